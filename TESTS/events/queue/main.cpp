@@ -240,6 +240,53 @@ void event_class_test()
     TEST_ASSERT_EQUAL(counter, 30);
 }
 
+void event_coalesce_test()
+{
+    counter = 0;
+    EventQueue queue(TEST_EQUEUE_SIZE);
+
+    Event<void(int)> e1(&queue, count1);
+
+    // a burst of posts results in a single dispatch with the last argument
+    int id = e1.post_coalesced(1);
+    TEST_ASSERT_NOT_EQUAL(0, id);
+    for (int i = 2; i <= 10; i++) {
+        TEST_ASSERT_EQUAL(id, e1.post_coalesced(i));
+    }
+
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(10, counter);
+
+    // once dispatched, the next post allocates a new event
+    id = e1.post_coalesced(5);
+    TEST_ASSERT_NOT_EQUAL(0, id);
+    queue.dispatch(0);
+    TEST_ASSERT_EQUAL(15, counter);
+}
+
+void static_event_queue_test()
+{
+    counter = 0;
+    StaticEventQueue<4> queue;
+    TEST_ASSERT_EQUAL(4, queue.capacity());
+
+    // the queue always holds exactly its capacity, whatever the event sizes
+    for (int r = 0; r < 3; r++) {
+        TEST_ASSERT_NOT_EQUAL(0, queue.call(count0));
+        TEST_ASSERT_NOT_EQUAL(0, queue.call(count1, 1));
+        TEST_ASSERT_NOT_EQUAL(0, queue.call(count2, 1, 1));
+        TEST_ASSERT_NOT_EQUAL(0, queue.call(count1, 1));
+        TEST_ASSERT_EQUAL(0, queue.call(count0));
+
+        queue.dispatch(0);
+    }
+
+    TEST_ASSERT_EQUAL(12, counter);
+
+    // events that do not fit are rejected
+    TEST_ASSERT_EQUAL(0, queue.call(count5, 1, 1, 1, 1, 1));
+}
+
 void event_class_helper_test()
 {
     counter = 0;
@@ -530,7 +577,9 @@ const Case cases[] = {
 
     Case("Testing event cancel 1", cancel_test1<20>),
     Case("Testing the event class", event_class_test),
+    Case("Testing the event class coalescing", event_coalesce_test),
     Case("Testing the event class helpers", event_class_helper_test),
+    Case("Testing static event queue", static_event_queue_test),
     Case("Testing the event inference", event_inference_test),
 
     Case("Testing time_left", time_left_test),
@@ -221,6 +221,37 @@ void test_any_polynomial()
     }
 }
 
+static volatile uint32_t async_crc;
+static volatile bool async_done;
+
+static void async_callback(uint32_t crc)
+{
+    async_crc = crc;
+    async_done = true;
+}
+
+void test_async_crc()
+{
+    static char test[1000];
+    for (size_t i = 0; i < sizeof(test); i++) {
+        test[i] = i * 7;
+    }
+
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    TEST_ASSERT_EQUAL(0, ct.compute(test, sizeof(test), &crc));
+
+    async_done = false;
+    TEST_ASSERT_EQUAL(0, ct.compute_async(test, sizeof(test), async_callback));
+    while (!async_done) {
+    }
+    TEST_ASSERT_EQUAL(crc, async_crc);
+
+    // The hardware is free again once the callback has run
+    TEST_ASSERT_EQUAL(0, ct.compute("123456789", 9, &crc));
+    TEST_ASSERT_EQUAL(0xCBF43926, crc);
+}
+
 void test_thread(void)
 {
     char  test[] = "123456789";
@@ -260,7 +291,8 @@ Case cases[] = {
 #if defined(MBED_CONF_RTOS_PRESENT)
     Case("Test thread safety", test_thread_safety),
 #endif
-    Case("Test not supported polynomials", test_any_polynomial)
+    Case("Test not supported polynomials", test_any_polynomial),
+    Case("Test asynchronous CRC", test_async_crc)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "drivers/DMAMemcpy.h"
+
+#include <string.h>
+
+/* Checks the results whether the copies run on the DMA or the CPU, so the
+ * test runs on every target.
+ */
+
+using namespace utest::v1;
+
+#define BUFFER_SIZE 4096
+#define TIMEOUT_US  100000
+
+static uint8_t src[BUFFER_SIZE + 4];
+static uint8_t dst[BUFFER_SIZE + 4];
+static volatile int done_count;
+
+static void done_handler()
+{
+    done_count++;
+}
+
+static void fill_buffers()
+{
+    for (size_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t)(i * 13 + 5);
+    }
+    memset(dst, 0, sizeof(dst));
+    done_count = 0;
+}
+
+static void wait_done()
+{
+    Timer timer;
+    timer.start();
+    while (!done_count && timer.elapsed_time().count() < TIMEOUT_US);
+    TEST_ASSERT_EQUAL(1, done_count);
+}
+
+template<size_t len, size_t offset>
+void test_memcpy_async()
+{
+    fill_buffers();
+    dma_memcpy_async(dst + offset, src + offset, len, done_handler);
+    wait_done();
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src + offset, dst + offset, len);
+    TEST_ASSERT_EQUAL(0, dst[offset + len]);
+}
+
+template<size_t len, size_t offset>
+void test_memset_async()
+{
+    fill_buffers();
+    dma_memset_async(dst + offset, 0xA5, len, done_handler);
+    wait_done();
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL(0xA5, dst[offset + i]);
+    }
+    TEST_ASSERT_EQUAL(0, dst[offset + len]);
+}
+
+template<size_t len>
+void test_memcpy_blocking()
+{
+    fill_buffers();
+    dma_memcpy(dst, src, len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, len);
+
+    dma_memset(dst, 0x5A, len);
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL(0x5A, dst[i]);
+    }
+}
+
+void test_concurrent_copies()
+{
+    // The second copy starts while the first may still own the channel
+    fill_buffers();
+    dma_memcpy_async(dst, src, BUFFER_SIZE / 2, done_handler);
+    dma_memcpy_async(dst + BUFFER_SIZE / 2, src + BUFFER_SIZE / 2, BUFFER_SIZE / 2, done_handler);
+
+    Timer timer;
+    timer.start();
+    while (done_count < 2 && timer.elapsed_time().count() < TIMEOUT_US);
+    TEST_ASSERT_EQUAL(2, done_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst, BUFFER_SIZE);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("memcpy async, small", test_memcpy_async<16, 0>, greentea_failure_handler),
+    Case("memcpy async, large aligned", test_memcpy_async<BUFFER_SIZE, 0>, greentea_failure_handler),
+    Case("memcpy async, large unaligned", test_memcpy_async<BUFFER_SIZE - 3, 1>, greentea_failure_handler),
+    Case("memset async, small", test_memset_async<16, 0>, greentea_failure_handler),
+    Case("memset async, large aligned", test_memset_async<BUFFER_SIZE, 0>, greentea_failure_handler),
+    Case("memset async, large unaligned", test_memset_async<BUFFER_SIZE - 1, 3>, greentea_failure_handler),
+    Case("memcpy blocking", test_memcpy_blocking<BUFFER_SIZE>, greentea_failure_handler),
+    Case("Concurrent copies", test_concurrent_copies, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -190,6 +190,85 @@ void flashiap_cross_sector_program_test()
     TEST_ASSERT_EQUAL_INT32(0, ret);
 }
 
+static volatile bool async_done;
+static volatile int async_result;
+
+static void async_complete(int result)
+{
+    async_result = result;
+    async_done = true;
+}
+
+static int wait_async()
+{
+    while (!async_done) {
+    }
+    async_done = false;
+    return async_result;
+}
+
+void flashiap_async_test()
+{
+    FlashIAP flash_device;
+    uint32_t ret = flash_device.init();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    uint32_t page_size = flash_device.get_page_size();
+    uint8_t erase_value = flash_device.get_erase_value();
+
+    // Use the last two sectors, so the operations take more than one step
+    uint32_t address = flash_device.get_flash_start() + flash_device.get_flash_size();
+    uint32_t sector_size, agg_size = 0;
+    for (uint32_t i = 0; i < 2; i++) {
+        sector_size = flash_device.get_sector_size(address - 1UL);
+        TEST_ASSERT_NOT_EQUAL(0, sector_size);
+        agg_size += sector_size;
+        address -= sector_size;
+    }
+    utest_printf("ROM ends at 0x%lx, test starts at 0x%lx\n", FLASHIAP_APP_ROM_END_ADDR, address);
+    TEST_SKIP_UNLESS_MESSAGE(address >= FLASHIAP_APP_ROM_END_ADDR, "Test skipped. Test region overlaps code.");
+
+    async_done = false;
+    ret = flash_device.erase_async(address, agg_size, async_complete);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_INT32(0, wait_async());
+
+    // program across the sector boundary, with a partial last page
+    address += sector_size - page_size;
+    uint32_t aligned_prog_size = 2 * page_size;
+    uint32_t prog_size = page_size > 1 ? aligned_prog_size - 1 : aligned_prog_size;
+    uint8_t *data = new uint8_t[aligned_prog_size];
+    for (uint32_t i = 0; i < prog_size; i++) {
+        data[i] = rand() % 256;
+    }
+    for (uint32_t i = prog_size; i < aligned_prog_size; i++) {
+        data[i] = erase_value;
+    }
+
+    ret = flash_device.program_async(data, address, prog_size, async_complete);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_INT32(0, wait_async());
+
+    // blocking calls wait for the asynchronous operation
+    uint8_t *data_flashed = new uint8_t[aligned_prog_size];
+    ret = flash_device.read(data_flashed, address, aligned_prog_size);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, data_flashed, aligned_prog_size);
+
+    // invalid requests fail without calling back
+    ret = flash_device.program_async(NULL, address, page_size, async_complete);
+    TEST_ASSERT_NOT_EQUAL(0, ret);
+    ret = flash_device.erase_async(address, 2 * agg_size, async_complete);
+    TEST_ASSERT_NOT_EQUAL(0, ret);
+    TEST_ASSERT_FALSE(async_done);
+
+    delete[] data;
+    delete[] data_flashed;
+
+    ret = flash_device.deinit();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
 void flashiap_program_error_test()
 {
     FlashIAP flash_device;
@@ -315,6 +394,7 @@ Case cases[] = {
     Case("FlashIAP - program", flashiap_program_test),
     Case("FlashIAP - program across sectors", flashiap_cross_sector_program_test),
     Case("FlashIAP - program errors", flashiap_program_error_test),
+    Case("FlashIAP - asynchronous erase and program", flashiap_async_test),
     Case("FlashIAP - timing", flashiap_timing_test),
 };
 
@@ -403,13 +403,56 @@ static void test_case_multithread_malloc_free()
 
 
 
+/** Test binary tracer
+ *
+ *  Given the binary memory tracer with a two record buffer
+ *  When perform three memory operations
+ *  Then the first two are read back as records and the third is counted as dropped
+ *
+ */
+static void test_case_binary_trace()
+{
+    const size_t block_size = 126;
+    mbed_mem_trace_record_t buffer[2];
+    mbed_mem_trace_record_t records[3];
+
+    mbed_mem_trace_binary_set_buffer(buffer, 2);
+    mbed_mem_trace_set_callback(mbed_mem_trace_binary_callback);
+
+    void *p = malloc(block_size);
+    TEST_ASSERT_NOT_EQUAL(p, NULL);
+    p = realloc(p, block_size * 2);
+    TEST_ASSERT_NOT_EQUAL(p, NULL);
+    free(p);
+
+    mbed_mem_trace_set_callback(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(2, mbed_mem_trace_binary_read(records, 3));
+    TEST_ASSERT_EQUAL_UINT32(1, mbed_mem_trace_binary_dropped());
+
+    TEST_ASSERT_EQUAL_HEX16(MBED_MEM_TRACE_RECORD_SYNC, records[0].sync);
+    TEST_ASSERT_EQUAL_UINT8(MBED_MEM_TRACE_MALLOC, records[0].op);
+    TEST_ASSERT_EQUAL_UINT8(0, records[0].seq);
+    TEST_ASSERT_EQUAL_UINT32(block_size, records[0].size);
+
+    TEST_ASSERT_EQUAL_UINT8(MBED_MEM_TRACE_REALLOC, records[1].op);
+    TEST_ASSERT_EQUAL_UINT8(1, records[1].seq);
+    TEST_ASSERT_EQUAL_UINT32((uintptr_t)p, records[1].res);
+    TEST_ASSERT_EQUAL_UINT32(records[0].res, records[1].ptr);
+    TEST_ASSERT_EQUAL_UINT32(block_size * 2, records[1].size);
+
+    TEST_ASSERT_EQUAL_UINT32(0, mbed_mem_trace_binary_read(records, 3));
+    mbed_mem_trace_binary_set_buffer(NULL, 0);
+}
+
 static Case cases[] = {
     Case("Test single malloc/free trace", test_case_single_malloc_free),
     Case("Test all memory operations trace", test_case_all_memory_ops),
     Case("Test trace off", test_case_trace_off),
     Case("Test partial trace", test_case_partial_trace),
     Case("Test new/delete trace", test_case_new_delete),
-    Case("Test multithreaded trace", test_case_multithread_malloc_free)
+    Case("Test multithreaded trace", test_case_multithread_malloc_free),
+    Case("Test binary trace", test_case_binary_trace)
 };
 
 static utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
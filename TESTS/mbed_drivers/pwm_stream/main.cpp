@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !DEVICE_PWMOUT_STREAM
+#error [NOT_SUPPORTED] PWM streaming not supported for this target
+#elif !defined(LED1)
+#error [NOT_SUPPORTED] Test needs a PWM capable LED1
+#else
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "mbed.h"
+
+using namespace utest::v1;
+
+#define PERIOD_US       100
+#define BUFFER_LENGTH   64
+#define STREAM_MS       320
+// Halves loaded in STREAM_MS
+#define EXPECTED_REFILLS (STREAM_MS * 1000 / PERIOD_US / (BUFFER_LENGTH / 2))
+
+static uint16_t buffer[BUFFER_LENGTH];
+static volatile uint32_t refill_count;
+static volatile uint32_t wrong_half_count;
+static uint16_t *volatile last_half;
+
+static void refill(uint16_t *half, size_t length)
+{
+    if (length != BUFFER_LENGTH / 2 || half == last_half ||
+            (half != buffer && half != buffer + BUFFER_LENGTH / 2)) {
+        wrong_half_count++;
+    }
+    last_half = half;
+    refill_count++;
+}
+
+static void fill_ramp(PwmOut &pwm)
+{
+    uint32_t ticks = pwm.period_ticks();
+    for (int i = 0; i < BUFFER_LENGTH; i++) {
+        buffer[i] = ticks * i / BUFFER_LENGTH;
+    }
+    refill_count = 0;
+    wrong_half_count = 0;
+    last_half = nullptr;
+}
+
+void test_refill_rate()
+{
+    PwmOut pwm(LED1);
+    pwm.period_us(PERIOD_US);
+    fill_ramp(pwm);
+
+    TEST_ASSERT_TRUE(pwm.stream_start(buffer, BUFFER_LENGTH, refill));
+    ThisThread::sleep_for(STREAM_MS);
+    pwm.stream_stop();
+
+    TEST_ASSERT_UINT32_WITHIN(EXPECTED_REFILLS / 10, EXPECTED_REFILLS, refill_count);
+    TEST_ASSERT_EQUAL(0, wrong_half_count);
+}
+
+void test_stop()
+{
+    PwmOut pwm(LED1);
+    pwm.period_us(PERIOD_US);
+    fill_ramp(pwm);
+
+    TEST_ASSERT_TRUE(pwm.stream_start(buffer, BUFFER_LENGTH, refill));
+    ThisThread::sleep_for(STREAM_MS / 4);
+    pwm.stream_stop();
+    uint32_t count = refill_count;
+    ThisThread::sleep_for(STREAM_MS / 4);
+
+    TEST_ASSERT(count > 0);
+    TEST_ASSERT_EQUAL(count, refill_count);
+}
+
+void test_restart()
+{
+    PwmOut pwm(LED1);
+    pwm.period_us(PERIOD_US);
+    fill_ramp(pwm);
+
+    TEST_ASSERT_TRUE(pwm.stream_start(buffer, BUFFER_LENGTH, refill));
+    ThisThread::sleep_for(STREAM_MS / 4);
+    fill_ramp(pwm);
+    TEST_ASSERT_TRUE(pwm.stream_start(buffer, BUFFER_LENGTH, refill));
+    ThisThread::sleep_for(STREAM_MS);
+    pwm.stream_stop();
+
+    TEST_ASSERT_UINT32_WITHIN(EXPECTED_REFILLS / 10, EXPECTED_REFILLS, refill_count);
+    TEST_ASSERT_EQUAL(0, wrong_half_count);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("Refill rate follows the period", test_refill_rate, greentea_failure_handler),
+    Case("No refills after stop", test_stop, greentea_failure_handler),
+    Case("Restart while streaming", test_restart, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_PWMOUT_STREAM
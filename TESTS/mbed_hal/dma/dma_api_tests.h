@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup hal_dma_tests
+ * @{
+ */
+
+#ifndef MBED_HAL_DMA_API_TESTS_H
+#define MBED_HAL_DMA_API_TESTS_H
+
+#if DEVICE_DMA
+
+/** Test capabilities validity
+ *
+ * Given a device supporting DMA HAL API,
+ * when @a hal_dma_get_capabilities() is called,
+ * then at least one channel, one width and a max_count of at least 1 are reported.
+ */
+void test_capabilities_are_valid();
+
+/** Test memory to memory transfers
+ *
+ * Given a channel initialized for memory to memory transfers,
+ * when a single descriptor transfer is started for each supported width,
+ * then the handler is called once with DMA_EVENT_COMPLETE and the destination matches the source.
+ */
+template<dma_width_t width>
+void test_memory_to_memory();
+
+/** Test linked descriptors
+ *
+ * Given a device supporting linked descriptors,
+ * when a chain of descriptors is started with DMA_EVENT_DESCRIPTOR_COMPLETE requested,
+ * then the handler reports each descriptor, DMA_EVENT_COMPLETE is reported once
+ * and every destination matches its source.
+ */
+void test_linked_descriptors();
+
+/** Test circular descriptors
+ *
+ * Given a device supporting circular chains,
+ * when a chain looping on itself is started,
+ * then it runs past its last descriptor without DMA_EVENT_COMPLETE,
+ * and after @a hal_dma_transfer_abort() returns it is not busy and reports no more events.
+ */
+void test_circular_descriptors();
+
+/** Test busy channel
+ *
+ * Given a transfer running on a channel,
+ * when @a hal_dma_transfer_start() is called again,
+ * then DMA_STATUS_BUSY is returned.
+ */
+void test_start_while_busy();
+
+/** Test channel allocation
+ *
+ * Given a device with N channels,
+ * when N + 1 channels are initialized,
+ * then the last initialization returns DMA_STATUS_OUT_OF_CHANNELS,
+ * and a channel can be initialized again after one is freed.
+ */
+void test_out_of_channels();
+
+#endif
+
+#endif
+
+/** @}*/
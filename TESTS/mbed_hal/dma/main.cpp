@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2020 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !DEVICE_DMA
+#error [NOT_SUPPORTED] DMA not supported for this target
+#else
+
+#include "greentea-client/test_env.h"
+#include "hal/dma_api.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "dma_api_tests.h"
+#include "mbed.h"
+
+#include <string.h>
+
+#define BUFFER_SIZE         256
+#define LINKED_COUNT        3
+#define CIRCULAR_LAPS       4
+#define TIMEOUT_US          100000
+#define MAX_TEST_CHANNELS   32
+
+using namespace utest::v1;
+
+static uint32_t src[BUFFER_SIZE / 4];
+static uint32_t dst[LINKED_COUNT][BUFFER_SIZE / 4];
+
+static volatile uint32_t complete_count;
+static volatile uint32_t descriptor_count;
+static volatile uint32_t error_count;
+
+static void handler(dma_channel_t *channel, uint32_t events, void *context)
+{
+    (void)channel;
+    (void)context;
+    if (events & DMA_EVENT_COMPLETE) {
+        complete_count++;
+    }
+    if (events & DMA_EVENT_DESCRIPTOR_COMPLETE) {
+        descriptor_count++;
+    }
+    if (events & DMA_EVENT_ERROR) {
+        error_count++;
+    }
+}
+
+static void reset_buffers()
+{
+    for (size_t i = 0; i < sizeof(src); i++) {
+        ((uint8_t *)src)[i] = (uint8_t)(i * 7 + 1);
+    }
+    memset(dst, 0, sizeof(dst));
+    complete_count = 0;
+    descriptor_count = 0;
+    error_count = 0;
+}
+
+static bool wait_for(volatile uint32_t *counter, uint32_t value)
+{
+    Timer timer;
+    timer.start();
+    while (*counter < value && timer.elapsed_time().count() < TIMEOUT_US);
+    return *counter >= value;
+}
+
+static dma_descriptor_t memory_descriptor(void *to, dma_width_t width, const dma_descriptor_t *next)
+{
+    dma_descriptor_t descriptor = { src, to, BUFFER_SIZE / width, width, true, true, next };
+    return descriptor;
+}
+
+static bool init_memory_channel(dma_channel_t *channel, uint32_t events)
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+    if (!capabilities.memory_to_memory) {
+        return false;
+    }
+
+    dma_config_t config = { DMA_MEMORY_TO_MEMORY, 0, 0, events };
+    TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_channel_init(channel, &config, handler, NULL));
+    return true;
+}
+
+void test_capabilities_are_valid()
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+
+    TEST_ASSERT(capabilities.channels >= 1);
+    TEST_ASSERT(capabilities.max_count >= 1);
+    TEST_ASSERT(capabilities.widths != 0);
+    TEST_ASSERT_EQUAL(0, capabilities.widths & ~(DMA_WIDTH_8BIT | DMA_WIDTH_16BIT | DMA_WIDTH_32BIT));
+}
+
+template<dma_width_t width>
+void test_memory_to_memory()
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+    if (!(capabilities.widths & width)) {
+        TEST_IGNORE_MESSAGE("Width not supported");
+        return;
+    }
+
+    dma_channel_t channel;
+    if (!init_memory_channel(&channel, 0)) {
+        TEST_IGNORE_MESSAGE("Memory to memory transfers not supported");
+        return;
+    }
+    reset_buffers();
+
+    dma_descriptor_t descriptor = memory_descriptor(dst[0], width, NULL);
+    TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_transfer_start(&channel, &descriptor));
+    TEST_ASSERT_TRUE(wait_for(&complete_count, 1));
+
+    TEST_ASSERT_FALSE(hal_dma_transfer_busy(&channel));
+    TEST_ASSERT_EQUAL(1, complete_count);
+    TEST_ASSERT_EQUAL(0, error_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst[0], BUFFER_SIZE);
+    hal_dma_channel_free(&channel);
+}
+
+void test_linked_descriptors()
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+    if (!capabilities.linked) {
+        TEST_IGNORE_MESSAGE("Linked descriptors not supported");
+        return;
+    }
+
+    dma_channel_t channel;
+    if (!init_memory_channel(&channel, DMA_EVENT_DESCRIPTOR_COMPLETE)) {
+        TEST_IGNORE_MESSAGE("Memory to memory transfers not supported");
+        return;
+    }
+    reset_buffers();
+
+    dma_descriptor_t descriptors[LINKED_COUNT];
+    for (int i = LINKED_COUNT - 1; i >= 0; i--) {
+        descriptors[i] = memory_descriptor(dst[i], DMA_WIDTH_8BIT,
+                                           i == LINKED_COUNT - 1 ? NULL : &descriptors[i + 1]);
+    }
+    TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_transfer_start(&channel, &descriptors[0]));
+    TEST_ASSERT_TRUE(wait_for(&complete_count, 1));
+
+    TEST_ASSERT_EQUAL(1, complete_count);
+    TEST_ASSERT_EQUAL(LINKED_COUNT, descriptor_count);
+    TEST_ASSERT_EQUAL(0, error_count);
+    for (int i = 0; i < LINKED_COUNT; i++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst[i], BUFFER_SIZE);
+    }
+    hal_dma_channel_free(&channel);
+}
+
+void test_circular_descriptors()
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+    if (!capabilities.circular) {
+        TEST_IGNORE_MESSAGE("Circular descriptors not supported");
+        return;
+    }
+
+    dma_channel_t channel;
+    if (!init_memory_channel(&channel, DMA_EVENT_DESCRIPTOR_COMPLETE)) {
+        TEST_IGNORE_MESSAGE("Memory to memory transfers not supported");
+        return;
+    }
+    reset_buffers();
+
+    dma_descriptor_t descriptors[2];
+    descriptors[0] = memory_descriptor(dst[0], DMA_WIDTH_8BIT, &descriptors[1]);
+    descriptors[1] = memory_descriptor(dst[1], DMA_WIDTH_8BIT, &descriptors[0]);
+    TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_transfer_start(&channel, &descriptors[0]));
+    TEST_ASSERT_TRUE(wait_for(&descriptor_count, 2 * CIRCULAR_LAPS));
+
+    hal_dma_transfer_abort(&channel);
+    TEST_ASSERT_FALSE(hal_dma_transfer_busy(&channel));
+    uint32_t count = descriptor_count;
+    wait_us(1000);
+    TEST_ASSERT_EQUAL(count, descriptor_count);
+    TEST_ASSERT_EQUAL(0, complete_count);
+    TEST_ASSERT_EQUAL(0, error_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst[0], BUFFER_SIZE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(src, dst[1], BUFFER_SIZE);
+    hal_dma_channel_free(&channel);
+}
+
+void test_start_while_busy()
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+    if (!capabilities.circular) {
+        TEST_IGNORE_MESSAGE("Circular descriptors not supported, can't keep the channel busy");
+        return;
+    }
+
+    dma_channel_t channel;
+    if (!init_memory_channel(&channel, 0)) {
+        TEST_IGNORE_MESSAGE("Memory to memory transfers not supported");
+        return;
+    }
+    reset_buffers();
+
+    dma_descriptor_t descriptor = memory_descriptor(dst[0], DMA_WIDTH_8BIT, NULL);
+    descriptor.next = &descriptor;
+    TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_transfer_start(&channel, &descriptor));
+    TEST_ASSERT_TRUE(hal_dma_transfer_busy(&channel));
+    TEST_ASSERT_EQUAL(DMA_STATUS_BUSY, hal_dma_transfer_start(&channel, &descriptor));
+
+    TEST_ASSERT(hal_dma_transfer_abort(&channel) <= descriptor.count);
+    TEST_ASSERT_FALSE(hal_dma_transfer_busy(&channel));
+    TEST_ASSERT_EQUAL(0, hal_dma_transfer_abort(&channel));
+    hal_dma_channel_free(&channel);
+}
+
+void test_out_of_channels()
+{
+    dma_capabilities_t capabilities;
+    hal_dma_get_capabilities(&capabilities);
+    if (!capabilities.memory_to_memory || capabilities.channels >= MAX_TEST_CHANNELS) {
+        TEST_IGNORE_MESSAGE("Memory to memory transfers not supported, or too many channels");
+        return;
+    }
+
+    static dma_channel_t channels[MAX_TEST_CHANNELS];
+    dma_config_t config = { DMA_MEMORY_TO_MEMORY, 0, 0, 0 };
+    for (int i = 0; i < capabilities.channels; i++) {
+        TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_channel_init(&channels[i], &config, NULL, NULL));
+    }
+    TEST_ASSERT_EQUAL(DMA_STATUS_OUT_OF_CHANNELS,
+                      hal_dma_channel_init(&channels[capabilities.channels], &config, NULL, NULL));
+
+    hal_dma_channel_free(&channels[0]);
+    TEST_ASSERT_EQUAL(DMA_STATUS_OK, hal_dma_channel_init(&channels[0], &config, NULL, NULL));
+    for (int i = 0; i < capabilities.channels; i++) {
+        hal_dma_channel_free(&channels[i]);
+    }
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("Capabilities are valid", test_capabilities_are_valid, greentea_failure_handler),
+    Case("Memory to memory, 8 bit", test_memory_to_memory<DMA_WIDTH_8BIT>, greentea_failure_handler),
+    Case("Memory to memory, 16 bit", test_memory_to_memory<DMA_WIDTH_16BIT>, greentea_failure_handler),
+    Case("Memory to memory, 32 bit", test_memory_to_memory<DMA_WIDTH_32BIT>, greentea_failure_handler),
+    Case("Linked descriptors", test_linked_descriptors, greentea_failure_handler),
+    Case("Circular descriptors", test_circular_descriptors, greentea_failure_handler),
+    Case("Start while busy", test_start_while_busy, greentea_failure_handler),
+    Case("Out of channels", test_out_of_channels, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_DMA
@@ -0,0 +1,134 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !DEVICE_LPTICKER
+#error [NOT_SUPPORTED] Low power timer not supported for this target
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "hal/lp_ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+/* Finds the shortest LowPowerTimeout delay that fires on time on this target,
+ * going through the whole low power path: ticker event queue, lp ticker
+ * wrapper (when LPTICKER_DELAY_TICKS is set) and lp ticker driver. The result
+ * is printed so it can be compared across targets and configurations.
+ */
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define TRIALS              16
+#define MAX_DELAY_US        20000
+// Interrupt and dispatch latency allowed on top of the delay
+#define LATENCY_US          200
+// Longest the wait for a missed event lasts
+#define MISS_TIMEOUT_US     50000
+
+#if !defined(LPTICKER_DELAY_TICKS)
+#define LPTICKER_DELAY_TICKS 0
+#endif
+
+static volatile bool fired;
+static volatile us_timestamp_t fired_us;
+
+static void fired_handler()
+{
+    fired_us = ticker_read_us(get_us_ticker_data());
+    fired = true;
+}
+
+static uint32_t lp_tick_us()
+{
+    const ticker_info_t *info = get_lp_ticker_data()->interface->get_info();
+    return (1000000 + info->frequency - 1) / info->frequency;
+}
+
+// Returns true if all trials with delay_us fire no earlier than one lp tick
+// before and no later than two lp ticks plus LATENCY_US after the delay
+static bool delay_is_reliable(uint32_t delay_us, uint32_t tick_us, uint32_t *worst_late_us)
+{
+    LowPowerTimeout timeout;
+
+    for (int i = 0; i < TRIALS; i++) {
+        fired = false;
+        us_timestamp_t start = ticker_read_us(get_us_ticker_data());
+        timeout.attach(fired_handler, microseconds(delay_us));
+        while (!fired && ticker_read_us(get_us_ticker_data()) - start < delay_us + MISS_TIMEOUT_US);
+        timeout.detach();
+
+        if (!fired) {
+            return false;
+        }
+        us_timestamp_t elapsed = fired_us - start;
+        if (elapsed + tick_us < delay_us || elapsed > delay_us + 2 * tick_us + LATENCY_US) {
+            return false;
+        }
+        if (elapsed > delay_us && elapsed - delay_us > *worst_late_us) {
+            *worst_late_us = elapsed - delay_us;
+        }
+    }
+    return true;
+}
+
+void test_lp_timeout_min_delay()
+{
+    uint32_t tick_us = lp_tick_us();
+    uint32_t min_delay_us = 0;
+    uint32_t worst_late_us = 0;
+
+    for (uint32_t delay_us = tick_us; delay_us <= MAX_DELAY_US; delay_us += tick_us) {
+        worst_late_us = 0;
+        if (delay_is_reliable(delay_us, tick_us, &worst_late_us)) {
+            min_delay_us = delay_us;
+            break;
+        }
+    }
+
+    printf("lp ticker tick: %lu us, wrapper delay: %d ticks\n", (unsigned long)tick_us, LPTICKER_DELAY_TICKS);
+    printf("minimum reliable LowPowerTimeout delay: %lu us (%lu ticks), worst lateness %lu us\n",
+           (unsigned long)min_delay_us, (unsigned long)(min_delay_us / tick_us), (unsigned long)worst_late_us);
+
+    TEST_ASSERT_MESSAGE(min_delay_us != 0, "No delay up to MAX_DELAY_US fires reliably");
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("LowPowerTimeout minimum reliable delay", test_lp_timeout_min_delay, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !DEVICE_LPTICKER
@@ -86,6 +86,49 @@ void test_lock_eq_ushrt_max()
     TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
 }
 
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+static bool find_lock_stats(const char *tag, mbed_stats_deep_sleep_lock_t *stat)
+{
+    mbed_stats_deep_sleep_lock_t stats[MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS + 1];
+    size_t count = mbed_stats_deep_sleep_lock_get_each(stats, MBED_ARRAY_SIZE(stats));
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].tag && strcmp(stats[i].tag, tag) == 0) {
+            *stat = stats[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void test_lock_stats()
+{
+    mbed_stats_deep_sleep_lock_t before = {};
+    mbed_stats_deep_sleep_lock_t after;
+    find_lock_stats("test_holder", &before);
+
+    sleep_manager_lock_deep_sleep_tagged("test_holder");
+    sleep_manager_lock_deep_sleep_tagged("test_holder");
+    TEST_ASSERT_TRUE(find_lock_stats("test_holder", &after));
+    TEST_ASSERT_EQUAL_UINT32(before.lock_cnt + 2, after.lock_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, after.held_cnt);
+
+    sleep_manager_unlock_deep_sleep_tagged("test_holder");
+    sleep_manager_unlock_deep_sleep_tagged("test_holder");
+    TEST_ASSERT_TRUE(find_lock_stats("test_holder", &after));
+    TEST_ASSERT_EQUAL_UINT32(before.lock_cnt + 2, after.lock_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, after.held_cnt);
+    TEST_ASSERT_TRUE(sleep_manager_can_deep_sleep());
+
+    {
+        DeepSleepLock lock("test_lock_object");
+        TEST_ASSERT_TRUE(find_lock_stats("test_lock_object", &after));
+        TEST_ASSERT_EQUAL_UINT32(1, after.held_cnt);
+    }
+    TEST_ASSERT_TRUE(find_lock_stats("test_lock_object", &after));
+    TEST_ASSERT_EQUAL_UINT32(0, after.held_cnt);
+}
+#endif
+
 utest::v1::status_t testcase_setup(const Case *const source, const size_t index_of_case)
 {
     // Suspend the RTOS kernel scheduler to prevent interference with duration of sleep.
@@ -322,6 +365,12 @@ Case cases[] = {
          (utest::v1::case_setup_handler_t) testcase_setup,
          test_lock_eq_ushrt_max,
          (utest::v1::case_teardown_handler_t) testcase_teardown),
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+    Case("deep sleep lock statistics",
+         (utest::v1::case_setup_handler_t) testcase_setup,
+         test_lock_stats,
+         (utest::v1::case_teardown_handler_t) testcase_teardown),
+#endif
 #if DEVICE_LPTICKER
 #if DEVICE_USTICKER
     Case("sleep_auto calls sleep/deep sleep based on lock",
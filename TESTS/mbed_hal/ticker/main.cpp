@@ -26,6 +26,10 @@
 #include "mbed.h"
 #include "ticker_api.h"
 
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+#error [NOT_SUPPORTED] test checks the layout of the sorted event list
+#else
+
 using namespace utest::v1;
 
 #define MBED_ARRAY_SIZE(array) (sizeof(array)/sizeof(array[0]))
@@ -1245,6 +1249,70 @@ static void test_insert_event_us_multiple_random()
     TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
 }
 
+/**
+ * Given an initialized ticker with events registered.
+ * When an event is inserted with ticker_insert_event_us_coalesced.
+ * Then
+ *   - If an event is due no more than slack after the timestamp, the new
+ *     event should take the timestamp of that event.
+ *   - Otherwise the event should keep the timestamp passed in parameter.
+ *   - The returned timestamp should be the timestamp of the event.
+ *   - Events in the queue should remain ordered by timestamp.
+ */
+static void test_insert_event_us_coalesced()
+{
+    ticker_set_handler(&ticker_stub, NULL);
+    interface_stub.set_interrupt_call = 0;
+
+    const timestamp_t ref_timestamp = UINT32_MAX / 2;
+    interface_stub.timestamp = ref_timestamp;
+
+    ticker_event_t first_event;
+    const us_timestamp_t first_event_timestamp = ref_timestamp + 1000;
+    ticker_insert_event_us(
+        &ticker_stub,
+        &first_event, first_event_timestamp, (uint32_t) &first_event
+    );
+
+    // within slack: joins the first event
+    ticker_event_t second_event;
+    us_timestamp_t result = ticker_insert_event_us_coalesced(
+                                &ticker_stub,
+                                &second_event, first_event_timestamp - 100, 100, (uint32_t) &second_event
+                            );
+    TEST_ASSERT_EQUAL_UINT64(first_event_timestamp, result);
+    TEST_ASSERT_EQUAL_UINT64(first_event_timestamp, second_event.timestamp);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t) &second_event, second_event.id);
+
+    // outside slack: keeps its own timestamp, ahead of the others
+    ticker_event_t third_event;
+    const us_timestamp_t third_event_timestamp = first_event_timestamp - 101;
+    result = ticker_insert_event_us_coalesced(
+                 &ticker_stub,
+                 &third_event, third_event_timestamp, 100, (uint32_t) &third_event
+             );
+    TEST_ASSERT_EQUAL_UINT64(third_event_timestamp, result);
+    TEST_ASSERT_EQUAL_UINT64(third_event_timestamp, third_event.timestamp);
+    TEST_ASSERT_EQUAL_PTR(&third_event, queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(third_event_timestamp, interface_stub.interrupt_timestamp);
+
+    // nothing due after it: keeps its own timestamp
+    ticker_event_t fourth_event;
+    const us_timestamp_t fourth_event_timestamp = first_event_timestamp + 10;
+    result = ticker_insert_event_us_coalesced(
+                 &ticker_stub,
+                 &fourth_event, fourth_event_timestamp, 1000, (uint32_t) &fourth_event
+             );
+    TEST_ASSERT_EQUAL_UINT64(fourth_event_timestamp, result);
+    TEST_ASSERT_EQUAL_UINT64(fourth_event_timestamp, fourth_event.timestamp);
+
+    for (ticker_event_t *e = queue_stub.head; e && e->next; e = e->next) {
+        TEST_ASSERT_TRUE(e->timestamp <= e->next->timestamp);
+    }
+
+    TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
+}
+
 /**
  * Given an initialized ticker with multiple events registered.
  * When the event at the tail of the queue is removed from the queue.
@@ -2394,6 +2462,7 @@ static const case_t cases[] = {
         "test_insert_event_us_multiple_random",
         test_insert_event_us_multiple_random
     ),
+    MAKE_TEST_CASE("test_insert_event_us_coalesced", test_insert_event_us_coalesced),
     MAKE_TEST_CASE("test_remove_event_tail", test_remove_event_tail),
     MAKE_TEST_CASE("test_remove_event_head", test_remove_event_head),
     MAKE_TEST_CASE("test_remove_event_invalid", test_remove_event_invalid),
@@ -2471,3 +2540,5 @@ int main()
     Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
     return !Harness::run(specification);
 }
+
+#endif // MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
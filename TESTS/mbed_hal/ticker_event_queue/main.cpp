@@ -0,0 +1,235 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+#include "ticker_api.h"
+
+/* These tests only use the public ticker API, so they check the event queue
+ * whichever way it stores pending events (see platform.ticker-event-heap).
+ */
+
+using namespace utest::v1;
+
+#define EVENT_COUNT 64
+#define ITERATIONS  5000
+
+static timestamp_t stub_time;
+
+static void stub_init()
+{
+}
+
+static uint32_t stub_read()
+{
+    return stub_time;
+}
+
+static void stub_nop()
+{
+}
+
+static void stub_set_interrupt(timestamp_t timestamp)
+{
+}
+
+static const ticker_info_t stub_info = { 1000000, 32 };
+
+static const ticker_info_t *stub_get_info()
+{
+    return &stub_info;
+}
+
+static const ticker_interface_t stub_interface = {
+    stub_init,
+    stub_read,
+    stub_nop,
+    stub_nop,
+    stub_set_interrupt,
+    stub_nop,
+    stub_nop,
+    stub_get_info,
+    false
+};
+
+static ticker_event_queue_t stub_queue;
+
+static const ticker_data_t stub_ticker = {
+    &stub_interface,
+    &stub_queue
+};
+
+static ticker_event_t events[EVENT_COUNT];
+static us_timestamp_t expected_timestamp[EVENT_COUNT];
+static bool queued[EVENT_COUNT];
+static us_timestamp_t last_fired;
+static bool fired_in_order;
+
+static void event_handler(uint32_t id)
+{
+    if (id >= EVENT_COUNT || !queued[id] || expected_timestamp[id] < last_fired ||
+            expected_timestamp[id] > stub_time) {
+        fired_in_order = false;
+    }
+    if (id < EVENT_COUNT) {
+        last_fired = expected_timestamp[id];
+        queued[id] = false;
+    }
+}
+
+static void reset()
+{
+    memset(&stub_queue, 0, sizeof(stub_queue));
+    memset(events, 0, sizeof(events));
+    memset(queued, 0, sizeof(queued));
+    stub_time = 0;
+    ticker_set_handler(&stub_ticker, event_handler);
+}
+
+static void check_next_timestamp()
+{
+    bool any = false;
+    us_timestamp_t earliest = 0;
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (queued[i] && (!any || expected_timestamp[i] < earliest)) {
+            earliest = expected_timestamp[i];
+            any = true;
+        }
+    }
+
+    us_timestamp_t next;
+    TEST_ASSERT_EQUAL(any ? 1 : 0, ticker_get_next_timestamp_us(&stub_ticker, &next));
+    if (any) {
+        TEST_ASSERT_EQUAL_UINT64(earliest, next);
+    }
+}
+
+static void dispatch()
+{
+    last_fired = 0;
+    fired_in_order = true;
+    ticker_irq_handler(&stub_ticker);
+    TEST_ASSERT_TRUE(fired_in_order);
+
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        TEST_ASSERT_FALSE(queued[i] && expected_timestamp[i] <= stub_time);
+    }
+}
+
+/** Test that events inserted and removed in random order are dispatched
+ *  in timestamp order, and the earliest one is always reported as next
+ */
+static void test_random_insert_remove_dispatch()
+{
+    reset();
+    srand(1);
+
+    for (int n = 0; n < ITERATIONS; n++) {
+        int i = rand() % EVENT_COUNT;
+        int op = rand() % 8;
+
+        if (op < 4) {
+            if (queued[i]) {
+                ticker_remove_event(&stub_ticker, &events[i]);
+            }
+            expected_timestamp[i] = stub_time + 1 + rand() % 5000;
+            ticker_insert_event_us(&stub_ticker, &events[i], expected_timestamp[i], i);
+            queued[i] = true;
+        } else if (op < 6) {
+            // removing an event which isn't queued must be harmless
+            ticker_remove_event(&stub_ticker, &events[i]);
+            queued[i] = false;
+        } else {
+            stub_time += rand() % 300;
+            dispatch();
+        }
+
+        check_next_timestamp();
+    }
+
+    stub_time += 10000;
+    dispatch();
+    check_next_timestamp();
+}
+
+/** Test that coalesced inserts pick the earliest queued event within the
+ *  slack, whatever the position of that event in the queue
+ */
+static void test_random_coalesced_insert()
+{
+    reset();
+    srand(2);
+
+    for (int n = 0; n < ITERATIONS; n++) {
+        int i = rand() % EVENT_COUNT;
+
+        if (rand() % 4 == 0) {
+            stub_time += rand() % 300;
+            dispatch();
+            continue;
+        }
+
+        if (queued[i]) {
+            ticker_remove_event(&stub_ticker, &events[i]);
+            queued[i] = false;
+        }
+
+        us_timestamp_t timestamp = stub_time + 1 + rand() % 5000;
+        us_timestamp_t slack = rand() % 200;
+        us_timestamp_t expected = timestamp;
+        bool found = false;
+        for (int j = 0; j < EVENT_COUNT; j++) {
+            if (queued[j] && expected_timestamp[j] >= timestamp &&
+                    expected_timestamp[j] - timestamp <= slack &&
+                    (!found || expected_timestamp[j] < expected)) {
+                expected = expected_timestamp[j];
+                found = true;
+            }
+        }
+
+        us_timestamp_t chosen = ticker_insert_event_us_coalesced(&stub_ticker, &events[i], timestamp, slack, i);
+        TEST_ASSERT_EQUAL_UINT64(expected, chosen);
+        expected_timestamp[i] = chosen;
+        queued[i] = true;
+
+        check_next_timestamp();
+    }
+}
+
+static const Case cases[] = {
+    Case("random insert, remove and dispatch", test_random_insert_remove_dispatch),
+    Case("random coalesced insert", test_random_coalesced_insert)
+};
+
+static utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+int main()
+{
+    Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+    return !Harness::run(specification);
+}
@@ -42,6 +42,23 @@ struct TestStruct {
 
 int TestStruct::s_count = 0;
 
+struct TestRefCounted : mbed::RefCounted {
+    TestRefCounted(int value) : value(value)
+    {
+        s_count++;
+    }
+
+    ~TestRefCounted()
+    {
+        s_count--;
+    }
+
+    int value;
+    static int s_count;
+};
+
+int TestRefCounted::s_count = 0;
+
 /**
  * Test that a shared pointer correctly manages the lifetime of the underlying raw pointer
  */
@@ -109,6 +126,58 @@ void test_equality_comparators()
     TEST_ASSERT_TRUE(s_ptr1_1 != s_ptr2); // Shared pointer / Shared pointer
 }
 
+/**
+ * Test that make_shared constructs the object in place and manages its lifetime
+ */
+void test_make_shared()
+{
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+
+    {
+        SharedPtr<TestStruct> s_ptr1 = mbed::make_shared<TestStruct>();
+        TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+        TEST_ASSERT_EQUAL(42, s_ptr1->value);
+        TEST_ASSERT_EQUAL_UINT32(1, s_ptr1.use_count());
+
+        SharedPtr<TestStruct> s_ptr2 = s_ptr1;
+        TEST_ASSERT_EQUAL_UINT32(2, s_ptr1.use_count());
+
+        s_ptr1 = nullptr;
+        TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+        TEST_ASSERT_EQUAL_UINT32(1, s_ptr2.use_count());
+    }
+
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+}
+
+/**
+ * Test that objects with an embedded reference count share it between
+ * shared pointers, including ones made from the raw pointer
+ */
+void test_ref_counted()
+{
+    TEST_ASSERT_EQUAL(0, TestRefCounted::s_count);
+
+    {
+        SharedPtr<TestRefCounted> s_ptr1(new TestRefCounted(7));
+        TEST_ASSERT_EQUAL_UINT32(1, s_ptr1.use_count());
+
+        SharedPtr<TestRefCounted> s_ptr2(s_ptr1.get());
+        TEST_ASSERT_EQUAL_UINT32(2, s_ptr1.use_count());
+        TEST_ASSERT_TRUE(s_ptr1 == s_ptr2);
+
+        SharedPtr<TestRefCounted> s_ptr3 = mbed::make_shared<TestRefCounted>(8);
+        TEST_ASSERT_EQUAL(2, TestRefCounted::s_count);
+        TEST_ASSERT_EQUAL(8, s_ptr3->value);
+
+        s_ptr1 = nullptr;
+        TEST_ASSERT_EQUAL(2, TestRefCounted::s_count);
+        TEST_ASSERT_EQUAL(7, s_ptr2->value);
+    }
+
+    TEST_ASSERT_EQUAL(0, TestRefCounted::s_count);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -118,7 +187,9 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Test single shared pointer instance", test_single_sharedptr_lifetime),
     Case("Test instance sharing across multiple shared pointers", test_instance_sharing),
-    Case("Test equality comparators", test_equality_comparators)
+    Case("Test equality comparators", test_equality_comparators),
+    Case("Test make_shared", test_make_shared),
+    Case("Test embedded reference count", test_ref_counted)
 };
 
 utest::v1::Specification specification(test_setup, cases);
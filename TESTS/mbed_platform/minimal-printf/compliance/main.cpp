@@ -19,6 +19,7 @@
 #include "mbed.h"
 #endif
 #include "mbed_printf.h"
+#include "platform/mbed_static_printf.h"
 
 #include "utest/utest.h"
 #include "unity/unity.h"
@@ -1056,6 +1057,43 @@ static control_t test_snprintf_buffer_overflow_llx(const size_t call_count)
     return test_snprintf_buffer_overflow_generic<unsigned long long, sizeof("llx: 0x10000000000"), BASE_16>("llx: 0x%llx", 0x10000000000ULL);
 }
 
+static control_t test_static_snprintf(const size_t call_count)
+{
+    char buffer_baseline[100];
+    char buffer_static[100];
+    int result_baseline;
+    int result_static;
+    const char *str = "string";
+
+    result_static = MBED_STATIC_SNPRINTF(buffer_static, sizeof(buffer_static), "d: %d u: %u x: %x X: %X c: %c s: %.3s %%\r\n",
+                                         -1024, 4000000000U, 0xbeefU, 0xbeefU, 'c', str);
+    result_baseline = sprintf(buffer_baseline, "d: %d u: %u x: %x X: %X c: %c s: %.3s %%\r\n",
+                              -1024, 4000000000U, 0xbeefU, 0xbeefU, 'c', str);
+    TEST_ASSERT_EQUAL_STRING(buffer_baseline, buffer_static);
+    TEST_ASSERT_EQUAL_INT(result_baseline, result_static);
+
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+    result_static = MBED_STATIC_SNPRINTF(buffer_static, sizeof(buffer_static), "lld: %lld hhu: %hhu", -1099511627776LL, (unsigned char) 255);
+    result_baseline = sprintf(buffer_baseline, "lld: %lld hhu: %hhu", -1099511627776LL, (unsigned char) 255);
+    TEST_ASSERT_EQUAL_STRING(buffer_baseline, buffer_static);
+    TEST_ASSERT_EQUAL_INT(result_baseline, result_static);
+#endif
+
+    return CaseNext;
+}
+
+static control_t test_static_snprintf_buffer_overflow(const size_t call_count)
+{
+    char buffer_static[8];
+    int result_static;
+
+    result_static = MBED_STATIC_SNPRINTF(buffer_static, sizeof(buffer_static), "d: %d", 123456789);
+    TEST_ASSERT_EQUAL_STRING("d: 1234", buffer_static);
+    TEST_ASSERT_EQUAL_INT(sizeof("d: 123456789") - 1, result_static);
+
+    return CaseNext;
+}
+
 utest::v1::status_t greentea_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(30 * 60, "default_auto");
@@ -1072,6 +1110,8 @@ Case cases[] = {
     Case("printf %%", test_printf_percent),
     Case("snprintf %%", test_snprintf_percent),
     Case("snprintf unsupported specifier", test_snprintf_unsupported_specifier),
+    Case("static snprintf", test_static_snprintf),
+    Case("static snprintf buffer overflow", test_static_snprintf_buffer_overflow),
 #if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
     Case("printf %f", test_printf_f),
     Case("snprintf %f", test_snprintf_f),
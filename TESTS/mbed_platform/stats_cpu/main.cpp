@@ -79,6 +79,22 @@ void test_cpu_info(void)
     return;
 }
 
+#if defined(MBED_TICKLESS)
+void test_cpu_wakeups(void)
+{
+    mbed_stats_cpu_t before;
+    mbed_stats_cpu_t after;
+
+    mbed_stats_cpu_get(&before);
+    // Each sleep of the main thread ends on the OS timer
+    for (int i = 0; i < 10; i++) {
+        ThisThread::sleep_for(5);
+    }
+    mbed_stats_cpu_get(&after);
+    TEST_ASSERT_UINT32_WITHIN(2, 10, after.timer_wakeups - before.timer_wakeups);
+}
+#endif
+
 void test_cpu_load(void)
 {
 
@@ -102,6 +118,9 @@ void test_cpu_load(void)
 
 Case cases[] = {
     Case("Test CPU Info", test_cpu_info),
+#if defined(MBED_TICKLESS)
+    Case("Test CPU wake-ups", test_cpu_wakeups),
+#endif
     Case("Test CPU load", test_cpu_load)
 };
 
@@ -188,11 +188,59 @@ void test_case_realloc_size()
     TEST_ASSERT_EQUAL_UINT32(stats_start.current_size, stats_current.current_size);
 }
 
+#if MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS > 0 && MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS > 0
+#define MAX_EACH_ENTRIES (MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS + MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS + 2)
+
+static uint32_t each_current_size(mbed_stats_heap_each_t *stats, size_t count,
+                                  mbed_stats_heap_each_type_t type, uint32_t thread_id)
+{
+    uint32_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].type == type && (!thread_id || stats[i].thread_id == thread_id)) {
+            size += stats[i].current_size;
+        }
+    }
+    return size;
+}
+
+void test_case_get_each()
+{
+    mbed_stats_heap_each_t *stats = new mbed_stats_heap_each_t[MAX_EACH_ENTRIES];
+    mbed_stats_heap_t heap_stats;
+    uint32_t thread_id = (uint32_t)ThisThread::get_id();
+
+    size_t count = mbed_stats_heap_get_each(stats, MAX_EACH_ENTRIES);
+    TEST_ASSERT(count >= 2);
+    uint32_t thread_start = each_current_size(stats, count, MBED_STATS_HEAP_EACH_THREAD, thread_id);
+
+    void *data = malloc(ALLOCATION_SIZE_DEFAULT);
+    TEST_ASSERT(data != NULL);
+
+    // every allocation since boot is attributed to exactly one thread
+    // entry and one call site entry
+    count = mbed_stats_heap_get_each(stats, MAX_EACH_ENTRIES);
+    mbed_stats_heap_get(&heap_stats);
+    TEST_ASSERT_EQUAL_UINT32(heap_stats.current_size, each_current_size(stats, count, MBED_STATS_HEAP_EACH_THREAD, 0));
+    TEST_ASSERT_EQUAL_UINT32(heap_stats.current_size, each_current_size(stats, count, MBED_STATS_HEAP_EACH_CALLER, 0));
+    TEST_ASSERT_EQUAL_UINT32(thread_start + ALLOCATION_SIZE_DEFAULT,
+                             each_current_size(stats, count, MBED_STATS_HEAP_EACH_THREAD, thread_id));
+
+    free(data);
+    count = mbed_stats_heap_get_each(stats, MAX_EACH_ENTRIES);
+    TEST_ASSERT_EQUAL_UINT32(thread_start, each_current_size(stats, count, MBED_STATS_HEAP_EACH_THREAD, thread_id));
+
+    delete[] stats;
+}
+#endif
+
 Case cases[] = {
     Case("malloc and free size", test_case_malloc_free_size),
     Case("allocate size zero", test_case_allocate_zero),
     Case("allocation failure", test_case_allocate_fail),
     Case("realloc size", test_case_realloc_size),
+#if MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS > 0 && MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS > 0
+    Case("heap stats for each thread and call site", test_case_get_each),
+#endif
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
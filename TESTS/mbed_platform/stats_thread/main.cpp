@@ -156,11 +156,45 @@ void test_case_multi_threads_terminate()
     delete[] stats;
 }
 
+void busy_then_wait()
+{
+    wait_us(50000);
+    ef.wait_all(FLAG_SIGNAL_DEC);
+}
+
+void test_case_thread_cpu_time()
+{
+    mbed_stats_thread_t *stats = new mbed_stats_thread_t[MAX_THREAD_STATS];
+
+    Thread t1(osPriorityNormal1, TEST_STACK_SIZE, NULL, "Th1");
+    t1.start(busy_then_wait);
+    ThisThread::sleep_for(100);
+
+    int count = mbed_stats_thread_get_each(stats, MAX_THREAD_STATS);
+    bool found = false;
+    for (int i = 0; i < count; i++) {
+        if (0 == strcmp(stats[i].name, "Th1")) {
+#if DEVICE_USTICKER
+            // Ran for 50 ms, then blocked
+            TEST_ASSERT_INT_WITHIN(10000, 50000, (int)stats[i].cpu_time);
+#endif
+            found = true;
+            break;
+        }
+    }
+    TEST_ASSERT_TRUE(found);
+
+    ef.set(FLAG_SIGNAL_DEC);
+    t1.join();
+    delete[] stats;
+}
+
 Case cases[] = {
     Case("Single Thread Stats", test_case_single_thread_stats),
     Case("Less count value", test_case_less_count),
     Case("Multiple Threads blocked", test_case_multi_threads_blocked),
     Case("Multiple Threads terminate", test_case_multi_threads_terminate),
+    Case("Thread CPU time", test_case_thread_cpu_time),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
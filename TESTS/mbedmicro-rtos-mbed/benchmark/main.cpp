@@ -0,0 +1,304 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] RTOS benchmark requires RTOS support
+#elif !DEVICE_USTICKER
+#error [NOT_SUPPORTED] UsTicker need to be enabled for this test.
+#else
+
+/*
+ * Measures the cost of the RTOS primitives, in core cycles on cores with a
+ * DWT cycle counter and in microseconds otherwise. The results are printed
+ * as "BENCH" lines with the toolchain and core clock, so runs on different
+ * targets, toolchains or RTOS configurations can be compared.
+ *
+ * Operations between threads always wake a thread of higher priority, so
+ * each one includes the context switch to it.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define BENCH_ITERATIONS    1000
+#define BENCH_HANDOFFS      100
+#define BENCH_ISR_OPS       16
+#define THREAD_STACK_SIZE   512
+
+#if defined(__ARMCC_VERSION)
+#define BENCH_TOOLCHAIN "ARM"
+#elif defined(__ICCARM__)
+#define BENCH_TOOLCHAIN "IAR"
+#elif defined(__GNUC__)
+#define BENCH_TOOLCHAIN "GCC_ARM"
+#else
+#define BENCH_TOOLCHAIN "unknown"
+#endif
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define BENCH_UNIT "cycles"
+
+static void bench_timer_init()
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t bench_now()
+{
+    return DWT->CYCCNT;
+}
+#else
+#define BENCH_UNIT "us"
+
+static void bench_timer_init()
+{
+}
+
+static inline uint32_t bench_now()
+{
+    return us_ticker_read();
+}
+#endif
+
+static volatile uint32_t bench_start;
+static volatile uint32_t bench_total;
+static Semaphore bench_go(0);
+static Semaphore bench_done(0);
+
+static void bench_report(const char *name, uint32_t total, uint32_t ops)
+{
+    printf("BENCH %-28s %8lu " BENCH_UNIT "/op\n", name, (unsigned long)(total / ops));
+}
+
+void test_mutex_uncontended()
+{
+    Mutex mutex;
+
+    uint32_t start = bench_now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        mutex.lock();
+        mutex.unlock();
+    }
+    bench_report("Mutex lock/unlock", bench_now() - start, BENCH_ITERATIONS);
+}
+
+static Mutex contended_mutex;
+
+static void mutex_waiter()
+{
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        bench_go.acquire();
+        contended_mutex.lock();
+        bench_total += bench_now() - bench_start;
+        contended_mutex.unlock();
+    }
+}
+
+void test_mutex_contended()
+{
+    Thread waiter(osPriorityAboveNormal, THREAD_STACK_SIZE);
+    bench_total = 0;
+    waiter.start(mutex_waiter);
+
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        contended_mutex.lock();
+        // The waiter runs straight away and blocks on the mutex
+        bench_go.release();
+        bench_start = bench_now();
+        contended_mutex.unlock();
+    }
+
+    waiter.join();
+    bench_report("Mutex unlock to waiter", bench_total, BENCH_HANDOFFS);
+}
+
+void test_semaphore_uncontended()
+{
+    Semaphore sem(1);
+
+    uint32_t start = bench_now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        sem.acquire();
+        sem.release();
+    }
+    bench_report("Semaphore acquire/release", bench_now() - start, BENCH_ITERATIONS);
+}
+
+static Queue<uint32_t, BENCH_ISR_OPS> bench_queue;
+static uint32_t queue_value;
+
+static void queue_consumer()
+{
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        bench_queue.get();
+        bench_total += bench_now() - bench_start;
+    }
+}
+
+void test_queue_threads()
+{
+    Thread consumer(osPriorityAboveNormal, THREAD_STACK_SIZE);
+    bench_total = 0;
+    consumer.start(queue_consumer);
+
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        bench_start = bench_now();
+        TEST_ASSERT_EQUAL(osOK, bench_queue.put(&queue_value));
+    }
+
+    consumer.join();
+    bench_report("Queue put to get", bench_total, BENCH_HANDOFFS);
+}
+
+static void queue_isr_put()
+{
+    uint32_t start = bench_now();
+    for (int i = 0; i < BENCH_ISR_OPS; i++) {
+        bench_queue.put(&queue_value);
+    }
+    bench_total = bench_now() - start;
+    bench_done.release();
+}
+
+static void queue_isr_get()
+{
+    uint32_t start = bench_now();
+    for (int i = 0; i < BENCH_ISR_OPS; i++) {
+        bench_queue.get(0s);
+    }
+    bench_total = bench_now() - start;
+    bench_done.release();
+}
+
+void test_queue_isr()
+{
+    Timeout timeout;
+
+    timeout.attach(queue_isr_put, 1ms);
+    bench_done.acquire();
+    TEST_ASSERT_EQUAL(BENCH_ISR_OPS, bench_queue.count());
+    bench_report("Queue put from ISR", bench_total, BENCH_ISR_OPS);
+
+    timeout.attach(queue_isr_get, 1ms);
+    bench_done.acquire();
+    TEST_ASSERT_TRUE(bench_queue.empty());
+    bench_report("Queue get from ISR", bench_total, BENCH_ISR_OPS);
+}
+
+static osThreadId_t main_thread_id;
+
+static void switch_peer()
+{
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        ThisThread::flags_wait_any(1);
+        osThreadFlagsSet(main_thread_id, 1);
+    }
+}
+
+void test_context_switch()
+{
+    Thread peer(osPriorityAboveNormal, THREAD_STACK_SIZE);
+    main_thread_id = ThisThread::get_id();
+    peer.start(switch_peer);
+
+    // Each round switches to the peer and back
+    uint32_t start = bench_now();
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        peer.flags_set(1);
+        ThisThread::flags_wait_any(1);
+    }
+    uint32_t total = bench_now() - start;
+
+    peer.join();
+    bench_report("Context switch (flags)", total, 2 * BENCH_HANDOFFS);
+}
+
+static void event_handler()
+{
+    bench_total += bench_now() - bench_start;
+    bench_done.release();
+}
+
+void test_event_queue_latency()
+{
+    EventQueue queue(4 * EVENTS_EVENT_SIZE);
+    Thread dispatcher(osPriorityAboveNormal, THREAD_STACK_SIZE * 2);
+    dispatcher.start(callback(&queue, &EventQueue::dispatch_forever));
+    bench_total = 0;
+
+    for (int i = 0; i < BENCH_HANDOFFS; i++) {
+        bench_start = bench_now();
+        TEST_ASSERT_NOT_EQUAL(0, queue.call(event_handler));
+        bench_done.acquire();
+    }
+
+    queue.break_dispatch();
+    dispatcher.join();
+    bench_report("EventQueue post to dispatch", bench_total, BENCH_HANDOFFS);
+}
+
+void test_memory_pool()
+{
+    MemoryPool<uint32_t, 4> pool;
+
+    uint32_t start = bench_now();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t *block = pool.try_alloc();
+        pool.free(block);
+    }
+    bench_report("MemoryPool alloc/free", bench_now() - start, BENCH_ITERATIONS);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("RTOS benchmark: uncontended Mutex", test_mutex_uncontended, greentea_failure_handler),
+    Case("RTOS benchmark: contended Mutex", test_mutex_contended, greentea_failure_handler),
+    Case("RTOS benchmark: uncontended Semaphore", test_semaphore_uncontended, greentea_failure_handler),
+    Case("RTOS benchmark: Queue between threads", test_queue_threads, greentea_failure_handler),
+    Case("RTOS benchmark: Queue from ISR", test_queue_isr, greentea_failure_handler),
+    Case("RTOS benchmark: context switch", test_context_switch, greentea_failure_handler),
+    Case("RTOS benchmark: EventQueue latency", test_event_queue_latency, greentea_failure_handler),
+    Case("RTOS benchmark: MemoryPool", test_memory_pool, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    bench_timer_init();
+    printf("BENCH toolchain %s, core clock %lu Hz\n", BENCH_TOOLCHAIN, (unsigned long)SystemCoreClock);
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
@@ -294,6 +294,46 @@ void test_single_thread_lock(void)
     mutex.unlock();
 }
 
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+void test_mutex_stats_thread(Mutex *mutex)
+{
+    mutex->lock();
+    mutex->unlock();
+}
+
+/** Test mutex statistics
+
+    Given a mutex held by thread A for a while
+    When thread B calls @a lock on it
+    Then the statistics show one contended lock with the wait time
+        and the hold time of thread A
+*/
+void test_mutex_stats(void)
+{
+    Mutex mutex("stats");
+    Thread thread(osPriorityNormal1, TEST_STACK_SIZE);
+    mbed_stats_mutex_t stats;
+
+    mutex.lock();
+    thread.start(callback(test_mutex_stats_thread, &mutex));
+    ThisThread::sleep_for(TEST_LONG_DELAY);
+    mutex.unlock();
+    thread.join();
+
+    mutex.get_stats(&stats, true);
+    TEST_ASSERT_EQUAL_STRING("stats", stats.name);
+    TEST_ASSERT_EQUAL(2, stats.lock_cnt);
+    TEST_ASSERT_EQUAL(1, stats.contended_cnt);
+    TEST_ASSERT_INT_WITHIN(5000, 20000, stats.max_wait_time);
+    TEST_ASSERT_INT_WITHIN(5000, 20000, stats.max_hold_time);
+    TEST_ASSERT_EQUAL(ThisThread::get_id(), stats.max_hold_owner);
+
+    mutex.get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.lock_cnt);
+    TEST_ASSERT_EQUAL(0, stats.contended_cnt);
+}
+#endif
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -310,6 +350,9 @@ Case cases[] = {
     Case("Test dual thread second thread lock", test_dual_thread_nolock<test_dual_thread_nolock_lock_thread>),
     Case("Test dual thread second thread trylock", test_dual_thread_nolock<test_dual_thread_nolock_trylock_thread>),
     Case("Test multiple thread", test_multiple_threads),
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+    Case("Test mutex stats", test_mutex_stats),
+#endif
 };
 
 Specification specification(test_setup, cases);
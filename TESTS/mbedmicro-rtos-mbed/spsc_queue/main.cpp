@@ -0,0 +1,211 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] SPSCQueue test cases require RTOS with multithread to run
+#else
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] UsTicker need to be enabled for this test.
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+using namespace utest::v1;
+using namespace std::chrono;
+
+#define THREAD_STACK_SIZE 512
+#define TEST_UINT_MSG 0xDEADBEEF
+#define TEST_TIMEOUT 50ms
+#define STREAM_COUNT 1000
+
+void thread_put_uint_msg(SPSCQueue<uint32_t, 1> *q)
+{
+    ThisThread::sleep_for(TEST_TIMEOUT);
+    TEST_ASSERT_TRUE(q->try_put(TEST_UINT_MSG));
+}
+
+void thread_put_stream(SPSCQueue<uint32_t, 4> *q)
+{
+    for (uint32_t i = 0; i < STREAM_COUNT; i++) {
+        while (!q->try_put(i)) {
+            ThisThread::yield();
+        }
+    }
+}
+
+/** Test put and get
+
+    Given an empty queue
+    when an element is put
+    then the same element is retrieved and the queue is empty again
+ */
+void test_put_get()
+{
+    SPSCQueue<uint32_t, 1> q;
+    uint32_t v = 0;
+
+    TEST_ASSERT_TRUE(q.empty());
+    TEST_ASSERT_FALSE(q.try_get(&v));
+
+    TEST_ASSERT_TRUE(q.try_put(TEST_UINT_MSG));
+    TEST_ASSERT_EQUAL(1, q.count());
+
+    TEST_ASSERT_TRUE(q.try_get(&v));
+    TEST_ASSERT_EQUAL(TEST_UINT_MSG, v);
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+/** Test put to full queue
+
+    Given a queue of size 2
+    when two elements are put
+    then the queue is full, a third put fails, and elements come out in order
+ */
+void test_put_full()
+{
+    SPSCQueue<uint32_t, 2> q;
+    uint32_t v = 0;
+
+    TEST_ASSERT_TRUE(q.try_put(1));
+    TEST_ASSERT_TRUE(q.try_put(2));
+    TEST_ASSERT_TRUE(q.full());
+    TEST_ASSERT_FALSE(q.try_put(3));
+
+    TEST_ASSERT_TRUE(q.try_get(&v));
+    TEST_ASSERT_EQUAL(1, v);
+    TEST_ASSERT_TRUE(q.try_put(3));
+    TEST_ASSERT_TRUE(q.try_get(&v));
+    TEST_ASSERT_EQUAL(2, v);
+    TEST_ASSERT_TRUE(q.try_get(&v));
+    TEST_ASSERT_EQUAL(3, v);
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+/** Test in-place put and get
+
+    Given an empty queue
+    when an element is constructed in a reserved slot and committed
+    then the consumer sees it in place until it is popped
+ */
+void test_reserve_peek()
+{
+    SPSCQueue<uint32_t, 1> q;
+
+    TEST_ASSERT_NULL(q.try_peek());
+
+    uint32_t *slot = q.try_reserve();
+    TEST_ASSERT_NOT_NULL(slot);
+    *slot = TEST_UINT_MSG;
+    TEST_ASSERT_TRUE(q.empty());
+    q.commit();
+    TEST_ASSERT_NULL(q.try_reserve());
+
+    uint32_t *front = q.try_peek();
+    TEST_ASSERT_NOT_NULL(front);
+    TEST_ASSERT_EQUAL(TEST_UINT_MSG, *front);
+    q.pop();
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+/** Test get from empty queue with timeout
+
+    Given an empty queue
+    when try_get_for is called
+    then it times out after the given time
+ */
+void test_get_empty_timeout()
+{
+    SPSCQueue<uint32_t, 1> q;
+    Timer timer;
+    uint32_t v = 0;
+
+    timer.start();
+    TEST_ASSERT_FALSE(q.try_get_for(TEST_TIMEOUT, &v));
+    TEST_ASSERT_INT_WITHIN(5000, 50000, duration_cast<microseconds>(timer.elapsed_time()).count());
+}
+
+/** Test blocking get
+
+    Given an empty queue
+    when a thread puts an element after a delay
+    then a blocked consumer wakes up with that element
+ */
+void test_get_wakeup()
+{
+    SPSCQueue<uint32_t, 1> q;
+    Thread thread(osPriorityNormal, THREAD_STACK_SIZE);
+    uint32_t v = 0;
+
+    thread.start(callback(thread_put_uint_msg, &q));
+
+    TEST_ASSERT_TRUE(q.try_get_for(TEST_TIMEOUT * 2, &v));
+    TEST_ASSERT_EQUAL(TEST_UINT_MSG, v);
+
+    thread.join();
+}
+
+/** Test stream of elements
+
+    Given a small queue
+    when a thread puts a long sequence of elements
+    then the consumer receives all of them in order
+ */
+void test_stream()
+{
+    SPSCQueue<uint32_t, 4> q;
+    Thread thread(osPriorityNormal, THREAD_STACK_SIZE);
+    uint32_t v = 0;
+
+    thread.start(callback(thread_put_stream, &q));
+
+    for (uint32_t i = 0; i < STREAM_COUNT; i++) {
+        TEST_ASSERT_TRUE(q.try_get_for(TEST_TIMEOUT, &v));
+        TEST_ASSERT_EQUAL(i, v);
+    }
+
+    thread.join();
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test put and get", test_put_get),
+    Case("Test put full", test_put_full),
+    Case("Test reserve and peek", test_reserve_peek),
+    Case("Test get from empty queue timeout", test_get_empty_timeout),
+    Case("Test get wakes up on put", test_get_wakeup),
+    Case("Test stream of elements", test_stream)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER
+#endif // defined(MBED_RTOS_SINGLE_THREAD) || !defined(MBED_CONF_RTOS_PRESENT)
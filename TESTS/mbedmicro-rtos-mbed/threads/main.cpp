@@ -486,6 +486,25 @@ void test_thread_wait()
     TEST_ASSERT_DURATION_WITHIN(50ms, 150ms, timer.elapsed_time());
 }
 
+/** Testing thread microsecond wait
+
+    Given the thread is running
+    when the @a sleep_for_us function is called for less and more than a tick
+    then the thread sleeps for given amount of time, to better than a tick
+ */
+void test_thread_wait_us()
+{
+    Timer timer;
+    timer.start();
+
+    ThisThread::sleep_for_us(300us);
+    TEST_ASSERT_DURATION_WITHIN(200us, 300us, timer.elapsed_time());
+
+    timer.reset();
+    ThisThread::sleep_for_us(5500us);
+    TEST_ASSERT_DURATION_WITHIN(200us, 5500us, timer.elapsed_time());
+}
+
 /** Testing thread name
 
     Given a thread is started with a specified name
@@ -770,6 +789,61 @@ void test_thread_ext_stack()
     TEST_FAIL_MESSAGE("External stack was not used.");
 }
 
+/** Allocator with a single stack, counting its calls */
+class SingleStackAllocator : public ThreadStackAllocator {
+public:
+    void *allocate(uint32_t size) override
+    {
+        allocations++;
+        if (in_use || size > sizeof(stack)) {
+            return nullptr;
+        }
+        in_use = true;
+        return stack;
+    }
+
+    void deallocate(void *mem, uint32_t size) override
+    {
+        TEST_ASSERT_EQUAL_PTR(stack, mem);
+        in_use = false;
+    }
+
+    MBED_ALIGN(8) uint32_t stack[THREAD_STACK_SIZE / sizeof(uint32_t)];
+    bool in_use = false;
+    int allocations = 0;
+};
+
+/** Testing thread with a stack allocator
+
+    Given a thread created with a stack allocator
+    when the thread is started and destroyed
+    then its stack is taken from the allocator and given back to it
+    and a thread started while the allocator is empty fails with osErrorNoMemory
+ */
+void test_thread_stack_allocator()
+{
+    SingleStackAllocator allocator;
+
+    {
+        Thread t(osPriorityNormal, THREAD_STACK_SIZE, allocator);
+        Thread t2(osPriorityNormal, THREAD_STACK_SIZE, allocator);
+        TEST_ASSERT_EQUAL(0, allocator.allocations);
+
+        TEST_ASSERT_EQUAL(osOK, t.start(callback(use_some_stack)));
+        TEST_ASSERT_TRUE(allocator.in_use);
+        TEST_ASSERT_EQUAL(osErrorNoMemory, t2.start(callback(use_some_stack)));
+        t.join();
+        // The stack belongs to the thread until it is destroyed
+        TEST_ASSERT_TRUE(allocator.in_use);
+    }
+    TEST_ASSERT_FALSE(allocator.in_use);
+    TEST_ASSERT_EQUAL(2, allocator.allocations);
+
+    Thread t3(osPriorityNormal, THREAD_STACK_SIZE, allocator);
+    TEST_ASSERT_EQUAL(osOK, t3.start(callback(use_some_stack)));
+    t3.join();
+}
+
 /** Testing thread priority operations
 
     Given thread running with osPriorityNormal
@@ -837,6 +911,7 @@ static const case_t cases[] = {
 
     {"Testing thread stack info", test_thread_stack_info, DEFAULT_HANDLERS},
     {"Testing thread wait", test_thread_wait, DEFAULT_HANDLERS},
+    {"Testing thread microsecond wait", test_thread_wait_us, DEFAULT_HANDLERS},
     {"Testing thread name", test_thread_name, DEFAULT_HANDLERS},
 
     {"Testing thread states: deleted", test_deleted, DEFAULT_HANDLERS},
@@ -849,6 +924,7 @@ static const case_t cases[] = {
     {"Testing thread states: wait message put", test_msg_put, DEFAULT_HANDLERS},
 
     {"Testing thread with external stack memory", test_thread_ext_stack, DEFAULT_HANDLERS},
+    {"Testing thread with a stack allocator", test_thread_stack_allocator, DEFAULT_HANDLERS},
     {"Testing thread priority ops", test_thread_prio, DEFAULT_HANDLERS}
 
 };
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2020, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] WaitSet test cases require RTOS with multithread to run
+#elif !DEVICE_USTICKER
+#error [NOT_SUPPORTED] UsTicker need to be enabled for this test.
+#else
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using utest::v1::Case;
+using namespace std::chrono;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define THREAD_STACK_SIZE   512
+#else
+#define THREAD_STACK_SIZE   320 /* 512B stack on GCC_ARM compiler cause out of memory on some 16kB RAM boards e.g. NUCLEO_F070RB */
+#endif
+
+#define TEST_ASSERT_DURATION_WITHIN(delta, expected, actual) \
+    do { \
+        using ct = std::common_type_t<decltype(delta), decltype(expected), decltype(actual)>; \
+        TEST_ASSERT_INT_WITHIN(ct(delta).count(), ct(expected).count(), ct(actual).count()); \
+    } while (0)
+
+#define TEST_FLAG 0x4
+#define TEST_TIMEOUT 50ms
+
+static uint32_t message = 0xC0FFEE;
+
+/** Test that nothing is reported ready before anything happens
+
+    Given a WaitSet with an empty Queue, a Semaphore without tokens and clear EventFlags
+    when wait_for is called
+    then it times out and returns -1
+ */
+void test_timeout()
+{
+    Queue<uint32_t, 1> queue;
+    Semaphore sem(0);
+    EventFlags flags;
+    WaitSet set;
+
+    TEST_ASSERT_EQUAL(0, set.add(queue));
+    TEST_ASSERT_EQUAL(1, set.add(sem));
+    TEST_ASSERT_EQUAL(2, set.add(flags, TEST_FLAG));
+
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(-1, set.wait_for(TEST_TIMEOUT));
+    TEST_ASSERT_DURATION_WITHIN(10ms, TEST_TIMEOUT, timer.elapsed_time());
+}
+
+/** Test that an object ready before the wait is reported straight away
+
+    Given a WaitSet with a Semaphore that has a token
+    when wait is called
+    then the Semaphore's index is returned
+ */
+void test_already_ready()
+{
+    Semaphore idle(0);
+    Semaphore sem(1);
+    WaitSet set;
+
+    set.add(idle);
+    const int index = set.add(sem);
+
+    TEST_ASSERT_EQUAL(index, set.wait_for(0ms));
+    TEST_ASSERT_TRUE(sem.try_acquire());
+}
+
+static void put_message(Queue<uint32_t, 1> *queue)
+{
+    ThisThread::sleep_for(10ms);
+    queue->put(&message);
+}
+
+static void release_semaphore(Semaphore *sem)
+{
+    ThisThread::sleep_for(10ms);
+    sem->release();
+}
+
+static void set_flag(EventFlags *flags)
+{
+    ThisThread::sleep_for(10ms);
+    // A flag outside the mask must not wake the set
+    flags->set(TEST_FLAG << 1);
+    ThisThread::sleep_for(10ms);
+    flags->set(TEST_FLAG);
+}
+
+/** Test that the object made ready by another thread is reported
+
+    Given a WaitSet with a Queue, a Semaphore and EventFlags
+    when another thread makes one of them ready
+    then wait returns its index, and the object can be taken from without blocking
+ */
+void test_wake_from_thread()
+{
+    Queue<uint32_t, 1> queue;
+    Semaphore sem(0);
+    EventFlags flags;
+    WaitSet set;
+
+    const int queue_index = set.add(queue);
+    const int sem_index = set.add(sem);
+    const int flags_index = set.add(flags, TEST_FLAG);
+
+    {
+        Thread t(osPriorityNormal, THREAD_STACK_SIZE);
+        t.start(callback(put_message, &queue));
+        TEST_ASSERT_EQUAL(queue_index, set.wait());
+        osEvent evt = queue.get(0s);
+        TEST_ASSERT_EQUAL(osEventMessage, evt.status);
+        TEST_ASSERT_EQUAL_PTR(&message, evt.value.p);
+        t.join();
+    }
+    {
+        Thread t(osPriorityNormal, THREAD_STACK_SIZE);
+        t.start(callback(release_semaphore, &sem));
+        TEST_ASSERT_EQUAL(sem_index, set.wait());
+        TEST_ASSERT_TRUE(sem.try_acquire());
+        t.join();
+    }
+    {
+        Thread t(osPriorityNormal, THREAD_STACK_SIZE);
+        t.start(callback(set_flag, &flags));
+        TEST_ASSERT_EQUAL(flags_index, set.wait());
+        TEST_ASSERT_EQUAL(TEST_FLAG, flags.get() & TEST_FLAG);
+        t.join();
+    }
+}
+
+static Semaphore isr_sem(0);
+
+static void release_from_isr()
+{
+    isr_sem.release();
+}
+
+/** Test that an object made ready from an interrupt is reported
+
+    Given a WaitSet with a Semaphore
+    when the Semaphore is released from a Timeout handler
+    then wait returns its index
+ */
+void test_wake_from_isr()
+{
+    WaitSet set;
+    Timeout timeout;
+
+    const int index = set.add(isr_sem);
+    timeout.attach(release_from_isr, 10ms);
+    TEST_ASSERT_EQUAL(index, set.wait_for(1s));
+    TEST_ASSERT_TRUE(isr_sem.try_acquire());
+    set.remove(index);
+}
+
+/** Test that Mail is supported and ready objects are reported in turn
+
+    Given a WaitSet with two Mails that both have mail
+    when wait is called repeatedly without taking from them
+    then the indexes of both are returned in turn
+ */
+void test_mail_round_robin()
+{
+    Mail<uint32_t, 1> mail1;
+    Mail<uint32_t, 1> mail2;
+    WaitSet set;
+
+    const int index1 = set.add(mail1);
+    const int index2 = set.add(mail2);
+    TEST_ASSERT_EQUAL(osOK, mail1.put(mail1.alloc()));
+    TEST_ASSERT_EQUAL(osOK, mail2.put(mail2.alloc()));
+
+    TEST_ASSERT_EQUAL(index1, set.wait());
+    TEST_ASSERT_EQUAL(index2, set.wait());
+    TEST_ASSERT_EQUAL(index1, set.wait());
+}
+
+/** Test that removed objects are not reported
+
+    Given a WaitSet with a Semaphore that has a token
+    when the Semaphore is removed
+    then wait_for times out, and the index is reused by the next add
+ */
+void test_remove()
+{
+    Semaphore sem(1);
+    WaitSet set;
+
+    const int index = set.add(sem);
+    set.remove(index);
+    TEST_ASSERT_EQUAL(-1, set.wait_for(0ms));
+    TEST_ASSERT_EQUAL(index, set.add(sem));
+}
+
+/** Test that the set has its configured capacity
+
+    Given a WaitSet
+    when more objects than its capacity are added
+    then add returns -1 for the extra object
+ */
+void test_full()
+{
+    Semaphore sems[MBED_CONF_RTOS_WAIT_SET_CAPACITY + 1];
+    WaitSet set;
+
+    for (int i = 0; i < MBED_CONF_RTOS_WAIT_SET_CAPACITY; i++) {
+        TEST_ASSERT_EQUAL(i, set.add(sems[i]));
+    }
+    TEST_ASSERT_EQUAL(-1, set.add(sems[MBED_CONF_RTOS_WAIT_SET_CAPACITY]));
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test timeout", test_timeout),
+    Case("Test object ready before wait", test_already_ready),
+    Case("Test wake from thread", test_wake_from_thread),
+    Case("Test wake from ISR", test_wake_from_isr),
+    Case("Test Mail and round robin", test_mail_round_robin),
+    Case("Test remove", test_remove),
+    Case("Test full set", test_full)
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER
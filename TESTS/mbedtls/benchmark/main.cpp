@@ -0,0 +1,305 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Measures the primitives that target crypto engines accelerate through the
+ * MBEDTLS_*_ALT hooks of their mbedtls_device.h. Each result is tagged "hw"
+ * when the primitive is provided by the target and "sw" otherwise. To compare
+ * both on a target, run this test once as is and once with
+ * "target.macros_remove": ["MBEDTLS_CONFIG_HW_SUPPORT"] in mbed_app.json.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ccm.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecdh.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#define mbedtls_printf     printf
+#endif
+
+#define BENCH_BUFFER_SIZE   1024
+#define BENCH_ITERATIONS    64
+#define BENCH_PK_ITERATIONS 4
+
+#if defined(MBEDTLS_AES_ALT) || defined(MBEDTLS_AES_ENCRYPT_ALT)
+#define BENCH_AES_ENGINE "hw"
+#else
+#define BENCH_AES_ENGINE "sw"
+#endif
+
+#if defined(MBEDTLS_CCM_ALT)
+#define BENCH_CCM_ENGINE "hw"
+#else
+#define BENCH_CCM_ENGINE BENCH_AES_ENGINE
+#endif
+
+#if defined(MBEDTLS_GCM_ALT)
+#define BENCH_GCM_ENGINE "hw"
+#else
+#define BENCH_GCM_ENGINE BENCH_AES_ENGINE
+#endif
+
+#if defined(MBEDTLS_SHA256_ALT) || defined(MBEDTLS_SHA256_PROCESS_ALT)
+#define BENCH_SHA256_ENGINE "hw"
+#else
+#define BENCH_SHA256_ENGINE "sw"
+#endif
+
+#if defined(MBEDTLS_ECP_ALT) || defined(MBEDTLS_ECP_INTERNAL_ALT) || \
+    defined(MBEDTLS_ECDSA_SIGN_ALT) || defined(MBEDTLS_ECDSA_VERIFY_ALT) || \
+    defined(MBEDTLS_ECDH_COMPUTE_SHARED_ALT)
+#define BENCH_ECC_ENGINE "hw"
+#else
+#define BENCH_ECC_ENGINE "sw"
+#endif
+
+static unsigned char buf[BENCH_BUFFER_SIZE];
+static const unsigned char key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static const unsigned char iv[12] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88
+};
+
+static void bench_report(const char *name, const char *engine, Timer &timer, size_t bytes, int ops)
+{
+    uint32_t us = timer.read_us();
+    if (us == 0) {
+        us = 1;
+    }
+    if (bytes) {
+        mbedtls_printf("BENCH %-16s [%s] %8lu KiB/s\n", name, engine,
+                       (unsigned long)((uint64_t)bytes * 1000000 / 1024 / us));
+    } else {
+        mbedtls_printf("BENCH %-16s [%s] %8lu us/op\n", name, engine, (unsigned long)(us / ops));
+    }
+}
+
+#if defined(MBEDTLS_ECP_C)
+// Not a random number generator, only fills ECC blinding values and nonces for timing
+static int bench_rng(void *ctx, unsigned char *output, size_t len)
+{
+    uint32_t *state = (uint32_t *)ctx;
+    for (size_t i = 0; i < len; i++) {
+        *state ^= *state << 13;
+        *state ^= *state >> 17;
+        *state ^= *state << 5;
+        output[i] = (unsigned char)*state;
+    }
+    return 0;
+}
+#endif
+
+#if defined(MBEDTLS_CCM_C) && defined(MBEDTLS_AES_C)
+void test_bench_aes_ccm()
+{
+    mbedtls_ccm_context ctx;
+    unsigned char tag[16];
+    Timer timer;
+
+    mbedtls_ccm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128));
+
+    timer.start();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_ccm_encrypt_and_tag(&ctx, sizeof(buf), iv, sizeof(iv), NULL, 0,
+                                                         buf, buf, tag, sizeof(tag)));
+    }
+    timer.stop();
+
+    mbedtls_ccm_free(&ctx);
+    bench_report("AES-128-CCM", BENCH_CCM_ENGINE, timer, sizeof(buf) * BENCH_ITERATIONS, BENCH_ITERATIONS);
+}
+#endif
+
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+void test_bench_aes_gcm()
+{
+    mbedtls_gcm_context ctx;
+    unsigned char tag[16];
+    Timer timer;
+
+    mbedtls_gcm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128));
+
+    timer.start();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, sizeof(buf), iv, sizeof(iv),
+                                                       NULL, 0, buf, buf, sizeof(tag), tag));
+    }
+    timer.stop();
+
+    mbedtls_gcm_free(&ctx);
+    bench_report("AES-128-GCM", BENCH_GCM_ENGINE, timer, sizeof(buf) * BENCH_ITERATIONS, BENCH_ITERATIONS);
+}
+#endif
+
+#if defined(MBEDTLS_SHA256_C)
+void test_bench_sha256()
+{
+    mbedtls_sha256_context ctx;
+    unsigned char sum[32];
+    Timer timer;
+
+    mbedtls_sha256_init(&ctx);
+
+    // One stream fed in buffer sized chunks, as when hashing a firmware image
+    timer.start();
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_starts_ret(&ctx, 0));
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_update_ret(&ctx, buf, sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_finish_ret(&ctx, sum));
+    timer.stop();
+
+    mbedtls_sha256_free(&ctx);
+    bench_report("SHA-256", BENCH_SHA256_ENGINE, timer, sizeof(buf) * BENCH_ITERATIONS, BENCH_ITERATIONS);
+}
+#endif
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED) && defined(MBEDTLS_SHA256_C)
+void test_bench_ecdsa_p256()
+{
+    mbedtls_ecdsa_context ctx;
+    mbedtls_mpi r, s;
+    unsigned char hash[32];
+    uint32_t rng_state = 0x12345678;
+    Timer sign_timer, verify_timer;
+
+    mbedtls_ecdsa_init(&ctx);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_ret(buf, sizeof(buf), hash, 0));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_genkey(&ctx, MBEDTLS_ECP_DP_SECP256R1, bench_rng, &rng_state));
+
+    for (int i = 0; i < BENCH_PK_ITERATIONS; i++) {
+        sign_timer.start();
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_sign(&ctx.grp, &r, &s, &ctx.d, hash, sizeof(hash),
+                                                bench_rng, &rng_state));
+        sign_timer.stop();
+        verify_timer.start();
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_verify(&ctx.grp, hash, sizeof(hash), &ctx.Q, &r, &s));
+        verify_timer.stop();
+    }
+
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+    mbedtls_ecdsa_free(&ctx);
+    bench_report("ECDSA-P256 sign", BENCH_ECC_ENGINE, sign_timer, 0, BENCH_PK_ITERATIONS);
+    bench_report("ECDSA-P256 verify", BENCH_ECC_ENGINE, verify_timer, 0, BENCH_PK_ITERATIONS);
+}
+#endif
+
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+void test_bench_ecdh_p256()
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q;
+    mbedtls_mpi d, z;
+    uint32_t rng_state = 0x87654321;
+    Timer timer;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&z);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdh_gen_public(&grp, &d, &Q, bench_rng, &rng_state));
+
+    timer.start();
+    for (int i = 0; i < BENCH_PK_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_compute_shared(&grp, &z, &Q, &d, bench_rng, &rng_state));
+    }
+    timer.stop();
+
+    mbedtls_mpi_free(&z);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+    bench_report("ECDH-P256", BENCH_ECC_ENGINE, timer, 0, BENCH_PK_ITERATIONS);
+}
+#endif
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+#if defined(MBEDTLS_CCM_C) && defined(MBEDTLS_AES_C)
+    Case("Crypto benchmark: AES-CCM", test_bench_aes_ccm, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_GCM_C) && defined(MBEDTLS_AES_C)
+    Case("Crypto benchmark: AES-GCM", test_bench_aes_gcm, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_SHA256_C)
+    Case("Crypto benchmark: SHA-256", test_bench_sha256, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED) && defined(MBEDTLS_SHA256_C)
+    Case("Crypto benchmark: ECDSA P-256", test_bench_ecdsa_p256, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    Case("Crypto benchmark: ECDH P-256", test_bench_ecdh_p256, greentea_failure_handler),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    int ret = 0;
+#if defined(MBEDTLS_PLATFORM_C)
+    if ((ret = mbedtls_platform_setup(NULL)) != 0) {
+        mbedtls_printf("Mbed TLS benchmark failed! mbedtls_platform_setup returned %d\n", ret);
+        return 1;
+    }
+#endif
+    ret = (Harness::run(specification) ? 0 : 1);
+#if defined(MBEDTLS_PLATFORM_C)
+    mbedtls_platform_teardown(NULL);
+#endif
+    return ret;
+}
@@ -200,6 +200,69 @@ void pits_ps_write_once_test()
     TEST_ASSERT_EQUAL(PSA_STORAGE_FLAG_WRITE_ONCE, info.flags);
 }
 
+void pits_batch_test()
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint8_t write_buff[TEST_BUFF_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    uint8_t read_buff[TEST_BUFF_SIZE] = {0};
+    size_t actual_size;
+    struct psa_storage_info_t info = {0, 0};
+
+    status = psa_its_begin_batch();
+    if (status == PSA_ERROR_NOT_SUPPORTED) {
+        TEST_IGNORE_MESSAGE("ITS storage does not support batches");
+        return;
+    }
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = psa_its_begin_batch();
+    TEST_ASSERT_EQUAL(PSA_ERROR_BAD_STATE, status);
+
+    for (psa_storage_uid_t uid = 5; uid < 10; uid++) {
+        write_buff[0] = uid;
+        status = psa_its_set(uid, TEST_BUFF_SIZE, write_buff, 0);
+        TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+    }
+
+    // Not visible until committed
+    status = psa_its_get_info(5, &info);
+    TEST_ASSERT_EQUAL(PSA_ERROR_DOES_NOT_EXIST, status);
+
+    status = psa_its_commit_batch();
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    for (psa_storage_uid_t uid = 5; uid < 10; uid++) {
+        status = psa_its_get(uid, 0, TEST_BUFF_SIZE, read_buff, &actual_size);
+        TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+        TEST_ASSERT_EQUAL(uid, read_buff[0]);
+    }
+
+    // Aborted operations leave the items as they were
+    status = psa_its_begin_batch();
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = psa_its_remove(5);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    write_buff[0] = 0xFF;
+    status = psa_its_set(6, TEST_BUFF_SIZE, write_buff, 0);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = psa_its_abort_batch();
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = psa_its_commit_batch();
+    TEST_ASSERT_EQUAL(PSA_ERROR_BAD_STATE, status);
+
+    status = psa_its_get(5, 0, TEST_BUFF_SIZE, read_buff, &actual_size);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(5, read_buff[0]);
+
+    status = psa_its_get(6, 0, TEST_BUFF_SIZE, read_buff, &actual_size);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(6, read_buff[0]);
+}
+
 utest::v1::status_t case_its_teardown_handler(const Case *const source, const size_t passed, const size_t failed, const failure_t reason)
 {
     psa_status_t status;
@@ -228,6 +291,7 @@ utest::v1::status_t case_its_setup_handler(const Case *const source, const size_
 Case cases[] = {
     Case("PSA prot internal storage - Basic", case_its_setup_handler<its>, pits_ps_test<its>, case_its_teardown_handler),
     Case("PSA prot internal storage - Write-once", case_its_setup_handler<its>, pits_ps_write_once_test<its>, case_its_teardown_handler),
+    Case("PSA prot internal storage - Batch", case_its_setup_handler<its>, pits_batch_test, case_its_teardown_handler),
 #if COMPONENT_FLASHIAP
     Case("PSA protected storage - Basic", case_its_setup_handler<ps>, pits_ps_test<ps>),
     Case("PSA protected storage - Write-once", case_its_setup_handler<ps>, pits_ps_write_once_test<ps>)
@@ -0,0 +1,1015 @@
+/*
+ * Copyright (c) 2020 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <limits.h>
+#include <string.h>
+#include <stdlib.h>
+#include "mbed-client-cli/ns_cmdline.h"
+#include "rtos/Thread.h"
+#include "ble/gap/AdvertisingDataParser.h"
+#include "BLEBenchmark.h"
+
+using namespace ble;
+
+// UUIDs of the benchmark service and its characteristics
+#define BENCHMARK_SERVICE_UUID "3a4b0000-5c1d-4e8f-9a61-7b2c8d9e0f10"
+#define BENCHMARK_TX_UUID      "3a4b0001-5c1d-4e8f-9a61-7b2c8d9e0f10"
+#define BENCHMARK_RX_UUID      "3a4b0002-5c1d-4e8f-9a61-7b2c8d9e0f10"
+#define BENCHMARK_CTRL_UUID    "3a4b0003-5c1d-4e8f-9a61-7b2c8d9e0f10"
+
+// Packets handed to the stack and not confirmed yet; bounds the memory used
+// by the stack whether or not the port reports a busy status.
+#define MAX_PACKETS_IN_FLIGHT 8
+
+// Time given to the last packets of a stream to arrive
+#define DRAIN_TIME_MS 500
+
+#define CONFIG_TIMEOUT_MS 10000
+
+#define ATT_HEADER_SIZE 3
+
+#define DEFAULT_ATT_MTU 23
+
+events::EventQueue BLEBenchmark::_bleQueue(32 * EVENTS_EVENT_SIZE);
+
+static rtos::Thread bleThread;
+
+static const char *phy_to_string(phy_t phy)
+{
+    switch (phy.value()) {
+        case phy_t::LE_2M:
+            return "2M";
+        case phy_t::LE_CODED:
+            return "coded";
+        default:
+            return "1M";
+    }
+}
+
+void BLEBenchmark::cpu_sample_t::start()
+{
+    mbed_stats_cpu_get(&stats);
+}
+
+unsigned BLEBenchmark::cpu_sample_t::load() const
+{
+    mbed_stats_cpu_t now;
+    mbed_stats_cpu_get(&now);
+
+    us_timestamp_t uptime = now.uptime - stats.uptime;
+    us_timestamp_t idle = now.idle_time - stats.idle_time;
+    if (uptime == 0 || idle > uptime) {
+        return 0;
+    }
+    return (unsigned)(((uptime - idle) * 100) / uptime);
+}
+
+BLEBenchmark::BLEBenchmark() :
+    _ble(BLE::Instance()),
+    _state(STATE_IDLE),
+    _connection(0),
+    _is_central(false),
+    _att_mtu(DEFAULT_ATT_MTU),
+    _requested_mtu(BENCHMARK_MAX_PAYLOAD + ATT_HEADER_SIZE),
+    _phy(phy_t::LE_1M),
+    _interval(0),
+    _config_pending(0),
+    _config_status(BLE_ERROR_NONE),
+    _config_timeout_id(0),
+    _tx_handle(0),
+    _rx_handle(0),
+    _ctrl_handle(0),
+    _rx_bytes(0),
+    _setup_us(0),
+    _duration_ms(0),
+    _deadline_us(0),
+    _first_us(0),
+    _last_us(0),
+    _bytes(0),
+    _packets(0),
+    _count(0),
+    _latency_start_us(0),
+    _latency_min_us(0),
+    _latency_max_us(0),
+    _latency_sum_us(0)
+{
+    for (size_t i = 0; i < sizeof(_tx_value); ++i) {
+        _tx_value[i] = i;
+    }
+    memset(_rx_value, 0, sizeof(_rx_value));
+    memset(_ctrl_value, 0, sizeof(_ctrl_value));
+
+    _timer.start();
+
+    osStatus status = bleThread.start(mbed::callback(&BLEBenchmark::ble_routine));
+    MBED_ASSERT(status == osOK);
+
+    _ble.onEventsToProcess(
+        makeFunctionPointer(this, &BLEBenchmark::schedule_ble_events)
+    );
+    _bleQueue.call(this, &BLEBenchmark::init);
+}
+
+BLEBenchmark &BLEBenchmark::instance()
+{
+    static BLEBenchmark benchmark;
+    return benchmark;
+}
+
+void BLEBenchmark::ble_routine()
+{
+    _bleQueue.dispatch_forever();
+}
+
+void BLEBenchmark::init()
+{
+    _ble.init(this, &BLEBenchmark::on_init_complete);
+}
+
+void BLEBenchmark::schedule_ble_events(BLE::OnEventsToProcessCallbackContext *context)
+{
+    _bleQueue.call(mbed::callback(&context->ble, &BLE::processEvents));
+}
+
+void BLEBenchmark::on_init_complete(BLE::InitializationCompleteCallbackContext *context)
+{
+    if (context->error) {
+        cmd_printf("BLE init failed: %d\r\n", context->error);
+        return;
+    }
+
+    _ble.gap().setEventHandler(this);
+    _ble.gattServer().setEventHandler(this);
+    _ble.gattClient().setEventHandler(this);
+
+    _ble.gattServer().onDataWritten(this, &BLEBenchmark::on_server_data_written);
+    _ble.gattServer().onDataSent(this, &BLEBenchmark::on_server_data_sent);
+    _ble.gattClient().onDataWritten(makeFunctionPointer(this, &BLEBenchmark::on_client_data_written));
+    _ble.gattClient().onDataRead(makeFunctionPointer(this, &BLEBenchmark::on_client_data_read));
+    _ble.gattClient().onHVX(makeFunctionPointer(this, &BLEBenchmark::on_hvx));
+    _ble.gattClient().onServiceDiscoveryTermination(
+        makeFunctionPointer(this, &BLEBenchmark::on_discovery_termination)
+    );
+
+    setup_service();
+
+    cmd_printf("BLE initialized\r\n");
+}
+
+void BLEBenchmark::setup_service()
+{
+    static GattCharacteristic tx(
+        UUID(BENCHMARK_TX_UUID), _tx_value, 0, sizeof(_tx_value),
+        GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_NOTIFY
+    );
+    static GattCharacteristic rx(
+        UUID(BENCHMARK_RX_UUID), _rx_value, 0, sizeof(_rx_value),
+        GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_WRITE |
+        GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_WRITE_WITHOUT_RESPONSE
+    );
+    static GattCharacteristic ctrl(
+        UUID(BENCHMARK_CTRL_UUID), _ctrl_value, sizeof(_ctrl_value), sizeof(_ctrl_value),
+        GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_READ |
+        GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_WRITE
+    );
+    static GattCharacteristic *characteristics[] = { &tx, &rx, &ctrl };
+    static GattService service(
+        UUID(BENCHMARK_SERVICE_UUID),
+        characteristics,
+        sizeof(characteristics) / sizeof(characteristics[0])
+    );
+
+    ble_error_t error = _ble.gattServer().addService(service);
+    if (error) {
+        cmd_printf("adding benchmark service failed: %d\r\n", error);
+        return;
+    }
+
+    _tx_handle = tx.getValueHandle();
+    _rx_handle = rx.getValueHandle();
+    _ctrl_handle = ctrl.getValueHandle();
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int BLEBenchmark::cmd_peripheral(int argc, char *argv[])
+{
+    _bleQueue.call(&instance(), &BLEBenchmark::peripheral);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+int BLEBenchmark::cmd_connect(int argc, char *argv[])
+{
+    _bleQueue.call(&instance(), &BLEBenchmark::connect);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+int BLEBenchmark::cmd_config(int argc, char *argv[])
+{
+    char *phy_name = NULL;
+    int32_t mtu = 0;
+    int32_t interval = 0;
+    phy_t phy = phy_t::LE_1M;
+    bool set_phy = false;
+
+    if (cmd_parameter_val(argc, argv, "--phy", &phy_name)) {
+        if (strcmp(phy_name, "1M") == 0) {
+            phy = phy_t::LE_1M;
+        } else if (strcmp(phy_name, "2M") == 0) {
+            phy = phy_t::LE_2M;
+        } else if (strcmp(phy_name, "coded") == 0) {
+            phy = phy_t::LE_CODED;
+        } else {
+            cmd_printf("invalid phy '%s', expected 1M, 2M or coded\r\n", phy_name);
+            return CMDLINE_RETCODE_INVALID_PARAMETERS;
+        }
+        set_phy = true;
+    }
+
+    if (cmd_parameter_int(argc, argv, "--mtu", &mtu) &&
+        (mtu < DEFAULT_ATT_MTU || mtu > BENCHMARK_MAX_PAYLOAD + ATT_HEADER_SIZE)) {
+        cmd_printf("invalid mtu %ld\r\n", (long) mtu);
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+
+    if (cmd_parameter_int(argc, argv, "--interval", &interval) &&
+        (interval < conn_interval_t::MIN || interval > conn_interval_t::MAX)) {
+        cmd_printf("invalid interval %ld\r\n", (long) interval);
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+
+    _bleQueue.call(&instance(), &BLEBenchmark::config, phy, set_phy, (uint16_t) mtu, (uint16_t) interval);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+int BLEBenchmark::cmd_notify(int argc, char *argv[])
+{
+    if (argc < 2) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _bleQueue.call(&instance(), &BLEBenchmark::start_notify_test, (uint32_t) strtoul(argv[1], NULL, 10));
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+int BLEBenchmark::cmd_write(int argc, char *argv[])
+{
+    if (argc < 2) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _bleQueue.call(&instance(), &BLEBenchmark::start_write_test, (uint32_t) strtoul(argv[1], NULL, 10));
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+int BLEBenchmark::cmd_latency(int argc, char *argv[])
+{
+    if (argc < 2) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _bleQueue.call(&instance(), &BLEBenchmark::start_latency_test, (uint32_t) strtoul(argv[1], NULL, 10));
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+int BLEBenchmark::cmd_disconnect(int argc, char *argv[])
+{
+    _bleQueue.call(&instance(), &BLEBenchmark::disconnect);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+void BLEBenchmark::finish(int retcode)
+{
+    if (_state != STATE_IDLE && _state != STATE_ADVERTISING) {
+        _state = STATE_CONNECTED;
+    }
+    cmd_ready(retcode);
+}
+
+uint16_t BLEBenchmark::payload_size() const
+{
+    uint16_t mtu = _att_mtu < _requested_mtu ? _att_mtu : _requested_mtu;
+    return mtu - ATT_HEADER_SIZE;
+}
+
+void BLEBenchmark::peripheral()
+{
+    if (_state != STATE_IDLE) {
+        cmd_printf("busy\r\n");
+        cmd_ready(CMDLINE_RETCODE_INVALID_PARAMETERS);
+        return;
+    }
+
+    uint8_t adv_buffer[LEGACY_ADVERTISING_MAX_SIZE];
+    AdvertisingDataBuilder adv_data(adv_buffer);
+    adv_data.setFlags();
+    adv_data.setName(BENCHMARK_DEVICE_NAME);
+
+    ble_error_t error = _ble.gap().setAdvertisingParameters(
+        LEGACY_ADVERTISING_HANDLE,
+        AdvertisingParameters(advertising_type_t::CONNECTABLE_UNDIRECTED, adv_interval_t(32), adv_interval_t(32))
+    );
+    if (!error) {
+        error = _ble.gap().setAdvertisingPayload(LEGACY_ADVERTISING_HANDLE, adv_data.getAdvertisingData());
+    }
+    if (!error) {
+        error = _ble.gap().startAdvertising(LEGACY_ADVERTISING_HANDLE);
+    }
+
+    if (error) {
+        cmd_printf("advertising failed: %d\r\n", error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    _is_central = false;
+    _state = STATE_ADVERTISING;
+    cmd_printf("advertising as %s\r\n", BENCHMARK_DEVICE_NAME);
+    cmd_ready(CMDLINE_RETCODE_SUCCESS);
+}
+
+void BLEBenchmark::connect()
+{
+    if (_state != STATE_IDLE) {
+        cmd_printf("busy\r\n");
+        cmd_ready(CMDLINE_RETCODE_INVALID_PARAMETERS);
+        return;
+    }
+
+    ble_error_t error = _ble.gap().setScanParameters(
+        ScanParameters(phy_t::LE_1M, scan_interval_t(80), scan_window_t(80), false)
+    );
+    if (!error) {
+        error = _ble.gap().startScan();
+    }
+
+    if (error) {
+        cmd_printf("scan failed: %d\r\n", error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    _is_central = true;
+    _state = STATE_SCANNING;
+}
+
+void BLEBenchmark::config(phy_t phy, bool set_phy, uint16_t mtu, uint16_t interval)
+{
+    if (_state != STATE_CONNECTED || !_is_central) {
+        cmd_printf("not connected as central\r\n");
+        cmd_ready(CMDLINE_RETCODE_INVALID_PARAMETERS);
+        return;
+    }
+
+    _state = STATE_CONFIGURING;
+    _config_pending = 0;
+    _config_status = BLE_ERROR_NONE;
+
+    if (set_phy) {
+        phy_set_t phys(phy);
+        ble_error_t error = _ble.gap().setPhy(_connection, &phys, &phys, coded_symbol_per_bit_t::UNDEFINED);
+        if (error) {
+            _config_status = error;
+        } else {
+            _config_pending++;
+        }
+    }
+
+    if (mtu) {
+        _requested_mtu = mtu;
+        // the ATT_MTU is negotiated once per connection, the requested value
+        // then only bounds the size of the payload used by the tests
+        if (_att_mtu == DEFAULT_ATT_MTU && mtu > DEFAULT_ATT_MTU) {
+            ble_error_t error = _ble.gattClient().negotiateAttMtu(_connection);
+            if (error) {
+                _config_status = error;
+            } else {
+                _config_pending++;
+            }
+        }
+    }
+
+    if (interval) {
+        ble_error_t error = _ble.gap().updateConnectionParameters(
+            _connection,
+            conn_interval_t(interval),
+            conn_interval_t(interval),
+            slave_latency_t(0),
+            supervision_timeout_t(500)
+        );
+        if (error) {
+            _config_status = error;
+        } else {
+            _config_pending++;
+        }
+    }
+
+    if (_config_pending) {
+        _config_timeout_id = _bleQueue.call_in(CONFIG_TIMEOUT_MS, this, &BLEBenchmark::config_timeout);
+    } else {
+        config_step_done(_config_status);
+    }
+}
+
+void BLEBenchmark::config_step_done(ble_error_t status)
+{
+    if (_state != STATE_CONFIGURING) {
+        return;
+    }
+
+    if (status) {
+        _config_status = status;
+    }
+
+    if (_config_pending) {
+        _config_pending--;
+    }
+
+    if (_config_pending) {
+        return;
+    }
+
+    _bleQueue.cancel(_config_timeout_id);
+
+    cmd_printf(
+        "BENCH:{\"test\":\"config\",\"status\":%d,\"phy\":\"%s\",\"att_mtu\":%u,\"payload\":%u,\"interval\":%u}\r\n",
+        _config_status,
+        phy_to_string(_phy),
+        _att_mtu,
+        payload_size(),
+        _interval
+    );
+
+    finish(_config_status ? CMDLINE_RETCODE_FAIL : CMDLINE_RETCODE_SUCCESS);
+}
+
+void BLEBenchmark::config_timeout()
+{
+    _config_pending = 1;
+    config_step_done(BLE_ERROR_INTERNAL_STACK_FAILURE);
+}
+
+bool BLEBenchmark::write_ctrl(ctrl_opcode_t opcode, uint32_t duration_ms)
+{
+    uint8_t command[5] = {
+        (uint8_t) opcode,
+        (uint8_t) duration_ms,
+        (uint8_t) (duration_ms >> 8),
+        (uint8_t) (duration_ms >> 16),
+        (uint8_t) (duration_ms >> 24)
+    };
+
+    ble_error_t error = _remote_ctrl.write(sizeof(command), command);
+    if (error) {
+        cmd_printf("control write failed: %d\r\n", error);
+        return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+void BLEBenchmark::start_notify_test(uint32_t duration_ms)
+{
+    if (_state != STATE_CONNECTED || !_is_central) {
+        cmd_printf("not connected as central\r\n");
+        cmd_ready(CMDLINE_RETCODE_INVALID_PARAMETERS);
+        return;
+    }
+
+    _state = STATE_NOTIFY_TEST;
+    _duration_ms = duration_ms;
+    _bytes = 0;
+    _packets = 0;
+    _first_us = 0;
+    _last_us = 0;
+
+    if (!write_ctrl(CTRL_START_NOTIFY, duration_ms)) {
+        finish(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    _cpu.start();
+    _bleQueue.call_in(duration_ms + DRAIN_TIME_MS, this, &BLEBenchmark::notify_test_done);
+}
+
+void BLEBenchmark::send_notifications()
+{
+    // peripheral side of the notification test
+    while (_count < MAX_PACKETS_IN_FLIGHT && _timer.read_us() < _deadline_us) {
+        ble_error_t error = _ble.gattServer().write(_connection, _tx_handle, _tx_value, payload_size());
+        if (error) {
+            break;
+        }
+        _tx_value[0]++;
+        _count++;
+        _packets++;
+        _bytes += payload_size();
+    }
+
+    // the stream ends once every packet sent has been confirmed
+    if (_count == 0) {
+        int elapsed_us = _timer.read_us() - _first_us;
+        cmd_printf(
+            "BENCH:{\"test\":\"notify_tx\",\"phy\":\"%s\",\"att_mtu\":%u,\"payload\":%u,\"interval\":%u,"
+            "\"duration_us\":%d,\"packets\":%lu,\"bytes\":%lu,\"cpu_load\":%u}\r\n",
+            phy_to_string(_phy),
+            _att_mtu,
+            payload_size(),
+            _interval,
+            elapsed_us,
+            (unsigned long) _packets,
+            (unsigned long) _bytes,
+            _cpu.load()
+        );
+        _state = STATE_CONNECTED;
+    }
+}
+
+void BLEBenchmark::notify_test_done()
+{
+    int duration_us = _last_us - _first_us;
+    uint32_t kbps = 0;
+    if (duration_us > 0) {
+        kbps = (uint32_t)(((uint64_t) _bytes * 8 * 1000) / duration_us);
+    }
+
+    cmd_printf(
+        "BENCH:{\"test\":\"notify\",\"phy\":\"%s\",\"att_mtu\":%u,\"payload\":%u,\"interval\":%u,"
+        "\"duration_us\":%d,\"packets\":%lu,\"bytes\":%lu,\"throughput_kbps\":%lu,\"cpu_load\":%u}\r\n",
+        phy_to_string(_phy),
+        _att_mtu,
+        payload_size(),
+        _interval,
+        duration_us,
+        (unsigned long) _packets,
+        (unsigned long) _bytes,
+        (unsigned long) kbps,
+        _cpu.load()
+    );
+
+    finish(_bytes ? CMDLINE_RETCODE_SUCCESS : CMDLINE_RETCODE_FAIL);
+}
+
+void BLEBenchmark::start_write_test(uint32_t duration_ms)
+{
+    if (_state != STATE_CONNECTED || !_is_central) {
+        cmd_printf("not connected as central\r\n");
+        cmd_ready(CMDLINE_RETCODE_INVALID_PARAMETERS);
+        return;
+    }
+
+    _state = STATE_WRITE_TEST;
+    _duration_ms = duration_ms;
+    _bytes = 0;
+    _packets = 0;
+    _count = 0;
+    _deadline_us = 0;
+
+    // the stream starts once the peripheral acknowledged the reset of its counter
+    if (!write_ctrl(CTRL_RESET_RX, 0)) {
+        finish(CMDLINE_RETCODE_FAIL);
+    }
+}
+
+void BLEBenchmark::send_write_commands()
+{
+    while (_count < MAX_PACKETS_IN_FLIGHT && _timer.read_us() < _deadline_us) {
+        ble_error_t error = _ble.gattClient().write(
+            GattClient::GATT_OP_WRITE_CMD,
+            _connection,
+            _remote_rx.getValueHandle(),
+            payload_size(),
+            _tx_value
+        );
+        if (error) {
+            break;
+        }
+        _tx_value[0]++;
+        _count++;
+        _packets++;
+        _bytes += payload_size();
+    }
+
+    if (_count == 0) {
+        _last_us = _timer.read_us();
+        // let the last packets reach the peer before reading its counter
+        _bleQueue.call_in(DRAIN_TIME_MS, this, &BLEBenchmark::write_test_done);
+    }
+}
+
+void BLEBenchmark::write_test_done()
+{
+    ble_error_t error = _remote_ctrl.read();
+    if (error) {
+        cmd_printf("control read failed: %d\r\n", error);
+        finish(CMDLINE_RETCODE_FAIL);
+    }
+}
+
+void BLEBenchmark::start_latency_test(uint32_t count)
+{
+    if (_state != STATE_CONNECTED || !_is_central || count == 0) {
+        cmd_printf("not connected as central\r\n");
+        cmd_ready(CMDLINE_RETCODE_INVALID_PARAMETERS);
+        return;
+    }
+
+    _state = STATE_LATENCY_TEST;
+    _count = count;
+    _packets = 0;
+    _latency_min_us = INT_MAX;
+    _latency_max_us = 0;
+    _latency_sum_us = 0;
+    _cpu.start();
+
+    send_latency_write();
+}
+
+void BLEBenchmark::send_latency_write()
+{
+    _latency_start_us = _timer.read_us();
+    ble_error_t error = _remote_rx.write(payload_size(), _tx_value);
+    if (error) {
+        cmd_printf("write failed: %d\r\n", error);
+        finish(CMDLINE_RETCODE_FAIL);
+    }
+}
+
+void BLEBenchmark::disconnect()
+{
+    if (_state == STATE_IDLE) {
+        cmd_ready(CMDLINE_RETCODE_SUCCESS);
+        return;
+    }
+
+    if (_state == STATE_ADVERTISING) {
+        _ble.gap().stopAdvertising(LEGACY_ADVERTISING_HANDLE);
+        _state = STATE_IDLE;
+        cmd_ready(CMDLINE_RETCODE_SUCCESS);
+        return;
+    }
+
+    if (_state == STATE_SCANNING) {
+        _ble.gap().stopScan();
+        _state = STATE_IDLE;
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    ble_error_t error = _ble.gap().disconnect(_connection, local_disconnection_reason_t::USER_TERMINATION);
+    if (error) {
+        cmd_printf("disconnect failed: %d\r\n", error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+    _state = STATE_DISCONNECTING;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+void BLEBenchmark::onAdvertisingReport(const AdvertisingReportEvent &event)
+{
+    if (_state != STATE_SCANNING || !event.getType().connectable()) {
+        return;
+    }
+
+    AdvertisingDataParser parser(event.getPayload());
+    while (parser.hasNext()) {
+        AdvertisingDataParser::element_t field = parser.next();
+        if (field.type != adv_data_type_t::COMPLETE_LOCAL_NAME ||
+            field.value.size() != strlen(BENCHMARK_DEVICE_NAME) ||
+            memcmp(field.value.data(), BENCHMARK_DEVICE_NAME, field.value.size()) != 0) {
+            continue;
+        }
+
+        _ble.gap().stopScan();
+
+        // connection setup time runs from the connection request to the
+        // subscription to the notifications of the peer
+        _setup_us = _timer.read_us();
+        ble_error_t error = _ble.gap().connect(
+            event.getPeerAddressType(),
+            event.getPeerAddress(),
+            ConnectionParameters()
+        );
+        if (error) {
+            cmd_printf("connect failed: %d\r\n", error);
+            _state = STATE_IDLE;
+            cmd_ready(CMDLINE_RETCODE_FAIL);
+            return;
+        }
+
+        _state = STATE_CONNECTING;
+        return;
+    }
+}
+
+void BLEBenchmark::onConnectionComplete(const ConnectionCompleteEvent &event)
+{
+    if (event.getStatus() != BLE_ERROR_NONE) {
+        if (_state == STATE_CONNECTING) {
+            cmd_printf("connection failed: %d\r\n", event.getStatus());
+            _state = STATE_IDLE;
+            cmd_ready(CMDLINE_RETCODE_FAIL);
+        }
+        return;
+    }
+
+    _connection = event.getConnectionHandle();
+    _interval = event.getConnectionInterval().value();
+    _att_mtu = DEFAULT_ATT_MTU;
+    _phy = phy_t::LE_1M;
+
+    if (event.getOwnRole() == connection_role_t::PERIPHERAL) {
+        _state = STATE_CONNECTED;
+        cmd_printf("BENCH:{\"event\":\"connected\",\"role\":\"peripheral\",\"interval\":%u}\r\n", _interval);
+        return;
+    }
+
+    _setup_us = _timer.read_us() - _setup_us;
+    _first_us = _timer.read_us();
+    _state = STATE_DISCOVERING;
+
+    ble_error_t error = _ble.gattClient().launchServiceDiscovery(
+        _connection,
+        NULL,
+        makeFunctionPointer(this, &BLEBenchmark::on_characteristic_discovered),
+        UUID(BENCHMARK_SERVICE_UUID)
+    );
+    if (error) {
+        cmd_printf("service discovery failed: %d\r\n", error);
+        finish(CMDLINE_RETCODE_FAIL);
+    }
+}
+
+void BLEBenchmark::onDisconnectionComplete(const DisconnectionCompleteEvent &event)
+{
+    state_t state = _state;
+    _state = STATE_IDLE;
+
+    cmd_printf("BENCH:{\"event\":\"disconnected\",\"reason\":%d}\r\n", event.getReason().value());
+
+    if (_is_central) {
+        cmd_ready(state == STATE_DISCONNECTING ? CMDLINE_RETCODE_SUCCESS : CMDLINE_RETCODE_FAIL);
+    }
+}
+
+void BLEBenchmark::onConnectionParametersUpdateComplete(const ConnectionParametersUpdateCompleteEvent &event)
+{
+    if (event.getStatus() == BLE_ERROR_NONE) {
+        _interval = event.getConnectionInterval().value();
+    }
+    config_step_done(event.getStatus());
+}
+
+void BLEBenchmark::onPhyUpdateComplete(
+    ble_error_t status,
+    connection_handle_t connectionHandle,
+    phy_t txPhy,
+    phy_t rxPhy
+)
+{
+    if (status == BLE_ERROR_NONE) {
+        _phy = txPhy;
+    }
+    config_step_done(status);
+}
+
+void BLEBenchmark::onAttMtuChange(connection_handle_t connectionHandle, uint16_t attMtuSize)
+{
+    _att_mtu = attMtuSize;
+    config_step_done(BLE_ERROR_NONE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+void BLEBenchmark::on_server_data_written(const GattWriteCallbackParams *params)
+{
+    if (params->handle == _rx_handle) {
+        _rx_bytes += params->len;
+        uint8_t value[4] = {
+            (uint8_t) _rx_bytes,
+            (uint8_t) (_rx_bytes >> 8),
+            (uint8_t) (_rx_bytes >> 16),
+            (uint8_t) (_rx_bytes >> 24)
+        };
+        _ble.gattServer().write(_ctrl_handle, value, sizeof(value), true);
+        return;
+    }
+
+    if (params->handle != _ctrl_handle || params->len != sizeof(_ctrl_value)) {
+        return;
+    }
+
+    uint32_t duration_ms = params->data[1] |
+        (params->data[2] << 8) |
+        (params->data[3] << 16) |
+        ((uint32_t) params->data[4] << 24);
+
+    switch (params->data[0]) {
+        case CTRL_START_NOTIFY:
+            _state = STATE_NOTIFY_TEST;
+            _count = 0;
+            _packets = 0;
+            _bytes = 0;
+            _cpu.start();
+            _first_us = _timer.read_us();
+            _deadline_us = _first_us + duration_ms * 1000;
+            send_notifications();
+            break;
+        case CTRL_RESET_RX:
+            _rx_bytes = 0;
+            _cpu.start();
+            break;
+        default:
+            break;
+    }
+}
+
+void BLEBenchmark::on_server_data_sent(unsigned count)
+{
+    if (_state != STATE_NOTIFY_TEST || _is_central) {
+        return;
+    }
+
+    _count = count > _count ? 0 : _count - count;
+    send_notifications();
+}
+
+void BLEBenchmark::on_characteristic_discovered(const DiscoveredCharacteristic *characteristic)
+{
+    if (characteristic->getUUID() == UUID(BENCHMARK_TX_UUID)) {
+        _remote_tx = *characteristic;
+    } else if (characteristic->getUUID() == UUID(BENCHMARK_RX_UUID)) {
+        _remote_rx = *characteristic;
+    } else if (characteristic->getUUID() == UUID(BENCHMARK_CTRL_UUID)) {
+        _remote_ctrl = *characteristic;
+    }
+}
+
+void BLEBenchmark::on_discovery_termination(connection_handle_t connectionHandle)
+{
+    if (_state != STATE_DISCOVERING) {
+        return;
+    }
+
+    if (!_remote_tx.getValueHandle() || !_remote_rx.getValueHandle() || !_remote_ctrl.getValueHandle()) {
+        cmd_printf("benchmark service not found\r\n");
+        finish(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    // The CCCD of the TX characteristic immediately follows its value in the
+    // benchmark service.
+    const uint8_t notify_enabled[2] = { BLE_HVX_NOTIFICATION, 0 };
+    _state = STATE_SUBSCRIBING;
+    ble_error_t error = _ble.gattClient().write(
+        GattClient::GATT_OP_WRITE_REQ,
+        _connection,
+        _remote_tx.getValueHandle() + 1,
+        sizeof(notify_enabled),
+        notify_enabled
+    );
+    if (error) {
+        cmd_printf("subscription failed: %d\r\n", error);
+        finish(CMDLINE_RETCODE_FAIL);
+    }
+}
+
+void BLEBenchmark::on_client_data_written(const GattWriteCallbackParams *params)
+{
+    switch (_state) {
+        case STATE_SUBSCRIBING:
+            cmd_printf(
+                "BENCH:{\"test\":\"connect\",\"status\":%d,\"setup_us\":%d,\"discovery_us\":%d,\"interval\":%u}\r\n",
+                params->status,
+                _setup_us,
+                _timer.read_us() - _first_us,
+                _interval
+            );
+            finish(params->status ? CMDLINE_RETCODE_FAIL : CMDLINE_RETCODE_SUCCESS);
+            break;
+
+        case STATE_WRITE_TEST:
+            if (params->writeOp == GattWriteCallbackParams::OP_WRITE_REQ) {
+                // counter reset acknowledged: start the stream
+                _cpu.start();
+                _first_us = _timer.read_us();
+                _deadline_us = _first_us + _duration_ms * 1000;
+            } else if (_count) {
+                _count--;
+            }
+            send_write_commands();
+            break;
+
+        case STATE_LATENCY_TEST: {
+            int latency_us = _timer.read_us() - _latency_start_us;
+            if (params->status) {
+                cmd_printf("write failed: %d\r\n", params->status);
+                finish(CMDLINE_RETCODE_FAIL);
+                return;
+            }
+
+            _packets++;
+            _latency_sum_us += latency_us;
+            if (latency_us < _latency_min_us) {
+                _latency_min_us = latency_us;
+            }
+            if (latency_us > _latency_max_us) {
+                _latency_max_us = latency_us;
+            }
+
+            if (_packets < _count) {
+                send_latency_write();
+                return;
+            }
+
+            cmd_printf(
+                "BENCH:{\"test\":\"latency\",\"phy\":\"%s\",\"att_mtu\":%u,\"payload\":%u,\"interval\":%u,"
+                "\"count\":%lu,\"min_us\":%d,\"avg_us\":%lu,\"max_us\":%d,\"cpu_load\":%u}\r\n",
+                phy_to_string(_phy),
+                _att_mtu,
+                payload_size(),
+                _interval,
+                (unsigned long) _packets,
+                _latency_min_us,
+                (unsigned long)(_latency_sum_us / _packets),
+                _latency_max_us,
+                _cpu.load()
+            );
+            finish(CMDLINE_RETCODE_SUCCESS);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void BLEBenchmark::on_client_data_read(const GattReadCallbackParams *params)
+{
+    if (_state != STATE_WRITE_TEST || params->handle != _remote_ctrl.getValueHandle()) {
+        return;
+    }
+
+    if (params->status || params->len < 4) {
+        cmd_printf("control read failed: %d\r\n", params->status);
+        finish(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    uint32_t received = params->data[0] |
+        (params->data[1] << 8) |
+        (params->data[2] << 16) |
+        ((uint32_t) params->data[3] << 24);
+
+    int duration_us = _last_us - _first_us;
+    uint32_t kbps = 0;
+    if (duration_us > 0) {
+        kbps = (uint32_t)(((uint64_t) received * 8 * 1000) / duration_us);
+    }
+
+    cmd_printf(
+        "BENCH:{\"test\":\"write_cmd\",\"phy\":\"%s\",\"att_mtu\":%u,\"payload\":%u,\"interval\":%u,"
+        "\"duration_us\":%d,\"packets\":%lu,\"bytes_sent\":%lu,\"bytes_received\":%lu,"
+        "\"throughput_kbps\":%lu,\"cpu_load\":%u}\r\n",
+        phy_to_string(_phy),
+        _att_mtu,
+        payload_size(),
+        _interval,
+        duration_us,
+        (unsigned long) _packets,
+        (unsigned long) _bytes,
+        (unsigned long) received,
+        (unsigned long) kbps,
+        _cpu.load()
+    );
+
+    finish(received ? CMDLINE_RETCODE_SUCCESS : CMDLINE_RETCODE_FAIL);
+}
+
+void BLEBenchmark::on_hvx(const GattHVXCallbackParams *params)
+{
+    if (_state != STATE_NOTIFY_TEST || params->handle != _remote_tx.getValueHandle()) {
+        return;
+    }
+
+    _last_us = _timer.read_us();
+    if (_packets == 0) {
+        _first_us = _last_us;
+    }
+    _packets++;
+    _bytes += params->len;
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2020 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _BLEBENCHMARK_H_INCLUDED
+#define _BLEBENCHMARK_H_INCLUDED
+
+#include <stdint.h>
+#include "mbed_events.h"
+#include "mbed_stats.h"
+#include "drivers/Timer.h"
+#include "ble/BLE.h"
+#include "ble/DiscoveredCharacteristic.h"
+
+/** Name advertised by the peripheral and looked for by the central */
+#define BENCHMARK_DEVICE_NAME "mbed-ble-bench"
+
+/** Largest characteristic value used by the benchmark: max ATT_MTU (247) minus the ATT header */
+#define BENCHMARK_MAX_PAYLOAD 244
+
+/**
+ * BLEBenchmark turns the serial commands into BLE operations run on the BLE event queue.
+ *
+ * The same image is flashed on both devices: one runs "peripheral" and exposes the benchmark service, the other
+ * runs "connect" and drives every measurement from the central side. Each completed measurement prints a single
+ * JSON object on one line, prefixed with "BENCH:" so test scripts can pick results out of the human readable traces.
+ *
+ * The benchmark service has three characteristics:
+ *   - TX (notify): streamed by the peripheral during a notification test.
+ *   - RX (write, write without response): sink for the write tests; bytes received are counted.
+ *   - CTRL (read, write): the central writes a 5 bytes command (opcode, duration in ms little endian) and reads the
+ *     number of bytes received on RX as a 32 bit little endian value.
+ *
+ * Handlers are statics because the test framework is not supporting C++
+ */
+class BLEBenchmark : private ble::Gap::EventHandler,
+                     private GattServer::EventHandler,
+                     private GattClient::EventHandler {
+public:
+    /** Return the benchmark singleton, the first call starts the BLE thread and initializes BLE */
+    static BLEBenchmark &instance();
+
+    /** Start advertising the benchmark service and wait for a central */
+    static int cmd_peripheral(int argc, char *argv[]);
+
+    /** Scan for the benchmark peripheral, connect and subscribe, reports the connection setup time */
+    static int cmd_connect(int argc, char *argv[]);
+
+    /** Change PHY, ATT_MTU and connection interval of the current connection */
+    static int cmd_config(int argc, char *argv[]);
+
+    /** Measure notification throughput from the peripheral for <duration_ms> */
+    static int cmd_notify(int argc, char *argv[]);
+
+    /** Measure write without response throughput to the peripheral for <duration_ms> */
+    static int cmd_write(int argc, char *argv[]);
+
+    /** Measure round trip latency of <count> write with response */
+    static int cmd_latency(int argc, char *argv[]);
+
+    /** Terminate the current connection */
+    static int cmd_disconnect(int argc, char *argv[]);
+
+private:
+    enum ctrl_opcode_t {
+        CTRL_START_NOTIFY = 0x01,
+        CTRL_RESET_RX = 0x02
+    };
+
+    enum state_t {
+        STATE_IDLE,
+        STATE_ADVERTISING,
+        STATE_SCANNING,
+        STATE_CONNECTING,
+        STATE_DISCOVERING,
+        STATE_SUBSCRIBING,
+        STATE_CONNECTED,
+        STATE_CONFIGURING,
+        STATE_NOTIFY_TEST,
+        STATE_WRITE_TEST,
+        STATE_LATENCY_TEST,
+        STATE_DISCONNECTING
+    };
+
+    /** Snapshot of the CPU statistics at the start of a measurement */
+    struct cpu_sample_t {
+        mbed_stats_cpu_t stats;
+
+        void start();
+
+        /** CPU load in percent since start() */
+        unsigned load() const;
+    };
+
+    BLEBenchmark();
+
+    static void ble_routine();
+
+    void init();
+
+    void schedule_ble_events(BLE::OnEventsToProcessCallbackContext *context);
+
+    void on_init_complete(BLE::InitializationCompleteCallbackContext *context);
+
+    void setup_service();
+
+    /* commands, run on the BLE event queue */
+    void peripheral();
+
+    void connect();
+
+    void config(ble::phy_t phy, bool set_phy, uint16_t mtu, uint16_t interval);
+
+    void start_notify_test(uint32_t duration_ms);
+
+    void start_write_test(uint32_t duration_ms);
+
+    void start_latency_test(uint32_t count);
+
+    void disconnect();
+
+    /* measurements */
+    void config_step_done(ble_error_t status);
+
+    void config_timeout();
+
+    void send_notifications();
+
+    void notify_test_done();
+
+    void send_write_commands();
+
+    void write_test_done();
+
+    void send_latency_write();
+
+    void finish(int retcode);
+
+    bool write_ctrl(ctrl_opcode_t opcode, uint32_t duration_ms);
+
+    uint16_t payload_size() const;
+
+    /* Gap::EventHandler */
+    virtual void onAdvertisingReport(const ble::AdvertisingReportEvent &event);
+
+    virtual void onConnectionComplete(const ble::ConnectionCompleteEvent &event);
+
+    virtual void onDisconnectionComplete(const ble::DisconnectionCompleteEvent &event);
+
+    virtual void onConnectionParametersUpdateComplete(
+        const ble::ConnectionParametersUpdateCompleteEvent &event
+    );
+
+    virtual void onPhyUpdateComplete(
+        ble_error_t status,
+        ble::connection_handle_t connectionHandle,
+        ble::phy_t txPhy,
+        ble::phy_t rxPhy
+    );
+
+    /* GattServer::EventHandler and GattClient::EventHandler */
+    virtual void onAttMtuChange(ble::connection_handle_t connectionHandle, uint16_t attMtuSize);
+
+    /* GattServer callbacks */
+    void on_server_data_written(const GattWriteCallbackParams *params);
+
+    void on_server_data_sent(unsigned count);
+
+    /* GattClient callbacks */
+    void on_characteristic_discovered(const DiscoveredCharacteristic *characteristic);
+
+    void on_discovery_termination(ble::connection_handle_t connectionHandle);
+
+    void on_client_data_written(const GattWriteCallbackParams *params);
+
+    void on_client_data_read(const GattReadCallbackParams *params);
+
+    void on_hvx(const GattHVXCallbackParams *params);
+
+private:
+    static events::EventQueue _bleQueue;
+
+    BLE &_ble;
+    state_t _state;
+    ble::connection_handle_t _connection;
+    bool _is_central;
+
+    /* negotiated parameters */
+    uint16_t _att_mtu;
+    uint16_t _requested_mtu;
+    ble::phy_t _phy;
+    uint16_t _interval;
+    unsigned _config_pending;
+    ble_error_t _config_status;
+    int _config_timeout_id;
+
+    /* local GATT server */
+    uint8_t _tx_value[BENCHMARK_MAX_PAYLOAD];
+    uint8_t _rx_value[BENCHMARK_MAX_PAYLOAD];
+    uint8_t _ctrl_value[5];
+    GattAttribute::Handle_t _tx_handle;
+    GattAttribute::Handle_t _rx_handle;
+    GattAttribute::Handle_t _ctrl_handle;
+    uint32_t _rx_bytes;
+
+    /* remote GATT server */
+    DiscoveredCharacteristic _remote_tx;
+    DiscoveredCharacteristic _remote_rx;
+    DiscoveredCharacteristic _remote_ctrl;
+
+    /* measurement state */
+    mbed::Timer _timer;
+    cpu_sample_t _cpu;
+    int _setup_us;
+    uint32_t _duration_ms;
+    int _deadline_us;
+    int _first_us;
+    int _last_us;
+    uint32_t _bytes;
+    uint32_t _packets;
+    uint32_t _count;
+    int _latency_start_us;
+    int _latency_min_us;
+    int _latency_max_us;
+    uint64_t _latency_sum_us;
+};
+
+#endif // _BLEBENCHMARK_H_INCLUDED
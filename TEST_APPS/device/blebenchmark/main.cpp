@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdarg.h>
+#include "mbed-client-cli/ns_cmdline.h"
+#include "BLEBenchmark.h"
+
+#if !defined(MBED_CPU_STATS_ENABLED)
+#warning CPU statistics are disabled, cpu_load is reported as 0
+#endif
+
+void wrap_printf(const char *f, va_list a)
+{
+    vprintf(f, a);
+}
+
+/** Disables VT100 etc. for easy manual UI interaction */
+int set_easy_printer(int argc, char *argv[])
+{
+    const char msg[][20] =
+    { "echo off", "set --retcode true", "set --vt100 off" };
+    for (size_t i = 0; i < (sizeof(msg) / sizeof(msg[0])); i++) {
+        cmd_exe((char *) msg[i]);
+    }
+    return (CMDLINE_RETCODE_SUCCESS);
+}
+
+/**
+ * BLE throughput and latency benchmark. The same application is flashed on two boards, possibly of different
+ * targets to compare BLE ports: the peripheral one is started with "peripheral", the other one runs "connect" then
+ * drives the measurements from the central side. It can be used interactively with a 115200 baud terminal or
+ * from the IceTea test framework https://os.mbed.com/docs/latest/tools/icetea-testing-applications.html .
+ *
+ * Every measurement prints one line "BENCH:<json object>", see README.md for the fields reported.
+ */
+int main()
+{
+    cmd_init(&wrap_printf);
+    BLEBenchmark::instance();
+
+    cmd_add("peripheral", BLEBenchmark::cmd_peripheral,
+            "advertise the benchmark service", "wait for the central to connect");
+    cmd_add("connect", BLEBenchmark::cmd_connect,
+            "connect to the benchmark peripheral", "scan, connect, discover and subscribe, reports setup time");
+    cmd_add("config", BLEBenchmark::cmd_config,
+            "configure the connection",
+            "config [--phy 1M|2M|coded] [--mtu <23..247>] [--interval <connection interval in 1.25ms units>]");
+    cmd_add("notify", BLEBenchmark::cmd_notify,
+            "notification throughput", "notify <duration_ms>");
+    cmd_add("write", BLEBenchmark::cmd_write,
+            "write without response throughput", "write <duration_ms>");
+    cmd_add("latency", BLEBenchmark::cmd_latency,
+            "write with response round trip latency", "latency <count>");
+    cmd_add("disconnect", BLEBenchmark::cmd_disconnect,
+            "disconnect", "stop advertising, scanning or terminate the connection");
+    cmd_add("easy", set_easy_printer, "Use human readable terminal output",
+            "echo off,vt100 off,return-codes visible");
+
+    cmd_printf("MBED BLE benchmark\r\n");
+
+    {
+        int c;
+        while ((c = getc(stdin)) != EOF) {
+            cmd_char_input(c);
+        }
+    }
+    return 0;
+}
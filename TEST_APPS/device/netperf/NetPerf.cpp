@@ -0,0 +1,539 @@
+/*
+ * Copyright (c) 2020 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "mbed-client-cli/ns_cmdline.h"
+#include "rtos/Thread.h"
+#include "rtos/ThisThread.h"
+#include "netsocket/TCPSocket.h"
+#include "netsocket/UDPSocket.h"
+#include "NetPerf.h"
+
+using namespace std::chrono;
+
+#define DEFAULT_TIME_S 10
+#define DEFAULT_TCP_LEN 1460
+#define DEFAULT_UDP_LEN 1470
+#define DEFAULT_BANDWIDTH_KBPS 1000
+
+// Time without data after which a server gives up on its client
+#define SERVER_TIMEOUT_MS 10000
+
+// The iperf 2 client sends its final datagram up to 10 times, waiting for the report in between
+#define UDP_FIN_RETRIES 10
+#define UDP_FIN_TIMEOUT_MS 250
+
+// iperf 2 UDP datagram header: sequence number, then the send time in seconds and microseconds
+#define UDP_HEADER_SIZE 12
+
+// iperf 2 server report following the datagram header: flags, total_len1, total_len2, stop_sec, stop_usec,
+// error_cnt, outorder_cnt, datagrams, jitter1, jitter2
+#define UDP_REPORT_SIZE 40
+#define UDP_REPORT_VERSION1 0x80000000
+
+#define NET_THREAD_STACK_SIZE 4096
+
+events::EventQueue NetPerf::_queue(8 * EVENTS_EVENT_SIZE);
+
+static rtos::Thread netThread(osPriorityNormal, NET_THREAD_STACK_SIZE);
+
+static void put_be32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = value >> 24;
+    buf[1] = value >> 16;
+    buf[2] = value >> 8;
+    buf[3] = value;
+}
+
+static uint32_t get_be32(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | buf[3];
+}
+
+void NetPerf::cpu_sample_t::start()
+{
+    mbed_stats_cpu_get(&stats);
+}
+
+unsigned NetPerf::cpu_sample_t::load() const
+{
+    mbed_stats_cpu_t now;
+    mbed_stats_cpu_get(&now);
+
+    us_timestamp_t uptime = now.uptime - stats.uptime;
+    us_timestamp_t idle = now.idle_time - stats.idle_time;
+    if (uptime == 0 || idle > uptime) {
+        return 0;
+    }
+    return (unsigned)(((uptime - idle) * 100) / uptime);
+}
+
+NetPerf::NetPerf() :
+    _net(NetworkInterface::get_default_instance())
+{
+    netThread.start(&NetPerf::net_routine);
+}
+
+NetPerf &NetPerf::instance()
+{
+    static NetPerf netperf;
+    return netperf;
+}
+
+void NetPerf::net_routine()
+{
+    _queue.dispatch_forever();
+}
+
+bool NetPerf::parse(int argc, char *argv[], bool needs_host, uint32_t default_len)
+{
+    int32_t value;
+
+    if (!_net) {
+        cmd_printf("no default network interface\r\n");
+        return false;
+    }
+
+    _params.port = NETPERF_DEFAULT_PORT;
+    _params.time_s = DEFAULT_TIME_S;
+    _params.bandwidth_kbps = DEFAULT_BANDWIDTH_KBPS;
+    _params.len = default_len;
+
+    if (cmd_parameter_int(argc, argv, "--port", &value)) {
+        _params.port = value;
+    }
+    if (cmd_parameter_int(argc, argv, "--time", &value) && value > 0) {
+        _params.time_s = value;
+    }
+    if (cmd_parameter_int(argc, argv, "--bandwidth", &value) && value > 0) {
+        _params.bandwidth_kbps = value;
+    }
+    if (cmd_parameter_int(argc, argv, "--len", &value)) {
+        if (value < UDP_HEADER_SIZE || value > NETPERF_BUFFER_SIZE) {
+            cmd_printf("--len must be between %d and %d\r\n", UDP_HEADER_SIZE, NETPERF_BUFFER_SIZE);
+            return false;
+        }
+        _params.len = value;
+    }
+
+    if (!needs_host) {
+        return true;
+    }
+
+    if (argc < 2 || argv[1][0] == '-') {
+        cmd_printf("missing host\r\n");
+        return false;
+    }
+    nsapi_error_t error = _net->gethostbyname(argv[1], &_params.peer);
+    if (error) {
+        cmd_printf("cannot resolve %s: %d\r\n", argv[1], error);
+        return false;
+    }
+    _params.peer.set_port(_params.port);
+    return true;
+}
+
+void NetPerf::report(const char *test, uint64_t bytes, int64_t duration_us, const char *extra)
+{
+    mbed_stats_heap_t heap;
+    mbed_stats_heap_get(&heap);
+
+    uint32_t throughput_kbps = duration_us > 0 ? (uint32_t)((bytes * 8000) / duration_us) : 0;
+
+    cmd_printf(
+        "BENCH:{\"test\":\"%s\",\"len\":%lu,\"duration_us\":%" PRId64 ",\"bytes\":%" PRIu64 ","
+        "\"throughput_kbps\":%lu,\"cpu_load\":%u,\"heap_max\":%lu%s}\r\n",
+        test,
+        (unsigned long)_params.len,
+        duration_us,
+        bytes,
+        (unsigned long)throughput_kbps,
+        _cpu.load(),
+        (unsigned long)heap.max_size,
+        extra
+    );
+    cmd_ready(CMDLINE_RETCODE_SUCCESS);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int NetPerf::cmd_connect(int argc, char *argv[])
+{
+    if (!instance()._net) {
+        cmd_printf("no default network interface\r\n");
+        return CMDLINE_RETCODE_FAIL;
+    }
+    _queue.call(&instance(), &NetPerf::connect);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+void NetPerf::connect()
+{
+    nsapi_error_t error = _net->connect();
+    if (error) {
+        cmd_printf("connect failed: %d\r\n", error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    SocketAddress address;
+    _net->get_ip_address(&address);
+    cmd_printf("BENCH:{\"event\":\"connected\",\"ip\":\"%s\"}\r\n", address.get_ip_address());
+    cmd_ready(CMDLINE_RETCODE_SUCCESS);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int NetPerf::cmd_tcp_client(int argc, char *argv[])
+{
+    if (!instance().parse(argc, argv, true, DEFAULT_TCP_LEN)) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _queue.call(&instance(), &NetPerf::tcp_client);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+void NetPerf::tcp_client()
+{
+    TCPSocket socket;
+    socket.open(_net);
+
+    nsapi_error_t error = socket.connect(_params.peer);
+    if (error) {
+        cmd_printf("connect to %s failed: %d\r\n", _params.peer.get_ip_address(), error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    // A zero first word tells the server there is no dual test header, the rest is payload
+    memset(_buffer, 0, _params.len);
+
+    uint64_t bytes = 0;
+    int64_t end_us = (int64_t)_params.time_s * 1000000;
+    _cpu.start();
+    _timer.reset();
+    _timer.start();
+
+    while (_timer.elapsed_time().count() < end_us) {
+        nsapi_size_or_error_t sent = socket.send(_buffer, _params.len);
+        if (sent < 0) {
+            cmd_printf("send failed: %d\r\n", sent);
+            break;
+        }
+        bytes += sent;
+    }
+    socket.close();
+
+    _timer.stop();
+    report("tcp_client", bytes, _timer.elapsed_time().count(), "");
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int NetPerf::cmd_tcp_server(int argc, char *argv[])
+{
+    if (!instance().parse(argc, argv, false, NETPERF_BUFFER_SIZE)) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _queue.call(&instance(), &NetPerf::tcp_server);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+void NetPerf::tcp_server()
+{
+    TCPSocket listener;
+    listener.open(_net);
+    listener.bind(_params.port);
+
+    nsapi_error_t error = listener.listen(1);
+    if (error) {
+        cmd_printf("listen on port %u failed: %d\r\n", _params.port, error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+    cmd_printf("listening on TCP port %u\r\n", _params.port);
+
+    TCPSocket *client = listener.accept(&error);
+    if (!client) {
+        cmd_printf("accept failed: %d\r\n", error);
+        listener.close();
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+    client->set_timeout(SERVER_TIMEOUT_MS);
+
+    uint64_t bytes = 0;
+    _cpu.start();
+    _timer.reset();
+    _timer.start();
+
+    // The client closes the connection at the end of the test
+    nsapi_size_or_error_t received;
+    while ((received = client->recv(_buffer, _params.len)) > 0) {
+        bytes += received;
+    }
+
+    _timer.stop();
+    client->close();
+    listener.close();
+
+    if (received < 0) {
+        cmd_printf("recv failed: %d\r\n", received);
+    }
+    report("tcp_server", bytes, _timer.elapsed_time().count(), "");
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int NetPerf::cmd_udp_client(int argc, char *argv[])
+{
+    if (!instance().parse(argc, argv, true, DEFAULT_UDP_LEN)) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _queue.call(&instance(), &NetPerf::udp_client);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+void NetPerf::udp_client()
+{
+    UDPSocket socket;
+    socket.open(_net);
+
+    memset(_buffer, 0, _params.len);
+
+    // Datagrams are sent at fixed times to hold the requested bandwidth
+    int64_t interval_us = ((int64_t)_params.len * 8000) / _params.bandwidth_kbps;
+    int64_t end_us = (int64_t)_params.time_s * 1000000;
+    uint64_t bytes = 0;
+    uint32_t send_errors = 0;
+    int32_t id = 0;
+
+    _cpu.start();
+    _timer.reset();
+    _timer.start();
+
+    for (;;) {
+        int64_t now_us = _timer.elapsed_time().count();
+        if (now_us >= end_us) {
+            break;
+        }
+        int64_t ahead_us = id * interval_us - now_us;
+        if (ahead_us >= 1000) {
+            rtos::ThisThread::sleep_for(milliseconds(ahead_us / 1000));
+            continue;
+        }
+
+        put_be32(_buffer, id);
+        put_be32(_buffer + 4, now_us / 1000000);
+        put_be32(_buffer + 8, now_us % 1000000);
+        nsapi_size_or_error_t sent = socket.sendto(_params.peer, _buffer, _params.len);
+        if (sent < 0) {
+            // Out of buffers: the datagram is lost, as it would be on the link
+            send_errors++;
+        } else {
+            bytes += sent;
+        }
+        id++;
+    }
+    int64_t duration_us = _timer.elapsed_time().count();
+
+    // Ask the server for its report, the final datagram carries the negated count
+    int32_t fin_id = id > 0 ? -id : -1;
+    put_be32(_buffer, fin_id);
+    socket.set_timeout(UDP_FIN_TIMEOUT_MS);
+
+    const uint8_t *report_data = NULL;
+    for (int i = 0; i < UDP_FIN_RETRIES && !report_data; i++) {
+        socket.sendto(_params.peer, _buffer, _params.len);
+
+        SocketAddress from;
+        nsapi_size_or_error_t received = socket.recvfrom(&from, _buffer, NETPERF_BUFFER_SIZE);
+        // iperf builds with 64 bit sequence numbers use a 16 byte header, the report flags tell them apart
+        for (size_t offset = UDP_HEADER_SIZE; offset <= UDP_HEADER_SIZE + 4; offset += 4) {
+            if (received >= (nsapi_size_or_error_t)(offset + UDP_REPORT_SIZE)
+                    && (get_be32(_buffer + offset) & UDP_REPORT_VERSION1)) {
+                report_data = _buffer + offset;
+                break;
+            }
+        }
+        put_be32(_buffer, fin_id);
+    }
+    socket.close();
+    _timer.stop();
+
+    char extra[160];
+    if (report_data) {
+        uint32_t jitter_us = get_be32(report_data + 32) * 1000000 + get_be32(report_data + 36);
+        snprintf(extra, sizeof(extra),
+                 ",\"datagrams\":%ld,\"send_errors\":%lu,\"server_datagrams\":%lu,\"lost\":%lu,"
+                 "\"out_of_order\":%lu,\"jitter_us\":%lu",
+                 (long)id,
+                 (unsigned long)send_errors,
+                 (unsigned long)get_be32(report_data + 28),
+                 (unsigned long)get_be32(report_data + 20),
+                 (unsigned long)get_be32(report_data + 24),
+                 (unsigned long)jitter_us);
+    } else {
+        cmd_printf("no report from the server\r\n");
+        snprintf(extra, sizeof(extra), ",\"datagrams\":%ld,\"send_errors\":%lu",
+                 (long)id, (unsigned long)send_errors);
+    }
+    report("udp_client", bytes, duration_us, extra);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int NetPerf::cmd_udp_server(int argc, char *argv[])
+{
+    if (!instance().parse(argc, argv, false, NETPERF_BUFFER_SIZE)) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+    _queue.call(&instance(), &NetPerf::udp_server);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+void NetPerf::udp_server()
+{
+    UDPSocket socket;
+    socket.open(_net);
+
+    nsapi_error_t error = socket.bind(_params.port);
+    if (error) {
+        cmd_printf("bind to port %u failed: %d\r\n", _params.port, error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+    cmd_printf("listening on UDP port %u\r\n", _params.port);
+
+    SocketAddress from;
+    uint64_t bytes = 0;
+    uint32_t datagrams = 0;
+    uint32_t lost = 0;
+    uint32_t out_of_order = 0;
+    int32_t expected = 0;
+    int64_t first_us = 0;
+    int64_t last_us = 0;
+    int64_t last_transit_us = 0;
+    // RFC 1889 interarrival jitter, in 1/16 microseconds
+    int64_t jitter = 0;
+    nsapi_size_or_error_t received;
+
+    while ((received = socket.recvfrom(&from, _buffer, _params.len)) >= 0) {
+        if (received < UDP_HEADER_SIZE) {
+            continue;
+        }
+        int64_t now_us = _timer.elapsed_time().count();
+        int32_t id = (int32_t)get_be32(_buffer);
+
+        if (id < 0) {
+            break;
+        }
+
+        if (datagrams == 0) {
+            // The test starts with the first datagram, the client may come at any time
+            socket.set_timeout(SERVER_TIMEOUT_MS);
+            _cpu.start();
+            _timer.reset();
+            _timer.start();
+            now_us = 0;
+            first_us = 0;
+            expected = id;
+        }
+
+        int64_t sent_us = (int64_t)get_be32(_buffer + 4) * 1000000 + get_be32(_buffer + 8);
+        int64_t transit_us = now_us - sent_us;
+        if (datagrams > 0) {
+            int64_t delta = transit_us - last_transit_us;
+            if (delta < 0) {
+                delta = -delta;
+            }
+            jitter += delta - ((jitter + 8) >> 4);
+        }
+        last_transit_us = transit_us;
+
+        if (id >= expected) {
+            lost += id - expected;
+            expected = id + 1;
+        } else {
+            // A late datagram was counted as lost when the ones after it arrived
+            out_of_order++;
+            if (lost > 0) {
+                lost--;
+            }
+        }
+
+        bytes += received;
+        datagrams++;
+        last_us = now_us;
+    }
+    _timer.stop();
+
+    if (received < 0) {
+        cmd_printf("recvfrom failed: %d\r\n", received);
+        socket.close();
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+
+    int64_t duration_us = last_us - first_us;
+    uint32_t jitter_us = (uint32_t)(jitter >> 4);
+
+    // Answer the final datagram with the report, keeping its header, for as long as the client repeats it
+    uint8_t *report_data = _buffer + UDP_HEADER_SIZE;
+    put_be32(report_data, UDP_REPORT_VERSION1);
+    put_be32(report_data + 4, bytes >> 32);
+    put_be32(report_data + 8, bytes);
+    put_be32(report_data + 12, duration_us / 1000000);
+    put_be32(report_data + 16, duration_us % 1000000);
+    put_be32(report_data + 20, lost);
+    put_be32(report_data + 24, out_of_order);
+    put_be32(report_data + 28, expected);
+    put_be32(report_data + 32, jitter_us / 1000000);
+    put_be32(report_data + 36, jitter_us % 1000000);
+
+    socket.set_timeout(UDP_FIN_TIMEOUT_MS);
+    do {
+        socket.sendto(from, _buffer, UDP_HEADER_SIZE + UDP_REPORT_SIZE);
+        received = socket.recvfrom(&from, _buffer, UDP_HEADER_SIZE);
+    } while (received == UDP_HEADER_SIZE && (int32_t)get_be32(_buffer) < 0);
+    socket.close();
+
+    char extra[128];
+    snprintf(extra, sizeof(extra), ",\"datagrams\":%lu,\"lost\":%lu,\"out_of_order\":%lu,\"jitter_us\":%lu",
+             (unsigned long)datagrams, (unsigned long)lost, (unsigned long)out_of_order, (unsigned long)jitter_us);
+    report("udp_server", bytes, duration_us, extra);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+
+int NetPerf::cmd_disconnect(int argc, char *argv[])
+{
+    _queue.call(&instance(), &NetPerf::disconnect);
+    return CMDLINE_RETCODE_EXCUTING_CONTINUE;
+}
+
+void NetPerf::disconnect()
+{
+    nsapi_error_t error = _net ? _net->disconnect() : NSAPI_ERROR_NO_CONNECTION;
+    if (error) {
+        cmd_printf("disconnect failed: %d\r\n", error);
+        cmd_ready(CMDLINE_RETCODE_FAIL);
+        return;
+    }
+    cmd_printf("BENCH:{\"event\":\"disconnected\"}\r\n");
+    cmd_ready(CMDLINE_RETCODE_SUCCESS);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _NETPERF_H_INCLUDED
+#define _NETPERF_H_INCLUDED
+
+#include <stdint.h>
+#include "mbed_events.h"
+#include "mbed_stats.h"
+#include "drivers/Timer.h"
+#include "netsocket/NetworkInterface.h"
+#include "netsocket/SocketAddress.h"
+
+/** Port iperf2 uses when none is given */
+#define NETPERF_DEFAULT_PORT 5001
+
+/** Size of the send and receive buffer, and so the largest --len accepted */
+#define NETPERF_BUFFER_SIZE 4096
+
+/**
+ * NetPerf runs iperf2 compatible throughput tests over the default network interface.
+ *
+ * The device can be either end of a test against a host running iperf 2: "tcp_client" and "udp_client" stream to
+ * "iperf -s [-u]", "tcp_server" and "udp_server" take a stream from "iperf -c <device> [-u]". Each completed test
+ * prints a single JSON object on one line, prefixed with "BENCH:" so test scripts can pick results out of the human
+ * readable traces.
+ *
+ * Sockets are blocking, so the commands run on a thread of their own and complete asynchronously.
+ *
+ * Handlers are statics because the test framework is not supporting C++
+ */
+class NetPerf {
+public:
+    /** Return the singleton, the first call starts the network thread */
+    static NetPerf &instance();
+
+    /** Bring the default network interface up and print its address */
+    static int cmd_connect(int argc, char *argv[]);
+
+    /** Stream TCP to an iperf server: tcp_client <host> [--port <n>] [--time <s>] [--len <bytes>] */
+    static int cmd_tcp_client(int argc, char *argv[]);
+
+    /** Receive one TCP stream from an iperf client: tcp_server [--port <n>] */
+    static int cmd_tcp_server(int argc, char *argv[]);
+
+    /** Stream UDP to an iperf server: udp_client <host> [--port <n>] [--time <s>] [--bandwidth <kbps>] [--len <bytes>] */
+    static int cmd_udp_client(int argc, char *argv[]);
+
+    /** Receive one UDP stream from an iperf client: udp_server [--port <n>] */
+    static int cmd_udp_server(int argc, char *argv[]);
+
+    /** Bring the network interface down */
+    static int cmd_disconnect(int argc, char *argv[]);
+
+private:
+    /** Parameters of a test, parsed from the command line */
+    struct params_t {
+        SocketAddress peer;
+        uint16_t port;
+        uint32_t time_s;
+        uint32_t bandwidth_kbps;
+        uint32_t len;
+    };
+
+    /** Snapshot of the CPU statistics at the start of a measurement */
+    struct cpu_sample_t {
+        mbed_stats_cpu_t stats;
+
+        void start();
+
+        /** CPU load in percent since start() */
+        unsigned load() const;
+    };
+
+    NetPerf();
+
+    static void net_routine();
+
+    /** Parse the options shared by the commands, resolving the host if @p needs_host */
+    bool parse(int argc, char *argv[], bool needs_host, uint32_t default_len);
+
+    /* commands, run on the network thread */
+    void connect();
+    void tcp_client();
+    void tcp_server();
+    void udp_client();
+    void udp_server();
+    void disconnect();
+
+    /** Print the result line of a test and complete the command */
+    void report(const char *test, uint64_t bytes, int64_t duration_us, const char *extra);
+
+    static events::EventQueue _queue;
+
+    NetworkInterface *_net;
+    params_t _params;
+    cpu_sample_t _cpu;
+    mbed::Timer _timer;
+    uint8_t _buffer[NETPERF_BUFFER_SIZE];
+};
+
+#endif //_NETPERF_H_INCLUDED
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdarg.h>
+#include "mbed-client-cli/ns_cmdline.h"
+#include "NetPerf.h"
+
+#if !defined(MBED_CPU_STATS_ENABLED)
+#warning CPU statistics are disabled, cpu_load is reported as 0
+#endif
+
+#if !defined(MBED_HEAP_STATS_ENABLED)
+#warning Heap statistics are disabled, heap_max is reported as 0
+#endif
+
+void wrap_printf(const char *f, va_list a)
+{
+    vprintf(f, a);
+}
+
+/** Disables VT100 etc. for easy manual UI interaction */
+int set_easy_printer(int argc, char *argv[])
+{
+    const char msg[][20] =
+    { "echo off", "set --retcode true", "set --vt100 off" };
+    for (size_t i = 0; i < (sizeof(msg) / sizeof(msg[0])); i++) {
+        cmd_exe((char *) msg[i]);
+    }
+    return (CMDLINE_RETCODE_SUCCESS);
+}
+
+/**
+ * Network throughput benchmark, compatible with iperf 2 on the host side. The board is either the client or the
+ * server of a TCP or UDP test run against "iperf" on a host of the same network, to compare network stacks, drivers
+ * and their configuration. It can be used interactively with a 115200 baud terminal or from the IceTea test
+ * framework https://os.mbed.com/docs/latest/tools/icetea-testing-applications.html .
+ *
+ * Every test prints one line "BENCH:<json object>", see README.md for the fields reported.
+ */
+int main()
+{
+    cmd_init(&wrap_printf);
+    NetPerf::instance();
+
+    cmd_add("connect", NetPerf::cmd_connect,
+            "bring the network interface up", "connect the default network interface and print its address");
+    cmd_add("tcp_client", NetPerf::cmd_tcp_client,
+            "TCP throughput to an iperf server",
+            "tcp_client <host> [--port <n>] [--time <s>] [--len <bytes>]");
+    cmd_add("tcp_server", NetPerf::cmd_tcp_server,
+            "TCP throughput from an iperf client", "tcp_server [--port <n>]");
+    cmd_add("udp_client", NetPerf::cmd_udp_client,
+            "UDP throughput to an iperf server",
+            "udp_client <host> [--port <n>] [--time <s>] [--bandwidth <kbps>] [--len <bytes>]");
+    cmd_add("udp_server", NetPerf::cmd_udp_server,
+            "UDP throughput from an iperf client", "udp_server [--port <n>]");
+    cmd_add("disconnect", NetPerf::cmd_disconnect,
+            "bring the network interface down", "disconnect the default network interface");
+    cmd_add("easy", set_easy_printer, "Use human readable terminal output",
+            "echo off,vt100 off,return-codes visible");
+
+    cmd_printf("MBED network benchmark\r\n");
+
+    {
+        int c;
+        while ((c = getc(stdin)) != EOF) {
+            cmd_char_input(c);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "drivers/MbedCRC.h"
+
+using namespace mbed;
+
+// Each CRC over buffers from a small packet up to a flash page, with the
+// table driven implementation when MBED_CRC_TABLE_SIZE is not 0 and the
+// bitwise one for comparison.
+template<uint32_t polynomial, uint8_t width, CrcMode mode>
+static void BM_MbedCRC(benchmark::State &state)
+{
+    MbedCRC<polynomial, width, mode> ct;
+    std::vector<uint8_t> data(state.range(0));
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i * 31;
+    }
+    uint32_t crc = 0;
+
+    for (auto _ : state) {
+        ct.compute(data.data(), data.size(), &crc);
+        benchmark::DoNotOptimize(crc);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_MbedCRC, POLY_32BIT_ANSI, 32, CrcMode::TABLE)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC, POLY_32BIT_ANSI, 32, CrcMode::BITWISE)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC, POLY_16BIT_CCITT, 16, CrcMode::TABLE)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC, POLY_16BIT_CCITT, 16, CrcMode::BITWISE)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC, POLY_8BIT_CCITT, 8, CrcMode::TABLE)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC, POLY_7BIT_SD, 7, CrcMode::TABLE)->Range(16, 4096);
+
+BENCHMARK_MAIN();
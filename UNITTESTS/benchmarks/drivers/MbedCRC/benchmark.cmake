@@ -0,0 +1,23 @@
+
+####################
+# BENCHMARKS
+####################
+
+# Table size of the table driven CRCs, drivers.crc-table-size on targets
+if (NOT BENCH_CRC_TABLE_SIZE)
+  set(BENCH_CRC_TABLE_SIZE 16)
+endif()
+
+set(unittest-sources
+  ../drivers/source/MbedCRC.cpp
+)
+
+set(unittest-test-sources
+  benchmarks/drivers/MbedCRC/bench_MbedCRC.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -DMBED_CRC_TABLE_SIZE=${BENCH_CRC_TABLE_SIZE}
+)
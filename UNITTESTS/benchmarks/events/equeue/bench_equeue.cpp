@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark/benchmark.h"
+#include "equeue.h"
+
+#define BENCH_EQUEUE_SIZE (64 * 1024)
+
+extern unsigned int equeue_global_time;
+
+static void count_func(void *p)
+{
+    (*static_cast<unsigned *>(p))++;
+}
+
+// One event posted and dispatched at a time, the common case of an ISR deferring to a thread
+static void BM_equeue_call_dispatch(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, BENCH_EQUEUE_SIZE);
+    unsigned count = 0;
+
+    for (auto _ : state) {
+        equeue_call(&q, count_func, &count);
+        equeue_dispatch(&q, 0);
+    }
+
+    benchmark::DoNotOptimize(count);
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_call_dispatch);
+
+// A burst of events posted before the dispatcher runs
+static void BM_equeue_burst(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, BENCH_EQUEUE_SIZE);
+    unsigned count = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            equeue_call(&q, count_func, &count);
+        }
+        equeue_dispatch(&q, 0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_burst)->Range(8, 256);
+
+// Delayed events inserted out of order into the timer list, then all due at once
+static void BM_equeue_call_in(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, BENCH_EQUEUE_SIZE);
+    unsigned count = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            equeue_call_in(&q, (i * 7919) % 1000, count_func, &count);
+        }
+        equeue_global_time += 1000;
+        equeue_dispatch(&q, 0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_call_in)->Range(8, 256);
+
+// Posting and cancelling without dispatch, as done by timeouts that are rearmed
+static void BM_equeue_call_cancel(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, BENCH_EQUEUE_SIZE);
+    unsigned count = 0;
+
+    for (auto _ : state) {
+        int id = equeue_call_in(&q, 100, count_func, &count);
+        equeue_cancel(&q, id);
+    }
+
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_call_cancel);
+
+BENCHMARK_MAIN();
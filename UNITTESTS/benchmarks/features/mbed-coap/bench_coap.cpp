@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "benchmark/benchmark.h"
+#include "ns_types.h"
+#include "mbed-coap/sn_coap_header.h"
+#include "mbed-coap/sn_coap_protocol.h"
+#include "sn_coap_protocol_internal.h"
+
+#define BENCH_PACKET_SIZE 1024
+
+static void *coap_malloc(uint16_t size)
+{
+    return malloc(size);
+}
+
+static void coap_free(void *ptr)
+{
+    free(ptr);
+}
+
+// The parser and the builder only use the allocator of the handle, so it is
+// set up without sn_coap_protocol_init()
+class CoapBench : public benchmark::Fixture {
+public:
+    struct coap_s handle;
+    sn_coap_hdr_s msg;
+    uint8_t token[4] = { 0xde, 0xad, 0xbe, 0xef };
+    uint8_t uri_path[21];
+    uint8_t uri_query[15];
+    uint8_t payload[BENCH_PACKET_SIZE];
+    uint8_t packet[BENCH_PACKET_SIZE];
+
+    void SetUp(const benchmark::State &state) override
+    {
+        memset(&handle, 0, sizeof(handle));
+        handle.sn_coap_protocol_malloc = coap_malloc;
+        handle.sn_coap_protocol_free = coap_free;
+
+        // A notification of an observed LwM2M resource
+        memcpy(uri_path, "3303/0/5700/temp/val", sizeof(uri_path));
+        memcpy(uri_query, "ep=node&lt=300", sizeof(uri_query));
+        memset(payload, 'x', sizeof(payload));
+
+        sn_coap_parser_init_message(&msg);
+        msg.msg_type = COAP_MSG_TYPE_CONFIRMABLE;
+        msg.msg_code = COAP_MSG_CODE_RESPONSE_CONTENT;
+        msg.msg_id = 0x1234;
+        msg.token_ptr = token;
+        msg.token_len = sizeof(token);
+        msg.uri_path_ptr = uri_path;
+        msg.uri_path_len = sizeof(uri_path) - 1;
+        msg.content_format = COAP_CT_TEXT_PLAIN;
+        msg.payload_ptr = payload;
+        msg.payload_len = state.range(0);
+
+        sn_coap_parser_alloc_options(&handle, &msg);
+        msg.options_list_ptr->observe = 42;
+        msg.options_list_ptr->max_age = 300;
+        msg.options_list_ptr->uri_query_ptr = uri_query;
+        msg.options_list_ptr->uri_query_len = sizeof(uri_query) - 1;
+    }
+
+    void TearDown(const benchmark::State &state) override
+    {
+        handle.sn_coap_protocol_free(msg.options_list_ptr);
+    }
+};
+
+BENCHMARK_DEFINE_F(CoapBench, build)(benchmark::State &state)
+{
+    for (auto _ : state) {
+        uint16_t size = sn_coap_builder_calc_needed_packet_data_size(&msg);
+        benchmark::DoNotOptimize(sn_coap_builder_3(packet, size, &msg));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_REGISTER_F(CoapBench, build)->Arg(0)->Arg(64)->Arg(512);
+
+BENCHMARK_DEFINE_F(CoapBench, parse)(benchmark::State &state)
+{
+    uint16_t size = sn_coap_builder_calc_needed_packet_data_size(&msg);
+    sn_coap_builder_3(packet, size, &msg);
+    coap_version_e version = COAP_VERSION_UNKNOWN;
+
+    for (auto _ : state) {
+        sn_coap_hdr_s *parsed = sn_coap_parser(&handle, size, packet, &version);
+        if (!parsed || parsed->coap_status == COAP_STATUS_PARSER_ERROR_IN_HEADER) {
+            state.SkipWithError("parse failed");
+            break;
+        }
+        sn_coap_parser_release_allocated_coap_msg_mem(&handle, parsed);
+    }
+}
+BENCHMARK_REGISTER_F(CoapBench, parse)->Arg(0)->Arg(64)->Arg(512);
+
+BENCHMARK_MAIN();
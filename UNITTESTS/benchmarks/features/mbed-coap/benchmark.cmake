@@ -0,0 +1,24 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  ../features/frameworks/mbed-coap
+  ../features/frameworks/mbed-coap/source/include
+  ../features/frameworks/mbed-client-randlib/mbed-client-randlib
+  ../features/frameworks/mbed-trace/mbed-trace
+)
+
+set(unittest-sources
+  ../features/frameworks/mbed-coap/source/sn_coap_parser.c
+  ../features/frameworks/mbed-coap/source/sn_coap_builder.c
+  ../features/frameworks/mbed-coap/source/sn_coap_header_check.c
+  ../features/frameworks/mbed-coap/source/sn_coap_protocol.c
+  ../features/frameworks/mbed-trace/source/mbed_trace.c
+)
+
+set(unittest-test-sources
+  benchmarks/features/mbed-coap/bench_coap.cpp
+  stubs/randLIB_stub.c
+)
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "features/netsocket/nsapi_dns.cpp"
+#include <stdio.h>
+#include <vector>
+
+// Response to an A query for www.example.com with the given number of
+// answers, the names compressed to the question as servers send them
+static std::vector<uint8_t> dns_response(int answers)
+{
+    std::vector<uint8_t> packet = {
+        0x00, 0x01, // ID
+        0x81, 0x80, // Flags
+        0x00, 0x01, // qdcount
+        0x00, (uint8_t)answers, // ancount
+        0x00, 0x00, // nscount
+        0x00, 0x00, // arcount
+        3, 'w', 'w', 'w', 7, 'e', 'x', 'a', 'm', 'p', 'l', 'e', 3, 'c', 'o', 'm', 0,
+        0x00, 0x01, // qtype
+        0x00, 0x01, // qclass
+    };
+    for (int i = 0; i < answers; i++) {
+        const uint8_t answer[] = {
+            0xc0, 0x0c, // name, pointer to the question
+            0x00, 0x01, // rtype
+            0x00, 0x01, // rclass
+            0x00, 0x00, 0x0e, 0x10, // ttl
+            0x00, 0x04, // rdlength
+            93, 184, 216, (uint8_t)i,
+        };
+        packet.insert(packet.end(), answer, answer + sizeof(answer));
+    }
+    return packet;
+}
+
+static void BM_dns_append_question(benchmark::State &state)
+{
+    uint8_t packet[DNS_BUFFER_SIZE];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dns_append_question(packet, 1, "www.example.com", NSAPI_IPv4));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_dns_append_question);
+
+static void BM_dns_scan_response(benchmark::State &state)
+{
+    std::vector<uint8_t> packet = dns_response(state.range(0));
+    nsapi_addr_t addr[MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
+    uint32_t ttl;
+
+    for (auto _ : state) {
+        int count = dns_scan_response(packet.data(), 1, &ttl, addr, MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT);
+        if (count != state.range(0)) {
+            state.SkipWithError("unexpected answer count");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_dns_scan_response)->Arg(1)->Arg(4)->Arg(MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT);
+
+// Lookups in a full cache, hitting each entry in turn
+static void BM_dns_cache_find(benchmark::State &state)
+{
+    nsapi_addr_t addr = { NSAPI_IPv4, { 93, 184, 216, 34 } };
+    char host[MBED_CONF_NSAPI_DNS_CACHE_HOST_NAME_LEN];
+
+    nsapi_dns_cache_reset();
+    for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
+        snprintf(host, sizeof(host), "host%d.example.com", i);
+        nsapi_dns_cache_add(host, &addr, 3600, 1);
+    }
+
+    nsapi_addr_t found;
+    int i = 0;
+    for (auto _ : state) {
+        snprintf(host, sizeof(host), "host%d.example.com", i);
+        if (nsapi_dns_cache_find(host, NSAPI_IPv4, &found) != 1) {
+            state.SkipWithError("cache miss");
+            break;
+        }
+        if (++i == MBED_CONF_NSAPI_DNS_CACHE_SIZE) {
+            i = 0;
+        }
+    }
+}
+BENCHMARK(BM_dns_cache_find);
+
+static void BM_dns_cache_miss(benchmark::State &state)
+{
+    nsapi_dns_cache_reset();
+    nsapi_addr_t found;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(nsapi_dns_cache_find("unknown.example.com", NSAPI_IPv4, &found));
+    }
+}
+BENCHMARK(BM_dns_cache_miss);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "benchmark/benchmark.h"
+#include "platform/CircularBuffer.h"
+
+#define BENCH_BUFFER_SIZE 256
+
+// Byte at a time, as serial drivers fill and drain their buffers
+static void BM_CircularBuffer_push_pop(benchmark::State &state)
+{
+    mbed::CircularBuffer<uint8_t, BENCH_BUFFER_SIZE> buf;
+    uint8_t data = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            buf.push(data++);
+        }
+        for (int i = 0; i < state.range(0); i++) {
+            buf.pop(data);
+        }
+    }
+
+    benchmark::DoNotOptimize(data);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircularBuffer_push_pop)->Arg(16)->Arg(BENCH_BUFFER_SIZE);
+
+// Same transfer with the span overloads, which copy in at most two chunks
+static void BM_CircularBuffer_push_pop_span(benchmark::State &state)
+{
+    mbed::CircularBuffer<uint8_t, BENCH_BUFFER_SIZE> buf;
+    uint8_t src[BENCH_BUFFER_SIZE] = { 0 };
+    uint8_t dst[BENCH_BUFFER_SIZE];
+
+    for (auto _ : state) {
+        buf.push(mbed::make_const_Span(src, state.range(0)));
+        buf.pop(mbed::make_Span(dst, state.range(0)));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CircularBuffer_push_pop_span)->Arg(16)->Arg(BENCH_BUFFER_SIZE);
+
+// Pushing into a full buffer overwrites the oldest element
+static void BM_CircularBuffer_overwrite(benchmark::State &state)
+{
+    mbed::CircularBuffer<uint32_t, BENCH_BUFFER_SIZE> buf;
+    uint32_t data = 0;
+
+    for (int i = 0; i < BENCH_BUFFER_SIZE; i++) {
+        buf.push(data++);
+    }
+    for (auto _ : state) {
+        buf.push(data++);
+    }
+
+    benchmark::DoNotOptimize(buf.size());
+}
+BENCHMARK(BM_CircularBuffer_overwrite);
+
+BENCHMARK_MAIN();
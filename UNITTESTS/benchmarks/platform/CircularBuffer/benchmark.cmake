@@ -0,0 +1,13 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  benchmarks/platform/CircularBuffer/bench_CircularBuffer.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
@@ -0,0 +1,122 @@
+/* Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "features/storage/blockdevice/HeapBlockDevice.h"
+#include "features/storage/blockdevice/FlashSimBlockDevice.h"
+#include "features/storage/kvstore/tdbstore/TDBStore.h"
+#include <stdio.h>
+#include <vector>
+
+#define BLOCK_SIZE (512)
+#define PROGRAM_SIZE (8)
+#define DEVICE_SIZE (BLOCK_SIZE*200)
+
+using namespace mbed;
+
+// Same store as the module test, on a simulated flash with the program
+// size of a typical internal flash
+class TDBStoreBench : public benchmark::Fixture {
+public:
+    HeapBlockDevice heap{DEVICE_SIZE, 1, PROGRAM_SIZE, BLOCK_SIZE};
+    FlashSimBlockDevice flash{&heap};
+    TDBStore tdb{&flash};
+
+    void SetUp(const benchmark::State &state) override
+    {
+        tdb.init();
+        tdb.reset();
+    }
+
+    void TearDown(const benchmark::State &state) override
+    {
+        tdb.deinit();
+    }
+
+    void fill(int keys, size_t size)
+    {
+        std::vector<uint8_t> value(size, 0x5a);
+        char key[16];
+        for (int i = 0; i < keys; i++) {
+            snprintf(key, sizeof(key), "key%d", i);
+            tdb.set(key, value.data(), value.size(), 0);
+        }
+    }
+};
+
+// Rewriting one key, including the garbage collections it triggers
+BENCHMARK_DEFINE_F(TDBStoreBench, set_overwrite)(benchmark::State &state)
+{
+    std::vector<uint8_t> value(state.range(0), 0xa5);
+
+    for (auto _ : state) {
+        tdb.set("key", value.data(), value.size(), 0);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(TDBStoreBench, set_overwrite)->Arg(16)->Arg(256)->Arg(2048);
+
+// Reading keys of a store holding the given number of them
+BENCHMARK_DEFINE_F(TDBStoreBench, get)(benchmark::State &state)
+{
+    fill(state.range(0), 16);
+    uint8_t buf[16];
+    size_t size;
+    char key[16];
+    int i = 0;
+
+    for (auto _ : state) {
+        snprintf(key, sizeof(key), "key%d", i);
+        tdb.get(key, buf, sizeof(buf), &size);
+        if (++i == state.range(0)) {
+            i = 0;
+        }
+    }
+}
+BENCHMARK_REGISTER_F(TDBStoreBench, get)->Arg(1)->Arg(16)->Arg(128);
+
+// Mounting a store, which scans it to rebuild the RAM table
+BENCHMARK_DEFINE_F(TDBStoreBench, init)(benchmark::State &state)
+{
+    fill(state.range(0), 16);
+
+    for (auto _ : state) {
+        tdb.deinit();
+        tdb.init();
+    }
+}
+BENCHMARK_REGISTER_F(TDBStoreBench, init)->Arg(1)->Arg(16)->Arg(128);
+
+// Iterating over all keys
+BENCHMARK_DEFINE_F(TDBStoreBench, iterate)(benchmark::State &state)
+{
+    fill(state.range(0), 16);
+    char key[KVStore::MAX_KEY_SIZE];
+
+    for (auto _ : state) {
+        KVStore::iterator_t it;
+        tdb.iterator_open(&it, NULL);
+        while (tdb.iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+        }
+        tdb.iterator_close(it);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(TDBStoreBench, iterate)->Arg(16)->Arg(128);
+
+BENCHMARK_MAIN();
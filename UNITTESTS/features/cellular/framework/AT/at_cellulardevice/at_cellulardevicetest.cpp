@@ -367,3 +367,26 @@ TEST_F(TestAT_CellularDevice, test_AT_CellularDevice_set_ready_cb)
 
     delete dev;
 }
+
+TEST_F(TestAT_CellularDevice, test_AT_CellularDevice_start_stop_mux)
+{
+    FileHandle_stub fh1;
+    AT_CellularDevice *dev = new AT_CellularDevice(&fh1);
+
+    EXPECT_TRUE(dev->get_mux_data_channel() == NULL);
+    EXPECT_EQ(NSAPI_ERROR_OK, dev->stop_mux());
+
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_DEVICE_ERROR;
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, dev->start_mux());
+    EXPECT_TRUE(dev->get_mux_data_channel() == NULL);
+
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_OK;
+    EXPECT_EQ(NSAPI_ERROR_OK, dev->start_mux());
+    EXPECT_TRUE(dev->get_mux_data_channel() != NULL);
+    EXPECT_EQ(NSAPI_ERROR_IS_CONNECTED, dev->start_mux());
+
+    EXPECT_EQ(NSAPI_ERROR_OK, dev->stop_mux());
+    EXPECT_TRUE(dev->get_mux_data_channel() == NULL);
+
+    delete dev;
+}
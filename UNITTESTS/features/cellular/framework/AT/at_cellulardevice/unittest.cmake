@@ -41,6 +41,7 @@ set(unittest-test-sources
   stubs/BufferedSerial_stub.cpp
   stubs/SerialBase_stub.cpp
   stubs/CellularStateMachine_stub.cpp
+  stubs/CellularMux_stub.cpp
   stubs/CellularContext_stub.cpp
   stubs/ThisThread_stub.cpp
   stubs/ConditionVariable_stub.cpp
@@ -125,6 +125,11 @@ public:
     {
         return AT_CellularStack::socket_attach(handle, callback, data);
     }
+
+    nsapi_size_or_error_t read_socket_data(void *buffer, nsapi_size_t size, nsapi_size_t data_len, bool quoted = false)
+    {
+        return AT_CellularStack::read_socket_data(buffer, size, data_len, quoted);
+    }
 };
 
 // AStyle ignored as the definition is not clear due to preprocessor usage
@@ -370,3 +375,28 @@ TEST_F(TestAT_CellularStack, test_AT_CellularStack_socket_attach)
     st.socket_open(&sock, NSAPI_TCP);
     st.socket_attach(sock, NULL, NULL);
 }
+
+TEST_F(TestAT_CellularStack, test_AT_CellularStack_read_socket_data)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    ATHandler at(&fh1, que, 0, ",");
+
+    MyStack st(at, 0, IPV6_STACK, *_dev);
+    uint8_t table[8];
+
+    EXPECT_EQ(st.read_socket_data(table, sizeof(table), 0), 0);
+
+    ATHandler_stub::ssize_value = 4;
+    EXPECT_EQ(st.read_socket_data(table, sizeof(table), 4), 4);
+
+    // the rest of a payload larger than the buffer is dropped
+    EXPECT_EQ(st.read_socket_data(table, 4, 8), 4);
+
+    ATHandler_stub::ssize_value = 1;
+    EXPECT_EQ(st.read_socket_data(table, sizeof(table), 1, true), 1);
+
+    ATHandler_stub::ssize_value = -1;
+    EXPECT_EQ(st.read_socket_data(table, sizeof(table), 4), NSAPI_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(st.read_socket_data(table, sizeof(table), 4, true), NSAPI_ERROR_DEVICE_ERROR);
+}
@@ -85,6 +85,17 @@ TEST_F(TestATHandler, test_ATHandler_get_file_handle)
     EXPECT_EQ(&fh1, at.get_file_handle());
 }
 
+TEST_F(TestATHandler, test_ATHandler_set_file_handle)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    FileHandle_stub fh2;
+
+    ATHandler at(&fh1, que, 0, ",");
+    at.set_file_handle(&fh2);
+    EXPECT_EQ(&fh2, at.get_file_handle());
+}
+
 TEST_F(TestATHandler, test_ATHandler_lock)
 {
     EventQueue que;
@@ -508,6 +519,33 @@ TEST_F(TestATHandler, test_ATHandler_read_bytes)
     EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.get_last_error());
 }
 
+TEST_F(TestATHandler, test_ATHandler_read_bytes_large)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    uint8_t buf[40];
+
+    char table1[] = "0123456789012345678901234567890123456789OK\r\n\0";
+    filehandle_stub_table = table1;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    // Payload larger than the receiving buffer is read straight into buf
+    EXPECT_EQ(40, at.read_bytes(buf, 40));
+    EXPECT_TRUE(!memcmp(buf, table1, 40));
+    EXPECT_EQ(filehandle_stub_table_pos, 40);
+
+    // Bytes already buffered are copied before reading the rest
+    filehandle_stub_table_pos = 0;
+    EXPECT_EQ(5, at.read_bytes(buf, 5));
+    EXPECT_EQ(filehandle_stub_table_pos, MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE);
+    EXPECT_EQ(-1, at.read_bytes(buf, 40));
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.get_last_error());
+}
+
 TEST_F(TestATHandler, test_ATHandler_read_string)
 {
     EventQueue que;
@@ -1129,6 +1167,39 @@ TEST_F(TestATHandler, test_ATHandler_resp_stop)
     urc_callback_count = 0;
 }
 
+TEST_F(TestATHandler, test_ATHandler_get_urc_hit_count)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+
+    at.set_urc_handler("+CEREG:", &urc_callback);
+    at.set_urc_handler("+CGREG:", &urc_callback);
+    at.set_urc_handler("R", &urc_callback);
+    EXPECT_TRUE(at.get_urc_hit_count("+CGREG:") == 0);
+    EXPECT_TRUE(at.get_urc_hit_count("+CREG:") == 0);
+
+    // prefix + URC lines of each bucket + OKCRLF
+    char table[] = "line1\r\n+CGREG: 1\r\nline2abcd\r\n+CGREG: 5\r\nR\r\n+CEREG: 1\r\nOK\r\n";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+
+    at.flush();
+    at.clear_error();
+    filehandle_stub_table_pos = 0;
+
+    at.resp_start("line2");
+    at.resp_stop();
+    EXPECT_TRUE(urc_callback_count == 4);
+    EXPECT_TRUE(at.get_urc_hit_count("+CGREG:") == 2);
+    EXPECT_TRUE(at.get_urc_hit_count("+CEREG:") == 1);
+    EXPECT_TRUE(at.get_urc_hit_count("R") == 1);
+
+    at.set_urc_handler("+CGREG:", NULL);
+    EXPECT_TRUE(at.get_urc_hit_count("+CGREG:") == 0);
+}
+
 TEST_F(TestATHandler, test_ATHandler_info_resp)
 {
     EventQueue que;
@@ -1305,6 +1376,91 @@ TEST_F(TestATHandler, test_ATHandler_at_cmd_discard)
     EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.at_cmd_discard("+CREG", "=1,", "%d%s%b", 3, "test", byte, 4));
 }
 
+static ATHandler *batch_at;
+static int batch_calls;
+static int batch_values[2];
+
+static void batch_first_handler()
+{
+    batch_values[0] = batch_at->read_int();
+    batch_calls++;
+}
+
+static void batch_second_handler()
+{
+    batch_at->skip_param();
+    batch_values[1] = batch_at->read_int();
+    batch_calls++;
+}
+
+TEST_F(TestATHandler, test_ATHandler_at_cmd_batch)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    batch_at = &at;
+    at.set_urc_handler("+CEREG:", &urc_callback);
+
+    ATHandler::batch_cmd_t cmds[] = {
+        { "+CSQ", "", batch_first_handler },
+        { "+CMEE", "=1", NULL },
+        { "+CREG", "?", batch_second_handler },
+    };
+
+    // All commands on one line, an URC among the responses
+    at.set_cmd_concatenation(true);
+    char table[] = "\r\n+CSQ: 20,99\r\n+CEREG: 1\r\n\r\n+CREG: 0,5\r\n\r\nOK\r\n";
+    mbed_poll_stub::revents_value = POLLIN + POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    fh1.size_value = 100;
+
+    filehandle_stub_table = NULL;
+    at.flush();
+    at.clear_error();
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    batch_calls = 0;
+
+    EXPECT_EQ(NSAPI_ERROR_OK, at.at_cmd_batch(cmds, 3));
+    EXPECT_EQ(2, batch_calls);
+    EXPECT_EQ(20, batch_values[0]);
+    EXPECT_EQ(5, batch_values[1]);
+    EXPECT_EQ(1, urc_callback_count);
+
+    // One command at a time, each with its own final result code
+    at.set_cmd_concatenation(false);
+    char table2[] = "\r\n+CSQ: 21,99\r\n\r\nOK\r\n\r\nOK\r\n\r\n+CREG: 0,1\r\n\r\nOK\r\n";
+    fh1.size_value = 100;
+
+    filehandle_stub_table = NULL;
+    at.flush();
+    at.clear_error();
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    batch_calls = 0;
+
+    EXPECT_EQ(NSAPI_ERROR_OK, at.at_cmd_batch(cmds, 3));
+    EXPECT_EQ(2, batch_calls);
+    EXPECT_EQ(21, batch_values[0]);
+    EXPECT_EQ(1, batch_values[1]);
+
+    // An error stops the batch
+    at.set_cmd_concatenation(true);
+    char table3[] = "\r\n+CME ERROR: 10\r\n";
+    fh1.size_value = 100;
+
+    filehandle_stub_table = NULL;
+    at.flush();
+    at.clear_error();
+    filehandle_stub_table = table3;
+    filehandle_stub_table_pos = 0;
+    batch_calls = 0;
+
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.at_cmd_batch(cmds, 3));
+    EXPECT_EQ(0, batch_calls);
+}
+
 TEST_F(TestATHandler, test_ATHandler_sync)
 {
     EventQueue que;
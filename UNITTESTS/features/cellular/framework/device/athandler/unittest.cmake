@@ -41,6 +41,7 @@ set(unittest-test-sources
 
 set(unittest-test-flags
   -DMBED_CONF_CELLULAR_DEBUG_AT=true
+  -DMBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE=32
   -DOS_STACK_SIZE=2048
   -DDEVICE_SERIAL=1
   -DDEVICE_INTERRUPTIN=1
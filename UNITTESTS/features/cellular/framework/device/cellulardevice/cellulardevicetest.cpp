@@ -259,3 +259,55 @@ TEST_F(TestCellularDevice, test_timeout_array)
 
     delete dev;
 }
+
+TEST_F(TestCellularDevice, test_power_stats)
+{
+    FileHandle_stub fh1;
+    myCellularDevice *dev = new myCellularDevice(&fh1);
+    EXPECT_TRUE(dev);
+
+    CellularDevice::power_stats_t stats;
+    dev->get_power_stats(stats);
+    EXPECT_EQ(stats.wake_count, 0);
+    EXPECT_EQ(stats.attach_count, 0);
+    EXPECT_EQ(stats.connect_latency, -1);
+
+    dev->set_radio_state(CellularDevice::RadioStateConnected);
+    dev->set_radio_state(CellularDevice::RadioStateConnected);
+    dev->set_radio_state(CellularDevice::RadioStateIdle);
+    dev->set_radio_state(CellularDevice::RadioStatePSM);
+    dev->set_radio_state(CellularDevice::RadioStateConnected);
+
+    cell_callback_data_t data;
+    data.status_data = CellularNetwork::Attached;
+    dev->cellular_callback((nsapi_event_t)CellularAttachNetwork, (intptr_t)&data);
+    data.error = NSAPI_ERROR_DEVICE_ERROR;
+    dev->cellular_callback((nsapi_event_t)CellularAttachNetwork, (intptr_t)&data);
+    dev->cellular_callback(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, NSAPI_STATUS_DISCONNECTED);
+
+    dev->add_data_stats(10, 0);
+    dev->get_power_stats(stats);
+    EXPECT_EQ(stats.connect_latency, -1);
+
+    dev->start_connect_stats();
+    dev->add_data_stats(0, 0);
+    dev->get_power_stats(stats);
+    EXPECT_EQ(stats.connect_latency, -1);
+    dev->add_data_stats(0, 20);
+
+    dev->get_power_stats(stats);
+    EXPECT_EQ(stats.wake_count, 2);
+    EXPECT_EQ(stats.attach_count, 1);
+    EXPECT_EQ(stats.detach_count, 1);
+    EXPECT_EQ(stats.bytes_sent, 10);
+    EXPECT_EQ(stats.bytes_received, 20);
+    EXPECT_EQ(stats.connect_latency, 0);
+
+    dev->reset_power_stats();
+    dev->get_power_stats(stats);
+    EXPECT_EQ(stats.wake_count, 0);
+    EXPECT_EQ(stats.bytes_sent, 0);
+    EXPECT_EQ(stats.connect_latency, -1);
+
+    delete dev;
+}
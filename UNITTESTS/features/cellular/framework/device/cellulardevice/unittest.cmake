@@ -36,6 +36,7 @@ set(unittest-test-sources
   stubs/ConditionVariable_stub.cpp
   stubs/Mutex_stub.cpp
   stubs/mbed_shared_queues_stub.cpp
+  stubs/Kernel_stub.cpp
 )
 
 set(unittest-test-flags
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include <string.h>
+#include <errno.h>
+#include <vector>
+#include <algorithm>
+#include "CellularMux.h"
+
+using namespace mbed;
+
+// Modem side of the multiplexer: accepts or refuses SABM and DISC commands and sends UIH frames
+class ModemFileHandle : public FileHandle {
+public:
+    ModemFileHandle() : rx_pos(0), accept(true)
+    {
+    }
+
+    virtual ssize_t read(void *buffer, size_t size)
+    {
+        size_t len = std::min(size, rx.size() - rx_pos);
+        if (!len) {
+            return -EAGAIN;
+        }
+        memcpy(buffer, &rx[rx_pos], len);
+        rx_pos += len;
+        return len;
+    }
+
+    virtual ssize_t write(const void *buffer, size_t size)
+    {
+        const uint8_t *data = static_cast<const uint8_t *>(buffer);
+        tx.insert(tx.end(), data, data + size);
+
+        // the header of a frame is written at once
+        if (size == 4 && data[0] == 0xF9 && ((data[2] & ~0x10) == 0x2F || (data[2] & ~0x10) == 0x43)) {
+            send_frame(data[1] >> 2, accept ? 0x73 : 0x1F, NULL, 0);
+        }
+        return size;
+    }
+
+    virtual off_t seek(off_t offset, int whence = SEEK_SET)
+    {
+        return -ESPIPE;
+    }
+
+    virtual int close()
+    {
+        return 0;
+    }
+
+    virtual short poll(short events) const
+    {
+        return POLLOUT | (rx_pos < rx.size() ? POLLIN : 0);
+    }
+
+    void send_frame(uint8_t dlci, uint8_t control, const char *data, size_t len)
+    {
+        uint8_t header[3] = { (uint8_t)((dlci << 2) | 0x03), control, (uint8_t)((len << 1) | 0x01) };
+        rx.push_back(0xF9);
+        rx.insert(rx.end(), header, header + sizeof(header));
+        rx.insert(rx.end(), data, data + len);
+        rx.push_back(fcs(header, sizeof(header)));
+        rx.push_back(0xF9);
+    }
+
+    static uint8_t fcs(const uint8_t *data, size_t len)
+    {
+        uint8_t crc = 0xFF;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x01) ? (crc >> 1) ^ 0xE0 : crc >> 1;
+            }
+        }
+        return 0xFF - crc;
+    }
+
+    std::vector<uint8_t> rx;
+    size_t rx_pos;
+    std::vector<uint8_t> tx;
+    bool accept;
+};
+
+class TestCellularMux : public testing::Test {
+protected:
+
+    void SetUp()
+    {
+    }
+
+    void TearDown()
+    {
+    }
+};
+
+TEST_F(TestCellularMux, test_CellularMux_start_stop)
+{
+    ModemFileHandle fh;
+    CellularMux mux;
+
+    EXPECT_TRUE(mux.get_channel(CellularMux::CHANNEL_AT) == NULL);
+    EXPECT_EQ(mux.start(&fh, 1000), NSAPI_ERROR_OK);
+    EXPECT_EQ(mux.start(&fh, 1000), NSAPI_ERROR_IS_CONNECTED);
+    EXPECT_TRUE(mux.get_file_handle() == &fh);
+
+    // SABM on the control channel then on each channel
+    const uint8_t sabm[] = {
+        0xF9, 0x03, 0x3F, 0x01, 0x1C, 0xF9,
+        0xF9, 0x07, 0x3F, 0x01, 0xDE, 0xF9,
+        0xF9, 0x0B, 0x3F, 0x01, 0x59, 0xF9
+    };
+    ASSERT_EQ(fh.tx.size(), sizeof(sabm));
+    EXPECT_TRUE(memcmp(&fh.tx[0], sabm, sizeof(sabm)) == 0);
+
+    FileHandle *at = mux.get_channel(CellularMux::CHANNEL_AT);
+    ASSERT_TRUE(at != NULL);
+    EXPECT_TRUE(mux.get_channel(CellularMux::CHANNEL_DATA) != NULL);
+
+    mux.stop(1000);
+    EXPECT_TRUE(mux.get_channel(CellularMux::CHANNEL_AT) == NULL);
+    EXPECT_TRUE(mux.get_file_handle() == NULL);
+    EXPECT_EQ(at->write("AT", 2), -EBADF);
+}
+
+TEST_F(TestCellularMux, test_CellularMux_start_refused)
+{
+    ModemFileHandle fh;
+    CellularMux mux;
+
+    fh.accept = false;
+    EXPECT_EQ(mux.start(&fh, 1000), NSAPI_ERROR_DEVICE_ERROR);
+    EXPECT_TRUE(mux.get_channel(CellularMux::CHANNEL_AT) == NULL);
+}
+
+TEST_F(TestCellularMux, test_CellularMux_write)
+{
+    ModemFileHandle fh;
+    CellularMux mux;
+
+    ASSERT_EQ(mux.start(&fh, 1000), NSAPI_ERROR_OK);
+    FileHandle *at = mux.get_channel(CellularMux::CHANNEL_AT);
+
+    fh.tx.clear();
+    EXPECT_EQ(at->write("AT\r", 3), 3);
+    const uint8_t frame[] = { 0xF9, 0x07, 0xEF, 0x07, 'A', 'T', '\r', 0xD3, 0xF9 };
+    ASSERT_EQ(fh.tx.size(), sizeof(frame));
+    EXPECT_TRUE(memcmp(&fh.tx[0], frame, sizeof(frame)) == 0);
+
+    // split in frames of MBED_CONF_CELLULAR_MUX_FRAME_SIZE bytes
+    char data[MBED_CONF_CELLULAR_MUX_FRAME_SIZE + 10];
+    memset(data, 'x', sizeof(data));
+    fh.tx.clear();
+    EXPECT_EQ(at->write(data, sizeof(data)), (ssize_t)sizeof(data));
+    EXPECT_EQ(fh.tx.size(), sizeof(data) + 2 * 6);
+}
+
+TEST_F(TestCellularMux, test_CellularMux_read)
+{
+    ModemFileHandle fh;
+    CellularMux mux;
+
+    ASSERT_EQ(mux.start(&fh, 1000), NSAPI_ERROR_OK);
+    FileHandle *at = mux.get_channel(CellularMux::CHANNEL_AT);
+    FileHandle *data = mux.get_channel(CellularMux::CHANNEL_DATA);
+    at->set_blocking(false);
+    data->set_blocking(false);
+
+    char buf[16];
+    EXPECT_EQ(at->read(buf, sizeof(buf)), -EAGAIN);
+    EXPECT_EQ(at->poll(POLLIN) & POLLIN, 0);
+
+    fh.send_frame(CellularMux::CHANNEL_DATA, 0xEF, "hello", 5);
+    fh.send_frame(CellularMux::CHANNEL_AT, 0xEF, "OK\r\n", 4);
+
+    EXPECT_EQ(at->poll(POLLIN) & POLLIN, POLLIN);
+    EXPECT_EQ(at->read(buf, sizeof(buf)), 4);
+    EXPECT_TRUE(memcmp(buf, "OK\r\n", 4) == 0);
+    EXPECT_EQ(data->read(buf, sizeof(buf)), 5);
+    EXPECT_TRUE(memcmp(buf, "hello", 5) == 0);
+
+    // frame with a bad FCS is dropped
+    fh.send_frame(CellularMux::CHANNEL_AT, 0xEF, "ERROR", 5);
+    fh.rx[fh.rx.size() - 2] ^= 0xFF;
+    EXPECT_EQ(at->read(buf, sizeof(buf)), -EAGAIN);
+
+    // modem closes the data channel
+    fh.send_frame(CellularMux::CHANNEL_DATA, 0x53, NULL, 0);
+    EXPECT_EQ(data->poll(POLLIN), POLLHUP);
+    EXPECT_EQ(data->read(buf, sizeof(buf)), -EBADF);
+}
@@ -0,0 +1,34 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  ../platform
+  ../features/cellular/framework/device
+  ../features/cellular/framework/common
+)
+
+# Source files
+set(unittest-sources
+  ../features/cellular/framework/device/CellularMux.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  features/cellular/framework/device/cellularmux/cellularmuxtest.cpp
+  stubs/FileHandle_stub.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_poll_stub.cpp
+  stubs/Kernel_stub.cpp
+  stubs/Mutex_stub.cpp
+  stubs/rtx_mutex_stub.c
+)
+
+set(unittest-test-flags
+  -DMBED_CONF_CELLULAR_MUX_FRAME_SIZE=31
+  -DMBED_CONF_CELLULAR_MUX_BUFFER_SIZE=64
+  -DMBED_CONF_RTOS_PRESENT=1
+)
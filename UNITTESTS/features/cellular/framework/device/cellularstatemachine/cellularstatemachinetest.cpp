@@ -59,6 +59,15 @@ static void cellular_callback(nsapi_event_t ev, intptr_t ptr)
 
 }
 
+static bool sim_ready_resumed;
+static void resume_callback(nsapi_event_t ev, intptr_t ptr)
+{
+    cell_callback_data_t *data = (cell_callback_data_t *)ptr;
+    if (ev == CellularSIMStatusChanged && data->data) {
+        sim_ready_resumed = *(const bool *)data->data;
+    }
+}
+
 namespace mbed {
 
 class UT_CellularStateMachine {
@@ -403,7 +412,51 @@ TEST_F(TestCellularStateMachine, test_run_to_state)
     dev = NULL;
 }
 
+TEST_F(TestCellularStateMachine, test_resume)
+{
+    UT_CellularStateMachine ut;
+    FileHandle_stub fh1;
+
+    CellularDevice *dev = new AT_CellularDevice(&fh1);
+    EXPECT_TRUE(dev);
 
+    CellularStateMachine *stm = ut.create_state_machine(*dev, *dev->get_queue(), *dev->open_network());
+    EXPECT_TRUE(stm);
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.start_dispatch());
 
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    ut.set_cellular_callback(&resume_callback);
 
+    UT_CellularState current_state;
+    UT_CellularState target_state;
 
+    // not attached, full sequence
+    sim_ready_resumed = true;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_attached());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_ATTACHING_NETWORK, current_state);
+    EXPECT_FALSE(sim_ready_resumed);
+    ut.reset();
+
+    // modem kept registration and attach
+    AT_CellularNetwork_stub::attached = true;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_attached());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_ATTACHING_NETWORK, current_state);
+    ASSERT_EQ(UT_STATE_ATTACHING_NETWORK, target_state);
+    EXPECT_TRUE(sim_ready_resumed);
+    ut.reset();
+
+    // modem was powered on, full sequence
+    sim_ready_resumed = true;
+    AT_CellularDevice_stub::init_module_failure_count = 1;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_attached());
+    EXPECT_FALSE(sim_ready_resumed);
+    ut.reset();
+    AT_CellularNetwork_stub::attached = false;
+
+    ut.delete_state_machine();
+    delete dev;
+}
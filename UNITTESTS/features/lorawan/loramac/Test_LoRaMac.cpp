@@ -545,9 +545,9 @@ TEST_F(Test_LoRaMac, set_batterylevel_callback)
     object->set_batterylevel_callback(batt_cb);
 }
 
-TEST_F(Test_LoRaMac, get_backoff_timer_event_id)
+TEST_F(Test_LoRaMac, get_backoff_time_left)
 {
-    object->get_backoff_timer_event_id();
+    object->get_backoff_time_left();
 }
 
 TEST_F(Test_LoRaMac, clear_tx_pipe)
@@ -571,7 +571,7 @@ TEST_F(Test_LoRaMac, clear_tx_pipe)
     LoRaPHY_stub::channel_params_ptr = params;
     LoRaWANTimer_stub::call_cb_immediately = true;
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize(NULL, my_cb));
-    EventQueue_stub::int_value = 0;
+    LoRaWANTimer_stub::time_left_value = 0;
     EXPECT_EQ(LORAWAN_STATUS_BUSY, object->clear_tx_pipe());
     loramac_mhdr_t machdr;
     machdr.bits.mtype = MCPS_UNCONFIRMED;
@@ -580,7 +580,7 @@ TEST_F(Test_LoRaMac, clear_tx_pipe)
     LoRaPHY_stub::lorawan_status_value = LORAWAN_STATUS_DUTYCYCLE_RESTRICTED;
     EXPECT_TRUE(LORAWAN_STATUS_OK == object->send(&machdr, 15, buf, 1));
 
-    EventQueue_stub::int_value = 1;
+    LoRaWANTimer_stub::time_left_value = 1;
     EXPECT_EQ(LORAWAN_STATUS_OK, object->clear_tx_pipe());
 }
 
@@ -18,8 +18,6 @@
 #include "gtest/gtest.h"
 #include "LoRaMacCrypto.h"
 
-#include "cipher_stub.h"
-#include "cmac_stub.h"
 #include "aes_stub.h"
 
 class Test_LoRaMacCrypto : public testing::Test {
@@ -28,11 +26,6 @@ protected:
 
     virtual void SetUp()
     {
-        cipher_stub.info_value = NULL;
-        cipher_stub.int_zero_counter = 0;
-        cipher_stub.int_value = 0;
-        cmac_stub.int_zero_counter = 0;
-        cmac_stub.int_value = 0;
         aes_stub.int_zero_counter = 0;
         aes_stub.int_value = 0;
         object = new LoRaMacCrypto();
@@ -52,36 +45,30 @@ TEST_F(Test_LoRaMacCrypto, constructor)
 
 TEST_F(Test_LoRaMacCrypto, compute_mic)
 {
-    EXPECT_TRUE(MBEDTLS_ERR_CIPHER_ALLOC_FAILED == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, NULL));
-
-    mbedtls_cipher_info_t info;
-    cipher_stub.info_value = &info;
-    cipher_stub.int_zero_counter = 0;
-    cipher_stub.int_value = -1;
-    EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, NULL));
-
-    cipher_stub.int_value = 0;
-    cmac_stub.int_zero_counter = 0;
-    cmac_stub.int_value = -1;
+    aes_stub.int_zero_counter = 0;
+    aes_stub.int_value = -1;
     EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, NULL));
 
-    cmac_stub.int_zero_counter = 1;
-    cmac_stub.int_value = -1;
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -1;
     EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, NULL));
 
-    cmac_stub.int_zero_counter = 2;
-    cmac_stub.int_value = -1;
+    aes_stub.int_zero_counter = 2;
+    aes_stub.int_value = -1;
     EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, NULL));
 
-    cmac_stub.int_zero_counter = 3;
-    cmac_stub.int_value = -1;
-    EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, NULL));
+    // Key schedule is cached now
+    uint8_t buf[20];
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -2;
+    EXPECT_TRUE(-2 == object->compute_mic(buf, 20, NULL, 0, 0, 0, 0, NULL));
 
     uint32_t mic[16];
-    cmac_stub.int_zero_counter = 3;
-    cmac_stub.int_value = 0;
-    EXPECT_TRUE(0 == object->compute_mic(NULL, 0, NULL, 0, 0, 0, 0, mic));
+    aes_stub.int_zero_counter = 0;
+    aes_stub.int_value = 0;
+    EXPECT_TRUE(0 == object->compute_mic(buf, 20, NULL, 0, 0, 0, 0, mic));
 
+    EXPECT_TRUE(MBEDTLS_ERR_AES_INVALID_KEY_LENGTH == object->compute_mic(NULL, 0, NULL, 512, 0, 0, 0, mic));
 }
 
 TEST_F(Test_LoRaMacCrypto, encrypt_payload)
@@ -117,28 +104,20 @@ TEST_F(Test_LoRaMacCrypto, decrypt_payload)
 TEST_F(Test_LoRaMacCrypto, compute_join_frame_mic)
 {
     uint32_t mic[16];
-    EXPECT_TRUE(MBEDTLS_ERR_CIPHER_ALLOC_FAILED == object->compute_join_frame_mic(NULL, 0, NULL, 0, NULL));
-    mbedtls_cipher_info_t info;
-    cipher_stub.info_value = &info;
-    cipher_stub.int_zero_counter = 0;
-    cipher_stub.int_value = -1;
-    EXPECT_TRUE(-1 == object->compute_join_frame_mic(NULL, 0, NULL, 0, NULL));
-
-    cipher_stub.int_value = 0;
-    cmac_stub.int_zero_counter = 0;
-    cmac_stub.int_value = -1;
+    aes_stub.int_zero_counter = 0;
+    aes_stub.int_value = -1;
     EXPECT_TRUE(-1 == object->compute_join_frame_mic(NULL, 0, NULL, 0, NULL));
 
-    cmac_stub.int_zero_counter = 1;
-    cmac_stub.int_value = -1;
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -1;
     EXPECT_TRUE(-1 == object->compute_join_frame_mic(NULL, 0, NULL, 0, NULL));
 
-    cmac_stub.int_zero_counter = 2;
-    cmac_stub.int_value = -1;
+    aes_stub.int_zero_counter = 2;
+    aes_stub.int_value = -1;
     EXPECT_TRUE(-1 == object->compute_join_frame_mic(NULL, 0, NULL, 0, NULL));
 
-    cmac_stub.int_zero_counter = 3;
-    cmac_stub.int_value = 0;
+    aes_stub.int_zero_counter = 0;
+    aes_stub.int_value = 0;
     EXPECT_TRUE(0 == object->compute_join_frame_mic(NULL, 0, NULL, 0, mic));
 }
 
@@ -176,3 +155,34 @@ TEST_F(Test_LoRaMacCrypto, compute_skeys_for_join_frame)
     aes_stub.int_value = 0;
     EXPECT_TRUE(0 == object->compute_skeys_for_join_frame(NULL, 0, nonce, 0, nwk_key, app_key));
 }
+
+TEST_F(Test_LoRaMacCrypto, key_schedule_cache)
+{
+    uint8_t key1[16] = {1};
+    uint8_t key2[16] = {2};
+    uint8_t key3[16] = {3};
+    uint8_t key4[16] = {4};
+    uint8_t buf[16];
+    uint8_t dec[16];
+
+    aes_stub.int_value = 0;
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key1, 128, dec));
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key2, 128, dec));
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key3, 128, dec));
+
+    // Cached keys only need the decryption itself
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -1;
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key1, 128, dec));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key3, 128, dec));
+
+    // A new key replaces the oldest schedule
+    aes_stub.int_value = 0;
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key4, 128, dec));
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -1;
+    EXPECT_TRUE(-1 == object->decrypt_join_frame(buf, 0, key1, 128, dec));
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(0 == object->decrypt_join_frame(buf, 0, key4, 128, dec));
+}
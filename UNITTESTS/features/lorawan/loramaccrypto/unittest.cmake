@@ -32,9 +32,7 @@ set(unittest-includes ${unittest-includes}
 # Test & stub files
 set(unittest-test-sources
   features/lorawan/loramaccrypto/Test_LoRaMacCrypto.cpp
-  stubs/cipher_stub.c
   stubs/aes_stub.c
-  stubs/cmac_stub.c
   stubs/mbed_assert_stub.cpp
   ../features/nanostack/coap-service/test/coap-service/unittest/stub/mbedtls_stub.c
 
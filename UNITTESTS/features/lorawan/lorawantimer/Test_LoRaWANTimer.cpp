@@ -86,5 +86,71 @@ TEST_F(Test_LoRaWANTimer, stop)
     EXPECT_TRUE(ev.timer_id == 0);
 }
 
+TEST_F(Test_LoRaWANTimer, time_left)
+{
+    equeue_stub.void_ptr = NULL;
+    timer_event_t ev;
+    memset(&ev, 0, sizeof(ev));
+    object->init(ev, my_callback);
+    EXPECT_EQ(-1, object->time_left(ev));
+
+    object->start(ev, 10);
+    EXPECT_EQ(10, object->time_left(ev));
+
+    // restarting replaces the deadline
+    object->start_at(ev, 5, 20);
+    EXPECT_EQ(25, object->time_left(ev));
+
+    object->stop(ev);
+    EXPECT_EQ(-1, object->time_left(ev));
+}
 
+static int dispatched[3];
+static int dispatched_count;
 
+void first_callback()
+{
+    dispatched[dispatched_count++] = 1;
+}
+
+void second_callback()
+{
+    dispatched[dispatched_count++] = 2;
+}
+
+void third_callback()
+{
+    dispatched[dispatched_count++] = 3;
+}
+
+TEST_F(Test_LoRaWANTimer, dispatch_order)
+{
+    timer_event_t first;
+    timer_event_t second;
+    timer_event_t third;
+    memset(&first, 0, sizeof(first));
+    memset(&second, 0, sizeof(second));
+    memset(&third, 0, sizeof(third));
+    object->init(first, first_callback);
+    object->init(second, second_callback);
+    object->init(third, third_callback);
+    dispatched_count = 0;
+
+    // nothing gets posted
+    equeue_stub.void_ptr = NULL;
+    object->start(second, 0);
+    object->start(third, 0);
+
+    // a deadline in the past expires at once, with all the expired timers
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    object->start_at(first, (lorawan_time_t) - 10, 5);
+    equeue_stub.call_cb_immediately = false;
+
+    EXPECT_EQ(3, dispatched_count);
+    EXPECT_EQ(1, dispatched[0]);
+    EXPECT_EQ(2, dispatched[1]);
+    EXPECT_EQ(3, dispatched[2]);
+    EXPECT_EQ(-1, object->time_left(second));
+}
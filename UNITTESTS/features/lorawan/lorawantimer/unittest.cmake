@@ -35,6 +35,7 @@ set(unittest-test-sources
   stubs/EventQueue_stub.cpp
   stubs/mbed_assert_stub.cpp
   stubs/equeue_stub.c
+  stubs/mbed_critical_stub.c
 )
 
 set(unittest-test-flags
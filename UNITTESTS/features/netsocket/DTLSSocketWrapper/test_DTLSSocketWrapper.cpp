@@ -383,6 +383,16 @@ TEST_F(TestDTLSSocketWrapper, setsockopt)
     EXPECT_EQ(wrapper->setsockopt(0, 0, 0, 0), NSAPI_ERROR_UNSUPPORTED);
 }
 
+TEST_F(TestDTLSSocketWrapper, connection_id_unsupported)
+{
+    // MBEDTLS_SSL_DTLS_CONNECTION_ID is not in the test configuration
+    transport->open(&stack);
+    EXPECT_EQ(wrapper->setsockopt(NSAPI_TLSSOCKET_LEVEL, NSAPI_TLSSOCKET_DTLS_CID, 0, 0), NSAPI_ERROR_UNSUPPORTED);
+    int enabled;
+    unsigned len = sizeof(enabled);
+    EXPECT_EQ(wrapper->getsockopt(NSAPI_TLSSOCKET_LEVEL, NSAPI_TLSSOCKET_DTLS_CID, &enabled, &len), NSAPI_ERROR_UNSUPPORTED);
+}
+
 TEST_F(TestDTLSSocketWrapper, getsockopt_no_stack)
 {
     EXPECT_EQ(wrapper->getsockopt(0, 0, 0, 0), NSAPI_ERROR_NO_SOCKET);
@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/netsocket/MultiNetworkInterface.h"
+#include "events/EventQueue.h"
+#include "equeue_stub.h"
+#include "NetworkStack_stub.h"
+
+namespace mbed {
+extern events::EventQueue *mbed_shared_queue_stub;
+}
+
+using namespace std::chrono;
+
+class stubMemberInterface : public NetworkInterface {
+public:
+    stubMemberInterface() :
+        connect_retval(NSAPI_ERROR_OK),
+        blocking_retval(NSAPI_ERROR_OK),
+        connect_count(0),
+        disconnect_count(0),
+        status(NSAPI_STATUS_DISCONNECTED)
+    {
+    }
+    virtual nsapi_error_t connect()
+    {
+        connect_count++;
+        return connect_retval;
+    }
+    virtual nsapi_error_t disconnect()
+    {
+        disconnect_count++;
+        status = NSAPI_STATUS_DISCONNECTED;
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_error_t set_blocking(bool blocking)
+    {
+        return blocking_retval;
+    }
+    virtual nsapi_error_t get_ip_address(SocketAddress *address)
+    {
+        *address = ip;
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_connection_status_t get_connection_status() const
+    {
+        return status;
+    }
+    virtual NetworkStack *get_stack()
+    {
+        return &stack;
+    }
+    virtual void attach(mbed::Callback<void(nsapi_event_t, intptr_t)> cb)
+    {
+        status_cb = cb;
+    }
+    void event(nsapi_connection_status_t s)
+    {
+        status = s;
+        status_cb(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, s);
+    }
+
+    nsapi_error_t connect_retval;
+    nsapi_error_t blocking_retval;
+    int connect_count;
+    int disconnect_count;
+    nsapi_connection_status_t status;
+    SocketAddress ip;
+    NetworkStackstub stack;
+private:
+    mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb;
+};
+
+static int status_events;
+static nsapi_connection_status_t last_status;
+
+static void status_cb(nsapi_event_t event, intptr_t value)
+{
+    if (event == NSAPI_EVENT_CONNECTION_STATUS_CHANGE) {
+        status_events++;
+        last_status = static_cast<nsapi_connection_status_t>(value);
+    }
+}
+
+class TestMultiNetworkInterface : public testing::Test {
+protected:
+    stubMemberInterface *eth;
+    stubMemberInterface *cell;
+    MultiNetworkInterface *multi;
+    uint8_t event_buffer[64];
+
+    virtual void SetUp()
+    {
+        eth = new stubMemberInterface();
+        cell = new stubMemberInterface();
+        eth->ip.set_ip_address("192.168.0.2");
+        cell->ip.set_ip_address("10.0.0.2");
+        multi = new MultiNetworkInterface();
+        multi->attach(mbed::callback(status_cb));
+        status_events = 0;
+        last_status = NSAPI_STATUS_DISCONNECTED;
+
+        // Deferred calls, the grace period and disconnecting the losers, run at once
+        mbed::mbed_shared_queue_stub = new events::EventQueue();
+        equeue_stub.void_ptr = event_buffer;
+        equeue_stub.call_cb_immediately = true;
+    }
+
+    virtual void TearDown()
+    {
+        delete multi;
+        delete cell;
+        delete eth;
+        delete mbed::mbed_shared_queue_stub;
+        mbed::mbed_shared_queue_stub = NULL;
+        equeue_stub.void_ptr = NULL;
+        equeue_stub.call_cb_immediately = false;
+    }
+};
+
+TEST_F(TestMultiNetworkInterface, add_interface)
+{
+    EXPECT_EQ(NSAPI_ERROR_PARAMETER, multi->add_interface(NULL));
+    for (int i = 0; i < MBED_CONF_NSAPI_MULTI_INTERFACE_MAX; i++) {
+        EXPECT_EQ(NSAPI_ERROR_OK, multi->add_interface(eth));
+    }
+    EXPECT_EQ(NSAPI_ERROR_NO_MEMORY, multi->add_interface(cell));
+}
+
+TEST_F(TestMultiNetworkInterface, connect_no_interfaces)
+{
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->connect());
+    EXPECT_EQ(NSAPI_STATUS_DISCONNECTED, multi->get_connection_status());
+}
+
+TEST_F(TestMultiNetworkInterface, not_connected)
+{
+    SocketAddress addr;
+    multi->add_interface(eth);
+    EXPECT_EQ(NULL, multi->get_active_interface());
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->get_ip_address(&addr));
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->gethostbyname("localhost", &addr));
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->disconnect());
+}
+
+TEST_F(TestMultiNetworkInterface, first_up_wins)
+{
+    SocketAddress addr;
+    multi->add_interface(eth);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    EXPECT_EQ(1, eth->connect_count);
+    EXPECT_EQ(1, cell->connect_count);
+    EXPECT_EQ(NSAPI_STATUS_CONNECTING, multi->get_connection_status());
+    EXPECT_EQ(NSAPI_ERROR_BUSY, multi->connect());
+
+    cell->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(cell, multi->get_active_interface());
+    EXPECT_EQ(NSAPI_STATUS_GLOBAL_UP, multi->get_connection_status());
+    EXPECT_EQ(NSAPI_STATUS_GLOBAL_UP, last_status);
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->get_ip_address(&addr));
+    EXPECT_EQ(cell->ip, addr);
+
+    // The loser is disconnected and its later events ignored
+    EXPECT_EQ(1, eth->disconnect_count);
+    EXPECT_EQ(0, cell->disconnect_count);
+    eth->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(cell, multi->get_active_interface());
+}
+
+TEST_F(TestMultiNetworkInterface, preferred_wins)
+{
+    multi->add_interface(eth, true);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    eth->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(eth, multi->get_active_interface());
+}
+
+TEST_F(TestMultiNetworkInterface, grace_period_expires)
+{
+    multi->add_interface(eth, true);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    cell->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(cell, multi->get_active_interface());
+    EXPECT_EQ(1, eth->disconnect_count);
+}
+
+TEST_F(TestMultiNetworkInterface, no_grace_period)
+{
+    multi->add_interface(eth, true);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+    multi->set_grace_period(0s);
+
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    cell->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(cell, multi->get_active_interface());
+}
+
+TEST_F(TestMultiNetworkInterface, preferred_fails)
+{
+    multi->add_interface(eth, true);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+    multi->set_grace_period(0s);
+    eth->connect_retval = NSAPI_ERROR_NO_CONNECTION;
+
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    EXPECT_EQ(NSAPI_STATUS_CONNECTING, multi->get_connection_status());
+    cell->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(cell, multi->get_active_interface());
+    EXPECT_EQ(0, eth->disconnect_count);
+}
+
+TEST_F(TestMultiNetworkInterface, all_fail)
+{
+    multi->add_interface(eth);
+    multi->add_interface(cell);
+    eth->connect_retval = NSAPI_ERROR_NO_CONNECTION;
+    cell->connect_retval = NSAPI_ERROR_DEVICE_ERROR;
+
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->connect());
+    EXPECT_EQ(NSAPI_STATUS_DISCONNECTED, multi->get_connection_status());
+    EXPECT_EQ(NULL, multi->get_active_interface());
+}
+
+TEST_F(TestMultiNetworkInterface, blocking_member)
+{
+    multi->add_interface(eth);
+    multi->add_interface(cell);
+    eth->connect_retval = NSAPI_ERROR_NO_CONNECTION;
+    cell->blocking_retval = NSAPI_ERROR_UNSUPPORTED;
+
+    // The blocking member is connected after the others failed
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    EXPECT_EQ(cell, multi->get_active_interface());
+    EXPECT_EQ(NSAPI_STATUS_GLOBAL_UP, multi->get_connection_status());
+}
+
+TEST_F(TestMultiNetworkInterface, blocking_member_skipped)
+{
+    multi->add_interface(eth);
+    multi->add_interface(cell);
+    eth->connect_retval = NSAPI_ERROR_IS_CONNECTED;
+    cell->blocking_retval = NSAPI_ERROR_UNSUPPORTED;
+
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->connect());
+    EXPECT_EQ(eth, multi->get_active_interface());
+    EXPECT_EQ(0, cell->connect_count);
+}
+
+TEST_F(TestMultiNetworkInterface, active_lost)
+{
+    SocketAddress addr;
+    multi->add_interface(eth);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+
+    multi->connect();
+    eth->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(eth, multi->get_active_interface());
+
+    eth->event(NSAPI_STATUS_DISCONNECTED);
+    EXPECT_EQ(NSAPI_STATUS_DISCONNECTED, multi->get_connection_status());
+    EXPECT_EQ(NSAPI_STATUS_DISCONNECTED, last_status);
+    EXPECT_EQ(NULL, multi->get_active_interface());
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->get_ip_address(&addr));
+}
+
+TEST_F(TestMultiNetworkInterface, disconnect)
+{
+    multi->add_interface(eth);
+    multi->add_interface(cell);
+    multi->set_blocking(false);
+
+    multi->connect();
+    EXPECT_EQ(NSAPI_ERROR_OK, multi->disconnect());
+    EXPECT_EQ(1, eth->disconnect_count);
+    EXPECT_EQ(1, cell->disconnect_count);
+    EXPECT_EQ(NSAPI_STATUS_DISCONNECTED, multi->get_connection_status());
+
+    // Late events from the members are ignored
+    eth->event(NSAPI_STATUS_GLOBAL_UP);
+    EXPECT_EQ(NULL, multi->get_active_interface());
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, multi->disconnect());
+}
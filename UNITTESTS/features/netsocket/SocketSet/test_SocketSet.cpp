@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/netsocket/SocketSet.h"
+#include <list>
+
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+// Socket that only records its sigio callback
+class stubSocket : public Socket {
+public:
+    mbed::Callback<void()> callback;
+
+    void sigio(mbed::Callback<void()> func) override
+    {
+        callback = func;
+    }
+    void event()
+    {
+        if (callback) {
+            callback();
+        }
+    }
+
+    nsapi_error_t close() override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_error_t connect(const SocketAddress &address) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_size_or_error_t send(const void *data, nsapi_size_t size) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_size_or_error_t recv(void *data, nsapi_size_t size) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_size_or_error_t sendto(const SocketAddress &address, const void *data, nsapi_size_t size) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_size_or_error_t recvfrom(SocketAddress *address, void *data, nsapi_size_t size) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_error_t bind(const SocketAddress &address) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    void set_blocking(bool blocking) override {}
+    void set_timeout(int timeout) override {}
+    nsapi_error_t setsockopt(int level, int optname, const void *optval, unsigned optlen) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_error_t getsockopt(int level, int optname, void *optval, unsigned *optlen) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    Socket *accept(nsapi_error_t *error = NULL) override
+    {
+        return NULL;
+    }
+    nsapi_error_t listen(int backlog = 1) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+    nsapi_error_t getpeername(SocketAddress *address) override
+    {
+        return NSAPI_ERROR_OK;
+    }
+};
+
+class TestSocketSet : public testing::Test {
+protected:
+    SocketSet *set;
+    stubSocket sockets[3];
+    SocketSet::event_t events[3];
+
+    virtual void SetUp()
+    {
+        set = new SocketSet(2);
+        eventFlagsStubNextRetval.clear();
+    }
+
+    virtual void TearDown()
+    {
+        delete set;
+    }
+};
+
+TEST_F(TestSocketSet, add_reports_once)
+{
+    EXPECT_EQ(set->add(&sockets[0], POLLIN, &sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_TRUE(sockets[0].callback);
+
+    EXPECT_EQ(set->wait(events, 3, 0), 1);
+    EXPECT_EQ(events[0].socket, &sockets[0]);
+    EXPECT_EQ(events[0].events, POLLIN);
+    EXPECT_EQ(events[0].data, &sockets[0]);
+
+    EXPECT_EQ(set->wait(events, 3, 0), 0);
+}
+
+TEST_F(TestSocketSet, add_invalid)
+{
+    EXPECT_EQ(set->add(NULL, POLLIN), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set->add(&sockets[0], POLLIN), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->add(&sockets[0], POLLIN), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set->add(&sockets[1], POLLIN), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->add(&sockets[2], POLLIN), NSAPI_ERROR_NO_MEMORY);
+}
+
+TEST_F(TestSocketSet, only_signalled_reported)
+{
+    set->add(&sockets[0], POLLIN);
+    set->add(&sockets[1], POLLOUT);
+    EXPECT_EQ(set->wait(events, 3, 0), 2);
+
+    sockets[1].event();
+    sockets[1].event();
+    EXPECT_EQ(set->wait(events, 3, 0), 1);
+    EXPECT_EQ(events[0].socket, &sockets[1]);
+    EXPECT_EQ(events[0].events, POLLOUT);
+}
+
+TEST_F(TestSocketSet, wait_limited_by_max_events)
+{
+    set->add(&sockets[0], POLLIN);
+    set->add(&sockets[1], POLLIN);
+
+    EXPECT_EQ(set->wait(events, 1, 0), 1);
+    EXPECT_EQ(events[0].socket, &sockets[0]);
+    EXPECT_EQ(set->wait(events, 1, 0), 1);
+    EXPECT_EQ(events[0].socket, &sockets[1]);
+}
+
+TEST_F(TestSocketSet, wait_timeout)
+{
+    eventFlagsStubNextRetval.push_back(osFlagsErrorTimeout);
+    EXPECT_EQ(set->wait(events, 3, 100), 0);
+}
+
+TEST_F(TestSocketSet, modify)
+{
+    EXPECT_EQ(set->modify(&sockets[0], POLLIN), NSAPI_ERROR_PARAMETER);
+    set->add(&sockets[0], POLLIN);
+    set->wait(events, 3, 0);
+
+    EXPECT_EQ(set->modify(&sockets[0], 0), NSAPI_ERROR_OK);
+    sockets[0].event();
+    EXPECT_EQ(set->wait(events, 3, 0), 0);
+
+    EXPECT_EQ(set->modify(&sockets[0], POLLIN | POLLOUT), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->wait(events, 3, 0), 1);
+    EXPECT_EQ(events[0].events, POLLIN | POLLOUT);
+}
+
+TEST_F(TestSocketSet, remove)
+{
+    EXPECT_EQ(set->remove(&sockets[0]), NSAPI_ERROR_PARAMETER);
+    set->add(&sockets[0], POLLIN);
+    set->add(&sockets[1], POLLIN);
+
+    EXPECT_EQ(set->remove(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_FALSE(sockets[0].callback);
+    EXPECT_EQ(set->wait(events, 3, 0), 1);
+    EXPECT_EQ(events[0].socket, &sockets[1]);
+
+    EXPECT_EQ(set->add(&sockets[2], POLLIN), NSAPI_ERROR_OK);
+}
@@ -0,0 +1,22 @@
+
+####################
+# UNIT TESTS
+####################
+
+# Unit test suite name
+set(TEST_SUITE_NAME "features_netsocket_SocketSet")
+
+# Source files
+set(unittest-sources
+  ../features/netsocket/SocketSet.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  features/netsocket/SocketSet/test_SocketSet.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+  stubs/EventFlags_stub.cpp
+  stubs/Kernel_stub.cpp
+)
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "features/netsocket/TCPSocket.h"
 #include "NetworkStack_stub.h"
+#include "NetStackMemoryManager_stub.h"
 
 // Control the rtos EventFlags stub. See EventFlags_stub.cpp
 extern std::list<uint32_t> eventFlagsStubNextRetval;
@@ -258,6 +259,82 @@ TEST_F(TestTCPSocket, recv_from_null)
     EXPECT_EQ(socket->recvfrom(NULL, dataBuf, dataSize), NSAPI_ERROR_OK);
 }
 
+TEST_F(TestTCPSocket, send_buf_no_memory_manager)
+{
+    NetStackMemoryManagerstub mem;
+    net_stack_mem_buf_t *buf = mem.alloc_heap(dataSize, 0);
+    EXPECT_EQ(socket->send_buf(buf), NSAPI_ERROR_NO_SOCKET);
+    socket->open(&stack);
+    EXPECT_EQ(socket->send_buf(buf), NSAPI_ERROR_UNSUPPORTED);
+    mem.free(buf);
+}
+
+TEST_F(TestTCPSocket, send_buf_chain)
+{
+    NetStackMemoryManagerstub mem;
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+    EXPECT_EQ(socket->get_memory_manager(), &mem);
+
+    // Each buffer of the chain goes to socket_send in turn
+    net_stack_mem_buf_t *buf = mem.alloc_pool(20, 0);
+    stack.return_values.push_back(8);
+    stack.return_values.push_back(8);
+    stack.return_values.push_back(4);
+    EXPECT_EQ(socket->send_buf(buf), 20);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestTCPSocket, send_buf_partial)
+{
+    NetStackMemoryManagerstub mem;
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+
+    // The rest of a buffer cut short is sent from the offset reached
+    net_stack_mem_buf_t *buf = mem.alloc_pool(16, 0);
+    stack.return_values.push_back(5);
+    stack.return_values.push_back(3);
+    stack.return_values.push_back(8);
+    EXPECT_EQ(socket->send_buf(buf), 16);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestTCPSocket, send_buf_would_block)
+{
+    NetStackMemoryManagerstub mem;
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->send_buf(mem.alloc_heap(dataSize, 0)), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestTCPSocket, recv_buf)
+{
+    NetStackMemoryManagerstub mem;
+    net_stack_mem_buf_t *buf;
+    EXPECT_EQ(socket->recv_buf(&buf, dataSize), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(buf, (net_stack_mem_buf_t *)NULL);
+
+    socket->open(&stack);
+    EXPECT_EQ(socket->recv_buf(&buf, dataSize), NSAPI_ERROR_UNSUPPORTED);
+
+    stack.memory_manager = &mem;
+    stack.return_value = 4;
+    EXPECT_EQ(socket->recv_buf(&buf, dataSize), 4);
+    ASSERT_NE(buf, (net_stack_mem_buf_t *)NULL);
+    EXPECT_EQ(mem.get_total_len(buf), 4);
+    mem.free(buf);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->recv_buf(&buf, dataSize), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(buf, (net_stack_mem_buf_t *)NULL);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
 TEST_F(TestTCPSocket, unsupported_api)
 {
     SocketAddress addr;
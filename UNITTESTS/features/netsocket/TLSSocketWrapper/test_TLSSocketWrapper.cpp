@@ -129,6 +129,24 @@ TEST_F(TestTLSSocketWrapper, connect)
     EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_IS_CONNECTED);
 }
 
+TEST_F(TestTLSSocketWrapper, set_max_fragment_length)
+{
+    EXPECT_EQ(wrapper->set_max_fragment_length(1024), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(0), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(1000), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(wrapper->get_max_fragment_length(), 0u);
+}
+
+TEST_F(TestTLSSocketWrapper, connect_session_not_resumed)
+{
+    transport->open(&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    wrapper->set_session_resumption(true);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_FALSE(wrapper->is_session_resumed());
+    TLSSocketWrapper::clear_session_cache();
+}
+
 /* connect: TCP-related errors */
 
 TEST_F(TestTLSSocketWrapper, connect_no_open)
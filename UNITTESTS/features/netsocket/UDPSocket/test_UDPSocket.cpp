@@ -19,6 +19,7 @@
 #include "features/netsocket/UDPSocket.h"
 #include "features/netsocket/nsapi_dns.h"
 #include "NetworkStack_stub.h"
+#include "NetStackMemoryManager_stub.h"
 
 /**
  * This test needs to access a private function
@@ -145,6 +146,199 @@ TEST_F(TestUDPSocket, recv_address_filtering)
     EXPECT_EQ(socket->recvfrom(&a1, &dataBuf, dataSize), 100);
 }
 
+TEST_F(TestUDPSocket, sendto_buf)
+{
+    NetStackMemoryManagerstub mem;
+    const SocketAddress a("127.0.0.1", 1024);
+
+    socket->open(&stack);
+    net_stack_mem_buf_t *buf = mem.alloc_heap(dataSize, 0);
+    EXPECT_EQ(socket->sendto_buf(a, buf), NSAPI_ERROR_UNSUPPORTED);
+    mem.free(buf);
+
+    stack.memory_manager = &mem;
+    stack.return_value = dataSize;
+    EXPECT_EQ(socket->sendto_buf(a, mem.alloc_heap(dataSize, 0)), dataSize);
+
+    // Chains are joined up for socket_sendto
+    stack.return_value = 20;
+    EXPECT_EQ(socket->sendto_buf(a, mem.alloc_pool(20, 0)), 20);
+
+    stack.return_value = NSAPI_ERROR_NO_MEMORY;
+    EXPECT_EQ(socket->sendto_buf(a, mem.alloc_heap(dataSize, 0)), NSAPI_ERROR_NO_MEMORY);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestUDPSocket, sendto_buf_timeout)
+{
+    NetStackMemoryManagerstub mem;
+    const SocketAddress a("127.0.0.1", 1024);
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+
+    // The stack hands the buffer back each time it would block
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->sendto_buf(a, mem.alloc_pool(20, 0)), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestUDPSocket, send_buf_no_address)
+{
+    NetStackMemoryManagerstub mem;
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+    EXPECT_EQ(socket->send_buf(mem.alloc_heap(dataSize, 0)), NSAPI_ERROR_NO_ADDRESS);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestUDPSocket, recv_buf)
+{
+    NetStackMemoryManagerstub mem;
+    net_stack_mem_buf_t *buf;
+    EXPECT_EQ(socket->recv_buf(&buf, dataSize), NSAPI_ERROR_NO_SOCKET);
+
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+    stack.return_value = 6;
+    EXPECT_EQ(socket->recv_buf(&buf, dataSize), 6);
+    ASSERT_NE(buf, (net_stack_mem_buf_t *)NULL);
+    EXPECT_EQ(mem.get_total_len(buf), 6);
+    mem.free(buf);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestUDPSocket, recv_buf_address_filtering)
+{
+    NetStackMemoryManagerstub mem;
+    net_stack_mem_buf_t *buf;
+    stack.memory_manager = &mem;
+    socket->open(&stack);
+    const nsapi_addr_t addr1 = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const nsapi_addr_t addr2 = {NSAPI_IPv4, {127, 0, 0, 2} };
+    SocketAddress a1(addr1, 1024);
+    SocketAddress a2(addr2, 1024);
+
+    EXPECT_EQ(socket->connect(a1), NSAPI_ERROR_OK);
+
+    // The packet from the wrong address is dropped along with its buffer
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(NSAPI_ERROR_NO_MEMORY);
+    EXPECT_EQ(socket->recvfrom_buf(&a2, &buf, dataSize), NSAPI_ERROR_NO_MEMORY);
+    EXPECT_EQ(buf, (net_stack_mem_buf_t *)NULL);
+    EXPECT_EQ(mem.allocated, 0);
+}
+
+TEST_F(TestUDPSocket, sendto_batch)
+{
+    nsapi_datagram_t datagrams[3];
+    const nsapi_addr_t addr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    for (int i = 0; i < 3; i++) {
+        datagrams[i].address = SocketAddress(addr, 1024 + i);
+        datagrams[i].data = dataBuf;
+        datagrams[i].size = dataSize;
+    }
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+    stack.return_value = dataSize;
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), 3);
+    EXPECT_EQ(datagrams[2].result, dataSize);
+
+    // Sending stops at the first datagram that fails
+    stack.return_values.push_back(dataSize);
+    stack.return_values.push_back(NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), 1);
+    EXPECT_EQ(datagrams[1].result, NSAPI_ERROR_PARAMETER);
+
+    stack.return_value = NSAPI_ERROR_NO_MEMORY;
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), NSAPI_ERROR_NO_MEMORY);
+}
+
+TEST_F(TestUDPSocket, sendto_batch_blocking)
+{
+    nsapi_datagram_t datagrams[3];
+    const nsapi_addr_t addr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    for (int i = 0; i < 3; i++) {
+        datagrams[i].address = SocketAddress(addr, 1024);
+        datagrams[i].data = dataBuf;
+        datagrams[i].size = dataSize;
+    }
+    socket->open(&stack);
+
+    // The rest of the batch is sent once the stack can take it
+    stack.return_values.push_back(dataSize);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    stack.return_value = dataSize;
+    eventFlagsStubNextRetval.push_back(0);
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), 3);
+
+    // A timeout counts what was sent so far
+    stack.return_values.push_back(dataSize);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(osFlagsError);
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), 1);
+    EXPECT_EQ(datagrams[1].result, NSAPI_ERROR_WOULD_BLOCK);
+
+    socket->set_blocking(false);
+    EXPECT_EQ(socket->sendto_batch(datagrams, 3), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch)
+{
+    nsapi_datagram_t datagrams[3];
+    char bufs[3][sizeof(dataBuf)];
+    for (int i = 0; i < 3; i++) {
+        datagrams[i].data = bufs[i];
+        datagrams[i].size = dataSize;
+    }
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 3), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+
+    // Whatever is waiting after the first datagram is returned with it
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(4);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 3), 2);
+    EXPECT_EQ(datagrams[0].result, 6);
+    EXPECT_EQ(datagrams[1].result, 4);
+
+    socket->set_blocking(false);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 3), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch_address_filtering)
+{
+    nsapi_datagram_t datagrams[2];
+    char bufs[2][sizeof(dataBuf)];
+    for (int i = 0; i < 2; i++) {
+        datagrams[i].data = bufs[i];
+        datagrams[i].size = dataSize;
+    }
+    socket->open(&stack);
+    const nsapi_addr_t addr1 = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const nsapi_addr_t addr2 = {NSAPI_IPv4, {127, 0, 0, 2} };
+    SocketAddress a1(addr1, 1024);
+    SocketAddress a2(addr2, 1024);
+
+    EXPECT_EQ(socket->connect(a1), NSAPI_ERROR_OK);
+
+    // Everything from the wrong address is dropped and the stack asked again
+    stack.return_socketAddress = a2;
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(NSAPI_ERROR_NO_MEMORY);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 2), NSAPI_ERROR_NO_MEMORY);
+
+    stack.return_socketAddress = a1;
+    stack.return_values.push_back(6);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 2), 1);
+    EXPECT_EQ(datagrams[0].address, a1);
+}
+
 TEST_F(TestUDPSocket, unsupported_api)
 {
     nsapi_error_t error;
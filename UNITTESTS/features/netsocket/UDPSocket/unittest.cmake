@@ -3,9 +3,12 @@
 # UNIT TESTS
 ####################
 
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT=10 -DMBED_CONF_NSAPI_HAPPY_EYEBALLS_DELAY=250")
+
 set(unittest-sources
   ../features/netsocket/SocketAddress.cpp
   ../features/netsocket/NetworkStack.cpp
+  ../features/netsocket/NetStackMemoryManager.cpp
   ../features/netsocket/InternetSocket.cpp
   ../features/netsocket/InternetDatagramSocket.cpp
   ../features/netsocket/UDPSocket.cpp
@@ -27,6 +30,7 @@ set(unittest-test-sources
   stubs/mbed_error.c
   stubs/mbed_shared_queues_stub.cpp
   stubs/EventFlags_stub.cpp
+  stubs/Kernel_stub.cpp
   stubs/nsapi_dns_stub.cpp
   stubs/stoip4_stub.c
   stubs/ip4tos_stub.c
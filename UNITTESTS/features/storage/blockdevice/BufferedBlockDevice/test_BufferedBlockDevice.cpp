@@ -316,3 +316,77 @@ TEST_F(BufferedBlockModuleTest, flush_automatically)
     .Times(1)
     .WillOnce(Return(BD_ERROR_OK));
 }
+
+TEST_F(BufferedBlockModuleTest, multi_entry_merge_on_sync)
+{
+    BufferedBlockDevice b(&bd_mock, 4, 2);
+
+    EXPECT_CALL(bd_mock, init());
+    EXPECT_CALL(bd_mock, get_read_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, get_program_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, size()).WillOnce(Return(DEVICE_SIZE));
+    ASSERT_EQ(b.init(), 0);
+
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+    EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    // Both units are completed, but stay in cache
+    EXPECT_EQ(b.program(magic, 0, BLOCK_SIZE / 2), 0);
+    EXPECT_EQ(b.program(magic + BLOCK_SIZE / 2, BLOCK_SIZE / 2, BLOCK_SIZE), 0);
+
+    EXPECT_CALL(bd_mock, is_valid_read(0, BLOCK_SIZE * 2)).WillOnce(Return(true));
+    EXPECT_EQ(b.read(buf, 0, BLOCK_SIZE * 2), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE * 3 / 2));
+
+    // Adjacent dirty units are programmed in one go
+    EXPECT_CALL(bd_mock, program(_, 0, BLOCK_SIZE * 2))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, sync());
+    EXPECT_EQ(b.sync(), 0);
+
+    // Nothing left to write back
+    EXPECT_CALL(bd_mock, sync());
+    EXPECT_CALL(bd_mock, deinit());
+    EXPECT_EQ(b.deinit(), 0);
+}
+
+TEST_F(BufferedBlockModuleTest, multi_entry_lru_eviction)
+{
+    BufferedBlockDevice b(&bd_mock, 4, 2);
+
+    EXPECT_CALL(bd_mock, init());
+    EXPECT_CALL(bd_mock, get_read_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, get_program_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, size()).WillOnce(Return(DEVICE_SIZE));
+    ASSERT_EQ(b.init(), 0);
+
+    EXPECT_CALL(bd_mock, read(_, _, BLOCK_SIZE))
+    .Times(3)
+    .WillRepeatedly(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    // Units 0, 2 and 4 all map to the first set of two ways
+    EXPECT_EQ(b.program("a", 0, 1), 0);
+    EXPECT_EQ(b.program("b", BLOCK_SIZE * 2, 1), 0);
+    EXPECT_EQ(b.program("c", 1, 1), 0);
+
+    // Unit 2 is the least recently used
+    EXPECT_CALL(bd_mock, program(_, BLOCK_SIZE * 2, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_EQ(b.program("d", BLOCK_SIZE * 4, 1), 0);
+
+    // Both remaining units are written back, lowest address first
+    {
+        ::testing::InSequence s;
+        EXPECT_CALL(bd_mock, program(_, 0, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+        EXPECT_CALL(bd_mock, program(_, BLOCK_SIZE * 4, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+        EXPECT_CALL(bd_mock, sync());
+    }
+    EXPECT_CALL(bd_mock, deinit());
+    EXPECT_EQ(b.deinit(), 0);
+}
@@ -0,0 +1,159 @@
+/* Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "stubs/BlockDevice_mock.h"
+#include "features/storage/blockdevice/CachingBlockDevice.h"
+#include "features/storage/blockdevice/HeapBlockDevice.h"
+
+#define BLOCK_SIZE (512)
+#define DEVICE_SIZE (BLOCK_SIZE*10)
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::DoAll;
+
+class CachingBlockModuleTest : public testing::Test {
+protected:
+    BlockDeviceMock bd_mock;
+    CachingBlockDevice bd{&bd_mock, BLOCK_SIZE, 2};
+    uint8_t *magic;
+    uint8_t *buf;
+    virtual void SetUp()
+    {
+        ON_CALL(bd_mock, size()).WillByDefault(Return(DEVICE_SIZE));
+        ON_CALL(bd_mock, get_erase_size(_)).WillByDefault(Return(BLOCK_SIZE));
+        ON_CALL(bd_mock, get_erase_size()).WillByDefault(Return(BLOCK_SIZE));
+        ON_CALL(bd_mock, get_program_size()).WillByDefault(Return(1));
+        ON_CALL(bd_mock, get_read_size()).WillByDefault(Return(1));
+        ON_CALL(bd_mock, is_valid_erase(_, _)).WillByDefault(Return(true));
+        ON_CALL(bd_mock, init()).WillByDefault(Return(BD_ERROR_OK));
+
+        ASSERT_EQ(bd.init(), 0);
+        magic = new uint8_t[BLOCK_SIZE];
+        buf = new uint8_t[BLOCK_SIZE];
+        // Generate simple pattern to verify against
+        for (int i = 0; i < BLOCK_SIZE; i++) {
+            magic[i] = 0xaa + i;
+        }
+    }
+
+    virtual void TearDown()
+    {
+        ASSERT_EQ(bd.deinit(), 0);
+        delete[] magic;
+        delete[] buf;
+    }
+};
+
+TEST_F(CachingBlockModuleTest, init)
+{
+    EXPECT_EQ(bd.get_erase_size(), bd_mock.get_erase_size());
+    EXPECT_EQ(bd.get_program_size(), bd_mock.get_program_size());
+    EXPECT_EQ(bd.get_read_size(), bd_mock.get_read_size());
+    EXPECT_EQ(bd.size(), DEVICE_SIZE);
+    EXPECT_EQ(bd.get_type(), bd_mock.get_type());
+}
+
+TEST_F(CachingBlockModuleTest, hit_and_miss)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(bd.read(buf, 16, 16), 0);
+    EXPECT_EQ(0, memcmp(buf, magic + 16, 16));
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+
+    EXPECT_EQ(bd.get_miss_count(), 1);
+    EXPECT_EQ(bd.get_hit_count(), 1);
+
+    bd.reset_counters();
+    EXPECT_EQ(bd.get_miss_count(), 0);
+    EXPECT_EQ(bd.get_hit_count(), 0);
+}
+
+TEST_F(CachingBlockModuleTest, lru_replacement)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+    EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE, BLOCK_SIZE))
+    .Times(2)
+    .WillRepeatedly(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+    EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE * 2, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    EXPECT_EQ(bd.read(buf, BLOCK_SIZE, 1), 0);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    // Replaces the second page, which is the least recently read
+    EXPECT_EQ(bd.read(buf, BLOCK_SIZE * 2, 1), 0);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    EXPECT_EQ(bd.read(buf, BLOCK_SIZE, 1), 0);
+
+    EXPECT_EQ(bd.get_miss_count(), 4);
+    EXPECT_EQ(bd.get_hit_count(), 2);
+}
+
+TEST_F(CachingBlockModuleTest, invalidate_on_write)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+    .Times(3)
+    .WillRepeatedly(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+    EXPECT_CALL(bd_mock, program(_, 8, 8)).WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, erase(0, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    EXPECT_EQ(bd.program(magic, 8, 8), 0);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+
+    EXPECT_EQ(bd.get_miss_count(), 3);
+    EXPECT_EQ(bd.get_hit_count(), 0);
+}
+
+TEST_F(CachingBlockModuleTest, large_read_bypasses_cache)
+{
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE * 2)).WillOnce(Return(BD_ERROR_OK));
+
+    uint8_t big[BLOCK_SIZE * 2];
+    EXPECT_EQ(bd.read(big, 0, BLOCK_SIZE * 2), 0);
+    EXPECT_EQ(bd.get_miss_count(), 0);
+}
+
+TEST_F(CachingBlockModuleTest, cache_block_device)
+{
+    HeapBlockDevice heap(BLOCK_SIZE * 2, 1, 1, BLOCK_SIZE);
+    CachingBlockDevice cached(&bd_mock, BLOCK_SIZE, 2, &heap);
+    ASSERT_EQ(cached.init(), 0);
+
+    EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(cached.read(buf, BLOCK_SIZE + 4, 4), 0);
+    EXPECT_EQ(0, memcmp(buf, magic + 4, 4));
+    EXPECT_EQ(cached.read(buf, BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+
+    EXPECT_EQ(cached.get_miss_count(), 1);
+    EXPECT_EQ(cached.get_hit_count(), 1);
+    EXPECT_EQ(cached.deinit(), 0);
+}
@@ -161,3 +161,53 @@ TEST_F(ChainingBlockModuleTest, memory_overlap)
     EXPECT_EQ(bd.erase((SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 4 * BLOCK_SIZE), BD_ERROR_OK);
 }
 
+
+static int async_result;
+static int async_calls;
+
+static void async_done(int err)
+{
+    async_result = err;
+    async_calls++;
+}
+
+TEST_F(ChainingBlockModuleTest, async)
+{
+    async_calls = 0;
+
+    // Within bd_mock2, forwarded with the address translated
+    EXPECT_CALL(bd_mock2, program(ByteBufferMatcher(magic, BLOCK_SIZE * 2), 2 * BLOCK_SIZE, 2 * BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_EQ(bd.program_async(magic, (SECTORS_NUM / 2 + 2) * BLOCK_SIZE, 2 * BLOCK_SIZE, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 1);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+
+    // Across both, split as for a blocking read
+    EXPECT_CALL(bd_mock1, read(_, (SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 2 * BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, 2 * BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_CALL(bd_mock2, read(_, 0, 2 * BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic + 2 * BLOCK_SIZE, 2 * BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(bd.read_async(buf, (SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 4 * BLOCK_SIZE, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 2);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+    EXPECT_EQ(memcmp(magic, buf, BLOCK_SIZE * 4), 0);
+
+    // Errors are reported through the callback
+    EXPECT_CALL(bd_mock1, erase(0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_DEVICE_ERROR));
+
+    EXPECT_EQ(bd.erase_async(0, BLOCK_SIZE, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 3);
+    EXPECT_EQ(async_result, BD_ERROR_DEVICE_ERROR);
+
+    // Invalid ranges are rejected without calling back
+    EXPECT_EQ(bd.erase_async(0, BLOCK_SIZE + 1, async_done), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(async_calls, 3);
+}
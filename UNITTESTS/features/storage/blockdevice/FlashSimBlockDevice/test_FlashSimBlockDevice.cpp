@@ -164,3 +164,83 @@ TEST_F(FlashSimBlockModuleTest, erase_invalid)
     // Unaligned erase should fail
     EXPECT_EQ(bd.erase(0, BLOCK_SIZE-1), BD_ERROR_DEVICE_ERROR);
 }
+
+TEST_F(FlashSimBlockModuleTest, wear_tracking)
+{
+    EXPECT_EQ(bd.get_max_erase_count(), 0);
+    EXPECT_EQ(bd.get_total_erase_count(), 0);
+
+    EXPECT_CALL(bd_mock, program(ByteBufferMatcher(erased_mem, BLOCK_SIZE), 0, BLOCK_SIZE))
+    .Times(3)
+    .WillRepeatedly(Return(BD_ERROR_OK));
+
+    // Erases before tracking is enabled are not counted
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.enable_wear_tracking(), 0);
+    EXPECT_EQ(bd.get_erase_count(0), 0);
+
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_erase_count(0), 2);
+    EXPECT_EQ(bd.get_erase_count(BLOCK_SIZE - 1), 2);
+    EXPECT_EQ(bd.get_erase_count(BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_max_erase_count(), 2);
+    EXPECT_EQ(bd.get_total_erase_count(), 2);
+
+    // Failed erases are not counted
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE - 1), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(bd.get_total_erase_count(), 2);
+
+    bd.reset_stats();
+    EXPECT_EQ(bd.get_erase_count(0), 0);
+    EXPECT_EQ(bd.get_total_erase_count(), 0);
+}
+
+TEST_F(FlashSimBlockModuleTest, cost_model)
+{
+    const FlashSimBlockDevice::cost_model_t model = {
+        10,     // read_op_ns
+        1,      // read_byte_ns
+        2,      // program_byte_ns
+        256,    // program_unit_size
+        1000,   // program_unit_ns
+        4096,   // erase_unit_size
+        100000, // erase_unit_ns
+    };
+
+    EXPECT_CALL(bd_mock, program(ByteBufferMatcher(erased_mem, BLOCK_SIZE), 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    // Nothing is accounted without a model
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_elapsed_ns(), 0);
+
+    bd.set_cost_model(&model);
+
+    EXPECT_CALL(bd_mock, program(ByteBufferMatcher(erased_mem, BLOCK_SIZE), 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    // A 512 byte erase still costs a whole 4 KiB erase unit of the part
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_elapsed_ns(), 100000);
+
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+    .Times(2)
+    .WillRepeatedly(DoAll(SetArg0ToCharPtr(erased_mem, BLOCK_SIZE), Return(BD_ERROR_OK)));
+    EXPECT_CALL(bd_mock, program(ByteBufferMatcher(magic, BLOCK_SIZE), 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+
+    // Two 256 byte pages plus the transfer
+    EXPECT_EQ(bd.program(magic, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_elapsed_ns(), 100000 + 2 * 1000 + 2 * BLOCK_SIZE);
+
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_elapsed_ns(), 100000 + 2 * 1000 + 2 * BLOCK_SIZE + 10 + BLOCK_SIZE);
+
+    bd.reset_stats();
+    EXPECT_EQ(bd.get_elapsed_ns(), 0);
+    bd.set_cost_model(NULL);
+}
@@ -92,3 +92,36 @@ TEST_F(ProfilingBlockModuleTest, count) {
     EXPECT_EQ(bd.get_program_count(), 0);
     EXPECT_EQ(bd.get_erase_count(), 0);
 }
+
+TEST_F(ProfilingBlockModuleTest, stats)
+{
+    EXPECT_EQ(bd.get_read_stats().calls, 0);
+
+    EXPECT_EQ(bd.program(magic, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE * 2), 0);
+
+    const ProfilingBlockDevice::op_stats_t &read = bd.get_read_stats();
+    EXPECT_EQ(read.calls, 2);
+    EXPECT_LE(read.min_us, read.max_us);
+    // 512 bytes lands in bucket 10, 1 byte in bucket 1
+    EXPECT_EQ(read.size_histogram[10], 1);
+    EXPECT_EQ(read.size_histogram[1], 1);
+
+    uint32_t timed = 0;
+    for (int i = 0; i < ProfilingBlockDevice::HISTOGRAM_BUCKETS; i++) {
+        timed += read.duration_histogram[i];
+    }
+    EXPECT_EQ(timed, 2);
+
+    EXPECT_EQ(bd.get_program_stats().calls, 1);
+    EXPECT_EQ(bd.get_erase_stats().calls, 2);
+    EXPECT_EQ(bd.get_erase_stats().size_histogram[11], 1);
+
+    bd.reset();
+    EXPECT_EQ(bd.get_read_stats().calls, 0);
+    EXPECT_EQ(bd.get_read_stats().size_histogram[10], 0);
+    EXPECT_EQ(bd.get_erase_stats().total_us, 0);
+}
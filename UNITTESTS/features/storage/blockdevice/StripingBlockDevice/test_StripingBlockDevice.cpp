@@ -0,0 +1,116 @@
+/* Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/storage/blockdevice/StripingBlockDevice.h"
+#include "features/storage/blockdevice/HeapBlockDevice.h"
+
+#define BLOCK_SIZE (512)
+#define STRIPE_SIZE (BLOCK_SIZE * 2)
+#define DEVICE_SIZE (STRIPE_SIZE * 4)
+
+class StripingBlockModuleTest : public testing::Test {
+protected:
+    HeapBlockDevice heap1{DEVICE_SIZE, BLOCK_SIZE};
+    HeapBlockDevice heap2{DEVICE_SIZE + BLOCK_SIZE, BLOCK_SIZE};
+    BlockDevice *bds[2] = {&heap1, &heap2};
+    StripingBlockDevice bd{bds, STRIPE_SIZE};
+    uint8_t *magic;
+    uint8_t *buf;
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(bd.init(), 0);
+        magic = new uint8_t[STRIPE_SIZE * 3];
+        buf = new uint8_t[STRIPE_SIZE * 3];
+        // Generate simple pattern to verify against
+        for (int i = 0; i < STRIPE_SIZE * 3; i++) {
+            magic[i] = 0xaa + i;
+        }
+    }
+
+    virtual void TearDown()
+    {
+        ASSERT_EQ(bd.deinit(), 0);
+        delete[] magic;
+        delete[] buf;
+    }
+};
+
+TEST_F(StripingBlockModuleTest, init)
+{
+    EXPECT_EQ(bd.get_stripe_size(), STRIPE_SIZE);
+    EXPECT_EQ(bd.get_erase_size(), BLOCK_SIZE);
+    EXPECT_EQ(bd.get_erase_size(STRIPE_SIZE), BLOCK_SIZE);
+    // Only whole stripes of the smaller device are used
+    EXPECT_EQ(bd.size(), DEVICE_SIZE * 2);
+    EXPECT_EQ(strcmp(bd.get_type(), "STRIPING"), 0);
+}
+
+TEST_F(StripingBlockModuleTest, stripes)
+{
+    // Starts half way through a stripe of heap2, then one stripe of each
+    EXPECT_EQ(bd.program(magic, STRIPE_SIZE + BLOCK_SIZE, STRIPE_SIZE * 2 + BLOCK_SIZE), 0);
+
+    EXPECT_EQ(heap2.read(buf, BLOCK_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(memcmp(buf, magic, BLOCK_SIZE), 0);
+    EXPECT_EQ(heap1.read(buf, STRIPE_SIZE, STRIPE_SIZE), 0);
+    EXPECT_EQ(memcmp(buf, magic + BLOCK_SIZE, STRIPE_SIZE), 0);
+    EXPECT_EQ(heap2.read(buf, STRIPE_SIZE, STRIPE_SIZE), 0);
+    EXPECT_EQ(memcmp(buf, magic + BLOCK_SIZE + STRIPE_SIZE, STRIPE_SIZE), 0);
+
+    memset(buf, 0, STRIPE_SIZE * 3);
+    EXPECT_EQ(bd.read(buf, STRIPE_SIZE + BLOCK_SIZE, STRIPE_SIZE * 2 + BLOCK_SIZE), 0);
+    EXPECT_EQ(memcmp(buf, magic, STRIPE_SIZE * 2 + BLOCK_SIZE), 0);
+
+    EXPECT_EQ(bd.erase(0, STRIPE_SIZE * 2), 0);
+    EXPECT_EQ(bd.read(buf, STRIPE_SIZE * 8, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+}
+
+static int async_result;
+static int async_calls;
+
+static void async_done(int err)
+{
+    async_result = err;
+    async_calls++;
+}
+
+TEST_F(StripingBlockModuleTest, async)
+{
+    async_calls = 0;
+
+    EXPECT_EQ(bd.program_async(magic, 0, STRIPE_SIZE * 3, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 1);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+
+    EXPECT_EQ(heap1.read(buf, STRIPE_SIZE, STRIPE_SIZE), 0);
+    EXPECT_EQ(memcmp(buf, magic + STRIPE_SIZE * 2, STRIPE_SIZE), 0);
+
+    memset(buf, 0, STRIPE_SIZE * 3);
+    EXPECT_EQ(bd.read_async(buf, BLOCK_SIZE, STRIPE_SIZE * 2, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 2);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+    EXPECT_EQ(memcmp(buf, magic + BLOCK_SIZE, STRIPE_SIZE * 2), 0);
+
+    EXPECT_EQ(bd.erase_async(0, STRIPE_SIZE * 3, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 3);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+
+    // Invalid ranges are rejected without calling back
+    EXPECT_EQ(bd.erase_async(0, BLOCK_SIZE + 1, async_done), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(async_calls, 3);
+}
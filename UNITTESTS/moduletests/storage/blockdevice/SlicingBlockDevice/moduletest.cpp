@@ -218,3 +218,49 @@ TEST_F(SlicingBlockModuleTest, too_big_to_init)
     // Just a pass through
     EXPECT_EQ(slice.init(), BD_ERROR_DEVICE_ERROR);
 }
+
+static int async_result;
+static int async_calls;
+
+static void async_done(int err)
+{
+    async_result = err;
+    async_calls++;
+}
+
+TEST_F(SlicingBlockModuleTest, async)
+{
+    uint8_t *program = new uint8_t[BLOCK_SIZE] {0xbb, 0xbb, 0xbb};
+    async_calls = 0;
+
+    bd.upper_limit = BLOCK_SIZE * 3;
+    bd.lower_limit = BLOCK_SIZE;
+    bd.borders_crossed = false;
+
+    mbed::SlicingBlockDevice slice(&bd, BLOCK_SIZE, BLOCK_SIZE * 3);
+    EXPECT_EQ(slice.init(), BD_ERROR_OK);
+
+    EXPECT_EQ(slice.program_async(program, BLOCK_SIZE, BLOCK_SIZE, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 1);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+
+    EXPECT_EQ(slice.read_async(buf, BLOCK_SIZE, BLOCK_SIZE, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 2);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+    EXPECT_EQ(0, memcmp(buf, program, BLOCK_SIZE));
+    EXPECT_EQ(bd.borders_crossed, false);
+
+    // The slice offset is applied
+    bd.read(buf, BLOCK_SIZE * 2, BLOCK_SIZE);
+    EXPECT_EQ(0, memcmp(buf, program, BLOCK_SIZE));
+
+    EXPECT_EQ(slice.erase_async(0, BLOCK_SIZE, async_done), BD_ERROR_OK);
+    EXPECT_EQ(async_calls, 3);
+    EXPECT_EQ(async_result, BD_ERROR_OK);
+
+    // Outside of the slice
+    EXPECT_EQ(slice.read_async(buf, 2 * BLOCK_SIZE, BLOCK_SIZE, async_done), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(async_calls, 3);
+
+    delete[] program;
+}
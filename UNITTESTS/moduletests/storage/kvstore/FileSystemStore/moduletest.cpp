@@ -109,3 +109,36 @@ TEST_F(FileSystemStoreModuleTest, set_multiple_iterate)
     EXPECT_EQ(store->iterator_next(iterator, buf, 100), MBED_ERROR_ITEM_NOT_FOUND);
     EXPECT_EQ(store->iterator_close(iterator), MBED_SUCCESS);
 }
+
+TEST_F(FileSystemStoreModuleTest, key_index)
+{
+    char buf[100];
+    size_t size;
+    EXPECT_EQ(store->set("key1", "data", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key2", "value", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->remove("key2"), MBED_SUCCESS);
+    EXPECT_EQ(store->get("missing", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->remove("missing"), MBED_ERROR_ITEM_NOT_FOUND);
+
+    // Loaded from the saved index
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key1", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_STREQ("data", buf);
+    EXPECT_EQ(store->get("key2", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+
+    // Changes after loading drop the saved index, and are saved again
+    EXPECT_EQ(store->set("key2", "again", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->remove("key1"), MBED_SUCCESS);
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key1", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->get("key2", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_STREQ("again", buf);
+
+    EXPECT_EQ(store->reset(), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key2", buf, 100, &size), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->set("key4", "new", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key4", buf, 100, &size), MBED_SUCCESS);
+    EXPECT_STREQ("new", buf);
+}
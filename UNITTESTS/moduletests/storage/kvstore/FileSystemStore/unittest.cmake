@@ -37,4 +37,5 @@ set(unittest-test-flags
   -DMBED_LFS_PROG_SIZE=64
   -DMBED_LFS_BLOCK_SIZE=512
   -DMBED_LFS_LOOKAHEAD=512
+  -DMBED_CONF_FILESYSTEMSTORE_KEY_INDEX=1
 )
\ No newline at end of file
@@ -25,6 +25,19 @@
 
 using namespace mbed;
 
+class EraseCountingBlockDevice : public FlashSimBlockDevice {
+public:
+    EraseCountingBlockDevice(BlockDevice *bd) : FlashSimBlockDevice(bd), erases(0) {}
+
+    virtual int erase(bd_addr_t addr, bd_size_t size)
+    {
+        erases++;
+        return FlashSimBlockDevice::erase(addr, size);
+    }
+
+    int erases;
+};
+
 class TDBStoreModuleTest : public testing::Test {
 protected:
     HeapBlockDevice heap{DEVICE_SIZE};
@@ -149,3 +162,420 @@ TEST_F(TDBStoreModuleTest, reserved_data_set_get)
     EXPECT_EQ(size, 6);
     EXPECT_EQ(tdb.reserved_data_set(reserved_key, 6), MBED_ERROR_WRITE_FAILED);
 }
+
+TEST_F(TDBStoreModuleTest, many_keys_lookup)
+{
+    char key[16];
+    int val;
+    size_t size;
+
+    for (int i = 0; i < 40; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.set(key, &i, sizeof(i), 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.remove("key7"), MBED_SUCCESS);
+
+    // Also exercise lookups from a RAM table rebuilt from storage
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    for (int i = 0; i < 40; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i == 7) {
+            EXPECT_EQ(tdb.get(key, &val, sizeof(val), &size), MBED_ERROR_ITEM_NOT_FOUND);
+            continue;
+        }
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val), &size), MBED_SUCCESS);
+        EXPECT_EQ(val, i);
+        EXPECT_EQ(tdb.get_with_hash(key, TDBStore::key_hash(key), &val, sizeof(val), &size), MBED_SUCCESS);
+        EXPECT_EQ(val, i);
+    }
+
+    EXPECT_EQ(tdb.get_with_hash("key1", TDBStore::key_hash("key2"), &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.get("nokey", &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(TDBStoreModuleTest, incremental_garbage_collection)
+{
+    char key[16];
+    int val;
+    int round = 0;
+
+    // Nothing to collect in a fresh store
+    EXPECT_FALSE(tdb.garbage_collection_pending());
+    EXPECT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+
+    while (!tdb.garbage_collection_pending()) {
+        for (int i = 0; i < 8; i++) {
+            snprintf(key, sizeof(key), "key%d", i);
+            val = round * 100 + i;
+            ASSERT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+        }
+        round++;
+    }
+
+    // Keep changing keys while the collection runs
+    int steps = 0;
+    while (tdb.garbage_collection_pending()) {
+        ASSERT_EQ(tdb.garbage_collection_step(2), MBED_SUCCESS);
+        val = round * 100 + 3;
+        ASSERT_EQ(tdb.set("key3", &val, sizeof(val), 0), MBED_SUCCESS);
+        val = steps;
+        ASSERT_EQ(tdb.set("new", &val, sizeof(val), 0), MBED_SUCCESS);
+        ASSERT_LT(++steps, 20);
+    }
+    EXPECT_GT(steps, 1);
+    EXPECT_EQ(tdb.remove("key5"), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    for (int i = 0; i < 8; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i == 5) {
+            EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+            continue;
+        }
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, (i == 3 ? round : round - 1) * 100 + i);
+    }
+    EXPECT_EQ(tdb.get("new", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(val, steps - 1);
+}
+
+TEST_F(TDBStoreModuleTest, init_from_index)
+{
+    char key[16];
+    int val;
+
+    for (int i = 0; i < 10; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        val = i;
+        EXPECT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+
+    // Compacting writes a RAM table snapshot to the new area
+    int round = 0;
+    while (!tdb.garbage_collection_pending()) {
+        val = round++;
+        ASSERT_EQ(tdb.set("filler", &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+    while (tdb.garbage_collection_pending()) {
+        ASSERT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    }
+
+    // Changes after the snapshot are picked up by the scan that follows it
+    val = 100;
+    EXPECT_EQ(tdb.set("key3", &val, sizeof(val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key4"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("later", &val, sizeof(val), 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    for (int i = 0; i < 10; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i == 4) {
+            EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+            continue;
+        }
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, i == 3 ? 100 : i);
+    }
+    EXPECT_EQ(tdb.get("later", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("TDBS/IDX", &val, sizeof(val)), MBED_ERROR_INVALID_ARGUMENT);
+
+    // Snapshot records are invisible to iteration
+    KVStore::iterator_t it;
+    int count = 0;
+    EXPECT_EQ(tdb.iterator_open(&it, "TDBS/"), MBED_SUCCESS);
+    while (tdb.iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+        count++;
+    }
+    EXPECT_EQ(tdb.iterator_close(it), MBED_SUCCESS);
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(TDBStoreModuleTest, batch_commit)
+{
+    char buf[16];
+    EXPECT_EQ(tdb.commit_batch(), MBED_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(tdb.set("ssid", "old", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("ip", "dhcp", 5, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.begin_batch(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.begin_batch(), MBED_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(tdb.set("ssid", "new", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("pass", "secret", 7, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("ip"), MBED_SUCCESS);
+
+    // Nothing takes effect before the commit
+    EXPECT_EQ(tdb.get("ssid", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+    EXPECT_EQ(tdb.get("pass", buf, sizeof(buf)), MBED_ERROR_ITEM_NOT_FOUND);
+
+    EXPECT_EQ(tdb.commit_batch(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("ssid", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("new", buf);
+    EXPECT_EQ(tdb.get("pass", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("secret", buf);
+    EXPECT_EQ(tdb.get("ip", buf, sizeof(buf)), MBED_ERROR_ITEM_NOT_FOUND);
+
+    EXPECT_EQ(tdb.set("later", "x", 2, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("ssid", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("new", buf);
+    EXPECT_EQ(tdb.get("pass", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("ip", buf, sizeof(buf)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.get("later", buf, sizeof(buf)), MBED_SUCCESS);
+}
+
+TEST_F(TDBStoreModuleTest, batch_abort)
+{
+    char buf[16];
+    EXPECT_EQ(tdb.set("ssid", "old", 4, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.begin_batch(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("ssid", "new", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.abort_batch(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.abort_batch(), MBED_ERROR_INVALID_OPERATION);
+
+    // Records after an aborted batch are not mistaken for part of it
+    EXPECT_EQ(tdb.set("after", "x", 2, 0), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("ssid", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+    EXPECT_EQ(tdb.get("after", buf, sizeof(buf)), MBED_SUCCESS);
+}
+
+TEST_F(TDBStoreModuleTest, batch_interrupted)
+{
+    char buf[16];
+    EXPECT_EQ(tdb.set("ssid", "old", 4, 0), MBED_SUCCESS);
+
+    // Dropping the store with a batch open is like losing power before the commit
+    EXPECT_EQ(tdb.begin_batch(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("ssid", "new", 4, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("pass", "secret", 7, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("ssid", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("old", buf);
+    EXPECT_EQ(tdb.get("pass", buf, sizeof(buf)), MBED_ERROR_ITEM_NOT_FOUND);
+
+    EXPECT_EQ(tdb.set("pass", "other", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("pass", buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("other", buf);
+}
+
+TEST_F(TDBStoreModuleTest, batch_across_garbage_collection)
+{
+    char key[16];
+    int val;
+
+    // Fill most of the area, so the batch is compacted along the way
+    EXPECT_EQ(tdb.set("base", "x", 2, 0), MBED_SUCCESS);
+    for (int i = 0; i < 40; i++) {
+        ASSERT_EQ(tdb.set("filler", &i, sizeof(i), 0), MBED_SUCCESS);
+    }
+
+    EXPECT_EQ(tdb.begin_batch(), MBED_SUCCESS);
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 4; i++) {
+            snprintf(key, sizeof(key), "key%d", i);
+            val = round * 100 + i;
+            ASSERT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+        }
+    }
+    EXPECT_EQ(tdb.get("key0", &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.commit_batch(), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    for (int i = 0; i < 4; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, 400 + i);
+    }
+    EXPECT_EQ(tdb.get("base", key, sizeof(key)), MBED_SUCCESS);
+}
+
+TEST_F(TDBStoreModuleTest, prefix_iterate)
+{
+    char key[32], prev[32];
+    int val = 0, count;
+    KVStore::iterator_t it;
+
+    for (int i = 0; i < 10; i++) {
+        snprintf(key, sizeof(key), "app.%d", i);
+        EXPECT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+        snprintf(key, sizeof(key), "sensor.cal.%d", 9 - i);
+        EXPECT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+        snprintf(key, sizeof(key), "sensor.log.%d", i);
+        EXPECT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+
+    // Matches come in key order, and nothing else
+    EXPECT_EQ(tdb.iterator_open(&it, "sensor.cal."), MBED_SUCCESS);
+    count = 0;
+    prev[0] = '\0';
+    while (tdb.iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+        EXPECT_EQ(strncmp(key, "sensor.cal.", 11), 0);
+        EXPECT_LT(strcmp(prev, key), 0);
+        strcpy(prev, key);
+        count++;
+    }
+    EXPECT_EQ(count, 10);
+    EXPECT_EQ(tdb.iterator_close(it), MBED_SUCCESS);
+
+    // Keys added and removed while iterating, once the key order is built
+    EXPECT_EQ(tdb.iterator_open(&it, "sensor."), MBED_SUCCESS);
+    EXPECT_EQ(tdb.iterator_next(it, key, sizeof(key)), MBED_SUCCESS);
+    EXPECT_STREQ(key, "sensor.cal.0");
+    EXPECT_EQ(tdb.set("sensor.a", &val, sizeof(val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("sensor.cal.00", &val, sizeof(val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("sensor.cal.1"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("app.3"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.iterator_next(it, key, sizeof(key)), MBED_SUCCESS);
+    EXPECT_STREQ(key, "sensor.cal.00");
+    EXPECT_EQ(tdb.iterator_next(it, key, sizeof(key)), MBED_SUCCESS);
+    EXPECT_STREQ(key, "sensor.cal.2");
+    count = 3;
+    while (tdb.iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+        count++;
+    }
+    EXPECT_EQ(count, 20);
+    EXPECT_EQ(tdb.iterator_close(it), MBED_SUCCESS);
+
+    // Survives garbage collection
+    while (!tdb.garbage_collection_pending()) {
+        ASSERT_EQ(tdb.set("app.0", &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+    while (tdb.garbage_collection_pending()) {
+        ASSERT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.iterator_open(&it, "app."), MBED_SUCCESS);
+    count = 0;
+    while (tdb.iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+        EXPECT_STRNE(key, "app.3");
+        count++;
+    }
+    EXPECT_EQ(count, 9);
+    EXPECT_EQ(tdb.iterator_close(it), MBED_SUCCESS);
+
+    EXPECT_EQ(tdb.iterator_open(&it, "zzz"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.iterator_next(it, key, sizeof(key)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.iterator_close(it), MBED_SUCCESS);
+}
+
+TEST(TDBStoreStandbyEraseTest, garbage_collection_without_erase)
+{
+    HeapBlockDevice heap{DEVICE_SIZE};
+    EraseCountingBlockDevice flash{&heap};
+    TDBStore tdb{&flash};
+    char key[16];
+    int val;
+
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.reset(), MBED_SUCCESS);
+
+    for (int i = 0; i < 8; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        val = i;
+        ASSERT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+
+    // Idle steps erase the standby area one unit at a time, then stop
+    int erases = flash.erases;
+    for (int i = 0; i < DEVICE_SIZE / BLOCK_SIZE; i++) {
+        ASSERT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    }
+    EXPECT_GT(flash.erases, erases);
+    erases = flash.erases;
+    EXPECT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    EXPECT_EQ(flash.erases, erases);
+
+    // The watermark survives a reboot
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    int round = 0;
+    while (!tdb.garbage_collection_pending()) {
+        val = round++;
+        ASSERT_EQ(tdb.set("filler", &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+
+    // The collection only copies records, and the switch to the new area doesn't erase either
+    erases = flash.erases;
+    while (tdb.garbage_collection_pending()) {
+        ASSERT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    }
+    EXPECT_EQ(flash.erases, erases);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    for (int i = 0; i < 8; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, i);
+    }
+    EXPECT_EQ(tdb.get("filler", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(val, round - 1);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+}
+
+TEST(TDBStoreStandbyEraseTest, interrupted_garbage_collection)
+{
+    HeapBlockDevice heap{DEVICE_SIZE};
+    EraseCountingBlockDevice flash{&heap};
+    TDBStore tdb{&flash};
+    char key[16];
+    int val;
+
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.reset(), MBED_SUCCESS);
+
+    for (int i = 0; i < 8; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        val = i;
+        ASSERT_EQ(tdb.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+    for (int i = 0; i < DEVICE_SIZE / BLOCK_SIZE; i++) {
+        ASSERT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    }
+
+    int round = 0;
+    while (!tdb.garbage_collection_pending()) {
+        val = round++;
+        ASSERT_EQ(tdb.set("filler", &val, sizeof(val), 0), MBED_SUCCESS);
+    }
+
+    // Copy part of the records, then reboot: the standby area is no longer erased
+    ASSERT_EQ(tdb.garbage_collection_step(2), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+
+    int erases = flash.erases;
+    while (tdb.garbage_collection_pending()) {
+        ASSERT_EQ(tdb.garbage_collection_step(), MBED_SUCCESS);
+    }
+    EXPECT_GT(flash.erases, erases);
+
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    for (int i = 0; i < 8; i++) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, i);
+    }
+    EXPECT_EQ(tdb.get("filler", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(val, round - 1);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+}
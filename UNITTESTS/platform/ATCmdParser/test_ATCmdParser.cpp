@@ -351,6 +351,33 @@ TEST_F(test_ATCmdParser, test_ATCmdParser_recv)
 
 }
 
+TEST_F(test_ATCmdParser, test_ATCmdParser_recv_payload)
+{
+    FileHandle_stub fh1;
+    ATCmdParser at(&fh1, "\r");
+
+    char table[] = "noise\r\n+IPD,5:hello\r\n+CWMODE:3\r\nOK\r\n";
+    at.flush();
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    int len = 0;
+    EXPECT_TRUE(at.recv("+IPD,%d:", &len));
+    EXPECT_EQ(5, len);
+
+    char buf[6] = {0};
+    EXPECT_EQ(5, at.read(buf, 5));
+    EXPECT_EQ(0, memcmp(buf, "hello", 5));
+
+    int mode = 0;
+    EXPECT_TRUE(at.recv("+CWMODE:%d\r\nOK", &mode));
+    EXPECT_EQ(3, mode);
+
+    filehandle_stub_table = NULL;
+}
+
 TEST_F(test_ATCmdParser, test_ATCmdParser_scanf)
 {
     FileHandle_stub fh1;
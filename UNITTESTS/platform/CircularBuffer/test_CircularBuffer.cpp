@@ -37,3 +37,77 @@ TEST_F(TestCircularBuffer, constructor)
 {
     EXPECT_TRUE(buf);
 }
+
+TEST_F(TestCircularBuffer, push_pop_span)
+{
+    int src[7] = {0, 1, 2, 3, 4, 5, 6};
+    int dest[10];
+
+    // Wrap around the end of the pool
+    buf->push(mbed::make_const_Span(src));
+    EXPECT_EQ(5, buf->pop(mbed::Span<int>(dest, 5)));
+    buf->push(mbed::make_const_Span(src));
+    EXPECT_EQ(9, buf->size());
+
+    EXPECT_EQ(9, buf->pop(mbed::make_Span(dest)));
+    int expected[9] = {5, 6, 0, 1, 2, 3, 4, 5, 6};
+    for (int i = 0; i < 9; i++) {
+        EXPECT_EQ(expected[i], dest[i]);
+    }
+    EXPECT_TRUE(buf->empty());
+}
+
+TEST_F(TestCircularBuffer, push_span_overwrite)
+{
+    int src[12];
+    int dest[10];
+    for (int i = 0; i < 12; i++) {
+        src[i] = i;
+    }
+
+    buf->push(3);
+    buf->push(mbed::make_const_Span(src));
+    EXPECT_TRUE(buf->full());
+
+    EXPECT_EQ(10, buf->pop(mbed::make_Span(dest)));
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(i + 2, dest[i]);
+    }
+}
+
+TEST_F(TestCircularBuffer, write_read_region)
+{
+    int data = 0;
+
+    for (int i = 0; i < 8; i++) {
+        buf->push(i);
+    }
+    for (int i = 0; i < 8; i++) {
+        buf->pop(data);
+    }
+
+    // Free space wraps, so only the part up to the end is contiguous
+    mbed::Span<int> region = buf->get_write_region();
+    EXPECT_EQ(2, region.size());
+    region[0] = 10;
+    region[1] = 11;
+    buf->commit_write(2);
+
+    region = buf->get_write_region();
+    EXPECT_EQ(8, region.size());
+    region[0] = 12;
+    buf->commit_write(1);
+    EXPECT_EQ(3, buf->size());
+
+    mbed::Span<const int> read = buf->get_read_region();
+    EXPECT_EQ(2, read.size());
+    EXPECT_EQ(10, read[0]);
+    buf->commit_read(2);
+
+    read = buf->get_read_region();
+    EXPECT_EQ(1, read.size());
+    EXPECT_EQ(12, read[0]);
+    buf->commit_read(1);
+    EXPECT_TRUE(buf->empty());
+    EXPECT_EQ(0, buf->get_read_region().size());
+}
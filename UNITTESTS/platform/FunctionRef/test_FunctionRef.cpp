@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/FunctionRef.h"
+
+using mbed::Callback;
+using mbed::FunctionRef;
+
+static_assert(sizeof(FunctionRef<int(int)>) == 2 * sizeof(void *), "FunctionRef must be two words");
+static_assert(std::is_trivially_copyable<FunctionRef<void()>>::value, "FunctionRef must be trivially copyable");
+
+static int add_one(int x)
+{
+    return x + 1;
+}
+
+static int apply(FunctionRef<int(int)> f, int x)
+{
+    return f(x);
+}
+
+struct Counter {
+    int count = 0;
+
+    int operator()(int step)
+    {
+        count += step;
+        return count;
+    }
+};
+
+TEST(TestFunctionRef, function)
+{
+    EXPECT_EQ(3, apply(add_one, 2));
+    EXPECT_EQ(3, apply(&add_one, 2));
+
+    int (*fp)(int) = add_one;
+    EXPECT_EQ(3, apply(fp, 2));
+}
+
+TEST(TestFunctionRef, lambda)
+{
+    int offset = 10;
+    EXPECT_EQ(12, apply([&](int x) {
+        return x + offset;
+    }, 2));
+}
+
+TEST(TestFunctionRef, object_is_referenced)
+{
+    Counter counter;
+    FunctionRef<int(int)> ref(counter);
+
+    EXPECT_EQ(2, ref(2));
+    EXPECT_EQ(5, ref(3));
+    // The calls went to the referenced object, not a copy
+    EXPECT_EQ(5, counter.count);
+
+    FunctionRef<int(int)> copy = ref;
+    EXPECT_EQ(6, copy(1));
+    EXPECT_EQ(6, counter.count);
+}
+
+TEST(TestFunctionRef, const_object)
+{
+    struct Doubler {
+        int operator()(int x) const
+        {
+            return x * 2;
+        }
+    };
+    const Doubler doubler{};
+
+    EXPECT_EQ(8, apply(doubler, 4));
+}
+
+TEST(TestFunctionRef, callback)
+{
+    Counter counter;
+    EXPECT_EQ(4, apply(Callback<int(int)>(&counter, &Counter::operator()), 4));
+    EXPECT_EQ(4, counter.count);
+}
+
+TEST(TestFunctionRef, return_conversion)
+{
+    FunctionRef<long(int)> widen(add_one);
+    EXPECT_EQ(8L, widen(7));
+
+    // Results are discarded for a void signature
+    Counter counter;
+    FunctionRef<void(int)> discard(counter);
+    discard(3);
+    EXPECT_EQ(3, counter.count);
+}
@@ -0,0 +1,12 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  platform/FunctionRef/test_FunctionRef.cpp
+  stubs/mbed_assert_stub.cpp
+)
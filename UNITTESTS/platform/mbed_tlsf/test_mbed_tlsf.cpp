@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/source/mbed_tlsf.h"
+#include <stdint.h>
+#include <string.h>
+
+#define REGION_SIZE 4096
+
+class TestMbedTlsf : public testing::Test {
+protected:
+    mbed_tlsf_t tlsf;
+    uint64_t region[REGION_SIZE / sizeof(uint64_t)];
+    uint64_t region2[REGION_SIZE / sizeof(uint64_t)];
+
+    virtual void SetUp()
+    {
+        mbed_tlsf_init(&tlsf);
+        ASSERT_EQ(0, mbed_tlsf_add_region(&tlsf, region, sizeof(region)));
+    }
+
+    bool in_region(void *p, void *r)
+    {
+        return (char *)p >= (char *)r && (char *)p < (char *)r + REGION_SIZE;
+    }
+};
+
+TEST_F(TestMbedTlsf, malloc_free)
+{
+    void *p = mbed_tlsf_malloc(&tlsf, 100);
+    ASSERT_TRUE(p);
+    EXPECT_TRUE(in_region(p, region));
+    EXPECT_EQ(0u, (uintptr_t)p % MBED_TLSF_ALIGN_SIZE);
+    EXPECT_GE(mbed_tlsf_block_size(p), 100u);
+    memset(p, 0xa5, 100);
+    mbed_tlsf_free(&tlsf, p);
+    mbed_tlsf_free(&tlsf, NULL);
+
+    EXPECT_EQ(sizeof(region), tlsf.reserved_size);
+}
+
+TEST_F(TestMbedTlsf, exhaust_and_merge)
+{
+    void *ptrs[REGION_SIZE / 64];
+    size_t count = 0;
+    while (count < sizeof(ptrs) / sizeof(ptrs[0])) {
+        ptrs[count] = mbed_tlsf_malloc(&tlsf, 48);
+        if (!ptrs[count]) {
+            break;
+        }
+        count++;
+    }
+    EXPECT_GT(count, 32u);
+    EXPECT_FALSE(mbed_tlsf_malloc(&tlsf, 48));
+
+    // free in an interleaved order so blocks merge both ways
+    for (size_t i = 0; i < count; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    for (size_t i = 1; i < count; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+
+    // everything merged back into one block
+    void *p = mbed_tlsf_malloc(&tlsf, REGION_SIZE - 256);
+    EXPECT_TRUE(p);
+    mbed_tlsf_free(&tlsf, p);
+}
+
+TEST_F(TestMbedTlsf, too_large)
+{
+    EXPECT_FALSE(mbed_tlsf_malloc(&tlsf, REGION_SIZE));
+    EXPECT_FALSE(mbed_tlsf_malloc(&tlsf, SIZE_MAX));
+    EXPECT_FALSE(mbed_tlsf_memalign(&tlsf, 64, SIZE_MAX));
+}
+
+TEST_F(TestMbedTlsf, memalign)
+{
+    void *a = mbed_tlsf_malloc(&tlsf, 8);
+    void *p = mbed_tlsf_memalign(&tlsf, 256, 100);
+    ASSERT_TRUE(p);
+    EXPECT_EQ(0u, (uintptr_t)p % 256);
+    void *b = mbed_tlsf_malloc(&tlsf, 8);
+    ASSERT_TRUE(b);
+
+    mbed_tlsf_free(&tlsf, a);
+    mbed_tlsf_free(&tlsf, p);
+    mbed_tlsf_free(&tlsf, b);
+
+    p = mbed_tlsf_malloc(&tlsf, REGION_SIZE - 256);
+    EXPECT_TRUE(p);
+}
+
+TEST_F(TestMbedTlsf, realloc)
+{
+    uint8_t *p = (uint8_t *)mbed_tlsf_realloc(&tlsf, NULL, 32);
+    ASSERT_TRUE(p);
+    for (int i = 0; i < 32; i++) {
+        p[i] = i;
+    }
+
+    // grows in place into the free space after it
+    uint8_t *q = (uint8_t *)mbed_tlsf_realloc(&tlsf, p, 512);
+    EXPECT_EQ(p, q);
+
+    // blocked, so moves
+    void *blocker = mbed_tlsf_malloc(&tlsf, 16);
+    q = (uint8_t *)mbed_tlsf_realloc(&tlsf, p, 1024);
+    ASSERT_TRUE(q);
+    EXPECT_NE(p, q);
+    for (int i = 0; i < 32; i++) {
+        EXPECT_EQ(i, q[i]);
+    }
+
+    // shrinks in place
+    p = (uint8_t *)mbed_tlsf_realloc(&tlsf, q, 16);
+    EXPECT_EQ(q, p);
+    EXPECT_LT(mbed_tlsf_block_size(p), 1024u);
+
+    // fails without touching the original
+    EXPECT_FALSE(mbed_tlsf_realloc(&tlsf, p, REGION_SIZE));
+    EXPECT_EQ(0, p[0]);
+
+    EXPECT_FALSE(mbed_tlsf_realloc(&tlsf, p, 0));
+    mbed_tlsf_free(&tlsf, blocker);
+}
+
+TEST_F(TestMbedTlsf, multiple_regions)
+{
+    ASSERT_EQ(0, mbed_tlsf_add_region(&tlsf, region2, sizeof(region2)));
+    EXPECT_EQ(sizeof(region) + sizeof(region2), tlsf.reserved_size);
+
+    void *a = mbed_tlsf_malloc(&tlsf, REGION_SIZE - 256);
+    void *b = mbed_tlsf_malloc(&tlsf, REGION_SIZE - 256);
+    ASSERT_TRUE(a);
+    ASSERT_TRUE(b);
+    EXPECT_TRUE(in_region(a, region) != in_region(a, region2));
+    EXPECT_TRUE(in_region(b, region) != in_region(b, region2));
+    EXPECT_NE(in_region(a, region), in_region(b, region));
+
+    // regions do not merge with each other
+    mbed_tlsf_free(&tlsf, a);
+    mbed_tlsf_free(&tlsf, b);
+    EXPECT_FALSE(mbed_tlsf_malloc(&tlsf, REGION_SIZE + 256));
+}
+
+TEST_F(TestMbedTlsf, small_region)
+{
+    EXPECT_EQ(-1, mbed_tlsf_add_region(&tlsf, region2, 8));
+    EXPECT_EQ(sizeof(region), tlsf.reserved_size);
+}
@@ -0,0 +1,12 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../platform/source/mbed_tlsf.c
+)
+
+set(unittest-test-sources
+  platform/mbed_tlsf/test_mbed_tlsf.cpp
+)
@@ -16,6 +16,7 @@
  */
 
 #include <ctype.h>
+#include <string.h>
 #include "nsapi_types.h"
 #include "events/EventQueue.h"
 #include "ATHandler_stub.h"
@@ -88,9 +89,9 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     _queue(queue),
     _ref_count(1),
     _oob_string_max_length(0),
-    _oobs(NULL),
     _max_resp_length(MAX_RESP_LENGTH)
 {
+    memset(_oobs, 0, sizeof(_oobs));
     ATHandler_stub::process_oob_urc = false;
 }
 
@@ -118,6 +119,11 @@ FileHandle *ATHandler::get_file_handle()
     return _fileHandle;
 }
 
+void ATHandler::set_file_handle(FileHandle *fh)
+{
+    _fileHandle = fh;
+}
+
 bool ATHandler::find_urc_handler(const char *prefix)
 {
     return ATHandler_stub::bool_value;
@@ -141,6 +147,11 @@ void ATHandler::remove_urc_handler(const char *prefix)
 {
 }
 
+uint32_t ATHandler::get_urc_hit_count(const char *prefix)
+{
+    return 0;
+}
+
 nsapi_error_t ATHandler::get_last_error() const
 {
     if (ATHandler_stub::nsapi_error_ok_counter) {
@@ -365,6 +376,15 @@ nsapi_error_t ATHandler::at_cmd_discard(const char *cmd, const char *cmd_chr,
     return ATHandler_stub::nsapi_error_value;
 }
 
+nsapi_error_t ATHandler::at_cmd_batch(const batch_cmd_t *cmds, size_t count)
+{
+    return ATHandler_stub::nsapi_error_value;
+}
+
+void ATHandler::set_cmd_concatenation(bool concatenate)
+{
+}
+
 void ATHandler::set_send_delay(uint16_t send_delay)
 {
 }
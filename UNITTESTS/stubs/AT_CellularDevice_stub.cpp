@@ -40,7 +40,7 @@ AT_CellularDevice::AT_CellularDevice(FileHandle *fh) :
     _sms(0),
 #endif // MBED_CONF_CELLULAR_USE_SMS
     _network(0),
-    _information(0), _context_list(0), _default_timeout(DEFAULT_AT_TIMEOUT), _modem_debug_on(false)
+    _information(0), _context_list(0), _mux(NULL), _default_timeout(DEFAULT_AT_TIMEOUT), _modem_debug_on(false)
 {
 }
 
@@ -251,6 +251,21 @@ nsapi_error_t AT_CellularDevice::set_baud_rate_impl(int baud_rate)
     return NSAPI_ERROR_OK;
 }
 
+nsapi_error_t AT_CellularDevice::start_mux()
+{
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t AT_CellularDevice::stop_mux()
+{
+    return NSAPI_ERROR_OK;
+}
+
+FileHandle *AT_CellularDevice::get_mux_data_channel()
+{
+    return NULL;
+}
+
 void AT_CellularDevice::set_cellular_properties(const intptr_t *property_array)
 {
 }
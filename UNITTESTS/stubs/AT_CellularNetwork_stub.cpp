@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <string.h>
 #include "AT_CellularNetwork_stub.h"
 #include "CellularNetwork.h"
 #include "CellularUtil.h"
@@ -31,6 +32,7 @@ nsapi_error_t AT_CellularNetwork_stub::nsapi_error_value = 0;
 int AT_CellularNetwork_stub::fail_counter = 0;
 int AT_CellularNetwork_stub::set_registration_urc_fail_counter = 0;
 int AT_CellularNetwork_stub::get_registration_params_fail_counter = 0;
+bool AT_CellularNetwork_stub::attached = false;
 
 AT_CellularNetwork::AT_CellularNetwork(ATHandler &atHandler, AT_CellularDevice &device) : _at(atHandler), _device(device)
 {
@@ -87,6 +89,9 @@ nsapi_error_t AT_CellularNetwork::set_attach()
 
 nsapi_error_t AT_CellularNetwork::get_attach(AttachStatus &status)
 {
+    if (AT_CellularNetwork_stub::attached) {
+        status = Attached;
+    }
     return NSAPI_ERROR_OK;
 }
 
@@ -135,6 +140,8 @@ nsapi_error_t AT_CellularNetwork::get_signal_quality(int &rssi, int *ber)
 
 nsapi_error_t AT_CellularNetwork::get_operator_params(int &format, operator_t &operator_params)
 {
+    format = 2;
+    strcpy(operator_params.op_num, "24405");
     return NSAPI_ERROR_OK;
 }
 
@@ -93,3 +93,8 @@ void AT_CellularStack::socket_attach(nsapi_socket_t handle, void (*callback)(voi
 void AT_CellularStack::set_cid(int cid)
 {
 }
+
+nsapi_size_or_error_t AT_CellularStack::read_socket_data(void *buffer, nsapi_size_t size, nsapi_size_t data_len, bool quoted)
+{
+    return data_len > size ? size : data_len;
+}
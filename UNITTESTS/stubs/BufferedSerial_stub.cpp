@@ -38,6 +38,16 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
     return 0;
 }
 
+ssize_t BufferedSerial::writev(Span<const struct iovec> iov)
+{
+    return 0;
+}
+
+ssize_t BufferedSerial::readv(Span<const struct iovec> iov)
+{
+    return 0;
+}
+
 off_t BufferedSerial::seek(off_t offset, int whence)
 {
     return -ESPIPE;
@@ -121,6 +121,36 @@ nsapi_error_t CellularDevice::shutdown()
     return NSAPI_ERROR_OK;
 }
 
+nsapi_error_t CellularDevice::start_mux()
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t CellularDevice::stop_mux()
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 void CellularDevice::cellular_callback(nsapi_event_t ev, intptr_t ptr, CellularContext *ctx)
 {
 }
+
+void CellularDevice::get_power_stats(power_stats_t &stats)
+{
+}
+
+void CellularDevice::reset_power_stats()
+{
+}
+
+void CellularDevice::set_radio_state(RadioState state)
+{
+}
+
+void CellularDevice::start_connect_stats()
+{
+}
+
+void CellularDevice::add_data_stats(nsapi_size_t sent, nsapi_size_t received)
+{
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CellularMux.h"
+
+using namespace mbed;
+
+CellularMux::MuxChannel::MuxChannel() :
+    _mux(NULL), _dlci(0), _blocking(true), _open(false)
+{
+}
+
+ssize_t CellularMux::MuxChannel::read(void *buffer, size_t size)
+{
+    return 0;
+}
+
+ssize_t CellularMux::MuxChannel::write(const void *buffer, size_t size)
+{
+    return size;
+}
+
+off_t CellularMux::MuxChannel::seek(off_t offset, int whence)
+{
+    return 0;
+}
+
+int CellularMux::MuxChannel::close()
+{
+    return 0;
+}
+
+int CellularMux::MuxChannel::set_blocking(bool blocking)
+{
+    _blocking = blocking;
+    return 0;
+}
+
+bool CellularMux::MuxChannel::is_blocking() const
+{
+    return _blocking;
+}
+
+short CellularMux::MuxChannel::poll(short events) const
+{
+    return 0;
+}
+
+void CellularMux::MuxChannel::sigio(Callback<void()> func)
+{
+}
+
+CellularMux::CellularMux() :
+    _fh(NULL),
+    _rx_state(RX_FLAG),
+    _rx_header_len(0),
+    _rx_len(0),
+    _rx_pos(0),
+    _response_dlci(-1),
+    _response(0)
+{
+}
+
+CellularMux::~CellularMux()
+{
+}
+
+nsapi_error_t CellularMux::start(FileHandle *fh, uint32_t timeout_ms)
+{
+    _fh = fh;
+    return NSAPI_ERROR_OK;
+}
+
+void CellularMux::stop(uint32_t timeout_ms)
+{
+    _fh = NULL;
+}
+
+FileHandle *CellularMux::get_channel(Channel channel)
+{
+    return _fh ? &_channels[channel - 1] : NULL;
+}
+
+FileHandle *CellularMux::get_file_handle() const
+{
+    return _fh;
+}
@@ -57,6 +57,11 @@ int EventQueue::time_left(int id)
     return EventQueue_stub::int_value;
 }
 
+bool EventQueue::get_dispatch_stats(equeue_dispatch_stats_t *stats, bool reset)
+{
+    return false;
+}
+
 void EventQueue::background(Callback<void(int)> update)
 {
 }
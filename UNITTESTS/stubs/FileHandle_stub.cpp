@@ -24,6 +24,16 @@ off_t FileHandle::size()
     return 0;
 }
 
+ssize_t FileHandle::readv(Span<const struct iovec> iov)
+{
+    return 0;
+}
+
+ssize_t FileHandle::writev(Span<const struct iovec> iov)
+{
+    return 0;
+}
+
 std::FILE *fdopen(FileHandle *fh, const char *mode)
 {
     return NULL;
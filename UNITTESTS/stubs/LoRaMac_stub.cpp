@@ -255,7 +255,7 @@ lorawan_status_t LoRaMac::send(loramac_mhdr_t *machdr, const uint8_t fport,
     return LoRaMac_stub::status_value;
 }
 
-int LoRaMac::get_backoff_timer_event_id(void)
+int LoRaMac::get_backoff_time_left(void)
 {
     return LoRaMac_stub::int_value;
 }
@@ -322,6 +322,11 @@ int16_t LoRaMac::prepare_ongoing_tx(const uint8_t port,
     return 0;
 }
 
+uint8_t LoRaMac::get_max_tx_size(void)
+{
+    return 0;
+}
+
 lorawan_status_t LoRaMac::send_ongoing_tx()
 {
     return LoRaMac_stub::status_value;
@@ -22,9 +22,13 @@
 
 lorawan_time_t LoRaWANTimer_stub::time_value = 0;
 bool LoRaWANTimer_stub::call_cb_immediately = false;
+int LoRaWANTimer_stub::time_left_value = 0;
 
 LoRaWANTimeHandler::LoRaWANTimeHandler()
-    : _queue(NULL)
+    : _queue(NULL),
+      _timers(NULL),
+      _event_id(0),
+      _event_deadline(0)
 {
 }
 
@@ -58,7 +62,17 @@ void LoRaWANTimeHandler::start(timer_event_t &obj, const uint32_t timeout)
 {
 }
 
+void LoRaWANTimeHandler::start_at(timer_event_t &obj, lorawan_time_t reference,
+                                  const uint32_t timeout)
+{
+}
+
 void LoRaWANTimeHandler::stop(timer_event_t &obj)
 {
     obj.timer_id = 0;
 }
+
+int LoRaWANTimeHandler::time_left(const timer_event_t &obj)
+{
+    return obj.timer_id ? LoRaWANTimer_stub::time_left_value : -1;
+}
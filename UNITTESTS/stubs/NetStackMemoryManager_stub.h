@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NETSTACKMEMORYMANAGERSTUB_H
+#define NETSTACKMEMORYMANAGERSTUB_H
+
+#include "netsocket/NetStackMemoryManager.h"
+#include <string.h>
+
+/*
+ * Heap backed memory manager for testing the socket buffer APIs.
+ * Pool allocations are chained in pool_unit sized buffers, and
+ * allocated counts the buffers not yet freed, to catch leaks.
+ */
+class NetStackMemoryManagerstub : public NetStackMemoryManager {
+public:
+    static const uint32_t pool_unit = 8;
+    int allocated = 0;
+
+    net_stack_mem_buf_t *alloc_heap(uint32_t size, uint32_t align) override
+    {
+        return new_buf(size);
+    }
+
+    net_stack_mem_buf_t *alloc_pool(uint32_t size, uint32_t align) override
+    {
+        buf_t *head = new_buf(size < pool_unit ? size : pool_unit);
+        buf_t *tail = head;
+        for (uint32_t left = size - tail->len; left; left -= tail->len) {
+            tail->next = new_buf(left < pool_unit ? left : pool_unit);
+            tail = tail->next;
+        }
+        return head;
+    }
+
+    uint32_t get_pool_alloc_unit(uint32_t align) const override
+    {
+        return pool_unit;
+    }
+
+    void free(net_stack_mem_buf_t *buf) override
+    {
+        buf_t *b = static_cast<buf_t *>(buf);
+        while (b) {
+            buf_t *next = b->next;
+            delete[] b->data;
+            delete b;
+            allocated--;
+            b = next;
+        }
+    }
+
+    uint32_t get_total_len(const net_stack_mem_buf_t *buf) const override
+    {
+        uint32_t len = 0;
+        for (const buf_t *b = static_cast<const buf_t *>(buf); b; b = b->next) {
+            len += b->len;
+        }
+        return len;
+    }
+
+    void copy(net_stack_mem_buf_t *to_buf, const net_stack_mem_buf_t *from_buf) override
+    {
+        uint32_t len = get_total_len(from_buf);
+        uint8_t *tmp = new uint8_t[len];
+        copy_from_buf(tmp, len, from_buf);
+        copy_to_buf(to_buf, tmp, len);
+        delete[] tmp;
+    }
+
+    void cat(net_stack_mem_buf_t *to_buf, net_stack_mem_buf_t *cat_buf) override
+    {
+        buf_t *b = static_cast<buf_t *>(to_buf);
+        while (b->next) {
+            b = b->next;
+        }
+        b->next = static_cast<buf_t *>(cat_buf);
+    }
+
+    net_stack_mem_buf_t *get_next(const net_stack_mem_buf_t *buf) const override
+    {
+        return static_cast<const buf_t *>(buf)->next;
+    }
+
+    void *get_ptr(const net_stack_mem_buf_t *buf) const override
+    {
+        return static_cast<const buf_t *>(buf)->data;
+    }
+
+    uint32_t get_len(const net_stack_mem_buf_t *buf) const override
+    {
+        return static_cast<const buf_t *>(buf)->len;
+    }
+
+    void set_len(net_stack_mem_buf_t *buf, uint32_t len) override
+    {
+        static_cast<buf_t *>(buf)->len = len;
+    }
+
+private:
+    struct buf_t {
+        buf_t *next;
+        uint32_t len;
+        uint8_t *data;
+    };
+
+    buf_t *new_buf(uint32_t size)
+    {
+        buf_t *b = new buf_t;
+        b->next = NULL;
+        b->len = size;
+        b->data = new uint8_t[size ? size : 1];
+        memset(b->data, 0, size);
+        allocated++;
+        return b;
+    }
+};
+
+#endif // NETSTACKMEMORYMANAGERSTUB_H
@@ -33,13 +33,20 @@ public:
     std::list<nsapi_error_t> return_values;
     nsapi_error_t return_value;
     SocketAddress return_socketAddress;
+    NetStackMemoryManager *memory_manager;
 
     NetworkStackstub() :
         return_value(0),
-        return_socketAddress()
+        return_socketAddress(),
+        memory_manager(NULL)
     {
     }
 
+    virtual NetStackMemoryManager *get_memory_manager()
+    {
+        return memory_manager;
+    }
+
     virtual nsapi_error_t get_ip_address(SocketAddress* address)
     {
         address->set_ip_address("127.0.0.1");
@@ -149,6 +156,35 @@ protected:
         }
         return return_value;
     };
+    virtual nsapi_size_or_error_t socket_sendto_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams,
+                                                      nsapi_size_t count)
+    {
+        nsapi_size_t sent;
+        for (sent = 0; sent < count; sent++) {
+            datagrams[sent].result = return_value;
+            if (!return_values.empty()) {
+                datagrams[sent].result = return_values.front();
+                return_values.pop_front();
+            }
+            if (datagrams[sent].result < 0) {
+                return sent ? (nsapi_size_or_error_t)sent : datagrams[sent].result;
+            }
+        }
+        return sent;
+    };
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams,
+                                                        nsapi_size_t count)
+    {
+        nsapi_size_t recv;
+        for (recv = 0; recv < count; recv++) {
+            datagrams[recv].result = socket_recvfrom(handle, &datagrams[recv].address,
+                                                     datagrams[recv].data, datagrams[recv].size);
+            if (datagrams[recv].result < 0) {
+                return recv ? (nsapi_size_or_error_t)recv : datagrams[recv].result;
+            }
+        }
+        return recv;
+    };
     virtual void socket_attach(nsapi_socket_t handle, void (*callback)(void *), void *data) {};
 
 private:
@@ -61,4 +61,24 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
 {
     return;
 }
+
+void SocketStats::stats_update_tls(const Socket *const reference_id, size_t max_fragment_len, size_t record_len)
+{
+    return;
+}
+
+void SocketStats::stats_update_send_call(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    return;
+}
+
+void SocketStats::stats_update_recv_call(const Socket *const reference_id, uint32_t wait_ms)
+{
+    return;
+}
+
+void SocketStats::stats_update_retransmissions(const Socket *const reference_id, uint32_t retransmissions)
+{
+    return;
+}
 #endif
@@ -67,6 +67,11 @@ void equeue_dealloc(equeue_t *queue, void *event)
 
 }
 
+void equeue_fixed_size(equeue_t *queue, size_t size)
+{
+
+}
+
 void equeue_event_delay(void *event, int ms)
 {
 
@@ -82,6 +87,11 @@ void equeue_event_dtor(void *event, void (*dtor)(void *))
 
 }
 
+void equeue_event_priority(void *event, int priority)
+{
+
+}
+
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event)
 {
     struct equeue_event *e = (struct equeue_event *)event - 1;
@@ -92,6 +102,17 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event)
     return 0;
 }
 
+int equeue_post_isr(equeue_t *queue, void (*cb)(void *), void *event)
+{
+    return equeue_post(queue, cb, event);
+}
+
+bool equeue_update(equeue_t *queue, int id,
+                   void (*update)(void *event, void *context), void *context)
+{
+    return false;
+}
+
 bool equeue_cancel(equeue_t *queue, int id)
 {
     return true;
@@ -29,4 +29,8 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
     return mbed_poll_stub::int_value;
 }
 
+void poll_wake()
+{
+}
+
 }
@@ -63,4 +63,23 @@ void pwmout_pulsewidth_us(pwmout_t *obj, int us)
 {
 }
 
+#if DEVICE_PWMOUT_STREAM
+
+uint32_t pwmout_stream_period_ticks(pwmout_t *obj)
+{
+    return 0;
+}
+
+int pwmout_stream_start(pwmout_t *obj, const uint16_t *buffer, uint32_t count,
+                        pwmout_stream_handler_t handler, void *context)
+{
+    return -1;
+}
+
+void pwmout_stream_stop(pwmout_t *obj)
+{
+}
+
+#endif // DEVICE_PWMOUT_STREAM
+
 #endif // DEVICE_PWMOUT
@@ -166,6 +166,21 @@ public:
         return NSAPI_ERROR_OK;
     }
 
+    void set_radio_state(RadioState state)
+    {
+        CellularDevice::set_radio_state(state);
+    }
+
+    void start_connect_stats()
+    {
+        CellularDevice::start_connect_stats();
+    }
+
+    void add_data_stats(nsapi_size_t sent, nsapi_size_t received)
+    {
+        CellularDevice::add_data_stats(sent, received);
+    }
+
     void verify_timeout_array(const uint16_t timeout[], int array_len)
     {
         if (array_len > CELLULAR_RETRY_ARRAY_SIZE) {
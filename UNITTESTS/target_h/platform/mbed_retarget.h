@@ -349,6 +349,7 @@ namespace mbed {
 #define O_RDWR   2        ///< Open for reading and writing
 #define O_NONBLOCK 0x0004 ///< Non-blocking mode
 #define O_APPEND   0x0008 ///< Set file offset to end of file prior to each write
+#define O_DIRECT   0x0010 ///< Write whole sectors straight to storage, leaving syncs to fsync() and close()
 #define O_CREAT    0x0200 ///< Create file if it does not exist
 #define O_TRUNC    0x0400 ///< Truncate file to zero length
 #define O_EXCL     0x0800 ///< Fail if file exists
@@ -420,6 +421,12 @@ struct pollfd {
     short revents;
 };
 
+/* sys/uio.h defines */
+struct iovec {
+    void *iov_base;
+    size_t iov_len;
+};
+
 }
 
 #endif //RETARGET_H
@@ -1611,7 +1611,6 @@ extern "C" void xcvr_spi_transfer(uint32_t instance,
 {
     MBED_ASSERT(spi != NULL);
     (void)instance;
-    volatile uint8_t dummy;
 
     if (!transferByteCount) {
         return;
@@ -1621,21 +1620,10 @@ extern "C" void xcvr_spi_transfer(uint32_t instance,
         return;
     }
 
-    while (transferByteCount--) {
-        if (sendBuffer) {
-            dummy = *sendBuffer;
-            sendBuffer++;
-        } else {
-            dummy = 0xFF;
-        }
-
-        dummy = spi->write(dummy);
-
-        if (receiveBuffer) {
-            *receiveBuffer = dummy;
-            receiveBuffer++;
-        }
-    }
+    // One block transfer, so frame buffer uploads and reads run back to back
+    // on the bus. Reads without data to send clock out the 0xFF fill value.
+    spi->write(reinterpret_cast<const char *>(sendBuffer), sendBuffer ? transferByteCount : 0,
+               reinterpret_cast<char *>(receiveBuffer), receiveBuffer ? transferByteCount : 0);
 }
 
 /*****************************************************************************/
@@ -114,6 +114,10 @@ static psa_status_t convert_status(int status)
         case MBED_ERROR_AUTHENTICATION_FAILED: // fallthrough
         case MBED_ERROR_RBP_AUTHENTICATION_FAILED:
             return PSA_ERROR_INVALID_SIGNATURE;
+        case MBED_ERROR_UNSUPPORTED:
+            return PSA_ERROR_NOT_SUPPORTED;
+        case MBED_ERROR_INVALID_OPERATION:
+            return PSA_ERROR_BAD_STATE;
         default:
             return PSA_ERROR_GENERIC_ERROR;
     }
@@ -282,6 +286,24 @@ psa_status_t psa_storage_reset_impl(KVStore *kvstore)
     return convert_status(status);
 }
 
+psa_status_t psa_storage_begin_batch_impl(KVStore *kvstore)
+{
+    int status = kvstore->begin_batch();
+    return convert_status(status);
+}
+
+psa_status_t psa_storage_commit_batch_impl(KVStore *kvstore)
+{
+    int status = kvstore->commit_batch();
+    return convert_status(status);
+}
+
+psa_status_t psa_storage_abort_batch_impl(KVStore *kvstore)
+{
+    int status = kvstore->abort_batch();
+    return convert_status(status);
+}
+
 #ifdef   __cplusplus
 }
 #endif
@@ -41,6 +41,9 @@ psa_status_t psa_storage_get_impl(mbed::KVStore *kvstore, int32_t pid, psa_stora
 psa_status_t psa_storage_get_info_impl(mbed::KVStore *kvstore, int32_t pid, psa_storage_uid_t uid, struct psa_storage_info_t *p_info, uint32_t *kv_get_flags);
 psa_status_t psa_storage_remove_impl(mbed::KVStore *kvstore, int32_t pid, psa_storage_uid_t uid);
 psa_status_t psa_storage_reset_impl(mbed::KVStore *kvstore);
+psa_status_t psa_storage_begin_batch_impl(mbed::KVStore *kvstore);
+psa_status_t psa_storage_commit_batch_impl(mbed::KVStore *kvstore);
+psa_status_t psa_storage_abort_batch_impl(mbed::KVStore *kvstore);
 
 #ifdef   __cplusplus
 }
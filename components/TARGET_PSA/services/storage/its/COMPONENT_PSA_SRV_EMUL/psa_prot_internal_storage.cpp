@@ -106,3 +106,26 @@ extern "C" psa_status_t psa_its_reset()
 
     return psa_its_reset_impl();
 }
+
+psa_status_t psa_its_begin_batch()
+{
+    // KVStore initiation:
+    // - In EMUL (non-secure single core) we do it here since we don't have another context to do it inside.
+    // - Repeating calls has no effect
+    int kv_status = kv_init_storage_config();
+    if (kv_status != MBED_SUCCESS) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return psa_its_begin_batch_impl();
+}
+
+psa_status_t psa_its_commit_batch()
+{
+    return psa_its_commit_batch_impl();
+}
+
+psa_status_t psa_its_abort_batch()
+{
+    return psa_its_abort_batch_impl();
+}
@@ -32,6 +32,20 @@ KVStore *get_its_kvstore_instance(void);
 #include "KVMap.h"
 #endif
 
+#ifndef MBED_CONF_PSA_ITS_CACHE_ENTRIES
+#define MBED_CONF_PSA_ITS_CACHE_ENTRIES 0
+#endif
+
+#ifndef MBED_CONF_PSA_ITS_CACHE_VALUE_SIZE
+#define MBED_CONF_PSA_ITS_CACHE_VALUE_SIZE 64
+#endif
+
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include "mbedtls/platform_util.h"
+#endif
+
 
 
 #ifdef   __cplusplus
@@ -45,6 +59,125 @@ extern "C"
 static KVStore *kvstore = NULL;
 static bool initialized = false;
 
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+// Values of recently read UIDs, so that hot items such as key handles are not
+// looked up and read from the KVStore again. Entries are keyed by pid and uid.
+typedef struct {
+    int32_t pid;
+    psa_storage_uid_t uid;
+    uint32_t last_use;      // 0 for a free entry
+    uint32_t flags;
+    size_t size;
+    uint8_t data[MBED_CONF_PSA_ITS_CACHE_VALUE_SIZE];
+} its_cache_entry_t;
+
+static SingletonPtr<PlatformMutex> its_cache_mutex;
+static its_cache_entry_t its_cache[MBED_CONF_PSA_ITS_CACHE_ENTRIES];
+static uint32_t its_cache_clock = 0;
+// Bumped by every write, so that a value read before a write is not cached after it
+static uint32_t its_cache_generation = 0;
+// Reads see the values from before an open batch, they are not cached
+static bool its_batch_open = false;
+
+static its_cache_entry_t *its_cache_find(int32_t pid, psa_storage_uid_t uid)
+{
+    for (int i = 0; i < MBED_CONF_PSA_ITS_CACHE_ENTRIES; i++) {
+        if (its_cache[i].last_use && its_cache[i].pid == pid && its_cache[i].uid == uid) {
+            return &its_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void its_cache_drop(its_cache_entry_t *entry)
+{
+    mbedtls_platform_zeroize(entry, sizeof(*entry));
+}
+
+static void its_cache_insert(int32_t pid, psa_storage_uid_t uid, const void *data, size_t size, uint32_t flags)
+{
+    its_cache_entry_t *entry = its_cache_find(pid, uid);
+    if (!entry) {
+        entry = &its_cache[0];
+        for (int i = 1; i < MBED_CONF_PSA_ITS_CACHE_ENTRIES && entry->last_use; i++) {
+            if (its_cache[i].last_use < entry->last_use) {
+                entry = &its_cache[i];
+            }
+        }
+    }
+
+    its_cache_drop(entry);
+    entry->pid = pid;
+    entry->uid = uid;
+    entry->last_use = ++its_cache_clock;
+    entry->flags = flags;
+    entry->size = size;
+    if (size) {
+        memcpy(entry->data, data, size);
+    }
+}
+
+// Drop the entries of all uids, or of uid only, after a write
+static void its_cache_invalidate(bool all, int32_t pid, psa_storage_uid_t uid)
+{
+    its_cache_mutex->lock();
+    its_cache_generation++;
+    for (int i = 0; i < MBED_CONF_PSA_ITS_CACHE_ENTRIES; i++) {
+        if (its_cache[i].last_use && (all || (its_cache[i].pid == pid && its_cache[i].uid == uid))) {
+            its_cache_drop(&its_cache[i]);
+        }
+    }
+    its_cache_mutex->unlock();
+}
+
+// Make the cache hold uid, reading it whole from the KVStore if it is small enough.
+// Returns the status of the lookup, *cached tells whether the value is in the cache.
+static psa_status_t its_cache_load(int32_t pid, psa_storage_uid_t uid, bool *cached)
+{
+    *cached = false;
+
+    its_cache_mutex->lock();
+    its_cache_entry_t *entry = its_cache_find(pid, uid);
+    if (entry) {
+        entry->last_use = ++its_cache_clock;
+        *cached = true;
+        its_cache_mutex->unlock();
+        return PSA_SUCCESS;
+    }
+    uint32_t generation = its_cache_generation;
+    bool batch_open = its_batch_open;
+    its_cache_mutex->unlock();
+
+    if (batch_open) {
+        return PSA_SUCCESS;
+    }
+
+    // The KVStore is accessed without the cache lock, a thread holding the
+    // KVStore for a batch may need the lock to write.
+    struct psa_storage_info_t info;
+    uint32_t kv_get_flags;
+    psa_status_t status = psa_storage_get_info_impl(kvstore, pid, uid, &info, &kv_get_flags);
+    if (status != PSA_SUCCESS || info.size > MBED_CONF_PSA_ITS_CACHE_VALUE_SIZE) {
+        return status;
+    }
+
+    uint8_t data[MBED_CONF_PSA_ITS_CACHE_VALUE_SIZE];
+    size_t size = 0;
+    status = psa_storage_get_impl(kvstore, pid, uid, 0, info.size, data, &size);
+    if (status == PSA_SUCCESS && size == info.size) {
+        its_cache_mutex->lock();
+        if (generation == its_cache_generation) {
+            its_cache_insert(pid, uid, data, size, info.flags);
+            *cached = true;
+        }
+        its_cache_mutex->unlock();
+    }
+    mbedtls_platform_zeroize(data, sizeof(data));
+
+    return status;
+}
+#endif
+
 
 MBED_WEAK psa_status_t its_version_migrate(KVStore *kvstore,
                                            const psa_storage_version_t *old_version, const psa_storage_version_t *new_version)
@@ -78,6 +211,10 @@ static void its_init(void)
 // used from test only
 void its_deinit(void)
 {
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    its_cache_invalidate(true, 0, 0);
+    its_batch_open = false;
+#endif
     kvstore = NULL;
     initialized = false;
 }
@@ -93,7 +230,21 @@ psa_status_t psa_its_set_impl(int32_t pid, psa_storage_uid_t uid, size_t data_le
         return PSA_ERROR_NOT_SUPPORTED;
     }
 
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    psa_status_t status = psa_storage_set_impl(kvstore, pid, uid, data_length, p_data, create_flags);
+    its_cache_invalidate(false, pid, uid);
+    if (status == PSA_SUCCESS && data_length <= MBED_CONF_PSA_ITS_CACHE_VALUE_SIZE) {
+        // Write through, unless the value only takes effect when the batch commits
+        its_cache_mutex->lock();
+        if (!its_batch_open) {
+            its_cache_insert(pid, uid, p_data, data_length, create_flags);
+        }
+        its_cache_mutex->unlock();
+    }
+    return status;
+#else
     return psa_storage_set_impl(kvstore, pid, uid, data_length, p_data, create_flags);
+#endif
 }
 
 psa_status_t psa_its_get_impl(int32_t pid, psa_storage_uid_t uid, size_t data_offset, size_t data_length, void *p_data, size_t *p_data_length)
@@ -102,6 +253,38 @@ psa_status_t psa_its_get_impl(int32_t pid, psa_storage_uid_t uid, size_t data_of
         its_init();
     }
 
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    if (uid == 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    bool cached;
+    psa_status_t status = its_cache_load(pid, uid, &cached);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (cached) {
+        // Same checks as psa_storage_get_impl()
+        its_cache_mutex->lock();
+        its_cache_entry_t *entry = its_cache_find(pid, uid);
+        if (entry) {
+            if (data_offset > entry->size || data_length + data_offset < data_length) {
+                status = PSA_ERROR_INVALID_ARGUMENT;
+            } else if (data_offset + data_length > entry->size) {
+                status = PSA_ERROR_BUFFER_TOO_SMALL;
+            } else {
+                memcpy(p_data, entry->data + data_offset, data_length);
+                *p_data_length = data_length;
+            }
+            its_cache_mutex->unlock();
+            return status;
+        }
+        // Invalidated meanwhile
+        its_cache_mutex->unlock();
+    }
+#endif
+
     return psa_storage_get_impl(kvstore, pid, uid, data_offset, data_length, p_data, p_data_length);
 }
 
@@ -112,6 +295,31 @@ psa_status_t psa_its_get_info_impl(int32_t pid, psa_storage_uid_t uid, struct ps
         its_init();
     }
 
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    if (uid == 0) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    bool cached;
+    psa_status_t status = its_cache_load(pid, uid, &cached);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (cached) {
+        its_cache_mutex->lock();
+        its_cache_entry_t *entry = its_cache_find(pid, uid);
+        if (entry) {
+            p_info->flags = entry->flags & PSA_STORAGE_FLAG_WRITE_ONCE;
+            p_info->size = entry->size;
+            p_info->capacity = entry->size;
+            its_cache_mutex->unlock();
+            return PSA_SUCCESS;
+        }
+        its_cache_mutex->unlock();
+    }
+#endif
+
     return psa_storage_get_info_impl(kvstore, pid, uid, p_info, &kv_get_flags);
 }
 
@@ -121,7 +329,13 @@ psa_status_t psa_its_remove_impl(int32_t pid, psa_storage_uid_t uid)
         its_init();
     }
 
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    psa_status_t status = psa_storage_remove_impl(kvstore, pid, uid);
+    its_cache_invalidate(false, pid, uid);
+    return status;
+#else
     return psa_storage_remove_impl(kvstore, pid, uid);
+#endif
 }
 
 psa_status_t psa_its_reset_impl()
@@ -139,7 +353,58 @@ psa_status_t psa_its_reset_impl()
         error("Failed getting kvstore instance\n");
     }
 
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    psa_status_t status = psa_storage_reset_impl(kvstore);
+    its_cache_invalidate(true, 0, 0);
+    return status;
+#else
     return psa_storage_reset_impl(kvstore);
+#endif
+}
+
+psa_status_t psa_its_begin_batch_impl()
+{
+    if (!initialized) {
+        its_init();
+    }
+
+    psa_status_t status = psa_storage_begin_batch_impl(kvstore);
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    if (status == PSA_SUCCESS) {
+        its_cache_mutex->lock();
+        its_batch_open = true;
+        its_cache_mutex->unlock();
+    }
+#endif
+    return status;
+}
+
+static psa_status_t its_end_batch(bool commit)
+{
+    if (!initialized) {
+        its_init();
+    }
+
+    psa_status_t status = commit ? psa_storage_commit_batch_impl(kvstore) : psa_storage_abort_batch_impl(kvstore);
+#if MBED_CONF_PSA_ITS_CACHE_ENTRIES > 0
+    // A failed commit leaves the batch open
+    if (status == PSA_SUCCESS) {
+        its_cache_mutex->lock();
+        its_batch_open = false;
+        its_cache_mutex->unlock();
+    }
+#endif
+    return status;
+}
+
+psa_status_t psa_its_commit_batch_impl()
+{
+    return its_end_batch(true);
+}
+
+psa_status_t psa_its_abort_batch_impl()
+{
+    return its_end_batch(false);
 }
 
 #ifdef   __cplusplus
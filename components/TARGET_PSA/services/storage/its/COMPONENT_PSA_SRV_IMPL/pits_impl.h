@@ -31,6 +31,9 @@ psa_status_t psa_its_get_impl(int32_t pid, psa_storage_uid_t uid, size_t data_of
 psa_status_t psa_its_get_info_impl(int32_t pid, psa_storage_uid_t uid, struct psa_storage_info_t *p_info);
 psa_status_t psa_its_remove_impl(int32_t pid, psa_storage_uid_t uid);
 psa_status_t psa_its_reset_impl();
+psa_status_t psa_its_begin_batch_impl();
+psa_status_t psa_its_commit_batch_impl();
+psa_status_t psa_its_abort_batch_impl();
 
 #ifdef   __cplusplus
 }
@@ -135,3 +135,19 @@ psa_status_t psa_its_reset()
     psa_close(conn);
     return status;
 }
+
+// The ITS partition has no service for batches: items are written one by one
+psa_status_t psa_its_begin_batch()
+{
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_its_commit_batch()
+{
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_its_abort_batch()
+{
+    return PSA_ERROR_NOT_SUPPORTED;
+}
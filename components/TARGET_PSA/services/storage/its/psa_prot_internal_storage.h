@@ -157,6 +157,47 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
  */
 psa_status_t psa_its_remove(psa_storage_uid_t uid);
 
+/**
+ * \brief Start a batch of set and remove operations, committed to the storage at once
+ *
+ * Mbed OS extension to the PSA ITS API. Items set or removed by the calling
+ * thread until `psa_its_commit_batch` are appended to the storage together,
+ * and take effect all at once, or not at all if power is lost before the
+ * commit completes. This saves storage writes when provisioning many small
+ * items. Until the batch is closed, reads return the values from before the
+ * batch and other threads accessing the storage wait.
+ *
+ * \return      A status indicating the success/failure of the operation
+ *
+ * \retval      PSA_SUCCESS                  The operation completed successfully
+ * \retval      PSA_ERROR_NOT_SUPPORTED      The storage doesn't support batches, items must be set one by one
+ * \retval      PSA_ERROR_BAD_STATE          A batch is already open
+ * \retval      PSA_ERROR_STORAGE_FAILURE    The operation failed because the physical storage has failed (Fatal error)
+ */
+psa_status_t psa_its_begin_batch(void);
+
+/**
+ * \brief Commit the open batch
+ *
+ * \return      A status indicating the success/failure of the operation
+ *
+ * \retval      PSA_SUCCESS                      The operation completed successfully
+ * \retval      PSA_ERROR_BAD_STATE              No batch is open
+ * \retval      PSA_ERROR_INSUFFICIENT_STORAGE   The batch doesn't fit in the storage, it stays open
+ * \retval      PSA_ERROR_STORAGE_FAILURE        The operation failed because the physical storage has failed, the batch stays open
+ */
+psa_status_t psa_its_commit_batch(void);
+
+/**
+ * \brief Discard the open batch
+ *
+ * \return      A status indicating the success/failure of the operation
+ *
+ * \retval      PSA_SUCCESS                  The operation completed successfully
+ * \retval      PSA_ERROR_BAD_STATE          No batch is open
+ */
+psa_status_t psa_its_abort_batch(void);
+
 #ifdef __cplusplus
 }
 #endif
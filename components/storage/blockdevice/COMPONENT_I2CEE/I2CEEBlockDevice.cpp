@@ -29,6 +29,7 @@ I2CEEBlockDevice::I2CEEBlockDevice(
     , _address_is_eight_bit(address_is_eight_bit)
     , _size(size)
     , _block(block)
+    , _write_pending(false)
 {
     _i2c = new (_i2c_buffer) I2C(sda, scl);
     _i2c->frequency(freq);
@@ -42,6 +43,7 @@ I2CEEBlockDevice::I2CEEBlockDevice(
     , _address_is_eight_bit(address_is_eight_bit)
     , _size(size)
     , _block(block)
+    , _write_pending(false)
 {
     _i2c = i2c_obj;
 }
@@ -54,12 +56,19 @@ I2CEEBlockDevice::~I2CEEBlockDevice()
 
 int I2CEEBlockDevice::init()
 {
+    // Also checks the chip is there
+    _write_pending = true;
     return _sync();
 }
 
 int I2CEEBlockDevice::deinit()
 {
-    return 0;
+    return _sync();
+}
+
+int I2CEEBlockDevice::sync()
+{
+    return _sync();
 }
 
 int I2CEEBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
@@ -69,6 +78,11 @@ int I2CEEBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 
     auto *pBuffer = static_cast<char *>(buffer);
 
+    int err = _sync();
+    if (err) {
+        return err;
+    }
+
     _i2c->start();
 
     if (1 != _i2c->write(get_paged_device_address(addr))) {
@@ -104,6 +118,13 @@ int I2CEEBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
         uint32_t off = addr % _block;
         uint32_t chunk = (off + size < _block) ? size : (_block - off);
 
+        // Wait for the previous page, the last one is left writing while
+        // the caller gets on with its next buffer
+        int err = _sync();
+        if (err) {
+            return err;
+        }
+
         _i2c->start();
 
         if (1 != _i2c->write(get_paged_device_address(addr))) {
@@ -125,12 +146,7 @@ int I2CEEBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
         }
 
         _i2c->stop();
-
-        int err = _sync();
-
-        if (err) {
-            return err;
-        }
+        _write_pending = true;
 
         addr += chunk;
         size -= chunk;
@@ -148,11 +164,16 @@ int I2CEEBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 
 int I2CEEBlockDevice::_sync()
 {
+    if (!_write_pending) {
+        return 0;
+    }
+
     // The chip doesn't ACK while writing to the actual EEPROM
     // so loop trying to do a zero byte write until it is ACKed
     // by the chip.
     for (int i = 0; i < I2CEE_TIMEOUT; i++) {
         if (_i2c->write(_i2c_addr | 0, 0, 0) < 1) {
+            _write_pending = false;
             return 0;
         }
 
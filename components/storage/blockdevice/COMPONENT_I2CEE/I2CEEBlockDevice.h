@@ -109,6 +109,15 @@ public:
      */
     virtual int deinit();
 
+    /** Wait for the last page write to finish
+     *
+     *  program() returns while the chip is still writing its last page, the
+     *  chip is polled by the next access or by this call.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
     /** Read blocks from a block device
      *
      *  @param buffer   Buffer to write blocks to
@@ -178,6 +187,7 @@ private:
     bool _address_is_eight_bit;
     uint32_t _size;
     uint32_t _block;
+    bool _write_pending;
 
     int _sync();
 
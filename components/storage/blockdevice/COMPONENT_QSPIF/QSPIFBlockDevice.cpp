@@ -21,6 +21,14 @@
 #include <string.h>
 #include "rtos/ThisThread.h"
 
+/* Asynchronous operations run in the shared event thread when there is one */
+#if defined(MBED_CONF_RTOS_PRESENT) && !MBED_CONF_EVENTS_SHARED_DISPATCH_FROM_APPLICATION
+#include "events/mbed_shared_queues.h"
+#define QSPIF_DEFER_ASYNC 1
+#else
+#define QSPIF_DEFER_ASYNC 0
+#endif
+
 #ifndef MBED_CONF_MBED_TRACE_ENABLE
 #define MBED_CONF_MBED_TRACE_ENABLE        0
 #endif
@@ -62,6 +70,8 @@ using namespace mbed;
 #define QSPIF_BASIC_PARAM_TABLE_222_READ_INST_BYTE 23
 #define QSPIF_BASIC_PARAM_TABLE_122_READ_INST_BYTE 15
 #define QSPIF_BASIC_PARAM_TABLE_112_READ_INST_BYTE 13
+#define QSPIF_BASIC_PARAM_TABLE_118_READ_INST_BYTE 65
+#define QSPIF_BASIC_PARAM_TABLE_188_READ_INST_BYTE 67
 // Quad Enable Params
 #define QSPIF_BASIC_PARAM_TABLE_QER_BYTE 58
 #define QSPIF_BASIC_PARAM_TABLE_444_MODE_EN_SEQ_BYTE 56
@@ -132,6 +142,29 @@ QSPIFBlockDevice::QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinNam
     _init_ref_count(0),
     _is_initialized(false)
 {
+    _octal_bus = false;
+    _initialize_members();
+}
+
+#if DEVICE_QSPI_OCTAL
+QSPIFBlockDevice::QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinName io3,
+                                   PinName io4, PinName io5, PinName io6, PinName io7,
+                                   PinName sclk, PinName csel,
+                                   int clock_mode,
+                                   int freq)
+    :
+    _qspi(io0, io1, io2, io3, io4, io5, io6, io7, sclk, csel, clock_mode), _csel(csel), _freq(freq),
+    _init_ref_count(0),
+    _is_initialized(false)
+{
+    _octal_bus = true;
+    _initialize_members();
+}
+#endif
+
+void QSPIFBlockDevice::_initialize_members()
+{
+    PinName csel = _csel;
     _unique_device_status = add_new_csel_instance(csel);
 
     if (_unique_device_status == 0) {
@@ -238,6 +271,8 @@ int QSPIFBlockDevice::init()
         _sfdp_info.bptbl.size = 0;
         _sfdp_info.smptbl.addr = 0x0;
         _sfdp_info.smptbl.size = 0;
+        _sfdp_info.xspi.addr = 0x0;
+        _sfdp_info.xspi.size = 0;
 
         if (sfdp_parse_headers(callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command), _sfdp_info) < 0) {
             tr_error("Init - Parse SFDP Headers Failed");
@@ -245,6 +280,12 @@ int QSPIFBlockDevice::init()
             goto exit_point;
         }
 
+        if (sfdp_parse_xspi_profile_table(callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command), _sfdp_info) < 0) {
+            tr_error("Init - Parse xSPI Profile Table Failed");
+            status = QSPIF_BD_ERROR_PARSING_FAILED;
+            goto exit_point;
+        }
+
         if (_sfdp_parse_basic_param_table(callback(this, &QSPIFBlockDevice::_qspi_send_read_sfdp_command),
                                           _sfdp_info) < 0) {
             tr_error("Init - Parse Basic Param Table Failed");
@@ -495,6 +536,58 @@ bd_size_t QSPIFBlockDevice::get_erase_size() const
     return _sfdp_info.smptbl.regions_min_common_erase_size;
 }
 
+int QSPIFBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if QSPIF_DEFER_ASYNC
+    // Run the blocking read in the shared event thread
+    if (0 == mbed_event_queue()->call(this, &QSPIFBlockDevice::_deferred_read, buffer, addr, size, callback)) {
+        return QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::read_async(buffer, addr, size, callback);
+#endif
+}
+
+int QSPIFBlockDevice::program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if QSPIF_DEFER_ASYNC
+    if (0 == mbed_event_queue()->call(this, &QSPIFBlockDevice::_deferred_program, buffer, addr, size, callback)) {
+        return QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::program_async(buffer, addr, size, callback);
+#endif
+}
+
+int QSPIFBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if QSPIF_DEFER_ASYNC
+    if (0 == mbed_event_queue()->call(this, &QSPIFBlockDevice::_deferred_erase, addr, size, callback)) {
+        return QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::erase_async(addr, size, callback);
+#endif
+}
+
+void QSPIFBlockDevice::_deferred_read(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(read(buffer, addr, size));
+}
+
+void QSPIFBlockDevice::_deferred_program(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(program(buffer, addr, size));
+}
+
+void QSPIFBlockDevice::_deferred_erase(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(erase(addr, size));
+}
+
 const char *QSPIFBlockDevice::get_type() const
 {
     return "QSPIF";
@@ -546,6 +639,72 @@ int QSPIFBlockDevice::get_erase_value() const
     return 0xFF;
 }
 
+const void *QSPIFBlockDevice::map(bd_addr_t addr, bd_size_t size)
+{
+#if DEVICE_QSPI_MEMORY_MAPPED
+    if (!_is_initialized || size == 0 || (addr + size) > this->size()) {
+        return NULL;
+    }
+
+    // With an extended address register the controller only sees the
+    // 16MB bank the register selects
+    bd_addr_t offset = addr;
+    if (_4byte_msb_reg_write_inst != QSPI_NO_INST) {
+        if ((addr >> 24) != ((addr + size - 1) >> 24)) {
+            tr_error("Map - region crosses a 16MB bank");
+            return NULL;
+        }
+        offset = addr & 0xFFFFFF;
+    }
+
+    const void *mapped = NULL;
+    _mutex.lock();
+
+    qspi_status_t status = _qspi_update_4byte_ext_addr_reg(addr);
+    if (QSPI_STATUS_OK == status) {
+        // Mapped reads use the best bus mode supported by the part, as read() does
+        status = _qspi.configure_format(_inst_width, _address_width, _address_size, _address_width,
+                                        _alt_size, _data_width, _dummy_cycles);
+    }
+    if (QSPI_STATUS_OK == status) {
+        const void *base;
+        size_t map_size;
+        status = _qspi.map(_read_instruction, (_alt_size == 0) ? -1 : QSPI_ALT_DEFAULT_VALUE, &base, &map_size);
+        if (QSPI_STATUS_OK == status) {
+            if ((offset + size) <= map_size) {
+                mapped = (const uint8_t *)base + offset;
+            } else {
+                tr_error("Map - region beyond the controller's memory-mapped window");
+                _qspi.unmap();
+            }
+        }
+    }
+
+    // The format only applies to later commands, which leave memory-mapped mode
+    _qspi.configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, _address_size, QSPI_CFG_BUS_SINGLE, 0, QSPI_CFG_BUS_SINGLE, 0);
+
+    _mutex.unlock();
+    return mapped;
+#else
+    return NULL;
+#endif
+}
+
+int QSPIFBlockDevice::unmap()
+{
+#if DEVICE_QSPI_MEMORY_MAPPED
+    int status = QSPIF_BD_ERROR_OK;
+    _mutex.lock();
+    if (QSPI_STATUS_OK != _qspi.unmap()) {
+        status = QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    _mutex.unlock();
+    return status;
+#else
+    return QSPIF_BD_ERROR_OK;
+#endif
+}
+
 /********************************/
 /*   Different Device Csel Mgmt */
 /********************************/
@@ -611,7 +770,7 @@ int QSPIFBlockDevice::remove_csel_instance(PinName csel)
 /*********************************************************/
 /********** SFDP Parsing and Detection Functions *********/
 /*********************************************************/
-int QSPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
+int QSPIFBlockDevice::_sfdp_parse_basic_param_table(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
                                                     sfdp_hdr_info &sfdp_info)
 {
     uint8_t param_table[SFDP_BASIC_PARAMS_TBL_SIZE]; /* Up To 20 DWORDS = 80 Bytes */
@@ -822,6 +981,35 @@ int QSPIFBlockDevice::_sfdp_detect_best_bus_read_mode(uint8_t *basic_param_table
     uint8_t examined_byte;
 
     do { // compound statement is the loop body
+        // Octal modes are checked first, a zero instruction means the mode is not supported
+        if (_octal_bus && basic_param_table_size > QSPIF_BASIC_PARAM_TABLE_188_READ_INST_BYTE) {
+            if (basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_188_READ_INST_BYTE]) {
+                // Fast Read 1-8-8 Supported
+                _read_instruction = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_188_READ_INST_BYTE];
+                _dummy_cycles = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_188_READ_INST_BYTE - 1] & 0x1F;
+                uint8_t mode_cycles = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_188_READ_INST_BYTE - 1] >> 5;
+                _alt_size = mode_cycles * 8;
+                _address_width = QSPI_CFG_BUS_OCTAL;
+                _data_width = QSPI_CFG_BUS_OCTAL;
+                tr_debug("Read Bus Mode set to 1-8-8, Instruction: 0x%xh", _read_instruction);
+                break;
+            }
+            if (basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_118_READ_INST_BYTE]) {
+                // Fast Read 1-1-8 Supported
+                _read_instruction = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_118_READ_INST_BYTE];
+                _dummy_cycles = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_118_READ_INST_BYTE - 1] & 0x1F;
+                uint8_t mode_cycles = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_118_READ_INST_BYTE - 1] >> 5;
+                _alt_size = mode_cycles;
+                _data_width = QSPI_CFG_BUS_OCTAL;
+                tr_debug("Read Bus Mode set to 1-1-8, Instruction: 0x%xh", _read_instruction);
+                break;
+            }
+        }
+        if (_octal_bus && _sfdp_info.xspi.read_8d8d8d_inst > 0) {
+            // Entering 8D-8D-8D switches every command of the device to it, which this driver does not do
+            tr_info("Device supports 8D-8D-8D reads, which are not used");
+        }
+
         examined_byte = basic_param_table_ptr[QSPIF_BASIC_PARAM_TABLE_FAST_READ_SUPPORT_BYTE];
         if (examined_byte & 0x20) {
             //  Fast Read 1-4-4 Supported
@@ -134,6 +134,31 @@ public:
                      int clock_mode = MBED_CONF_QSPIF_QSPI_POLARITY_MODE,
                      int freq = MBED_CONF_QSPIF_QSPI_FREQ);
 
+#if DEVICE_QSPI_OCTAL || defined(DOXYGEN_ONLY)
+    /** Create QSPIFBlockDevice - An SFDP based Flash Block Device over an octal bus
+     *
+     *  Reads use the 1-8-8 or 1-1-8 bus mode when the device lists it in SFDP, other commands stay 1-1-1.
+     *
+     *  @param io0 1st IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io1 2nd IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io2 3rd IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io3 4th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io4 5th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io5 6th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io6 7th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io7 8th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param sclk QSPI Clock pin
+     *  @param csel QSPI chip select pin
+     *  @param clock_mode specifies the QSPI Clock Polarity mode (QSPIF_POLARITY_MODE_0/QSPIF_POLARITY_MODE_1)
+     *  @param freq Clock frequency of the QSPI bus
+     */
+    QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinName io3,
+                     PinName io4, PinName io5, PinName io6, PinName io7,
+                     PinName sclk, PinName csel,
+                     int clock_mode = MBED_CONF_QSPIF_QSPI_POLARITY_MODE,
+                     int freq = MBED_CONF_QSPIF_QSPI_FREQ);
+#endif
+
     /** Initialize a block device
      *
      *  @return         QSPIF_BD_ERROR_OK(0) - success
@@ -197,6 +222,44 @@ public:
      */
     virtual int erase(mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+    /** Start reading blocks from a block device
+     *
+     *  The read runs in the thread of the shared event queue, and the
+     *  callback is called from there with the result of read(). Without
+     *  an RTOS, or if the shared event queue is dispatched from the
+     *  application, the read completes before returning.
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function to call with the result when the read has finished
+     *  @return         0 if the read was started, or a negative error code
+     */
+    virtual int read_async(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start programming blocks to a block device
+     *
+     *  The program runs like read_async().
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function to call with the result when the program has finished
+     *  @return         0 if the program was started, or a negative error code
+     */
+    virtual int program_async(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start erasing blocks on a block device
+     *
+     *  The erase runs like read_async().
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function to call with the result when the erase has finished
+     *  @return         0 if the erase was started, or a negative error code
+     */
+    virtual int erase_async(mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -248,6 +311,30 @@ public:
      */
     virtual const char *get_type() const;
 
+    /** Map a region of the device for reading in place
+     *
+     *  Puts the QSPI controller in memory-mapped mode, so the region can be
+     *  read through the returned pointer with no copy, and cached by the CPU.
+     *  Reads use the same bus mode as read().
+     *
+     *  The pointer is valid until unmap() is called, or until any other
+     *  operation on this device or another device on the same QSPI bus.
+     *  Mapping needs a target with DEVICE_QSPI_MEMORY_MAPPED.
+     *
+     *  @param addr     Address of the region to map
+     *  @param size     Size of the region in bytes
+     *  @return         Read-only pointer to the data at addr, or NULL if the
+     *                  region can't be mapped
+     */
+    const void *map(mbed::bd_addr_t addr, mbed::bd_size_t size);
+
+    /** Leave memory-mapped mode
+     *
+     *  @return         QSPIF_BD_ERROR_OK(0) - success
+     *                  QSPIF_BD_ERROR_DEVICE_ERROR - device driver transaction failed
+     */
+    int unmap();
+
 private:
     /********************************/
     /*   Different Device Csel Mgmt */
@@ -256,6 +343,9 @@ private:
     // Only one QSPIFBlockDevice instance per CS is allowed
     int add_new_csel_instance(PinName csel);
 
+    // Set the members shared by the constructors
+    void _initialize_members();
+
     // Remove device CS from existing device list upon destroying object (last deinit is called)
     int remove_csel_instance(PinName csel);
 
@@ -313,7 +403,7 @@ private:
     /* SFDP Detection and Parsing Functions */
     /****************************************/
     // Parse and Detect required Basic Parameters from Table
-    int _sfdp_parse_basic_param_table(mbed::Callback<int(mbed::bd_addr_t, void *, mbed::bd_size_t)> sfdp_reader,
+    int _sfdp_parse_basic_param_table(mbed::FunctionRef<int(mbed::bd_addr_t, void *, mbed::bd_size_t)> sfdp_reader,
                                       mbed::sfdp_hdr_info &sfdp_info);
 
     // Detect the soft reset protocol and reset - returns error if soft reset is not supported
@@ -333,6 +423,11 @@ private:
     int _sfdp_detect_and_enable_4byte_addressing(uint8_t *basic_param_table_ptr, int basic_param_table_size);
 
 private:
+    // Run a blocking operation and report its result, from the shared event queue
+    void _deferred_read(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+    void _deferred_program(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+    void _deferred_erase(mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
     enum qspif_clear_protection_method_t {
         QSPIF_BP_ULBPR,    // Issue global protection unlock instruction
         QSPIF_BP_CLEAR_SR, // Clear protection bits in status register 1
@@ -391,6 +486,7 @@ private:
     bool _alt_enabled; //Whether alt is enabled
     uint8_t _dummy_cycles; //Number of Dummy cycles required by Current Bus Mode
     qspi_bus_width_t _data_width; //Bus width for Data phase
+    bool _octal_bus; //Whether io4-io7 are connected
 
     uint32_t _init_ref_count;
     bool _is_initialized;
@@ -142,6 +142,14 @@
 #include "SDBlockDevice.h"
 #include "rtos/ThisThread.h"
 #include "platform/mbed_debug.h"
+
+/* Asynchronous operations run in the shared event thread when there is one */
+#if defined(MBED_CONF_RTOS_PRESENT) && !MBED_CONF_EVENTS_SHARED_DISPATCH_FROM_APPLICATION
+#include "events/mbed_shared_queues.h"
+#define SD_DEFER_ASYNC 1
+#else
+#define SD_DEFER_ASYNC 0
+#endif
 #ifndef __STDC_FORMAT_MACROS
 #define __STDC_FORMAT_MACROS
 #endif
@@ -653,6 +661,41 @@ bd_size_t SDBlockDevice::size() const
     return _block_size * _sectors;
 }
 
+int SDBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if SD_DEFER_ASYNC
+    // Run the blocking read in the shared event thread
+    if (0 == mbed_event_queue()->call(this, &SDBlockDevice::_deferred_read, buffer, addr, size, callback)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::read_async(buffer, addr, size, callback);
+#endif
+}
+
+int SDBlockDevice::program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if SD_DEFER_ASYNC
+    if (0 == mbed_event_queue()->call(this, &SDBlockDevice::_deferred_program, buffer, addr, size, callback)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::program_async(buffer, addr, size, callback);
+#endif
+}
+
+void SDBlockDevice::_deferred_read(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(read(buffer, addr, size));
+}
+
+void SDBlockDevice::_deferred_program(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(program(buffer, addr, size));
+}
+
 const char *SDBlockDevice::get_type() const
 {
     return "SD";
@@ -949,7 +992,10 @@ int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
     }
 
     // read data
-    _spi.write(NULL, 0, (char *)buffer, length);
+    if (0 != _transfer_data(NULL, buffer, length)) {
+        debug_if(SD_DBG, "Read transfer failed\n");
+        return SD_BLOCK_DEVICE_ERROR_NO_RESPONSE;
+    }
 
     // Read the CRC16 checksum for the data block
     crc = (_spi.write(SPI_FILL_CHAR) << 8);
@@ -982,7 +1028,10 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
     _spi.write(token);
 
     // write the data
-    _spi.write((char *)buffer, length, NULL, 0);
+    if (0 != _transfer_data(buffer, NULL, length)) {
+        debug_if(SD_DBG, "Write transfer failed\n");
+        return 0;
+    }
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -1125,6 +1174,35 @@ void SDBlockDevice::_spi_wait(uint8_t count)
     }
 }
 
+int SDBlockDevice::_transfer_data(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length)
+{
+#if SD_ASYNC_TRANSFER
+    // Let the peripheral move the block while this thread sleeps, the
+    // card stays selected as the transfer runs between select() and
+    // deselect()
+    if (0 == _spi.transfer(tx_buffer, tx_buffer ? length : 0, rx_buffer, rx_buffer ? length : 0,
+                           callback(this, &SDBlockDevice::_transfer_done), SPI_EVENT_ALL)) {
+        if (!_transfer_sem.try_acquire_for(std::chrono::milliseconds(SD_COMMAND_TIMEOUT))) {
+            _spi.abort_transfer();
+            // consume a completion which raced with the timeout
+            _transfer_sem.try_acquire();
+            return -1;
+        }
+        return (_transfer_event == SPI_EVENT_COMPLETE) ? 0 : -1;
+    }
+#endif
+    _spi.write((const char *)tx_buffer, tx_buffer ? length : 0, (char *)rx_buffer, rx_buffer ? length : 0);
+    return 0;
+}
+
+#if SD_ASYNC_TRANSFER
+void SDBlockDevice::_transfer_done(int event)
+{
+    _transfer_event = event;
+    _transfer_sem.release();
+}
+#endif
+
 void SDBlockDevice::_spi_init()
 {
     _spi.lock();
@@ -1132,6 +1210,9 @@ void SDBlockDevice::_spi_init()
     _spi.frequency(_init_sck);
     _spi.format(8, 0);
     _spi.set_default_write_value(SPI_FILL_CHAR);
+#if SD_ASYNC_TRANSFER
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
     // Initial 74 cycles required for few cards, before selecting SPI mode
     _spi_wait(10);
     _spi.unlock();
@@ -51,6 +51,16 @@
 #ifndef MBED_CONF_SD_CRC_ENABLED
 #define MBED_CONF_SD_CRC_ENABLED 0
 #endif
+#ifndef MBED_CONF_SD_ASYNC_ENABLED
+#define MBED_CONF_SD_ASYNC_ENABLED 0
+#endif
+
+/* Move the data of read and write blocks with non-blocking SPI transfers */
+#define SD_ASYNC_TRANSFER (DEVICE_SPI_ASYNCH && MBED_CONF_SD_ASYNC_ENABLED)
+
+#if SD_ASYNC_TRANSFER
+#include "rtos/Semaphore.h"
+#endif
 
 /** SDBlockDevice class
  *
@@ -135,6 +145,33 @@ public:
      */
     virtual int program(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+    /** Start reading blocks from a block device
+     *
+     *  The read runs in the thread of the shared event queue, and the
+     *  callback is called from there with the result of read(). Without
+     *  an RTOS, or if the shared event queue is dispatched from the
+     *  application, the read completes before returning.
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function to call with the result when the read has finished
+     *  @return         0 if the read was started, or a negative error code
+     */
+    virtual int read_async(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start programming blocks to a block device
+     *
+     *  The program runs like read_async().
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function to call with the result when the program has finished
+     *  @return         0 if the program was started, or a negative error code
+     */
+    virtual int program_async(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
     /** Mark blocks as no longer in use
      *
      *  This function provides a hint to the underlying block device that a region of blocks
@@ -233,6 +270,10 @@ private:
         ACMD51_SEND_SCR = 51,
     };
 
+    // Run a blocking operation and report its result, from the shared event queue
+    void _deferred_read(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+    void _deferred_program(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
     uint8_t _card_type;
     int _cmd(SDBlockDevice::cmdSupported cmd, uint32_t arg, bool isAcmd = 0, uint32_t *resp = NULL);
     int _cmd8();
@@ -271,6 +312,7 @@ private:
     int _read(uint8_t *buffer, uint32_t length);
     int _read_bytes(uint8_t *buffer, uint32_t length);
     uint8_t _write(const uint8_t *buffer, uint8_t token, uint32_t length);
+    int _transfer_data(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length);
     int _freq(void);
     void _preclock_then_select();
     void _postclock_then_deselect();
@@ -295,6 +337,13 @@ private:
 #if MBED_CONF_SD_CRC_ENABLED
     bool _crc_on;
 #endif
+
+#if SD_ASYNC_TRANSFER
+    void _transfer_done(int event);
+
+    rtos::Semaphore _transfer_sem;  /**< Released when a non-blocking transfer ends */
+    int _transfer_event;            /**< Event which ended the last non-blocking transfer */
+#endif
 };
 
 #endif  /* DEVICE_SPI */
@@ -20,6 +20,14 @@
 #include "rtos/ThisThread.h"
 #include "mbed_critical.h"
 
+/* Asynchronous operations run in the shared event thread when there is one */
+#if defined(MBED_CONF_RTOS_PRESENT) && !MBED_CONF_EVENTS_SHARED_DISPATCH_FROM_APPLICATION
+#include "events/mbed_shared_queues.h"
+#define SPIF_DEFER_ASYNC 1
+#else
+#define SPIF_DEFER_ASYNC 0
+#endif
+
 #include <string.h>
 #include <inttypes.h>
 
@@ -451,6 +459,58 @@ int SPIFBlockDevice::get_erase_value() const
     return 0xFF;
 }
 
+int SPIFBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if SPIF_DEFER_ASYNC
+    // Run the blocking read in the shared event thread
+    if (0 == mbed_event_queue()->call(this, &SPIFBlockDevice::_deferred_read, buffer, addr, size, callback)) {
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::read_async(buffer, addr, size, callback);
+#endif
+}
+
+int SPIFBlockDevice::program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if SPIF_DEFER_ASYNC
+    if (0 == mbed_event_queue()->call(this, &SPIFBlockDevice::_deferred_program, buffer, addr, size, callback)) {
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::program_async(buffer, addr, size, callback);
+#endif
+}
+
+int SPIFBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+#if SPIF_DEFER_ASYNC
+    if (0 == mbed_event_queue()->call(this, &SPIFBlockDevice::_deferred_erase, addr, size, callback)) {
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return 0;
+#else
+    return BlockDevice::erase_async(addr, size, callback);
+#endif
+}
+
+void SPIFBlockDevice::_deferred_read(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(read(buffer, addr, size));
+}
+
+void SPIFBlockDevice::_deferred_program(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(program(buffer, addr, size));
+}
+
+void SPIFBlockDevice::_deferred_erase(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    callback(erase(addr, size));
+}
+
 const char *SPIFBlockDevice::get_type() const
 {
     return "SPIF";
@@ -587,7 +647,7 @@ spif_bd_error SPIFBlockDevice::_spi_send_general_command(int instruction, bd_add
 /*********************************************************/
 /********** SFDP Parsing and Detection Functions *********/
 /*********************************************************/
-int SPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
+int SPIFBlockDevice::_sfdp_parse_basic_param_table(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
                                                    mbed::sfdp_hdr_info &sfdp_info)
 {
     uint8_t param_table[SFDP_BASIC_PARAMS_TBL_SIZE]; /* Up To 20 DWORDS = 80 Bytes */
@@ -678,6 +738,8 @@ int SPIFBlockDevice::_reset_flash_mem()
                 tr_error("Sending RST failed");
                 status = -1;
             }
+            // The device ignores commands until the reset has completed
+            rtos::ThisThread::sleep_for(1);
             if (false == _is_mem_ready()) {
                 tr_error("Device not ready, write failed");
                 status = -1;
@@ -695,15 +757,19 @@ bool SPIFBlockDevice::_is_mem_ready()
     int retries = 0;
     bool mem_ready = true;
 
-    do {
-        rtos::ThisThread::sleep_for(1);
-        retries++;
+    // Poll before sleeping, page programs usually finish in well under the 1 ms sleep
+    while (true) {
         //Read the Status Register from device
         if (SPIF_BD_ERROR_OK != _spi_send_general_command(SPIF_RDSR, SPI_NO_ADDRESS_COMMAND, NULL, 0, status_value,
                                                           1)) {   // store received values in status_value
             tr_error("Reading Status Register failed");
         }
-    } while ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0 && retries < IS_MEM_READY_MAX_RETRIES);
+        if ((status_value[0] & SPIF_STATUS_BIT_WIP) == 0 || retries >= IS_MEM_READY_MAX_RETRIES) {
+            break;
+        }
+        rtos::ThisThread::sleep_for(1);
+        retries++;
+    }
 
     if ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0) {
         tr_error("_is_mem_ready FALSE");
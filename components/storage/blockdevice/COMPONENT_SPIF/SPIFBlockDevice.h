@@ -165,6 +165,44 @@ public:
      */
     virtual int erase(mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+    /** Start reading blocks from a block device
+     *
+     *  The read runs in the thread of the shared event queue, and the
+     *  callback is called from there with the result of read(). Without
+     *  an RTOS, or if the shared event queue is dispatched from the
+     *  application, the read completes before returning.
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function to call with the result when the read has finished
+     *  @return         0 if the read was started, or a negative error code
+     */
+    virtual int read_async(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start programming blocks to a block device
+     *
+     *  The program runs like read_async().
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function to call with the result when the program has finished
+     *  @return         0 if the program was started, or a negative error code
+     */
+    virtual int program_async(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start erasing blocks on a block device
+     *
+     *  The erase runs like read_async().
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function to call with the result when the erase has finished
+     *  @return         0 if the erase was started, or a negative error code
+     */
+    virtual int erase_async(mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -224,7 +262,7 @@ private:
     int _spi_send_read_sfdp_command(mbed::bd_addr_t addr, void *rx_buffer, mbed::bd_size_t rx_length);
 
     // Parse and Detect required Basic Parameters from Table
-    int _sfdp_parse_basic_param_table(mbed::Callback<int(mbed::bd_addr_t, void *, mbed::bd_size_t)> sfdp_reader,
+    int _sfdp_parse_basic_param_table(mbed::FunctionRef<int(mbed::bd_addr_t, void *, mbed::bd_size_t)> sfdp_reader,
                                       mbed::sfdp_hdr_info &hdr_info);
 
     // Detect fastest read Bus mode supported by device
@@ -264,6 +302,11 @@ private:
     int _handle_vendor_quirks();
 
 private:
+    // Run a blocking operation and report its result, from the shared event queue
+    void _deferred_read(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+    void _deferred_program(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+    void _deferred_erase(mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::Callback<void(int)> callback);
+
     // Master side hardware
     mbed::SPI _spi;
 
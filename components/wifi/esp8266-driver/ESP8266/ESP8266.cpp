@@ -345,14 +345,19 @@ bool ESP8266::cond_enable_tcp_passive_mode()
 }
 
 
-nsapi_error_t ESP8266::connect(const char *ap, const char *passPhrase)
+nsapi_error_t ESP8266::connect(const char *ap, const char *passPhrase, const char *bssid)
 {
     nsapi_error_t ret = NSAPI_ERROR_OK;
 
     _smutex.lock();
     set_timeout(ESP8266_CONNECT_TIMEOUT);
 
-    bool res = _parser.send("AT+CWJAP_CUR=\"%s\",\"%s\"", ap, passPhrase);
+    bool res;
+    if (bssid) {
+        res = _parser.send("AT+CWJAP_CUR=\"%s\",\"%s\",\"%s\"", ap, passPhrase, bssid);
+    } else {
+        res = _parser.send("AT+CWJAP_CUR=\"%s\",\"%s\"", ap, passPhrase);
+    }
     if (!res || !_parser.recv("OK\n")) {
         if (_fail) {
             if (_connect_error == 1) {
@@ -375,6 +380,19 @@ nsapi_error_t ESP8266::connect(const char *ap, const char *passPhrase)
     return ret;
 }
 
+bool ESP8266::get_bssid(char bssid[18])
+{
+    _smutex.lock();
+    set_timeout(ESP8266_CONNECT_TIMEOUT);
+    bool done = _parser.send("AT+CWJAP_CUR?")
+                && _parser.recv("+CWJAP_CUR:\"%*[^\"]\",\"%17[^\"]\"", bssid)
+                && _parser.recv("OK\n");
+    set_timeout();
+    _smutex.unlock();
+
+    return done;
+}
+
 bool ESP8266::disconnect(void)
 {
     _smutex.lock();
@@ -459,18 +477,10 @@ int8_t ESP8266::rssi()
     int8_t rssi = 0;
     char bssid[18];
 
-    _smutex.lock();
-    set_timeout(ESP8266_CONNECT_TIMEOUT);
-    if (!(_parser.send("AT+CWJAP_CUR?")
-            && _parser.recv("+CWJAP_CUR:\"%*[^\"]\",\"%17[^\"]\"", bssid)
-            && _parser.recv("OK\n"))) {
-        _smutex.unlock();
+    if (!get_bssid(bssid)) {
         return 0;
     }
 
-    set_timeout();
-    _smutex.unlock();
-
     WiFiAccessPoint ap[1];
     _scan_r.res = ap;
     _scan_r.limit = 1;
@@ -868,39 +878,50 @@ int32_t ESP8266::_recv_tcp_passive(int id, void *data, uint32_t amount, uint32_t
 
     _process_oob(timeout, true);
 
-    if (_sock_i[id].tcp_data_avbl != 0) {
-        _sock_i[id].tcp_data = (char *)data;
+    // Keep fetching while the modem has data buffered and the caller has room,
+    // so large reads don't pay a socket call for every +CIPRECVDATA chunk
+    uint32_t received = 0;
+    while (_sock_i[id].tcp_data_avbl != 0 && received < amount) {
+        _sock_i[id].tcp_data = (char *)data + received;
         _sock_i[id].tcp_data_rcvd = NSAPI_ERROR_WOULD_BLOCK;
         _sock_active_id = id;
 
         // +CIPRECVDATA supports up to 2048 bytes at a time
-        amount = amount > 2048 ? 2048 : amount;
+        uint32_t chunk = amount - received > 2048 ? 2048 : amount - received;
 
         // NOTE: documentation v3.0 says '+CIPRECVDATA:<data_len>,' but it's not how the FW responds...
-        bool done = _parser.send("AT+CIPRECVDATA=%d,%" PRIu32, id, amount)
+        bool done = _parser.send("AT+CIPRECVDATA=%d,%" PRIu32, id, chunk)
                     && _parser.recv("OK\n");
 
         _sock_i[id].tcp_data = NULL;
         _sock_active_id = -1;
 
         if (!done) {
+            if (received) {
+                break;
+            }
             goto BUSY;
         }
 
         // update internal variable tcp_data_avbl to reflect the remaining data
-        if (_sock_i[id].tcp_data_rcvd > 0) {
-            if (_sock_i[id].tcp_data_rcvd > (int32_t)amount) {
+        int32_t rcvd = _sock_i[id].tcp_data_rcvd;
+        if (rcvd > 0) {
+            if (rcvd > (int32_t)chunk) {
                 MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER, MBED_ERROR_CODE_EBADMSG), \
                            "ESP8266::_recv_tcp_passive() too much data from modem\n");
             }
-            if (_sock_i[id].tcp_data_avbl > _sock_i[id].tcp_data_rcvd) {
-                _sock_i[id].tcp_data_avbl -= _sock_i[id].tcp_data_rcvd;
+            if (_sock_i[id].tcp_data_avbl > rcvd) {
+                _sock_i[id].tcp_data_avbl -= rcvd;
             } else {
                 _sock_i[id].tcp_data_avbl = 0;
             }
+            received += rcvd;
         }
 
-        ret = _sock_i[id].tcp_data_rcvd;
+        ret = received ? (int32_t)received : rcvd;
+        if (rcvd < (int32_t)chunk) {
+            break;
+        }
     }
 
     if (!_sock_i[id].open && ret == NSAPI_ERROR_WOULD_BLOCK) {
@@ -936,36 +957,36 @@ int32_t ESP8266::recv_tcp(int id, void *data, uint32_t amount, uint32_t timeout)
         _process_oob(timeout, true);
     }
 
-    // check if any packets are ready for us
-    for (struct packet **p = &_packets; *p; p = &(*p)->next) {
-        if ((*p)->id == id) {
-            struct packet *q = *p;
-
-            if (q->len <= amount) { // Return and remove full packet
-                memcpy(data, q + 1, q->len);
-
-                if (_packets_end == &(*p)->next) {
-                    _packets_end = p;
-                }
-                *p = (*p)->next;
-
-                _smutex.unlock();
-
-                uint32_t pdu_len = sizeof(struct packet) + q->alloc_len;
-                uint32_t len = q->len;
-                free(q);
-                _heap_usage -= pdu_len;
-                return len;
-            } else { // return only partial packet
-                memcpy(data, q + 1, amount);
+    // check if any packets are ready for us, and take as many as fit
+    uint32_t copied = 0;
+    struct packet **p = &_packets;
+    while (*p && copied < amount) {
+        struct packet *q = *p;
+        if (q->id != id) {
+            p = &q->next;
+            continue;
+        }
 
-                q->len -= amount;
-                memmove(q + 1, (uint8_t *)(q + 1) + amount, q->len);
+        // Data already returned is skipped rather than moved
+        uint32_t len = q->len < amount - copied ? q->len : amount - copied;
+        memcpy((uint8_t *)data + copied, (uint8_t *)(q + 1) + (q->alloc_len - q->len), len);
+        copied += len;
+        q->len -= len;
+        if (q->len) {
+            break;
+        }
 
-                _smutex.unlock();
-                return amount;
-            }
+        // Remove the full packet
+        if (_packets_end == &q->next) {
+            _packets_end = p;
         }
+        *p = q->next;
+        _heap_usage -= sizeof(struct packet) + q->alloc_len;
+        free(q);
+    }
+    if (copied) {
+        _smutex.unlock();
+        return copied;
     }
     if (!_sock_i[id].open) {
         _smutex.unlock();
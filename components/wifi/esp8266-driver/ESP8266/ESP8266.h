@@ -168,9 +168,18 @@ public:
     *
     * @param ap the name of the AP
     * @param passPhrase the password of AP
+    * @param bssid MAC address of the AP to join, NULL to let the modem pick one (Default: NULL)
     * @return NSAPI_ERROR_OK in success, negative error code in failure
     */
-    nsapi_error_t connect(const char *ap, const char *passPhrase);
+    nsapi_error_t connect(const char *ap, const char *passPhrase, const char *bssid = NULL);
+
+    /**
+    * Get the MAC address of the AP ESP8266 is connected to
+    *
+    * @param bssid buffer for the address in the "xx:xx:xx:xx:xx:xx" format
+    * @return true only if ESP8266 is connected and the address could be read
+    */
+    bool get_bssid(char bssid[18]);
 
     /**
     * Disconnect ESP8266 from AP
@@ -30,6 +30,9 @@
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_debug.h"
 #include "rtos/ThisThread.h"
+#if defined(MBED_CONF_ESP8266_FAST_RECONNECT_KVSTORE)
+#include "kvstore_global_api.h"
+#endif
 
 #ifndef MBED_CONF_ESP8266_DEBUG
 #define MBED_CONF_ESP8266_DEBUG false
@@ -57,6 +60,42 @@
 
 #define LOCAL_ADDR "127.0.0.1"
 
+#if defined(MBED_CONF_ESP8266_FAST_RECONNECT_KVSTORE)
+// AP of the last connection, stored as the SSID followed by the BSSID
+#define FAST_RECONNECT_KEY MBED_CONF_ESP8266_FAST_RECONNECT_KVSTORE "esp8266_ap"
+#define FAST_RECONNECT_SSID_SIZE 33
+#define FAST_RECONNECT_BSSID_SIZE 18
+
+static bool ap_cache_get(const char *ssid, char *bssid)
+{
+    char cached[FAST_RECONNECT_SSID_SIZE + FAST_RECONNECT_BSSID_SIZE];
+    size_t len = 0;
+    if (kv_get(FAST_RECONNECT_KEY, cached, sizeof(cached), &len) != MBED_SUCCESS || len != sizeof(cached)) {
+        return false;
+    }
+    cached[FAST_RECONNECT_SSID_SIZE - 1] = '\0';
+    cached[sizeof(cached) - 1] = '\0';
+    if (strcmp(cached, ssid) != 0) {
+        return false;
+    }
+    memcpy(bssid, cached + FAST_RECONNECT_SSID_SIZE, FAST_RECONNECT_BSSID_SIZE);
+    return true;
+}
+
+static void ap_cache_set(const char *ssid, const char *bssid)
+{
+    char cached[FAST_RECONNECT_SSID_SIZE + FAST_RECONNECT_BSSID_SIZE] = { 0 };
+    char bssid_cached[FAST_RECONNECT_BSSID_SIZE];
+    // write only on change to spare the flash
+    if (ap_cache_get(ssid, bssid_cached) && strcmp(bssid, bssid_cached) == 0) {
+        return;
+    }
+    strncpy(cached, ssid, FAST_RECONNECT_SSID_SIZE - 1);
+    strncpy(cached + FAST_RECONNECT_SSID_SIZE, bssid, FAST_RECONNECT_BSSID_SIZE - 1);
+    kv_set(FAST_RECONNECT_KEY, cached, sizeof(cached), 0);
+}
+#endif // MBED_CONF_ESP8266_FAST_RECONNECT_KVSTORE
+
 using namespace mbed;
 using namespace rtos;
 
@@ -259,7 +298,25 @@ void ESP8266Interface::_connect_async()
         _cmutex.unlock();
         return;
     }
+#if defined(MBED_CONF_ESP8266_FAST_RECONNECT_KVSTORE)
+    // Join the AP of the last connection directly, and fall back to letting
+    // the modem choose if it has gone away
+    char bssid[FAST_RECONNECT_BSSID_SIZE];
+    if (ap_cache_get(ap_ssid, bssid)) {
+        _connect_retval = _esp.connect(ap_ssid, ap_pass, bssid);
+        if (_connect_retval != NSAPI_ERROR_OK && _connect_retval != NSAPI_ERROR_AUTH_FAILURE) {
+            kv_remove(FAST_RECONNECT_KEY);
+            _connect_retval = _esp.connect(ap_ssid, ap_pass);
+        }
+    } else {
+        _connect_retval = _esp.connect(ap_ssid, ap_pass);
+    }
+    if (_connect_retval == NSAPI_ERROR_OK && _esp.get_bssid(bssid)) {
+        ap_cache_set(ap_ssid, bssid);
+    }
+#else
     _connect_retval = _esp.connect(ap_ssid, ap_pass);
+#endif
     int timeleft_ms = ESP8266_INTERFACE_CONNECT_TIMEOUT_MS - _conn_timer.read_ms();
     if (_connect_retval == NSAPI_ERROR_OK
             || _connect_retval == NSAPI_ERROR_AUTH_FAILURE
@@ -0,0 +1,146 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGINSTREAM_H
+#define MBED_ANALOGINSTREAM_H
+
+#include "platform/platform.h"
+
+#if DEVICE_ANALOGIN_ASYNCH || defined(DOXYGEN_ONLY)
+
+#include "hal/analogin_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include "platform/Span.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_AnalogInStream AnalogInStream class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A continuously sampled analog input
+ *
+ * Conversions are triggered at a fixed rate by the hardware and written to
+ * a double buffer without CPU involvement. The callback is called from
+ * interrupt context each time one half of the buffer is full, with that
+ * half, while the other half is being filled. The callback must be done
+ * with the samples before the other half fills up.
+ *
+ * To process the samples in thread context, pass an event created by
+ * EventQueue::event() as the callback.
+ *
+ * This locks the deep sleep while sampling.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * AnalogInStream vibration(A0);
+ * uint16_t samples[2 * 256];
+ *
+ * void process(Span<const uint16_t> block)
+ * {
+ *     // 256 samples, 5.12ms of signal
+ * }
+ *
+ * int main() {
+ *     EventQueue *queue = mbed_event_queue();
+ *     vibration.start(samples, 50000, queue->event(process));
+ *     queue->dispatch_forever();
+ * }
+ * @endcode
+ */
+class AnalogInStream : private NonCopyable<AnalogInStream> {
+
+public:
+    /** Create an AnalogInStream, connected to the specified pin
+     *
+     * @param pin AnalogIn pin to connect to
+     */
+    AnalogInStream(PinName pin);
+
+    /** Create an AnalogInStream, connected to the specified pin
+     *
+     * @param pinmap reference to structure which holds static pinmap.
+     */
+    AnalogInStream(const PinMap &pinmap);
+    AnalogInStream(const PinMap &&) = delete; // prevent passing of temporary objects
+
+    ~AnalogInStream();
+
+    /** Start sampling
+     *
+     * @param buffer      The sample buffer, split in two halves of equal size.
+     *                    It must stay valid until stop() is called.
+     * @param sample_rate The number of samples per second
+     * @param callback    Called from interrupt context with each half of the
+     *                    buffer once it is full
+     *
+     * @return 0 if sampling has started, -1 if already sampling, if the
+     *         buffer can't be split in two halves or if the sample rate is
+     *         not supported
+     */
+    int start(Span<uint16_t> buffer, uint32_t sample_rate, Callback<void(Span<const uint16_t>)> callback);
+
+    /** Stop sampling
+     *
+     * The callback is not called once this returns.
+     */
+    void stop();
+
+    /** Check if sampling is in progress
+     *
+     * @return true if started and not stopped
+     */
+    bool active() const
+    {
+        return _active;
+    }
+
+#if !defined(DOXYGEN_ONLY)
+protected:
+    void lock()
+    {
+        _mutex->lock();
+    }
+
+    void unlock()
+    {
+        _mutex->unlock();
+    }
+
+    static void _irq_handler(uint32_t id, const uint16_t *samples, size_t count);
+
+    analogin_t _adc;
+    Callback<void(Span<const uint16_t>)> _callback;
+    bool _active;
+    static SingletonPtr<PlatformMutex> _mutex;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -37,6 +37,16 @@
 #define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
 #endif
 
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_DMA_BUF_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_DMA_BUF_SIZE  0
+#endif
+
+#if DEVICE_SERIAL_DMA && MBED_CONF_DRIVERS_UART_SERIAL_DMA_BUF_SIZE > 0
+#define BUFFERED_SERIAL_DMA 1
+#else
+#define BUFFERED_SERIAL_DMA 0
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_BufferedSerial BufferedSerial class
@@ -89,6 +99,16 @@ public:
      */
     short poll(short events) const final;
 
+    /** BufferedSerial calls mbed::poll_wake() on state changes, so
+     *  mbed::poll() can block on it rather than checking it periodically.
+     *
+     *  @returns true
+     */
+    bool wakes_poll() const final
+    {
+        return true;
+    }
+
     /* Resolve ambiguities versus our private SerialBase
      * (for writable, spelling differs, but just in case)
      */
@@ -125,6 +145,26 @@ public:
      */
     ssize_t read(void *buffer, size_t length) override;
 
+    /** Write the contents of several buffers to a file
+     *
+     *  The buffers are queued for transmission under a single lock, with
+     *  the same semantics as write() of their total size.
+     *
+     *  @param iov      The buffers to write from
+     *  @return         The number of bytes written, negative error on failure
+     */
+    ssize_t writev(Span<const struct iovec> iov) override;
+
+    /** Read the contents of a file into several buffers
+     *
+     *  The buffers are filled from the receive buffer under a single lock,
+     *  with the same semantics as read() of their total size.
+     *
+     *  @param iov      The buffers to read in to
+     *  @return         The number of bytes read, negative error on failure
+     */
+    ssize_t readv(Span<const struct iovec> iov) override;
+
     /** Close a file
      *
      *  @return         0 on success, negative error code on failure
@@ -301,6 +341,28 @@ private:
      */
     ssize_t write_unbuffered(const char *buf_ptr, size_t length);
 
+    /** Check if data is still waiting to be sent
+     *  @return         true if the TX buffer or the TX DMA is not empty
+     */
+    bool tx_pending();
+
+    /** Buffered write, called with the mutex held
+     *  @param buf_ptr  The buffer to write from
+     *  @param length   The number of bytes to write
+     *  @return         The number of bytes written
+     */
+    size_t write_locked(const char *buf_ptr, size_t length);
+
+    /** Wait for received data, called with the mutex held
+     *  @return         true if data is available, false if there is none and
+     *                  the serial is non-blocking
+     */
+    bool wait_readable_locked();
+
+    /** Resume reception after reading, called with the mutex held
+     */
+    void resume_rx_locked();
+
     /** Enable processing of byte reception IRQs and register a callback to
      * process them.
      */
@@ -328,6 +390,21 @@ private:
     CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
     CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
 
+#if BUFFERED_SERIAL_DMA
+    /** DMA buffers
+     *  The peripheral receives continuously into _rx_dma_buf, and the RX IRQ
+     *  moves what arrived since _rx_dma_tail into _rxbuf. The TX IRQ moves
+     *  data from _txbuf into _tx_dma_buf each time a transmission completes.
+     */
+    char _rx_dma_buf[MBED_CONF_DRIVERS_UART_SERIAL_DMA_BUF_SIZE];
+    char _tx_dma_buf[MBED_CONF_DRIVERS_UART_SERIAL_DMA_BUF_SIZE];
+    size_t _rx_dma_tail = 0;
+
+    /** Start continuous reception into _rx_dma_buf
+     */
+    void start_rx_dma();
+#endif
+
     PlatformMutex _mutex;
 
     Callback<void()> _sigio_cb;
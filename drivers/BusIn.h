@@ -20,6 +20,7 @@
 #include "platform/platform.h"
 #include "drivers/DigitalIn.h"
 #include "platform/PlatformMutex.h"
+#include "drivers/internal/BusPorts.h"
 #include "platform/NonCopyable.h"
 
 namespace mbed {
@@ -122,6 +123,11 @@ protected:
 
     PlatformMutex _mutex;
 
+#if DEVICE_PORTIN
+    /* Pins sharing a port, accessed with one port operation per port */
+    internal::BusPorts _ports;
+#endif
+
 private:
     virtual void lock();
     virtual void unlock();
@@ -19,6 +19,7 @@
 
 #include "drivers/DigitalInOut.h"
 #include "platform/PlatformMutex.h"
+#include "drivers/internal/BusPorts.h"
 #include "platform/NonCopyable.h"
 
 namespace mbed {
@@ -147,6 +148,11 @@ protected:
     int _nc_mask;
 
     PlatformMutex _mutex;
+
+#if DEVICE_PORTINOUT
+    /* Pins sharing a port, accessed with one port operation per port */
+    internal::BusPorts _ports;
+#endif
 #endif //!defined(DOXYGEN_ONLY)
 };
 
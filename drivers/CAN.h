@@ -25,6 +25,7 @@
 #include "platform/Callback.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 namespace mbed {
 /** \defgroup drivers-public-api-can CAN
@@ -53,6 +54,7 @@ public:
         format = CANStandard;
         id     = 0U;
         memset(data, 0, 8);
+        timestamp = 0;
     }
 
     /** Creates CAN message with specific content.
@@ -70,6 +72,7 @@ public:
         format = _format;
         id     = _id;
         memcpy(data, _data, len);
+        timestamp = 0;
     }
 
 
@@ -88,6 +91,7 @@ public:
         format = _format;
         id     = _id;
         memcpy(data, _data, len);
+        timestamp = 0;
     }
 
     /** Creates CAN remote message.
@@ -102,7 +106,16 @@ public:
         format = _format;
         id     = _id;
         memset(data, 0, 8);
+        timestamp = 0;
     }
+
+    /** Time the message was received, in microseconds of the us ticker
+     *
+     *  Only set for messages taken from the receive buffer, see
+     *  CAN::rx_buffer(). It is the time at which the frame was read from
+     *  the peripheral, unless the target timestamps frames in hardware.
+     */
+    us_timestamp_t timestamp;
 };
 
 /** @}*/
@@ -213,7 +226,8 @@ public:
     /** Read a CANMessage from the bus.
      *
      *  @param msg A CANMessage to read to.
-     *  @param handle message filter handle (0 for any message)
+     *  @param handle message filter handle (0 for any message), ignored
+     *  while the receive buffer is active
      *
      *  @returns
      *    0 if no message arrived,
@@ -265,6 +279,92 @@ public:
      */
     int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
 
+    /** Get the number of acceptance filter banks
+     *
+     *  Filter banks expose the whole acceptance filter of the peripheral,
+     *  so several ids or id ranges can be received at once, and the
+     *  controller discards everything else before it reaches the receive
+     *  FIFO.
+     *
+     *  @returns
+     *    number of filter banks, 0 if filter banks are unsupported
+     */
+    int filter_banks();
+
+    /** Configure an acceptance filter bank
+     *
+     *  A message is received if it matches any of the enabled banks. It
+     *  matches a bank if its format matches and (message id & mask)
+     *  equals (id & mask).
+     *
+     *  @param bank the bank to configure, from 0 to filter_banks() - 1
+     *  @param id the id to filter on
+     *  @param mask the mask applied to the id
+     *  @param format format to filter on (Default CANStandard)
+     *
+     *  @returns
+     *    0 if the bank could not be configured or is unsupported,
+     *    1 if successful
+     *
+     *  @note The filter set up by the constructor to receive all messages,
+     *  which is bank 0 on targets with filter banks, stays enabled until
+     *  it is reconfigured or disabled.
+     */
+    int filter_bank(int bank, unsigned int id, unsigned int mask, CANFormat format = CANStandard);
+
+    /** Disable an acceptance filter bank
+     *
+     *  @param bank the bank to disable
+     *
+     *  @returns
+     *    0 if the bank could not be disabled or is unsupported,
+     *    1 if successful
+     */
+    int filter_bank_disable(int bank);
+
+    /** Start receiving messages into a buffer
+     *
+     *  Instead of leaving messages in the few hardware mailboxes until
+     *  read() is called, the receive interrupt handler moves every message
+     *  into a FIFO as soon as it arrives, together with the time it was
+     *  received. This keeps up with back to back frames on a busy bus, as
+     *  long as the FIFO is drained often enough, preferably in batches with
+     *  read(Span<CANMessage>).
+     *
+     *  While the buffer is active, read() takes messages from the FIFO and
+     *  the callback attached to CAN::RxIrq is called after the messages
+     *  are stored. This function locks the deep sleep until rx_buffer_stop()
+     *  is called.
+     *
+     *  @param buffer   Storage for the FIFO, one slot is kept empty so it
+     *                  holds up to buffer.size() - 1 messages. It must stay
+     *                  valid until rx_buffer_stop() is called.
+     */
+    void rx_buffer(Span<CANMessage> buffer);
+
+    /** Stop receiving messages into the buffer
+     *
+     *  Messages still in the FIFO are discarded.
+     */
+    void rx_buffer_stop();
+
+    /** Read several messages
+     *
+     *  @param msgs Where to copy the messages, oldest first
+     *
+     *  @returns number of messages read, 0 if none arrived
+     */
+    int read(Span<CANMessage> msgs);
+
+    /** Number of messages lost because the receive buffer was full
+     *
+     *  The count is reset when rx_buffer() is called. Messages lost by
+     *  the hardware are counted by rderror().
+     *
+     *  @returns number of messages dropped since the buffer was started
+     */
+    uint32_t rx_dropped() const;
+
     /**  Detects read errors - Used to detect read overflow errors.
      *
      *  @returns number of read errors
@@ -308,9 +408,17 @@ protected:
     virtual void lock();
     virtual void unlock();
 
+    void buffer_rx();
+    bool pop_rx(CANMessage &msg);
+
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
+    CANMessage         *_rx_buffer;
+    uint32_t            _rx_size;
+    uint32_t            _rx_head;
+    uint32_t            _rx_tail;
+    uint32_t            _rx_dropped;
 #endif
 };
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DMA_MEMCPY_H
+#define MBED_DMA_MEMCPY_H
+
+#include <stddef.h>
+#include "platform/Callback.h"
+
+namespace mbed {
+/** \addtogroup drivers-public-api */
+/** @{*/
+
+/**
+ * \defgroup drivers_DMAMemcpy DMA memcpy functions
+ * @{
+ */
+
+/** Copy memory with the DMA, completing asynchronously
+ *
+ * Copies of at least drivers.dma-memcpy-threshold bytes run on a memory to
+ * memory DMA channel shared by all callers. Smaller copies, copies started
+ * while the channel is in use and copies on targets without DEVICE_DMA are
+ * done by the CPU before this function returns.
+ *
+ * @param dst   Destination, must not overlap the source
+ * @param src   Source
+ * @param len   Number of bytes to copy
+ * @param done  Called when the copy completes, from interrupt context if
+ *              the DMA did the copy, or before returning otherwise
+ * @return true if the DMA does the copy, false if the CPU did it
+ *
+ * @note Neither buffer may be accessed until done is called.
+ */
+bool dma_memcpy_async(void *dst, const void *src, size_t len, Callback<void()> done);
+
+/** Fill memory with the DMA, completing asynchronously
+ *
+ * Same as dma_memcpy_async() for memset().
+ *
+ * @param dst   Destination
+ * @param value Byte value to fill the destination with
+ * @param len   Number of bytes to fill
+ * @param done  Called when the fill completes, from interrupt context if
+ *              the DMA did the fill, or before returning otherwise
+ * @return true if the DMA does the fill, false if the CPU did it
+ */
+bool dma_memset_async(void *dst, int value, size_t len, Callback<void()> done);
+
+/** Copy memory with the DMA, waiting for the copy to complete
+ *
+ * With an RTOS the calling thread blocks while the DMA copies, letting other
+ * threads run. Falls back to memcpy() like dma_memcpy_async().
+ *
+ * @param dst   Destination, must not overlap the source
+ * @param src   Source
+ * @param len   Number of bytes to copy
+ *
+ * @note Must not be called from interrupt context.
+ */
+void dma_memcpy(void *dst, const void *src, size_t len);
+
+/** Fill memory with the DMA, waiting for the fill to complete
+ *
+ * @param dst   Destination
+ * @param value Byte value to fill the destination with
+ * @param len   Number of bytes to fill
+ *
+ * @note Must not be called from interrupt context.
+ */
+void dma_memset(void *dst, int value, size_t len);
+
+/** @}*/
+/** @}*/
+
+} // namespace mbed
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "platform/platform.h"
 #include "hal/gpio_api.h"
+#include "hal/gpio_fast_api.h"
 
 namespace mbed {
 /**
@@ -78,7 +79,7 @@ public:
     void write(int value)
     {
         // Thread safe / atomic HAL call
-        gpio_write(&gpio, value);
+        gpio_write_fast(&gpio, value);
     }
 
     /** Return the output setting, represented as 0 or 1 (int)
@@ -90,7 +91,7 @@ public:
     int read()
     {
         // Thread safe / atomic HAL call
-        return gpio_read(&gpio);
+        return gpio_read_fast(&gpio);
     }
 
     /** Return the output setting, represented as 0 or 1 (int)
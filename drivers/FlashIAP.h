@@ -27,6 +27,7 @@
 #if DEVICE_FLASH || defined(DOXYGEN_ONLY)
 
 #include "flash_api.h"
+#include "platform/Callback.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
@@ -115,6 +116,46 @@ public:
      */
     int erase(uint32_t addr, uint32_t size);
 
+    /** Program data to pages without blocking the caller for the whole write
+     *
+     *  On targets with DEVICE_FLASH_ASYNCH, this starts programming and
+     *  returns. The flash controller interrupt moves on to the next pages,
+     *  and the callback is called from interrupt context once all the data
+     *  is written. On other targets, the data is programmed from the calling
+     *  thread, which yields between sectors, and the callback is called
+     *  before this returns.
+     *
+     *  Other FlashIAP calls wait until the operation completes.
+     *
+     *  @param buffer   Buffer of data to be written, must stay valid until
+     *                  the callback is called
+     *  @param addr     Address of a page to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program size
+     *  @param callback Called with 0 on success, negative error code on failure
+     *  @return         0 if programming was started, negative error code on
+     *                  failure, in which case the callback is not called
+     */
+    int program_async(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Erase sectors without blocking the caller for the whole erase
+     *
+     *  On targets with DEVICE_FLASH_ASYNCH, this starts erasing and returns.
+     *  The flash controller interrupt moves on to the next sectors, and the
+     *  callback is called from interrupt context once all of them are erased.
+     *  On other targets, the sectors are erased from the calling thread,
+     *  which yields between sectors, and the callback is called before this
+     *  returns.
+     *
+     *  Other FlashIAP calls wait until the operation completes.
+     *
+     *  @param addr     Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size     Size to erase in bytes, must be a multiple of the sector size
+     *  @param callback Called with 0 on success, negative error code on failure
+     *  @return         0 if erasing was started, negative error code on
+     *                  failure, in which case the callback is not called
+     */
+    int erase_async(uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
     /** Get the sector size at the defined address
      *
      *  Sector size might differ at address ranges.
@@ -162,6 +203,33 @@ private:
      */
     bool is_aligned_to_sector(uint32_t addr, uint32_t size);
 
+    /* Check that an erase starts and ends on sector boundaries in the flash */
+    bool is_valid_erase(uint32_t addr, uint32_t size);
+
+    /* Check that a program starts on a page boundary and ends in the flash */
+    bool is_valid_program(const void *buffer, uint32_t addr, uint32_t size);
+
+    /* Select the next block of a program, copying it to the page buffer if
+     * it is unaligned or shorter than a page
+     *
+     *  @return Number of bytes of buf the block holds
+     */
+    uint32_t program_chunk(const uint8_t *buf, uint32_t addr, uint32_t size,
+                           const uint8_t **prog_buf, uint32_t *prog_size);
+
+    int program_pages(const uint8_t *buf, uint32_t addr, uint32_t size, bool yield);
+    int erase_sectors(uint32_t addr, uint32_t size, bool yield);
+
+    /* Lock the mutex, waiting for any asynchronous operation to finish */
+    static void lock();
+    static void unlock();
+
+#if DEVICE_FLASH_ASYNCH
+    int start_async(const uint8_t *buf, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+    int start_async_step();
+    static void async_handler(uint32_t id, int32_t status);
+#endif
+
     flash_t _flash;
     uint8_t *_page_buf;
     static SingletonPtr<PlatformMutex> _mutex;
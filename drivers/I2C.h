@@ -31,6 +31,13 @@
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
 #include "platform/Callback.h"
+#include "platform/CircularBuffer.h"
+
+#if defined MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+#define TRANSACTION_QUEUE_SIZE_I2C MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+#else
+#define TRANSACTION_QUEUE_SIZE_I2C 0
+#endif
 #endif
 
 namespace mbed {
@@ -195,6 +202,15 @@ public:
      *
      * This function locks the deep sleep until any event has occurred
      *
+     * If another transfer is in progress, the transfer is put on a queue
+     * shared by all I2C objects and started from the interrupt handler once
+     * the bus is free. The queue holds TRANSACTION_QUEUE_SIZE_I2C transfers,
+     * set by the drivers.i2c-transaction-queue-size configuration option.
+     * The buffers must stay valid until the callback is called.
+     *
+     * A write-then-read sequence with a repeated start is a single transfer
+     * with both a TX and an RX buffer.
+     *
      * @param address   8/10 bit I2C slave address
      * @param tx_buffer The TX buffer with data to be transferred
      * @param tx_length The length of TX buffer in bytes
@@ -205,14 +221,23 @@ public:
      * @param repeated Repeated start, true - do not send stop at end
      *        default value is false.
      *
-     * @returns Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @returns Zero if the transfer has started or was queued, or -1 if I2C
+     *          peripheral is busy and the queue is full
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
-    /** Abort the ongoing I2C transfer
+    /** Abort the ongoing I2C transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
 
+    /** Clear the queue of transfers.
+     */
+    void clear_transfer_buffer();
+
+    /** Clear the queue of transfers and abort the on-going transfer.
+     */
+    void abort_all_transfers();
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Lock deep sleep only if it is not yet locked */
@@ -222,10 +247,41 @@ protected:
     void unlock_deep_sleep();
 
     void irq_handler_asynch(void);
+
+    /** Configure the callback and the peripheral, and initiate a new transfer.
+     */
+    void start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated);
+
     event_callback_t _callback;
     CThunk<I2C> _irq;
     DMAUsage _usage;
     bool _deep_sleep_locked;
+
+    /* Object whose transfer is in progress, if any */
+    static I2C *_transfer_owner;
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+    /** Pending transfer
+     */
+    struct queued_transfer_t {
+        I2C *obj;
+        int address;
+        const char *tx_buffer;
+        int tx_length;
+        char *rx_buffer;
+        int rx_length;
+        event_callback_t callback;
+        int event;
+        bool repeated;
+    };
+
+    /** Dequeue a transfer and start it if there was one pending.
+     */
+    static void dequeue_transaction();
+
+    /* Queue of pending transfers */
+    static SingletonPtr<CircularBuffer<queued_transfer_t, TRANSACTION_QUEUE_SIZE_I2C> > _transaction_buffer;
+#endif
 #endif
 #endif
 
@@ -23,10 +23,14 @@
 
 #include "hal/gpio_api.h"
 #include "hal/gpio_irq_api.h"
+#include "hal/ticker_api.h"
 #include "platform/Callback.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
+
+#include <chrono>
 
 namespace mbed {
 /**
@@ -127,6 +131,62 @@ public:
      */
     void disable_irq();
 
+#if DEVICE_USTICKER || defined(DOXYGEN_ONLY)
+    /** An edge recorded in capture mode
+     */
+    struct edge_t {
+        us_timestamp_t timestamp; /**< Time of the edge, as read from the us ticker */
+        bool rising;              /**< true for a rising edge, false for a falling edge */
+    };
+
+    /** Start recording edges into a buffer
+     *
+     *  Instead of calling a function for each edge, the interrupt handler
+     *  reads the us ticker and stores the time of the edge in a FIFO, to be
+     *  drained in batches with read_edges(). The timestamp is taken as soon
+     *  as the interrupt is handled, so it is not delayed by other callbacks.
+     *
+     *  If a debounce time is given, edges which come less than that time
+     *  after the last recorded edge are discarded in the interrupt handler.
+     *
+     *  Functions attached with rise() and fall() are still called. Deep sleep
+     *  is locked while capturing, as the us ticker stops in deep sleep.
+     *
+     *  @param buffer   Storage for the FIFO, which holds up to buffer.size() - 1
+     *                  edges. It must stay valid until capture_stop() is called.
+     *  @param rise     Record rising edges
+     *  @param fall     Record falling edges
+     *  @param debounce Minimum time between two recorded edges, or zero to
+     *                  record every edge
+     *
+     *  @note Edges are read by a single reader: read_edges() must not be
+     *        called from more than one context at once.
+     */
+    void capture(Span<edge_t> buffer, bool rise = true, bool fall = false,
+                 std::chrono::microseconds debounce = std::chrono::microseconds::zero());
+
+    /** Stop recording edges
+     *
+     *  Edges still in the FIFO are discarded.
+     */
+    void capture_stop();
+
+    /** Take recorded edges out of the FIFO
+     *
+     *  @param edges    Where to copy the edges, oldest first
+     *  @return         Number of edges copied, 0 if none were recorded
+     */
+    size_t read_edges(Span<edge_t> edges);
+
+    /** Number of edges lost because the FIFO was full
+     *
+     *  The count is reset when capture() is called.
+     *
+     *  @return         Number of edges dropped since capture started
+     */
+    uint32_t dropped_edges() const;
+#endif
+
     static void _irq_handler(uint32_t id, gpio_irq_event event);
 #if !defined(DOXYGEN_ONLY)
 protected:
@@ -136,6 +196,20 @@ protected:
     Callback<void()> _rise;
     Callback<void()> _fall;
 
+#if DEVICE_USTICKER
+    edge_t *_capture_buffer;
+    uint32_t _capture_size;
+    uint32_t _capture_head;
+    uint32_t _capture_tail;
+    uint32_t _capture_dropped;
+    uint32_t _capture_debounce;
+    us_timestamp_t _capture_last;
+    bool _capture_rise;
+    bool _capture_fall;
+
+    void capture_edge(gpio_irq_event event);
+#endif
+
     void irq_init(PinName pin);
 #endif
 };
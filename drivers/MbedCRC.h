@@ -28,6 +28,11 @@
 
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "platform/Callback.h"
+#if DEVICE_CRC_ASYNCH
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_thread.h"
+#endif
 
 #ifdef UNITTEST
 #include <type_traits>
@@ -46,6 +51,13 @@ namespace mbed {
 
 extern SingletonPtr<PlatformMutex> mbed_crc_mutex;
 
+#if DEVICE_CRC_ASYNCH
+/* State of the hardware CRC computation started by compute_async, if any */
+extern bool mbed_crc_async_active;
+extern Callback<void(uint32_t)> mbed_crc_async_callback;
+void mbed_crc_async_handler(void);
+#endif
+
 /** CRC mode selection
  */
 enum class CrcMode {
@@ -229,6 +241,24 @@ public:
         return crc_impl.compute(buffer, size, crc);
     }
 
+    /** Compute CRC for the data input without blocking
+     *
+     *  If the CRC is computed by a hardware module that can be fed by DMA, this
+     *  starts the computation and returns. The callback is then called from
+     *  interrupt context with the final CRC, and the buffer must stay valid
+     *  until then. Otherwise the CRC is computed in the calling thread and the
+     *  callback is called before this returns.
+     *
+     *  @param  buffer  Data bytes
+     *  @param  size  Size of data
+     *  @param  callback  Called with the final CRC value
+     *  @return  0 on success, negative error code on failure
+     */
+    int32_t compute_async(const void *buffer, crc_data_size_t size, Callback<void(uint32_t)> callback)
+    {
+        return crc_impl.compute_async(buffer, size, callback);
+    }
+
     /** Compute partial CRC for the data input.
      *
      *  CRC data if not available fully, CRC can be computed in parts with available data.
@@ -349,6 +379,35 @@ public:
         return status;
     }
 
+    /** Compute CRC for the data input without blocking
+     *
+     *  @param  buffer  Data bytes
+     *  @param  size  Size of data
+     *  @param  callback  Called with the final CRC value
+     *  @return  0 on success, negative error code on failure
+     */
+    int32_t compute_async(const void *buffer, crc_data_size_t size, Callback<void(uint32_t)> callback)
+    {
+#if DEVICE_CRC_ASYNCH
+        if (mode == CrcMode::HARDWARE) {
+            lock();
+            // Holds off other users of the hardware until the handler runs
+            core_util_atomic_store_bool(&mbed_crc_async_active, true);
+            mbed_crc_async_callback = callback;
+            hal_start();
+            hal_crc_compute_partial_asynch(static_cast<const uint8_t *>(buffer), size, mbed_crc_async_handler);
+            unlock();
+            return 0;
+        }
+#endif
+        uint32_t crc;
+        int32_t status = compute(buffer, size, &crc);
+        if (status == 0) {
+            callback(crc);
+        }
+        return status;
+    }
+
     /** Compute partial CRC for the data input.
      *
      *  CRC data if not available fully, CRC can be computed in parts with available data.
@@ -391,15 +450,7 @@ public:
 #if DEVICE_CRC
         if (mode == CrcMode::HARDWARE) {
             lock();
-            crc_mbed_config_t config;
-            config.polynomial  = polynomial;
-            config.width       = width;
-            config.initial_xor = _initial_value;
-            config.final_xor   = _final_xor;
-            config.reflect_in  = _reflect_data;
-            config.reflect_out = _reflect_remainder;
-
-            hal_crc_compute_partial_start(&config);
+            hal_start();
         }
 #endif
 
@@ -559,9 +610,31 @@ private:
                                           >>;
     // *INDENT-ON*
 
-#if MBED_CRC_TABLE_SIZE > 0
+#if MBED_CRC_TABLE_SIZE > 0 && MBED_CRC_TABLE_SIZE <= 256
     /* Tables only actually defined for mode == TABLE, and certain polynomials - see below */
     static const crc_table_t _crc_table[MBED_CRC_TABLE_SIZE];
+#elif MBED_CRC_TABLE_SIZE == 1024
+    /* Slice-by-4 tables, generated at compile time. Entry i of table k is the
+     * reflected CRC register after feeding byte i followed by k zero bytes.
+     */
+    struct crc_slice_table_t {
+        crc_table_t t[4][256];
+
+        constexpr crc_slice_table_t() : t()
+        {
+            for (unsigned int k = 0; k < 4; k++) {
+                for (unsigned int i = 0; i < 256; i++) {
+                    uint32_t p_crc = i;
+                    for (unsigned int bit = 0; bit < 8 * (k + 1); bit++) {
+                        p_crc = (p_crc & 1) ? (p_crc >> 1) ^ get_reflected_polynomial() : (p_crc >> 1);
+                    }
+                    t[k][i] = crc_table_t(p_crc);
+                }
+            }
+        }
+    };
+
+    static constexpr crc_slice_table_t _crc_slice_table{};
 #endif
 
     static constexpr uint32_t adjust_initial_value(uint32_t initial_xor, bool reflect_data)
@@ -588,10 +661,36 @@ private:
 #if DEVICE_CRC
         if (mode == CrcMode::HARDWARE) {
             mbed_crc_mutex->lock();
+#if DEVICE_CRC_ASYNCH
+            // The mutex can't be held across an asynchronous computation, as
+            // it completes in interrupt context - wait for it to finish
+            while (core_util_atomic_load_bool(&mbed_crc_async_active)) {
+                mbed_crc_mutex->unlock();
+                thread_sleep_for(1);
+                mbed_crc_mutex->lock();
+            }
+#endif
         }
 #endif
     }
 
+#if DEVICE_CRC
+    /** Configure the CRC hardware for a new computation.
+     */
+    void hal_start() const
+    {
+        crc_mbed_config_t config;
+        config.polynomial  = polynomial;
+        config.width       = width;
+        config.initial_xor = _initial_value;
+        config.final_xor   = _final_xor;
+        config.reflect_in  = _reflect_data;
+        config.reflect_out = _reflect_remainder;
+
+        hal_crc_compute_partial_start(&config);
+    }
+#endif
+
     /** Release exclusive access to CRC hardware/software.
      */
     static void unlock()
@@ -806,12 +905,33 @@ private:
         // Note the inversion because table and CRC are reflected - data must be
         bool reflect = !_reflect_data;
 
+#if MBED_CRC_TABLE_SIZE == 1024
+        const auto &t = _crc_slice_table.t;
+
+        // Fold four bytes into the register at once, then look up the
+        // contribution of each byte in the table for its distance from the end
+        for (; size >= 4; size -= 4, data += 4) {
+            uint_fast32_t d0 = data[0], d1 = data[1], d2 = data[2], d3 = data[3];
+            if (reflect) {
+                d0 = reflect_byte(d0);
+                d1 = reflect_byte(d1);
+                d2 = reflect_byte(d2);
+                d3 = reflect_byte(d3);
+            }
+            p_crc ^= d0 | (d1 << 8) | (d2 << 16) | (d3 << 24);
+            p_crc = t[3][p_crc & 0xFF] ^ t[2][(p_crc >> 8) & 0xFF] ^
+                    t[1][(p_crc >> 16) & 0xFF] ^ t[0][(p_crc >> 24) & 0xFF];
+        }
+#endif
+
         for (crc_data_size_t byte = 0; byte < size; byte++) {
             uint_fast32_t data_byte = data[byte];
             if (reflect) {
                 data_byte = reflect_byte(data_byte);
             }
-#if MBED_CRC_TABLE_SIZE == 16
+#if MBED_CRC_TABLE_SIZE == 1024
+            p_crc = t[0][(data_byte ^ p_crc) & 0xFF] ^ (p_crc >> 8);
+#elif MBED_CRC_TABLE_SIZE == 16
             p_crc = _crc_table[(data_byte ^ p_crc) & 0xF] ^ (p_crc >> 4);
             data_byte >>= 4;
             p_crc = _crc_table[(data_byte ^ p_crc) & 0xF] ^ (p_crc >> 4);
@@ -842,7 +962,10 @@ private:
 
 };
 
-#if MBED_CRC_TABLE_SIZE > 0
+#if MBED_CRC_TABLE_SIZE == 1024
+template <uint32_t polynomial, uint8_t width, CrcMode mode>
+constexpr typename MbedCRC<polynomial, width, mode>::crc_slice_table_t MbedCRC<polynomial, width, mode>::_crc_slice_table;
+#elif MBED_CRC_TABLE_SIZE > 0
 /* Declarations of the tables we provide. (Not strictly needed, but compilers
  * can warn if they see us using the template without a generic definition, so
  * let it know we have provided these specialisations.)
@@ -22,6 +22,7 @@
 #if DEVICE_PORTOUT || defined(DOXYGEN_ONLY)
 
 #include "hal/port_api.h"
+#include "hal/gpio_fast_api.h"
 
 namespace mbed {
 /**
@@ -71,7 +72,7 @@ public:
      */
     void write(int value)
     {
-        port_write(&_port, value);
+        port_write_fast(&_port, value);
     }
 
     /** Read the value currently output on the port
@@ -81,7 +82,7 @@ public:
      */
     int read()
     {
-        return port_read(&_port);
+        return port_read_fast(&_port);
     }
 
     /** A shorthand for write()
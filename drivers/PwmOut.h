@@ -21,6 +21,7 @@
 
 #if DEVICE_PWMOUT || defined(DOXYGEN_ONLY)
 #include "hal/pwmout_api.h"
+#include "platform/Callback.h"
 
 namespace mbed {
 /**
@@ -143,6 +144,34 @@ public:
      */
     void resume();
 
+#if DEVICE_PWMOUT_STREAM || defined(DOXYGEN_ONLY)
+    /** Get the PWM period in timer ticks, the unit of the stream values
+     *
+     *  @returns
+     *    The period in timer ticks
+     */
+    uint32_t period_ticks();
+
+    /** Stream pulsewidths from a buffer, a new one each period, loaded by DMA
+     *
+     *  The buffer is output in two halves: while one half is output, the
+     *  refill callback is called with the other so it can be filled with the
+     *  next values. The period must be set before streaming starts.
+     *
+     *  @param buffer Pulsewidths in timer ticks, see period_ticks()
+     *  @param length Number of values in the buffer, must be even
+     *  @param refill Called from interrupt context with the half of the buffer
+     *      that was just loaded and its length
+     *  @returns
+     *    true if streaming started, false if no DMA channel is available
+     */
+    bool stream_start(uint16_t *buffer, size_t length, Callback<void(uint16_t *, size_t)> refill);
+
+    /** Stop streaming, keeping the last pulsewidth output
+     */
+    void stream_stop();
+#endif
+
     /** A operator shorthand for write()
      *  \sa PwmOut::write()
      */
@@ -186,11 +215,20 @@ protected:
     /** Power down this instance */
     void deinit();
 
+#if DEVICE_PWMOUT_STREAM
+    static void stream_handler(pwmout_t *obj, uint32_t half, void *context);
+#endif
+
     pwmout_t _pwm;
     PinName _pin;
     bool _deep_sleep_locked;
     bool _initialized;
     float _duty_cycle;
+#if DEVICE_PWMOUT_STREAM
+    uint16_t *_stream_buffer;
+    size_t _stream_length;
+    Callback<void(uint16_t *, size_t)> _stream_refill;
+#endif
 #endif
 };
 
@@ -115,11 +115,37 @@ public:
     QSPI(const qspi_pinmap_t &pinmap, int mode = 0);
     QSPI(const qspi_pinmap_t &&, int = 0) = delete; // prevent passing of temporary objects
 
+#if DEVICE_QSPI_OCTAL || defined(DOXYGEN_ONLY)
+    /** Create a QSPI master connected to an octal memory
+     *
+     *  io0-io7 are the pins of the 8-line data bus, which commands use with QSPI_CFG_BUS_OCTAL
+     *
+     *  @param io0 1st IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io1 2nd IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io2 3rd IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io3 4th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io4 5th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io5 6th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io6 7th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param io7 8th IO pin used for sending/receiving data during data phase of a transaction
+     *  @param sclk QSPI Clock pin
+     *  @param ssel QSPI chip select pin
+     *  @param mode Clock polarity and phase mode (0 - 3) of SPI
+     *         (Default: Mode=0 uses CPOL=0, CPHA=0, Mode=1 uses CPOL=1, CPHA=1)
+     *
+     */
+    QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName io4, PinName io5, PinName io6, PinName io7,
+         PinName sclk, PinName ssel = NC, int mode = 0);
+#endif
+
     virtual ~QSPI()
     {
     }
 
     /** Configure the data transmission format
+     *
+     *  QSPI_CFG_BUS_OCTAL is also valid for any phase on targets with DEVICE_QSPI_OCTAL, when the object was
+     *  created with the 8 data pins.
      *
      *  @param inst_width Bus width used by instruction phase(Valid values are QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_DUAL, QSPI_CFG_BUS_QUAD)
      *  @param address_width Bus width used by address phase(Valid values are QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_DUAL, QSPI_CFG_BUS_QUAD)
@@ -129,6 +155,9 @@ public:
      *  @param data_width Bus width used by data phase(Valid values are QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_DUAL, QSPI_CFG_BUS_QUAD)
      *  @param dummy_cycles Number of dummy clock cycles to be used after alt phase
      *
+     *  @returns
+     *    Returns QSPI_STATUS_OK on success, QSPI_STATUS_INVALID_PARAMETER if a bus width is not supported
+     *    and QSPI_STATUS_ERROR if alt_size does not fit alt_width.
      */
     qspi_status_t configure_format(qspi_bus_width_t inst_width,
                                    qspi_bus_width_t address_width,
@@ -138,6 +167,21 @@ public:
                                    qspi_bus_width_t data_width,
                                    int dummy_cycles);
 
+    /** Configure double transfer rate (DTR) for the phases of the following transactions
+     *
+     *  A phase in DTR mode transfers on both clock edges. The alt phase follows the address phase, and the
+     *  dummy cycles are still counted in clock cycles. Formats set with configure_format() keep these settings.
+     *
+     *  @param inst_dtr Use DTR for the instruction phase
+     *  @param address_dtr Use DTR for the address and alt phases
+     *  @param data_dtr Use DTR for the data phase
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_OK on success, QSPI_STATUS_INVALID_PARAMETER if DTR is requested on a target without
+     *    DEVICE_QSPI_DTR.
+     */
+    qspi_status_t configure_dtr(bool inst_dtr, bool address_dtr, bool data_dtr);
+
     /** Set the qspi bus clock frequency
      *
      *  @param hz SCLK frequency in hz (default = 1MHz)
@@ -208,6 +252,34 @@ public:
      */
     qspi_status_t command_transfer(qspi_inst_t instruction, int address, const char *tx_buffer, size_t tx_length, const char *rx_buffer, size_t rx_length);
 
+#if DEVICE_QSPI_MEMORY_MAPPED || defined(DOXYGEN_ONLY)
+    /** Map the peripheral into the address space for reading
+     *
+     *  In memory-mapped mode, the QSPI controller issues the read instruction
+     *  whenever the CPU reads from the mapped region, so the memory can be read
+     *  in place, like internal flash. The current format is used for the read.
+     *
+     *  Memory-mapped mode is left by unmap(), or by any other read, write or
+     *  command on the bus, after which the mapping can't be accessed.
+     *
+     *  @param instruction Read instruction to be used when the region is accessed
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param base On return, start of the mapped region, which maps peripheral address 0
+     *  @param size On return, size of the mapped region in bytes
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS if the peripheral was mapped, QSPI_STATUS_ERROR otherwise
+     */
+    qspi_status_t map(qspi_inst_t instruction, int alt, const void **base, size_t *size);
+
+    /** Leave memory-mapped mode
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success, QSPI_STATUS_ERROR otherwise
+     */
+    qspi_status_t unmap();
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Acquire exclusive access to this SPI bus
@@ -229,22 +301,37 @@ protected:
     qspi_bus_width_t _alt_width; //Bus width for Alt phase
     qspi_alt_size_t _alt_size;
     qspi_bus_width_t _data_width; //Bus width for Data phase
+    bool _inst_dtr; //Instruction phase on both clock edges
+    bool _address_dtr; //Address and Alt phases on both clock edges
+    bool _data_dtr; //Data phase on both clock edges
     qspi_command_t _qspi_command; //QSPI Hal command struct
     unsigned int _num_dummy_cycles; //Number of dummy cycles to be used
     int _hz; //Bus Frequency
     int _mode; //SPI mode
     bool _initialized;
     PinName _qspi_io0, _qspi_io1, _qspi_io2, _qspi_io3, _qspi_clk, _qspi_cs; //IO lines, clock and chip select
+#if DEVICE_QSPI_OCTAL
+    PinName _qspi_io4, _qspi_io5, _qspi_io6, _qspi_io7; //Upper IO lines of an octal bus, NC for quad
+#endif
     const qspi_pinmap_t *_static_pinmap;
     bool (QSPI::* _init_func)(void);
+#if DEVICE_QSPI_MEMORY_MAPPED
+    static bool _mapped; //The owner is in memory-mapped mode
+#endif
 
 private:
     /* Private acquire function without locking/unlocking
      * Implemented in order to avoid duplicate locking and boost performance
      */
     bool _acquire(void);
+#if DEVICE_QSPI_MEMORY_MAPPED
+    void _unmap(void);
+#endif
     bool _initialize();
     bool _initialize_direct();
+#if DEVICE_QSPI_OCTAL
+    bool _initialize_octal();
+#endif
 
     /*
      * This function builds the qspi command struct to be send to Hal
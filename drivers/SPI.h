@@ -54,6 +54,25 @@ namespace mbed {
 struct use_gpio_ssel_t { };
 const use_gpio_ssel_t use_gpio_ssel;
 
+#if DEVICE_SPI_ASYNCH
+/** One segment of a batched non-blocking transfer, see SPI::transfer_batch()
+ */
+struct spi_batch_segment_t {
+    /** The TX buffer, or NULL to send the default SPI value */
+    const void *tx_buffer;
+    /** The length of the TX buffer in bytes */
+    int tx_length;
+    /** The RX buffer, or NULL to ignore received data */
+    void *rx_buffer;
+    /** The length of the RX buffer in bytes */
+    int rx_length;
+    /** The buffers element width in bits (8, 16 or 32) */
+    unsigned char bit_width;
+    /** Pulse the Slave Select line after this segment, before the next one starts */
+    bool deselect_after;
+};
+#endif
+
 /** A SPI Master, used for communicating with SPI slave devices.
  *
  * The default format is set to 8-bits, mode 0, and a clock frequency of 1MHz.
@@ -242,6 +261,9 @@ public:
      *
      * This function locks the deep sleep until any event has occurred.
      *
+     * If the transfer is started between select() and deselect(), the
+     * Slave Select line stays asserted when the transfer ends.
+     *
      * @param tx_buffer The TX buffer with data to be transferred. If NULL is passed,
      *                  the default SPI value is sent.
      * @param tx_length The length of TX buffer in bytes.
@@ -265,6 +287,30 @@ public:
         return 0;
     }
 
+    /** Start a batch of non-blocking SPI transfers as a single job.
+     *
+     * The segments are run back to back from the interrupt handler, without
+     * re-acquiring the peripheral or releasing the Slave Select line between
+     * them, unless a segment asks for it with deselect_after. The callback is
+     * called once, when the last segment completes or when any segment fails.
+     *
+     * This function locks the deep sleep until any event has occurred.
+     *
+     * @note The Slave Select line can only be pulsed between segments if
+     *       use_gpio_ssel was passed to the constructor.
+     *
+     * @param segments  The segments to transfer. The array and the buffers it
+     *                  refers to must stay valid until the callback is called.
+     * @param count     The number of segments, must be greater than zero.
+     * @param callback  The event callback function.
+     * @param event     The event mask of events to modify. @see spi_api.h for SPI events.
+     *
+     * @return Operation result.
+     * @retval 0 If the transfer has started.
+     * @retval -1 If SPI peripheral is busy.
+     */
+    int transfer_batch(const spi_batch_segment_t *segments, size_t count, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE);
+
     /** Abort the on-going SPI transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
@@ -351,6 +397,9 @@ private:
     /** Unlock deep sleep in case it is locked */
     void unlock_deep_sleep();
 
+    /** Start the next segment of the current batch */
+    void start_batch_segment();
+
 
 #if TRANSACTION_QUEUE_SIZE_SPI
     /** Start a new transaction.
@@ -416,6 +465,11 @@ protected:
     DMAUsage _usage;
     /* Current sate of the sleep manager */
     bool _deep_sleep_locked;
+    /* Remaining segments of the current batch, the first one is in progress */
+    const spi_batch_segment_t *_batch;
+    size_t _batch_count;
+    /* Event mask of the current batch */
+    int _batch_event;
 #endif // DEVICE_SPI_ASYNCH
 
     // Configuration.
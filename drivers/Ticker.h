@@ -125,6 +125,20 @@ public:
      */
     void detach();
 
+    /** Set how late the callback may be called
+     *
+     *  When the callback is attached, it is moved to the time of another
+     *  event already pending on the same ticker if that event is due no
+     *  more than @a slack later. This lets several timers share a single
+     *  interrupt, and allows the system to stay asleep for longer.
+     *
+     *  For a Ticker only the first call is affected; once running, calls
+     *  follow each other at the interval given to attach().
+     *
+     *  @param slack how late the callback may be called, 0 by default
+     */
+    void set_slack(std::chrono::microseconds slack);
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     TickerBase(const ticker_data_t *data);
@@ -150,6 +164,7 @@ protected:
 
     void handler() override;
     std::chrono::microseconds  _delay{0};  /**< Time delay (in microseconds) for resetting the multishot callback. */
+    std::chrono::microseconds  _slack{0};  /**< How late the callback may be called when attached. */
     Callback<void()>    _function;  /**< Callback. */
     bool          _lock_deepsleep;  /**< Flag which indicates if deep sleep should be disabled. */
 #endif
@@ -98,6 +98,22 @@ public:
         ticker_insert_event_us(_ticker, obj, timestamp.time_since_epoch().count(), id);
     }
 
+    /** Insert an event to the queue, allowing it to share an interrupt with a later event
+     *
+     * If an event already in the queue is due no more than slack after
+     * timestamp, the event is inserted with that event's timestamp instead.
+     *
+     * @param obj       The event object to be inserted to the queue
+     * @param timestamp The event's timestamp
+     * @param slack     How late the event may be executed
+     * @param id        The event object
+     * @return The timestamp the event was inserted with
+     */
+    time_point insert_event_coalesced(ticker_event_t *obj, time_point timestamp, duration slack, uint32_t id)
+    {
+        return time_point(duration(ticker_insert_event_us_coalesced(_ticker, obj, timestamp.time_since_epoch().count(), slack.count(), id)));
+    }
+
     /** Read the current (absolute) ticker's timestamp
      *
      * @warning Return an absolute timestamp counting from the initialization of the
@@ -104,6 +104,22 @@ protected:
      */
     void insert_absolute(TickerDataClock::time_point timestamp);
 
+    /** Set absolute timestamp of the internal event, allowing it to be late.
+     *
+     * If another event on the same ticker is already due no more than
+     * @a slack after @a timestamp, the event is moved to that event's time,
+     * so that a single interrupt serves both.
+     *
+     * @param   timestamp   event's us timestamp
+     * @param   slack       how late the event may be handled
+     * @return  the timestamp the event was scheduled for
+     *
+     * @warning
+     * Do not insert more than one timestamp.
+     * The same @a event object is used for every @a insert/insert_absolute call.
+     */
+    TickerDataClock::time_point insert_absolute(TickerDataClock::time_point timestamp, std::chrono::microseconds slack);
+
     /** Remove timestamp.
      */
     void remove();
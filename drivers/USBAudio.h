@@ -167,6 +167,18 @@ public:
      */
     uint32_t read_overflows(bool clear = false);
 
+    /**
+     * Return the rate the host is asked to send audio data at
+     *
+     * With drivers.usb-audio-feedback enabled the speaker runs in asynchronous
+     * mode. The rate follows the drift between the host clock and the rate
+     * the application reads at, estimated from the fill level of the receive
+     * buffer, so the buffer neither overflows nor runs dry.
+     *
+     * @return Sample rate in Hz, the nominal rate if feedback is disabled
+     */
+    float read_feedback_rate();
+
     /**
      * Check if the audio read channel is open
      *
@@ -288,6 +300,9 @@ private:
 
     void _receive_change(ChannelState new_state);
     void _receive_isr();
+    void _feedback_update();
+    void _feedback_isr_start();
+    void _feedback_isr();
     void _send_change(ChannelState new_state);
     void _send_isr_start();
     void _send_isr_next_sync();
@@ -371,13 +386,26 @@ private:
     // endpoint numbers
     usb_ep_t _episo_out;    // rx endpoint
     usb_ep_t _episo_in;     // tx endpoint
+    usb_ep_t _episo_feedback;   // rx feedback endpoint
+
+    // Feedback reported to the host, frames per millisecond in 10.14 format
+    uint32_t _feedback_nominal;
+    uint32_t _feedback;
+    // Average fill level of the receive buffer in 1/256 frames
+    int32_t _rx_fill_avg;
+    bool _feedback_busy;
+    uint8_t _feedback_buf[3];
 
     // channel config in the configuration descriptor: master, left, right
     uint16_t _channel_config_rx;
     uint16_t _channel_config_tx;
 
     // configuration descriptor
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+    uint8_t _config_descriptor[192];
+#else
     uint8_t _config_descriptor[183];
+#endif
 
     // buffer for control requests
     uint8_t _control_receive[2];
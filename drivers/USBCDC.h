@@ -24,6 +24,7 @@
 
 #include "USBDevice.h"
 #include "OperationList.h"
+#include "platform/Span.h"
 
 class AsyncOp;
 
@@ -91,7 +92,9 @@ public:
     /*
     * Send a buffer
     *
-    * This function blocks until the full contents have been sent.
+    * This function blocks until the full contents have been sent. Whole
+    * packets are sent straight from the buffer, as many per transfer as
+    * the USB phy supports, so large buffers go out at the bus speed.
     *
     * @param buffer buffer to be sent
     * @param size length of the buffer
@@ -132,6 +135,25 @@ public:
      */
     void receive_nb(uint8_t *buffer, uint32_t size, uint32_t *actual);
 
+    /**
+     * Access the receive buffer without copying
+     *
+     * The data stays valid until it is consumed with receive_consume(),
+     * or the terminal disconnects.
+     *
+     * @return the data received and not read yet, empty if there is none
+     */
+    mbed::Span<const uint8_t> receive_span();
+
+    /**
+     * Release data read through receive_span()
+     *
+     * Once the whole span is consumed the next data is received.
+     *
+     * @param size number of bytes read from the start of the span
+     */
+    void receive_consume(uint32_t size);
+
 protected:
     /*
     * Get device descriptor. Warning: this method has to store the length of the report descriptor in reportLength.
@@ -200,6 +222,7 @@ protected:
 
     void _change_terminal_connected(bool connected);
 
+    void _send_in_place(uint8_t *buffer, uint32_t size, uint32_t *actual);
     void _send_isr_start();
     void _send_isr();
 
@@ -219,13 +242,13 @@ protected:
 
     OperationList<AsyncWrite> _tx_list;
     bool _tx_in_progress;
-    uint8_t _tx_buffer[64];
+    uint8_t _tx_buffer[MBED_CONF_DRIVERS_USB_CDC_BUFFER_SIZE];
     uint8_t *_tx_buf;
     uint32_t _tx_size;
 
     OperationList<AsyncRead> _rx_list;
     bool _rx_in_progress;
-    uint8_t _rx_buffer[64];
+    uint8_t _rx_buffer[MBED_CONF_DRIVERS_USB_CDC_BUFFER_SIZE];
     uint8_t *_rx_buf;
     uint32_t _rx_size;
 };
@@ -113,6 +113,20 @@ public:
     */
     bool send(uint8_t *buffer, uint32_t size);
 
+    /**
+    * Send an ethernet frame held in several buffers
+    *
+    * This function blocks until the full frame has been sent. Whole packets
+    * are sent straight from the buffers, only packets that span two buffers
+    * and the final short packet are copied.
+    *
+    * @param buffers buffers holding the frame, in order
+    * @param sizes length of each buffer
+    * @param count number of buffers
+    * @returns true if successful false if interrupted due to a state change
+    */
+    bool send(uint8_t *const *buffers, const uint32_t *sizes, uint32_t count);
+
     /**
      * Read from the receive buffer
      *
@@ -122,6 +136,30 @@ public:
      */
     void receive_nb(uint8_t *buffer, uint32_t size, uint32_t *actual);
 
+    /**
+     * Receive the next ethernet frame straight into a buffer
+     *
+     * Once called, frames are no longer copied to the receive buffer read by
+     * receive_nb(). Reception pauses after each frame, until the next call
+     * supplies a new buffer. Frames that don't fit in the buffer are dropped.
+     *
+     * @param buffer buffer to receive the frame into
+     * @param size size of the buffer, must be a multiple of the packet size
+     * @param done called with the frame length once the frame is received
+     * @returns true if started, false if a buffer is already in use
+     *
+     * Warning: done is called in ISR context
+     */
+    bool receive_start(uint8_t *buffer, uint32_t size, mbed::Callback<void(uint32_t)> done);
+
+    /**
+     * Stop receiving frames into buffers
+     *
+     * Aborts the frame being received into the buffer given to receive_start(),
+     * and goes back to the receive buffer read by receive_nb().
+     */
+    void receive_stop();
+
     /**
      * Return ethernet packet filter bitmap
      *
@@ -254,6 +292,7 @@ private:
     uint8_t _string_imac_addr[26];
 
     uint8_t _bulk_buf[MAX_PACKET_SIZE_BULK];
+    uint8_t _tx_buf[MAX_PACKET_SIZE_BULK];
     uint16_t _packet_filter;
     ByteBuffer _rx_queue;
 
@@ -265,10 +304,24 @@ private:
     mbed::Callback<void()> _callback_rx;
     mbed::Callback<void()> _callback_filter;
 
+    // Frame reception into the buffer given to receive_start()
+    uint8_t *_rx_buf;
+    uint32_t _rx_size;
+    uint32_t _rx_len;
+    uint8_t *_rx_pos;
+    uint32_t _rx_requested;
+    mbed::Callback<void(uint32_t)> _rx_done;
+    bool _rx_direct;
+    bool _rx_dropping;
+    bool _rx_active;
+    bool _rx_reading;
+
     void _init();
     void _int_callback();
     void _bulk_in_callback();
     void _bulk_out_callback();
+    void _read_next();
+    void _receive_direct(uint32_t size);
     bool _notify_network_connection(uint8_t value);
     bool _notify_connection_speed_change(uint32_t up, uint32_t down);
     bool _write_bulk(uint8_t *buffer, uint32_t size);
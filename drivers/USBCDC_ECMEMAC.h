@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USBCDC_ECMEMAC_H
+#define USBCDC_ECMEMAC_H
+
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CONF_NSAPI_PRESENT)
+#include "USBCDC_ECM.h"
+#include "EMAC.h"
+#include "EMACMemoryManager.h"
+#include "EventFlags.h"
+#include "Thread.h"
+
+#define USBCDC_ECMEMAC_RX_BUFFERS   (2)
+
+/**
+ * \defgroup drivers_USBCDC_ECMEMAC USBCDC_ECMEMAC class
+ * \ingroup drivers-public-api-usb
+ * @{
+ * @note Bare metal profile: This class is not supported.
+ */
+
+/**
+ * EMAC driver running over a USBCDC_ECM device
+ *
+ * Lets a network stack use the USB link to the host as an ethernet interface.
+ * Frames are received straight into network stack buffers, and sent from the
+ * network stack buffer chains without flattening them first.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ * #include "USBCDC_ECMEMAC.h"
+ *
+ * USBCDC_ECM ecm(false);
+ * USBCDC_ECMEMAC emac(ecm);
+ * EthernetInterface net(emac, OnboardNetworkStack::get_default_instance());
+ *
+ * int main() {
+ *     ecm.connect();
+ *     net.connect();
+ * }
+ * @endcode
+ */
+class USBCDC_ECMEMAC : public EMAC {
+public:
+
+    /**
+     * Create an EMAC driver for a USBCDC_ECM device
+     *
+     * Frames stop going to USBCDC_ECM::receive_nb() while the driver is powered up.
+     *
+     * @param ecm USBCDC_ECM device to send and receive the frames with
+     */
+    USBCDC_ECMEMAC(USBCDC_ECM &ecm);
+
+    virtual ~USBCDC_ECMEMAC();
+
+    virtual uint32_t get_mtu_size() const;
+    virtual uint32_t get_align_preference() const;
+    virtual void get_ifname(char *name, uint8_t size) const;
+    virtual uint8_t get_hwaddr_size() const;
+    virtual bool get_hwaddr(uint8_t *addr) const;
+    virtual void set_hwaddr(const uint8_t *addr);
+    virtual bool link_out(emac_mem_buf_t *buf);
+    virtual bool power_up();
+    virtual void power_down();
+    virtual void set_link_input_cb(emac_link_input_cb_t input_cb);
+    virtual void set_link_state_cb(emac_link_state_change_cb_t state_cb);
+    virtual void add_multicast_group(const uint8_t *address);
+    virtual void remove_multicast_group(const uint8_t *address);
+    virtual void set_all_multicast(bool all);
+    virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
+
+private:
+    enum rx_state_t {
+        RX_EMPTY,       // No buffer in the slot
+        RX_READY,       // Buffer waiting for its turn to receive
+        RX_RECEIVING,   // Buffer given to USBCDC_ECM::receive_start()
+        RX_DONE         // Frame received, waiting for the thread
+    };
+
+    USBCDC_ECM &_ecm;
+    EMACMemoryManager *_memory_manager;
+    emac_link_input_cb_t _input_cb;
+    emac_link_state_change_cb_t _state_cb;
+    uint8_t _hwaddr[6];
+    bool _link_up;
+
+    emac_mem_buf_t *_rx_slots[USBCDC_ECMEMAC_RX_BUFFERS];
+    EMACRxRing _rx_ring;
+    uint8_t *_rx_ptr[USBCDC_ECMEMAC_RX_BUFFERS];
+    volatile rx_state_t _rx_state[USBCDC_ECMEMAC_RX_BUFFERS];
+    volatile uint32_t _rx_length[USBCDC_ECMEMAC_RX_BUFFERS];
+    uint32_t _rx_receiving;
+    uint32_t _rx_take;
+
+    rtos::EventFlags _flags;
+    rtos::Thread *_thread;
+
+    void _thread_main();
+    void _receive();
+    void _rx_post(uint32_t idx, void *ptr);
+    void _rx_start(uint32_t idx);
+    void _rx_done(uint32_t length);
+};
+
+/** @}*/
+#endif // defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CONF_NSAPI_PRESENT)
+#endif
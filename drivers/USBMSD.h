@@ -242,6 +242,18 @@ private:
     // cache in RAM before writing in memory. Useful also to read a block.
     uint8_t *_page;
 
+    // Buffers of the block cache, the second one is only used with
+    // drivers.usb-msd-double-buffer so storage and USB work in parallel
+    struct cache_t {
+        uint8_t *data;
+        uint32_t block;
+        uint32_t count;
+    };
+    cache_t _cache[2];
+    uint32_t _cache_blocks;
+    uint8_t _cache_current;
+    int8_t _cache_pending;
+
     int _block_size;
     uint64_t _memory_size;
     uint64_t _block_count;
@@ -251,6 +263,7 @@ private:
     usb_ep_t _bulk_out;
     uint8_t _bulk_in_buf[64];
     uint8_t _bulk_out_buf[64];
+    uint8_t *_bulk_out_data;
     bool _out_ready;
     bool _in_ready;
     uint32_t _bulk_out_size;
@@ -292,6 +305,12 @@ private:
     void _process();
     void _write_next(uint8_t *data, uint32_t size);
     void _read_next();
+    uint32_t _transfer_size(usb_ep_t endpoint, uint32_t space);
+    cache_t *_cache_find(uint32_t addr);
+    void _cache_setup(cache_t *cache, uint32_t addr);
+    uint8_t *_cache_write_position(uint32_t *space);
+    void _cache_write(cache_t *cache);
+    void _cache_flush();
 
     void CBWDecode(uint8_t *buf, uint16_t size);
     void sendCSW(void);
@@ -108,6 +108,18 @@ public:
     */
     virtual int _getc();
 
+    /**
+    * Write a buffer: blocking
+    *
+    * Sends the whole buffer at once rather than a character at a time,
+    * see USBCDC::send()
+    *
+    * @param buffer data to be sent
+    * @param size number of bytes to send
+    * @returns number of bytes sent, 0 if the terminal disconnected
+    */
+    virtual ssize_t write(const void *buffer, size_t size);
+
     /**
     * Check the number of bytes available.
     *
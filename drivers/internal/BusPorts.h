@@ -0,0 +1,97 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BUSPORTS_H
+#define MBED_BUSPORTS_H
+
+#include "platform/platform.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+#include "hal/port_api.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+namespace internal {
+
+/**
+ * \defgroup drivers_BusPorts BusPorts class
+ * \ingroup drivers-internal-api
+ * @{
+ */
+
+/** Port access for the pins of a bus
+ *
+ * Groups the pins of a BusIn, BusOut or BusInOut by port, so a bus value
+ * can be written or read with one port operation per port instead of one
+ * GPIO operation per pin. Only ports shared by two or more pins of the bus
+ * are grouped, the remaining pins carry on being accessed one by one.
+ *
+ * Grouping needs the target to implement port_pin_info().
+ */
+class BusPorts : private NonCopyable<BusPorts> {
+public:
+    BusPorts();
+    ~BusPorts();
+
+    /** Group the pins of a bus by port
+     *
+     *  @param pins Pins of the bus, NC for unused bits
+     *  @param dir  Direction to initialize the ports with
+     */
+    void init(const PinName pins[16], PinDirection dir);
+
+    /** Bus bits accessed through a port
+     *
+     *  @return Mask of the bus bits handled by write() and read(), the other
+     *          bits must be accessed pin by pin
+     */
+    int mask() const
+    {
+        return _mask;
+    }
+
+    /** Write the grouped bits of a bus value
+     *
+     *  All ports are written in one critical section, so ISRs writing other
+     *  pins of the same ports are not overwritten.
+     *
+     *  @param value Bus value, bits outside mask() are ignored
+     */
+    void write(int value);
+
+    /** Read the grouped bits of a bus value
+     *
+     *  @return Bus value, bits outside mask() are 0
+     */
+    int read();
+
+private:
+    port_t *_ports;
+    int _count;
+    int _mask;
+    uint8_t _port[16];
+    uint8_t _bit[16];
+};
+
+/** @}*/
+
+} // namespace internal
+} // namespace mbed
+
+#endif
+
+#endif
@@ -86,7 +86,7 @@ public:
 private:
 
     usb_ep_t index_to_endpoint(int index);
-    int next_index(usb_ep_type_t type, bool in_not_out);
+    int next_index(usb_ep_type_t type, bool in_not_out, usb_ep_attr_t required);
 
     const usb_ep_table_t *_table;
     uint32_t _cost;
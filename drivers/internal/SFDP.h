@@ -21,7 +21,7 @@
 #include <cstddef>
 #include <cstdint>
 #include "features/storage/blockdevice/BlockDevice.h"
-#include "platform/Callback.h"
+#include "platform/FunctionRef.h"
 
 namespace mbed {
 
@@ -68,10 +68,19 @@ struct sfdp_smptbl_info {
     unsigned int erase_type_size_arr[SFDP_MAX_NUM_OF_ERASE_TYPES]; ///< Erase sizes for all different erase types
 };
 
+/** JEDEC xSPI Profile 1.0 Table info */
+struct sfdp_xspi_info {
+    uint32_t addr; ///< Address
+    size_t size; ///< Size
+    int read_8d8d8d_inst; ///< 8D-8D-8D Fast Read instruction, -1 if not supported
+    int read_8d8d8d_dummy_cycles; ///< Dummy cycles of the 8D-8D-8D Fast Read at the highest listed frequency
+};
+
 /** SFDP JEDEC Parameter Table info */
 struct sfdp_hdr_info {
     sfdp_bptbl_info bptbl;
     sfdp_smptbl_info smptbl;
+    sfdp_xspi_info xspi;
 };
 
 /** Parse SFDP Database
@@ -84,7 +93,7 @@ struct sfdp_hdr_info {
  *
  * @return MBED_SUCCESS on success, negative error code on failure
  */
-int sfdp_parse_headers(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
+int sfdp_parse_headers(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
 
 /** Parse Sector Map Parameter Table
  * Retrieves the table from a device and parses the information contained by the table
@@ -94,7 +103,19 @@ int sfdp_parse_headers(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
  *
  * @return MBED_SUCCESS on success, negative error code on failure
  */
-int sfdp_parse_sector_map_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
+int sfdp_parse_sector_map_table(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
+
+/** Parse xSPI Profile 1.0 Parameter Table
+ * Retrieves the table from a device and parses the 8D-8D-8D read command it describes
+ *
+ * Without the table, the read is reported as not supported.
+ *
+ * @param      sfdp_reader Callback function used to read headers from within a device
+ * @param[out] sfdp_info   Contains the results of parsing the JEDEC xSPI Profile 1.0 Table
+ *
+ * @return MBED_SUCCESS on success, negative error code on failure
+ */
+int sfdp_parse_xspi_profile_table(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
 
 /** Detect page size used for writing on flash
  *
@@ -125,11 +146,13 @@ int sfdp_find_addr_region(bd_size_t offset, const sfdp_hdr_info &sfdp_info);
 
 /** Finds the largest Erase Type of the Region to which the offset belongs to
  *
- * Iterates from highest type to lowest.
+ * The chosen type is supported by the region, starts at offset, is no larger
+ * than size and does not cross the end of the region. If none qualifies,
+ * the smallest type supported by the region is returned.
  *
  * @param bitfield Erase types bit field
  * @param size     Upper limit for region size
- * @param offset   Offset value
+ * @param offset   Offset value, the start of the unit to erase
  * @param region   Region number
  * @param smptbl   Information about different erase types
  *
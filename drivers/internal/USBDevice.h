@@ -210,6 +210,17 @@ public:
      */
     uint32_t endpoint_max_packet_size(usb_ep_t endpoint);
 
+    /**
+     * Get the largest transfer for this endpoint
+     *
+     * Return the largest size read_start and write_start move in one
+     * transfer. This is a multiple of the max packet size when the USB PHY
+     * supports multi-packet transfers on this endpoint, otherwise it is the
+     * max packet size.
+     * @note This endpoint must already have been setup with endpoint_add
+     */
+    uint32_t endpoint_max_transfer_size(usb_ep_t endpoint);
+
     /**
      * Abort the current transfer on this endpoint
      *
@@ -227,7 +238,9 @@ public:
      * @param endpoint endpoint to read data from
      * @param buffer buffer to fill with read data
      * @param size The size of data to read. This must be greater than or equal
-     *        to the max packet size for this endpoint
+     *        to the max packet size for this endpoint. Up to
+     *        endpoint_max_transfer_size bytes are read, the read completes
+     *        early when a short packet is received.
      * @return true if the read was completed, otherwise false
      * @note This endpoint must already have been setup with endpoint_add
      */
@@ -249,8 +262,8 @@ public:
      *
      * @param endpoint endpoint to write data to
      * @param buffer data to write
-     * @param size the size of data to send. This must be less than or equal to the
-     * max packet size of this endpoint
+     * @param size the size of data to send. This must be less than or equal to
+     * endpoint_max_transfer_size for this endpoint
      * @note This endpoint must already have been setup with endpoint_add
      */
     bool write_start(usb_ep_t endpoint, uint8_t *buffer, uint32_t size);
@@ -550,7 +563,8 @@ private:
     struct endpoint_info_t {
         mbed::Callback<void()> callback;
         uint16_t max_packet_size;
-        uint16_t transfer_size;
+        uint32_t max_transfer_size;
+        uint32_t transfer_size;
         uint8_t flags;
         uint8_t pending;
     };
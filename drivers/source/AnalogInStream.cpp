@@ -0,0 +1,96 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/AnalogInStream.h"
+
+#if DEVICE_ANALOGIN_ASYNCH
+
+#include "platform/mbed_power_mgmt.h"
+
+namespace mbed {
+
+SingletonPtr<PlatformMutex> AnalogInStream::_mutex;
+
+AnalogInStream::AnalogInStream(PinName pin) : _active(false)
+{
+    lock();
+    analogin_init(&_adc, pin);
+    unlock();
+}
+
+AnalogInStream::AnalogInStream(const PinMap &pinmap) : _active(false)
+{
+    lock();
+    analogin_init_direct(&_adc, &pinmap);
+    unlock();
+}
+
+AnalogInStream::~AnalogInStream()
+{
+    stop();
+    lock();
+    analogin_free(&_adc);
+    unlock();
+}
+
+int AnalogInStream::start(Span<uint16_t> buffer, uint32_t sample_rate, Callback<void(Span<const uint16_t>)> callback)
+{
+    size_t count = buffer.size() / 2;
+    if (count == 0 || sample_rate == 0) {
+        return -1;
+    }
+
+    lock();
+    if (_active) {
+        unlock();
+        return -1;
+    }
+
+    _callback = callback;
+    sleep_manager_lock_deep_sleep();
+    if (analogin_stream_start(&_adc, buffer.data(), count, sample_rate, &AnalogInStream::_irq_handler, (uint32_t)this) != 0) {
+        sleep_manager_unlock_deep_sleep();
+        unlock();
+        return -1;
+    }
+    _active = true;
+    unlock();
+    return 0;
+}
+
+void AnalogInStream::stop()
+{
+    lock();
+    if (_active) {
+        analogin_stream_stop(&_adc);
+        sleep_manager_unlock_deep_sleep();
+        _active = false;
+    }
+    unlock();
+}
+
+void AnalogInStream::_irq_handler(uint32_t id, const uint16_t *samples, size_t count)
+{
+    AnalogInStream *handler = (AnalogInStream *)id;
+    if (handler->_callback) {
+        handler->_callback(Span<const uint16_t>(samples, count));
+    }
+}
+
+} // namespace mbed
+
+#endif
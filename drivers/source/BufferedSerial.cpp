@@ -20,6 +20,7 @@
 
 #include "platform/mbed_poll.h"
 #include "platform/mbed_thread.h"
+#include <algorithm>
 
 namespace mbed {
 
@@ -27,12 +28,18 @@ BufferedSerial::BufferedSerial(PinName tx, PinName rx, int baud):
     SerialBase(tx, rx, baud)
 {
     enable_rx_irq();
+#if BUFFERED_SERIAL_DMA
+    start_rx_dma();
+#endif
 }
 
 BufferedSerial::BufferedSerial(const serial_pinmap_t &static_pinmap, int baud):
     SerialBase(static_pinmap, baud)
 {
     enable_rx_irq();
+#if BUFFERED_SERIAL_DMA
+    start_rx_dma();
+#endif
 }
 
 BufferedSerial::~BufferedSerial()
@@ -105,7 +112,7 @@ int BufferedSerial::sync()
 {
     api_lock();
 
-    while (!_txbuf.empty()) {
+    while (tx_pending()) {
         api_unlock();
         // Doing better than wait would require TxIRQ to also do wake() when
         // becoming empty. Worth it?
@@ -131,12 +138,22 @@ void BufferedSerial::sigio(Callback<void()> func)
     core_util_critical_section_exit();
 }
 
+bool BufferedSerial::tx_pending()
+{
+#if BUFFERED_SERIAL_DMA
+    if (serial_tx_dma_active(&_serial)) {
+        return true;
+    }
+#endif
+    return !_txbuf.empty();
+}
+
 /* Special synchronous write designed to work from critical section, such
  * as in mbed_error_vprintf.
  */
 ssize_t BufferedSerial::write_unbuffered(const char *buf_ptr, size_t length)
 {
-    while (!_txbuf.empty()) {
+    while (tx_pending()) {
         tx_irq();
     }
 
@@ -147,20 +164,9 @@ ssize_t BufferedSerial::write_unbuffered(const char *buf_ptr, size_t length)
     return length;
 }
 
-ssize_t BufferedSerial::write(const void *buffer, size_t length)
+size_t BufferedSerial::write_locked(const char *buf_ptr, size_t length)
 {
     size_t data_written = 0;
-    const char *buf_ptr = static_cast<const char *>(buffer);
-
-    if (length == 0) {
-        return 0;
-    }
-
-    if (core_util_in_critical_section()) {
-        return write_unbuffered(buf_ptr, length);
-    }
-
-    api_lock();
 
     // Unlike read, we should write the whole thing if blocking. POSIX only
     // allows partial as a side-effect of signal handling; it normally tries to
@@ -179,10 +185,12 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
             } while (_txbuf.full());
         }
 
-        while (data_written < length && !_txbuf.full()) {
-            _txbuf.push(*buf_ptr++);
-            data_written++;
-        }
+        // Only the IRQ handler takes data out, so the free space can only grow
+        size_t space = MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE - _txbuf.size();
+        size_t chunk = std::min(length - data_written, space);
+        _txbuf.push(Span<const char>(buf_ptr, chunk));
+        buf_ptr += chunk;
+        data_written += chunk;
 
         core_util_critical_section_enter();
         if (_tx_enabled && !_tx_irq_enabled) {
@@ -195,39 +203,80 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
         core_util_critical_section_exit();
     }
 
+    return data_written;
+}
+
+ssize_t BufferedSerial::write(const void *buffer, size_t length)
+{
+    const char *buf_ptr = static_cast<const char *>(buffer);
+
+    if (length == 0) {
+        return 0;
+    }
+
+    if (core_util_in_critical_section()) {
+        return write_unbuffered(buf_ptr, length);
+    }
+
+    api_lock();
+
+    size_t data_written = write_locked(buf_ptr, length);
+
     api_unlock();
 
     return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
 }
 
-ssize_t BufferedSerial::read(void *buffer, size_t length)
+ssize_t BufferedSerial::writev(Span<const struct iovec> iov)
 {
-    size_t data_read = 0;
-
-    char *ptr = static_cast<char *>(buffer);
+    size_t length = 0;
+    for (ptrdiff_t i = 0; i < iov.size(); i++) {
+        length += iov[i].iov_len;
+    }
 
     if (length == 0) {
         return 0;
     }
 
+    if (core_util_in_critical_section()) {
+        for (ptrdiff_t i = 0; i < iov.size(); i++) {
+            write_unbuffered(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        }
+        return length;
+    }
+
     api_lock();
 
+    size_t data_written = 0;
+    for (ptrdiff_t i = 0; i < iov.size(); i++) {
+        size_t chunk = write_locked(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+        data_written += chunk;
+        if (chunk < iov[i].iov_len) {
+            break;
+        }
+    }
+
+    api_unlock();
+
+    return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+}
+
+bool BufferedSerial::wait_readable_locked()
+{
     while (_rxbuf.empty()) {
         if (!_blocking) {
-            api_unlock();
-            return -EAGAIN;
+            return false;
         }
         api_unlock();
         // Do we need a proper wait?
         thread_sleep_for(1);
         api_lock();
     }
+    return true;
+}
 
-    while (data_read < length && !_rxbuf.empty()) {
-        _rxbuf.pop(*ptr++);
-        data_read++;
-    }
-
+void BufferedSerial::resume_rx_locked()
+{
     core_util_critical_section_enter();
     if (_rx_enabled && !_rx_irq_enabled) {
         // only read from hardware in one place
@@ -237,6 +286,62 @@ ssize_t BufferedSerial::read(void *buffer, size_t length)
         }
     }
     core_util_critical_section_exit();
+}
+
+ssize_t BufferedSerial::read(void *buffer, size_t length)
+{
+    size_t data_read = 0;
+
+    char *ptr = static_cast<char *>(buffer);
+
+    if (length == 0) {
+        return 0;
+    }
+
+    api_lock();
+
+    if (!wait_readable_locked()) {
+        api_unlock();
+        return -EAGAIN;
+    }
+
+    data_read = _rxbuf.pop(Span<char>(ptr, length));
+
+    resume_rx_locked();
+
+    api_unlock();
+
+    return data_read;
+}
+
+ssize_t BufferedSerial::readv(Span<const struct iovec> iov)
+{
+    size_t length = 0;
+    for (ptrdiff_t i = 0; i < iov.size(); i++) {
+        length += iov[i].iov_len;
+    }
+
+    if (length == 0) {
+        return 0;
+    }
+
+    api_lock();
+
+    if (!wait_readable_locked()) {
+        api_unlock();
+        return -EAGAIN;
+    }
+
+    size_t data_read = 0;
+    for (ptrdiff_t i = 0; i < iov.size(); i++) {
+        size_t chunk = _rxbuf.pop(Span<char>(static_cast<char *>(iov[i].iov_base), iov[i].iov_len));
+        data_read += chunk;
+        if (chunk < iov[i].iov_len) {
+            break;
+        }
+    }
+
+    resume_rx_locked();
 
     api_unlock();
 
@@ -253,6 +358,7 @@ void BufferedSerial::wake()
     if (_sigio_cb) {
         _sigio_cb();
     }
+    poll_wake();
 }
 
 short BufferedSerial::poll(short events) const
@@ -290,12 +396,24 @@ void BufferedSerial::rx_irq(void)
 {
     bool was_empty = _rxbuf.empty();
 
+#if BUFFERED_SERIAL_DMA
+    // Move what the DMA received since last time into the receive buffer.
+    // Anything that doesn't fit stays in the DMA buffer until the next call.
+    size_t head = serial_rx_dma_position(&_serial);
+    while (!_rxbuf.full() && _rx_dma_tail != head) {
+        _rxbuf.push(_rx_dma_buf[_rx_dma_tail]);
+        if (++_rx_dma_tail == sizeof(_rx_dma_buf)) {
+            _rx_dma_tail = 0;
+        }
+    }
+#else
     // Fill in the receive buffer if the peripheral is readable
     // and receive buffer is not full.
     while (!_rxbuf.full() && SerialBase::readable()) {
         char data = SerialBase::_base_getc();
         _rxbuf.push(data);
     }
+#endif
 
     if (_rx_irq_enabled && _rxbuf.full()) {
         disable_rx_irq();
@@ -311,6 +429,22 @@ void BufferedSerial::rx_irq(void)
 void BufferedSerial::tx_irq(void)
 {
     bool was_full = _txbuf.full();
+
+#if BUFFERED_SERIAL_DMA
+    // Hand the next chunk to the DMA once the previous one is out. The TX
+    // IRQ stays enabled while a transmission is active, it signals completion.
+    if (!serial_tx_dma_active(&_serial)) {
+        size_t length = _txbuf.pop(Span<char>(_tx_dma_buf, sizeof(_tx_dma_buf)));
+        if (length) {
+            serial_tx_dma_start(&_serial, _tx_dma_buf, length);
+            if (!_tx_irq_enabled) {
+                enable_tx_irq();
+            }
+        } else if (_tx_irq_enabled) {
+            disable_tx_irq();
+        }
+    }
+#else
     char data;
 
     // Write to the peripheral if there is something to write
@@ -322,6 +456,7 @@ void BufferedSerial::tx_irq(void)
     if (_tx_irq_enabled && _txbuf.empty()) {
         disable_tx_irq();
     }
+#endif
 
     // Report the File handler that data can be written to peripheral.
     if (was_full && !_txbuf.full() && !hup()) {
@@ -356,10 +491,31 @@ void BufferedSerial::disable_tx_irq()
     _tx_irq_enabled = false;
 }
 
+#if BUFFERED_SERIAL_DMA
+void BufferedSerial::start_rx_dma()
+{
+    _rx_dma_tail = 0;
+    serial_rx_dma_start(&_serial, _rx_dma_buf, sizeof(_rx_dma_buf));
+}
+#endif
+
 int BufferedSerial::enable_input(bool enabled)
 {
     api_lock();
+#if BUFFERED_SERIAL_DMA
+    bool was_enabled = SerialBase::_rx_enabled;
+    if (was_enabled && !enabled) {
+        serial_rx_dma_stop(&_serial);
+        _rx_dma_tail = 0;
+    }
+#endif
     SerialBase::enable_input(enabled);
+#if BUFFERED_SERIAL_DMA
+    if (!was_enabled && enabled) {
+        // The peripheral may have been freed and initialised again
+        start_rx_dma();
+    }
+#endif
     api_unlock();
 
     return 0;
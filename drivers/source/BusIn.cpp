@@ -24,6 +24,10 @@ BusIn::BusIn(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinName
     PinName pins[16] = {p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15};
 
     // No lock needed in the constructor
+#if DEVICE_PORTIN
+    // before the pins, so their mode isn't overridden by the ports
+    _ports.init(pins, PIN_INPUT);
+#endif
     _nc_mask = 0;
     for (int i = 0; i < 16; i++) {
         _pin[i] = (pins[i] != NC) ? new DigitalIn(pins[i]) : 0;
@@ -36,6 +40,10 @@ BusIn::BusIn(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinName
 BusIn::BusIn(PinName pins[16])
 {
     // No lock needed in the constructor
+#if DEVICE_PORTIN
+    // before the pins, so their mode isn't overridden by the ports
+    _ports.init(pins, PIN_INPUT);
+#endif
     _nc_mask = 0;
     for (int i = 0; i < 16; i++) {
         _pin[i] = (pins[i] != NC) ? new DigitalIn(pins[i]) : 0;
@@ -57,10 +65,16 @@ BusIn::~BusIn()
 
 int BusIn::read()
 {
-    int v = 0;
     lock();
+#if DEVICE_PORTIN
+    int v = _ports.read();
+    int pin_mask = _nc_mask & ~_ports.mask();
+#else
+    int v = 0;
+    int pin_mask = _nc_mask;
+#endif
     for (int i = 0; i < 16; i++) {
-        if (_pin[i] != 0) {
+        if (pin_mask & (1 << i)) {
             v |= _pin[i]->read() << i;
         }
     }
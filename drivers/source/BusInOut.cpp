@@ -24,6 +24,11 @@ BusInOut::BusInOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, P
     PinName pins[16] = {p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15};
 
     // No lock needed in the constructor
+#if DEVICE_PORTINOUT
+    // before the pins, so their mode isn't overridden by the ports. The
+    // ports only carry values, direction changes are left to the pins
+    _ports.init(pins, PIN_INPUT);
+#endif
     _nc_mask = 0;
     for (int i = 0; i < 16; i++) {
         _pin[i] = (pins[i] != NC) ? new DigitalInOut(pins[i]) : 0;
@@ -36,6 +41,11 @@ BusInOut::BusInOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, P
 BusInOut::BusInOut(PinName pins[16])
 {
     // No lock needed in the constructor
+#if DEVICE_PORTINOUT
+    // before the pins, so their mode isn't overridden by the ports. The
+    // ports only carry values, direction changes are left to the pins
+    _ports.init(pins, PIN_INPUT);
+#endif
     _nc_mask = 0;
     for (int i = 0; i < 16; i++) {
         _pin[i] = (pins[i] != NC) ? new DigitalInOut(pins[i]) : 0;
@@ -58,8 +68,14 @@ BusInOut::~BusInOut()
 void BusInOut::write(int value)
 {
     lock();
+#if DEVICE_PORTINOUT
+    _ports.write(value);
+    int pin_mask = _nc_mask & ~_ports.mask();
+#else
+    int pin_mask = _nc_mask;
+#endif
     for (int i = 0; i < 16; i++) {
-        if (_pin[i] != 0) {
+        if (pin_mask & (1 << i)) {
             _pin[i]->write((value >> i) & 1);
         }
     }
@@ -69,9 +85,15 @@ void BusInOut::write(int value)
 int BusInOut::read()
 {
     lock();
+#if DEVICE_PORTINOUT
+    int v = _ports.read();
+    int pin_mask = _nc_mask & ~_ports.mask();
+#else
     int v = 0;
+    int pin_mask = _nc_mask;
+#endif
     for (int i = 0; i < 16; i++) {
-        if (_pin[i] != 0) {
+        if (pin_mask & (1 << i)) {
             v |= _pin[i]->read() << i;
         }
     }
@@ -31,6 +31,11 @@ BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinNa
             _nc_mask |= (1 << i);
         }
     }
+
+#if DEVICE_PORTOUT
+    // once the pins are outputs, so the ports don't glitch them
+    _ports.init(pins, PIN_OUTPUT);
+#endif
 }
 
 BusOut::BusOut(PinName pins[16])
@@ -43,6 +48,11 @@ BusOut::BusOut(PinName pins[16])
             _nc_mask |= (1 << i);
         }
     }
+
+#if DEVICE_PORTOUT
+    // once the pins are outputs, so the ports don't glitch them
+    _ports.init(pins, PIN_OUTPUT);
+#endif
 }
 
 BusOut::~BusOut()
@@ -58,8 +68,14 @@ BusOut::~BusOut()
 void BusOut::write(int value)
 {
     lock();
+#if DEVICE_PORTOUT
+    _ports.write(value);
+    int pin_mask = _nc_mask & ~_ports.mask();
+#else
+    int pin_mask = _nc_mask;
+#endif
     for (int i = 0; i < 16; i++) {
-        if (_pin[i] != 0) {
+        if (pin_mask & (1 << i)) {
             _pin[i]->write((value >> i) & 1);
         }
     }
@@ -69,9 +85,15 @@ void BusOut::write(int value)
 int BusOut::read()
 {
     lock();
+#if DEVICE_PORTOUT
+    int v = _ports.read();
+    int pin_mask = _nc_mask & ~_ports.mask();
+#else
     int v = 0;
+    int pin_mask = _nc_mask;
+#endif
     for (int i = 0; i < 16; i++) {
-        if (_pin[i] != 0) {
+        if (pin_mask & (1 << i)) {
             v |= _pin[i]->read() << i;
         }
     }
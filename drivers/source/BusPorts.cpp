@@ -0,0 +1,127 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "drivers/internal/BusPorts.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+namespace internal {
+
+BusPorts::BusPorts() : _ports(nullptr), _count(0), _mask(0)
+{
+}
+
+BusPorts::~BusPorts()
+{
+    delete[] _ports;
+}
+
+void BusPorts::init(const PinName pins[16], PinDirection dir)
+{
+    PortName names[16];
+    int masks[16];
+    int pin_count[16];
+    int count = 0;
+
+    // find the port of each pin
+    for (int i = 0; i < 16; i++) {
+        PortName port;
+        int pin_n;
+        if (pins[i] == NC || !port_pin_info(pins[i], &port, &pin_n) || pin_n < 0 || pin_n >= 32) {
+            continue;
+        }
+
+        int g = 0;
+        while (g < count && names[g] != port) {
+            g++;
+        }
+        if (g == count) {
+            names[g] = port;
+            masks[g] = 0;
+            pin_count[g] = 0;
+            count++;
+        }
+        masks[g] |= 1 << pin_n;
+        pin_count[g]++;
+        _port[i] = g;
+        _bit[i] = pin_n;
+        _mask |= 1 << i;
+    }
+
+    // a port with a single pin of the bus gains nothing, leave it to the pin
+    int index[16];
+    for (int g = 0; g < count; g++) {
+        index[g] = pin_count[g] > 1 ? _count++ : -1;
+    }
+    for (int i = 0; i < 16; i++) {
+        if ((_mask & (1 << i)) && index[_port[i]] < 0) {
+            _mask &= ~(1 << i);
+        } else if (_mask & (1 << i)) {
+            _port[i] = index[_port[i]];
+        }
+    }
+
+    if (_count == 0) {
+        return;
+    }
+
+    _ports = new port_t[_count];
+    for (int g = 0; g < count; g++) {
+        if (index[g] >= 0) {
+            port_init(&_ports[index[g]], names[g], masks[g], dir);
+        }
+    }
+}
+
+void BusPorts::write(int value)
+{
+    int values[16] = { 0 };
+    for (int i = 0; i < 16; i++) {
+        if ((_mask & value) & (1 << i)) {
+            values[_port[i]] |= 1 << _bit[i];
+        }
+    }
+
+    core_util_critical_section_enter();
+    for (int g = 0; g < _count; g++) {
+        port_write(&_ports[g], values[g]);
+    }
+    core_util_critical_section_exit();
+}
+
+int BusPorts::read()
+{
+    int values[16];
+    for (int g = 0; g < _count; g++) {
+        values[g] = port_read(&_ports[g]);
+    }
+
+    int value = 0;
+    for (int i = 0; i < 16; i++) {
+        if (_mask & (1 << i)) {
+            value |= ((values[_port[i]] >> _bit[i]) & 1) << i;
+        }
+    }
+    return value;
+}
+
+} // namespace internal
+} // namespace mbed
+
+#endif
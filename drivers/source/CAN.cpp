@@ -18,32 +18,36 @@
 
 #if DEVICE_CAN
 
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 
 namespace mbed {
 
-CAN::CAN(PinName rd, PinName td) : _can(), _irq()
+CAN::CAN(PinName rd, PinName td) : _can(), _irq(), _rx_buffer(nullptr), _rx_size(0), _rx_head(0), _rx_tail(0), _rx_dropped(0)
 {
     // No lock needed in constructor
     can_init(&_can, rd, td);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq()
+CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq(), _rx_buffer(nullptr), _rx_size(0), _rx_head(0), _rx_tail(0), _rx_dropped(0)
 {
     // No lock needed in constructor
     can_init_freq(&_can, rd, td, hz);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(const can_pinmap_t &pinmap) : _can(), _irq()
+CAN::CAN(const can_pinmap_t &pinmap) : _can(), _irq(), _rx_buffer(nullptr), _rx_size(0), _rx_head(0), _rx_tail(0), _rx_dropped(0)
 {
     // No lock needed in constructor
     can_init_direct(&_can, &pinmap);
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(const can_pinmap_t &pinmap, int hz) : _can(), _irq()
+CAN::CAN(const can_pinmap_t &pinmap, int hz) : _can(), _irq(), _rx_buffer(nullptr), _rx_size(0), _rx_head(0), _rx_tail(0), _rx_dropped(0)
 {
     // No lock needed in constructor
     can_init_freq_direct(&_can, &pinmap, hz);
@@ -55,6 +59,7 @@ CAN::~CAN()
     // No lock needed in destructor
 
     // Detaching interrupts releases the sleep lock if it was locked
+    rx_buffer_stop();
     for (int irq = 0; irq < IrqCnt; irq++) {
         attach(nullptr, (IrqType)irq);
     }
@@ -81,11 +86,34 @@ int CAN::write(CANMessage msg)
 int CAN::read(CANMessage &msg, int handle)
 {
     lock();
-    int ret = can_read(&_can, &msg, handle);
+    int ret;
+    if (_rx_buffer) {
+        ret = pop_rx(msg) ? 1 : 0;
+    } else {
+        ret = can_read(&_can, &msg, handle);
+    }
     unlock();
     return ret;
 }
 
+int CAN::read(Span<CANMessage> msgs)
+{
+    lock();
+    int count = 0;
+    while (count < msgs.size()) {
+        if (_rx_buffer) {
+            if (!pop_rx(msgs[count])) {
+                break;
+            }
+        } else if (!can_read(&_can, &msgs[count], 0)) {
+            break;
+        }
+        count++;
+    }
+    unlock();
+    return count;
+}
+
 void CAN::reset()
 {
     lock();
@@ -132,6 +160,114 @@ int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle
     return ret;
 }
 
+int CAN::filter_banks()
+{
+    lock();
+    int ret = can_filter_bank_count(&_can);
+    unlock();
+    return ret;
+}
+
+int CAN::filter_bank(int bank, unsigned int id, unsigned int mask, CANFormat format)
+{
+    lock();
+    int ret = can_filter_bank(&_can, bank, id, mask, format, 1);
+    unlock();
+    return ret;
+}
+
+int CAN::filter_bank_disable(int bank)
+{
+    lock();
+    int ret = can_filter_bank(&_can, bank, 0, 0, CANStandard, 0);
+    unlock();
+    return ret;
+}
+
+void CAN::rx_buffer(Span<CANMessage> buffer)
+{
+    MBED_ASSERT(buffer.size() > 1);
+
+    lock();
+    core_util_critical_section_enter();
+    if (!_rx_buffer) {
+        sleep_manager_lock_deep_sleep();
+    }
+    _rx_buffer = buffer.data();
+    _rx_size = buffer.size();
+    _rx_head = 0;
+    _rx_tail = 0;
+    _rx_dropped = 0;
+    can_irq_set(&_can, IRQ_RX, 1);
+    core_util_critical_section_exit();
+    unlock();
+}
+
+void CAN::rx_buffer_stop()
+{
+    lock();
+    core_util_critical_section_enter();
+    if (_rx_buffer) {
+        _rx_buffer = nullptr;
+        can_irq_set(&_can, IRQ_RX, _irq[RxIrq] ? 1 : 0);
+        sleep_manager_unlock_deep_sleep();
+    }
+    core_util_critical_section_exit();
+    unlock();
+}
+
+uint32_t CAN::rx_dropped() const
+{
+    return core_util_atomic_load_u32(&_rx_dropped);
+}
+
+void CAN::buffer_rx()
+{
+    // Drain every pending message, even when the FIFO is full, so the
+    // interrupt does not fire again straight away
+    CANMessage overflow;
+    while (true) {
+        uint32_t next = _rx_head + 1;
+        if (next == _rx_size) {
+            next = 0;
+        }
+        bool full = next == core_util_atomic_load_u32(&_rx_tail);
+        CANMessage *slot = full ? &overflow : &_rx_buffer[_rx_head];
+
+#if DEVICE_USTICKER
+        slot->timestamp = ticker_read_us(get_us_ticker_data());
+#else
+        slot->timestamp = 0;
+#endif
+        if (!can_read_timestamp(&_can, slot, 0, &slot->timestamp)) {
+            return;
+        }
+
+        if (full) {
+            _rx_dropped++;
+        } else {
+            // publish the message to read() only once it is written
+            core_util_atomic_store_u32(&_rx_head, next);
+        }
+    }
+}
+
+bool CAN::pop_rx(CANMessage &msg)
+{
+    // Only the interrupt handler moves the head, and only this moves the
+    // tail, so no critical section is needed
+    uint32_t tail = _rx_tail;
+    if (tail == core_util_atomic_load_u32(&_rx_head)) {
+        return false;
+    }
+    msg = _rx_buffer[tail];
+    if (++tail == _rx_size) {
+        tail = 0;
+    }
+    core_util_atomic_store_u32(&_rx_tail, tail);
+    return true;
+}
+
 void CAN::attach(Callback<void()> func, IrqType type)
 {
     lock();
@@ -148,7 +284,10 @@ void CAN::attach(Callback<void()> func, IrqType type)
             sleep_manager_unlock_deep_sleep();
         }
         _irq[(CanIrqType)type] = nullptr;
-        can_irq_set(&_can, (CanIrqType)type, 0);
+        // keep the receive interrupt while messages are being buffered
+        if (type != RxIrq || !_rx_buffer) {
+            can_irq_set(&_can, (CanIrqType)type, 0);
+        }
     }
     unlock();
 }
@@ -156,6 +295,9 @@ void CAN::attach(Callback<void()> func, IrqType type)
 void CAN::_irq_handler(uint32_t id, CanIrqType type)
 {
     CAN *handler = (CAN *)id;
+    if (type == IRQ_RX && handler->_rx_buffer) {
+        handler->buffer_rx();
+    }
     if (handler->_irq[type]) {
         handler->_irq[type].call();
     }
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2020 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/DMAMemcpy.h"
+#include "hal/dma_api.h"
+#include "platform/mbed_critical.h"
+#if MBED_CONF_RTOS_API_PRESENT
+#include "rtos/Semaphore.h"
+#endif
+#include <string.h>
+
+// Longest copy is DMA_MEMCPY_DESCRIPTORS times the max_count of the target
+#define DMA_MEMCPY_DESCRIPTORS 4
+
+namespace mbed {
+
+#if DEVICE_DMA && MBED_CONF_DRIVERS_DMA_MEMCPY_THRESHOLD > 0
+
+static dma_channel_t channel;
+static dma_capabilities_t capabilities;
+static bool channel_initialized;
+static bool channel_unavailable;
+static bool channel_busy;
+
+static dma_descriptor_t descriptors[DMA_MEMCPY_DESCRIPTORS];
+static uint32_t fill;
+static Callback<void()> pending_done;
+static void *pending_dst;
+static const void *pending_src;
+static size_t pending_len;
+
+static void dma_handler(dma_channel_t *, uint32_t events, void *)
+{
+    if (events & DMA_EVENT_ERROR) {
+        // Finish on the CPU rather than leave the destination half written
+        if (pending_src) {
+            memcpy(pending_dst, pending_src, pending_len);
+        } else {
+            memset(pending_dst, (uint8_t)fill, pending_len);
+        }
+    }
+
+    Callback<void()> done = pending_done;
+    pending_done = nullptr;
+    channel_busy = false;
+    if (done) {
+        done();
+    }
+}
+
+// Start the copy, or the fill if src is NULL, on the DMA channel
+static bool dma_start(void *dst, const void *src, int value, size_t len, Callback<void()> done)
+{
+    if (len < MBED_CONF_DRIVERS_DMA_MEMCPY_THRESHOLD) {
+        return false;
+    }
+
+    core_util_critical_section_enter();
+
+    if (!channel_initialized && !channel_unavailable) {
+        hal_dma_get_capabilities(&capabilities);
+        dma_config_t config = { DMA_MEMORY_TO_MEMORY, 0, 0, 0 };
+        if (capabilities.memory_to_memory &&
+                hal_dma_channel_init(&channel, &config, dma_handler, NULL) == DMA_STATUS_OK) {
+            channel_initialized = true;
+        } else {
+            channel_unavailable = true;
+        }
+    }
+    if (!channel_initialized || channel_busy) {
+        core_util_critical_section_exit();
+        return false;
+    }
+
+    // Widest items the buffers are aligned to
+    uintptr_t alignment = (uintptr_t)dst | (uintptr_t)src | len;
+    dma_width_t width = DMA_WIDTH_8BIT;
+    if (!(alignment & 3) && (capabilities.widths & DMA_WIDTH_32BIT)) {
+        width = DMA_WIDTH_32BIT;
+    } else if (!(alignment & 1) && (capabilities.widths & DMA_WIDTH_16BIT)) {
+        width = DMA_WIDTH_16BIT;
+    } else if (!(capabilities.widths & DMA_WIDTH_8BIT)) {
+        core_util_critical_section_exit();
+        return false;
+    }
+
+    uint32_t items = len / width;
+    uint32_t count = (items + capabilities.max_count - 1) / capabilities.max_count;
+    if (count > DMA_MEMCPY_DESCRIPTORS || (count > 1 && !capabilities.linked)) {
+        core_util_critical_section_exit();
+        return false;
+    }
+
+    fill = (uint8_t)value * 0x01010101UL;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t chunk = items - offset < capabilities.max_count ? items - offset : capabilities.max_count;
+        descriptors[i].src = src ? (const uint8_t *)src + offset * width : (const void *)&fill;
+        descriptors[i].dst = (uint8_t *)dst + offset * width;
+        descriptors[i].count = chunk;
+        descriptors[i].width = width;
+        descriptors[i].src_increment = src != NULL;
+        descriptors[i].dst_increment = true;
+        descriptors[i].next = i + 1 < count ? &descriptors[i + 1] : NULL;
+        offset += chunk;
+    }
+
+    pending_done = done;
+    pending_dst = dst;
+    pending_src = src;
+    pending_len = len;
+    channel_busy = true;
+    if (hal_dma_transfer_start(&channel, &descriptors[0]) != DMA_STATUS_OK) {
+        pending_done = nullptr;
+        channel_busy = false;
+        core_util_critical_section_exit();
+        return false;
+    }
+
+    core_util_critical_section_exit();
+    return true;
+}
+
+#else
+
+static bool dma_start(void *, const void *, int, size_t, Callback<void()>)
+{
+    return false;
+}
+
+#endif
+
+bool dma_memcpy_async(void *dst, const void *src, size_t len, Callback<void()> done)
+{
+    if (dma_start(dst, src, 0, len, done)) {
+        return true;
+    }
+    memcpy(dst, src, len);
+    if (done) {
+        done();
+    }
+    return false;
+}
+
+bool dma_memset_async(void *dst, int value, size_t len, Callback<void()> done)
+{
+    if (dma_start(dst, NULL, value, len, done)) {
+        return true;
+    }
+    memset(dst, value, len);
+    if (done) {
+        done();
+    }
+    return false;
+}
+
+#if MBED_CONF_RTOS_API_PRESENT
+
+static void dma_wait(void *dst, const void *src, int value, size_t len)
+{
+    rtos::Semaphore sem(0);
+    if (dma_start(dst, src, value, len, [&sem] { sem.release(); })) {
+        sem.acquire();
+    } else if (src) {
+        memcpy(dst, src, len);
+    } else {
+        memset(dst, value, len);
+    }
+}
+
+#else
+
+static void dma_wait(void *dst, const void *src, int value, size_t len)
+{
+    volatile bool done = false;
+    if (dma_start(dst, src, value, len, [&done] { done = true; })) {
+        while (!done);
+    } else if (src) {
+        memcpy(dst, src, len);
+    } else {
+        memset(dst, value, len);
+    }
+}
+
+#endif
+
+void dma_memcpy(void *dst, const void *src, size_t len)
+{
+    dma_wait(dst, src, 0, len);
+}
+
+void dma_memset(void *dst, int value, size_t len)
+{
+    dma_wait(dst, NULL, value, len);
+}
+
+} // namespace mbed
@@ -27,6 +27,10 @@
 #include <algorithm>
 #include "FlashIAP.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_mpu_mgmt.h"
+#include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_thread.h"
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/ScopedRomWriteLock.h"
 
@@ -39,6 +43,17 @@ const unsigned int num_write_retries = 16;
 
 SingletonPtr<PlatformMutex> FlashIAP::_mutex;
 
+#if DEVICE_FLASH_ASYNCH
+// State of the asynchronous operation. There is only one flash controller,
+// so only one operation runs at a time, whichever FlashIAP started it
+static bool async_active;
+static Callback<void(int)> async_callback;
+static const uint8_t *async_buf;
+static uint32_t async_addr;
+static uint32_t async_size;
+static uint32_t async_step;
+#endif
+
 static inline bool is_aligned(uint32_t number, uint32_t alignment)
 {
     if ((number % alignment) != 0) {
@@ -51,7 +66,7 @@ static inline bool is_aligned(uint32_t number, uint32_t alignment)
 int FlashIAP::init()
 {
     int ret = 0;
-    _mutex->lock();
+    lock();
     {
         ScopedRamExecutionLock make_ram_executable;
         ScopedRomWriteLock make_rom_writable;
@@ -66,14 +81,14 @@ int FlashIAP::init()
         _page_buf = new uint8_t[page_size];
     }
 
-    _mutex->unlock();
+    unlock();
     return ret;
 }
 
 int FlashIAP::deinit()
 {
     int ret = 0;
-    _mutex->lock();
+    lock();
     {
         ScopedRamExecutionLock make_ram_executable;
         ScopedRomWriteLock make_rom_writable;
@@ -82,7 +97,7 @@ int FlashIAP::deinit()
         }
     }
     delete[] _page_buf;
-    _mutex->unlock();
+    unlock();
     return ret;
 }
 
@@ -90,55 +105,66 @@ int FlashIAP::deinit()
 int FlashIAP::read(void *buffer, uint32_t addr, uint32_t size)
 {
     int32_t ret = -1;
-    _mutex->lock();
+    lock();
     {
         ScopedRamExecutionLock make_ram_executable;
         ScopedRomWriteLock make_rom_writable;
         ret = flash_read(&_flash, addr, (uint8_t *) buffer, size);
     }
-    _mutex->unlock();
+    unlock();
     return ret;
 }
 
-int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
+bool FlashIAP::is_valid_program(const void *buffer, uint32_t addr, uint32_t size)
 {
     uint32_t page_size = get_page_size();
     uint32_t flash_size = flash_get_size(&_flash);
     uint32_t flash_start_addr = flash_get_start_address(&_flash);
-    uint8_t flash_erase_value = flash_get_erase_value(&_flash);
-    uint32_t chunk, prog_size;
-    const uint8_t *buf = (uint8_t *) buffer;
-    const uint8_t *prog_buf;
 
     // addr should be aligned to page size
     if (!is_aligned(addr, page_size) || (!buffer) ||
             ((addr + size) > (flash_start_addr + flash_size))) {
-        return -1;
+        return false;
+    }
+    return true;
+}
+
+uint32_t FlashIAP::program_chunk(const uint8_t *buf, uint32_t addr, uint32_t size,
+                                 const uint8_t **prog_buf, uint32_t *prog_size)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
+    bool unaligned_src = (((size_t) buf / sizeof(uint32_t) * sizeof(uint32_t)) != (size_t) buf);
+    uint32_t chunk = std::min(current_sector_size - (addr % current_sector_size), size);
+    // Need to use the internal page buffer in any of these two cases:
+    // 1. Size is not page aligned
+    // 2. Source buffer is not aligned to uint32_t. This is not supported by many targets (although
+    //    the pointer they accept is of uint8_t).
+    if (unaligned_src || (chunk < page_size)) {
+        chunk = std::min(chunk, page_size);
+        memcpy(_page_buf, buf, chunk);
+        if (chunk < page_size) {
+            memset(_page_buf + chunk, flash_get_erase_value(&_flash), page_size - chunk);
+        }
+        *prog_buf = _page_buf;
+        *prog_size = page_size;
+    } else {
+        chunk = chunk / page_size * page_size;
+        *prog_buf = buf;
+        *prog_size = chunk;
     }
+    return chunk;
+}
+
+int FlashIAP::program_pages(const uint8_t *buf, uint32_t addr, uint32_t size, bool yield)
+{
+    uint32_t chunk, prog_size;
+    const uint8_t *prog_buf;
 
     int ret = 0;
-    _mutex->lock();
+    lock();
     while (size && !ret) {
-        uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
-        bool unaligned_src = (((size_t) buf / sizeof(uint32_t) * sizeof(uint32_t)) != (size_t) buf);
-        chunk = std::min(current_sector_size - (addr % current_sector_size), size);
-        // Need to use the internal page buffer in any of these two cases:
-        // 1. Size is not page aligned
-        // 2. Source buffer is not aligned to uint32_t. This is not supported by many targets (although
-        //    the pointer they accept is of uint8_t).
-        if (unaligned_src || (chunk < page_size)) {
-            chunk = std::min(chunk, page_size);
-            memcpy(_page_buf, buf, chunk);
-            if (chunk < page_size) {
-                memset(_page_buf + chunk, flash_erase_value, page_size - chunk);
-            }
-            prog_buf = _page_buf;
-            prog_size = page_size;
-        } else {
-            chunk = chunk / page_size * page_size;
-            prog_buf = buf;
-            prog_size = chunk;
-        }
+        chunk = program_chunk(buf, addr, size, &prog_buf, &prog_size);
         {
             // Few boards may fail the write actions due to HW limitations (like critical drivers that
             // disable flash operations). Just retry a few times until success.
@@ -156,12 +182,26 @@ int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
         size -= chunk;
         addr += chunk;
         buf += chunk;
+
+        // let other threads run at sector boundaries
+        if (yield && size && addr % flash_get_sector_size(&_flash, addr) == 0) {
+            thread_sleep_for(1);
+        }
     }
-    _mutex->unlock();
+    unlock();
 
     return ret;
 }
 
+int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
+{
+    if (!is_valid_program(buffer, addr, size)) {
+        return -1;
+    }
+
+    return program_pages((const uint8_t *) buffer, addr, size, false);
+}
+
 bool FlashIAP::is_aligned_to_sector(uint32_t addr, uint32_t size)
 {
     uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
@@ -173,25 +213,30 @@ bool FlashIAP::is_aligned_to_sector(uint32_t addr, uint32_t size)
     }
 }
 
-int FlashIAP::erase(uint32_t addr, uint32_t size)
+bool FlashIAP::is_valid_erase(uint32_t addr, uint32_t size)
 {
-    uint32_t current_sector_size;
     uint32_t flash_size = flash_get_size(&_flash);
     uint32_t flash_start_addr = flash_get_start_address(&_flash);
     uint32_t flash_end_addr = flash_start_addr + flash_size;
     uint32_t erase_end_addr = addr + size;
 
     if (erase_end_addr > flash_end_addr) {
-        return -1;
+        return false;
     } else if (erase_end_addr < flash_end_addr) {
         uint32_t following_sector_size = flash_get_sector_size(&_flash, erase_end_addr);
         if (!is_aligned(erase_end_addr, following_sector_size)) {
-            return -1;
+            return false;
         }
     }
+    return true;
+}
+
+int FlashIAP::erase_sectors(uint32_t addr, uint32_t size, bool yield)
+{
+    uint32_t current_sector_size;
 
     int32_t ret = 0;
-    _mutex->lock();
+    lock();
     while (size && !ret) {
         // Few boards may fail the erase actions due to HW limitations (like critical drivers that
         // disable flash operations). Just retry a few times until success.
@@ -208,11 +253,154 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
         current_sector_size = flash_get_sector_size(&_flash, addr);
         size -= current_sector_size;
         addr += current_sector_size;
+
+        // let other threads run between sectors
+        if (yield && size && !ret) {
+            thread_sleep_for(1);
+        }
     }
-    _mutex->unlock();
+    unlock();
     return ret;
 }
 
+int FlashIAP::erase(uint32_t addr, uint32_t size)
+{
+    if (!is_valid_erase(addr, size)) {
+        return -1;
+    }
+
+    return erase_sectors(addr, size, false);
+}
+
+int FlashIAP::program_async(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    if (!is_valid_program(buffer, addr, size)) {
+        return -1;
+    }
+
+#if DEVICE_FLASH_ASYNCH
+    return start_async((const uint8_t *) buffer, addr, size, callback);
+#else
+    callback(program_pages((const uint8_t *) buffer, addr, size, true));
+    return 0;
+#endif
+}
+
+int FlashIAP::erase_async(uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    if (!is_valid_erase(addr, size)) {
+        return -1;
+    }
+
+#if DEVICE_FLASH_ASYNCH
+    return start_async(nullptr, addr, size, callback);
+#else
+    callback(erase_sectors(addr, size, true));
+    return 0;
+#endif
+}
+
+#if DEVICE_FLASH_ASYNCH
+int FlashIAP::start_async(const uint8_t *buf, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    if (size == 0) {
+        callback(0);
+        return 0;
+    }
+
+    lock();
+    async_callback = callback;
+    async_buf = buf;
+    async_addr = addr;
+    async_size = size;
+    core_util_atomic_store_bool(&async_active, true);
+
+    // held until the last step completes, in interrupt context
+    sleep_manager_lock_deep_sleep();
+    mbed_mpu_manager_lock_ram_execution();
+    mbed_mpu_manager_lock_rom_write();
+
+    int ret = start_async_step();
+    if (ret) {
+        mbed_mpu_manager_unlock_rom_write();
+        mbed_mpu_manager_unlock_ram_execution();
+        sleep_manager_unlock_deep_sleep();
+        core_util_atomic_store_bool(&async_active, false);
+    }
+    unlock();
+    return ret;
+}
+
+int FlashIAP::start_async_step()
+{
+    int32_t ret = -1;
+    // Few boards may fail the write actions due to HW limitations (like critical drivers that
+    // disable flash operations). Just retry a few times until success.
+    for (unsigned int retry = 0; retry < num_write_retries && ret; retry++) {
+        if (async_buf) {
+            const uint8_t *prog_buf;
+            uint32_t prog_size;
+            async_step = program_chunk(async_buf, async_addr, async_size, &prog_buf, &prog_size);
+            ret = flash_program_page_async(&_flash, async_addr, prog_buf, prog_size,
+                                           &FlashIAP::async_handler, (uint32_t)this);
+        } else {
+            async_step = flash_get_sector_size(&_flash, async_addr);
+            ret = flash_erase_sector_async(&_flash, async_addr, &FlashIAP::async_handler, (uint32_t)this);
+        }
+    }
+    return ret ? -1 : 0;
+}
+
+void FlashIAP::async_handler(uint32_t id, int32_t status)
+{
+    FlashIAP *flash = (FlashIAP *)id;
+
+    if (status == 0) {
+        async_size -= async_step;
+        async_addr += async_step;
+        if (async_buf) {
+            async_buf += async_step;
+        }
+        if (async_size) {
+            if (flash->start_async_step() == 0) {
+                return;
+            }
+            status = -1;
+        }
+    } else {
+        status = -1;
+    }
+
+    mbed_mpu_manager_unlock_rom_write();
+    mbed_mpu_manager_unlock_ram_execution();
+    sleep_manager_unlock_deep_sleep();
+
+    Callback<void(int)> callback = async_callback;
+    async_callback = nullptr;
+    core_util_atomic_store_bool(&async_active, false);
+    callback(status);
+}
+#endif
+
+void FlashIAP::lock()
+{
+    _mutex->lock();
+#if DEVICE_FLASH_ASYNCH
+    // An asynchronous operation can't hold the mutex, as it completes in
+    // interrupt context - wait for it to finish
+    while (core_util_atomic_load_bool(&async_active)) {
+        _mutex->unlock();
+        thread_sleep_for(1);
+        _mutex->lock();
+    }
+#endif
+}
+
+void FlashIAP::unlock()
+{
+    _mutex->unlock();
+}
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
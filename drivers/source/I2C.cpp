@@ -18,6 +18,7 @@
 #include "drivers/I2C.h"
 #include "drivers/DigitalInOut.h"
 #include "platform/mbed_wait_api.h"
+#include "platform/mbed_critical.h"
 
 #if DEVICE_I2C
 
@@ -206,32 +207,106 @@ int I2C::recover(PinName sda, PinName scl)
 
 #if DEVICE_I2C_ASYNCH
 
+I2C *I2C::_transfer_owner = NULL;
+#if TRANSACTION_QUEUE_SIZE_I2C
+SingletonPtr<CircularBuffer<I2C::queued_transfer_t, TRANSACTION_QUEUE_SIZE_I2C> > I2C::_transaction_buffer;
+#endif
+
 int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
 {
     lock();
-    if (i2c_active(&_i2c)) {
+#if TRANSACTION_QUEUE_SIZE_I2C
+    // prime the SingletonPtr outside of the critical section
+    _transaction_buffer.get();
+#endif
+    core_util_critical_section_enter();
+    if (_transfer_owner || i2c_active(&_i2c)) {
+#if TRANSACTION_QUEUE_SIZE_I2C
+        if (!_transaction_buffer->full()) {
+            queued_transfer_t t;
+            t.obj = this;
+            t.address = address;
+            t.tx_buffer = tx_buffer;
+            t.tx_length = tx_length;
+            t.rx_buffer = rx_buffer;
+            t.rx_length = rx_length;
+            t.callback = callback;
+            t.event = event;
+            t.repeated = repeated;
+            _transaction_buffer->push(t);
+            core_util_critical_section_exit();
+            unlock();
+            return 0;
+        }
+#endif
+        core_util_critical_section_exit();
         unlock();
         return -1; // transaction ongoing
     }
+    start_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
+    core_util_critical_section_exit();
+    unlock();
+    return 0;
+}
+
+void I2C::start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
     lock_deep_sleep();
-    aquire();
+    // Queued transfers are started from the interrupt handler, where the
+    // mutex can't be taken, so restore our frequency directly
+    if (_owner != this) {
+        i2c_frequency(&_i2c, _hz);
+        _owner = this;
+    }
+    _transfer_owner = this;
 
     _callback = callback;
     int stop = (repeated) ? 0 : 1;
     _irq.callback(&I2C::irq_handler_asynch);
     i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
-    unlock();
-    return 0;
 }
 
 void I2C::abort_transfer(void)
 {
     lock();
+    core_util_critical_section_enter();
     i2c_abort_asynch(&_i2c);
     unlock_deep_sleep();
+    if (_transfer_owner == this) {
+        _transfer_owner = NULL;
+#if TRANSACTION_QUEUE_SIZE_I2C
+        dequeue_transaction();
+#endif
+    }
+    core_util_critical_section_exit();
     unlock();
 }
 
+void I2C::clear_transfer_buffer()
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    _transaction_buffer->reset();
+#endif
+}
+
+void I2C::abort_all_transfers()
+{
+    clear_transfer_buffer();
+    abort_transfer();
+}
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+void I2C::dequeue_transaction()
+{
+    queued_transfer_t t;
+    if (_transaction_buffer->pop(t)) {
+        t.obj->start_transfer(t.address, t.tx_buffer, t.tx_length, t.rx_buffer, t.rx_length, t.callback, t.event, t.repeated);
+    }
+}
+
+#endif
+
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
@@ -241,6 +316,11 @@ void I2C::irq_handler_asynch(void)
 
     if (event) {
         unlock_deep_sleep();
+        // The bus is free, start the next pending transfer
+        _transfer_owner = NULL;
+#if TRANSACTION_QUEUE_SIZE_I2C
+        dequeue_transaction();
+#endif
     }
 }
 
@@ -15,6 +15,10 @@
  * limitations under the License.
  */
 #include "drivers/InterruptIn.h"
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_power_mgmt.h"
 
 #if DEVICE_INTERRUPTIN
 
@@ -47,6 +51,11 @@ InterruptIn::InterruptIn(PinName pin, PinMode mode) :
 
 void InterruptIn::irq_init(PinName pin)
 {
+#if DEVICE_USTICKER
+    _capture_buffer = nullptr;
+    _capture_rise = false;
+    _capture_fall = false;
+#endif
     gpio_irq_init(&gpio_irq, pin, (&InterruptIn::_irq_handler), (uint32_t)this);
 }
 
@@ -54,6 +63,11 @@ InterruptIn::~InterruptIn()
 {
     // No lock needed in the destructor
     gpio_irq_free(&gpio_irq);
+#if DEVICE_USTICKER
+    if (_capture_buffer) {
+        sleep_manager_unlock_deep_sleep();
+    }
+#endif
 }
 
 int InterruptIn::read()
@@ -77,7 +91,12 @@ void InterruptIn::rise(Callback<void()> func)
         gpio_irq_set(&gpio_irq, IRQ_RISE, 1);
     } else {
         _rise = nullptr;
+#if DEVICE_USTICKER
+        // keep the interrupt if the edge is being captured
+        gpio_irq_set(&gpio_irq, IRQ_RISE, _capture_rise ? 1 : 0);
+#else
         gpio_irq_set(&gpio_irq, IRQ_RISE, 0);
+#endif
     }
     core_util_critical_section_exit();
 }
@@ -90,7 +109,12 @@ void InterruptIn::fall(Callback<void()> func)
         gpio_irq_set(&gpio_irq, IRQ_FALL, 1);
     } else {
         _fall = nullptr;
+#if DEVICE_USTICKER
+        // keep the interrupt if the edge is being captured
+        gpio_irq_set(&gpio_irq, IRQ_FALL, _capture_fall ? 1 : 0);
+#else
         gpio_irq_set(&gpio_irq, IRQ_FALL, 0);
+#endif
     }
     core_util_critical_section_exit();
 }
@@ -98,6 +122,11 @@ void InterruptIn::fall(Callback<void()> func)
 void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event)
 {
     InterruptIn *handler = (InterruptIn *)id;
+#if DEVICE_USTICKER
+    if (handler->_capture_buffer) {
+        handler->capture_edge(event);
+    }
+#endif
     switch (event) {
         case IRQ_RISE:
             if (handler->_rise) {
@@ -114,6 +143,102 @@ void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event)
     }
 }
 
+#if DEVICE_USTICKER
+void InterruptIn::capture_edge(gpio_irq_event event)
+{
+    // read the time first so it doesn't depend on the checks below
+    us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+
+    bool rising = event == IRQ_RISE;
+    if (event == IRQ_NONE || !(rising ? _capture_rise : _capture_fall)) {
+        return;
+    }
+
+    if (now - _capture_last < _capture_debounce) {
+        return;
+    }
+    _capture_last = now;
+
+    uint32_t next = _capture_head + 1;
+    if (next == _capture_size) {
+        next = 0;
+    }
+    if (next == core_util_atomic_load_u32(&_capture_tail)) {
+        _capture_dropped++;
+        return;
+    }
+
+    _capture_buffer[_capture_head].timestamp = now;
+    _capture_buffer[_capture_head].rising = rising;
+    // publish the edge to read_edges() only once it is written
+    core_util_atomic_store_u32(&_capture_head, next);
+}
+
+void InterruptIn::capture(Span<edge_t> buffer, bool rise, bool fall, std::chrono::microseconds debounce)
+{
+    MBED_ASSERT(buffer.size() > 1);
+
+    core_util_critical_section_enter();
+    if (!_capture_buffer) {
+        sleep_manager_lock_deep_sleep();
+    }
+    _capture_buffer = buffer.data();
+    _capture_size = buffer.size();
+    _capture_head = 0;
+    _capture_tail = 0;
+    _capture_dropped = 0;
+    _capture_debounce = (uint32_t)debounce.count();
+    // let the first edge through the debounce check
+    _capture_last = ticker_read_us(get_us_ticker_data()) - _capture_debounce;
+    _capture_rise = rise;
+    _capture_fall = fall;
+    gpio_irq_set(&gpio_irq, IRQ_RISE, (rise || _rise) ? 1 : 0);
+    gpio_irq_set(&gpio_irq, IRQ_FALL, (fall || _fall) ? 1 : 0);
+    core_util_critical_section_exit();
+}
+
+void InterruptIn::capture_stop()
+{
+    core_util_critical_section_enter();
+    if (_capture_buffer) {
+        _capture_buffer = nullptr;
+        _capture_rise = false;
+        _capture_fall = false;
+        gpio_irq_set(&gpio_irq, IRQ_RISE, _rise ? 1 : 0);
+        gpio_irq_set(&gpio_irq, IRQ_FALL, _fall ? 1 : 0);
+        sleep_manager_unlock_deep_sleep();
+    }
+    core_util_critical_section_exit();
+}
+
+size_t InterruptIn::read_edges(Span<edge_t> edges)
+{
+    // Only the interrupt handler moves the head, and only this moves the
+    // tail, so no lock is needed
+    const edge_t *buffer = _capture_buffer;
+    if (!buffer) {
+        return 0;
+    }
+
+    uint32_t head = core_util_atomic_load_u32(&_capture_head);
+    uint32_t tail = _capture_tail;
+    size_t count = 0;
+    while (tail != head && count < (size_t)edges.size()) {
+        edges[count++] = buffer[tail];
+        if (++tail == _capture_size) {
+            tail = 0;
+        }
+    }
+    core_util_atomic_store_u32(&_capture_tail, tail);
+    return count;
+}
+
+uint32_t InterruptIn::dropped_edges() const
+{
+    return core_util_atomic_load_u32(&_capture_dropped);
+}
+#endif
+
 void InterruptIn::enable_irq()
 {
     core_util_critical_section_enter();
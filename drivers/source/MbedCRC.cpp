@@ -23,10 +23,25 @@ namespace mbed {
 
 SingletonPtr<PlatformMutex> mbed_crc_mutex;
 
-MBED_STATIC_ASSERT(MBED_CRC_TABLE_SIZE == 0 || MBED_CRC_TABLE_SIZE == 16 || MBED_CRC_TABLE_SIZE == 256,
-                   "Configuration setting drivers.crc-table-size must be set to 0, 16 or 256");
+#if DEVICE_CRC_ASYNCH
+bool mbed_crc_async_active;
+Callback<void(uint32_t)> mbed_crc_async_callback;
 
-#if MBED_CRC_TABLE_SIZE > 0
+void mbed_crc_async_handler(void)
+{
+    uint32_t crc = hal_crc_get_result();
+    Callback<void(uint32_t)> callback = mbed_crc_async_callback;
+    core_util_atomic_store_bool(&mbed_crc_async_active, false);
+    if (callback) {
+        callback(crc);
+    }
+}
+#endif
+
+MBED_STATIC_ASSERT(MBED_CRC_TABLE_SIZE == 0 || MBED_CRC_TABLE_SIZE == 16 || MBED_CRC_TABLE_SIZE == 256 || MBED_CRC_TABLE_SIZE == 1024,
+                   "Configuration setting drivers.crc-table-size must be set to 0, 16, 256 or 1024");
+
+#if MBED_CRC_TABLE_SIZE > 0 && MBED_CRC_TABLE_SIZE <= 256
 
 /* Tables are arranged for LSB first input. This means they're optimised
  * for reflect_data == true and reflect_result == true. If using 16-entry
@@ -143,7 +158,7 @@ const uint32_t MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE>::_crc_table[MBED_CRC
 
 } // namespace impl
 
-#endif // MBED_CRC_TABLE_SIZE > 0
+#endif // MBED_CRC_TABLE_SIZE > 0 && MBED_CRC_TABLE_SIZE <= 256
 
 } // namespace mbed
 
@@ -31,11 +31,19 @@ PwmOut::PwmOut(PinName pin) :
     _deep_sleep_locked(false),
     _initialized(false),
     _duty_cycle(0)
+#if DEVICE_PWMOUT_STREAM
+    , _stream_buffer(nullptr),
+    _stream_length(0)
+#endif
 {
     PwmOut::init();
 }
 
 PwmOut::PwmOut(const PinMap &pinmap) : _deep_sleep_locked(false)
+#if DEVICE_PWMOUT_STREAM
+    , _stream_buffer(nullptr),
+    _stream_length(0)
+#endif
 {
     core_util_critical_section_enter();
     pwmout_init_direct(&_pwm, &pinmap);
@@ -124,6 +132,54 @@ void PwmOut::resume()
     core_util_critical_section_exit();
 }
 
+#if DEVICE_PWMOUT_STREAM
+
+uint32_t PwmOut::period_ticks()
+{
+    core_util_critical_section_enter();
+    uint32_t ticks = pwmout_stream_period_ticks(&_pwm);
+    core_util_critical_section_exit();
+    return ticks;
+}
+
+bool PwmOut::stream_start(uint16_t *buffer, size_t length, Callback<void(uint16_t *, size_t)> refill)
+{
+    MBED_ASSERT(length >= 2 && length % 2 == 0);
+
+    core_util_critical_section_enter();
+    pwmout_stream_stop(&_pwm);
+    _stream_buffer = buffer;
+    _stream_length = length;
+    _stream_refill = refill;
+    bool started = pwmout_stream_start(&_pwm, buffer, length, stream_handler, this) == 0;
+    if (!started) {
+        _stream_buffer = nullptr;
+    }
+    core_util_critical_section_exit();
+    return started;
+}
+
+void PwmOut::stream_stop()
+{
+    core_util_critical_section_enter();
+    if (_stream_buffer) {
+        pwmout_stream_stop(&_pwm);
+        _stream_buffer = nullptr;
+    }
+    core_util_critical_section_exit();
+}
+
+void PwmOut::stream_handler(pwmout_t *, uint32_t half, void *context)
+{
+    PwmOut *pwm = static_cast<PwmOut *>(context);
+    size_t half_length = pwm->_stream_length / 2;
+    if (pwm->_stream_buffer && pwm->_stream_refill) {
+        pwm->_stream_refill(pwm->_stream_buffer + half * half_length, half_length);
+    }
+}
+
+#endif
+
 void PwmOut::lock_deep_sleep()
 {
     if (_deep_sleep_locked == false) {
@@ -158,6 +214,9 @@ void PwmOut::deinit()
     core_util_critical_section_enter();
 
     if (_initialized) {
+#if DEVICE_PWMOUT_STREAM
+        stream_stop();
+#endif
         pwmout_free(&_pwm);
         unlock_deep_sleep();
         _initialized = false;
@@ -25,6 +25,9 @@ namespace mbed {
 
 QSPI *QSPI::_owner = NULL;
 SingletonPtr<PlatformMutex> QSPI::_mutex;
+#if DEVICE_QSPI_MEMORY_MAPPED
+bool QSPI::_mapped = false;
+#endif
 
 uint8_t convert_bus_width_to_line_count(qspi_bus_width_t width)
 {
@@ -35,6 +38,10 @@ uint8_t convert_bus_width_to_line_count(qspi_bus_width_t width)
             return 2;
         case QSPI_CFG_BUS_QUAD:
             return 4;
+#if DEVICE_QSPI_OCTAL
+        case QSPI_CFG_BUS_OCTAL:
+            return 8;
+#endif
         default:
             // Unrecognized bus width
             return 0;
@@ -47,6 +54,12 @@ QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, Pin
     _qspi_io1 = io1;
     _qspi_io2 = io2;
     _qspi_io3 = io3;
+#if DEVICE_QSPI_OCTAL
+    _qspi_io4 = NC;
+    _qspi_io5 = NC;
+    _qspi_io6 = NC;
+    _qspi_io7 = NC;
+#endif
     _qspi_clk = sclk;
     _qspi_cs = ssel;
     _static_pinmap = NULL;
@@ -56,6 +69,9 @@ QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, Pin
     _alt_width = QSPI_CFG_BUS_SINGLE;
     _alt_size = 0;
     _data_width = QSPI_CFG_BUS_SINGLE;
+    _inst_dtr = false;
+    _address_dtr = false;
+    _data_dtr = false;
     _num_dummy_cycles = 0;
     _mode = mode;
     _hz = ONE_MHZ;
@@ -73,6 +89,12 @@ QSPI::QSPI(const qspi_pinmap_t &pinmap, int mode) : _qspi()
     _qspi_io1 = pinmap.data1_pin;
     _qspi_io2 = pinmap.data2_pin;
     _qspi_io3 = pinmap.data3_pin;
+#if DEVICE_QSPI_OCTAL
+    _qspi_io4 = NC;
+    _qspi_io5 = NC;
+    _qspi_io6 = NC;
+    _qspi_io7 = NC;
+#endif
     _qspi_clk = pinmap.sclk_pin;
     _qspi_cs = pinmap.ssel_pin;
     _static_pinmap = &pinmap;
@@ -82,6 +104,9 @@ QSPI::QSPI(const qspi_pinmap_t &pinmap, int mode) : _qspi()
     _alt_width = QSPI_CFG_BUS_SINGLE;
     _alt_size = QSPI_CFG_ALT_SIZE_8;
     _data_width = QSPI_CFG_BUS_SINGLE;
+    _inst_dtr = false;
+    _address_dtr = false;
+    _data_dtr = false;
     _num_dummy_cycles = 0;
     _mode = mode;
     _hz = ONE_MHZ;
@@ -93,8 +118,56 @@ QSPI::QSPI(const qspi_pinmap_t &pinmap, int mode) : _qspi()
     MBED_ASSERT(success);
 }
 
+#if DEVICE_QSPI_OCTAL
+QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName io4, PinName io5, PinName io6, PinName io7,
+           PinName sclk, PinName ssel, int mode) : _qspi()
+{
+    _qspi_io0 = io0;
+    _qspi_io1 = io1;
+    _qspi_io2 = io2;
+    _qspi_io3 = io3;
+    _qspi_io4 = io4;
+    _qspi_io5 = io5;
+    _qspi_io6 = io6;
+    _qspi_io7 = io7;
+    _qspi_clk = sclk;
+    _qspi_cs = ssel;
+    _static_pinmap = NULL;
+    _inst_width = QSPI_CFG_BUS_SINGLE;
+    _address_width = QSPI_CFG_BUS_SINGLE;
+    _address_size = QSPI_CFG_ADDR_SIZE_24;
+    _alt_width = QSPI_CFG_BUS_SINGLE;
+    _alt_size = 0;
+    _data_width = QSPI_CFG_BUS_SINGLE;
+    _inst_dtr = false;
+    _address_dtr = false;
+    _data_dtr = false;
+    _num_dummy_cycles = 0;
+    _mode = mode;
+    _hz = ONE_MHZ;
+    _initialized = false;
+    _init_func = &QSPI::_initialize_octal;
+
+    //Go ahead init the device here with the default config
+    bool success = (this->*_init_func)();
+    MBED_ASSERT(success);
+}
+#endif
+
 qspi_status_t QSPI::configure_format(qspi_bus_width_t inst_width, qspi_bus_width_t address_width, qspi_address_size_t address_size, qspi_bus_width_t alt_width, qspi_alt_size_t alt_size, qspi_bus_width_t data_width, int dummy_cycles)
 {
+    if (convert_bus_width_to_line_count(inst_width) == 0 || convert_bus_width_to_line_count(address_width) == 0 ||
+            convert_bus_width_to_line_count(data_width) == 0) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+#if DEVICE_QSPI_OCTAL
+    // The octal width needs the upper data lines
+    if (_qspi_io7 == NC && (inst_width == QSPI_CFG_BUS_OCTAL || address_width == QSPI_CFG_BUS_OCTAL ||
+                            alt_width == QSPI_CFG_BUS_OCTAL || data_width == QSPI_CFG_BUS_OCTAL)) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+#endif
+
     // Check that alt_size/alt_width are a valid combination
     uint8_t alt_lines = convert_bus_width_to_line_count(alt_width);
     if (alt_lines == 0) {
@@ -117,6 +190,23 @@ qspi_status_t QSPI::configure_format(qspi_bus_width_t inst_width, qspi_bus_width
     return QSPI_STATUS_OK;
 }
 
+qspi_status_t QSPI::configure_dtr(bool inst_dtr, bool address_dtr, bool data_dtr)
+{
+#if !DEVICE_QSPI_DTR
+    if (inst_dtr || address_dtr || data_dtr) {
+        return QSPI_STATUS_INVALID_PARAMETER;
+    }
+#endif
+
+    lock();
+    _inst_dtr = inst_dtr;
+    _address_dtr = address_dtr;
+    _data_dtr = data_dtr;
+    unlock();
+
+    return QSPI_STATUS_OK;
+}
+
 qspi_status_t QSPI::set_frequency(int hz)
 {
     qspi_status_t ret_status = QSPI_STATUS_OK;
@@ -127,6 +217,9 @@ qspi_status_t QSPI::set_frequency(int hz)
         //If the same owner, just change freq.
         //Otherwise we may have to change mode as well, so call _acquire
         if (_owner == this) {
+#if DEVICE_QSPI_MEMORY_MAPPED
+            _unmap();
+#endif
             if (QSPI_STATUS_OK != qspi_frequency(&_qspi, _hz)) {
                 ret_status = QSPI_STATUS_ERROR;
             }
@@ -303,9 +396,35 @@ bool QSPI::_initialize_direct()
     return _initialized;
 }
 
+#if DEVICE_QSPI_OCTAL
+// Note: Private helper function to initialize qspi HAL
+bool QSPI::_initialize_octal()
+{
+    if (_mode != 0 && _mode != 1) {
+        _initialized = false;
+        return _initialized;
+    }
+
+    qspi_status_t ret = qspi_init_octal(&_qspi, _qspi_io0, _qspi_io1, _qspi_io2, _qspi_io3,
+                                        _qspi_io4, _qspi_io5, _qspi_io6, _qspi_io7, _qspi_clk, _qspi_cs, _hz, _mode);
+    if (QSPI_STATUS_OK == ret) {
+        _initialized = true;
+        _owner = this;
+    } else {
+        _initialized = false;
+    }
+
+    return _initialized;
+}
+#endif
+
 // Note: Private function with no locking
 bool QSPI::_acquire()
 {
+#if DEVICE_QSPI_MEMORY_MAPPED
+    // Every operation other than reading the mapping needs indirect mode
+    _unmap();
+#endif
     if (_owner != this) {
         //This will set freq as well
         (this->*_init_func)();
@@ -315,6 +434,55 @@ bool QSPI::_acquire()
     return _initialized;
 }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+qspi_status_t QSPI::map(qspi_inst_t instruction, int alt, const void **base, size_t *size)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if ((base != NULL) && (size != NULL)) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, 0, alt);
+                if (QSPI_STATUS_OK == qspi_memory_mapped_enable(&_qspi, &_qspi_command, base, size)) {
+                    _mapped = true;
+                    ret_status = QSPI_STATUS_OK;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::unmap()
+{
+    qspi_status_t ret_status = QSPI_STATUS_OK;
+
+    lock();
+    if (_mapped && _owner == this) {
+        if (QSPI_STATUS_OK != qspi_memory_mapped_disable(&_qspi)) {
+            ret_status = QSPI_STATUS_ERROR;
+        }
+        _mapped = false;
+    }
+    unlock();
+
+    return ret_status;
+}
+
+void QSPI::_unmap()
+{
+    if (_mapped) {
+        qspi_memory_mapped_disable(&_owner->_qspi);
+        _mapped = false;
+    }
+}
+#endif
+
 void QSPI::_build_qspi_command(qspi_inst_t instruction, int address, int alt)
 {
     memset(&_qspi_command, 0,  sizeof(qspi_command_t));
@@ -326,6 +494,7 @@ void QSPI::_build_qspi_command(qspi_inst_t instruction, int address, int alt)
     } else {
         _qspi_command.instruction.disabled = true;
     }
+    _qspi_command.instruction.dtr = _inst_dtr;
 
     //Set up address phase parameters
     _qspi_command.address.bus_width = _address_width;
@@ -336,6 +505,7 @@ void QSPI::_build_qspi_command(qspi_inst_t instruction, int address, int alt)
     } else {
         _qspi_command.address.disabled = true;
     }
+    _qspi_command.address.dtr = _address_dtr;
 
     //Set up alt phase parameters
     _qspi_command.alt.bus_width = _alt_width;
@@ -346,11 +516,13 @@ void QSPI::_build_qspi_command(qspi_inst_t instruction, int address, int alt)
     } else {
         _qspi_command.alt.disabled = true;
     }
+    _qspi_command.alt.dtr = _address_dtr;
 
     _qspi_command.dummy_count = _num_dummy_cycles;
 
     //Set up bus width for data phase
     _qspi_command.data.bus_width = _data_width;
+    _qspi_command.data.dtr = _data_dtr;
 }
 
 } // namespace mbed
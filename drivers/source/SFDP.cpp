@@ -59,6 +59,13 @@ constexpr int SFDP_BASIC_PARAM_TABLE_4K_ERASE_TYPE_BYTE = 1; ///< 4 Kilobyte Era
 
 constexpr int SFDP_ERASE_BITMASK_TYPE_4K_ERASE_UNSUPPORTED = 0xFF;
 
+// xSPI Profile 1.0 Params
+constexpr int SFDP_XSPI_PROFILE_TBL_SIZE = 20; ///< Parsed part of the xSPI Profile 1.0 table, 5 DWORDS
+constexpr int SFDP_XSPI_PROFILE_READ_INST_BYTE = 1; ///< 8D-8D-8D Fast Read Instruction
+constexpr int SFDP_XSPI_PROFILE_DUMMY_200MHZ_BYTE = 12; ///< Dummy cycles at 200MHz, bits 11:7 of DWORD4
+constexpr int SFDP_XSPI_PROFILE_DUMMY_BYTE = 16; ///< Dummy cycles at 166/133/100MHz, DWORD5
+constexpr int SFDP_XSPI_PROFILE_DEFAULT_DUMMY_CYCLES = 20; ///< Dummy cycles the profile requires at power up
+
 /** SFDP Header */
 struct sfdp_hdr {
     uint8_t SIG_B0; ///< SFDP Signature, Byte 0
@@ -138,7 +145,9 @@ int sfdp_parse_single_param_header(sfdp_prm_hdr *phdr_ptr, sfdp_hdr_info &hdr_in
                 tr_info("UNSUPPORTED:Parameter header: 4-byte Address Instruction");
                 break;
             case 0x05:
-                tr_info("UNSUPPORTED:Parameter header: eXtended Serial Peripheral Interface (xSPI) Profile 1.0");
+                tr_info("Parameter header: eXtended Serial Peripheral Interface (xSPI) Profile 1.0");
+                hdr_info.xspi.addr = sfdp_get_param_tbl_ptr(phdr_ptr->DWORD2);
+                hdr_info.xspi.size = std::min((phdr_ptr->P_LEN * 4), SFDP_XSPI_PROFILE_TBL_SIZE);
                 break;
             case 0x06:
                 tr_info("UNSUPPORTED:Parameter header: eXtended Serial Peripheral Interface (xSPI) Profile 2.0");
@@ -179,7 +188,7 @@ int sfdp_parse_single_param_header(sfdp_prm_hdr *phdr_ptr, sfdp_hdr_info &hdr_in
     return 0;
 }
 
-int sfdp_parse_headers(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info)
+int sfdp_parse_headers(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info)
 {
     bd_addr_t addr = 0x0;
     int number_of_param_headers = 0;
@@ -229,7 +238,7 @@ int sfdp_parse_headers(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader,
     return 0;
 }
 
-int sfdp_parse_sector_map_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info)
+int sfdp_parse_sector_map_table(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info)
 {
     uint32_t tmp_region_size = 0;
     uint8_t type_mask;
@@ -310,6 +319,55 @@ int sfdp_parse_sector_map_table(Callback<int(bd_addr_t, void *, bd_size_t)> sfdp
     return 0;
 }
 
+int sfdp_parse_xspi_profile_table(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info)
+{
+    sfdp_info.xspi.read_8d8d8d_inst = -1;
+    sfdp_info.xspi.read_8d8d8d_dummy_cycles = 0;
+
+    if (!sfdp_info.xspi.addr || sfdp_info.xspi.size < SFDP_XSPI_PROFILE_TBL_SIZE) {
+        tr_debug("No xSPI Profile 1.0 Table");
+        return MBED_SUCCESS;
+    }
+
+    uint8_t xspi_table[SFDP_XSPI_PROFILE_TBL_SIZE];
+
+    int status = sfdp_reader(sfdp_info.xspi.addr, xspi_table, SFDP_XSPI_PROFILE_TBL_SIZE);
+    if (status < 0) {
+        tr_error("xSPI Profile: Table retrieval failed");
+        return -1;
+    }
+
+    if (!xspi_table[SFDP_XSPI_PROFILE_READ_INST_BYTE]) {
+        tr_debug("xSPI Profile: no 8D-8D-8D Fast Read");
+        return 0;
+    }
+    sfdp_info.xspi.read_8d8d8d_inst = xspi_table[SFDP_XSPI_PROFILE_READ_INST_BYTE];
+
+    // Use the wait states of the highest frequency listed, the bus may run at any frequency up to it
+    uint32_t dword4 = *((uint32_t *)&xspi_table[SFDP_XSPI_PROFILE_DUMMY_200MHZ_BYTE]);
+    uint32_t dword5 = *((uint32_t *)&xspi_table[SFDP_XSPI_PROFILE_DUMMY_BYTE]);
+    int dummy_cycles = (dword4 >> 7) & 0x1F;
+    if (!dummy_cycles) {
+        dummy_cycles = (dword5 >> 27) & 0x1F;
+    }
+    if (!dummy_cycles) {
+        dummy_cycles = (dword5 >> 17) & 0x1F;
+    }
+    if (!dummy_cycles) {
+        dummy_cycles = (dword5 >> 7) & 0x1F;
+    }
+    if (!dummy_cycles) {
+        dummy_cycles = SFDP_XSPI_PROFILE_DEFAULT_DUMMY_CYCLES;
+    }
+    // A DTR data phase starts on a rising edge, so the count has to be even
+    sfdp_info.xspi.read_8d8d8d_dummy_cycles = (dummy_cycles + 1) & ~1;
+
+    tr_debug("xSPI Profile: 8D-8D-8D Fast Read Instruction: 0x%xh, dummy cycles: %d",
+             sfdp_info.xspi.read_8d8d8d_inst, sfdp_info.xspi.read_8d8d8d_dummy_cycles);
+
+    return 0;
+}
+
 size_t sfdp_detect_page_size(uint8_t *basic_param_table_ptr, size_t basic_param_table_size)
 {
     constexpr int SFDP_BASIC_PARAM_TABLE_PAGE_SIZE = 40;
@@ -397,26 +455,33 @@ int sfdp_iterate_next_largest_erase_type(uint8_t &bitfield,
                                          int region,
                                          const sfdp_smptbl_info &smptbl)
 {
-    uint8_t type_mask = SFDP_ERASE_BITMASK_TYPE4;
-    int largest_erase_type = 0;
+    int largest_erase_type = -1;
+    int smallest_erase_type = -1;
 
-    int idx;
-    for (idx = 3; idx >= 0; idx--) {
-        if (bitfield & type_mask) {
+    for (int idx = 0; idx < SFDP_MAX_NUM_OF_ERASE_TYPES; idx++) {
+        if (!(bitfield & (SFDP_ERASE_BITMASK_TYPE1 << idx))) {
+            continue;
+        }
+
+        unsigned int eu_size = smptbl.erase_type_size_arr[idx];
+        if (!eu_size) {
+            continue;
+        }
+        if (smallest_erase_type < 0 || eu_size < smptbl.erase_type_size_arr[smallest_erase_type]) {
+            smallest_erase_type = idx;
+        }
+
+        // The whole unit must be inside the requested range and the region, so it must start at offset
+        if ((offset % eu_size) == 0 && size >= (int)eu_size &&
+                (smptbl.region_high_boundary[region] - offset) >= (eu_size - 1) &&
+                (largest_erase_type < 0 || eu_size > smptbl.erase_type_size_arr[largest_erase_type])) {
             largest_erase_type = idx;
-            if ((size > (int)(smptbl.erase_type_size_arr[largest_erase_type])) &&
-                    ((smptbl.region_high_boundary[region] - offset)
-                     > (int)(smptbl.erase_type_size_arr[largest_erase_type]))) {
-                break;
-            } else {
-                bitfield &= ~type_mask;
-            }
         }
-        type_mask = type_mask >> 1;
     }
 
-    if (idx == -1) {
+    if (largest_erase_type < 0) {
         tr_error("No erase type was found for current region addr");
+        largest_erase_type = smallest_erase_type < 0 ? 0 : smallest_erase_type;
     }
     return largest_erase_type;
 }
@@ -120,6 +120,9 @@ void SPI::_do_construct()
 #if DEVICE_SPI_ASYNCH
     _usage = DMA_USAGE_NEVER;
     _deep_sleep_locked = false;
+    _batch = nullptr;
+    _batch_count = 0;
+    _batch_event = 0;
 #endif
     _select_count = 0;
     _bits = 8;
@@ -287,9 +290,43 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_batch(const spi_batch_segment_t *segments, size_t count, const event_callback_t &callback, int event)
+{
+    MBED_ASSERT(count > 0);
+
+    core_util_critical_section_enter();
+    if (spi_active(&_peripheral->spi)) {
+        core_util_critical_section_exit();
+        return -1;
+    }
+    lock_deep_sleep();
+    _acquire();
+    _set_ssel(0);
+    _callback = callback;
+    _batch = segments;
+    _batch_count = count;
+    _batch_event = event;
+    _irq.callback(&SPI::irq_handler_asynch);
+    start_batch_segment();
+    core_util_critical_section_exit();
+    return 0;
+}
+
+void SPI::start_batch_segment()
+{
+    const spi_batch_segment_t *segment = _batch;
+    // Intermediate segments report completion and errors so the batch can
+    // move on or stop, only the last one uses the caller's mask
+    int event = _batch_count > 1 ? SPI_EVENT_ALL : _batch_event;
+    spi_master_transfer(&_peripheral->spi, segment->tx_buffer, segment->tx_length, segment->rx_buffer, segment->rx_length,
+                        segment->bit_width, _irq.entry(), event, _usage);
+}
+
 void SPI::abort_transfer()
 {
     spi_abort_asynch(&_peripheral->spi);
+    _batch = nullptr;
+    _batch_count = 0;
     unlock_deep_sleep();
 #if TRANSACTION_QUEUE_SIZE_SPI
     dequeue_transaction();
@@ -395,8 +432,34 @@ void SPI::dequeue_transaction()
 void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_peripheral->spi);
+    if (_batch) {
+        int done = event & SPI_EVENT_ALL;
+        if (_batch_count > 1 && done) {
+            if (done == SPI_EVENT_COMPLETE) {
+                // Chain the next segment without releasing the peripheral
+                if (_batch->deselect_after) {
+                    _set_ssel(1);
+                    _set_ssel(0);
+                }
+                _batch++;
+                _batch_count--;
+                start_batch_segment();
+                return;
+            }
+            // A segment failed, report it with the caller's mask
+            event = (done & _batch_event) | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE;
+        }
+        if (event & (SPI_EVENT_ALL | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE)) {
+            _batch = nullptr;
+            _batch_count = 0;
+        }
+    }
     if (_callback && (event & SPI_EVENT_ALL)) {
-        _set_ssel(1);
+        // a transfer started between select() and deselect() leaves the
+        // slave selected for the blocking calls which follow it
+        if (_select_count == 0) {
+            _set_ssel(1);
+        }
         unlock_deep_sleep();
         _callback.call(event & SPI_EVENT_ALL);
     }
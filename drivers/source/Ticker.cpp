@@ -51,17 +51,23 @@ void TickerBase::setup(microseconds t)
 {
     remove();
     _delay = t;
-    insert_absolute(_ticker_data.now() + t);
+    insert_absolute(_ticker_data.now() + t, _slack);
 }
 
 void TickerBase::setup_absolute(TickerDataClock::time_point t)
 {
     remove();
-    insert_absolute(t);
+    insert_absolute(t, _slack);
+}
+
+void TickerBase::set_slack(microseconds slack)
+{
+    _slack = slack;
 }
 
 void TickerBase::handler()
 {
+    // periodic reschedules stay exact, so a Ticker never drifts
     insert_absolute(get_time_point(event) + _delay);
     if (_function) {
         _function();
@@ -60,6 +60,11 @@ void TimerEvent::insert_absolute(TickerDataClock::time_point timestamp)
     _ticker_data.insert_event(&event, timestamp, (uint32_t)this);
 }
 
+TickerDataClock::time_point TimerEvent::insert_absolute(TickerDataClock::time_point timestamp, microseconds slack)
+{
+    return _ticker_data.insert_event_coalesced(&event, timestamp, slack, (uint32_t)this);
+}
+
 void TimerEvent::remove()
 {
     _ticker_data.remove_event(&event);
@@ -46,7 +46,14 @@ void EndpointResolver::endpoint_ctrl(uint32_t size)
 
 usb_ep_t EndpointResolver::next_free_endpoint(bool in_not_out, usb_ep_type_t type, uint32_t size)
 {
-    int index = next_index(type, in_not_out);
+    int index = -1;
+    if (type == USB_EP_TYPE_BULK) {
+        // Bulk throughput benefits the most from a double buffered endpoint
+        index = next_index(type, in_not_out, USB_EP_ATTR_DOUBLE_BUFFER);
+    }
+    if (index < 0) {
+        index = next_index(type, in_not_out, 0);
+    }
     if (index < 0) {
         _valid = false;
         return 0;
@@ -86,7 +93,7 @@ usb_ep_t EndpointResolver::index_to_endpoint(int index)
     return index_to_logical(index) | ((index & 1) ? 0x80 : 0);
 }
 
-int EndpointResolver::next_index(usb_ep_type_t type, bool in_not_out)
+int EndpointResolver::next_index(usb_ep_type_t type, bool in_not_out, usb_ep_attr_t required)
 {
     for (int logical = 0; logical < (int)(sizeof(_table->table) / sizeof(_table->table[0])); logical++) {
         uint32_t index = logical_to_index(logical, in_not_out);
@@ -103,6 +110,11 @@ int EndpointResolver::next_index(usb_ep_type_t type, bool in_not_out)
             continue;
         }
 
+        if ((entry.attributes & required) != required) {
+            // Missing a required attribute
+            continue;
+        }
+
         if (in_not_out && !in_allowed) {
             // In endpoint not supported
             continue;
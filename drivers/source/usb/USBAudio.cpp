@@ -27,6 +27,15 @@
 #define WRITE_READY_UNBLOCK         (1 << 0)
 #define READ_READY_UNBLOCK          (1 << 1)
 
+// Feedback in frames per millisecond, 10.14 format on full speed
+#define FEEDBACK_SIZE               3
+#define FEEDBACK_FRACT_BITS         14
+// The host reads the feedback every 2^FEEDBACK_REFRESH milliseconds
+#define FEEDBACK_REFRESH            5
+// Endpoint bmAttributes sync type and usage bits
+#define E_SYNC_ASYNCHRONOUS         (1 << 2)
+#define E_USAGE_FEEDBACK            (1 << 4)
+
 class USBAudio::AsyncWrite: public AsyncOp {
 public:
     AsyncWrite(USBAudio *audio, uint8_t *buf, uint32_t size):
@@ -182,8 +191,18 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
     resolver.endpoint_ctrl(64);
     _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _tx_packet_size_max);
     _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _rx_packet_size_max);
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+    _episo_feedback = resolver.endpoint_in(USB_EP_TYPE_ISO, FEEDBACK_SIZE);
+#else
+    _episo_feedback = 0;
+#endif
     MBED_ASSERT(resolver.valid());
 
+    _feedback_nominal = ((uint64_t)_rx_freq << FEEDBACK_FRACT_BITS) / XFER_FREQUENCY_HZ;
+    _feedback = _feedback_nominal;
+    _rx_fill_avg = 0;
+    _feedback_busy = false;
+
     _channel_config_rx = (_rx_channel_count == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
     _channel_config_tx = (_tx_channel_count == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
 
@@ -268,6 +287,16 @@ uint32_t USBAudio::read_overflows(bool clear)
 }
 
 
+float USBAudio::read_feedback_rate()
+{
+    lock();
+
+    float rate = (float)_feedback * XFER_FREQUENCY_HZ / (1 << FEEDBACK_FRACT_BITS);
+
+    unlock();
+    return rate;
+}
+
 bool USBAudio::read_ready()
 {
     lock();
@@ -545,6 +574,10 @@ void USBAudio::callback_set_configuration(uint8_t configuration)
         // Configure isochronous endpoint
         endpoint_add(_episo_out, _rx_packet_size_max, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_receive_isr));
         endpoint_add(_episo_in, _tx_packet_size_max, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_send_isr));
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+        endpoint_add(_episo_feedback, FEEDBACK_SIZE, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_feedback_isr));
+#endif
+        _feedback_busy = false;
 
         // activate readings on this endpoint
         read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
@@ -609,6 +642,7 @@ const uint8_t *USBAudio::string_iproduct_desc()
                                + (2 * STREAMING_INTERFACE_DESCRIPTOR_LENGTH) \
                                + (2 * FORMAT_TYPE_I_DESCRIPTOR_LENGTH) \
                                + (2 * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) \
+                               + (MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK ? ENDPOINT_DESCRIPTOR_LENGTH + 2 : 0) \
                                + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) )
 
 #define TOTAL_CONTROL_INTF_LENGTH    (CONTROL_INTERFACE_DESCRIPTOR_LENGTH + 1 + \
@@ -738,7 +772,7 @@ void USBAudio::_build_configuration_desc()
         INTERFACE_DESCRIPTOR,                   // bDescriptorType
         0x01,                                   // bInterfaceNumber
         0x01,                                   // bAlternateSetting
-        0x01,                                   // bNumEndpoints
+        MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK ? 0x02 : 0x01, // bNumEndpoints
         AUDIO_CLASS,                            // bInterfaceClass
         SUBCLASS_AUDIOSTREAMING,                // bInterfaceSubClass
         0x00,                                   // bInterfaceProtocol
@@ -770,12 +804,16 @@ void USBAudio::_build_configuration_desc()
         ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
         ENDPOINT_DESCRIPTOR,                    // bDescriptorType
         _episo_out,                             // bEndpointAddress
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+        E_ISOCHRONOUS | E_SYNC_ASYNCHRONOUS,    // bmAttributes
+#else
         E_ISOCHRONOUS,                          // bmAttributes
+#endif
         (uint8_t)(LSB(_rx_packet_size_max)),    // wMaxPacketSize
         (uint8_t)(MSB(_rx_packet_size_max)),    // wMaxPacketSize
         0x01,                                   // bInterval
         0x00,                                   // bRefresh
-        0x00,                                   // bSynchAddress
+        _episo_feedback,                        // bSynchAddress
 
         // Endpoint - Audio Streaming
         STREAMING_ENDPOINT_DESCRIPTOR_LENGTH,   // bLength
@@ -786,6 +824,19 @@ void USBAudio::_build_configuration_desc()
         LSB(0x0000),                            // wLockDelay
         MSB(0x0000),                            // wLockDelay
 
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+        // Endpoint - Feedback
+        ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
+        ENDPOINT_DESCRIPTOR,                    // bDescriptorType
+        _episo_feedback,                        // bEndpointAddress
+        E_ISOCHRONOUS | E_USAGE_FEEDBACK,       // bmAttributes
+        LSB(FEEDBACK_SIZE),                     // wMaxPacketSize
+        MSB(FEEDBACK_SIZE),                     // wMaxPacketSize
+        0x01,                                   // bInterval
+        FEEDBACK_REFRESH,                       // bRefresh
+        0x00,                                   // bSynchAddress
+#endif
+
 
         // Interface 1, Alternate Setting 0, Audio Streaming - Zero Bandwith
         INTERFACE_DESCRIPTOR_LENGTH,            // bLength
@@ -874,6 +925,9 @@ void USBAudio::_receive_change(ChannelState new_state)
     }
     if (new_state == Opened) {
         // Entering the opened state
+        _rx_fill_avg = (_rx_queue.size() + _rx_queue.free()) / (_rx_channel_count * SAMPLE_SIZE) / 2 * 256;
+        _feedback = _feedback_nominal;
+        _feedback_isr_start();
         _read_list.process();
         _rx_done.call(Start);
     }
@@ -897,6 +951,7 @@ void USBAudio::_receive_isr()
 
         // Copy data over
         _rx_queue.write(_rx_packet_buf, size);
+        _feedback_update();
 
         // Signal that there is more data available
         _read_list.process();
@@ -908,6 +963,55 @@ void USBAudio::_receive_isr()
     read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
 }
 
+void USBAudio::_feedback_update()
+{
+    assert_locked();
+
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+    // Smooth the fill level, it steps by a packet on each transfer and read
+    int32_t frame_size = _rx_channel_count * SAMPLE_SIZE;
+    int32_t fill = _rx_queue.size() / frame_size * 256;
+    int32_t target = (_rx_queue.size() + _rx_queue.free()) / frame_size / 2 * 256;
+    _rx_fill_avg += (fill - _rx_fill_avg) / 16;
+
+    // Ask for the excess to drain, or the shortfall to fill, over about a second
+    int32_t correction = (target - _rx_fill_avg) / 16;
+    int32_t limit = _feedback_nominal / 64;
+    if (correction > limit) {
+        correction = limit;
+    } else if (correction < -limit) {
+        correction = -limit;
+    }
+    _feedback = _feedback_nominal + correction;
+#endif
+}
+
+void USBAudio::_feedback_isr_start()
+{
+    assert_locked();
+
+#if MBED_CONF_DRIVERS_USB_AUDIO_FEEDBACK
+    if (_feedback_busy || (_rx_state != Opened)) {
+        return;
+    }
+
+    _feedback_buf[0] = (_feedback >> 0) & 0xFF;
+    _feedback_buf[1] = (_feedback >> 8) & 0xFF;
+    _feedback_buf[2] = (_feedback >> 16) & 0xFF;
+    _feedback_busy = write_start(_episo_feedback, _feedback_buf, FEEDBACK_SIZE);
+#endif
+}
+
+void USBAudio::_feedback_isr()
+{
+    assert_locked();
+
+    write_finish(_episo_feedback);
+    _feedback_busy = false;
+
+    _feedback_isr_start();
+}
+
 void USBAudio::_send_change(ChannelState new_state)
 {
     assert_locked();
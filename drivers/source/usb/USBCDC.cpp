@@ -39,7 +39,7 @@ static const uint8_t cdc_line_coding_default[7] = {0x80, 0x25, 0x00, 0x00, 0x00,
 class USBCDC::AsyncWrite: public AsyncOp {
 public:
     AsyncWrite(USBCDC *serial, uint8_t *buf, uint32_t size):
-        serial(serial), tx_buf(buf), tx_size(size), result(false)
+        serial(serial), tx_buf(buf), tx_size(size), in_place(false), result(false)
     {
 
     }
@@ -56,11 +56,25 @@ public:
             return true;
         }
 
+        // The data sent in place must be out before the write completes
+        if (in_place) {
+            if (serial->_tx_in_progress) {
+                return false;
+            }
+            in_place = false;
+        }
+
         uint32_t actual_size = 0;
-        serial->send_nb(tx_buf, tx_size, &actual_size, true);
+        if (tx_size) {
+            serial->_send_in_place(tx_buf, tx_size, &actual_size);
+            in_place = actual_size > 0;
+        }
+        if (!in_place) {
+            serial->send_nb(tx_buf, tx_size, &actual_size, true);
+        }
         tx_size -= actual_size;
         tx_buf += actual_size;
-        if (tx_size == 0) {
+        if ((tx_size == 0) && !in_place) {
             result = true;
             return true;
         }
@@ -73,6 +87,7 @@ public:
     USBCDC *serial;
     uint8_t *tx_buf;
     uint32_t tx_size;
+    bool in_place;
     bool result;
 };
 
@@ -382,11 +397,16 @@ void USBCDC::send_nb(uint8_t *buffer, uint32_t size, uint32_t *actual, bool now)
 
     *actual = 0;
     if (_terminal_connected && !_tx_in_progress) {
-        uint32_t free = sizeof(_tx_buffer) - _tx_size;
+        uint32_t capacity = endpoint_max_transfer_size(_bulk_in);
+        if (capacity > sizeof(_tx_buffer)) {
+            capacity = sizeof(_tx_buffer);
+        }
+        uint32_t free = capacity - _tx_size;
         uint32_t write_size = free > size ? size : free;
         if (size > 0) {
             memcpy(_tx_buf, buffer, write_size);
         }
+        _tx_buf += write_size;
         _tx_size += write_size;
         *actual = write_size;
         if (now) {
@@ -397,6 +417,26 @@ void USBCDC::send_nb(uint8_t *buffer, uint32_t size, uint32_t *actual, bool now)
     unlock();
 }
 
+void USBCDC::_send_in_place(uint8_t *buffer, uint32_t size, uint32_t *actual)
+{
+    assert_locked();
+
+    *actual = 0;
+    if (_terminal_connected && !_tx_in_progress && (_tx_size == 0)) {
+        // Whole packets, as many as the endpoint transfers at once
+        uint32_t max_packet = endpoint_max_packet_size(_bulk_in);
+        uint32_t write_size = endpoint_max_transfer_size(_bulk_in);
+        if (write_size > size) {
+            write_size = size;
+        }
+        write_size -= write_size % max_packet;
+        if (write_size && USBDevice::write_start(_bulk_in, buffer, write_size)) {
+            _tx_in_progress = true;
+            *actual = write_size;
+        }
+    }
+}
+
 void USBCDC::_send_isr_start()
 {
     assert_locked();
@@ -461,6 +501,35 @@ void USBCDC::receive_nb(uint8_t *buffer, uint32_t size,  uint32_t *size_read)
     }
 }
 
+mbed::Span<const uint8_t> USBCDC::receive_span()
+{
+    lock();
+
+    mbed::Span<const uint8_t> data;
+    if (_terminal_connected && !_rx_in_progress) {
+        data = mbed::Span<const uint8_t>(_rx_buf, _rx_size);
+    }
+
+    unlock();
+    return data;
+}
+
+void USBCDC::receive_consume(uint32_t size)
+{
+    lock();
+
+    if (_terminal_connected && !_rx_in_progress) {
+        uint32_t consume_size = _rx_size > size ? size : _rx_size;
+        _rx_buf += consume_size;
+        _rx_size -= consume_size;
+        if (_rx_size == 0) {
+            _receive_isr_start();
+        }
+    }
+
+    unlock();
+}
+
 void USBCDC::_receive_isr_start()
 {
     if ((_rx_size == 0) && !_rx_in_progress) {
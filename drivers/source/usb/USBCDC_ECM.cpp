@@ -78,6 +78,16 @@ void USBCDC_ECM::_init()
 
     MBED_ASSERT(resolver.valid());
 
+    _rx_buf = NULL;
+    _rx_size = 0;
+    _rx_len = 0;
+    _rx_pos = NULL;
+    _rx_requested = 0;
+    _rx_direct = false;
+    _rx_dropping = false;
+    _rx_active = false;
+    _rx_reading = false;
+
     _thread.start(callback(&_queue, &events::EventQueue::dispatch_forever));
     _rx_queue.resize(MAX_SEGMENT_SIZE);
 }
@@ -200,35 +210,67 @@ bool USBCDC_ECM::_write_bulk(uint8_t *buffer, uint32_t size)
 
 bool USBCDC_ECM::send(uint8_t *buffer, uint32_t size)
 {
-    _write_mutex.lock();
-    bool ret = true;
-    uint32_t sent = 0;
-    uint32_t data_size = 0;
+    return send(&buffer, &size, 1);
+}
+
+bool USBCDC_ECM::send(uint8_t *const *buffers, const uint32_t *sizes, uint32_t count)
+{
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        size += sizes[i];
+    }
 
     if (size > MAX_SEGMENT_SIZE) {
-        _write_mutex.unlock();
         mbed_error_printf("Buffer size is too large\n");
         return false;
     }
 
+    _write_mutex.lock();
+
     uint32_t max_packet = USBDevice::endpoint_max_packet_size(_bulk_in);
+    uint32_t max_transfer = USBDevice::endpoint_max_transfer_size(_bulk_in);
+    uint32_t pending = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t *data = buffers[i];
+        uint32_t data_size = sizes[i];
+
+        /* Complete the packet started by the previous buffers */
+        if (pending) {
+            uint32_t copy_size = (data_size > max_packet - pending) ? max_packet - pending : data_size;
+            memcpy(_tx_buf + pending, data, copy_size);
+            pending += copy_size;
+            data += copy_size;
+            data_size -= copy_size;
+            if (pending == max_packet) {
+                if (!_write_bulk(_tx_buf, max_packet)) {
+                    _write_mutex.unlock();
+                    return false;
+                }
+                pending = 0;
+            }
+        }
 
-    while (size - sent > 0) {
-        data_size = (size - sent > max_packet) ? max_packet : size - sent;
-        if (_write_bulk(buffer + sent, data_size)) {
-            sent += data_size;
-        } else {
-            _write_mutex.unlock();
-            return false;
+        /* Send whole packets in place */
+        while (data_size >= max_packet) {
+            uint32_t write_size = (data_size > max_transfer) ? max_transfer : data_size;
+            write_size -= write_size % max_packet;
+            if (!_write_bulk(data, write_size)) {
+                _write_mutex.unlock();
+                return false;
+            }
+            data += write_size;
+            data_size -= write_size;
         }
-    }
 
-    /* Send zero length packet */
-    if (size % max_packet == 0) {
-        uint8_t buf = 0;
-        ret = _write_bulk(&buf, 0);
+        /* Keep the rest for the next packet */
+        memcpy(_tx_buf + pending, data, data_size);
+        pending += data_size;
     }
 
+    /* Send the short packet ending the frame, zero length if the frame is whole packets */
+    bool ret = _write_bulk(_tx_buf, pending);
+
     _write_mutex.unlock();
     return ret;
 }
@@ -245,6 +287,51 @@ void USBCDC_ECM::receive_nb(uint8_t *buffer, uint32_t size, uint32_t *actual)
     unlock();
 }
 
+bool USBCDC_ECM::receive_start(uint8_t *buffer, uint32_t size, mbed::Callback<void(uint32_t)> done)
+{
+    lock();
+
+    if (_rx_buf) {
+        unlock();
+        return false;
+    }
+
+    _rx_direct = true;
+    _rx_buf = buffer;
+    _rx_size = size;
+    _rx_len = 0;
+    _rx_done = done;
+
+    // Resume reception, paused since the last frame
+    if (_rx_active && !_rx_reading) {
+        _read_next();
+    }
+
+    unlock();
+    return true;
+}
+
+void USBCDC_ECM::receive_stop()
+{
+    lock();
+
+    if (_rx_reading && (_rx_pos != _bulk_buf)) {
+        endpoint_abort(_bulk_out);
+        _rx_reading = false;
+    }
+    _rx_direct = false;
+    _rx_dropping = false;
+    _rx_buf = NULL;
+    _rx_len = 0;
+    _rx_done = nullptr;
+
+    if (_rx_active && !_rx_reading) {
+        _read_next();
+    }
+
+    unlock();
+}
+
 void USBCDC_ECM::attach_rx(mbed::Callback<void()> cb)
 {
     lock();
@@ -322,7 +409,9 @@ void USBCDC_ECM::callback_set_interface(uint16_t interface, uint8_t alternate)
         endpoint_add(_bulk_in, MAX_PACKET_SIZE_BULK, USB_EP_TYPE_BULK, &USBCDC_ECM::_bulk_in_callback);
         endpoint_add(_bulk_out, MAX_PACKET_SIZE_BULK, USB_EP_TYPE_BULK, &USBCDC_ECM::_bulk_out_callback);
 
-        read_start(_bulk_out, _bulk_buf, MAX_PACKET_SIZE_BULK);
+        _rx_active = true;
+        _rx_reading = false;
+        _read_next();
 
         _queue.call(static_cast<USBCDC_ECM *>(this), &USBCDC_ECM::_notify_connect);
     }
@@ -341,6 +430,12 @@ void USBCDC_ECM::callback_state_change(DeviceState new_state)
     } else {
         _flags.set(FLAG_DISCONNECT);
         _flags.clear(FLAG_CONNECT | FLAG_WRITE_DONE | FLAG_INT_DONE);
+
+        // Drop the frame being received, its buffer is kept for the next one
+        _rx_active = false;
+        _rx_reading = false;
+        _rx_dropping = false;
+        _rx_len = 0;
     }
 }
 
@@ -543,6 +638,12 @@ void USBCDC_ECM::_bulk_out_callback()
     assert_locked();
 
     uint32_t read_size = read_finish(_bulk_out);
+    _rx_reading = false;
+
+    if (_rx_direct) {
+        _receive_direct(read_size);
+        return;
+    }
 
     if (read_size <= _rx_queue.free()) {
         // Copy data over
@@ -554,6 +655,68 @@ void USBCDC_ECM::_bulk_out_callback()
         _callback_rx();
     }
 
-    read_start(_bulk_out, _bulk_buf, MAX_PACKET_SIZE_BULK);
+    _read_next();
+}
+
+void USBCDC_ECM::_read_next()
+{
+    assert_locked();
+
+    uint8_t *data = _bulk_buf;
+    uint32_t size = MAX_PACKET_SIZE_BULK;
+
+    if (_rx_direct) {
+        if (!_rx_buf) {
+            // Paused until receive_start() supplies a buffer
+            return;
+        }
+
+        // Whole packets while they fit in the buffer, the rest of a frame too long is dropped
+        uint32_t max_packet = USBDevice::endpoint_max_packet_size(_bulk_out);
+        uint32_t max_transfer = USBDevice::endpoint_max_transfer_size(_bulk_out);
+        uint32_t space = _rx_size - _rx_len;
+        space -= space % max_packet;
+        if (space && !_rx_dropping) {
+            data = _rx_buf + _rx_len;
+            size = (space > max_transfer) ? max_transfer : space;
+        } else {
+            size = max_packet;
+        }
+    }
+
+    _rx_pos = data;
+    _rx_requested = size;
+    _rx_reading = true;
+    read_start(_bulk_out, data, size);
+}
+
+void USBCDC_ECM::_receive_direct(uint32_t size)
+{
+    assert_locked();
+
+    if (_rx_pos == _bulk_buf) {
+        if (size) {
+            _rx_dropping = true;
+        }
+    } else {
+        _rx_len += size;
+    }
+
+    // A transfer cut short by a short packet ends the frame
+    if (size < _rx_requested) {
+        if (_rx_dropping || !_rx_len) {
+            _rx_dropping = false;
+            _rx_len = 0;
+        } else {
+            mbed::Callback<void(uint32_t)> done = _rx_done;
+            uint32_t len = _rx_len;
+            _rx_buf = NULL;
+            _rx_len = 0;
+            done(len);
+            return;
+        }
+    }
+
+    _read_next();
 }
 #endif // defined(MBED_CONF_RTOS_PRESENT)
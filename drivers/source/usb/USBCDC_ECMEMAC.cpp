@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CONF_NSAPI_PRESENT)
+#include <string.h>
+#include "USBCDC_ECMEMAC.h"
+#include "mbed_interface.h"
+#include "mbed_critical.h"
+
+#define ETH_MTU_SIZE            (1500)
+// Largest frame rounded up to whole 64 byte packets
+#define RX_BUFFER_SIZE          (1536)
+#define RX_BUFFER_ALIGN         (4)
+// Longer buffer chains are copied to a single buffer before they are sent
+#define TX_MAX_SEGMENTS         (8)
+
+#define THREAD_STACKSIZE        (512)
+#define THREAD_PRIORITY         (osPriorityNormal)
+#define LINK_POLL_INTERVAL      std::chrono::milliseconds(100)
+
+#define FLAG_RX                 (1 << 0)
+#define FLAG_STOP               (1 << 1)
+
+USBCDC_ECMEMAC::USBCDC_ECMEMAC(USBCDC_ECM &ecm)
+    : _ecm(ecm), _memory_manager(NULL), _link_up(false),
+      _rx_ring(_rx_slots, USBCDC_ECMEMAC_RX_BUFFERS), _rx_receiving(0), _rx_take(0), _thread(NULL)
+{
+    for (int i = 0; i < USBCDC_ECMEMAC_RX_BUFFERS; i++) {
+        _rx_ptr[i] = NULL;
+        _rx_state[i] = RX_EMPTY;
+        _rx_length[i] = 0;
+    }
+
+    // The host names its end of the link with the device MAC address, so
+    // use a locally administered address that differs from it
+    mbed_mac_address((char *)_hwaddr);
+    _hwaddr[0] |= 0x02;
+    _hwaddr[5] ^= 0x01;
+}
+
+USBCDC_ECMEMAC::~USBCDC_ECMEMAC()
+{
+    power_down();
+}
+
+uint32_t USBCDC_ECMEMAC::get_mtu_size() const
+{
+    return ETH_MTU_SIZE;
+}
+
+uint32_t USBCDC_ECMEMAC::get_align_preference() const
+{
+    return 0;
+}
+
+void USBCDC_ECMEMAC::get_ifname(char *name, uint8_t size) const
+{
+    strncpy(name, "ue", size);
+}
+
+uint8_t USBCDC_ECMEMAC::get_hwaddr_size() const
+{
+    return sizeof(_hwaddr);
+}
+
+bool USBCDC_ECMEMAC::get_hwaddr(uint8_t *addr) const
+{
+    memcpy(addr, _hwaddr, sizeof(_hwaddr));
+    return true;
+}
+
+void USBCDC_ECMEMAC::set_hwaddr(const uint8_t *addr)
+{
+    memcpy(_hwaddr, addr, sizeof(_hwaddr));
+}
+
+bool USBCDC_ECMEMAC::link_out(emac_mem_buf_t *buf)
+{
+    uint8_t *buffers[TX_MAX_SEGMENTS];
+    uint32_t sizes[TX_MAX_SEGMENTS];
+    uint32_t count = 0;
+
+    if (!_ecm.ready()) {
+        _memory_manager->free(buf);
+        return false;
+    }
+
+    emac_mem_buf_t *segment = buf;
+    while (segment && count < TX_MAX_SEGMENTS) {
+        buffers[count] = static_cast<uint8_t *>(_memory_manager->get_ptr(segment));
+        sizes[count] = _memory_manager->get_len(segment);
+        segment = _memory_manager->get_next(segment);
+        count++;
+    }
+
+    if (segment) {
+        emac_mem_buf_t *copy_buf = _memory_manager->alloc_heap(_memory_manager->get_total_len(buf), 0);
+        if (!copy_buf) {
+            _memory_manager->free(buf);
+            return false;
+        }
+        _memory_manager->copy(copy_buf, buf);
+        _memory_manager->free(buf);
+        buf = copy_buf;
+
+        buffers[0] = static_cast<uint8_t *>(_memory_manager->get_ptr(buf));
+        sizes[0] = _memory_manager->get_len(buf);
+        count = 1;
+    }
+
+    bool ret = _ecm.send(buffers, sizes, count);
+    _memory_manager->free(buf);
+    return ret;
+}
+
+bool USBCDC_ECMEMAC::power_up()
+{
+    if (!_memory_manager || _thread) {
+        return false;
+    }
+
+    _rx_receiving = 0;
+    _rx_take = 0;
+    if (!_rx_ring.init(*_memory_manager, RX_BUFFER_SIZE, RX_BUFFER_ALIGN)) {
+        _rx_ring.deinit();
+        return false;
+    }
+    for (int i = 0; i < USBCDC_ECMEMAC_RX_BUFFERS; i++) {
+        _rx_post(i, _rx_ring.get_ptr(i));
+    }
+
+    _flags.clear(FLAG_RX | FLAG_STOP);
+    _thread = new rtos::Thread(THREAD_PRIORITY, THREAD_STACKSIZE, NULL, "USBCDC_ECMEMAC");
+    _thread->start(mbed::callback(this, &USBCDC_ECMEMAC::_thread_main));
+    return true;
+}
+
+void USBCDC_ECMEMAC::power_down()
+{
+    if (!_thread) {
+        return;
+    }
+
+    _flags.set(FLAG_STOP);
+    _thread->join();
+    delete _thread;
+    _thread = NULL;
+
+    _ecm.receive_stop();
+    _rx_ring.deinit();
+    for (int i = 0; i < USBCDC_ECMEMAC_RX_BUFFERS; i++) {
+        _rx_ptr[i] = NULL;
+        _rx_state[i] = RX_EMPTY;
+    }
+
+    if (_link_up) {
+        _link_up = false;
+        if (_state_cb) {
+            _state_cb(false);
+        }
+    }
+}
+
+void USBCDC_ECMEMAC::set_link_input_cb(emac_link_input_cb_t input_cb)
+{
+    _input_cb = input_cb;
+}
+
+void USBCDC_ECMEMAC::set_link_state_cb(emac_link_state_change_cb_t state_cb)
+{
+    _state_cb = state_cb;
+}
+
+void USBCDC_ECMEMAC::add_multicast_group(const uint8_t *address)
+{
+    // Filtering is left to the host, see USBCDC_ECM::read_packet_filter()
+}
+
+void USBCDC_ECMEMAC::remove_multicast_group(const uint8_t *address)
+{
+}
+
+void USBCDC_ECMEMAC::set_all_multicast(bool all)
+{
+}
+
+void USBCDC_ECMEMAC::set_memory_manager(EMACMemoryManager &mem_mngr)
+{
+    _memory_manager = &mem_mngr;
+}
+
+void USBCDC_ECMEMAC::_thread_main()
+{
+    while (true) {
+        uint32_t flags = _flags.wait_any_for(FLAG_RX | FLAG_STOP, LINK_POLL_INTERVAL);
+        if (flags & osFlagsError) {
+            flags = 0;
+        }
+        if (flags & FLAG_STOP) {
+            break;
+        }
+
+        // Also retries buffers that couldn't be allocated last time
+        _receive();
+
+        bool up = _ecm.ready();
+        if (up != _link_up) {
+            _link_up = up;
+            if (_state_cb) {
+                _state_cb(up);
+            }
+        }
+    }
+}
+
+void USBCDC_ECMEMAC::_receive()
+{
+    while (_rx_state[_rx_take] == RX_DONE) {
+        uint32_t idx = _rx_take;
+        emac_mem_buf_t *buf = _rx_ring.take(idx, _rx_length[idx]);
+        _rx_ptr[idx] = NULL;
+        _rx_state[idx] = RX_EMPTY;
+        _rx_take = (idx + 1) % USBCDC_ECMEMAC_RX_BUFFERS;
+
+        if (_input_cb) {
+            _input_cb(buf);
+        } else {
+            _memory_manager->free(buf);
+        }
+    }
+
+    _rx_ring.refill(mbed::callback(this, &USBCDC_ECMEMAC::_rx_post));
+}
+
+void USBCDC_ECMEMAC::_rx_post(uint32_t idx, void *ptr)
+{
+    core_util_critical_section_enter();
+
+    _rx_ptr[idx] = static_cast<uint8_t *>(ptr);
+    _rx_state[idx] = RX_READY;
+    // Buffers receive in ring order, start this one if reception is waiting for it
+    if (idx == _rx_receiving) {
+        _rx_start(idx);
+    }
+
+    core_util_critical_section_exit();
+}
+
+void USBCDC_ECMEMAC::_rx_start(uint32_t idx)
+{
+    _rx_state[idx] = RX_RECEIVING;
+    _ecm.receive_start(_rx_ptr[idx], RX_BUFFER_SIZE, mbed::callback(this, &USBCDC_ECMEMAC::_rx_done));
+}
+
+void USBCDC_ECMEMAC::_rx_done(uint32_t length)
+{
+    /* Called in ISR context */
+
+    uint32_t idx = _rx_receiving;
+    _rx_length[idx] = length;
+    _rx_state[idx] = RX_DONE;
+
+    // Keep receiving into the next buffer while the thread passes this one on
+    _rx_receiving = (idx + 1) % USBCDC_ECMEMAC_RX_BUFFERS;
+    if (_rx_state[_rx_receiving] == RX_READY) {
+        _rx_start(_rx_receiving);
+    }
+
+    _flags.set(FLAG_RX);
+}
+#endif // defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CONF_NSAPI_PRESENT)
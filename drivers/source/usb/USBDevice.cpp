@@ -1140,6 +1140,14 @@ bool USBDevice::endpoint_add(usb_ep_t endpoint, uint32_t max_packet_size, usb_ep
         info->flags |= ENDPOINT_ENABLED;
         info->pending = 0;
         info->max_packet_size = max_packet_size;
+        info->max_transfer_size = max_packet_size;
+        if (type == USB_EP_TYPE_BULK) {
+            // Whole packets only, so a read ends on a packet boundary
+            uint32_t max_transfer_size = _phy->endpoint_max_transfer_size(endpoint);
+            if (max_transfer_size > max_packet_size) {
+                info->max_transfer_size = max_transfer_size - max_transfer_size % max_packet_size;
+            }
+        }
     }
 
     unlock();
@@ -1393,6 +1401,22 @@ uint32_t USBDevice::endpoint_max_packet_size(usb_ep_t endpoint)
     return size;
 }
 
+uint32_t USBDevice::endpoint_max_transfer_size(usb_ep_t endpoint)
+{
+    lock();
+
+    uint32_t size = 0;
+    if (EP_CONTROL(endpoint)) {
+        size = _max_packet_size_ep0;
+    } else {
+        endpoint_info_t *info = &_endpoint_info[EP_TO_INDEX(endpoint)];
+        size = info->max_transfer_size;
+    }
+
+    unlock();
+    return size;
+}
+
 void USBDevice::endpoint_abort(usb_ep_t endpoint)
 {
     lock();
@@ -1476,7 +1500,9 @@ bool USBDevice::read_start(usb_ep_t endpoint, uint8_t *buffer, uint32_t max_size
         return false;
     }
 
-    bool ret = _phy->endpoint_read(endpoint, buffer, info->max_packet_size);
+    uint32_t size = max_size < info->max_transfer_size ? max_size : info->max_transfer_size;
+    size -= size % info->max_packet_size;
+    bool ret = _phy->endpoint_read(endpoint, buffer, size);
     if (ret) {
         info->pending += 1;
     }
@@ -1546,7 +1572,7 @@ bool USBDevice::write_start(usb_ep_t endpoint, uint8_t *buffer, uint32_t size)
         return false;
     }
 
-    if (size > info->max_packet_size) {
+    if (size > info->max_transfer_size) {
 #if MBED_TRAP_ERRORS_ENABLED
         MBED_ERROR(
             MBED_MAKE_ERROR(
@@ -58,6 +58,12 @@
 // max packet size
 #define MAX_PACKET  64
 
+#if MBED_CONF_DRIVERS_USB_MSD_DOUBLE_BUFFER
+#define CACHE_BUFFERS   2
+#else
+#define CACHE_BUFFERS   1
+#endif
+
 // CSW Status
 enum Status {
     CSW_PASSED,
@@ -69,7 +75,7 @@ USBMSD::USBMSD(BlockDevice *bd, bool connect_blocking, uint16_t vendor_id, uint1
     : USBDevice(get_usb_phy(), vendor_id, product_id, product_release),
       _initialized(false), _media_removed(false),
       _addr(0), _length(0), _mem_ok(false), _block_size(0), _memory_size(0), _block_count(0),
-      _out_ready(false), _in_ready(false), _bulk_out_size(0),
+      _bulk_out_data(_bulk_out_buf), _out_ready(false), _in_ready(false), _bulk_out_size(0),
       _in_task(&_queue), _out_task(&_queue), _reset_task(&_queue), _control_task(&_queue),
       _configure_task(&_queue), _bd(bd)
 {
@@ -85,7 +91,7 @@ USBMSD::USBMSD(USBPhy *phy, BlockDevice *bd, uint16_t vendor_id, uint16_t produc
     : USBDevice(phy, vendor_id, product_id, product_release),
       _initialized(false), _media_removed(false),
       _addr(0), _length(0), _mem_ok(false), _block_size(0), _memory_size(0), _block_count(0),
-      _out_ready(false), _in_ready(false), _bulk_out_size(0),
+      _bulk_out_data(_bulk_out_buf), _out_ready(false), _in_ready(false), _bulk_out_size(0),
       _in_task(&_queue), _out_task(&_queue), _reset_task(&_queue), _control_task(&_queue),
       _configure_task(&_queue), _bd(bd)
 {
@@ -114,6 +120,10 @@ void USBMSD::_init()
     memset((void *)&_cbw, 0, sizeof(CBW));
     memset((void *)&_csw, 0, sizeof(CSW));
     _page = NULL;
+    memset(_cache, 0, sizeof(_cache));
+    _cache_blocks = MBED_CONF_DRIVERS_USB_MSD_CACHE_BLOCKS;
+    _cache_current = 0;
+    _cache_pending = -1;
 }
 
 USBMSD::~USBMSD()
@@ -154,12 +164,16 @@ bool USBMSD::connect()
         _block_size = _memory_size / _block_count;
         if (_block_size != 0) {
             free(_page);
-            _page = (uint8_t *)malloc(_block_size * sizeof(uint8_t));
+            _page = (uint8_t *)malloc(_block_size * _cache_blocks * CACHE_BUFFERS * sizeof(uint8_t));
             if (_page == NULL) {
                 _mutex.unlock();
                 _mutex_init.unlock();
                 return false;
             }
+            for (int i = 0; i < CACHE_BUFFERS; i++) {
+                _cache[i].data = _page + i * _block_size * _cache_blocks;
+                _cache[i].count = 0;
+            }
         }
     } else {
         _mutex.unlock();
@@ -204,6 +218,7 @@ void USBMSD::disconnect()
     //De-allocate MSD page size:
     free(_page);
     _page = NULL;
+    memset(_cache, 0, sizeof(_cache));
 
     _mutex.unlock();
     _mutex_init.unlock();
@@ -477,6 +492,7 @@ void USBMSD::_configure()
     _in_ready = true;
 
     //activate readings
+    _bulk_out_data = _bulk_out_buf;
     read_start(_bulk_out, _bulk_out_buf, sizeof(_bulk_out_buf));
     complete_set_configuration(true);
 
@@ -493,7 +509,7 @@ void USBMSD::_process()
             if (!_out_ready) {
                 break;
             }
-            CBWDecode(_bulk_out_buf, _bulk_out_size);
+            CBWDecode(_bulk_out_data, _bulk_out_size);
             _read_next();
             break;
 
@@ -506,14 +522,16 @@ void USBMSD::_process()
                     if (!_out_ready) {
                         break;
                     }
-                    memoryWrite(_bulk_out_buf, _bulk_out_size);
+                    memoryWrite(_bulk_out_data, _bulk_out_size);
                     _read_next();
+                    // Program the full buffer while the next data is received
+                    _cache_flush();
                     break;
                 case VERIFY10:
                     if (!_out_ready) {
                         break;
                     }
-                    memoryVerify(_bulk_out_buf, _bulk_out_size);
+                    memoryVerify(_bulk_out_data, _bulk_out_size);
                     _read_next();
                     break;
                 // the device has to send data to the host
@@ -549,11 +567,16 @@ void USBMSD::_write_next(uint8_t *data, uint32_t size)
 {
     lock();
 
-    MBED_ASSERT(size <= MAX_PACKET);
     MBED_ASSERT(_in_ready);
-    uint32_t send_size = MAX_PACKET > size ? size : MAX_PACKET;
-    memcpy(_bulk_in_buf, data, send_size);
-    write_start(_bulk_in, _bulk_in_buf, send_size);
+    if (size > MAX_PACKET) {
+        // Multi-packet transfers are sent from the block cache, which stays
+        // unchanged until the transfer completes
+        MBED_ASSERT(size <= endpoint_max_transfer_size(_bulk_in));
+        write_start(_bulk_in, data, size);
+    } else {
+        memcpy(_bulk_in_buf, data, size);
+        write_start(_bulk_in, _bulk_in_buf, size);
+    }
     _in_ready = false;
 
     unlock();
@@ -564,17 +587,89 @@ void USBMSD::_read_next()
     lock();
 
     MBED_ASSERT(_out_ready);
-    read_start(_bulk_out, _bulk_out_buf, sizeof(_bulk_out_buf));
+    if ((_stage == PROCESS_CBW) && ((_cbw.CB[0] == WRITE10) || (_cbw.CB[0] == WRITE12)) && (_length > MAX_PACKET)) {
+        // Receive the rest of the buffer straight into the block cache
+        uint32_t space;
+        _bulk_out_data = _cache_write_position(&space);
+        read_start(_bulk_out, _bulk_out_data, _transfer_size(_bulk_out, space));
+    } else {
+        _bulk_out_data = _bulk_out_buf;
+        read_start(_bulk_out, _bulk_out_buf, sizeof(_bulk_out_buf));
+    }
     _out_ready = false;
 
     unlock();
 }
 
+uint32_t USBMSD::_transfer_size(usb_ep_t endpoint, uint32_t space)
+{
+    // Up to the end of the cache buffer, so it is never overrun
+    uint32_t size = space;
+    uint32_t max_transfer = endpoint_max_transfer_size(endpoint);
+    if (size > max_transfer) {
+        size = max_transfer;
+    }
+    if (size > _length) {
+        size = _length;
+    }
+    return size;
+}
+
+USBMSD::cache_t *USBMSD::_cache_find(uint32_t addr)
+{
+    for (int i = 0; i < CACHE_BUFFERS; i++) {
+        cache_t *cache = &_cache[i];
+        if (cache->count && (addr >= cache->block * _block_size) &&
+                (addr < (cache->block + cache->count) * _block_size)) {
+            return cache;
+        }
+    }
+    return NULL;
+}
+
+void USBMSD::_cache_setup(cache_t *cache, uint32_t addr)
+{
+    // As many blocks as fit, without going past the end of the transfer
+    uint32_t end = _addr + _length;
+    cache->block = addr / _block_size;
+    cache->count = (end - cache->block * _block_size + _block_size - 1) / _block_size;
+    if (cache->count > _cache_blocks) {
+        cache->count = _cache_blocks;
+    }
+}
+
+uint8_t *USBMSD::_cache_write_position(uint32_t *space)
+{
+    cache_t *cache = &_cache[_cache_current];
+    if (_cache_find(_addr) != cache) {
+        _cache_setup(cache, _addr);
+    }
+    uint32_t offset = _addr - cache->block * _block_size;
+    *space = cache->count * _block_size - offset;
+    return cache->data + offset;
+}
+
+void USBMSD::_cache_write(cache_t *cache)
+{
+    if (!(disk_status() & WRITE_PROTECT)) {
+        disk_write(cache->data, cache->block, cache->count);
+    }
+    cache->count = 0;
+}
+
+void USBMSD::_cache_flush()
+{
+    if (_cache_pending >= 0) {
+        _cache_write(&_cache[_cache_pending]);
+        _cache_pending = -1;
+    }
+}
+
 void USBMSD::memoryWrite(uint8_t *buf, uint16_t size)
 {
     // Max sized packets are required to be sent until the transfer is complete
     MBED_ASSERT(_block_size % MAX_PACKET == 0);
-    if ((size != MAX_PACKET) && (size != 0)) {
+    if (size % MAX_PACKET) {
         _stage = ERROR;
         endpoint_stall(_bulk_out);
         return;
@@ -586,23 +681,33 @@ void USBMSD::memoryWrite(uint8_t *buf, uint16_t size)
         endpoint_stall(_bulk_out);
     }
 
-    // we fill an array in RAM of 1 block before writing it in memory
-    for (int i = 0; i < size; i++) {
-        _page[_addr % _block_size + i] = buf[i];
-    }
-
-    // if the array is filled, write it in memory
-    if (!((_addr + size) % _block_size)) {
-        if (!(disk_status() & WRITE_PROTECT)) {
-            disk_write(_page, _addr / _block_size, 1);
-        }
+    // we fill a buffer in RAM of whole blocks before writing it in memory,
+    // multi-packet transfers were received there directly
+    uint32_t space;
+    uint8_t *dst = _cache_write_position(&space);
+    MBED_ASSERT(size <= space);
+    if (buf != dst) {
+        memcpy(dst, buf, size);
     }
 
     _addr += size;
     _length -= size;
     _csw.DataResidue -= size;
 
-    if ((!_length) || (_stage != PROCESS_CBW)) {
+    // if the buffer is filled, write it in memory
+    bool done = (!_length) || (_stage != PROCESS_CBW);
+    if ((size == space) || done) {
+        if (done || (CACHE_BUFFERS == 1)) {
+            _cache_write(&_cache[_cache_current]);
+        } else {
+            // Written by _cache_flush() once the next transfer is started
+            _cache_pending = _cache_current;
+            _cache_current = !_cache_current;
+            _cache[_cache_current].count = 0;
+        }
+    }
+
+    if (done) {
         _csw.Status = (_stage == ERROR) ? CSW_FAILED : CSW_PASSED;
         sendCSW();
     }
@@ -882,7 +987,17 @@ void USBMSD::memoryRead(void)
 {
     uint32_t n;
 
-    n = (_length > MAX_PACKET) ? MAX_PACKET : _length;
+    // we read whole blocks, unless they were read ahead
+    cache_t *cache = _cache_find(_addr);
+    if (cache == NULL) {
+        cache = &_cache[_cache_current];
+        _cache_setup(cache, _addr);
+        disk_read(cache->data, cache->block, cache->count);
+    }
+    _cache_current = cache - _cache;
+
+    uint32_t offset = _addr - cache->block * _block_size;
+    n = _transfer_size(_bulk_in, cache->count * _block_size - offset);
 
     if (_addr > (_memory_size - n)) {
         n = _addr < _memory_size ? _memory_size - _addr : 0;
@@ -890,18 +1005,21 @@ void USBMSD::memoryRead(void)
     }
 
     if (n > 0) {
-        // we read an entire block
-        if (!(_addr % _block_size)) {
-            disk_read(_page, _addr / _block_size, 1);
-        }
-
         // write data which are in RAM
-        _write_next(&_page[_addr % _block_size], MAX_PACKET);
+        _write_next(cache->data + offset, n);
 
         _addr += n;
         _length -= n;
 
         _csw.DataResidue -= n;
+
+        // read the next blocks while these are sent
+        uint32_t cache_end = (cache->block + cache->count) * _block_size;
+        if ((CACHE_BUFFERS > 1) && (cache_end < _addr + _length) && !_cache_find(cache_end)) {
+            cache_t *next = &_cache[!_cache_current];
+            _cache_setup(next, cache_end);
+            disk_read(next->data, next->block, next->count);
+        }
     }
 
     if (!_length || (_stage != PROCESS_CBW)) {
@@ -961,6 +1079,12 @@ bool USBMSD::infoTransfer(void)
         return false;
     }
 
+    // the media may have changed since the blocks were cached
+    _cache[0].count = 0;
+    _cache[1].count = 0;
+    _cache_current = 0;
+    _cache_pending = -1;
+
     return true;
 }
 
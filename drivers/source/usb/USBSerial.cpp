@@ -53,6 +53,15 @@ int USBSerial::_putc(int c)
     }
 }
 
+ssize_t USBSerial::write(const void *buffer, size_t size)
+{
+    if (send((uint8_t *)buffer, size)) {
+        return size;
+    } else {
+        return 0;
+    }
+}
+
 int USBSerial::_getc()
 {
     uint8_t c = 0;
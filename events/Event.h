@@ -70,6 +70,7 @@ public:
             _event->period = duration(-1);
 
             _event->post = &Event::event_post<F>;
+            _event->update = &Event::event_update<F>;
             _event->dtor = &Event::event_dtor<F>;
 
             new (_event + 1) F(std::move(f));
@@ -181,6 +182,36 @@ public:
         return _event->id;
     }
 
+    /** Posts an event onto the underlying event queue, coalescing with a pending post
+     *
+     *  If the most recently posted instance of this event has not yet begun
+     *  dispatching, its arguments are replaced with the new arguments and no
+     *  new event is allocated, so a burst of posts results in a single
+     *  dispatch with the latest arguments. The pending event keeps its
+     *  original dispatch time. Otherwise, the event is posted as by post.
+     *
+     *  The post_coalesced function is IRQ safe. The arguments are copied
+     *  while holding the queue lock, so they should be small.
+     *
+     *  @param args     Arguments to pass to the event
+     *  @return         A unique id that represents the pending event and can
+     *                  be passed to EventQueue::cancel, or an id of 0 if
+     *                  there is not enough memory to allocate the event.
+     */
+    int post_coalesced(ArgTs... args) const
+    {
+        if (!_event) {
+            return 0;
+        }
+
+        if (_event->id && _event->update(_event, args...)) {
+            return _event->id;
+        }
+
+        _event->id = _event->post(_event, args...);
+        return _event->id;
+    }
+
     /** Posts an event onto the underlying event queue, returning void
      *
      *  @param args     Arguments to pass to the event
@@ -238,6 +269,7 @@ private:
         duration period;
 
         int (*post)(struct event *, ArgTs... args);
+        bool (*update)(struct event *, ArgTs... args);
         void (*dtor)(struct event *);
 
         // F follows
@@ -260,6 +292,21 @@ private:
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
+    template <typename C>
+    static void event_replace(void *p, void *c)
+    {
+        ((C *)p)->~C();
+        new (p) C(*(C *)c);
+    }
+
+    template <typename F>
+    static bool event_update(struct event *e, ArgTs... args)
+    {
+        typedef EventQueue::context<F, ArgTs...> C;
+        C c(*(F *)(e + 1), args...);
+        return equeue_update(e->equeue, e->id, &Event::event_replace<C>, &c);
+    }
+
     template <typename F>
     static void event_dtor(struct event *e)
     {
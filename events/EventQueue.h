@@ -63,6 +63,18 @@ class EventQueue : private mbed::NonCopyable<EventQueue> {
 public:
     using duration = std::chrono::duration<int, std::milli>;
 
+    /** Event priority
+     *
+     *  Events that are due at the same time are dispatched highest priority
+     *  first. The number of levels is set by events.priorities; intermediate
+     *  levels can be given as Priority(n), and values beyond the highest
+     *  level are clamped to it.
+     */
+    enum class Priority : uint8_t {
+        Low = 0,        /**< Default priority of events */
+        High = 0xff,    /**< Highest configured priority */
+    };
+
     /** Create an EventQueue
      *
      *  Create an event queue. The event queue either allocates a buffer of
@@ -226,6 +238,23 @@ public:
         return equeue_timeleft_user_allocated(&_equeue, &event->_e);
     }
 
+    /** Get the dispatch statistics of the event queue
+     *
+     *  Fills in the passed structure with the dispatch latency histogram,
+     *  the longest running callback and the queue depth high-water mark,
+     *  which can be used to spot starvation of the dispatch loop.
+     *
+     *  Statistics are only gathered if events.dispatch-stats-enabled or
+     *  MBED_ALL_STATS_ENABLED is set.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param stats    A pointer to the equeue_dispatch_stats_t structure to fill
+     *  @param reset    Clear the statistics after reading them
+     *  @return         True if statistics are gathered, false otherwise
+     */
+    bool get_dispatch_stats(equeue_dispatch_stats_t *stats, bool reset = false);
+
     /** Background an event queue onto a single-shot timer-interrupt
      *
      *  When updated, the event queue will call the provided update function
@@ -775,6 +804,84 @@ public:
         return call(context<F, ArgTs...>(std::move(f), args...));
     }
 
+    /** Calls an event on the queue with a priority
+     *
+     *  Behaves like call, but events due at the same time are dispatched in
+     *  priority order, and higher priority events overtake lower priority
+     *  events already waiting to be dispatched. Priorities have no effect
+     *  unless events.priorities is greater than one.
+     *
+     *  @param prio     Priority of the event
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call(Priority prio, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        equeue_event_priority(e, static_cast<int>(prio));
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue with a priority
+     *  @see                    EventQueue::call(Priority, F)
+     *  @param prio             Priority of the event
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param args             Arguments to pass to the callback
+     */
+    template <typename F, typename... ArgTs>
+    int call(Priority prio, F f, ArgTs... args)
+    {
+        return call(prio, context<F, ArgTs...>(std::move(f), args...));
+    }
+
+    /** Calls an event on the queue from an interrupt
+     *
+     *  Behaves like call, but the event is pushed onto the queue's lock-free
+     *  interrupt list with an atomic compare-and-swap instead of being
+     *  inserted into the queue under the queue lock, so interrupts are only
+     *  masked while allocating the event. For a fully lock-free post, use
+     *  UserAllocatedEvent::call_from_isr.
+     *
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     *
+     *  @see equeue_post_isr
+     */
+    template <typename F>
+    int call_from_isr(F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post_isr(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue from an interrupt
+     *  @see                    EventQueue::call_from_isr
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param args             Arguments to pass to the callback
+     */
+    template <typename F, typename... ArgTs>
+    int call_from_isr(F f, ArgTs... args)
+    {
+        return call_from_isr(context<F, ArgTs...>(std::move(f), args...));
+    }
+
     /** Calls an event on the queue
      *  @see EventQueue::call
      */
@@ -839,6 +946,43 @@ public:
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
+    /** Calls an event on the queue after a specified delay with a priority
+     *  @see                    EventQueue::call_in, EventQueue::call(Priority, F)
+     *  @param ms               Time to delay in milliseconds
+     *  @param prio             Priority of the event
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @return                 A unique id that represents the posted event and can
+     *                          be passed to cancel, or an id of 0 if there is not
+     *                          enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_in(duration ms, Priority prio, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_delay(e, ms.count());
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        equeue_event_priority(e, static_cast<int>(prio));
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue after a specified delay with a priority
+     *  @see                    EventQueue::call_in(duration, Priority, F)
+     *  @param ms               Time to delay in milliseconds
+     *  @param prio             Priority of the event
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param args             Arguments to pass to the callback
+     */
+    template <typename F, typename... ArgTs>
+    int call_in(duration ms, Priority prio, F f, ArgTs... args)
+    {
+        return call_in(ms, prio, context<F, ArgTs...>(std::move(f), args...));
+    }
+
     /** Calls an event on the queue after a specified delay
      *  @see                        EventQueue::call_in
      *  @param ms                   Time to delay in milliseconds
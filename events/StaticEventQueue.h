@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATIC_EVENT_QUEUE_H
+#define STATIC_EVENT_QUEUE_H
+
+#include "events/EventQueue.h"
+#include "platform/mbed_assert.h"
+
+namespace events {
+/**
+ * \addtogroup events-public-api
+ * @{
+ */
+
+/**
+ * \defgroup events_StaticEventQueue StaticEventQueue class
+ * @{
+ */
+
+/** StaticEventQueue
+ *
+ *  Event queue with storage for a fixed number of events sized at compile
+ *  time.
+ *
+ *  The queue buffer is a member of the object, so a StaticEventQueue with
+ *  static storage duration is placed in .bss and shows up in the map file.
+ *  Every event takes exactly EventSize bytes of the buffer, so the buffer
+ *  can not fragment: as long as each event fits in EventSize, and no more
+ *  than N events are pending at once, posting never fails.
+ *
+ *  The size of an event is the size of the callback and its bound
+ *  arguments plus the event overhead. The default EventSize,
+ *  EVENTS_EVENT_SIZE, fits a Callback<void()>, which covers calls of free
+ *  functions with up to two pointer-sized arguments or member functions.
+ *
+ * Usage:
+ * @code
+ *  #include "mbed.h"
+ *
+ *  // room for 8 pending events of the default size
+ *  static StaticEventQueue<8> queue;
+ *
+ *  int main()
+ *  {
+ *      queue.call(printf, "called immediately\n");
+ *      queue.dispatch_forever();
+ *  }
+ * @endcode
+ *
+ *  @tparam N           Maximum number of pending events
+ *  @tparam EventSize   Size of each event in bytes, including event overhead
+ */
+template <size_t N, size_t EventSize = EVENTS_EVENT_SIZE>
+class StaticEventQueue : public EventQueue {
+    static constexpr size_t chunk_size = (EventSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+    static_assert(N > 0, "StaticEventQueue must hold at least one event");
+    static_assert(EventSize >= sizeof(struct equeue_event), "EventSize must include the event overhead");
+
+public:
+    /** Create a StaticEventQueue
+     */
+    StaticEventQueue() : EventQueue(sizeof(_buffer), reinterpret_cast<unsigned char *>(_buffer))
+    {
+        equeue_fixed_size(&_equeue, chunk_size);
+    }
+
+    /** Maximum number of pending events
+     *
+     *  @return     N, the number of events the queue can always hold
+     */
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    /** Largest callback that fits in an event
+     *
+     *  @return     Maximum size in bytes of a callback and its bound
+     *              arguments that can be posted to the queue
+     */
+    static constexpr size_t max_callback_size()
+    {
+        return chunk_size - sizeof(struct equeue_event);
+    }
+
+private:
+    void *_buffer[N * chunk_size / sizeof(void *)];
+};
+
+/** @}*/
+
+/** @}*/
+
+}
+
+#endif
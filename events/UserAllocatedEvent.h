@@ -191,6 +191,38 @@ public:
         return post_on(queue);
     }
 
+    /** Posts an event onto the underlying event queue from an interrupt, returning void
+    *
+    *  The event is pushed onto the queue's lock-free interrupt list with an
+    *  atomic compare-and-swap, and moved into the queue by the dispatch loop.
+    *  Unlike call, this does not mask interrupts while posting.
+    *
+    *  This call cannot fail due queue memory exhaustion
+    *  because it doesn't allocate any memory
+    *
+    *  @see equeue_post_user_allocated_isr
+    */
+    void call_from_isr()
+    {
+        MBED_ASSERT(!_post_ref);
+        MBED_ASSERT(_equeue);
+        MBED_UNUSED bool status = post_isr();
+        MBED_ASSERT(status);
+    }
+
+    /** Posts an event onto the underlying event queue from an interrupt
+    *
+    *  @see UserAllocatedEvent::call_from_isr
+    *
+    *  @return     False if the event was already posted
+    *              true otherwise
+    *
+    */
+    bool try_call_from_isr()
+    {
+        return post_isr();
+    }
+
     /** Posts an event onto the underlying event queue, returning void
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -268,6 +300,18 @@ private:
         return true;
     }
 
+    bool post_isr()
+    {
+        if (_post_ref) {
+            return false;
+        }
+        core_util_atomic_incr_u8(&_post_ref, 1);
+        equeue_event_delay(&_e + 1, _delay);
+        equeue_event_period(&_e + 1, _period);
+        equeue_post_user_allocated_isr(_equeue, &EventQueue::function_call<C>, &_e);
+        return true;
+    }
+
     bool post_on(EventQueue *queue)
     {
         MBED_ASSERT(queue);
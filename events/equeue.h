@@ -38,7 +38,65 @@ extern "C" {
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// Number of size classes used by the event allocator
+//
+// When non-zero, freed events are kept in per-size-class free lists, with
+// class n holding chunks of EQUEUE_EVENT_SIZE << n bytes. Allocations that
+// fit in a class are rounded up to the class size, which makes equeue_alloc
+// and equeue_dealloc constant time at the cost of some internal
+// fragmentation. Larger allocations fall back to the first-fit chunk list.
+#ifndef EQUEUE_SIZE_CLASSES
+#ifdef MBED_CONF_EVENTS_SIZE_CLASSES
+#define EQUEUE_SIZE_CLASSES MBED_CONF_EVENTS_SIZE_CLASSES
+#else
+#define EQUEUE_SIZE_CLASSES 0
+#endif
+#endif
+
+// Use a pairing heap for timed events
+//
+// By default pending events are kept in a sorted list, which makes posting
+// an event linear in the number of pending events. When EQUEUE_TIMER_HEAP
+// is enabled, events are kept in a pairing heap instead, which makes
+// posting constant time and dispatching and cancelling logarithmic,
+// at the cost of a slightly larger event.
+#ifndef EQUEUE_TIMER_HEAP
+#if defined(MBED_CONF_EVENTS_TIMER_HEAP) && MBED_CONF_EVENTS_TIMER_HEAP
+#define EQUEUE_TIMER_HEAP 1
+#else
+#define EQUEUE_TIMER_HEAP 0
+#endif
+#endif
+
+// Number of event priority levels
+//
+// When greater than one, events carry a priority set with
+// equeue_event_priority, and events that are due at the same time are
+// dispatched highest priority first. Higher priority events that become
+// due while a batch of events is being dispatched overtake the remaining
+// lower priority events of that batch.
+#ifndef EQUEUE_PRIORITIES
+#ifdef MBED_CONF_EVENTS_PRIORITIES
+#define EQUEUE_PRIORITIES MBED_CONF_EVENTS_PRIORITIES
+#else
+#define EQUEUE_PRIORITIES 1
+#endif
+#endif
+
+// Enable event memory statistics, see equeue_get_mem_stats
+#ifndef EQUEUE_MEM_STATS
+#if defined(MBED_CONF_EVENTS_MEM_STATS_ENABLED) && MBED_CONF_EVENTS_MEM_STATS_ENABLED
+#define EQUEUE_MEM_STATS 1
+#else
+#define EQUEUE_MEM_STATS 0
+#endif
+#endif
+
 // Internal event structure
+//
+// In the timer heap, sibling points to the first child of an event, next
+// to the following child of the same parent, and seq orders events with
+// the same target in posting order.
 struct equeue_event {
     unsigned size;
     uint8_t id;
@@ -53,14 +111,66 @@ struct equeue_event {
     void (*dtor)(void *);
 
     void (*cb)(void *);
+#if EQUEUE_TIMER_HEAP
+    unsigned seq;
+#endif
+#if EQUEUE_PRIORITIES > 1
+    uint8_t priority;
+#endif
     // data follows
 };
 
+// Enable dispatch statistics, see equeue_get_dispatch_stats
+#ifndef EQUEUE_DISPATCH_STATS
+#if (defined(MBED_CONF_EVENTS_DISPATCH_STATS_ENABLED) && MBED_CONF_EVENTS_DISPATCH_STATS_ENABLED) || defined(MBED_ALL_STATS_ENABLED)
+#define EQUEUE_DISPATCH_STATS 1
+#else
+#define EQUEUE_DISPATCH_STATS 0
+#endif
+#endif
+
+// Number of buckets in the dispatch latency histogram
+#define EQUEUE_LATENCY_BUCKETS 8
+
+// Event dispatch statistics
+//
+// Latency is how late an event was dispatched relative to its target tick.
+// Bucket 0 counts events dispatched on time, bucket n counts events that
+// were between 2^(n-1) and 2^n-1 ms late, and the last bucket counts all
+// later events. Run times are measured with equeue_tick, and so have the
+// same resolution.
+typedef struct equeue_dispatch_stats {
+    uint32_t dispatch_cnt;                              // Number of events dispatched
+    uint32_t latency[EQUEUE_LATENCY_BUCKETS];           // Dispatch latency histogram
+    unsigned max_latency;                               // Worst dispatch latency in ms
+    unsigned max_runtime;                               // Longest callback run time in ms
+    void (*max_runtime_cb)(void *);                     // Callback that ran the longest
+    unsigned pending_cnt;                               // Number of events currently pending
+    unsigned max_pending_cnt;                           // High-water mark of pending_cnt
+} equeue_dispatch_stats_t;
+
+// Event memory statistics
+typedef struct equeue_mem_stats {
+    size_t reserved_size;       // Bytes carved out of the queue buffer so far
+    size_t current_size;        // Bytes currently held by allocated events
+    size_t max_size;            // High-water mark of current_size
+    size_t free_size;           // Bytes held in free chunks that are not in use
+    uint32_t alloc_cnt;         // Number of successful allocations
+    uint32_t alloc_fail_cnt;    // Number of failed allocations
+} equeue_mem_stats_t;
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+    struct equeue_event *volatile deferred;
+#if EQUEUE_TIMER_HEAP
+    unsigned seq;
+#endif
     unsigned tick;
     bool break_requested;
+#if EQUEUE_PRIORITIES > 1
+    bool preempt;
+#endif
     uint8_t generation;
 
     unsigned char *buffer;
@@ -68,10 +178,20 @@ typedef struct equeue {
     void *allocated;
 
     struct equeue_event *chunks;
+    size_t chunk_size;
+#if EQUEUE_SIZE_CLASSES
+    struct equeue_event *classes[EQUEUE_SIZE_CLASSES];
+#endif
     struct equeue_slab {
         size_t size;
         unsigned char *data;
     } slab;
+#if EQUEUE_MEM_STATS
+    equeue_mem_stats_t mem_stats;
+#endif
+#if EQUEUE_DISPATCH_STATS
+    equeue_dispatch_stats_t dispatch_stats;
+#endif
 
     struct equeue_background {
         bool active;
@@ -111,6 +231,21 @@ void equeue_destroy(equeue_t *queue);
 // equeue_dispatch does not wait and is irq safe.
 void equeue_dispatch(equeue_t *queue, int ms);
 
+// Query dispatch statistics
+//
+// Fills in the provided structure with latency, run time and queue depth
+// statistics of the queue, which can be used to spot starved queues or
+// callbacks that hog the dispatch loop. equeue_reset_dispatch_stats clears
+// everything except the current pending count.
+//
+// Statistics are only gathered if EQUEUE_DISPATCH_STATS is enabled,
+// otherwise the structure is zeroed and equeue_get_dispatch_stats
+// returns false.
+//
+// Both functions are irq safe.
+bool equeue_get_dispatch_stats(equeue_t *queue, equeue_dispatch_stats_t *stats);
+void equeue_reset_dispatch_stats(equeue_t *queue);
+
 // Break out of a running event loop
 //
 // Forces the specified event queue's dispatch loop to terminate. Pending
@@ -149,6 +284,8 @@ int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 // well as avoid memory fragmentation on small devices. The allocator achieves
 // both constant-runtime and zero-fragmentation for fixed-size events, however
 // grows linearly as the quantity of different sized allocations increases.
+// If EQUEUE_SIZE_CLASSES is enabled, allocations that fit in a size class
+// are constant-runtime regardless of the mix of event sizes.
 //
 // The equeue_alloc function returns a pointer to the event's allocated memory
 // and acts as a handle to the underlying event. If there is not enough memory
@@ -156,14 +293,42 @@ int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 void *equeue_alloc(equeue_t *queue, size_t size);
 void equeue_dealloc(equeue_t *queue, void *event);
 
+// Fix the size of event allocations
+//
+// After calling equeue_fixed_size, every allocation takes exactly size
+// bytes of the buffer, including the event overhead as with
+// EQUEUE_EVENT_SIZE, and allocations that do not fit fail. As every chunk
+// is the same size the buffer can not fragment, so a buffer of n chunks
+// always holds n events, and allocation is constant time.
+//
+// Must be called before any events are allocated. A size of 0 restores
+// variable sized allocations.
+void equeue_fixed_size(equeue_t *queue, size_t size);
+
+// Query event memory statistics
+//
+// Fills in the provided structure with the current allocation statistics of
+// the queue's event buffer. The free_size field gives the amount of memory
+// lost to fragmentation, and max_size can be used to size the queue buffer
+// from real usage.
+//
+// Statistics are only gathered if EQUEUE_MEM_STATS is enabled, otherwise
+// the structure is zeroed and equeue_get_mem_stats returns false.
+//
+// The equeue_get_mem_stats function is irq safe.
+bool equeue_get_mem_stats(equeue_t *queue, equeue_mem_stats_t *stats);
+
 // Configure an allocated event
 //
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_priority - Priority level of the event, from 0 (the default)
+//                         to EQUEUE_PRIORITIES-1, larger values are clamped
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_priority(void *event, int priority);
 
 // Post an event onto the event queue
 //
@@ -190,6 +355,24 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 // a mechanism for moving events out of irq contexts.
 void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post an event from an interrupt without taking the queue lock
+//
+// The equeue_post_isr and equeue_post_user_allocated_isr functions behave
+// like equeue_post and equeue_post_user_allocated, except that the event
+// is pushed onto a lock-free list with an atomic compare-and-swap instead
+// of being inserted into the queue under the queue lock. The dispatch loop
+// moves these events into the queue before dispatching, so high-rate
+// interrupts can defer work without masking other interrupts. Combined
+// with user allocated events, posting does not lock at all.
+//
+// Until the dispatch loop has picked up the event, equeue_cancel returns
+// false, but the event is still prevented from being dispatched.
+//
+// If the queue is backgrounded or chained, these functions fall back to
+// the locked path, as the background timer must be updated on post.
+int equeue_post_isr(equeue_t *queue, void (*cb)(void *), void *event);
+void equeue_post_user_allocated_isr(equeue_t *queue, void (*cb)(void *), void *event);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -205,6 +388,28 @@ void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *), void *event
 // Returning false if invalid id or already started executing.
 bool equeue_cancel(equeue_t *queue, int id);
 
+// Update a pending event
+//
+// Attempts to find the event referenced by the unique id returned from
+// equeue_call or equeue_post, and if it is still waiting to be dispatched,
+// calls the update function with the event's memory and the provided
+// context while holding the queue lock. This allows a posting context to
+// coalesce a burst of identical posts into a single pending event, for
+// example by refreshing the event's arguments instead of allocating a new
+// event.
+//
+// Returns true if the update function was called. Returns false if the id
+// is invalid, the event has already begun dispatching, or the event was
+// posted with equeue_post_isr and not yet picked up by the dispatch loop.
+//
+// The update function is called with the queue lock held, which may be a
+// critical section, so it must be short and must not call back into the
+// queue.
+//
+// The equeue_update function is irq safe.
+bool equeue_update(equeue_t *queue, int id,
+                   void (*update)(void *event, void *context), void *context);
+
 // Cancel an in-flight user allocated event
 //
 // Attempts to cancel an event referenced by its address.
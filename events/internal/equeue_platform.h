@@ -53,6 +53,30 @@ extern "C" {
 #endif
 
 
+// Platform tracing and profiling of dispatched callbacks
+#if defined(EQUEUE_PLATFORM_MBED)
+#include "platform/mbed_rtos_trace.h"
+#include "platform/mbed_profile.h"
+#define EQUEUE_TRACE_DISPATCH(cb) MBED_RTOS_TRACE(MBED_RTOS_TRACE_EVENT_DISPATCH, cb)
+#define EQUEUE_TRACE_DONE(cb) MBED_RTOS_TRACE(MBED_RTOS_TRACE_EVENT_DONE, cb)
+#define EQUEUE_PROFILE_START(site, name) MBED_PROFILE_START(site, name)
+#define EQUEUE_PROFILE_STOP(site) MBED_PROFILE_STOP(site)
+#else
+#define EQUEUE_TRACE_DISPATCH(cb)
+#define EQUEUE_TRACE_DONE(cb)
+#define EQUEUE_PROFILE_START(site, name)
+#define EQUEUE_PROFILE_STOP(site)
+#endif
+
+// Platform placement of the dispatch loop in fast memory
+#if defined(EQUEUE_PLATFORM_MBED)
+#include "platform/mbed_toolchain.h"
+#define EQUEUE_FAST_CODE MBED_FAST_CODE
+#else
+#define EQUEUE_FAST_CODE
+#endif
+
+
 // Platform millisecond counter
 //
 // Return a tick that represents the number of milliseconds that have passed
@@ -96,6 +120,23 @@ void equeue_mutex_lock(equeue_mutex_t *mutex);
 void equeue_mutex_unlock(equeue_mutex_t *mutex);
 
 
+// Platform atomic operations
+//
+// The equeue library uses atomic pointer operations to let interrupt
+// contexts post events without taking the queue lock. These must be safe
+// to call from interrupt contexts.
+//
+// The equeue_atomic_cas_ptr function compares the pointer at ptr with the
+// pointer at expected and, if they match, replaces it with desired and
+// returns true. Otherwise expected is updated with the current value and
+// false is returned.
+//
+// The equeue_atomic_xchg_ptr function replaces the pointer at ptr with
+// desired and returns the previous value.
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void **expected, void *desired);
+void *equeue_atomic_xchg_ptr(void *volatile *ptr, void *desired);
+
+
 // Platform semaphore type
 //
 // The equeue library requires a binary semaphore type that can be safely
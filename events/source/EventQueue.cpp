@@ -66,6 +66,15 @@ int EventQueue::time_left(int id)
     return equeue_timeleft(&_equeue, id);
 }
 
+bool EventQueue::get_dispatch_stats(equeue_dispatch_stats_t *stats, bool reset)
+{
+    bool enabled = equeue_get_dispatch_stats(&_equeue, stats);
+    if (reset) {
+        equeue_reset_dispatch_stats(&_equeue);
+    }
+    return enabled;
+}
+
 void EventQueue::background(Callback<void(int)> update)
 {
     _update = update;
@@ -91,14 +91,33 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     }
 
     q->chunks = 0;
+    q->chunk_size = 0;
+#if EQUEUE_SIZE_CLASSES
+    for (unsigned i = 0; i < EQUEUE_SIZE_CLASSES; i++) {
+        q->classes[i] = 0;
+    }
+#endif
+#if EQUEUE_MEM_STATS
+    memset(&q->mem_stats, 0, sizeof(q->mem_stats));
+#endif
+#if EQUEUE_DISPATCH_STATS
+    memset(&q->dispatch_stats, 0, sizeof(q->dispatch_stats));
+#endif
     q->slab.size = size;
     q->slab.data = q->buffer;
 
     q->queue = 0;
+    q->deferred = 0;
+#if EQUEUE_TIMER_HEAP
+    q->seq = 0;
+#endif
     equeue_tick_init();
     q->tick = equeue_tick();
     q->generation = 0;
     q->break_requested = false;
+#if EQUEUE_PRIORITIES > 1
+    q->preempt = false;
+#endif
 
     q->background.active = false;
     q->background.update = 0;
@@ -124,9 +143,25 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     return 0;
 }
 
+#if EQUEUE_TIMER_HEAP
+static struct equeue_event *equeue_heap_pop(equeue_t *q);
+#endif
+
 void equeue_destroy(equeue_t *q)
 {
     // call destructors on pending events
+    for (struct equeue_event *e = q->deferred; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+#if EQUEUE_TIMER_HEAP
+    for (struct equeue_event *e = equeue_heap_pop(q); e; e = equeue_heap_pop(q)) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+#endif
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
             if (e->dtor) {
@@ -151,14 +186,74 @@ void equeue_destroy(equeue_t *q)
 
 
 // equeue chunk allocation functions
+#if EQUEUE_SIZE_CLASSES
+// find the smallest size class that fits the chunk size, or
+// EQUEUE_SIZE_CLASSES if the chunk is too big for any class
+static inline unsigned equeue_size_class(size_t size)
+{
+    unsigned c = 0;
+    while (c < EQUEUE_SIZE_CLASSES && ((size_t)EQUEUE_EVENT_SIZE << c) < size) {
+        c++;
+    }
+    return c;
+}
+#endif
+
+static inline void equeue_mem_stats_alloc(equeue_t *q, struct equeue_event *e, bool carved)
+{
+#if EQUEUE_MEM_STATS
+    q->mem_stats.alloc_cnt += 1;
+    q->mem_stats.current_size += e->size;
+    if (q->mem_stats.current_size > q->mem_stats.max_size) {
+        q->mem_stats.max_size = q->mem_stats.current_size;
+    }
+    if (carved) {
+        q->mem_stats.reserved_size += e->size;
+    } else {
+        q->mem_stats.free_size -= e->size;
+    }
+#endif
+}
+
 static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
 {
     // add event overhead
     size += sizeof(struct equeue_event);
     size = (size + sizeof(void *) -1) & ~(sizeof(void *) -1);
 
+    // fixed size queues round every allocation up to the chunk size
+    if (q->chunk_size) {
+        if (size > q->chunk_size) {
+            return 0;
+        }
+        size = q->chunk_size;
+    }
+
     equeue_mutex_lock(&q->memlock);
 
+#if EQUEUE_SIZE_CLASSES
+    // check the size class free lists first, these are exact sizes so
+    // the first chunk of any fitting class will do
+    unsigned c = q->chunk_size ? EQUEUE_SIZE_CLASSES : equeue_size_class(size);
+    for (unsigned i = c; i < EQUEUE_SIZE_CLASSES; i++) {
+        struct equeue_event *e = q->classes[i];
+        if (e) {
+            q->classes[i] = e->next;
+            equeue_mem_stats_alloc(q, e, false);
+
+            equeue_mutex_unlock(&q->memlock);
+            return e;
+        }
+
+        // round up to the class size so the chunk can be reused by any
+        // allocation in the same class, if the slab can spare it
+        if (i == c && q->slab.size >= ((size_t)EQUEUE_EVENT_SIZE << c)) {
+            size = (size_t)EQUEUE_EVENT_SIZE << c;
+            break;
+        }
+    }
+#endif
+
     // check if a good chunk is available
     for (struct equeue_event **p = &q->chunks; *p; p = &(*p)->next) {
         if ((*p)->size >= size) {
@@ -169,6 +264,7 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
             } else {
                 *p = e->next;
             }
+            equeue_mem_stats_alloc(q, e, false);
 
             equeue_mutex_unlock(&q->memlock);
             return e;
@@ -182,11 +278,15 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
         q->slab.size -= size;
         e->size = size;
         e->id = 1;
+        equeue_mem_stats_alloc(q, e, true);
 
         equeue_mutex_unlock(&q->memlock);
         return e;
     }
 
+#if EQUEUE_MEM_STATS
+    q->mem_stats.alloc_fail_cnt += 1;
+#endif
     equeue_mutex_unlock(&q->memlock);
     return 0;
 }
@@ -195,6 +295,23 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
 {
     equeue_mutex_lock(&q->memlock);
 
+#if EQUEUE_MEM_STATS
+    q->mem_stats.current_size -= e->size;
+    q->mem_stats.free_size += e->size;
+#endif
+
+#if EQUEUE_SIZE_CLASSES
+    // chunks of exactly a class size go on that class's free list
+    unsigned c = q->chunk_size ? EQUEUE_SIZE_CLASSES : equeue_size_class(e->size);
+    if (c < EQUEUE_SIZE_CLASSES && e->size == ((size_t)EQUEUE_EVENT_SIZE << c)) {
+        e->next = q->classes[c];
+        q->classes[c] = e;
+
+        equeue_mutex_unlock(&q->memlock);
+        return;
+    }
+#endif
+
     // stick chunk into list of chunks
     struct equeue_event **p = &q->chunks;
     while (*p && (*p)->size < e->size) {
@@ -213,6 +330,24 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
     equeue_mutex_unlock(&q->memlock);
 }
 
+void equeue_fixed_size(equeue_t *q, size_t size)
+{
+    q->chunk_size = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+}
+
+bool equeue_get_mem_stats(equeue_t *q, equeue_mem_stats_t *stats)
+{
+#if EQUEUE_MEM_STATS
+    equeue_mutex_lock(&q->memlock);
+    *stats = q->mem_stats;
+    equeue_mutex_unlock(&q->memlock);
+    return true;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return false;
+#endif
+}
+
 void *equeue_alloc(equeue_t *q, size_t size)
 {
     struct equeue_event *e = equeue_mem_alloc(q, size);
@@ -223,6 +358,9 @@ void *equeue_alloc(equeue_t *q, size_t size)
     e->target = 0;
     e->period = -1;
     e->dtor = 0;
+#if EQUEUE_PRIORITIES > 1
+    e->priority = 0;
+#endif
 
     return e + 1;
 }
@@ -242,6 +380,111 @@ void equeue_dealloc(equeue_t *q, void *p)
     }
 }
 
+#if EQUEUE_TIMER_HEAP
+// pairing heap of pending events, ordered by target and then by posting
+// order, the root of the heap is always the next event to dispatch
+static inline bool equeue_heap_before(struct equeue_event *a, struct equeue_event *b)
+{
+    int diff = equeue_tickdiff(a->target, b->target);
+    return diff < 0 || (diff == 0 && equeue_tickdiff(a->seq, b->seq) < 0);
+}
+
+// meld two heaps, the second heap becomes the first child of the winner
+static struct equeue_event *equeue_heap_meld(struct equeue_event *a, struct equeue_event *b)
+{
+    if (equeue_heap_before(b, a)) {
+        struct equeue_event *t = a;
+        a = b;
+        b = t;
+    }
+
+    b->next = a->sibling;
+    if (b->next) {
+        b->next->ref = &b->next;
+    }
+    a->sibling = b;
+    b->ref = &a->sibling;
+    return a;
+}
+
+// meld a list of sibling heaps using the standard two-pass scheme
+static struct equeue_event *equeue_heap_meld_list(struct equeue_event *list)
+{
+    // meld pairs left to right, building up a reversed list
+    struct equeue_event *pairs = 0;
+    while (list) {
+        struct equeue_event *a = list;
+        struct equeue_event *b = a->next;
+        if (b) {
+            list = b->next;
+            a->next = 0;
+            b->next = 0;
+            a = equeue_heap_meld(a, b);
+        } else {
+            list = 0;
+        }
+
+        a->next = pairs;
+        pairs = a;
+    }
+
+    // meld the pairs right to left into a single heap
+    struct equeue_event *root = 0;
+    while (pairs) {
+        struct equeue_event *a = pairs;
+        pairs = a->next;
+        a->next = 0;
+        root = root ? equeue_heap_meld(root, a) : a;
+    }
+
+    return root;
+}
+
+static void equeue_heap_setroot(equeue_t *q, struct equeue_event *e)
+{
+    q->queue = e;
+    if (e) {
+        e->next = 0;
+        e->ref = &q->queue;
+    }
+}
+
+static void equeue_heap_insert(equeue_t *q, struct equeue_event *e)
+{
+    e->seq = q->seq++;
+    e->next = 0;
+    e->sibling = 0;
+    equeue_heap_setroot(q, q->queue ? equeue_heap_meld(q->queue, e) : e);
+}
+
+static void equeue_heap_remove(equeue_t *q, struct equeue_event *e)
+{
+    // detach the event's subtree from its parent
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    }
+
+    // and meld its children back into the heap
+    struct equeue_event *children = equeue_heap_meld_list(e->sibling);
+    e->sibling = 0;
+    if (children) {
+        equeue_heap_setroot(q, q->queue ? equeue_heap_meld(q->queue, children) : children);
+    }
+}
+
+static struct equeue_event *equeue_heap_pop(equeue_t *q)
+{
+    struct equeue_event *e = q->queue;
+    if (e) {
+        equeue_heap_setroot(q, equeue_heap_meld_list(e->sibling));
+        e->sibling = 0;
+        e->next = 0;
+    }
+    return e;
+}
+#endif
+
 void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 {
     e->target = tick + equeue_clampdiff(e->target, tick);
@@ -249,6 +492,23 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     equeue_mutex_lock(&q->queuelock);
 
+#if EQUEUE_DISPATCH_STATS
+    q->dispatch_stats.pending_cnt += 1;
+    if (q->dispatch_stats.pending_cnt > q->dispatch_stats.max_pending_cnt) {
+        q->dispatch_stats.max_pending_cnt = q->dispatch_stats.pending_cnt;
+    }
+#endif
+
+#if EQUEUE_PRIORITIES > 1
+    // let the dispatch loop know a prioritized event is due
+    if (e->priority && e->target == tick) {
+        q->preempt = true;
+    }
+#endif
+
+#if EQUEUE_TIMER_HEAP
+    equeue_heap_insert(q, e);
+#else
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -274,10 +534,16 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
 
     *p = e;
     e->ref = p;
+#endif
 
     // notify background timer
+#if EQUEUE_TIMER_HEAP
+    if ((q->background.update && q->background.active) &&
+            (q->queue == e)) {
+#else
     if ((q->background.update && q->background.active) &&
             (q->queue == e && !e->sibling)) {
+#endif
         q->background.update(q->background.timer,
                              equeue_clampdiff(e->target, tick));
     }
@@ -304,7 +570,21 @@ static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue
         return 0;
     }
 
+    // events posted from interrupts are not in the queue until the
+    // dispatch loop picks them up, clearing the callback is all we can do
+    if (!e->ref) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
+#if EQUEUE_DISPATCH_STATS
+    q->dispatch_stats.pending_cnt -= 1;
+#endif
+
     // disentangle from queue
+#if EQUEUE_TIMER_HEAP
+    equeue_heap_remove(q, e);
+#else
     if (e->sibling) {
         e->sibling->next = e->next;
         if (e->sibling->next) {
@@ -319,6 +599,7 @@ static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue
             e->next->ref = e->ref;
         }
     }
+#endif
     equeue_mutex_unlock(&q->queuelock);
     return e;
 }
@@ -352,10 +633,27 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
 
     // find all expired events and mark a new generation
     q->generation += 1;
+#if EQUEUE_PRIORITIES > 1
+    q->preempt = false;
+#endif
     if (equeue_tickdiff(q->tick, target) <= 0) {
         q->tick = target;
     }
 
+#if EQUEUE_TIMER_HEAP
+    // pop expired events in order, they are already flattened
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    while (q->queue && equeue_tickdiff(q->queue->target, target) <= 0) {
+        *tail = equeue_heap_pop(q);
+        tail = &(*tail)->next;
+#if EQUEUE_DISPATCH_STATS
+        q->dispatch_stats.pending_cnt -= 1;
+#endif
+    }
+
+    equeue_mutex_unlock(&q->queuelock);
+#else
     struct equeue_event *head = q->queue;
     struct equeue_event **p = &head;
     while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
@@ -388,6 +686,20 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         tail = &es->next;
     }
 
+#if EQUEUE_DISPATCH_STATS
+    unsigned count = 0;
+    for (struct equeue_event *e = head; e; e = e->next) {
+        count++;
+    }
+
+    if (count) {
+        equeue_mutex_lock(&q->queuelock);
+        q->dispatch_stats.pending_cnt -= count;
+        equeue_mutex_unlock(&q->queuelock);
+    }
+#endif
+#endif
+
     return head;
 }
 
@@ -416,6 +728,72 @@ void equeue_post_user_allocated(equeue_t *q, void (*cb)(void *), void *p)
     equeue_sema_signal(&q->eventsema);
 }
 
+// push an event onto the deferred list, this is lock-free as the
+// dispatch loop only ever takes the whole list
+static void equeue_defer(equeue_t *q, struct equeue_event *e)
+{
+    e->ref = 0;
+    void *head = q->deferred;
+    do {
+        e->next = head;
+    } while (!equeue_atomic_cas_ptr((void *volatile *)&q->deferred, &head, e));
+}
+
+static void equeue_undefer(equeue_t *q, unsigned tick)
+{
+    if (!q->deferred) {
+        return;
+    }
+
+    // take the whole list and reverse it to match posting order
+    struct equeue_event *es = equeue_atomic_xchg_ptr((void *volatile *)&q->deferred, 0);
+    struct equeue_event *prev = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = prev;
+        prev = e;
+    }
+
+    while (prev) {
+        struct equeue_event *e = prev;
+        prev = e->next;
+        equeue_enqueue(q, e, tick);
+    }
+}
+
+int equeue_post_isr(equeue_t *q, void (*cb)(void *), void *p)
+{
+    if (q->background.update) {
+        return equeue_post(q, cb, p);
+    }
+
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->cb = cb;
+    e->target = equeue_tick() + e->target;
+
+    int id = equeue_event_id(q, e);
+    equeue_defer(q, e);
+    equeue_sema_signal(&q->eventsema);
+    return id;
+}
+
+void equeue_post_user_allocated_isr(equeue_t *q, void (*cb)(void *), void *p)
+{
+    if (q->background.update) {
+        equeue_post_user_allocated(q, cb, p);
+        return;
+    }
+
+    struct equeue_event *e = (struct equeue_event *)p;
+    e->cb = cb;
+    e->target = equeue_tick() + e->target;
+    e->id = EQUEUE_USER_ALLOCATED_EVENT_STATE_INPROGRESS;
+
+    equeue_defer(q, e);
+    equeue_sema_signal(&q->eventsema);
+}
+
 bool equeue_cancel(equeue_t *q, int id)
 {
     if (!id) {
@@ -446,6 +824,35 @@ bool equeue_cancel_user_allocated(equeue_t *q, void *e)
     }
 }
 
+bool equeue_update(equeue_t *q, int id,
+                   void (*update)(void *event, void *context), void *context)
+{
+    if (!id) {
+        return false;
+    }
+
+    // decode event from unique id and check that the local id matches
+    struct equeue_event *e = (struct equeue_event *)
+                             &q->buffer[id & ((1u << q->npw2) - 1u)];
+
+    equeue_mutex_lock(&q->queuelock);
+    if (e->id != (unsigned)id >> q->npw2 || !e->ref || !e->cb) {
+        equeue_mutex_unlock(&q->queuelock);
+        return false;
+    }
+
+    // check the event has not been dequeued for dispatch
+    int diff = equeue_tickdiff(e->target, q->tick);
+    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+        equeue_mutex_unlock(&q->queuelock);
+        return false;
+    }
+
+    update(e + 1, context);
+    equeue_mutex_unlock(&q->queuelock);
+    return true;
+}
+
 int equeue_timeleft(equeue_t *q, int id)
 {
     int ret = -1;
@@ -489,15 +896,117 @@ void equeue_break(equeue_t *q)
     equeue_sema_signal(&q->eventsema);
 }
 
-void equeue_dispatch(equeue_t *q, int ms)
+#if EQUEUE_DISPATCH_STATS
+static void ecallback_dispatch(void *p);
+
+static void equeue_dispatch_stats_record(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    unsigned latency = equeue_clampdiff(tick, e->target);
+    unsigned bucket = 0;
+    while (bucket < EQUEUE_LATENCY_BUCKETS - 1 && (latency >> bucket)) {
+        bucket++;
+    }
+
+    equeue_mutex_lock(&q->queuelock);
+    q->dispatch_stats.dispatch_cnt += 1;
+    q->dispatch_stats.latency[bucket] += 1;
+    if (latency > q->dispatch_stats.max_latency) {
+        q->dispatch_stats.max_latency = latency;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+static void equeue_dispatch_stats_runtime(equeue_t *q, struct equeue_event *e,
+                                          void (*cb)(void *), unsigned start)
+{
+    unsigned runtime = equeue_clampdiff(equeue_tick(), start);
+
+    equeue_mutex_lock(&q->queuelock);
+    if (runtime > q->dispatch_stats.max_runtime || !q->dispatch_stats.max_runtime_cb) {
+        // report the user's callback rather than the equeue_call wrapper
+        if (cb == ecallback_dispatch) {
+            cb = *(void (**)(void *))(e + 1);
+        }
+        q->dispatch_stats.max_runtime = runtime;
+        q->dispatch_stats.max_runtime_cb = cb;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+}
+#endif
+
+bool equeue_get_dispatch_stats(equeue_t *q, equeue_dispatch_stats_t *stats)
+{
+#if EQUEUE_DISPATCH_STATS
+    equeue_mutex_lock(&q->queuelock);
+    *stats = q->dispatch_stats;
+    equeue_mutex_unlock(&q->queuelock);
+    return true;
+#else
+    memset(stats, 0, sizeof(*stats));
+    return false;
+#endif
+}
+
+void equeue_reset_dispatch_stats(equeue_t *q)
+{
+#if EQUEUE_DISPATCH_STATS
+    equeue_mutex_lock(&q->queuelock);
+    unsigned pending_cnt = q->dispatch_stats.pending_cnt;
+    memset(&q->dispatch_stats, 0, sizeof(q->dispatch_stats));
+    q->dispatch_stats.pending_cnt = pending_cnt;
+    q->dispatch_stats.max_pending_cnt = pending_cnt;
+    equeue_mutex_unlock(&q->queuelock);
+#endif
+}
+
+#if EQUEUE_PRIORITIES > 1
+// sort a list of events by priority, highest first, while keeping the
+// order of events with the same priority
+static struct equeue_event *equeue_prioritize(struct equeue_event *es)
+{
+    struct equeue_event *heads[EQUEUE_PRIORITIES];
+    struct equeue_event **tails[EQUEUE_PRIORITIES];
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        heads[i] = 0;
+        tails[i] = &heads[i];
+    }
+
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        *tails[e->priority] = e;
+        tails[e->priority] = &e->next;
+    }
+
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    for (int i = EQUEUE_PRIORITIES - 1; i >= 0; i--) {
+        if (heads[i]) {
+            *tail = heads[i];
+            tail = tails[i];
+        }
+    }
+    *tail = 0;
+
+    return head;
+}
+#endif
+
+EQUEUE_FAST_CODE void equeue_dispatch(equeue_t *q, int ms)
 {
     unsigned tick = equeue_tick();
     unsigned timeout = tick + ms;
     q->background.active = false;
 
     while (1) {
+        // pick up events posted from interrupts
+        equeue_undefer(q, tick);
+
         // collect all the available events and next deadline
         struct equeue_event *es = equeue_dequeue(q, tick);
+#if EQUEUE_PRIORITIES > 1
+        es = equeue_prioritize(es);
+#endif
 
         // dispatch events
         while (es) {
@@ -507,7 +1016,18 @@ void equeue_dispatch(equeue_t *q, int ms)
             // actually dispatch the callbacks
             void (*cb)(void *) = e->cb;
             if (cb) {
+                EQUEUE_TRACE_DISPATCH(cb);
+                EQUEUE_PROFILE_START(dispatch_probe, "equeue_dispatch callback");
+#if EQUEUE_DISPATCH_STATS
+                unsigned start = equeue_tick();
+                equeue_dispatch_stats_record(q, e, start);
                 cb(e + 1);
+                equeue_dispatch_stats_runtime(q, e, cb, start);
+#else
+                cb(e + 1);
+#endif
+                EQUEUE_PROFILE_STOP(dispatch_probe);
+                EQUEUE_TRACE_DONE(cb);
             }
 
             // reenqueue periodic events or deallocate
@@ -520,6 +1040,18 @@ void equeue_dispatch(equeue_t *q, int ms)
                 }
                 equeue_dealloc(q, e + 1);
             }
+
+#if EQUEUE_PRIORITIES > 1
+            // let prioritized events that became due overtake the rest
+            if (q->preempt && es) {
+                struct equeue_event **tail = &es;
+                while (*tail) {
+                    tail = &(*tail)->next;
+                }
+                *tail = equeue_dequeue(q, equeue_tick());
+                es = equeue_prioritize(es);
+            }
+#endif
         }
 
         int deadline = -1;
@@ -593,6 +1125,19 @@ void equeue_event_dtor(void *p, void (*dtor)(void *))
     e->dtor = dtor;
 }
 
+void equeue_event_priority(void *p, int priority)
+{
+#if EQUEUE_PRIORITIES > 1
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    if (priority < 0) {
+        priority = 0;
+    } else if (priority > EQUEUE_PRIORITIES - 1) {
+        priority = EQUEUE_PRIORITIES - 1;
+    }
+    e->priority = priority;
+#endif
+}
+
 
 // simple callbacks
 struct ecallback {
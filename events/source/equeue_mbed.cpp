@@ -24,6 +24,7 @@
 #include <string.h>
 #include "cmsis.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
 #include "platform/mbed_power_mgmt.h"
 #include "drivers/Timer.h"
 #include "drivers/Ticker.h"
@@ -150,6 +151,18 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 }
 
 
+// Atomic operations
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void **expected, void *desired)
+{
+    return core_util_atomic_cas_ptr(ptr, expected, desired);
+}
+
+void *equeue_atomic_xchg_ptr(void *volatile *ptr, void *desired)
+{
+    return core_util_atomic_exchange_ptr(ptr, desired);
+}
+
+
 // Semaphore operations
 #ifdef MBED_CONF_RTOS_API_PRESENT
 
@@ -66,6 +66,11 @@ void sloth_func(void *p)
     (*(int *)p)++;
 }
 
+void simple_func_indirect(void *p)
+{
+    (**(int **)p)++;
+}
+
 struct indirect {
     int *touched;
     uint8_t buffer[7];
@@ -789,6 +794,7 @@ void sibling_test(void)
     int id1 = equeue_call_in(&q, 1, pass_func, 0);
     int id2 = equeue_call_in(&q, 1, pass_func, 0);
 
+#if !EQUEUE_TIMER_HEAP
     struct equeue_event *e = q.queue;
 
     for (; e; e = e->next) {
@@ -796,6 +802,7 @@ void sibling_test(void)
             test_assert(!s->next);
         }
     }
+#endif
     test_assert(equeue_cancel(&q, id0));
     test_assert(equeue_cancel(&q, id1));
     test_assert(equeue_cancel(&q, id2));
@@ -867,6 +874,391 @@ void id_cycle()
     equeue_destroy(&q);
 }
 
+void mem_stats_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    equeue_mem_stats_t stats;
+    if (!equeue_get_mem_stats(&q, &stats)) {
+        test_assert(stats.max_size == 0);
+        equeue_destroy(&q);
+        return;
+    }
+    test_assert(stats.current_size == 0);
+    test_assert(stats.alloc_cnt == 0);
+
+    void *a = equeue_alloc(&q, 8);
+    void *b = equeue_alloc(&q, 8);
+    test_assert(a && b);
+
+    equeue_get_mem_stats(&q, &stats);
+    test_assert(stats.alloc_cnt == 2);
+    test_assert(stats.current_size > 0);
+    test_assert(stats.max_size == stats.current_size);
+    test_assert(stats.reserved_size == stats.current_size);
+    test_assert(stats.free_size == 0);
+    size_t max = stats.max_size;
+
+    equeue_dealloc(&q, a);
+    equeue_get_mem_stats(&q, &stats);
+    test_assert(stats.current_size == max / 2);
+    test_assert(stats.free_size == max / 2);
+    test_assert(stats.max_size == max);
+
+    void *p = equeue_alloc(&q, 4096);
+    test_assert(!p);
+    equeue_get_mem_stats(&q, &stats);
+    test_assert(stats.alloc_fail_cnt == 1);
+
+    equeue_dealloc(&q, b);
+    equeue_get_mem_stats(&q, &stats);
+    test_assert(stats.current_size == 0);
+    test_assert(stats.free_size == stats.reserved_size);
+
+    equeue_destroy(&q);
+}
+
+void size_class_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 4096);
+    test_assert(!err);
+
+    // freed chunks must be reused by later allocations of a similar size
+    void *small[4];
+    void *large[4];
+    for (int i = 0; i < 4; i++) {
+        small[i] = equeue_alloc(&q, 4 + i);
+        large[i] = equeue_alloc(&q, 100 + i);
+        test_assert(small[i] && large[i]);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        equeue_dealloc(&q, small[i]);
+        equeue_dealloc(&q, large[i]);
+    }
+
+    for (int r = 0; r < 100; r++) {
+        for (int i = 0; i < 4; i++) {
+            small[i] = equeue_alloc(&q, 4 + 3 - i);
+            large[i] = equeue_alloc(&q, 100 + 3 - i);
+            test_assert(small[i] && large[i]);
+        }
+
+        for (int i = 0; i < 4; i++) {
+            equeue_dealloc(&q, small[i]);
+            equeue_dealloc(&q, large[i]);
+        }
+    }
+
+    // a queue that has seen many event sizes must still be usable
+    void *e = equeue_alloc(&q, 2048);
+    test_assert(e);
+    equeue_dealloc(&q, e);
+
+    equeue_destroy(&q);
+}
+
+struct ordered {
+    int *last;
+    int *count;
+    int key;
+};
+
+static void ordered_func(void *p)
+{
+    struct ordered *o = (struct ordered *)p;
+    test_assert(*o->last < o->key);
+    *o->last = o->key;
+    (*o->count)++;
+}
+
+void timer_order_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2 * N * (EQUEUE_EVENT_SIZE + sizeof(struct ordered)));
+    test_assert(!err);
+
+    // events must run in target order, and in posting order for equal
+    // targets, regardless of the order in which they were posted
+    int last = -1;
+    int count = 0;
+    int *ids = malloc(N * sizeof(int));
+    test_assert(ids);
+    for (int i = 0; i < N; i++) {
+        int delay = (i * 7) % 10;
+        struct ordered *o = equeue_alloc(&q, sizeof(struct ordered));
+        test_assert(o);
+
+        o->last = &last;
+        o->count = &count;
+        o->key = delay * N + i;
+        equeue_event_delay(o, delay * 10);
+        ids[i] = equeue_post(&q, ordered_func, o);
+        test_assert(ids[i]);
+    }
+
+    // cancelling some of them must not disturb the order of the others
+    for (int i = 0; i < N; i += 3) {
+        test_assert(equeue_cancel(&q, ids[i]));
+    }
+
+    equeue_dispatch(&q, 150);
+    test_assert(count == N - (N + 2) / 3);
+
+    free(ids);
+    equeue_destroy(&q);
+}
+
+struct isr_poster {
+    pthread_t thread;
+    equeue_t *q;
+    int *touched;
+    int count;
+};
+
+static void *isr_post_thread(void *p)
+{
+    struct isr_poster *t = (struct isr_poster *)p;
+    for (int i = 0; i < t->count; i++) {
+        struct indirect *e;
+        do {
+            e = equeue_alloc(t->q, sizeof(struct indirect));
+        } while (!e);
+        e->touched = t->touched;
+        equeue_post_isr(t->q, indirect_func, e);
+    }
+    return 0;
+}
+
+void isr_post_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // deferred events run in posting order
+    int touched = 0;
+    int last = -1;
+    int count = 0;
+    for (int i = 0; i < 3; i++) {
+        struct ordered *e = equeue_alloc(&q, sizeof(struct ordered));
+        test_assert(e);
+
+        e->last = &last;
+        e->count = &count;
+        e->key = i;
+        test_assert(equeue_post_isr(&q, ordered_func, e));
+    }
+
+    // cancelling before pickup prevents dispatch
+    struct indirect *i = equeue_alloc(&q, sizeof(struct indirect));
+    test_assert(i);
+
+    i->touched = &touched;
+    int id = equeue_post_isr(&q, indirect_func, i);
+    test_assert(id);
+    test_assert(!equeue_cancel(&q, id));
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 3 && last == 2);
+    test_assert(touched == 0);
+
+    // concurrent posters
+    struct isr_poster t[4];
+    for (int i = 0; i < 4; i++) {
+        t[i].q = &q;
+        t[i].touched = &touched;
+        t[i].count = 100;
+        err = pthread_create(&t[i].thread, 0, isr_post_thread, &t[i]);
+        test_assert(!err);
+    }
+
+    while (touched < 400) {
+        equeue_dispatch(&q, 10);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        pthread_join(t[i].thread, 0);
+    }
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 400);
+
+    equeue_destroy(&q);
+}
+
+void dispatch_stats_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    equeue_dispatch_stats_t stats;
+    if (!equeue_get_dispatch_stats(&q, &stats)) {
+        test_assert(stats.dispatch_cnt == 0);
+        equeue_destroy(&q);
+        return;
+    }
+
+    int touched = 0;
+    equeue_call(&q, simple_func, &touched);
+    equeue_call(&q, sloth_func, &touched);
+    equeue_call_in(&q, 1000, simple_func, &touched);
+
+    equeue_get_dispatch_stats(&q, &stats);
+    test_assert(stats.pending_cnt == 3);
+    test_assert(stats.max_pending_cnt == 3);
+
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 2);
+
+    equeue_get_dispatch_stats(&q, &stats);
+    test_assert(stats.dispatch_cnt == 2);
+    test_assert(stats.pending_cnt == 1);
+    test_assert(stats.max_pending_cnt == 3);
+    test_assert(stats.max_runtime_cb == sloth_func);
+    test_assert(stats.max_runtime >= 5);
+
+    uint32_t total = 0;
+    for (int i = 0; i < EQUEUE_LATENCY_BUCKETS; i++) {
+        total += stats.latency[i];
+    }
+    test_assert(total == stats.dispatch_cnt);
+
+    equeue_reset_dispatch_stats(&q);
+    equeue_get_dispatch_stats(&q, &stats);
+    test_assert(stats.dispatch_cnt == 0);
+    test_assert(stats.pending_cnt == 1);
+    test_assert(stats.max_runtime_cb == 0);
+
+    equeue_destroy(&q);
+}
+
+struct prioritized {
+    equeue_t *q;
+    int *order;
+    int *count;
+    int key;
+    int spawn;
+};
+
+static void prioritized_func(void *p)
+{
+    struct prioritized *e = (struct prioritized *)p;
+    e->order[(*e->count)++] = e->key;
+
+    if (e->spawn) {
+        struct prioritized *s = equeue_alloc(e->q, sizeof(struct prioritized));
+        test_assert(s);
+
+        *s = *e;
+        s->key = e->spawn;
+        s->spawn = 0;
+        equeue_event_priority(s, EQUEUE_PRIORITIES - 1);
+        test_assert(equeue_post(e->q, prioritized_func, s));
+    }
+}
+
+void priority_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    // keys 1-3 are posted at the lowest priority, key 4 at the highest,
+    // and key 1 posts key 5 at the highest priority while dispatching
+    int order[5];
+    int count = 0;
+    int keys[4] = {1, 2, 3, 4};
+    for (int i = 0; i < 4; i++) {
+        struct prioritized *e = equeue_alloc(&q, sizeof(struct prioritized));
+        test_assert(e);
+
+        e->q = &q;
+        e->order = order;
+        e->count = &count;
+        e->key = keys[i];
+        e->spawn = (keys[i] == 1) ? 5 : 0;
+        equeue_event_priority(e, keys[i] == 4 ? EQUEUE_PRIORITIES - 1 : 0);
+        test_assert(equeue_post(&q, prioritized_func, e));
+    }
+
+    equeue_dispatch(&q, 0);
+    equeue_dispatch(&q, 0);
+    test_assert(count == 5);
+#if EQUEUE_PRIORITIES > 1
+    int expected[5] = {4, 1, 5, 2, 3};
+#else
+    int expected[5] = {1, 2, 3, 4, 5};
+#endif
+    for (int i = 0; i < 5; i++) {
+        test_assert(order[i] == expected[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+static void replace_int(void *p, void *c)
+{
+    *(int **)p = *(int **)c;
+}
+
+void update_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int a = 0;
+    int b = 0;
+    int *c = &b;
+    int **e = equeue_alloc(&q, sizeof(int *));
+    test_assert(e);
+    *e = &a;
+    int id = equeue_post(&q, simple_func_indirect, e);
+    test_assert(id);
+
+    // pending events can be updated
+    test_assert(equeue_update(&q, id, replace_int, &c));
+    equeue_dispatch(&q, 0);
+    test_assert(a == 0 && b == 1);
+
+    // dispatched events can not
+    test_assert(!equeue_update(&q, id, replace_int, &c));
+    test_assert(!equeue_update(&q, 0, replace_int, &c));
+
+    equeue_destroy(&q);
+}
+
+void fixed_size_test(void)
+{
+    equeue_t q;
+    size_t size = EQUEUE_EVENT_SIZE + 32;
+    int err = equeue_create(&q, 4 * size);
+    test_assert(!err);
+    equeue_fixed_size(&q, size);
+
+    // a buffer of 4 chunks always holds 4 events, whatever their sizes
+    for (int r = 0; r < 10; r++) {
+        void *e[4];
+        for (int i = 0; i < 4; i++) {
+            e[i] = equeue_alloc(&q, (r * 4 + i) % 33);
+            test_assert(e[i]);
+        }
+        test_assert(!equeue_alloc(&q, 0));
+
+        for (int i = 0; i < 4; i++) {
+            equeue_dealloc(&q, e[i]);
+        }
+    }
+
+    test_assert(!equeue_alloc(&q, size));
+
+    equeue_destroy(&q);
+}
+
 int main()
 {
     printf("beginning tests...\n");
@@ -897,6 +1289,14 @@ int main()
     test_run(sibling_test);
     test_run(user_allocated_event_test);
     test_run(id_cycle);
+    test_run(mem_stats_test);
+    test_run(size_class_test);
+    test_run(timer_order_test, 200);
+    test_run(isr_post_test);
+    test_run(dispatch_stats_test);
+    test_run(priority_test);
+    test_run(update_test);
+    test_run(fixed_size_test);
     printf("done!\n");
     return test_failure;
 }
@@ -23,6 +23,7 @@
 #include "ble/Gap.h"
 #include "ble/GattServer.h"
 #include "ble/GattClient.h"
+#include "ble/L2capChannel.h"
 #include "ble/SecurityManager.h"
 
 #include "ble/FunctionPointerWithContext.h"
@@ -393,6 +394,17 @@ public:
     const GattClient &gattClient() const;
 #endif // BLE_FEATURE_GATT_CLIENT
 
+#if BLE_FEATURE_CONNECTABLE
+    /**
+     * Accessor to L2capChannel. Connection oriented channels are opened and
+     * operated through this accessor.
+     *
+     * @return A reference to a L2capChannel object associated to this BLE
+     * instance.
+     */
+    L2capChannel &l2capChannel();
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_FEATURE_SECURITY
     /**
      * Accessors to SecurityManager. All SecurityManager-related functionality
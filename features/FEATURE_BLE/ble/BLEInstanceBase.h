@@ -26,6 +26,7 @@
 #include "ble/SecurityManager.h"
 #include "ble/GattServer.h"
 #include "ble/GattClient.h"
+#include "ble/L2capChannel.h"
 
 
 
@@ -218,6 +219,18 @@ public:
     virtual GattClient &getGattClient(void) = 0;
 #endif
 
+#if BLE_FEATURE_CONNECTABLE
+    /**
+     * Accessor to the vendor implementation of the L2capChannel interface.
+     *
+     * @return A reference to a L2capChannel object associated to this
+     * BLEInstanceBase instance.
+     *
+     * @see BLE::l2capChannel() L2capChannel
+     */
+    virtual L2capChannel &getL2capChannel(void) = 0;
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_FEATURE_SECURITY
     /**
      * Accessor to the vendor implementation of the SecurityManager interface.
@@ -603,6 +603,27 @@ public:
      */
     ble_error_t negotiateAttMtu(ble::connection_handle_t connection);
 
+    /**
+     * Enable caching of the databases discovered on servers.
+     *
+     * When the cache is enabled, launchServiceDiscovery() first reads the
+     * Database Hash characteristic of the server. If a server database with
+     * the same hash has been discovered before, the services and
+     * characteristics are reported from the cache and no discovery request
+     * is sent to the server. Otherwise the discovery runs normally and a
+     * complete discovery of all services is recorded for the next time.
+     *
+     * Servers without a Database Hash characteristic are always discovered
+     * in full.
+     *
+     * @param[in] dbFilepath Path to the file used to store the cache.
+     * NULL disables the cache.
+     *
+     * @return BLE_ERROR_NONE on success, BLE_ERROR_NO_MEM if the cache could
+     * not be allocated or BLE_ERROR_INVALID_PARAM if the file is unavailable.
+     */
+    ble_error_t enableDatabaseCache(const char *dbFilepath);
+
     /**
      * Register an handler for Handle Value Notification/Indication events.
      *
@@ -726,6 +747,8 @@ protected:
 
     ble_error_t negotiateAttMtu_(ble::connection_handle_t connection);
 
+    ble_error_t enableDatabaseCache_(const char *dbFilepath);
+
     ble_error_t read_(
         ble::connection_handle_t connHandle,
         GattAttribute::Handle_t attributeHandle,
@@ -120,6 +120,75 @@ public:
         )
         {
         }
+
+        /**
+         * Function invoked when an update queued with queueUpdates() has been
+         * handed to the controller, or has been dropped.
+         *
+         * The buffer of the payload may be reused once this is called, and
+         * there is room in the queue for another payload.
+         *
+         * @param connectionHandle The connection the update was queued for.
+         * @param attributeHandle The characteristic value handle updated.
+         * @param value The payload buffer given to queueUpdates().
+         * @param status BLE_ERROR_NONE if the update was sent.
+         */
+        virtual void onQueuedUpdateSent(
+            ble::connection_handle_t connectionHandle,
+            GattAttribute::Handle_t attributeHandle,
+            const uint8_t *value,
+            ble_error_t status
+        )
+        {
+        }
+    };
+
+    /**
+     * Payload of a characteristic value update queued with queueUpdates().
+     */
+    struct UpdatePayload {
+        /**
+         * Value to send; it must remain valid until onQueuedUpdateSent() is
+         * called for it.
+         */
+        const uint8_t *value;
+
+        /**
+         * Size of the value.
+         */
+        uint16_t size;
+    };
+
+    /**
+     * Statistics of the update queue of a connection.
+     *
+     * @see getUpdateQueueStatistics()
+     */
+    struct UpdateQueueStatistics {
+        /**
+         * Number of updates waiting in the queue.
+         */
+        uint32_t pending;
+
+        /**
+         * Number of updates sent.
+         */
+        uint32_t sent;
+
+        /**
+         * Number of updates dropped.
+         */
+        uint32_t dropped;
+
+        /**
+         * Number of value bytes sent.
+         */
+        uint32_t bytesSent;
+
+        /**
+         * Value bytes sent per second while the queue was not empty.
+         */
+        uint32_t throughput;
     };
 
     /**
@@ -342,6 +411,52 @@ public:
         bool localOnly = false
     );
 
+    /**
+     * Queue notifications or indications of a characteristic value to a
+     * client.
+     *
+     * The payloads are sent in order, each one as soon as the stack has
+     * room for it, so a client can be streamed to without retrying write().
+     * Unlike write(), the attribute value is not updated.
+     *
+     * The payload buffers are not copied; each must remain valid until
+     * EventHandler::onQueuedUpdateSent() is called for it. Updates still in
+     * the queue are dropped when the connection closes.
+     *
+     * @note Updates of a characteristic should not be sent with write()
+     * while queued updates of it are pending.
+     *
+     * @param[in] connectionHandle Connection handle of the client.
+     * @param[in] attributeHandle Handle for the value attribute of the
+     * characteristic.
+     * @param[in] payloads Payloads to queue.
+     * @param[in] count Number of payloads.
+     * @param[out] queued Upon return, number of payloads queued, which is
+     * less than @p count if the queue is full.
+     *
+     * @return BLE_ERROR_NONE if at least one payload has been queued.
+     */
+    ble_error_t queueUpdates(
+        ble::connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const UpdatePayload *payloads,
+        size_t count,
+        size_t *queued
+    );
+
+    /**
+     * Get statistics of the update queue of a connection.
+     *
+     * @param[in] connectionHandle Connection handle of the client.
+     * @param[out] statistics Upon return, the queue statistics.
+     *
+     * @return BLE_ERROR_NONE if the connection is found.
+     */
+    ble_error_t getUpdateQueueStatistics(
+        ble::connection_handle_t connectionHandle,
+        UpdateQueueStatistics *statistics
+    );
+
     /**
      * Determine if one of the connected clients has subscribed to notifications
      * or indications of the characteristic in input.
@@ -769,6 +884,19 @@ protected:
         bool localOnly
     );
 
+    ble_error_t queueUpdates_(
+        ble::connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const UpdatePayload *payloads,
+        size_t count,
+        size_t *queued
+    );
+
+    ble_error_t getUpdateQueueStatistics_(
+        ble::connection_handle_t connectionHandle,
+        UpdateQueueStatistics *statistics
+    );
+
     ble_error_t areUpdatesEnabled_(
         const GattCharacteristic &characteristic,
         bool *enabledP
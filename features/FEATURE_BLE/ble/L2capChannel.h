@@ -0,0 +1,578 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_L2CAP_CHANNEL_H__
+#define MBED_L2CAP_CHANNEL_H__
+
+#include "ble/common/StaticInterface.h"
+#include "ble/blecommon.h"
+#include "ble/BLETypes.h"
+#include "platform/Span.h"
+#include "BleImplementationForward.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup l2cap
+ * @{
+ */
+
+/** Local identifier of an L2CAP connection oriented channel. */
+typedef uint16_t l2cap_channel_id_t;
+
+/** Identifier of a registration made with L2capChannel::registerChannel(). */
+typedef uint16_t l2cap_registration_t;
+
+/**
+ * Parameters of the channels created from a registration.
+ */
+class L2capChannelParameters {
+public:
+    /**
+     * Construct parameters of channels with the minimal sizes allowed.
+     *
+     * @param psm Local PSM accepting incoming channels. Zero registers an
+     * initiator which cannot accept channels.
+     */
+    L2capChannelParameters(uint16_t psm = 0) :
+        _psm(psm),
+        _mtu(MIN_MTU),
+        _mps(MIN_MPS),
+        _credits(1),
+        _security(link_encryption_t::NOT_ENCRYPTED)
+    {
+    }
+
+    /** Smallest SDU size allowed by the specification. */
+    static const uint16_t MIN_MTU = 23;
+
+    /** Smallest PDU size allowed by the specification. */
+    static const uint16_t MIN_MPS = 23;
+
+    /**
+     * Set the local PSM accepting incoming channels; zero disables incoming
+     * channels.
+     */
+    L2capChannelParameters &setPsm(uint16_t psm)
+    {
+        _psm = psm;
+        return *this;
+    }
+
+    /**
+     * Set the size of the largest SDU the application receives. SDUs are
+     * reassembled by the stack in a buffer of that size.
+     */
+    L2capChannelParameters &setMtu(uint16_t mtu)
+    {
+        _mtu = mtu;
+        return *this;
+    }
+
+    /**
+     * Set the size of the largest PDU received; an SDU is split by the peer
+     * in PDUs of that size.
+     */
+    L2capChannelParameters &setMps(uint16_t mps)
+    {
+        _mps = mps;
+        return *this;
+    }
+
+    /**
+     * Set the number of PDUs the peer can send before it waits for more
+     * credits. The stack returns credits as PDUs are received.
+     */
+    L2capChannelParameters &setCredits(uint16_t credits)
+    {
+        _credits = credits;
+        return *this;
+    }
+
+    /**
+     * Set the minimum security of the link required to open a channel.
+     */
+    L2capChannelParameters &setSecurity(link_encryption_t security)
+    {
+        _security = security;
+        return *this;
+    }
+
+    /** Get the local PSM accepting incoming channels. */
+    uint16_t getPsm() const
+    {
+        return _psm;
+    }
+
+    /** Get the size of the largest SDU received. */
+    uint16_t getMtu() const
+    {
+        return _mtu;
+    }
+
+    /** Get the size of the largest PDU received. */
+    uint16_t getMps() const
+    {
+        return _mps;
+    }
+
+    /** Get the number of credits granted to the peer. */
+    uint16_t getCredits() const
+    {
+        return _credits;
+    }
+
+    /** Get the minimum security of the link required. */
+    link_encryption_t getSecurity() const
+    {
+        return _security;
+    }
+
+private:
+    uint16_t _psm;
+    uint16_t _mtu;
+    uint16_t _mps;
+    uint16_t _credits;
+    link_encryption_t _security;
+};
+
+/**
+ * Event generated when a channel is opened by either side.
+ */
+struct L2capChannelConnectedEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    L2capChannelConnectedEvent(
+        connection_handle_t connectionHandle,
+        l2cap_channel_id_t channel,
+        uint16_t psm,
+        uint16_t peerMtu
+    ) :
+        connectionHandle(connectionHandle),
+        channel(channel),
+        psm(psm),
+        peerMtu(peerMtu)
+    {
+    }
+
+#endif
+
+    /** Get the handle of the connection carrying the channel. */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /** Get the local identifier of the channel. */
+    l2cap_channel_id_t getChannel() const
+    {
+        return channel;
+    }
+
+    /** Get the PSM the channel is connected to. */
+    uint16_t getPsm() const
+    {
+        return psm;
+    }
+
+    /** Get the size of the largest SDU the peer accepts. */
+    uint16_t getPeerMtu() const
+    {
+        return peerMtu;
+    }
+
+private:
+    connection_handle_t connectionHandle;
+    l2cap_channel_id_t channel;
+    uint16_t psm;
+    uint16_t peerMtu;
+};
+
+/**
+ * Event generated when a channel is closed or fails to open.
+ */
+struct L2capChannelDisconnectedEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    L2capChannelDisconnectedEvent(
+        connection_handle_t connectionHandle,
+        l2cap_channel_id_t channel,
+        uint16_t result
+    ) :
+        connectionHandle(connectionHandle),
+        channel(channel),
+        result(result)
+    {
+    }
+
+#endif
+
+    /** Get the handle of the connection that carried the channel. */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /** Get the local identifier of the channel. */
+    l2cap_channel_id_t getChannel() const
+    {
+        return channel;
+    }
+
+    /**
+     * Get the L2CAP result code of a connection refused by the peer or zero
+     * if an open channel was closed.
+     */
+    uint16_t getResult() const
+    {
+        return result;
+    }
+
+private:
+    connection_handle_t connectionHandle;
+    l2cap_channel_id_t channel;
+    uint16_t result;
+};
+
+/**
+ * Event generated when an SDU is received on a channel.
+ */
+struct L2capDataReceivedEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    L2capDataReceivedEvent(
+        connection_handle_t connectionHandle,
+        l2cap_channel_id_t channel,
+        const mbed::Span<const uint8_t> &sdu
+    ) :
+        connectionHandle(connectionHandle),
+        channel(channel),
+        sdu(sdu)
+    {
+    }
+
+#endif
+
+    /** Get the handle of the connection carrying the channel. */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /** Get the local identifier of the channel. */
+    l2cap_channel_id_t getChannel() const
+    {
+        return channel;
+    }
+
+    /**
+     * Get the SDU received.
+     *
+     * @note The SDU is the reassembly buffer of the stack; it is not copied
+     * and is valid only during the call of the event handler.
+     */
+    const mbed::Span<const uint8_t> &getSdu() const
+    {
+        return sdu;
+    }
+
+private:
+    connection_handle_t connectionHandle;
+    l2cap_channel_id_t channel;
+    mbed::Span<const uint8_t> sdu;
+};
+
+/**
+ * Event generated when an SDU written on a channel has been sent.
+ */
+struct L2capDataSentEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    L2capDataSentEvent(
+        connection_handle_t connectionHandle,
+        l2cap_channel_id_t channel,
+        ble_error_t status
+    ) :
+        connectionHandle(connectionHandle),
+        channel(channel),
+        status(status)
+    {
+    }
+
+#endif
+
+    /** Get the handle of the connection carrying the channel. */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /** Get the local identifier of the channel. */
+    l2cap_channel_id_t getChannel() const
+    {
+        return channel;
+    }
+
+    /**
+     * Get the status of the transfer: BLE_ERROR_NONE once the last PDU of the
+     * SDU is sent, BLE_ERROR_NO_MEM if the stack could not queue it or
+     * BLE_ERROR_OPERATION_NOT_PERMITTED if a previous SDU was still pending.
+     */
+    ble_error_t getStatus() const
+    {
+        return status;
+    }
+
+private:
+    connection_handle_t connectionHandle;
+    l2cap_channel_id_t channel;
+    ble_error_t status;
+};
+
+#if !defined(DOXYGEN_ONLY)
+namespace interface {
+#endif
+
+/**
+ * Open and operate L2CAP connection oriented channels.
+ *
+ * A connection oriented channel uses LE credit based flow control to carry
+ * SDUs of up to 64KB between two devices without the overhead and the size
+ * limits of the ATT protocol. It is suited to bulk transfers such as images
+ * or logs.
+ *
+ * The application registers the parameters of its channels with
+ * registerChannel(). A registration with a PSM accepts channels opened by
+ * the peer on that PSM; any registration can open a channel to a PSM of the
+ * peer with connect(). Segmentation, reassembly and credits are handled by
+ * the stack.
+ *
+ * SDUs are sent with write(), one at a time per channel: the application
+ * waits for EventHandler::onDataSent() before it writes the next SDU.
+ */
+#if defined(DOXYGEN_ONLY)
+class L2capChannel {
+#else
+template <class Impl>
+class L2capChannel : public StaticInterface<Impl, L2capChannel> {
+#endif
+
+    using StaticInterface<Impl, ::ble::interface::L2capChannel>::impl;
+
+public:
+
+    /**
+     * Definition of the general handler of L2capChannel related events.
+     */
+    struct EventHandler {
+        /**
+         * Called when a channel is opened.
+         *
+         * @param event Channel opened.
+         */
+        virtual void onChannelConnected(const L2capChannelConnectedEvent &event)
+        {
+        }
+
+        /**
+         * Called when a channel is closed or when connect() fails.
+         *
+         * @param event Channel closed.
+         */
+        virtual void onChannelDisconnected(const L2capChannelDisconnectedEvent &event)
+        {
+        }
+
+        /**
+         * Called when an SDU is received.
+         *
+         * @param event SDU received.
+         */
+        virtual void onDataReceived(const L2capDataReceivedEvent &event)
+        {
+        }
+
+        /**
+         * Called when an SDU passed to write() has been sent.
+         *
+         * @param event Transfer status.
+         */
+        virtual void onDataSent(const L2capDataSentEvent &event)
+        {
+        }
+
+    protected:
+        /**
+         * Prevent polymorphic deletion and avoid unnecessary virtual destructor
+         * as the L2capChannel class will never delete the instance it contains.
+         */
+        ~EventHandler()
+        {
+        }
+    };
+
+    /**
+     * Assign the event handler implementation that will be used by the
+     * module to signal events back to the application.
+     *
+     * @param handler Application implementation of an EventHandler.
+     */
+    void setEventHandler(EventHandler *handler)
+    {
+        eventHandler = handler;
+    }
+
+    /**
+     * Register parameters of channels.
+     *
+     * @param[out] registration Identifier of the registration.
+     * @param[in] parameters Parameters of the channels.
+     *
+     * @return BLE_ERROR_NONE on success, BLE_ERROR_INVALID_PARAM if the
+     * parameters are out of range or BLE_ERROR_NO_MEM if no registration is
+     * available.
+     */
+    ble_error_t registerChannel(
+        l2cap_registration_t &registration,
+        const L2capChannelParameters &parameters
+    );
+
+    /**
+     * Release a registration. It must not be used by an open channel.
+     *
+     * @param registration Registration to release.
+     *
+     * @return BLE_ERROR_NONE on success.
+     */
+    ble_error_t unregisterChannel(l2cap_registration_t registration);
+
+    /**
+     * Open a channel to a PSM of the peer.
+     *
+     * @param[in] connectionHandle Connection to the peer.
+     * @param[in] registration Registration holding the local parameters.
+     * @param[in] psm PSM of the peer.
+     * @param[out] channel Identifier of the channel opening.
+     *
+     * @return BLE_ERROR_NONE if the request has been sent; the outcome is
+     * reported by EventHandler::onChannelConnected() or
+     * EventHandler::onChannelDisconnected().
+     */
+    ble_error_t connect(
+        connection_handle_t connectionHandle,
+        l2cap_registration_t registration,
+        uint16_t psm,
+        l2cap_channel_id_t &channel
+    );
+
+    /**
+     * Close a channel.
+     *
+     * @param channel Channel to close.
+     *
+     * @return BLE_ERROR_NONE if the request has been sent; completion is
+     * reported by EventHandler::onChannelDisconnected().
+     */
+    ble_error_t disconnect(l2cap_channel_id_t channel);
+
+    /**
+     * Send an SDU on a channel.
+     *
+     * The SDU is copied once in a packet buffer of the stack, which splits it
+     * in PDUs and sends them as the peer grants credits.
+     *
+     * @param channel Channel used.
+     * @param sdu Data to send; it is not larger than the MTU of the peer.
+     *
+     * @return BLE_ERROR_NONE if the SDU has been handed to the stack;
+     * completion is reported by EventHandler::onDataSent().
+     */
+    ble_error_t write(l2cap_channel_id_t channel, mbed::Span<const uint8_t> sdu);
+
+    /**
+     * Reset the state of the L2capChannel instance; registrations are
+     * released and the event handler is removed.
+     *
+     * @return BLE_ERROR_NONE on success.
+     */
+    ble_error_t reset(void);
+
+protected:
+
+    /* --- Abstract calls to override --- */
+
+    /* Derived implementation must call the base class implementation */
+    ble_error_t reset_(void);
+
+    ble_error_t registerChannel_(
+        l2cap_registration_t &registration,
+        const L2capChannelParameters &parameters
+    );
+
+    ble_error_t unregisterChannel_(l2cap_registration_t registration);
+
+    ble_error_t connect_(
+        connection_handle_t connectionHandle,
+        l2cap_registration_t registration,
+        uint16_t psm,
+        l2cap_channel_id_t &channel
+    );
+
+    ble_error_t disconnect_(l2cap_channel_id_t channel);
+
+    ble_error_t write_(l2cap_channel_id_t channel, mbed::Span<const uint8_t> sdu);
+
+protected:
+    L2capChannel() : eventHandler(NULL)
+    {
+    }
+
+    /**
+     * Event handler provided by the application.
+     */
+    EventHandler *eventHandler;
+
+private:
+    /* Disallow copy and assignment. */
+    L2capChannel(const L2capChannel &);
+    L2capChannel& operator=(const L2capChannel &);
+};
+
+#if !defined(DOXYGEN_ONLY)
+} // namespace interface
+#endif
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#if !defined(DOXYGEN_ONLY)
+// import L2capChannel implementation into global namespace
+typedef ble::impl::L2capChannel L2capChannel;
+
+// import L2capChannel implementation into ble namespace
+namespace ble {
+typedef impl::L2capChannel L2capChannel;
+}
+#endif
+
+#endif /* ifndef MBED_L2CAP_CHANNEL_H__ */
@@ -0,0 +1,373 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLE_GAP_CONSTEXPRADVERTISINGDATABUILDER_H
+#define BLE_GAP_CONSTEXPRADVERTISINGDATABUILDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform/Span.h"
+#include "platform/mbed_assert.h"
+#include "ble/gap/AdvertisingDataTypes.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gap
+ * @{
+ */
+
+/**
+ * Build advertising data at compile time.
+ *
+ * The builder has the same fluent API as AdvertisingDataSimpleBuilder but
+ * every insertion is constexpr: a payload built in the initializer of a
+ * constexpr object is computed by the compiler and placed in flash. Fields
+ * that change at runtime, like a counter, are then patched in a copy at an
+ * offset also computed by the compiler, without scanning the payload.
+ *
+ * It differs from AdvertisingDataSimpleBuilder on the following points:
+ *   - Insertions require C++14 to be evaluated at compile time.
+ *   - An insertion that overflows the payload or adds a field already
+ *   present fails to compile. At runtime an assertion is raised and the
+ *   buffer is not modified.
+ *   - Only fields whose content is known at compile time can be added:
+ *   16-bit service UUIDs, arrays and string literals.
+ *
+ * @code
+    using namespace ble;
+
+    typedef AdvertisingDataConstexprBuilder<LEGACY_ADVERTISING_MAX_SIZE> BeaconPayload;
+
+    // company identifier then a 16-bit counter
+    constexpr uint8_t beacon_data[] = { 0x4C, 0x00, 0x00, 0x00 };
+
+    constexpr BeaconPayload beacon_payload = BeaconPayload()
+        .setFlags()
+        .setName("beacon")
+        .setManufacturerSpecificData(beacon_data);
+
+    constexpr size_t counter_offset =
+        beacon_payload.getFieldOffset(adv_data_type_t::MANUFACTURER_SPECIFIC_DATA) + 2;
+
+    void updateCounter(Gap& gap, uint16_t counter)
+    {
+        static BeaconPayload payload = beacon_payload;
+        const uint8_t value[] = { (uint8_t) counter, (uint8_t) (counter >> 8) };
+        payload.patch(counter_offset, value);
+        gap.setAdvertisingPayload(LEGACY_ADVERTISING_HANDLE, payload.getAdvertisingData());
+    }
+ * @endcode
+ */
+template<size_t DataSize>
+class AdvertisingDataConstexprBuilder {
+public:
+    /**
+     * Construct an empty AdvertisingDataConstexprBuilder
+     */
+    constexpr AdvertisingDataConstexprBuilder() : _data(), _size(0)
+    {
+    }
+
+    /**
+     * Add BLE flags in the advertising payload.
+     *
+     * @param[in] flags Bitfield describing the capability of the device. See
+     * allowed flags in adv_data_flags_t.
+     *
+     * @return A reference to this object.
+     */
+    constexpr AdvertisingDataConstexprBuilder &setFlags(
+        uint8_t flags = adv_data_flags_t::default_flags
+    )
+    {
+        const uint8_t value[] = { flags };
+        return addData(adv_data_type_t::FLAGS, value);
+    }
+
+    /**
+     * Add device appearance in the advertising payload.
+     *
+     * @param[in] appearance The appearance to advertise.
+     *
+     * @return A reference to this object.
+     */
+    constexpr AdvertisingDataConstexprBuilder &setAppearance(
+        adv_data_appearance_t::type appearance
+    )
+    {
+        const uint8_t value[] = {
+            (uint8_t) appearance,
+            (uint8_t) (appearance >> 8)
+        };
+        return addData(adv_data_type_t::APPEARANCE, value);
+    }
+
+    /**
+     * Add the advertising TX in the advertising payload.
+     *
+     * @param[in] txPower Transmission power level in dB.
+     *
+     * @return A reference to this object.
+     */
+    constexpr AdvertisingDataConstexprBuilder &setTxPowerAdvertised(int8_t txPower)
+    {
+        const uint8_t value[] = { (uint8_t) txPower };
+        return addData(adv_data_type_t::TX_POWER_LEVEL, value);
+    }
+
+    /**
+     * Add device name to the advertising payload.
+     *
+     * @param[in] name String literal containing the name.
+     * @param[in] complete Complete local name if true, otherwise shortened.
+     *
+     * @return A reference to this object.
+     */
+    template<size_t NameSize>
+    constexpr AdvertisingDataConstexprBuilder &setName(
+        const char (&name)[NameSize],
+        bool complete = true
+    )
+    {
+        uint8_t value[NameSize] = { 0 };
+        for (size_t i = 0; i < NameSize; ++i) {
+            value[i] = name[i];
+        }
+        return addData(
+            complete ?
+                adv_data_type_t::COMPLETE_LOCAL_NAME :
+                adv_data_type_t::SHORTENED_LOCAL_NAME,
+            value,
+            NameSize - 1 /* null terminator */
+        );
+    }
+
+    /**
+     * Add manufacturer specific data to the advertising payload.
+     *
+     * @param[in] data Data to add, starting with the company identifier.
+     *
+     * @return A reference to this object.
+     */
+    template<size_t Size>
+    constexpr AdvertisingDataConstexprBuilder &setManufacturerSpecificData(
+        const uint8_t (&data)[Size]
+    )
+    {
+        return addData(adv_data_type_t::MANUFACTURER_SPECIFIC_DATA, data);
+    }
+
+    /**
+     * Add a 16-bit local service ID to the advertising payload.
+     *
+     * @param[in] service 16-bit UUID of the service.
+     * @param[in] complete True if this is a complete list.
+     *
+     * @return A reference to this object.
+     */
+    constexpr AdvertisingDataConstexprBuilder &setLocalService(
+        uint16_t service,
+        bool complete = true
+    )
+    {
+        const uint8_t value[] = { (uint8_t) service, (uint8_t) (service >> 8) };
+        return addData(
+            complete ?
+                adv_data_type_t::COMPLETE_LIST_16BIT_SERVICE_IDS :
+                adv_data_type_t::INCOMPLETE_LIST_16BIT_SERVICE_IDS,
+            value
+        );
+    }
+
+    /**
+     * Add service data of a 16-bit service to the advertising payload.
+     *
+     * @param[in] service 16-bit UUID of the service.
+     * @param[in] data Data to add after the UUID.
+     *
+     * @return A reference to this object.
+     */
+    template<size_t Size>
+    constexpr AdvertisingDataConstexprBuilder &setServiceData(
+        uint16_t service,
+        const uint8_t (&data)[Size]
+    )
+    {
+        uint8_t value[Size + 2] = { (uint8_t) service, (uint8_t) (service >> 8) };
+        for (size_t i = 0; i < Size; ++i) {
+            value[i + 2] = data[i];
+        }
+        return addData(adv_data_type_t::SERVICE_DATA_16BIT_ID, value);
+    }
+
+    /**
+     * Add a new field into the payload. The operation fails if type is
+     * already present.
+     *
+     * @param[in] advDataType The type of the field to add.
+     * @param[in] fieldData Data of the field.
+     *
+     * @return A reference to this object.
+     */
+    template<size_t Size>
+    constexpr AdvertisingDataConstexprBuilder &addData(
+        adv_data_type_t::type advDataType,
+        const uint8_t (&fieldData)[Size]
+    )
+    {
+        return addData(advDataType, fieldData, Size);
+    }
+
+    /**
+     * Add a new field into the payload. The operation fails if type is
+     * already present.
+     *
+     * @param[in] advDataType The type of the field to add.
+     * @param[in] fieldData Data of the field.
+     * @param[in] fieldSize Number of bytes in fieldData.
+     *
+     * @return A reference to this object.
+     */
+    constexpr AdvertisingDataConstexprBuilder &addData(
+        adv_data_type_t::type advDataType,
+        const uint8_t *fieldData,
+        size_t fieldSize
+    )
+    {
+        if (findField(advDataType) != DataSize) {
+            error_field_already_present();
+            return *this;
+        }
+
+        // field size byte covers the type and the data
+        if (fieldSize > 0xFE || _size + 2 + fieldSize > DataSize) {
+            error_payload_overflow();
+            return *this;
+        }
+
+        _data[_size] = fieldSize + 1;
+        _data[_size + 1] = advDataType;
+        for (size_t i = 0; i < fieldSize; ++i) {
+            _data[_size + 2 + i] = fieldData[i];
+        }
+        _size += fieldSize + 2;
+
+        return *this;
+    }
+
+    /**
+     * Get the offset of the data of a field in the payload.
+     *
+     * Evaluated at compile time, it gives the offset to pass to patch().
+     *
+     * @param[in] advDataType Type of the field; it must be present.
+     *
+     * @return Offset of the first byte after the type of the field.
+     */
+    constexpr size_t getFieldOffset(adv_data_type_t::type advDataType) const
+    {
+        return findField(advDataType) == DataSize ?
+            error_field_not_found() :
+            findField(advDataType) + 2;
+    }
+
+    /**
+     * Get the size of the payload.
+     */
+    constexpr size_t getSize() const
+    {
+        return _size;
+    }
+
+    /**
+     * Overwrite bytes of the payload in place.
+     *
+     * @param[in] offset Offset of the first byte to overwrite, usually
+     * computed at compile time with getFieldOffset().
+     * @param[in] value Bytes written; they must be inside the payload.
+     *
+     * @return A reference to this object.
+     */
+    AdvertisingDataConstexprBuilder &patch(size_t offset, mbed::Span<const uint8_t> value)
+    {
+        MBED_ASSERT(offset + value.size() <= _size);
+        if (offset + value.size() <= _size) {
+            memcpy(_data + offset, value.data(), value.size());
+        }
+        return *this;
+    }
+
+    /**
+     * Get the subspan of the buffer containing valid data.
+     *
+     * @return A Span containing the payload.
+     */
+    mbed::Span<const uint8_t> getAdvertisingData() const
+    {
+        return mbed::make_const_Span(_data, _size);
+    }
+
+private:
+    /*
+     * Offset of the field of a given type or DataSize if absent.
+     */
+    constexpr size_t findField(adv_data_type_t::type advDataType) const
+    {
+        for (size_t i = 0; i < _size; i += _data[i] + 1) {
+            if (_data[i + 1] == advDataType) {
+                return i;
+            }
+        }
+        return DataSize;
+    }
+
+    /*
+     * Not constexpr: reaching one of these while the compiler evaluates the
+     * payload is a compilation error naming the problem.
+     */
+    static void error_payload_overflow()
+    {
+        MBED_ASSERT(false);
+    }
+
+    static void error_field_already_present()
+    {
+        MBED_ASSERT(false);
+    }
+
+    static size_t error_field_not_found()
+    {
+        MBED_ASSERT(false);
+        return 0;
+    }
+
+    uint8_t _data[DataSize];
+    size_t _size;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#endif //BLE_GAP_CONSTEXPRADVERTISINGDATABUILDER_H
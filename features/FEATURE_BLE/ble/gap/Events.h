@@ -176,6 +176,140 @@ private:
     mbed::Span<const uint8_t> advertisingData;
 };
 
+/**
+ * Event generated when a batch of advertising reports is delivered.
+ *
+ * Reports received while batching is enabled are stored in the buffer
+ * provided to Gap::setScanReportBatching() and delivered together, at most
+ * after the interval configured or earlier if the buffer is full.
+ *
+ * @note The reports are only valid during the call of the event handler.
+ *
+ * @see ble::Gap::setScanReportBatching()
+ * @see ble::Gap::EventHandler::onAdvertisingReportBatch()
+ */
+struct AdvertisingReportBatchEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    /** Size of a record without its payload. */
+    static const size_t RECORD_HEADER_SIZE = 24;
+
+    /** Create an advertising report batch event.
+     *
+     * @param records Reports serialized with writeRecord().
+     * @param reportCount Number of reports in records.
+     * @param droppedReportCount Number of reports that did not fit in the
+     * buffer since the previous batch.
+     */
+    AdvertisingReportBatchEvent(
+        const mbed::Span<const uint8_t> &records,
+        uint16_t reportCount,
+        uint16_t droppedReportCount
+    ) :
+        records(records),
+        reportCount(reportCount),
+        droppedReportCount(droppedReportCount)
+    {
+    }
+
+    /** Size required to store a report in a batch. */
+    static size_t getRecordSize(const AdvertisingReportEvent &report)
+    {
+        return RECORD_HEADER_SIZE + report.getPayload().size();
+    }
+
+    /** Raw Event_Type field an advertising_event_t is built from. */
+    static uint8_t getRawType(const advertising_event_t &type)
+    {
+        return type.connectable() |
+            (type.scannable_advertising() << 1) |
+            (type.directed_advertising() << 2) |
+            (type.scan_response() << 3) |
+            (type.legacy_advertising() << 4) |
+            (type.data_status().value() << 5);
+    }
+
+    /** Serialize a report; record must hold getRecordSize() bytes. */
+    static void writeRecord(uint8_t *record, const AdvertisingReportEvent &report)
+    {
+        record[0] = getRawType(report.getType());
+        record[1] = report.getPeerAddressType().value();
+        memcpy(record + 2, report.getPeerAddress().data(), address_t::size());
+        record[8] = report.getPrimaryPhy().value();
+        record[9] = report.getSecondaryPhy().value();
+        record[10] = report.getSID();
+        record[11] = report.getTxPower();
+        record[12] = report.getRssi();
+        uint16_t interval = report.isPeriodicIntervalPresent() ?
+            report.getPeriodicInterval().value() : 0;
+        record[13] = interval;
+        record[14] = interval >> 8;
+        record[15] = report.getDirectAddressType().value();
+        memcpy(record + 16, report.getDirectAddress().data(), address_t::size());
+        record[22] = report.getPayload().size();
+        record[23] = 0;
+        memcpy(record + RECORD_HEADER_SIZE, report.getPayload().data(), report.getPayload().size());
+    }
+
+#endif
+
+    /** Get the number of reports in the batch. */
+    uint16_t getReportCount() const
+    {
+        return reportCount;
+    }
+
+    /**
+     * Get the number of reports dropped because the buffer was full since the
+     * previous batch.
+     */
+    uint16_t getDroppedReportCount() const
+    {
+        return droppedReportCount;
+    }
+
+    /**
+     * Call a function for each report of the batch, in reception order.
+     *
+     * @param visitor Function or function object called with a
+     * const AdvertisingReportEvent & for each report.
+     */
+    template<typename Visitor>
+    void forEachReport(Visitor visitor) const
+    {
+        size_t offset = 0;
+        for (uint16_t i = 0; i < reportCount; ++i) {
+            const uint8_t *record = records.data() + offset;
+            const address_t peerAddress(record + 2);
+            const address_t directAddress(record + 16);
+            const uint16_t interval = record[13] | (record[14] << 8);
+
+            AdvertisingReportEvent report(
+                advertising_event_t(record[0]),
+                static_cast<peer_address_type_t::type>(record[1]),
+                peerAddress,
+                phy_t(record[8]),
+                phy_t(record[9]),
+                record[10],
+                static_cast<advertising_power_t>(record[11]),
+                static_cast<rssi_t>(record[12]),
+                interval,
+                static_cast<peer_address_type_t::type>(record[15]),
+                directAddress,
+                mbed::make_const_Span(record + RECORD_HEADER_SIZE, record[22])
+            );
+            visitor(report);
+
+            offset += RECORD_HEADER_SIZE + record[22];
+        }
+    }
+
+private:
+    mbed::Span<const uint8_t> records;
+    uint16_t reportCount;
+    uint16_t droppedReportCount;
+};
+
 /**
  * Event generated when a connection initiation ends (successfully or not).
  *
@@ -816,6 +950,111 @@ private:
 
 };
 
+/**
+ * Event received when the throughput profile of a connection has been
+ * negotiated.
+ *
+ * @see ble::Gap::negotiateThroughputProfile().
+ * @see ble::Gap::EventHandler::onThroughputProfileNegotiated().
+ */
+struct ThroughputProfileNegotiatedEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    ThroughputProfileNegotiatedEvent(
+        ble_error_t status,
+        connection_handle_t connectionHandle,
+        phy_t txPhy,
+        phy_t rxPhy,
+        uint16_t txOctets,
+        const conn_interval_t &connectionInterval,
+        uint32_t linkCapacity
+    ) :
+        status(status),
+        connectionHandle(connectionHandle),
+        txPhy(txPhy),
+        rxPhy(rxPhy),
+        txOctets(txOctets),
+        connectionInterval(connectionInterval),
+        linkCapacity(linkCapacity)
+    {
+    }
+
+#endif
+
+    /**
+     * Get the status of the negotiation. It is equal to BLE_ERROR_NONE if
+     * every step succeeded; otherwise the values reported are the ones in
+     * use when the failing step was abandoned.
+     */
+    ble_error_t getStatus() const
+    {
+        return status;
+    }
+
+    /**
+     * Get the handle of the connection negotiated.
+     */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /**
+     * Get the PHY used by the transmitter.
+     */
+    const phy_t &getTxPhy() const
+    {
+        return txPhy;
+    }
+
+    /**
+     * Get the PHY used by the receiver.
+     */
+    const phy_t &getRxPhy() const
+    {
+        return rxPhy;
+    }
+
+    /**
+     * Get the maximum number of payload octets sent in a single link layer
+     * packet.
+     */
+    uint16_t getTxOctets() const
+    {
+        return txOctets;
+    }
+
+    /**
+     * Get the connection interval.
+     */
+    const conn_interval_t &getConnectionInterval() const
+    {
+        return connectionInterval;
+    }
+
+    /**
+     * Get the estimated capacity of the link in the transmit direction, in
+     * bytes of link layer payload per second.
+     *
+     * The estimate assumes every connection event is filled with full size
+     * packets acknowledged by empty packets; it is an upper bound of the
+     * application throughput, which also pays for the L2CAP and ATT headers.
+     */
+    uint32_t getLinkCapacity() const
+    {
+        return linkCapacity;
+    }
+
+private:
+    ble_error_t status;
+    ble::connection_handle_t connectionHandle;
+    ble::phy_t txPhy;
+    ble::phy_t rxPhy;
+    uint16_t txOctets;
+    ble::conn_interval_t connectionInterval;
+    uint32_t linkCapacity;
+};
+
 /**
  * @}
  * @}
@@ -340,6 +340,17 @@ public:
         {
         }
 
+        /**
+         * Called when a batch of advertising reports is delivered.
+         *
+         * @param event Reports received since the previous batch.
+         *
+         * @see setScanReportBatching()
+         */
+        virtual void onAdvertisingReportBatch(const AdvertisingReportBatchEvent &event)
+        {
+        }
+
         /**
          * Called when scan times out.
          *
@@ -537,6 +548,21 @@ public:
         )
         {
         }
+
+        /**
+         * Called when the negotiation started by negotiateThroughputProfile()
+         * has completed.
+         *
+         * @param event Parameters in use on the connection and the estimated
+         * capacity of the link.
+         *
+         * @see negotiateThroughputProfile()
+         */
+        virtual void onThroughputProfileNegotiated(
+            const ThroughputProfileNegotiatedEvent &event
+        )
+        {
+        }
     protected:
         /**
          * Prevent polymorphic deletion and avoid unnecessary virtual destructor
@@ -863,6 +889,53 @@ public:
      * @retval BLE_ERROR_NONE if successfully stopped scanning procedure.
      */
     ble_error_t stopScan();
+
+    /**
+     * Drop duplicate advertising reports in software.
+     *
+     * A report with the same type, advertiser address and payload as a report
+     * forwarded less than window ago is dropped, unless its RSSI differs by
+     * at least rssiThreshold dB from the one forwarded. This complements the
+     * duplicates filter of startScan() which is limited by the memory of the
+     * controller, forgets nothing until the scan restarts and ignores RSSI.
+     *
+     * @param window Time during which a duplicate is dropped. Zero disables
+     * the filter.
+     * @param rssiThreshold RSSI variation that forwards a duplicate. Zero
+     * ignores the RSSI.
+     *
+     * @return BLE_ERROR_NONE on success.
+     *
+     * @note The filter remembers a limited number of advertisers; when full,
+     * the least recently forwarded entry is forgotten.
+     */
+    ble_error_t setScanDuplicateFilter(
+        millisecond_t window,
+        uint8_t rssiThreshold = 0
+    );
+
+    /**
+     * Deliver advertising reports in batches rather than one at a time.
+     *
+     * Reports are serialized in buffer and delivered to
+     * EventHandler::onAdvertisingReportBatch() every interval, when the
+     * buffer is full and when scanning stops. This saves the cost of waking
+     * the application for every report in dense environments.
+     *
+     * @param buffer Memory holding the reports between deliveries; it must
+     * remain valid until batching is disabled. An empty buffer disables
+     * batching and reports are delivered to
+     * EventHandler::onAdvertisingReport() again.
+     * @param interval Maximum delay between the reception of a report and
+     * its delivery.
+     *
+     * @return BLE_ERROR_NONE on success or BLE_ERROR_INVALID_PARAM if interval
+     * is zero while buffer is not empty.
+     */
+    ble_error_t setScanReportBatching(
+        mbed::Span<uint8_t> buffer,
+        millisecond_t interval
+    );
 #endif // BLE_ROLE_OBSERVER
 
 #if BLE_ROLE_OBSERVER
@@ -1216,6 +1289,30 @@ public:
         const phy_set_t *rxPhys,
         coded_symbol_per_bit_t codedSymbol
     );
+
+    /**
+     * Negotiate the connection parameters giving the highest throughput.
+     *
+     * In one procedure the link is moved to the 2M PHY, the longest link
+     * layer packets are requested and the connection interval is shortened.
+     * Steps the controller doesn't support are skipped. The ATT MTU is not
+     * part of the procedure; use GattClient::negotiateAttMtu() for it.
+     *
+     * Once the procedure has been completed, the parameters in use and the
+     * resulting link capacity are reported to the application via the
+     * function onThroughputProfileNegotiated of the event handler registered
+     * by the application.
+     *
+     * @param connection Handle of the connection to negotiate.
+     *
+     * @return BLE_ERROR_NONE if the procedure has been started,
+     * BLE_ERROR_INVALID_STATE if it is already running on this connection or
+     * another appropriate error code.
+     *
+     * @see EventHandler::onThroughputProfileNegotiated is called when the
+     * negotiation has been completed.
+     */
+    ble_error_t negotiateThroughputProfile(connection_handle_t connection);
 #endif // BLE_FEATURE_PHY_MANAGEMENT
 
     /**
@@ -1514,6 +1611,14 @@ protected:
         scan_period_t period
     );
     ble_error_t stopScan_();
+    ble_error_t setScanDuplicateFilter_(
+        millisecond_t window,
+        uint8_t rssiThreshold
+    );
+    ble_error_t setScanReportBatching_(
+        mbed::Span<uint8_t> buffer,
+        millisecond_t interval
+    );
     ble_error_t createSync_(
         peer_address_type_t peerAddressType,
         const address_t &peerAddress,
@@ -1584,6 +1689,7 @@ protected:
         const phy_set_t *rxPhys,
         coded_symbol_per_bit_t codedSymbol
     );
+    ble_error_t negotiateThroughputProfile_(connection_handle_t connection);
     ble_error_t enablePrivacy_(bool enable);
     ble_error_t setPeripheralPrivacyConfiguration_(
         const peripheral_privacy_configuration_t *configuration
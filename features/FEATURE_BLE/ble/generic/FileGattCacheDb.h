@@ -0,0 +1,135 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENERIC_FILE_GATT_CACHE_DB_H_
+#define GENERIC_FILE_GATT_CACHE_DB_H_
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ble/BLETypes.h"
+#include "ble/UUID.h"
+
+// IMPORTANT: private header. Not part of the public interface.
+
+namespace ble {
+namespace generic {
+
+/** Database Hash characteristic value (Bluetooth 5.1, Vol 3, Part G, 7.3) */
+typedef byte_array_t<16> database_hash_t;
+
+/**
+ * Filesystem store of the services and characteristics discovered on remote
+ * GATT servers.
+ *
+ * Entries are indexed by the Database Hash of the server: two servers with
+ * the same hash have the same attribute layout, so a hit is valid whichever
+ * peer exposes it. When the store is full the least recently used entry is
+ * replaced.
+ */
+class FileGattCacheDb {
+public:
+    static const size_t MAX_ENTRIES = 4;
+    static const size_t MAX_SERVICES = 16;
+    static const size_t MAX_CHARACTERISTICS = 48;
+
+    struct uuid_t {
+        uint8_t length;
+        uint8_t value[UUID::LENGTH_OF_LONG_UUID];
+    };
+
+    struct service_t {
+        uint16_t begin;
+        uint16_t end;
+        uuid_t uuid;
+    };
+
+    struct characteristic_t {
+        uint16_t decl_handle;
+        uint16_t value_handle;
+        uint16_t last_handle;
+        uint8_t properties;
+        uuid_t uuid;
+    };
+
+    /** Services and characteristics of a server, in handle order */
+    struct database_t {
+        uint8_t service_count;
+        uint8_t characteristic_count;
+        service_t services[MAX_SERVICES];
+        characteristic_t characteristics[MAX_CHARACTERISTICS];
+    };
+
+    FileGattCacheDb(FILE *db_file);
+    ~FileGattCacheDb();
+
+    /**
+     * Validates or creates a file for the GATT cache.
+     * @param db_path path to the file
+     * @return FILE handle open and ready for use by the cache or NULL if unavailable
+     */
+    static FILE* open_db_file(const char *db_path);
+
+    /**
+     * Fetch the database discovered on a server with a given hash.
+     * @param hash Database Hash read from the server
+     * @param database destination of the cached database
+     * @return true on a hit, false if the hash is not in the cache
+     */
+    bool load(const database_hash_t &hash, database_t &database);
+
+    /**
+     * Record the database discovered on a server.
+     * @param hash Database Hash read from the server
+     * @param database services and characteristics discovered
+     */
+    void store(const database_hash_t &hash, const database_t &database);
+
+    static void set_uuid(uuid_t &dest, const UUID &uuid) {
+        dest.length = uuid.getLen();
+        memcpy(dest.value, uuid.getBaseUUID(), dest.length);
+    }
+
+    static UUID get_uuid(const uuid_t &src) {
+        if (src.length == UUID::LENGTH_OF_LONG_UUID) {
+            return UUID(src.value, UUID::LSB);
+        }
+        UUID::ShortUUIDBytes_t short_uuid;
+        memcpy(&short_uuid, src.value, sizeof(short_uuid));
+        return UUID(short_uuid);
+    }
+
+private:
+    struct entry_t {
+        database_hash_t hash;
+        uint32_t last_use;
+        bool valid;
+    };
+
+    void restore();
+
+    static FILE* erase_db_file(FILE* db_file);
+
+private:
+    entry_t _entries[MAX_ENTRIES];
+    uint32_t _use_counter;
+    FILE *_db_file;
+};
+
+} /* namespace generic */
+} /* namespace ble */
+
+#endif /*GENERIC_FILE_GATT_CACHE_DB_H_*/
@@ -24,14 +24,27 @@
 namespace ble {
 namespace generic {
 
-/** Filesystem implementation */
+/**
+ * Filesystem implementation.
+ *
+ * Entries are held in RAM and written to the file by sync(), which happens
+ * when a connection closes. An entry is written in a single pass and only if
+ * it changed since the previous sync, so signed writes and reconnections do
+ * not wear the flash with small writes.
+ */
 class FileSecurityDb : public SecurityDb {
 private:
 
+    /* the layout of the keys matches the layout of an entry in the file */
     struct entry_t {
         SecurityDistributionFlags_t flags;
-        sign_count_t peer_sign_counter;
+        SecurityEntryKeys_t local_keys;
+        SecurityEntryKeys_t peer_keys;
+        SecurityEntryIdentity_t peer_identity;
+        SecurityEntrySigning_t peer_signing;
+        SecurityDistributionFlags_t synced_flags;
         size_t file_offset;
+        bool dirty;
     };
 
     static const size_t MAX_ENTRIES = 5;
@@ -148,7 +161,6 @@ private:
 private:
     entry_t _entries[MAX_ENTRIES];
     FILE *_db_file;
-    uint8_t _buffer[sizeof(SecurityEntryKeys_t)];
 };
 
 } /* namespace pal */
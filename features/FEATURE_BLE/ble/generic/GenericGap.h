@@ -30,6 +30,7 @@
 
 #include "drivers/LowPowerTimeout.h"
 #include "drivers/LowPowerTicker.h"
+#include "drivers/LowPowerTimer.h"
 #include "platform/mbed_error.h"
 
 namespace ble {
@@ -298,6 +299,22 @@ public:
      */
     ble_error_t stopScan_();
 
+    /**
+     * @see Gap::setScanDuplicateFilter
+     */
+    ble_error_t setScanDuplicateFilter_(
+        millisecond_t window,
+        uint8_t rssiThreshold
+    );
+
+    /**
+     * @see Gap::setScanReportBatching
+     */
+    ble_error_t setScanReportBatching_(
+        mbed::Span<uint8_t> buffer,
+        millisecond_t interval
+    );
+
     /**
      * @see Gap::connect
      */
@@ -363,6 +380,11 @@ public:
         ble::coded_symbol_per_bit_t codedSymbol
     );
 
+    /**
+    * @see Gap::negotiateThroughputProfile
+    */
+    ble_error_t negotiateThroughputProfile_(connection_handle_t connection);
+
     ble_error_t disconnect_(
         connection_handle_t connectionHandle,
         local_disconnection_reason_t reason
@@ -573,6 +595,64 @@ private:
     void on_scan_timeout_();
     void process_legacy_scan_timeout();
 
+    enum throughput_step_t {
+        THROUGHPUT_IDLE,
+        THROUGHPUT_PHY_UPDATE,
+        THROUGHPUT_CONNECTION_UPDATE
+    };
+
+    /*
+     * Link state of a connection, kept while a throughput profile is
+     * negotiated or once the data length of the connection has changed.
+     */
+    struct link_t {
+        bool in_use;
+        connection_handle_t connection;
+        throughput_step_t step;
+        ble_error_t status;
+        uint8_t tx_phy;
+        uint8_t rx_phy;
+        uint16_t tx_octets;
+        uint16_t connection_interval;
+    };
+
+    link_t *get_link(connection_handle_t connection, bool allocate);
+
+    ble_error_t start_throughput_connection_update(link_t &link);
+
+    void on_throughput_connection_update(
+        connection_handle_t connection,
+        bool success,
+        uint16_t connection_interval
+    );
+
+    void complete_throughput_profile(link_t &link);
+
+    static uint32_t get_link_capacity(
+        phy_t phy,
+        uint16_t tx_octets,
+        uint16_t connection_interval
+    );
+
+    void signal_advertising_report(const AdvertisingReportEvent &report);
+
+    bool is_duplicate_advertising_report(const AdvertisingReportEvent &report);
+
+    void on_scan_report_interval();
+
+    void flush_scan_reports();
+
+    /*
+     * Advertising report forwarded recently, identified by a hash of its
+     * type, advertiser address and payload.
+     */
+    struct scan_duplicate_t {
+        bool in_use;
+        rssi_t rssi;
+        uint32_t hash;
+        uint32_t timestamp;
+    };
+
 private:
     pal::EventQueue &_event_queue;
     PalGap &_pal_gap;
@@ -595,6 +675,8 @@ private:
     mbed::LowPowerTimeout _advertising_timeout;
     mbed::LowPowerTimeout _scan_timeout;
     mbed::LowPowerTicker _address_rotation_ticker;
+    mbed::LowPowerTicker _scan_report_ticker;
+    mbed::LowPowerTimer _scan_duplicate_timer;
 
     template<size_t bit_size>
     struct BitArray {
@@ -650,6 +732,19 @@ private:
 
     bool _user_manage_connection_parameter_requests : 1;
 
+    static const uint8_t MAX_LINKS = 4;
+    link_t _links[MAX_LINKS];
+
+    static const uint8_t MAX_SCAN_DUPLICATES = 16;
+    scan_duplicate_t _scan_duplicates[MAX_SCAN_DUPLICATES];
+    uint32_t _scan_duplicate_window;
+    uint8_t _scan_duplicate_rssi_threshold;
+
+    mbed::Span<uint8_t> _scan_report_buffer;
+    size_t _scan_report_size;
+    uint16_t _scan_report_count;
+    uint16_t _scan_report_dropped;
+
 private:
     ble_error_t setExtendedAdvertisingParameters(
         advertising_handle_t handle,
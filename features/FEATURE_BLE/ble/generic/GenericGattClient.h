@@ -21,6 +21,7 @@
 #include "ble/GattClient.h"
 #include "ble/pal/PalGattClient.h"
 #include "ble/pal/SigningEventMonitor.h"
+#include "ble/generic/FileGattCacheDb.h"
 
 // IMPORTANT: private header. Not part of the public interface.
 
@@ -129,6 +130,11 @@ public:
         connection_handle_t connection
     );
 
+    /**
+     * @see GattClient::enableDatabaseCache
+     */
+    ble_error_t enableDatabaseCache_(const char *dbFilepath);
+
 	/**
 	 * @see GattClient::reset
 	 */
@@ -180,6 +186,7 @@ private:
     ServiceDiscovery::TerminationCallback_t _termination_callback;
     SigningMonitorEventHandler* _signing_event_handler;
     mutable ProcedureControlBlock* control_blocks;
+    FileGattCacheDb* _cache_db;
     bool _is_reseting;
 };
 
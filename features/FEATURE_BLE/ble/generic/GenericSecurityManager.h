@@ -280,7 +280,8 @@ public:
         _default_key_distribution(pal::KeyDistribution::KEY_DISTRIBUTION_ALL),
         _pairing_authorisation_required(false),
         _legacy_pairing_allowed(true),
-        _master_sends_keys(false) {
+        _master_sends_keys(false),
+        _resolving_list_size(0) {
         _pal.set_event_handler(this);
 
         /* We create a fake value for oob to allow creation of the next oob which needs
@@ -461,6 +462,17 @@ private:
         const SecurityEntryIdentity_t* identity
     );
 
+    /**
+     * Callback invoked by the secure DB when the identity of an entry about
+     * to receive a new IRK has been retrieved.
+     * @param entry Handle of the entry.
+     * @param identity The identity being replaced; may be NULL.
+     */
+    void on_security_entry_replaced(
+        SecurityDb::entry_handle_t entry,
+        const SecurityEntryIdentity_t* identity
+    );
+
     /**
      * Callback invoked by the secure DB when the identity list has been
      * retrieved.
@@ -520,6 +532,8 @@ private:
         uint8_t legacy_pairing_oob_request_pending:1;
 
         uint8_t csrk_failures:2;
+
+        uint8_t identity_updated:1; /**< IRK distributed, resolving list to be updated */
     };
 
     PalSecurityManager &_pal;
@@ -544,6 +558,9 @@ private:
     bool _legacy_pairing_allowed;
     bool _master_sends_keys;
 
+    /* Number of identities programmed into the controller's resolving list */
+    uint8_t _resolving_list_size;
+
     static const size_t MAX_CONTROL_BLOCKS = 5;
     ControlBlock_t _control_blocks[MAX_CONTROL_BLOCKS];
 
@@ -1957,6 +1957,31 @@ public:
         );
     }
 
+    /**
+     * Suggest the maximum payload and transmission time of the link layer
+     * packets sent on a connection.
+     *
+     * The controller negotiates the values with the peer and reports the
+     * outcome with an LE Data Length Change event if the lengths in use
+     * change.
+     *
+     * @param connection Handle of the connection.
+     * @param tx_octets Preferred maximum number of payload octets in a single
+     * packet; range [0x001B : 0x00FB].
+     * @param tx_time Preferred maximum number of microseconds used to
+     * transmit a single packet; range [0x0148 : 0x4290].
+     * @return BLE_ERROR_NONE if the request has been sent to the controller.
+     *
+     * @note: See Bluetooth 5 Vol 2 PartE: 7.8.33 LE Set Data Length Command.
+     */
+    ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) {
+        return impl()->set_data_length_(connection, tx_octets, tx_time);
+    }
+
     /**
      * Register a callback which will handle Gap events.
      *
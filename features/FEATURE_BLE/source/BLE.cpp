@@ -254,6 +254,19 @@ GattClient& BLE::gattClient()
 
 #endif // BLE_FEATURE_GATT_CLIENT
 
+#if BLE_FEATURE_CONNECTABLE
+
+L2capChannel& BLE::l2capChannel()
+{
+    if (!transport) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_BLE, MBED_ERROR_CODE_BLE_BACKEND_NOT_INITIALIZED), "bad handle to underlying transport");
+    }
+
+    return transport->getL2capChannel();
+}
+
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_FEATURE_SECURITY
 
 const SecurityManager& BLE::securityManager() const
@@ -131,6 +131,12 @@ ble_error_t GattClient<Impl>::negotiateAttMtu(
     return impl()->negotiateAttMtu_(connHandle);
 }
 
+template<class Impl>
+ble_error_t GattClient<Impl>::enableDatabaseCache(const char *dbFilepath)
+{
+    return impl()->enableDatabaseCache_(dbFilepath);
+}
+
 template<class Impl>
 ble_error_t GattClient<Impl>::reset(void)
 {
@@ -193,6 +199,12 @@ ble_error_t GattClient<Impl>::negotiateAttMtu_(
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t GattClient<Impl>::enableDatabaseCache_(const char *dbFilepath)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 template<class Impl>
 ble_error_t GattClient<Impl>::read_(
     ble::connection_handle_t connHandle,
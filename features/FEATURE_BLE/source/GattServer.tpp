@@ -85,6 +85,31 @@ ble_error_t GattServer<Impl>::write(
     );
 }
 
+template<class Impl>
+ble_error_t GattServer<Impl>::queueUpdates(
+    ble::connection_handle_t connectionHandle,
+    GattAttribute::Handle_t attributeHandle,
+    const UpdatePayload *payloads,
+    size_t count,
+    size_t *queued
+) {
+    return impl()->queueUpdates_(
+        connectionHandle,
+        attributeHandle,
+        payloads,
+        count,
+        queued
+    );
+}
+
+template<class Impl>
+ble_error_t GattServer<Impl>::getUpdateQueueStatistics(
+    ble::connection_handle_t connectionHandle,
+    UpdateQueueStatistics *statistics
+) {
+    return impl()->getUpdateQueueStatistics_(connectionHandle, statistics);
+}
+
 template<class Impl>
 ble_error_t GattServer<Impl>::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
@@ -182,6 +207,25 @@ ble_error_t GattServer<Impl>::write_(
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t GattServer<Impl>::queueUpdates_(
+    ble::connection_handle_t connectionHandle,
+    GattAttribute::Handle_t attributeHandle,
+    const UpdatePayload *payloads,
+    size_t count,
+    size_t *queued
+) {
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+template<class Impl>
+ble_error_t GattServer<Impl>::getUpdateQueueStatistics_(
+    ble::connection_handle_t connectionHandle,
+    UpdateQueueStatistics *statistics
+) {
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 template<class Impl>
 ble_error_t GattServer<Impl>::areUpdatesEnabled_(
     const GattCharacteristic &characteristic,
@@ -0,0 +1,118 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ble/L2capChannel.h"
+
+namespace ble {
+namespace interface {
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::registerChannel(
+    l2cap_registration_t &registration,
+    const L2capChannelParameters &parameters
+) {
+    return impl()->registerChannel_(registration, parameters);
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::unregisterChannel(
+    l2cap_registration_t registration
+) {
+    return impl()->unregisterChannel_(registration);
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::connect(
+    connection_handle_t connectionHandle,
+    l2cap_registration_t registration,
+    uint16_t psm,
+    l2cap_channel_id_t &channel
+) {
+    return impl()->connect_(connectionHandle, registration, psm, channel);
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::disconnect(l2cap_channel_id_t channel)
+{
+    return impl()->disconnect_(channel);
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::write(
+    l2cap_channel_id_t channel,
+    mbed::Span<const uint8_t> sdu
+) {
+    return impl()->write_(channel, sdu);
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::reset(void)
+{
+    return impl()->reset_();
+}
+
+/* ------------------------ Default implementations ------------------------- */
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::reset_(void)
+{
+    eventHandler = NULL;
+
+    return BLE_ERROR_NONE;
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::registerChannel_(
+    l2cap_registration_t &registration,
+    const L2capChannelParameters &parameters
+) {
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::unregisterChannel_(
+    l2cap_registration_t registration
+) {
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::connect_(
+    connection_handle_t connectionHandle,
+    l2cap_registration_t registration,
+    uint16_t psm,
+    l2cap_channel_id_t &channel
+) {
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::disconnect_(l2cap_channel_id_t channel)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+template<class Impl>
+ble_error_t L2capChannel<Impl>::write_(
+    l2cap_channel_id_t channel,
+    mbed::Span<const uint8_t> sdu
+) {
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+} // interface
+} // ble
@@ -210,6 +210,24 @@ ble_error_t Gap<Impl>::stopScan()
 {
     return impl()->stopScan_();
 }
+
+template<class Impl>
+ble_error_t Gap<Impl>::setScanDuplicateFilter(
+    millisecond_t window,
+    uint8_t rssiThreshold
+)
+{
+    return impl()->setScanDuplicateFilter_(window, rssiThreshold);
+}
+
+template<class Impl>
+ble_error_t Gap<Impl>::setScanReportBatching(
+    mbed::Span<uint8_t> buffer,
+    millisecond_t interval
+)
+{
+    return impl()->setScanReportBatching_(buffer, interval);
+}
 #endif // BLE_ROLE_OBSERVER
 #if BLE_FEATURE_PERIODIC_ADVERTISING
 template<class Impl>
@@ -417,6 +435,12 @@ ble_error_t Gap<Impl>::setPhy(
         codedSymbol
     );
 }
+
+template<class Impl>
+ble_error_t Gap<Impl>::negotiateThroughputProfile(connection_handle_t connection)
+{
+    return impl()->negotiateThroughputProfile_(connection);
+}
 #endif // BLE_FEATURE_PHY_MANAGEMENT
 
 template<class Impl>
@@ -668,6 +692,24 @@ ble_error_t Gap<Impl>::stopScan_()
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t Gap<Impl>::setScanDuplicateFilter_(
+    millisecond_t window,
+    uint8_t rssiThreshold
+)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
+template<class Impl>
+ble_error_t Gap<Impl>::setScanReportBatching_(
+    mbed::Span<uint8_t> buffer,
+    millisecond_t interval
+)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 template<class Impl>
 ble_error_t Gap<Impl>::createSync_(
     peer_address_type_t peerAddressType,
@@ -829,6 +871,12 @@ ble_error_t Gap<Impl>::setPhy_(
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+template<class Impl>
+ble_error_t Gap<Impl>::negotiateThroughputProfile_(connection_handle_t connection)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 template<class Impl>
 ble_error_t Gap<Impl>::enablePrivacy_(bool enable)
 {
@@ -0,0 +1,211 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+
+#include "ble/generic/FileGattCacheDb.h"
+
+namespace ble {
+namespace generic {
+
+namespace {
+
+const uint16_t DB_VERSION = 1;
+
+/* layout of an entry in the file, the valid flag is written last */
+struct store_t {
+    uint32_t valid;
+    uint32_t last_use;
+    database_hash_t hash;
+    FileGattCacheDb::database_t database;
+};
+
+/* make size multiple of 4 */
+#define PAD4(value) ((((value - 1) / 4) * 4) + 4)
+
+#define DB_OFFSET_VERSION (0)
+#define DB_OFFSET_STORES  PAD4(sizeof(DB_VERSION))
+#define DB_SIZE_STORE     PAD4(sizeof(store_t))
+#define DB_SIZE           (DB_OFFSET_STORES + FileGattCacheDb::MAX_ENTRIES * DB_SIZE_STORE)
+
+long int store_offset(size_t index) {
+    return DB_OFFSET_STORES + index * DB_SIZE_STORE;
+}
+
+template<class T>
+bool db_read(FILE *db_file, T *value, long int offset) {
+    fseek(db_file, offset, SEEK_SET);
+    return fread(value, sizeof(T), 1, db_file) == 1;
+}
+
+template<class T>
+void db_write(FILE *db_file, const T *value, long int offset) {
+    fseek(db_file, offset, SEEK_SET);
+    fwrite(value, sizeof(T), 1, db_file);
+}
+
+} // namespace
+
+FileGattCacheDb::FileGattCacheDb(FILE *db_file) :
+    _use_counter(0),
+    _db_file(db_file) {
+    restore();
+}
+
+FileGattCacheDb::~FileGattCacheDb() {
+    fclose(_db_file);
+}
+
+FILE* FileGattCacheDb::open_db_file(const char *db_path) {
+    if (!db_path) {
+        return NULL;
+    }
+
+    /* try to open an existing file */
+    FILE *db_file = fopen(db_path, "rb+");
+
+    if (!db_file) {
+        /* file doesn't exist, create it */
+        db_file = fopen(db_path, "wb+");
+    }
+
+    if (!db_file) {
+        /* failed to create a file, abort */
+        return NULL;
+    }
+
+    /* if the version or size doesn't match what we expect blank the file */
+    bool init = false;
+    uint16_t version;
+
+    if (db_read(db_file, &version, DB_OFFSET_VERSION) && version == DB_VERSION) {
+        fseek(db_file, 0, SEEK_END);
+        if (ftell(db_file) != (long int) DB_SIZE) {
+            init = true;
+        }
+    } else {
+        init = true;
+    }
+
+    if (init) {
+        return erase_db_file(db_file);
+    }
+
+    return db_file;
+}
+
+FILE* FileGattCacheDb::erase_db_file(FILE* db_file) {
+    fseek(db_file, 0, SEEK_SET);
+
+    /* zero the file */
+    const uint32_t zero = 0;
+    size_t count = DB_SIZE / 4;
+    while (count--) {
+        if (fwrite(&zero, sizeof(zero), 1, db_file) != 1) {
+            fclose(db_file);
+            return NULL;
+        }
+    }
+
+    db_write(db_file, &DB_VERSION, DB_OFFSET_VERSION);
+
+    if (fflush(db_file)) {
+        fclose(db_file);
+        return NULL;
+    }
+
+    return db_file;
+}
+
+void FileGattCacheDb::restore() {
+    /* only the index is kept in memory, databases are read on a hit */
+    for (size_t i = 0; i < MAX_ENTRIES; i++) {
+        entry_t &entry = _entries[i];
+        long int offset = store_offset(i);
+        uint32_t valid = 0;
+
+        entry.valid =
+            db_read(_db_file, &valid, offset + offsetof(store_t, valid)) &&
+            valid == 1 &&
+            db_read(_db_file, &entry.last_use, offset + offsetof(store_t, last_use)) &&
+            db_read(_db_file, &entry.hash, offset + offsetof(store_t, hash));
+
+        if (entry.valid && entry.last_use > _use_counter) {
+            _use_counter = entry.last_use;
+        }
+    }
+}
+
+bool FileGattCacheDb::load(const database_hash_t &hash, database_t &database) {
+    for (size_t i = 0; i < MAX_ENTRIES; i++) {
+        entry_t &entry = _entries[i];
+        if (!entry.valid || entry.hash != hash) {
+            continue;
+        }
+
+        long int offset = store_offset(i);
+        if (!db_read(_db_file, &database, offset + offsetof(store_t, database)) ||
+            database.service_count > MAX_SERVICES ||
+            database.characteristic_count > MAX_CHARACTERISTICS) {
+            return false;
+        }
+
+        entry.last_use = ++_use_counter;
+        db_write(_db_file, &entry.last_use, offset + offsetof(store_t, last_use));
+        fflush(_db_file);
+        return true;
+    }
+
+    return false;
+}
+
+void FileGattCacheDb::store(const database_hash_t &hash, const database_t &database) {
+    /* replace the entry of the same hash, a free one or the least recently used */
+    size_t index = 0;
+    for (size_t i = 0; i < MAX_ENTRIES; i++) {
+        if (_entries[i].valid && _entries[i].hash == hash) {
+            index = i;
+            break;
+        }
+        if (!_entries[i].valid) {
+            index = i;
+        } else if (_entries[index].valid && _entries[i].last_use < _entries[index].last_use) {
+            index = i;
+        }
+    }
+
+    entry_t &entry = _entries[index];
+    long int offset = store_offset(index);
+    const uint32_t invalid = 0;
+    const uint32_t valid = 1;
+
+    entry.valid = false;
+    entry.hash = hash;
+    entry.last_use = ++_use_counter;
+
+    db_write(_db_file, &invalid, offset + offsetof(store_t, valid));
+    fflush(_db_file);
+    db_write(_db_file, &database, offset + offsetof(store_t, database));
+    db_write(_db_file, &entry.hash, offset + offsetof(store_t, hash));
+    db_write(_db_file, &entry.last_use, offset + offsetof(store_t, last_use));
+    fflush(_db_file);
+    db_write(_db_file, &valid, offset + offsetof(store_t, valid));
+
+    entry.valid = (fflush(_db_file) == 0);
+}
+
+} /* namespace generic */
+} /* namespace ble */
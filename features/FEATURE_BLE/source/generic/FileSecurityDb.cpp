@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include "FileSecurityDb.h"
 
 namespace ble {
@@ -21,26 +23,6 @@ namespace generic {
 
 const uint16_t DB_VERSION = 1;
 
-#define DB_STORE_OFFSET_FLAGS         (0)
-#define DB_STORE_OFFSET_LOCAL_KEYS    (DB_STORE_OFFSET_FLAGS + sizeof(SecurityDistributionFlags_t))
-#define DB_STORE_OFFSET_PEER_KEYS     (DB_STORE_OFFSET_LOCAL_KEYS + sizeof(SecurityEntryKeys_t))
-#define DB_STORE_OFFSET_PEER_IDENTITY (DB_STORE_OFFSET_PEER_KEYS + sizeof(SecurityEntryKeys_t))
-#define DB_STORE_OFFSET_PEER_SIGNING  (DB_STORE_OFFSET_PEER_IDENTITY + sizeof(SecurityEntryIdentity_t))
-
-#define DB_STORE_OFFSET_LOCAL_KEYS_LTK  (DB_STORE_OFFSET_LOCAL_KEYS)
-#define DB_STORE_OFFSET_LOCAL_KEYS_EDIV (DB_STORE_OFFSET_LOCAL_KEYS_LTK + sizeof(ltk_t))
-#define DB_STORE_OFFSET_LOCAL_KEYS_RAND (DB_STORE_OFFSET_LOCAL_KEYS_EDIV + sizeof(ediv_t))
-
-#define DB_STORE_OFFSET_PEER_KEYS_LTK  (DB_STORE_OFFSET_PEER_KEYS)
-#define DB_STORE_OFFSET_PEER_KEYS_EDIV (DB_STORE_OFFSET_PEER_KEYS_LTK + sizeof(ltk_t))
-#define DB_STORE_OFFSET_PEER_KEYS_RAND (DB_STORE_OFFSET_PEER_KEYS_EDIV + sizeof(ediv_t))
-
-#define DB_STORE_OFFSET_PEER_IDENTITY_ADDRESS (DB_STORE_OFFSET_PEER_IDENTITY)
-#define DB_STORE_OFFSET_PEER_IDENTITY_IRK     (DB_STORE_OFFSET_PEER_IDENTITY + sizeof(address_t))
-#define DB_STORE_OFFSET_PEER_IDENTITY_ADDRESS_IS_PUBLIC (DB_STORE_OFFSET_PEER_IDENTITY_IRK + sizeof(irk_t))
-
-#define DB_STORE_OFFSET_PEER_SIGNING_COUNT (DB_STORE_OFFSET_PEER_SIGNING + sizeof(csrk_t))
-
 /* make size multiple of 4 */
 #define PAD4(value) ((((value - 1) / 4) * 4) + 4)
 
@@ -73,6 +55,8 @@ FileSecurityDb::FileSecurityDb(FILE *db_file)
     /* init the offset in entries so they point to file positions */
     for (size_t i = 0; i < get_entry_count(); i++) {
         _entries[i].file_offset = DB_OFFSET_STORES + i * DB_SIZE_STORE;
+        _entries[i].synced_flags = _entries[i].flags;
+        _entries[i].dirty = false;
     }
 }
 
@@ -163,8 +147,8 @@ void FileSecurityDb::set_entry_local_ltk(
     }
 
     entry->flags.ltk_sent = true;
-
-    db_write(&ltk, entry->file_offset + DB_STORE_OFFSET_LOCAL_KEYS_LTK);
+    entry->local_keys.ltk = ltk;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_local_ediv_rand(
@@ -177,8 +161,9 @@ void FileSecurityDb::set_entry_local_ediv_rand(
         return;
     }
 
-    db_write(&ediv, entry->file_offset + DB_STORE_OFFSET_LOCAL_KEYS_EDIV);
-    db_write(&rand, entry->file_offset + DB_STORE_OFFSET_LOCAL_KEYS_RAND);
+    entry->local_keys.ediv = ediv;
+    entry->local_keys.rand = rand;
+    entry->dirty = true;
 }
 
 /* peer's keys */
@@ -195,8 +180,8 @@ void FileSecurityDb::set_entry_peer_ltk(
     }
 
     entry->flags.ltk_stored = true;
-
-    db_write(&ltk, entry->file_offset + DB_STORE_OFFSET_PEER_KEYS_LTK);
+    entry->peer_keys.ltk = ltk;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_ediv_rand(
@@ -209,8 +194,9 @@ void FileSecurityDb::set_entry_peer_ediv_rand(
         return;
     }
 
-    db_write(&ediv, entry->file_offset + DB_STORE_OFFSET_PEER_KEYS_EDIV);
-    db_write(&rand, entry->file_offset + DB_STORE_OFFSET_PEER_KEYS_RAND);
+    entry->peer_keys.ediv = ediv;
+    entry->peer_keys.rand = rand;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_irk(
@@ -223,8 +209,8 @@ void FileSecurityDb::set_entry_peer_irk(
     }
 
     entry->flags.irk_stored = true;
-
-    db_write(&irk, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY_IRK);
+    entry->peer_identity.irk = irk;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_bdaddr(
@@ -237,8 +223,9 @@ void FileSecurityDb::set_entry_peer_bdaddr(
         return;
     }
 
-    db_write(&peer_address, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY_ADDRESS);
-    db_write(&address_is_public, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY_ADDRESS_IS_PUBLIC);
+    entry->peer_identity.identity_address = peer_address;
+    entry->peer_identity.identity_address_is_public = address_is_public;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_csrk(
@@ -251,8 +238,8 @@ void FileSecurityDb::set_entry_peer_csrk(
     }
 
     entry->flags.csrk_stored = true;
-
-    db_write(&csrk, entry->file_offset + DB_STORE_OFFSET_PEER_SIGNING);
+    entry->peer_signing.csrk = csrk;
+    entry->dirty = true;
 }
 
 void FileSecurityDb::set_entry_peer_sign_counter(
@@ -260,8 +247,9 @@ void FileSecurityDb::set_entry_peer_sign_counter(
     sign_count_t sign_counter
 ) {
     entry_t *entry = as_entry(db_handle);
-    if (entry) {
-        entry->peer_sign_counter = sign_counter;
+    if (entry && entry->peer_signing.counter != sign_counter) {
+        entry->peer_signing.counter = sign_counter;
+        entry->dirty = true;
     }
 }
 
@@ -276,6 +264,7 @@ void FileSecurityDb::restore() {
         erase_db_file(_db_file);
 
         db_write(&DB_VERSION, DB_OFFSET_VERSION);
+        fflush(_db_file);
         return;
     }
 
@@ -283,12 +272,18 @@ void FileSecurityDb::restore() {
     db_read(&_local_csrk, DB_OFFSET_LOCAL_CSRK);
     db_read(&_local_sign_counter, DB_OFFSET_LOCAL_SIGN_COUNT);
 
-    /* read flags and sign counters */
+    /* load the entries in memory, fields are contiguous in the file */
     for (size_t i = 0; i < get_entry_count(); i++) {
-        db_read(&_entries[i].flags, _entries[i].file_offset + DB_STORE_OFFSET_FLAGS);
-        db_read(&_entries[i].peer_sign_counter, _entries[i].file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
+        entry_t &entry = _entries[i];
+        fseek(_db_file, entry.file_offset, SEEK_SET);
+        fread(&entry.flags, sizeof(entry.flags), 1, _db_file);
+        fread(&entry.local_keys, sizeof(entry.local_keys), 1, _db_file);
+        fread(&entry.peer_keys, sizeof(entry.peer_keys), 1, _db_file);
+        fread(&entry.peer_identity, sizeof(entry.peer_identity), 1, _db_file);
+        fread(&entry.peer_signing, sizeof(entry.peer_signing), 1, _db_file);
+        entry.synced_flags = entry.flags;
+        entry.dirty = false;
     }
-
 }
 
 void FileSecurityDb::sync(entry_handle_t db_handle) {
@@ -297,12 +292,32 @@ void FileSecurityDb::sync(entry_handle_t db_handle) {
         return;
     }
 
-    db_write(&entry->peer_sign_counter, entry->file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
-    db_write(&entry->flags, entry->file_offset + DB_STORE_OFFSET_FLAGS);
+    /* flags are also modified through the handle returned to the caller */
+    if (memcmp(&entry->flags, &entry->synced_flags, sizeof(entry->flags))) {
+        entry->dirty = true;
+    }
+
+    if (!entry->dirty) {
+        return;
+    }
+
+    /* a single pass over the entry, flushed once */
+    fseek(_db_file, entry->file_offset, SEEK_SET);
+    fwrite(&entry->flags, sizeof(entry->flags), 1, _db_file);
+    fwrite(&entry->local_keys, sizeof(entry->local_keys), 1, _db_file);
+    fwrite(&entry->peer_keys, sizeof(entry->peer_keys), 1, _db_file);
+    fwrite(&entry->peer_identity, sizeof(entry->peer_identity), 1, _db_file);
+    fwrite(&entry->peer_signing, sizeof(entry->peer_signing), 1, _db_file);
+
+    if (fflush(_db_file) == 0) {
+        entry->synced_flags = entry->flags;
+        entry->dirty = false;
+    }
 }
 
 void FileSecurityDb::set_restore(bool reload) {
     db_write(&reload, DB_OFFSET_RESTORE);
+    fflush(_db_file);
 }
 
 /* helper functions */
@@ -325,15 +340,15 @@ void FileSecurityDb::reset_entry(entry_handle_t db_entry) {
         return;
     }
 
-    fseek(_db_file, entry->file_offset, SEEK_SET);
-    const uint32_t zero = 0;
-    size_t count = DB_SIZE_STORE / 4;
-    while (count--) {
-        fwrite(&zero, sizeof(zero), 1, _db_file);
-    }
-
     entry->flags = SecurityDistributionFlags_t();
-    entry->peer_sign_counter = 0;
+    entry->local_keys = SecurityEntryKeys_t();
+    entry->peer_keys = SecurityEntryKeys_t();
+    entry->peer_identity = SecurityEntryIdentity_t();
+    entry->peer_signing = SecurityEntrySigning_t();
+
+    /* removed bonds are persisted immediately */
+    entry->dirty = true;
+    sync(db_entry);
 }
 
 SecurityEntryIdentity_t* FileSecurityDb::read_in_entry_peer_identity(entry_handle_t db_entry) {
@@ -342,10 +357,7 @@ SecurityEntryIdentity_t* FileSecurityDb::read_in_entry_peer_identity(entry_handl
         return NULL;
     }
 
-    SecurityEntryIdentity_t* identity = reinterpret_cast<SecurityEntryIdentity_t*>(_buffer);
-    db_read(identity, entry->file_offset + DB_STORE_OFFSET_PEER_IDENTITY);
-
-    return identity;
+    return &entry->peer_identity;
 };
 
 SecurityEntryKeys_t* FileSecurityDb::read_in_entry_peer_keys(entry_handle_t db_entry) {
@@ -354,10 +366,7 @@ SecurityEntryKeys_t* FileSecurityDb::read_in_entry_peer_keys(entry_handle_t db_e
         return NULL;
     }
 
-    SecurityEntryKeys_t* keys = reinterpret_cast<SecurityEntryKeys_t*>(_buffer);
-    db_read(keys, entry->file_offset + DB_STORE_OFFSET_PEER_KEYS);
-
-    return keys;
+    return &entry->peer_keys;
 };
 
 SecurityEntryKeys_t* FileSecurityDb::read_in_entry_local_keys(entry_handle_t db_entry) {
@@ -366,10 +375,7 @@ SecurityEntryKeys_t* FileSecurityDb::read_in_entry_local_keys(entry_handle_t db_
         return NULL;
     }
 
-    SecurityEntryKeys_t* keys = reinterpret_cast<SecurityEntryKeys_t*>(_buffer);
-    db_read(keys, entry->file_offset + DB_STORE_OFFSET_LOCAL_KEYS);
-
-    return keys;
+    return &entry->local_keys;
 };
 
 SecurityEntrySigning_t* FileSecurityDb::read_in_entry_peer_signing(entry_handle_t db_entry) {
@@ -378,16 +384,7 @@ SecurityEntrySigning_t* FileSecurityDb::read_in_entry_peer_signing(entry_handle_
         return NULL;
     }
 
-    /* only read in the csrk */
-    csrk_t* csrk = reinterpret_cast<csrk_t*>(_buffer);
-    db_read(csrk, entry->file_offset + DB_STORE_OFFSET_PEER_SIGNING);
-
-
-    /* use the counter held in memory */
-    SecurityEntrySigning_t* signing = reinterpret_cast<SecurityEntrySigning_t*>(_buffer);
-    signing->counter = entry->peer_sign_counter;
-
-    return signing;
+    return &entry->peer_signing;
 };
 
 } /* namespace pal */
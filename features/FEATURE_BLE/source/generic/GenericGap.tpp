@@ -315,7 +315,15 @@ GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::
     _scan_enabled(false),
     _advertising_timeout(),
     _scan_timeout(),
-    _user_manage_connection_parameter_requests(false)
+    _user_manage_connection_parameter_requests(false),
+    _links(),
+    _scan_duplicates(),
+    _scan_duplicate_window(0),
+    _scan_duplicate_rssi_threshold(0),
+    _scan_report_buffer(),
+    _scan_report_size(0),
+    _scan_report_count(0),
+    _scan_report_dropped(0)
 {
     _pal_gap.initialize();
 
@@ -428,6 +436,58 @@ ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEve
 
     _scan_timeout.detach();
 
+    flush_scan_reports();
+
+    return BLE_ERROR_NONE;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::setScanDuplicateFilter_(
+    millisecond_t window,
+    uint8_t rssiThreshold
+)
+{
+    for (size_t i = 0; i < MAX_SCAN_DUPLICATES; ++i) {
+        _scan_duplicates[i].in_use = false;
+    }
+
+    _scan_duplicate_window = window.valueInMs();
+    _scan_duplicate_rssi_threshold = rssiThreshold;
+
+    if (_scan_duplicate_window) {
+        _scan_duplicate_timer.start();
+    } else {
+        _scan_duplicate_timer.stop();
+        _scan_duplicate_timer.reset();
+    }
+
+    return BLE_ERROR_NONE;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::setScanReportBatching_(
+    mbed::Span<uint8_t> buffer,
+    millisecond_t interval
+)
+{
+    if (!buffer.empty() && !interval.value()) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    // deliver the reports stored in the previous buffer
+    _scan_report_ticker.detach();
+    flush_scan_reports();
+
+    _scan_report_buffer = buffer;
+    _scan_report_dropped = 0;
+
+    if (!buffer.empty()) {
+        _scan_report_ticker.attach_us(
+            mbed::callback(this, &GenericGap::on_scan_report_interval),
+            microsecond_t(interval).value()
+        );
+    }
+
     return BLE_ERROR_NONE;
 }
 
@@ -617,6 +677,55 @@ ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEve
     return _pal_gap.set_phy(connection, tx_phys, rx_phys, codedSymbol);
 }
 
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::negotiateThroughputProfile_(
+    connection_handle_t connection
+)
+{
+    bool allocated = false;
+    link_t *link = get_link(connection, false);
+    if (!link) {
+        link = get_link(connection, true);
+        allocated = true;
+    }
+
+    if (!link) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    if (link->step != THROUGHPUT_IDLE) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    link->status = BLE_ERROR_NONE;
+    link->tx_phy = phy_t::LE_1M;
+    link->rx_phy = phy_t::LE_1M;
+    link->connection_interval = 0;
+
+    // Longest packets: 251 octets take 2120us on the 1M PHY. The controller
+    // only reports a change of length, so the procedure doesn't wait for it.
+    if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_DATA_PACKET_LENGTH_EXTENSION)) {
+        _pal_gap.set_data_length(connection, 251, 2120);
+    }
+
+    ble_error_t err = BLE_ERROR_NONE;
+    if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_2M_PHY)) {
+        phy_set_t phys(phy_t::LE_2M);
+        err = _pal_gap.set_phy(connection, phys, phys, coded_symbol_per_bit_t::UNDEFINED);
+        if (!err) {
+            link->step = THROUGHPUT_PHY_UPDATE;
+        }
+    } else {
+        err = start_throughput_connection_update(*link);
+    }
+
+    if (err && allocated) {
+        link->in_use = false;
+    }
+
+    return err;
+}
+
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::on_read_phy_(
     pal::hci_error_code_t hci_status,
@@ -642,6 +751,11 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     uint16_t rx_size
 )
 {
+    link_t *link = get_link(connection_handle, true);
+    if (link) {
+        link->tx_octets = tx_size;
+    }
+
     if (_eventHandler) {
         _eventHandler->onDataLengthChange(connection_handle, tx_size, rx_size);
     }
@@ -663,6 +777,22 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     if (_eventHandler) {
         _eventHandler->onPhyUpdateComplete(status, connection_handle, tx_phy, rx_phy);
     }
+
+    link_t *link = get_link(connection_handle, false);
+    if (link && link->step == THROUGHPUT_PHY_UPDATE) {
+        if (status == BLE_ERROR_NONE) {
+            link->tx_phy = tx_phy.value();
+            link->rx_phy = rx_phy.value();
+        } else {
+            link->status = status;
+        }
+
+        ble_error_t err = start_throughput_connection_update(*link);
+        if (err) {
+            link->status = err;
+            complete_throughput_profile(*link);
+        }
+    }
 }
 
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
@@ -938,6 +1068,8 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
             )
         );
     } else {
+        flush_scan_reports();
+
         if (_eventHandler) {
             _eventHandler->onScanTimeout(ScanTimeoutEvent());
         }
@@ -953,6 +1085,8 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     set_random_address_rotation(false);
 #endif
 
+    flush_scan_reports();
+
     if (_eventHandler) {
         _eventHandler->onScanTimeout(ScanTimeoutEvent());
     }
@@ -1061,7 +1195,7 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
                     break;
             }
 
-            _eventHandler->onAdvertisingReport(
+            signal_advertising_report(
                 AdvertisingReportEvent(
                     advertising_event_t(event_type),
                     peer_address_type,
@@ -1214,6 +1348,12 @@ template <template<class> class PalGapImpl, class PalSecurityManager, class Conn
 void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::on_disconnection_complete(const pal::GapDisconnectionCompleteEvent &e)
 {
     if (e.status == pal::hci_error_code_t::SUCCESS) {
+        // a throughput negotiation in progress ends without report
+        link_t *link = get_link((connection_handle_t) e.connection_handle, false);
+        if (link) {
+            link->in_use = false;
+        }
+
         // signal internal stack
         if (_connection_event_handler) {
             _connection_event_handler->on_disconnected(
@@ -1269,6 +1409,12 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::on_connection_update(const pal::GapConnectionUpdateEvent &e)
 {
+    on_throughput_connection_update(
+        e.connection_handle,
+        e.status == pal::hci_error_code_t::SUCCESS,
+        e.connection_interval
+    );
+
     if (!_eventHandler) {
         return;
     }
@@ -1291,6 +1437,134 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     // has been updated.
 }
 
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+typename GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::link_t *
+GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::get_link(connection_handle_t connection, bool allocate)
+{
+    link_t *free_link = NULL;
+    for (size_t i = 0; i < MAX_LINKS; ++i) {
+        if (!_links[i].in_use) {
+            if (!free_link) {
+                free_link = &_links[i];
+            }
+        } else if (_links[i].connection == connection) {
+            return &_links[i];
+        }
+    }
+
+    if (!allocate || !free_link) {
+        return NULL;
+    }
+
+    // until the controller reports a change the default length is in use
+    free_link->in_use = true;
+    free_link->connection = connection;
+    free_link->step = THROUGHPUT_IDLE;
+    free_link->tx_octets = 27;
+    return free_link;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+ble_error_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::start_throughput_connection_update(link_t &link)
+{
+    // Short intervals give more connection events per second; the peer
+    // picks within 7.5ms and 30ms.
+    ble_error_t err = updateConnectionParameters_(
+        link.connection,
+        conn_interval_t(6),
+        conn_interval_t(24),
+        slave_latency_t(0),
+        supervision_timeout_t(200),
+        conn_event_length_t(0),
+        conn_event_length_t(0)
+    );
+
+    link.step = err ? THROUGHPUT_IDLE : THROUGHPUT_CONNECTION_UPDATE;
+    return err;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::on_throughput_connection_update(
+    connection_handle_t connection,
+    bool success,
+    uint16_t connection_interval
+)
+{
+    link_t *link = get_link(connection, false);
+    if (!link || link->step != THROUGHPUT_CONNECTION_UPDATE) {
+        return;
+    }
+
+    // on failure the event carries the parameters still in use
+    link->connection_interval = connection_interval;
+    if (!success) {
+        link->status = BLE_ERROR_UNSPECIFIED;
+    }
+
+    complete_throughput_profile(*link);
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::complete_throughput_profile(link_t &link)
+{
+    link.step = THROUGHPUT_IDLE;
+
+    if (!_eventHandler) {
+        return;
+    }
+
+    _eventHandler->onThroughputProfileNegotiated(
+        ThroughputProfileNegotiatedEvent(
+            link.status,
+            link.connection,
+            phy_t(link.tx_phy),
+            phy_t(link.rx_phy),
+            link.tx_octets,
+            conn_interval_t(link.connection_interval),
+            get_link_capacity(phy_t(link.tx_phy), link.tx_octets, link.connection_interval)
+        )
+    );
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+uint32_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::get_link_capacity(
+    phy_t phy,
+    uint16_t tx_octets,
+    uint16_t connection_interval
+)
+{
+    if (connection_interval == 0) {
+        return 0;
+    }
+
+    // Air time of a data packet and of the empty packet acknowledging it:
+    // preamble, access address, header and CRC around the payload.
+    uint32_t packet_us;
+    uint32_t empty_us;
+    switch (phy.value()) {
+        case phy_t::LE_2M:
+            packet_us = (2 + 4 + 2 + 3 + tx_octets) * 4;
+            empty_us = (2 + 4 + 2 + 3) * 4;
+            break;
+        case phy_t::LE_CODED:
+            // S=8: 400us of fixed fields then 64us per octet
+            packet_us = 400 + (2 + 3 + tx_octets) * 64;
+            empty_us = 400 + (2 + 3) * 64;
+            break;
+        default:
+            packet_us = (1 + 4 + 2 + 3 + tx_octets) * 8;
+            empty_us = (1 + 4 + 2 + 3) * 8;
+            break;
+    }
+
+    // each packet and acknowledgement is followed by the 150us inter frame space
+    uint32_t exchange_us = packet_us + 150 + empty_us + 150;
+    uint32_t interval_us = connection_interval * 1250;
+    uint64_t octets_per_event = (uint64_t)(interval_us / exchange_us) * tx_octets;
+
+    return (uint32_t)((octets_per_event * 1000000) / interval_us);
+}
+
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 pal::own_address_type_t GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::get_own_address_type(AddressUseType_t address_use_type)
 {
@@ -2226,7 +2500,7 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
         return;
     }
 
-    _eventHandler->onAdvertisingReport(
+    signal_advertising_report(
         AdvertisingReportEvent(
             event_type,
             address_type ?
@@ -2246,6 +2520,134 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     );
 }
 
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::signal_advertising_report(
+    const AdvertisingReportEvent &report
+)
+{
+    if (is_duplicate_advertising_report(report)) {
+        return;
+    }
+
+    if (_scan_report_buffer.empty()) {
+        _eventHandler->onAdvertisingReport(report);
+        return;
+    }
+
+    size_t record_size = AdvertisingReportBatchEvent::getRecordSize(report);
+
+    if (_scan_report_size + record_size > (size_t) _scan_report_buffer.size()) {
+        flush_scan_reports();
+    }
+
+    if (record_size > (size_t) _scan_report_buffer.size()) {
+        ++_scan_report_dropped;
+        return;
+    }
+
+    AdvertisingReportBatchEvent::writeRecord(
+        _scan_report_buffer.data() + _scan_report_size,
+        report
+    );
+    _scan_report_size += record_size;
+    ++_scan_report_count;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+bool GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::is_duplicate_advertising_report(
+    const AdvertisingReportEvent &report
+)
+{
+    if (!_scan_duplicate_window) {
+        return false;
+    }
+
+    // FNV-1a of the fields identifying the content of the report
+    uint8_t header[2 + address_t::size()];
+    header[0] = AdvertisingReportBatchEvent::getRawType(report.getType());
+    header[1] = report.getPeerAddressType().value();
+    memcpy(header + 2, report.getPeerAddress().data(), address_t::size());
+
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < sizeof(header); ++i) {
+        hash = (hash ^ header[i]) * 16777619U;
+    }
+    for (ptrdiff_t i = 0; i < report.getPayload().size(); ++i) {
+        hash = (hash ^ report.getPayload()[i]) * 16777619U;
+    }
+
+    uint32_t now = _scan_duplicate_timer.read_ms();
+    scan_duplicate_t *entry = NULL;
+    scan_duplicate_t *oldest = &_scan_duplicates[0];
+
+    for (size_t i = 0; i < MAX_SCAN_DUPLICATES; ++i) {
+        scan_duplicate_t &candidate = _scan_duplicates[i];
+        if (candidate.in_use && candidate.hash == hash) {
+            entry = &candidate;
+            break;
+        }
+        // a free entry or the least recently forwarded one is replaced
+        if (!oldest->in_use) {
+            continue;
+        }
+        if (!candidate.in_use || now - candidate.timestamp > now - oldest->timestamp) {
+            oldest = &candidate;
+        }
+    }
+
+    if (entry) {
+        if (now - entry->timestamp < _scan_duplicate_window) {
+            int rssi_delta = report.getRssi() - entry->rssi;
+            if (rssi_delta < 0) {
+                rssi_delta = -rssi_delta;
+            }
+            if (!_scan_duplicate_rssi_threshold || rssi_delta < _scan_duplicate_rssi_threshold) {
+                return true;
+            }
+        }
+    } else {
+        entry = oldest;
+    }
+
+    entry->in_use = true;
+    entry->hash = hash;
+    entry->rssi = report.getRssi();
+    entry->timestamp = now;
+
+    return false;
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::on_scan_report_interval()
+{
+    // ticker runs in interrupt context, deliver from the event queue
+    _event_queue.post(
+        mbed::callback(this, &GenericGap::flush_scan_reports)
+    );
+}
+
+template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
+void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::flush_scan_reports()
+{
+    if (!_scan_report_count && !_scan_report_dropped) {
+        return;
+    }
+
+    AdvertisingReportBatchEvent batch(
+        mbed::make_const_Span(_scan_report_buffer.data(), _scan_report_size),
+        _scan_report_count,
+        _scan_report_dropped
+    );
+
+    _scan_report_size = 0;
+    _scan_report_count = 0;
+    _scan_report_dropped = 0;
+
+    if (_eventHandler) {
+        _eventHandler->onAdvertisingReportBatch(batch);
+    }
+}
+
 template <template<class> class PalGapImpl, class PalSecurityManager, class ConnectionEventMonitorEventHandler>
 void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandler>::on_periodic_advertising_sync_established_(
     pal::hci_error_code_t error,
@@ -2366,6 +2768,12 @@ void GenericGap<PalGapImpl, PalSecurityManager, ConnectionEventMonitorEventHandl
     uint16_t supervision_timeout
 )
 {
+    on_throughput_connection_update(
+        connection_handle,
+        status == pal::hci_error_code_t::SUCCESS,
+        connection_interval
+    );
+
     if (!_eventHandler) {
         return;
     }
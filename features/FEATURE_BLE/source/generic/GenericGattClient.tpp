@@ -49,6 +49,7 @@ using ble::pal::AttFindInformationResponse;
 #define WRITE_HEADER_LENGTH 3
 #define CMAC_LENGTH 8
 #define MAC_COUNTER_LENGTH 4
+#define DATABASE_HASH_UUID 0x2B2A
 
 namespace ble {
 namespace generic {
@@ -117,6 +118,8 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		matching_service_uuid(matching_service_uuid),
 		matching_characteristic_uuid(matching_characteristic_uuid),
 		services_discovered(NULL),
+		database_record(NULL),
+		reading_database_hash(false),
 		done(false) {
 	}
 
@@ -126,6 +129,7 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			delete services_discovered;
 			services_discovered = tmp;
 		}
+		delete database_record;
 	}
 
 	virtual void handle_timeout_error(GenericGattClient* client) {
@@ -143,6 +147,19 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			return;
 		}
 
+		if (reading_database_hash) {
+			reading_database_hash = false;
+			if (message.opcode == AttributeOpcode::READ_BY_TYPE_RESPONSE) {
+				handle_database_hash(
+					client, static_cast<const AttReadByTypeResponse&>(message)
+				);
+			} else {
+				// the server has no usable hash, discover it in full
+				start_discovery(client, false);
+			}
+			return;
+		}
+
 		switch(message.opcode) {
 			case AttributeOpcode::READ_BY_GROUP_TYPE_RESPONSE:
 				handle_service_discovered(
@@ -185,6 +202,107 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		}
 	}
 
+	ble_error_t read_database_hash(GenericGattClient* client) {
+		reading_database_hash = true;
+		return client->_pal_client->read_using_characteristic_uuid(
+			connection_handle,
+			attribute_handle_range(0x0001, 0xFFFF),
+			UUID(DATABASE_HASH_UUID)
+		);
+	}
+
+	ble_error_t launch_discovery(GenericGattClient* client) {
+		if (matching_service_uuid == UUID()) {
+			return client->_pal_client->discover_primary_service(
+				connection_handle,
+				0x0001
+			);
+		} else {
+			return client->_pal_client->discover_primary_service_by_service_uuid(
+				connection_handle,
+				0x0001,
+				matching_service_uuid
+			);
+		}
+	}
+
+	void start_discovery(GenericGattClient* client, bool record) {
+		// only a discovery of all the services and their characteristics
+		// gives a complete picture of the server worth caching
+		if (record && characteristic_callback && matching_service_uuid == UUID()) {
+			database_record = new (std::nothrow) FileGattCacheDb::database_t();
+		}
+
+		if (launch_discovery(client)) {
+			terminate(client);
+		}
+	}
+
+	void handle_database_hash(GenericGattClient* client, const AttReadByTypeResponse& response) {
+		if (!client->_cache_db ||
+			response.size() != 1 ||
+			response[0].value.size() != (ptrdiff_t) database_hash_t::size()
+		) {
+			start_discovery(client, false);
+			return;
+		}
+
+		database_hash = database_hash_t(response[0].value.data(), database_hash_t::size());
+
+		FileGattCacheDb::database_t* database = new (std::nothrow) FileGattCacheDb::database_t();
+		if (database && client->_cache_db->load(database_hash, *database)) {
+			replay_database(client, *database);
+			delete database;
+			terminate(client);
+			return;
+		}
+
+		delete database;
+		start_discovery(client, true);
+	}
+
+	void replay_database(GenericGattClient* client, const FileGattCacheDb::database_t& database) {
+		for (size_t i = 0; i < database.service_count; ++i) {
+			const FileGattCacheDb::service_t& service = database.services[i];
+			UUID service_uuid = FileGattCacheDb::get_uuid(service.uuid);
+
+			if (matching_service_uuid != UUID() && matching_service_uuid != service_uuid) {
+				continue;
+			}
+
+			if (done) {
+				return;
+			}
+
+			if (service_callback) {
+				DiscoveredService discovered_service;
+				discovered_service.setup(service_uuid, service.begin, service.end);
+				service_callback(&discovered_service);
+			}
+
+			if (!characteristic_callback) {
+				continue;
+			}
+
+			for (size_t j = 0; j < database.characteristic_count; ++j) {
+				const FileGattCacheDb::characteristic_t& cached = database.characteristics[j];
+				if (cached.decl_handle < service.begin || cached.decl_handle > service.end) {
+					continue;
+				}
+
+				if (done) {
+					return;
+				}
+
+				characteristic_t characteristic(client, connection_handle, cached);
+				if (matching_characteristic_uuid == UUID()
+					|| matching_characteristic_uuid == characteristic.getUUID()) {
+					characteristic_callback(&characteristic);
+				}
+			}
+		}
+	}
+
 	template<typename Response>
 	void handle_service_discovered(GenericGattClient* client, const Response& response) {
 		if (!response.size()) {
@@ -213,6 +331,7 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 				}
 
 				insert_service(discovered_service);
+				record_service(start_handle, end_handle, uuid);
 			}
 		}
 
@@ -264,6 +383,7 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		for (size_t i = 0; i < response.size(); ++i) {
 			if (last_characteristic.is_valid() == false) {
 				last_characteristic.set_last_handle(response[i].handle - 1);
+				record_characteristic(last_characteristic);
 				if (matching_characteristic_uuid == UUID()
 				|| last_characteristic.getUUID() == matching_characteristic_uuid) {
 					characteristic_callback(&last_characteristic);
@@ -295,9 +415,10 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 
 	void handle_all_characteristics_discovered(GenericGattClient* client) {
 		if (last_characteristic.is_valid() == false) {
+			last_characteristic.set_last_handle(services_discovered->end);
+			record_characteristic(last_characteristic);
 			if (matching_characteristic_uuid == UUID()
 				|| matching_characteristic_uuid == last_characteristic.getUUID()) {
-				last_characteristic.set_last_handle(services_discovered->end);
 				characteristic_callback(&last_characteristic);
 			}
 		}
@@ -307,6 +428,9 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		delete old;
 
 		if (!services_discovered) {
+			if (database_record && client->_cache_db) {
+				client->_cache_db->store(database_hash, *database_record);
+			}
 			terminate(client);
 		} else {
 			start_characteristic_discovery(client);
@@ -378,6 +502,20 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			connHandle = connection_handle;
 		}
 
+		characteristic_t(
+			GattClient* client,
+			connection_handle_t connection_handle,
+			const FileGattCacheDb::characteristic_t& cached
+		) : DiscoveredCharacteristic() {
+			gattc = client;
+			uuid = FileGattCacheDb::get_uuid(cached.uuid);
+			props = get_properties(cached.properties);
+			declHandle = cached.decl_handle;
+			valueHandle = cached.value_handle;
+			lastHandle = cached.last_handle;
+			connHandle = connection_handle;
+		}
+
 		static UUID get_uuid(const Span<const uint8_t>& value) {
 			if (value.size() == 5) {
 				return UUID(value[3] | (value[4] << 8));
@@ -387,7 +525,10 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		}
 
 		static DiscoveredCharacteristic::Properties_t get_properties(const Span<const uint8_t>& value) {
-			uint8_t raw_properties = value[0];
+			return get_properties(value[0]);
+		}
+
+		static DiscoveredCharacteristic::Properties_t get_properties(uint8_t raw_properties) {
 			DiscoveredCharacteristic::Properties_t result;
 			result._broadcast = (raw_properties & (1 << 0)) ? true : false;
 			result._read = (raw_properties & (1 << 1)) ? true : false;
@@ -399,6 +540,16 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 			return result;
 		}
 
+		static uint8_t get_raw_properties(const DiscoveredCharacteristic::Properties_t& properties) {
+			return (properties.broadcast() ? (1 << 0) : 0) |
+				(properties.read() ? (1 << 1) : 0) |
+				(properties.writeWoResp() ? (1 << 2) : 0) |
+				(properties.write() ? (1 << 3) : 0) |
+				(properties.notify() ? (1 << 4) : 0) |
+				(properties.indicate() ? (1 << 5) : 0) |
+				(properties.authSignedWrite() ? (1 << 6) : 0);
+		}
+
 		static uint16_t get_value_handle(const Span<const uint8_t>& value) {
 			return value[1] | (value[2] << 8);
 		}
@@ -425,12 +576,55 @@ struct GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::DiscoveryC
 		current->next = service;
 	}
 
+	void record_service(uint16_t begin, uint16_t end, const UUID& uuid) {
+		if (!database_record) {
+			return;
+		}
+
+		if (database_record->service_count == FileGattCacheDb::MAX_SERVICES) {
+			// too large for the cache
+			delete database_record;
+			database_record = NULL;
+			return;
+		}
+
+		FileGattCacheDb::service_t& service =
+			database_record->services[database_record->service_count++];
+		service.begin = begin;
+		service.end = end;
+		FileGattCacheDb::set_uuid(service.uuid, uuid);
+	}
+
+	void record_characteristic(const characteristic_t& characteristic) {
+		if (!database_record) {
+			return;
+		}
+
+		if (database_record->characteristic_count == FileGattCacheDb::MAX_CHARACTERISTICS) {
+			// too large for the cache
+			delete database_record;
+			database_record = NULL;
+			return;
+		}
+
+		FileGattCacheDb::characteristic_t& cached =
+			database_record->characteristics[database_record->characteristic_count++];
+		cached.decl_handle = characteristic.getDeclHandle();
+		cached.value_handle = characteristic.getValueHandle();
+		cached.last_handle = characteristic.getLastHandle();
+		cached.properties = characteristic_t::get_raw_properties(characteristic.getProperties());
+		FileGattCacheDb::set_uuid(cached.uuid, characteristic.getUUID());
+	}
+
 	ServiceDiscovery::ServiceCallback_t service_callback;
 	ServiceDiscovery::CharacteristicCallback_t characteristic_callback;
 	UUID matching_service_uuid;
 	UUID matching_characteristic_uuid;
 	service_t* services_discovered;
 	characteristic_t last_characteristic;
+	FileGattCacheDb::database_t* database_record;
+	database_hash_t database_hash;
+	bool reading_database_hash;
 	bool done;
 };
 
@@ -959,6 +1153,7 @@ GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::GenericGattClient
 	_signing_event_handler(NULL),
 #endif
 	control_blocks(NULL),
+	_cache_db(NULL),
 	_is_reseting(false) {
 	_pal_client->when_server_message_received(
 		mbed::callback(this, &GenericGattClient::on_server_message_received)
@@ -1004,19 +1199,13 @@ ble_error_t GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::launc
 	// of the transaction and the callback can be call synchronously
 	insert_control_block(discovery_pcb);
 
-	// launch the request
+	// launch the request, with a cache the database hash decides if the
+	// server has to be discovered
 	ble_error_t err = BLE_ERROR_UNSPECIFIED;
-	if (matching_service_uuid == UUID()) {
-		err = _pal_client->discover_primary_service(
-			connection_handle,
-			0x0001
-		);
+	if (_cache_db) {
+		err = discovery_pcb->read_database_hash(this);
 	} else {
-		err = _pal_client->discover_primary_service_by_service_uuid(
-			connection_handle,
-			0x0001,
-			matching_service_uuid
-		);
+		err = discovery_pcb->launch_discovery(this);
 	}
 
 	if (err) {
@@ -1302,6 +1491,31 @@ ble_error_t GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::negot
     return _pal_client->exchange_mtu(connection);
 }
 
+template<template<class> class TPalGattClient, class SigningMonitorEventHandler>
+ble_error_t GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::enableDatabaseCache_(
+	const char *dbFilepath
+) {
+	delete _cache_db;
+	_cache_db = NULL;
+
+	if (!dbFilepath) {
+		return BLE_ERROR_NONE;
+	}
+
+	FILE* db_file = FileGattCacheDb::open_db_file(dbFilepath);
+	if (!db_file) {
+		return BLE_ERROR_INVALID_PARAM;
+	}
+
+	_cache_db = new (std::nothrow) FileGattCacheDb(db_file);
+	if (!_cache_db) {
+		fclose(db_file);
+		return BLE_ERROR_NO_MEM;
+	}
+
+	return BLE_ERROR_NONE;
+}
+
 template<template<class> class TPalGattClient, class SigningMonitorEventHandler>
 ble_error_t GenericGattClient<TPalGattClient, SigningMonitorEventHandler>::reset_(void) {
 
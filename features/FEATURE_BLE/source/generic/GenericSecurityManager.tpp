@@ -161,6 +161,10 @@ template<template<class> class TPalSecurityManager, template<class> class Signin
 ble_error_t GenericSecurityManager<TPalSecurityManager, SigningMonitor>::purgeAllBondingState_(void) {
     if (!_db) return BLE_ERROR_INITIALIZATION_INCOMPLETE;
     _db->clear_entries();
+#if BLE_FEATURE_PRIVACY
+    _pal.clear_resolving_list();
+    _resolving_list_size = 0;
+#endif // BLE_FEATURE_PRIVACY
     return BLE_ERROR_NONE;
 }
 
@@ -1177,13 +1181,51 @@ void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_security_en
 
     typedef advertising_peer_address_type_t address_type_t;
 #if BLE_FEATURE_PRIVACY
-    _pal.add_device_to_resolving_list(
+    uint8_t resolving_list_capacity = _pal.read_resolving_list_capacity();
+    if (!resolving_list_capacity) {
+        return;
+    }
+
+    /* once the list is full rebuild it from the database, dropping the bonds
+     * the database has since replaced */
+    if (_resolving_list_size >= resolving_list_capacity) {
+        init_resolving_list();
+        return;
+    }
+
+    ble_error_t err = _pal.add_device_to_resolving_list(
         identity->identity_address_is_public ?
             address_type_t::PUBLIC :
             address_type_t::RANDOM,
         identity->identity_address,
         identity->irk
     );
+    if (err == BLE_ERROR_NONE) {
+        _resolving_list_size++;
+    }
+#endif // BLE_FEATURE_PRIVACY
+}
+
+template<template<class> class TPalSecurityManager, template<class> class SigningMonitor>
+void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_security_entry_replaced(
+    SecurityDb::entry_handle_t entry,
+    const SecurityEntryIdentity_t* identity
+) {
+    if (!identity) {
+        return;
+    }
+
+    typedef advertising_peer_address_type_t address_type_t;
+#if BLE_FEATURE_PRIVACY
+    ble_error_t err = _pal.remove_device_from_resolving_list(
+        identity->identity_address_is_public ?
+            address_type_t::PUBLIC :
+            address_type_t::RANDOM,
+        identity->identity_address
+    );
+    if (err == BLE_ERROR_NONE && _resolving_list_size) {
+        _resolving_list_size--;
+    }
 #endif // BLE_FEATURE_PRIVACY
 }
 
@@ -1195,14 +1237,18 @@ void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_identity_li
     typedef advertising_peer_address_type_t address_type_t;
 
     _pal.clear_resolving_list();
+    _resolving_list_size = 0;
     for (size_t i = 0; i < count; ++i) {
-        _pal.add_device_to_resolving_list(
+        ble_error_t err = _pal.add_device_to_resolving_list(
             identity_list[i].identity_address_is_public ?
                 address_type_t::PUBLIC :
                 address_type_t::RANDOM,
             identity_list[i].identity_address,
             identity_list[i].irk
         );
+        if (err == BLE_ERROR_NONE) {
+            _resolving_list_size++;
+        }
     }
 
     delete [] identity_list.data();
@@ -1282,7 +1328,9 @@ template<template<class> class TPalSecurityManager, template<class> class Signin
 void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_pairing_completed_(connection_handle_t connection) {
     MBED_ASSERT(_db);
     ControlBlock_t *cb = get_control_block(connection);
-    if (cb) {
+    /* the resolving list only changes when the peer distributed its IRK */
+    if (cb && cb->identity_updated) {
+        cb->identity_updated = false;
         _db->get_entry_identity(
             mbed::callback(this, &GenericSecurityManager::on_security_entry_retrieved),
             cb->db_entry
@@ -1652,7 +1700,16 @@ void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_keys_distri
         return;
     }
 
+    /* the peer bonded before, its old identity leaves the resolving list */
+    if (flags->irk_stored) {
+        _db->get_entry_identity(
+            mbed::callback(this, &GenericSecurityManager::on_security_entry_replaced),
+            cb->db_entry
+        );
+    }
+
     _db->set_entry_peer_irk(cb->db_entry, irk);
+    cb->identity_updated = true;
 }
 
 template<template<class> class TPalSecurityManager, template<class> class SigningMonitor>
@@ -1746,7 +1803,8 @@ GenericSecurityManager<TPalSecurityManager, SigningMonitor>::ControlBlock_t::Con
     oob_mitm_protection(false),
     oob_present(false),
     legacy_pairing_oob_request_pending(false),
-    csrk_failures(0) { }
+    csrk_failures(0),
+    identity_updated(false) { }
 
 template<template<class> class TPalSecurityManager, template<class> class SigningMonitor>
 void GenericSecurityManager<TPalSecurityManager, SigningMonitor>::on_ltk_request_(connection_handle_t connection)
@@ -39,6 +39,9 @@ namespace ble {
         template<class Impl>
         class GattServer;
 
+        template<class Impl>
+        class L2capChannel;
+
     } // namespace interface
 
 
@@ -93,6 +96,8 @@ namespace ble {
 
             class GattServer;
 
+            class L2capChannel;
+
         } // cordio
     } // vendor
 } // ble
@@ -158,6 +163,13 @@ namespace ble {
             GattServerImpl
         > GattServer;
 
+        // L2CAP CONNECTION ORIENTED CHANNELS
+        typedef ble::vendor::cordio::L2capChannel L2capChannelImpl;
+
+        typedef ble::interface::L2capChannel<
+            L2capChannelImpl
+        > L2capChannel;
+
     } // impl
 } // ble
 
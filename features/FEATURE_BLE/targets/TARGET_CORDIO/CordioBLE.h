@@ -23,6 +23,7 @@
 
 #include "CordioHCIDriver.h"
 #include "CordioGattServer.h"
+#include "CordioL2capChannel.h"
 #include "CordioPalAttClient.h"
 #include "ble/pal/AttClientToGattClientAdapter.h"
 #include "ble/generic/GenericGattClient.h"
@@ -121,6 +122,13 @@ public:
     impl::PalGattClientImpl &getPalGattClient();
 #endif // BLE_FEATURE_GATT_CLIENT
 
+#if BLE_FEATURE_CONNECTABLE
+    /**
+     * @see BLEInstanceBase::getL2capChannel
+     */
+    virtual L2capChannel &getL2capChannel();
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_FEATURE_SECURITY
     /**
      * @see BLEInstanceBase::getSecurityManager
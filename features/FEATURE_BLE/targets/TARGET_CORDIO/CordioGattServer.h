@@ -32,6 +32,11 @@
 /*! client characteristic configuration descriptors settings */
 #define MAX_CCCD_CNT 20
 
+/*! Maximum count of updates queued per connection with queueUpdates */
+#ifndef MBED_CONF_CORDIO_MAX_QUEUED_UPDATES
+#define MBED_CONF_CORDIO_MAX_QUEUED_UPDATES 8
+#endif
+
 namespace ble {
 
 // fwd declaration of CordioAttClient and BLE
@@ -118,6 +123,25 @@ public:
         bool localOnly = false
     );
 
+    /**
+     * @see ::GattServer::queueUpdates
+     */
+    ble_error_t queueUpdates_(
+        connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const UpdatePayload *payloads,
+        size_t count,
+        size_t *queued
+    );
+
+    /**
+     * @see ::GattServer::getUpdateQueueStatistics
+     */
+    ble_error_t getUpdateQueueStatistics_(
+        connection_handle_t connectionHandle,
+        UpdateQueueStatistics *statistics
+    );
+
     /**
      * @see ::GattServer::areUpdatesEnabled
      */
@@ -238,6 +262,10 @@ private:
     bool get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_handle, uint8_t& idx) const;
     bool get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t& idx) const;
     bool is_update_authorized(connection_handle_t connection, GattAttribute::Handle_t value_handle);
+    void send_queued_update(dmConnId_t conn_id);
+    void complete_queued_update(dmConnId_t conn_id, ble_error_t status);
+    void on_update_confirmed(dmConnId_t conn_id, uint16_t handle, uint8_t status);
+    void clear_update_queue(dmConnId_t conn_id);
 
     struct alloc_block_t {
         alloc_block_t* next;
@@ -249,6 +277,25 @@ private:
         internal_service_t *next;
     };
 
+    struct queued_update_t {
+        GattAttribute::Handle_t handle;
+        UpdatePayload payload;
+    };
+
+    /* Updates of a connection; only the head one is handed to the stack at a
+     * time, the next one is sent when the stack confirms it. */
+    struct update_queue_t {
+        queued_update_t updates[MBED_CONF_CORDIO_MAX_QUEUED_UPDATES];
+        uint8_t head;
+        uint8_t count;
+        bool in_flight;
+        uint32_t sent;
+        uint32_t dropped;
+        uint32_t bytes_sent;
+        uint64_t busy_start_ms;
+        uint64_t busy_ms;
+    };
+
     impl::SigningEventHandler *_signing_event_handler;
 
     attsCccSet_t cccds[MAX_CCCD_CNT];
@@ -259,6 +306,8 @@ private:
     GattCharacteristic *_auth_char[MAX_CHARACTERISTIC_AUTHORIZATION_CNT];
     uint8_t _auth_char_count;
 
+    update_queue_t _update_queues[DM_CONN_MAX];
+
     struct {
         attsGroup_t service;
         attsAttr_t attributes[7];
@@ -0,0 +1,104 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CORDIO_L2CAP_CHANNEL_H_
+#define CORDIO_L2CAP_CHANNEL_H_
+
+#include "ble/blecommon.h"
+#include "ble/L2capChannel.h"
+#include "wsf_types.h"
+#include "cfg_stack.h"
+#include "l2c_api.h"
+
+namespace ble {
+namespace vendor {
+namespace cordio {
+
+class BLE;
+
+/**
+ * Cordio implementation of ::L2capChannel
+ */
+class L2capChannel : public ::ble::interface::L2capChannel<L2capChannel>
+{
+    friend ble::vendor::cordio::BLE;
+
+    typedef ::ble::interface::L2capChannel<L2capChannel> Base;
+
+public:
+    /**
+     * Return the singleton of the Cordio implementation of ::L2capChannel.
+     */
+    static L2capChannel &getInstance();
+
+    /**
+     * @see ::L2capChannel::registerChannel
+     */
+    ble_error_t registerChannel_(
+        l2cap_registration_t &registration,
+        const L2capChannelParameters &parameters
+    );
+
+    /**
+     * @see ::L2capChannel::unregisterChannel
+     */
+    ble_error_t unregisterChannel_(l2cap_registration_t registration);
+
+    /**
+     * @see ::L2capChannel::connect
+     */
+    ble_error_t connect_(
+        connection_handle_t connectionHandle,
+        l2cap_registration_t registration,
+        uint16_t psm,
+        l2cap_channel_id_t &channel
+    );
+
+    /**
+     * @see ::L2capChannel::disconnect
+     */
+    ble_error_t disconnect_(l2cap_channel_id_t channel);
+
+    /**
+     * @see ::L2capChannel::write
+     */
+    ble_error_t write_(l2cap_channel_id_t channel, mbed::Span<const uint8_t> sdu);
+
+    /**
+     * @see ::L2capChannel::reset
+     */
+    ble_error_t reset_(void);
+
+private:
+    static void coc_cb(l2cCocEvt_t *evt);
+
+    bool is_registered(l2cap_registration_t registration) const;
+
+private:
+    L2capChannel();
+
+    L2capChannel(const L2capChannel &);
+    const L2capChannel& operator=(const L2capChannel &);
+
+    l2cCocRegId_t _registrations[L2C_COC_REG_MAX];
+};
+
+} // namespace cordio
+} // namespace vendor
+} // namespace ble
+
+#endif /* CORDIO_L2CAP_CHANNEL_H_ */
@@ -371,6 +371,8 @@ private:
 
     PrivacyControlBlock* _pending_privacy_control_blocks;
     bool _processing_privacy_control_block;
+    // Set when clearing the resolving list turns address resolution off in the stack
+    bool _restore_address_resolution;
     irk_t _irk;
     csrk_t _csrk;
     csrk_t* _peer_csrks[DM_CONN_MAX];
@@ -0,0 +1,217 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if DEVICE_SERIAL && DEVICE_SERIAL_FC && DEVICE_SERIAL_ASYNCH
+
+#include <string.h>
+#include <algorithm>
+#include "H4DMATransportDriver.h"
+#include "hci_defs.h"
+
+namespace ble {
+namespace vendor {
+namespace cordio {
+
+H4DMATransportDriver::H4DMATransportDriver(PinName tx, PinName rx, PinName cts, PinName rts, int baud) :
+    SerialBase(tx, rx, baud),
+    cts(cts),
+    rts(rts),
+    rx_index(0),
+    rx_state(RX_TYPE),
+    rx_header_length(0),
+    rx_remaining(0),
+    tx_head(0),
+    tx_tail(0),
+    tx_count(0),
+    tx_in_flight(0) { }
+
+void H4DMATransportDriver::initialize()
+{
+    format(
+        /* bits */ 8,
+        /* parity */ SerialBase::None,
+        /* stop bit */ 1
+    );
+
+    set_flow_control(
+        /* flow */ SerialBase::RTSCTS,
+        /* rts */ rts,
+        /* cts */ cts
+    );
+
+    set_dma_usage_tx(DMA_USAGE_ALWAYS);
+    set_dma_usage_rx(DMA_USAGE_ALWAYS);
+
+    restart_rx();
+}
+
+void H4DMATransportDriver::terminate()
+{
+    abort_read();
+    abort_write();
+
+    tx_head = 0;
+    tx_tail = 0;
+    tx_count = 0;
+    tx_in_flight = 0;
+}
+
+uint16_t H4DMATransportDriver::write(uint8_t type, uint16_t len, uint8_t *pData)
+{
+    uint16_t total = len + 1;
+
+    MBED_ASSERT(total <= TX_BUFFER_SIZE);
+    if (total > TX_BUFFER_SIZE) {
+        return 0;
+    }
+
+    // wait for the DMA to release enough room in the ring
+    while ((uint16_t)(TX_BUFFER_SIZE - tx_count) < total);
+
+    // Only the free part of the ring is written, the DMA reads from tx_tail.
+    tx_buffer[tx_head] = type;
+    tx_head = (tx_head + 1) % TX_BUFFER_SIZE;
+
+    uint16_t first_chunk = std::min(len, (uint16_t)(TX_BUFFER_SIZE - tx_head));
+    memcpy(tx_buffer + tx_head, pData, first_chunk);
+    memcpy(tx_buffer, pData + first_chunk, len - first_chunk);
+    tx_head = (tx_head + len) % TX_BUFFER_SIZE;
+
+    core_util_critical_section_enter();
+    tx_count += total;
+    if (!tx_in_flight) {
+        start_tx();
+    }
+    core_util_critical_section_exit();
+
+    return len;
+}
+
+void H4DMATransportDriver::start_tx()
+{
+    // a transfer cannot wrap around the end of the ring, the rest is sent
+    // once it completes
+    tx_in_flight = std::min((uint16_t) tx_count, (uint16_t)(TX_BUFFER_SIZE - tx_tail));
+    SerialBase::write(
+        tx_buffer + tx_tail,
+        tx_in_flight,
+        mbed::callback(this, &H4DMATransportDriver::on_tx_event),
+        SERIAL_EVENT_TX_COMPLETE
+    );
+}
+
+void H4DMATransportDriver::on_tx_event(int event)
+{
+    tx_tail = (tx_tail + tx_in_flight) % TX_BUFFER_SIZE;
+    tx_count -= tx_in_flight;
+    tx_in_flight = 0;
+
+    if (tx_count) {
+        start_tx();
+    }
+}
+
+void H4DMATransportDriver::start_rx(uint8_t *buffer, uint16_t length)
+{
+    SerialBase::read(
+        buffer,
+        length,
+        mbed::callback(this, &H4DMATransportDriver::on_rx_event),
+        SERIAL_EVENT_RX_ALL
+    );
+}
+
+void H4DMATransportDriver::restart_rx()
+{
+    rx_state = RX_TYPE;
+    start_rx(rx_buffers[rx_index], 1);
+}
+
+void H4DMATransportDriver::on_rx_event(int event)
+{
+    uint8_t *packet = rx_buffers[rx_index];
+
+    if (event != SERIAL_EVENT_RX_COMPLETE) {
+        // overrun, framing or parity error: the packet is lost, resynchronize
+        // on the next packet type
+        restart_rx();
+        return;
+    }
+
+    switch (rx_state) {
+        case RX_TYPE:
+            if (packet[0] == HCI_EVT_TYPE) {
+                rx_header_length = HCI_EVT_HDR_LEN;
+            } else if (packet[0] == HCI_ACL_TYPE) {
+                rx_header_length = HCI_ACL_HDR_LEN;
+            } else {
+                restart_rx();
+                return;
+            }
+            rx_state = RX_HEADER;
+            start_rx(packet + 1, rx_header_length);
+            return;
+
+        case RX_HEADER:
+            if (packet[0] == HCI_EVT_TYPE) {
+                rx_remaining = packet[2];
+            } else {
+                rx_remaining = packet[3] | (packet[4] << 8);
+            }
+
+            if (rx_remaining == 0) {
+                break;
+            }
+
+            if (1 + rx_header_length + rx_remaining > RX_BUFFER_SIZE) {
+                // too large for the stack, drain it from the line
+                rx_state = RX_DISCARD;
+                start_rx(packet + 1, std::min(rx_remaining, (uint16_t)(RX_BUFFER_SIZE - 1)));
+                return;
+            }
+
+            rx_state = RX_PAYLOAD;
+            start_rx(packet + 1 + rx_header_length, rx_remaining);
+            return;
+
+        case RX_PAYLOAD:
+            break;
+
+        case RX_DISCARD:
+            rx_remaining -= std::min(rx_remaining, (uint16_t)(RX_BUFFER_SIZE - 1));
+            if (rx_remaining) {
+                start_rx(packet + 1, std::min(rx_remaining, (uint16_t)(RX_BUFFER_SIZE - 1)));
+            } else {
+                restart_rx();
+            }
+            return;
+    }
+
+    // the next packet is received in the other buffer while this one is
+    // processed by the stack
+    uint16_t length = 1 + rx_header_length + (rx_state == RX_PAYLOAD ? rx_remaining : 0);
+    rx_index ^= 1;
+    restart_rx();
+
+    on_data_received(packet, length);
+}
+
+} // namespace cordio
+} // namespace vendor
+} // namespace ble
+
+#endif
@@ -0,0 +1,125 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CORDIO_H4_DMA_TRANSPORT_DRIVER_H_
+#define CORDIO_H4_DMA_TRANSPORT_DRIVER_H_
+
+#if (DEVICE_SERIAL && DEVICE_SERIAL_FC && DEVICE_SERIAL_ASYNCH) || defined(DOXYGEN_ONLY)
+
+#include <stdint.h>
+#include "mbed.h"
+#include "CordioHCITransportDriver.h"
+
+namespace ble {
+namespace vendor {
+namespace cordio {
+
+/**
+ * H4 transport driver moving packets with the asynchronous serial API.
+ *
+ * It is a drop-in replacement for H4TransportDriver on targets supporting
+ * asynchronous serial transfers. The transfers use DMA if the target has it,
+ * which removes the per byte interrupts of H4TransportDriver:
+ *   - Packets written by the stack are copied in a ring buffer drained by the
+ *   DMA; write() only waits if the ring is full.
+ *   - Incoming packets are read in three transfers: the packet type, the
+ *   header, then the payload whose length is given by the header. Complete
+ *   packets are passed to the stack at once from a pair of buffers: the
+ *   next packet is received while the previous one is processed.
+ *
+ * The size of the ring buffer is set by cordio.hci-dma-tx-buffer-size.
+ */
+class H4DMATransportDriver : public CordioHCITransportDriver, private mbed::SerialBase {
+public:
+    /**
+     * Initialize the transport driver.
+     *
+     * @param tx tx pin name.
+     * @param rx rx pin name
+     * @param cts cts pin name
+     * @param rts rts pin name.
+     * @param baud baud use to communicate with the ble module
+     */
+    H4DMATransportDriver(PinName tx, PinName rx, PinName cts, PinName rts, int baud);
+
+    /**
+     * Destructor
+     */
+    virtual ~H4DMATransportDriver() { }
+
+    /**
+     * @see CordioHCITransportDriver::initialize
+     */
+    virtual void initialize();
+
+    /**
+     * @see CordioHCITransportDriver::terminate
+     */
+    virtual void terminate();
+
+    /**
+     * @see CordioHCITransportDriver::write
+     */
+    virtual uint16_t write(uint8_t type, uint16_t len, uint8_t *pData);
+
+private:
+    enum rx_state_t {
+        RX_TYPE,
+        RX_HEADER,
+        RX_PAYLOAD,
+        RX_DISCARD
+    };
+
+    // largest packet received: an event with a 255 bytes payload, it also
+    // holds an LE ACL packet with the maximum data length (251 bytes)
+    static const uint16_t RX_BUFFER_SIZE = 1 + 2 + 255;
+
+    static const uint16_t TX_BUFFER_SIZE = MBED_CONF_CORDIO_HCI_DMA_TX_BUFFER_SIZE;
+
+    void start_rx(uint8_t *buffer, uint16_t length);
+
+    void restart_rx();
+
+    void on_rx_event(int event);
+
+    void start_tx();
+
+    void on_tx_event(int event);
+
+    PinName cts;
+    PinName rts;
+
+    uint8_t rx_buffers[2][RX_BUFFER_SIZE];
+    uint8_t rx_index;
+    rx_state_t rx_state;
+    uint8_t rx_header_length;
+    uint16_t rx_remaining;
+
+    uint8_t tx_buffer[TX_BUFFER_SIZE];
+    uint16_t tx_head;
+    volatile uint16_t tx_tail;
+    volatile uint16_t tx_count;
+    volatile uint16_t tx_in_flight;
+};
+
+} // namespace cordio
+} // namespace vendor
+} // namespace ble
+
+#endif
+
+#endif /* CORDIO_H4_DMA_TRANSPORT_DRIVER_H_ */
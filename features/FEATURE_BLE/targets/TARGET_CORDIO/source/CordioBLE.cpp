@@ -167,6 +167,10 @@ ble_error_t BLE::shutdown()
     getGattClient().reset();
 #endif // BLE_FEATURE_GATT_CLIENT
 
+#if BLE_FEATURE_CONNECTABLE
+    getL2capChannel().reset();
+#endif // BLE_FEATURE_CONNECTABLE
+
     getGap().reset();
     _event_queue.clear();
 
@@ -228,6 +232,13 @@ impl::PalGattClientImpl& BLE::getPalGattClient()
 }
 #endif // BLE_FEATURE_GATT_CLIENT
 
+#if BLE_FEATURE_CONNECTABLE
+L2capChannel& BLE::getL2capChannel()
+{
+    return cordio::L2capChannel::getInstance();
+}
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_FEATURE_SECURITY
 SecurityManager& BLE::getSecurityManager()
 {
@@ -354,6 +365,10 @@ void BLE::device_manager_cb(dmEvt_t* dm_event)
         case DM_CONN_CLOSE_IND:
             /* clear CCC table on connection close */
             AttsCccClearTable(connId);
+#if BLE_FEATURE_GATT_SERVER
+            /* return queued updates to the application */
+            cordio::GattServer::getInstance().clear_update_queue(connId);
+#endif // BLE_FEATURE_GATT_SERVER
             break;
         default:
             break;
@@ -454,6 +469,10 @@ void BLE::stack_setup()
 
 #if BLE_FEATURE_CONNECTABLE
     L2cInit();
+
+    handlerId = WsfOsSetNextHandler(L2cCocHandler);
+    L2cCocHandlerInit(handlerId);
+    L2cCocInit();
 #endif
 
 #if BLE_ROLE_PERIPHERAL
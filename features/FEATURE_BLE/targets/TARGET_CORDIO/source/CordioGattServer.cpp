@@ -20,6 +20,7 @@
 #include "CordioGattServer.h"
 #include "source/GattServer.tpp"
 #include "mbed.h"
+#include "rtos/Kernel.h"
 #include "wsf_types.h"
 #include "att_api.h"
 
@@ -748,6 +749,72 @@ ble_error_t GattServer::write_(
     return BLE_ERROR_NONE;
 }
 
+ble_error_t GattServer::queueUpdates_(
+    connection_handle_t connection,
+    GattAttribute::Handle_t att_handle,
+    const UpdatePayload *payloads,
+    size_t count,
+    size_t *queued
+) {
+    *queued = 0;
+
+    if (connection == DM_CONN_ID_NONE || connection > DM_CONN_MAX ||
+        DmConnInUse(connection) == false) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t cccd_index;
+    if (!get_cccd_index_by_value_handle(att_handle, cccd_index)) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    if (!(AttsCccEnabled(connection, cccd_index) & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) ||
+        !is_update_authorized(connection, att_handle)) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    update_queue_t &queue = _update_queues[connection - 1];
+    if (queue.count == 0 && count) {
+        queue.busy_start_ms = rtos::Kernel::get_ms_count();
+    }
+
+    while (*queued < count && queue.count < MBED_CONF_CORDIO_MAX_QUEUED_UPDATES) {
+        queued_update_t &update =
+            queue.updates[(queue.head + queue.count) % MBED_CONF_CORDIO_MAX_QUEUED_UPDATES];
+        update.handle = att_handle;
+        update.payload = payloads[*queued];
+        queue.count++;
+        (*queued)++;
+    }
+
+    send_queued_update(connection);
+
+    return *queued ? BLE_ERROR_NONE : BLE_ERROR_NO_MEM;
+}
+
+ble_error_t GattServer::getUpdateQueueStatistics_(
+    connection_handle_t connection,
+    UpdateQueueStatistics *statistics
+) {
+    if (connection == DM_CONN_ID_NONE || connection > DM_CONN_MAX) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    const update_queue_t &queue = _update_queues[connection - 1];
+    uint64_t busy_ms = queue.busy_ms;
+    if (queue.count) {
+        busy_ms += rtos::Kernel::get_ms_count() - queue.busy_start_ms;
+    }
+
+    statistics->pending = queue.count;
+    statistics->sent = queue.sent;
+    statistics->dropped = queue.dropped;
+    statistics->bytesSent = queue.bytes_sent;
+    statistics->throughput = busy_ms ? (uint64_t) queue.bytes_sent * 1000 / busy_ms : 0;
+
+    return BLE_ERROR_NONE;
+}
+
 ble_error_t GattServer::areUpdatesEnabled_(
     const GattCharacteristic &characteristic,
     bool *enabled
@@ -889,6 +956,9 @@ ble_error_t GattServer::reset_(void)
 
     _auth_char_count = 0;
 
+    // queued payloads belong to the application being shut down
+    memset(_update_queues, 0, sizeof(_update_queues));
+
     AttsCccRegister(cccd_cnt, (attsCccSet_t*)cccds, cccd_cb);
 
     return BLE_ERROR_NONE;
@@ -911,9 +981,102 @@ void GattServer::att_cb(const attEvt_t *evt)
         if (handler) {
             handler->onAttMtuChange(evt->hdr.param, evt->mtu);
         }
-    } else if (evt->hdr.status == ATT_SUCCESS && evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
-        getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+    } else if (evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
+        if (evt->hdr.status == ATT_SUCCESS) {
+            getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+        }
+        getInstance().on_update_confirmed(evt->hdr.param, evt->handle, evt->hdr.status);
+    }
+}
+
+void GattServer::send_queued_update(dmConnId_t conn_id)
+{
+    update_queue_t &queue = _update_queues[conn_id - 1];
+
+    while (queue.count && !queue.in_flight) {
+        const queued_update_t &update = queue.updates[queue.head];
+
+        // The client may have unsubscribed since the update was queued
+        uint8_t cccd_index;
+        uint16_t cccd_config = 0;
+        if (get_cccd_index_by_value_handle(update.handle, cccd_index)) {
+            cccd_config = AttsCccEnabled(conn_id, cccd_index);
+        }
+
+        if (!(cccd_config & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE))) {
+            complete_queued_update(conn_id, BLE_ERROR_INVALID_STATE);
+            continue;
+        }
+
+        // The stack may confirm a failure before returning
+        queue.in_flight = true;
+        if (cccd_config & ATT_CLIENT_CFG_NOTIFY) {
+            AttsHandleValueNtf(conn_id, update.handle, update.payload.size, (uint8_t*)update.payload.value);
+        } else {
+            AttsHandleValueInd(conn_id, update.handle, update.payload.size, (uint8_t*)update.payload.value);
+        }
+    }
+}
+
+void GattServer::complete_queued_update(dmConnId_t conn_id, ble_error_t status)
+{
+    update_queue_t &queue = _update_queues[conn_id - 1];
+    queued_update_t update = queue.updates[queue.head];
+
+    queue.head = (queue.head + 1) % MBED_CONF_CORDIO_MAX_QUEUED_UPDATES;
+    queue.count--;
+    queue.in_flight = false;
+
+    if (status == BLE_ERROR_NONE) {
+        queue.sent++;
+        queue.bytes_sent += update.payload.size;
+    } else {
+        queue.dropped++;
+    }
+
+    if (queue.count == 0) {
+        queue.busy_ms += rtos::Kernel::get_ms_count() - queue.busy_start_ms;
+    }
+
+    if (eventHandler) {
+        eventHandler->onQueuedUpdateSent(conn_id, update.handle, update.payload.value, status);
+    }
+}
+
+void GattServer::on_update_confirmed(dmConnId_t conn_id, uint16_t handle, uint8_t status)
+{
+    if (conn_id == DM_CONN_ID_NONE || conn_id > DM_CONN_MAX) {
+        return;
+    }
+
+    update_queue_t &queue = _update_queues[conn_id - 1];
+    if (queue.count == 0) {
+        return;
+    }
+
+    if (queue.in_flight && queue.updates[queue.head].handle == handle) {
+        if (status == ATT_ERR_OVERFLOW) {
+            // A notification of this handle sent with write() was still
+            // pending in the stack; try again when that one is confirmed.
+            queue.in_flight = false;
+            return;
+        }
+        complete_queued_update(
+            conn_id,
+            status == ATT_SUCCESS ? BLE_ERROR_NONE : BLE_ERROR_UNSPECIFIED
+        );
+    }
+
+    send_queued_update(conn_id);
+}
+
+void GattServer::clear_update_queue(dmConnId_t conn_id)
+{
+    update_queue_t &queue = _update_queues[conn_id - 1];
+    while (queue.count) {
+        complete_queued_update(conn_id, BLE_ERROR_INVALID_STATE);
     }
+    queue.in_flight = false;
 }
 
 uint8_t GattServer::atts_read_cb(
@@ -1347,6 +1510,7 @@ GattServer::GattServer() :
     cccd_cnt(0),
     _auth_char(),
     _auth_char_count(0),
+    _update_queues(),
     generic_access_service(),
     generic_attribute_service(),
     registered_service(NULL),
@@ -0,0 +1,260 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CordioL2capChannel.h"
+#include "source/L2capChannel.tpp"
+#include "dm_api.h"
+
+template class ble::interface::L2capChannel<ble::vendor::cordio::L2capChannel>;
+
+namespace ble {
+namespace vendor {
+namespace cordio {
+
+namespace {
+
+static const uint16_t MAX_MPS = 65533;
+
+uint8_t to_security_level(link_encryption_t security)
+{
+    switch (security.value()) {
+        case link_encryption_t::ENCRYPTED:
+            return DM_SEC_LEVEL_ENC;
+        case link_encryption_t::ENCRYPTED_WITH_MITM:
+            return DM_SEC_LEVEL_ENC_AUTH;
+        case link_encryption_t::ENCRYPTED_WITH_SC_AND_MITM:
+            return DM_SEC_LEVEL_ENC_LESC;
+        default:
+            return DM_SEC_LEVEL_NONE;
+    }
+}
+
+} // end of anonymous namespace
+
+L2capChannel &L2capChannel::getInstance()
+{
+    static L2capChannel m_instance;
+    return m_instance;
+}
+
+L2capChannel::L2capChannel() : Base()
+{
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        _registrations[i] = L2C_COC_REG_ID_NONE;
+    }
+}
+
+ble_error_t L2capChannel::registerChannel_(
+    l2cap_registration_t &registration,
+    const L2capChannelParameters &parameters
+)
+{
+    if (parameters.getMtu() < L2capChannelParameters::MIN_MTU ||
+        parameters.getMps() < L2capChannelParameters::MIN_MPS ||
+        parameters.getMps() > MAX_MPS ||
+        parameters.getCredits() == 0) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    l2cCocRegId_t *slot = NULL;
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        if (_registrations[i] == L2C_COC_REG_ID_NONE) {
+            slot = &_registrations[i];
+            break;
+        }
+    }
+
+    if (!slot) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    l2cCocReg_t reg;
+    reg.psm = parameters.getPsm();
+    reg.mps = parameters.getMps();
+    reg.mtu = parameters.getMtu();
+    reg.credits = parameters.getCredits();
+    reg.authoriz = FALSE;
+    reg.secLevel = to_security_level(parameters.getSecurity());
+    reg.role = L2C_COC_ROLE_INITIATOR;
+    if (parameters.getPsm()) {
+        reg.role |= L2C_COC_ROLE_ACCEPTOR;
+    }
+
+    l2cCocRegId_t reg_id = L2cCocRegister(coc_cb, &reg);
+    if (reg_id == L2C_COC_REG_ID_NONE) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    *slot = reg_id;
+    registration = reg_id;
+
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2capChannel::unregisterChannel_(l2cap_registration_t registration)
+{
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        if (registration != L2C_COC_REG_ID_NONE && _registrations[i] == registration) {
+            L2cCocDeregister(registration);
+            _registrations[i] = L2C_COC_REG_ID_NONE;
+            return BLE_ERROR_NONE;
+        }
+    }
+
+    return BLE_ERROR_INVALID_PARAM;
+}
+
+ble_error_t L2capChannel::connect_(
+    connection_handle_t connectionHandle,
+    l2cap_registration_t registration,
+    uint16_t psm,
+    l2cap_channel_id_t &channel
+)
+{
+    if (!is_registered(registration) || psm == 0) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    uint16_t cid = L2cCocConnectReq(connectionHandle, registration, psm);
+    if (cid == L2C_COC_CID_NONE) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    channel = cid;
+
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2capChannel::disconnect_(l2cap_channel_id_t channel)
+{
+    if (channel == L2C_COC_CID_NONE) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    L2cCocDisconnectReq(channel);
+
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2capChannel::write_(
+    l2cap_channel_id_t channel,
+    mbed::Span<const uint8_t> sdu
+)
+{
+    if (channel == L2C_COC_CID_NONE || sdu.empty() || sdu.size() > 0xFFFF) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    // The stack copies the SDU in its packet buffer before it returns, it
+    // does not modify the payload.
+    L2cCocDataReq(channel, sdu.size(), const_cast<uint8_t*>(sdu.data()));
+
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t L2capChannel::reset_(void)
+{
+    Base::reset_();
+
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        if (_registrations[i] != L2C_COC_REG_ID_NONE) {
+            L2cCocDeregister(_registrations[i]);
+            _registrations[i] = L2C_COC_REG_ID_NONE;
+        }
+    }
+
+    return BLE_ERROR_NONE;
+}
+
+void L2capChannel::coc_cb(l2cCocEvt_t *evt)
+{
+    EventHandler *handler = getInstance().eventHandler;
+    if (!handler) {
+        return;
+    }
+
+    connection_handle_t connection = evt->hdr.param;
+
+    switch (evt->hdr.event) {
+        case L2C_COC_CONNECT_IND:
+            handler->onChannelConnected(
+                L2capChannelConnectedEvent(
+                    connection,
+                    evt->connectInd.cid,
+                    evt->connectInd.psm,
+                    evt->connectInd.peerMtu
+                )
+            );
+            break;
+
+        case L2C_COC_DISCONNECT_IND:
+            handler->onChannelDisconnected(
+                L2capChannelDisconnectedEvent(
+                    connection,
+                    evt->disconnectInd.cid,
+                    evt->disconnectInd.result
+                )
+            );
+            break;
+
+        case L2C_COC_DATA_IND:
+            handler->onDataReceived(
+                L2capDataReceivedEvent(
+                    connection,
+                    evt->dataInd.cid,
+                    mbed::make_const_Span(evt->dataInd.pData, evt->dataInd.dataLen)
+                )
+            );
+            break;
+
+        case L2C_COC_DATA_CNF: {
+            ble_error_t status = BLE_ERROR_NONE;
+            if (evt->hdr.status == L2C_COC_DATA_ERR_MEMORY) {
+                status = BLE_ERROR_NO_MEM;
+            } else if (evt->hdr.status == L2C_COC_DATA_ERR_OVERFLOW) {
+                status = BLE_ERROR_OPERATION_NOT_PERMITTED;
+            }
+
+            handler->onDataSent(
+                L2capDataSentEvent(connection, evt->dataCnf.cid, status)
+            );
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+bool L2capChannel::is_registered(l2cap_registration_t registration) const
+{
+    if (registration == L2C_COC_REG_ID_NONE) {
+        return false;
+    }
+
+    for (size_t i = 0; i < L2C_COC_REG_MAX; ++i) {
+        if (_registrations[i] == registration) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // cordio
+} // vendor
+} // ble
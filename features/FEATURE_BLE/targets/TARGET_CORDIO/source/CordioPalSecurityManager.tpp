@@ -38,6 +38,7 @@ CordioSecurityManager<EventHandler>::CordioSecurityManager() :
     _public_key_x(),
     _pending_privacy_control_blocks(NULL),
     _processing_privacy_control_block(false),
+    _restore_address_resolution(false),
     _peer_csrks()
 {
 }
@@ -947,6 +948,12 @@ void CordioSecurityManager<EventHandler>::queue_clear_resolving_list() {
     // Remove any pending control blocks, there's no point executing them as we're about to queue the list
     clear_privacy_control_blocks();
 
+    // The stack disables address resolution once the list is cleared, it is
+    // turned back on when the queue has been processed
+    if (DmLlPrivEnabled()) {
+        _restore_address_resolution = true;
+    }
+
     PrivacyClearResListControlBlock* cb =
         new (std::nothrow) PrivacyClearResListControlBlock();
     if( cb == NULL )
@@ -999,6 +1006,10 @@ void CordioSecurityManager<EventHandler>::process_privacy_control_blocks(bool cb
     if(cb == NULL) {
         // All control blocks processed
         _processing_privacy_control_block = false;
+        if (_restore_address_resolution) {
+            _restore_address_resolution = false;
+            DmPrivSetAddrResEnable(true);
+        }
         return;
     }
 
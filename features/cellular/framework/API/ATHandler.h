@@ -50,6 +50,16 @@ extern const char *CRLF;
 
 #define BUFF_SIZE 32
 
+// Size of the buffer receiving data from the modem, it should fit any prefix and int
+#ifndef MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE 256
+#endif
+
+// Longest command line at_cmd_batch() writes when concatenating commands, longer batches are split
+#ifndef MBED_CONF_CELLULAR_AT_BATCH_LINE_LENGTH
+#define MBED_CONF_CELLULAR_AT_BATCH_LINE_LENGTH 128
+#endif
+
 /* AT Error types enumeration */
 enum DeviceErrorType {
     DeviceErrorTypeNoError = 0,
@@ -86,6 +96,13 @@ public:
      */
     FileHandle *get_file_handle();
 
+    /** Set the file handle used for AT commands, for example a multiplexer channel. The previous file handle is
+     *  released and any data buffered from it is discarded.
+     *
+     *  @param fh   file handle to use
+     */
+    void set_file_handle(FileHandle *fh);
+
     /** Locks the mutex for file handle if AT_HANDLER_MUTEX is defined.
      */
     void lock();
@@ -107,6 +124,13 @@ public:
      */
     void set_urc_handler(const char *prefix, Callback<void()> callback);
 
+    /** Get how many times a URC has been matched, for diagnostics.
+     *
+     *  @param prefix   URC text given to set_urc_handler()
+     *  @return number of times the URC handler was called, 0 if no handler is set for prefix
+     */
+    uint32_t get_urc_hit_count(const char *prefix);
+
     /** returns the last error while parsing AT responses.
      *
      *  @return last error
@@ -221,6 +245,33 @@ public:
      */
     nsapi_error_t at_cmd_discard(const char *cmd, const char *cmd_chr, const char *format = "", ...);
 
+    /** A command of a batch sent with at_cmd_batch() */
+    struct batch_cmd_t {
+        const char *cmd;            ///< AT command in form +<CMD>, also used to match its information responses
+        const char *cmd_chr;        ///< Chars added to the command: '?', '=' or ''. '=1' is valid as well.
+        Callback<void()> handler;   ///< Called for each "+<CMD>:" information response, reading it as after resp_start(). May be empty.
+    };
+
+    /**
+     * @brief at_cmd_batch Send several AT commands and dispatch their information responses to the handler of each
+     *        command. Locks and unlocks ATHandler for operation.
+     *
+     *        With command concatenation on, the commands are written as one command line separated by ';', so the
+     *        batch costs a single response wait. Otherwise they are sent one after the other. The commands take
+     *        no variadic arguments, parameters go into cmd_chr. An error response stops the batch.
+     *
+     * @param cmds  Commands to send, in order
+     * @param count Number of commands
+     * @return last error that happened when parsing AT responses
+     */
+    nsapi_error_t at_cmd_batch(const batch_cmd_t *cmds, size_t count);
+
+    /** Set whether the modem accepts several commands on one command line, separated by ';'.
+     *
+     *  @param concatenate true to let at_cmd_batch() concatenate commands, false by default
+     */
+    void set_cmd_concatenation(bool concatenate);
+
     /** Writes integer type AT command subparameter. Starts with the delimiter if not the first param after cmd_start.
      *  In case of failure when writing, the last error is set to NSAPI_ERROR_DEVICE_ERROR.
      *
@@ -295,6 +346,8 @@ public:
     void skip_param(ssize_t len, uint32_t count);
 
     /** Reads given number of bytes from receiving buffer without checking any subparameter delimiters, such as comma.
+     *  Bytes not yet in the receiving buffer are read from the file handle directly into buf when they would not
+     *  fit in the receiving buffer.
      *
      *  @param buf output buffer for the read
      *  @param len maximum number of bytes to read
@@ -418,9 +471,15 @@ private: //Private structs & enums
         const char *prefix;
         int prefix_len;
         Callback<void()> cb;
+        uint32_t hits;
         oob_t *next;
     };
 
+    // URC handlers are kept in buckets indexed by the first URC_KEY_LENGTH characters of their prefix,
+    // as most prefixes start with '+'. Prefixes shorter than that are kept in the last bucket.
+    static const uint8_t URC_BUCKETS = 16;
+    static const uint8_t URC_KEY_LENGTH = 3;
+
     // resp_type: the part of the response that doesn't include the information response (+CMD1,+CMD2..)
     //            ends with OK or (CME)(CMS)ERROR
     // info_type: the information response part of the response: starts with +CMD1 and ends with CRLF
@@ -460,6 +519,14 @@ private: //Private functions
      */
     void remove_urc_handler(const char *prefix);
 
+    /** Get the bucket of _oobs holding urc handlers whose prefix starts with str
+     *
+     *  @param str  urc prefix or received data
+     *  @param len  length of str
+     *  @return index in _oobs
+     */
+    uint8_t urc_bucket(const char *str, size_t len) const;
+
     void set_error(nsapi_error_t err);
 
     //Handles the arguments from given variadic list
@@ -485,6 +552,9 @@ private: //Private functions
     // Reads from serial to receiving buffer.
     // Returns true on successful read OR false on timeout.
     bool fill_buffer(bool wait_for_timeout = true);
+    // Reads up to size bytes from serial to buf once data is available.
+    // Returns the number of bytes read, 0 on timeout.
+    ssize_t read_file_handle(char *buf, size_t size, bool wait_for_timeout = true);
 
     void set_tag(tag_t *tag_dest, const char *tag_seq);
 
@@ -505,6 +575,12 @@ private: //Private functions
     // Checks if receiving buffer contains OK, ERROR, URC or given prefix.
     void resp(const char *prefix, bool check_urc);
 
+    // Reads the responses of a batch of commands up to OK or ERROR, calling the handlers on their information responses
+    void resp_batch(const batch_cmd_t *cmds, size_t count);
+
+    // Matches "<cmd>:" from the current position
+    bool match_cmd_prefix(const char *cmd);
+
     void set_scope(ScopeType scope_type);
 
     ScopeType get_scope();
@@ -540,6 +616,9 @@ private: //Private functions
     // check is urc is already added
     bool find_urc_handler(const char *prefix);
 
+    // get urc handler set for prefix, NULL if not found
+    oob_t *get_urc_handler(const char *prefix);
+
     // print contents of a buffer to trace log
     enum ATType {
         AT_ERR,
@@ -564,7 +643,7 @@ private: //Member variables
     uint16_t _oob_string_max_length;
     char *_output_delimiter;
 
-    oob_t *_oobs;
+    oob_t *_oobs[URC_BUCKETS + 1];
     uint32_t _at_timeout;
     uint32_t _previous_at_timeout;
 
@@ -575,7 +654,7 @@ private: //Member variables
     bool _is_fh_usable;
 
     // should fit any prefix and int
-    char _recv_buff[BUFF_SIZE];
+    char _recv_buff[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE];
     // reading position
     size_t _recv_len;
     // reading length
@@ -608,6 +687,7 @@ private: //Member variables
     bool _debug_on;
     bool _cmd_start;
     bool _use_delimiter;
+    bool _cmd_concatenation;
 
     // time when a command or an URC processing was started
     uint64_t _start_time;
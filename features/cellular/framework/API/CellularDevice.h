@@ -63,6 +63,26 @@ public:
         SimStateUnknown
     };
 
+    /* radio states tracked in power statistics */
+    enum RadioState {
+        RadioStateConnected = 0,    /* RRC connected, the radio is active */
+        RadioStateIdle,             /* RRC idle, the modem listens to paging at each DRX or eDRX cycle */
+        RadioStatePSM,              /* power saving mode, the modem is unreachable */
+        RadioStateUnknown
+    };
+
+    /* power statistics, see get_power_stats() */
+    struct power_stats_t {
+        uint64_t time_in_state[RadioStateUnknown];  /* milliseconds spent in each radio state */
+        uint32_t wake_count;                        /* transitions to RadioStateConnected */
+        uint32_t attach_count;                      /* successful network attaches */
+        uint32_t detach_count;                      /* disconnections from the network */
+        uint64_t bytes_sent;                        /* socket data sent through the modem */
+        uint64_t bytes_received;                    /* socket data received through the modem */
+        int connect_latency;                        /* milliseconds from the last connect to the first data sent or
+                                                       received, -1 if no data was sent or received since */
+    };
+
     /** Returns singleton instance of CellularDevice, if Mbed target board has a supported
      *  onboard modem, or provide-default is defined for a cellular driver in JSON configuration
      *  files. Otherwise returns NULL. See NetworkInterface::get_default_instance for details.
@@ -103,6 +123,27 @@ public: //Virtual functions
      */
     virtual nsapi_error_t shutdown();
 
+    /** Start 3GPP TS 27.010 multiplexing on the connection to the modem.
+     *
+     *  AT commands are then sent on a multiplexer channel and PPP data on another one, so that AT commands
+     *  can be used while a PPP connection is up, without escaping out of data mode.
+     *
+     *  @remark Multiplexing must be started before connecting, once the modem is ready.
+     *
+     *  @return         NSAPI_ERROR_OK on success
+     *                  NSAPI_ERROR_UNSUPPORTED if the device does not support multiplexing
+     *                  NSAPI_ERROR_IS_CONNECTED if multiplexing is already started
+     *                  NSAPI_ERROR_DEVICE_ERROR on failure
+     */
+    virtual nsapi_error_t start_mux();
+
+    /** Stop multiplexing, AT commands are sent again on the connection to the modem.
+     *
+     *  @return         NSAPI_ERROR_OK on success
+     *                  NSAPI_ERROR_UNSUPPORTED if the device does not support multiplexing
+     */
+    virtual nsapi_error_t stop_mux();
+
     /** Get event queue that can be chained to main event queue.
      *  @return event queue
      */
@@ -431,11 +472,44 @@ public: //Common functions
      */
     void set_retry_timeout_array(const uint16_t timeout[], int array_len);
 
+    /** Get power statistics, to tune the PSM and eDRX timers of set_power_save_mode() and
+     *  CellularNetwork::set_receive_period(). Bytes per wake is (bytes_sent + bytes_received) / wake_count.
+     *
+     *  @remark The radio state is tracked only if the modem driver reports it, see set_radio_state(). AT drivers
+     *          report it from +CSCON URCs if cellular.power-stats is set.
+     *
+     *  @param stats    statistics since the device was created or since reset_power_stats()
+     */
+    void get_power_stats(power_stats_t &stats);
+
+    /** Clear power statistics. The current radio state is kept.
+     */
+    void reset_power_stats();
+
 protected: //Common functions
     friend class AT_CellularNetwork;
     friend class AT_CellularContext;
+    friend class AT_CellularStack;
     friend class CellularContext;
 
+    /** Update the radio state of the power statistics. Called by the modem driver, for example on
+     *  signalling connection status or power saving mode URCs.
+     *
+     *  @param state    new radio state
+     */
+    void set_radio_state(RadioState state);
+
+    /** Start measuring the connect latency of the power statistics, called when connecting starts.
+     */
+    void start_connect_stats();
+
+    /** Add socket data to the power statistics. The first data after start_connect_stats() sets the connect latency.
+     *
+     *  @param sent         bytes sent
+     *  @param received     bytes received
+     */
+    void add_data_stats(nsapi_size_t sent, nsapi_size_t received);
+
     /** Get the retry array from the CellularStateMachine. Array is used in retry logic.
      *  Array contains seconds and retry logic uses those second to wait before trying again.
      *
@@ -466,6 +540,12 @@ private: //Member variables
     char _plmn[MAX_PLMN_SIZE + 1];
     PlatformMutex _mutex;
 
+    power_stats_t _power_stats;
+    RadioState _radio_state;
+    uint64_t _radio_state_time;
+    uint64_t _connect_time;
+    bool _connect_pending;
+
 #ifdef MBED_CONF_RTOS_PRESENT
     rtos::Thread _queue_thread;
 #endif
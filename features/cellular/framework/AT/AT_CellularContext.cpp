@@ -40,6 +40,11 @@
 #if MBED_CONF_CELLULAR_USE_APN_LOOKUP
 #include "CellularInformation.h"
 #include "APN_db.h"
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+#include "kvstore_global_api.h"
+// APN, user name and password of the last lookup, as in the APN database
+#define RESUME_APN_KEY MBED_CONF_CELLULAR_RESUME_KVSTORE "cellular_apn"
+#endif
 #endif //MBED_CONF_CELLULAR_USE_APN_LOOKUP
 
 using namespace mbed_cellular_util;
@@ -83,7 +88,8 @@ nsapi_error_t AT_CellularContext::configure_hup(PinName dcd_pin, bool active_hig
 
 void AT_CellularContext::enable_hup(bool enable)
 {
-    if (_dcd_pin != NC) {
+    // DCD of the serial does not follow the multiplexer data channel
+    if (_dcd_pin != NC && !get_device()->get_mux_data_channel()) {
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN) || defined(DOXYGEN_ONLY)
         static_cast<BufferedSerial *>(_at.get_file_handle())->set_data_carrier_detect(enable ? _dcd_pin : NC, _active_high);
 #endif // #if DEVICE_SERIAL
@@ -106,6 +112,7 @@ nsapi_error_t AT_CellularContext::connect()
     if (_is_connected) {
         return NSAPI_ERROR_IS_CONNECTED;
     }
+    _device->start_connect_stats();
     call_network_cb(NSAPI_STATUS_CONNECTING);
 
     nsapi_error_t err = _device->attach_to_network();
@@ -210,7 +217,7 @@ nsapi_error_t AT_CellularContext::get_ip_address(SocketAddress *address)
         return NSAPI_ERROR_PARAMETER;
     }
 #if NSAPI_PPP_AVAILABLE
-    address->set_ip_address(nsapi_ppp_get_ip_addr(_at.get_file_handle()));
+    address->set_ip_address(nsapi_ppp_get_ip_addr(get_ppp_file_handle()));
     return NSAPI_ERROR_OK;
 #else
     if (!_stack) {
@@ -592,6 +599,14 @@ nsapi_error_t AT_CellularContext::open_data_channel()
     }
 
     tr_info("CellularContext PPP connect");
+
+    // when multiplexing, PPP is started on the data channel and AT commands continue on the AT channel
+    FileHandle *at_fh = _at.get_file_handle();
+    FileHandle *ppp_fh = get_ppp_file_handle();
+    if (ppp_fh != at_fh) {
+        _at.set_file_handle(ppp_fh);
+    }
+
     if (get_device()->get_property(AT_CellularDevice::PROPERTY_AT_CGDATA)) {
         _at.cmd_start_stop("+CGDATA", "=\"PPP\",", "%d", _cid);
     } else {
@@ -605,17 +620,23 @@ nsapi_error_t AT_CellularContext::open_data_channel()
     }
 
     _at.resp_start("CONNECT", true);
-    if (_at.get_last_error()) {
+    nsapi_error_t err = _at.get_last_error();
+    if (ppp_fh != at_fh) {
+        _at.set_file_handle(at_fh);
+    }
+    if (err) {
         tr_error("Failed to CONNECT");
-        return _at.get_last_error();
+        return err;
     }
 
-    _at.set_is_filehandle_usable(false);
+    if (ppp_fh == at_fh) {
+        _at.set_is_filehandle_usable(false);
+    }
     enable_hup(true);
     /* Initialize PPP
      * If blocking: mbed_ppp_init() is a blocking call, it will block until
                   connected, or timeout after 30 seconds*/
-    nsapi_error_t err = nsapi_ppp_connect(_at.get_file_handle(), callback(this, &AT_CellularContext::ppp_status_cb), _uname, _pwd, (nsapi_ip_stack_t)_pdp_type);
+    err = nsapi_ppp_connect(ppp_fh, callback(this, &AT_CellularContext::ppp_status_cb), _uname, _pwd, (nsapi_ip_stack_t)_pdp_type);
     if (err) {
         tr_error("nsapi_ppp_connect failed");
         ppp_disconnected();
@@ -661,6 +682,11 @@ void AT_CellularContext::ppp_disconnected()
     _at.unlock();
 }
 
+FileHandle *AT_CellularContext::get_ppp_file_handle()
+{
+    FileHandle *fh = get_device()->get_mux_data_channel();
+    return fh ? fh : _at.get_file_handle();
+}
 #endif //#if NSAPI_PPP_AVAILABLE
 
 void AT_CellularContext::do_disconnect()
@@ -676,7 +702,7 @@ void AT_CellularContext::do_disconnect()
     // set false here so callbacks know that we are not connected and so should not send DISCONNECTED
     _is_connected = false;
 #if NSAPI_PPP_AVAILABLE
-    nsapi_error_t err = nsapi_ppp_disconnect(_at.get_file_handle());
+    nsapi_error_t err = nsapi_ppp_disconnect(get_ppp_file_handle());
     if (err != NSAPI_ERROR_OK) {
         tr_error("CellularContext disconnect failed!");
         // continue even in failure due to ppp disconnect in any case releases filehandle
@@ -878,6 +904,57 @@ nsapi_error_t AT_CellularContext::get_pdpcontext_params(pdpContextList_t &params
     return _at.unlock_return_error();
 }
 
+#if MBED_CONF_CELLULAR_USE_APN_LOOKUP
+bool AT_CellularContext::load_apn_config(const cell_callback_data_t *data)
+{
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+    // the SIM has not changed if the modem kept its registration, reuse the last lookup
+    if (!data->data || !*(const bool *)data->data) {
+        return false;
+    }
+    size_t len = 0;
+    if (kv_get(RESUME_APN_KEY, _cached_apn_config, sizeof(_cached_apn_config), &len) != MBED_SUCCESS ||
+            len < 3 || _cached_apn_config[len - 1] != '\0') {
+        return false;
+    }
+    const char *apn_config = _cached_apn_config;
+    const char *apn = _APN_GET(apn_config);
+    const char *uname = _APN_GET(apn_config);
+    const char *pwd = _APN_GET(apn_config);
+    if (apn_config != _cached_apn_config + len) {
+        return false;
+    }
+    tr_info("Cached APN %s", apn);
+    set_credentials(apn, uname, pwd);
+    return true;
+#else
+    return false;
+#endif // MBED_CONF_CELLULAR_RESUME_KVSTORE
+}
+
+void AT_CellularContext::store_apn_config(const char *apn_config)
+{
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+    size_t len = 0;
+    for (int i = 0; i < 3; i++) {
+        len += strlen(apn_config + len) + 1;
+    }
+    if (len > sizeof(_cached_apn_config)) {
+        return;
+    }
+    // write only on change to spare the flash
+    size_t cached_len = 0;
+    if (kv_get(RESUME_APN_KEY, _cached_apn_config, sizeof(_cached_apn_config), &cached_len) == MBED_SUCCESS &&
+            cached_len == len && memcmp(_cached_apn_config, apn_config, len) == 0) {
+        return;
+    }
+    if (kv_set(RESUME_APN_KEY, apn_config, len, 0) != MBED_SUCCESS) {
+        tr_warn("Failed to store APN");
+    }
+#endif // MBED_CONF_CELLULAR_RESUME_KVSTORE
+}
+#endif // MBED_CONF_CELLULAR_USE_APN_LOOKUP
+
 // Called by CellularDevice for network and cellular device changes
 void AT_CellularContext::cellular_callback(nsapi_event_t ev, intptr_t ptr)
 {
@@ -890,13 +967,14 @@ void AT_CellularContext::cellular_callback(nsapi_event_t ev, intptr_t ptr)
 #if MBED_CONF_CELLULAR_USE_APN_LOOKUP
         if (st == CellularSIMStatusChanged && data->status_data == CellularDevice::SimStateReady &&
                 _cb_data.error == NSAPI_ERROR_OK) {
-            if (!_apn) {
+            if (!_apn && !load_apn_config(data)) {
                 char imsi[MAX_IMSI_LENGTH + 1];
                 ThisThread::sleep_for(1000); // need to wait to access SIM in some modems
                 _cb_data.error = _device->open_information()->get_imsi(imsi, sizeof(imsi));
                 if (_cb_data.error == NSAPI_ERROR_OK) {
                     const char *apn_config = apnconfig(imsi);
                     if (apn_config) {
+                        store_apn_config(apn_config);
                         const char *apn = _APN_GET(apn_config);
                         const char *uname = _APN_GET(apn_config);
                         const char *pwd = _APN_GET(apn_config);
@@ -113,6 +113,8 @@ private:
     nsapi_error_t open_data_channel();
     void ppp_status_cb(nsapi_event_t ev, intptr_t ptr);
     void ppp_disconnected();
+    // file handle used by PPP: the multiplexer data channel if multiplexing is started, otherwise the AT file handle
+    FileHandle *get_ppp_file_handle();
 #endif // #if NSAPI_PPP_AVAILABLE
     nsapi_error_t do_activate_context();
     virtual void activate_context();
@@ -121,6 +123,11 @@ private:
     void check_and_deactivate_context();
     void delete_current_context();
     nsapi_error_t check_operation(nsapi_error_t err, ContextOperation op);
+#if MBED_CONF_CELLULAR_USE_APN_LOOKUP
+    // APN lookup result kept over reboots in KVStore, used when the state machine resumed the registration
+    bool load_apn_config(const cell_callback_data_t *data);
+    void store_apn_config(const char *apn_config);
+#endif // MBED_CONF_CELLULAR_USE_APN_LOOKUP
     void ciot_opt_cb(mbed::CellularNetwork::CIoT_Supported_Opt ciot_opt);
     virtual void do_connect_with_retry();
     void set_cid(int cid);
@@ -133,6 +140,10 @@ private:
     PinName _dcd_pin;
     bool _active_high;
 
+#if MBED_CONF_CELLULAR_USE_APN_LOOKUP && defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+    char _cached_apn_config[3 * MAX_APN_LENGTH];
+#endif
+
 protected:
     char _found_apn[MAX_APN_LENGTH];
     // flag indicating if CP was requested to be setup
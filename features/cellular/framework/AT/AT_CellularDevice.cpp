@@ -25,6 +25,7 @@
 #include "AT_CellularStack.h"
 #include "CellularLog.h"
 #include "ATHandler.h"
+#include "CellularMux.h"
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN) || defined(DOXYGEN_ONLY)
 #include "drivers/BufferedSerial.h"
 #endif // #if DEVICE_SERIAL
@@ -36,6 +37,7 @@ using namespace events;
 using namespace mbed;
 
 #define DEFAULT_AT_TIMEOUT 1000 // at default timeout in milliseconds
+#define MUX_TIMEOUT 3000 // time for the modem to open or close a multiplexer channel in milliseconds
 const int MAX_SIM_RESPONSE_LENGTH = 16;
 
 AT_CellularDevice::AT_CellularDevice(FileHandle *fh) :
@@ -47,6 +49,11 @@ AT_CellularDevice::AT_CellularDevice(FileHandle *fh) :
     _network(0),
     _information(0),
     _context_list(0),
+    _mux(NULL),
+#if MBED_CONF_CELLULAR_POWER_STATS
+    _psm_active_time(-1),
+    _psm_event_id(0),
+#endif // MBED_CONF_CELLULAR_POWER_STATS
     _default_timeout(DEFAULT_AT_TIMEOUT),
     _modem_debug_on(false),
     _property_array(NULL)
@@ -62,6 +69,12 @@ AT_CellularDevice::~AT_CellularDevice()
         _at.set_urc_handler("+CGEV: NW PDN D", nullptr);
         _at.set_urc_handler("+CGEV: ME PDN D", nullptr);
     }
+#if MBED_CONF_CELLULAR_POWER_STATS
+    _at.set_urc_handler("+CSCON:", nullptr);
+    if (_psm_event_id) {
+        _queue.cancel(_psm_event_id);
+    }
+#endif // MBED_CONF_CELLULAR_POWER_STATS
 
     // make sure that all is deleted even if somewhere close was not called and reference counting is messed up.
     _network_ref_count = 1;
@@ -85,6 +98,8 @@ AT_CellularDevice::~AT_CellularDevice()
         delete curr;
         curr = next;
     }
+
+    stop_mux();
 }
 
 void AT_CellularDevice::set_at_urcs_impl()
@@ -99,6 +114,9 @@ void AT_CellularDevice::set_at_urcs()
         _at.set_urc_handler("+CGEV: NW PDN D", callback(this, &AT_CellularDevice::urc_pdn_deact));
         _at.set_urc_handler("+CGEV: ME PDN D", callback(this, &AT_CellularDevice::urc_pdn_deact));
     }
+#if MBED_CONF_CELLULAR_POWER_STATS
+    _at.set_urc_handler("+CSCON:", callback(this, &AT_CellularDevice::urc_cscon));
+#endif // MBED_CONF_CELLULAR_POWER_STATS
 
     set_at_urcs_impl();
 }
@@ -108,6 +126,7 @@ void AT_CellularDevice::setup_at_handler()
     set_at_urcs();
 
     _at.set_send_delay(get_property(AT_CellularDevice::PROPERTY_AT_SEND_DELAY));
+    _at.set_cmd_concatenation(get_property(AT_CellularDevice::PROPERTY_AT_CMD_CONCATENATION));
 }
 
 void AT_CellularDevice::urc_nw_deact()
@@ -143,6 +162,33 @@ void AT_CellularDevice::urc_pdn_deact()
     send_disconnect_to_context(cid);
 }
 
+#if MBED_CONF_CELLULAR_POWER_STATS
+void AT_CellularDevice::urc_cscon()
+{
+    // +CSCON: <mode>[,<state>[,<access>]]
+    int mode = _at.read_int();
+    if (_psm_event_id) {
+        _queue.cancel(_psm_event_id);
+        _psm_event_id = 0;
+    }
+    if (mode == 1) {
+        set_radio_state(RadioStateConnected);
+    } else if (mode == 0) {
+        set_radio_state(RadioStateIdle);
+        // there is no standard URC for entering PSM, the modem is expected to enter it when the active time expires
+        if (_psm_active_time >= 0) {
+            _psm_event_id = _queue.call_in(_psm_active_time * 1000, callback(this, &AT_CellularDevice::psm_entered));
+        }
+    }
+}
+
+void AT_CellularDevice::psm_entered()
+{
+    _psm_event_id = 0;
+    set_radio_state(RadioStatePSM);
+}
+#endif // MBED_CONF_CELLULAR_POWER_STATS
+
 void AT_CellularDevice::send_disconnect_to_context(int cid)
 {
     tr_debug("send_disconnect_to_context, cid: %d", cid);
@@ -423,6 +469,16 @@ nsapi_error_t AT_CellularDevice::init()
         rtos::ThisThread::sleep_for(100); // let modem have time to get ready
     }
 
+#if MBED_CONF_CELLULAR_POWER_STATS
+    if (_at.get_last_error() == NSAPI_ERROR_OK) {
+        // signalling connection status URCs for the radio state of power statistics, not supported by all modems
+        if (_at.at_cmd_discard("+CSCON", "=1") != NSAPI_ERROR_OK) {
+            tr_warn("Radio state is not reported");
+            _at.clear_error();
+        }
+    }
+#endif // MBED_CONF_CELLULAR_POWER_STATS
+
     return _at.unlock_return_error();
 }
 
@@ -568,6 +624,12 @@ nsapi_error_t AT_CellularDevice::set_power_save_mode(int periodic_time, int acti
         }
     }
 
+#if MBED_CONF_CELLULAR_POWER_STATS
+    if (_at.get_last_error() == NSAPI_ERROR_OK) {
+        _psm_active_time = (periodic_time == 0 && active_time == 0) ? -1 : active_time;
+    }
+#endif // MBED_CONF_CELLULAR_POWER_STATS
+
     return _at.unlock_return_error();
 }
 
@@ -622,6 +684,55 @@ nsapi_error_t AT_CellularDevice::set_baud_rate(int baud_rate)
     return error;
 }
 
+nsapi_error_t AT_CellularDevice::start_mux()
+{
+    if (_mux) {
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+
+    _at.lock();
+    nsapi_error_t err = _at.at_cmd_discard("+CMUX", "=0,0,,", "%d", MBED_CONF_CELLULAR_MUX_FRAME_SIZE);
+    if (err == NSAPI_ERROR_OK) {
+        FileHandle *fh = _at.get_file_handle();
+        _at.set_is_filehandle_usable(false);
+        _mux = new CellularMux();
+        err = _mux->start(fh, MUX_TIMEOUT);
+        if (err == NSAPI_ERROR_OK) {
+            _at.set_file_handle(_mux->get_channel(CellularMux::CHANNEL_AT));
+        } else {
+            delete _mux;
+            _mux = NULL;
+            _at.set_is_filehandle_usable(true);
+        }
+    }
+    _at.unlock();
+
+    return err;
+}
+
+nsapi_error_t AT_CellularDevice::stop_mux()
+{
+    if (!_mux) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _at.lock();
+    FileHandle *fh = _mux->get_file_handle();
+    _mux->stop(MUX_TIMEOUT);
+    // the channel is released before the multiplexer is deleted
+    _at.set_file_handle(fh);
+    delete _mux;
+    _mux = NULL;
+    _at.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+FileHandle *AT_CellularDevice::get_mux_data_channel()
+{
+    return _mux ? _mux->get_channel(CellularMux::CHANNEL_DATA) : NULL;
+}
+
 nsapi_error_t AT_CellularDevice::set_baud_rate_impl(int baud_rate)
 {
     return _at.at_cmd_discard("+IPR", "=", "%d", baud_rate);
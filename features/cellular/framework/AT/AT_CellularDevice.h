@@ -27,6 +27,7 @@ class AT_CellularInformation;
 class AT_CellularNetwork;
 class AT_CellularSMS;
 class AT_CellularContext;
+class CellularMux;
 class FileHandle;
 
 /**
@@ -63,6 +64,7 @@ public:
         PROPERTY_IP_TCP,                // 0 = not supported, 1 = supported. Modem IP stack has support for TCP
         PROPERTY_IP_UDP,                // 0 = not supported, 1 = supported. Modem IP stack has support for TCP
         PROPERTY_AT_SEND_DELAY,         // Sending delay between AT commands in ms
+        PROPERTY_AT_CMD_CONCATENATION,  // 0 = not supported, 1 = supported. Several commands on one command line, separated by ';'
         PROPERTY_MAX
     };
 
@@ -116,6 +118,16 @@ public:
 
     virtual nsapi_error_t set_baud_rate(int baud_rate);
 
+    virtual nsapi_error_t start_mux();
+
+    virtual nsapi_error_t stop_mux();
+
+    /** Get the multiplexer channel used for PPP data.
+     *
+     *  @return     data channel, NULL if multiplexing is not started
+     */
+    FileHandle *get_mux_data_channel();
+
 #if MBED_CONF_CELLULAR_USE_SMS
     virtual CellularSMS *open_sms();
 
@@ -184,6 +196,10 @@ protected:
 private:
     void urc_nw_deact();
     void urc_pdn_deact();
+#if MBED_CONF_CELLULAR_POWER_STATS
+    void urc_cscon();
+    void psm_entered();
+#endif // MBED_CONF_CELLULAR_POWER_STATS
 
 protected:
     ATHandler _at;
@@ -196,6 +212,12 @@ private:
     AT_CellularNetwork *_network;
     AT_CellularInformation *_information;
     AT_CellularContext *_context_list;
+    CellularMux *_mux;
+#if MBED_CONF_CELLULAR_POWER_STATS
+    // active time given to set_power_save_mode() in seconds, -1 if power saving mode is disabled
+    int _psm_active_time;
+    int _psm_event_id;
+#endif // MBED_CONF_CELLULAR_POWER_STATS
 
     int _default_timeout;
     bool _modem_debug_on;
@@ -310,6 +310,7 @@ nsapi_size_or_error_t AT_CellularStack::socket_sendto(nsapi_socket_t handle, con
     _at.unlock();
 
     if (ret_val >= 0) {
+        _device.add_data_stats(ret_val, 0);
         tr_info("Socket %d sent %d bytes to %s port %d", find_socket_index(socket), ret_val, addr.get_ip_address(), addr.get_port());
     } else if (ret_val != NSAPI_ERROR_WOULD_BLOCK) {
         tr_error("Socket %d sendto %s error %d", find_socket_index(socket), addr.get_ip_address(), ret_val);
@@ -361,6 +362,7 @@ nsapi_size_or_error_t AT_CellularStack::socket_recvfrom(nsapi_socket_t handle, S
     }
 
     if (ret_val >= 0) {
+        _device.add_data_stats(0, ret_val);
         if (addr) {
             tr_info("Socket %d recv %d bytes from %s port %d", find_socket_index(socket), ret_val, addr->get_ip_address(), addr->get_port());
         } else {
@@ -420,3 +422,31 @@ bool AT_CellularStack::is_addr_stack_compatible(const SocketAddress &addr)
     return true;
 }
 
+
+nsapi_size_or_error_t AT_CellularStack::read_socket_data(void *buffer, nsapi_size_t size, nsapi_size_t data_len, bool quoted)
+{
+    uint8_t discard[16];
+
+    if (quoted && _at.read_bytes(discard, 1) != 1) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    nsapi_size_t len = data_len > size ? size : data_len;
+    if (len > 0 && _at.read_bytes((uint8_t *)buffer, len) != (ssize_t)len) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    for (nsapi_size_t left = data_len - len; left > 0;) {
+        nsapi_size_t chunk = left > sizeof(discard) ? sizeof(discard) : left;
+        if (_at.read_bytes(discard, chunk) != (ssize_t)chunk) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+        left -= chunk;
+    }
+
+    if (data_len > len) {
+        tr_warn("Socket data truncated, dropped %d bytes", (int)(data_len - len));
+    }
+
+    return len;
+}
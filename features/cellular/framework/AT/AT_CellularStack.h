@@ -189,6 +189,22 @@ protected:
      */
     bool is_addr_stack_compatible(const SocketAddress &addr);
 
+    /**
+     *  Reads socket payload that the modem sends as binary data in an AT response, for modems supporting
+     *  binary transfer of socket data. Payload is read from the file handle straight into buffer, without
+     *  hex decoding or intermediate copies.
+     *
+     *  If the modem sends more than size bytes the rest of the payload is read and dropped, so that the
+     *  response can be completed with ATHandler::resp_stop().
+     *
+     *  @param buffer   Destination buffer for the payload
+     *  @param size     Size of the buffer in bytes
+     *  @param data_len Length of the payload announced by the modem
+     *  @param quoted   True if the payload is enclosed in double quotes, the opening quote is skipped
+     *  @return         Number of bytes stored in buffer on success, negative error code on failure
+     */
+    nsapi_size_or_error_t read_socket_data(void *buffer, nsapi_size_t size, nsapi_size_t data_len, bool quoted = false);
+
 private:
     int get_socket_index_by_port(uint16_t port);
 
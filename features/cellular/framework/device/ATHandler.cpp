@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <limits.h>
 #include <errno.h>
+#include <algorithm>
 #include "ATHandler.h"
 #include "mbed_poll.h"
 #include "FileHandle.h"
@@ -78,7 +79,6 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     _last_err(NSAPI_ERROR_OK),
     _last_3gpp_error(0),
     _oob_string_max_length(0),
-    _oobs(NULL),
     _at_timeout(timeout),
     _previous_at_timeout(timeout),
     _at_send_delay(send_delay),
@@ -94,6 +94,7 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     _debug_on(DEBUG_AT_ENABLED),
     _cmd_start(false),
     _use_delimiter(true),
+    _cmd_concatenation(false),
     _start_time(0),
     _event_id(0)
 {
@@ -107,6 +108,7 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     }
 
     reset_buffer();
+    memset(_oobs, 0, sizeof(_oobs));
     memset(_recv_buff, 0, sizeof(_recv_buff));
     memset(_info_resp_prefix, 0, sizeof(_info_resp_prefix));
 
@@ -138,10 +140,12 @@ ATHandler::~ATHandler()
 #endif // AT_HANDLER_MUTEX
     }
 
-    while (_oobs) {
-        struct oob_t *oob = _oobs;
-        _oobs = oob->next;
-        delete oob;
+    for (int i = 0; i <= URC_BUCKETS; i++) {
+        while (_oobs[i]) {
+            struct oob_t *oob = _oobs[i];
+            _oobs[i] = oob->next;
+            delete oob;
+        }
     }
     if (_output_delimiter) {
         delete [] _output_delimiter;
@@ -176,6 +180,15 @@ FileHandle *ATHandler::get_file_handle()
     return _fileHandle;
 }
 
+void ATHandler::set_file_handle(FileHandle *fh)
+{
+    ScopedLock<ATHandler> lock(*this);
+    set_is_filehandle_usable(false);
+    _fileHandle = fh;
+    reset_buffer();
+    set_is_filehandle_usable(true);
+}
+
 void ATHandler::set_is_filehandle_usable(bool usable)
 {
     ScopedLock<ATHandler> lock(*this);
@@ -212,23 +225,26 @@ void ATHandler::set_urc_handler(const char *prefix, Callback<void()> callback)
         }
     }
 
+    uint8_t bucket = urc_bucket(prefix, prefix_len);
     oob->prefix = prefix;
     oob->prefix_len = prefix_len;
     oob->cb = callback;
-    oob->next = _oobs;
-    _oobs = oob;
+    oob->hits = 0;
+    oob->next = _oobs[bucket];
+    _oobs[bucket] = oob;
 }
 
 void ATHandler::remove_urc_handler(const char *prefix)
 {
-    struct oob_t *current = _oobs;
+    uint8_t bucket = urc_bucket(prefix, strlen(prefix));
+    struct oob_t *current = _oobs[bucket];
     struct oob_t *prev = NULL;
     while (current) {
         if (strcmp(prefix, current->prefix) == 0) {
             if (prev) {
                 prev->next = current->next;
             } else {
-                _oobs = current->next;
+                _oobs[bucket] = current->next;
             }
             delete current;
             break;
@@ -238,17 +254,41 @@ void ATHandler::remove_urc_handler(const char *prefix)
     }
 }
 
-bool ATHandler::find_urc_handler(const char *prefix)
+uint8_t ATHandler::urc_bucket(const char *str, size_t len) const
 {
-    struct oob_t *oob = _oobs;
+    if (len < URC_KEY_LENGTH) {
+        return URC_BUCKETS;
+    }
+
+    uint32_t key = 0;
+    for (int i = 0; i < URC_KEY_LENGTH; i++) {
+        key = key * 31 + (uint8_t)str[i];
+    }
+    return key % URC_BUCKETS;
+}
+
+ATHandler::oob_t *ATHandler::get_urc_handler(const char *prefix)
+{
+    struct oob_t *oob = _oobs[urc_bucket(prefix, strlen(prefix))];
     while (oob) {
         if (strcmp(prefix, oob->prefix) == 0) {
-            return true;
+            return oob;
         }
         oob = oob->next;
     }
 
-    return false;
+    return NULL;
+}
+
+bool ATHandler::find_urc_handler(const char *prefix)
+{
+    return get_urc_handler(prefix) != NULL;
+}
+
+uint32_t ATHandler::get_urc_hit_count(const char *prefix)
+{
+    struct oob_t *oob = get_urc_handler(prefix);
+    return oob ? oob->hits : 0;
 }
 
 void ATHandler::event()
@@ -384,27 +424,40 @@ int ATHandler::poll_timeout(bool wait_for_timeout)
 
 bool ATHandler::fill_buffer(bool wait_for_timeout)
 {
-    // Reset buffer when full
+    // Make room by dropping what has been read, reset buffer when full of unread data
+    if (sizeof(_recv_buff) == _recv_len) {
+        rewind_buffer();
+    }
     if (sizeof(_recv_buff) == _recv_len) {
         tr_warn("AT overflow");
         debug_print(_recv_buff, _recv_len, AT_ERR);
         reset_buffer();
     }
 
+    ssize_t len = read_file_handle(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len, wait_for_timeout);
+    if (len > 0) {
+        _recv_len += len;
+        return true;
+    }
+
+    return false;
+}
+
+ssize_t ATHandler::read_file_handle(char *buf, size_t size, bool wait_for_timeout)
+{
     pollfh fhs;
     fhs.fh = _fileHandle;
     fhs.events = POLLIN;
     int count = poll(&fhs, 1, poll_timeout(wait_for_timeout));
     if (count > 0 && (fhs.revents & POLLIN)) {
-        ssize_t len = _fileHandle->read(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len);
+        ssize_t len = _fileHandle->read(buf, size);
         if (len > 0) {
-            debug_print(_recv_buff + _recv_len, len, AT_RX);
-            _recv_len += len;
-            return true;
+            debug_print(buf, len, AT_RX);
+            return len;
         }
     }
 
-    return false;
+    return 0;
 }
 
 int ATHandler::get_char()
@@ -487,14 +540,32 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
     }
 
     size_t read_len = 0;
-    for (; read_len < len; read_len++) {
-        int c = get_char();
-        if (c == -1) {
+    while (read_len < len) {
+        size_t buffered = _recv_len - _recv_pos;
+        if (buffered) {
+            size_t copy_len = std::min(buffered, len - read_len);
+            memcpy(buf + read_len, _recv_buff + _recv_pos, copy_len);
+            _recv_pos += copy_len;
+            read_len += copy_len;
+            continue;
+        }
+
+        // Payloads larger than the receiving buffer skip it, smaller ones are read in bulk with what follows
+        ssize_t fh_len = 0;
+        reset_buffer();
+        if (len - read_len >= sizeof(_recv_buff)) {
+            fh_len = read_file_handle((char *)buf + read_len, len - read_len);
+            read_len += fh_len;
+        } else if (fill_buffer()) {
+            fh_len = _recv_len;
+        }
+
+        if (fh_len <= 0) {
+            tr_warn("AT timeout");
             set_error(NSAPI_ERROR_DEVICE_ERROR);
             _debug_on = debug_on;
             return -1;
         }
-        buf[read_len] = c;
     }
 
 #if DEBUG_AT_ENABLED
@@ -775,11 +846,13 @@ bool ATHandler::match(const char *str, size_t size)
 bool ATHandler::match_urc()
 {
     rewind_buffer();
-    size_t prefix_len = 0;
-    for (struct oob_t *oob = _oobs; oob; oob = oob->next) {
-        prefix_len = oob->prefix_len;
-        if (_recv_len >= prefix_len) {
-            if (match(oob->prefix, prefix_len)) {
+    // only prefixes sharing the first characters of the received data can match, shorter prefixes are
+    // checked after them
+    uint8_t bucket = urc_bucket(_recv_buff + _recv_pos, _recv_len - _recv_pos);
+    while (true) {
+        for (struct oob_t *oob = _oobs[bucket]; oob; oob = oob->next) {
+            if (match(oob->prefix, oob->prefix_len)) {
+                oob->hits++;
                 set_scope(InfoType);
                 if (oob->cb) {
                     oob->cb();
@@ -788,8 +861,11 @@ bool ATHandler::match_urc()
                 return true;
             }
         }
+        if (bucket == URC_BUCKETS) {
+            return false;
+        }
+        bucket = URC_BUCKETS;
     }
-    return false;
 }
 
 bool ATHandler::match_error()
@@ -937,6 +1013,88 @@ void ATHandler::resp(const char *prefix, bool check_urc)
     // something went wrong so application need to recover and retry
 }
 
+bool ATHandler::match_cmd_prefix(const char *cmd)
+{
+    rewind_buffer();
+
+    size_t len = strlen(cmd);
+    if ((_recv_len - _recv_pos) < len + 1) {
+        return false;
+    }
+
+    if (memcmp(_recv_buff + _recv_pos, cmd, len) == 0 && _recv_buff[_recv_pos + len] == ':') {
+        // consume matching part
+        _recv_pos += len + 1;
+        return true;
+    }
+    return false;
+}
+
+void ATHandler::resp_batch(const batch_cmd_t *cmds, size_t count)
+{
+    if (!ok_to_proceed()) {
+        return;
+    }
+
+    set_scope(NotSet);
+    // Try get as much data as possible
+    rewind_buffer();
+    (void)fill_buffer(false);
+
+    set_scope(RespType);
+
+    _prefix_matched = false;
+    _urc_matched = false;
+    _error_found = false;
+
+    // Information responses come in the order of the commands, any number of them per command
+    size_t next = 0;
+
+    while (!get_last_error()) {
+
+        (void)match(CRLF, CRLF_LENGTH);
+
+        if (match(OK, OK_LENGTH)) {
+            set_scope(RespType);
+            _stop_tag->found = true;
+            return;
+        }
+
+        if (match_error()) {
+            _error_found = true;
+            return;
+        }
+
+        size_t i = next;
+        while (i < count && !match_cmd_prefix(cmds[i].cmd)) {
+            i++;
+        }
+        if (i < count) {
+            next = i;
+            set_scope(InfoType);
+            if (cmds[i].handler) {
+                cmds[i].handler();
+            }
+            information_response_stop();
+            continue;
+        }
+
+        if (match_urc()) {
+            _urc_matched = true;
+            clear_error();
+            continue;
+        }
+
+        // If no match found, look for CRLF and consume everything up to and including CRLF
+        if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) {
+            consume_to_tag(CRLF, true);
+        } else if (!fill_buffer()) {
+            // if we don't get any match and no data within timeout, set an error to indicate need for recovery
+            set_error(NSAPI_ERROR_DEVICE_ERROR);
+        }
+    }
+}
+
 void ATHandler::resp_start(const char *prefix, bool stop)
 {
     if (!ok_to_proceed()) {
@@ -1313,6 +1471,49 @@ nsapi_error_t ATHandler::at_cmd_discard(const char *cmd, const char *cmd_chr, co
     return unlock_return_error();
 }
 
+nsapi_error_t ATHandler::at_cmd_batch(const batch_cmd_t *cmds, size_t count)
+{
+    lock();
+
+    size_t first = 0;
+    while (first < count && !get_last_error()) {
+        // Put as many commands on the command line as fit
+        size_t last = first + 1;
+        if (_cmd_concatenation) {
+            size_t len = strlen("AT") + strlen(cmds[first].cmd) + (cmds[first].cmd_chr ? strlen(cmds[first].cmd_chr) : 0);
+            while (last < count) {
+                len += 1 + strlen(cmds[last].cmd) + (cmds[last].cmd_chr ? strlen(cmds[last].cmd_chr) : 0);
+                if (len > MBED_CONF_CELLULAR_AT_BATCH_LINE_LENGTH) {
+                    break;
+                }
+                last++;
+            }
+        }
+
+        handle_start(cmds[first].cmd, cmds[first].cmd_chr);
+        for (size_t i = first + 1; i < last; i++) {
+            write_bytes((const uint8_t *)";", 1);
+            write_bytes((const uint8_t *)cmds[i].cmd, strlen(cmds[i].cmd));
+            if (cmds[i].cmd_chr) {
+                write_bytes((const uint8_t *)cmds[i].cmd_chr, strlen(cmds[i].cmd_chr));
+            }
+        }
+        cmd_stop();
+
+        resp_batch(cmds + first, last - first);
+        resp_stop();
+
+        first = last;
+    }
+
+    return unlock_return_error();
+}
+
+void ATHandler::set_cmd_concatenation(bool concatenate)
+{
+    _cmd_concatenation = concatenate;
+}
+
 void ATHandler::write_int(int32_t param)
 {
     // do common checks before sending subparameter
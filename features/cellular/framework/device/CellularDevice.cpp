@@ -21,6 +21,7 @@
 #include "CellularLog.h"
 #include "events/EventQueue.h"
 #include "mbed_shared_queues.h"
+#include "Kernel.h"
 
 namespace mbed {
 
@@ -40,13 +41,15 @@ CellularDevice::CellularDevice() :
     _sms_ref_count(0),
 #endif //MBED_CONF_CELLULAR_USE_SMS
     _info_ref_count(0), _queue(10 * EVENTS_EVENT_SIZE), _state_machine(0),
-    _status_cb(), _nw(0)
+    _status_cb(), _nw(0), _radio_state(RadioStateUnknown), _radio_state_time(0), _connect_time(0),
+    _connect_pending(false)
 #ifdef MBED_CONF_RTOS_PRESENT
     , _queue_thread(osPriorityNormal, 2048, NULL, "cellular_queue")
 #endif // MBED_CONF_RTOS_PRESENT
 {
     set_sim_pin(NULL);
     set_plmn(NULL);
+    reset_power_stats();
 
 #ifdef MBED_CONF_RTOS_PRESENT
     if (_queue_thread.start(callback(&_queue, &events::EventQueue::dispatch_forever)) != osOK) {
@@ -193,9 +196,18 @@ void CellularDevice::cellular_callback(nsapi_event_t ev, intptr_t ptr, CellularC
             // broadcast only network registration changes to state machine
             _state_machine->cellular_event_changed(ev, ptr);
         }
+        if (cell_ev == CellularAttachNetwork && ptr_data->error == NSAPI_ERROR_OK &&
+                ptr_data->status_data == CellularNetwork::Attached) {
+            _mutex.lock();
+            _power_stats.attach_count++;
+            _mutex.unlock();
+        }
     } else {
         tr_debug("callback: %d, ptr: %d", ev, ptr);
         if (ev == NSAPI_EVENT_CONNECTION_STATUS_CHANGE && ptr == NSAPI_STATUS_DISCONNECTED) {
+            _mutex.lock();
+            _power_stats.detach_count++;
+            _mutex.unlock();
             // we have been disconnected, reset state machine so that application can start connect sequence again
             if (_state_machine) {
                 CellularStateMachine::CellularState current_state, targeted_state;
@@ -243,6 +255,16 @@ nsapi_error_t CellularDevice::shutdown()
     return NSAPI_ERROR_OK;
 }
 
+nsapi_error_t CellularDevice::start_mux()
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t CellularDevice::stop_mux()
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 void CellularDevice::set_retry_timeout_array(const uint16_t timeout[], int array_len)
 {
     if (create_state_machine() == NSAPI_ERROR_OK) {
@@ -250,4 +272,59 @@ void CellularDevice::set_retry_timeout_array(const uint16_t timeout[], int array
     }
 }
 
+void CellularDevice::get_power_stats(power_stats_t &stats)
+{
+    _mutex.lock();
+    stats = _power_stats;
+    if (_radio_state != RadioStateUnknown) {
+        // the current state is counted up to now
+        stats.time_in_state[_radio_state] += rtos::Kernel::get_ms_count() - _radio_state_time;
+    }
+    _mutex.unlock();
+}
+
+void CellularDevice::reset_power_stats()
+{
+    _mutex.lock();
+    memset(&_power_stats, 0, sizeof(_power_stats));
+    _power_stats.connect_latency = -1;
+    _radio_state_time = rtos::Kernel::get_ms_count();
+    _mutex.unlock();
+}
+
+void CellularDevice::set_radio_state(RadioState state)
+{
+    _mutex.lock();
+    uint64_t now = rtos::Kernel::get_ms_count();
+    if (_radio_state != RadioStateUnknown) {
+        _power_stats.time_in_state[_radio_state] += now - _radio_state_time;
+    }
+    if (state == RadioStateConnected && _radio_state != RadioStateConnected) {
+        _power_stats.wake_count++;
+    }
+    _radio_state = state;
+    _radio_state_time = now;
+    _mutex.unlock();
+}
+
+void CellularDevice::start_connect_stats()
+{
+    _mutex.lock();
+    _connect_time = rtos::Kernel::get_ms_count();
+    _connect_pending = true;
+    _mutex.unlock();
+}
+
+void CellularDevice::add_data_stats(nsapi_size_t sent, nsapi_size_t received)
+{
+    _mutex.lock();
+    _power_stats.bytes_sent += sent;
+    _power_stats.bytes_received += received;
+    if (_connect_pending && (sent || received)) {
+        _power_stats.connect_latency = rtos::Kernel::get_ms_count() - _connect_time;
+        _connect_pending = false;
+    }
+    _mutex.unlock();
+}
+
 } // namespace mbed
@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <algorithm>
+#include "CellularMux.h"
+#include "mbed_poll.h"
+#include "Kernel.h"
+#include "CellularLog.h"
+
+using namespace mbed;
+
+// 3GPP TS 27.010 basic option framing
+#define MUX_FLAG 0xF9
+#define MUX_EA 0x01
+#define MUX_CR 0x02
+#define MUX_PF 0x10
+
+// frame types of the control field
+#define MUX_SABM 0x2F
+#define MUX_UA 0x63
+#define MUX_DM 0x0F
+#define MUX_DISC 0x43
+#define MUX_UIH 0xEF
+#define MUX_UI 0x03
+
+// time to wait for serial data when a blocking channel read has nothing to return
+#define MUX_RX_POLL_TIME 10
+// time to wait for room in the serial transmit buffer
+#define MUX_TX_TIMEOUT 5000
+
+CellularMux::MuxChannel::MuxChannel() :
+    _mux(NULL), _dlci(0), _blocking(true), _open(false)
+{
+}
+
+ssize_t CellularMux::MuxChannel::read(void *buffer, size_t size)
+{
+    while (true) {
+        if (!_open) {
+            return -EBADF;
+        }
+
+        _mux->process_rx();
+        size_t len = _rx_buf.pop(mbed::Span<uint8_t>(static_cast<uint8_t *>(buffer), size));
+        if (len > 0 || size == 0) {
+            return len;
+        }
+
+        if (!_blocking) {
+            return -EAGAIN;
+        }
+        _mux->wait_rx(MUX_RX_POLL_TIME);
+    }
+}
+
+ssize_t CellularMux::MuxChannel::write(const void *buffer, size_t size)
+{
+    const uint8_t *data = static_cast<const uint8_t *>(buffer);
+    size_t written = 0;
+
+    while (written < size) {
+        if (!_open) {
+            return written ? written : -EBADF;
+        }
+
+        size_t len = std::min(size - written, (size_t)MBED_CONF_CELLULAR_MUX_FRAME_SIZE);
+        ssize_t ret = _mux->write_frame(_dlci, MUX_UIH, true, data + written, len);
+        if (ret < 0) {
+            return written ? written : ret;
+        }
+        written += len;
+    }
+
+    return written;
+}
+
+off_t CellularMux::MuxChannel::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int CellularMux::MuxChannel::close()
+{
+    return 0;
+}
+
+int CellularMux::MuxChannel::set_blocking(bool blocking)
+{
+    _blocking = blocking;
+    return 0;
+}
+
+bool CellularMux::MuxChannel::is_blocking() const
+{
+    return _blocking;
+}
+
+short CellularMux::MuxChannel::poll(short events) const
+{
+    _mux->process_rx();
+
+    if (!_open) {
+        return POLLHUP;
+    }
+
+    short revents = POLLOUT;
+    if (!_rx_buf.empty()) {
+        revents |= POLLIN;
+    }
+    return revents;
+}
+
+void CellularMux::MuxChannel::sigio(Callback<void()> func)
+{
+    _sigio_cb = func;
+    if (_sigio_cb && !_rx_buf.empty()) {
+        _sigio_cb();
+    }
+}
+
+CellularMux::CellularMux() :
+    _fh(NULL),
+    _rx_state(RX_FLAG),
+    _rx_header_len(0),
+    _rx_len(0),
+    _rx_pos(0),
+    _response_dlci(-1),
+    _response(0)
+{
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        _channels[i]._mux = this;
+        _channels[i]._dlci = i + 1;
+    }
+}
+
+CellularMux::~CellularMux()
+{
+    stop(0);
+}
+
+nsapi_error_t CellularMux::start(FileHandle *fh, uint32_t timeout_ms)
+{
+    _mutex.lock();
+    if (_fh) {
+        _mutex.unlock();
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+    _fh = fh;
+    _rx_state = RX_FLAG;
+    _mutex.unlock();
+
+    _fh->set_blocking(false);
+    _fh->sigio(Callback<void()>(this, &CellularMux::on_sigio));
+
+    // control channel first, then the channels
+    bool success = send_command(0, MUX_SABM, timeout_ms);
+    for (int i = 0; success && i < CHANNEL_COUNT; i++) {
+        success = send_command(_channels[i]._dlci, MUX_SABM, timeout_ms);
+        _channels[i]._open = success;
+    }
+
+    if (!success) {
+        tr_error("CMUX start failed");
+        stop(timeout_ms);
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    tr_info("CMUX started");
+    return NSAPI_ERROR_OK;
+}
+
+void CellularMux::stop(uint32_t timeout_ms)
+{
+    if (!_fh) {
+        return;
+    }
+
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        if (_channels[i]._open) {
+            _channels[i]._open = false;
+            if (!send_command(_channels[i]._dlci, MUX_DISC, timeout_ms)) {
+                tr_warn("CMUX channel %d not closed", _channels[i]._dlci);
+            }
+            if (_channels[i]._sigio_cb) {
+                _channels[i]._sigio_cb();
+            }
+        }
+    }
+
+    // closing the control channel closes the multiplexer
+    (void)send_command(0, MUX_DISC, timeout_ms);
+
+    _mutex.lock();
+    _fh->sigio(nullptr);
+    _fh = NULL;
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        _channels[i]._rx_buf.reset();
+    }
+    _mutex.unlock();
+
+    tr_info("CMUX stopped");
+}
+
+FileHandle *CellularMux::get_channel(Channel channel)
+{
+    if (!_fh || channel < 1 || channel > CHANNEL_COUNT) {
+        return NULL;
+    }
+    return &_channels[channel - 1];
+}
+
+FileHandle *CellularMux::get_file_handle() const
+{
+    return _fh;
+}
+
+void CellularMux::process_rx()
+{
+    uint8_t buf[32];
+
+    _mutex.lock();
+    while (_fh) {
+        ssize_t len = _fh->read(buf, sizeof(buf));
+        if (len <= 0) {
+            break;
+        }
+        for (ssize_t i = 0; i < len; i++) {
+            rx_byte(buf[i]);
+        }
+    }
+    _mutex.unlock();
+}
+
+void CellularMux::wait_rx(int timeout_ms)
+{
+    _mutex.lock();
+    FileHandle *fh = _fh;
+    _mutex.unlock();
+
+    if (fh) {
+        pollfh fhs;
+        fhs.fh = fh;
+        fhs.events = POLLIN;
+        (void)mbed::poll(&fhs, 1, timeout_ms);
+    }
+    process_rx();
+}
+
+void CellularMux::rx_byte(uint8_t byte)
+{
+    switch (_rx_state) {
+        case RX_FLAG:
+            if (byte == MUX_FLAG) {
+                _rx_state = RX_ADDRESS;
+            }
+            break;
+        case RX_ADDRESS:
+            // skip repeated flags
+            if (byte != MUX_FLAG) {
+                _rx_header[0] = byte;
+                _rx_header_len = 1;
+                _rx_state = RX_CONTROL;
+            }
+            break;
+        case RX_CONTROL:
+            _rx_header[_rx_header_len++] = byte;
+            _rx_state = RX_LENGTH;
+            break;
+        case RX_LENGTH:
+            _rx_header[_rx_header_len++] = byte;
+            _rx_len = byte >> 1;
+            if (byte & MUX_EA) {
+                rx_length_done();
+            } else {
+                _rx_state = RX_LENGTH2;
+            }
+            break;
+        case RX_LENGTH2:
+            _rx_header[_rx_header_len++] = byte;
+            _rx_len |= byte << 7;
+            rx_length_done();
+            break;
+        case RX_DATA:
+            _rx_frame[_rx_pos++] = byte;
+            if (_rx_pos == _rx_len) {
+                _rx_state = RX_FCS;
+            }
+            break;
+        case RX_FCS:
+            if (byte == fcs(_rx_header, _rx_header_len)) {
+                handle_frame();
+            } else {
+                tr_warn("CMUX frame FCS error");
+            }
+            _rx_state = RX_CLOSE;
+            break;
+        case RX_CLOSE:
+            // the closing flag may be the opening flag of the next frame
+            _rx_state = (byte == MUX_FLAG) ? RX_ADDRESS : RX_FLAG;
+            break;
+    }
+}
+
+void CellularMux::rx_length_done()
+{
+    _rx_pos = 0;
+    if (_rx_len > MBED_CONF_CELLULAR_MUX_FRAME_SIZE) {
+        tr_warn("CMUX frame too long: %d", _rx_len);
+        _rx_state = RX_FLAG;
+    } else {
+        _rx_state = _rx_len ? RX_DATA : RX_FCS;
+    }
+}
+
+void CellularMux::handle_frame()
+{
+    uint8_t dlci = _rx_header[0] >> 2;
+    uint8_t control = _rx_header[1] & ~MUX_PF;
+
+    switch (control) {
+        case MUX_UA:
+        case MUX_DM:
+            _response = control;
+            _response_dlci = dlci;
+            break;
+        case MUX_DISC:
+            (void)write_frame(dlci, MUX_UA | MUX_PF, false, NULL, 0);
+            if (dlci > 0 && dlci <= CHANNEL_COUNT && _channels[dlci - 1]._open) {
+                tr_info("CMUX channel %d closed by modem", dlci);
+                _channels[dlci - 1]._open = false;
+                if (_channels[dlci - 1]._sigio_cb) {
+                    _channels[dlci - 1]._sigio_cb();
+                }
+            }
+            break;
+        case MUX_UIH:
+        case MUX_UI:
+            if (dlci == 0) {
+                // acknowledge control channel commands (e.g. modem status) by returning them as responses
+                if (_rx_len > 0 && (_rx_frame[0] & MUX_CR)) {
+                    _rx_frame[0] &= ~MUX_CR;
+                    (void)write_frame(0, MUX_UIH, true, _rx_frame, _rx_len);
+                }
+            } else if (dlci <= CHANNEL_COUNT) {
+                MuxChannel &channel = _channels[dlci - 1];
+                size_t len = std::min((size_t)_rx_len, (size_t)(MBED_CONF_CELLULAR_MUX_BUFFER_SIZE - channel._rx_buf.size()));
+                if (len < _rx_len) {
+                    tr_warn("CMUX channel %d buffer full, dropped %d bytes", dlci, _rx_len - len);
+                }
+                channel._rx_buf.push(mbed::Span<const uint8_t>(_rx_frame, len));
+                if (channel._sigio_cb) {
+                    channel._sigio_cb();
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool CellularMux::send_command(uint8_t dlci, uint8_t control, uint32_t timeout_ms)
+{
+    _response_dlci = -1;
+    if (write_frame(dlci, control | MUX_PF, true, NULL, 0) < 0) {
+        return false;
+    }
+
+    uint64_t start_time = rtos::Kernel::get_ms_count();
+    while (_response_dlci != dlci) {
+        uint64_t elapsed = rtos::Kernel::get_ms_count() - start_time;
+        if (elapsed >= timeout_ms) {
+            return false;
+        }
+        wait_rx(timeout_ms - elapsed);
+    }
+
+    return _response == MUX_UA;
+}
+
+ssize_t CellularMux::write_frame(uint8_t dlci, uint8_t control, bool command, const uint8_t *data, size_t size)
+{
+    uint8_t header[5];
+    size_t header_len = 4;
+
+    header[0] = MUX_FLAG;
+    header[1] = (dlci << 2) | (command ? MUX_CR : 0) | MUX_EA;
+    header[2] = control;
+    if (size > 0x7F) {
+        header[3] = (size & 0x7F) << 1;
+        header[4] = size >> 7;
+        header_len = 5;
+    } else {
+        header[3] = (size << 1) | MUX_EA;
+    }
+
+    const uint8_t trailer[2] = { fcs(header + 1, header_len - 1), MUX_FLAG };
+
+    // a frame is written at once so that frames of different channels are not interleaved
+    _mutex.lock();
+    bool success = _fh && write_all(header, header_len) && write_all(data, size) && write_all(trailer, sizeof(trailer));
+    _mutex.unlock();
+
+    return success ? size : -EIO;
+}
+
+bool CellularMux::write_all(const uint8_t *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t len = _fh->write(data, size);
+        if (len == -EAGAIN) {
+            pollfh fhs;
+            fhs.fh = _fh;
+            fhs.events = POLLOUT;
+            if (mbed::poll(&fhs, 1, MUX_TX_TIMEOUT) <= 0) {
+                return false;
+            }
+            continue;
+        }
+        if (len <= 0) {
+            return false;
+        }
+        data += len;
+        size -= len;
+    }
+    return true;
+}
+
+void CellularMux::on_sigio()
+{
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        if (_channels[i]._open && _channels[i]._sigio_cb) {
+            _channels[i]._sigio_cb();
+        }
+    }
+}
+
+uint8_t CellularMux::fcs(const uint8_t *data, size_t size)
+{
+    // CRC-8 with the reversed polynomial 0xE0, see 3GPP TS 27.010 annex B
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x01) ? (crc >> 1) ^ 0xE0 : crc >> 1;
+        }
+    }
+    return 0xFF - crc;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _CELLULAR_MUX_H_
+#define _CELLULAR_MUX_H_
+
+#include "FileHandle.h"
+#include "Callback.h"
+#include "CircularBuffer.h"
+#include "PlatformMutex.h"
+#include "NonCopyable.h"
+#include "nsapi_types.h"
+
+// Maximum information field length of a frame (N1), also given to the modem with AT+CMUX
+#ifndef MBED_CONF_CELLULAR_MUX_FRAME_SIZE
+#define MBED_CONF_CELLULAR_MUX_FRAME_SIZE 127
+#endif
+
+// Size of the receive buffer of each channel
+#ifndef MBED_CONF_CELLULAR_MUX_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_MUX_BUFFER_SIZE 1024
+#endif
+
+namespace mbed {
+
+/** CellularMux class
+ *
+ *  3GPP TS 27.010 multiplexer, basic option. Runs on the serial file handle of a modem that has been put
+ *  in multiplexer mode with AT+CMUX, and exposes its data link connections as FileHandle channels: AT commands
+ *  can be sent on one channel while PPP data flows on another one, without escaping out of data mode.
+ *
+ *  There is no receive thread: frames are read from the serial and dispatched to the channel buffers when a
+ *  channel is read or polled, and channels are woken up with their sigio callback when data is dispatched to
+ *  them or when the serial has data. Data received for a channel whose buffer is full is dropped.
+ */
+class CellularMux : private NonCopyable<CellularMux> {
+public:
+    /** Data link connection identifiers of the channels
+     */
+    enum Channel {
+        CHANNEL_AT = 1,
+        CHANNEL_DATA = 2,
+        CHANNEL_COUNT = 2
+    };
+
+    CellularMux();
+    ~CellularMux();
+
+    /** Start multiplexing: opens the control channel and the channels used for AT commands and data.
+     *  The modem must already have accepted AT+CMUX.
+     *
+     *  @param fh           serial file handle to the modem, it must not be used by anything else until stop()
+     *  @param timeout_ms   time to wait for the modem to accept each channel
+     *  @return             NSAPI_ERROR_OK on success
+     *                      NSAPI_ERROR_IS_CONNECTED if already started
+     *                      NSAPI_ERROR_DEVICE_ERROR if the modem refused or did not reply
+     */
+    nsapi_error_t start(FileHandle *fh, uint32_t timeout_ms);
+
+    /** Close all channels and the multiplexer, the modem returns to AT command mode.
+     *
+     *  @param timeout_ms   time to wait for the modem to acknowledge each channel closure
+     */
+    void stop(uint32_t timeout_ms);
+
+    /** Get the file handle of a channel
+     *
+     *  @param channel  CHANNEL_AT or CHANNEL_DATA
+     *  @return         channel file handle, NULL if multiplexing is not started
+     */
+    FileHandle *get_channel(Channel channel);
+
+    /** Get the serial file handle given to start()
+     *
+     *  @return serial file handle, NULL if multiplexing is not started
+     */
+    FileHandle *get_file_handle() const;
+
+private:
+    class MuxChannel : public FileHandle {
+    public:
+        MuxChannel();
+
+        virtual ssize_t read(void *buffer, size_t size);
+        virtual ssize_t write(const void *buffer, size_t size);
+        virtual off_t seek(off_t offset, int whence = SEEK_SET);
+        virtual int close();
+        virtual int set_blocking(bool blocking);
+        virtual bool is_blocking() const;
+        virtual short poll(short events) const;
+        virtual void sigio(Callback<void()> func);
+
+    private:
+        friend class CellularMux;
+
+        CellularMux *_mux;
+        uint8_t _dlci;
+        bool _blocking;
+        volatile bool _open;
+        Callback<void()> _sigio_cb;
+        CircularBuffer<uint8_t, MBED_CONF_CELLULAR_MUX_BUFFER_SIZE> _rx_buf;
+    };
+
+    enum RxState {
+        RX_FLAG,
+        RX_ADDRESS,
+        RX_CONTROL,
+        RX_LENGTH,
+        RX_LENGTH2,
+        RX_DATA,
+        RX_FCS,
+        RX_CLOSE
+    };
+
+    // read everything available from the serial and dispatch the frames
+    void process_rx();
+
+    // wait for data on the serial for at most timeout_ms and dispatch it
+    void wait_rx(int timeout_ms);
+
+    void rx_byte(uint8_t byte);
+    void rx_length_done();
+    void handle_frame();
+
+    // send a SABM or DISC command and wait for the UA response
+    bool send_command(uint8_t dlci, uint8_t control, uint32_t timeout_ms);
+
+    ssize_t write_frame(uint8_t dlci, uint8_t control, bool command, const uint8_t *data, size_t size);
+    bool write_all(const uint8_t *data, size_t size);
+
+    void on_sigio();
+
+    static uint8_t fcs(const uint8_t *data, size_t size);
+
+    FileHandle *_fh;
+    PlatformMutex _mutex;
+    MuxChannel _channels[CHANNEL_COUNT];
+
+    RxState _rx_state;
+    uint8_t _rx_header[4];
+    uint8_t _rx_header_len;
+    uint16_t _rx_len;
+    uint16_t _rx_pos;
+    uint8_t _rx_frame[MBED_CONF_CELLULAR_MUX_FRAME_SIZE];
+
+    // dlci and control field of the last UA or DM response received
+    volatile int _response_dlci;
+    volatile uint8_t _response;
+};
+
+} // namespace mbed
+
+#endif // _CELLULAR_MUX_H_
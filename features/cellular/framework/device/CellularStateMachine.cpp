@@ -15,10 +15,14 @@
  * limitations under the License.
  */
 
+#include <stdio.h>
 #include "CellularStateMachine.h"
 #include "CellularDevice.h"
 #include "CellularLog.h"
 #include "CellularInformation.h"
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+#include "kvstore_global_api.h"
+#endif
 
 #ifndef MBED_TRACE_MAX_LEVEL
 #define MBED_TRACE_MAX_LEVEL TRACE_LEVEL_INFO
@@ -47,13 +51,18 @@ const int ACTIVE_PDP_CONTEXT = 0x01;
 const int ATTACHED_TO_NETWORK = 0x02;
 const int DEVICE_READY = 0x04;
 
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+// operator of the last attach, stored as the COPS format followed by the operator name
+#define RESUME_PLMN_KEY MBED_CONF_CELLULAR_RESUME_KVSTORE "cellular_plmn"
+#endif
+
 namespace mbed {
 
 CellularStateMachine::CellularStateMachine(CellularDevice &device, events::EventQueue &queue, CellularNetwork &nw) :
     _cellularDevice(device), _state(STATE_INIT), _next_state(_state), _target_state(_state),
     _event_status_cb(), _network(nw), _queue(queue), _sim_pin(0), _retry_count(0),
     _event_timeout(-1), _event_id(-1), _plmn(0), _command_success(false),
-    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0)
+    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0), _resumed(false)
 {
 #if MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY == 0
     _start_time = 0;
@@ -95,6 +104,7 @@ void CellularStateMachine::reset()
     _event_id = -1;
     _is_retry = false;
     _status = 0;
+    _resumed = false;
     _target_state = STATE_INIT;
     enter_to_state(STATE_INIT);
 }
@@ -139,6 +149,7 @@ bool CellularStateMachine::open_sim()
 
     // report current state so callback can set sim pin if needed
     _cb_data.status_data = state;
+    _cb_data.data = &_resumed;
     send_event_cb(CellularSIMStatusChanged);
 
     if (state == CellularDevice::SimStatePinNeeded) {
@@ -251,6 +262,137 @@ bool CellularStateMachine::get_network_registration(CellularNetwork::Registratio
     return true;
 }
 
+bool CellularStateMachine::set_network_reporting()
+{
+    bool success = false;
+    for (int type = 0; type < CellularNetwork::C_MAX; type++) {
+        _cb_data.error = _network.set_registration_urc((CellularNetwork::RegistrationType)type, true);
+        if (!_cb_data.error && (type == CellularNetwork::C_EREG || type == CellularNetwork::C_GREG)) {
+            success = true;
+        }
+    }
+    if (!success) {
+        tr_error("Failed to set CEREG/CGREG URC's for registration");
+        return false;
+    }
+
+    // if packet domain event reporting is not set it's not a stopper. We might lack some events when we are
+    // dropped from the network.
+    _cb_data.error = _network.set_packet_domain_event_reporting(true);
+    if (_cb_data.error == NSAPI_STATUS_ERROR_UNSUPPORTED) {
+        tr_warning("Packet domain event reporting not supported!");
+    } else if (_cb_data.error) {
+        tr_warning("Packet domain event reporting set failed!");
+    }
+    return true;
+}
+
+bool CellularStateMachine::get_operator(char *buf, size_t buf_len)
+{
+    int format = 0;
+    CellularNetwork::operator_t op;
+    if (_network.get_operator_params(format, op) != NSAPI_ERROR_OK) {
+        return false;
+    }
+    const char *name = format == 0 ? op.op_long : format == 1 ? op.op_short : op.op_num;
+    if (!strlen(name)) {
+        return false;
+    }
+    snprintf(buf, buf_len, "%d%s", format, name);
+    return true;
+}
+
+bool CellularStateMachine::is_resumable_operator()
+{
+    char op[MAX_OPERATOR_NAME_LONG + 2];
+    if (!get_operator(op, sizeof(op))) {
+        return false;
+    }
+
+    // in manual registering the modem must be on the requested network, given in numeric format
+    if (_plmn && strlen(_plmn)) {
+        return op[0] == '2' && strcmp(op + 1, _plmn) == 0;
+    }
+
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+    // a network change since the last attach is reported to the application with the full sequence
+    char cached[MAX_OPERATOR_NAME_LONG + 2];
+    size_t len = 0;
+    if (kv_get(RESUME_PLMN_KEY, cached, sizeof(cached) - 1, &len) != MBED_SUCCESS) {
+        return false;
+    }
+    cached[len] = '\0';
+    return strcmp(op, cached) == 0;
+#else
+    return true;
+#endif // MBED_CONF_CELLULAR_RESUME_KVSTORE
+}
+
+void CellularStateMachine::store_operator()
+{
+#if defined(MBED_CONF_CELLULAR_RESUME_KVSTORE)
+    char op[MAX_OPERATOR_NAME_LONG + 2];
+    char cached[MAX_OPERATOR_NAME_LONG + 2];
+    size_t len = 0;
+    if (!get_operator(op, sizeof(op))) {
+        return;
+    }
+    // write only on change to spare the flash
+    if (kv_get(RESUME_PLMN_KEY, cached, sizeof(cached) - 1, &len) == MBED_SUCCESS) {
+        cached[len] = '\0';
+        if (strcmp(op, cached) == 0) {
+            return;
+        }
+    }
+    if (kv_set(RESUME_PLMN_KEY, op, strlen(op), 0) != MBED_SUCCESS) {
+        tr_warn("Failed to store operator");
+    }
+#endif // MBED_CONF_CELLULAR_RESUME_KVSTORE
+}
+
+bool CellularStateMachine::resume()
+{
+    // Queried back to back, without the timeouts and retries of the full sequence. Any unsatisfied
+    // condition falls back to the full sequence.
+    CellularDevice::SimState sim_state = CellularDevice::SimStateUnknown;
+    if (_cellularDevice.get_sim_state(sim_state) != NSAPI_ERROR_OK || sim_state != CellularDevice::SimStateReady) {
+        return false;
+    }
+
+    CellularNetwork::AttachStatus attach_status = CellularNetwork::Detached;
+    if (_network.get_attach(attach_status) != NSAPI_ERROR_OK || attach_status != CellularNetwork::Attached) {
+        return false;
+    }
+
+    CellularNetwork::RegistrationStatus status = CellularNetwork::Unknown;
+    bool registered = false;
+    for (int type = 0; type < CellularNetwork::C_REG && !registered; type++) {
+        (void)get_network_registration((CellularNetwork::RegistrationType)type, status, registered);
+    }
+    if (!registered || !is_resumable_operator()) {
+        return false;
+    }
+
+    // modem init may have reset the URC settings
+    if (!set_network_reporting()) {
+        return false;
+    }
+
+    tr_info("Resuming registration and attach kept by the modem");
+    _resumed = true;
+    _status = ATTACHED_TO_NETWORK;
+
+    _cb_data.error = NSAPI_ERROR_OK;
+    _cb_data.status_data = sim_state;
+    _cb_data.data = &_resumed;
+    send_event_cb(CellularSIMStatusChanged);
+
+    _cb_data.status_data = status;
+    send_event_cb(CellularRegistrationStatusChanged);
+
+    return true;
+}
+
 void CellularStateMachine::report_failure(const char *msg)
 {
     tr_error("CellularStateMachine failure: %s", msg);
@@ -308,6 +450,7 @@ void CellularStateMachine::state_init()
     tr_info("Start connecting (timeout %d ms)", _state_timeout_power_on);
     _cb_data.error = _cellularDevice.is_ready();
     _status = _cb_data.error ? 0 : DEVICE_READY;
+    _resumed = false;
     if (_cb_data.error != NSAPI_ERROR_OK) {
         _event_timeout = _start_time;
         if (_start_time > 0) {
@@ -382,8 +525,14 @@ void CellularStateMachine::state_device_ready()
 #endif // MBED_CONF_MBED_TRACE_ENABLE
 
             if (device_ready()) {
+                // a modem that stayed powered, for example over a reboot or in PSM, may still be registered and attached
+                bool was_ready = _status & DEVICE_READY;
                 _status = 0;
-                enter_to_state(STATE_SIM_PIN);
+                if (was_ready && _target_state > STATE_DEVICE_READY && resume()) {
+                    enter_to_state(STATE_ATTACHING_NETWORK);
+                } else {
+                    enter_to_state(STATE_SIM_PIN);
+                }
             } else {
                 tr_warning("Power cycle CellularDevice and restart connecting");
                 (void) _cellularDevice.soft_power_off();
@@ -408,15 +557,7 @@ void CellularStateMachine::state_sim_pin()
     change_timeout(_state_timeout_sim_pin);
     tr_info("Setup SIM (timeout %d ms)", _state_timeout_sim_pin);
     if (open_sim()) {
-        bool success = false;
-        for (int type = 0; type < CellularNetwork::C_MAX; type++) {
-            _cb_data.error = _network.set_registration_urc((CellularNetwork::RegistrationType)type, true);
-            if (!_cb_data.error && (type == CellularNetwork::C_EREG || type == CellularNetwork::C_GREG)) {
-                success = true;
-            }
-        }
-        if (!success) {
-            tr_error("Failed to set CEREG/CGREG URC's for registration");
+        if (!set_network_reporting()) {
             retry_state_or_fail();
             return;
         }
@@ -429,15 +570,6 @@ void CellularStateMachine::state_sim_pin()
             _status |= ATTACHED_TO_NETWORK;
             tr_debug("Cellular already attached.");
         }
-
-        // if packet domain event reporting is not set it's not a stopper. We might lack some events when we are
-        // dropped from the network.
-        _cb_data.error = _network.set_packet_domain_event_reporting(true);
-        if (_cb_data.error == NSAPI_STATUS_ERROR_UNSUPPORTED) {
-            tr_warning("Packet domain event reporting not supported!");
-        } else if (_cb_data.error) {
-            tr_warning("Packet domain event reporting set failed!");
-        }
         enter_to_state(STATE_SIGNAL_QUALITY);
     } else {
         retry_state_or_fail();
@@ -489,6 +621,9 @@ void CellularStateMachine::state_attaching()
         _cb_data.error = _network.set_attach();
     }
     if (_cb_data.error == NSAPI_ERROR_OK) {
+        if (!_resumed) {
+            store_operator();
+        }
         _cb_data.status_data = CellularNetwork::Attached;
         send_event_cb(_current_event);
     } else {
@@ -29,6 +29,11 @@ class CellularDevice;
 /** CellularStateMachine class
  *
  *  Finite State Machine for attaching to cellular network. Used by CellularDevice.
+ *
+ *  If the modem is already powered when the state machine starts, for example after a reboot or a PSM wake,
+ *  and is still registered and attached, the SIM, signal quality and registration states are skipped.
+ *  With cellular.resume-kvstore set to a KVStore path, the operator of the last attach is stored there and
+ *  automatic registration is resumed only on the same operator.
  */
 class CellularStateMachine {
 public:
@@ -146,6 +151,11 @@ private:
     bool get_network_registration(CellularNetwork::RegistrationType type, CellularNetwork::RegistrationStatus &status, bool &is_registered);
     bool is_registered();
     bool device_ready();
+    bool set_network_reporting();
+    bool get_operator(char *buf, size_t buf_len);
+    bool is_resumable_operator();
+    void store_operator();
+    bool resume();
 
     // state functions to keep state machine simple
     void state_init();
@@ -191,6 +201,8 @@ private:
     cell_callback_data_t _cb_data;
     cellular_connection_status_t _current_event;
     int _status;
+    // registration and attach were kept by the modem, see resume()
+    bool _resumed;
     PlatformMutex _mutex;
 
     // Cellular state timeouts
@@ -110,6 +110,7 @@ void GEMALTO_CINTERION::init_module_bgs2()
         1,  // PROPERTY_IP_TCP
         1,  // PROPERTY_IP_UDP
         100,// PROPERTY_AT_SEND_DELAY, if baud is below 9600 this must be longer
+        0,  // PROPERTY_AT_CMD_CONCATENATION
     };
     set_cellular_properties(cellular_properties);
     _module = ModuleBGS2;
@@ -139,6 +140,7 @@ void GEMALTO_CINTERION::init_module_els61()
         1,  // PROPERTY_IP_TCP
         1,  // PROPERTY_IP_UDP
         100,// PROPERTY_AT_SEND_DELAY, if baud is below 9600 this must be longer
+        0,  // PROPERTY_AT_CMD_CONCATENATION
     };
     set_cellular_properties(cellular_properties);
     _module = ModuleELS61;
@@ -168,6 +170,7 @@ void GEMALTO_CINTERION::init_module_ems31()
         1,  // PROPERTY_IP_TCP
         1,  // PROPERTY_IP_UDP
         100,// PROPERTY_AT_SEND_DELAY, if baud is below 9600 this must be longer
+        0,  // PROPERTY_AT_CMD_CONCATENATION
     };
     set_cellular_properties(cellular_properties);
     _module = ModuleEMS31;
@@ -197,6 +200,7 @@ void GEMALTO_CINTERION::init_module_ehs5e()
         1,  // PROPERTY_IP_TCP
         1,  // PROPERTY_IP_UDP
         100,// PROPERTY_AT_SEND_DELAY, if baud is below 9600 this must be longer
+        0,  // PROPERTY_AT_CMD_CONCATENATION
     };
     set_cellular_properties(cellular_properties);
     _module = ModuleEHS5E;
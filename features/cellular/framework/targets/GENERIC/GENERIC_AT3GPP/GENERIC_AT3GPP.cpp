@@ -42,6 +42,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     0,  // PROPERTY_IP_TCP
     0,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    0,  // PROPERTY_AT_CMD_CONCATENATION
 };
 
 GENERIC_AT3GPP::GENERIC_AT3GPP(FileHandle *fh) : AT_CellularDevice(fh)
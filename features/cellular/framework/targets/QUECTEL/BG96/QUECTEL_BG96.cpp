@@ -66,6 +66,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     1,  // PROPERTY_IP_TCP
     1,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    1,  // PROPERTY_AT_CMD_CONCATENATION
 };
 
 QUECTEL_BG96::QUECTEL_BG96(FileHandle *fh, PinName pwr, bool active_high, PinName rst)
@@ -430,8 +430,7 @@ nsapi_size_or_error_t QUECTEL_BG96_CellularStack::socket_recvfrom_impl(CellularS
             port = _at.read_int();
         }
         // do not read more than buffer size
-        recv_len = recv_len > (nsapi_size_or_error_t)size ? size : recv_len;
-        _at.read_bytes((uint8_t *)buffer, recv_len);
+        recv_len = read_socket_data(buffer, size, recv_len);
     }
     _at.resp_stop();
 
@@ -72,6 +72,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     0,  // PROPERTY_IP_TCP
     0,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    0,  // PROPERTY_AT_CMD_CONCATENATION
 };
 
 QUECTEL_EC2X::QUECTEL_EC2X(FileHandle *fh, PinName pwr, bool active_high, PinName rst)
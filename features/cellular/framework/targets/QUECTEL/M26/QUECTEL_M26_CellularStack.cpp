@@ -501,8 +501,10 @@ nsapi_size_or_error_t QUECTEL_M26_CellularStack::socket_recvfrom_impl(CellularSo
             port = _at.read_int();
             _at.read_string(type, sizeof(type));
             recv_len = _at.read_int();
-            _at.read_bytes((uint8_t *)buffer + len, recv_len);
-            len += recv_len;
+            nsapi_size_or_error_t data_len = read_socket_data((uint8_t *)buffer + len, size - len, recv_len);
+            if (data_len > 0) {
+                len += data_len;
+            }
         }
         _at.resp_stop();
 
@@ -49,6 +49,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     1,  // PROPERTY_IP_TCP
     1,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    0,  // PROPERTY_AT_CMD_CONCATENATION
 };
 
 RM1000_AT::RM1000_AT(FileHandle *fh) : AT_CellularDevice(fh)
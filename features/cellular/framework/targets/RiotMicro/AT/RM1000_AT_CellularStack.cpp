@@ -218,6 +218,7 @@ nsapi_size_or_error_t RM1000_AT_CellularStack::socket_recvfrom_impl(CellularSock
     nsapi_size_t read_blk;
     nsapi_size_t count = 0;
     nsapi_size_t rsorcv_sz;
+    nsapi_size_or_error_t read_len;
     char ipAddress[NSAPI_IP_SIZE];
     int port = 0;
     Timer timer;
@@ -245,10 +246,8 @@ nsapi_size_or_error_t RM1000_AT_CellularStack::socket_recvfrom_impl(CellularSock
                 _at.read_string(ipAddress, sizeof(ipAddress));
                 port = _at.read_int();
             }
-            if (rsorcv_sz > size) {
-                rsorcv_sz = size;
-            }
-            _at.read_bytes((uint8_t *)buffer + count, rsorcv_sz);
+            read_len = read_socket_data((uint8_t *)buffer + count, size, rsorcv_sz);
+            rsorcv_sz = read_len > 0 ? read_len : 0;
             _at.resp_stop();
 
             // Must use what +RSORCV returns here as it may be less or more than we asked for
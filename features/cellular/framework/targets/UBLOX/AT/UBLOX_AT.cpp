@@ -42,6 +42,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     1,  // PROPERTY_IP_TCP
     1,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    1,  // PROPERTY_AT_CMD_CONCATENATION
 };
 #elif defined(UBX_MDM_SARA_U2XX) || defined(UBX_MDM_SARA_G3XX)
 static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
@@ -69,6 +70,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     1,  // PROPERTY_IP_TCP
     1,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    1,  // PROPERTY_AT_CMD_CONCATENATION
 };
 #else
 static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
@@ -92,6 +94,7 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
     0,  // PROPERTY_IP_TCP
     0,  // PROPERTY_IP_UDP
     0,  // PROPERTY_AT_SEND_DELAY
+    1,  // PROPERTY_AT_CMD_CONCATENATION
 };
 #endif
 
@@ -237,8 +237,8 @@ nsapi_size_or_error_t UBLOX_AT_CellularStack::socket_recvfrom_impl(CellularSocke
     nsapi_size_t read_blk;
     nsapi_size_t count = 0;
     nsapi_size_t usorf_sz;
+    nsapi_size_or_error_t read_len;
     char ipAddress[NSAPI_IP_SIZE];
-    uint8_t ch = 0;
     int port = 0;
     Timer timer;
 
@@ -265,13 +265,11 @@ nsapi_size_or_error_t UBLOX_AT_CellularStack::socket_recvfrom_impl(CellularSocke
                 _at.read_string(ipAddress, sizeof(ipAddress));
                 port = _at.read_int();
                 usorf_sz = _at.read_int();
-                if (usorf_sz > size) {
-                    usorf_sz = size;
-                } else {
+                if (usorf_sz <= size) {
                     packet_received = true;
                 }
-                _at.read_bytes(&ch, 1);
-                _at.read_bytes((uint8_t *)buffer + count, usorf_sz);
+                read_len = read_socket_data((uint8_t *)buffer + count, size, usorf_sz, true);
+                usorf_sz = read_len > 0 ? read_len : 0;
                 _at.resp_stop();
 
                 // Must use what +USORF returns here as it may be less or more than we asked for
@@ -311,11 +309,8 @@ nsapi_size_or_error_t UBLOX_AT_CellularStack::socket_recvfrom_impl(CellularSocke
                 _at.resp_start("+USORD:");
                 _at.skip_param(); // receiving socket id
                 usorf_sz = _at.read_int();
-                if (usorf_sz > size) {
-                    usorf_sz = size;
-                }
-                _at.read_bytes(&ch, 1);
-                _at.read_bytes((uint8_t *)buffer + count, usorf_sz);
+                read_len = read_socket_data((uint8_t *)buffer + count, size, usorf_sz, true);
+                usorf_sz = read_len > 0 ? read_len : 0;
                 _at.resp_stop();
 
                 // Must use what +USORD returns here as it may be less or more than we asked for
@@ -488,6 +488,55 @@ void generate_derived_key_wrong_key_type_test()
 
 }
 
+/*
+ * Test that cached derived keys match freshly derived ones, and that a new root of trust drops them
+ */
+void generate_derived_key_cache_test()
+{
+    unsigned char output1[DEVICE_KEY_16BYTE];
+    unsigned char output2[DEVICE_KEY_16BYTE];
+    unsigned char other[DEVICE_KEY_16BYTE];
+    unsigned char salt[] = "Once upon a time, I worked for the circus and I lived in Omaha.";
+    unsigned char other_salt[] = "Some other salt";
+    uint32_t key[DEVICE_KEY_16BYTE / sizeof(uint32_t)];
+    DeviceKey &devkey = DeviceKey::get_instance();
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *inner_store = kv_map.get_internal_kv_instance(NULL);
+    TEST_ASSERT_NOT_EQUAL(NULL, inner_store);
+
+    int ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+    memcpy(key, "1234567812345678", sizeof(key));
+    ret = devkey.device_inject_root_of_trust(key, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = devkey.generate_derived_key(salt, sizeof(salt), output1, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    ret = devkey.generate_derived_key(other_salt, sizeof(other_salt), other, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_NOT_EQUAL(0, memcmp(output1, other, DEVICE_KEY_16BYTE));
+
+    ret = devkey.generate_derived_key(salt, sizeof(salt), output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+
+    devkey.purge_derived_keys();
+    ret = devkey.generate_derived_key(salt, sizeof(salt), output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+
+    // A key derived from a different root of trust must not come out of the cache
+    ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+    memcpy(key, "8765432187654321", sizeof(key));
+    ret = devkey.device_inject_root_of_trust(key, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = devkey.generate_derived_key(salt, sizeof(salt), output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_NOT_EQUAL(0, memcmp(output1, output2, DEVICE_KEY_16BYTE));
+}
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -509,7 +558,8 @@ Case cases[] = {
 #ifndef MBEDTLS_AES_ONLY_128_BIT_KEY_LENGTH
     Case("Device Key - derived key key type 32",             generate_derived_key_key_type_32_test,             greentea_failure_handler),
 #endif
-    Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler)
+    Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler),
+    Case("Device Key - derived key cache",                   generate_derived_key_cache_test,                   greentea_failure_handler)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
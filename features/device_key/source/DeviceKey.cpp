@@ -19,6 +19,7 @@
 #if DEVICEKEY_ENABLED
 #include "mbedtls/cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "features/storage/kvstore/include/KVStore.h"
 #include "features/storage/kvstore/tdbstore/TDBStore.h"
 #include "features/storage/kvstore/kv_map/KVMap.h"
@@ -37,8 +38,35 @@
 #else
 
 
+#ifndef MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+#define MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES 4
+#endif
+
 namespace mbed {
 
+// Salt of the key authenticating cache entries, derived from the root of trust
+static const char cache_mac_salt[] = "DEVKEY_CACHE_MAC";
+
+// derived key cache entry, keyed by salt and key type
+struct DeviceKey::derived_key_t {
+    unsigned char *salt = nullptr;
+    size_t salt_size = 0;
+    uint16_t key_type = 0;
+    uint32_t last_use = 0;
+    unsigned char key[DEVICE_KEY_32BYTE] = { 0 };
+    unsigned char mac[DEVICE_KEY_16BYTE] = { 0 };
+
+    void clear()
+    {
+        delete[] salt;
+        salt = nullptr;
+        salt_size = 0;
+        key_type = 0;
+        mbedtls_platform_zeroize(key, sizeof(key));
+        mbedtls_platform_zeroize(mac, sizeof(mac));
+    }
+};
+
 #define DEVKEY_WRITE_UINT32_LE( dst, src )                              \
     do                                                                  \
     {                                                                   \
@@ -55,8 +83,12 @@ namespace mbed {
     } while( 0 )
 
 
-DeviceKey::DeviceKey()
+DeviceKey::DeviceKey() :
+    _derived_keys(0), _derived_key_tick(0), _cache_mac_key_set(false)
 {
+    if (MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES) {
+        _derived_keys = new derived_key_t[MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES];
+    }
 
     int ret = kv_init_storage_config();
     if (ret != MBED_SUCCESS) {
@@ -73,6 +105,8 @@ DeviceKey::DeviceKey()
 
 DeviceKey::~DeviceKey()
 {
+    purge_derived_keys();
+    delete[] _derived_keys;
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
@@ -91,16 +125,150 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
 
     actual_size = DEVICE_KEY_16BYTE != ikey_type ? DEVICE_KEY_32BYTE : DEVICE_KEY_16BYTE;
 
+    _mutex.lock();
+
+    if (get_cached_key(salt, isalt_size, output, ikey_type)) {
+        _mutex.unlock();
+        return DEVICEKEY_SUCCESS;
+    }
+
     //First try to read the key from KVStore
     int ret = read_key_from_kvstore(key_buff, actual_size);
     if (DEVICEKEY_SUCCESS != ret) {
+        _mutex.unlock();
         return ret;
     }
 
     ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+    if (DEVICEKEY_SUCCESS == ret && _derived_keys) {
+        if (!_cache_mac_key_set) {
+            _cache_mac_key_set = DEVICEKEY_SUCCESS == get_derived_key(key_buff, actual_size,
+                                                                      (const unsigned char *)cache_mac_salt,
+                                                                      sizeof(cache_mac_salt) - 1,
+                                                                      _cache_mac_key, DEVICE_KEY_16BYTE);
+        }
+        if (_cache_mac_key_set) {
+            cache_key(salt, isalt_size, output, ikey_type);
+        }
+    }
+
+    mbedtls_platform_zeroize(key_buff, sizeof(key_buff));
+    _mutex.unlock();
     return ret;
 }
 
+void DeviceKey::purge_derived_keys()
+{
+    _mutex.lock();
+    if (_derived_keys) {
+        for (uint32_t i = 0; i < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES; i++) {
+            _derived_keys[i].clear();
+        }
+    }
+    mbedtls_platform_zeroize(_cache_mac_key, sizeof(_cache_mac_key));
+    _cache_mac_key_set = false;
+    _mutex.unlock();
+}
+
+int DeviceKey::derived_key_mac(const derived_key_t &entry, unsigned char *mac)
+{
+    mbedtls_cipher_context_t ctx;
+    unsigned char salt_size_enc[4] = {0};
+    unsigned char key_type_enc[4] = {0};
+
+    DEVKEY_WRITE_UINT32_LE(salt_size_enc, entry.salt_size);
+    DEVKEY_WRITE_UINT32_LE(key_type_enc, entry.key_type);
+
+    mbedtls_cipher_init(&ctx);
+    int ret = mbedtls_cipher_setup(&ctx, mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB));
+    if (!ret) {
+        ret = mbedtls_cipher_cmac_starts(&ctx, _cache_mac_key, DEVICE_KEY_16BYTE * 8);
+    }
+    if (!ret) {
+        ret = mbedtls_cipher_cmac_update(&ctx, salt_size_enc, sizeof(salt_size_enc));
+    }
+    if (!ret) {
+        ret = mbedtls_cipher_cmac_update(&ctx, entry.salt, entry.salt_size);
+    }
+    if (!ret) {
+        ret = mbedtls_cipher_cmac_update(&ctx, key_type_enc, sizeof(key_type_enc));
+    }
+    if (!ret) {
+        ret = mbedtls_cipher_cmac_update(&ctx, entry.key, entry.key_type);
+    }
+    if (!ret) {
+        ret = mbedtls_cipher_cmac_finish(&ctx, mac);
+    }
+    mbedtls_cipher_free(&ctx);
+
+    return ret ? DEVICEKEY_ERR_CMAC_GENERIC_FAILURE : DEVICEKEY_SUCCESS;
+}
+
+bool DeviceKey::get_cached_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output,
+                               uint16_t ikey_type)
+{
+    if (!_derived_keys || !_cache_mac_key_set) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES; i++) {
+        derived_key_t &entry = _derived_keys[i];
+        if (!entry.salt || entry.key_type != ikey_type || entry.salt_size != isalt_size ||
+                memcmp(entry.salt, isalt, isalt_size)) {
+            continue;
+        }
+
+        // Don't hand out a key that was corrupted in RAM, derive it again instead
+        unsigned char mac[DEVICE_KEY_16BYTE];
+        unsigned char diff = 0;
+        if (derived_key_mac(entry, mac)) {
+            return false;
+        }
+        for (size_t j = 0; j < sizeof(mac); j++) {
+            diff |= mac[j] ^ entry.mac[j];
+        }
+        if (diff) {
+            tr_warning("DeviceKey: cached key failed authentication, deriving it again");
+            entry.clear();
+            return false;
+        }
+
+        entry.last_use = ++_derived_key_tick;
+        memcpy(output, entry.key, ikey_type);
+        return true;
+    }
+
+    return false;
+}
+
+void DeviceKey::cache_key(const unsigned char *isalt, size_t isalt_size, const unsigned char *key,
+                          uint16_t ikey_type)
+{
+    // Take a free entry, or else the least recently used
+    derived_key_t *entry = &_derived_keys[0];
+    for (uint32_t i = 0; i < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES; i++) {
+        derived_key_t *candidate = &_derived_keys[i];
+        if (!candidate->salt) {
+            entry = candidate;
+            break;
+        }
+        if (candidate->last_use < entry->last_use) {
+            entry = candidate;
+        }
+    }
+
+    entry->clear();
+    entry->salt = new unsigned char[isalt_size ? isalt_size : 1];
+    memcpy(entry->salt, isalt, isalt_size);
+    entry->salt_size = isalt_size;
+    entry->key_type = ikey_type;
+    entry->last_use = ++_derived_key_tick;
+    memcpy(entry->key, key, ikey_type);
+    if (derived_key_mac(*entry, entry->mac)) {
+        entry->clear();
+    }
+}
+
 int DeviceKey::device_inject_root_of_trust(uint32_t *value, size_t isize)
 {
     return write_key_to_kvstore(value, isize);
@@ -138,6 +306,9 @@ int DeviceKey::write_key_to_kvstore(uint32_t *input, size_t isize)
         return DEVICEKEY_KVSTORE_UNPREDICTED_ERROR;
     }
 
+    // Keys cached so far came from whatever was stored before
+    purge_derived_keys();
+
     return DEVICEKEY_SUCCESS;
 }
 
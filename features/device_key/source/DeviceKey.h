@@ -19,6 +19,7 @@
 #include "stddef.h"
 #include "stdint.h"
 #include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
 
 #define DEVICEKEY_ENABLED 1
 
@@ -90,6 +91,9 @@ public:
     ~DeviceKey();
 
     /** Derive a new key based on the salt string.
+     *  Recent derivations are kept in a small RAM cache, so deriving the same key again does not
+     *  read the root of trust from storage or rerun the KDF. Each cache entry is checked against a
+     *  CMAC before it is used, and rederived if the check fails.
      * @param isalt Input buffer used to create the new key. Same input always generates the same key
      * @param isalt_size Size of the data in salt buffer.
      * @param output Buffer to receive the derived key. Size must be 16 bytes or 32 bytes
@@ -117,10 +121,49 @@ public:
      */
     int generate_root_of_trust();
 
+    /** Wipe all cached derived keys.
+     *  The cache is purged whenever a root of trust is written through this class. Call this after
+     *  any other change to the stored root of trust, such as a reset of the internal KVStore.
+     */
+    void purge_derived_keys();
+
 private:
+    // Forward declaration
+    struct derived_key_t;
+
+    PlatformMutex _mutex;
+    derived_key_t *_derived_keys;
+    uint32_t _derived_key_tick;
+    unsigned char _cache_mac_key[DEVICE_KEY_16BYTE];
+    bool _cache_mac_key_set;
+
     // Private constructor, as class is a singleton
     DeviceKey();
 
+    /** Calculate the CMAC protecting a derived key cache entry
+     * @param entry Cache entry
+     * @param mac Buffer for the 16 byte result
+     * @return 0 on success, negative error code on failure
+     */
+    int derived_key_mac(const derived_key_t &entry, unsigned char *mac);
+
+    /** Look up a derived key in the cache
+     * @param isalt Salt the key was derived from
+     * @param isalt_size Size of the salt
+     * @param output Buffer to receive the derived key
+     * @param ikey_type Type of the required key
+     * @return true if the key was found and its CMAC checked out
+     */
+    bool get_cached_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
+
+    /** Store a derived key in the cache, replacing the least recently used entry
+     * @param isalt Salt the key was derived from
+     * @param isalt_size Size of the salt
+     * @param key Derived key
+     * @param ikey_type Type of the key
+     */
+    void cache_key(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type);
+
     /** Read a device key from the KVStore
      * @param output Buffer for the returned key.
      * @param size Input: The size of the output buffer.
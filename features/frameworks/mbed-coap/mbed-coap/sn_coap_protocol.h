@@ -29,6 +29,29 @@ extern "C" {
 
 #include "sn_coap_header.h"
 
+/**
+ * \brief Received blockwise payload callback
+ *
+ * \param *coap_msg_ptr Received message, payload_ptr and payload_len hold the block
+ * \param *src_addr_ptr Source address of the message
+ * \param offset Offset of the block in the whole payload
+ * \param *param Parameter given to sn_coap_protocol_parse()
+ */
+typedef void sn_coap_block_rx_cb(const sn_coap_hdr_s *coap_msg_ptr, const sn_nsdl_addr_s *src_addr_ptr, uint32_t offset, void *param);
+
+/**
+ * \brief Blockwise payload read callback
+ *
+ * \param *coap_msg_ptr Message being sent
+ * \param offset Offset of the block in the whole payload
+ * \param *block_ptr Buffer to fill with the block
+ * \param block_len Length of the block
+ * \param *param Parameter given to sn_coap_protocol_build()
+ *
+ * \return 0 on success, negative value cancels sending the block
+ */
+typedef int8_t sn_coap_block_tx_cb(const sn_coap_hdr_s *coap_msg_ptr, uint32_t offset, uint8_t *block_ptr, uint16_t block_len, void *param);
+
 /**
  * \fn struct coap_s *sn_coap_protocol_init(void* (*used_malloc_func_ptr)(uint16_t), void (*used_free_func_ptr)(void*),
         uint8_t (*used_tx_callback_ptr)(sn_nsdl_capab_e , uint8_t *, uint16_t, sn_nsdl_addr_s *),
@@ -260,6 +283,28 @@ extern int8_t sn_coap_convert_block_size(uint16_t block_size);
  */
 extern int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle, uint8_t handle_response);
 
+/**
+ * \fn int8_t sn_coap_protocol_set_blockwise_stream(struct coap_s *handle, sn_coap_block_rx_cb *block_rx_cb, sn_coap_block_tx_cb *block_tx_cb)
+ *
+ * \brief Stream blockwise payloads through callbacks instead of collecting them to memory.
+ *
+ * With block_rx_cb set, each received Block1 request block and each Block2 response block
+ * (when responses are handled internally) is passed to block_rx_cb as it arrives, in order.
+ * The last block is then returned as COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED with no payload.
+ *
+ * With block_tx_cb set, a message built with payload_ptr NULL and payload_len set to the
+ * total length is sent blockwise, and each block is read through block_tx_cb when it is sent.
+ *
+ * Memory use for a transfer is then bounded by one block.
+ *
+ * \param *handle Pointer to CoAP library handle
+ * \param *block_rx_cb Called with each received block, or NULL to collect payloads to memory
+ * \param *block_tx_cb Called to read each block to be sent, or NULL
+ *
+ * \return  0 = success, -1 = failure
+ */
+extern int8_t sn_coap_protocol_set_blockwise_stream(struct coap_s *handle, sn_coap_block_rx_cb *block_rx_cb, sn_coap_block_tx_cb *block_tx_cb);
+
 /**
  * \fn void sn_coap_protocol_clear_sent_blockwise_messages(struct coap_s *handle)
  *
@@ -219,6 +219,20 @@
 #define SN_COAP_MAX_ALLOWED_DUPLICATION_MESSAGE_COUNT   6
 #endif
 
+/**
+ * \def SN_COAP_LOOKUP_HASH_SIZE
+ * \brief Number of hash buckets used for finding stored duplication detection
+ * infos and re-sending messages by message ID. Must be a power of 2.
+ * By default 8 buckets.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_LOOKUP_HASH_SIZE
+#define SN_COAP_LOOKUP_HASH_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_LOOKUP_HASH_SIZE
+#endif
+
+#ifndef SN_COAP_LOOKUP_HASH_SIZE
+#define SN_COAP_LOOKUP_HASH_SIZE                    8
+#endif
+
 /**
  * \def SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED
  * \brief Maximum time in seconds howe long message is kept for duplicate detection.
@@ -27,6 +27,7 @@
 #include "ns_list.h"
 #include "sn_coap_header_internal.h"
 #include "mbed-coap/sn_config.h"
+#include "mbed-coap/sn_coap_protocol.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,10 +53,12 @@ typedef struct coap_send_msg_ {
 
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
-    ns_list_link_t      link;
+    ns_list_link_t      link;               /* Resending queue, ordered by resending_time */
+    ns_list_link_t      hash_link;          /* Message ID hash bucket */
 } coap_send_msg_s;
 
 typedef NS_LIST_HEAD(coap_send_msg_s, link) coap_send_msg_list_t;
+typedef NS_LIST_HEAD(coap_send_msg_s, hash_link) coap_send_msg_hash_list_t;
 
 /* Structure which is stored to Linked list for message duplication detection purposes */
 typedef struct coap_duplication_info_ {
@@ -65,10 +68,12 @@ typedef struct coap_duplication_info_ {
     uint8_t             *packet_ptr;
     sn_nsdl_addr_s      *address;
     void                *param;
-    ns_list_link_t      link;
+    ns_list_link_t      link;       /* Duplication list, ordered by timestamp */
+    ns_list_link_t      hash_link;  /* Address and message ID hash bucket */
 } coap_duplication_info_s;
 
 typedef NS_LIST_HEAD(coap_duplication_info_s, link) coap_duplication_info_list_t;
+typedef NS_LIST_HEAD(coap_duplication_info_s, hash_link) coap_duplication_info_hash_list_t;
 
 /* Structure which is stored to Linked list for blockwise messages sending purposes */
 typedef struct coap_blockwise_msg_ {
@@ -113,17 +118,22 @@ struct coap_s {
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        coap_send_msg_hash_list_t resent_msgs_hash[SN_COAP_LOOKUP_HASH_SIZE]; /* Same messages, hashed by message ID */
         uint16_t count_resent_msgs;
+        uint32_t size_resent_msgs; /* Total packet length of active resending messages */
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_hash_list_t duplication_msgs_hash[SN_COAP_LOOKUP_HASH_SIZE]; /* Same messages, hashed by address and message ID */
         uint16_t                      count_duplication_msgs;
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        sn_coap_block_rx_cb          *sn_coap_block_rx_callback; /* If set, received blockwise payloads are passed here instead of being stored */
+        sn_coap_block_tx_cb          *sn_coap_block_tx_callback; /* Reads blocks of messages sent without payload_ptr */
     #endif
 
     uint32_t system_time;    /* System time seconds */
@@ -37,16 +37,19 @@
 
 #define TRACE_GROUP "coap"
 /* * * * LOCAL FUNCTION PROTOTYPES * * * */
-static int8_t   sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const sn_coap_hdr_s *src_coap_msg_ptr);
-static int8_t   sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, const sn_coap_hdr_s *src_coap_msg_ptr);
+static int16_t  sn_coap_builder_build(uint8_t *dst_packet_data_ptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr);
+static bool     sn_coap_builder_fits(const uint8_t *dst_packet_data_ptr, const uint8_t *dst_end_ptr, uint32_t len);
+static int8_t   sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr);
+static int8_t   sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr);
 static uint16_t sn_coap_builder_options_calc_option_size(uint16_t query_len, const uint8_t *query_ptr, sn_coap_option_numbers_e option);
-static int16_t  sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet_data_pptr, uint16_t option_len, const uint8_t *option_ptr, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number);
-static void     sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_packet_data_pptr, const uint8_t *src_pptr, uint16_t src_len_ptr, sn_coap_option_numbers_e option, uint16_t *previous_option_number);
-static uint8_t  sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packet_data_pptr, uint32_t value, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number);
+static bool     sn_coap_builder_options_check_option_part_len(uint16_t one_query_part_len, sn_coap_option_numbers_e option);
+static int16_t  sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, uint16_t option_len, const uint8_t *option_ptr, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number);
+static int8_t   sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const uint8_t *src_pptr, uint16_t src_len_ptr, sn_coap_option_numbers_e option, uint16_t *previous_option_number);
+static uint8_t  sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, uint32_t value, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number);
 static uint8_t  sn_coap_builder_options_get_option_part_count(uint16_t query_len, const uint8_t *query_ptr, sn_coap_option_numbers_e option);
 static uint16_t sn_coap_builder_options_get_option_part_length_from_whole_option_string(uint16_t query_len, const uint8_t *query_ptr, uint8_t query_index, sn_coap_option_numbers_e option);
 static int16_t  sn_coap_builder_options_get_option_part_position(uint16_t query_len, const uint8_t *query_ptr, uint8_t query_index, sn_coap_option_numbers_e option);
-static void     sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, const sn_coap_hdr_s *src_coap_msg_ptr);
+static void     sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr);
 static uint8_t  sn_coap_builder_options_calculate_jump_need(const sn_coap_hdr_s *src_coap_msg_ptr);
 
 sn_coap_hdr_s *sn_coap_build_response(struct coap_s *handle, const sn_coap_hdr_s *coap_packet_ptr, uint8_t msg_code)
@@ -103,32 +106,48 @@ int16_t sn_coap_builder(uint8_t *dst_packet_data_ptr, const sn_coap_hdr_s *src_c
 
 int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, const sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size)
 {
-    uint8_t *base_packet_data_ptr;
+    (void)blockwise_payload_size;
 
     /* * * * Check given pointers  * * * */
     if (dst_packet_data_ptr == NULL || src_coap_msg_ptr == NULL) {
         return -2;
     }
 
-    /* Initialize given Packet data memory area with zero values */
-    uint16_t dst_byte_count_to_be_built = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_msg_ptr, blockwise_payload_size);
-    if (!dst_byte_count_to_be_built) {
-        tr_error("sn_coap_builder_2 - failed to allocate message!");
-        return -1;
+    /* Caller has sized the destination, so it is not checked */
+    return sn_coap_builder_build(dst_packet_data_ptr, NULL, src_coap_msg_ptr);
+}
+
+int16_t sn_coap_builder_3(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, const sn_coap_hdr_s *src_coap_msg_ptr)
+{
+    /* * * * Check given pointers  * * * */
+    if (dst_packet_data_ptr == NULL || src_coap_msg_ptr == NULL) {
+        return -2;
     }
 
-    // XXX: this should not be needed anymore but I have no courage to remove it yet.
-    memset(dst_packet_data_ptr, 0, dst_byte_count_to_be_built);
+    return sn_coap_builder_build(dst_packet_data_ptr, dst_packet_data_ptr + dst_packet_data_len, src_coap_msg_ptr);
+}
 
+/**
+ * \fn static int16_t sn_coap_builder_build(uint8_t *dst_packet_data_ptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr)
+ *
+ * \brief Builds Packet data in one pass, checking values of the CoAP message while writing them
+ *
+ * \param *dst_end_ptr is end of destination, or NULL if destination is known to be large enough
+ *
+ * \return Return value is byte count of built Packet data, -1 for invalid message and -3 if
+ *         the destination is too small
+ */
+static int16_t sn_coap_builder_build(uint8_t *dst_packet_data_ptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr)
+{
     /* * * * Store base (= original) destination Packet data pointer for later usage * * * */
-    base_packet_data_ptr = dst_packet_data_ptr;
+    uint8_t *base_packet_data_ptr = dst_packet_data_ptr;
 
     /* * * * * * * * * * * * * * * * * * */
     /* * * * Header part building  * * * */
     /* * * * * * * * * * * * * * * * * * */
-    if (sn_coap_builder_header_build(&dst_packet_data_ptr, src_coap_msg_ptr) != 0) {
+    if (sn_coap_builder_header_build(&dst_packet_data_ptr, dst_end_ptr, src_coap_msg_ptr) != 0) {
         /* Header building failed */
-        tr_error("sn_coap_builder_2 - header building failed!");
+        tr_error("sn_coap_builder_build - header building failed!");
         return -1;
     }
 
@@ -137,16 +156,39 @@ int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, const sn_coap_hdr_s *src
         /* * * * * * * * * * * * * * * * * * */
         /* * * * Options part building * * * */
         /* * * * * * * * * * * * * * * * * * */
-        sn_coap_builder_options_build(&dst_packet_data_ptr, src_coap_msg_ptr);
+        if (sn_coap_builder_options_build(&dst_packet_data_ptr, dst_end_ptr, src_coap_msg_ptr) != 0) {
+            tr_error("sn_coap_builder_build - options building failed!");
+            return -1;
+        }
 
         /* * * * * * * * * * * * * * * * * * */
         /* * * * Payload part building * * * */
         /* * * * * * * * * * * * * * * * * * */
-        sn_coap_builder_payload_build(&dst_packet_data_ptr, src_coap_msg_ptr);
+        sn_coap_builder_payload_build(&dst_packet_data_ptr, dst_end_ptr, src_coap_msg_ptr);
     }
+
+    /* Writers set pointer to NULL when destination ran out */
+    if (dst_packet_data_ptr == NULL) {
+        tr_error("sn_coap_builder_build - destination too small!");
+        return -3;
+    }
+
     /* * * * Return built Packet data length * * * */
     return (dst_packet_data_ptr - base_packet_data_ptr);
 }
+
+/**
+ * \fn static bool sn_coap_builder_fits(const uint8_t *dst_packet_data_ptr, const uint8_t *dst_end_ptr, uint32_t len)
+ *
+ * \brief Checks if len bytes can be written to destination
+ *
+ * \return true if there is room, or destination is not checked
+ */
+static bool sn_coap_builder_fits(const uint8_t *dst_packet_data_ptr, const uint8_t *dst_end_ptr, uint32_t len)
+{
+    return dst_end_ptr == NULL || (uint32_t)(dst_end_ptr - dst_packet_data_ptr) >= len;
+}
+
 uint16_t sn_coap_builder_calc_needed_packet_data_size(const sn_coap_hdr_s *src_coap_msg_ptr)
 {
     return sn_coap_builder_calc_needed_packet_data_size_2(src_coap_msg_ptr, SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE);
@@ -197,7 +239,7 @@ uint16_t sn_coap_builder_calc_needed_packet_data_size_2(const sn_coap_hdr_s *src
                 tr_error("sn_coap_builder_calc_needed_packet_data_size_2 - content format too large!");
                 return 0;
             }
-            returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_coap_msg_ptr->content_format, COAP_OPTION_CONTENT_FORMAT, &tempInt);
+            returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_coap_msg_ptr->content_format, COAP_OPTION_CONTENT_FORMAT, &tempInt);
         }
         /* If options list pointer exists */
         if (src_coap_msg_ptr->options_list_ptr != NULL) {
@@ -210,11 +252,11 @@ uint16_t sn_coap_builder_calc_needed_packet_data_size_2(const sn_coap_hdr_s *src
                     tr_error("sn_coap_builder_calc_needed_packet_data_size_2 - accept too large!");
                     return 0;
                 }
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->accept, COAP_OPTION_ACCEPT, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->accept, COAP_OPTION_ACCEPT, &tempInt);
             }
             /* MAX AGE - An integer option, omitted for default. Up to 4 bytes */
             if (src_options_list_ptr->max_age != COAP_OPTION_MAX_AGE_DEFAULT) {
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->max_age, COAP_OPTION_MAX_AGE, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->max_age, COAP_OPTION_MAX_AGE, &tempInt);
             }
             /* PROXY URI - Length of this option is  1-1034 bytes */
             if (src_options_list_ptr->proxy_uri_ptr != NULL) {
@@ -282,7 +324,7 @@ uint16_t sn_coap_builder_calc_needed_packet_data_size_2(const sn_coap_hdr_s *src
                     tr_error("sn_coap_builder_calc_needed_packet_data_size_2 - uri port too large!");
                     return 0;
                 }
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->uri_port, COAP_OPTION_URI_PORT, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->uri_port, COAP_OPTION_URI_PORT, &tempInt);
             }
             /* lOCATION QUERY - Repeatable option. Length of this option is 0-255 bytes */
             if (src_options_list_ptr->location_query_ptr != NULL) {
@@ -300,7 +342,7 @@ uint16_t sn_coap_builder_calc_needed_packet_data_size_2(const sn_coap_hdr_s *src
                 if ((uint32_t) src_options_list_ptr->observe > 0xffffff) {
                     return 0;
                 }
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->observe, COAP_OPTION_OBSERVE, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->observe, COAP_OPTION_OBSERVE, &tempInt);
             }
             /* URI QUERY - Repeatable option. Length of this option is 1-255 */
             if (src_options_list_ptr->uri_query_ptr != NULL) {
@@ -320,11 +362,11 @@ uint16_t sn_coap_builder_calc_needed_packet_data_size_2(const sn_coap_hdr_s *src
                     tr_error("sn_coap_builder_calc_needed_packet_data_size_2 - block1 too large!");
                     return 0;
                 }
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->block1, COAP_OPTION_BLOCK1, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->block1, COAP_OPTION_BLOCK1, &tempInt);
             }
             /* SIZE1 - Length of this option is 0-4 bytes */
             if (src_options_list_ptr->use_size1) {
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->size1, COAP_OPTION_SIZE1, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->size1, COAP_OPTION_SIZE1, &tempInt);
             }
             /* BLOCK 2 - An integer option, up to 3 bytes */
             if (src_options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
@@ -332,11 +374,11 @@ uint16_t sn_coap_builder_calc_needed_packet_data_size_2(const sn_coap_hdr_s *src
                     tr_error("sn_coap_builder_calc_needed_packet_data_size_2 - block2 too large!");
                     return 0;
                 }
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->block2, COAP_OPTION_BLOCK2, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->block2, COAP_OPTION_BLOCK2, &tempInt);
             }
             /* SIZE2 - Length of this option is 0-4 bytes */
             if (src_coap_msg_ptr->options_list_ptr->use_size2) {
-                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, src_options_list_ptr->size2, COAP_OPTION_SIZE2, &tempInt);
+                returned_byte_count += sn_coap_builder_options_build_add_uint_option(NULL, NULL, src_options_list_ptr->size2, COAP_OPTION_SIZE2, &tempInt);
             }
         }
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
@@ -489,17 +531,19 @@ static uint8_t sn_coap_builder_options_calculate_jump_need(const sn_coap_hdr_s *
 }
 
 /**
- * \fn static int8_t sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, sn_coap_hdr_s *src_coap_msg_ptr)
+ * \fn static int8_t sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, sn_coap_hdr_s *src_coap_msg_ptr)
  *
  * \brief Builds Header part of Packet data
  *
- * \param **dst_packet_data_pptr is destination for built Packet data
+ * \param **dst_packet_data_pptr is destination for built Packet data, set to NULL if it does not fit
+ *
+ * \param *dst_end_ptr is end of destination, NULL if not checked
  *
  * \param *src_coap_msg_ptr is source for building Packet data
  *
  * \return Return value is 0 in ok case and -1 in failure case
  **************************************************************************** */
-static int8_t sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const sn_coap_hdr_s *src_coap_msg_ptr)
+static int8_t sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr)
 {
     /* * * * Check validity of Header values * * * */
     if (sn_coap_header_validity_check(src_coap_msg_ptr, COAP_VERSION) != 0) {
@@ -507,6 +551,16 @@ static int8_t sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const
         return -1;
     }
 
+    if (src_coap_msg_ptr->token_len > 8) {
+        tr_error("sn_coap_builder_header_build - token too large!");
+        return -1;
+    }
+
+    if (!sn_coap_builder_fits(*dst_packet_data_pptr, dst_end_ptr, COAP_HEADER_LENGTH)) {
+        *dst_packet_data_pptr = NULL;
+        return 0;
+    }
+
     uint8_t* dest_packet = *dst_packet_data_pptr;
 
     /* Set CoAP Version, Message type and Token length */
@@ -526,18 +580,25 @@ static int8_t sn_coap_builder_header_build(uint8_t **dst_packet_data_pptr, const
 }
 
 /**
- * \fn static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, sn_coap_hdr_s *src_coap_msg_ptr)
+ * \fn static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, sn_coap_hdr_s *src_coap_msg_ptr)
  *
  * \brief Builds Options part of Packet data
  *
- * \param **dst_packet_data_pptr is destination for built Packet data
+ * \param **dst_packet_data_pptr is destination for built Packet data, set to NULL if it does not fit
+ *
+ * \param *dst_end_ptr is end of destination, NULL if not checked
  *
  * \param *src_coap_msg_ptr is source for building Packet data
  *
- * \return Return value is 0 in every case
+ * \return Return value is 0 in ok case and -1 if an option value is invalid
  */
-static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, const sn_coap_hdr_s *src_coap_msg_ptr)
+static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr)
 {
+    /* Destination already ran out */
+    if (*dst_packet_data_pptr == NULL) {
+        return 0;
+    }
+
     /* * * * Check if Options are used at all  * * * */
     if (src_coap_msg_ptr->uri_path_ptr == NULL && src_coap_msg_ptr->token_ptr == NULL &&
             src_coap_msg_ptr->content_format == COAP_CT_NONE && src_coap_msg_ptr->options_list_ptr == NULL) {
@@ -549,8 +610,14 @@ static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, cons
     }
 
     /* * * * First add Token option  * * * */
+    if (!sn_coap_builder_fits(*dst_packet_data_pptr, dst_end_ptr, src_coap_msg_ptr->token_len)) {
+        *dst_packet_data_pptr = NULL;
+        return 0;
+    }
     if (src_coap_msg_ptr->token_len && src_coap_msg_ptr->token_ptr) {
         memcpy(*dst_packet_data_pptr, src_coap_msg_ptr->token_ptr, src_coap_msg_ptr->token_len);
+    } else {
+        memset(*dst_packet_data_pptr, 0, src_coap_msg_ptr->token_len);
     }
     (*dst_packet_data_pptr) += src_coap_msg_ptr->token_len;
 
@@ -563,89 +630,125 @@ static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, cons
 
     const sn_coap_options_list_s *src_options_list_ptr = src_coap_msg_ptr->options_list_ptr;
 
+    /* * * * Check values which are not checked while writing them * * * */
+    if (src_coap_msg_ptr->content_format != COAP_CT_NONE && (uint32_t) src_coap_msg_ptr->content_format > 0xffff) {
+        tr_error("sn_coap_builder_options_build - content format too large!");
+        return -1;
+    }
+    if (src_options_list_ptr != NULL) {
+        if ((src_options_list_ptr->accept != COAP_CT_NONE && (uint32_t) src_options_list_ptr->accept > 0xffff) ||
+            (src_options_list_ptr->uri_port != COAP_OPTION_URI_PORT_NONE && (uint32_t) src_options_list_ptr->uri_port > 0xffff) ||
+            (src_options_list_ptr->observe != COAP_OBSERVE_NONE && (uint32_t) src_options_list_ptr->observe > 0xffffff) ||
+            (src_options_list_ptr->block1 != COAP_OPTION_BLOCK_NONE && (uint32_t) src_options_list_ptr->block1 > 0xffffff) ||
+            (src_options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE && (uint32_t) src_options_list_ptr->block2 > 0xffffff)) {
+            tr_error("sn_coap_builder_options_build - integer option too large!");
+            return -1;
+        }
+        if (src_options_list_ptr->proxy_uri_ptr != NULL &&
+            (src_options_list_ptr->proxy_uri_len < 1 || src_options_list_ptr->proxy_uri_len > 1034)) {
+            tr_error("sn_coap_builder_options_build - proxy uri too large!");
+            return -1;
+        }
+        if (src_options_list_ptr->uri_host_ptr != NULL &&
+            (src_options_list_ptr->uri_host_len < 1 || src_options_list_ptr->uri_host_len > 255)) {
+            tr_error("sn_coap_builder_options_build - uri host too large!");
+            return -1;
+        }
+    }
+
     /* Check if less used options are used at all */
     if (src_options_list_ptr != NULL) {
         /* * * * Build Uri-Host option * * * */
-        sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, src_options_list_ptr->uri_host_len,
+        sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->uri_host_len,
                      src_options_list_ptr->uri_host_ptr, COAP_OPTION_URI_HOST, &previous_option_number);
 
         /* * * * Build ETag option  * * * */
-        sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, src_options_list_ptr->etag_ptr,
-                     src_options_list_ptr->etag_len, COAP_OPTION_ETAG, &previous_option_number);
+        if (sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->etag_ptr,
+                         src_options_list_ptr->etag_len, COAP_OPTION_ETAG, &previous_option_number) < 0) {
+            return -1;
+        }
 
         /* * * * Build Observe option  * * * * */
         if (src_options_list_ptr->observe != COAP_OBSERVE_NONE) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->observe,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->observe,
                          COAP_OPTION_OBSERVE, &previous_option_number);
         }
 
         /* * * * Build Uri-Port option * * * */
         if (src_options_list_ptr->uri_port != COAP_OPTION_URI_PORT_NONE) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->uri_port,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->uri_port,
                          COAP_OPTION_URI_PORT, &previous_option_number);
         }
 
         /* * * * Build Location-Path option  * * * */
-        sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, src_options_list_ptr->location_path_ptr,
-                     src_options_list_ptr->location_path_len, COAP_OPTION_LOCATION_PATH, &previous_option_number);
+        if (sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->location_path_ptr,
+                         src_options_list_ptr->location_path_len, COAP_OPTION_LOCATION_PATH, &previous_option_number) < 0) {
+            return -1;
+        }
     }
     /* * * * Build Uri-Path option * * * */
-    sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, src_coap_msg_ptr->uri_path_ptr,
-             src_coap_msg_ptr->uri_path_len, COAP_OPTION_URI_PATH, &previous_option_number);
+    if (sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, dst_end_ptr, src_coap_msg_ptr->uri_path_ptr,
+                 src_coap_msg_ptr->uri_path_len, COAP_OPTION_URI_PATH, &previous_option_number) < 0) {
+        return -1;
+    }
 
     /* * * * Build Content-Type option * * * */
     if (src_coap_msg_ptr->content_format != COAP_CT_NONE) {
-        sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_coap_msg_ptr->content_format,
+        sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_coap_msg_ptr->content_format,
                      COAP_OPTION_CONTENT_FORMAT, &previous_option_number);
     }
 
     if (src_options_list_ptr != NULL) {
         /* * * * Build Max-Age option  * * * */
         if (src_options_list_ptr->max_age != COAP_OPTION_MAX_AGE_DEFAULT) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->max_age,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->max_age,
                          COAP_OPTION_MAX_AGE, &previous_option_number);
         }
 
         /* * * * Build Uri-Query option  * * * * */
-        sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, src_options_list_ptr->uri_query_ptr,
-                     src_options_list_ptr->uri_query_len, COAP_OPTION_URI_QUERY, &previous_option_number);
+        if (sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->uri_query_ptr,
+                         src_options_list_ptr->uri_query_len, COAP_OPTION_URI_QUERY, &previous_option_number) < 0) {
+            return -1;
+        }
 
         /* * * * Build Accept option  * * * * */
         if (src_coap_msg_ptr->options_list_ptr->accept != COAP_CT_NONE) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->accept,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->accept,
                          COAP_OPTION_ACCEPT, &previous_option_number);
         }
 
         /* * * * Build Location-Query option * * * */
-        sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, src_options_list_ptr->location_query_ptr,
-                     src_options_list_ptr->location_query_len, COAP_OPTION_LOCATION_QUERY, &previous_option_number);
+        if (sn_coap_builder_options_build_add_multiple_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->location_query_ptr,
+                         src_options_list_ptr->location_query_len, COAP_OPTION_LOCATION_QUERY, &previous_option_number) < 0) {
+            return -1;
+        }
 
         /* * * * Build Block2 option * * * * */
         if (src_coap_msg_ptr->options_list_ptr->block2 != COAP_OPTION_BLOCK_NONE) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->block2,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->block2,
                          COAP_OPTION_BLOCK2, &previous_option_number);
         }
 
         /* * * * Build Block1 option * * * * */
         if (src_coap_msg_ptr->options_list_ptr->block1 != COAP_OPTION_BLOCK_NONE) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->block1,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->block1,
                          COAP_OPTION_BLOCK1, &previous_option_number);
         }
 
         /* * * * Build Size2 option * * * */
         if (src_coap_msg_ptr->options_list_ptr->use_size2) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->size2,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->size2,
                          COAP_OPTION_SIZE2, &previous_option_number);
         }
 
         /* * * * Build Proxy-Uri option * * * */
-        sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, src_options_list_ptr->proxy_uri_len,
+        sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->proxy_uri_len,
                      src_options_list_ptr->proxy_uri_ptr, COAP_OPTION_PROXY_URI, &previous_option_number);
 
 
         /* * * * Build Size1 option * * * */
         if (src_options_list_ptr->use_size1) {
-            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, src_options_list_ptr->size1,
+            sn_coap_builder_options_build_add_uint_option(dst_packet_data_pptr, dst_end_ptr, src_options_list_ptr->size1,
                          COAP_OPTION_SIZE1, &previous_option_number);
         }
     }
@@ -655,11 +758,13 @@ static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, cons
 }
 
 /**
- * \fn static int16_t sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet_data_pptr, uint16_t option_value_len, uint8_t *option_value_ptr, sn_coap_option_numbers_e option_number)
+ * \fn static int16_t sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, uint16_t option_value_len, uint8_t *option_value_ptr, sn_coap_option_numbers_e option_number)
  *
  * \brief Adds Options part of Packet data
  *
- * \param **dst_packet_data_pptr is destination for built Packet data
+ * \param **dst_packet_data_pptr is destination for built Packet data, set to NULL if it does not fit
+ *
+ * \param *dst_end_ptr is end of destination, NULL if not checked
  *
  * \param option_value_len is Option value length to be added
  *
@@ -669,15 +774,28 @@ static int8_t sn_coap_builder_options_build(uint8_t **dst_packet_data_pptr, cons
  *
  * \return Return value is 0 if option was not added, 1 if added
  */
-static int16_t sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet_data_pptr, uint16_t option_len,
+static int16_t sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, uint16_t option_len,
         const uint8_t *option_ptr, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number)
 {
     /* Check if there is option at all */
-    if (option_ptr != NULL) {
+    if (option_ptr != NULL && *dst_packet_data_pptr != NULL) {
         uint16_t option_delta;
 
         option_delta = (option_number - *previous_option_number);
 
+        /* Check that header, extensions and value fit before writing anything */
+        uint16_t option_size = 1 + option_len;
+        if (option_delta > 12) {
+            option_size += (option_delta < 269) ? 1 : 2;
+        }
+        if (option_len > 12) {
+            option_size += (option_len < 269) ? 1 : 2;
+        }
+        if (!sn_coap_builder_fits(*dst_packet_data_pptr, dst_end_ptr, option_size)) {
+            *dst_packet_data_pptr = NULL;
+            return 0;
+        }
+
         /* * * Build option header * * */
 
         uint8_t first_byte;
@@ -755,13 +873,15 @@ static int16_t sn_coap_builder_options_build_add_one_option(uint8_t **dst_packet
  * \param **dst_packet_data_pptr is destination for built Packet data; NULL
  *        to compute size only.
  *
+ * \param *dst_end_ptr is end of destination, NULL if not checked
+ *
  * \param option_value is Option value to be added
  *
  * \param option_number is Option number to be added
  *
  * \return Return value is total option size, or -1 in write failure case
  */
-static uint8_t sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packet_data_pptr, uint32_t option_value, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number)
+static uint8_t sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, uint32_t option_value, sn_coap_option_numbers_e option_number, uint16_t *previous_option_number)
 {
     uint8_t payload[4];
     uint8_t len = 0;
@@ -775,9 +895,9 @@ static uint8_t sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packe
 
     /* If output pointer isn't NULL, write it out */
     if (dst_packet_data_pptr) {
-        // No need to check & handle return value, as the function returns failure only if the option pointer is zero
-        // and it is pointing to a local variable here.
-        sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, len, payload, option_number, previous_option_number);
+        // No need to check & handle return value, running out of destination is reported
+        // through the destination pointer.
+        sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, dst_end_ptr, len, payload, option_number, previous_option_number);
     }
 
     /* Return the total option size */
@@ -785,11 +905,13 @@ static uint8_t sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packe
 }
 
 /**
- * \fn static int16_t sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_packet_data_pptr, uint8_t **src_pptr, uint16_t *src_len_ptr, sn_coap_option_numbers_e option)
+ * \fn static int8_t sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, uint8_t **src_pptr, uint16_t *src_len_ptr, sn_coap_option_numbers_e option)
  *
  * \brief Builds Option Uri-Query from given CoAP Header structure to Packet data
  *
- * \param **dst_packet_data_pptr is destination for built Packet data
+ * \param **dst_packet_data_pptr is destination for built Packet data, set to NULL if it does not fit
+ *
+ * \param *dst_end_ptr is end of destination, NULL if not checked
  *
  * \param uint8_t **src_ptr
  *
@@ -797,9 +919,9 @@ static uint8_t sn_coap_builder_options_build_add_uint_option(uint8_t **dst_packe
  *
  *  \paramsn_coap_option_numbers_e option option to be added
  *
- * \return Return value is 0 always
+ * \return Return value is 0 in ok case and -1 if an option part has invalid length
  */
-static void sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_packet_data_pptr, const uint8_t *src_pptr, uint16_t src_len, sn_coap_option_numbers_e option, uint16_t *previous_option_number)
+static int8_t sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const uint8_t *src_pptr, uint16_t src_len, sn_coap_option_numbers_e option, uint16_t *previous_option_number)
 {
     /* Check if there is option at all */
     if (src_pptr != NULL) {
@@ -817,14 +939,20 @@ static void sn_coap_builder_options_build_add_multiple_option(uint8_t **dst_pack
             /* Get length of query part */
             uint16_t one_query_part_len = sn_coap_builder_options_get_option_part_length_from_whole_option_string(query_len, query_ptr, i, option);
 
+            if (!sn_coap_builder_options_check_option_part_len(one_query_part_len, option)) {
+                tr_error("sn_coap_builder_options_build_add_multiple_option - invalid option length!");
+                return -1;
+            }
+
             /* Get position of query part */
             query_part_offset = sn_coap_builder_options_get_option_part_position(query_len, query_ptr, i, option);
 
             /* Add Uri-query's one part to Options */
-            sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, one_query_part_len, src_pptr + query_part_offset, option, previous_option_number);
+            sn_coap_builder_options_build_add_one_option(dst_packet_data_pptr, dst_end_ptr, one_query_part_len, src_pptr + query_part_offset, option, previous_option_number);
         }
     }
     /* Success */
+    return 0;
 }
 
 
@@ -855,31 +983,8 @@ static uint16_t sn_coap_builder_options_calc_option_size(uint16_t query_len, con
         uint16_t one_query_part_len = sn_coap_builder_options_get_option_part_length_from_whole_option_string(query_len, query_ptr, i, option);
 
         /* Check option length */
-        switch (option) {
-            case (COAP_OPTION_ETAG):            /* Length 1-8 */
-                if (one_query_part_len < 1 || one_query_part_len > 8) {
-                    return 0;
-                }
-                break;
-            case (COAP_OPTION_LOCATION_PATH):   /* Length 0-255 */
-            case (COAP_OPTION_URI_PATH):        /* Length 0-255 */
-            case (COAP_OPTION_LOCATION_QUERY):  /* Length 0-255 */
-                if (one_query_part_len > 255) {
-                    return 0;
-                }
-                break;
-            case (COAP_OPTION_URI_QUERY):       /* Length 1-255 */
-                if (one_query_part_len < 1 || one_query_part_len > 255) {
-                    return 0;
-                }
-                break;
-//            case (COAP_OPTION_ACCEPT):          /* Length 0-2 */
-//                if (one_query_part_len > 2) {
-//                    return 0;
-//                }
-//                break;
-            default:
-                break; //impossible scenario currently
+        if (!sn_coap_builder_options_check_option_part_len(one_query_part_len, option)) {
+            return 0;
         }
 
         /* Check if 4 bits are enough for writing Option value length */
@@ -907,7 +1012,32 @@ static uint16_t sn_coap_builder_options_calc_option_size(uint16_t query_len, con
     return ret_value;
 }
 
-
+/**
+ * \fn static bool sn_coap_builder_options_check_option_part_len(uint16_t one_query_part_len, sn_coap_option_numbers_e option)
+ *
+ * \brief Checks length of one part of a multi-part option
+ *
+ * \param one_query_part_len is length of the option part
+ *
+ * \param option is option number of the part
+ *
+ * \return Return value is true if the length is valid for the option
+ */
+static bool sn_coap_builder_options_check_option_part_len(uint16_t one_query_part_len, sn_coap_option_numbers_e option)
+{
+    switch (option) {
+        case (COAP_OPTION_ETAG):            /* Length 1-8 */
+            return one_query_part_len >= 1 && one_query_part_len <= 8;
+        case (COAP_OPTION_LOCATION_PATH):   /* Length 0-255 */
+        case (COAP_OPTION_URI_PATH):        /* Length 0-255 */
+        case (COAP_OPTION_LOCATION_QUERY):  /* Length 0-255 */
+            return one_query_part_len <= 255;
+        case (COAP_OPTION_URI_QUERY):       /* Length 1-255 */
+            return one_query_part_len >= 1 && one_query_part_len <= 255;
+        default:
+            return true; //impossible scenario currently
+    }
+}
 
 /**
  * \fn static uint8_t sn_coap_builder_options_get_option_part_count(uint16_t query_len, uint8_t *query_ptr, sn_coap_option_numbers_e option)
@@ -1065,18 +1195,25 @@ static int16_t sn_coap_builder_options_get_option_part_position(uint16_t query_l
 
 
 /**
- * \fn static void sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, sn_coap_hdr_s *src_coap_msg_ptr)
+ * \fn static void sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, sn_coap_hdr_s *src_coap_msg_ptr)
  *
  * \brief Builds Options part of Packet data
  *
- * \param **dst_packet_data_pptr is destination for built Packet data
+ * \param **dst_packet_data_pptr is destination for built Packet data, set to NULL if it does not fit
+ *
+ * \param *dst_end_ptr is end of destination, NULL if not checked
  *
  * \param *src_coap_msg_ptr is source for building Packet data
  */
-static void sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, const sn_coap_hdr_s *src_coap_msg_ptr)
+static void sn_coap_builder_payload_build(uint8_t **dst_packet_data_pptr, const uint8_t *dst_end_ptr, const sn_coap_hdr_s *src_coap_msg_ptr)
 {
     /* Check if Payload is used at all */
-    if (src_coap_msg_ptr->payload_len && src_coap_msg_ptr->payload_ptr != NULL) {
+    if (src_coap_msg_ptr->payload_len && src_coap_msg_ptr->payload_ptr != NULL && *dst_packet_data_pptr != NULL) {
+        if (!sn_coap_builder_fits(*dst_packet_data_pptr, dst_end_ptr, 1 + (uint32_t) src_coap_msg_ptr->payload_len)) {
+            *dst_packet_data_pptr = NULL;
+            return;
+        }
+
         /* Write Payload marker */
 
         **dst_packet_data_pptr = 0xff;
@@ -43,6 +43,10 @@
 #include "mbed-trace/mbed_trace.h"
 
 #define TRACE_GROUP "coap"
+
+#if (SN_COAP_LOOKUP_HASH_SIZE & (SN_COAP_LOOKUP_HASH_SIZE - 1)) != 0
+#error "SN_COAP_LOOKUP_HASH_SIZE must be a power of 2"
+#endif
 /* * * * * * * * * * * * * * * * * * * * */
 /* * * * LOCAL FUNCTION PROTOTYPES * * * */
 /* * * * * * * * * * * * * * * * * * * * */
@@ -50,6 +54,8 @@
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT/* If Message duplication detection is not used at all, this part of code will not be compiled */
 static void                  sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id, void *param);
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle, const sn_nsdl_addr_s *scr_addr_ptr, const uint16_t msg_id);
+static uint8_t               sn_coap_protocol_duplication_info_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port, uint16_t msg_id);
+static void                  sn_coap_protocol_duplication_info_release(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 static void                  sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
@@ -71,6 +77,9 @@ static bool                     sn_coap_handle_last_blockwise(struct coap_s *han
 static sn_coap_hdr_s            *sn_coap_protocol_copy_header(struct coap_s *handle, const sn_coap_hdr_s *source_header_ptr);
 static coap_blockwise_msg_s     *search_sent_blockwise_message(struct coap_s *handle, uint16_t msg_id);
 static int16_t                  store_blockwise_copy(struct coap_s *handle, const sn_coap_hdr_s *src_coap_msg_ptr, void *param, uint16_t original_payload_len, bool copy_payload);
+static void                     sn_coap_protocol_linked_list_blockwise_payload_stream(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, const sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option, void *param);
+static bool                     sn_coap_handle_last_blockwise_stream(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr);
+static uint8_t                  *sn_coap_protocol_blockwise_payload_pull(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint32_t offset, uint16_t length, void *param);
 #endif
 
 #if ENABLE_RESENDINGS
@@ -78,7 +87,8 @@ static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
-static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
+static void                  sn_coap_protocol_resend_queue_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_resend_queue_remove(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
 static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter);
 #endif
 
@@ -105,10 +115,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
-
-        ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
-
-        sn_coap_protocol_duplication_info_free(handle, tmp);
+        sn_coap_protocol_duplication_info_release(handle, tmp);
     }
 
 #endif
@@ -158,6 +165,9 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if ENABLE_RESENDINGS  /* If Message resending is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing active resending messages  * * * */
     ns_list_init(&handle->linked_list_resent_msgs);
+    for (uint8_t i = 0; i < SN_COAP_LOOKUP_HASH_SIZE; i++) {
+        ns_list_init(&handle->resent_msgs_hash[i]);
+    }
     handle->sn_coap_resending_queue_msgs = SN_COAP_RESENDING_QUEUE_SIZE_MSGS;
     handle->sn_coap_resending_queue_bytes = SN_COAP_RESENDING_QUEUE_SIZE_BYTES;
     handle->sn_coap_resending_intervall = DEFAULT_RESPONSE_TIMEOUT;
@@ -169,6 +179,9 @@ struct coap_s *sn_coap_protocol_init(void *(*used_malloc_func_ptr)(uint16_t), vo
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     /* * * * Create Linked list for storing Duplication info * * * */
     ns_list_init(&handle->linked_list_duplication_msgs);
+    for (uint8_t i = 0; i < SN_COAP_LOOKUP_HASH_SIZE; i++) {
+        ns_list_init(&handle->duplication_msgs_hash[i]);
+    }
     handle->sn_coap_duplication_buffer_size = SN_COAP_DUPLICATION_MAX_MSGS_COUNT;
 #endif
 
@@ -194,6 +207,24 @@ int8_t sn_coap_protocol_handle_block2_response_internally(struct coap_s *handle,
     return 0;
 }
 
+int8_t sn_coap_protocol_set_blockwise_stream(struct coap_s *handle, sn_coap_block_rx_cb *block_rx_cb, sn_coap_block_tx_cb *block_tx_cb)
+{
+    (void) block_rx_cb;
+    (void) block_tx_cb;
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (handle == NULL) {
+        return -1;
+    }
+
+    handle->sn_coap_block_rx_callback = block_rx_cb;
+    handle->sn_coap_block_tx_callback = block_tx_cb;
+    return 0;
+#else
+    (void) handle;
+    return -1;
+#endif
+}
+
 int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_size)
 {
     (void) handle;
@@ -315,9 +346,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_resend_queue_remove(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -328,12 +358,11 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
-    ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
+    ns_list_foreach(coap_send_msg_s, tmp, &handle->resent_msgs_hash[msg_id & (SN_COAP_LOOKUP_HASH_SIZE - 1)]) {
         if (tmp->send_msg_ptr.packet_ptr) {
             uint16_t temp_msg_id = read_packet_msg_id(tmp);
             if (temp_msg_id == msg_id) {
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_resend_queue_remove(handle, tmp);
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
                 return 0;
             }
@@ -357,8 +386,7 @@ int8_t sn_coap_protocol_delete_retransmission_by_token(struct coap_s *handle, co
             if (memcmp(&stored_msg->send_msg_ptr.packet_ptr[4], token, stored_token_len) == 0) {
 
                 tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %" PRIu16, read_packet_msg_id(stored_msg));
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_resend_queue_remove(handle, stored_msg);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg);
@@ -425,6 +453,7 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
     int16_t  byte_count_built     = 0;
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwising is not enabled, this part of code will not be compiled */
     uint16_t original_payload_len = 0;
+    uint8_t *stream_block_ptr = NULL;
 #endif
     /* * * * Check given pointers  * * * */
     if ((dst_addr_ptr == NULL) || (dst_packet_data_ptr == NULL) || (src_coap_msg_ptr == NULL) || handle == NULL) {
@@ -454,6 +483,15 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
         original_payload_len = src_coap_msg_ptr->payload_len;
         /* Change Payload length of send message because Payload is blockwised */
         src_coap_msg_ptr->payload_len = handle->sn_coap_block_data_size;
+
+        /* Without payload, blocks are read from the application as they are sent */
+        if (src_coap_msg_ptr->payload_ptr == NULL) {
+            stream_block_ptr = sn_coap_protocol_blockwise_payload_pull(handle, src_coap_msg_ptr, 0, src_coap_msg_ptr->payload_len, param);
+            if (stream_block_ptr == NULL) {
+                return -2;
+            }
+            src_coap_msg_ptr->payload_ptr = stream_block_ptr;
+        }
     }
 #endif
     /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -462,6 +500,13 @@ int16_t sn_coap_protocol_build(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_p
 
     byte_count_built = sn_coap_builder_2(dst_packet_data_ptr, src_coap_msg_ptr, handle->sn_coap_block_data_size);
 
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+    if (stream_block_ptr) {
+        handle->sn_coap_protocol_free(stream_block_ptr);
+        src_coap_msg_ptr->payload_ptr = NULL;
+    }
+#endif
+
     if (byte_count_built < 0) {
         tr_error("sn_coap_protocol_build - failed to build message!");
         return byte_count_built;
@@ -544,6 +589,10 @@ static int16_t store_blockwise_copy(struct coap_s *handle, const sn_coap_hdr_s *
 
     if (copy_payload) {
         stored_blockwise_msg_ptr->coap_msg_ptr->payload_len = original_payload_len;
+    }
+
+    /* Streamed payload stays with the application, only its length is stored */
+    if (copy_payload && src_coap_msg_ptr->payload_ptr) {
         stored_blockwise_msg_ptr->coap_msg_ptr->payload_ptr = sn_coap_protocol_malloc_copy(handle, src_coap_msg_ptr->payload_ptr, stored_blockwise_msg_ptr->coap_msg_ptr->payload_len);
 
         if (!stored_blockwise_msg_ptr->coap_msg_ptr->payload_ptr) {
@@ -673,10 +722,7 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
                 coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
 
                 // Remove oldest stored duplication message for getting room for new duplication message
-                sn_coap_protocol_linked_list_duplication_info_remove(handle,
-                                                                     stored_duplication_info_ptr->address->addr_ptr,
-                                                                     stored_duplication_info_ptr->address->port,
-                                                                     stored_duplication_info_ptr->msg_id);
+                sn_coap_protocol_duplication_info_release(handle, stored_duplication_info_ptr);
             }
 
             // Store Duplication info to Linked list
@@ -868,51 +914,54 @@ int8_t sn_coap_protocol_exec(struct coap_s *handle, uint32_t current_time)
     /* foreach_safe isn't sufficient because callback routine could cancel messages. */
 rescan:
     ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        // First check that msg belongs to handle
-        /* Check if it is time to send this message */
-        if (current_time >= stored_msg_ptr->resending_time) {
-            /* * * Increase Resending counter  * * */
-            stored_msg_ptr->resending_counter++;
+        /* Queue is ordered by resending time, so nothing after this one is due either */
+        if (current_time < stored_msg_ptr->resending_time) {
+            break;
+        }
 
-            /* Check if all re-sendings have been done */
-            if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
-                coap_version_e coap_version = COAP_VERSION_UNKNOWN;
+        /* * * Increase Resending counter  * * */
+        stored_msg_ptr->resending_counter++;
 
+        /* Check if all re-sendings have been done */
+        if (stored_msg_ptr->resending_counter > handle->sn_coap_resending_count) {
+            coap_version_e coap_version = COAP_VERSION_UNKNOWN;
 
-                /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
 
-                /* If RX callback have been defined.. */
-                if (handle->sn_coap_rx_callback != 0) {
-                    sn_coap_hdr_s *tmp_coap_hdr_ptr;
-                    /* Parse CoAP message, set status and call RX callback */
-                    tmp_coap_hdr_ptr = sn_coap_parser(handle, stored_msg_ptr->send_msg_ptr.packet_len, stored_msg_ptr->send_msg_ptr.packet_ptr, &coap_version);
+            /* Remove message from Linked list */
+            sn_coap_protocol_resend_queue_remove(handle, stored_msg_ptr);
 
-                    if (tmp_coap_hdr_ptr != 0) {
-                        tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
-                        handle->sn_coap_rx_callback(tmp_coap_hdr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
+            /* If RX callback have been defined.. */
+            if (handle->sn_coap_rx_callback != 0) {
+                sn_coap_hdr_s *tmp_coap_hdr_ptr;
+                /* Parse CoAP message, set status and call RX callback */
+                tmp_coap_hdr_ptr = sn_coap_parser(handle, stored_msg_ptr->send_msg_ptr.packet_len, stored_msg_ptr->send_msg_ptr.packet_ptr, &coap_version);
 
-                        sn_coap_parser_release_allocated_coap_msg_mem(handle, tmp_coap_hdr_ptr);
-                    }
-                }
+                if (tmp_coap_hdr_ptr != 0) {
+                    tmp_coap_hdr_ptr->coap_status = COAP_STATUS_BUILDER_MESSAGE_SENDING_FAILED;
+                    handle->sn_coap_rx_callback(tmp_coap_hdr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
 
-                /* Free memory of stored message */
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
-            } else {
-                /* Send message  */
-                handle->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr.packet_ptr,
-                        stored_msg_ptr->send_msg_ptr.packet_len, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
-
-                /* * * Count new Resending time  * * */
-                stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
-                                                                                   handle->sn_coap_resending_intervall,
-                                                                                   stored_msg_ptr->resending_counter);
+                    sn_coap_parser_release_allocated_coap_msg_mem(handle, tmp_coap_hdr_ptr);
+                }
             }
-            /* Callback routine could have wiped the list (eg as a response to sending failed) */
-            /* Be super cautious and rescan from the start */
-            goto rescan;
+
+            /* Free memory of stored message */
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
+        } else {
+            /* * * Count new Resending time and move the message to its new place in the queue * * */
+            /* Done before sending, as the callback could remove the message */
+            sn_coap_protocol_resend_queue_remove(handle, stored_msg_ptr);
+            stored_msg_ptr->resending_time = sn_coap_calculate_new_resend_time(current_time,
+                                                                               handle->sn_coap_resending_intervall,
+                                                                               stored_msg_ptr->resending_counter);
+            sn_coap_protocol_resend_queue_add(handle, stored_msg_ptr);
+
+            /* Send message  */
+            handle->sn_coap_tx_callback(stored_msg_ptr->send_msg_ptr.packet_ptr,
+                    stored_msg_ptr->send_msg_ptr.packet_len, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr, stored_msg_ptr->param);
         }
+        /* Callback routine could have wiped the list (eg as a response to sending failed) */
+        /* Be super cautious and rescan from the start */
+        goto rescan;
     }
 
 #endif /* ENABLE_RESENDINGS */
@@ -960,7 +1009,7 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
     /* Count resending queue size, if buffer size is defined */
     if (handle->sn_coap_resending_queue_bytes > 0) {
-        if ((sn_coap_count_linked_list_size(&handle->linked_list_resent_msgs) + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
+        if ((handle->size_resent_msgs + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
             tr_error("sn_coap_protocol_linked_list_send_msg_store - resend buffer size reached!");
             return 0;
         }
@@ -992,11 +1041,55 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     stored_msg_ptr->param = param;
 
     /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
-    ++handle->count_resent_msgs;
+    sn_coap_protocol_resend_queue_add(handle, stored_msg_ptr);
     return 1;
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_resend_queue_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Adds message to resending queue, keeping the queue ordered by resending time
+ *
+ * Messages with equal resending time stay in the order they were added.
+ *
+ * \param *stored_msg_ptr is message to be added
+ *****************************************************************************/
+
+static void sn_coap_protocol_resend_queue_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    /* New messages are usually the latest ones, so search from the end */
+    coap_send_msg_s *prev_msg_ptr = ns_list_get_last(&handle->linked_list_resent_msgs);
+    while (prev_msg_ptr && prev_msg_ptr->resending_time > stored_msg_ptr->resending_time) {
+        prev_msg_ptr = ns_list_get_previous(&handle->linked_list_resent_msgs, prev_msg_ptr);
+    }
+
+    if (prev_msg_ptr) {
+        ns_list_add_after(&handle->linked_list_resent_msgs, prev_msg_ptr, stored_msg_ptr);
+    } else {
+        ns_list_add_to_start(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    }
+
+    ns_list_add_to_end(&handle->resent_msgs_hash[read_packet_msg_id(stored_msg_ptr) & (SN_COAP_LOOKUP_HASH_SIZE - 1)], stored_msg_ptr);
+    ++handle->count_resent_msgs;
+    handle->size_resent_msgs += stored_msg_ptr->send_msg_ptr.packet_len;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_resend_queue_remove(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Removes message from resending queue, without freeing it
+ *
+ * \param *stored_msg_ptr is message to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_resend_queue_remove(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    ns_list_remove(&handle->resent_msgs_hash[read_packet_msg_id(stored_msg_ptr) & (SN_COAP_LOOKUP_HASH_SIZE - 1)], stored_msg_ptr);
+    --handle->count_resent_msgs;
+    handle->size_resent_msgs -= stored_msg_ptr->send_msg_ptr.packet_len;
+}
+
 
 /**************************************************************************//**
  * \fn static void sn_coap_protocol_linked_list_send_msg_remove(sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
@@ -1009,8 +1102,8 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
 static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+    /* Loop stored resending messages with the same message ID hash */
+    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->resent_msgs_hash[msg_id & (SN_COAP_LOOKUP_HASH_SIZE - 1)]) {
         /* Get message ID from stored resending message */
         uint16_t temp_msg_id = read_packet_msg_id(stored_msg_ptr);
 
@@ -1021,8 +1114,7 @@ static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle,
                 /* * * Message found * * */
 
                 /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_resend_queue_remove(handle, stored_msg_ptr);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
@@ -1119,7 +1211,13 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     stored_duplication_info_ptr->param = param;
     /* * * * Storing Duplication info to Linked list * * * */
 
+    /* system_time only moves forward, so the list stays ordered by timestamp */
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    ns_list_add_to_end(&handle->duplication_msgs_hash[sn_coap_protocol_duplication_info_hash(addr_ptr->addr_ptr,
+                                                                                               addr_ptr->addr_len,
+                                                                                               addr_ptr->port,
+                                                                                               msg_id)],
+                       stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
 }
 
@@ -1137,8 +1235,13 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle,
         const sn_nsdl_addr_s *addr_ptr, const uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    const coap_duplication_info_hash_list_t *bucket = &handle->duplication_msgs_hash[sn_coap_protocol_duplication_info_hash(addr_ptr->addr_ptr,
+                                                                                                                            addr_ptr->addr_len,
+                                                                                                                            addr_ptr->port,
+                                                                                                                            msg_id)];
+
+    /* Loop nodes in the hash bucket for searching Message ID */
+    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, bucket) {
         /* If message's Message ID is same than is searched */
         if (stored_duplication_info_ptr->msg_id == msg_id) {
             /* If message's Source address & port is same than is searched */
@@ -1161,24 +1264,65 @@ static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_se
 
 static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle)
 {
-
+    /* List is ordered by timestamp, so stop at the first one still valid */
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
-        if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
-            /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
-
-            /* Free memory of stored Duplication info */
-            sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
+        if ((handle->system_time - removed_duplication_info_ptr->timestamp) <= SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
+            break;
         }
+
+        /* * * * Old Duplication info found, remove it from Linked list and free it * * * */
+        sn_coap_protocol_duplication_info_release(handle, removed_duplication_info_ptr);
     }
 }
 
+/**************************************************************************//**
+ * \fn static uint8_t sn_coap_protocol_duplication_info_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port, uint16_t msg_id)
+ *
+ * \brief Calculates hash bucket of Duplication info (FNV-1a over address, port and Message ID)
+ *
+ * \return Index to duplication_msgs_hash
+ *****************************************************************************/
+
+static uint8_t sn_coap_protocol_duplication_info_hash(const uint8_t *addr_ptr, uint8_t addr_len, uint16_t port, uint16_t msg_id)
+{
+    uint32_t hash = 2166136261u;
+
+    for (uint8_t i = 0; i < addr_len; i++) {
+        hash = (hash ^ addr_ptr[i]) * 16777619u;
+    }
+    hash = (hash ^ (uint8_t)(port >> 8)) * 16777619u;
+    hash = (hash ^ (uint8_t)port) * 16777619u;
+    hash = (hash ^ (uint8_t)(msg_id >> 8)) * 16777619u;
+    hash = (hash ^ (uint8_t)msg_id) * 16777619u;
+
+    return hash & (SN_COAP_LOOKUP_HASH_SIZE - 1);
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_duplication_info_release(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr)
+ *
+ * \brief Removes stored Duplication info from Linked list and hash bucket, and frees it
+ *****************************************************************************/
+
+static void sn_coap_protocol_duplication_info_release(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr)
+{
+    ns_list_remove(&handle->linked_list_duplication_msgs, duplication_info_ptr);
+    ns_list_remove(&handle->duplication_msgs_hash[sn_coap_protocol_duplication_info_hash(duplication_info_ptr->address->addr_ptr,
+                                                                                          duplication_info_ptr->address->addr_len,
+                                                                                          duplication_info_ptr->address->port,
+                                                                                          duplication_info_ptr->msg_id)],
+                   duplication_info_ptr);
+    --handle->count_duplication_msgs;
+
+    sn_coap_protocol_duplication_info_free(handle, duplication_info_ptr);
+}
+
 #endif /* SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
 
 void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, const uint8_t *scr_addr_ptr, const uint16_t port, const uint16_t msg_id)
 {
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
+    /* Address length is not known here, so the hash bucket cannot be used */
     /* Loop all stored duplication messages in Linked list */
     ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
         /* If message's Address is same than is searched */
@@ -1191,11 +1335,7 @@ void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle,
                 if (removed_duplication_info_ptr->msg_id == msg_id) {
                     /* * * * Correct Duplication info found, remove it from Linked list * * * */
                     tr_info("sn_coap_protocol_linked_list_duplication_info_remove - message id %d removed", msg_id);
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
-
-                    /* Free memory of stored Duplication info */
-                    sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
+                    sn_coap_protocol_duplication_info_release(handle, removed_duplication_info_ptr);
                     return;
                 }
             }
@@ -1644,24 +1784,6 @@ static void sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handl
     }
 }
 
-/**************************************************************************//**
- * \fn static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
- *
- * \brief Counts total message size of all messages in linked list
- *
- * \param const coap_send_msg_list_t *linked_list_ptr pointer to linked list
- *****************************************************************************/
-static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
-{
-    uint16_t total_size = 0;
-
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, linked_list_ptr) {
-        total_size += stored_msg_ptr->send_msg_ptr.packet_len;
-    }
-
-    return total_size;
-}
-
 #endif
 
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
@@ -1764,6 +1886,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
     uint16_t original_payload_len = 0;
     uint8_t *original_payload_ptr = NULL;
+    uint8_t *stream_block_ptr = NULL;
 
     /* Block1 Option in a request (e.g., PUT or POST) */
     // Blocked request sending, received ACK, sending next block..
@@ -1819,12 +1942,23 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                         src_coap_blockwise_ack_msg_ptr->payload_ptr = src_coap_blockwise_ack_msg_ptr->payload_ptr + (block_size * block_number);
                     }
 
+                    /* Streamed payload, read the block from the application */
+                    if (!original_payload_ptr) {
+                        stream_block_ptr = sn_coap_protocol_blockwise_payload_pull(handle, src_coap_blockwise_ack_msg_ptr,
+                                                                                   block_size * block_number,
+                                                                                   src_coap_blockwise_ack_msg_ptr->payload_len,
+                                                                                   stored_blockwise_msg_temp_ptr->param);
+                        src_coap_blockwise_ack_msg_ptr->payload_ptr = stream_block_ptr;
+                    }
+
                     /* Build and send block message */
                     dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
                     dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
-                    if (!dst_ack_packet_data_ptr) {
+                    if (!dst_ack_packet_data_ptr || !src_coap_blockwise_ack_msg_ptr->payload_ptr) {
                         tr_error("sn_coap_handle_blockwise_message - (send block1) failed to allocate ack message!");
+                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                        handle->sn_coap_protocol_free(stream_block_ptr);
                         handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
                         handle->sn_coap_protocol_free(original_payload_ptr);
                         handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr);
@@ -1849,6 +1983,8 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
                     handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                     dst_ack_packet_data_ptr = 0;
+                    handle->sn_coap_protocol_free(stream_block_ptr);
+                    stream_block_ptr = NULL;
 
                     stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
                     stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr = original_payload_ptr;
@@ -1908,8 +2044,10 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_DELETED;
                 }
 
-                // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle
-                if (received_coap_msg_ptr->options_list_ptr->size1 > SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE) {
+                // Response with COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE if the payload size is more than we can handle.
+                // Streamed payload is not stored, so its size is not limited.
+                if (!handle->sn_coap_block_rx_callback &&
+                    received_coap_msg_ptr->options_list_ptr->size1 > SN_COAP_MAX_INCOMING_BLOCK_MESSAGE_SIZE) {
                     // Include maximum size that stack can handle into response
                     tr_error("sn_coap_handle_blockwise_message - (recv block1) COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE!");
                     src_coap_blockwise_ack_msg_ptr->msg_code = COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE;
@@ -1970,14 +2108,22 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 // Store only in success case
                 if (src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_INCOMPLETE &&
                     src_coap_blockwise_ack_msg_ptr->msg_code != COAP_MSG_CODE_RESPONSE_REQUEST_ENTITY_TOO_LARGE) {
-                    sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                         src_addr_ptr,
-                                                                         received_coap_msg_ptr->payload_len,
-                                                                         received_coap_msg_ptr->payload_ptr,
-                                                                         received_coap_msg_ptr->token_ptr,
-                                                                         received_coap_msg_ptr->token_len,
-                                                                         block_number,
-                                                                         received_coap_msg_ptr->options_list_ptr->size1);
+                    if (handle->sn_coap_block_rx_callback) {
+                        sn_coap_protocol_linked_list_blockwise_payload_stream(handle,
+                                                                              src_addr_ptr,
+                                                                              received_coap_msg_ptr,
+                                                                              received_coap_msg_ptr->options_list_ptr->block1,
+                                                                              param);
+                    } else {
+                        sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                             src_addr_ptr,
+                                                                             received_coap_msg_ptr->payload_len,
+                                                                             received_coap_msg_ptr->payload_ptr,
+                                                                             received_coap_msg_ptr->token_ptr,
+                                                                             received_coap_msg_ptr->token_len,
+                                                                             block_number,
+                                                                             received_coap_msg_ptr->options_list_ptr->size1);
+                    }
                 }
 
                 handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
@@ -1993,18 +2139,36 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 /* * * This is the last block when whole Blockwise payload from received * * */
                 /* * * blockwise messages is gathered and returned to User               * * */
 
-                sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                     src_addr_ptr,
-                                                                     received_coap_msg_ptr->payload_len,
-                                                                     received_coap_msg_ptr->payload_ptr,
-                                                                     received_coap_msg_ptr->token_ptr,
-                                                                     received_coap_msg_ptr->token_len,
-                                                                     block_number,
-                                                                     received_coap_msg_ptr->options_list_ptr->size1);
+                if (handle->sn_coap_block_rx_callback) {
+                    /* Streamed payload can not be completed if a block is missing */
+                    if (!blocks_in_order) {
+                        tr_error("sn_coap_handle_blockwise_message - (recv block1) stream block missing!");
+                        return NULL;
+                    }
 
-                if (!sn_coap_handle_last_blockwise(handle, src_addr_ptr, received_coap_msg_ptr)) {
+                    sn_coap_protocol_linked_list_blockwise_payload_stream(handle,
+                                                                          src_addr_ptr,
+                                                                          received_coap_msg_ptr,
+                                                                          received_coap_msg_ptr->options_list_ptr->block1,
+                                                                          param);
 
-                    return NULL;
+                    if (!sn_coap_handle_last_blockwise_stream(handle, src_addr_ptr, received_coap_msg_ptr)) {
+                        return NULL;
+                    }
+                } else {
+                    sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                         src_addr_ptr,
+                                                                         received_coap_msg_ptr->payload_len,
+                                                                         received_coap_msg_ptr->payload_ptr,
+                                                                         received_coap_msg_ptr->token_ptr,
+                                                                         received_coap_msg_ptr->token_len,
+                                                                         block_number,
+                                                                         received_coap_msg_ptr->options_list_ptr->size1);
+
+                    if (!sn_coap_handle_last_blockwise(handle, src_addr_ptr, received_coap_msg_ptr)) {
+
+                        return NULL;
+                    }
                 }
             }
         }
@@ -2019,16 +2183,24 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 #if SN_COAP_BLOCKWISE_INTERNAL_BLOCK_2_HANDLING_ENABLED
             if (handle->sn_coap_internal_block2_resp_handling) {
                 uint32_t block_number = 0;
-                /* Store blockwise payload to Linked list */
-                //todo: add block number to stored values - just to make sure all packets are in order
-                sn_coap_protocol_linked_list_blockwise_payload_store(handle,
-                                                                     src_addr_ptr,
-                                                                     received_coap_msg_ptr->payload_len,
-                                                                     received_coap_msg_ptr->payload_ptr,
-                                                                     received_coap_msg_ptr->token_ptr,
-                                                                     received_coap_msg_ptr->token_len,
-                                                                     received_coap_msg_ptr->options_list_ptr->block2 >> 4,
-                                                                     received_coap_msg_ptr->options_list_ptr->size1);
+                if (handle->sn_coap_block_rx_callback) {
+                    sn_coap_protocol_linked_list_blockwise_payload_stream(handle,
+                                                                          src_addr_ptr,
+                                                                          received_coap_msg_ptr,
+                                                                          received_coap_msg_ptr->options_list_ptr->block2,
+                                                                          param);
+                } else {
+                    /* Store blockwise payload to Linked list */
+                    //todo: add block number to stored values - just to make sure all packets are in order
+                    sn_coap_protocol_linked_list_blockwise_payload_store(handle,
+                                                                         src_addr_ptr,
+                                                                         received_coap_msg_ptr->payload_len,
+                                                                         received_coap_msg_ptr->payload_ptr,
+                                                                         received_coap_msg_ptr->token_ptr,
+                                                                         received_coap_msg_ptr->token_len,
+                                                                         received_coap_msg_ptr->options_list_ptr->block2 >> 4,
+                                                                         received_coap_msg_ptr->options_list_ptr->size1);
+                }
                 /* If not last block (more value is set) */
                 if (received_coap_msg_ptr->options_list_ptr->block2 & 0x08) {
                     coap_blockwise_msg_s *previous_blockwise_msg_ptr;
@@ -2145,7 +2317,11 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     /* * * This is the last block when whole Blockwise payload from received * * */
                     /* * * blockwise messages is gathered and returned to User               * * */
 
-                    if (!sn_coap_handle_last_blockwise(handle, src_addr_ptr, received_coap_msg_ptr)) {
+                    if (handle->sn_coap_block_rx_callback) {
+                        if (!sn_coap_handle_last_blockwise_stream(handle, src_addr_ptr, received_coap_msg_ptr)) {
+                            return NULL;
+                        }
+                    } else if (!sn_coap_handle_last_blockwise(handle, src_addr_ptr, received_coap_msg_ptr)) {
 
                         return NULL;
                     }
@@ -2212,6 +2388,15 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     src_coap_blockwise_ack_msg_ptr->payload_ptr = stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr + (block_size * block_number);
                 }
 
+                /* Streamed payload, read the block from the application */
+                if (!original_payload_ptr) {
+                    stream_block_ptr = sn_coap_protocol_blockwise_payload_pull(handle, src_coap_blockwise_ack_msg_ptr,
+                                                                               block_size * block_number,
+                                                                               src_coap_blockwise_ack_msg_ptr->payload_len,
+                                                                               stored_blockwise_msg_temp_ptr->param);
+                    src_coap_blockwise_ack_msg_ptr->payload_ptr = stream_block_ptr;
+                }
+
                 /* Update token to match one which is in GET request.
                  * This is needed only in case of notification message.
                 */
@@ -2230,8 +2415,10 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
                 dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
-                if (!dst_ack_packet_data_ptr) {
+                if (!dst_ack_packet_data_ptr || !src_coap_blockwise_ack_msg_ptr->payload_ptr) {
                     tr_error("sn_coap_handle_blockwise_message - (recv block2) failed to allocate packet!");
+                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                    handle->sn_coap_protocol_free(stream_block_ptr);
                     handle->sn_coap_protocol_free(original_payload_ptr);
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     stored_blockwise_msg_temp_ptr->coap_msg_ptr = NULL;
@@ -2249,6 +2436,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                                                                         dst_ack_packet_data_ptr)) {
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                     handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                    handle->sn_coap_protocol_free(stream_block_ptr);
                     return NULL;
                 }
 #endif
@@ -2257,6 +2445,8 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
                 handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
                 dst_ack_packet_data_ptr = 0;
+                handle->sn_coap_protocol_free(stream_block_ptr);
+                stream_block_ptr = NULL;
 
                 stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
                 stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_ptr = original_payload_ptr;
@@ -2306,6 +2496,119 @@ static bool sn_coap_handle_last_blockwise(struct coap_s *handle, const sn_nsdl_a
     return true;
 }
 
+static bool sn_coap_handle_last_blockwise_stream(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, sn_coap_hdr_s *received_coap_msg_ptr)
+{
+    coap_blockwise_payload_s *stored_blockwise_payload_ptr = sn_coap_protocol_linked_list_blockwise_search(handle, src_addr_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+
+    if (!stored_blockwise_payload_ptr) {
+        tr_error("sn_coap_handle_last_blockwise_stream - stream not found!");
+        return false;
+    }
+
+    tr_debug("sn_coap_handle_last_blockwise_stream - %" PRIu32 " blocks", stored_blockwise_payload_ptr->block_number + 1);
+    sn_coap_protocol_linked_list_blockwise_payload_remove(handle, stored_blockwise_payload_ptr);
+
+    /* Every block, including this last one, has already been passed to the application */
+    received_coap_msg_ptr->payload_ptr = NULL;
+    received_coap_msg_ptr->payload_len = 0;
+    received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVED;
+
+    return true;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_blockwise_payload_stream(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr, const sn_coap_hdr_s *received_coap_msg_ptr, int32_t block_option, void *param)
+ *
+ * \brief Passes received blockwise payload to the application instead of storing it
+ *
+ * Only the number of the latest block is stored to Linked list, for detecting
+ * retransmitted and missing blocks.
+ *
+ * \param *received_coap_msg_ptr is received message holding the block
+ * \param block_option is Block1 or Block2 option of the received message
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_blockwise_payload_stream(struct coap_s *handle, const sn_nsdl_addr_s *addr_ptr,
+        const sn_coap_hdr_s *received_coap_msg_ptr,
+        int32_t block_option,
+        void *param)
+{
+    const uint32_t block_number = (uint32_t)block_option >> 4;
+    const uint32_t offset = block_number << ((block_option & 0x07) + 4);
+
+    coap_blockwise_payload_s *stored_blockwise_payload_ptr = sn_coap_protocol_linked_list_blockwise_search(handle, addr_ptr, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+
+    if (stored_blockwise_payload_ptr) {
+        // Retransmitted block has already been passed to the application
+        if (stored_blockwise_payload_ptr->block_number == block_number) {
+            return;
+        }
+    } else {
+        stored_blockwise_payload_ptr = sn_coap_protocol_calloc(handle, sizeof(coap_blockwise_payload_s));
+        if (stored_blockwise_payload_ptr == NULL) {
+            tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - failed to allocate blockwise!");
+            return;
+        }
+
+        stored_blockwise_payload_ptr->addr_ptr = sn_coap_protocol_malloc_copy(handle, addr_ptr->addr_ptr, addr_ptr->addr_len);
+        if (stored_blockwise_payload_ptr->addr_ptr == NULL) {
+            tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - failed to allocate address pointer!");
+            handle->sn_coap_protocol_free(stored_blockwise_payload_ptr);
+            return;
+        }
+        stored_blockwise_payload_ptr->addr_len = addr_ptr->addr_len;
+        stored_blockwise_payload_ptr->port = addr_ptr->port;
+
+        if (received_coap_msg_ptr->token_ptr && received_coap_msg_ptr->token_len) {
+            stored_blockwise_payload_ptr->token_ptr = sn_coap_protocol_malloc_copy(handle, received_coap_msg_ptr->token_ptr, received_coap_msg_ptr->token_len);
+            if (stored_blockwise_payload_ptr->token_ptr == NULL) {
+                tr_error("sn_coap_protocol_linked_list_blockwise_payload_stream - failed to allocate token pointer!");
+                handle->sn_coap_protocol_free(stored_blockwise_payload_ptr->addr_ptr);
+                handle->sn_coap_protocol_free(stored_blockwise_payload_ptr);
+                return;
+            }
+            stored_blockwise_payload_ptr->token_len = received_coap_msg_ptr->token_len;
+        }
+
+        ns_list_add_to_end(&handle->linked_list_blockwise_received_payloads, stored_blockwise_payload_ptr);
+    }
+
+    stored_blockwise_payload_ptr->block_number = block_number;
+    stored_blockwise_payload_ptr->timestamp = handle->system_time;
+
+    handle->sn_coap_block_rx_callback(received_coap_msg_ptr, addr_ptr, offset, param);
+}
+
+/**************************************************************************//**
+ * \fn static uint8_t *sn_coap_protocol_blockwise_payload_pull(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint32_t offset, uint16_t length, void *param)
+ *
+ * \brief Reads one block of streamed payload from the application
+ *
+ * \return Allocated block, to be freed by the caller, or NULL on failure
+ *****************************************************************************/
+
+static uint8_t *sn_coap_protocol_blockwise_payload_pull(struct coap_s *handle, const sn_coap_hdr_s *coap_msg_ptr, uint32_t offset, uint16_t length, void *param)
+{
+    if (!handle->sn_coap_block_tx_callback) {
+        tr_error("sn_coap_protocol_blockwise_payload_pull - no payload and no stream callback!");
+        return NULL;
+    }
+
+    uint8_t *block_ptr = handle->sn_coap_protocol_malloc(length);
+    if (!block_ptr) {
+        tr_error("sn_coap_protocol_blockwise_payload_pull - failed to allocate block!");
+        return NULL;
+    }
+
+    if (handle->sn_coap_block_tx_callback(coap_msg_ptr, offset, block_ptr, length, param) < 0) {
+        tr_error("sn_coap_protocol_blockwise_payload_pull - stream read failed at %" PRIu32, offset);
+        handle->sn_coap_protocol_free(block_ptr);
+        return NULL;
+    }
+
+    return block_ptr;
+}
+
 int8_t sn_coap_convert_block_size(uint16_t block_size)
 {
     if (block_size == 16) {
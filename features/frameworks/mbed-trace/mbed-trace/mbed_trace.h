@@ -259,6 +259,15 @@ void mbed_trace_mutex_wait_function_set(void (*mutex_wait_f)(void));
  * be acquired from a single thread repeatedly.
  */
 void mbed_trace_mutex_release_function_set(void (*mutex_release_f)(void));
+/**
+ * Set trace timestamp function
+ * Used in deferred mode to stamp each trace when it is recorded,
+ * since the prefix function is only called when the trace is printed.
+ * e.g.
+ *   uint32_t trace_timestamp(){ return us_ticker_read(); }
+ *   mbed_trace_timestamp_function_set( &trace_timestamp );
+ */
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void));
 /**
  * When trace group contains text in filters,
  * trace print will be ignored.
@@ -324,6 +333,45 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
  *  Get last trace from buffer
  */
 const char *mbed_trace_last(void);
+/**
+ * Enable deferred mode
+ * In deferred mode trace calls do not format anything. They store the
+ * format string pointer, the timestamp and the raw arguments to a ring
+ * buffer, which is printed later with mbed_trace_deferred_flush(), e.g.
+ * from a low priority thread, or read out with mbed_trace_deferred_read()
+ * to be formatted on the host. Traces which do not fit to the ring buffer
+ * are dropped and counted.
+ *
+ * Group and format strings must stay valid until the trace is printed,
+ * which is true for string literals. String arguments are copied, up to
+ * MBED_TRACE_DEFERRED_STRING_LENGTH (default 48) characters. tr_cmdline()
+ * is always printed immediately.
+ *
+ * @param length    ring buffer length in bytes, 0 to return to immediate mode
+ * @return 0 when success, -1 if out of memory
+ */
+int mbed_trace_deferred_set(int length);
+/**
+ * Print traces recorded in deferred mode
+ * The trace mutex is held while printing each trace, not for the whole flush.
+ * @return number of traces printed
+ */
+int mbed_trace_deferred_flush(void);
+/**
+ * Read raw records recorded in deferred mode
+ * Only whole records are read, and they are removed from the ring buffer.
+ * Each record is in native byte order and type sizes:
+ * uint16_t record length, uint8_t trace level, uint32_t timestamp,
+ * group string pointer, format string pointer, and then the arguments
+ * in format order. '*' width and precision are int, integers have the size
+ * given by their length modifier, %p is a pointer, floating point values
+ * are double and %s is uint8_t length followed by the characters.
+ *
+ * @param buf   destination buffer
+ * @param len   destination buffer length
+ * @return number of bytes read
+ */
+int mbed_trace_deferred_read(uint8_t *buf, int len);
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
 /**
  * mbed_tracef helping function for convert ipv6
@@ -390,6 +438,7 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_trace_cmdprint_function_set
 #undef mbed_trace_mutex_wait_function_set
 #undef mbed_trace_mutex_release_function_set
+#undef mbed_trace_timestamp_function_set
 #undef mbed_trace_exclude_filters_set
 #undef mbed_trace_exclude_filters_get
 #undef mbed_trace_include_filters_set
@@ -397,6 +446,9 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_tracef
 #undef mbed_vtracef
 #undef mbed_trace_last
+#undef mbed_trace_deferred_set
+#undef mbed_trace_deferred_flush
+#undef mbed_trace_deferred_read
 #undef mbed_trace_ipv6
 #undef mbed_trace_ipv6_prefix
 #undef mbed_trace_array
@@ -415,11 +467,15 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_cmdprint_function_set(...)       ((void) 0)
 #define mbed_trace_mutex_wait_function_set(...)     ((void) 0)
 #define mbed_trace_mutex_release_function_set(...)  ((void) 0)
+#define mbed_trace_timestamp_function_set(...)      ((void) 0)
 #define mbed_trace_exclude_filters_set(...)         ((void) 0)
 #define mbed_trace_exclude_filters_get(...)         ((const char *) 0)
 #define mbed_trace_include_filters_set(...)         ((void) 0)
 #define mbed_trace_include_filters_get(...)         ((const char *) 0)
 #define mbed_trace_last(...)                        ((const char *) 0)
+#define mbed_trace_deferred_set(...)                ((int) 0)
+#define mbed_trace_deferred_flush(...)              ((int) 0)
+#define mbed_trace_deferred_read(...)               ((int) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
 /**
@@ -85,6 +85,13 @@
 #define DEFAULT_TRACE_FILTER_LENGTH       24
 #endif
 
+/** default max length of one string argument stored in deferred mode */
+#ifdef MBED_TRACE_DEFERRED_STRING_LENGTH
+#define DEFAULT_TRACE_DEFERRED_STRING_LEN MBED_TRACE_DEFERRED_STRING_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_STRING_LEN 48
+#endif
+
 /** default trace configuration bitmask */
 #ifdef MBED_TRACE_CONFIG
 #define DEFAULT_TRACE_CONFIG              MBED_TRACE_CONFIG
@@ -96,6 +103,8 @@
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_deferred_record(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -131,6 +140,22 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+    /** timestamp function for deferred records */
+    uint32_t (*timestamp_f)(void);
+    /** deferred mode ring buffer, NULL when traces are printed immediately */
+    uint8_t *deferred_ring;
+    /** deferred ring buffer length */
+    int deferred_ring_length;
+    /** deferred ring buffer write index */
+    int deferred_head;
+    /** deferred ring buffer read index */
+    int deferred_tail;
+    /** bytes used in deferred ring buffer */
+    int deferred_used;
+    /** records dropped because deferred ring buffer was full */
+    int deferred_dropped;
+    /** text of deferred record being printed */
+    char *deferred_line;
 } trace_t;
 
 static trace_t m_trace = {
@@ -149,7 +174,15 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+    .timestamp_f = 0,
+    .deferred_ring = 0,
+    .deferred_ring_length = 0,
+    .deferred_head = 0,
+    .deferred_tail = 0,
+    .deferred_used = 0,
+    .deferred_dropped = 0,
+    .deferred_line = 0
 };
 
 int mbed_trace_init(void)
@@ -192,6 +225,8 @@ void mbed_trace_free(void)
     MBED_TRACE_MEM_FREE(m_trace.tmp_data);
     MBED_TRACE_MEM_FREE(m_trace.filters_exclude);
     MBED_TRACE_MEM_FREE(m_trace.filters_include);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_ring);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_line);
 
     // reset to default values
     m_trace.trace_config = DEFAULT_TRACE_CONFIG;
@@ -209,6 +244,14 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+    m_trace.timestamp_f = 0;
+    m_trace.deferred_ring = 0;
+    m_trace.deferred_ring_length = 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_used = 0;
+    m_trace.deferred_dropped = 0;
+    m_trace.deferred_line = 0;
 }
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length)
 {
@@ -220,6 +263,14 @@ void mbed_trace_buffer_sizes(int lineLength, int tmpLength)
 {
     if (lineLength > 0) {
         mbed_trace_realloc(&(m_trace.line), &m_trace.line_length, lineLength);
+        if (m_trace.deferred_ring) {
+            // Recorded traces may not fit to the new line length
+            int length;
+            mbed_trace_realloc(&(m_trace.deferred_line), &length, lineLength);
+            m_trace.deferred_head = 0;
+            m_trace.deferred_tail = 0;
+            m_trace.deferred_used = 0;
+        }
     }
     if (tmpLength > 0) {
         mbed_trace_realloc(&(m_trace.tmp_data), &m_trace.tmp_data_length, tmpLength);
@@ -258,6 +309,10 @@ void mbed_trace_mutex_release_function_set(void (*mutex_release_f)(void))
 {
     m_trace.mutex_release_f = mutex_release_f;
 }
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void))
+{
+    m_trace.timestamp_f = timestamp_f;
+}
 void mbed_trace_exclude_filters_set(char *filters)
 {
     if (filters) {
@@ -305,99 +360,28 @@ static void mbed_trace_default_print(const char *str)
 {
     puts(str);
 }
-void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
-{
-    va_list ap;
-    va_start(ap, fmt);
-    mbed_vtracef(dlevel, grp, fmt, ap);
-    va_end(ap);
-}
-void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
 {
-    if (m_trace.mutex_wait_f) {
-        m_trace.mutex_wait_f();
-        m_trace.mutex_lock_count++;
-    }
-
-    if (NULL == m_trace.line) {
-        goto end;
-    }
-
-    m_trace.line[0] = 0; //by default trace is empty
+    bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
+    bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
+    bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
 
-    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
-        //return tmp data pointer back to the beginning
-        mbed_trace_reset_tmp();
-        goto end;
-    }
-    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
-        bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
-        bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
-        bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
-
-        int retval = 0, bLeft = m_trace.line_length;
-        char *ptr = m_trace.line;
-        if (plain == true || dlevel == TRACE_LEVEL_CMD) {
-            //add trace data
-            retval = vsnprintf(ptr, bLeft, fmt, ap);
-            if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
-                m_trace.cmd_printf(m_trace.line);
-                m_trace.cmd_printf("\n");
-            } else {
-                //print out whole data
-                m_trace.printf(m_trace.line);
-            }
+    int retval = 0, bLeft = m_trace.line_length;
+    char *ptr = m_trace.line;
+    if (plain == true || dlevel == TRACE_LEVEL_CMD) {
+        //add trace data
+        retval = vsnprintf(ptr, bLeft, fmt, ap);
+        if (dlevel == TRACE_LEVEL_CMD && m_trace.cmd_printf) {
+            m_trace.cmd_printf(m_trace.line);
+            m_trace.cmd_printf("\n");
         } else {
-            if (color) {
-                if (cr) {
-                    retval = snprintf(ptr, bLeft, "\r\x1b[2K");
-                    if (retval >= bLeft) {
-                        retval = 0;
-                    }
-                    if (retval > 0) {
-                        ptr += retval;
-                        bLeft -= retval;
-                    }
-                }
-                if (bLeft > 0) {
-                    //include color in ANSI/VT100 escape code
-                    switch (dlevel) {
-                        case (TRACE_LEVEL_ERROR):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_ERROR);
-                            break;
-                        case (TRACE_LEVEL_WARN):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_WARN);
-                            break;
-                        case (TRACE_LEVEL_INFO):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_INFO);
-                            break;
-                        case (TRACE_LEVEL_DEBUG):
-                            retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_DEBUG);
-                            break;
-                        default:
-                            color = 0; //avoid unneeded color-terminate code
-                            retval = 0;
-                            break;
-                    }
-                    if (retval >= bLeft) {
-                        retval = 0;
-                    }
-                    if (retval > 0 && color) {
-                        ptr += retval;
-                        bLeft -= retval;
-                    }
-                }
-
-            }
-            if (bLeft > 0 && m_trace.prefix_f) {
-                //find out length of body
-                size_t sz = 0;
-                va_list ap2;
-                va_copy(ap2, ap);
-                sz = vsnprintf(NULL, 0, fmt, ap2) + retval + (retval ? 4 : 0);
-                va_end(ap2);
-                //add prefix string
-                retval = snprintf(ptr, bLeft, "%s", m_trace.prefix_f(sz));
+            //print out whole data
+            m_trace.printf(m_trace.line);
+        }
+    } else {
+        if (color) {
+            if (cr) {
+                retval = snprintf(ptr, bLeft, "\r\x1b[2K");
                 if (retval >= bLeft) {
                     retval = 0;
                 }
@@ -407,70 +391,156 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
                 }
             }
             if (bLeft > 0) {
-                //add group tag
+                //include color in ANSI/VT100 escape code
                 switch (dlevel) {
                     case (TRACE_LEVEL_ERROR):
-                        retval = snprintf(ptr, bLeft, "[ERR ][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_ERROR);
                         break;
                     case (TRACE_LEVEL_WARN):
-                        retval = snprintf(ptr, bLeft, "[WARN][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_WARN);
                         break;
                     case (TRACE_LEVEL_INFO):
-                        retval = snprintf(ptr, bLeft, "[INFO][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_INFO);
                         break;
                     case (TRACE_LEVEL_DEBUG):
-                        retval = snprintf(ptr, bLeft, "[DBG ][%-4s]: ", grp);
+                        retval = snprintf(ptr, bLeft, "%s", VT100_COLOR_DEBUG);
                         break;
                     default:
-                        retval = snprintf(ptr, bLeft, "              ");
+                        color = 0; //avoid unneeded color-terminate code
+                        retval = 0;
                         break;
                 }
                 if (retval >= bLeft) {
                     retval = 0;
                 }
-                if (retval > 0) {
+                if (retval > 0 && color) {
                     ptr += retval;
                     bLeft -= retval;
                 }
             }
-            if (retval > 0 && bLeft > 0) {
-                //add trace text
-                retval = vsnprintf(ptr, bLeft, fmt, ap);
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    ptr += retval;
-                    bLeft -= retval;
-                }
+
+        }
+        if (bLeft > 0 && m_trace.prefix_f) {
+            //find out length of body
+            size_t sz = 0;
+            va_list ap2;
+            va_copy(ap2, ap);
+            sz = vsnprintf(NULL, 0, fmt, ap2) + retval + (retval ? 4 : 0);
+            va_end(ap2);
+            //add prefix string
+            retval = snprintf(ptr, bLeft, "%s", m_trace.prefix_f(sz));
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
+        if (bLeft > 0) {
+            //add group tag
+            switch (dlevel) {
+                case (TRACE_LEVEL_ERROR):
+                    retval = snprintf(ptr, bLeft, "[ERR ][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_WARN):
+                    retval = snprintf(ptr, bLeft, "[WARN][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_INFO):
+                    retval = snprintf(ptr, bLeft, "[INFO][%-4s]: ", grp);
+                    break;
+                case (TRACE_LEVEL_DEBUG):
+                    retval = snprintf(ptr, bLeft, "[DBG ][%-4s]: ", grp);
+                    break;
+                default:
+                    retval = snprintf(ptr, bLeft, "              ");
+                    break;
             }
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
+        if (retval > 0 && bLeft > 0) {
+            //add trace text
+            retval = vsnprintf(ptr, bLeft, fmt, ap);
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
+            }
+        }
 
-            if (retval > 0 && bLeft > 0  && m_trace.suffix_f) {
-                //add suffix string
-                retval = snprintf(ptr, bLeft, "%s", m_trace.suffix_f());
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    ptr += retval;
-                    bLeft -= retval;
-                }
+        if (retval > 0 && bLeft > 0  && m_trace.suffix_f) {
+            //add suffix string
+            retval = snprintf(ptr, bLeft, "%s", m_trace.suffix_f());
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                ptr += retval;
+                bLeft -= retval;
             }
+        }
 
-            if (retval > 0 && bLeft > 0  && color) {
-                //add zero color VT100 when color mode
-                retval = snprintf(ptr, bLeft, "\x1b[0m");
-                if (retval >= bLeft) {
-                    retval = 0;
-                }
-                if (retval > 0) {
-                    // not used anymore
-                    //ptr += retval;
-                    //bLeft -= retval;
-                }
+        if (retval > 0 && bLeft > 0  && color) {
+            //add zero color VT100 when color mode
+            retval = snprintf(ptr, bLeft, "\x1b[0m");
+            if (retval >= bLeft) {
+                retval = 0;
+            }
+            if (retval > 0) {
+                // not used anymore
+                //ptr += retval;
+                //bLeft -= retval;
             }
-            //print out whole data
-            m_trace.printf(m_trace.line);
+        }
+        //print out whole data
+        m_trace.printf(m_trace.line);
+    }
+}
+static void mbed_trace_print(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_trace_vprint(dlevel, grp, fmt, ap);
+    va_end(ap);
+}
+void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_vtracef(dlevel, grp, fmt, ap);
+    va_end(ap);
+}
+void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+        m_trace.mutex_lock_count++;
+    }
+
+    if (NULL == m_trace.line) {
+        goto end;
+    }
+
+    m_trace.line[0] = 0; //by default trace is empty
+
+    if (mbed_trace_skip(dlevel, grp) || fmt == 0 || grp == 0 || !m_trace.printf) {
+        //return tmp data pointer back to the beginning
+        mbed_trace_reset_tmp();
+        goto end;
+    }
+    if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+        if (m_trace.deferred_ring && dlevel != TRACE_LEVEL_CMD) {
+            mbed_trace_deferred_record(dlevel, grp, fmt, ap);
+        } else {
+            mbed_trace_vprint(dlevel, grp, fmt, ap);
         }
         //return tmp data pointer back to the beginning
         mbed_trace_reset_tmp();
@@ -502,6 +572,535 @@ const char *mbed_trace_last(void)
 {
     return m_trace.line;
 }
+/* Deferred mode */
+typedef enum {
+    TRACE_ARG_NONE,
+    TRACE_ARG_INT,
+    TRACE_ARG_LONG,
+    TRACE_ARG_LONG_LONG,
+    TRACE_ARG_SIZE,
+    TRACE_ARG_INTMAX,
+    TRACE_ARG_PTRDIFF,
+    TRACE_ARG_POINTER,
+    TRACE_ARG_DOUBLE,
+    TRACE_ARG_LONG_DOUBLE,
+    TRACE_ARG_STRING,
+    TRACE_ARG_COUNT
+} trace_arg_type_e;
+
+typedef struct trace_conversion_s {
+    /** start of conversion, the '%' character */
+    const char *start;
+    /** first character after conversion */
+    const char *end;
+    /** field width is given as an int argument */
+    bool width_arg;
+    /** precision is given as an int argument */
+    bool precision_arg;
+    /** precision written in format, -1 if none */
+    int precision;
+    /** type of the converted argument */
+    trace_arg_type_e type;
+} trace_conversion_t;
+
+/**
+ * Find next conversion from format and classify its argument, using
+ * the same rules when recording and when formatting a record.
+ * Returns false at the end of the format.
+ */
+static bool mbed_trace_next_conversion(const char *fmt, trace_conversion_t *conv)
+{
+    const char *ptr = strchr(fmt, '%');
+    int length = 0;
+
+    if (ptr == NULL) {
+        return false;
+    }
+    conv->start = ptr++;
+    conv->width_arg = false;
+    conv->precision_arg = false;
+    conv->precision = -1;
+
+    while (*ptr && strchr("-+ #0", *ptr)) {
+        ptr++;
+    }
+    if (*ptr == '*') {
+        conv->width_arg = true;
+        ptr++;
+    } else {
+        while (*ptr >= '0' && *ptr <= '9') {
+            ptr++;
+        }
+    }
+    if (*ptr == '.') {
+        ptr++;
+        if (*ptr == '*') {
+            conv->precision_arg = true;
+            ptr++;
+        } else {
+            conv->precision = 0;
+            while (*ptr >= '0' && *ptr <= '9') {
+                conv->precision = conv->precision * 10 + (*ptr++ - '0');
+            }
+        }
+    }
+    while (*ptr && strchr("hlLzjt", *ptr)) {
+        length = (length == 'l' && *ptr == 'l') ? 'q' : *ptr;
+        ptr++;
+    }
+
+    switch (*ptr) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+            switch (length) {
+                case 'l':
+                    conv->type = TRACE_ARG_LONG;
+                    break;
+                case 'q':
+                    conv->type = TRACE_ARG_LONG_LONG;
+                    break;
+                case 'z':
+                    conv->type = TRACE_ARG_SIZE;
+                    break;
+                case 'j':
+                    conv->type = TRACE_ARG_INTMAX;
+                    break;
+                case 't':
+                    conv->type = TRACE_ARG_PTRDIFF;
+                    break;
+                default:
+                    conv->type = TRACE_ARG_INT;
+                    break;
+            }
+            break;
+        case 'c':
+            conv->type = TRACE_ARG_INT;
+            break;
+        case 'a':
+        case 'A':
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            conv->type = length == 'L' ? TRACE_ARG_LONG_DOUBLE : TRACE_ARG_DOUBLE;
+            break;
+        case 'p':
+            conv->type = TRACE_ARG_POINTER;
+            break;
+        case 's':
+            conv->type = TRACE_ARG_STRING;
+            break;
+        case 'n':
+            conv->type = TRACE_ARG_COUNT;
+            break;
+        default:
+            // "%%" or unknown conversion, no argument
+            conv->type = TRACE_ARG_NONE;
+            break;
+    }
+    conv->end = *ptr ? ptr + 1 : ptr;
+    return true;
+}
+static bool mbed_trace_deferred_put(uint8_t **ptr, const uint8_t *end, const void *data, size_t len)
+{
+    if ((size_t)(end - *ptr) < len) {
+        return false;
+    }
+    memcpy(*ptr, data, len);
+    *ptr += len;
+    return true;
+}
+static bool mbed_trace_deferred_get(const uint8_t **ptr, const uint8_t *end, void *data, size_t len)
+{
+    if ((size_t)(end - *ptr) < len) {
+        return false;
+    }
+    memcpy(data, *ptr, len);
+    *ptr += len;
+    return true;
+}
+static void mbed_trace_deferred_ring_write(const uint8_t *data, int len)
+{
+    int first = m_trace.deferred_ring_length - m_trace.deferred_head;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(m_trace.deferred_ring + m_trace.deferred_head, data, first);
+    memcpy(m_trace.deferred_ring, data + first, len - first);
+    m_trace.deferred_head = (m_trace.deferred_head + len) % m_trace.deferred_ring_length;
+    m_trace.deferred_used += len;
+}
+static void mbed_trace_deferred_ring_read(uint8_t *data, int len)
+{
+    int first = m_trace.deferred_ring_length - m_trace.deferred_tail;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(data, m_trace.deferred_ring + m_trace.deferred_tail, first);
+    memcpy(data + first, m_trace.deferred_ring, len - first);
+    m_trace.deferred_tail = (m_trace.deferred_tail + len) % m_trace.deferred_ring_length;
+    m_trace.deferred_used -= len;
+}
+/** Length of the oldest record in ring, 0 if ring is empty */
+static uint16_t mbed_trace_deferred_ring_peek(void)
+{
+    uint16_t len = 0;
+    if (m_trace.deferred_used > 0) {
+        uint8_t *ptr = (uint8_t *)&len;
+        ptr[0] = m_trace.deferred_ring[m_trace.deferred_tail];
+        ptr[1] = m_trace.deferred_ring[(m_trace.deferred_tail + 1) % m_trace.deferred_ring_length];
+    }
+    return len;
+}
+static void mbed_trace_deferred_record(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    // Record is built in the line buffer, which is unused in deferred mode
+    uint8_t *ptr = (uint8_t *)m_trace.line + 2;
+    const uint8_t *end = (uint8_t *)m_trace.line + m_trace.line_length;
+    uint32_t timestamp = m_trace.timestamp_f ? m_trace.timestamp_f() : 0;
+    trace_conversion_t conv;
+    bool ok = true;
+
+    ok = ok && mbed_trace_deferred_put(&ptr, end, &dlevel, sizeof dlevel);
+    ok = ok && mbed_trace_deferred_put(&ptr, end, &timestamp, sizeof timestamp);
+    ok = ok && mbed_trace_deferred_put(&ptr, end, &grp, sizeof grp);
+    ok = ok && mbed_trace_deferred_put(&ptr, end, &fmt, sizeof fmt);
+
+    while (ok && mbed_trace_next_conversion(fmt, &conv)) {
+        fmt = conv.end;
+        if (conv.width_arg) {
+            int width = va_arg(ap, int);
+            ok = ok && mbed_trace_deferred_put(&ptr, end, &width, sizeof width);
+        }
+        if (conv.precision_arg) {
+            conv.precision = va_arg(ap, int);
+            ok = ok && mbed_trace_deferred_put(&ptr, end, &conv.precision, sizeof conv.precision);
+        }
+        switch (conv.type) {
+            case TRACE_ARG_INT: {
+                int value = va_arg(ap, int);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_LONG: {
+                long value = va_arg(ap, long);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_LONG_LONG: {
+                long long value = va_arg(ap, long long);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_SIZE: {
+                size_t value = va_arg(ap, size_t);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_INTMAX: {
+                intmax_t value = va_arg(ap, intmax_t);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_PTRDIFF: {
+                ptrdiff_t value = va_arg(ap, ptrdiff_t);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_POINTER: {
+                void *value = va_arg(ap, void *);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_DOUBLE: {
+                double value = va_arg(ap, double);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_LONG_DOUBLE: {
+                // stored as double, 'L' is dropped when formatting
+                double value = (double)va_arg(ap, long double);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &value, sizeof value);
+                break;
+            }
+            case TRACE_ARG_STRING: {
+                // String may be in a temporary buffer, so copy its content
+                const char *str = va_arg(ap, const char *);
+                size_t max = DEFAULT_TRACE_DEFERRED_STRING_LEN;
+                uint8_t len = 0;
+                if (conv.precision >= 0 && (size_t)conv.precision < max) {
+                    max = conv.precision;
+                }
+                if (str == NULL) {
+                    str = "<null>";
+                }
+                while (len < max && str[len]) {
+                    len++;
+                }
+                ok = ok && mbed_trace_deferred_put(&ptr, end, &len, sizeof len);
+                ok = ok && mbed_trace_deferred_put(&ptr, end, str, len);
+                break;
+            }
+            case TRACE_ARG_COUNT:
+                (void)va_arg(ap, void *);
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint16_t len = ptr - (uint8_t *)m_trace.line;
+    if (!ok || len > m_trace.deferred_ring_length - m_trace.deferred_used) {
+        m_trace.deferred_dropped++;
+    } else {
+        memcpy(m_trace.line, &len, sizeof len);
+        mbed_trace_deferred_ring_write((uint8_t *)m_trace.line, len);
+    }
+    m_trace.line[0] = 0;
+}
+/** Format arguments of a record with its format string */
+static void mbed_trace_deferred_format(char *dst, int dst_len, const char *fmt, const uint8_t *ptr, const uint8_t *end)
+{
+    trace_conversion_t conv;
+    char spec[32];
+    char str[DEFAULT_TRACE_DEFERRED_STRING_LEN + 1];
+    int retval = 0;
+
+    dst[0] = 0;
+    while (dst_len > 1) {
+        bool ok = true;
+        bool more = mbed_trace_next_conversion(fmt, &conv);
+        int literal = more ? conv.start - fmt : (int)strlen(fmt);
+
+        // literal text before conversion
+        if (literal >= dst_len) {
+            literal = dst_len - 1;
+        }
+        memcpy(dst, fmt, literal);
+        dst += literal;
+        dst_len -= literal;
+        *dst = 0;
+        if (!more || dst_len <= 1) {
+            break;
+        }
+        fmt = conv.end;
+
+        // rebuild conversion, with '*' replaced by recorded values and 'L' dropped
+        int spec_len = 0;
+        for (const char *c = conv.start; c < conv.end && spec_len < (int)sizeof(spec) - 12; c++) {
+            if (*c == '*') {
+                int value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                spec_len += snprintf(spec + spec_len, sizeof(spec) - spec_len, "%d", value);
+            } else if (*c != 'L') {
+                spec[spec_len++] = *c;
+            }
+        }
+        spec[spec_len] = 0;
+
+        switch (conv.type) {
+            case TRACE_ARG_INT: {
+                int value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_LONG: {
+                long value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_LONG_LONG: {
+                long long value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_SIZE: {
+                size_t value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_INTMAX: {
+                intmax_t value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_PTRDIFF: {
+                ptrdiff_t value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_POINTER: {
+                void *value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_DOUBLE:
+            case TRACE_ARG_LONG_DOUBLE: {
+                double value = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &value, sizeof value);
+                retval = snprintf(dst, dst_len, spec, value);
+                break;
+            }
+            case TRACE_ARG_STRING: {
+                uint8_t len = 0;
+                ok = ok && mbed_trace_deferred_get(&ptr, end, &len, sizeof len);
+                ok = ok && len < sizeof str && mbed_trace_deferred_get(&ptr, end, str, len);
+                str[ok ? len : 0] = 0;
+                retval = snprintf(dst, dst_len, spec, str);
+                break;
+            }
+            case TRACE_ARG_COUNT:
+                retval = 0;
+                break;
+            default:
+                retval = snprintf(dst, dst_len, "%s", spec[1] == '%' ? "%" : spec);
+                break;
+        }
+        if (!ok) {
+            break;
+        }
+        if (retval >= dst_len) {
+            retval = dst_len - 1;
+        }
+        if (retval > 0) {
+            dst += retval;
+            dst_len -= retval;
+        }
+    }
+}
+int mbed_trace_deferred_set(int length)
+{
+    uint8_t *ring = 0;
+    char *line = 0;
+
+    if (length > 0) {
+        ring = MBED_TRACE_MEM_ALLOC(length);
+        line = MBED_TRACE_MEM_ALLOC(m_trace.line_length);
+        if (ring == NULL || line == NULL) {
+            MBED_TRACE_MEM_FREE(ring);
+            MBED_TRACE_MEM_FREE(line);
+            return -1;
+        }
+    }
+
+    // Print whatever was recorded before the buffer goes away
+    mbed_trace_deferred_flush();
+
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    MBED_TRACE_MEM_FREE(m_trace.deferred_ring);
+    MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+    m_trace.deferred_ring = ring;
+    m_trace.deferred_line = line;
+    m_trace.deferred_ring_length = length > 0 ? length : 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_used = 0;
+    m_trace.deferred_dropped = 0;
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+    return 0;
+}
+int mbed_trace_deferred_flush(void)
+{
+    int count = 0;
+
+    // Lock for one record at a time, so tracing threads are not blocked
+    // for the whole flush
+    for (;;) {
+        if (m_trace.mutex_wait_f) {
+            m_trace.mutex_wait_f();
+        }
+        uint16_t len = 0;
+        if (m_trace.deferred_ring && m_trace.deferred_line && m_trace.line) {
+            len = mbed_trace_deferred_ring_peek();
+        }
+        if (len == 0) {
+            // Drops happen when ring is full, so report them after the
+            // traces that were kept
+            if (m_trace.deferred_dropped && m_trace.printf && m_trace.line) {
+                mbed_trace_print(TRACE_LEVEL_WARN, "trce", "%d traces dropped", m_trace.deferred_dropped);
+                m_trace.deferred_dropped = 0;
+            }
+            if (m_trace.mutex_release_f) {
+                m_trace.mutex_release_f();
+            }
+            break;
+        }
+
+        // Record goes to the line buffer, it is not needed any more when
+        // the formatted text is printed into the line buffer
+        uint8_t *record = (uint8_t *)m_trace.line;
+        mbed_trace_deferred_ring_read(record, len);
+
+        const uint8_t *ptr = record + 2;
+        const uint8_t *end = record + len;
+        uint8_t dlevel = 0;
+        uint32_t timestamp = 0;
+        const char *grp = 0;
+        const char *fmt = 0;
+        mbed_trace_deferred_get(&ptr, end, &dlevel, sizeof dlevel);
+        mbed_trace_deferred_get(&ptr, end, &timestamp, sizeof timestamp);
+        mbed_trace_deferred_get(&ptr, end, &grp, sizeof grp);
+        mbed_trace_deferred_get(&ptr, end, &fmt, sizeof fmt);
+
+        char *dst = m_trace.deferred_line;
+        int dst_len = m_trace.line_length;
+        if (m_trace.timestamp_f) {
+            int retval = snprintf(dst, dst_len, "[%" PRIu32 "] ", timestamp);
+            if (retval > 0 && retval < dst_len) {
+                dst += retval;
+                dst_len -= retval;
+            }
+        }
+        mbed_trace_deferred_format(dst, dst_len, fmt, ptr, end);
+
+        if (m_trace.printf) {
+            mbed_trace_print(dlevel, grp, "%s", m_trace.deferred_line);
+        }
+        count++;
+
+        if (m_trace.mutex_release_f) {
+            m_trace.mutex_release_f();
+        }
+    }
+    return count;
+}
+int mbed_trace_deferred_read(uint8_t *buf, int len)
+{
+    int read = 0;
+
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    while (m_trace.deferred_ring) {
+        uint16_t record_len = mbed_trace_deferred_ring_peek();
+        if (record_len == 0 || record_len > len - read) {
+            break;
+        }
+        mbed_trace_deferred_ring_read(buf + read, record_len);
+        read += record_len;
+    }
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+    return read;
+}
 /* Helping functions */
 #define tmp_data_left()  m_trace.tmp_data_length-(m_trace.tmp_data_ptr-m_trace.tmp_data)
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
@@ -21,6 +21,8 @@
  * nsdynmemlib provides access to one default heap, along with the ability to use extra user heaps.
  * ns_dyn_mem_alloc/free always access the default heap initialised by ns_dyn_mem_init.
  * ns_mem_alloc/free access a user heap initialised by ns_mem_init. User heaps are identified by a book-keeping pointer.
+ * Free blocks are searched first-fit. Building with NS_DYN_MEM_SIZE_CLASS_COUNT set above 1 (e.g. 16) keeps them on
+ * separate lists by size class instead, bounding allocation time on long-running, fragmented heaps.
  */
 
 #ifndef NSDYNMEMLIB_H_
@@ -64,6 +66,17 @@ typedef struct mem_stat_t {
     uint32_t heap_alloc_fail_cnt;               /**< Counter for Heap allocation fail. */
 } mem_stat_t;
 
+/**
+ * /struct mem_free_stat_t
+ * /brief Struct for free heap and fragmentation stats, see ns_mem_get_free_stat()
+ */
+typedef struct mem_free_stat_t {
+    ns_mem_heap_size_t free_bytes;              /**< Free heap data in bytes, excluding block headers. */
+    ns_mem_heap_size_t free_block_cnt;          /**< Free heap block cnt. */
+    ns_mem_heap_size_t largest_free_block;      /**< Largest free block in bytes, the largest allocation that can succeed. */
+    uint8_t fragmentation_percentage;           /**< Percentage of free heap data outside the largest free block. */
+} mem_free_stat_t;
+
 
 typedef struct ns_mem_book ns_mem_book_t;
 
@@ -138,6 +151,18 @@ extern void *ns_dyn_mem_alloc(ns_mem_block_size_t alloc_size);
   */
 extern const mem_stat_t *ns_dyn_mem_get_mem_stat(void);
 
+/**
+  * \brief Get free heap and fragmentation statistics of the default heap.
+  *
+  * Walks the free blocks of the heap with interrupts disabled, so the time taken
+  * grows with the number of free blocks.
+  *
+  * \param stat Pointer to mem_free_stat_t to fill in.
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_dyn_mem_get_free_stat(mem_free_stat_t *stat);
+
 /**
   * \brief Set amount of free heap that must be available for temporary memory allocation to succeed.
   *
@@ -229,6 +254,19 @@ extern void *ns_mem_alloc(ns_mem_book_t *book, ns_mem_block_size_t alloc_size);
   */
 extern const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *book);
 
+/**
+  * \brief Get free heap and fragmentation statistics of a heap.
+  *
+  * Walks the free blocks of the heap with interrupts disabled, so the time taken
+  * grows with the number of free blocks.
+  *
+  * \param book Address of book keeping structure
+  * \param stat Pointer to mem_free_stat_t to fill in.
+  *
+  * \return 0 on success, <0 otherwise
+  */
+extern int ns_mem_get_free_stat(ns_mem_book_t *book, mem_free_stat_t *stat);
+
 /**
   * \brief Set amount of free heap that must be available for temporary memory allocation to succeed.
   *
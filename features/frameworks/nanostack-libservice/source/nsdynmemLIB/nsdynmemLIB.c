@@ -31,18 +31,28 @@ typedef struct {
     ns_list_link_t link;
 } hole_t;
 
+typedef NS_LIST_HEAD(hole_t, link) hole_list_t;
+
 typedef int ns_mem_word_size_t; // internal signed heap block size type
 
 // Amount of memory regions
 #define REGION_COUNT 3
 
+// Amount of hole lists. With the default of 1, all holes are on one list
+// searched first-fit. Larger values keep holes on separate lists by size
+// class (powers of two in words), so allocation time no longer grows with
+// the number of small holes left by fragmentation.
+#ifndef NS_DYN_MEM_SIZE_CLASS_COUNT
+#define NS_DYN_MEM_SIZE_CLASS_COUNT 1
+#endif
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main[REGION_COUNT];
     ns_mem_word_size_t     *heap_main_end[REGION_COUNT];
     mem_stat_t *mem_stat_info_ptr;
     void (*heap_failure_callback)(heap_fail_t);
-    NS_LIST_HEAD(hole_t, link) holes_list;
+    hole_list_t holes_list[NS_DYN_MEM_SIZE_CLASS_COUNT];
     ns_mem_heap_size_t heap_size;
     ns_mem_heap_size_t temporary_alloc_heap_limit;   /* Amount of reserved heap temporary alloc can't exceed */
 };
@@ -64,6 +74,58 @@ static NS_INLINE ns_mem_word_size_t *block_start_from_hole(hole_t *start)
     return ((ns_mem_word_size_t *)start) - 1;
 }
 
+static NS_INLINE hole_list_t *hole_list_for_size(ns_mem_book_t *book, ns_mem_word_size_t size)
+{
+#if NS_DYN_MEM_SIZE_CLASS_COUNT > 1
+    int size_class = 0;
+    while (size > 1 && size_class < NS_DYN_MEM_SIZE_CLASS_COUNT - 1) {
+        size >>= 1;
+        size_class++;
+    }
+    return &book->holes_list[size_class];
+#else
+    (void) size;
+    return &book->holes_list[0];
+#endif
+}
+
+// Each hole list is kept in address order
+static void hole_insert(ns_mem_book_t *book, hole_t *hole, ns_mem_word_size_t size)
+{
+    hole_list_t *list = hole_list_for_size(book, size);
+    ns_list_foreach(hole_t, ptr, list) {
+        if (ptr > hole) {
+            ns_list_add_before(list, ptr, hole);
+            return;
+        }
+    }
+    ns_list_add_to_end(list, hole);
+}
+
+// Replace a hole with one covering part of the same area, e.g. after a split
+static void hole_replace(ns_mem_book_t *book, hole_t *old_hole, ns_mem_word_size_t old_size, hole_t *new_hole, ns_mem_word_size_t new_size)
+{
+    hole_list_t *old_list = hole_list_for_size(book, old_size);
+    hole_list_t *new_list = hole_list_for_size(book, new_size);
+
+    if (old_list == new_list) {
+        if (old_hole != new_hole) {
+            // Would like to just replace old_hole with new_hole, but
+            // they could overlap, so ns_list_replace might fail
+            hole_t *before = ns_list_get_previous(old_list, old_hole);
+            ns_list_remove(old_list, old_hole);
+            if (before) {
+                ns_list_add_after(old_list, before, new_hole);
+            } else {
+                ns_list_add_to_start(old_list, new_hole);
+            }
+        }
+    } else {
+        ns_list_remove(old_list, old_hole);
+        hole_insert(book, new_hole, new_size);
+    }
+}
+
 static void heap_failure(ns_mem_book_t *book, heap_fail_t reason)
 {
     if (book->heap_failure_callback) {
@@ -159,8 +221,10 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     *ptr = -(temp_int);
     book->heap_main_end[0] = ptr;
 
-    ns_list_init(&book->holes_list);
-    ns_list_add_to_start(&book->holes_list, hole_from_block_start(book->heap_main[0]));
+    for (int i = 0; i < NS_DYN_MEM_SIZE_CLASS_COUNT; i++) {
+        ns_list_init(&book->holes_list[i]);
+    }
+    ns_list_add_to_start(hole_list_for_size(book, temp_int), hole_from_block_start(book->heap_main[0]));
 
     book->mem_stat_info_ptr = info_ptr;
     //RESET Memory by Hea Len
@@ -207,15 +271,14 @@ int ns_mem_region_add(ns_mem_book_t *book, void *region_ptr, ns_mem_heap_size_t
     block_ptr += (temp_int + 1);    // now block_ptr points to end of block
     *block_ptr = -(temp_int);
 
-    // find place for the new hole from the holes list
+    // check the new hole is not already in the holes lists
     hole_t *hole_to_add = hole_from_block_start(region_ptr);
-    hole_t *previous_hole = NULL;
-    ns_list_foreach(hole_t, hole_in_list_ptr, &book->holes_list) {
-        if (hole_in_list_ptr < hole_to_add) {
-            previous_hole = hole_in_list_ptr;
-        } else if (hole_in_list_ptr == hole_to_add) {
-            // trying to add memory block that is already in the list!
-            return -2;
+    for (int i = 0; i < NS_DYN_MEM_SIZE_CLASS_COUNT; i++) {
+        ns_list_foreach(hole_t, hole_in_list_ptr, &book->holes_list[i]) {
+            if (hole_in_list_ptr == hole_to_add) {
+                // trying to add memory block that is already in the list!
+                return -2;
+            }
         }
     }
 
@@ -225,11 +288,7 @@ int ns_mem_region_add(ns_mem_book_t *book, void *region_ptr, ns_mem_heap_size_t
     }
 
     // Add new hole to the list
-    if (previous_hole) {
-        ns_list_add_after(&book->holes_list, previous_hole, hole_to_add);
-    } else {
-        ns_list_add_to_start(&book->holes_list, hole_to_add);
-    }
+    hole_insert(book, hole_to_add, temp_int);
 
     // adjust total heap size with new hole
     book->heap_size += region_size;
@@ -260,6 +319,46 @@ const mem_stat_t *ns_mem_get_mem_stat(ns_mem_book_t *heap)
 #endif
 }
 
+int ns_mem_get_free_stat(ns_mem_book_t *book, mem_free_stat_t *stat)
+{
+#ifndef STANDARD_MALLOC
+    if (!book || !stat) {
+        return -1;
+    }
+
+    memset(stat, 0, sizeof(mem_free_stat_t));
+
+    platform_enter_critical();
+    for (int i = 0; i < NS_DYN_MEM_SIZE_CLASS_COUNT; i++) {
+        ns_list_foreach(hole_t, hole, &book->holes_list[i]) {
+            ns_mem_heap_size_t hole_bytes = -*block_start_from_hole(hole) * sizeof(ns_mem_word_size_t);
+            stat->free_bytes += hole_bytes;
+            stat->free_block_cnt++;
+            if (hole_bytes > stat->largest_free_block) {
+                stat->largest_free_block = hole_bytes;
+            }
+        }
+    }
+    platform_exit_critical();
+
+    if (stat->free_bytes) {
+        stat->fragmentation_percentage = 100 - (uint64_t) stat->largest_free_block * 100 / stat->free_bytes;
+    }
+
+    return 0;
+#else
+    (void) book;
+    (void) stat;
+
+    return -1;
+#endif
+}
+
+int ns_dyn_mem_get_free_stat(mem_free_stat_t *stat)
+{
+    return ns_mem_get_free_stat(default_book, stat);
+}
+
 int ns_mem_set_temporary_alloc_free_heap_threshold(ns_mem_book_t *book, uint8_t free_heap_percentage, ns_mem_heap_size_t free_heap_amount)
 {
 #ifndef STANDARD_MALLOC
@@ -380,23 +479,30 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         goto done;
     }
 
-    // ns_list_foreach, either forwards or backwards, result to ptr
-    for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
-                            : ns_list_get_last(&book->holes_list);
-            cur_hole;
-            cur_hole = direction > 0 ? ns_list_get_next(&book->holes_list, cur_hole)
-                       : ns_list_get_previous(&book->holes_list, cur_hole)
-        ) {
-        ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
-        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
-            //Validation failed, or this supposed hole has positive (allocated) size
-            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
-            break;
-        }
-        if (-*p >= data_size) {
-            // Found a big enough block
-            block_ptr = p;
-            break;
+    // Search the lists from the size class of the request upwards. Any hole
+    // in a higher size class is big enough, so only the first list searched
+    // can need more than one step.
+    for (hole_list_t *list = hole_list_for_size(book, data_size);
+            !block_ptr && list < book->holes_list + NS_DYN_MEM_SIZE_CLASS_COUNT;
+            list++) {
+        // ns_list_foreach, either forwards or backwards, result to ptr
+        for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(list)
+                                : ns_list_get_last(list);
+                cur_hole;
+                cur_hole = direction > 0 ? ns_list_get_next(list, cur_hole)
+                           : ns_list_get_previous(list, cur_hole)
+            ) {
+            ns_mem_word_size_t *p = block_start_from_hole(cur_hole);
+            if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+                //Validation failed, or this supposed hole has positive (allocated) size
+                heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+                goto done;
+            }
+            if (-*p >= data_size) {
+                // Found a big enough block
+                block_ptr = p;
+                break;
+            }
         }
     }
 
@@ -410,32 +516,24 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
     if (block_data_size >= (data_size + 2 + HOLE_T_SIZE)) {
         ns_mem_word_size_t hole_size = block_data_size - data_size - 2;
         ns_mem_word_size_t *hole_ptr;
+        hole_t *old_hole = hole_from_block_start(block_ptr);
         //There is enough room for a new hole so create it first
         if (direction > 0) {
             hole_ptr = block_ptr + 1 + data_size + 1;
             // Hole will be left at end of area.
-            // Would like to just replace this block_ptr with new descriptor, but
-            // they could overlap, so ns_list_replace might fail
-            //ns_list_replace(&holes_list, block_ptr, hole_from_block_start(hole_ptr));
-            hole_t *before = ns_list_get_previous(&book->holes_list, hole_from_block_start(block_ptr));
-            ns_list_remove(&book->holes_list, hole_from_block_start(block_ptr));
-            if (before) {
-                ns_list_add_after(&book->holes_list, before, hole_from_block_start(hole_ptr));
-            } else {
-                ns_list_add_to_start(&book->holes_list, hole_from_block_start(hole_ptr));
-            }
         } else {
             hole_ptr = block_ptr;
             // Hole remains at start of area - keep existing descriptor in place.
             block_ptr += 1 + hole_size + 1;
         }
+        hole_replace(book, old_hole, block_data_size, hole_from_block_start(hole_ptr), hole_size);
 
         hole_ptr[0] = -hole_size;
         hole_ptr[1 + hole_size] = -hole_size;
     } else {
         // Not enough room for a left-over hole, so use the whole block
         data_size = block_data_size;
-        ns_list_remove(&book->holes_list, hole_from_block_start(block_ptr));
+        ns_list_remove(hole_list_for_size(book, block_data_size), hole_from_block_start(block_ptr));
     }
     block_ptr[0] = data_size;
     block_ptr[1 + data_size] = data_size;
@@ -494,6 +592,8 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
 
     hole_t *existing_start = NULL;
     hole_t *existing_end = NULL;
+    ns_mem_word_size_t existing_start_size = 0;
+    ns_mem_word_size_t existing_end_size = 0;
     ns_mem_word_size_t *start = cur_block;
     ns_mem_word_size_t *end = cur_block + data_size + 1;
     ns_mem_word_size_t *region_start;
@@ -525,6 +625,7 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
             }
             if (block_size >= 1 + HOLE_T_SIZE + 1) {
                 existing_start = hole_from_block_start(start);
+                existing_start_size = block_size - 2;
             }
         }
     }
@@ -540,45 +641,28 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
             }
             if (block_size >= 1 + HOLE_T_SIZE + 1) {
                 existing_end = hole_from_block_start(block_start);
+                existing_end_size = block_size - 2;
             }
         }
     }
 
     hole_t *to_add = hole_from_block_start(start);
-    hole_t *before = NULL;
-    if (existing_end) {
-        // Extending hole described by "existing_end" downwards.
-        // Will replace with descriptor at bottom of merged block.
-        // (Can't use ns_list_replace, because of danger of overlap)
-        // Optimisation - note our position for insertion below.
-        before = ns_list_get_next(&book->holes_list, existing_end);
-        ns_list_remove(&book->holes_list, existing_end);
-    }
     if (existing_start) {
         // Extending hole described by "existing_start" upwards.
         // No need to modify that descriptor - it remains at the bottom
-        // of the merged block to describe it.
-    } else {
+        // of the merged block to describe it - but its size class may change.
+        if (existing_end) {
+            ns_list_remove(hole_list_for_size(book, existing_end_size), existing_end);
+        }
+        hole_replace(book, existing_start, existing_start_size, existing_start, merged_data_size);
+    } else if (existing_end) {
+        // Extending hole described by "existing_end" downwards.
+        // Will replace with descriptor at bottom of merged block.
+        hole_replace(book, existing_end, existing_end_size, to_add, merged_data_size);
+    } else if (merged_data_size >= HOLE_T_SIZE) {
         // Didn't find adjacent descriptors, but may still
         // be merging with small blocks without descriptors.
-        if (merged_data_size >= HOLE_T_SIZE) {
-            // Locate hole position in list, if we don't already know
-            // from merging with the block above.
-            if (!existing_end) {
-                ns_list_foreach(hole_t, ptr, &book->holes_list) {
-                    if (ptr > to_add) {
-                        before = ptr;
-                        break;
-                    }
-                }
-            }
-            if (before) {
-                ns_list_add_before(&book->holes_list, before, to_add);
-            } else {
-                ns_list_add_to_end(&book->holes_list, to_add);
-            }
-
-        }
+        hole_insert(book, to_add, merged_data_size);
     }
     *start = -merged_data_size;
     *end = -merged_data_size;
@@ -750,6 +750,43 @@ TEST(dynmem, test_free_corrupted_next_block)
     free(heap);
 }
 
+TEST(dynmem, free_stat)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    mem_free_stat_t free_info;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    void *p[3];
+    CHECK(NULL != heap);
+    reset_heap_error();
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(!heap_have_failed());
+    CHECK(ns_dyn_mem_get_free_stat(NULL) < 0);
+
+    CHECK(ns_dyn_mem_get_free_stat(&free_info) == 0);
+    CHECK(free_info.free_block_cnt == 1);
+    CHECK(free_info.largest_free_block == free_info.free_bytes);
+    CHECK(free_info.fragmentation_percentage == 0);
+
+    for (int i = 0; i < 3; i++) {
+        p[i] = ns_dyn_mem_temporary_alloc(100);
+        CHECK(p[i]);
+    }
+    ns_dyn_mem_free(p[1]);
+    CHECK(ns_dyn_mem_get_free_stat(&free_info) == 0);
+    CHECK(free_info.free_block_cnt == 2);
+    CHECK(free_info.free_bytes == free_info.largest_free_block + 100);
+    CHECK(free_info.fragmentation_percentage > 0);
+
+    ns_dyn_mem_free(p[0]);
+    ns_dyn_mem_free(p[2]);
+    CHECK(!heap_have_failed());
+    CHECK(ns_dyn_mem_get_free_stat(&free_info) == 0);
+    CHECK(free_info.free_block_cnt == 1);
+    CHECK(free_info.fragmentation_percentage == 0);
+    free(heap);
+}
+
 //NOTE! This test must be last!
 TEST(dynmem, uninitialized_test)
 {
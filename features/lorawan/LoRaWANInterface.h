@@ -343,10 +343,15 @@ public:
      *
      *                      All flags are mutually exclusive, and MSG_MULTICAST_FLAG cannot be set.
      *
-     * @return              The number of bytes sent, or a negative error code on failure:
+     *                      If lora.uplink-queue-size is set, a message sent while another TX is
+     *                      ongoing is copied to the uplink queue and transmitted after it.
+     *                      With lora.uplink-aggregation, consecutive queued messages for the same
+     *                      port and of the same type are concatenated into one frame.
+     *
+     * @return              The number of bytes sent or queued, or a negative error code on failure:
      *                      LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
      *                      LORAWAN_STATUS_NO_ACTIVE_SESSIONS if connection is not open,
-     *                      LORAWAN_STATUS_WOULD_BLOCK       if another TX is ongoing,
+     *                      LORAWAN_STATUS_WOULD_BLOCK       if another TX is ongoing and the uplink queue is full or disabled,
      *                      LORAWAN_STATUS_PORT_INVALID      if trying to send to an invalid port (e.g. to 0)
      *                      LORAWAN_STATUS_PARAMETER_INVALID if NULL data pointer is given or flags are invalid.
      */
@@ -79,6 +79,10 @@ LoRaWANStack::LoRaWANStack()
     _rx_metadata.stale = true;
     core_util_atomic_flag_clear(&_rx_payload_in_use);
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    clear_uplink_queue();
+#endif
+
 #ifdef MBED_CONF_LORA_APP_PORT
     if (is_port_valid(MBED_CONF_LORA_APP_PORT)) {
         _app_port = MBED_CONF_LORA_APP_PORT;
@@ -279,6 +283,9 @@ lorawan_status_t LoRaWANStack::stop_sending(void)
         _ctrl_flags &= ~TX_DONE_FLAG;
         _loramac.set_tx_ongoing(false);
         _device_current_state = DEVICE_STATE_IDLE;
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+        clear_uplink_queue();
+#endif
         return LORAWAN_STATUS_OK;
     }
 
@@ -301,10 +308,24 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
         return LORAWAN_STATUS_NO_ACTIVE_SESSIONS;
     }
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    // automatic uplinks are not queued, anything else waits behind the
+    // messages already queued
+    if (!allow_port_0 && (_loramac.tx_ongoing() || _uplink_queue_count > 0)) {
+        return queue_uplink(port, data, length, flags);
+    }
+#endif
+
     if (_loramac.tx_ongoing()) {
         return LORAWAN_STATUS_WOULD_BLOCK;
     }
 
+    return send_uplink(port, data, length, flags, allow_port_0);
+}
+
+int16_t LoRaWANStack::send_uplink(const uint8_t port, const uint8_t *data,
+                                  uint16_t length, uint8_t flags, bool allow_port_0)
+{
     // add a link check request with normal data, until the application
     // explicitly removes it.
     if (_link_check_requested) {
@@ -347,6 +368,118 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
     return (status == LORAWAN_STATUS_OK) ? len : (int16_t) status;
 }
 
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+int16_t LoRaWANStack::queue_uplink(const uint8_t port, const uint8_t *data,
+                                   uint16_t length, uint8_t flags)
+{
+    if (!is_port_valid(port)) {
+        return LORAWAN_STATUS_PORT_INVALID;
+    }
+
+    switch (flags & MSG_FLAG_MASK) {
+        case MSG_UNCONFIRMED_FLAG:
+        case MSG_CONFIRMED_FLAG:
+        case MSG_PROPRIETARY_FLAG:
+            break;
+
+        default:
+            tr_error("Invalid send flags");
+            return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (_uplink_queue_count == MBED_CONF_LORA_UPLINK_QUEUE_SIZE) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    if (length > MBED_CONF_LORA_TX_MAX_SIZE) {
+        length = MBED_CONF_LORA_TX_MAX_SIZE;
+    }
+
+    queued_uplink_t &uplink = _uplink_queue[(_uplink_queue_head + _uplink_queue_count)
+                                            % MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+    uplink.port = port;
+    uplink.flags = flags;
+    uplink.length = length;
+    if (length > 0) {
+        memcpy(uplink.data, data, length);
+    }
+    _uplink_queue_count++;
+
+    // nothing in flight would trigger the queue otherwise
+    if (!_loramac.tx_ongoing() && _uplink_queue_count == 1) {
+        const int ret = _queue->call(this, &LoRaWANStack::send_queued_uplink);
+        MBED_ASSERT(ret != 0);
+        (void)ret;
+    }
+
+    return length;
+}
+
+void LoRaWANStack::send_queued_uplink(void)
+{
+    if (_uplink_queue_count == 0 || _loramac.tx_ongoing() || !_lw_session.active) {
+        return;
+    }
+
+    const queued_uplink_t &head = _uplink_queue[_uplink_queue_head];
+    const uint8_t *data = head.data;
+    uint16_t length = head.length;
+    uint8_t count = 1;
+
+#if MBED_CONF_LORA_UPLINK_AGGREGATION
+    // pack the following messages for the same port and of the same type
+    // into the frame, as long as they fit in the payload of the current
+    // datarate. A link check request takes one more byte of FOpts.
+    uint8_t max_size = _loramac.get_max_tx_size();
+    if (_link_check_requested && max_size > 0) {
+        max_size--;
+    }
+
+    if (_uplink_queue_count > 1) {
+        memcpy(_uplink_aggregate, head.data, head.length);
+        while (count < _uplink_queue_count) {
+            const queued_uplink_t &next = _uplink_queue[(_uplink_queue_head + count)
+                                                        % MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+            if (next.port != head.port || next.flags != head.flags
+                    || length + next.length > max_size) {
+                break;
+            }
+            memcpy(_uplink_aggregate + length, next.data, next.length);
+            length += next.length;
+            count++;
+        }
+        data = _uplink_aggregate;
+    }
+#endif
+
+    const int16_t ret = send_uplink(head.port, data, length, head.flags, false);
+
+    if (ret == LORAWAN_STATUS_WOULD_BLOCK || ret == LORAWAN_STATUS_BUSY) {
+        // tried again when the ongoing transmission completes
+        return;
+    }
+
+    _uplink_queue_head = (_uplink_queue_head + count) % MBED_CONF_LORA_UPLINK_QUEUE_SIZE;
+    _uplink_queue_count -= count;
+
+    if (ret < 0) {
+        tr_error("Failed to send queued uplink, error code = %d", ret);
+        send_event_to_application(TX_SCHEDULING_ERROR);
+        if (_uplink_queue_count > 0) {
+            const int id = _queue->call(this, &LoRaWANStack::send_queued_uplink);
+            MBED_ASSERT(id != 0);
+            (void)id;
+        }
+    }
+}
+
+void LoRaWANStack::clear_uplink_queue(void)
+{
+    _uplink_queue_head = 0;
+    _uplink_queue_count = 0;
+}
+#endif
+
 int16_t LoRaWANStack::handle_rx(uint8_t *data, uint16_t length, uint8_t &port, int &flags, bool validate_params)
 {
     if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
@@ -494,10 +627,10 @@ lorawan_status_t LoRaWANStack::acquire_backoff_metadata(int &backoff)
         return LORAWAN_STATUS_NOT_INITIALIZED;
     }
 
-    int id = _loramac.get_backoff_timer_event_id();
+    const int time_left = _loramac.get_backoff_time_left();
 
-    if (_loramac.get_backoff_timer_event_id() > 0) {
-        backoff = _queue->time_left(id);
+    if (time_left > 0) {
+        backoff = time_left;
         return LORAWAN_STATUS_OK;
     }
 
@@ -1126,6 +1259,9 @@ void LoRaWANStack::process_shutdown_state(lorawan_status_t &op_status)
     _device_current_state = DEVICE_STATE_SHUTDOWN;
     op_status = LORAWAN_STATUS_DEVICE_OFF;
     _ctrl_flags = 0;
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    clear_uplink_queue();
+#endif
     send_event_to_application(DISCONNECTED);
 }
 
@@ -1167,6 +1303,15 @@ void LoRaWANStack::process_status_check_state()
             mcps_indication_handler();
         }
     }
+
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    // the next queued message goes after the events of this transmission
+    if (_uplink_queue_count > 0 && !_loramac.tx_ongoing()) {
+        const int ret = _queue->call(this, &LoRaWANStack::send_queued_uplink);
+        MBED_ASSERT(ret != 0);
+        (void)ret;
+    }
+#endif
 }
 
 void LoRaWANStack::process_scheduling_state(lorawan_status_t &op_status)
@@ -448,6 +448,31 @@ private:
      */
     lorawan_status_t handle_connect(bool is_otaa);
 
+    /**
+     * Prepares and schedules an uplink, no TX may be ongoing
+     */
+    int16_t send_uplink(uint8_t port, const uint8_t *data, uint16_t length,
+                        uint8_t flags, bool allow_port_0);
+
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    /**
+     * Copies an uplink to the uplink queue
+     *
+     * @return The number of bytes queued, LORAWAN_STATUS_WOULD_BLOCK if the
+     *         queue is full or a negative error code for invalid port or flags.
+     */
+    int16_t queue_uplink(uint8_t port, const uint8_t *data, uint16_t length,
+                         uint8_t flags);
+
+    /**
+     * Sends the oldest queued uplink, together with the following ones when
+     * uplink aggregation is enabled
+     */
+    void send_queued_uplink(void);
+
+    void clear_uplink_queue(void);
+#endif
+
 
     /** Send event to application.
      *
@@ -512,6 +537,22 @@ private:
     uint8_t _rx_payload[LORAMAC_PHY_MAXPAYLOAD];
     events::EventQueue *_queue;
     lorawan_time_t _tx_timestamp;
+
+#if MBED_CONF_LORA_UPLINK_QUEUE_SIZE > 0
+    struct queued_uplink_t {
+        uint8_t port;
+        uint8_t flags;
+        uint16_t length;
+        uint8_t data[MBED_CONF_LORA_TX_MAX_SIZE];
+    };
+
+    queued_uplink_t _uplink_queue[MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+    uint8_t _uplink_queue_head;
+    uint8_t _uplink_queue_count;
+#if MBED_CONF_LORA_UPLINK_AGGREGATION
+    uint8_t _uplink_aggregate[MBED_CONF_LORA_TX_MAX_SIZE];
+#endif
+#endif
 };
 
 #endif /* LORAWANSTACK_H_ */
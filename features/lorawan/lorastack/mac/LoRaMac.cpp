@@ -633,30 +633,33 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
     }
 
     if (_params.is_rx_window_enabled == true) {
-        lorawan_time_t time_diff = _lora_time.get_current_time() - timestamp;
+        // All the timers count from the end of the transmission, whatever
+        // the latency of this handler. They share a single wakeup in the
+        // timer service, which is armed for the first of them.
+
         // start timer after which rx1_window will get opened
-        _lora_time.start(_params.timers.rx_window1_timer,
-                         _params.rx_window1_delay - time_diff);
+        _lora_time.start_at(_params.timers.rx_window1_timer, timestamp,
+                            _params.rx_window1_delay);
 
         // start timer after which rx2_window will get opened
-        _lora_time.start(_params.timers.rx_window2_timer,
-                         _params.rx_window2_delay - time_diff);
+        _lora_time.start_at(_params.timers.rx_window2_timer, timestamp,
+                            _params.rx_window2_delay);
 
         // If class C and an Unconfirmed messgae is outgoing,
         // this will start a timer which will invoke rx2 would be
         // closure handler
         if (get_device_class() == CLASS_C) {
-            _lora_time.start(_rx2_closure_timer_for_class_c,
-                             (_params.rx_window2_delay - time_diff) +
-                             _params.rx_window2_config.window_timeout_ms);
+            _lora_time.start_at(_rx2_closure_timer_for_class_c, timestamp,
+                                _params.rx_window2_delay +
+                                _params.rx_window2_config.window_timeout_ms);
         }
 
         // start timer after which ack wait will timeout (for Confirmed messages)
         if (_params.is_node_ack_requested) {
-            _lora_time.start(_params.timers.ack_timeout_timer,
-                             (_params.rx_window2_delay - time_diff) +
-                             _params.rx_window2_config.window_timeout_ms +
-                             _lora_phy->get_ack_timeout());
+            _lora_time.start_at(_params.timers.ack_timeout_timer, timestamp,
+                                _params.rx_window2_delay +
+                                _params.rx_window2_config.window_timeout_ms +
+                                _lora_phy->get_ack_timeout());
         }
     } else {
         _mcps_confirmation.status = LORAMAC_EVENT_INFO_STATUS_OK;
@@ -1057,9 +1060,9 @@ lorawan_status_t LoRaMac::send(loramac_mhdr_t *machdr, const uint8_t fport,
     return status;
 }
 
-int LoRaMac::get_backoff_timer_event_id(void)
+int LoRaMac::get_backoff_time_left(void)
 {
-    return _params.timers.backoff_timer.timer_id;
+    return _lora_time.time_left(_params.timers.backoff_timer);
 }
 
 lorawan_status_t LoRaMac::clear_tx_pipe(void)
@@ -1069,14 +1072,14 @@ lorawan_status_t LoRaMac::clear_tx_pipe(void)
     }
 
     // check if the event is not already queued
-    const int id = get_backoff_timer_event_id();
+    const int time_left = get_backoff_time_left();
 
-    if (id == 0) {
+    if (time_left < 0) {
         // No queued send request
         return LORAWAN_STATUS_NO_OP;
     }
 
-    if (_ev_queue->time_left(id) > 0) {
+    if (time_left > 0) {
         _lora_time.stop(_params.timers.backoff_timer);
         _lora_time.stop(_params.timers.ack_timeout_timer);
         memset(_params.tx_buffer, 0, sizeof _params.tx_buffer);
@@ -1363,6 +1366,18 @@ int16_t LoRaMac::prepare_ongoing_tx(const uint8_t port,
     return _ongoing_tx_msg.f_buffer_size;
 }
 
+uint8_t LoRaMac::get_max_tx_size(void)
+{
+    uint8_t max_possible_size = get_max_possible_tx_size(_mac_commands.get_mac_cmd_length()
+                                                         + _mac_commands.get_repeat_commands_length());
+
+    if (max_possible_size > MBED_CONF_LORA_TX_MAX_SIZE) {
+        max_possible_size = MBED_CONF_LORA_TX_MAX_SIZE;
+    }
+
+    return max_possible_size;
+}
+
 lorawan_status_t LoRaMac::send_ongoing_tx()
 {
     lorawan_status_t status;
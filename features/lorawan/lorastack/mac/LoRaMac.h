@@ -283,6 +283,15 @@ public:
     int16_t prepare_ongoing_tx(const uint8_t port, const uint8_t *data,
                                uint16_t length, uint8_t flags, uint8_t num_retries);
 
+    /**
+     * @brief get_max_tx_size Queries the size of the biggest FRMPayload that
+     *        prepare_ongoing_tx() would accept at the moment, taking the
+     *        pending MAC commands into account.
+     *
+     * @return Size of the biggest payload that can be sent.
+     */
+    uint8_t get_max_tx_size(void);
+
     /**
      * @brief send_ongoing_tx Sends the ongoing_tx_msg
      * @return LORAWAN_STATUS_OK or a negative error code on failure.
@@ -388,9 +397,10 @@ public:
     void set_batterylevel_callback(mbed::Callback<uint8_t(void)> battery_level);
 
     /**
-     * Returns the event ID of backoff timer.
+     * Returns the time left in ms before the backoff timer expires, or -1
+     * if it is not running.
      */
-    int get_backoff_timer_event_id(void);
+    int get_backoff_time_left(void);
 
     /**
      * Clears out the TX pipe by discarding any outgoing message if the backoff
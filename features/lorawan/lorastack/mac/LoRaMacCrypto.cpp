@@ -30,11 +30,13 @@
 #include "LoRaMacCrypto.h"
 #include "system/lorawan_data_structures.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 
 
-#if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_C)
+#if defined(MBEDTLS_AES_C)
 
 LoRaMacCrypto::LoRaMacCrypto()
+    : _next_schedule(0)
 {
 #if defined(MBEDTLS_PLATFORM_C)
     int ret = mbedtls_platform_setup(NULL);
@@ -42,15 +44,140 @@ LoRaMacCrypto::LoRaMacCrypto()
         MBED_ASSERT(0 && "LoRaMacCrypto: Fail in mbedtls_platform_setup.");
     }
 #endif /* MBEDTLS_PLATFORM_C */
+
+    for (uint8_t i = 0; i < KEY_CACHE_SIZE; i++) {
+        mbedtls_aes_init(&_key_schedules[i].aes_ctx);
+        _key_schedules[i].valid = false;
+    }
 }
 
 LoRaMacCrypto::~LoRaMacCrypto()
 {
+    for (uint8_t i = 0; i < KEY_CACHE_SIZE; i++) {
+        mbedtls_aes_free(&_key_schedules[i].aes_ctx);
+    }
+    mbedtls_platform_zeroize(_key_schedules, sizeof(_key_schedules));
+
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
 }
 
+/**
+ * Left shift of a CMAC subkey, see RFC 4493
+ */
+static void cmac_shift(const uint8_t *in, uint8_t *out)
+{
+    uint8_t overflow = 0;
+    for (int i = 15; i >= 0; i--) {
+        out[i] = (in[i] << 1) | overflow;
+        overflow = in[i] >> 7;
+    }
+    if (in[0] & 0x80) {
+        out[15] ^= 0x87;
+    }
+}
+
+int LoRaMacCrypto::get_key_schedule(const uint8_t *key, uint32_t key_length,
+                                    key_schedule_t **schedule)
+{
+    uint32_t key_bytes = key_length / 8;
+    if (key_bytes > sizeof(_key_schedules[0].key)) {
+        return MBEDTLS_ERR_AES_INVALID_KEY_LENGTH;
+    }
+
+    for (uint8_t i = 0; i < KEY_CACHE_SIZE; i++) {
+        key_schedule_t *cached = &_key_schedules[i];
+        if (cached->valid && cached->key_length == key_length
+                && (key_bytes == 0 || memcmp(cached->key, key, key_bytes) == 0)) {
+            *schedule = cached;
+            return 0;
+        }
+    }
+
+    // Replace the oldest schedule
+    key_schedule_t *entry = &_key_schedules[_next_schedule];
+    _next_schedule = (_next_schedule + 1) % KEY_CACHE_SIZE;
+    entry->valid = false;
+
+    int ret = mbedtls_aes_setkey_enc(&entry->aes_ctx, key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
+
+    // CMAC subkeys derived from the encryption of a zero block
+    uint8_t l[16] = {};
+    ret = mbedtls_aes_crypt_ecb(&entry->aes_ctx, MBEDTLS_AES_ENCRYPT, l, l);
+    if (0 != ret) {
+        return ret;
+    }
+    cmac_shift(l, entry->k1);
+    cmac_shift(entry->k1, entry->k2);
+    mbedtls_platform_zeroize(l, sizeof(l));
+
+    if (key_bytes) {
+        memcpy(entry->key, key, key_bytes);
+    }
+    entry->key_length = key_length;
+    entry->valid = true;
+    *schedule = entry;
+    return 0;
+}
+
+int LoRaMacCrypto::compute_cmac(key_schedule_t *schedule, const uint8_t *b0,
+                                const uint8_t *buffer, uint16_t size, uint8_t *mac)
+{
+    uint8_t x[16] = {};
+    int ret = 0;
+    uint8_t i;
+
+    if (b0 && size == 0) {
+        // B0 is then the last block
+        buffer = b0;
+        size = 16;
+        b0 = NULL;
+    }
+
+    if (b0) {
+        for (i = 0; i < 16; i++) {
+            x[i] ^= b0[i];
+        }
+        ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, x, x);
+        if (0 != ret) {
+            return ret;
+        }
+    }
+
+    while (size > 16) {
+        for (i = 0; i < 16; i++) {
+            x[i] ^= buffer[i];
+        }
+        ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, x, x);
+        if (0 != ret) {
+            return ret;
+        }
+        buffer += 16;
+        size -= 16;
+    }
+
+    // The last block is XORed with K1 if complete, or padded and XORed with K2
+    if (size == 16) {
+        for (i = 0; i < 16; i++) {
+            x[i] ^= buffer[i] ^ schedule->k1[i];
+        }
+    } else {
+        for (i = 0; i < size; i++) {
+            x[i] ^= buffer[i];
+        }
+        x[size] ^= 0x80;
+        for (i = 0; i < 16; i++) {
+            x[i] ^= schedule->k2[i];
+        }
+    }
+
+    return mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, x, mac);
+}
+
 int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
                                const uint8_t *key, const uint32_t key_length,
                                uint32_t address, uint8_t dir, uint32_t seq_counter,
@@ -58,7 +185,12 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 {
     uint8_t computed_mic[16] = {};
     uint8_t mic_block_b0[16] = {};
-    int ret = 0;
+    key_schedule_t *schedule;
+
+    int ret = get_key_schedule(key, key_length, &schedule);
+    if (0 != ret) {
+        return ret;
+    }
 
     mic_block_b0[0] = 0x49;
 
@@ -76,46 +208,15 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 
     mic_block_b0[15] = size & 0xFF;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = compute_cmac(schedule, mic_block_b0, buffer, size & 0xFF, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
-    return ret;
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+    return 0;
 }
 
 int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
@@ -126,14 +227,13 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     uint16_t i;
     uint8_t bufferIndex = 0;
     uint16_t ctr = 1;
-    int ret = 0;
     uint8_t a_block[16] = {};
     uint8_t s_block[16] = {};
+    key_schedule_t *schedule;
 
-    mbedtls_aes_init(&aes_ctx);
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    int ret = get_key_schedule(key, key_length, &schedule);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     a_block[0] = 0x01;
@@ -152,10 +252,10 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     while (size >= 16) {
         a_block[15] = ((ctr) & 0xFF);
         ctr++;
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
-            goto exit;
+            return ret;
         }
 
         for (i = 0; i < 16; i++) {
@@ -167,10 +267,10 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
 
     if (size > 0) {
         a_block[15] = ((ctr) & 0xFF);
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
-            goto exit;
+            return ret;
         }
 
         for (i = 0; i < size; i++) {
@@ -178,9 +278,7 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
         }
     }
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
-    return ret;
+    return 0;
 }
 
 int LoRaMacCrypto::decrypt_payload(const uint8_t *buffer, uint16_t size,
@@ -197,71 +295,47 @@ int LoRaMacCrypto::compute_join_frame_mic(const uint8_t *buffer, uint16_t size,
                                           uint32_t *mic)
 {
     uint8_t computed_mic[16] = {};
-    int ret = 0;
-
-    mbedtls_cipher_init(aes_cmac_ctx);
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    key_schedule_t *schedule;
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    int ret = get_key_schedule(key, key_length, &schedule);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = compute_cmac(schedule, NULL, buffer, size & 0xFF, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
-    return ret;
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+    return 0;
 }
 
 int LoRaMacCrypto::decrypt_join_frame(const uint8_t *buffer, uint16_t size,
                                       const uint8_t *key, uint32_t key_length,
                                       uint8_t *dec_buffer)
 {
-    int ret = 0;
-
-    mbedtls_aes_init(&aes_ctx);
+    key_schedule_t *schedule;
 
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    int ret = get_key_schedule(key, key_length, &schedule);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer,
+    ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, buffer,
                                 dec_buffer);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     // Check if optional CFList is included
     if (size >= 16) {
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer + 16,
+        ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, buffer + 16,
                                     dec_buffer + 16);
     }
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -271,39 +345,33 @@ int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *key, uint32_t key
 {
     uint8_t nonce[16];
     uint8_t *p_dev_nonce = (uint8_t *) &dev_nonce;
-    int ret = 0;
+    key_schedule_t *schedule;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    int ret = get_key_schedule(key, key_length, &schedule);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
     nonce[0] = 0x01;
     memcpy(nonce + 1, app_nonce, 6);
     memcpy(nonce + 7, p_dev_nonce, 2);
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, nwk_skey);
+    ret = mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, nwk_skey);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
     nonce[0] = 0x02;
     memcpy(nonce + 1, app_nonce, 6);
     memcpy(nonce + 7, p_dev_nonce, 2);
-    ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
-
-exit:
-    mbedtls_aes_free(&aes_ctx);
-    return ret;
+    return mbedtls_aes_crypt_ecb(&schedule->aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
 }
 #else
 
 LoRaMacCrypto::LoRaMacCrypto()
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 }
 
 LoRaMacCrypto::~LoRaMacCrypto()
@@ -317,7 +385,7 @@ LoRaMacCrypto::~LoRaMacCrypto()
 int LoRaMacCrypto::compute_mic(const uint8_t *, uint16_t, const uint8_t *, uint32_t, uint32_t,
                                uint8_t dir, uint32_t, uint32_t *)
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 
     // Never actually reaches here
     return LORAWAN_STATUS_CRYPTO_FAIL;
@@ -326,7 +394,7 @@ int LoRaMacCrypto::compute_mic(const uint8_t *, uint16_t, const uint8_t *, uint3
 int LoRaMacCrypto::encrypt_payload(const uint8_t *, uint16_t, const uint8_t *, uint32_t, uint32_t,
                                    uint8_t, uint32_t, uint8_t *)
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 
     // Never actually reaches here
     return LORAWAN_STATUS_CRYPTO_FAIL;
@@ -335,7 +403,7 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *, uint16_t, const uint8_t *, u
 int LoRaMacCrypto::decrypt_payload(const uint8_t *, uint16_t, const uint8_t *, uint32_t, uint32_t,
                                    uint8_t, uint32_t, uint8_t *)
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 
     // Never actually reaches here
     return LORAWAN_STATUS_CRYPTO_FAIL;
@@ -343,7 +411,7 @@ int LoRaMacCrypto::decrypt_payload(const uint8_t *, uint16_t, const uint8_t *, u
 
 int LoRaMacCrypto::compute_join_frame_mic(const uint8_t *, uint16_t, const uint8_t *, uint32_t, uint32_t *)
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 
     // Never actually reaches here
     return LORAWAN_STATUS_CRYPTO_FAIL;
@@ -351,7 +419,7 @@ int LoRaMacCrypto::compute_join_frame_mic(const uint8_t *, uint16_t, const uint8
 
 int LoRaMacCrypto::decrypt_join_frame(const uint8_t *, uint16_t, const uint8_t *, uint32_t, uint8_t *)
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 
     // Never actually reaches here
     return LORAWAN_STATUS_CRYPTO_FAIL;
@@ -360,7 +428,7 @@ int LoRaMacCrypto::decrypt_join_frame(const uint8_t *, uint16_t, const uint8_t *
 int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *, uint32_t, const uint8_t *, uint16_t,
                                                 uint8_t *, uint8_t *)
 {
-    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES, CMAC & CIPHER from mbedTLS");
+    MBED_ASSERT(0 && "[LoRaCrypto] Must enable AES from mbedTLS");
 
     // Never actually reaches here
     return LORAWAN_STATUS_CRYPTO_FAIL;
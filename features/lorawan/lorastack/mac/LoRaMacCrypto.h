@@ -31,7 +31,6 @@ SPDX-License-Identifier: BSD-3-Clause
 #define MBED_LORAWAN_MAC_LORAMAC_CRYPTO_H__
 
 #include "mbedtls/aes.h"
-#include "mbedtls/cmac.h"
 
 
 class LoRaMacCrypto {
@@ -152,14 +151,57 @@ public:
 
 private:
     /**
-     * AES computation context variable
+     * Number of keys whose schedules are kept: the network and application
+     * session keys, and the application key while joining
      */
-    mbedtls_aes_context aes_ctx;
+    static const uint8_t KEY_CACHE_SIZE = 3;
 
     /**
-     * CMAC computation context variable
+     * Expanded AES key schedule and CMAC subkeys of a key. The AES context
+     * uses the hardware accelerator when the target provides MBEDTLS_AES_ALT.
      */
-    mbedtls_cipher_context_t aes_cmac_ctx[1];
+    struct key_schedule_t {
+        mbedtls_aes_context aes_ctx;
+        uint8_t key[32];
+        uint32_t key_length;
+        uint8_t k1[16];
+        uint8_t k2[16];
+        bool valid;
+    };
+
+    /**
+     * Finds the schedule of a key, or expands the key in place of the
+     * oldest schedule
+     *
+     * @param [in]  key             - AES key
+     * @param [in]  key_length      - Length of the key (bits)
+     * @param [out] schedule        - Schedule of the key
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int get_key_schedule(const uint8_t *key, uint32_t key_length,
+                         key_schedule_t **schedule);
+
+    /**
+     * Computes an AES-CMAC (RFC 4493)
+     *
+     * @param [in]  schedule        - Schedule of the key
+     * @param [in]  b0              - Optional 16 bytes block preceding the buffer, or NULL
+     * @param [in]  buffer          - Data buffer
+     * @param [in]  size            - Data buffer size
+     * @param [out] mac             - 16 bytes CMAC
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int compute_cmac(key_schedule_t *schedule, const uint8_t *b0,
+                     const uint8_t *buffer, uint16_t size, uint8_t *mac);
+
+    key_schedule_t _key_schedules[KEY_CACHE_SIZE];
+
+    /**
+     * Next schedule to replace
+     */
+    uint8_t _next_schedule;
 };
 
 #endif // MBED_LORAWAN_MAC_LORAMAC_CRYPTO_H__
@@ -53,6 +53,45 @@ void LoRaPHY::initialize(LoRaWANTimeHandler *lora_time)
     _lora_time = lora_time;
 }
 
+// bit scan helpers for the 16-bit words of the channel masks
+static inline uint8_t mask_ffs(uint16_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(word);
+#else
+    uint8_t i = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+static inline uint8_t mask_popcount(uint16_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(word);
+#else
+    uint8_t count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Bits of mask word 'index' that map to existing channels
+static inline uint16_t mask_word(const uint16_t *mask, uint8_t index, uint8_t max_channels)
+{
+    uint16_t word = mask[index];
+    if (max_channels < (index + 1) * 16) {
+        word &= (1U << (max_channels - index * 16)) - 1;
+    }
+    return word;
+}
+
 bool LoRaPHY::mask_bit_test(const uint16_t *mask, unsigned bit)
 {
     return mask[bit / 16] & (1U << (bit % 16));
@@ -173,8 +212,14 @@ bool LoRaPHY::verify_channel_DR(uint16_t *channel_mask, int8_t dr)
         return false;
     }
 
-    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
-        if (mask_bit_test(channel_mask, i)) {
+    for (uint8_t w = 0; w * 16 < phy_params.max_channel_cnt; w++) {
+        uint16_t word = mask_word(channel_mask, w, phy_params.max_channel_cnt);
+
+        // visit the enabled channels only
+        while (word) {
+            uint8_t i = w * 16 + mask_ffs(word);
+            word &= word - 1;
+
             // Check datarate validity for enabled channels
             if (val_in_range(dr, (phy_params.channels.channel_list[i].dr_range.fields.min & 0x0F),
                              (phy_params.channels.channel_list[i].dr_range.fields.max & 0x0F))) {
@@ -213,15 +258,11 @@ bool LoRaPHY::disable_channel(uint16_t *channel_mask, uint8_t id,
 
 uint8_t LoRaPHY::count_bits(uint16_t mask, uint8_t nbBits)
 {
-    uint8_t nbActiveBits = 0;
-
-    for (uint8_t j = 0; j < nbBits; j++) {
-        if (mask_bit_test(&mask, j)) {
-            nbActiveBits++;
-        }
+    if (nbBits < 16) {
+        mask &= (1U << nbBits) - 1;
     }
 
-    return nbActiveBits;
+    return mask_popcount(mask);
 }
 
 uint8_t LoRaPHY::num_active_channels(uint16_t *channel_mask, uint8_t start_idx,
@@ -493,8 +534,16 @@ uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
     uint8_t count = 0;
     uint8_t delay_transmission = 0;
 
-    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
-        if (mask_bit_test(channel_mask, i)) {
+    band_t *band_table = (band_t *) phy_params.bands.table;
+
+    // Whole mask words are scanned at once, most channels of the regions
+    // with 64+ channels are usually disabled
+    for (uint8_t w = 0; w * 16 < phy_params.max_channel_cnt; w++) {
+        uint16_t word = mask_word(channel_mask, w, phy_params.max_channel_cnt);
+
+        while (word) {
+            uint8_t i = w * 16 + mask_ffs(word);
+            word &= word - 1;
 
             if (val_in_range(datarate, phy_params.channels.channel_list[i].dr_range.fields.min,
                              phy_params.channels.channel_list[i].dr_range.fields.max) == 0) {
@@ -502,7 +551,6 @@ uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
                 continue;
             }
 
-            band_t *band_table = (band_t *) phy_params.bands.table;
             if (band_table[phy_params.channels.channel_list[i].band].off_time > 0) {
                 // Check if the band is available for transmission
                 delay_transmission++;
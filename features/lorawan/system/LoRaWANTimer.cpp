@@ -19,14 +19,21 @@ SPDX-License-Identifier: BSD-3-Clause
 */
 
 #include "LoRaWANTimer.h"
+#include "platform/mbed_critical.h"
 
 LoRaWANTimeHandler::LoRaWANTimeHandler()
-    : _queue(NULL)
+    : _queue(NULL),
+      _timers(NULL),
+      _event_id(0),
+      _event_deadline(0)
 {
 }
 
 LoRaWANTimeHandler::~LoRaWANTimeHandler()
 {
+    if (_event_id) {
+        _queue->cancel(_event_id);
+    }
 }
 
 void LoRaWANTimeHandler::activate_timer_subsystem(events::EventQueue *queue)
@@ -49,16 +56,125 @@ void LoRaWANTimeHandler::init(timer_event_t &obj, mbed::Callback<void()> callbac
 {
     obj.callback = callback;
     obj.timer_id = 0;
+    obj.deadline = 0;
+    obj.next = NULL;
 }
 
 void LoRaWANTimeHandler::start(timer_event_t &obj, const uint32_t timeout)
 {
-    obj.timer_id = _queue->call_in(timeout, obj.callback);
-    MBED_ASSERT(obj.timer_id != 0);
+    start_at(obj, get_current_time(), timeout);
+}
+
+void LoRaWANTimeHandler::start_at(timer_event_t &obj, lorawan_time_t reference,
+                                  const uint32_t timeout)
+{
+    core_util_critical_section_enter();
+
+    remove(obj);
+
+    obj.deadline = reference + timeout;
+    obj.timer_id = 1;
+
+    // timers with the same deadline expire in the order they were started
+    timer_event_t **pos = &_timers;
+    while (*pos && (int32_t)((*pos)->deadline - obj.deadline) <= 0) {
+        pos = &(*pos)->next;
+    }
+    obj.next = *pos;
+    *pos = &obj;
+
+    if (_timers == &obj) {
+        arm();
+    }
+
+    core_util_critical_section_exit();
 }
 
 void LoRaWANTimeHandler::stop(timer_event_t &obj)
 {
-    _queue->cancel(obj.timer_id);
+    core_util_critical_section_enter();
+
+    if (remove(obj)) {
+        arm();
+    }
     obj.timer_id = 0;
+
+    core_util_critical_section_exit();
+}
+
+int LoRaWANTimeHandler::time_left(const timer_event_t &obj)
+{
+    int left = -1;
+
+    core_util_critical_section_enter();
+
+    for (timer_event_t *timer = _timers; timer; timer = timer->next) {
+        if (timer == &obj) {
+            int32_t delay = obj.deadline - get_current_time();
+            left = delay > 0 ? delay : 0;
+            break;
+        }
+    }
+
+    core_util_critical_section_exit();
+
+    return left;
+}
+
+bool LoRaWANTimeHandler::remove(timer_event_t &obj)
+{
+    for (timer_event_t **pos = &_timers; *pos; pos = &(*pos)->next) {
+        if (*pos == &obj) {
+            bool first = (pos == &_timers);
+            *pos = obj.next;
+            obj.next = NULL;
+            return first;
+        }
+    }
+    return false;
+}
+
+void LoRaWANTimeHandler::arm(void)
+{
+    if (_event_id) {
+        if (_timers && _timers->deadline == _event_deadline) {
+            // already armed for this deadline
+            return;
+        }
+        _queue->cancel(_event_id);
+        _event_id = 0;
+    }
+
+    if (_timers) {
+        int32_t delay = _timers->deadline - get_current_time();
+        _event_deadline = _timers->deadline;
+        _event_id = _queue->call_in(delay > 0 ? delay : 0, this, &LoRaWANTimeHandler::dispatch);
+        MBED_ASSERT(_event_id != 0);
+    }
+}
+
+void LoRaWANTimeHandler::dispatch(void)
+{
+    core_util_critical_section_enter();
+    _event_id = 0;
+
+    // the callbacks may start and stop timers, the list is checked again
+    // after each of them
+    while (_timers && (int32_t)(_timers->deadline - get_current_time()) <= 0) {
+        timer_event_t *timer = _timers;
+        _timers = timer->next;
+        timer->next = NULL;
+        timer->timer_id = 0;
+        mbed::Callback<void()> callback = timer->callback;
+
+        core_util_critical_section_exit();
+        if (callback) {
+            callback();
+        }
+        core_util_critical_section_enter();
+    }
+
+    arm();
+
+    core_util_critical_section_exit();
 }
@@ -70,14 +70,54 @@ public:
      */
     void start(timer_event_t &obj, const uint32_t timeout);
 
+    /** Starts a timer relative to a moment in the past.
+     *
+     * The deadline does not depend on when this is called, e.g. the RX windows
+     * are timed from the end of the transmission. A deadline already passed
+     * expires at once.
+     *
+     * @param [in] obj       The structure containing the timer object parameters.
+     * @param [in] reference The moment the timeout is counted from.
+     * @param [in] timeout   The new timeout value.
+     */
+    void start_at(timer_event_t &obj, lorawan_time_t reference, const uint32_t timeout);
+
     /** Stops and removes the timer object from the list of timer events.
      *
      * @param [in] obj The structure containing the timer object parameters.
      */
     void stop(timer_event_t &obj);
 
+    /** Time left before a timer expires.
+     *
+     * @param [in] obj The structure containing the timer object parameters.
+     * @return     The time left in ms, 0 if the timer expires now or -1 if
+     *             the timer is not running.
+     */
+    int time_left(const timer_event_t &obj);
+
 private:
+    /** Removes a timer from the list of timer events.
+     *
+     * @return true if the timer was the first one to expire
+     */
+    bool remove(timer_event_t &obj);
+
+    /** Posts the single EventQueue event for the first deadline of the list.
+     */
+    void arm(void);
+
+    /** Runs the callbacks of the expired timers in the order of their deadlines.
+     */
+    void dispatch(void);
+
     events::EventQueue *_queue;
+
+    // Running timers sorted by deadline. All of them share one event of the
+    // EventQueue, armed for the first deadline.
+    timer_event_t *_timers;
+    int _event_id;
+    lorawan_time_t _event_deadline;
 };
 
 #endif // MBED_LORAWAN_SYS_TIMER_H__
@@ -1051,9 +1051,17 @@ typedef struct {
 /*!
  * \brief Timer object description
  */
-typedef struct {
+typedef struct timer_event_s {
     mbed::Callback<void()> callback;
+    /*!
+     * Non-zero while the timer is running
+     */
     int timer_id;
+    /*!
+     * Expiry time, see LoRaWANTimeHandler
+     */
+    lorawan_time_t deadline;
+    struct timer_event_s *next;
 } timer_event_t;
 
 /*!
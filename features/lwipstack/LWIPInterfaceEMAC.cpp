@@ -23,9 +23,31 @@
 #include "netsocket/EMAC.h"
 
 #include "LWIPStack.h"
+#include "platform/mbed_profile.h"
 
 #if LWIP_ETHERNET
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+static const struct {
+    uint32_t capability;
+    u16_t checksum;
+} emac_checksum_offloads[] = {
+    { EMAC::CAPABILITY_TX_CHECKSUM_IPV4,  NETIF_CHECKSUM_GEN_IP },
+    { EMAC::CAPABILITY_TX_CHECKSUM_TCP,   NETIF_CHECKSUM_GEN_TCP },
+    { EMAC::CAPABILITY_TX_CHECKSUM_ICMP,  NETIF_CHECKSUM_GEN_ICMP },
+    { EMAC::CAPABILITY_TX_CHECKSUM_ICMP6, NETIF_CHECKSUM_GEN_ICMP6 },
+    { EMAC::CAPABILITY_RX_CHECKSUM_IPV4,  NETIF_CHECKSUM_CHECK_IP },
+    { EMAC::CAPABILITY_RX_CHECKSUM_TCP,   NETIF_CHECKSUM_CHECK_TCP },
+    { EMAC::CAPABILITY_RX_CHECKSUM_ICMP,  NETIF_CHECKSUM_CHECK_ICMP },
+    { EMAC::CAPABILITY_RX_CHECKSUM_ICMP6, NETIF_CHECKSUM_CHECK_ICMP6 },
+#if !(IP_FRAG || IP_REASSEMBLY || LWIP_IPV6_FRAG || LWIP_IPV6_REASS)
+    // UDP datagrams could be fragmented, which hardware can't checksum
+    { EMAC::CAPABILITY_TX_CHECKSUM_UDP,   NETIF_CHECKSUM_GEN_UDP },
+    { EMAC::CAPABILITY_RX_CHECKSUM_UDP,   NETIF_CHECKSUM_CHECK_UDP },
+#endif
+};
+#endif
+
 err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p)
 {
     /* Increase reference counter since lwip stores handle to pbuf and frees
@@ -33,12 +55,45 @@ err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p
     pbuf_ref(p);
 
     LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(netif->state);
-    bool ret = mbed_if->emac->link_out(p);
-    return ret ? ERR_OK : ERR_IF;
+    if (!mbed_if->tx_batch_enabled) {
+        bool ret = mbed_if->emac->link_out(p);
+        return ret ? ERR_OK : ERR_IF;
+    }
+
+    /* Collect frames produced by the current piece of work, typically a run of
+       TCP segments, and hand them to the EMAC together once it has finished */
+    mbed_if->tx_batch[mbed_if->tx_batch_count++] = p;
+    if (mbed_if->tx_batch_count == MBED_CONF_LWIP_EMAC_TX_BATCH_SIZE) {
+        emac_tx_flush(mbed_if);
+    } else if (!mbed_if->tx_flush_pending) {
+        if (tcpip_try_callback(&LWIP::Interface::emac_tx_flush, mbed_if) == ERR_OK) {
+            mbed_if->tx_flush_pending = true;
+        } else {
+            emac_tx_flush(mbed_if);
+        }
+    }
+    return ERR_OK;
+}
+
+void LWIP::Interface::emac_tx_flush(void *ctx)
+{
+    LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(ctx);
+    uint8_t count = mbed_if->tx_batch_count;
+
+    /* Clearing pending here means only callbacks queued after this one can
+       find the batch empty, which they tolerate */
+    mbed_if->tx_flush_pending = false;
+    if (count == 0) {
+        return;
+    }
+    mbed_if->tx_batch_count = 0;
+    mbed_if->emac->link_out_batch(mbed_if->tx_batch, count);
 }
 
 void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
 {
+    MBED_PROFILE("lwip emac_input");
+
     struct pbuf *p = static_cast<struct pbuf *>(buf);
 
     /* pass all packets to ethernet_input, which decides what packets it supports */
@@ -158,6 +213,23 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
 
     mbed_if->emac->get_ifname(netif->name, NSAPI_INTERFACE_PREFIX_SIZE);
 
+    uint32_t capabilities = mbed_if->emac->get_capabilities();
+
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* Leave checksums the hardware handles to it */
+    u16_t chksum_flags = NETIF_CHECKSUM_ENABLE_ALL;
+    for (size_t i = 0; i < sizeof emac_checksum_offloads / sizeof emac_checksum_offloads[0]; i++) {
+        if (capabilities & emac_checksum_offloads[i].capability) {
+            chksum_flags &= ~emac_checksum_offloads[i].checksum;
+        }
+    }
+    NETIF_SET_CHECKSUM_CTRL(netif, chksum_flags);
+#endif
+
+    mbed_if->tx_batch_count = 0;
+    mbed_if->tx_flush_pending = false;
+    mbed_if->tx_batch_enabled = MBED_CONF_LWIP_EMAC_TX_BATCH_SIZE > 1 && (capabilities & EMAC::CAPABILITY_TX_BATCH);
+
 #if LWIP_IPV4
     netif->output = etharp_output;
 #if LWIP_IGMP
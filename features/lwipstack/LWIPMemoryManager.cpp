@@ -13,9 +13,26 @@
  * limitations under the License.
  */
 
+#include <stdlib.h>
 #include "pbuf.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include "platform/mbed_atomic.h"
 #include "LWIPMemoryManager.h"
 
+#if MBED_CONF_LWIP_PBUF_POOL_OVERFLOW_MAX
+static uint32_t pool_overflow_used;
+static uint32_t pool_overflow_max;
+static uint32_t pool_overflow_err;
+
+static void pool_overflow_free(struct pbuf *p)
+{
+    // The pbuf_custom is at the start of the allocated block
+    free(p);
+    core_util_atomic_decr_u32(&pool_overflow_used, 1);
+}
+#endif
+
 net_stack_mem_buf_t *LWIPMemoryManager::alloc_heap(uint32_t size, uint32_t align)
 {
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + align, PBUF_RAM);
@@ -34,12 +51,104 @@ net_stack_mem_buf_t *LWIPMemoryManager::alloc_pool(uint32_t size, uint32_t align
 
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + total_align, PBUF_POOL);
     if (pbuf == NULL) {
+        return alloc_pool_overflow(size, align);
+    }
+
+    align_memory(pbuf, align);
+
+    return static_cast<net_stack_mem_buf_t *>(pbuf);
+}
+
+net_stack_mem_buf_t *LWIPMemoryManager::alloc_pool_overflow(uint32_t size, uint32_t align)
+{
+#if MBED_CONF_LWIP_PBUF_POOL_OVERFLOW_MAX
+    const uint32_t header_len = LWIP_MEM_ALIGN_SIZE(sizeof(struct pbuf_custom));
+
+    if (size + align > 0xFFFF) {
+        core_util_atomic_incr_u32(&pool_overflow_err, 1);
+        return NULL;
+    }
+
+    // Claim one of the overflow buffers
+    uint32_t used = core_util_atomic_load_u32(&pool_overflow_used);
+    do {
+        if (used >= MBED_CONF_LWIP_PBUF_POOL_OVERFLOW_MAX) {
+            core_util_atomic_incr_u32(&pool_overflow_err, 1);
+            return NULL;
+        }
+    } while (!core_util_atomic_cas_u32(&pool_overflow_used, &used, used + 1));
+
+    uint32_t max = core_util_atomic_load_u32(&pool_overflow_max);
+    while (used + 1 > max && !core_util_atomic_cas_u32(&pool_overflow_max, &max, used + 1)) {
+    }
+
+    struct pbuf_custom *custom = static_cast<struct pbuf_custom *>(malloc(header_len + size + align));
+    if (custom == NULL) {
+        core_util_atomic_decr_u32(&pool_overflow_used, 1);
+        core_util_atomic_incr_u32(&pool_overflow_err, 1);
         return NULL;
     }
+    custom->custom_free_function = pool_overflow_free;
+
+    // Typed as a pool buffer, so the stack treats it like one
+    struct pbuf *pbuf = pbuf_alloced_custom(PBUF_RAW, size + align, PBUF_POOL, custom,
+                                            reinterpret_cast<uint8_t *>(custom) + header_len, size + align);
 
     align_memory(pbuf, align);
 
     return static_cast<net_stack_mem_buf_t *>(pbuf);
+#else
+    return NULL;
+#endif
+}
+
+size_t LWIPMemoryManager::get_pool_stats(pool_stats_t *stats, size_t count)
+{
+    size_t n = 0;
+
+#if LWIP_STATS && MEM_STATS
+    if (n < count) {
+        stats[n].name = "HEAP";
+        stats[n].size = 0;
+        stats[n].avail = lwip_stats.mem.avail;
+        stats[n].used = lwip_stats.mem.used;
+        stats[n].max = lwip_stats.mem.max;
+        stats[n].err = lwip_stats.mem.err;
+        n++;
+    }
+#endif
+
+#if LWIP_STATS && MEMP_STATS
+    static const char *const memp_names[] = {
+#define LWIP_MEMPOOL(name, num, size, desc) desc,
+#include "lwip/priv/memp_std.h"
+    };
+
+    for (int i = 0; i < MEMP_MAX && n < count; i++) {
+        const struct stats_mem *memp = lwip_stats.memp[i];
+        stats[n].name = memp_names[i];
+        stats[n].size = memp_pools[i]->size;
+        stats[n].avail = memp->avail;
+        stats[n].used = memp->used;
+        stats[n].max = memp->max;
+        stats[n].err = memp->err;
+        n++;
+    }
+#endif
+
+#if MBED_CONF_LWIP_PBUF_POOL_OVERFLOW_MAX
+    if (n < count) {
+        stats[n].name = "PBUF_POOL_OVERFLOW";
+        stats[n].size = 0;
+        stats[n].avail = MBED_CONF_LWIP_PBUF_POOL_OVERFLOW_MAX;
+        stats[n].used = core_util_atomic_load_u32(&pool_overflow_used);
+        stats[n].max = core_util_atomic_load_u32(&pool_overflow_max);
+        stats[n].err = core_util_atomic_load_u32(&pool_overflow_err);
+        n++;
+    }
+#endif
+
+    return n;
 }
 
 uint32_t LWIPMemoryManager::get_pool_alloc_unit(uint32_t align) const
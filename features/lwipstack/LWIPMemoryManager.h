@@ -22,6 +22,16 @@
 class LWIPMemoryManager final : public EMACMemoryManager {
 public:
 
+    /** Statistics for the lwIP heap or one of its memory pools */
+    struct pool_stats_t {
+        const char *name;   /**< Pool description */
+        uint32_t size;      /**< Size of each element in bytes, or 0 for the heap */
+        uint32_t avail;     /**< Number of elements, or bytes for the heap */
+        uint32_t used;      /**< Number of elements, or bytes, currently in use */
+        uint32_t max;       /**< Most elements, or bytes, ever in use */
+        uint32_t err;       /**< Number of failed allocations */
+    };
+
     /**
      * Allocates memory buffer from the heap
      *
@@ -161,8 +171,34 @@ public:
      */
     void set_len(net_stack_mem_buf_t *buf, uint32_t len) override;
 
+    /**
+     * Get lwIP memory statistics
+     *
+     * Fills in statistics for the lwIP heap, then each of lwIP's fixed-size pools
+     * (including the pbuf pool), then the heap-backed pbuf pool overflow if
+     * lwip.pbuf-pool-overflow-max is set. Heap and pool statistics require
+     * lwip.memory-stats-enabled.
+     *
+     * @param stats    Array to fill in
+     * @param count    Number of entries in the array
+     * @return         Number of entries filled in
+     */
+    static size_t get_pool_stats(pool_stats_t *stats, size_t count);
+
 private:
 
+    /**
+     * Allocates a pool-like buffer from the system heap
+     *
+     * Used when the pbuf pool is exhausted, up to lwip.pbuf-pool-overflow-max
+     * buffers at a time.
+     *
+     * @param  size    Size of the memory to allocate in bytes
+     * @param  align   Memory alignment requirement in bytes
+     * @return         Allocated memory buffer, or NULL in case of error
+     */
+    net_stack_mem_buf_t *alloc_pool_overflow(uint32_t size, uint32_t align);
+
     /**
      * Returns a total memory alignment size
      *
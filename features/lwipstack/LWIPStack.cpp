@@ -28,6 +28,7 @@
 #include "lwip/dhcp.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/priv/tcpip_priv.h"
 #include "lwip/ip.h"
 #include "lwip/mld6.h"
 #include "lwip/igmp.h"
@@ -45,6 +46,14 @@
 #define LWIP_SOCKET_MAX_MEMBERSHIPS 4
 #endif
 
+#if LWIP_TCP && !MEM_LIBC_MALLOC && MEM_SIZE < TCP_SND_BUF
+#warning lwip.mem-size is smaller than lwip.tcp-snd-buf, so a TCP socket cannot fill its send window.
+#endif
+
+#if LWIP_TCP && LWIP_TCP_SACK_OUT && MEMP_NUM_TCP_SEG < (TCP_WND / TCP_MSS)
+#warning lwip.memp-num-tcp-seg cannot queue a full window of out-of-order segments, limiting the use of SACK.
+#endif
+
 void LWIP::socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len)
 {
     // Filter send minus events
@@ -230,6 +239,11 @@ nsapi_error_t LWIP::get_ip_address_if(SocketAddress *address, const char *interf
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+NetStackMemoryManager *LWIP::get_memory_manager()
+{
+    return &memory_manager;
+}
+
 nsapi_error_t LWIP::socket_open(nsapi_socket_t *handle, nsapi_protocol_t proto)
 {
     // check if network is connected
@@ -439,13 +453,44 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
 #endif
 }
 
-nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
+nsapi_size_or_error_t LWIP::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf, nsapi_size_t size)
 {
+#if LWIP_TCP
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
-    ip_addr_t ip_addr;
+    *buf = NULL;
+
+    if (!s->buf) {
+        err_t err = netconn_recv_tcp_pbuf(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+    }
+
+    u16_t recv = s->buf->tot_len - s->offset;
+    if (recv > size) {
+        return NetworkStack::socket_recv_buf(handle, buf, size);
+    }
+
+    // Hand over what is left of the chain as it is
+    struct pbuf *p = s->buf;
+    s->buf = 0;
+    if (s->offset) {
+        p = pbuf_free_header(p, s->offset);
+    }
+
+    *buf = static_cast<net_stack_mem_buf_t *>(p);
+    return recv;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
 
+nsapi_error_t LWIP::sendto_check(struct mbed_lwip_socket *s, const SocketAddress &address, ip_addr_t *ip_addr)
+{
     nsapi_addr_t addr = address.get_addr();
-    if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+    if (!convert_mbed_addr_to_lwip(ip_addr, &addr)) {
         return NSAPI_ERROR_PARAMETER;
     }
     struct netif *netif_ = netif_get_by_index(s->conn->pcb.ip->netif_idx);
@@ -458,6 +503,18 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
             return NSAPI_ERROR_PARAMETER;
         }
     }
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    ip_addr_t ip_addr;
+
+    nsapi_error_t check = sendto_check(s, address, &ip_addr);
+    if (check != NSAPI_ERROR_OK) {
+        return check;
+    }
     struct netbuf *buf = netbuf_new();
 
     err_t err = netbuf_ref(buf, data, (u16_t)size);
@@ -498,6 +555,131 @@ nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct pbuf *p = static_cast<struct pbuf *>(buf);
+    ip_addr_t ip_addr;
+
+    nsapi_error_t check = sendto_check(s, address, &ip_addr);
+    if (check != NSAPI_ERROR_OK) {
+        pbuf_free(p);
+        return check;
+    }
+
+    struct netbuf *nbuf = netbuf_new();
+    if (!nbuf) {
+        pbuf_free(p);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    // The netbuf frees the chain when it is deleted
+    nbuf->p = p;
+    nbuf->ptr = p;
+    u16_t size = p->tot_len;
+
+    err_t err = netconn_sendto(s->conn, nbuf, &ip_addr, address.get_port());
+    netbuf_delete(nbuf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address, net_stack_mem_buf_t **buf, nsapi_size_t size)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct netbuf *nbuf;
+    *buf = NULL;
+
+    err_t err = netconn_recv(s->conn, &nbuf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(nbuf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(nbuf));
+    }
+
+    struct pbuf *p = nbuf->p;
+    u16_t recv = p->tot_len;
+    if (recv > size) {
+        // Truncate into a copy, as recvfrom would
+        recv = size;
+        p = static_cast<struct pbuf *>(memory_manager.alloc_heap(recv, 0));
+        if (p) {
+            netbuf_copy(nbuf, p->payload, recv);
+        }
+    } else {
+        // Take the chain out of the netbuf so deleting it leaves the chain alone
+        nbuf->p = NULL;
+        nbuf->ptr = NULL;
+    }
+    netbuf_delete(nbuf);
+
+    if (!p) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    *buf = static_cast<net_stack_mem_buf_t *>(p);
+    return recv;
+}
+
+#if LWIP_UDP && LWIP_TCPIP_CORE_LOCKING
+nsapi_size_or_error_t LWIP::socket_sendto_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_UDP) {
+        return NetworkStack::socket_sendto_batch(handle, datagrams, count);
+    }
+    if (!count) {
+        return 0;
+    }
+
+    // The core lock is not recursive, so the pcb is driven directly
+    // instead of going through netconn_sendto
+    nsapi_size_t sent;
+    LOCK_TCPIP_CORE();
+    for (sent = 0; sent < count; sent++) {
+        nsapi_datagram_t &datagram = datagrams[sent];
+        ip_addr_t ip_addr;
+
+        datagram.result = sendto_check(s, datagram.address, &ip_addr);
+        if (datagram.result != NSAPI_ERROR_OK) {
+            break;
+        }
+        if (datagram.size > 0xFFFF) {
+            datagram.result = NSAPI_ERROR_PARAMETER;
+            break;
+        }
+
+        struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, 0, PBUF_REF);
+        if (!p) {
+            datagram.result = NSAPI_ERROR_NO_MEMORY;
+            break;
+        }
+        p->payload = datagram.data;
+        p->len = p->tot_len = (u16_t)datagram.size;
+
+        err_t err = udp_sendto(s->conn->pcb.udp, p, &ip_addr, datagram.address.get_port());
+        pbuf_free(p);
+        if (err != ERR_OK) {
+            datagram.result = err_remap(err);
+            break;
+        }
+        datagram.result = datagram.size;
+    }
+    UNLOCK_TCPIP_CORE();
+
+    return sent ? (nsapi_size_or_error_t)sent : datagrams[0].result;
+}
+#endif
+
 int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr)
 {
     uint32_t count = 0;
@@ -517,6 +699,69 @@ int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsap
     return -1;
 }
 
+#if LWIP_TCP
+struct lwip_tcp_option_call {
+    struct tcpip_api_call_data call;
+    struct tcp_pcb *pcb;
+    int optname;
+    int value;
+    uint32_t *sndbuf_reserved;
+};
+
+/* Applies a TCP option in the TCP/IP thread, as it touches state also used by incoming segments */
+static err_t lwip_tcp_option_apply(struct tcpip_api_call_data *call)
+{
+    struct lwip_tcp_option_call *opt = (struct lwip_tcp_option_call *)call;
+    struct tcp_pcb *pcb = opt->pcb;
+
+    if (pcb->state == LISTEN) {
+        return ERR_ARG;
+    }
+
+    switch (opt->optname) {
+        case NSAPI_TCP_NODELAY:
+            if (opt->value) {
+                tcp_nagle_disable(pcb);
+            } else {
+                tcp_nagle_enable(pcb);
+            }
+            break;
+
+        case NSAPI_TCP_CORK:
+            if (opt->value) {
+                tcp_set_flags(pcb, TF_CORK);
+            } else {
+                tcp_clear_flags(pcb, TF_CORK);
+            }
+            break;
+
+        case NSAPI_SNDBUF: {
+            uint32_t reserved = TCP_SND_BUF - opt->value;
+            if (reserved > *opt->sndbuf_reserved) {
+                // Shrinking takes space that must not already be queued
+                if (pcb->snd_buf < reserved - *opt->sndbuf_reserved) {
+                    return ERR_WOULDBLOCK;
+                }
+                pcb->snd_buf -= (tcpwnd_size_t)(reserved - *opt->sndbuf_reserved);
+            } else {
+                pcb->snd_buf += (tcpwnd_size_t)(*opt->sndbuf_reserved - reserved);
+            }
+            *opt->sndbuf_reserved = reserved;
+            return ERR_OK;
+        }
+
+        default:
+            return ERR_ARG;
+    }
+
+    // Send anything that was being held back
+    if (pcb->state != CLOSED && pcb->state != SYN_SENT) {
+        return tcp_output(pcb);
+    }
+    return ERR_OK;
+}
+#endif
+
 nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, const void *optval, unsigned optlen)
 {
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
@@ -554,6 +799,30 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
             s->conn->pcb.tcp->keep_intvl = *(int *)optval;
             return 0;
+
+        case NSAPI_TCP_NODELAY:
+        case NSAPI_TCP_CORK:
+        case NSAPI_SNDBUF: {
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (!s->conn->pcb.tcp) {
+                return NSAPI_ERROR_NO_CONNECTION;
+            }
+
+            int value = *(const int *)optval;
+            if (optname == NSAPI_SNDBUF && (value <= 0 || value > TCP_SND_BUF)) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            struct lwip_tcp_option_call call;
+            call.pcb = s->conn->pcb.tcp;
+            call.optname = optname;
+            call.value = value;
+            call.sndbuf_reserved = &s->sndbuf_reserved;
+            return err_remap(tcpip_api_call(lwip_tcp_option_apply, &call.call));
+        }
 #endif
 
         case NSAPI_REUSEADDR:
@@ -673,7 +942,54 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
 nsapi_error_t LWIP::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
 {
-    return NSAPI_ERROR_UNSUPPORTED;
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (level != NSAPI_SOCKET) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    switch (optname) {
+#if LWIP_TCP && LWIP_TCP_RTX_COUNT
+        case NSAPI_RETRANSMISSIONS:
+            if (*optlen < sizeof(uint32_t) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (!s->conn->pcb.tcp) {
+                return NSAPI_ERROR_NO_CONNECTION;
+            }
+
+            *(uint32_t *)optval = s->conn->pcb.tcp->rtx_count;
+            *optlen = sizeof(uint32_t);
+            return 0;
+#endif
+#if LWIP_TCP
+        case NSAPI_TCP_NODELAY:
+        case NSAPI_TCP_CORK:
+        case NSAPI_SNDBUF:
+            if (*optlen < sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            if (!s->conn->pcb.tcp || s->conn->pcb.tcp->state == LISTEN) {
+                return NSAPI_ERROR_NO_CONNECTION;
+            }
+
+            if (optname == NSAPI_TCP_NODELAY) {
+                *(int *)optval = tcp_nagle_disabled(s->conn->pcb.tcp) ? 1 : 0;
+            } else if (optname == NSAPI_TCP_CORK) {
+                *(int *)optval = tcp_is_flag_set(s->conn->pcb.tcp, TF_CORK) ? 1 : 0;
+            } else {
+                *(int *)optval = TCP_SND_BUF - s->sndbuf_reserved;
+            }
+            *optlen = sizeof(int);
+            return 0;
+#endif
+
+        default:
+            (void)s;
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
 }
 
 
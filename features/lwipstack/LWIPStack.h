@@ -165,6 +165,7 @@ public:
 
 #if LWIP_ETHERNET
         static err_t emac_low_level_output(struct netif *netif, struct pbuf *p);
+        static void emac_tx_flush(void *ctx);
         void emac_input(net_stack_mem_buf_t *buf);
         void emac_state_change(bool up);
 #if LWIP_IGMP
@@ -249,6 +250,13 @@ public:
         bool ppp_enabled;
         mbed::Callback<void(nsapi_event_t, intptr_t)> client_callback;
         struct netif netif;
+#if LWIP_ETHERNET
+        /* Frames waiting to go to an EMAC that sends in batches */
+        emac_mem_buf_t *tx_batch[MBED_CONF_LWIP_EMAC_TX_BATCH_SIZE];
+        uint8_t tx_batch_count;
+        bool tx_batch_enabled;
+        bool tx_flush_pending;
+#endif
         static Interface *list;
         Interface *next;
         LWIPMemoryManager *memory_manager;
@@ -350,6 +358,9 @@ public:
       */
     void set_default_interface(OnboardNetworkStack::Interface *interface) override;
 
+    /** @copydoc NetworkStack::get_memory_manager */
+    NetStackMemoryManager *get_memory_manager() override;
+
 protected:
     LWIP();
 
@@ -502,6 +513,66 @@ protected:
     nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                           void *buffer, nsapi_size_t size) override;
 
+    /** Receive data into a network buffer over a TCP socket
+     *
+     *  Hands over the pbuf chain lwIP received, without copying, if it is
+     *  no longer than size. Otherwise copies size bytes into a new buffer.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received buffer chain
+     *  @param size     Maximum number of bytes to receive
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle,
+                                          net_stack_mem_buf_t **buf, nsapi_size_t size) override;
+
+    /** Send a network buffer as a packet over a UDP socket
+     *
+     *  The pbuf chain is passed to lwIP without copying. The stack takes
+     *  ownership of it, unless NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buf      Buffer chain from get_memory_manager()
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                            net_stack_mem_buf_t *buf) override;
+
+    /** Receive a packet into a network buffer over a UDP socket
+     *
+     *  Hands over the pbuf chain lwIP received, without copying, if it is
+     *  no longer than size. Otherwise copies size bytes into a new buffer.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buf      Destination for the received buffer chain
+     *  @param size     Maximum number of bytes to receive
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                              net_stack_mem_buf_t **buf, nsapi_size_t size) override;
+
+#if LWIP_UDP && LWIP_TCPIP_CORE_LOCKING
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Takes the core lock once and hands each datagram straight to the
+     *  UDP pcb, rather than posting one message to the tcpip thread per
+     *  datagram.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to send
+     *  @param count     Number of datagrams
+     *  @return          Number of sent datagrams on success, negative error
+     *                   code on failure
+     */
+    nsapi_size_or_error_t socket_sendto_batch(nsapi_socket_t handle,
+                                              nsapi_datagram_t *datagrams, nsapi_size_t count) override;
+#endif
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -595,6 +666,9 @@ private:
         nsapi_ip_mreq_t *multicast_memberships;
         uint32_t         multicast_memberships_count;
         uint32_t         multicast_memberships_registry;
+
+        // Amount by which NSAPI_SNDBUF has reduced the send buffer below TCP_SND_BUF
+        uint32_t sndbuf_reserved;
     };
 
     struct lwip_callback {
@@ -644,6 +718,9 @@ private:
     }
     static int32_t find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr);
 
+    /* Convert the destination of a sendto, checking the socket's interface has an address of its family */
+    nsapi_error_t sendto_check(struct mbed_lwip_socket *s, const SocketAddress &address, ip_addr_t *ip_addr);
+
     static void socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len);
 
     static void tcpip_init_irq(void *handle);
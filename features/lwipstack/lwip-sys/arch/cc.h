@@ -81,11 +81,23 @@ extern "C" {
 
     void* thumb2_memcpy(void* pDest, const void* pSource, size_t length);
     uint16_t thumb2_checksum(const void* pData, int length);
+#elif defined(__thumb2__)
+    /* Other Thumb-2 toolchains use lwIP's 32-bit accumulating version */
+    #define LWIP_CHKSUM_ALGORITHM   3
 #else
     /* Used with IP headers only */
     #define LWIP_CHKSUM_ALGORITHM   1
 #endif
 
+/* Checksum TCP data while copying it from the application, rather than
+   in a second pass over the segment */
+#if defined(__thumb2__)
+    #define LWIP_CHECKSUM_ON_COPY   1
+    #define LWIP_CHKSUM_COPY        mbed_lwip_chksum_copy
+
+    uint16_t mbed_lwip_chksum_copy(void* pDest, const void* pSource, uint16_t length);
+#endif
+
 
 #ifdef LWIP_DEBUG
 
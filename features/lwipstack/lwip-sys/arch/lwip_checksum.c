@@ -12,13 +12,15 @@
    See the License for the specific language governing permissions and
    limitations under the License.
 */
+#include "platform/mbed_toolchain.h"
+
 #if defined(TOOLCHAIN_GCC) && defined(__thumb2__)
 
 
 /* This is a hand written Thumb-2 assembly language version of the
    algorithm 3 version of lwip_standard_chksum in lwIP's inet_chksum.c.  It
-   performs the checksumming 32-bits at a time and even unrolls the loop to
-   perform two of these 32-bit adds per loop iteration.
+   performs the checksumming 32-bits at a time, loading four words per loop
+   iteration and chaining their carries through ADCS.
    
    Returns:
         16-bit 1's complement summation (not inversed).
@@ -27,7 +29,7 @@
          but is marked as void so that GCC doesn't issue warning because it
          doesn't know about this low level return.
 */
-__attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int length)
+__attribute__((naked)) MBED_FAST_CODE void /*uint16_t*/ thumb2_checksum(const void* pData, int length)
 {
     __asm (
         ".syntax unified\n"
@@ -35,7 +37,7 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
 
         // Push non-volatile registers we use on stack.  Push link register too to
         // keep stack 8-byte aligned and allow single pop to restore and return.
-        "    push        {r4, lr}\n"
+        "    push        {r4, r5, r6, lr}\n"
         // Initialize sum, r2, to 0.
         "    movs    r2, #0\n"
         // Remember whether pData was at odd address in r3.  This is used later to
@@ -69,21 +71,31 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
         "    adds    r2, r2, r4\n"
         "    subs    r1, r1, #2\n"
 
-        // Main summing loop which sums up data 2 words at a time.
-        // Make sure that we have more than 7 bytes left to sum.
+        // Main summing loop which sums up data 4 words at a time.
+        // Make sure that we have more than 15 bytes left to sum.
         "2$:\n"
-        "    cmp     r1, #8\n"
-        "    blt     3$\n"
-        // Sum next two words.  Applying previous upper 16-bit carry to
-        // lower 16-bits.
-        "    ldr     r4, [r0], #4\n"
+        "    cmp     r1, #16\n"
+        "    blt     4$\n"
+        // Sum next four words, carrying from each add into the next and
+        // applying the final carry to the lower 16-bits.
+        "    ldmia   r0!, {r4, r5, r6, r12}\n"
         "    adds    r2, r4\n"
+        "    adcs    r2, r5\n"
+        "    adcs    r2, r6\n"
+        "    adcs    r2, r12\n"
         "    adc     r2, r2, #0\n"
+        "    subs    r1, r1, #16\n"
+        "    b       2$\n"
+
+        // Sum up any remaining words.
+        "4$:\n"
+        "    cmp     r1, #4\n"
+        "    blt     3$\n"
         "    ldr     r4, [r0], #4\n"
         "    adds    r2, r4\n"
         "    adc     r2, r2, #0\n"
-        "    subs    r1, r1, #8\n"
-        "    b       2$\n"
+        "    subs    r1, r1, #4\n"
+        "    b       4$\n"
 
         // Sum up any remaining half-words.
         "3$:\n"
@@ -119,8 +131,79 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
 
         // Return final sum.
         "9$: mov     r0, r2\n"
-        "    pop     {r4, pc}\n"
+        "    pop     {r4, r5, r6, pc}\n"
     );
 }
 
 #endif
+
+#if defined(__thumb2__)
+
+#include "lwip/inet_chksum.h"
+
+/* Copy and checksum in a single pass, for LWIP_CHKSUM_COPY.  Words are
+   summed into a 64-bit accumulator so the compiler can chain the carries
+   with ADDS/ADC, and the total is folded to 16 bits at the end.
+
+   Returns:
+        16-bit 1's complement summation (not inversed), in the same byte
+        order as LWIP_CHKSUM.
+*/
+MBED_FAST_CODE uint16_t mbed_lwip_chksum_copy(void* pDest, const void* pSource, uint16_t length)
+{
+    /* Word loads and stores need both sides aligned alike */
+    if (((uintptr_t)pDest | (uintptr_t)pSource) & 3) {
+        MEMCPY(pDest, pSource, length);
+        return LWIP_CHKSUM(pDest, length);
+    }
+
+    const uint32_t* pSrc = (const uint32_t*)pSource;
+    uint32_t* pDst = (uint32_t*)pDest;
+    uint64_t sum = 0;
+
+    while (length >= 16) {
+        uint32_t w0 = pSrc[0];
+        uint32_t w1 = pSrc[1];
+        uint32_t w2 = pSrc[2];
+        uint32_t w3 = pSrc[3];
+        pDst[0] = w0;
+        pDst[1] = w1;
+        pDst[2] = w2;
+        pDst[3] = w3;
+        sum += (uint64_t)w0 + w1 + w2 + w3;
+        pSrc += 4;
+        pDst += 4;
+        length -= 16;
+    }
+    while (length >= 4) {
+        uint32_t w = *pSrc++;
+        *pDst++ = w;
+        sum += w;
+        length -= 4;
+    }
+
+    const uint8_t* pSrcByte = (const uint8_t*)pSrc;
+    uint8_t* pDstByte = (uint8_t*)pDst;
+    if (length >= 2) {
+        pDstByte[0] = pSrcByte[0];
+        pDstByte[1] = pSrcByte[1];
+        sum += pSrcByte[0] | ((uint32_t)pSrcByte[1] << 8);
+        pSrcByte += 2;
+        pDstByte += 2;
+        length -= 2;
+    }
+    if (length) {
+        /* Trailing byte is at an even offset, so is the low byte */
+        *pDstByte = *pSrcByte;
+        sum += *pSrcByte;
+    }
+
+    /* Fold 64-bit sum into 16 bits */
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return (uint16_t)sum;
+}
+
+#endif
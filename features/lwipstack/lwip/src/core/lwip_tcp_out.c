@@ -1691,6 +1691,9 @@ tcp_rexmit_rto_commit(struct tcp_pcb *pcb)
   if (pcb->nrtx < 0xFF) {
     ++pcb->nrtx;
   }
+#if LWIP_TCP_RTX_COUNT
+  ++pcb->rtx_count;
+#endif /* LWIP_TCP_RTX_COUNT */
   /* Do the actual retransmission */
   tcp_output(pcb);
 }
@@ -1762,6 +1765,9 @@ tcp_rexmit(struct tcp_pcb *pcb)
   if (pcb->nrtx < 0xFF) {
     ++pcb->nrtx;
   }
+#if LWIP_TCP_RTX_COUNT
+  ++pcb->rtx_count;
+#endif /* LWIP_TCP_RTX_COUNT */
 
   /* Don't take any rtt measurements after retransmitting. */
   pcb->rttest = 0;
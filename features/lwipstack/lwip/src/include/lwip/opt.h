@@ -1972,6 +1972,23 @@
 #define LWIP_SOCKET_OFFSET              0
 #endif
 
+/**
+ * LWIP_TCP_RTX_COUNT==1: Keep a running total of retransmissions in each
+ * tcp_pcb (rtx_count), unlike nrtx which is reset when data is acknowledged.
+ */
+#if !defined LWIP_TCP_RTX_COUNT || defined __DOXYGEN__
+#define LWIP_TCP_RTX_COUNT              0
+#endif
+
+/**
+ * LWIP_TCP_CORK==1: Support the TF_CORK pcb flag, which holds back partial
+ * segments (even when TF_NODELAY is set) until it is cleared or the
+ * connection is closed.
+ */
+#if !defined LWIP_TCP_CORK || defined __DOXYGEN__
+#define LWIP_TCP_CORK                   0
+#endif
+
 /**
  * LWIP_TCP_KEEPALIVE==1: Enable TCP_KEEPIDLE, TCP_KEEPINTVL and TCP_KEEPCNT
  * options processing. Note that TCP_KEEPIDLE and TCP_KEEPINTVL have to be set
@@ -269,6 +269,9 @@ struct tcp_pcb {
 #define TF_RTO         0x0800U /* RTO timer has fired, in-flight data moved to unsent and being retransmitted */
 #if LWIP_TCP_SACK_OUT
 #define TF_SACK        0x1000U /* Selective ACKs enabled */
+#endif
+#if LWIP_TCP_CORK
+#define TF_CORK        0x2000U /* Hold back partial segments until uncorked */
 #endif
 
   /* the rest of the fields are in host byte order
@@ -303,6 +306,9 @@ struct tcp_pcb {
 
   s16_t rto;    /* retransmission time-out (in ticks of TCP_SLOW_INTERVAL) */
   u8_t nrtx;    /* number of retransmissions */
+#if LWIP_TCP_RTX_COUNT
+  u32_t rtx_count; /* total number of retransmissions over the connection */
+#endif /* LWIP_TCP_RTX_COUNT */
 
   /* fast retransmit/recovery */
   u8_t dupacks;
@@ -85,6 +85,13 @@
 
 #define MEMP_NUM_TCPIP_MSG_INPKT    MBED_CONF_LWIP_MEMP_NUM_TCPIP_MSG_INPKT
 
+#define LWIP_TCPIP_CORE_LOCKING     MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING_INPUT MBED_CONF_LWIP_TCPIP_CORE_LOCKING_INPUT
+
+#if LWIP_TCPIP_CORE_LOCKING_INPUT && !LWIP_TCPIP_CORE_LOCKING
+#error "lwip.tcpip-core-locking-input requires lwip.tcpip-core-locking"
+#endif
+
 // Thread stacks use 8-byte alignment
 #define LWIP_ALIGN_UP(pos, align) ((pos) % (align) ? (pos) +  ((align) - (pos) % (align)) : (pos))
 
@@ -118,8 +125,15 @@
 
 #define LWIP_RAM_HEAP_POINTER       lwip_ram_heap
 
+#define MBED_LWIP_MAX(a, b)         ((a) > (b) ? (a) : (b))
+
 // Number of simultaneously queued TCP segments.
+#if MBED_CONF_LWIP_TCP_WND_SCALE_ENABLED
+// At least enough to fill the send buffer
+#define MEMP_NUM_TCP_SEG            MBED_LWIP_MAX(MBED_CONF_LWIP_MEMP_NUM_TCP_SEG, TCP_SND_QUEUELEN)
+#else
 #define MEMP_NUM_TCP_SEG            MBED_CONF_LWIP_MEMP_NUM_TCP_SEG
+#endif
 
 // TCP Maximum segment size.
 #define TCP_MSS                     MBED_CONF_LWIP_TCP_MSS
@@ -127,16 +141,45 @@
 // TCP sender buffer space (bytes).
 #define TCP_SND_BUF                 MBED_CONF_LWIP_TCP_SND_BUF
 
-// TCP sender buffer space (bytes).
+// TCP receive window (bytes).
 #define TCP_WND                     MBED_CONF_LWIP_TCP_WND
 
+#if MBED_CONF_LWIP_TCP_WND_SCALE_ENABLED
+#define LWIP_WND_SCALE              1
+// Smallest shift that lets TCP_WND be advertised in 16 bits
+#if TCP_WND <= 0xFFFF
+#define TCP_RCV_SCALE               0
+#elif TCP_WND <= (0xFFFFL << 1)
+#define TCP_RCV_SCALE               1
+#elif TCP_WND <= (0xFFFFL << 2)
+#define TCP_RCV_SCALE               2
+#elif TCP_WND <= (0xFFFFL << 3)
+#define TCP_RCV_SCALE               3
+#elif TCP_WND <= (0xFFFFL << 4)
+#define TCP_RCV_SCALE               4
+#elif TCP_WND <= (0xFFFFL << 5)
+#define TCP_RCV_SCALE               5
+#elif TCP_WND <= (0xFFFFL << 6)
+#define TCP_RCV_SCALE               6
+#else
+#error "lwip.tcp-wnd is too large"
+#endif
+#endif
+
+#define LWIP_TCP_SACK_OUT           MBED_CONF_LWIP_TCP_SACK_ENABLED
+
 #define TCP_MAXRTX                  MBED_CONF_LWIP_TCP_MAXRTX
 
 #define TCP_SYNMAXRTX               MBED_CONF_LWIP_TCP_SYNMAXRTX
 
 // Number of pool pbufs.
 // Each requires 684 bytes of RAM (if MSS=536 and PBUF_POOL_BUFSIZE defaulting to be based on MSS)
+#if MBED_CONF_LWIP_TCP_WND_SCALE_ENABLED
+// At least enough to receive a full window of maximum-sized segments
+#define PBUF_POOL_SIZE              MBED_LWIP_MAX(MBED_CONF_LWIP_PBUF_POOL_SIZE, (TCP_WND + TCP_MSS - 1) / TCP_MSS)
+#else
 #define PBUF_POOL_SIZE              MBED_CONF_LWIP_PBUF_POOL_SIZE
+#endif
 
 #ifdef MBED_CONF_LWIP_PBUF_POOL_BUFSIZE
 #undef PBUF_POOL_BUFSIZE
@@ -151,7 +194,12 @@
 #endif
 #endif
 
+#if MBED_CONF_LWIP_TCP_WND_SCALE_ENABLED
+// At least enough to hold a full send buffer, plus room for headers
+#define MEM_SIZE                    MBED_LWIP_MAX(MBED_CONF_LWIP_MEM_SIZE, TCP_SND_BUF + 2 * TCP_MSS)
+#else
 #define MEM_SIZE                    MBED_CONF_LWIP_MEM_SIZE
+#endif
 
 // One tcp_pcb_listen is needed for each TCP server.
 // Each requires 72 bytes of RAM.
@@ -180,6 +228,10 @@
 #define LWIP_TCP                    1
 #define TCP_OVERSIZE                0
 #define LWIP_TCP_KEEPALIVE          1
+// Count retransmissions per PCB for socket statistics
+#define LWIP_TCP_RTX_COUNT          MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
+// Support NSAPI_TCP_CORK
+#define LWIP_TCP_CORK               1
 
 #define TCP_CLOSE_TIMEOUT            MBED_CONF_LWIP_TCP_CLOSE_TIMEOUT
 
@@ -254,8 +306,32 @@
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
 #else
 #define LWIP_NOASSERT               1
+#if MBED_CONF_LWIP_MEMORY_STATS_ENABLED
+// Only memory statistics are collected
+#define LWIP_STATS                  1
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define SYS_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
+#else
 #define LWIP_STATS                  0
 #endif
+#endif
+
+#if MBED_CONF_LWIP_PBUF_POOL_OVERFLOW_MAX
+// Pool overflow buffers are custom pbufs
+#define LWIP_SUPPORT_CUSTOM_PBUF    1
+#endif
 
 #define TRACE_TO_ASCII_HEX_DUMP     0
 
@@ -321,6 +397,9 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Let EMACs with checksum offload disable software checksums on their interface
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
@@ -0,0 +1,307 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2020 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Generate platform/src/mbed_ecp_comb_tables.c, the fixed-base comb tables of
+the generator points of the short Weierstrass curves.
+
+A host program is built from the imported Mbed Crypto sources, it multiplies
+the generator point of each curve to let mbedtls_ecp_mul() precompute its
+comb table, then dumps the table. Run it again after importing a new Mbed
+Crypto release (make ecp-comb-tables).
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+CURVES = [
+    "SECP192R1", "SECP224R1", "SECP256R1", "SECP384R1", "SECP521R1",
+    "SECP192K1", "SECP224K1", "SECP256K1",
+    "BP256R1", "BP384R1", "BP512R1",
+]
+
+CRYPTO_SOURCES = ["ecp.c", "ecp_curves.c", "bignum.c", "platform_util.c"]
+
+HOST_CONFIG = """
+#include <limits.h>
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECP_NIST_OPTIM
+#define MBEDTLS_ECP_NO_INTERNAL_RNG
+%s
+"""
+
+HOST_PROGRAM = """
+#include <stdio.h>
+#include "mbedtls/ecp.h"
+
+static void dump_mpi(const mbedtls_mpi *X, size_t len)
+{
+    unsigned char buf[MBEDTLS_ECP_MAX_BYTES];
+    size_t i;
+
+    mbedtls_mpi_write_binary(X, buf, len);
+    for (i = 0; i < len; i++) {
+        printf("%02X", buf[i]);
+    }
+}
+
+static int dump_table(mbedtls_ecp_group_id id, const char *name)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point R;
+    mbedtls_mpi m;
+    size_t i, len;
+    int ret;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&R);
+    mbedtls_mpi_init(&m);
+
+    ret = mbedtls_ecp_group_load(&grp, id);
+    if (ret == 0) {
+        ret = mbedtls_mpi_lset(&m, 1);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ecp_mul(&grp, &R, &m, &grp.G, NULL, NULL);
+    }
+    if (ret == 0 && grp.T == NULL) {
+        ret = -1;
+    }
+
+    if (ret == 0) {
+        len = mbedtls_mpi_size(&grp.P);
+        printf("%s %u %u\\n", name, (unsigned) grp.T_size, (unsigned) len);
+        for (i = 0; i < grp.T_size; i++) {
+            /* normalized points have Z = 1, or Z freed */
+            if (grp.T[i].Z.n != 0 && mbedtls_mpi_cmp_int(&grp.T[i].Z, 1) != 0) {
+                ret = -1;
+                break;
+            }
+            dump_mpi(&grp.T[i].X, len);
+            printf(" ");
+            dump_mpi(&grp.T[i].Y, len);
+            printf("\\n");
+        }
+    }
+
+    mbedtls_mpi_free(&m);
+    mbedtls_ecp_point_free(&R);
+    mbedtls_ecp_group_free(&grp);
+    return ret;
+}
+
+int main(void)
+{
+@DUMP_TABLES@
+    return 0;
+}
+"""
+
+HEADER = """/*
+ *  mbed_ecp_comb_tables.c
+ *
+ *  Copyright (C) 2020, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+/*
+ * Generated by features/mbedtls/importer/ecp_comb_tables.py, do not edit.
+ *
+ * Fixed-base comb tables of the generator points, in affine coordinates, as
+ * computed by ecp_precompute_comb() for the window size picked by
+ * ecp_pick_window_size() when the point multiplied is the generator.
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/ecp.h"
+#include "mbed_ecp_comb_tables.h"
+
+#if defined(MBED_ECP_COMB_TABLES)
+
+/*
+ * Conversion macros for embedded constants, as in ecp_curves.c:
+ * build lists of mbedtls_mpi_uint's from lists of unsigned char's grouped by 8
+ */
+#if defined(MBEDTLS_HAVE_INT32)
+
+#define BYTES_TO_T_UINT_4( a, b, c, d )                       \\
+    ( (mbedtls_mpi_uint) (a) <<  0 ) |                        \\
+    ( (mbedtls_mpi_uint) (b) <<  8 ) |                        \\
+    ( (mbedtls_mpi_uint) (c) << 16 ) |                        \\
+    ( (mbedtls_mpi_uint) (d) << 24 )
+
+#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h ) \\
+    BYTES_TO_T_UINT_4( a, b, c, d ),                \\
+    BYTES_TO_T_UINT_4( e, f, g, h )
+
+#else /* 64-bits */
+
+#define BYTES_TO_T_UINT_8( a, b, c, d, e, f, g, h ) \\
+    ( (mbedtls_mpi_uint) (a) <<  0 ) |                        \\
+    ( (mbedtls_mpi_uint) (b) <<  8 ) |                        \\
+    ( (mbedtls_mpi_uint) (c) << 16 ) |                        \\
+    ( (mbedtls_mpi_uint) (d) << 24 ) |                        \\
+    ( (mbedtls_mpi_uint) (e) << 32 ) |                        \\
+    ( (mbedtls_mpi_uint) (f) << 40 ) |                        \\
+    ( (mbedtls_mpi_uint) (g) << 48 ) |                        \\
+    ( (mbedtls_mpi_uint) (h) << 56 )
+
+#endif /* bits in mbedtls_mpi_uint */
+
+/* The table is never written, the MPIs only need non-const pointers */
+#define ECP_MPI_INIT( p ) \\
+    { 1, sizeof( p ) / sizeof( mbedtls_mpi_uint ), (mbedtls_mpi_uint *) ( p ) }
+
+#define ECP_POINT_INIT_XY_Z1( x, y ) \\
+    { ECP_MPI_INIT( x ), ECP_MPI_INIT( y ), ECP_MPI_INIT( ecp_comb_one ) }
+
+static const mbedtls_mpi_uint ecp_comb_one[] = { 1 };
+"""
+
+FOOTER = """
+const mbedtls_ecp_point *mbed_ecp_comb_table( mbedtls_ecp_group_id id )
+{
+    switch( id )
+    {
+%s
+        default:
+            return( NULL );
+    }
+}
+
+#endif /* MBED_ECP_COMB_TABLES */
+"""
+
+
+def limbs(hex_be):
+    """Little-endian BYTES_TO_T_UINT_8 lines of a big-endian hex number"""
+    data = bytearray.fromhex(hex_be)[::-1]
+    data += bytearray((-len(data)) % 8)
+    lines = []
+    for i in range(0, len(data), 8):
+        lines.append("    BYTES_TO_T_UINT_8( %s )," % ", ".join(
+            "0x%02X" % b for b in data[i:i + 8]))
+    return "\n".join(lines)
+
+
+def run_host(crypto_dir, tls_inc, platform_inc, cc):
+    build_dir = tempfile.mkdtemp()
+    try:
+        with open(os.path.join(build_dir, "host_config.h"), "w") as f:
+            f.write(HOST_CONFIG % "\n".join(
+                "#define MBEDTLS_ECP_DP_%s_ENABLED" % c for c in CURVES))
+        with open(os.path.join(build_dir, "host.c"), "w") as f:
+            f.write(HOST_PROGRAM.replace("@DUMP_TABLES@", "\n".join(
+                '    if (dump_table(MBEDTLS_ECP_DP_%s, "%s") != 0) {\n'
+                '        return 1;\n'
+                '    }' % (c, c) for c in CURVES)))
+
+        exe = os.path.join(build_dir, "host")
+        cmd = [cc, "-O1",
+               "-I" + build_dir,
+               "-I" + os.path.join(crypto_dir, "inc"),
+               "-I" + tls_inc,
+               "-I" + platform_inc,
+               '-DMBEDTLS_CONFIG_FILE="host_config.h"',
+               "-o", exe, os.path.join(build_dir, "host.c")]
+        cmd += [os.path.join(crypto_dir, "src", s) for s in CRYPTO_SOURCES]
+        subprocess.check_call(cmd)
+        return subprocess.check_output([exe]).decode()
+    finally:
+        shutil.rmtree(build_dir)
+
+
+def generate(output):
+    lines = iter(output.splitlines())
+    tables = []
+    cases = []
+    for header in lines:
+        name, size, _ = header.split()
+        points = [next(lines).split() for _ in range(int(size))]
+
+        table = ["#if defined(MBEDTLS_ECP_DP_%s_ENABLED)" % name]
+        for i, (x, y) in enumerate(points):
+            for coord, value in (("x", x), ("y", y)):
+                table.append("static const mbedtls_mpi_uint %s_T_%d_%s[] = {"
+                             % (name.lower(), i, coord))
+                table.append(limbs(value))
+                table.append("};")
+        table.append("static const mbedtls_ecp_point %s_T[%d] = {"
+                     % (name.lower(), len(points)))
+        for i in range(len(points)):
+            table.append("    ECP_POINT_INIT_XY_Z1( %s_T_%d_x, %s_T_%d_y ),"
+                         % (name.lower(), i, name.lower(), i))
+        table.append("};")
+        table.append("#endif /* MBEDTLS_ECP_DP_%s_ENABLED */" % name)
+        tables.append("\n".join(table))
+
+        cases.append("#if defined(MBEDTLS_ECP_DP_%s_ENABLED)\n"
+                     "        case MBEDTLS_ECP_DP_%s:\n"
+                     "            return( %s_T );\n"
+                     "#endif" % (name, name, name.lower()))
+
+    return HEADER + "\n" + "\n\n".join(tables) + "\n" + \
+        FOOTER % "\n".join(cases)
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    parser = argparse.ArgumentParser(
+        description="Generate the fixed-base comb tables of Mbed TLS")
+    parser.add_argument("--cc", default=os.environ.get("CC", "cc"),
+                        help="host C compiler")
+    parser.add_argument("-o", "--output",
+                        default=os.path.join(root, "platform", "src",
+                                             "mbed_ecp_comb_tables.c"),
+                        help="generated C file")
+    args = parser.parse_args()
+
+    output = run_host(os.path.join(root, "mbed-crypto"),
+                      os.path.join(root, "inc"),
+                      os.path.join(root, "platform", "inc"), args.cc)
+    with open(args.output, "w") as f:
+        f.write(generate(output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
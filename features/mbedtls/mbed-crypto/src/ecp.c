@@ -82,6 +82,7 @@
 #include "mbedtls/threading.h"
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
+#include "mbed_ecp_comb_tables.h"
 
 #include <string.h>
 
@@ -588,6 +589,20 @@ void mbedtls_ecp_point_free( mbedtls_ecp_point *pt )
     mbedtls_mpi_free( &( pt->Z ) );
 }
 
+/*
+ * Is the comb table of the generator the static one from
+ * mbed_ecp_comb_table(), rather than one computed and owned by the group?
+ */
+static int ecp_group_is_static_comb_table( const mbedtls_ecp_group *grp )
+{
+#if defined(MBED_ECP_COMB_TABLES)
+    return( grp->T != NULL && grp->T_size == 0 );
+#else
+    (void) grp;
+    return( 0 );
+#endif
+}
+
 /*
  * Unallocate (the components of) a group
  */
@@ -607,7 +622,7 @@ void mbedtls_ecp_group_free( mbedtls_ecp_group *grp )
         mbedtls_mpi_free( &grp->N );
     }
 
-    if( grp->T != NULL )
+    if( grp->T != NULL && !ecp_group_is_static_comb_table( grp ) )
     {
         for( i = 0; i < grp->T_size; i++ )
             mbedtls_ecp_point_free( &grp->T[i] );
@@ -2056,7 +2071,9 @@ static unsigned char ecp_pick_window_size( const mbedtls_ecp_group *grp,
      * (The last test is useful only for very small curves in the test suite.)
      */
 #if( MBEDTLS_ECP_WINDOW_SIZE < 6 )
-    if( w > MBEDTLS_ECP_WINDOW_SIZE )
+    /* The static table costs no RAM and was computed for the default size */
+    if( ( ! p_eq_g || ! ecp_group_is_static_comb_table( grp ) ) &&
+        w > MBEDTLS_ECP_WINDOW_SIZE )
         w = MBEDTLS_ECP_WINDOW_SIZE;
 #endif
     if( w >= grp->nbits )
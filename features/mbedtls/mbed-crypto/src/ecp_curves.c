@@ -30,6 +30,7 @@
 #include "mbedtls/ecp.h"
 #include "mbedtls/platform_util.h"
 #include "mbedtls/error.h"
+#include "mbed_ecp_comb_tables.h"
 
 #include <string.h>
 
@@ -605,6 +606,12 @@ static int ecp_group_load( mbedtls_ecp_group *grp,
 
     grp->h = 1;
 
+#if defined(MBED_ECP_COMB_TABLES)
+    /* The comb table of the generator is in flash, T_size 0 marks it static */
+    grp->T = (mbedtls_ecp_point *) mbed_ecp_comb_table( grp->id );
+    grp->T_size = 0;
+#endif
+
     return( 0 );
 }
 
@@ -0,0 +1,63 @@
+/*
+ *  mbed_ecp_comb_tables.h
+ *
+ *  Copyright (C) 2020, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef MBED_ECP_COMB_TABLES_H
+#define MBED_ECP_COMB_TABLES_H
+
+#include "mbedtls/ecp.h"
+
+/*
+ * The comb tables are only valid for the software implementation of ECP and
+ * are only used when multiplications of the generator are sped up.
+ */
+#if MBED_CONF_MBEDTLS_ECP_COMB_TABLES && MBEDTLS_ECP_FIXED_POINT_OPTIM == 1 && \
+    !defined(MBEDTLS_ECP_ALT)
+#define MBED_ECP_COMB_TABLES
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MBED_ECP_COMB_TABLES)
+
+/**
+ * \brief       Get the fixed-base comb table of the generator of a curve
+ *
+ * \note        The table is in flash and is used as grp->T by the groups
+ *              loaded with mbedtls_ecp_group_load(), with grp->T_size set to
+ *              0 so that it is never computed, modified or freed. It holds
+ *              the points ecp_precompute_comb() would compute for the window
+ *              size picked for the generator with the default
+ *              MBEDTLS_ECP_WINDOW_SIZE, whatever the configured one.
+ *
+ * \param id    Group identifier
+ *
+ * \return      Table of the generator, NULL if the curve has none
+ */
+const mbedtls_ecp_point *mbed_ecp_comb_table( mbedtls_ecp_group_id id );
+
+#endif /* MBED_ECP_COMB_TABLES */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBED_ECP_COMB_TABLES_H */
@@ -0,0 +1,62 @@
+/*
+ *  mbed_shared_drbg.h
+ *
+ *  Copyright (C) 2020, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef MBED_SHARED_DRBG_H
+#define MBED_SHARED_DRBG_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief       Generate random bytes from the system-wide DRBG
+ *
+ * \note        The DRBG is seeded from the Mbed TLS entropy sources on first
+ *              use and reseeded every mbedtls.shared-drbg-reseed-interval
+ *              requests. It is a CTR_DRBG if MBEDTLS_CTR_DRBG_C is enabled,
+ *              an HMAC_DRBG otherwise.
+ * \note        Thread safe, it can be passed to mbedtls_ssl_conf_rng() and
+ *              any other Mbed TLS API taking an f_rng callback.
+ *
+ * \param ctx   Unused
+ * \param dst   Buffer to fill
+ * \param len   Length of the buffer
+ *
+ * \return      0 if successful, or an Mbed TLS DRBG error code
+ */
+int mbed_shared_drbg_random( void *ctx, unsigned char *dst, size_t len );
+
+/**
+ * \brief       Reseed the system-wide DRBG immediately
+ *
+ * \param additional    Additional data mixed in the new seed, may be NULL
+ * \param len           Length of the additional data
+ *
+ * \return      0 if successful, or an Mbed TLS DRBG error code
+ */
+int mbed_shared_drbg_reseed( const unsigned char *additional, size_t len );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_SHARED_DRBG_H
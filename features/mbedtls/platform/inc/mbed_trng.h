@@ -0,0 +1,73 @@
+/*
+ *  mbed_trng.h
+ *
+ *  Copyright (C) 2020, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef MBED_TRNG_H
+#define MBED_TRNG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief       Health test run on each block read from the TRNG
+ *
+ * \param data  Bytes read from the TRNG
+ * \param len   Number of bytes
+ *
+ * \return      0 if the bytes can be used, any other value to discard them
+ */
+typedef int (*mbed_trng_health_test_t)( const unsigned char *data, size_t len );
+
+/**
+ * \brief       Statistics of the TRNG entropy source
+ */
+typedef struct {
+    uint32_t requested_bytes;       /**< Bytes requested through mbedtls_hardware_poll() */
+    uint32_t pool_bytes;            /**< Bytes served from the entropy pool */
+    uint32_t trng_bytes;            /**< Bytes read from the TRNG and accepted by the health test */
+    uint32_t refills;               /**< Background refills of the entropy pool */
+    uint32_t health_test_failures;  /**< Blocks discarded by the health test */
+} mbed_trng_stats_t;
+
+/**
+ * \brief       Set the health test run on the TRNG output
+ *
+ * \note        Bytes rejected by the test are neither pooled nor returned,
+ *              mbedtls_hardware_poll() fails if it can't serve a request.
+ *
+ * \param test  Health test, NULL to accept all bytes
+ */
+void mbed_trng_set_health_test( mbed_trng_health_test_t test );
+
+/**
+ * \brief       Get the statistics of the TRNG entropy source
+ *
+ * \param stats Filled with the statistics since boot
+ */
+void mbed_trng_get_stats( mbed_trng_stats_t *stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_TRNG_H
@@ -0,0 +1,133 @@
+/*
+ *  mbed_shared_drbg.cpp
+ *
+ *  Copyright (C) 2020, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if MBED_CONF_MBEDTLS_SHARED_DRBG && defined(MBEDTLS_ENTROPY_C) && \
+    (defined(MBEDTLS_CTR_DRBG_C) || defined(MBEDTLS_HMAC_DRBG_C))
+
+#include "mbed_shared_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/hmac_drbg.h"
+#include "platform/SingletonPtr.h"
+#include "platform/PlatformMutex.h"
+#include "mbed_trace.h"
+
+#define TRACE_GROUP "SDRB"
+
+#if defined(MBEDTLS_CTR_DRBG_C)
+typedef mbedtls_ctr_drbg_context drbg_context_t;
+#else
+typedef mbedtls_hmac_drbg_context drbg_context_t;
+#endif
+
+static const char drbg_pers[] = "mbed shared DRBG";
+
+static SingletonPtr<PlatformMutex> drbg_mutex;
+static mbedtls_entropy_context drbg_entropy;
+static drbg_context_t drbg;
+static bool drbg_seeded;
+
+/* Called with drbg_mutex held */
+static int drbg_seed()
+{
+    int ret;
+
+    mbedtls_entropy_init(&drbg_entropy);
+#if defined(MBEDTLS_CTR_DRBG_C)
+    mbedtls_ctr_drbg_init(&drbg);
+    ret = mbedtls_ctr_drbg_seed(&drbg, mbedtls_entropy_func, &drbg_entropy,
+                                (const unsigned char *) drbg_pers, sizeof(drbg_pers));
+    if (ret == 0) {
+        mbedtls_ctr_drbg_set_reseed_interval(&drbg, MBED_CONF_MBEDTLS_SHARED_DRBG_RESEED_INTERVAL);
+    }
+#else
+    mbedtls_hmac_drbg_init(&drbg);
+    ret = mbedtls_hmac_drbg_seed(&drbg, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                                 mbedtls_entropy_func, &drbg_entropy,
+                                 (const unsigned char *) drbg_pers, sizeof(drbg_pers));
+    if (ret == 0) {
+        mbedtls_hmac_drbg_set_reseed_interval(&drbg, MBED_CONF_MBEDTLS_SHARED_DRBG_RESEED_INTERVAL);
+    }
+#endif
+
+    if (ret != 0) {
+        tr_error("shared DRBG seeding failed: -0x%x", -ret);
+#if defined(MBEDTLS_CTR_DRBG_C)
+        mbedtls_ctr_drbg_free(&drbg);
+#else
+        mbedtls_hmac_drbg_free(&drbg);
+#endif
+        mbedtls_entropy_free(&drbg_entropy);
+        return ret;
+    }
+
+    drbg_seeded = true;
+    return 0;
+}
+
+extern "C"
+int mbed_shared_drbg_random( void *ctx, unsigned char *dst, size_t len )
+{
+    (void) ctx;
+    int ret = 0;
+
+    drbg_mutex->lock();
+    if (!drbg_seeded) {
+        ret = drbg_seed();
+    }
+    if (ret == 0) {
+#if defined(MBEDTLS_CTR_DRBG_C)
+        ret = mbedtls_ctr_drbg_random(&drbg, dst, len);
+#else
+        ret = mbedtls_hmac_drbg_random(&drbg, dst, len);
+#endif
+    }
+    drbg_mutex->unlock();
+
+    return ret;
+}
+
+extern "C"
+int mbed_shared_drbg_reseed( const unsigned char *additional, size_t len )
+{
+    int ret;
+
+    drbg_mutex->lock();
+    if (!drbg_seeded) {
+        ret = drbg_seed();
+    } else {
+#if defined(MBEDTLS_CTR_DRBG_C)
+        ret = mbedtls_ctr_drbg_reseed(&drbg, additional, len);
+#else
+        ret = mbedtls_hmac_drbg_reseed(&drbg, additional, len);
+#endif
+    }
+    drbg_mutex->unlock();
+
+    return ret;
+}
+
+#endif // MBED_CONF_MBEDTLS_SHARED_DRBG
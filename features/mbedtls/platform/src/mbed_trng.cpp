@@ -16,21 +16,115 @@
 
 #if DEVICE_TRNG
 
+#include <string.h>
 #include "hal/trng_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "mbedtls/platform_util.h"
+#include "mbed_trng.h"
+
+#if defined(MBED_CONF_MBEDTLS_TRNG_POOL_SIZE) && (MBED_CONF_MBEDTLS_TRNG_POOL_SIZE > 0) && MBED_CONF_EVENTS_PRESENT
+#define MBED_TRNG_POOL 1
+#include "events/mbed_shared_queues.h"
+#else
+#define MBED_TRNG_POOL 0
+#endif
 
 SingletonPtr<PlatformMutex> mbedtls_mutex;
 
-extern "C"
-int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
+static mbed_trng_health_test_t health_test;
+static mbed_trng_stats_t trng_stats;
+
+#if MBED_TRNG_POOL
+/* Bytes are taken from the end of the pool, refills append after them */
+static unsigned char pool[MBED_CONF_MBEDTLS_TRNG_POOL_SIZE];
+static size_t pool_count;
+static bool refill_pending;
+#endif
+
+/* Called with mbedtls_mutex held */
+static int trng_read( unsigned char *output, size_t len, size_t *olen )
+{
     trng_t trng_obj;
-    mbedtls_mutex->lock();
     trng_init(&trng_obj);
     int ret = trng_get_bytes(&trng_obj, output, len, olen);
     trng_free(&trng_obj);
+
+    if (ret == 0 && health_test && health_test(output, *olen) != 0) {
+        mbedtls_platform_zeroize(output, *olen);
+        *olen = 0;
+        trng_stats.health_test_failures++;
+        return -1;
+    }
+
+    if (ret == 0) {
+        trng_stats.trng_bytes += *olen;
+    }
+    return ret;
+}
+
+#if MBED_TRNG_POOL
+static void pool_refill()
+{
+    mbedtls_mutex->lock();
+    size_t olen = 0;
+    if (trng_read(pool + pool_count, sizeof(pool) - pool_count, &olen) == 0) {
+        pool_count += olen;
+    }
+    trng_stats.refills++;
+    refill_pending = false;
+    mbedtls_mutex->unlock();
+}
+#endif
+
+extern "C"
+int mbedtls_hardware_poll( void *data, unsigned char *output, size_t len, size_t *olen ) {
+    int ret = 0;
+    mbedtls_mutex->lock();
+    trng_stats.requested_bytes += len;
+
+#if MBED_TRNG_POOL
+    size_t served = (len < pool_count) ? len : pool_count;
+    pool_count -= served;
+    memcpy(output, pool + pool_count, served);
+    mbedtls_platform_zeroize(pool + pool_count, served);
+    trng_stats.pool_bytes += served;
+
+    /* The TRNG is only read synchronously when the pool runs dry */
+    *olen = served;
+    if (served < len) {
+        size_t direct = 0;
+        ret = trng_read(output + served, len - served, &direct);
+        *olen += direct;
+        /* a partial request is still useful to the entropy collector */
+        if (served > 0) {
+            ret = 0;
+        }
+    }
+
+    if (pool_count < MBED_CONF_MBEDTLS_TRNG_POOL_REFILL_THRESHOLD && !refill_pending) {
+        refill_pending = (mbed_event_queue()->call(pool_refill) != 0);
+    }
+#else
+    ret = trng_read(output, len, olen);
+#endif
+
     mbedtls_mutex->unlock();
     return ret;
 }
 
+extern "C"
+void mbed_trng_set_health_test( mbed_trng_health_test_t test ) {
+    mbedtls_mutex->lock();
+    health_test = test;
+    mbedtls_mutex->unlock();
+}
+
+extern "C"
+void mbed_trng_get_stats( mbed_trng_stats_t *stats ) {
+    mbedtls_mutex->lock();
+    *stats = trng_stats;
+    mbedtls_mutex->unlock();
+}
+
 #endif
@@ -416,6 +416,52 @@ int mbedtls_ssl_session_reset(mbedtls_ssl_context *ssl)
     return mbedtls_stub.expected_int;
 }
 
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session)
+{
+
+}
+
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session)
+{
+
+}
+
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session)
+{
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session)
+{
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_session_save(const mbedtls_ssl_session *session, unsigned char *buf, size_t buf_len, size_t *olen)
+{
+    *olen = 0;
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_session_load(mbedtls_ssl_session *session, const unsigned char *buf, size_t len)
+{
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_conf_max_frag_len(mbedtls_ssl_config *conf, unsigned char mfl_code)
+{
+    return mbedtls_stub.expected_int;
+}
+
+size_t mbedtls_ssl_get_max_frag_len(const mbedtls_ssl_context *ssl)
+{
+    return 16384;
+}
+
+void mbedtls_platform_zeroize(void *buf, size_t len)
+{
+    memset(buf, 0, len);
+}
+
 void mbedtls_strerror(int ret, char *buf, size_t buflen)
 {
 }
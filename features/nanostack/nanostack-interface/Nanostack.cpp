@@ -586,6 +586,40 @@ nsapi_error_t Nanostack::socket_close(void *handle)
 
 }
 
+static nsapi_size_or_error_t map_socket_send_error(int retcode)
+{
+    /*
+     * \return length if entire amount written (which could be 0)
+     * \return value >0 and <length if partial amount written (stream only)
+     * \return NS_EWOULDBLOCK if nothing written due to lack of queue space.
+     * \return -1 Invalid socket ID or message structure.
+     * \return -2 Socket memory allocation fail.
+     * \return -3 TCP state not established or address scope not defined .
+     * \return -4 Socket TX process busy or unknown interface.
+     * \return -5 Socket not connected
+     * \return -6 Packet too short (ICMP raw socket error).
+     * */
+    switch (retcode) {
+        case -1:
+            return NSAPI_ERROR_PARAMETER;
+        case -2:
+            return NSAPI_ERROR_NO_MEMORY;
+        case -3:
+            return NSAPI_ERROR_NO_ADDRESS;
+        case -4:
+            return NSAPI_ERROR_BUSY;
+        case -5:
+            return NSAPI_ERROR_NO_CONNECTION;
+        case -6:
+            return NSAPI_ERROR_PARAMETER;
+        case NS_EWOULDBLOCK:
+            return NSAPI_ERROR_WOULD_BLOCK;
+        default:
+            tr_error("socket_sendmsg: error=%d", retcode);
+            return NSAPI_ERROR_DEVICE_ERROR;
+    }
+}
+
 nsapi_size_or_error_t Nanostack::do_sendto(void *handle, const ns_address_t *address, const void *data, nsapi_size_t size)
 {
     // Validate parameters
@@ -633,46 +667,11 @@ nsapi_size_or_error_t Nanostack::do_sendto(void *handle, const ns_address_t *add
     retcode = ::socket_sendmsg(socket->socket_id, &msg, 0);
 #endif
 
-    /*
-     * \return length if entire amount written (which could be 0)
-     * \return value >0 and <length if partial amount written (stream only)
-     * \return NS_EWOULDBLOCK if nothing written due to lack of queue space.
-     * \return -1 Invalid socket ID or message structure.
-     * \return -2 Socket memory allocation fail.
-     * \return -3 TCP state not established or address scope not defined .
-     * \return -4 Socket TX process busy or unknown interface.
-     * \return -5 Socket not connected
-     * \return -6 Packet too short (ICMP raw socket error).
-     * */
     if (retcode >= 0) {
         ret = retcode;
-    } else switch (retcode) {
-            case -1:
-                ret = NSAPI_ERROR_PARAMETER;
-                break;
-            case -2:
-                ret = NSAPI_ERROR_NO_MEMORY;
-                break;
-            case -3:
-                ret = NSAPI_ERROR_NO_ADDRESS;
-                break;
-            case -4:
-                ret = NSAPI_ERROR_BUSY;
-                break;
-            case -5:
-                ret = NSAPI_ERROR_NO_CONNECTION;
-                break;
-            case -6:
-                ret = NSAPI_ERROR_PARAMETER;
-                break;
-            case NS_EWOULDBLOCK:
-                ret = NSAPI_ERROR_WOULD_BLOCK;
-                break;
-            default:
-                tr_error("socket_sendmsg: error=%d", retcode);
-                ret = NSAPI_ERROR_DEVICE_ERROR;
-                break;
-        }
+    } else {
+        ret = map_socket_send_error(retcode);
+    }
 
 out:
     tr_debug("socket_sendto(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
@@ -737,6 +736,70 @@ out:
     return ret;
 }
 
+nsapi_size_or_error_t Nanostack::socket_sendto_batch(void *handle, nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    // The lock is recursive, so each send just nests inside this one
+    NanostackLockGuard lock;
+    return NetworkStack::socket_sendto_batch(handle, datagrams, count);
+}
+
+nsapi_size_or_error_t Nanostack::socket_recvfrom_batch(void *handle, nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    NanostackLockGuard lock;
+    return NetworkStack::socket_recvfrom_batch(handle, datagrams, count);
+}
+
+NetStackMemoryManager *Nanostack::get_memory_manager()
+{
+    return &socket_memory_manager;
+}
+
+nsapi_size_or_error_t Nanostack::socket_sendto_buf(void *handle, const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    // Validate parameters
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    if (socket_memory_manager.get_next(buf) || socket->proto == SOCKET_TCP) {
+        // Joined up and sent the ordinary way
+        return NetworkStack::socket_sendto_buf(handle, address, buf);
+    }
+
+    if (address.get_ip_version() != NSAPI_IPv6) {
+        socket_memory_manager.free(buf);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    ns_address_t ns_address;
+    convert_mbed_addr_to_ns(&ns_address, &address);
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        socket_memory_manager.free(buf);
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    ns_msghdr_t msg;
+    msg.msg_name = &ns_address;
+    msg.msg_namelen = sizeof ns_address;
+    msg.msg_iov = NULL;
+    msg.msg_iovlen = 0;
+    msg.msg_control = NULL;
+    msg.msg_controllen = 0;
+
+    // The stack takes the buffer whatever the outcome
+    int retcode = ::socket_sendmsg_buffer(socket->socket_id, socket_memory_manager.release(buf), &msg, 0);
+    nsapi_size_or_error_t ret = retcode >= 0 ? retcode : map_socket_send_error(retcode);
+
+    tr_debug("socket_sendto_buf(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
 nsapi_error_t Nanostack::socket_bind(void *handle, const SocketAddress &address)
 {
     // Validate parameters
@@ -789,9 +852,24 @@ nsapi_error_t Nanostack::setsockopt(void *handle, int level, int optname, const
     NanostackLockGuard lock;
 
     ns_ipv6_mreq_t ns_mreq;
+    int32_t ns_buf_size;
 
     if (level == NSAPI_SOCKET) {
         switch (optname) {
+            case NSAPI_SNDBUF:
+            case NSAPI_RCVBUF: {
+                if (optlen != sizeof(int)) {
+                    return NSAPI_ERROR_PARAMETER;
+                }
+
+                /* Nanostack takes the size as int32_t at the socket level */
+                ns_buf_size = *static_cast<const int *>(optval);
+                level = SOCKET_SOL_SOCKET;
+                optname = optname == NSAPI_SNDBUF ? SOCKET_SO_SNDBUF : SOCKET_SO_RCVBUF;
+                optval = &ns_buf_size;
+                optlen = sizeof ns_buf_size;
+                break;
+            }
             case NSAPI_ADD_MEMBERSHIP:
             case NSAPI_DROP_MEMBERSHIP: {
                 if (optlen != sizeof(nsapi_ip_mreq_t)) {
@@ -851,6 +929,7 @@ nsapi_error_t Nanostack::getsockopt(void *handle, int level, int optname, void *
     // Nanostack internal structures
     ns_ipv6_latency_t nanostack_latency;
     ns_ipv6_stagger_t nanostack_stagger;
+    int32_t nanostack_buf_size;
     int nanostack_optname = optname;
 
     void *ns_option_value = optval;
@@ -875,6 +954,14 @@ nsapi_error_t Nanostack::getsockopt(void *handle, int level, int optname, void *
             memcpy(nanostack_stagger.dest_addr, ns_stagger_r->addr, 16);
             nanostack_stagger.data_amount = ns_stagger_r->data_amount;
             ns_option_value = &nanostack_stagger;
+        } else if (optname == NSAPI_SNDBUF || optname == NSAPI_RCVBUF) {
+            if (*optlen < sizeof(int)) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+            // Adjust to Nanostack namespace
+            level = SOCKET_SOL_SOCKET;
+            nanostack_optname = optname == NSAPI_SNDBUF ? SOCKET_SO_SNDBUF : SOCKET_SO_RCVBUF;
+            ns_option_value = &nanostack_buf_size;
         }
     }
 
@@ -889,6 +976,9 @@ nsapi_error_t Nanostack::getsockopt(void *handle, int level, int optname, void *
             ns_stagger_r->stagger_min = nanostack_stagger.stagger_min;
             ns_stagger_r->stagger_max = nanostack_stagger.stagger_max;
             ns_stagger_r->stagger_rand = nanostack_stagger.stagger_rand;
+        } else if (optname == NSAPI_SNDBUF || optname == NSAPI_RCVBUF) {
+            *static_cast<int *>(optval) = nanostack_buf_size;
+            *optlen = sizeof(int);
         }
         return NSAPI_ERROR_OK;
     } else if (retcode == -2) {
@@ -20,6 +20,7 @@
 
 #include "OnboardNetworkStack.h"
 #include "NanostackMemoryManager.h"
+#include "NanostackSocketMemoryManager.h"
 #include "MeshInterface.h"
 #include "mesh_interface_types.h"
 #include "eventOS_event.h"
@@ -203,6 +204,47 @@ protected:
      */
     nsapi_size_or_error_t socket_recvfrom(void *handle, SocketAddress *address, void *buffer, nsapi_size_t size) override;
 
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Holds the stack lock across the whole batch.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to send
+     *  @param count     Number of datagrams
+     *  @return          Number of sent datagrams on success, negative error
+     *                   code on failure
+     */
+    nsapi_size_or_error_t socket_sendto_batch(void *handle, nsapi_datagram_t *datagrams, nsapi_size_t count) override;
+
+    /** Receive a batch of packets over a UDP socket
+     *
+     *  Holds the stack lock across the whole batch.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to receive into
+     *  @param count     Number of entries in datagrams
+     *  @return          Number of received datagrams on success, negative
+     *                   error code on failure
+     */
+    nsapi_size_or_error_t socket_recvfrom_batch(void *handle, nsapi_datagram_t *datagrams, nsapi_size_t count) override;
+
+    /** @copydoc NetworkStack::get_memory_manager */
+    NetStackMemoryManager *get_memory_manager() override;
+
+    /** Send a buffer over a UDP socket
+     *
+     *  A single buffer from get_memory_manager() is handed to the stack
+     *  without copying; the stack builds the headers in its headroom.
+     *  Chains are joined up first.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buf      Buffer chain from get_memory_manager()
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_sendto_buf(void *handle, const SocketAddress &address, net_stack_mem_buf_t *buf) override;
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -289,6 +331,7 @@ private:
     static void call_event_tasklet_main(arm_event_s *event);
     char text_ip_address[40];
     NanostackMemoryManager memory_manager;
+    NanostackSocketMemoryManager socket_memory_manager;
     int8_t call_event_tasklet;
 };
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "mbed_assert.h"
+#include "nsdynmemLIB.h"
+#include "NanostackLockGuard.h"
+#include "NanostackSocketMemoryManager.h"
+
+struct ns_socket_mem_t {
+    ns_socket_mem_t *next;
+    ns_socket_buffer_t *buf;
+};
+
+net_stack_mem_buf_t *NanostackSocketMemoryManager::alloc_heap(uint32_t size, uint32_t align)
+{
+    if (size > UINT16_MAX) {
+        return NULL;
+    }
+
+    NanostackLockGuard lock;
+    ns_socket_mem_t *mem = static_cast<ns_socket_mem_t *>(ns_dyn_mem_temporary_alloc(sizeof(ns_socket_mem_t)));
+    if (mem == NULL) {
+        return NULL;
+    }
+
+    mem->next = NULL;
+    mem->buf = socket_buffer_allocate(size);
+    if (mem->buf == NULL) {
+        ns_dyn_mem_free(mem);
+        return NULL;
+    }
+
+    return static_cast<net_stack_mem_buf_t *>(mem);
+}
+
+net_stack_mem_buf_t *NanostackSocketMemoryManager::alloc_pool(uint32_t size, uint32_t align)
+{
+    return alloc_heap(size, align);
+}
+
+uint32_t NanostackSocketMemoryManager::get_pool_alloc_unit(uint32_t align) const
+{
+    return 1280; // IPv6 minimum MTU
+}
+
+void NanostackSocketMemoryManager::free(net_stack_mem_buf_t *buf)
+{
+    ns_socket_mem_t *mem = static_cast<ns_socket_mem_t *>(buf);
+
+    NanostackLockGuard lock;
+    while (mem) {
+        ns_socket_mem_t *next = mem->next;
+        socket_buffer_free(mem->buf);
+        ns_dyn_mem_free(mem);
+        mem = next;
+    }
+}
+
+uint32_t NanostackSocketMemoryManager::get_total_len(const net_stack_mem_buf_t *buf) const
+{
+    const ns_socket_mem_t *mem = static_cast<const ns_socket_mem_t *>(buf);
+    uint32_t total = 0;
+
+    while (mem) {
+        total += socket_buffer_length(mem->buf);
+        mem = mem->next;
+    }
+    return total;
+}
+
+void NanostackSocketMemoryManager::copy(net_stack_mem_buf_t *to, const net_stack_mem_buf_t *from)
+{
+    MBED_ASSERT(get_total_len(to) >= get_total_len(from));
+
+    uint32_t to_offset = 0;
+    uint32_t from_offset = 0;
+    while (from) {
+        uint32_t to_avail = get_len(to) - to_offset;
+        uint32_t from_avail = get_len(from) - from_offset;
+        uint32_t chunk = to_avail < from_avail ? to_avail : from_avail;
+        uint8_t *to_ptr = static_cast<uint8_t *>(get_ptr(to)) + to_offset;
+        const uint8_t *from_ptr = static_cast<const uint8_t *>(get_ptr(from)) + from_offset;
+        memcpy(to_ptr, from_ptr, chunk);
+        to_offset += chunk;
+        if (to_offset == get_len(to)) {
+            to = get_next(to);
+            to_offset = 0;
+        }
+        from_offset += chunk;
+        if (from_offset == get_len(from)) {
+            from = get_next(from);
+            from_offset = 0;
+        }
+    }
+}
+
+void NanostackSocketMemoryManager::cat(net_stack_mem_buf_t *to_buf, net_stack_mem_buf_t *cat_buf)
+{
+    ns_socket_mem_t *to_mem = static_cast<ns_socket_mem_t *>(to_buf);
+
+    while (to_mem->next) {
+        to_mem = to_mem->next;
+    }
+
+    to_mem->next = static_cast<ns_socket_mem_t *>(cat_buf);
+}
+
+net_stack_mem_buf_t *NanostackSocketMemoryManager::get_next(const net_stack_mem_buf_t *buf) const
+{
+    return static_cast<const ns_socket_mem_t *>(buf)->next;
+}
+
+void *NanostackSocketMemoryManager::get_ptr(const net_stack_mem_buf_t *buf) const
+{
+    return socket_buffer_data(static_cast<const ns_socket_mem_t *>(buf)->buf);
+}
+
+uint32_t NanostackSocketMemoryManager::get_len(const net_stack_mem_buf_t *buf) const
+{
+    return socket_buffer_length(static_cast<const ns_socket_mem_t *>(buf)->buf);
+}
+
+void NanostackSocketMemoryManager::set_len(net_stack_mem_buf_t *buf, uint32_t len)
+{
+    ns_socket_mem_t *mem = static_cast<ns_socket_mem_t *>(buf);
+
+    MBED_ASSERT(len <= UINT16_MAX);
+    int8_t ret = socket_buffer_length_set(mem->buf, len);
+    MBED_ASSERT(ret == 0);
+    (void) ret;
+}
+
+ns_socket_buffer_t *NanostackSocketMemoryManager::release(net_stack_mem_buf_t *buf)
+{
+    ns_socket_mem_t *mem = static_cast<ns_socket_mem_t *>(buf);
+    MBED_ASSERT(mem->next == NULL);
+
+    ns_socket_buffer_t *socket_buf = mem->buf;
+    ns_dyn_mem_free(mem);
+    return socket_buf;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NANOSTACK_SOCKET_MEMORY_MANAGER_H
+#define NANOSTACK_SOCKET_MEMORY_MANAGER_H
+
+#include "NetStackMemoryManager.h"
+#include "socket_api.h"
+
+/** Memory manager for Nanostack socket buffers
+ *
+ * Each segment is a Nanostack socket transmit buffer, with headroom for the
+ * lower layer headers, so a single segment filled in by the application can
+ * be handed to socket_sendmsg_buffer() without copying the payload.
+ *
+ * Socket payloads have no alignment requirement, so the align arguments
+ * are ignored.
+ */
+class NanostackSocketMemoryManager final : public NetStackMemoryManager {
+public:
+    net_stack_mem_buf_t *alloc_heap(uint32_t size, uint32_t align) override;
+    net_stack_mem_buf_t *alloc_pool(uint32_t size, uint32_t align) override;
+    uint32_t get_pool_alloc_unit(uint32_t align) const override;
+    void free(net_stack_mem_buf_t *buf) override;
+    uint32_t get_total_len(const net_stack_mem_buf_t *buf) const override;
+    void copy(net_stack_mem_buf_t *to_buf, const net_stack_mem_buf_t *from_buf) override;
+    void cat(net_stack_mem_buf_t *to_buf, net_stack_mem_buf_t *cat_buf) override;
+    net_stack_mem_buf_t *get_next(const net_stack_mem_buf_t *buf) const override;
+    void *get_ptr(const net_stack_mem_buf_t *buf) const override;
+    uint32_t get_len(const net_stack_mem_buf_t *buf) const override;
+    void set_len(net_stack_mem_buf_t *buf, uint32_t len) override;
+
+    /** Take the socket buffer out of a single segment
+     *
+     * The segment is freed, and the caller owns the returned buffer.
+     *
+     * @param buf   Segment with no next segment
+     * @return      Socket buffer holding the segment's data
+     */
+    ns_socket_buffer_t *release(net_stack_mem_buf_t *buf);
+};
+
+#endif /* NANOSTACK_SOCKET_MEMORY_MANAGER_H */
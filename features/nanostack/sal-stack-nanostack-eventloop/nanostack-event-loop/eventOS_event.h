@@ -163,6 +163,26 @@ extern int8_t eventOS_event_handler_create(void (*handler_func_ptr)(arm_event_t
  */
 extern void eventOS_cancel(arm_event_storage_t *event);
 
+/** Event storage statistics */
+typedef struct eventOS_event_stats {
+    uint16_t pool_size;             /**< Number of events in the static pool */
+    uint16_t pool_used;             /**< Static pool events currently in use */
+    uint16_t pool_used_max;         /**< Maximum static pool events in use at once */
+    uint16_t dynamic_used;          /**< Heap-allocated events currently in use */
+    uint16_t dynamic_used_max;      /**< Maximum heap-allocated events in use at once */
+    uint32_t alloc_fail_cnt;        /**< Number of times no event storage was available */
+} eventOS_event_stats_t;
+
+/**
+ * \brief Read event storage statistics.
+ *
+ * Events are taken from a static pool, sized by NS_EVENTLOOP_EVENT_POOL_SIZE,
+ * and then from the heap unless NS_EVENTLOOP_NO_DYNAMIC_EVENTS is set.
+ *
+ * \param stats structure to store the statistics in
+ */
+extern void eventOS_event_stats_get(eventOS_event_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
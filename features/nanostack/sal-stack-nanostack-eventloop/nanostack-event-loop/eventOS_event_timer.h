@@ -215,6 +215,23 @@ extern int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id);
  * */
 extern uint32_t eventOS_event_timer_shortest_active_timer(void);
 
+/** Event timer statistics */
+typedef struct eventOS_event_timer_stats {
+    uint32_t active;            /**< Timers currently pending */
+    uint32_t active_max;        /**< Maximum number of timers pending at once */
+    uint32_t expired;           /**< Total number of timers expired */
+    uint32_t tick_updates;      /**< Number of system timer tick updates (wakeups) */
+    uint32_t idle_tick_updates; /**< Number of tick updates that expired no timers */
+} eventOS_event_timer_stats_t;
+
+/**
+ * Read event timer statistics
+ *
+ * \param stats structure to store the statistics in
+ *
+ * */
+extern void eventOS_event_timer_stats_get(eventOS_event_timer_stats_t *stats);
+
 
 /** Timeout structure. Not to be modified by user */
 typedef struct timeout_entry_t timeout_t;
@@ -27,6 +27,8 @@
 #undef NS_EVENTLOOP_USE_TICK_TIMER
 /* Exclude high resolution timer from build (removes need for "platform_timer" API) */
 #undef NS_EXCLUDE_HIGHRES_TIMER
+/* Never allocate events from the heap - eventOS_event_send() fails when the static pool is exhausted */
+#undef NS_EVENTLOOP_NO_DYNAMIC_EVENTS
 
 /*
  * mbedOS 5 specific configuration flag mapping to internal flags
@@ -39,6 +41,14 @@
 #define NS_EXCLUDE_HIGHRES_TIMER        1
 #endif
 
+#ifdef MBED_CONF_NANOSTACK_EVENTLOOP_NO_DYNAMIC_EVENTS
+#define NS_EVENTLOOP_NO_DYNAMIC_EVENTS  1
+#endif
+
+#ifdef MBED_CONF_NANOSTACK_EVENTLOOP_EVENT_POOL_SIZE
+#define NS_EVENTLOOP_EVENT_POOL_SIZE    MBED_CONF_NANOSTACK_EVENTLOOP_EVENT_POOL_SIZE
+#endif
+
 /*
  * Include the user config file if defined
  */
@@ -31,13 +31,23 @@ typedef struct arm_core_tasklet {
     ns_list_link_t link;
 } arm_core_tasklet_t;
 
+typedef NS_LIST_HEAD(arm_event_storage_t, link) event_list_t;
+
+#define EVENT_PRIORITY_COUNT (ARM_LIB_LOW_PRIORITY_EVENT + 1)
+
 static NS_LIST_DEFINE(arm_core_tasklet_list, arm_core_tasklet_t, link);
-static NS_LIST_DEFINE(event_queue_active, arm_event_storage_t, link);
 static NS_LIST_DEFINE(free_event_entry, arm_event_storage_t, link);
 
+// One queue per priority, each in order of sending
+static event_list_t event_queue_active[EVENT_PRIORITY_COUNT];
+
 // Statically allocate initial pool of events.
-#define STARTUP_EVENT_POOL_SIZE 10
-static arm_event_storage_t startup_event_pool[STARTUP_EVENT_POOL_SIZE];
+#ifndef NS_EVENTLOOP_EVENT_POOL_SIZE
+#define NS_EVENTLOOP_EVENT_POOL_SIZE 10
+#endif
+static arm_event_storage_t startup_event_pool[NS_EVENTLOOP_EVENT_POOL_SIZE];
+
+static eventOS_event_stats_t event_stats;
 
 /** Curr_tasklet tell to core and platform which task_let is active, Core Update this automatic when switch Tasklet. */
 int8_t curr_tasklet = 0;
@@ -140,18 +150,34 @@ void eventOS_event_send_timer_allocated(arm_event_storage_t *event)
     event_core_write(event);
 }
 
+static event_list_t *event_queue_for(const arm_event_storage_t *event)
+{
+    // Unknown priorities run after all others, as they always have
+    if ((unsigned) event->data.priority >= EVENT_PRIORITY_COUNT) {
+        return &event_queue_active[EVENT_PRIORITY_COUNT - 1];
+    }
+    return &event_queue_active[event->data.priority];
+}
+
 void eventOS_event_cancel_critical(arm_event_storage_t *event)
 {
-    ns_list_remove(&event_queue_active, event);
+    ns_list_remove(event_queue_for(event), event);
 }
 
 static arm_event_storage_t *event_dynamically_allocate(void)
 {
+#ifndef NS_EVENTLOOP_NO_DYNAMIC_EVENTS
     arm_event_storage_t *event = ns_dyn_mem_temporary_alloc(sizeof(arm_event_storage_t));
     if (event) {
         event->allocator = ARM_LIB_EVENT_DYNAMIC;
+        if (++event_stats.dynamic_used > event_stats.dynamic_used_max) {
+            event_stats.dynamic_used_max = event_stats.dynamic_used;
+        }
     }
     return event;
+#else
+    return NULL;
+#endif
 }
 
 static arm_core_tasklet_t *tasklet_dynamically_allocate(void)
@@ -166,10 +192,15 @@ arm_event_storage_t *event_core_get(void)
     event = ns_list_get_first(&free_event_entry);
     if (event) {
         ns_list_remove(&free_event_entry, event);
+        if (++event_stats.pool_used > event_stats.pool_used_max) {
+            event_stats.pool_used_max = event_stats.pool_used;
+        }
     } else {
         event = event_dynamically_allocate();
     }
-    if (event) {
+    if (!event) {
+        event_stats.alloc_fail_cnt++;
+    } else {
         event->data.data_ptr = NULL;
         event->data.priority = ARM_LIB_LOW_PRIORITY_EVENT;
     }
@@ -184,11 +215,15 @@ void event_core_free_push(arm_event_storage_t *free)
             free->state = ARM_LIB_EVENT_UNQUEUED;
             platform_enter_critical();
             ns_list_add_to_start(&free_event_entry, free);
+            event_stats.pool_used--;
             platform_exit_critical();
             break;
         case ARM_LIB_EVENT_DYNAMIC:
             // Free all dynamically allocated events.
             // No need to set state to UNQUEUED - it's being freed.
+            platform_enter_critical();
+            event_stats.dynamic_used--;
+            platform_exit_critical();
             ns_dyn_mem_free(free);
             break;
         case ARM_LIB_EVENT_TIMER:
@@ -206,11 +241,16 @@ void event_core_free_push(arm_event_storage_t *free)
 
 static arm_event_storage_t *event_core_read(void)
 {
+    arm_event_storage_t *event = NULL;
     platform_enter_critical();
-    arm_event_storage_t *event = ns_list_get_first(&event_queue_active);
-    if (event) {
-        event->state = ARM_LIB_EVENT_RUNNING;
-        ns_list_remove(&event_queue_active, event);
+    // Enum ordering puts highest priority first
+    for (int i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        event = ns_list_get_first(&event_queue_active[i]);
+        if (event) {
+            event->state = ARM_LIB_EVENT_RUNNING;
+            ns_list_remove(&event_queue_active[i], event);
+            break;
+        }
     }
     platform_exit_critical();
     return event;
@@ -219,18 +259,7 @@ static arm_event_storage_t *event_core_read(void)
 void event_core_write(arm_event_storage_t *event)
 {
     platform_enter_critical();
-    bool added = false;
-    ns_list_foreach(arm_event_storage_t, event_tmp, &event_queue_active) {
-        // note enum ordering means we're checking if event_tmp is LOWER priority than event
-        if (event_tmp->data.priority > event->data.priority) {
-            ns_list_add_before(&event_queue_active, event_tmp, event);
-            added = true;
-            break;
-        }
-    }
-    if (!added) {
-        ns_list_add_to_end(&event_queue_active, event);
-    }
+    ns_list_add_to_end(event_queue_for(event), event);
     event->state = ARM_LIB_EVENT_QUEUED;
 
     /* Wake From Idle */
@@ -241,15 +270,24 @@ void event_core_write(arm_event_storage_t *event)
 // Requires lock to be held
 arm_event_storage_t *eventOS_event_find_by_id_critical(uint8_t tasklet_id, uint8_t event_id)
 {
-    ns_list_foreach(arm_event_storage_t, cur, &event_queue_active) {
-        if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
-            return cur;
+    for (int i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        ns_list_foreach(arm_event_storage_t, cur, &event_queue_active[i]) {
+            if (cur->data.receiver == tasklet_id && cur->data.event_id == event_id) {
+                return cur;
+            }
         }
     }
 
     return NULL;
 }
 
+void eventOS_event_stats_get(eventOS_event_stats_t *stats)
+{
+    platform_enter_critical();
+    *stats = event_stats;
+    platform_exit_critical();
+}
+
 /**
  *
  * \brief Initialize Nanostack Core.
@@ -261,15 +299,20 @@ void eventOS_scheduler_init(void)
 {
     /* Reset Event List variables */
     ns_list_init(&free_event_entry);
-    ns_list_init(&event_queue_active);
+    for (int i = 0; i < EVENT_PRIORITY_COUNT; i++) {
+        ns_list_init(&event_queue_active[i]);
+    }
     ns_list_init(&arm_core_tasklet_list);
 
-    //Add first 10 entries to "free" list
+    //Add static pool entries to "free" list
     for (unsigned i = 0; i < (sizeof(startup_event_pool) / sizeof(startup_event_pool[0])); i++) {
         startup_event_pool[i].allocator = ARM_LIB_EVENT_STARTUP_POOL;
         ns_list_add_to_start(&free_event_entry, &startup_event_pool[i]);
     }
 
+    memset(&event_stats, 0, sizeof(event_stats));
+    event_stats.pool_size = NS_EVENTLOOP_EVENT_POOL_SIZE;
+
     /* Init Generic timer module */
     timer_sys_init();               //initialize timer
     /* Set Tasklett switcher to Idle */
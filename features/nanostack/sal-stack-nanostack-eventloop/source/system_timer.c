@@ -40,8 +40,20 @@ NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms pe
 // atomicity on 16-bit platforms
 static volatile uint32_t timer_sys_ticks;
 
+#ifndef TIMER_WHEEL_SIZE
+#define TIMER_WHEEL_SIZE 64
+#endif
+NS_STATIC_ASSERT((TIMER_WHEEL_SIZE & (TIMER_WHEEL_SIZE - 1)) == 0, "Timer wheel size must be a power of two")
+
+typedef NS_LIST_HEAD(sys_timer_struct_s, event.link) sys_timer_list_t;
+
 static NS_LIST_DEFINE(system_timer_free, sys_timer_struct_s, event.link);
-static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
+
+// Pending timers are hashed by launch time into a wheel of lists, so that
+// adding a timer and running a tick don't depend on the number pending.
+// Each list is in order of request.
+static sys_timer_list_t system_timer_wheel[TIMER_WHEEL_SIZE];
+static eventOS_event_timer_stats_t system_timer_stats;
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
@@ -90,6 +102,10 @@ static int8_t platform_tick_timer_stop(void)
  */
 void timer_sys_init(void)
 {
+    for (uint16_t i = 0; i < TIMER_WHEEL_SIZE; i++) {
+        ns_list_init(&system_timer_wheel[i]);
+    }
+
     for (uint8_t i = 0; i < ST_MAX; i++) {
         ns_list_add_to_start(&system_timer_free, &startup_sys_timer_pool[i]);
     }
@@ -129,6 +145,18 @@ static sys_timer_struct_s *sys_timer_dynamically_allocate(void)
     return ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
 }
 
+static NS_INLINE sys_timer_list_t *timer_sys_wheel_list(uint32_t launch_time)
+{
+    return &system_timer_wheel[launch_time & (TIMER_WHEEL_SIZE - 1)];
+}
+
+/* Called internally with lock held */
+static void timer_sys_remove(sys_timer_struct_s *timer)
+{
+    ns_list_remove(timer_sys_wheel_list(timer->launch_time), timer);
+    system_timer_stats.active--;
+}
+
 static sys_timer_struct_s *timer_struct_get(void)
 {
     sys_timer_struct_s *timer;
@@ -170,7 +198,7 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
     timer->period = 0;
     // If its unqueued it is on my timer list, otherwise it is in event-loop.
     if (event->state == ARM_LIB_EVENT_UNQUEUED) {
-        ns_list_remove(&system_timer_list, timer);
+        timer_sys_remove(timer);
     }
 }
 
@@ -188,19 +216,11 @@ uint32_t eventOS_event_timer_ticks(void)
 /* Called internally with lock held */
 static void timer_sys_add(sys_timer_struct_s *timer)
 {
-    uint32_t at = timer->launch_time;
-
-    // Find first timer scheduled to run after us, and insert before it.
-    // (This means timers scheduled for same time run in order of request)
-    ns_list_foreach(sys_timer_struct_s, t, &system_timer_list) {
-        if (TICKS_BEFORE(at, t->launch_time)) {
-            ns_list_add_before(&system_timer_list, t, timer);
-            return;
-        }
+    // Add to end, so timers scheduled for same time run in order of request
+    ns_list_add_to_end(timer_sys_wheel_list(timer->launch_time), timer);
+    if (++system_timer_stats.active > system_timer_stats.active_max) {
+        system_timer_stats.active_max = system_timer_stats.active;
     }
-
-    // Didn't insert before another timer, so must be last.
-    ns_list_add_to_end(&system_timer_list, timer);
 }
 
 /* Called internally with lock held */
@@ -307,10 +327,12 @@ int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id)
     platform_enter_critical();
 
     /* First check pending timers */
-    ns_list_foreach(sys_timer_struct_s, cur, &system_timer_list) {
-        if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
-            eventOS_cancel(&cur->event);
-            goto done;
+    for (uint16_t i = 0; i < TIMER_WHEEL_SIZE; i++) {
+        ns_list_foreach(sys_timer_struct_s, cur, &system_timer_wheel[i]) {
+            if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
+                eventOS_cancel(&cur->event);
+                goto done;
+            }
         }
     }
 
@@ -335,39 +357,68 @@ uint32_t eventOS_event_timer_shortest_active_timer(void)
     uint32_t ret_val = 0;
 
     platform_enter_critical();
-    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
-    if (first == NULL) {
-        // Weird API has 0 for "no events"
-        ret_val = 0;
-    } else if (TICKS_BEFORE_OR_AT(first->launch_time, timer_sys_ticks)) {
-        // Which means an immediate/overdue event has to be 1
-        ret_val = 1;
-    } else {
-        ret_val = first->launch_time - timer_sys_ticks;
+    // Weird API has 0 for "no events"
+    if (system_timer_stats.active) {
+        // Look at lists in order of time from now. A timer on the list for
+        // "now + i" that is due in i ticks is the first; others there are due
+        // in later turns of the wheel, so track the minimum in case no list
+        // has one due in this turn.
+        ret_val = UINT32_MAX;
+        for (uint32_t i = 1; i <= TIMER_WHEEL_SIZE && ret_val > i; i++) {
+            ns_list_foreach(sys_timer_struct_s, cur, timer_sys_wheel_list(timer_sys_ticks + i)) {
+                if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
+                    // Which means an immediate/overdue event has to be 1
+                    ret_val = 1;
+                    break;
+                }
+                if (cur->launch_time - timer_sys_ticks < ret_val) {
+                    ret_val = cur->launch_time - timer_sys_ticks;
+                }
+            }
+        }
     }
 
     platform_exit_critical();
     return eventOS_event_timer_ticks_to_ms(ret_val);
 }
 
+void eventOS_event_timer_stats_get(eventOS_event_timer_stats_t *stats)
+{
+    platform_enter_critical();
+    *stats = system_timer_stats;
+    platform_exit_critical();
+}
+
 void system_timer_tick_update(uint32_t ticks)
 {
     platform_enter_critical();
     //Keep runtime time
     timer_sys_ticks += ticks;
-    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
-        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
-            // Unthread from our list
-            ns_list_remove(&system_timer_list, cur);
-            // Make it an event (can't fail - no allocation)
-            // event system will call our timer_sys_event_free on event delivery.
-            eventOS_event_send_timer_allocated(&cur->event);
-        } else {
-            // List is ordered, so as soon as we see a later event, we're done.
-            break;
+    system_timer_stats.tick_updates++;
+
+    // Each list passed over holds the timers due at that tick; after a jump
+    // of a full turn or more, every list may hold overdue timers.
+    uint32_t lists = ticks < TIMER_WHEEL_SIZE ? ticks : TIMER_WHEEL_SIZE;
+    uint32_t expired = 0;
+    for (uint32_t t = timer_sys_ticks - lists + 1; lists; lists--, t++) {
+        sys_timer_list_t *list = timer_sys_wheel_list(t);
+        ns_list_foreach_safe(sys_timer_struct_s, cur, list) {
+            if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
+                // Unthread from our list
+                timer_sys_remove(cur);
+                // Make it an event (can't fail - no allocation)
+                // event system will call our timer_sys_event_free on event delivery.
+                eventOS_event_send_timer_allocated(&cur->event);
+                expired++;
+            }
         }
     }
 
+    if (expired) {
+        system_timer_stats.expired += expired;
+    } else {
+        system_timer_stats.idle_tick_updates++;
+    }
+
     platform_exit_critical();
 }
-
@@ -51,6 +51,10 @@ typedef struct nwk_stats_t {
     /* Fragments */
     uint32_t frag_rx_errors;        /**< Fragmentation RX error count. */
     uint32_t frag_tx_errors;        /**< Fragmentation TX error count. */
+    uint32_t frag_rx_timeouts;      /**< Fragmentation RX reassembly timeout count. */
+    uint32_t frag_rx_pool_drops;    /**< Fragmentation RX datagrams dropped for lack of a reassembly block. */
+    uint16_t frag_rx_pool_used;     /**< Fragmentation RX reassembly blocks in use. */
+    uint16_t frag_rx_pool_peak;     /**< Fragmentation RX reassembly blocks in use peak. */
     /*RPL stats*/
     uint32_t rpl_route_routecost_better_change; /**< RPL parent change count. */
     uint32_t ip_routeloop_detect;               /**< RPL route loop detection count. */
@@ -73,6 +77,12 @@ typedef struct nwk_stats_t {
     /* MAC */
     uint16_t adapt_layer_tx_queue_size; /**< Adaptation layer direct TX queue size. */
     uint16_t adapt_layer_tx_queue_peak; /**< Adaptation layer direct TX queue size peak. */
+    /* MPL */
+    uint16_t mpl_buffered_bytes;    /**< MPL buffered message bytes. */
+    uint16_t mpl_buffered_peak;     /**< MPL buffered message bytes peak. */
+    uint32_t mpl_evict_count;       /**< MPL buffered messages evicted to make space. */
+    uint32_t mpl_evict_bytes;       /**< MPL buffered message bytes evicted to make space. */
+    uint32_t mpl_duplicate_drop;    /**< MPL repeated or old messages dropped. */
 } nwk_stats_t;
 
 /**
@@ -40,6 +40,7 @@ extern "C" {
  * - socket_send(), A function to write data buffer to a socket.
  * - socket_sendto(), A function to write data to a specific destination in the socket.
  * - socket_sendmsg(), A function which support socket_send and socket_sendto functionality which supports ancillary data
+ * - socket_sendmsg_buffer(), A function to send a payload written in place into a buffer from socket_buffer_allocate()
  *
  * \section sock-connect TCP socket connection handle
  *  - socket_listen(), A function to set the socket to listening mode.
@@ -210,6 +211,11 @@ typedef struct ns_msghdr {
     int msg_flags;                  /**< Flags for received messages */
 } ns_msghdr_t;
 
+/*!
+ * \brief Socket transmit buffer for socket_sendmsg_buffer(). Contents are private to the stack.
+ */
+typedef struct buffer ns_socket_buffer_t;
+
 /*!
  * \struct ns_cmsghdr_t
  * \brief Control messages.
@@ -624,6 +630,73 @@ int16_t socket_sendto(int8_t socket, const ns_address_t *address, const void *bu
  */
 int16_t socket_sendmsg(int8_t socket, const ns_msghdr_t *msg, int flags);
 
+/**
+ * \brief A function to allocate a transmit buffer for socket_sendmsg_buffer().
+ *
+ * The application writes its payload directly into the buffer. Room for the
+ * IPv6, 6LoWPAN and MAC headers is reserved in front of the payload, so the
+ * stack builds the frame around it without copying the data again.
+ *
+ * \param length Payload length.
+ *
+ * \return A pointer to the buffer, or NULL if allocation failed.
+ */
+ns_socket_buffer_t *socket_buffer_allocate(uint16_t length);
+
+/**
+ * \brief A function to get the payload of a buffer from socket_buffer_allocate().
+ *
+ * \param buf A pointer to the buffer.
+ *
+ * \return A pointer to the payload.
+ */
+uint8_t *socket_buffer_data(ns_socket_buffer_t *buf);
+
+/**
+ * \brief A function to get the payload length of a buffer from socket_buffer_allocate().
+ *
+ * \param buf A pointer to the buffer.
+ *
+ * \return The payload length.
+ */
+uint16_t socket_buffer_length(const ns_socket_buffer_t *buf);
+
+/**
+ * \brief A function to change the payload length of a buffer from socket_buffer_allocate().
+ *
+ * \param buf A pointer to the buffer.
+ * \param length New payload length, no more than the buffer was allocated with.
+ *
+ * \return 0 on success.
+ * \return -1 if the buffer has no room for length.
+ */
+int8_t socket_buffer_length_set(ns_socket_buffer_t *buf, uint16_t length);
+
+/**
+ * \brief A function to free a buffer from socket_buffer_allocate() that was not sent.
+ *
+ * \param buf A pointer to the buffer.
+ */
+void socket_buffer_free(ns_socket_buffer_t *buf);
+
+/**
+ * \brief A function to send a buffer from socket_buffer_allocate() via a UDP or raw ICMP socket.
+ *
+ * As socket_sendmsg(), except that the payload is taken from buf and
+ * msg->msg_iov is ignored. msg may be NULL for a connected socket.
+ *
+ * The buffer is always consumed, even on failure, and must not be used after
+ * the call. Stream sockets are not supported.
+ *
+ * \param socket The socket ID.
+ * \param buf A pointer to the buffer.
+ * \param msg A pointer to the message header holding address and ancillary data, or NULL.
+ * \param flags A flags for message send (eg NS_MSG_LEGACY0)
+ *
+ * \return As socket_sendmsg().
+ */
+int16_t socket_sendmsg_buffer(int8_t socket, ns_socket_buffer_t *buf, const ns_msghdr_t *msg, int flags);
+
 /**
  * \brief A function to read local address and port for a bound socket.
  *
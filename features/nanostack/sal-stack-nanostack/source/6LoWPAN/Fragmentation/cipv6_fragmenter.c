@@ -40,6 +40,30 @@
 
 #define TRACE_GROUP "6frg"
 
+/* Reassembly blocks, shared by all interfaces. Partial datagrams are held in
+ * these rather than in heap buffers, so incomplete datagrams cannot fragment
+ * the heap; a datagram is only copied into a buffer once complete. A datagram
+ * bigger than a block, or arriving when all blocks are in use, is dropped at
+ * its first fragment.
+ */
+#ifndef CIPV6_REASSEMBLY_POOL_COUNT
+#define CIPV6_REASSEMBLY_POOL_COUNT 4
+#endif
+
+/* Largest datagram (uncompressed IPv6 size) that can be reassembled */
+#ifndef CIPV6_REASSEMBLY_POOL_DATAGRAM_SIZE
+#define CIPV6_REASSEMBLY_POOL_DATAGRAM_SIZE LOWPAN_MTU
+#endif
+
+/* Allow 1 byte extra for an "Uncompressed IPv6" dispatch byte - the
+ * 6LoWPAN data can be 1 byte longer than the IPv6 data.
+ * Also, round datagram size up to a multiple of 8 to ensure we have
+ * room for a final hole descriptor (it can spill past the indicated
+ * datagram size if the last fragment is smaller than 8 bytes).
+ * Then round the block to 8 bytes so the free list links stay aligned.
+ */
+#define REASSEMBLY_BLOCK_SIZE ((1 + ((CIPV6_REASSEMBLY_POOL_DATAGRAM_SIZE + 7) & ~7) + 7) & ~7)
+
 typedef struct {
     uint16_t ttl;   /*!< Reassembly timer (seconds) */
     uint16_t tag;   /*!< Fragmentation datagram TAG ID */
@@ -48,7 +72,9 @@ typedef struct {
     uint16_t frag_max;  /*!< Maximum fragment size (MAC payload) */
     uint16_t offset; /*!< Data offset from datagram start */
     int16_t pattern; /*!< Size of compressed LoWPAN headers */
-    buffer_t *buf;
+    bool first_seen; /*!< First fragment received, so buf holds its metadata */
+    uint8_t *block; /*!< Reassembly block, data at block + 1 */
+    buffer_t *buf;  /*!< Fragment buffer kept for addresses and metadata */
     ns_list_link_t      link; /*!< List link entry */
 } reassembly_entry_t;
 
@@ -65,6 +91,55 @@ typedef struct {
 
 static NS_LIST_DEFINE(reassembly_interface_list, reassembly_interface_t, link);
 
+static uint8_t *reassembly_pool;
+static void *reassembly_pool_free;
+static uint8_t reassembly_pool_used;
+
+static bool reassembly_pool_init(void)
+{
+    if (reassembly_pool) {
+        return true;
+    }
+
+    reassembly_pool = ns_dyn_mem_alloc(CIPV6_REASSEMBLY_POOL_COUNT * REASSEMBLY_BLOCK_SIZE);
+    if (!reassembly_pool) {
+        return false;
+    }
+
+    reassembly_pool_free = NULL;
+    for (int i = 0; i < CIPV6_REASSEMBLY_POOL_COUNT; i++) {
+        void **block = (void **)(reassembly_pool + i * REASSEMBLY_BLOCK_SIZE);
+        *block = reassembly_pool_free;
+        reassembly_pool_free = block;
+    }
+    reassembly_pool_used = 0;
+    return true;
+}
+
+static uint8_t *reassembly_block_get(void)
+{
+    // Pool is allocated at first use, and kept until the last interface goes
+    if (!reassembly_pool_init()) {
+        return NULL;
+    }
+
+    void **block = reassembly_pool_free;
+    if (!block) {
+        return NULL;
+    }
+
+    reassembly_pool_free = *block;
+    protocol_stats_update(STATS_FRAG_RX_POOL_USED, ++reassembly_pool_used);
+    return (uint8_t *) block;
+}
+
+static void reassembly_block_free(uint8_t *block)
+{
+    *(void **) block = reassembly_pool_free;
+    reassembly_pool_free = block;
+    protocol_stats_update(STATS_FRAG_RX_POOL_USED, --reassembly_pool_used);
+}
+
 
 /* Reassembly structures and helpers - basically the same as in
  * ipv6_fragmentation.c, as we are also using a variation of RFC 815, but there
@@ -86,23 +161,23 @@ typedef struct hole {
  * alignment for hole_t, and letting us manipulate uintptr_t in the conventional
  * fashion.
  */
-static hole_t *hole_pointer(const buffer_t *buf, uint16_t offset)
+static hole_t *hole_pointer(uint8_t *data, uint16_t offset)
 {
-    uintptr_t ptr = (uintptr_t)(buffer_data_pointer(buf) + offset);
+    uintptr_t ptr = (uintptr_t)(data + offset);
 
     return (hole_t *)((ptr + 1) & ~(uintptr_t) 1);
 }
 
-static void delete_hole(buffer_t *buf, uint16_t hole, uint16_t *prev_ptr)
+static void delete_hole(uint8_t *data, uint16_t hole, uint16_t *prev_ptr)
 {
-    hole_t *hole_ptr = hole_pointer(buf, hole);
+    hole_t *hole_ptr = hole_pointer(data, hole);
 
     *prev_ptr = hole_ptr->next;
 }
 
-static hole_t *create_hole(buffer_t *buf, uint16_t first, uint16_t last, uint16_t *prev_ptr)
+static hole_t *create_hole(uint8_t *data, uint16_t first, uint16_t last, uint16_t *prev_ptr)
 {
-    hole_t *hole_ptr = hole_pointer(buf, first);
+    hole_t *hole_ptr = hole_pointer(data, first);
     hole_ptr->first = first;
     hole_ptr->last = last;
     hole_ptr->next = *prev_ptr;
@@ -125,7 +200,7 @@ static hole_t *create_hole(buffer_t *buf, uint16_t first, uint16_t last, uint16_
  * always know the 6LoWPAN size of the first fragment, the reassembly buffer
  * always leaves space for the uncompressed IPv6 header, and 1 byte more for a
  * 6LoWPAN "uncompressed IPv6" dispatch byte. This means non-first fragments
- * are always placed at buffer_data_pointer() + datagram_offset.
+ * are always placed at the block's data start (block + 1) + datagram_offset.
  *
  * This routine doesn't explicitly distinguish the compressed and uncompressed
  * cases - the difference arises purely from the output of "iphc_header_scan",
@@ -145,7 +220,7 @@ static hole_t *create_hole(buffer_t *buf, uint16_t first, uint16_t last, uint16_
  *    |FRAGN 0x70|    data2    |
  *    +----------+-------------+
  *
- * During assembly, the data pointer points at the "0" position representing the
+ * During assembly, the data start is the "0" position representing the
  * virtual start of the IPv6 packet:
  *
  *   -1 0        0x20             0x70           0xD0
@@ -153,7 +228,7 @@ static hole_t *create_hole(buffer_t *buf, uint16_t first, uint16_t last, uint16_
  *    | | padding |  IPHC  |  data1 |    data2    |
  *    +-+---------+--------+--------+-------------+
  *
- * On completion of assembly, the start pointer moves forward to point at the
+ * On completion of assembly, the copy out starts forward, at the
  * IPHC header. (This means buffer size is slightly inefficient for an IPHC
  * upper layer, but it does reserve headroom for decompression to native IPv6.)
  *
@@ -175,7 +250,7 @@ static hole_t *create_hole(buffer_t *buf, uint16_t first, uint16_t last, uint16_
  *    |FRAGN 0x70|     data2     |
  *    +----------+---------------+
  *
- * During assembly, the data pointer points at the "0" position representing the
+ * During assembly, the data start is the "0" position representing the
  * start of the IPv6 packet:
  *
  *   -1 0             0x70            0xD0
@@ -183,7 +258,7 @@ static hole_t *create_hole(buffer_t *buf, uint16_t first, uint16_t last, uint16_
  *    |D|    data1     |     data2     |
  *    +-+--------------+---------------+
  *
- * On completion of assembly, the start pointer moves back to point to the
+ * On completion of assembly, the copy out starts back, at the
  * 6LoWPAN dispatch byte:
  *
  *    0 1             0x71            0xD1
@@ -217,6 +292,10 @@ static void reassembly_entry_free(reassembly_interface_t *interface_ptr, reassem
     if (entry->buf) {
         entry->buf = buffer_free(entry->buf);
     }
+    if (entry->block) {
+        reassembly_block_free(entry->block);
+        entry->block = NULL;
+    }
 }
 
 static void reassembly_list_free(reassembly_interface_t *interface_ptr)
@@ -297,44 +376,38 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
     reassembly_entry_t *frag_ptr = reassembly_already_action(&interface_ptr->rx_list, buf, datagram_tag, datagram_size);
 
     if (!frag_ptr) {
+        if (datagram_size > CIPV6_REASSEMBLY_POOL_DATAGRAM_SIZE) {
+            tr_debug("Reassembly too big: %u", datagram_size);
+            protocol_stats_update(STATS_FRAG_RX_POOL_DROP, 1);
+            goto resassembly_error;
+        }
 
         frag_ptr = lowpan_adaptation_reassembly_get(interface_ptr);
         if (!frag_ptr) {
             goto resassembly_error;
         }
 
-        buffer_t *reassembly_buffer = buffer_get(1 + ((datagram_size + 7) & ~7));
-        if (!reassembly_buffer) {
+        frag_ptr->block = reassembly_block_get();
+        if (!frag_ptr->block) {
             //Put allocated back to free
             reassembly_entry_free(interface_ptr, frag_ptr);
+            protocol_stats_update(STATS_FRAG_RX_POOL_DROP, 1);
             goto resassembly_error;
         }
 
-        // Allocate the reassembly buffer.
-        // Allow 1 byte extra for an "Uncompressed IPv6" dispatch byte - the
-        // 6LoWPAN data can be 1 byte longer than the IPv6 data.
-        // Also, round datagram size up to a multiple of 8 to ensure we have
-        // room for a final hole descriptor (it can spill past the indicated
-        // datagram size if the last fragment is smaller than 8 bytes).
-
-        reassembly_buffer->src_sa = buf->src_sa;
-        reassembly_buffer->dst_sa = buf->dst_sa;
         frag_ptr->ttl = interface_ptr->timeout;
         frag_ptr->tag = datagram_tag;
         frag_ptr->size = datagram_size;
-        // Set buffer length and adjust start pointer, so it represents the
-        // uncompressed IPv6 packet. (See comment block before this function).
-        buffer_data_length_set(reassembly_buffer, 1 + datagram_size);
-        buffer_data_strip_header(reassembly_buffer, 1);
-        // Write initial hole descriptor into buffer
+        // Write initial hole descriptor into block, past the dispatch byte.
+        // (See comment block before this function).
         frag_ptr->offset = 0xffff;
-        create_hole(reassembly_buffer, 0, datagram_size - 1, &frag_ptr->offset);
-        frag_ptr->buf = reassembly_buffer;
+        create_hole(frag_ptr->block + 1, 0, datagram_size - 1, &frag_ptr->offset);
     }
 
+    uint8_t *data = frag_ptr->block + 1;
+
     /* For the first link fragment, work out and remember the "pattern"
-     * (difference between6LoWPAN and IPv6 size), and also copy the buffer
-     * header metadata.
+     * (difference between6LoWPAN and IPv6 size).
      */
     uint16_t lowpan_size, ipv6_size;
     if (fragment_first == 0) {
@@ -344,12 +417,6 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
         lowpan_size = buffer_data_length(buf);
         ipv6_size = lowpan_size - compressed_header_size + uncompressed_header_size;
         frag_ptr->pattern = ipv6_size - lowpan_size;
-
-        /* Clone the buffer header from this first fragment, preserving only size + pointers */
-        /* Also the security flag - this fragment's flag is merged in later */
-        bool buf_security = frag_ptr->buf->options.ll_security_bypass_rx;
-        buffer_copy_metadata(frag_ptr->buf, buf, true);
-        frag_ptr->buf->options.ll_security_bypass_rx = buf_security;
     } else {
         ipv6_size = lowpan_size = buffer_data_length(buf);
     }
@@ -369,7 +436,7 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
     uint16_t hole_off = frag_ptr->offset;
     uint16_t *prev_ptr = &frag_ptr->offset;
     do {
-        hole_t *hole = hole_pointer(frag_ptr->buf, hole_off);
+        hole_t *hole = hole_pointer(data, hole_off);
         uint_fast16_t hole_first = hole->first;
         uint_fast16_t hole_last = hole->last;
 
@@ -392,20 +459,20 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
             protocol_stats_update(STATS_FRAG_RX_ERROR, 1);
             /* Forget previous data by marking as "all hole" */
             frag_ptr->offset = 0xffff;
-            create_hole(frag_ptr->buf, hole_off = hole_first = 0, hole_last = datagram_size - 1, prev_ptr = &frag_ptr->offset);
+            create_hole(data, hole_off = hole_first = 0, hole_last = datagram_size - 1, prev_ptr = &frag_ptr->offset);
         }
 
         /* Unhook this hole from the hole list (RFC 815 step 4) */
-        delete_hole(frag_ptr->buf, hole_off, prev_ptr);
+        delete_hole(data, hole_off, prev_ptr);
 
         /* Create a new hole in front if necessary (RFC 815 step 5) */
         if (fragment_first > hole_first) {
-            prev_ptr = &create_hole(frag_ptr->buf, hole_first, fragment_first - 1, prev_ptr)->next;
+            prev_ptr = &create_hole(data, hole_first, fragment_first - 1, prev_ptr)->next;
         }
 
         /* Create a following hole if necessary (RFC 815 step 6) */
         if (fragment_last < hole_last) {
-            create_hole(frag_ptr->buf, fragment_last + 1, hole_last, prev_ptr);
+            create_hole(data, fragment_last + 1, hole_last, prev_ptr);
         }
 
         /* Unlike RFC 815, we're now done. We don't allow overlaps, so we finish
@@ -416,14 +483,28 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
     /* Hole list updated, can now copy in the fragment data -  to make sure the
      * initial fragment goes in the right place we use the end offset, rather
      * than the start offset. */
-    memcpy(buffer_data_pointer(frag_ptr->buf) + fragment_last + 1 - lowpan_size, buffer_data_pointer(buf), lowpan_size);
+    memcpy(data + fragment_last + 1 - lowpan_size, buffer_data_pointer(buf), lowpan_size);
 
-    /* Combine the "improper security" flags, so reassembled buffer's flag is set if any fragment wasn't secure */
+    /* Keep one fragment buffer for its addresses and metadata - the first
+     * link fragment's once it arrives. Combine the "improper security" flags,
+     * so the kept flag is set if any fragment wasn't secure.
+     */
     /* XXX should have some sort of overall "merge buffer metadata" routine handling this and whatever else */
-    frag_ptr->buf->options.ll_security_bypass_rx |= buf->options.ll_security_bypass_rx;
-
-    /* We've finished with the original fragment buffer */
-    buf = buffer_free(buf);
+    bool security_bypass = buf->options.ll_security_bypass_rx;
+    if (frag_ptr->buf) {
+        security_bypass |= frag_ptr->buf->options.ll_security_bypass_rx;
+    }
+    if (!frag_ptr->buf || (fragment_first == 0 && !frag_ptr->first_seen)) {
+        if (frag_ptr->buf) {
+            buffer_free(frag_ptr->buf);
+        }
+        frag_ptr->buf = buf;
+        frag_ptr->first_seen = fragment_first == 0;
+    } else {
+        buffer_free(buf);
+    }
+    frag_ptr->buf->options.ll_security_bypass_rx = security_bypass;
+    buf = NULL;
 
     /* Completion check - any holes left? */
     if (frag_ptr->offset != 0xffff) {
@@ -431,18 +512,23 @@ buffer_t *cipv6_frag_reassembly(int8_t interface_id, buffer_t *buf)
         return NULL;
     }
 
-    /* No more holes, so our reassembly is complete */
-    buf = frag_ptr->buf;
-    frag_ptr->buf = NULL;
-    reassembly_entry_free(interface_ptr, frag_ptr);
-
-    /* Buffer start pointer is currently at the "start of uncompressed IPv6
-     * packet" position. Move it either forwards or backwards to match
-     * the IPHC data (could be compressed, or uncompressed with added dispatch
-     * byte).
+    /* No more holes, so our reassembly is complete. Copy it out into a
+     * buffer, starting either forwards or backwards of the "start of
+     * uncompressed IPv6 packet" position to match the IPHC data (could be
+     * compressed, or uncompressed with added dispatch byte). The bytes
+     * skipped are left as headroom for decompression to native IPv6.
      */
-    buf->buf_ptr += frag_ptr->pattern;
-    buf->info = (buffer_info_t)(B_DIR_UP | B_FROM_FRAGMENTATION | B_TO_IPV6_TXRX);
+    uint16_t headroom = 1 + frag_ptr->pattern;
+    uint16_t length = datagram_size - frag_ptr->pattern;
+    buf = buffer_get_specific(headroom, length, 0);
+    if (buf) {
+        buffer_copy_metadata(buf, frag_ptr->buf, true);
+        buffer_data_add(buf, frag_ptr->block + headroom, length);
+        buf->info = (buffer_info_t)(B_DIR_UP | B_FROM_FRAGMENTATION | B_TO_IPV6_TXRX);
+    } else {
+        protocol_stats_update(STATS_FRAG_RX_ERROR, 1);
+    }
+    reassembly_entry_free(interface_ptr, frag_ptr);
     return buf;
 
 resassembly_error:
@@ -457,6 +543,7 @@ static void reassembly_entry_timer_update(reassembly_interface_t *interface_ptr,
             reassembly_entry->ttl -= seconds;
         } else {
             protocol_stats_update(STATS_FRAG_RX_ERROR, 1);
+            protocol_stats_update(STATS_FRAG_RX_TIMEOUT, 1);
             tr_debug("Reassembly TO: src %s size %u",
                      trace_sockaddr(&reassembly_entry->buf->src_sa, true),
                      reassembly_entry->size);
@@ -480,12 +567,19 @@ int8_t reassembly_interface_free(int8_t interface_id)
         return -1;
     }
 
+    //Return buffers and blocks of any reassemblies in progress
+    reassembly_list_free(interface_ptr);
     ns_list_remove(&reassembly_interface_list, interface_ptr);
 
     //Free Dynamic allocated entry buffer
     ns_dyn_mem_free(interface_ptr->entry_pointer_buffer);
     ns_dyn_mem_free(interface_ptr);
 
+    if (ns_list_is_empty(&reassembly_interface_list)) {
+        ns_dyn_mem_free(reassembly_pool);
+        reassembly_pool = NULL;
+    }
+
     return 0;
 }
 
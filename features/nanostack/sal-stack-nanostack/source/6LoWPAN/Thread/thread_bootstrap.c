@@ -656,6 +656,7 @@ static void thread_bootstrap_ml_address_update(protocol_interface_info_entry_t *
                 tr_debug("Updated to %s.", trace_ipv6(entry->ip_address));
             }
         }
+        ipv6_neighbour_cache_rehash(&cur->ipv6_neighbour_cache);
 
         // Delete the ML64 address
         thread_delete_ml64_address(cur);
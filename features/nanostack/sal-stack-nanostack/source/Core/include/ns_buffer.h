@@ -55,6 +55,16 @@
  */
 #define BUFFER_DEFAULT_HEADROOM     40
 
+/*
+ * headroom given to datagram buffers from sockets.
+ * enough for the IPv6 (40), UDP (8), RPL hop-by-hop (8) and 6LoWPAN
+ * fragment (5) headers plus an 802.15.4 MAC header with security, so the
+ * frame can be built in front of the payload without moving it.
+ */
+#ifndef BUFFER_SOCKET_HEADROOM
+#define BUFFER_SOCKET_HEADROOM      112
+#endif
+
 /*
  * default minimum size for buffers.
  * if size is below this then extra space is allocated as headroom.
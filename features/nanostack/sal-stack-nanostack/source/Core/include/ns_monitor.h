@@ -27,6 +27,8 @@
 #ifndef _NS_MONITOR_H
 #define _NS_MONITOR_H
 
+struct ipv6_cache_lookup_stats;
+
 int ns_monitor_init(void);
 
 int ns_monitor_clear(void);
@@ -35,5 +37,14 @@ void ns_monitor_timer(uint16_t seconds);
 
 int ns_monitor_heap_gc_threshold_set(uint8_t percentage_high, uint8_t percentage_critical);
 
+/**
+ * Read the look-up statistics of the Neighbour Caches and the Destination Cache.
+ *
+ * \param neighbour statistics of the Neighbour Caches of all interfaces
+ * \param destination statistics of the Destination Cache
+ * \return 0 on success, -1 on invalid parameters
+ */
+int ns_monitor_cache_stats_get(struct ipv6_cache_lookup_stats *neighbour, struct ipv6_cache_lookup_stats *destination);
+
 #endif // _NS_MONITOR_H
 
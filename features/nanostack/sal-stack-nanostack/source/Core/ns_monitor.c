@@ -64,6 +64,13 @@ static ns_monitor_t *ns_monitor_ptr = NULL;
 
 typedef void (ns_maintenance_gc_cb)(bool full_gc);
 
+static void ns_monitor_neighbour_cache_gc(bool full_gc)
+{
+    ns_list_foreach(protocol_interface_info_entry_t, cur, &protocol_interface_info_list) {
+        ipv6_neighbour_cache_forced_gc(&cur->ipv6_neighbour_cache, full_gc);
+    }
+}
+
 /*
  * Garbage collection functions.
  * Add more GC performing functions to the table
@@ -71,6 +78,7 @@ typedef void (ns_maintenance_gc_cb)(bool full_gc);
  */
 static ns_maintenance_gc_cb *ns_maintenance_gc_functions[] = {
     ipv6_destination_cache_forced_gc,
+    ns_monitor_neighbour_cache_gc,
     ws_pae_controller_forced_gc
 };
 
@@ -172,6 +180,21 @@ int ns_monitor_clear(void)
     return -1;
 }
 
+int ns_monitor_cache_stats_get(ipv6_cache_lookup_stats_t *neighbour, ipv6_cache_lookup_stats_t *destination)
+{
+    if (!neighbour || !destination) {
+        return -1;
+    }
+
+    *neighbour = *ipv6_neighbour_cache_lookup_stats();
+    *destination = *ipv6_destination_cache_lookup_stats();
+    tr_debug("Neighbour cache lookups:%"PRIu32" misses:%"PRIu32" probes:%"PRIu32" evictions:%"PRIu32,
+             neighbour->lookups, neighbour->misses, neighbour->probes, neighbour->evictions);
+    tr_debug("Destination cache lookups:%"PRIu32" misses:%"PRIu32" probes:%"PRIu32" evictions:%"PRIu32,
+             destination->lookups, destination->misses, destination->probes, destination->evictions);
+    return 0;
+}
+
 int ns_monitor_heap_gc_threshold_set(uint8_t percentage_high, uint8_t percentage_critical)
 {
     if (ns_monitor_ptr && (percentage_critical <= 100) && (percentage_high < percentage_critical)) {
@@ -1068,7 +1068,14 @@ int16_t socket_buffer_sendmsg(int8_t sid, buffer_t *buf, const struct ns_msghdr
 
     // Now copy (some of) the data into a buffer
     if (!buf) {
-        buf = buffer_get(payload_length);
+        uint16_t headroom = BUFFER_SOCKET_HEADROOM;
+#ifndef NO_TCP
+        if (socket_ptr->type == SOCKET_TYPE_STREAM) {
+            // Stream data sits in the send queue and is segmented by TCP
+            headroom = BUFFER_DEFAULT_HEADROOM;
+        }
+#endif
+        buf = buffer_get_specific(headroom, payload_length, BUFFER_DEFAULT_MIN_SIZE);
         if (!buf) {
             ret_val = -2;
             goto fail;
@@ -1263,7 +1270,8 @@ int16_t socket_buffer_sendmsg(int8_t sid, buffer_t *buf, const struct ns_msghdr
 
     /* Should have destination address by now */
     if (buf->dst_sa.addr_type == ADDR_NONE) {
-        return -5;
+        ret_val = -5;
+        goto fail;
     }
 
     switch (socket_ptr->type) {
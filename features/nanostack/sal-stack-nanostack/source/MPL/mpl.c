@@ -28,9 +28,11 @@
 #include "Core/include/ns_buffer.h"
 #include "NWK_INTERFACE/Include/protocol.h"
 #include "NWK_INTERFACE/Include/protocol_timer.h"
+#include "NWK_INTERFACE/Include/protocol_stats.h"
 #include "Common_Protocols/ipv6.h"
 #include "Common_Protocols/icmpv6.h"
 #include "Service_Libs/Trickle/trickle.h"
+#include "Service_Libs/fnv_hash/fnv_hash.h"
 #include "6LoWPAN/MAC/mac_helper.h"
 #include "6LoWPAN/Thread/thread_common.h"
 #include "6LoWPAN/ws/ws_common.h"
@@ -48,9 +50,17 @@
 #define MPL_SEED_64_BIT     2
 #define MPL_SEED_128_BIT    3
 
+#ifndef MAX_BUFFERED_MESSAGES_SIZE
 #define MAX_BUFFERED_MESSAGES_SIZE 2048
+#endif
 #define MAX_BUFFERED_MESSAGE_LIFETIME 600 // 1/10 s ticks
 
+/* Buckets in each domain's seed set hash - must be a power of 2 */
+#ifndef MPL_SEED_HASH_SIZE
+#define MPL_SEED_HASH_SIZE 8
+#endif
+NS_STATIC_ASSERT((MPL_SEED_HASH_SIZE & (MPL_SEED_HASH_SIZE - 1)) == 0, "MPL_SEED_HASH_SIZE must be a power of 2")
+
 static bool mpl_timer_running;
 static uint16_t mpl_total_buffered;
 
@@ -83,14 +93,18 @@ typedef struct mpl_data_message {
 
 typedef struct mpl_seed {
     ns_list_link_t link;
+    ns_list_link_t hash_link;
     bool colour;
     uint16_t lifetime;
     uint8_t min_sequence;
     uint8_t id_len;
     NS_LIST_HEAD(mpl_buffered_message_t, link) messages; /* sequence number order */
+    uint8_t buffered[32];   /* bit set for each sequence number in messages */
     uint8_t id[];
 } mpl_seed_t;
 
+typedef NS_LIST_HEAD(mpl_seed_t, hash_link) mpl_seed_hash_list_t;
+
 /* For simplicity, we assume each MPL domain is on exactly 1 interface */
 struct mpl_domain {
     protocol_interface_info_entry_t *interface;
@@ -100,6 +114,7 @@ struct mpl_domain {
     bool proactive_forwarding;
     uint16_t seed_set_entry_lifetime;
     NS_LIST_HEAD(mpl_seed_t, link) seeds;
+    mpl_seed_hash_list_t seed_hash[MPL_SEED_HASH_SIZE];
     trickle_t trickle;                      // Control timer
     trickle_params_t data_trickle_params;
     trickle_params_t control_trickle_params;
@@ -235,6 +250,9 @@ mpl_domain_t *mpl_domain_create(protocol_interface_info_entry_t *cur, const uint
     domain->sequence = randLIB_get_8bit();
     domain->colour = false;
     ns_list_init(&domain->seeds);
+    for (int i = 0; i < MPL_SEED_HASH_SIZE; i++) {
+        ns_list_init(&domain->seed_hash[i]);
+    }
     domain->proactive_forwarding = proactive_forwarding >= 0 ? proactive_forwarding
                                    : cur->mpl_proactive_forwarding;
     domain->seed_set_entry_lifetime = seed_set_entry_lifetime ? seed_set_entry_lifetime
@@ -313,9 +331,16 @@ static void mpl_domain_inconsistent(mpl_domain_t *domain)
     mpl_schedule_timer();
 }
 
-static mpl_seed_t *mpl_seed_lookup(const mpl_domain_t *domain, uint8_t id_len, const uint8_t *seed_id)
+static mpl_seed_hash_list_t *mpl_seed_hash_list(mpl_domain_t *domain, uint8_t id_len, const uint8_t *seed_id)
 {
-    ns_list_foreach(mpl_seed_t, seed, &domain->seeds) {
+    /* Seed ids mostly differ at the end, which the reverse hash takes first */
+    uint32_t hash = fnv_hash_1a_32_reverse_block(seed_id, id_len);
+    return &domain->seed_hash[hash & (MPL_SEED_HASH_SIZE - 1)];
+}
+
+static mpl_seed_t *mpl_seed_lookup(mpl_domain_t *domain, uint8_t id_len, const uint8_t *seed_id)
+{
+    ns_list_foreach(mpl_seed_t, seed, mpl_seed_hash_list(domain, id_len, seed_id)) {
         if (seed->id_len == id_len && memcmp(seed->id, seed_id, id_len) == 0) {
             return seed;
         }
@@ -336,8 +361,10 @@ static mpl_seed_t *mpl_seed_create(mpl_domain_t *domain, uint8_t id_len, const u
     seed->id_len = id_len;
     seed->colour = domain->colour;
     ns_list_init(&seed->messages);
+    memset(seed->buffered, 0, sizeof seed->buffered);
     memcpy(seed->id, seed_id, id_len);
     ns_list_add_to_end(&domain->seeds, seed);
+    ns_list_add_to_start(mpl_seed_hash_list(domain, id_len, seed_id), seed);
     return seed;
 }
 
@@ -347,6 +374,7 @@ static void mpl_seed_delete(mpl_domain_t *domain, mpl_seed_t *seed)
         mpl_buffer_delete(seed, message);
     }
     ns_list_remove(&domain->seeds, seed);
+    ns_list_remove(mpl_seed_hash_list(domain, seed->id_len, seed->id), seed);
     ns_dyn_mem_free(seed);
 }
 
@@ -362,6 +390,9 @@ static void mpl_seed_advance_min_sequence(mpl_seed_t *seed, uint8_t min_sequence
 
 static mpl_buffered_message_t *mpl_buffer_lookup(mpl_seed_t *seed, uint8_t sequence)
 {
+    if (!bit_test(seed->buffered, sequence)) {
+        return NULL;
+    }
     ns_list_foreach(mpl_buffered_message_t, message, &seed->messages) {
         if (mpl_buffer_sequence(message) == sequence) {
             return message;
@@ -370,7 +401,7 @@ static mpl_buffered_message_t *mpl_buffer_lookup(mpl_seed_t *seed, uint8_t seque
     return NULL;
 }
 
-static void mpl_free_space(void)
+static bool mpl_free_space(void)
 {
     mpl_seed_t *oldest_seed = NULL;
     mpl_buffered_message_t *oldest_message = NULL;
@@ -392,11 +423,13 @@ static void mpl_free_space(void)
     }
 
     if (!oldest_message) {
-        return;
+        return false;
     }
 
+    protocol_stats_update(STATS_MPL_BUFFER_EVICT, mpl_buffer_size(oldest_message));
     oldest_seed->min_sequence = mpl_buffer_sequence(oldest_message) + 1;
     mpl_buffer_delete(oldest_seed, oldest_message);
+    return true;
 }
 
 
@@ -406,7 +439,10 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
     uint16_t ip_len = buffer_data_length(buf);
 
     while (mpl_total_buffered + ip_len > MAX_BUFFERED_MESSAGES_SIZE) {
-        mpl_free_space();
+        if (!mpl_free_space()) {
+            tr_debug("MPL message too big to buffer: %"PRIu16, ip_len);
+            return NULL;
+        }
     }
 
     /* As we came in, message sequence was >= min_sequence, but mpl_free_space
@@ -455,7 +491,9 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
     if (!inserted) {
         ns_list_add_to_start(&seed->messages, message);
     }
+    bit_set(seed->buffered, sequence);
     mpl_total_buffered += ip_len;
+    protocol_stats_update(STATS_MPL_BUFFERED_BYTES, mpl_total_buffered);
 
     /* Does MPL spec intend this distinction between start and reset? */
     mpl_control_reset_or_start(domain);
@@ -466,6 +504,8 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
 static void mpl_buffer_delete(mpl_seed_t *seed, mpl_buffered_message_t *message)
 {
     mpl_total_buffered -= mpl_buffer_size(message);
+    protocol_stats_update(STATS_MPL_BUFFERED_BYTES, mpl_total_buffered);
+    bit_clear(seed->buffered, mpl_buffer_sequence(message));
     ns_list_remove(&seed->messages, message);
     ns_dyn_mem_free(message);
 }
@@ -902,12 +942,14 @@ bool mpl_forwarder_process_message(buffer_t *buf, mpl_domain_t *domain, bool see
     /* Drop old messages (sequence < MinSequence) */
     if (common_serial_number_greater_8(seed->min_sequence, sequence)) {
         tr_debug("Old MPL message %"PRIu8" < %"PRIu8, sequence, seed->min_sequence);
+        protocol_stats_update(STATS_MPL_DUPLICATE_DROP, 1);
         return false;
     }
 
     mpl_buffered_message_t *message = mpl_buffer_lookup(seed, sequence);
     if (message) {
         tr_debug("Repeated MPL message %"PRIu8, sequence);
+        protocol_stats_update(STATS_MPL_DUPLICATE_DROP, 1);
         trickle_consistent_heard(&message->trickle);
         return false;
     }
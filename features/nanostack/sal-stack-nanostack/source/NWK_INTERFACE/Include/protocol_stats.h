@@ -26,6 +26,9 @@ typedef enum {
     STATS_IP_CKSUM_ERROR,
     STATS_FRAG_RX_ERROR,
     STATS_FRAG_TX_ERROR,
+    STATS_FRAG_RX_TIMEOUT,
+    STATS_FRAG_RX_POOL_DROP,
+    STATS_FRAG_RX_POOL_USED,
     STATS_RPL_PARENT_CHANGE,
     STATS_RPL_ROUTELOOP,
     // RFC 6550 S18.5 stats
@@ -44,7 +47,10 @@ typedef enum {
     STATS_BUFFER_HEADROOM_FAIL,
     STATS_ETX_1ST_PARENT,
     STATS_ETX_2ND_PARENT,
-    STATS_AL_TX_QUEUE_SIZE
+    STATS_AL_TX_QUEUE_SIZE,
+    STATS_MPL_BUFFERED_BYTES,
+    STATS_MPL_BUFFER_EVICT,
+    STATS_MPL_DUPLICATE_DROP
 
 } nwk_stats_type_t;
 
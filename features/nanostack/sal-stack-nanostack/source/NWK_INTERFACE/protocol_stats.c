@@ -75,6 +75,21 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                 nwk_stats_ptr->frag_tx_errors++;
                 break;
 
+            case STATS_FRAG_RX_TIMEOUT:
+                nwk_stats_ptr->frag_rx_timeouts++;
+                break;
+
+            case STATS_FRAG_RX_POOL_DROP:
+                nwk_stats_ptr->frag_rx_pool_drops++;
+                break;
+
+            case STATS_FRAG_RX_POOL_USED:
+                nwk_stats_ptr->frag_rx_pool_used = update_val;
+                if (nwk_stats_ptr->frag_rx_pool_used > nwk_stats_ptr->frag_rx_pool_peak) {
+                    nwk_stats_ptr->frag_rx_pool_peak = nwk_stats_ptr->frag_rx_pool_used;
+                }
+                break;
+
             case STATS_RPL_PARENT_CHANGE:
                 nwk_stats_ptr->rpl_route_routecost_better_change++;
                 break;
@@ -152,6 +167,22 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                     nwk_stats_ptr->adapt_layer_tx_queue_peak = nwk_stats_ptr->adapt_layer_tx_queue_size;
                 }
                 break;
+
+            case STATS_MPL_BUFFERED_BYTES:
+                nwk_stats_ptr->mpl_buffered_bytes = update_val;
+                if (nwk_stats_ptr->mpl_buffered_bytes > nwk_stats_ptr->mpl_buffered_peak) {
+                    nwk_stats_ptr->mpl_buffered_peak = nwk_stats_ptr->mpl_buffered_bytes;
+                }
+                break;
+
+            case STATS_MPL_BUFFER_EVICT:
+                nwk_stats_ptr->mpl_evict_count++;
+                nwk_stats_ptr->mpl_evict_bytes += update_val;
+                break;
+
+            case STATS_MPL_DUPLICATE_DROP:
+                nwk_stats_ptr->mpl_duplicate_drop += update_val;
+                break;
         }
     }
 }
@@ -32,6 +32,28 @@ uint16_t tr51_calc_nearest_prime_number(uint16_t start_value);
  */
 int tr51_init_channel_table(int16_t *channel_table, int16_t number_of_channels);
 
+/**
+ * @brief Compute the whole unicast hopping sequence using tr51 channel function.
+ * @param channel_table Channel table.
+ * @param output_table Output hopping sequence table.
+ * @param mac MAC address of the node for which the sequence is calculated.
+ * @param number_of_channels Number of channels.
+ * @param excluded_channels Excluded channels.
+ * @return Number of channels in sequence.
+ */
+uint16_t tr51_get_uc_hopping_sequence(int16_t *channel_table, uint8_t *output_table, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels);
+
+/**
+ * @brief Compute the whole broadcast hopping sequence using tr51 channel function.
+ * @param channel_table Channel table.
+ * @param output_table Output hopping sequence table.
+ * @param bsi Broadcast schedule identifier of the node for which the sequence is calculated.
+ * @param number_of_channels Number of channels.
+ * @param excluded_channels Excluded channels.
+ * @return Number of channels in sequence.
+ */
+uint16_t tr51_get_bc_hopping_sequence(int16_t *channel_table, uint8_t *output_table, uint16_t bsi, int16_t number_of_channels, uint32_t *excluded_channels);
+
 /**
  * @brief Compute the unicast schedule channel index using tr51 channel function.
  * @param channel_table Channel table.
@@ -65,6 +87,16 @@ int32_t tr51_get_bc_channel_index(int16_t *channel_table, uint8_t *output_table,
  */
 int32_t dh1cf_get_uc_channel_index(uint16_t slot_number, uint8_t *mac, int16_t number_of_channels);
 
+/**
+ * @brief Compute the unicast schedule channel indexes of consecutive slots using direct hash channel function.
+ * @param first_slot Slot number of the first channel.
+ * @param mac MAC address of the node for which the indexes are calculated.
+ * @param number_of_channels Number of channels.
+ * @param sequence Output table of channel indexes.
+ * @param length Number of slots to calculate.
+ */
+void dh1cf_get_uc_channel_sequence(uint16_t first_slot, uint8_t *mac, int16_t number_of_channels, uint8_t *sequence, uint8_t length);
+
 /**
  * @brief Compute the broadcast schedule channel index using direct hash channel function.
  * @param slot_number Current slot number.
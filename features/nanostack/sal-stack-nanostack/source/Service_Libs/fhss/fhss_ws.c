@@ -79,6 +79,7 @@ struct ws_ie_t {
 };
 
 static int fhss_ws_manage_channel_table_allocation(fhss_structure_t *fhss_structure, uint16_t channel_count);
+static void fhss_ws_update_schedule_tables(fhss_structure_t *fhss_structure);
 static void fhss_event_timer_cb(int8_t timer_id, uint16_t slots);
 static void fhss_ws_update_uc_channel_callback(fhss_structure_t *fhss_structure);
 static void fhss_unicast_handler(const fhss_api_t *fhss_api, uint16_t delay);
@@ -160,6 +161,7 @@ fhss_structure_t *fhss_ws_enable(fhss_api_t *fhss_api, const fhss_ws_configurati
     fhss_ws_set_hop_count(fhss_struct, 0xff);
     fhss_struct->rx_channel = fhss_configuration->unicast_fixed_channel;
     fhss_struct->ws->min_synch_interval = DEFAULT_MIN_SYNCH_INTERVAL;
+    fhss_ws_update_schedule_tables(fhss_struct);
     ns_list_init(&fhss_struct->fhss_failed_tx_list);
     return fhss_struct;
 }
@@ -182,6 +184,25 @@ static int fhss_ws_manage_channel_table_allocation(fhss_structure_t *fhss_struct
     return 0;
 }
 
+/* Precompute the broadcast schedule and forget the cached neighbour hops, called whenever the channel plan changes.
+ * Without memory for the table the broadcast channels are computed on demand.
+ */
+static void fhss_ws_update_schedule_tables(fhss_structure_t *fhss_structure)
+{
+    memset(fhss_structure->ws->neighbor_hop_cache, 0, sizeof(fhss_structure->ws->neighbor_hop_cache));
+    ns_dyn_mem_free(fhss_structure->ws->tr51_bc_sequence);
+    fhss_structure->ws->tr51_bc_sequence = NULL;
+    if (fhss_structure->ws->fhss_configuration.ws_bc_channel_function != WS_TR51CF) {
+        return;
+    }
+    fhss_structure->ws->tr51_bc_sequence = ns_dyn_mem_alloc(fhss_structure->number_of_channels);
+    if (!fhss_structure->ws->tr51_bc_sequence) {
+        return;
+    }
+    memset(fhss_structure->ws->tr51_bc_sequence, 0, fhss_structure->number_of_channels);
+    tr51_get_bc_hopping_sequence(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_bc_sequence, fhss_structure->ws->fhss_configuration.bsi, fhss_structure->number_of_channels, NULL);
+}
+
 void fhss_set_txrx_slot_length(fhss_structure_t *fhss_structure)
 {
     // No broadcast schedule, no TX slots
@@ -233,7 +254,12 @@ static int32_t fhss_ws_calc_bc_channel(fhss_structure_t *fhss_structure)
 {
     int32_t next_channel = fhss_structure->ws->fhss_configuration.broadcast_fixed_channel;
 
-    if (fhss_structure->ws->fhss_configuration.ws_bc_channel_function == WS_TR51CF) {
+    if (fhss_structure->ws->fhss_configuration.ws_bc_channel_function == WS_TR51CF && fhss_structure->ws->tr51_bc_sequence && fhss_structure->ws->bc_slot < fhss_structure->number_of_channels) {
+        next_channel = fhss_structure->ws->tr51_bc_sequence[fhss_structure->ws->bc_slot];
+        if (++fhss_structure->ws->bc_slot == fhss_structure->number_of_channels) {
+            fhss_structure->ws->bc_slot = 0;
+        }
+    } else if (fhss_structure->ws->fhss_configuration.ws_bc_channel_function == WS_TR51CF) {
         next_channel = tr51_get_bc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, fhss_structure->ws->bc_slot, fhss_structure->ws->fhss_configuration.bsi, fhss_structure->number_of_channels, NULL);
         if (++fhss_structure->ws->bc_slot == fhss_structure->number_of_channels) {
             fhss_structure->ws->bc_slot = 0;
@@ -428,6 +454,49 @@ static uint16_t fhss_ws_calculate_destination_slot(fhss_ws_neighbor_timing_info_
     return (own_floor(((float)(US_TO_MS(tx_time - ufsi_timestamp) + dest_ms_since_seq_start) / dwell_time)) % seq_length);
 }
 
+static int32_t fhss_ws_get_neighbor_channel(fhss_structure_t *fhss_structure, fhss_ws_neighbor_timing_info_t *neighbor_timing_info, uint8_t *destination_address, uint16_t destination_slot)
+{
+    uint8_t channel_function = neighbor_timing_info->uc_timing_info.unicast_channel_function;
+    uint16_t number_of_channels = neighbor_timing_info->uc_channel_list.channel_count;
+    uint32_t seq_length = 0x10000;
+    if (channel_function == WS_TR51CF) {
+        number_of_channels = neighbor_timing_info->uc_timing_info.unicast_number_of_channels;
+        seq_length = number_of_channels;
+    }
+    fhss_ws_hop_cache_t *hop_cache = NULL;
+    for (uint8_t i = 0; i < WS_NEIGHBOR_HOP_CACHE_SIZE; i++) {
+        fhss_ws_hop_cache_t *cur = &fhss_structure->ws->neighbor_hop_cache[i];
+        if (cur->number_of_channels == number_of_channels && cur->channel_function == channel_function && !memcmp(cur->eui64, destination_address, 8)) {
+            uint32_t offset = (destination_slot + seq_length - cur->first_slot) % seq_length;
+            if (offset < WS_NEIGHBOR_HOP_CACHE_SLOTS) {
+                return cur->channel[offset];
+            }
+            hop_cache = cur;
+            break;
+        }
+    }
+    if (!hop_cache) {
+        hop_cache = &fhss_structure->ws->neighbor_hop_cache[fhss_structure->ws->neighbor_hop_cache_next];
+        if (++fhss_structure->ws->neighbor_hop_cache_next == WS_NEIGHBOR_HOP_CACHE_SIZE) {
+            fhss_structure->ws->neighbor_hop_cache_next = 0;
+        }
+        memcpy(hop_cache->eui64, destination_address, 8);
+        hop_cache->channel_function = channel_function;
+        hop_cache->number_of_channels = number_of_channels;
+    }
+    // Calculate the channels of the upcoming slots of the neighbour
+    hop_cache->first_slot = destination_slot;
+    if (channel_function == WS_TR51CF) {
+        tr51_get_uc_hopping_sequence(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_address, number_of_channels, NULL);
+        for (uint8_t i = 0; i < WS_NEIGHBOR_HOP_CACHE_SLOTS; i++) {
+            hop_cache->channel[i] = fhss_structure->ws->tr51_output_table[(destination_slot + i) % seq_length];
+        }
+    } else {
+        dh1cf_get_uc_channel_sequence(destination_slot, destination_address, number_of_channels, hop_cache->channel, WS_NEIGHBOR_HOP_CACHE_SLOTS);
+    }
+    return hop_cache->channel[0];
+}
+
 static uint32_t fhss_ws_get_sf_timeout_callback(fhss_structure_t *fhss_structure)
 {
     return MS_TO_US(fhss_structure->ws->fhss_configuration.fhss_uc_dwell_interval);
@@ -538,10 +607,8 @@ static int fhss_ws_tx_handle_callback(const fhss_api_t *api, bool is_broadcast_a
 
         uint16_t destination_slot = fhss_ws_calculate_destination_slot(neighbor_timing_info, tx_time);
         int32_t tx_channel = neighbor_timing_info->uc_timing_info.fixed_channel;
-        if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF) {
-            tx_channel = tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels, NULL);
-        } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF) {
-            tx_channel = dh1cf_get_uc_channel_index(destination_slot, destination_address, neighbor_timing_info->uc_channel_list.channel_count);
+        if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF || neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF) {
+            tx_channel = fhss_ws_get_neighbor_channel(fhss_structure, neighbor_timing_info, destination_address, destination_slot);
         } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_VENDOR_DEF_CF) {
             if (fhss_structure->ws->fhss_configuration.vendor_defined_cf) {
                 tx_channel = fhss_structure->ws->fhss_configuration.vendor_defined_cf(fhss_structure->fhss_api, fhss_structure->ws->bc_slot, destination_address, fhss_structure->ws->fhss_configuration.bsi, neighbor_timing_info->uc_timing_info.unicast_number_of_channels);
@@ -993,6 +1060,7 @@ int fhss_ws_configuration_set(fhss_structure_t *fhss_structure, const fhss_ws_co
     if (fhss_configuration->ws_uc_channel_function == WS_FIXED_CHANNEL) {
         fhss_structure->rx_channel = fhss_configuration->unicast_fixed_channel;
     }
+    fhss_ws_update_schedule_tables(fhss_structure);
     platform_exit_critical();
     tr_info("fhss Configuration set, UC channel: %d, BC channel: %d, UC CF: %d, BC CF: %d, channels: BC %d UC %d, uc dwell: %d, bc dwell: %d, bc interval: %"PRIu32", bsi:%d",
             fhss_structure->ws->fhss_configuration.unicast_fixed_channel,
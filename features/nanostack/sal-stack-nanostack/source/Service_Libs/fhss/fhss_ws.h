@@ -31,8 +31,20 @@
 #define SYNCH_COMPENSATION_MIN_INTERVAL 60
 // MAX compensation per received synchronization info in ns
 #define MAX_DRIFT_COMPENSATION_STEP     10
+// Number of neighbours whose upcoming unicast channels are cached
+#define WS_NEIGHBOR_HOP_CACHE_SIZE      4
+// Number of upcoming unicast slots cached per neighbour
+#define WS_NEIGHBOR_HOP_CACHE_SLOTS     8
 typedef struct fhss_ws fhss_ws_t;
 
+typedef struct fhss_ws_hop_cache {
+    uint8_t eui64[8];
+    uint8_t channel_function;
+    uint16_t number_of_channels;
+    uint16_t first_slot;
+    uint8_t channel[WS_NEIGHBOR_HOP_CACHE_SLOTS];
+} fhss_ws_hop_cache_t;
+
 struct fhss_ws {
     uint8_t bc_channel;
     uint16_t uc_slot;
@@ -44,6 +56,9 @@ struct fhss_ws {
     int32_t drift_per_millisecond_ns;
     int16_t *tr51_channel_table;
     uint8_t *tr51_output_table;
+    uint8_t *tr51_bc_sequence;
+    uint8_t neighbor_hop_cache_next;
+    fhss_ws_hop_cache_t neighbor_hop_cache[WS_NEIGHBOR_HOP_CACHE_SIZE];
     bool unicast_timer_running;
     bool is_on_bc_channel;
     struct fhss_ws_configuration fhss_configuration;
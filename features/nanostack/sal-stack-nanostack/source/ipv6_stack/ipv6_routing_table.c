@@ -43,6 +43,7 @@
 #include "Common_Protocols/icmpv6.h"
 #include "nsdynmemLIB.h"
 #include "Service_Libs/etx/etx.h"
+#include "Service_Libs/fnv_hash/fnv_hash.h"
 #include "Common_Protocols/ipv6_resolution.h"
 #include <stdarg.h>
 #include <stdio.h>
@@ -65,6 +66,11 @@
 #define DCACHE_MAX_ABSOLUTE     64 /* Never have more than this */
 #define DCACHE_GC_AGE           (30 * DCACHE_GC_PERIOD)    /* 10 minutes */
 
+/* Number of hash buckets indexing the Destination Cache */
+#ifndef DCACHE_HASH_SIZE
+#define DCACHE_HASH_SIZE        32
+#endif
+
 typedef struct destination_cache_configuration_s {
     uint16_t max_entries;  // Never have more than this
     uint16_t short_term_entries; // Expire stale entries if more than this
@@ -93,10 +99,18 @@ static neighbour_cache_config_t neighbour_cache_config = {NCACHE_MAX_ABSOLUTE, N
 static NS_LIST_DEFINE(ipv6_destination_cache, ipv6_destination_t, link);
 static NS_LIST_DEFINE(ipv6_routing_table, ipv6_route_t, link);
 
+/* The caches are kept in most-recently-used-first lists for garbage
+ * collection, and indexed by a hash of the IP address for look-ups. */
+static ipv6_destination_t *ipv6_destination_hash[DCACHE_HASH_SIZE];
+
+static ipv6_cache_lookup_stats_t ncache_stats;
+static ipv6_cache_lookup_stats_t dcache_stats;
+
 static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id);
 static void ipv6_destination_cache_forget_router(ipv6_neighbour_cache_t *cache, const uint8_t neighbour_addr[16]);
 static void ipv6_destination_cache_forget_neighbour(const ipv6_neighbour_t *neighbour);
 static void ipv6_destination_release(ipv6_destination_t *dest);
+static void ipv6_destination_cache_remove(ipv6_destination_t *dest);
 static void ipv6_route_table_remove_router(int8_t interface_id, const uint8_t *addr, ipv6_route_src_t source);
 static uint16_t total_metric(const ipv6_route_t *route);
 static uint8_t ipv6_route_table_count_source(int8_t interface_id, ipv6_route_src_t source);
@@ -105,6 +119,33 @@ static uint8_t ipv6_route_table_get_max_entries(int8_t interface_id, ipv6_route_
 
 static uint16_t dcache_gc_timer;
 
+static uint_fast16_t ipv6_address_hash(const uint8_t address[static 16], uint_fast16_t size)
+{
+    /* Low-order bytes vary most, so hash from the end */
+    return fnv_hash_1a_32_reverse_block(address, 16) % size;
+}
+
+static void ipv6_neighbour_hash_add(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    ipv6_neighbour_t **bucket = &cache->hash[ipv6_address_hash(entry->ip_address, NCACHE_HASH_SIZE)];
+
+    entry->hash_next = *bucket;
+    *bucket = entry;
+}
+
+static void ipv6_neighbour_hash_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    ipv6_neighbour_t **p = &cache->hash[ipv6_address_hash(entry->ip_address, NCACHE_HASH_SIZE)];
+
+    while (*p) {
+        if (*p == entry) {
+            *p = entry->hash_next;
+            return;
+        }
+        p = &(*p)->hash_next;
+    }
+}
+
 static uint32_t next_probe_time(ipv6_neighbour_cache_t *cache, uint_fast8_t retrans_num)
 {
     uint32_t t = cache->retrans_timer;
@@ -220,6 +261,7 @@ void ipv6_neighbour_cache_init(ipv6_neighbour_cache_t *cache, int8_t interface_i
     ns_list_foreach_safe(ipv6_neighbour_t, cur, &cache->list) {
         ipv6_neighbour_entry_remove(cache, cur);
     }
+    memset(cache->hash, 0, sizeof(cache->hash));
     cache->gc_timer = NCACHE_GC_PERIOD;
     cache->retrans_timer = 1000;
     cache->max_ll_len = 0;
@@ -245,14 +287,56 @@ void ipv6_neighbour_cache_flush(ipv6_neighbour_cache_t *cache)
 }
 
 
-ipv6_neighbour_t *ipv6_neighbour_lookup(ipv6_neighbour_cache_t *cache, const uint8_t *address)
+/* Call after changing the IP address of entries in place */
+void ipv6_neighbour_cache_rehash(ipv6_neighbour_cache_t *cache)
 {
+    memset(cache->hash, 0, sizeof(cache->hash));
     ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+        ipv6_neighbour_hash_add(cache, cur);
+    }
+}
+
+/* Shrink the cache under memory pressure, dropping least recently used entries first */
+void ipv6_neighbour_cache_forced_gc(ipv6_neighbour_cache_t *cache, bool full_gc)
+{
+    uint_fast16_t gc_count = 0;
+    ns_list_foreach(ipv6_neighbour_t, entry, &cache->list) {
+        if (entry->type == IP_NEIGHBOUR_GARBAGE_COLLECTIBLE) {
+            gc_count++;
+        }
+    }
+
+    /* Registered entries stay, they are the state of 6LoWPAN-ND hosts */
+    ns_list_foreach_reverse_safe(ipv6_neighbour_t, entry, &cache->list) {
+        if (!full_gc && gc_count <= neighbour_cache_config.long_term_entries) {
+            break;
+        }
+        if (entry->type == IP_NEIGHBOUR_GARBAGE_COLLECTIBLE) {
+            ipv6_neighbour_entry_remove(cache, entry);
+            ncache_stats.evictions++;
+            gc_count--;
+        }
+    }
+}
+
+const ipv6_cache_lookup_stats_t *ipv6_neighbour_cache_lookup_stats(void)
+{
+    return &ncache_stats;
+}
+
+ipv6_neighbour_t *ipv6_neighbour_lookup(ipv6_neighbour_cache_t *cache, const uint8_t *address)
+{
+    ipv6_neighbour_t *cur = cache->hash[ipv6_address_hash(address, NCACHE_HASH_SIZE)];
+
+    ncache_stats.lookups++;
+    for (; cur; cur = cur->hash_next) {
+        ncache_stats.probes++;
         if (addr_ipv6_equal(cur->ip_address, address)) {
             return cur;
         }
     }
 
+    ncache_stats.misses++;
     return NULL;
 }
 
@@ -274,6 +358,7 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
      * the entry.
      */
     ns_list_remove(&cache->list, entry);
+    ipv6_neighbour_hash_remove(cache, entry);
     switch (entry->state) {
         case IP_NEIGHBOUR_NEW:
             break;
@@ -302,28 +387,28 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
 ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache, const uint8_t *address/*, bool tentative*/)
 {
     uint_fast16_t count = 0;
-    ipv6_neighbour_t *entry = NULL;
+    ipv6_neighbour_t *entry = ipv6_neighbour_lookup(cache, address);
     ipv6_neighbour_t *garbage_possible_entry = NULL;
 
-    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+    if (entry) {
+        if (entry != ns_list_get_first(&cache->list)) {
+            ns_list_remove(&cache->list, entry);
+            ns_list_add_to_start(&cache->list, entry);
+        }
+        return entry;
+    }
 
+    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
         if (cur->type == IP_NEIGHBOUR_GARBAGE_COLLECTIBLE) {
             garbage_possible_entry = cur;
             count++;
         }
-
-        if (addr_ipv6_equal(cur->ip_address, address)) {
-            if (cur != ns_list_get_first(&cache->list)) {
-                ns_list_remove(&cache->list, cur);
-                ns_list_add_to_start(&cache->list, cur);
-            }
-            return cur;
-        }
     }
 
     if (count >= neighbour_cache_config.max_entries && garbage_possible_entry) {
         //Remove Last storaged IP_NEIGHBOUR_GARBAGE_COLLECTIBLE type entry
         ipv6_neighbour_entry_remove(cache, garbage_possible_entry);
+        ncache_stats.evictions++;
     }
 
     // Allocate new - note we have a basic size, plus enough for the LL address,
@@ -354,6 +439,7 @@ ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache,
     }
 
     ns_list_add_to_start(&cache->list, entry);
+    ipv6_neighbour_hash_add(cache, entry);
 
     return entry;
 }
@@ -875,29 +961,45 @@ void ipv6_destination_cache_print(route_print_fn_t *print_fn)
     }
 }
 
-static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id)
+const ipv6_cache_lookup_stats_t *ipv6_destination_cache_lookup_stats(void)
 {
-    bool is_ll = addr_is_ipv6_link_local(address);
+    return &dcache_stats;
+}
 
-    if (is_ll && interface_id == -1) {
-        return NULL;
-    }
+/* Hash look-up, comparing the interface ID too if interface_specific */
+static ipv6_destination_t *ipv6_destination_hash_lookup(const uint8_t *address, int8_t interface_id, bool interface_specific)
+{
+    ipv6_destination_t *cur = ipv6_destination_hash[ipv6_address_hash(address, DCACHE_HASH_SIZE)];
 
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
+    dcache_stats.lookups++;
+    for (; cur; cur = cur->hash_next) {
+        dcache_stats.probes++;
         if (!addr_ipv6_equal(cur->destination, address)) {
             continue;
         }
-        /* For LL addresses, interface ID must also be compared */
-        if (is_ll && cur->interface_id != interface_id) {
+        if (interface_specific && cur->interface_id != interface_id) {
             continue;
         }
 
         return cur;
     }
 
+    dcache_stats.misses++;
     return NULL;
 }
 
+static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id)
+{
+    bool is_ll = addr_is_ipv6_link_local(address);
+
+    if (is_ll && interface_id == -1) {
+        return NULL;
+    }
+
+    /* For LL addresses, interface ID must also be compared */
+    return ipv6_destination_hash_lookup(address, interface_id, is_ll);
+}
+
 /* Unlike original version, this does NOT perform routing check - it's pure destination cache look-up
  *
  * We no longer attempt to cache route lookups in the destination cache, as
@@ -912,8 +1014,7 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
  */
 ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, int8_t interface_id)
 {
-    uint_fast16_t count = 0;
-    ipv6_destination_t *entry = NULL;
+    ipv6_destination_t *entry;
     bool interface_specific = addr_ipv6_scope(address, NULL) <= IPV6_SCOPE_REALM_LOCAL;
 
     if (interface_specific && interface_id == -1) {
@@ -921,26 +1022,13 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
     }
 
     /* Find any existing entry */
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
-        count++;
-        if (!addr_ipv6_equal(cur->destination, address)) {
-            continue;
-        }
-        /* For LL addresses, interface ID must also be compared */
-        if (interface_specific && cur->interface_id != interface_id) {
-            continue;
-        }
-
-        entry = cur;
-        break;
-    }
-
+    entry = ipv6_destination_hash_lookup(address, interface_id, interface_specific);
 
     if (!entry) {
-        if (count > destination_cache_config.max_entries) {
-            entry = ns_list_get_last(&ipv6_destination_cache);
-            ns_list_remove(&ipv6_destination_cache, entry);
-            ipv6_destination_release(entry);
+        if (ns_list_count(&ipv6_destination_cache) > destination_cache_config.max_entries) {
+            /* Least recently used goes */
+            ipv6_destination_cache_remove(ns_list_get_last(&ipv6_destination_cache));
+            dcache_stats.evictions++;
         }
 
         /* If no entry, make one */
@@ -967,6 +1055,9 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
             entry->interface_id = -1;
         }
         ns_list_add_to_start(&ipv6_destination_cache, entry);
+        ipv6_destination_t **bucket = &ipv6_destination_hash[ipv6_address_hash(address, DCACHE_HASH_SIZE)];
+        entry->hash_next = *bucket;
+        *bucket = entry;
     } else if (entry != ns_list_get_first(&ipv6_destination_cache)) {
         /* If there was an entry, and it wasn't at the start, move it */
         ns_list_remove(&ipv6_destination_cache, entry);
@@ -1082,8 +1173,8 @@ void ipv6_destination_cache_forced_gc(bool full_gc)
      **/
     ns_list_foreach_reverse_safe(ipv6_destination_t, entry, &ipv6_destination_cache) {
         if (entry->lifetime == 0 || gc_count > destination_cache_config.long_term_entries || full_gc) {
-            ns_list_remove(&ipv6_destination_cache, entry);
-            ipv6_destination_release(entry);
+            ipv6_destination_cache_remove(entry);
+            dcache_stats.evictions++;
             gc_count--;
         }
     }
@@ -1096,6 +1187,23 @@ static void ipv6_destination_release(ipv6_destination_t *dest)
     }
 }
 
+/* Take the entry out of the list and the hash, it is freed once unreferenced */
+static void ipv6_destination_cache_remove(ipv6_destination_t *dest)
+{
+    ipv6_destination_t **p = &ipv6_destination_hash[ipv6_address_hash(dest->destination, DCACHE_HASH_SIZE)];
+
+    while (*p) {
+        if (*p == dest) {
+            *p = dest->hash_next;
+            break;
+        }
+        p = &(*p)->hash_next;
+    }
+
+    ns_list_remove(&ipv6_destination_cache, dest);
+    ipv6_destination_release(dest);
+}
+
 static void ipv6_destination_cache_gc_periodic(void)
 {
     uint_fast16_t gc_count = 0;
@@ -1137,8 +1245,7 @@ static void ipv6_destination_cache_gc_periodic(void)
      */
     ns_list_foreach_reverse_safe(ipv6_destination_t, entry, &ipv6_destination_cache) {
         if (entry->lifetime == 0 || gc_count > destination_cache_config.short_term_entries) {
-            ns_list_remove(&ipv6_destination_cache, entry);
-            ipv6_destination_release(entry);
+            ipv6_destination_cache_remove(entry);
             if (--gc_count <= destination_cache_config.long_term_entries) {
                 break;
             }
@@ -41,6 +41,11 @@
 
 #define IPV6_ROUTE_DEFAULT_METRIC           128
 
+/* Number of hash buckets indexing the Neighbour Cache of each interface */
+#ifndef NCACHE_HASH_SIZE
+#define NCACHE_HASH_SIZE                    16
+#endif
+
 /* XXX in the process of renaming this - it's really specifically the
  * IP Neighbour Cache  but was initially called a routing table */
 
@@ -101,6 +106,7 @@ typedef struct ipv6_neighbour {
     uint32_t                        timer;                      /* 100ms ticks */
     uint32_t                        lifetime;                   /* seconds */
     ns_list_link_t                  link;                       /*!< List link */
+    struct ipv6_neighbour           *hash_next;                 /*!< Next entry in the same hash bucket */
     NS_LIST_HEAD_INCOMPLETE(struct buffer) queue;
     uint8_t                         ll_address[];
 } ipv6_neighbour_t;
@@ -135,8 +141,17 @@ typedef struct ipv6_neighbour_cache {
     ipv6_route_interface_info_t             route_if_info;
     //uint8_t                                   num_entries;
     NS_LIST_HEAD(ipv6_neighbour_t, link)    list;
+    ipv6_neighbour_t                        *hash[NCACHE_HASH_SIZE]; // index of list by IP address
 } ipv6_neighbour_cache_t;
 
+/* Look-up statistics of the Neighbour Cache (all interfaces) or the Destination Cache */
+typedef struct ipv6_cache_lookup_stats {
+    uint32_t                                lookups;    // look-ups by address
+    uint32_t                                misses;     // look-ups finding no entry
+    uint32_t                                probes;     // entries compared, probes / lookups is the average chain length
+    uint32_t                                evictions;  // entries discarded to make room or under memory pressure
+} ipv6_cache_lookup_stats_t;
+
 /* Macros for formatting ipv6 addresses into strings for route printing. */
 /* Initialize a string buffer for the ipv6 address */
 #define ROUTE_PRINT_ADDR_STR_BUFFER_INIT(str) char str[41] = "<null>"
@@ -148,6 +163,9 @@ typedef void (route_print_fn_t)(const char *fmt, ...);
 
 extern void ipv6_neighbour_cache_init(ipv6_neighbour_cache_t *cache, int8_t interface_id);
 extern void ipv6_neighbour_cache_flush(ipv6_neighbour_cache_t *cache);
+extern void ipv6_neighbour_cache_rehash(ipv6_neighbour_cache_t *cache);
+extern void ipv6_neighbour_cache_forced_gc(ipv6_neighbour_cache_t *cache, bool full_gc);
+extern const ipv6_cache_lookup_stats_t *ipv6_neighbour_cache_lookup_stats(void);
 extern ipv6_neighbour_t *ipv6_neighbour_update(ipv6_neighbour_cache_t *cache, const uint8_t *address, bool solicited);
 extern void ipv6_neighbour_set_state(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry, ip_neighbour_cache_state_t state);
 extern ipv6_neighbour_t *ipv6_neighbour_used(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry);
@@ -207,6 +225,7 @@ typedef struct ipv6_destination {
 #endif
     ipv6_neighbour_t                *last_neighbour;    // last neighbour used (only for reachability confirmation)
     ns_list_link_t                  link;
+    struct ipv6_destination         *hash_next;         // next entry in the same hash bucket
 } ipv6_destination_t;
 
 #ifndef NO_IPV6_PMTUD
@@ -223,6 +242,7 @@ void ipv6_destination_cache_timer(uint8_t ticks);
 void ipv6_destination_redirect(const uint8_t *dest_addr, const uint8_t *sender_addr, const uint8_t *redirect_addr, int8_t interface_id, addrtype_t ll_type, const uint8_t *ll_address);
 #endif
 void ipv6_destination_cache_forced_gc(bool full_gc);
+const ipv6_cache_lookup_stats_t *ipv6_destination_cache_lookup_stats(void);
 
 /* Combined Routing Table (RFC 4191) and Prefix List (RFC 4861) */
 /* On-link prefixes have the on_link flag set and next_hop is unset */
@@ -517,6 +517,56 @@ int16_t socket_sendmsg(int8_t socket, const ns_msghdr_t *msg, int flags)
     return socket_buffer_sendmsg(socket, NULL, msg, flags);
 }
 
+ns_socket_buffer_t *socket_buffer_allocate(uint16_t length)
+{
+    buffer_t *buf = buffer_get_specific(BUFFER_SOCKET_HEADROOM, length, 0);
+    if (buf) {
+        buffer_data_length_set(buf, length);
+    }
+
+    return buf;
+}
+
+uint8_t *socket_buffer_data(ns_socket_buffer_t *buf)
+{
+    return buffer_data_pointer(buf);
+}
+
+uint16_t socket_buffer_length(const ns_socket_buffer_t *buf)
+{
+    return buffer_data_length(buf);
+}
+
+int8_t socket_buffer_length_set(ns_socket_buffer_t *buf, uint16_t length)
+{
+    if (length > buf->size - buf->buf_ptr) {
+        return -1;
+    }
+
+    buffer_data_length_set(buf, length);
+    return 0;
+}
+
+void socket_buffer_free(ns_socket_buffer_t *buf)
+{
+    buffer_free(buf);
+}
+
+int16_t socket_sendmsg_buffer(int8_t socket, ns_socket_buffer_t *buf, const ns_msghdr_t *msg, int flags)
+{
+    if (!buf) {
+        return -1;
+    }
+
+    socket_t *socket_ptr = socket_pointer_get(socket);
+    if (socket_ptr && socket_ptr->type == SOCKET_TYPE_STREAM) {
+        buffer_free(buf);
+        return -1;
+    }
+
+    return socket_buffer_sendmsg(socket, buf, msg, flags);
+}
+
 int16_t socket_sendto(int8_t socket, const ns_address_t *address, const void *buffer, uint16_t length)
 {
     ns_iovec_t data_vector;
@@ -71,6 +71,86 @@ int DTLSSocketWrapper::timing_get_delay(void *ctx)
     }
 }
 
+nsapi_error_t DTLSSocketWrapper::setsockopt(int level, int optname, const void *optval, unsigned optlen)
+{
+    if (level != NSAPI_TLSSOCKET_LEVEL || optname != NSAPI_TLSSOCKET_DTLS_CID) {
+        return TLSSocketWrapper::setsockopt(level, optname, optval, optlen);
+    }
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    if (optlen > MBEDTLS_SSL_CID_IN_LEN_MAX || (optlen && !optval)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (is_handshake_started()) {
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+
+    // Records from the server carry this many bytes of Connection ID
+    if (mbedtls_ssl_conf_cid(get_ssl_config(), optlen, MBEDTLS_SSL_UNEXPECTED_CID_IGNORE) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (optlen) {
+        memcpy(_own_cid, optval, optlen);
+    }
+    _own_cid_len = optlen;
+    _cid_enabled = true;
+    return NSAPI_ERROR_OK;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_error_t DTLSSocketWrapper::getsockopt(int level, int optname, void *optval, unsigned *optlen)
+{
+    if (level != NSAPI_TLSSOCKET_LEVEL || (optname != NSAPI_TLSSOCKET_DTLS_CID && optname != NSAPI_TLSSOCKET_DTLS_PEER_CID)) {
+        return TLSSocketWrapper::getsockopt(level, optname, optval, optlen);
+    }
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    if (!optval || !optlen) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    int enabled;
+    unsigned char peer_cid[MBEDTLS_SSL_CID_OUT_LEN_MAX];
+    size_t peer_cid_len;
+    if (get_ssl_context()->state != MBEDTLS_SSL_HANDSHAKE_OVER ||
+            mbedtls_ssl_get_peer_cid(get_ssl_context(), &enabled, peer_cid, &peer_cid_len) != 0) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    if (optname == NSAPI_TLSSOCKET_DTLS_CID) {
+        if (*optlen < sizeof(int)) {
+            return NSAPI_ERROR_PARAMETER;
+        }
+        *static_cast<int *>(optval) = enabled == MBEDTLS_SSL_CID_ENABLED;
+        *optlen = sizeof(int);
+    } else {
+        if (enabled != MBEDTLS_SSL_CID_ENABLED) {
+            peer_cid_len = 0;
+        }
+        if (*optlen < peer_cid_len) {
+            return NSAPI_ERROR_PARAMETER;
+        }
+        memcpy(optval, peer_cid, peer_cid_len);
+        *optlen = peer_cid_len;
+    }
+    return NSAPI_ERROR_OK;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+int DTLSSocketWrapper::configure_ssl_context()
+{
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    if (_cid_enabled) {
+        return mbedtls_ssl_set_cid(get_ssl_context(), MBEDTLS_SSL_CID_ENABLED, _own_cid, _own_cid_len);
+    }
+#endif
+    return 0;
+}
+
 void DTLSSocketWrapper::timer_event(void)
 {
     _timer_expired = true;
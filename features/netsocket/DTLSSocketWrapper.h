@@ -39,6 +39,55 @@ public:
      * @param control      Transport control mode. See @ref control_transport.
      */
     DTLSSocketWrapper(Socket *transport, const char *hostname = NULL, control_transport control = TRANSPORT_CONNECT_AND_CLOSE);
+
+    /** Set socket options.
+     *
+     *  Besides the options of the transport, handles the DTLS Connection ID
+     *  (RFC 9146) options of level NSAPI_TLSSOCKET_LEVEL. With Connection IDs
+     *  in use, records name the connection they belong to, so the server
+     *  keeps the session when a NAT gives the device a new address.
+     *
+     *  NSAPI_TLSSOCKET_DTLS_CID takes the Connection ID, up to
+     *  MBEDTLS_SSL_CID_IN_LEN_MAX bytes, that the server should send with.
+     *  It may be empty, as a client that stays reachable only needs the
+     *  server's. Must be set before calling connect().
+     *
+     *  @note Needs MBEDTLS_SSL_DTLS_CONNECTION_ID in the Mbed TLS configuration.
+     *
+     *  @param level    Stack level, see @ref nsapi_socket_level_t.
+     *  @param optname  Option name.
+     *  @param optval   Option value.
+     *  @param optlen   Length of the option value.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if Mbed TLS was built without Connection IDs.
+     *  @retval         NSAPI_ERROR_PARAMETER if the Connection ID is too long.
+     *  @retval         NSAPI_ERROR_IS_CONNECTED if the handshake has already started.
+     *  @retval         int Other error codes from the transport, see @ref Socket::setsockopt.
+     */
+    nsapi_error_t setsockopt(int level, int optname, const void *optval, unsigned optlen) override;
+
+    /** Get socket options.
+     *
+     *  Besides the options of the transport, NSAPI_TLSSOCKET_DTLS_CID gets an
+     *  int telling whether the handshake negotiated Connection IDs, and
+     *  NSAPI_TLSSOCKET_DTLS_PEER_CID gets the Connection ID the server asked
+     *  to be sent with.
+     *
+     *  @param level    Stack level, see @ref nsapi_socket_level_t.
+     *  @param optname  Option name.
+     *  @param optval   Destination for option value.
+     *  @param optlen   Length of the option value, updated to the length written.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if Mbed TLS was built without Connection IDs.
+     *  @retval         NSAPI_ERROR_NO_CONNECTION if the handshake hasn't completed.
+     *  @retval         NSAPI_ERROR_PARAMETER if the buffer is too small.
+     *  @retval         int Other error codes from the transport, see @ref Socket::getsockopt.
+     */
+    nsapi_error_t getsockopt(int level, int optname, void *optval, unsigned *optlen) override;
+
+protected:
+    int configure_ssl_context() override;
+
 private:
     static void timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms);
     static int timing_get_delay(void *ctx);
@@ -46,6 +95,11 @@ private:
     uint64_t _int_ms_tick = 0;
     int _timer_event_id = 0;
     bool _timer_expired = false;
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    unsigned char _own_cid[MBEDTLS_SSL_CID_IN_LEN_MAX];
+    uint8_t _own_cid_len = 0;
+    bool _cid_enabled = false;
+#endif
 };
 
 #endif
@@ -55,6 +55,32 @@ public:
     //typedef void (*emac_link_state_change_fn)(void *data, bool up);
     typedef mbed::Callback<void (bool up)> emac_link_state_change_cb_t;
 
+    /**
+     * Hardware features an EMAC may offer, as reported by get_capabilities()
+     *
+     * Transmit checksum flags mean the hardware computes and inserts the checksum,
+     * working correctly when the stack leaves the field zero. Receive checksum flags
+     * mean the hardware verifies the checksum and drops packets where it is wrong.
+     * TCP and UDP flags cover both IPv4 and IPv6. Hardware generally can't checksum
+     * the payload of IP fragments, so stacks may keep doing that in software for
+     * protocols whose datagrams they fragment or reassemble.
+     */
+    enum capability {
+        CAPABILITY_TX_CHECKSUM_IPV4  = 0x00001, /**< Inserts IPv4 header checksums */
+        CAPABILITY_TX_CHECKSUM_UDP   = 0x00002, /**< Inserts UDP checksums */
+        CAPABILITY_TX_CHECKSUM_TCP   = 0x00004, /**< Inserts TCP checksums */
+        CAPABILITY_TX_CHECKSUM_ICMP  = 0x00008, /**< Inserts ICMPv4 checksums */
+        CAPABILITY_TX_CHECKSUM_ICMP6 = 0x00010, /**< Inserts ICMPv6 checksums */
+        CAPABILITY_RX_CHECKSUM_IPV4  = 0x00100, /**< Verifies IPv4 header checksums */
+        CAPABILITY_RX_CHECKSUM_UDP   = 0x00200, /**< Verifies UDP checksums */
+        CAPABILITY_RX_CHECKSUM_TCP   = 0x00400, /**< Verifies TCP checksums */
+        CAPABILITY_RX_CHECKSUM_ICMP  = 0x00800, /**< Verifies ICMPv4 checksums */
+        CAPABILITY_RX_CHECKSUM_ICMP6 = 0x01000, /**< Verifies ICMPv6 checksums */
+        CAPABILITY_VLAN              = 0x10000, /**< Inserts and strips IEEE 802.1Q VLAN tags */
+        CAPABILITY_HW_TIMESTAMP      = 0x20000, /**< Timestamps packets in hardware */
+        CAPABILITY_TX_BATCH          = 0x40000, /**< link_out_batch() starts transmission once per batch */
+    };
+
     /**
      * Return maximum transmission unit
      *
@@ -72,6 +98,18 @@ public:
      */
     virtual uint32_t get_align_preference() const = 0;
 
+    /**
+     * Return hardware capabilities
+     *
+     * Called after power_up(), so a driver may report what it found enabled.
+     *
+     * @return     Bitmap of capability flags, 0 if none are supported
+     */
+    virtual uint32_t get_capabilities() const
+    {
+        return 0;
+    }
+
     /**
      * Return interface name
      *
@@ -124,6 +162,32 @@ public:
      */
     virtual bool link_out(emac_mem_buf_t *buf) = 0;
 
+    /**
+     * Sends a batch of packets over the link
+     *
+     * Lets a driver queue all the packets before starting the hardware once,
+     * rather than once per packet. The EMAC takes ownership of every buffer,
+     * as with link_out(), whether or not it is sent. The default implementation
+     * calls link_out() for each packet in turn; drivers overriding it should
+     * report CAPABILITY_TX_BATCH so stacks know batching is worthwhile.
+     *
+     * That can not be called from an interrupt context.
+     *
+     * @param bufs  Packets to be sent, which the EMAC may overwrite
+     * @param count Number of packets
+     * @return      Number of packets sent successfully
+     */
+    virtual uint32_t link_out_batch(emac_mem_buf_t **bufs, uint32_t count)
+    {
+        uint32_t sent = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (link_out(bufs[i])) {
+                sent++;
+            }
+        }
+        return sent;
+    }
+
     /**
      * Initializes the HW
      *
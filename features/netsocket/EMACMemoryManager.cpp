@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EMACMemoryManager.h"
+
+EMACRxRing::EMACRxRing(emac_mem_buf_t **slots, uint32_t len) :
+    _slots(slots), _len(len), _refill_idx(0), _buf_size(0), _align(0), _mem_mngr(NULL), _stats()
+{
+    for (uint32_t i = 0; i < _len; i++) {
+        _slots[i] = NULL;
+    }
+}
+
+emac_mem_buf_t *EMACRxRing::alloc()
+{
+    emac_mem_buf_t *buf = _mem_mngr->alloc_heap(_buf_size, _align);
+    if (buf) {
+        _stats.replenished++;
+    } else {
+        _stats.starved++;
+    }
+    return buf;
+}
+
+bool EMACRxRing::init(EMACMemoryManager &mem_mngr, uint32_t size, uint32_t align)
+{
+    _mem_mngr = &mem_mngr;
+    _buf_size = size;
+    _align = align;
+    _refill_idx = 0;
+
+    for (uint32_t i = 0; i < _len; i++) {
+        if (!_slots[i]) {
+            _slots[i] = alloc();
+            if (!_slots[i]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void EMACRxRing::deinit()
+{
+    for (uint32_t i = 0; i < _len; i++) {
+        if (_slots[i]) {
+            _mem_mngr->free(_slots[i]);
+            _slots[i] = NULL;
+        }
+    }
+}
+
+void *EMACRxRing::get_ptr(uint32_t idx) const
+{
+    return _slots[idx] ? _mem_mngr->get_ptr(_slots[idx]) : NULL;
+}
+
+emac_mem_buf_t *EMACRxRing::take(uint32_t idx, uint32_t len)
+{
+    emac_mem_buf_t *buf = _slots[idx];
+    if (!buf) {
+        return NULL;
+    }
+
+    _slots[idx] = NULL;
+    _mem_mngr->set_len(buf, len);
+    _stats.received++;
+    return buf;
+}
+
+emac_mem_buf_t *EMACRxRing::swap(uint32_t idx, uint32_t len)
+{
+    emac_mem_buf_t *new_buf = alloc();
+    if (!new_buf) {
+        _stats.dropped++;
+        return NULL;
+    }
+
+    emac_mem_buf_t *buf = take(idx, len);
+    _slots[idx] = new_buf;
+    return buf;
+}
+
+uint32_t EMACRxRing::refill(mbed::Callback<void(uint32_t idx, void *ptr)> post)
+{
+    uint32_t count = 0;
+
+    // Slots are taken in ring order, so the empty ones follow on from the last refilled
+    while (count < _len && !_slots[_refill_idx]) {
+        emac_mem_buf_t *buf = alloc();
+        if (!buf) {
+            break;
+        }
+        _slots[_refill_idx] = buf;
+        post(_refill_idx, _mem_mngr->get_ptr(buf));
+        _refill_idx = (_refill_idx + 1) % _len;
+        count++;
+    }
+    return count;
+}
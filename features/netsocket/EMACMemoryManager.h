@@ -38,6 +38,7 @@
 
 #include "nsapi.h"
 #include "NetStackMemoryManager.h"
+#include "Callback.h"
 
 typedef void emac_mem_buf_t;          // Memory buffer
 
@@ -45,4 +46,105 @@ class EMACMemoryManager : public NetStackMemoryManager {
 
 };
 
+/**
+ * Ring of receive buffers posted to an EMAC's DMA
+ *
+ * Holds one stack buffer per receive descriptor, so received frames can be passed
+ * to the stack without copying. A driver takes the buffer of each completed
+ * descriptor, either replacing it at once with swap(), or leaving the slot empty
+ * with take() and posting new buffers for several slots at a time with refill().
+ *
+ * Slot storage is supplied by the driver, typically a static array with one
+ * entry per descriptor. The ring is not thread-safe; drivers use it from their
+ * receive thread.
+ */
+class EMACRxRing {
+public:
+    /** Receive ring statistics */
+    struct stats_t {
+        uint32_t received;      /**< Frames taken from the ring */
+        uint32_t replenished;   /**< Buffers allocated to refill slots */
+        uint32_t starved;       /**< Times a buffer couldn't be allocated for a slot */
+        uint32_t dropped;       /**< Frames dropped by swap() to recycle their buffer */
+    };
+
+    /** Create a ring
+     *
+     * @param slots  Storage for the ring, one entry per descriptor
+     * @param len    Number of slots
+     */
+    EMACRxRing(emac_mem_buf_t **slots, uint32_t len);
+
+    /** Allocate a buffer for every slot
+     *
+     * @param mem_mngr Memory manager to allocate buffers from
+     * @param size     Size of each buffer, normally the maximum frame length
+     * @param align    Buffer alignment required by the DMA
+     * @return         True if every slot has a buffer
+     */
+    bool init(EMACMemoryManager &mem_mngr, uint32_t size, uint32_t align);
+
+    /** Free all posted buffers */
+    void deinit();
+
+    /** Return number of slots */
+    uint32_t size() const
+    {
+        return _len;
+    }
+
+    /** Return data pointer of the buffer posted in a slot
+     *
+     * @param idx Slot index
+     * @return    Data pointer to give to the descriptor, or NULL if the slot is empty
+     */
+    void *get_ptr(uint32_t idx) const;
+
+    /** Take the frame received into a slot, leaving the slot empty
+     *
+     * @param idx Slot index
+     * @param len Length of the received frame
+     * @return    Buffer holding the frame, ownership passes to the caller
+     */
+    emac_mem_buf_t *take(uint32_t idx, uint32_t len);
+
+    /** Take the frame received into a slot, posting a new buffer in its place
+     *
+     * If no new buffer can be allocated the frame is dropped and its buffer
+     * stays posted, so the DMA never runs short of buffers.
+     *
+     * @param idx Slot index
+     * @param len Length of the received frame
+     * @return    Buffer holding the frame, or NULL if it was dropped
+     */
+    emac_mem_buf_t *swap(uint32_t idx, uint32_t len);
+
+    /** Post new buffers to empty slots, in ring order
+     *
+     * Starts at the oldest empty slot, and stops at the first slot still
+     * posted or when allocation fails.
+     *
+     * @param post Called with each refilled slot index and data pointer, to update its descriptor
+     * @return     Number of slots refilled
+     */
+    uint32_t refill(mbed::Callback<void(uint32_t idx, void *ptr)> post);
+
+    /** Return ring statistics */
+    const stats_t &get_stats() const
+    {
+        return _stats;
+    }
+
+private:
+    emac_mem_buf_t *alloc();
+
+    emac_mem_buf_t **_slots;
+    uint32_t _len;
+    uint32_t _refill_idx;
+    uint32_t _buf_size;
+    uint32_t _align;
+    EMACMemoryManager *_mem_mngr;
+    stats_t _stats;
+};
+
 #endif /* EMAC_MEMORY_MANAGER_H */
@@ -15,8 +15,11 @@
  */
 
 #include "InternetDatagramSocket.h"
+#include "NetStackMemoryManager.h"
 #include "Timer.h"
 #include "mbed_assert.h"
+#include "rtos/Kernel.h"
+#include <utility>
 
 nsapi_error_t InternetDatagramSocket::connect(const SocketAddress &address)
 {
@@ -27,9 +30,27 @@ nsapi_error_t InternetDatagramSocket::connect(const SocketAddress &address)
 }
 
 nsapi_size_or_error_t InternetDatagramSocket::sendto(const SocketAddress &address, const void *data, nsapi_size_t size)
+{
+    return sendto_internal(address, data, NULL, size);
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::sendto_buf(const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    NetStackMemoryManager *mem = get_memory_manager();
+    if (!mem) {
+        return _socket ? NSAPI_ERROR_UNSUPPORTED : NSAPI_ERROR_NO_SOCKET;
+    }
+
+    return sendto_internal(address, NULL, buf, mem->get_total_len(buf));
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::sendto_internal(const SocketAddress &address, const void *data,
+                                                              net_stack_mem_buf_t *buf, nsapi_size_t size)
 {
     _lock.lock();
     nsapi_size_or_error_t ret;
+    uint32_t blocked_ms = 0;
+    NetStackMemoryManager *mem = buf ? get_memory_manager() : NULL;
 
     _writers++;
     if (_socket) {
@@ -43,7 +64,16 @@ nsapi_size_or_error_t InternetDatagramSocket::sendto(const SocketAddress &addres
         }
 
         core_util_atomic_flag_clear(&_pending);
-        nsapi_size_or_error_t sent = _stack->socket_sendto(_socket, address, data, size);
+        nsapi_size_or_error_t sent;
+        if (buf) {
+            sent = _stack->socket_sendto_buf(_socket, address, buf);
+            // The stack only hands the buffer back if it would block
+            if (sent != NSAPI_ERROR_WOULD_BLOCK) {
+                buf = NULL;
+            }
+        } else {
+            sent = _stack->socket_sendto(_socket, address, data, size);
+        }
         if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
             _socket_stats.stats_update_sent_bytes(this, sent);
             ret = sent;
@@ -54,7 +84,9 @@ nsapi_size_or_error_t InternetDatagramSocket::sendto(const SocketAddress &addres
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t wait_start = rtos::Kernel::get_ms_count();
             flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            blocked_ms += rtos::Kernel::get_ms_count() - wait_start;
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -69,6 +101,10 @@ nsapi_size_or_error_t InternetDatagramSocket::sendto(const SocketAddress &addres
     if (!_socket || !_writers) {
         _event_flag.set(FINISHED_FLAG);
     }
+    _socket_stats.stats_update_send_call(this, blocked_ms);
+    if (buf) {
+        mem->free(buf);
+    }
     _lock.unlock();
     return ret;
 }
@@ -81,10 +117,39 @@ nsapi_size_or_error_t InternetDatagramSocket::send(const void *data, nsapi_size_
     return sendto(_remote_peer, data, size);
 }
 
+nsapi_size_or_error_t InternetDatagramSocket::send_buf(net_stack_mem_buf_t *buf)
+{
+    if (!_remote_peer) {
+        NetStackMemoryManager *mem = get_memory_manager();
+        if (mem) {
+            mem->free(buf);
+        }
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+    return sendto_buf(_remote_peer, buf);
+}
+
 nsapi_size_or_error_t InternetDatagramSocket::recvfrom(SocketAddress *address, void *buffer, nsapi_size_t size)
+{
+    return recvfrom_internal(address, buffer, NULL, size);
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvfrom_buf(SocketAddress *address, net_stack_mem_buf_t **buf, nsapi_size_t size)
+{
+    *buf = NULL;
+    if (!get_memory_manager()) {
+        return _socket ? NSAPI_ERROR_UNSUPPORTED : NSAPI_ERROR_NO_SOCKET;
+    }
+
+    return recvfrom_internal(address, NULL, buf, size);
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvfrom_internal(SocketAddress *address, void *buffer,
+                                                                net_stack_mem_buf_t **buf, nsapi_size_t size)
 {
     _lock.lock();
     nsapi_size_or_error_t ret;
+    uint32_t wait_ms = 0;
     SocketAddress ignored;
 
     if (!address) {
@@ -103,10 +168,19 @@ nsapi_size_or_error_t InternetDatagramSocket::recvfrom(SocketAddress *address, v
         }
 
         core_util_atomic_flag_clear(&_pending);
-        nsapi_size_or_error_t recv = _stack->socket_recvfrom(_socket, address, buffer, size);
+        nsapi_size_or_error_t recv;
+        if (buf) {
+            recv = _stack->socket_recvfrom_buf(_socket, address, buf, size);
+        } else {
+            recv = _stack->socket_recvfrom(_socket, address, buffer, size);
+        }
 
         // Filter incomming packets using connected peer address
         if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+            if (buf) {
+                get_memory_manager()->free(*buf);
+                *buf = NULL;
+            }
             continue;
         }
 
@@ -122,7 +196,9 @@ nsapi_size_or_error_t InternetDatagramSocket::recvfrom(SocketAddress *address, v
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t wait_start = rtos::Kernel::get_ms_count();
             flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            wait_ms += rtos::Kernel::get_ms_count() - wait_start;
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -137,6 +213,7 @@ nsapi_size_or_error_t InternetDatagramSocket::recvfrom(SocketAddress *address, v
     if (!_socket || !_readers) {
         _event_flag.set(FINISHED_FLAG);
     }
+    _socket_stats.stats_update_recv_call(this, wait_ms);
 
     _lock.unlock();
     return ret;
@@ -147,6 +224,150 @@ nsapi_size_or_error_t InternetDatagramSocket::recv(void *buffer, nsapi_size_t si
     return recvfrom(NULL, buffer, size);
 }
 
+nsapi_size_or_error_t InternetDatagramSocket::recv_buf(net_stack_mem_buf_t **buf, nsapi_size_t size)
+{
+    return recvfrom_buf(NULL, buf, size);
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::sendto_batch(nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    uint32_t blocked_ms = 0;
+    nsapi_size_t done = 0;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendto_batch(_socket, datagrams + done, count - done);
+        if (sent > 0) {
+            for (nsapi_size_t i = done; i < done + sent; i++) {
+                _socket_stats.stats_update_peer(this, datagrams[i].address);
+                _socket_stats.stats_update_sent_bytes(this, datagrams[i].result);
+            }
+            done += sent;
+            if (done == count) {
+                ret = NSAPI_ERROR_OK;
+                break;
+            }
+            // The stack stopped on the next datagram, find out why
+            sent = datagrams[done].result;
+        }
+
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            uint64_t wait_start = rtos::Kernel::get_ms_count();
+            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            blocked_ms += rtos::Kernel::get_ms_count() - wait_start;
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                datagrams[done].result = NSAPI_ERROR_WOULD_BLOCK;
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _socket_stats.stats_update_send_call(this, blocked_ms);
+    _lock.unlock();
+    return done ? (nsapi_size_or_error_t)done : ret;
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvfrom_batch(nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    uint32_t wait_ms = 0;
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvfrom_batch(_socket, datagrams, count);
+
+        if (recv > 0) {
+            // Filter incomming packets using connected peer address,
+            // keeping the buffers of dropped ones at the end of the array
+            nsapi_size_t kept = 0;
+            for (nsapi_size_t i = 0; i < (nsapi_size_t)recv; i++) {
+                if (_remote_peer && _remote_peer != datagrams[i].address) {
+                    continue;
+                }
+                if (i != kept) {
+                    std::swap(datagrams[kept], datagrams[i]);
+                }
+                _socket_stats.stats_update_recv_bytes(this, datagrams[kept].result);
+                kept++;
+            }
+            if (!kept) {
+                continue;
+            }
+            recv = kept;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            uint64_t wait_start = rtos::Kernel::get_ms_count();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            wait_ms += rtos::Kernel::get_ms_count() - wait_start;
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _socket_stats.stats_update_recv_call(this, wait_ms);
+
+    _lock.unlock();
+    return ret;
+}
+
 Socket *InternetDatagramSocket::accept(nsapi_error_t *error)
 {
     if (error) {
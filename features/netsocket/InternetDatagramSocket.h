@@ -123,6 +123,118 @@ public:
      */
     nsapi_size_or_error_t recv(void *data, nsapi_size_t size) override;
 
+    /** Send a network buffer to the specified address.
+     *
+     *  Works like sendto(), but takes the datagram in a buffer chain allocated
+     *  from get_memory_manager(), so it can be filled in place and passed to
+     *  the stack without copying. The socket takes ownership of the buffer and
+     *  frees it before returning, whether or not it was sent.
+     *
+     *  @param address  Remote address
+     *  @param buf      Buffer chain of data to send to the host.
+     *  @retval         int Number of sent bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack does not expose its buffers.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_sendto_buf.
+     */
+    nsapi_size_or_error_t sendto_buf(const SocketAddress &address, net_stack_mem_buf_t *buf);
+
+    /** Send a network buffer to the remote host set by connect().
+     *
+     *  This is equivalent to calling sendto_buf() with the connected address.
+     *
+     *  @param buf      Buffer chain of data to send to the host.
+     *  @retval         int Number of sent bytes on success.
+     *  @retval         NSAPI_ERROR_NO_ADDRESS if the socket is not connected.
+     *  @retval         int Other negative error codes, see sendto_buf().
+     */
+    nsapi_size_or_error_t send_buf(net_stack_mem_buf_t *buf);
+
+    /** Receive a datagram into a network buffer.
+     *
+     *  Works like recvfrom(), but returns the datagram in a buffer chain,
+     *  which the stack may hand over without copying. On success the caller
+     *  owns the buffer and must free it with get_memory_manager().
+     *
+     *  @param address  Destination for the source address or NULL.
+     *  @param buf      Destination for the buffer chain, set to NULL if no
+     *                  datagram is returned.
+     *  @param size     Maximum number of bytes to receive, longer datagrams
+     *                  are truncated.
+     *  @retval         int Number of received bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack does not expose its buffers.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_recvfrom_buf.
+     */
+    nsapi_size_or_error_t recvfrom_buf(SocketAddress *address, net_stack_mem_buf_t **buf, nsapi_size_t size);
+
+    /** Receive a datagram into a network buffer.
+     *
+     *  This is equivalent to calling recvfrom_buf(NULL, buf, size).
+     *
+     *  @param buf      Destination for the buffer chain.
+     *  @param size     Maximum number of bytes to receive.
+     *  @retval         int Number of received bytes on success.
+     *  @retval         int Negative error codes, see recvfrom_buf().
+     */
+    nsapi_size_or_error_t recv_buf(net_stack_mem_buf_t **buf, nsapi_size_t size);
+
+    /** Send a batch of datagrams.
+     *
+     *  Each datagram is sent to its own address, in order, with a single
+     *  call into the stack per attempt rather than one per datagram. The
+     *  result of every sent datagram is set to the number of bytes sent.
+     *
+     *  By default, sendto_batch blocks until all the datagrams are sent. If
+     *  socket is set to nonblocking or times out, the datagrams sent so far
+     *  are counted and the result of the next one is set to
+     *  NSAPI_ERROR_WOULD_BLOCK. Sending stops at the first datagram that
+     *  fails, its result holding the error.
+     *
+     *  @param datagrams Datagrams to send.
+     *  @param count     Number of datagrams.
+     *  @retval         int Number of sent datagrams on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and no datagram could be sent immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_sendto_batch.
+     */
+    nsapi_size_or_error_t sendto_batch(nsapi_datagram_t *datagrams, nsapi_size_t count);
+
+    /** Receive a batch of datagrams.
+     *
+     *  By default, recvfrom_batch blocks until at least one datagram is
+     *  received, then returns it with any others that are already waiting,
+     *  up to count. If socket is set to nonblocking or times out with no
+     *  datagram, NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  Each entry gives the buffer and its size. On return, the first entries
+     *  hold the source address and size of each received datagram.
+     *
+     *  @note If a datagram is larger than its buffer, the excess data is silently discarded.
+     *
+     *  @note If socket is connected, only packets coming from connected peer
+     *  address are accepted. The entries of dropped packets are moved after
+     *  the received ones, so buffers may come back in a different order.
+     *
+     *  @param datagrams Datagrams to receive into.
+     *  @param count     Number of entries in datagrams.
+     *  @retval         int Number of received datagrams on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and no datagram is waiting.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See \ref NetworkStack::socket_recvfrom_batch.
+     */
+    nsapi_size_or_error_t recvfrom_batch(nsapi_datagram_t *datagrams, nsapi_size_t count);
+
     /** Not implemented for InternetDatagramSocket.
      *
      *  @param error      Not used.
@@ -146,6 +258,16 @@ protected:
      */
     InternetDatagramSocket() = default;
 
+    /** Send from either a plain buffer or a buffer chain, whichever is not NULL
+     */
+    nsapi_size_or_error_t sendto_internal(const SocketAddress &address, const void *data,
+                                          net_stack_mem_buf_t *buf, nsapi_size_t size);
+
+    /** Receive into either a plain buffer or a buffer chain, whichever is not NULL
+     */
+    nsapi_size_or_error_t recvfrom_internal(SocketAddress *address, void *data,
+                                            net_stack_mem_buf_t **buf, nsapi_size_t size);
+
 #endif //!defined(DOXYGEN_ONLY)
 };
 
@@ -15,11 +15,31 @@
  */
 
 #include "InternetSocket.h"
+#include "nsapi_dns.h"
 #include "platform/mbed_critical.h"
 #include "platform/Callback.h"
+#include "rtos/Kernel.h"
 
 using namespace mbed;
 
+namespace {
+// Collects the answer of the name lookup for connect_happy_eyeballs()
+struct happy_eyeballs_lookup {
+    rtos::EventFlags done;
+    SocketAddress addresses[MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
+    nsapi_size_or_error_t result = NSAPI_ERROR_DNS_FAILURE;
+
+    void resolved(nsapi_value_or_error_t status, SocketAddress *address)
+    {
+        result = status;
+        for (int i = 0; i < status && i < MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT; i++) {
+            addresses[i] = address[i];
+        }
+        done.set(1);
+    }
+};
+}
+
 InternetSocket::InternetSocket()
 {
     _socket_stats.stats_new_socket_entry(this);
@@ -163,6 +183,190 @@ int InternetSocket::get_stagger_estimate_to_address(const SocketAddress &address
     return ret;
 }
 
+nsapi_error_t InternetSocket::connect_happy_eyeballs(const char *host, uint16_t port)
+{
+    if (!host) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    SocketAddress literal;
+    if (literal.set_ip_address(host)) {
+        literal.set_port(port);
+        return connect(literal);
+    }
+
+    _lock.lock();
+    NetworkStack *stack = _stack;
+    _lock.unlock();
+    if (!stack) {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    // Without a version, the lookup asks for AAAA and A records together
+    happy_eyeballs_lookup lookup;
+    nsapi_value_or_error_t ret = nsapi_dns_query_multiple_async(stack, host, callback(&lookup, &happy_eyeballs_lookup::resolved),
+                                                                MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT, stack->get_call_in_callback(),
+                                                                _interface_name[0] ? _interface_name : NULL, NSAPI_UNSPEC);
+    if (ret < 0) {
+        return ret;
+    }
+    lookup.done.wait_any(1);
+    if (lookup.result <= 0) {
+        return lookup.result ? lookup.result : NSAPI_ERROR_DNS_FAILURE;
+    }
+
+    // RFC 8305 section 4: alternates the families, starting with IPv6
+    SocketAddress v6[MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
+    SocketAddress v4[MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
+    int count = lookup.result;
+    int v6_count = 0;
+    int v4_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (lookup.addresses[i].get_ip_version() == NSAPI_IPv6) {
+            v6[v6_count++] = lookup.addresses[i];
+        } else {
+            v4[v4_count++] = lookup.addresses[i];
+        }
+    }
+
+    SocketAddress *addresses = lookup.addresses;
+    for (int i = 0, i6 = 0, i4 = 0; i < count; i++) {
+        if (i6 < v6_count && (i4 == v4_count || i6 <= i4)) {
+            addresses[i] = v6[i6++];
+        } else {
+            addresses[i] = v4[i4++];
+        }
+        addresses[i].set_port(port);
+    }
+
+    if (count == 1 || _timeout == 0 || get_proto() != NSAPI_TCP) {
+        return connect(addresses[0]);
+    }
+
+    return connect_race(addresses, count);
+}
+
+nsapi_error_t InternetSocket::connect_race(const SocketAddress *addresses, int count)
+{
+    nsapi_socket_t handles[MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT] = {};
+    nsapi_error_t ret = NSAPI_ERROR_NO_CONNECTION;
+    int started = 0;
+    int active = 0;
+    int winner = -1;
+
+    _lock.lock();
+    _writers++;
+
+    nsapi_socket_t own = _socket;
+    uint64_t now = rtos::Kernel::get_ms_count();
+    uint64_t deadline = now + _timeout;
+    uint64_t next_start = now;
+
+    while (_socket == own && own) {
+        // Starts the next attempt once the others had their head start, or all have failed
+        if (started < count && (!active || now >= next_start)) {
+            nsapi_socket_t handle = own;
+            if (started && _stack->socket_open(&handle, get_proto()) != NSAPI_ERROR_OK) {
+                // Out of sockets, the attempts in progress are all there is going to be
+                count = started;
+            } else {
+                if (handle != own) {
+                    _stack->socket_attach(handle, _event.thunk, &_event);
+                    if (_interface_name[0]) {
+                        _stack->setsockopt(handle, NSAPI_SOCKET, NSAPI_BIND_TO_DEVICE, _interface_name, NSAPI_INTERFACE_NAME_MAX_SIZE);
+                    }
+                }
+                handles[started++] = handle;
+                active++;
+                next_start = now + MBED_CONF_NSAPI_HAPPY_EYEBALLS_DELAY;
+            }
+        }
+
+        // Polls every attempt in progress, blocking stacks only return when theirs is done
+        core_util_atomic_flag_clear(&_pending);
+        for (int i = 0; i < started && winner < 0; i++) {
+            if (!handles[i]) {
+                continue;
+            }
+            nsapi_error_t err = _stack->socket_connect(handles[i], addresses[i]);
+            if (err == NSAPI_ERROR_OK || err == NSAPI_ERROR_IS_CONNECTED) {
+                winner = i;
+            } else if (err != NSAPI_ERROR_IN_PROGRESS && err != NSAPI_ERROR_ALREADY) {
+                ret = err;
+                if (handles[i] != own) {
+                    _stack->socket_attach(handles[i], 0, 0);
+                    _stack->socket_close(handles[i]);
+                }
+                handles[i] = nullptr;
+                active--;
+            }
+        }
+
+        if (winner >= 0 || (!active && started == count)) {
+            break;
+        }
+
+        now = rtos::Kernel::get_ms_count();
+        if (_timeout != osWaitForever && now >= deadline) {
+            ret = NSAPI_ERROR_TIMEOUT;
+            break;
+        }
+        if (!active) {
+            continue;
+        }
+
+        // Waits for progress, the next attempt to be due, or the timeout
+        uint64_t until = (started < count) ? next_start : deadline;
+        if (_timeout != osWaitForever && deadline < until) {
+            until = deadline;
+        }
+        uint32_t wait_ms = osWaitForever;
+        if (started < count || _timeout != osWaitForever) {
+            wait_ms = (until > now) ? (uint32_t)(until - now) : 0;
+        }
+
+        // Release lock before blocking so other threads
+        // accessing this object aren't blocked
+        _lock.unlock();
+        _event_flag.wait_any(WRITE_FLAG, wait_ms);
+        _lock.lock();
+        now = rtos::Kernel::get_ms_count();
+    }
+
+    // The socket was closed under us, nothing can win any more
+    if (_socket != own || !own) {
+        winner = -1;
+        ret = NSAPI_ERROR_NO_SOCKET;
+    }
+
+    for (int i = 0; i < started; i++) {
+        if (handles[i] && handles[i] != own && i != winner) {
+            _stack->socket_attach(handles[i], 0, 0);
+            _stack->socket_close(handles[i]);
+        }
+    }
+
+    if (winner >= 0) {
+        if (handles[winner] != own) {
+            _stack->socket_attach(own, 0, 0);
+            _stack->socket_close(own);
+            _socket = handles[winner];
+        }
+        _remote_peer = addresses[winner];
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        _socket_stats.stats_update_socket_state(this, SOCK_CONNECTED);
+        ret = NSAPI_ERROR_OK;
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_error_t InternetSocket::bind(uint16_t port)
 {
     // Underlying bind is thread safe
@@ -264,3 +468,11 @@ nsapi_error_t InternetSocket::getpeername(SocketAddress *address)
     *address = _remote_peer;
     return NSAPI_ERROR_OK;
 }
+
+NetStackMemoryManager *InternetSocket::get_memory_manager()
+{
+    if (!_stack) {
+        return NULL;
+    }
+    return _stack->get_memory_manager();
+}
@@ -115,6 +115,33 @@ public:
      */
     int get_stagger_estimate_to_address(const SocketAddress &address, uint16_t data_amount, uint16_t *stagger_min, uint16_t *stagger_max, uint16_t *stagger_rand);
 
+    /** Resolve a host name and connect to whichever of its addresses answers first.
+     *
+     *  Follows Happy Eyeballs (RFC 8305). IPv6 and IPv4 addresses are
+     *  looked up together and tried alternately, IPv6 first. Each new
+     *  attempt starts nsapi.happy-eyeballs-delay milliseconds after the
+     *  previous one unless that one fails sooner, and the first connection
+     *  made wins. On stacks whose connect blocks, the attempts simply run
+     *  one after another.
+     *
+     *  Attempts after the first run on new stack sockets. If one of them
+     *  wins, it replaces the socket's own, and options other than
+     *  NSAPI_BIND_TO_DEVICE set before the call are lost.
+     *
+     *  Non-blocking sockets and connectionless protocols only use the
+     *  first address.
+     *
+     *  @param host     Host name or IP address literal.
+     *  @param port     Port of the remote host.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET if socket is not open.
+     *  @retval         NSAPI_ERROR_PARAMETER if host is NULL.
+     *  @retval         NSAPI_ERROR_TIMEOUT if no attempt succeeded within the socket timeout.
+     *  @retval         int Other negative error codes from name resolution or
+     *                  from the last attempt that failed. See @ref Socket::connect.
+     */
+    nsapi_error_t connect_happy_eyeballs(const char *host, uint16_t port);
+
     /** Bind the socket to a port on which to receive data.
      *
      *  @param port     Local port to bind.
@@ -153,6 +180,17 @@ public:
      */
     nsapi_error_t getpeername(SocketAddress *address) override;
 
+    /** Get the memory manager of the network stack's buffers
+     *
+     *  Buffers for send_buf() and sendto_buf() are allocated from it, and
+     *  buffers returned by recv_buf() and recvfrom_buf() are freed with it.
+     *
+     *  @return         The memory manager, or NULL if the socket is not open
+     *                  or the stack does not expose its buffers.
+     *                  See @ref NetworkStack::get_memory_manager.
+     */
+    NetStackMemoryManager *get_memory_manager();
+
 
 #if !defined(DOXYGEN_ONLY)
 
@@ -161,6 +199,7 @@ protected:
     virtual nsapi_protocol_t get_proto() = 0;
     void event();
     int modify_multicast_group(const SocketAddress &address, nsapi_socket_option_t socketopt);
+    nsapi_error_t connect_race(const SocketAddress *addresses, int count);
     char _interface_name[NSAPI_INTERFACE_NAME_MAX_SIZE];
     NetworkStack *_stack = nullptr;
     nsapi_socket_t _socket = nullptr;
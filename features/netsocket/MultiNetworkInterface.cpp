@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/MultiNetworkInterface.h"
+#include "netsocket/NetworkStack.h"
+#include "events/mbed_shared_queues.h"
+#include "platform/ScopedLock.h"
+
+using namespace std::chrono;
+
+#define MULTI_FLAG_DONE 0x1
+
+MultiNetworkInterface::MultiNetworkInterface() :
+    _member_count(0),
+    _active(NULL),
+    _first_up(NULL),
+    _grace(5s),
+    _grace_event(0),
+    _grace_expired(false),
+    _blocking(true),
+    _status(NSAPI_STATUS_DISCONNECTED)
+{
+}
+
+MultiNetworkInterface::~MultiNetworkInterface()
+{
+    cancel_grace();
+#if MBED_CONF_PLATFORM_CALLBACK_COMPARABLE
+    for (int i = 0; i < _member_count; i++) {
+        _members[i].iface->remove_event_listener(mbed::callback(&_members[i], &member_t::status_cb));
+    }
+#endif
+}
+
+nsapi_error_t MultiNetworkInterface::add_interface(NetworkInterface *iface, bool preferred)
+{
+    if (!iface) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    if (_status != NSAPI_STATUS_DISCONNECTED) {
+        return NSAPI_ERROR_BUSY;
+    }
+    if (_member_count == MBED_CONF_NSAPI_MULTI_INTERFACE_MAX) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    member_t *member = &_members[_member_count++];
+    member->owner = this;
+    member->iface = iface;
+    member->state = MEMBER_IDLE;
+    member->preferred = preferred;
+    member->blocking = true;
+    iface->add_event_listener(mbed::callback(member, &member_t::status_cb));
+
+    return NSAPI_ERROR_OK;
+}
+
+void MultiNetworkInterface::set_grace_period(milliseconds grace)
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    _grace = grace;
+}
+
+NetworkInterface *MultiNetworkInterface::get_active_interface() const
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    return _active ? _active->iface : NULL;
+}
+
+nsapi_error_t MultiNetworkInterface::connect()
+{
+    _mutex.lock();
+    if (_member_count == 0) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+    if (_status != NSAPI_STATUS_DISCONNECTED) {
+        nsapi_error_t err = _status == NSAPI_STATUS_CONNECTING ? NSAPI_ERROR_BUSY : NSAPI_ERROR_IS_CONNECTED;
+        _mutex.unlock();
+        return err;
+    }
+
+    _active = NULL;
+    _first_up = NULL;
+    _grace_expired = false;
+    _flags.clear(MULTI_FLAG_DONE);
+    for (int i = 0; i < _member_count; i++) {
+        _members[i].state = MEMBER_CONNECTING;
+        // Interfaces without a non-blocking mode are connected in turn below
+        _members[i].blocking = _members[i].iface->set_blocking(false) == NSAPI_ERROR_UNSUPPORTED;
+    }
+    set_status(NSAPI_STATUS_CONNECTING);
+    _mutex.unlock();
+
+    // Members report back through status_cb(), which may run before connect() returns
+    for (int i = 0; i < _member_count; i++) {
+        member_t *member = &_members[i];
+        _mutex.lock();
+        bool start = !member->blocking && member->state == MEMBER_CONNECTING;
+        _mutex.unlock();
+        if (!start) {
+            continue;
+        }
+        nsapi_error_t err = member->iface->connect();
+        if (err == NSAPI_ERROR_IS_CONNECTED) {
+            member_status(member, NSAPI_STATUS_GLOBAL_UP);
+        } else if (err != NSAPI_ERROR_OK && err != NSAPI_ERROR_IN_PROGRESS) {
+            member_status(member, NSAPI_STATUS_DISCONNECTED);
+        }
+    }
+
+    for (int i = 0; i < _member_count; i++) {
+        member_t *member = &_members[i];
+        _mutex.lock();
+        bool start = member->blocking && member->state == MEMBER_CONNECTING;
+        _mutex.unlock();
+        if (!start) {
+            continue;
+        }
+
+        nsapi_error_t err = member->iface->connect();
+
+        _mutex.lock();
+        bool lost = member->state != MEMBER_CONNECTING && member->state != MEMBER_UP;
+        if (!lost) {
+            member_status(member, err == NSAPI_ERROR_OK || err == NSAPI_ERROR_IS_CONNECTED ?
+                          NSAPI_STATUS_GLOBAL_UP : NSAPI_STATUS_DISCONNECTED);
+        }
+        _mutex.unlock();
+        if (lost && err == NSAPI_ERROR_OK) {
+            // Another interface won while this one was connecting
+            member->iface->disconnect();
+        }
+    }
+
+    if (!_blocking) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _flags.wait_any(MULTI_FLAG_DONE);
+
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    return _active ? NSAPI_ERROR_OK : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::disconnect()
+{
+    NetworkInterface *to_disconnect[MBED_CONF_NSAPI_MULTI_INTERFACE_MAX];
+    int count = 0;
+
+    _mutex.lock();
+    if (_status == NSAPI_STATUS_DISCONNECTED) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    cancel_grace();
+    for (int i = 0; i < _member_count; i++) {
+        if (_members[i].state == MEMBER_CONNECTING || _members[i].state == MEMBER_UP) {
+            to_disconnect[count++] = _members[i].iface;
+        }
+        _members[i].state = MEMBER_IDLE;
+    }
+    _active = NULL;
+    _first_up = NULL;
+    set_status(NSAPI_STATUS_DISCONNECTED);
+    _flags.set(MULTI_FLAG_DONE);
+    _mutex.unlock();
+
+    for (int i = 0; i < count; i++) {
+        to_disconnect[i]->disconnect();
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+void MultiNetworkInterface::member_t::status_cb(nsapi_event_t event, intptr_t value)
+{
+    if (event == NSAPI_EVENT_CONNECTION_STATUS_CHANGE) {
+        owner->member_status(this, static_cast<nsapi_connection_status_t>(value));
+    }
+}
+
+void MultiNetworkInterface::member_status(member_t *member, nsapi_connection_status_t status)
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+
+    if (member->state == MEMBER_IDLE || member->state == MEMBER_DROPPED) {
+        return;
+    }
+
+    switch (status) {
+        case NSAPI_STATUS_GLOBAL_UP:
+            if (member->state == MEMBER_CONNECTING) {
+                member->state = MEMBER_UP;
+                if (!_first_up) {
+                    _first_up = member;
+                }
+            }
+            break;
+        case NSAPI_STATUS_DISCONNECTED:
+            if (member == _active) {
+                // The winner went down: report it rather than silently switching interface
+                for (int i = 0; i < _member_count; i++) {
+                    _members[i].state = MEMBER_IDLE;
+                }
+                _active = NULL;
+                _first_up = NULL;
+                set_status(NSAPI_STATUS_DISCONNECTED);
+                return;
+            }
+            if (member == _first_up) {
+                _first_up = NULL;
+                for (int i = 0; i < _member_count; i++) {
+                    if (_members[i].state == MEMBER_UP && &_members[i] != member) {
+                        _first_up = &_members[i];
+                        break;
+                    }
+                }
+            }
+            member->state = MEMBER_FAILED;
+            break;
+        default:
+            return;
+    }
+
+    if (!_active) {
+        decide();
+    }
+}
+
+void MultiNetworkInterface::grace_expired()
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    _grace_event = 0;
+    _grace_expired = true;
+    if (!_active && _status == NSAPI_STATUS_CONNECTING) {
+        decide();
+    }
+}
+
+void MultiNetworkInterface::decide()
+{
+    member_t *winner = NULL;
+    bool preferred_pending = false;
+    bool pending = false;
+
+    for (int i = 0; i < _member_count; i++) {
+        member_t *member = &_members[i];
+        if (member->state == MEMBER_UP && member->preferred) {
+            winner = member;
+            break;
+        }
+        if (member->state == MEMBER_CONNECTING) {
+            pending = true;
+            if (member->preferred) {
+                preferred_pending = true;
+            }
+        }
+    }
+
+    if (!winner && _first_up) {
+        if (!preferred_pending || _grace_expired || _grace == 0s) {
+            winner = _first_up;
+        } else if (!_grace_event) {
+            _grace_event = mbed::mbed_event_queue()->call_in(_grace, this, &MultiNetworkInterface::grace_expired);
+            if (!_grace_event) {
+                // No room to wait for the preferred interface
+                winner = _first_up;
+            }
+        }
+    }
+
+    if (!winner) {
+        if (!pending && !_first_up) {
+            for (int i = 0; i < _member_count; i++) {
+                _members[i].state = MEMBER_IDLE;
+            }
+            set_status(NSAPI_STATUS_DISCONNECTED);
+            _flags.set(MULTI_FLAG_DONE);
+        }
+        return;
+    }
+
+    cancel_grace();
+    _active = winner;
+    drop_members();
+    set_status(NSAPI_STATUS_GLOBAL_UP);
+    _flags.set(MULTI_FLAG_DONE);
+}
+
+void MultiNetworkInterface::drop_members()
+{
+    bool dropped = false;
+
+    for (int i = 0; i < _member_count; i++) {
+        member_t *member = &_members[i];
+        if (member == _active) {
+            continue;
+        }
+        if (member->blocking && member->state == MEMBER_CONNECTING) {
+            // connect() is running for it and disconnects it once it returns
+            member->state = MEMBER_IDLE;
+        } else if (member->state == MEMBER_CONNECTING || member->state == MEMBER_UP) {
+            member->state = MEMBER_DROPPED;
+            dropped = true;
+        } else {
+            member->state = MEMBER_IDLE;
+        }
+    }
+
+    // Member status callbacks may run in the member's own context, so do not
+    // call back into it from here
+    if (dropped && !mbed::mbed_event_queue()->call(this, &MultiNetworkInterface::disconnect_dropped)) {
+        for (int i = 0; i < _member_count; i++) {
+            if (_members[i].state == MEMBER_DROPPED) {
+                _members[i].state = MEMBER_IDLE;
+            }
+        }
+    }
+}
+
+void MultiNetworkInterface::disconnect_dropped()
+{
+    for (int i = 0; i < _member_count; i++) {
+        member_t *member = &_members[i];
+        _mutex.lock();
+        bool drop = member->state == MEMBER_DROPPED;
+        member->state = drop ? MEMBER_IDLE : member->state;
+        _mutex.unlock();
+        if (drop) {
+            member->iface->disconnect();
+        }
+    }
+}
+
+void MultiNetworkInterface::cancel_grace()
+{
+    if (_grace_event) {
+        mbed::mbed_event_queue()->cancel(_grace_event);
+        _grace_event = 0;
+    }
+}
+
+void MultiNetworkInterface::set_status(nsapi_connection_status_t status)
+{
+    if (_status == status) {
+        return;
+    }
+    _status = status;
+    if (_status_cb) {
+        _status_cb(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, _status);
+    }
+}
+
+const char *MultiNetworkInterface::get_mac_address()
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_mac_address() : NULL;
+}
+
+nsapi_error_t MultiNetworkInterface::get_ip_address(SocketAddress *address)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_ip_address(address) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::get_ipv6_link_local_address(SocketAddress *address)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_ipv6_link_local_address(address) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::get_netmask(SocketAddress *address)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_netmask(address) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::get_gateway(SocketAddress *address)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_gateway(address) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+char *MultiNetworkInterface::get_interface_name(char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_interface_name(interface_name) : NULL;
+}
+
+nsapi_error_t MultiNetworkInterface::gethostbyname(const char *host, SocketAddress *address, nsapi_version_t version,
+                                                   const char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->gethostbyname(host, address, version, interface_name) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_value_or_error_t MultiNetworkInterface::getaddrinfo(const char *hostname, SocketAddress *hints, SocketAddress **res,
+                                                          const char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->getaddrinfo(hostname, hints, res, interface_name) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_value_or_error_t MultiNetworkInterface::gethostbyname_async(const char *host, hostbyname_cb_t callback,
+                                                                  nsapi_version_t version, const char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->gethostbyname_async(host, callback, version, interface_name) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_value_or_error_t MultiNetworkInterface::getaddrinfo_async(const char *hostname, SocketAddress *hints,
+                                                                hostbyname_cb_t callback, const char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->getaddrinfo_async(hostname, hints, callback, interface_name) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::gethostbyname_async_cancel(int id)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->gethostbyname_async_cancel(id) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::add_dns_server(const SocketAddress &address, const char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->add_dns_server(address, interface_name) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+nsapi_error_t MultiNetworkInterface::get_dns_server(int index, SocketAddress *address, const char *interface_name)
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? iface->get_dns_server(index, address, interface_name) : NSAPI_ERROR_NO_CONNECTION;
+}
+
+void MultiNetworkInterface::attach(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb)
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    _status_cb = status_cb;
+}
+
+nsapi_connection_status_t MultiNetworkInterface::get_connection_status() const
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    return _status;
+}
+
+nsapi_error_t MultiNetworkInterface::set_blocking(bool blocking)
+{
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    _blocking = blocking;
+    return NSAPI_ERROR_OK;
+}
+
+NetworkStack *MultiNetworkInterface::get_stack()
+{
+    NetworkInterface *iface = get_active_interface();
+    return iface ? nsapi_create_stack(iface) : NULL;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file MultiNetworkInterface.h Network interface bringing up several interfaces at once */
+/** @addtogroup netinterface
+ * @{
+ */
+
+#ifndef MULTI_NETWORK_INTERFACE_H
+#define MULTI_NETWORK_INTERFACE_H
+
+#include <chrono>
+#include "netsocket/NetworkInterface.h"
+#include "rtos/Mutex.h"
+#include "rtos/EventFlags.h"
+
+#ifndef MBED_CONF_NSAPI_MULTI_INTERFACE_MAX
+#define MBED_CONF_NSAPI_MULTI_INTERFACE_MAX 3
+#endif
+
+/** MultiNetworkInterface class
+ *
+ * Races the connection of several network interfaces, for example Ethernet,
+ * Wi-Fi and cellular, and uses the first one to come up. A missing cable or an
+ * out of range access point then does not delay the fallback to another
+ * interface by its whole connection timeout.
+ *
+ * All interfaces are started together in non-blocking mode. The first
+ * interface to reach global connectivity wins, unless a preferred interface
+ * is still connecting: the others then wait for it for up to the grace period.
+ * The losing interfaces are disconnected. Sockets opened on the
+ * MultiNetworkInterface, and DNS queries made through it, use the winner.
+ *
+ * Interfaces that do not support non-blocking mode are connected in turn
+ * after the others have been started, in the thread calling connect().
+ *
+ * @code
+ * MultiNetworkInterface net;
+ * net.add_interface(EthInterface::get_default_instance(), true);
+ * net.add_interface(CellularInterface::get_default_instance());
+ * if (net.connect() == NSAPI_ERROR_OK) {
+ *     TCPSocket socket;
+ *     socket.open(&net);
+ * }
+ * @endcode
+ */
+class MultiNetworkInterface : public NetworkInterface {
+public:
+    MultiNetworkInterface();
+    ~MultiNetworkInterface() override;
+
+    /** Add an interface to the race.
+     *
+     * Interfaces can only be added while disconnected.
+     *
+     * @param iface     Interface to bring up. It must outlive this object.
+     * @param preferred True to wait up to the grace period for this interface
+     *                  when another one connects first.
+     * @return          NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if iface is NULL,
+     *                  NSAPI_ERROR_NO_MEMORY if MBED_CONF_NSAPI_MULTI_INTERFACE_MAX
+     *                  interfaces were already added, NSAPI_ERROR_BUSY while connected.
+     */
+    nsapi_error_t add_interface(NetworkInterface *iface, bool preferred = false);
+
+    /** Set how long a connected interface waits for a preferred one still connecting.
+     *
+     * @param grace Grace period, 0 to use the first interface to connect. Default 5 seconds.
+     */
+    void set_grace_period(std::chrono::milliseconds grace);
+
+    /** Get the interface in use.
+     *
+     * @return Interface that won the race, or NULL if not connected.
+     */
+    NetworkInterface *get_active_interface() const;
+
+    /** @copydoc NetworkInterface::connect */
+    nsapi_error_t connect() override;
+
+    /** @copydoc NetworkInterface::disconnect */
+    nsapi_error_t disconnect() override;
+
+    /** @copydoc NetworkInterface::get_mac_address */
+    const char *get_mac_address() override;
+
+    /** @copydoc NetworkInterface::get_ip_address */
+    nsapi_error_t get_ip_address(SocketAddress *address) override;
+
+    /** @copydoc NetworkInterface::get_ipv6_link_local_address */
+    nsapi_error_t get_ipv6_link_local_address(SocketAddress *address) override;
+
+    /** @copydoc NetworkInterface::get_netmask */
+    nsapi_error_t get_netmask(SocketAddress *address) override;
+
+    /** @copydoc NetworkInterface::get_gateway */
+    nsapi_error_t get_gateway(SocketAddress *address) override;
+
+    /** @copydoc NetworkInterface::get_interface_name */
+    char *get_interface_name(char *interface_name) override;
+
+    /** @copydoc NetworkInterface::gethostbyname */
+    nsapi_error_t gethostbyname(const char *host, SocketAddress *address, nsapi_version_t version = NSAPI_UNSPEC,
+                                const char *interface_name = NULL) override;
+
+    /** @copydoc NetworkInterface::getaddrinfo */
+    nsapi_value_or_error_t getaddrinfo(const char *hostname, SocketAddress *hints, SocketAddress **res,
+                                       const char *interface_name = NULL) override;
+
+    /** @copydoc NetworkInterface::gethostbyname_async */
+    nsapi_value_or_error_t gethostbyname_async(const char *host, hostbyname_cb_t callback, nsapi_version_t version = NSAPI_UNSPEC,
+                                               const char *interface_name = NULL) override;
+
+    /** @copydoc NetworkInterface::getaddrinfo_async */
+    nsapi_value_or_error_t getaddrinfo_async(const char *hostname, SocketAddress *hints, hostbyname_cb_t callback,
+                                             const char *interface_name = NULL) override;
+
+    /** @copydoc NetworkInterface::gethostbyname_async_cancel */
+    nsapi_error_t gethostbyname_async_cancel(int id) override;
+
+    /** @copydoc NetworkInterface::add_dns_server */
+    nsapi_error_t add_dns_server(const SocketAddress &address, const char *interface_name) override;
+
+    /** @copydoc NetworkInterface::get_dns_server */
+    nsapi_error_t get_dns_server(int index, SocketAddress *address, const char *interface_name = NULL) override;
+
+    /** @copydoc NetworkInterface::attach */
+    void attach(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb) override;
+
+    /** @copydoc NetworkInterface::get_connection_status */
+    nsapi_connection_status_t get_connection_status() const override;
+
+    /** @copydoc NetworkInterface::set_blocking */
+    nsapi_error_t set_blocking(bool blocking) override;
+
+protected:
+    NetworkStack *get_stack() override;
+
+private:
+    /** State of an interface in the race */
+    enum member_state_t {
+        MEMBER_IDLE,
+        MEMBER_CONNECTING,
+        MEMBER_UP,
+        MEMBER_FAILED,
+        MEMBER_DROPPED      // Lost the race, to be disconnected
+    };
+
+    struct member_t {
+        MultiNetworkInterface *owner;
+        NetworkInterface *iface;
+        member_state_t state;
+        bool preferred;
+        bool blocking;
+
+        void status_cb(nsapi_event_t event, intptr_t value);
+    };
+
+    void member_status(member_t *member, nsapi_connection_status_t status);
+    void grace_expired();
+    void decide();
+    void drop_members();
+    void disconnect_dropped();
+    void cancel_grace();
+    void set_status(nsapi_connection_status_t status);
+
+    mutable rtos::Mutex _mutex;
+    rtos::EventFlags _flags;
+    member_t _members[MBED_CONF_NSAPI_MULTI_INTERFACE_MAX];
+    int _member_count;
+    member_t *_active;
+    member_t *_first_up;
+    std::chrono::milliseconds _grace;
+    int _grace_event;
+    bool _grace_expired;
+    bool _blocking;
+    nsapi_connection_status_t _status;
+    mbed::Callback<void(nsapi_event_t, intptr_t)> _status_cb;
+};
+
+#endif
+
+/** @}*/
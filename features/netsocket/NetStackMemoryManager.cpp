@@ -16,6 +16,19 @@
  */
 
 #include "NetStackMemoryManager.h"
+#if MBED_CONF_NSAPI_DMA_MEMCPY
+#include "drivers/DMAMemcpy.h"
+#endif
+#include <string.h>
+
+static void copy_data(void *dst, const void *src, uint32_t len)
+{
+#if MBED_CONF_NSAPI_DMA_MEMCPY
+    mbed::dma_memcpy(dst, src, len);
+#else
+    memcpy(dst, src, len);
+#endif
+}
 
 void NetStackMemoryManager::copy_to_buf(net_stack_mem_buf_t *to_buf, const void *ptr, uint32_t len)
 {
@@ -30,7 +43,7 @@ void NetStackMemoryManager::copy_to_buf(net_stack_mem_buf_t *to_buf, const void
             len -= copy_to_len;
         }
 
-        memcpy(copy_to_ptr, ptr, copy_to_len);
+        copy_data(copy_to_ptr, ptr, copy_to_len);
         ptr = static_cast<const uint8_t *>(ptr) + copy_to_len;
 
         to_buf = get_next(to_buf);
@@ -52,7 +65,7 @@ uint32_t NetStackMemoryManager::copy_from_buf(void *ptr, uint32_t len, const net
             len -= copy_from_len;
         }
 
-        memcpy(ptr, copy_from_ptr, copy_from_len);
+        copy_data(ptr, copy_from_ptr, copy_from_len);
         ptr = static_cast<uint8_t *>(ptr) + copy_from_len;
         copied_len += copy_from_len;
 
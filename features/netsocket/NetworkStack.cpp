@@ -15,6 +15,7 @@
  */
 
 #include "NetworkStack.h"
+#include "NetStackMemoryManager.h"
 #include "nsapi_dns.h"
 #include "stddef.h"
 #include <new>
@@ -188,6 +189,143 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_send_buf(nsapi_socket_t handle, const net_stack_mem_buf_t *buf, nsapi_size_t offset)
+{
+    NetStackMemoryManager *mem = get_memory_manager();
+    if (!mem) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    nsapi_size_t sent = 0;
+    for (; buf; buf = mem->get_next(buf)) {
+        nsapi_size_t len = mem->get_len(buf);
+        if (offset >= len) {
+            offset -= len;
+            continue;
+        }
+
+        nsapi_size_or_error_t ret = socket_send(handle, static_cast<uint8_t *>(mem->get_ptr(buf)) + offset, len - offset);
+        if (ret < 0) {
+            return sent ? sent : ret;
+        }
+
+        sent += ret;
+        if ((nsapi_size_t)ret < len - offset) {
+            break;
+        }
+        offset = 0;
+    }
+
+    return sent;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf, nsapi_size_t size)
+{
+    *buf = NULL;
+
+    NetStackMemoryManager *mem = get_memory_manager();
+    if (!mem) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    net_stack_mem_buf_t *recv_buf = mem->alloc_heap(size, 0);
+    if (!recv_buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_size_or_error_t ret = socket_recv(handle, mem->get_ptr(recv_buf), size);
+    if (ret <= 0) {
+        mem->free(recv_buf);
+        return ret;
+    }
+
+    mem->set_len(recv_buf, ret);
+    *buf = recv_buf;
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    NetStackMemoryManager *mem = get_memory_manager();
+    if (!mem) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    nsapi_size_or_error_t ret;
+    if (!mem->get_next(buf)) {
+        ret = socket_sendto(handle, address, mem->get_ptr(buf), mem->get_len(buf));
+    } else {
+        // The packet has to go out in one call, so join up the chain
+        uint32_t size = mem->get_total_len(buf);
+        uint8_t *data = new (std::nothrow) uint8_t[size];
+        if (!data) {
+            ret = NSAPI_ERROR_NO_MEMORY;
+        } else {
+            mem->copy_from_buf(data, size, buf);
+            ret = socket_sendto(handle, address, data, size);
+            delete[] data;
+        }
+    }
+
+    if (ret != NSAPI_ERROR_WOULD_BLOCK) {
+        mem->free(buf);
+    }
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address, net_stack_mem_buf_t **buf, nsapi_size_t size)
+{
+    *buf = NULL;
+
+    NetStackMemoryManager *mem = get_memory_manager();
+    if (!mem) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    net_stack_mem_buf_t *recv_buf = mem->alloc_heap(size, 0);
+    if (!recv_buf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_size_or_error_t ret = socket_recvfrom(handle, address, mem->get_ptr(recv_buf), size);
+    if (ret < 0) {
+        mem->free(recv_buf);
+        return ret;
+    }
+
+    mem->set_len(recv_buf, ret);
+    *buf = recv_buf;
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendto_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    nsapi_size_t sent;
+    for (sent = 0; sent < count; sent++) {
+        nsapi_datagram_t &datagram = datagrams[sent];
+        datagram.result = socket_sendto(handle, datagram.address, datagram.data, datagram.size);
+        if (datagram.result < 0) {
+            return sent ? (nsapi_size_or_error_t)sent : datagram.result;
+        }
+    }
+
+    return sent;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_batch(nsapi_socket_t handle, nsapi_datagram_t *datagrams, nsapi_size_t count)
+{
+    nsapi_size_t recv;
+    for (recv = 0; recv < count; recv++) {
+        nsapi_datagram_t &datagram = datagrams[recv];
+        datagram.result = socket_recvfrom(handle, &datagram.address, datagram.data, datagram.size);
+        if (datagram.result < 0) {
+            return recv ? (nsapi_size_or_error_t)recv : datagram.result;
+        }
+    }
+
+    return recv;
+}
+
 nsapi_error_t NetworkStack::call_in(int delay, mbed::Callback<void()> func)
 {
     static events::EventQueue *event_queue = mbed::mbed_event_queue();
@@ -30,6 +30,24 @@
 
 // Predeclared classes
 class OnboardNetworkStack;
+class NetStackMemoryManager;
+typedef void net_stack_mem_buf_t;
+
+/** One datagram of a batched send or receive
+ *
+ *  @see InternetDatagramSocket::sendto_batch
+ *  @see InternetDatagramSocket::recvfrom_batch
+ */
+typedef struct nsapi_datagram {
+    /** Destination address when sending, source address when receiving */
+    SocketAddress address;
+    /** Payload to send, or buffer to receive into */
+    void *data;
+    /** Size of the payload, or of the receive buffer, in bytes */
+    nsapi_size_t size;
+    /** Number of bytes sent or received, or a negative error code */
+    nsapi_size_or_error_t result;
+} nsapi_datagram_t;
 
 /** NetworkStack class
  *
@@ -240,6 +258,19 @@ public:
         return 0;
     }
 
+    /** Get the memory manager of the stack's network buffers
+     *
+     *  Buffers passed to the socket send_buf calls are allocated from it, and
+     *  buffers returned by the recv_buf calls must be freed with it.
+     *
+     *  @return         The memory manager, or NULL if the stack does not
+     *                  expose its buffers
+     */
+    virtual NetStackMemoryManager *get_memory_manager()
+    {
+        return 0;
+    }
+
 protected:
     friend class InternetSocket;
     friend class InternetDatagramSocket;
@@ -394,6 +425,130 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size) = 0;
 
+    /** Send data from a network buffer over a TCP socket
+     *
+     *  Sends the buffer chain from the given offset. Returns the number of
+     *  bytes sent. The caller keeps ownership of the buffer.
+     *
+     *  The default implementation passes each buffer of the chain to
+     *  socket_send in turn.
+     *
+     *  This call is non-blocking. If send would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Buffer chain from get_memory_manager()
+     *  @param offset   Offset in the chain of the first byte to send
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_send_buf(nsapi_socket_t handle,
+                                                  const net_stack_mem_buf_t *buf, nsapi_size_t offset);
+
+    /** Receive data into a network buffer over a TCP socket
+     *
+     *  Returns the number of bytes received and, on success, a buffer chain
+     *  holding them. The caller owns the buffer and must free it with
+     *  get_memory_manager().
+     *
+     *  The default implementation allocates a buffer and calls socket_recv.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received buffer chain
+     *  @param size     Maximum number of bytes to receive
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle,
+                                                  net_stack_mem_buf_t **buf, nsapi_size_t size);
+
+    /** Send a network buffer as a packet over a UDP socket
+     *
+     *  The stack takes ownership of the buffer chain and frees it, unless
+     *  it returns NSAPI_ERROR_WOULD_BLOCK.
+     *
+     *  The default implementation calls socket_sendto, first copying the
+     *  chain into one contiguous block if it has more than one buffer.
+     *
+     *  This call is non-blocking. If sendto would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buf      Buffer chain from get_memory_manager()
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                    net_stack_mem_buf_t *buf);
+
+    /** Receive a packet into a network buffer over a UDP socket
+     *
+     *  Works like socket_recvfrom, but returns the packet in a buffer
+     *  chain that the caller owns and must free with get_memory_manager().
+     *  Packets longer than size are truncated.
+     *
+     *  The default implementation allocates a buffer and calls socket_recvfrom.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buf      Destination for the received buffer chain
+     *  @param size     Maximum number of bytes to receive
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                      net_stack_mem_buf_t **buf, nsapi_size_t size);
+
+    /** Send a batch of packets over a UDP socket
+     *
+     *  Sends the datagrams in order, setting the result of each, and stops
+     *  at the first that cannot be sent. Returns the number of datagrams
+     *  sent, or the error of the first one if none could be sent.
+     *
+     *  The default implementation calls socket_sendto for each datagram.
+     *  Stacks should override it to send the whole batch under one
+     *  acquisition of their lock.
+     *
+     *  This call is non-blocking. If sendto would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to send
+     *  @param count     Number of datagrams
+     *  @return          Number of sent datagrams on success, negative error
+     *                   code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendto_batch(nsapi_socket_t handle,
+                                                      nsapi_datagram_t *datagrams, nsapi_size_t count);
+
+    /** Receive a batch of packets over a UDP socket
+     *
+     *  Receives datagrams into the entries in order, setting the source
+     *  address and result of each, until count are received or no more are
+     *  waiting. Returns the number of datagrams received, or the error of
+     *  the first receive if none were.
+     *
+     *  The default implementation calls socket_recvfrom for each datagram.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle    Socket handle
+     *  @param datagrams Datagrams to receive into
+     *  @param count     Number of entries in datagrams
+     *  @return          Number of received datagrams on success, negative
+     *                   error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t handle,
+                                                        nsapi_datagram_t *datagrams, nsapi_size_t count);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
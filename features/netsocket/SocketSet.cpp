@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSet.h"
+#include "platform/mbed_critical.h"
+#include "rtos/Kernel.h"
+
+SocketSet::SocketSet(unsigned capacity) :
+    _entries(new entry_t[capacity]()),
+    _capacity(capacity),
+    _ready_head(nullptr),
+    _ready_tail(nullptr)
+{
+}
+
+SocketSet::~SocketSet()
+{
+    for (unsigned i = 0; i < _capacity; i++) {
+        if (_entries[i].socket) {
+            remove(_entries[i].socket);
+        }
+    }
+    delete[] _entries;
+}
+
+void SocketSet::entry_t::signal()
+{
+    // May be called from interrupt context
+    core_util_critical_section_enter();
+    if (socket && !ready) {
+        ready = true;
+        next_ready = nullptr;
+        if (set->_ready_tail) {
+            set->_ready_tail->next_ready = this;
+        } else {
+            set->_ready_head = this;
+        }
+        set->_ready_tail = this;
+    }
+    core_util_critical_section_exit();
+
+    set->_event_flag.set(READY_FLAG);
+}
+
+SocketSet::entry_t *SocketSet::find(const Socket *socket)
+{
+    for (unsigned i = 0; i < _capacity; i++) {
+        if (_entries[i].socket == socket) {
+            return &_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+void SocketSet::unlink_ready(entry_t *entry)
+{
+    core_util_critical_section_enter();
+    if (entry->ready) {
+        entry_t *prev = nullptr;
+        for (entry_t *e = _ready_head; e; prev = e, e = e->next_ready) {
+            if (e == entry) {
+                if (prev) {
+                    prev->next_ready = e->next_ready;
+                } else {
+                    _ready_head = e->next_ready;
+                }
+                if (_ready_tail == e) {
+                    _ready_tail = prev;
+                }
+                break;
+            }
+        }
+        entry->ready = false;
+    }
+    core_util_critical_section_exit();
+}
+
+nsapi_error_t SocketSet::add(Socket *socket, short events, void *data)
+{
+    if (!socket) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    if (find(socket)) {
+        _mutex.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+    entry_t *entry = find(nullptr);
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    entry->set = this;
+    entry->events = events;
+    entry->data = data;
+    entry->ready = false;
+    entry->socket = socket;
+    socket->sigio(mbed::callback(entry, &entry_t::signal));
+
+    // Report it once, in case it is already ready
+    entry->signal();
+    _mutex.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SocketSet::modify(Socket *socket, short events, void *data)
+{
+    if (!socket) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    entry_t *entry = find(socket);
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    entry->events = events;
+    entry->data = data;
+    entry->signal();
+    _mutex.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SocketSet::remove(Socket *socket)
+{
+    if (!socket) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    entry_t *entry = find(socket);
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    socket->sigio(nullptr);
+    unlink_ready(entry);
+    entry->socket = nullptr;
+    _mutex.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+int SocketSet::wait(event_t *events, unsigned max_events, int timeout)
+{
+    uint64_t start = rtos::Kernel::get_ms_count();
+
+    for (;;) {
+        unsigned count = 0;
+
+        _mutex.lock();
+        core_util_critical_section_enter();
+        while (count < max_events && _ready_head) {
+            entry_t *entry = _ready_head;
+            _ready_head = entry->next_ready;
+            if (!_ready_head) {
+                _ready_tail = nullptr;
+            }
+            entry->ready = false;
+
+            if (entry->events) {
+                events[count].socket = entry->socket;
+                events[count].events = entry->events;
+                events[count].data = entry->data;
+                count++;
+            }
+        }
+        core_util_critical_section_exit();
+        _mutex.unlock();
+
+        if (count) {
+            return count;
+        }
+
+        uint32_t wait_ms = osWaitForever;
+        if (timeout >= 0) {
+            uint64_t elapsed = rtos::Kernel::get_ms_count() - start;
+            if (elapsed >= (uint64_t)timeout) {
+                return 0;
+            }
+            wait_ms = timeout - elapsed;
+        }
+
+        // The flag can be left over from reports already collected, so
+        // go round again to check the list rather than trusting it
+        uint32_t flag = _event_flag.wait_any(READY_FLAG, wait_ms);
+        if (flag & osFlagsError) {
+            return 0;
+        }
+    }
+}
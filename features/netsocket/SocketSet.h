@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file SocketSet.h Wait for events on multiple sockets */
+/** @addtogroup netsocket
+ * @{ */
+
+#ifndef SOCKETSET_H
+#define SOCKETSET_H
+
+#include "netsocket/Socket.h"
+#include "rtos/EventFlags.h"
+#include "rtos/Mutex.h"
+#include "platform/mbed_poll.h"
+#include "platform/NonCopyable.h"
+
+/** Wait for events on multiple sockets from a single thread.
+ *
+ * Sockets are registered with the events they are of interest for
+ * (POLLIN and/or POLLOUT), and wait() blocks until at least one of them
+ * signals, returning only those sockets. This works with any Socket,
+ * whichever stack provides it.
+ *
+ * The set is built on Socket::sigio(), so registering a socket replaces
+ * any sigio callback already attached to it.
+ *
+ * Reporting is edge-triggered: a socket is reported once after each state
+ * change signal, with the events it was registered for, and the signal may
+ * have been spurious. Registered sockets should be non-blocking, and a
+ * reported socket should be serviced until its calls return
+ * NSAPI_ERROR_WOULD_BLOCK. Each socket is also reported once when it is
+ * added or modified, in case it is already ready.
+ *
+ * The cost of wait() is proportional to the number of sockets reported,
+ * not the number registered.
+ */
+class SocketSet : private mbed::NonCopyable<SocketSet> {
+public:
+    /** Socket event returned by wait() */
+    struct event_t {
+        Socket *socket;     /**< Socket that signalled */
+        short events;       /**< Events the socket is registered for */
+        void *data;         /**< User data given when registering */
+    };
+
+    /** Create a socket set.
+     *
+     *  @param capacity Maximum number of sockets that can be registered.
+     */
+    explicit SocketSet(unsigned capacity);
+
+    /** Destroy a socket set.
+     *
+     *  Removes any sockets still registered.
+     */
+    ~SocketSet();
+
+    /** Register a socket.
+     *
+     *  @param socket   Socket to wait on.
+     *  @param events   Events of interest, POLLIN and/or POLLOUT. A socket
+     *                  registered with no events is never reported.
+     *  @param data     User data to report with the socket's events.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_PARAMETER if the socket is NULL or already registered.
+     *  @retval         NSAPI_ERROR_NO_MEMORY if the set is full.
+     */
+    nsapi_error_t add(Socket *socket, short events, void *data = nullptr);
+
+    /** Change a registered socket's events of interest and user data.
+     *
+     *  @param socket   Registered socket.
+     *  @param events   Events of interest, POLLIN and/or POLLOUT.
+     *  @param data     User data to report with the socket's events.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_PARAMETER if the socket is not registered.
+     */
+    nsapi_error_t modify(Socket *socket, short events, void *data = nullptr);
+
+    /** Deregister a socket.
+     *
+     *  Must be called before a registered socket is closed or destroyed.
+     *  Clears the socket's sigio callback.
+     *
+     *  @param socket   Registered socket.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_PARAMETER if the socket is not registered.
+     */
+    nsapi_error_t remove(Socket *socket);
+
+    /** Wait for registered sockets to signal.
+     *
+     *  @param events       Array to store reported events in.
+     *  @param max_events   Size of the array. Sockets not reported remain
+     *                      pending for the next call.
+     *  @param timeout      Timeout in milliseconds, 0 to return immediately,
+     *                      or -1 to wait forever.
+     *  @return             Number of events stored, or 0 on timeout.
+     */
+    int wait(event_t *events, unsigned max_events, int timeout = -1);
+
+private:
+    struct entry_t {
+        SocketSet *set;
+        Socket *socket;
+        void *data;
+        entry_t *next_ready;
+        short events;
+        bool ready;
+
+        void signal();
+    };
+
+    entry_t *find(const Socket *socket);
+    void unlink_ready(entry_t *entry);
+
+    static const uint32_t READY_FLAG = 0x1u;
+
+    entry_t *_entries;
+    unsigned _capacity;
+    entry_t *_ready_head;
+    entry_t *_ready_tail;
+    rtos::Mutex _mutex;
+    rtos::EventFlags _event_flag;
+};
+
+#endif
+
+/** @}*/
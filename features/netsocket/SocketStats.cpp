@@ -26,6 +26,7 @@
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 SingletonPtr<PlatformMutex> SocketStats::_mutex;
 mbed_stats_socket_t SocketStats::_stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+SocketStats::rate_window_t SocketStats::_rates[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
 uint32_t SocketStats::_size = 0;
 
 int SocketStats::get_entry_position(const Socket *const reference_id)
@@ -38,6 +39,39 @@ int SocketStats::get_entry_position(const Socket *const reference_id)
     return -1;
 }
 
+#ifdef MBED_CONF_RTOS_PRESENT
+uint32_t SocketStats::advance_rate_window(int position)
+{
+    const uint32_t window = MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW;
+    rate_window_t &rate = _rates[position];
+    uint64_t now = rtos::Kernel::get_ms_count();
+    uint64_t elapsed = now - rate.start;
+
+    if (elapsed >= 2 * window) {
+        rate = {};
+        rate.start = now;
+        return 0;
+    }
+    if (elapsed >= window) {
+        rate.sent[1] = rate.sent[0];
+        rate.recv[1] = rate.recv[0];
+        rate.sent[0] = 0;
+        rate.recv[0] = 0;
+        rate.start += window;
+        elapsed -= window;
+    }
+    return elapsed;
+}
+
+static uint32_t window_rate(const size_t bytes[2], uint32_t elapsed)
+{
+    const uint32_t window = MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW;
+    // Count the part of the previous window still covered by the sliding window
+    uint64_t total = (uint64_t)bytes[1] * (window - elapsed) / window + bytes[0];
+    return total * 1000 / window;
+}
+#endif
+
 size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_t count)
 {
     MBED_ASSERT(stats != NULL);
@@ -45,6 +79,11 @@ size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_
     _mutex->lock();
     for (j = 0; j < count && j < _size; j++) {
         stats[j] = _stats[j];
+#ifdef MBED_CONF_RTOS_PRESENT
+        uint32_t elapsed = advance_rate_window(j);
+        stats[j].sent_bytes_per_sec = window_rate(_rates[j].sent, elapsed);
+        stats[j].recv_bytes_per_sec = window_rate(_rates[j].recv, elapsed);
+#endif
     }
     _mutex->unlock();
     return j;
@@ -77,6 +116,7 @@ void SocketStats::stats_new_socket_entry(Socket *const reference_id)
         }
         _stats[position] = {};
         _stats[position].reference_id = reference_id;
+        _rates[position] = {};
     }
     _mutex->unlock();
 }
@@ -120,6 +160,10 @@ void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size
     int position = get_entry_position(reference_id);
     if ((position >= 0) && ((int32_t)sent_bytes > 0)) {
         _stats[position].sent_bytes += sent_bytes;
+#ifdef MBED_CONF_RTOS_PRESENT
+        advance_rate_window(position);
+        _rates[position].sent[0] += sent_bytes;
+#endif
     }
     _mutex->unlock();
 }
@@ -130,6 +174,57 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
     int position = get_entry_position(reference_id);
     if ((position >= 0) && ((int32_t)recv_bytes > 0)) {
         _stats[position].recv_bytes += recv_bytes;
+#ifdef MBED_CONF_RTOS_PRESENT
+        advance_rate_window(position);
+        _rates[position].recv[0] += recv_bytes;
+#endif
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_tls(const Socket *const reference_id, size_t max_fragment_len, size_t record_len)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        if (max_fragment_len) {
+            _stats[position].tls_max_fragment_len = max_fragment_len;
+        }
+        if (record_len > _stats[position].tls_record_peak) {
+            _stats[position].tls_record_peak = record_len;
+        }
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_send_call(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].send_calls++;
+        _stats[position].send_blocked_ms += blocked_ms;
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_recv_call(const Socket *const reference_id, uint32_t wait_ms)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].recv_calls++;
+        _stats[position].recv_wait_ms += wait_ms;
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_retransmissions(const Socket *const reference_id, uint32_t retransmissions)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].tcp_retransmissions = retransmissions;
     }
     _mutex->unlock();
 }
@@ -27,6 +27,10 @@
 #define MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT      10
 #endif
 
+#ifndef MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW
+#define MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW    1000
+#endif
+
 /** Enum of socket states
   *
   * Can be used to specify current state of socket - open, closed, connected or listen.
@@ -50,6 +54,15 @@ typedef struct {
     size_t sent_bytes;              /**< Data sent through this socket */
     size_t recv_bytes;              /**< Data received through this socket */
     us_timestamp_t last_change_tick;/**< osKernelGetTick() when state last changed */
+    size_t tls_max_fragment_len;    /**< Maximum TLS record payload in force on this socket, 0 if no TLS handshake completed */
+    size_t tls_record_peak;         /**< Largest TLS record sent or received through this socket */
+    size_t send_calls;              /**< Number of send calls made on this socket, including failed ones */
+    size_t recv_calls;              /**< Number of receive calls made on this socket, including failed ones */
+    uint32_t sent_bytes_per_sec;    /**< Send rate over the last `socket-stats-rate-window` milliseconds */
+    uint32_t recv_bytes_per_sec;    /**< Receive rate over the last `socket-stats-rate-window` milliseconds */
+    uint32_t send_blocked_ms;       /**< Total time send calls spent blocked waiting for the stack to take data */
+    uint32_t recv_wait_ms;          /**< Total time receive calls spent waiting for data to arrive */
+    uint32_t tcp_retransmissions;   /**< TCP segments retransmitted, as reported by the stack, 0 if it doesn't report them */
 } mbed_stats_socket_t;
 
 /**  SocketStats class
@@ -140,9 +153,54 @@ public:
      */
     void stats_update_recv_bytes(const Socket *reference_id, size_t recv_bytes);
 
+    /** Update TLS record sizes of the socket carrying a TLS connection.
+     *  API used by TLS layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify the transport socket in data array.
+     *  @param max_fragment_len Maximum record payload in force, or 0 to leave it unchanged.
+     *  @param record_len Size of a record, kept if it is the largest so far.
+     *
+     */
+    void stats_update_tls(const Socket *reference_id, size_t max_fragment_len, size_t record_len);
+
+    /** Count a send call on the socket and the time it spent blocked.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param blocked_ms Milliseconds the call waited for the stack to accept data.
+     *
+     */
+    void stats_update_send_call(const Socket *reference_id, uint32_t blocked_ms);
+
+    /** Count a receive call on the socket and the time it spent waiting.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param wait_ms Milliseconds the call waited for data to arrive.
+     *
+     */
+    void stats_update_recv_call(const Socket *reference_id, uint32_t wait_ms);
+
+    /** Update the TCP retransmission count reported by the stack.
+     *  API used by socket (TCP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param retransmissions Total retransmissions on the connection so far.
+     *
+     */
+    void stats_update_retransmissions(const Socket *reference_id, uint32_t retransmissions);
+
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 private:
+    /** Byte counts of the current and previous rate window of a socket */
+    struct rate_window_t {
+        uint64_t start;
+        size_t sent[2];
+        size_t recv[2];
+    };
+
     static mbed_stats_socket_t _stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+    static rate_window_t _rates[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
     static SingletonPtr<PlatformMutex> _mutex;
     static uint32_t _size;
 
@@ -152,6 +210,13 @@ private:
      *
      */
     int get_entry_position(const Socket *reference_id);
+
+    /** Internal function to move the rate window of an entry up to the current time.
+     *
+     *  @param position Position of the entry in the data array.
+     *  @return         Milliseconds elapsed in the current window.
+     */
+    static uint32_t advance_rate_window(int position);
 #endif
 #endif
 };
@@ -185,6 +250,22 @@ inline void SocketStats::stats_update_sent_bytes(const Socket *, size_t)
 inline void SocketStats::stats_update_recv_bytes(const Socket *, size_t)
 {
 }
+
+inline void SocketStats::stats_update_tls(const Socket *, size_t, size_t)
+{
+}
+
+inline void SocketStats::stats_update_send_call(const Socket *, uint32_t)
+{
+}
+
+inline void SocketStats::stats_update_recv_call(const Socket *, uint32_t)
+{
+}
+
+inline void SocketStats::stats_update_retransmissions(const Socket *, uint32_t)
+{
+}
 #endif // !MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 
 #endif
@@ -15,8 +15,10 @@
  */
 
 #include "TCPSocket.h"
+#include "NetStackMemoryManager.h"
 #include "Timer.h"
 #include "mbed_assert.h"
+#include "rtos/Kernel.h"
 
 TCPSocket::TCPSocket()
 {
@@ -100,11 +102,29 @@ nsapi_error_t TCPSocket::connect(const SocketAddress &address)
 }
 
 nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
+{
+    return send_internal(data, NULL, size);
+}
+
+nsapi_size_or_error_t TCPSocket::send_buf(net_stack_mem_buf_t *buf)
+{
+    NetStackMemoryManager *mem = get_memory_manager();
+    if (!mem) {
+        return _socket ? NSAPI_ERROR_UNSUPPORTED : NSAPI_ERROR_NO_SOCKET;
+    }
+
+    nsapi_size_or_error_t ret = send_internal(NULL, buf, mem->get_total_len(buf));
+    mem->free(buf);
+    return ret;
+}
+
+nsapi_size_or_error_t TCPSocket::send_internal(const void *data, const net_stack_mem_buf_t *buf, nsapi_size_t size)
 {
     _lock.lock();
     const uint8_t *data_ptr = static_cast<const uint8_t *>(data);
     nsapi_size_or_error_t ret;
     nsapi_size_t written = 0;
+    uint32_t blocked_ms = 0;
 
     // If this assert is hit then there are two threads
     // performing a send at the same time which is undefined
@@ -122,7 +142,11 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         }
 
         core_util_atomic_flag_clear(&_pending);
-        ret = _stack->socket_send(_socket, data_ptr + written, size - written);
+        if (buf) {
+            ret = _stack->socket_send_buf(_socket, buf, written);
+        } else {
+            ret = _stack->socket_send(_socket, data_ptr + written, size - written);
+        }
         if (ret >= 0) {
             written += ret;
             if (written >= size) {
@@ -137,7 +161,9 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t wait_start = rtos::Kernel::get_ms_count();
             flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            blocked_ms += rtos::Kernel::get_ms_count() - wait_start;
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -154,6 +180,17 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         _event_flag.set(FINISHED_FLAG);
     }
 
+    _socket_stats.stats_update_send_call(this, blocked_ms);
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
+    if (_socket && written > 0) {
+        uint32_t retransmissions;
+        unsigned len = sizeof retransmissions;
+        if (_stack->getsockopt(_socket, NSAPI_SOCKET, NSAPI_RETRANSMISSIONS, &retransmissions, &len) == NSAPI_ERROR_OK) {
+            _socket_stats.stats_update_retransmissions(this, retransmissions);
+        }
+    }
+#endif
+
     _lock.unlock();
     if (ret <= 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
         return ret;
@@ -172,9 +209,25 @@ nsapi_size_or_error_t TCPSocket::sendto(const SocketAddress &address, const void
 }
 
 nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
+{
+    return recv_internal(data, NULL, size);
+}
+
+nsapi_size_or_error_t TCPSocket::recv_buf(net_stack_mem_buf_t **buf, nsapi_size_t size)
+{
+    *buf = NULL;
+    if (!get_memory_manager()) {
+        return _socket ? NSAPI_ERROR_UNSUPPORTED : NSAPI_ERROR_NO_SOCKET;
+    }
+
+    return recv_internal(NULL, buf, size);
+}
+
+nsapi_size_or_error_t TCPSocket::recv_internal(void *data, net_stack_mem_buf_t **buf, nsapi_size_t size)
 {
     _lock.lock();
     nsapi_size_or_error_t ret;
+    uint32_t wait_ms = 0;
 
     // If this assert is hit then there are two threads
     // performing a recv at the same time which is undefined
@@ -189,7 +242,11 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
         }
 
         core_util_atomic_flag_clear(&_pending);
-        ret = _stack->socket_recv(_socket, data, size);
+        if (buf) {
+            ret = _stack->socket_recv_buf(_socket, buf, size);
+        } else {
+            ret = _stack->socket_recv(_socket, data, size);
+        }
         if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
             _socket_stats.stats_update_recv_bytes(this, ret);
             break;
@@ -199,7 +256,9 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
+            uint64_t wait_start = rtos::Kernel::get_ms_count();
             flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            wait_ms += rtos::Kernel::get_ms_count() - wait_start;
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -215,6 +274,7 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
         _event_flag.set(FINISHED_FLAG);
     }
 
+    _socket_stats.stats_update_recv_call(this, wait_ms);
     _lock.unlock();
     return ret;
 }
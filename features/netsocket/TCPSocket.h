@@ -144,6 +144,43 @@ public:
     nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                    void *data, nsapi_size_t size) override;
 
+    /** Send data from a network buffer over a TCP socket
+     *
+     *  Works like send(), but takes the data in a buffer chain allocated
+     *  from get_memory_manager(), so it can be filled in place. The socket
+     *  takes ownership of the buffer and frees it before returning, whether
+     *  or not all of it was sent.
+     *
+     *  @param buf      Buffer chain of data to send to the host
+     *  @retval         int Number of sent bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack does not expose its buffers
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_send_buf.
+     */
+    nsapi_size_or_error_t send_buf(net_stack_mem_buf_t *buf);
+
+    /** Receive data into a network buffer over a TCP socket
+     *
+     *  Works like recv(), but returns the data in a buffer chain, which the
+     *  stack may hand over without copying. On success the caller owns the
+     *  buffer and must free it with get_memory_manager().
+     *
+     *  @param buf      Destination for the buffer chain, set to NULL if no
+     *                  data is returned
+     *  @param size     Maximum number of bytes to receive
+     *  @retval         int Number of received bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack does not expose its buffers
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_recv_buf.
+     */
+    nsapi_size_or_error_t recv_buf(net_stack_mem_buf_t **buf, nsapi_size_t size);
+
     /** Accepts a connection on a socket.
      *
      *  The server socket must be bound and set to listen for connections.
@@ -185,6 +222,14 @@ private:
      *  To be used within accept() function. Close() will clean this up.
      */
     TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress address);
+
+    /** Send from either a plain buffer or a buffer chain, whichever is not NULL
+     */
+    nsapi_size_or_error_t send_internal(const void *data, const net_stack_mem_buf_t *buf, nsapi_size_t size);
+
+    /** Receive into either a plain buffer or a buffer chain, whichever is not NULL
+     */
+    nsapi_size_or_error_t recv_internal(void *data, net_stack_mem_buf_t **buf, nsapi_size_t size);
 };
 
 
@@ -24,16 +24,203 @@
 #include "mbed-trace/mbed_trace.h"
 #include "mbedtls/debug.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "mbed_error.h"
 #include "Kernel.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include <algorithm>
+
+#ifndef MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+#define MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE 4
+#endif
+
+#ifndef MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH
+#define MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH 0
+#endif
+
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBED_CONF_NSAPI_TLS_SESSION_CACHE_KVSTORE)
+#include "kvstore_global_api.h"
+#endif
+
+#if MBED_CONF_MBEDTLS_SHARED_DRBG
+#include "mbed_shared_drbg.h"
+#endif
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+#include "platform/mbed_stats.h"
+#include "hal/us_ticker_api.h"
+#endif
 
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C)
 
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+static unsigned char tls_max_frag_len_code(size_t length)
+{
+    switch (length) {
+        case 0:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+        case 512:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_512;
+        case 1024:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+        case 2048:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+        case 4096:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+        default:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_INVALID;
+    }
+}
+#endif
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+static uint64_t profile_now_us()
+{
+#if DEVICE_USTICKER
+    return ticker_read_us(get_us_ticker_data());
+#else
+    return rtos::Kernel::get_ms_count() * 1000;
+#endif
+}
+
+// heap in use, and the high-water mark in max_size
+static uint32_t profile_heap(uint32_t *max_size)
+{
+    mbed_stats_heap_t stats;
+    mbed_stats_heap_get(&stats);
+    *max_size = stats.max_size;
+    return stats.current_size;
+}
+#endif
+
+static const char *tls_session_hostname(const mbedtls_ssl_context *ssl)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && !defined(MBEDTLS_X509_REMOVE_HOSTNAME_VERIFICATION)
+    return ssl->hostname;
+#else
+    return nullptr;
+#endif
+}
+
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+// A cache entry holds the NUL terminated hostname followed by the session
+// serialized by mbedtls_ssl_session_save(). KVStore keeps the same bytes.
+struct TLS_SESSION_CACHE {
+    unsigned char *data;
+    size_t len;
+    uint32_t used;
+};
+
+static TLS_SESSION_CACHE tls_session_cache[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+static uint32_t tls_session_clock;
+// Protects cache shared between all sockets
+static SingletonPtr<PlatformMutex> tls_session_mutex;
+
+static int tls_session_cache_find(const char *hostname)
+{
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i].data && strcmp(reinterpret_cast<const char *>(tls_session_cache[i].data), hostname) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void tls_session_cache_drop(int i)
+{
+    // Sessions hold the master secret
+    mbedtls_platform_zeroize(tls_session_cache[i].data, tls_session_cache[i].len);
+    delete[] tls_session_cache[i].data;
+    tls_session_cache[i].data = nullptr;
+    tls_session_cache[i].len = 0;
+}
+
+// Takes ownership of data, called with tls_session_mutex locked
+static int tls_session_cache_put(unsigned char *data, size_t len)
+{
+    // Replaces the host's previous session, otherwise a free or the least recently used entry
+    int i = tls_session_cache_find(reinterpret_cast<const char *>(data));
+    if (i < 0) {
+        i = 0;
+        for (int j = 0; j < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; j++) {
+            if (!tls_session_cache[j].data) {
+                i = j;
+                break;
+            }
+            if (tls_session_cache[j].used < tls_session_cache[i].used) {
+                i = j;
+            }
+        }
+    }
+    if (tls_session_cache[i].data) {
+        tls_session_cache_drop(i);
+    }
+
+    tls_session_cache[i].data = data;
+    tls_session_cache[i].len = len;
+    tls_session_cache[i].used = ++tls_session_clock;
+    return i;
+}
+
+#if defined(MBED_CONF_NSAPI_TLS_SESSION_CACHE_KVSTORE)
+#define TLS_SESSION_KV_PREFIX MBED_CONF_NSAPI_TLS_SESSION_CACHE_KVSTORE "tls"
+
+// Host names may hold characters KVStore does not allow, so keys are made of their hash
+static void tls_session_kv_key(const char *hostname, char *key, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    while (*hostname) {
+        hash = (hash ^ static_cast<uint8_t>(*hostname++)) * 16777619u;
+    }
+    snprintf(key, size, TLS_SESSION_KV_PREFIX "%08lx", (unsigned long) hash);
+}
+
+// Reads a session saved before a reboot into the cache, called with tls_session_mutex locked
+static int tls_session_kv_load(const char *hostname)
+{
+    char key[KV_MAX_KEY_LENGTH];
+    tls_session_kv_key(hostname, key, sizeof(key));
+
+    kv_info_t info;
+    size_t host_len = strlen(hostname) + 1;
+    if (kv_get_info(key, &info) != MBED_SUCCESS || info.size <= host_len) {
+        return -1;
+    }
+
+    unsigned char *data = new (std::nothrow) unsigned char[info.size];
+    if (!data) {
+        return -1;
+    }
+
+    size_t len;
+    // Another host with the same hash is treated as a miss
+    if (kv_get(key, data, info.size, &len) != MBED_SUCCESS || len != info.size ||
+            memcmp(data, hostname, host_len) != 0) {
+        mbedtls_platform_zeroize(data, info.size);
+        delete[] data;
+        return -1;
+    }
+    return tls_session_cache_put(data, len);
+}
+
+static void tls_session_kv_remove(const char *hostname)
+{
+    char key[KV_MAX_KEY_LENGTH];
+    tls_session_kv_key(hostname, key, sizeof(key));
+    kv_remove(key);
+}
+#endif
+#endif /* MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0 */
+
 TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, control_transport control) :
     _transport(transport),
     _connect_transport(control == TRANSPORT_CONNECT || control == TRANSPORT_CONNECT_AND_CLOSE),
     _close_transport(control == TRANSPORT_CLOSE || control == TRANSPORT_CONNECT_AND_CLOSE),
+    _session_resumption(MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0),
+    _session_offered(false),
+    _session_resumed(false),
     _tls_initialized(false),
     _handshake_completed(false),
     _cacert_allocated(false),
@@ -161,7 +348,9 @@ nsapi_error_t TLSSocketWrapper::set_client_cert_key(const void *client_cert, siz
 
 nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
 {
+#if !MBED_CONF_MBEDTLS_SHARED_DRBG
     const char DRBG_PERS[] = "mbed TLS client";
+#endif
     int ret;
 
     if (!_transport) {
@@ -180,7 +369,9 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     /*
      * Initialize TLS-related stuf.
      */
-#if defined(MBEDTLS_CTR_DRBG_C)
+#if MBED_CONF_MBEDTLS_SHARED_DRBG
+    // The system-wide DRBG is already seeded, no entropy gathering per socket
+#elif defined(MBEDTLS_CTR_DRBG_C)
     if ((ret = mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy,
                                      (const unsigned char *) DRBG_PERS,
                                      sizeof(DRBG_PERS))) != 0) {
@@ -200,8 +391,12 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
 #endif
 
 #if !defined(MBEDTLS_SSL_CONF_RNG)
+#if MBED_CONF_MBEDTLS_SHARED_DRBG
+    mbedtls_ssl_conf_rng(get_ssl_config(), mbed_shared_drbg_random, nullptr);
+#else
     mbedtls_ssl_conf_rng(get_ssl_config(), DRBG_RANDOM, &_drbg);
 #endif
+#endif
 
 
 #if MBED_CONF_TLS_SOCKET_DEBUG_LEVEL > 0
@@ -216,6 +411,11 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
         return NSAPI_ERROR_AUTH_FAILURE;
     }
 
+    if ((ret = configure_ssl_context()) != 0) {
+        print_mbedtls_error("configure_ssl_context", ret);
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+
     _transport->set_blocking(false);
     _transport->sigio(mbed::callback(this, &TLSSocketWrapper::event));
 
@@ -228,6 +428,16 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     mbedtls_ssl_set_bio_ctx(&_ssl, this);
 #endif /* !defined(MBEDTLS_SSL_CONF_RECV) && !defined(MBEDTLS_SSL_CONF_SEND) && !defined(MBEDTLS_SSL_CONF_RECV_TIMEOUT) */
 
+    load_session();
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+    uint32_t max_size;
+    _profile = {};
+    _profile_start_us = profile_now_us();
+    _profile_mark_us = _profile_start_us;
+    _profile_heap_base = profile_heap(&max_size);
+#endif
+
     _tls_initialized = true;
 
     ret = continue_handshake();
@@ -255,7 +465,7 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     }
 
     while (true) {
-        ret = mbedtls_ssl_handshake(&_ssl);
+        ret = handshake();
         if (_timeout && (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
             uint32_t flag;
             flag = _event_flag.wait_any(1, _timeout);
@@ -272,6 +482,10 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
         if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
             return NSAPI_ERROR_ALREADY;
         } else {
+            // Don't offer the same session again, in case it was the cause
+            if (_session_offered) {
+                clear_session_cache(tls_session_hostname(&_ssl));
+            }
             return NSAPI_ERROR_AUTH_FAILURE;
         }
     }
@@ -303,10 +517,244 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     delete[] buf;
 #endif
 
+    save_session();
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+    _profile.total_us = profile_now_us() - _profile_start_us;
+    tr_info("TLS handshake took %lu us, heap peak %lu", (unsigned long) _profile.total_us,
+            (unsigned long) _profile.heap_peak);
+    for (int state = 0; state <= MBEDTLS_SSL_SERVER_HELLO_VERIFY_REQUEST_SENT; state++) {
+        const handshake_state_profile_t &profile = _profile.states[state];
+        if (profile.steps) {
+            tr_debug("  state %d: start %lu us, %lu us in %u steps, heap peak %lu", state,
+                     (unsigned long) profile.start_us, (unsigned long) profile.time_us,
+                     profile.steps, (unsigned long) profile.heap_peak);
+        }
+    }
+#endif
+
+    _socket_stats.stats_update_tls(_transport, get_max_fragment_length(), _record_peak);
+
     _handshake_completed = true;
     return NSAPI_ERROR_IS_CONNECTED;
 }
 
+int TLSSocketWrapper::handshake()
+{
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+    // Same loop as mbedtls_ssl_handshake(), measuring each step
+    int ret = 0;
+    while (_ssl.state != MBEDTLS_SSL_HANDSHAKE_OVER) {
+        int state = _ssl.state;
+        uint32_t max_before, max_after;
+        uint32_t heap_before = profile_heap(&max_before);
+        uint64_t start_us = profile_now_us();
+
+        ret = mbedtls_ssl_handshake_step(&_ssl);
+
+        uint64_t end_us = profile_now_us();
+        uint32_t heap_after = profile_heap(&max_after);
+        uint32_t peak = max_after > max_before ? max_after : std::max(heap_before, heap_after);
+        peak = peak > _profile_heap_base ? peak - _profile_heap_base : 0;
+
+        if (state <= MBEDTLS_SSL_SERVER_HELLO_VERIFY_REQUEST_SENT) {
+            handshake_state_profile_t &profile = _profile.states[state];
+            if (!profile.steps) {
+                profile.start_us = start_us - _profile_start_us;
+            }
+            profile.time_us += end_us - _profile_mark_us;
+            profile.heap_peak = std::max(profile.heap_peak, peak);
+            profile.steps++;
+            if (_profile_cb && _ssl.state != state) {
+                _profile_cb(state, profile);
+            }
+        }
+        _profile.heap_peak = std::max(_profile.heap_peak, peak);
+        _profile_mark_us = end_us;
+
+        if (ret != 0) {
+            break;
+        }
+    }
+    return ret;
+#else
+    return mbedtls_ssl_handshake(&_ssl);
+#endif
+}
+
+void TLSSocketWrapper::load_session()
+{
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+    const char *hostname = tls_session_hostname(&_ssl);
+    if (!_session_resumption || !hostname) {
+        return;
+    }
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+
+    tls_session_mutex->lock();
+    int i = tls_session_cache_find(hostname);
+#if defined(MBED_CONF_NSAPI_TLS_SESSION_CACHE_KVSTORE)
+    if (i < 0) {
+        i = tls_session_kv_load(hostname);
+    }
+#endif
+    if (i >= 0) {
+        size_t host_len = strlen(hostname) + 1;
+        int ret = mbedtls_ssl_session_load(&session, tls_session_cache[i].data + host_len,
+                                           tls_session_cache[i].len - host_len);
+        if (ret == 0) {
+            ret = mbedtls_ssl_set_session(&_ssl, &session);
+        }
+        if (ret == 0) {
+            tls_session_cache[i].used = ++tls_session_clock;
+            // A resumed handshake keeps the master secret, a full one makes a new one
+            memcpy(_session_check, session.master, sizeof(_session_check));
+            _session_offered = true;
+            tr_debug("Offering cached TLS session");
+        } else {
+            // Saved by an incompatible Mbed TLS version or configuration
+            print_mbedtls_error("mbedtls_ssl_session_load", ret);
+            tls_session_cache_drop(i);
+        }
+    }
+    tls_session_mutex->unlock();
+
+    mbedtls_ssl_session_free(&session);
+#endif
+}
+
+void TLSSocketWrapper::save_session()
+{
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+    _session_resumed = _session_offered && memcmp(_ssl.session->master, _session_check, sizeof(_session_check)) == 0;
+    mbedtls_platform_zeroize(_session_check, sizeof(_session_check));
+    if (_session_resumed) {
+        tr_info("TLS session resumed");
+    }
+
+    const char *hostname = tls_session_hostname(&_ssl);
+    if (!_session_resumption || !hostname) {
+        return;
+    }
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+
+    size_t len = 0;
+    size_t host_len = strlen(hostname) + 1;
+    unsigned char *data = nullptr;
+    if (mbedtls_ssl_get_session(&_ssl, &session) == 0 &&
+            mbedtls_ssl_session_save(&session, nullptr, 0, &len) == MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL && len) {
+        data = new (std::nothrow) unsigned char[host_len + len];
+    }
+    if (data) {
+        memcpy(data, hostname, host_len);
+        if (mbedtls_ssl_session_save(&session, data + host_len, len, &len) == 0) {
+#if defined(MBED_CONF_NSAPI_TLS_SESSION_CACHE_KVSTORE)
+            // Resumed sessions are already stored, which spares the flash
+            if (!_session_resumed) {
+                char key[KV_MAX_KEY_LENGTH];
+                tls_session_kv_key(hostname, key, sizeof(key));
+                kv_set(key, data, host_len + len, KV_REQUIRE_CONFIDENTIALITY_FLAG);
+            }
+#endif
+            tls_session_mutex->lock();
+            tls_session_cache_put(data, host_len + len);
+            tls_session_mutex->unlock();
+        } else {
+            mbedtls_platform_zeroize(data, host_len + len);
+            delete[] data;
+        }
+    }
+
+    mbedtls_ssl_session_free(&session);
+#endif
+}
+
+nsapi_error_t TLSSocketWrapper::set_max_fragment_length(size_t length)
+{
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    unsigned char code = tls_max_frag_len_code(length);
+    if (code == MBEDTLS_SSL_MAX_FRAG_LEN_INVALID) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    mbedtls_ssl_conf_max_frag_len(get_ssl_config(), code);
+    return NSAPI_ERROR_OK;
+#else
+    return length ? NSAPI_ERROR_UNSUPPORTED : NSAPI_ERROR_OK;
+#endif
+}
+
+size_t TLSSocketWrapper::get_max_fragment_length() const
+{
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    if (_tls_initialized && _ssl.state == MBEDTLS_SSL_HANDSHAKE_OVER) {
+        return mbedtls_ssl_get_max_frag_len(&_ssl);
+    }
+#endif
+    return 0;
+}
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+const TLSSocketWrapper::handshake_profile_t &TLSSocketWrapper::get_handshake_profile() const
+{
+    return _profile;
+}
+
+void TLSSocketWrapper::set_handshake_profile_callback(mbed::Callback<void(int, const handshake_state_profile_t &)> func)
+{
+    _profile_cb = func;
+}
+#endif
+
+void TLSSocketWrapper::update_record_peak(size_t len)
+{
+    // Only growth is reported, so the statistics lock is rarely taken
+    if (len > _record_peak) {
+        _record_peak = len;
+        _socket_stats.stats_update_tls(_transport, 0, len);
+    }
+}
+
+void TLSSocketWrapper::set_session_resumption(bool enabled)
+{
+    _session_resumption = enabled && MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0;
+}
+
+bool TLSSocketWrapper::is_session_resumed() const
+{
+    return _session_resumed;
+}
+
+void TLSSocketWrapper::clear_session_cache(const char *hostname)
+{
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0)
+    tls_session_mutex->lock();
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i].data && (!hostname || strcmp(reinterpret_cast<const char *>(tls_session_cache[i].data), hostname) == 0)) {
+            tls_session_cache_drop(i);
+        }
+    }
+#if defined(MBED_CONF_NSAPI_TLS_SESSION_CACHE_KVSTORE)
+    if (hostname) {
+        tls_session_kv_remove(hostname);
+    } else {
+        kv_iterator_t it;
+        if (kv_iterator_open(&it, TLS_SESSION_KV_PREFIX) == MBED_SUCCESS) {
+            char key[KV_MAX_KEY_LENGTH];
+            while (kv_iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+                kv_remove(key);
+            }
+            kv_iterator_close(it);
+        }
+    }
+#endif
+    tls_session_mutex->unlock();
+#endif
+}
+
 
 nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
 {
@@ -493,6 +941,12 @@ int TLSSocketWrapper::ssl_recv(void *ctx, unsigned char *buf, size_t len)
 
     recv = my->_transport->recv(buf, len);
 
+    // Over a stream, Mbed TLS asks for the rest of the record being read.
+    // Over datagrams, it offers its whole buffer and gets what arrived.
+    if (recv > 0) {
+        my->update_record_peak(my->_ssl_conf->transport == MBEDTLS_SSL_TRANSPORT_DATAGRAM ? recv : len);
+    }
+
     if (NSAPI_ERROR_WOULD_BLOCK == recv) {
         return MBEDTLS_ERR_SSL_WANT_READ;
     } else if (recv < 0) {
@@ -513,6 +967,10 @@ int TLSSocketWrapper::ssl_send(void *ctx, const unsigned char *buf, size_t len)
 
     size = my->_transport->send(buf, len);
 
+    if (size > 0) {
+        my->update_record_peak(len);
+    }
+
     if (NSAPI_ERROR_WOULD_BLOCK == size) {
         return MBEDTLS_ERR_SSL_WANT_WRITE;
     } else if (size < 0) {
@@ -586,6 +1044,9 @@ mbedtls_ssl_config *TLSSocketWrapper::get_ssl_config()
          * MBEDTLS_SSL_VERIFY_NONE in the call to mbedtls_ssl_conf_authmode()
          */
         mbedtls_ssl_conf_authmode(get_ssl_config(), MBEDTLS_SSL_VERIFY_REQUIRED);
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH) && (MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH > 0)
+        mbedtls_ssl_conf_max_frag_len(_ssl_conf, tls_max_frag_len_code(MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH));
+#endif
     }
     return _ssl_conf;
 }
@@ -725,6 +1186,11 @@ bool TLSSocketWrapper::is_handshake_started() const
     return _tls_initialized;
 }
 
+int TLSSocketWrapper::configure_ssl_context()
+{
+    return 0;
+}
+
 
 nsapi_error_t TLSSocketWrapper::getpeername(SocketAddress *address)
 {
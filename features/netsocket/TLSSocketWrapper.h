@@ -23,6 +23,7 @@
 #define _MBED_HTTPS_TLS_SOCKET_WRAPPER_H_
 
 #include "netsocket/Socket.h"
+#include "netsocket/SocketStats.h"
 #include "rtos/EventFlags.h"
 #include "platform/Callback.h"
 #include "mbedtls/platform.h"
@@ -137,6 +138,109 @@ public:
      */
     nsapi_error_t set_client_cert_key(const char *client_cert_pem, const char *client_private_key_pem);
 
+    /** Enable or disable resuming earlier sessions with the same host.
+     *
+     * Sessions of completed handshakes are kept in a cache shared by all
+     * sockets and keyed by hostname, holding nsapi.tls-session-cache-size
+     * entries. A later handshake with the same host offers the session ID
+     * or session ticket (RFC 5077), which lets the server skip the key
+     * exchange. If the server declines, a full handshake follows as usual.
+     * When nsapi.tls-session-cache-kvstore is set, sessions are also saved
+     * to KVStore and survive a reboot.
+     *
+     * Enabled by default when the cache is configured.
+     *
+     * @note Must be called before calling connect(). Needs the hostname, see @ref set_hostname.
+     *
+     * @param enabled True to offer and save sessions.
+     */
+    void set_session_resumption(bool enabled);
+
+    /** Check whether the handshake resumed a cached session.
+     *
+     * @return True if the server accepted the offered session.
+     */
+    bool is_session_resumed() const;
+
+    /** Forget cached sessions, including those saved to KVStore.
+     *
+     * @param hostname Host whose session is dropped, or NULL to drop all.
+     */
+    static void clear_session_cache(const char *hostname = NULL);
+
+    /** Ask the server to limit the size of TLS records.
+     *
+     * Negotiates the max_fragment_length extension (RFC 6066), so that records
+     * from either side carry at most the given payload. Defaults to
+     * nsapi.tls-max-fragment-length. Servers that don't support the extension
+     * ignore it and keep sending records of up to 16 KB.
+     *
+     * Mbed TLS allocates record buffers of MBEDTLS_SSL_IN_CONTENT_LEN and
+     * MBEDTLS_SSL_OUT_CONTENT_LEN for every connection. Once the servers in
+     * use are known to accept the extension, those can be lowered to the
+     * negotiated size. The negotiated size and the largest record seen are
+     * reported through SocketStats for the transport socket.
+     *
+     * @note Must be called before calling connect().
+     *
+     * @param length Largest record payload: 512, 1024, 2048 or 4096, or 0 not to ask.
+     * @retval NSAPI_ERROR_OK on success.
+     * @retval NSAPI_ERROR_PARAMETER if the length is not one of the above.
+     * @retval NSAPI_ERROR_UNSUPPORTED if Mbed TLS was built without MBEDTLS_SSL_MAX_FRAGMENT_LENGTH.
+     */
+    nsapi_error_t set_max_fragment_length(size_t length);
+
+    /** Get the maximum record payload in force on the connection.
+     *
+     * @return Negotiated or configured length in bytes, 0 if the handshake
+     *         hasn't completed or the extension isn't supported.
+     */
+    size_t get_max_fragment_length() const;
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING || defined(DOXYGEN_ONLY)
+    /** Time and heap used by one state of the handshake */
+    struct handshake_state_profile_t {
+        uint32_t start_us;      /**< Time from the start of the handshake to the first entry in the state */
+        uint32_t time_us;       /**< Time spent in the state, including waits for the peer */
+        uint32_t heap_peak;     /**< Highest heap use seen in the state, above the use at the start of the handshake */
+        uint16_t steps;         /**< Number of times the state ran, more than once if it waited for the peer */
+    };
+
+    /** Profile of a handshake */
+    struct handshake_profile_t {
+        uint32_t total_us;      /**< Duration of the handshake, 0 until it completes */
+        uint32_t heap_peak;     /**< Highest heap use seen during the handshake, above the use at its start */
+        /** Profile of each state, indexed by mbedtls_ssl_states. States the handshake did not go through have no steps. */
+        handshake_state_profile_t states[MBEDTLS_SSL_SERVER_HELLO_VERIFY_REQUEST_SENT + 1];
+    };
+
+    /** Get the profile of the last handshake.
+     *
+     * Available when nsapi.tls-handshake-profiling is enabled. The handshake
+     * is driven one Mbed TLS state at a time, and the time and heap used by
+     * each state are recorded, so that certificate parsing, key exchange,
+     * signature verification and waits for the server can be told apart.
+     *
+     * Heap figures come from the heap statistics and need
+     * MBED_HEAP_STATS_ENABLED. They include allocations made by other threads
+     * meanwhile. A peak is exact when the state raised the heap high-water
+     * mark, otherwise it is the larger of the heap use before and after each
+     * step of the state.
+     *
+     * @return Profile, reset when the handshake starts.
+     */
+    const handshake_profile_t &get_handshake_profile() const;
+
+    /** Register a callback invoked each time the handshake leaves a state.
+     *
+     * The callback runs in the context of the thread driving the handshake,
+     * with the state left (a value of mbedtls_ssl_states) and its profile so far.
+     *
+     * @param func Callback, or nullptr to remove it.
+     */
+    void set_handshake_profile_callback(mbed::Callback<void(int, const handshake_state_profile_t &)> func);
+#endif
+
     /** Send data over a TLS socket.
      *
      *  The socket must be connected to a remote host. Returns the number of
@@ -265,6 +369,12 @@ protected:
 
     bool is_handshake_started() const;
 
+    /** Adjust the SSL context once it is set up, before the handshake starts.
+     *
+     *  @return       0 on success, or an Mbed TLS error code that fails the handshake.
+     */
+    virtual int configure_ssl_context();
+
     void event();
 #endif
 
@@ -273,6 +383,14 @@ protected:
 private:
     /** Continue already initialized handshake */
     nsapi_error_t continue_handshake();
+    /** Run the handshake until it completes or needs the network */
+    int handshake();
+    /** Offer the cached session of the host, if any */
+    void load_session();
+    /** Cache the session of a completed handshake */
+    void save_session();
+    /** Record the size of a record passing through the transport */
+    void update_record_peak(size_t len);
     /**
      * Helper for pretty-printing Mbed TLS error codes
      */
@@ -317,6 +435,17 @@ private:
     mbed::Callback<void()> _sigio;
     Socket *_transport;
     int _timeout = -1;
+    size_t _record_peak = 0;
+    SocketStats _socket_stats;
+
+#if MBED_CONF_NSAPI_TLS_HANDSHAKE_PROFILING
+    handshake_profile_t _profile = {};
+    mbed::Callback<void(int, const handshake_state_profile_t &)> _profile_cb;
+    uint64_t _profile_start_us = 0;
+    // end of the last step, time from there to the end of the next step goes to that step
+    uint64_t _profile_mark_us = 0;
+    uint32_t _profile_heap_base = 0;
+#endif
 
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     mbedtls_x509_crt *_cacert = nullptr;
@@ -324,8 +453,14 @@ private:
 #endif
     mbedtls_ssl_config *_ssl_conf = nullptr;
 
+    // Start of the master secret of the offered session
+    unsigned char _session_check[8] = {};
+
     bool _connect_transport: 1;
     bool _close_transport: 1;
+    bool _session_resumption: 1;
+    bool _session_offered: 1;
+    bool _session_resumed: 1;
     bool _tls_initialized: 1;
     bool _handshake_completed: 1;
     bool _cacert_allocated: 1;
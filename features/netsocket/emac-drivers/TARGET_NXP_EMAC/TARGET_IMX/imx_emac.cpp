@@ -73,7 +73,7 @@ extern "C" void kinetis_init_eth_hardware(void);
 
 #define PHY_TASK_PERIOD_MS      200
 
-Kinetis_EMAC::Kinetis_EMAC() : xTXDCountSem(ENET_TX_RING_LEN, ENET_TX_RING_LEN), hwaddr()
+Kinetis_EMAC::Kinetis_EMAC() : xTXDCountSem(ENET_TX_RING_LEN, ENET_TX_RING_LEN), rx_ring(rx_buff, ENET_RX_RING_LEN), hwaddr()
 {
 }
 
@@ -195,13 +195,11 @@ bool Kinetis_EMAC::low_level_init_successful()
     AT_NONCACHEABLE_SECTION_ALIGN(static enet_tx_bd_struct_t tx_desc_start_addr[ENET_TX_RING_LEN], ENET_BUFF_ALIGNMENT);
 
     /* Create buffers for each receive BD */
-    for (i = 0; i < ENET_RX_RING_LEN; i++) {
-        rx_buff[i] = memory_manager->alloc_heap(ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT),
-                                                ENET_BUFF_ALIGNMENT);
-        if (NULL == rx_buff[i])
-            return false;
+    if (!rx_ring.init(*memory_manager, ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT), ENET_BUFF_ALIGNMENT))
+        return false;
 
-        rx_ptr[i] = (uint32_t*)memory_manager->get_ptr(rx_buff[i]);
+    for (i = 0; i < ENET_RX_RING_LEN; i++) {
+        rx_ptr[i] = (uint32_t*)rx_ring.get_ptr(i);
         SCB_InvalidateDCache_by_Addr(rx_ptr[i], ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT));
     }
 
@@ -238,7 +236,7 @@ bool Kinetis_EMAC::low_level_init_successful()
     config.rxMaxFrameLen = ENET_ETH_MAX_FLEN;
     config.macSpecialConfig = kENET_ControlFlowControlEnable;
     config.txAccelerConfig = 0;
-    config.rxAccelerConfig = kENET_RxAccelMacCheckEnabled;
+    config.rxAccelerConfig = kENET_RxAccelMacCheckEnabled | kENET_RxAccelIpCheckEnabled | kENET_RxAccelProtoCheckEnabled;
     ENET_Init(ENET, &g_handle, &config, &buffCfg, hwaddr, sysClock);
 
     ENET_SetCallback(&g_handle, &Kinetis_EMAC::ethernet_callback, this);
@@ -256,7 +254,6 @@ emac_mem_buf_t *Kinetis_EMAC::low_level_input(int idx)
 {
     volatile enet_rx_bd_struct_t *bdPtr = g_handle.rxBdCurrent[0];
     emac_mem_buf_t *p = NULL;
-    emac_mem_buf_t *temp_rxbuf = NULL;
     uint32_t length = 0;
     const uint16_t err_mask = ENET_BUFFDESCRIPTOR_RX_TRUNC_MASK | ENET_BUFFDESCRIPTOR_RX_CRC_MASK |
                               ENET_BUFFDESCRIPTOR_RX_NOOCTET_MASK | ENET_BUFFDESCRIPTOR_RX_LENVLIOLATE_MASK;
@@ -274,15 +271,10 @@ emac_mem_buf_t *Kinetis_EMAC::low_level_input(int idx)
         /* A packet is waiting, get length */
         length = bdPtr->length;
 
-        /* Zero-copy */
-        p = rx_buff[idx];
+        /* Zero-copy, queueing a new buffer in its place */
         SCB_InvalidateDCache_by_Addr(rx_ptr[idx], length);
-        memory_manager->set_len(p, length);
-
-        /* Attempt to queue new buffer */
-        temp_rxbuf = memory_manager->alloc_heap(ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT),
-                                                ENET_BUFF_ALIGNMENT);
-        if (NULL == temp_rxbuf) {
+        p = rx_ring.swap(idx, length);
+        if (NULL == p) {
             /* Re-queue the same buffer */
             update_read_buffer(NULL);
 
@@ -293,8 +285,7 @@ emac_mem_buf_t *Kinetis_EMAC::low_level_input(int idx)
             return NULL;
         }
 
-        rx_buff[idx] = temp_rxbuf;
-        rx_ptr[idx] = (uint32_t*)memory_manager->get_ptr(rx_buff[idx]);
+        rx_ptr[idx] = (uint32_t*)rx_ring.get_ptr(idx);
         SCB_InvalidateDCache_by_Addr(rx_ptr[idx], ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT));
 
         update_read_buffer((uint8_t*)rx_ptr[idx]);
@@ -375,14 +366,12 @@ void Kinetis_EMAC::packet_tx()
     tx_reclaim();
 }
 
-/** \brief  Low level output of a packet. Never call this from an
- *          interrupt context, as it may block until TX descriptors
- *          become available.
+/** \brief  Get a packet into a form the DMA can send.
  *
- *  \param[in] buf      the MAC packet to send (e.g. IP packet including MAC addresses and type)
- *  \return ERR_OK if the packet could be sent or an err_t value if the packet couldn't be sent
+ *  \param[in] buf      the MAC packet to send
+ *  \return the buffer to hand to the DMA, or NULL if a copy was needed and failed
  */
-bool Kinetis_EMAC::link_out(emac_mem_buf_t *buf)
+emac_mem_buf_t *Kinetis_EMAC::tx_prepare(emac_mem_buf_t *buf)
 {
     // If buffer is chained or not aligned then make a contiguous aligned copy of it
     if (memory_manager->get_next(buf) ||
@@ -391,7 +380,7 @@ bool Kinetis_EMAC::link_out(emac_mem_buf_t *buf)
         copy_buf = memory_manager->alloc_heap(memory_manager->get_total_len(buf), ENET_BUFF_ALIGNMENT);
         if (NULL == copy_buf) {
             memory_manager->free(buf);
-            return false;
+            return NULL;
         }
 
         // Copy to new buffer and free original
@@ -402,43 +391,97 @@ bool Kinetis_EMAC::link_out(emac_mem_buf_t *buf)
 
     SCB_CleanDCache_by_Addr(static_cast<uint32_t *>(memory_manager->get_ptr(buf)), memory_manager->get_len(buf));
 
-    /* Check if a descriptor is available for the transfer (wait 10ms before dropping the buffer) */
-    if (!xTXDCountSem.try_acquire_for(10)) {
-        memory_manager->free(buf);
-        return false;
+    return buf;
+}
+
+/** \brief  Low level output of a packet. Never call this from an
+ *          interrupt context, as it may block until TX descriptors
+ *          become available.
+ *
+ *  \param[in] buf      the MAC packet to send (e.g. IP packet including MAC addresses and type)
+ *  \return ERR_OK if the packet could be sent or an err_t value if the packet couldn't be sent
+ */
+bool Kinetis_EMAC::link_out(emac_mem_buf_t *buf)
+{
+    return link_out_batch(&buf, 1) == 1;
+}
+
+/** \brief  Low level output of several packets, queueing as many as there are
+ *          free descriptors before activating transmission. Never call this
+ *          from an interrupt context, as it may block until TX descriptors
+ *          become available.
+ *
+ *  \param[in] bufs     the MAC packets to send
+ *  \param[in] count    number of packets
+ *  \return number of packets queued for transmission
+ */
+uint32_t Kinetis_EMAC::link_out_batch(emac_mem_buf_t **bufs, uint32_t count)
+{
+    uint32_t sent = 0;
+    uint32_t i = 0;
+
+    for (uint32_t j = 0; j < count; j++) {
+        bufs[j] = tx_prepare(bufs[j]);
     }
 
-    /* Get exclusive access */
-    TXLockMutex.lock();
+    while (i < count) {
+        if (!bufs[i]) {
+            i++;
+            continue;
+        }
 
-    /* Save the buffer so that it can be freed when transmit is done */
-    tx_buff[tx_produce_index % ENET_TX_RING_LEN] = buf;
-    tx_produce_index += 1;
+        /* Check if a descriptor is available for the transfer (wait 10ms before dropping the buffer) */
+        if (!xTXDCountSem.try_acquire_for(10)) {
+            memory_manager->free(bufs[i++]);
+            continue;
+        }
 
-    /* Setup transfers */
-    g_handle.txBdCurrent[0]->buffer = static_cast<uint8_t *>(memory_manager->get_ptr(buf));
-    g_handle.txBdCurrent[0]->length = memory_manager->get_len(buf);
-    /* Ensures buffer and length is written before control. */
-    __DMB();
-    g_handle.txBdCurrent[0]->control |= (ENET_BUFFDESCRIPTOR_TX_READY_MASK | ENET_BUFFDESCRIPTOR_TX_LAST_MASK);
+        /* Take descriptors for the following packets too, as long as they are free */
+        uint32_t end = i + 1;
+        while (end < count && (!bufs[end] || xTXDCountSem.try_acquire())) {
+            end++;
+        }
 
-    /* Increase the buffer descriptor address. */
-    if (g_handle.txBdCurrent[0]->control & ENET_BUFFDESCRIPTOR_TX_WRAP_MASK) {
-        g_handle.txBdCurrent[0] = g_handle.txBdBase[0];
-    } else {
-        g_handle.txBdCurrent[0]++;
-    }
+        /* Get exclusive access */
+        TXLockMutex.lock();
+
+        for (; i < end; i++) {
+            emac_mem_buf_t *buf = bufs[i];
+            if (!buf) {
+                continue;
+            }
+
+            /* Save the buffer so that it can be freed when transmit is done */
+            tx_buff[tx_produce_index % ENET_TX_RING_LEN] = buf;
+            tx_produce_index += 1;
+
+            /* Setup transfers */
+            g_handle.txBdCurrent[0]->buffer = static_cast<uint8_t *>(memory_manager->get_ptr(buf));
+            g_handle.txBdCurrent[0]->length = memory_manager->get_len(buf);
+            /* Ensures buffer and length is written before control. */
+            __DMB();
+            g_handle.txBdCurrent[0]->control |= (ENET_BUFFDESCRIPTOR_TX_READY_MASK | ENET_BUFFDESCRIPTOR_TX_LAST_MASK);
+
+            /* Increase the buffer descriptor address. */
+            if (g_handle.txBdCurrent[0]->control & ENET_BUFFDESCRIPTOR_TX_WRAP_MASK) {
+                g_handle.txBdCurrent[0] = g_handle.txBdBase[0];
+            } else {
+                g_handle.txBdCurrent[0]++;
+            }
+            sent++;
+        }
 
-    /* Ensures descriptor is written before kicking hardware. */
-    __DSB();
+        /* Ensures descriptors are written before kicking hardware. */
+        __DSB();
 
-    /* Active the transmit buffer descriptor. */
-    ENET->TDAR = ENET_TDAR_TDAR_MASK;
+        /* Active the transmit buffer descriptors. */
+        ENET->TDAR = ENET_TDAR_TDAR_MASK;
 
-    /* Restore access */
-    TXLockMutex.unlock();
+        /* Restore access */
+        TXLockMutex.unlock();
+    }
 
-    return true;
+    return sent;
 }
 
 /*******************************************************************************
@@ -526,6 +569,15 @@ uint32_t Kinetis_EMAC::get_align_preference() const
     return ENET_BUFF_ALIGNMENT;
 }
 
+uint32_t Kinetis_EMAC::get_capabilities() const
+{
+    /* ENET accelerator discards received frames with bad checksums. Transmit
+       insertion stays off as it needs every stack to zero checksum fields */
+    return EMAC::CAPABILITY_RX_CHECKSUM_IPV4 | EMAC::CAPABILITY_RX_CHECKSUM_UDP |
+           EMAC::CAPABILITY_RX_CHECKSUM_TCP | EMAC::CAPABILITY_RX_CHECKSUM_ICMP |
+           (ENET_TX_RING_LEN > 1 ? EMAC::CAPABILITY_TX_BATCH : 0);
+}
+
 void Kinetis_EMAC::get_ifname(char *name, uint8_t size) const
 {
     memcpy(name, KINETIS_ETH_IF_NAME, (size < sizeof(KINETIS_ETH_IF_NAME)) ? size : sizeof(KINETIS_ETH_IF_NAME));
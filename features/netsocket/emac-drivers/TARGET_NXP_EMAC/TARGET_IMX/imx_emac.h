@@ -27,6 +27,16 @@ public:
 
     static Kinetis_EMAC &get_instance();
 
+    /**
+     * Return receive buffer ring statistics
+     *
+     * @return     Counts of frames received, and of buffers that couldn't be replaced
+     */
+    const EMACRxRing::stats_t &get_rx_ring_stats() const
+    {
+        return rx_ring.get_stats();
+    }
+
     /**
      * Return maximum transmission unit
      *
@@ -44,6 +54,13 @@ public:
      */
     virtual uint32_t get_align_preference() const;
 
+    /**
+     * Return hardware capabilities
+     *
+     * @return     Checksum offloads enabled in the MAC, and batched transmission
+     */
+    virtual uint32_t get_capabilities() const;
+
     /**
      * Return interface name
      *
@@ -96,6 +113,17 @@ public:
      */
     virtual bool link_out(emac_mem_buf_t *buf);
 
+    /**
+     * Sends several packets over the link, starting transmission once
+     *
+     * That can not be called from an interrupt context.
+     *
+     * @param bufs   Packets to be sent
+     * @param count  Number of packets
+     * @return       Number of packets sent successfully
+     */
+    virtual uint32_t link_out_batch(emac_mem_buf_t **bufs, uint32_t count);
+
     /**
      * Initializes the HW
      *
@@ -155,6 +183,7 @@ private:
     void packet_rx();
     void packet_tx();
     void tx_reclaim();
+    emac_mem_buf_t *tx_prepare(emac_mem_buf_t *buf);
     void input(int idx);
     emac_mem_buf_t *low_level_input(int idx);
     static void thread_function(void* pvParameters);
@@ -165,6 +194,7 @@ private:
     osThreadId_t thread; /**< Processing thread */
     rtos::Mutex TXLockMutex;/**< TX critical section mutex */
     rtos::Semaphore xTXDCountSem; /**< TX free buffer counting semaphore */
+    EMACRxRing rx_ring; /**< RX buffers posted to descriptors */
     uint8_t tx_consume_index, tx_produce_index; /**< TX buffers ring */
     emac_link_input_cb_t emac_link_input_cb; /**< Callback for incoming data */
     emac_link_state_change_cb_t emac_link_state_cb; /**< Link state change callback */
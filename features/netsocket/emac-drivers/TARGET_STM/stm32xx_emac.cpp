@@ -306,7 +306,7 @@ bool STM32_EMAC::low_level_init_successful()
 #endif
     EthHandle.Init.MACAddr = &MACAddr[0];
     EthHandle.Init.RxMode = ETH_RXINTERRUPT_MODE;
-    EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE;
+    EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE;
     EthHandle.Init.MediaInterface = MBED_CONF_STM32_EMAC_ETH_PHY_MEDIA_INTERFACE;
     tr_info("PHY Addr %u AutoNegotiation %u", EthHandle.Init.PhyAddress, EthHandle.Init.AutoNegotiation);
     tr_debug("MAC Addr %02x:%02x:%02x:%02x:%02x:%02x", MACAddr[0], MACAddr[1], MACAddr[2], MACAddr[3], MACAddr[4], MACAddr[5]);
@@ -915,6 +915,16 @@ uint32_t STM32_EMAC::get_align_preference() const
     return 0;
 }
 
+uint32_t STM32_EMAC::get_capabilities() const
+{
+    /* Checksum offload engine inserts checksums on transmit and drops
+       received frames with bad ones (DropTCPIPChecksumErrorFrame) */
+    return EMAC::CAPABILITY_TX_CHECKSUM_IPV4 | EMAC::CAPABILITY_TX_CHECKSUM_UDP |
+           EMAC::CAPABILITY_TX_CHECKSUM_TCP | EMAC::CAPABILITY_TX_CHECKSUM_ICMP |
+           EMAC::CAPABILITY_RX_CHECKSUM_IPV4 | EMAC::CAPABILITY_RX_CHECKSUM_UDP |
+           EMAC::CAPABILITY_RX_CHECKSUM_TCP | EMAC::CAPABILITY_RX_CHECKSUM_ICMP;
+}
+
 void STM32_EMAC::get_ifname(char *name, uint8_t size) const
 {
     memcpy(name, STM_ETH_IF_NAME, (size < sizeof(STM_ETH_IF_NAME)) ? size : sizeof(STM_ETH_IF_NAME));
@@ -44,6 +44,13 @@ public:
      */
     virtual uint32_t get_align_preference() const;
 
+    /**
+     * Return hardware capabilities
+     *
+     * @return     Checksum offloads enabled in the MAC
+     */
+    virtual uint32_t get_capabilities() const;
+
     /**
      * Return interface name
      *
@@ -37,6 +37,7 @@
 #include "netsocket/MeshInterface.h"
 
 #include "netsocket/Socket.h"
+#include "netsocket/SocketSet.h"
 #include "netsocket/UDPSocket.h"
 #include "netsocket/TCPSocket.h"
 #include "netsocket/TLSSocketWrapper.h"
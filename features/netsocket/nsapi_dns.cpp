@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <algorithm>
 #include "mbed_shared_queues.h"
 #include "events/EventQueue.h"
 #include "OnboardNetworkStack.h"
@@ -44,16 +45,28 @@
 #define DNS_QUERY_QUEUE_SIZE 5
 #define DNS_HOST_NAME_MAX_LEN 255
 #define DNS_TIMER_TIMEOUT 100
+// RFC 8305 section 3: how long to wait for the other family once one has answered
+#define DNS_RESOLUTION_DELAY 50
+#define DNS_ANSWERED_A 0x1
+#define DNS_ANSWERED_AAAA 0x2
 #if !defined(MIN)
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
+// Lookups an entry must serve before it is worth refreshing in the background
+#define DNS_CACHE_REFRESH_HITS 2
+
 struct DNS_CACHE {
-    nsapi_addr_t *address;
-    char *host;
+    nsapi_addr_t address[MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
+    char host[MBED_CONF_NSAPI_DNS_CACHE_HOST_NAME_LEN + 1];
     uint64_t expires;      /*!< time to live in milliseconds */
-    uint64_t accessed;     /*!< last accessed */
+    uint32_t hash;         /*!< hash of host */
+    uint16_t next;         /*!< next entry in the same bucket or in the free list */
+    uint16_t newer;        /*!< entry used more recently */
+    uint16_t older;        /*!< entry used less recently */
     uint8_t count;         /*!< number of IP addresses */
+    uint8_t hits;          /*!< lookups served */
+    bool refreshing;       /*!< background query started */
 };
 
 struct SOCKET_CB_DATA {
@@ -84,20 +97,27 @@ struct DNS_QUERY {
     uint32_t total_timeout;
     uint32_t socket_timeout;
     uint16_t dns_message_id;
+    uint16_t dns_message_id_a;  /*!< id of the A question when asking for both families, otherwise 0 */
     uint8_t dns_server;
     uint8_t retries;
     uint8_t total_attempts;
     uint8_t send_success;
     uint8_t count;
+    uint8_t answered;           /*!< families answered when asking for both */
     dns_state state;
 };
 
 static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl, uint8_t count);
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh = NULL);
 static void nsapi_dns_cache_reset();
+static void nsapi_dns_cache_refresh(NetworkStack *stack, const char *host, nsapi_size_t addr_count,
+                                    call_in_callback_cb_t call_in_cb, const char *interface_name, const nsapi_addr_t *address);
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr, const char *interface_name);
 
+static nsapi_value_or_error_t nsapi_dns_query_async_start(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version);
 static void nsapi_dns_query_async_create(void *ptr);
 static nsapi_error_t nsapi_dns_query_async_delete(intptr_t unique_id);
 static void nsapi_dns_query_async_send(void *ptr);
@@ -106,6 +126,7 @@ static void nsapi_dns_query_async_resp(DNS_QUERY *query, nsapi_error_t status, S
 static void nsapi_dns_query_async_socket_callback(void *ptr);
 static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack);
 static void nsapi_dns_query_async_response(void *ptr);
+static void nsapi_dns_query_async_answer_both(DNS_QUERY *query, const uint8_t *packet, uint16_t id);
 static void nsapi_dns_query_async_initiate_next(void);
 
 // *INDENT-OFF*
@@ -121,7 +142,14 @@ static nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
 // *INDENT-ON*
 
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
-static DNS_CACHE *dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+// Entries are referred to by their index plus one, so zero means none
+// and the zero initialized pool starts out empty
+static DNS_CACHE dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static uint16_t dns_cache_bucket[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static uint16_t dns_cache_used;     // entries taken from the pool so far
+static uint16_t dns_cache_free;     // entries released since
+static uint16_t dns_cache_newest;
+static uint16_t dns_cache_oldest;
 // Protects cache shared between blocking and asynchronous calls
 static SingletonPtr<PlatformMutex> dns_cache_mutex;
 #endif
@@ -323,93 +351,184 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
     return count;
 }
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl, uint8_t count)
-{
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
-    // RFC 1034: if TTL is zero, entry is not added to cache
-    if (ttl == 0) {
-        return;
+static uint32_t nsapi_dns_cache_hash(const char *host)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*host) {
+        hash = (hash ^ (uint8_t) *host++) * 16777619u;
     }
+    return hash;
+}
 
-    // Checks if already cached
-    if (nsapi_dns_cache_find(host, address->version, NULL) == NSAPI_ERROR_OK) {
-        return;
+static inline DNS_CACHE *nsapi_dns_cache_entry(uint16_t id)
+{
+    return &dns_cache[id - 1];
+}
+
+static void nsapi_dns_cache_link(uint16_t id)
+{
+    DNS_CACHE *entry = nsapi_dns_cache_entry(id);
+
+    uint16_t *bucket = &dns_cache_bucket[entry->hash % MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+    entry->next = *bucket;
+    *bucket = id;
+
+    entry->newer = 0;
+    entry->older = dns_cache_newest;
+    if (dns_cache_newest) {
+        nsapi_dns_cache_entry(dns_cache_newest)->newer = id;
+    } else {
+        dns_cache_oldest = id;
     }
+    dns_cache_newest = id;
+}
 
-    dns_cache_mutex->lock();
+static void nsapi_dns_cache_unlink(uint16_t id)
+{
+    DNS_CACHE *entry = nsapi_dns_cache_entry(id);
 
-    int index = -1;
-    uint64_t accessed = UINT64_MAX;
+    uint16_t *link = &dns_cache_bucket[entry->hash % MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+    while (*link != id) {
+        link = &nsapi_dns_cache_entry(*link)->next;
+    }
+    *link = entry->next;
 
-    // Finds free or last accessed entry
-    for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (!dns_cache[i]) {
-            index = i;
-            break;
-        } else if (dns_cache[i]->accessed <= accessed) {
-            accessed = dns_cache[i]->accessed;
-            index = i;
+    if (entry->newer) {
+        nsapi_dns_cache_entry(entry->newer)->older = entry->older;
+    } else {
+        dns_cache_newest = entry->older;
+    }
+    if (entry->older) {
+        nsapi_dns_cache_entry(entry->older)->newer = entry->newer;
+    } else {
+        dns_cache_oldest = entry->newer;
+    }
+}
+
+static void nsapi_dns_cache_release(uint16_t id)
+{
+    nsapi_dns_cache_unlink(id);
+    nsapi_dns_cache_entry(id)->next = dns_cache_free;
+    dns_cache_free = id;
+}
+
+// Finds an entry, dropping any expired ones met on the way
+static uint16_t nsapi_dns_cache_lookup(const char *host, uint32_t hash, nsapi_version_t version, uint64_t ms_count)
+{
+    uint16_t id = dns_cache_bucket[hash % MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+
+    while (id) {
+        DNS_CACHE *entry = nsapi_dns_cache_entry(id);
+        uint16_t next = entry->next;
+
+        if (ms_count > entry->expires) {
+            nsapi_dns_cache_release(id);
+        } else if (entry->hash == hash &&
+                   (version == NSAPI_UNSPEC || (version == entry->address[0].version && // IPv6 addresses come first in entries holding both
+                                                version == entry->address[entry->count - 1].version)) &&
+                   strcmp(entry->host, host) == 0) {
+            return id;
         }
+        id = next;
     }
 
-    if (index < 0) {
-        dns_cache_mutex->unlock();
+    return 0;
+}
+#endif
+
+static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl, uint8_t count)
+{
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    // RFC 1034: if TTL is zero, entry is not added to cache
+    if (ttl == 0) {
         return;
     }
 
-    // Allocates in case entry is free, otherwise reuses
-    if (!dns_cache[index]) {
-        dns_cache[index] = new (std::nothrow) DNS_CACHE;
+    // Names too long for an entry are always resolved from the network
+    if (strlen(host) > MBED_CONF_NSAPI_DNS_CACHE_HOST_NAME_LEN) {
+        return;
+    }
+
+    dns_cache_mutex->lock();
+
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+    uint32_t hash = nsapi_dns_cache_hash(host);
+
+    // Renews the entry if already cached, otherwise takes a free or the least recently used one
+    uint16_t id = nsapi_dns_cache_lookup(host, hash, address->version, ms_count);
+    bool renewed = id != 0;
+    if (id) {
+        nsapi_dns_cache_unlink(id);
+    } else if (dns_cache_free) {
+        id = dns_cache_free;
+        dns_cache_free = nsapi_dns_cache_entry(id)->next;
+    } else if (dns_cache_used < MBED_CONF_NSAPI_DNS_CACHE_SIZE) {
+        id = ++dns_cache_used;
     } else {
-        delete dns_cache[index]->host;
-        delete dns_cache[index]->address;
+        id = dns_cache_oldest;
+        nsapi_dns_cache_unlink(id);
     }
 
-    if (dns_cache[index]) {
-        dns_cache[index]->address = new (std::nothrow) nsapi_addr_t[count];
-        for (int i = 0; i < count; i++) {
-            dns_cache[index]->address[i] = address[i];
-        }
-        dns_cache[index]->count = count;
-        dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
-        strcpy(dns_cache[index]->host, host);
-        uint64_t ms_count = rtos::Kernel::get_ms_count();
-        dns_cache[index]->expires = ms_count + (uint64_t) ttl * 1000;
-        dns_cache[index]->accessed = ms_count;
+    DNS_CACHE *entry = nsapi_dns_cache_entry(id);
+    entry->count = MIN(count, MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT);
+    for (int i = 0; i < entry->count; i++) {
+        entry->address[i] = address[i];
+    }
+    strcpy(entry->host, host);
+    entry->hash = hash;
+    entry->expires = ms_count + (uint64_t) ttl * 1000;
+    entry->refreshing = false;
+    if (!renewed) {
+        entry->hits = 0;
     }
+    nsapi_dns_cache_link(id);
 
     dns_cache_mutex->unlock();
 #endif
 }
 
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address)
+static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh)
 {
     nsapi_error_t ret_val = NSAPI_ERROR_NO_ADDRESS;
 
+    if (refresh) {
+        *refresh = false;
+    }
+
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
     dns_cache_mutex->lock();
 
-    for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (dns_cache[i]) {
-            uint64_t ms_count = rtos::Kernel::get_ms_count();
-            // Checks all entries for expired entries
-            if (ms_count > dns_cache[i]->expires) {
-                delete dns_cache[i]->host;
-                delete dns_cache[i];
-                dns_cache[i] = NULL;
-            } else if ((version == NSAPI_UNSPEC || version == dns_cache[i]->address[0].version) && //only first IP address version check, others have the same version
-                       strcmp(dns_cache[i]->host, host) == 0) {
-                if (address) {
-                    ret_val = 0;
-                    for (int count = 0; count < dns_cache[i]->count; count++) {
-                        address[count] = dns_cache[i]->address[count];
-                        ret_val++;
-                    }
-                }
-                dns_cache[i]->accessed = ms_count;
-
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+    uint16_t id = nsapi_dns_cache_lookup(host, nsapi_dns_cache_hash(host), version, ms_count);
+    if (id) {
+        DNS_CACHE *entry = nsapi_dns_cache_entry(id);
+        if (address) {
+            ret_val = 0;
+            for (int count = 0; count < entry->count; count++) {
+                address[count] = entry->address[count];
+                ret_val++;
             }
         }
+        if (entry->hits < UINT8_MAX) {
+            entry->hits++;
+        }
+
+#if (MBED_CONF_NSAPI_DNS_CACHE_REFRESH_TIME > 0)
+        // Popular names are resolved again shortly before they expire, so
+        // lookups keep hitting the cache. If the query fails, the entry
+        // just expires as usual.
+        if (refresh && !entry->refreshing && entry->hits >= DNS_CACHE_REFRESH_HITS &&
+                entry->expires - ms_count <= MBED_CONF_NSAPI_DNS_CACHE_REFRESH_TIME) {
+            entry->refreshing = true;
+            *refresh = true;
+        }
+#endif
+
+        // Moves the entry to the recently used end
+        nsapi_dns_cache_unlink(id);
+        nsapi_dns_cache_link(id);
     }
 
     dns_cache_mutex->unlock();
@@ -422,19 +541,52 @@ static void nsapi_dns_cache_reset()
 {
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
     dns_cache_mutex->lock();
-    for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (dns_cache[i]) {
-            delete[] dns_cache[i]->host;
-            dns_cache[i]->host = NULL;
-            delete[] dns_cache[i]->address;
-            delete dns_cache[i];
-            dns_cache[i] = NULL;
-        }
-    }
+    memset(dns_cache_bucket, 0, sizeof(dns_cache_bucket));
+    dns_cache_used = 0;
+    dns_cache_free = 0;
+    dns_cache_newest = 0;
+    dns_cache_oldest = 0;
     dns_cache_mutex->unlock();
 #endif
 }
 
+static void nsapi_dns_cache_refresh_cb(nsapi_value_or_error_t result, SocketAddress *address)
+{
+    // Answers are added to the cache before the callback, nothing left to do
+}
+
+// Runs background refreshes on the shared event queue when the stack's own
+// context is not known, as for blocking queries
+static nsapi_error_t nsapi_dns_cache_refresh_call_in(int delay, mbed::Callback<void()> func)
+{
+    events::EventQueue *event_queue = mbed::mbed_event_queue();
+
+    if (!event_queue) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    int id = (delay > 0) ? event_queue->call_in(delay, func) : event_queue->call(func);
+    return id ? NSAPI_ERROR_OK : NSAPI_ERROR_NO_MEMORY;
+}
+
+static void nsapi_dns_cache_refresh(NetworkStack *stack, const char *host, nsapi_size_t addr_count,
+                                    call_in_callback_cb_t call_in_cb, const char *interface_name, const nsapi_addr_t *address)
+{
+    if (!call_in_cb) {
+        call_in_cb = mbed::callback(nsapi_dns_cache_refresh_call_in);
+    }
+
+    // Entries holding both families are renewed with both
+    nsapi_version_t version = address[0].version;
+    if (address[addr_count - 1].version != version) {
+        version = NSAPI_UNSPEC;
+    }
+
+    dns_mutex->lock();
+    nsapi_dns_query_async_start(stack, host, mbed::callback(nsapi_dns_cache_refresh_cb),
+                                addr_count > 1 ? addr_count : 0, call_in_cb, interface_name, version);
+}
+
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr, const char *interface_name)
 {
     bool dns_addr_set = false;
@@ -483,11 +635,15 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
 
     // check cache
     nsapi_addr *tmp = new (std::nothrow) nsapi_addr_t [MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
-    int cached = nsapi_dns_cache_find(host, version, tmp);
+    bool refresh;
+    int cached = nsapi_dns_cache_find(host, version, tmp, &refresh);
     if (cached > 0) {
         for (int i = 0;  i < MIN(cached, addr_count); i++) {
             addr[i] = tmp[i];
         }
+        if (refresh) {
+            nsapi_dns_cache_refresh(stack, host, cached, nullptr, interface_name, tmp);
+        }
         delete [] tmp;
         return MIN(cached, addr_count);
     }
@@ -701,12 +857,16 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     nsapi_addr *address = new (std::nothrow) nsapi_addr_t [MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
-    int cached = nsapi_dns_cache_find(host, version, address);
+    bool refresh;
+    int cached = nsapi_dns_cache_find(host, version, address, &refresh);
     if (!addr_count) {
         if (cached > 0) {
             SocketAddress addr(*address);
             dns_mutex->unlock();
             callback(1, &addr);
+            if (refresh) {
+                nsapi_dns_cache_refresh(stack, host, cached, call_in_cb, interface_name, address);
+            }
             delete[] address;
             return NSAPI_ERROR_OK;
         }
@@ -720,12 +880,25 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
             }
             dns_mutex->unlock();
             callback(cached, addr);
+            if (refresh) {
+                nsapi_dns_cache_refresh(stack, host, cached, call_in_cb, interface_name, address);
+            }
             delete[] address;
             delete[] addr;
             return cached;
         }
     }
     delete[] address;
+
+    return nsapi_dns_query_async_start(stack, host, callback, addr_count, call_in_cb, interface_name, version);
+}
+
+// Queues a query without looking at the cache, called with dns_mutex locked
+static nsapi_value_or_error_t nsapi_dns_query_async_start(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version)
+{
+    int host_len = strlen(host);
     int index = -1;
 
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
@@ -768,6 +941,8 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     query->total_attempts =  MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS;
     query->send_success = 0;
     query->dns_message_id = 0;
+    query->dns_message_id_a = 0;
+    query->answered = 0;
     query->socket_timeout = 0;
     query->total_timeout = MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS * MBED_CONF_NSAPI_DNS_RESPONSE_WAIT_TIME + 500;
     query->count = 0;
@@ -1080,6 +1255,21 @@ static void nsapi_dns_query_async_send(void *ptr)
         dns_message_id = 1;
     }
 
+    // Without a version, lookups for several addresses ask for AAAA and A
+    // records at the same time, rather than only for the type matching the
+    // server address. Single address lookups keep to the server's type.
+    bool both = query->version == NSAPI_UNSPEC && query->addr_count > 1;
+    if (both) {
+        query->dns_message_id_a = dns_message_id++;
+        if (dns_message_id == 0) {
+            dns_message_id = 1;
+        }
+        query->answered = 0;
+        query->count = 0;
+        delete[] query->addrs;
+        query->addrs = NULL;
+    }
+
     // create network packet
     uint8_t *packet = (uint8_t *)malloc(DNS_BUFFER_SIZE);
     if (!packet) {
@@ -1101,9 +1291,13 @@ static void nsapi_dns_query_async_send(void *ptr)
             continue;
         }
         // send the question
-        int len = dns_append_question(packet, query->dns_message_id, query->host, dns_addr.get_ip_version());
+        int len = dns_append_question(packet, query->dns_message_id, query->host, both ? NSAPI_IPv6 : dns_addr.get_ip_version());
 
         err = query->socket->sendto(dns_addr, packet, len);
+        if (both && err >= 0) {
+            len = dns_append_question(packet, query->dns_message_id_a, query->host, NSAPI_IPv4);
+            err = query->socket->sendto(dns_addr, packet, len);
+        }
 
         if (err < 0) {
             if (err == NSAPI_ERROR_WOULD_BLOCK) {
@@ -1176,7 +1370,7 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
             DNS_QUERY *query = NULL;
 
             for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
-                if (dns_query_queue[i] && dns_query_queue[i]->dns_message_id == id) {
+                if (dns_query_queue[i] && (dns_query_queue[i]->dns_message_id == id || dns_query_queue[i]->dns_message_id_a == id)) {
                     query = dns_query_queue[i];
                     break;
                 }
@@ -1186,6 +1380,11 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
                 continue;
             }
 
+            if (query->dns_message_id_a) {
+                nsapi_dns_query_async_answer_both(query, packet, id);
+                continue;
+            }
+
             int requested_count = 1;
             if (query->addr_count > 1) {
                 requested_count = query->addr_count;
@@ -1213,6 +1412,56 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
     dns_mutex->unlock();
 }
 
+static void nsapi_dns_query_async_answer_both(DNS_QUERY *query, const uint8_t *packet, uint16_t id)
+{
+    uint8_t family = (id == query->dns_message_id) ? DNS_ANSWERED_AAAA : DNS_ANSWERED_A;
+    if (query->answered & family) {
+        return;
+    }
+
+    int requested_count = 1;
+    if (query->addr_count > 1) {
+        requested_count = query->addr_count;
+    }
+
+    // Room for a full answer of each family, trimmed to the requested count below
+    if (!query->addrs) {
+        query->addrs = new (std::nothrow) nsapi_addr_t[2 * requested_count];
+        if (!query->addrs) {
+            return;
+        }
+    }
+
+    uint32_t ttl;
+    int resp = dns_scan_response(packet, id, &ttl, query->addrs + query->count, requested_count);
+
+    // Ignore invalid responses
+    if (resp < 0) {
+        return;
+    }
+
+    if (resp > 0) {
+        if (!query->count || ttl < query->ttl) {
+            query->ttl = ttl;
+        }
+        // IPv6 addresses go first
+        if (family == DNS_ANSWERED_AAAA) {
+            std::rotate(query->addrs, query->addrs + query->count, query->addrs + query->count + resp);
+        }
+        query->count = MIN(query->count + resp, requested_count);
+    }
+    query->answered |= family;
+
+    if (query->answered == (DNS_ANSWERED_A | DNS_ANSWERED_AAAA) || resp > 0) {
+        query->status = NSAPI_ERROR_DNS_FAILURE; // Used in case failure, otherwise ok
+        query->socket_timeout = 0;
+        // After the first answer with addresses, gives the other family a moment to follow.
+        // Whichever call comes second finds the query gone.
+        int delay = (query->answered == (DNS_ANSWERED_A | DNS_ANSWERED_AAAA)) ? 0 : DNS_RESOLUTION_DELAY;
+        nsapi_dns_call_in(query->call_in_cb, delay, mbed::callback(nsapi_dns_query_async_response, reinterpret_cast<void *>(query->unique_id)));
+    }
+}
+
 static void nsapi_dns_query_async_response(void *ptr)
 {
     dns_mutex->lock();
@@ -171,7 +171,9 @@ nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const char *
  *  @param host       Hostname to resolve
  *  @param callback   Callback that is called for result
  *  @param addr_count Number of addresses allocated in the array
- *  @param version    IP version to resolve (defaults to NSAPI_IPv4)
+ *  @param version    IP version to resolve (defaults to NSAPI_IPv4). With NSAPI_UNSPEC
+ *                    and more than one address, A and AAAA records are queried
+ *                    concurrently and IPv6 addresses are returned first
  *  @return           0 on success, negative error code on failure or an unique id that
                       represents the hostname translation operation and can be passed to
  *                    cancel, NSAPI_ERROR_DNS_FAILURE indicates the host could not be found
@@ -272,6 +272,9 @@ typedef enum nsapi_socket_option {
     NSAPI_BIND_TO_DEVICE,    /*!< Bind socket network interface name*/
     NSAPI_LATENCY,           /*!< Read estimated latency to destination */
     NSAPI_STAGGER,           /*!< Read estimated stagger value to destination */
+    NSAPI_RETRANSMISSIONS,   /*!< Read number of TCP segments retransmitted on the connection, as uint32_t */
+    NSAPI_TCP_NODELAY,       /*!< Disable Nagle's algorithm so small writes are sent immediately, as int */
+    NSAPI_TCP_CORK,          /*!< Hold back partial TCP segments until uncorked, as int */
 } nsapi_socket_option_t;
 
 typedef enum nsapi_tlssocket_level {
@@ -283,7 +286,9 @@ typedef enum nsapi_tlssocket_option {
     NSAPI_TLSSOCKET_SET_CACERT,     /*!< Set server CA certificate */
     NSAPI_TLSSOCKET_SET_CLCERT,     /*!< Set client certificate */
     NSAPI_TLSSOCKET_SET_CLKEY,      /*!< Set client key */
-    NSAPI_TLSSOCKET_ENABLE          /*!< Enable TLSSocket */
+    NSAPI_TLSSOCKET_ENABLE,         /*!< Enable TLSSocket */
+    NSAPI_TLSSOCKET_DTLS_CID,       /*!< Set the DTLS Connection ID the peer should send with, offering the extension, or get int 1 if its use was negotiated, 0 otherwise */
+    NSAPI_TLSSOCKET_DTLS_PEER_CID,  /*!< Get the DTLS Connection ID the peer asked to be sent with */
 } nsapi_tlssocket_option_t;
 
 /** Supported IP protocol versions of IP stack
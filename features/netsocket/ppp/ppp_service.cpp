@@ -164,9 +164,9 @@ void ppp_service::ppp_input()
     // Infinite loop, but we assume that we can read faster than the
     // serial, so we will fairly rapidly hit -EAGAIN.
     for (;;) {
-        u8_t buffer[16];
+        u8_t *buffer = ppp_service_rx_buffer;
 
-        ssize_t len = ppp_service_stream->read(buffer, sizeof buffer);
+        ssize_t len = ppp_service_stream->read(buffer, sizeof ppp_service_rx_buffer);
 
         if (len == -EAGAIN) {
             break;
@@ -217,6 +217,7 @@ private:
     NetStackMemoryManager *memory_manager = nullptr; /**< Memory manager */
     ppp_link_input_cb_t ppp_link_input_cb; /**< Callback for incoming data */
     ppp_link_state_change_cb_t ppp_link_state_cb; /**< Link state change callback */
+    uint8_t ppp_service_rx_buffer[MBED_CONF_PPP_RX_READ_SIZE]; /**< Serial stream read buffer */
 
     netif *ppp_service_netif;
     ppp_pcb_s *ppp_service_pcb = nullptr;
@@ -64,6 +64,7 @@ static void pppos_input_callback(void *arg);
 static void pppos_input_free_current_packet(pppos_pcb *pppos);
 static void pppos_input_drop(pppos_pcb *pppos);
 static err_t pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t accm, u16_t *fcs);
+static err_t pppos_output_append_data(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs);
 static err_t pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs);
 
 /* Callbacks structure for PPP core */
@@ -221,9 +222,7 @@ pppos_write(ppp_pcb *ppp, void *ctx, struct pbuf *p)
   s = (u8_t*)p->payload;
   n = p->len;
 
-  while (n-- > 0) {
-    err = pppos_output_append(pppos, err,  nb, *s++, 1, &fcs_out);
-  }
+  err = pppos_output_append_data(pppos, err, nb, s, n, &fcs_out);
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
   if (err == ERR_OK) {
@@ -289,9 +288,7 @@ pppos_netif_output(ppp_pcb *ppp, void *ctx, struct pbuf *pb, u16_t protocol)
       u16_t n = mem_mngr->get_len(p);
       u8_t *s = (u8_t*) mem_mngr->get_ptr(p);
 
-      while (n-- > 0) {
-        err = pppos_output_append(pppos, err, nb, *s++, 1, &fcs_out);
-      }
+      err = pppos_output_append_data(pppos, err, nb, s, n, &fcs_out);
   }
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
@@ -704,6 +701,29 @@ pppos_input(ppp_pcb *ppp, u8_t *s, int l)
 
       /* update the frame check sequence number. */
       pppos->in_fcs = PPP_FCS(pppos->in_fcs, cur_char);
+
+      /* Copy any run of following data bytes that need no unescaping
+       * straight into the buffer, rather than taking each one through
+       * the state machine. */
+      if (pppos->in_state == PDDATA && pppos->in_tail != NULL) {
+        u8_t *payload = (u8_t*)pppos->in_tail->payload;
+        u16_t len = pppos->in_tail->len;
+        u16_t fcs = pppos->in_fcs;
+
+        PPPOS_PROTECT(lev);
+        if (pppos->open) {
+          while (l > 0 && len < pppos->in_tail->tot_len && !ESCAPE_P(pppos->in_accm, *s)) {
+            cur_char = *s++;
+            l--;
+            payload[len++] = cur_char;
+            fcs = PPP_FCS(fcs, cur_char);
+          }
+        }
+        PPPOS_UNPROTECT(lev);
+
+        pppos->in_tail->len = len;
+        pppos->in_fcs = fcs;
+      }
     }
   } /* while (l-- > 0), all bytes processed */
 }
@@ -856,6 +876,54 @@ pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t a
   return ERR_OK;
 }
 
+/*
+ * pppos_output_append_data - append a block of data to end of given pbuf,
+ * escaping characters as needed and updating the FCS.
+ * Equivalent to calling pppos_output_append for each character, but
+ * without the per-character call and error checking.
+ */
+static err_t
+pppos_output_append_data(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs)
+{
+  if (err != ERR_OK) {
+    return err;
+  }
+
+  u8_t *out = (u8_t*)nb->payload;
+  u16_t fcs_out = *fcs;
+
+  while (n > 0) {
+    /* Send the pbuf and reuse it once there may not be room for an
+     * escaped character. */
+    if ((nb->tot_len - nb->len) < 2) {
+      u32_t l = pppos->output_cb(pppos->ppp, out, nb->len, pppos->ppp->ctx_cb);
+      if (l != nb->len) {
+        *fcs = fcs_out;
+        return ERR_IF;
+      }
+      nb->len = 0;
+    }
+
+    u16_t len = nb->len;
+    u16_t limit = nb->tot_len - 1;
+    while (n > 0 && len < limit) {
+      u8_t c = *s++;
+      n--;
+      fcs_out = PPP_FCS(fcs_out, c);
+      if (ESCAPE_P(pppos->out_accm, c)) {
+        out[len++] = PPP_ESCAPE;
+        out[len++] = c ^ PPP_TRANS;
+      } else {
+        out[len++] = c;
+      }
+    }
+    nb->len = len;
+  }
+
+  *fcs = fcs_out;
+  return ERR_OK;
+}
+
 static err_t
 pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs)
 {
@@ -27,6 +27,10 @@
 #include "drivers/DigitalOut.h"
 #include "drivers/InterruptIn.h"
 
+#if DEVICE_SPI_ASYNCH
+#include "rtos/Semaphore.h"
+#endif
+
 namespace mbed {
 namespace nfc {
 
@@ -40,10 +44,23 @@ private:
 
     void transport_write(uint8_t address, const uint8_t *outBuf, size_t outLen);
     void transport_read(uint8_t address, uint8_t *inBuf, size_t inLen);
+    void transport_write_registers(const nfc_transport_register_t *registers, size_t count);
+    void transport_read_registers(nfc_transport_register_t *registers, size_t count);
+
+    // Move the data bytes of a FIFO access while the chip is selected
+    void transfer(const uint8_t *outBuf, uint8_t *inBuf, size_t len);
 
     // Callbacks from munfc
     static void s_transport_write(uint8_t address, const uint8_t *outBuf, size_t outLen, void *pUser);
     static void s_transport_read(uint8_t address, uint8_t *inBuf, size_t inLen, void *pUser);
+    static void s_transport_write_registers(const nfc_transport_register_t *registers, size_t count, void *pUser);
+    static void s_transport_read_registers(nfc_transport_register_t *registers, size_t count, void *pUser);
+
+#if DEVICE_SPI_ASYNCH
+    void transfer_done(int event);
+
+    rtos::Semaphore _transfer_sem;
+#endif
 
     nfc_transport_t _nfc_transport;
     mbed::SPI _spi;
@@ -23,6 +23,7 @@
 #include "NFCDefinitions.h"
 #include "NFCTarget.h"
 #include "NFCEEPROMDriver.h"
+#include "nfc/ndef/StreamingMessageParser.h"
 
 namespace mbed {
 namespace nfc {
@@ -98,6 +99,28 @@ public:
      */
     void set_delegate(Delegate *delegate);
 
+    /**
+     * Parse NDEF messages read from the EEPROM as they are read.
+     *
+     * When a parser is set, the message is read in chunks of the size of the
+     * NDEF buffer and fed to the parser instead of being decoded once fully
+     * read; messages larger than the NDEF buffer can therefore be read.
+     * Messages are still written from the NDEF buffer.
+     *
+     * @param[in] parser the parser to use, NULL to decode the whole message
+     */
+    void set_ndef_stream_parser(ndef::StreamingMessageParser *parser);
+
+    /**
+     * Compare each page with the message before writing it.
+     *
+     * Pages whose content is unchanged are not rewritten, which saves a
+     * write cycle and wear for each of them at the cost of reading them first.
+     *
+     * @param[in] enabled true to compare pages before writing them
+     */
+    void set_compare_before_write(bool enabled);
+
     // Implementation of NFCTarget
     virtual void write_ndef_message();
     virtual void read_ndef_message();
@@ -115,6 +138,8 @@ private:
 
     void handle_error(nfc_err_t ret);
     void continue_write();
+    void write_chunk();
+    void on_chunk_compared(size_t count);
     void continue_read();
     void continue_erase();
 
@@ -127,6 +152,7 @@ private:
         nfc_eeprom_write_start_session,
         nfc_eeprom_write_write_size,
         nfc_eeprom_write_write_bytes,
+        nfc_eeprom_write_compare_bytes,
         nfc_eeprom_write_end_session,
 
         nfc_eeprom_read_start_session,
@@ -150,6 +176,11 @@ private:
     ac_buffer_t _ndef_buffer_reader;
     size_t _ndef_buffer_read_sz;
     uint32_t _eeprom_address;
+    ndef::StreamingMessageParser *_stream_parser;
+    bool _compare_before_write;
+    size_t _write_chunk_size;
+    size_t _compare_offset;
+    uint8_t _compare_buffer[16];
     nfc_err_t _operation_result;
 };
 /** @}*/
@@ -129,6 +129,16 @@ public:
      */
     virtual size_t read_max_size() = 0;
 
+    /**
+     * Get the size of the pages of the EEPROM.
+     *
+     * Writes are split so that none crosses a page boundary, each one then
+     * takes a single write cycle.
+     *
+     * @return the page size in bytes, 0 if writes don't need to be split.
+     */
+    virtual size_t write_page_size();
+
     /**
      * Start a session of operations (reads, writes, erases, size gets/sets).
      * This method is called prior to any memory access to allow the underlying implementation
@@ -84,7 +84,13 @@ public:
          * Type is missing in a record expecting a type (well known type, media
          * type, absolute uri or external type).
          */
-        MISSING_TYPE_VALUE
+        MISSING_TYPE_VALUE,
+
+        /**
+         * Type and id of a record don't fit in the buffer of a
+         * StreamingMessageParser.
+         */
+        TYPE_ID_TOO_LONG
     };
 
     /**
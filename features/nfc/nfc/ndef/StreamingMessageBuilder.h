@@ -0,0 +1,130 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NFC_NDEF_STREAMINGMESSAGEBUILDER_H_
+#define NFC_NDEF_STREAMINGMESSAGEBUILDER_H_
+
+#include <stdint.h>
+
+#include "platform/Span.h"
+#include "platform/Callback.h"
+
+#include "nfc/ndef/Record.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+/** @addtogroup nfc
+ * @{
+ */
+
+/**
+ * Construct an NDEF Message record by record and hand it to the transport in
+ * pieces.
+ *
+ * Unlike MessageBuilder, the message is not stored in a single buffer: the
+ * header of a record is written first, then its payload as it is produced by
+ * the application. The bytes go through a small staging buffer which is
+ * passed to the flush callback every time it is full.
+ */
+class StreamingMessageBuilder {
+public:
+    /**
+     * Function called to push bytes of the message to the transport.
+     *
+     * It receives the next bytes of the message and returns true if they have
+     * been consumed, false otherwise. Once it has failed, the builder refuses
+     * any further operation until it is reset.
+     */
+    typedef mbed::Callback<bool(const Span<const uint8_t> &)> flush_function_t;
+
+    /**
+     * Construct a streaming message builder.
+     *
+     * @param buffer The staging buffer, it must not be empty.
+     * @param flush The function called to push the bytes of the message.
+     */
+    StreamingMessageBuilder(const Span<uint8_t> &buffer, const flush_function_t &flush);
+
+    /**
+     * Start a new record in the message.
+     *
+     * The payload of the previous record must have been fully appended.
+     *
+     * @param type The type of the record.
+     * @param id The id of the record.
+     * @param payload_size The size of the payload of the record.
+     * @param is_last_record true if the record is the last of the message.
+     *
+     * @return true if the record has been started, false otherwise.
+     */
+    bool begin_record(
+        const RecordType &type,
+        const RecordID &id,
+        uint32_t payload_size,
+        bool is_last_record
+    );
+
+    /**
+     * Append the next fragment of the payload of the current record.
+     *
+     * @param fragment The bytes to append.
+     *
+     * @return true if the fragment has been appended, false if it exceeds the
+     * payload size announced in begin_record() or if the flush failed.
+     */
+    bool append_payload(const Span<const uint8_t> &fragment);
+
+    /**
+     * Push the bytes remaining in the staging buffer to the transport.
+     *
+     * @return true in case of success, false otherwise.
+     */
+    bool flush();
+
+    /**
+     * Remove all the records pushed in the builder.
+     */
+    void reset();
+
+    /**
+     * Return if the message is complete.
+     *
+     * @return true if the last record has been started and its whole payload
+     * appended.
+     */
+    bool is_message_complete() const;
+
+private:
+    bool write(const uint8_t *data, size_t size);
+
+    Span<uint8_t> _buffer;
+    flush_function_t _flush;
+    size_t _position;
+    uint32_t _payload_remaining;
+    bool _message_started;
+    bool _message_ended;
+    bool _error;
+};
+
+/** @}*/
+
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
+
+#endif /* NFC_NDEF_STREAMINGMESSAGEBUILDER_H_ */
@@ -0,0 +1,176 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NFC_NDEF_STREAMINGMESSAGEPARSER_H_
+#define NFC_NDEF_STREAMINGMESSAGEPARSER_H_
+
+#include <stdlib.h>
+
+#include "platform/Span.h"
+#include "nfc/ndef/MessageParser.h"
+#include "nfc/ndef/Record.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+/** @addtogroup nfc
+ * @{
+ */
+
+/**
+ * Event driven NDEF Message parser working on successive chunks of a message.
+ *
+ * Unlike MessageParser, the message doesn't have to be stored in a single
+ * buffer: it can be fed as it is read from the transport. Record payloads are
+ * reported in fragments, as they are found in the chunks. Only the type and
+ * the id of the current record are copied, in a buffer provided by the
+ * application.
+ */
+class StreamingMessageParser {
+public:
+    /**
+     * Report parsing event to the application.
+     */
+    struct Delegate {
+        /**
+         * Invoked when parsing as started.
+         */
+        virtual void on_parsing_started() { }
+
+        /**
+         * Invoked when the header, type and id of a record have been parsed.
+         *
+         * @param type The type of the record. It remains valid until
+         * on_record_ended() is called.
+         * @param id The id of the record. It remains valid until
+         * on_record_ended() is called.
+         * @param payload_size The size of the payload of the record.
+         * @param last_record true if this is the last record of the message.
+         */
+        virtual void on_record_started(
+            const RecordType &type,
+            const RecordID &id,
+            uint32_t payload_size,
+            bool last_record
+        ) { }
+
+        /**
+         * Invoked when a fragment of the payload of the current record has been
+         * parsed.
+         *
+         * @param fragment The payload fragment, only valid for the duration
+         * of the call.
+         */
+        virtual void on_record_payload(const Span<const uint8_t> &fragment) { }
+
+        /**
+         * Invoked when the whole payload of the current record has been parsed.
+         */
+        virtual void on_record_ended() { }
+
+        /**
+         * Invoked when parsing is over.
+         */
+        virtual void on_parsing_terminated() { }
+
+        /**
+         * Invoked when an error is present in the message.
+         *
+         * @param error The error present in the message.
+         */
+        virtual void on_parsing_error(MessageParser::error_t error) { }
+
+    protected:
+        /**
+         * Protected non virtual destructor.
+         * Delegate is not meant to be destroyed in a polymorphic manner.
+         */
+        ~Delegate() { }
+    };
+
+    /**
+     * Construct a streaming message parser.
+     *
+     * @param type_id_buffer The buffer that holds the type and the id of the
+     * record being parsed. Records whose type and id don't fit are reported
+     * with the error TYPE_ID_TOO_LONG.
+     */
+    StreamingMessageParser(const Span<uint8_t> &type_id_buffer);
+
+    /**
+     * Set the handler that processes parsing events.
+     *
+     * @param delegate The parsing event handler.
+     */
+    void set_delegate(Delegate *delegate);
+
+    /**
+     * Start the parsing of a new message.
+     */
+    void begin();
+
+    /**
+     * Parse the next chunk of the message.
+     *
+     * @param chunk The data following the previous chunk in the message.
+     */
+    void feed(const Span<const uint8_t> &chunk);
+
+    /**
+     * Terminate the parsing of the message, no more data is available.
+     */
+    void end();
+
+private:
+    enum state_t {
+        STATE_IDLE,
+        STATE_HEADER,
+        STATE_TYPE_LENGTH,
+        STATE_PAYLOAD_LENGTH,
+        STATE_ID_LENGTH,
+        STATE_TYPE_ID,
+        STATE_PAYLOAD,
+        STATE_DONE,
+        STATE_ERROR
+    };
+
+    void parse_header(uint8_t header);
+    void parse_lengths_done();
+    void start_record();
+    void end_record();
+
+    void report_parsing_error(MessageParser::error_t error);
+
+    Delegate *_delegate;
+    Span<uint8_t> _type_id_buffer;
+    state_t _state;
+    uint8_t _header;
+    uint8_t _type_length;
+    uint8_t _id_length;
+    uint32_t _payload_length;
+    // bytes left in the field being parsed
+    uint32_t _remaining;
+    bool _first_record_parsed;
+};
+
+/** @}*/
+
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
+
+#endif /* NFC_NDEF_STREAMINGMESSAGEPARSER_H_ */
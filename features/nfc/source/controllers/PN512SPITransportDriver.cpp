@@ -26,6 +26,17 @@
 using namespace mbed;
 using namespace mbed::nfc;
 
+// Registers read in a single transaction
+static const size_t REGISTERS_BATCH_SIZE = 16;
+
+#if DEVICE_SPI_ASYNCH
+// Shorter FIFO accesses are not worth setting up a non-blocking transfer
+static const size_t ASYNC_TRANSFER_MIN_LENGTH = 8;
+
+// A full FIFO takes 52us at 10MHz, this only guards against a stuck peripheral
+static const uint32_t ASYNC_TRANSFER_TIMEOUT_MS = 100;
+#endif
+
 PN512SPITransportDriver::PN512SPITransportDriver(PinName mosi, PinName miso, PinName sclk, PinName ssel, PinName irq, PinName rst) :
     _spi(mosi, miso, sclk),
     _ssel(ssel, 1),
@@ -39,8 +50,13 @@ PN512SPITransportDriver::PN512SPITransportDriver(PinName mosi, PinName miso, Pin
     // The PN512 supports SPI clock frequencies up to 10MHz, so use this if we can
     _spi.frequency(10000000UL);
 
+#if DEVICE_SPI_ASYNCH
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
+
     // Initialize NFC transport
     nfc_transport_init(&_nfc_transport, &PN512SPITransportDriver::s_transport_write, &PN512SPITransportDriver::s_transport_read, this);
+    nfc_transport_set_registers_fns(&_nfc_transport, &PN512SPITransportDriver::s_transport_write_registers, &PN512SPITransportDriver::s_transport_read_registers);
 }
 
 void PN512SPITransportDriver::initialize()
@@ -72,10 +88,12 @@ void PN512SPITransportDriver::transport_write(uint8_t address, const uint8_t *ou
 
     // First byte is (address << 1) | 0x00 for a write
     address = (address << 1) | 0x00;
+    _spi.lock();
     _ssel = 0;
     _spi.write(address); // First write address byte
-    _spi.write((const char *) outBuf, outLen, (char *) NULL, 0); // Ignore read bytes
+    transfer(outBuf, NULL, outLen); // Ignore read bytes
     _ssel = 1;
+    _spi.unlock();
 }
 
 void PN512SPITransportDriver::transport_read(uint8_t address, uint8_t *inBuf, size_t inLen)
@@ -95,12 +113,81 @@ void PN512SPITransportDriver::transport_read(uint8_t address, uint8_t *inBuf, si
     // Also terminate with 0 so that it's a no-op
     inBuf[inLen - 1] = 0;
 
+    _spi.lock();
     _ssel = 0;
     _spi.write(address); // First write address byte
-    _spi.write((const char *) inBuf, inLen, (char *) inBuf, inLen);
+    transfer(inBuf, inBuf, inLen);
     _ssel = 1;
+    _spi.unlock();
+}
+
+void PN512SPITransportDriver::transport_write_registers(const nfc_transport_register_t *registers, size_t count)
+{
+    // A write transaction only targets one address, but the bus is only
+    // acquired once for the whole list
+    _spi.lock();
+    for (size_t i = 0; i < count; i++) {
+        char frame[2] = { (char)((registers[i].address << 1) | 0x00), (char) registers[i].value };
+        _ssel = 0;
+        _spi.write(frame, sizeof(frame), (char *) NULL, 0);
+        _ssel = 1;
+    }
+    _spi.unlock();
+}
+
+void PN512SPITransportDriver::transport_read_registers(nfc_transport_register_t *registers, size_t count)
+{
+    // Each byte of a read transaction holds the address of the next register
+    // to read, so different registers can be read in a single transaction;
+    // the value of each register comes one byte after its address
+    char frame[REGISTERS_BATCH_SIZE + 1];
+
+    _spi.lock();
+    while (count > 0) {
+        size_t len = count < REGISTERS_BATCH_SIZE ? count : REGISTERS_BATCH_SIZE;
+        for (size_t i = 0; i < len; i++) {
+            frame[i] = (registers[i].address << 1) | 0x80;
+        }
+        frame[len] = 0;
+
+        _ssel = 0;
+        _spi.write(frame, len + 1, frame, len + 1);
+        _ssel = 1;
+
+        for (size_t i = 0; i < len; i++) {
+            registers[i].value = frame[i + 1];
+        }
+        registers += len;
+        count -= len;
+    }
+    _spi.unlock();
+}
+
+void PN512SPITransportDriver::transfer(const uint8_t *outBuf, uint8_t *inBuf, size_t len)
+{
+#if DEVICE_SPI_ASYNCH
+    // Let the peripheral move FIFO data while this thread sleeps
+    if (len >= ASYNC_TRANSFER_MIN_LENGTH &&
+            _spi.transfer(outBuf, outBuf ? len : 0, inBuf, inBuf ? len : 0,
+                          callback(this, &PN512SPITransportDriver::transfer_done), SPI_EVENT_ALL) == 0) {
+        if (!_transfer_sem.try_acquire_for(std::chrono::milliseconds(ASYNC_TRANSFER_TIMEOUT_MS))) {
+            _spi.abort_transfer();
+            // consume a completion which raced with the timeout
+            _transfer_sem.try_acquire();
+        }
+        return;
+    }
+#endif
+    _spi.write((const char *) outBuf, outBuf ? len : 0, (char *) inBuf, inBuf ? len : 0);
 }
 
+#if DEVICE_SPI_ASYNCH
+void PN512SPITransportDriver::transfer_done(int event)
+{
+    _transfer_sem.release();
+}
+#endif
+
 // Callbacks from munfc
 void PN512SPITransportDriver::s_transport_write(uint8_t address, const uint8_t *outBuf, size_t outLen, void *pUser)
 {
@@ -114,4 +201,16 @@ void PN512SPITransportDriver::s_transport_read(uint8_t address, uint8_t *inBuf,
     self->transport_read(address, inBuf, inLen);
 }
 
+void PN512SPITransportDriver::s_transport_write_registers(const nfc_transport_register_t *registers, size_t count, void *pUser)
+{
+    PN512SPITransportDriver *self = (PN512SPITransportDriver *)pUser;
+    self->transport_write_registers(registers, count);
+}
+
+void PN512SPITransportDriver::s_transport_read_registers(nfc_transport_register_t *registers, size_t count, void *pUser)
+{
+    PN512SPITransportDriver *self = (PN512SPITransportDriver *)pUser;
+    self->transport_read_registers(registers, count);
+}
+
 #endif
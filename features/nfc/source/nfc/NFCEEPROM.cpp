@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <string.h>
+#include <algorithm>
+
 #include "NFCEEPROM.h"
 #include "ndef/ndef.h"
 
@@ -24,7 +27,8 @@ NFCEEPROM::NFCEEPROM(NFCEEPROMDriver *driver, events::EventQueue *queue, const S
     :
     NFCTarget(ndef_buffer), _delegate(NULL), _driver(driver), _event_queue(queue), _initialized(false),
     _current_op(nfc_eeprom_idle), _ndef_buffer_reader { nullptr, 0, nullptr }, _ndef_buffer_read_sz(0),
-    _eeprom_address(0), _operation_result(NFC_ERR_UNKNOWN)
+    _eeprom_address(0), _stream_parser(NULL),
+    _compare_before_write(false), _write_chunk_size(0), _compare_offset(0), _operation_result(NFC_ERR_UNKNOWN)
 {
     _driver->set_delegate(this);
     _driver->set_event_queue(queue);
@@ -45,6 +49,16 @@ void NFCEEPROM::set_delegate(NFCEEPROM::Delegate *delegate)
     _delegate = delegate;
 }
 
+void NFCEEPROM::set_ndef_stream_parser(ndef::StreamingMessageParser *parser)
+{
+    _stream_parser = parser;
+}
+
+void NFCEEPROM::set_compare_before_write(bool enabled)
+{
+    _compare_before_write = enabled;
+}
+
 void NFCEEPROM::write_ndef_message()
 {
     MBED_ASSERT(_initialized == true);
@@ -190,7 +204,11 @@ void NFCEEPROM::on_session_ended(bool success)
             _current_op = nfc_eeprom_idle;
 
             // Try to parse the NDEF message
-            ndef_msg_decode(ndef_message());
+            if (_stream_parser != NULL) {
+                _stream_parser->end();
+            } else {
+                ndef_msg_decode(ndef_message());
+            }
 
             if (_delegate != NULL) {
                 _delegate->on_ndef_message_read(_operation_result);
@@ -218,6 +236,14 @@ void NFCEEPROM::on_session_ended(bool success)
 void NFCEEPROM::on_bytes_read(size_t count)
 {
     switch (_current_op) {
+        case nfc_eeprom_write_compare_bytes:
+            if (count == 0) {
+                handle_error(NFC_ERR_CONTROLLER);
+                return;
+            }
+
+            on_chunk_compared(count);
+            break;
         case nfc_eeprom_read_read_bytes: {
             if (count == 0) {
                 handle_error(NFC_ERR_CONTROLLER);
@@ -227,6 +253,9 @@ void NFCEEPROM::on_bytes_read(size_t count)
             // Discard bytes that were actually read and update address
             _eeprom_address += count;
             ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
+            if (_stream_parser != NULL) {
+                _stream_parser->feed(Span<const uint8_t>(ac_buffer_builder_write_position(buffer_builder), count));
+            }
             ac_buffer_builder_write_n_skip(buffer_builder, count);
 
             // Continue reading
@@ -316,8 +345,11 @@ void NFCEEPROM::on_size_read(bool success, size_t size)
             ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
             ac_buffer_builder_reset(buffer_builder);
 
-            // Check that we have a big enough buffer to read the message
-            if (size > ac_buffer_builder_writable(buffer_builder)) {
+            // Check that we have a big enough buffer to read the message, a
+            // streamed message is read in chunks
+            if (_stream_parser != NULL) {
+                _stream_parser->begin();
+            } else if (size > ac_buffer_builder_writable(buffer_builder)) {
                 // Not enough space, close session
                 _current_op = nfc_eeprom_read_end_session;
                 _operation_result = NFC_ERR_BUFFER_TOO_SMALL;
@@ -367,8 +399,24 @@ void NFCEEPROM::on_bytes_erased(size_t count)
 void NFCEEPROM::continue_write()
 {
     if (ac_buffer_reader_readable(&_ndef_buffer_reader) > 0) {
-        // Continue writing
-        _driver->write_bytes(_eeprom_address, ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader));
+        // Never cross a page boundary, so that each write takes one write cycle
+        _write_chunk_size = ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader);
+        size_t page_size = _driver->write_page_size();
+        if (page_size > 0) {
+            size_t page_left = page_size - (_eeprom_address % page_size);
+            if (_write_chunk_size > page_left) {
+                _write_chunk_size = page_left;
+            }
+        }
+
+        if (_compare_before_write) {
+            // Read back the chunk first, it is only written if it differs
+            _current_op = nfc_eeprom_write_compare_bytes;
+            _compare_offset = 0;
+            _driver->read_bytes(_eeprom_address, _compare_buffer, std::min(_write_chunk_size, sizeof(_compare_buffer)));
+        } else {
+            write_chunk();
+        }
     } else {
         // we are done
         _current_op = nfc_eeprom_write_end_session;
@@ -377,6 +425,32 @@ void NFCEEPROM::continue_write()
     }
 }
 
+void NFCEEPROM::write_chunk()
+{
+    _current_op = nfc_eeprom_write_write_bytes;
+    _driver->write_bytes(_eeprom_address, ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), _write_chunk_size);
+}
+
+void NFCEEPROM::on_chunk_compared(size_t count)
+{
+    const uint8_t *expected = ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader) + _compare_offset;
+    if (memcmp(_compare_buffer, expected, count) != 0) {
+        write_chunk();
+        return;
+    }
+
+    _compare_offset += count;
+    if (_compare_offset < _write_chunk_size) {
+        _driver->read_bytes(_eeprom_address + _compare_offset, _compare_buffer, std::min(_write_chunk_size - _compare_offset, sizeof(_compare_buffer)));
+        return;
+    }
+
+    // Unchanged, move on to the next chunk
+    _eeprom_address += _write_chunk_size;
+    ac_buffer_read_n_skip(&_ndef_buffer_reader, _write_chunk_size);
+    _event_queue->call(this, &NFCEEPROM::continue_write);
+}
+
 void NFCEEPROM::continue_erase()
 {
     if (_eeprom_address < _driver->read_max_size()) {
@@ -394,7 +468,15 @@ void NFCEEPROM::continue_read()
     if (_eeprom_address < _ndef_buffer_read_sz) {
         // Continue reading
         ac_buffer_builder_t *buffer_builder = ndef_msg_buffer_builder(ndef_message());
-        _driver->read_bytes(_eeprom_address, ac_buffer_builder_write_position(buffer_builder), _ndef_buffer_read_sz - _eeprom_address);
+        size_t count = _ndef_buffer_read_sz - _eeprom_address;
+        if (_stream_parser != NULL) {
+            // The previous chunk has been parsed, reuse the whole buffer
+            ac_buffer_builder_reset(buffer_builder);
+            if (count > ac_buffer_builder_writable(buffer_builder)) {
+                count = ac_buffer_builder_writable(buffer_builder);
+            }
+        }
+        _driver->read_bytes(_eeprom_address, ac_buffer_builder_write_position(buffer_builder), count);
     } else {
         // Done, close session
         _current_op = nfc_eeprom_read_end_session;
@@ -39,6 +39,11 @@ void NFCEEPROMDriver::set_event_queue(events::EventQueue *queue)
     _event_queue = queue;
 }
 
+size_t NFCEEPROMDriver::write_page_size()
+{
+    return 0;
+}
+
 NFCEEPROMDriver::Delegate *NFCEEPROMDriver::delegate()
 {
     return _delegate;
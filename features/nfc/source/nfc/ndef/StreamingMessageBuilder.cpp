@@ -0,0 +1,181 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "nfc/ndef/StreamingMessageBuilder.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+StreamingMessageBuilder::StreamingMessageBuilder(
+    const Span<uint8_t> &buffer,
+    const flush_function_t &flush
+) :
+    _buffer(buffer),
+    _flush(flush),
+    _position(0),
+    _payload_remaining(0),
+    _message_started(false),
+    _message_ended(false),
+    _error(false)
+{ }
+
+bool StreamingMessageBuilder::begin_record(
+    const RecordType &type,
+    const RecordID &id,
+    uint32_t payload_size,
+    bool is_last_record
+)
+{
+    if (_error || _message_ended || _payload_remaining) {
+        return false;
+    }
+
+    if (type.value.size() > 255 || id.size() > 255) {
+        return false;
+    }
+
+    switch (type.tnf) {
+        case RecordType::empty:
+            if (!type.value.empty() || !id.empty() || payload_size) {
+                return false;
+            }
+            break;
+        case RecordType::well_known_type:
+        case RecordType::media_type:
+        case RecordType::absolute_uri:
+        case RecordType::external_type:
+            if (type.value.empty()) {
+                return false;
+            }
+            break;
+        case RecordType::unknown:
+            if (!type.value.empty()) {
+                return false;
+            }
+            break;
+        default:
+            // chunked records are not supported
+            return false;
+    }
+
+    uint8_t header[1 + 1 + 4 + 1];
+    size_t header_size = 0;
+    bool short_record = payload_size <= 255;
+
+    header[0] = type.tnf;
+    if (!_message_started) {
+        header[0] |= Header::message_begin_bit;
+    }
+    if (is_last_record) {
+        header[0] |= Header::message_end_bit;
+    }
+    if (short_record) {
+        header[0] |= Header::short_record_bit;
+    }
+    if (!id.empty()) {
+        header[0] |= Header::id_length_bit;
+    }
+    header_size++;
+
+    header[header_size++] = type.value.size();
+
+    if (short_record) {
+        header[header_size++] = payload_size;
+    } else {
+        header[header_size++] = (payload_size >> 24) & 0xFF;
+        header[header_size++] = (payload_size >> 16) & 0xFF;
+        header[header_size++] = (payload_size >> 8) & 0xFF;
+        header[header_size++] = payload_size & 0xFF;
+    }
+
+    if (!id.empty()) {
+        header[header_size++] = id.size();
+    }
+
+    _message_started = true;
+    _message_ended = is_last_record;
+    _payload_remaining = payload_size;
+
+    return write(header, header_size) &&
+           write(type.value.data(), type.value.size()) &&
+           write(id.data(), id.size());
+}
+
+bool StreamingMessageBuilder::append_payload(const Span<const uint8_t> &fragment)
+{
+    if (_error || (uint32_t) fragment.size() > _payload_remaining) {
+        return false;
+    }
+
+    _payload_remaining -= fragment.size();
+    return write(fragment.data(), fragment.size());
+}
+
+bool StreamingMessageBuilder::flush()
+{
+    if (_error) {
+        return false;
+    }
+
+    if (_position) {
+        if (!_flush(_buffer.first(_position))) {
+            _error = true;
+            return false;
+        }
+        _position = 0;
+    }
+
+    return true;
+}
+
+void StreamingMessageBuilder::reset()
+{
+    _position = 0;
+    _payload_remaining = 0;
+    _message_started = false;
+    _message_ended = false;
+    _error = false;
+}
+
+bool StreamingMessageBuilder::is_message_complete() const
+{
+    return _message_ended && !_payload_remaining;
+}
+
+bool StreamingMessageBuilder::write(const uint8_t *data, size_t size)
+{
+    while (size) {
+        if (_position == (size_t) _buffer.size() && !flush()) {
+            return false;
+        }
+
+        size_t count = std::min(size, (size_t) _buffer.size() - _position);
+        memcpy(_buffer.data() + _position, data, count);
+        _position += count;
+        data += count;
+        size -= count;
+    }
+
+    return true;
+}
+
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
@@ -0,0 +1,260 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "nfc/ndef/StreamingMessageParser.h"
+
+namespace mbed {
+namespace nfc {
+namespace ndef {
+
+StreamingMessageParser::StreamingMessageParser(const Span<uint8_t> &type_id_buffer) :
+    _delegate(NULL),
+    _type_id_buffer(type_id_buffer),
+    _state(STATE_IDLE),
+    _header(0),
+    _type_length(0),
+    _id_length(0),
+    _payload_length(0),
+    _remaining(0),
+    _first_record_parsed(false)
+{ }
+
+void StreamingMessageParser::set_delegate(Delegate *delegate)
+{
+    _delegate = delegate;
+}
+
+void StreamingMessageParser::begin()
+{
+    _state = STATE_HEADER;
+    _first_record_parsed = false;
+    if (_delegate) {
+        _delegate->on_parsing_started();
+    }
+}
+
+void StreamingMessageParser::feed(const Span<const uint8_t> &chunk)
+{
+    const uint8_t *it = chunk.data();
+    size_t left = chunk.size();
+
+    while (left) {
+        switch (_state) {
+            case STATE_HEADER:
+                parse_header(*it++);
+                left--;
+                break;
+
+            case STATE_TYPE_LENGTH:
+                _type_length = *it++;
+                left--;
+                _payload_length = 0;
+                _remaining = (_header & Header::short_record_bit) ? 1 : 4;
+                _state = STATE_PAYLOAD_LENGTH;
+                break;
+
+            case STATE_PAYLOAD_LENGTH:
+                // big endian, on one or four bytes
+                _payload_length = (_payload_length << 8) | *it++;
+                left--;
+                if (--_remaining == 0) {
+                    if (_header & Header::id_length_bit) {
+                        _state = STATE_ID_LENGTH;
+                    } else {
+                        _id_length = 0;
+                        parse_lengths_done();
+                    }
+                }
+                break;
+
+            case STATE_ID_LENGTH:
+                _id_length = *it++;
+                left--;
+                parse_lengths_done();
+                break;
+
+            case STATE_TYPE_ID: {
+                size_t count = std::min(left, (size_t) _remaining);
+                size_t offset = _type_length + _id_length - _remaining;
+                memcpy(_type_id_buffer.data() + offset, it, count);
+                it += count;
+                left -= count;
+                _remaining -= count;
+                if (_remaining == 0) {
+                    start_record();
+                }
+                break;
+            }
+
+            case STATE_PAYLOAD: {
+                size_t count = std::min(left, (size_t) _remaining);
+                // the remaining count is updated first as the delegate may
+                // inspect the parser state
+                _remaining -= count;
+                if (_delegate) {
+                    _delegate->on_record_payload(Span<const uint8_t>(it, count));
+                }
+                it += count;
+                left -= count;
+                if (_remaining == 0) {
+                    end_record();
+                }
+                break;
+            }
+
+            default:
+                // idle, error or message already complete: the rest of the
+                // data is not part of the message
+                return;
+        }
+    }
+}
+
+void StreamingMessageParser::end()
+{
+    if (_state == STATE_IDLE) {
+        return;
+    }
+
+    if (_state == STATE_HEADER) {
+        report_parsing_error(MessageParser::MISSING_MESSAGE_END);
+    } else if (_state != STATE_DONE && _state != STATE_ERROR) {
+        report_parsing_error(MessageParser::INSUFICIENT_DATA);
+    }
+
+    _state = STATE_IDLE;
+    if (_delegate) {
+        _delegate->on_parsing_terminated();
+    }
+}
+
+void StreamingMessageParser::parse_header(uint8_t header)
+{
+    // NOTE: report an error until the chunk parsing design is sorted out
+    if (header & Header::chunk_flag_bit) {
+        report_parsing_error(MessageParser::CHUNK_RECORD_NOT_SUPPORTED);
+        return;
+    }
+
+    // only the first record starts the message
+    if (_first_record_parsed == (bool)(header & Header::message_begin_bit)) {
+        report_parsing_error(MessageParser::INVALID_MESSAGE_START);
+        return;
+    }
+
+    _first_record_parsed = true;
+    _header = header;
+    _state = STATE_TYPE_LENGTH;
+}
+
+void StreamingMessageParser::parse_lengths_done()
+{
+    // validate the Type Name Format of the header
+    switch (_header & Header::tnf_bits) {
+        case RecordType::empty:
+            if (_type_length || _payload_length || _id_length) {
+                report_parsing_error(MessageParser::INVALID_EMPTY_RECORD);
+                return;
+            }
+            break;
+        case RecordType::well_known_type:
+        case RecordType::media_type:
+        case RecordType::absolute_uri:
+        case RecordType::external_type:
+            if (!_type_length) {
+                report_parsing_error(MessageParser::MISSING_TYPE_VALUE);
+                return;
+            }
+            break;
+        case RecordType::unknown:
+            if (_type_length) {
+                report_parsing_error(MessageParser::INVALID_UNKNOWN_TYPE_LENGTH);
+                return;
+            }
+            break;
+        case RecordType::unchanged:
+            // shouldn't be handled outside of chunk handling
+            report_parsing_error(MessageParser::INVALID_UNCHANGED_TYPE);
+            return;
+        default:
+            report_parsing_error(MessageParser::INVALID_TYPE_NAME_FORMAT);
+            return;
+    }
+
+    _remaining = _type_length + _id_length;
+    if (_remaining > (uint32_t) _type_id_buffer.size()) {
+        report_parsing_error(MessageParser::TYPE_ID_TOO_LONG);
+        return;
+    }
+
+    if (_remaining) {
+        _state = STATE_TYPE_ID;
+    } else {
+        start_record();
+    }
+}
+
+void StreamingMessageParser::start_record()
+{
+    _remaining = _payload_length;
+    _state = STATE_PAYLOAD;
+
+    if (_delegate) {
+        RecordType type(static_cast<RecordType::tnf_t>(_header & Header::tnf_bits));
+        if (_type_length) {
+            type.value = _type_id_buffer.first(_type_length);
+        }
+
+        RecordID id;
+        if (_id_length) {
+            id = _type_id_buffer.subspan(_type_length, _id_length);
+        }
+
+        _delegate->on_record_started(
+            type,
+            id,
+            _payload_length,
+            _header & Header::message_end_bit
+        );
+    }
+
+    if (_payload_length == 0) {
+        end_record();
+    }
+}
+
+void StreamingMessageParser::end_record()
+{
+    _state = (_header & Header::message_end_bit) ? STATE_DONE : STATE_HEADER;
+    if (_delegate) {
+        _delegate->on_record_ended();
+    }
+}
+
+void StreamingMessageParser::report_parsing_error(MessageParser::error_t error)
+{
+    _state = STATE_ERROR;
+    if (_delegate) {
+        _delegate->on_parsing_error(error);
+    }
+}
+
+} // namespace ndef
+} // namespace nfc
+} // namespace mbed
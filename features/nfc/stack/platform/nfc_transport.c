@@ -40,9 +40,22 @@ void nfc_transport_init(nfc_transport_t *pTransport, nfc_transport_write_fn_t wr
 {
     pTransport->write = write;
     pTransport->read = read;
+    pTransport->write_registers = NULL;
+    pTransport->read_registers = NULL;
     pTransport->pUser = pUser;
 }
 
+/** Set the functions accessing several registers at once
+ * \param pTransport pointer to an initialized nfc_transport_t structure
+ * \param write_registers transport function writing a list of registers, or NULL to write them one by one
+ * \param read_registers transport function reading a list of registers, or NULL to read them one by one
+ */
+void nfc_transport_set_registers_fns(nfc_transport_t *pTransport, nfc_transport_write_registers_fn_t write_registers, nfc_transport_read_registers_fn_t read_registers)
+{
+    pTransport->write_registers = write_registers;
+    pTransport->read_registers = read_registers;
+}
+
 
 
 
@@ -52,13 +52,37 @@ typedef void (*nfc_transport_write_fn_t)(uint8_t address, const uint8_t *outBuf,
  */
 typedef void (*nfc_transport_read_fn_t)(uint8_t address, uint8_t *inBuf, size_t inLen, void *pUser);
 
+/** Register access in a batch
+ */
+typedef struct __transport_register {
+    uint8_t address; ///< address of the register
+    uint8_t value; ///< value to write, or value read
+} nfc_transport_register_t;
+
+/** Function called to write the values of a list of registers
+ * \param registers registers to write, in order
+ * \param count number of registers
+ * \param pUser parameter passed to the nfc_transport_init function
+ */
+typedef void (*nfc_transport_write_registers_fn_t)(const nfc_transport_register_t *registers, size_t count, void *pUser);
+
+/** Function called to read the values of a list of registers
+ * \param registers registers to read, in order; their value field is filled in
+ * \param count number of registers
+ * \param pUser parameter passed to the nfc_transport_init function
+ */
+typedef void (*nfc_transport_read_registers_fn_t)(nfc_transport_register_t *registers, size_t count, void *pUser);
+
 typedef struct __transport {
     nfc_transport_write_fn_t write;
     nfc_transport_read_fn_t read;
+    nfc_transport_write_registers_fn_t write_registers;
+    nfc_transport_read_registers_fn_t read_registers;
     void *pUser;
 } nfc_transport_t;
 
 void nfc_transport_init(nfc_transport_t *pTransport, nfc_transport_write_fn_t write, nfc_transport_read_fn_t read, void *pUser);
+void nfc_transport_set_registers_fns(nfc_transport_t *pTransport, nfc_transport_write_registers_fn_t write_registers, nfc_transport_read_registers_fn_t read_registers);
 
 static inline void nfc_transport_write(nfc_transport_t *pTransport, uint8_t address, const uint8_t *outBuf, size_t outLen)
 {
@@ -70,6 +94,28 @@ static inline void nfc_transport_read(nfc_transport_t *pTransport, uint8_t addre
     pTransport->read(address, inBuf, inLen, pTransport->pUser);
 }
 
+static inline void nfc_transport_write_registers(nfc_transport_t *pTransport, const nfc_transport_register_t *registers, size_t count)
+{
+    if (pTransport->write_registers != NULL) {
+        pTransport->write_registers(registers, count, pTransport->pUser);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        pTransport->write(registers[i].address, &registers[i].value, 1, pTransport->pUser);
+    }
+}
+
+static inline void nfc_transport_read_registers(nfc_transport_t *pTransport, nfc_transport_register_t *registers, size_t count)
+{
+    if (pTransport->read_registers != NULL) {
+        pTransport->read_registers(registers, count, pTransport->pUser);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        pTransport->read(registers[i].address, &registers[i].value, 1, pTransport->pUser);
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,26 @@ static inline void pn512_hw_read(pn512_t *pPN512, uint8_t addr, uint8_t *buf, si
     nfc_transport_read(((nfc_transceiver_t *)pPN512)->pTransport, addr, buf, len);
 }
 
+/** \internal Write a list of registers on the underlying transport link
+ * \param pPN512 pointer to pn512_t structure
+ * \param registers addresses and values of the registers
+ * \param count number of registers
+ */
+static inline void pn512_hw_write_registers(pn512_t *pPN512, const nfc_transport_register_t *registers, size_t count)
+{
+    nfc_transport_write_registers(((nfc_transceiver_t *)pPN512)->pTransport, registers, count);
+}
+
+/** \internal Read a list of registers on the underlying transport link
+ * \param pPN512 pointer to pn512_t structure
+ * \param registers addresses of the registers, values are filled in
+ * \param count number of registers
+ */
+static inline void pn512_hw_read_registers(pn512_t *pPN512, nfc_transport_register_t *registers, size_t count)
+{
+    nfc_transport_read_registers(((nfc_transceiver_t *)pPN512)->pTransport, registers, count);
+}
+
 static inline void pn512_hw_write_buffer(pn512_t *pPN512, uint8_t addr, ac_buffer_t *pData, size_t len)
 {
     while (len > 0) {
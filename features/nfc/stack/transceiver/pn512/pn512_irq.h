@@ -66,8 +66,12 @@ extern "C" {
  */
 static inline void pn512_irq_set(pn512_t *pPN512, uint16_t irqs) //ORed
 {
-    pn512_register_write(pPN512, PN512_REG_COMIEN, PN512_REG_COMIEN_VAL | (PN512_REG_COMIEN_MASK & (irqs & 0xFF)));
-    pn512_register_write(pPN512, PN512_REG_DIVIEN, PN512_REG_DIVIEN_VAL | (PN512_REG_DIVIEN_MASK & (irqs >> 8)));
+    const uint8_t addresses[] = { PN512_REG_COMIEN, PN512_REG_DIVIEN };
+    const uint8_t values[] = {
+        PN512_REG_COMIEN_VAL | (PN512_REG_COMIEN_MASK & (irqs & 0xFF)),
+        PN512_REG_DIVIEN_VAL | (PN512_REG_DIVIEN_MASK & (irqs >> 8))
+    };
+    pn512_register_write_multiple(pPN512, addresses, values, 2);
     pPN512->irqsEn = irqs;
 }
 
@@ -87,8 +91,11 @@ static inline uint16_t pn512_irq_enabled(pn512_t *pPN512) //ORed
  */
 static inline uint16_t pn512_irq_get(pn512_t *pPN512) //ORed
 {
-    return ((pn512_register_read(pPN512, PN512_REG_COMIRQ) & PN512_REG_COMIEN_MASK)
-            | ((pn512_register_read(pPN512, PN512_REG_DIVIRQ) & PN512_REG_DIVIEN_MASK) << 8)) & pPN512->irqsEn;
+    const uint8_t addresses[] = { PN512_REG_COMIRQ, PN512_REG_DIVIRQ };
+    uint8_t values[2];
+    pn512_register_read_multiple(pPN512, addresses, values, 2);
+    return ((values[0] & PN512_REG_COMIEN_MASK)
+            | ((values[1] & PN512_REG_DIVIEN_MASK) << 8)) & pPN512->irqsEn;
 }
 
 /** \internal Clear some interrupts
@@ -97,8 +104,12 @@ static inline uint16_t pn512_irq_get(pn512_t *pPN512) //ORed
  */
 static inline void pn512_irq_clear(pn512_t *pPN512, uint16_t irqs)
 {
-    pn512_register_write(pPN512, PN512_REG_COMIRQ, PN512_REG_COMIRQ_CLEAR | (PN512_REG_COMIRQ_MASK & (irqs & 0xFF)));
-    pn512_register_write(pPN512, PN512_REG_DIVIRQ, PN512_REG_DIVIRQ_CLEAR | (PN512_REG_DIVIRQ_MASK & (irqs >> 8)));
+    const uint8_t addresses[] = { PN512_REG_COMIRQ, PN512_REG_DIVIRQ };
+    const uint8_t values[] = {
+        PN512_REG_COMIRQ_CLEAR | (PN512_REG_COMIRQ_MASK & (irqs & 0xFF)),
+        PN512_REG_DIVIRQ_CLEAR | (PN512_REG_DIVIRQ_MASK & (irqs >> 8))
+    };
+    pn512_register_write_multiple(pPN512, addresses, values, 2);
 }
 
 #ifdef __cplusplus
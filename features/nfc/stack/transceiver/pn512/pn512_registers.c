@@ -36,6 +36,9 @@
 #define REGISTER_PAGE(x) ((x)>>4)
 #define REGISTER_ADDR(x) ((x)&0xF)
 
+//Maximum number of registers passed to the transport at once
+#define REGISTERS_BATCH_SIZE 16
+
 /** \addtogroup PN512
  *  \internal
  *  @{
@@ -83,9 +86,7 @@ static const uint8_t PN512_CFG_INIT_VALS[] = {
 void pn512_registers_reset(pn512_t *pPN512)
 {
     pn512_register_switch_page_intl(pPN512, 0);
-    for (int i = 0; i < PN512_CFG_INIT_LEN; i++) {
-        pn512_register_write(pPN512, PN512_CFG_INIT_REGS[i], PN512_CFG_INIT_VALS[i]);
-    }
+    pn512_register_write_multiple(pPN512, PN512_CFG_INIT_REGS, PN512_CFG_INIT_VALS, PN512_CFG_INIT_LEN);
 }
 
 /** \internal Write register
@@ -124,6 +125,68 @@ uint8_t pn512_register_read(pn512_t *pPN512, uint8_t address)
     return data;
 }
 
+/** \internal Write several registers in as few transport accesses as possible
+ * \param pPN512 pointer to pn512_t structure
+ * \param addresses registers addresses, in the order in which they are written
+ * \param values values to write in the registers
+ * \param count number of registers
+ */
+void pn512_register_write_multiple(pn512_t *pPN512, const uint8_t *addresses, const uint8_t *values, size_t count)
+{
+    nfc_transport_register_t batch[REGISTERS_BATCH_SIZE];
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+        NFC_DBG("Write [%02x] << %02x", addresses[i], values[i]);
+        if (len + 2 > REGISTERS_BATCH_SIZE) {
+            pn512_hw_write_registers(pPN512, batch, len);
+            len = 0;
+        }
+        //Page switches are register writes too, they go in the same batch
+        if (REGISTER_PAGE(addresses[i]) != pPN512->registers.registers_page) {
+            pPN512->registers.registers_page = REGISTER_PAGE(addresses[i]);
+            batch[len].address = PN512_REG_PAGE;
+            batch[len].value = (1 << 7) | pPN512->registers.registers_page;
+            len++;
+        }
+        batch[len].address = REGISTER_ADDR(addresses[i]);
+        batch[len].value = values[i];
+        len++;
+    }
+    if (len > 0) {
+        pn512_hw_write_registers(pPN512, batch, len);
+    }
+}
+
+/** \internal Read several registers in as few transport accesses as possible
+ * \param pPN512 pointer to pn512_t structure
+ * \param addresses registers addresses, in the order in which they are read
+ * \param values values read from the registers
+ * \param count number of registers
+ */
+void pn512_register_read_multiple(pn512_t *pPN512, const uint8_t *addresses, uint8_t *values, size_t count)
+{
+    nfc_transport_register_t batch[REGISTERS_BATCH_SIZE];
+    size_t first = 0;
+    while (first < count) {
+        if (REGISTER_PAGE(addresses[first]) != pPN512->registers.registers_page) {
+            pn512_register_switch_page_intl(pPN512, REGISTER_PAGE(addresses[first]));
+        }
+        //Read registers up to the next page switch
+        size_t len = 0;
+        while ((first + len < count) && (len < REGISTERS_BATCH_SIZE)
+                && (REGISTER_PAGE(addresses[first + len]) == pPN512->registers.registers_page)) {
+            batch[len].address = REGISTER_ADDR(addresses[first + len]);
+            len++;
+        }
+        pn512_hw_read_registers(pPN512, batch, len);
+        for (size_t i = 0; i < len; i++) {
+            values[first + i] = batch[i].value;
+            NFC_DBG("Read  [%02x] >> %02x", addresses[first + i], values[first + i]);
+        }
+        first += len;
+    }
+}
+
 void pn512_register_switch_page(pn512_t *pPN512, uint8_t address)
 {
     if (REGISTER_PAGE(address) != pPN512->registers.registers_page) {
@@ -103,6 +103,8 @@ void pn512_registers_reset(pn512_t *pPN512);
 
 void pn512_register_write(pn512_t *pPN512, uint8_t address, uint8_t data);
 uint8_t pn512_register_read(pn512_t *pPN512, uint8_t address);
+void pn512_register_write_multiple(pn512_t *pPN512, const uint8_t *addresses, const uint8_t *values, size_t count);
+void pn512_register_read_multiple(pn512_t *pPN512, const uint8_t *addresses, uint8_t *values, size_t count);
 
 void pn512_register_switch_page(pn512_t *pPN512, uint8_t address);
 
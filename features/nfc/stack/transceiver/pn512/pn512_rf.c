@@ -80,9 +80,7 @@ nfc_err_t pn512_framing_set(pn512_t *pPN512, nfc_framing_t framing)
             return NFC_ERR_UNSUPPORTED;
     }
 
-    for (int i = 0; i < PN512_FRAMING_REGS; i++) {
-        pn512_register_write(pPN512, framing_registers[i], framing_registers_values[i]);
-    }
+    pn512_register_write_multiple(pPN512, framing_registers, framing_registers_values, PN512_FRAMING_REGS);
 
     pPN512->framing = framing;
     pPN512->crc.out = true;
@@ -29,11 +29,19 @@ void pn512_timer_config(pn512_t *pPN512, bool autostart, uint16_t prescaler, uin
 {
     pn512_timer_stop(pPN512); //just in case...
 
-    pn512_register_write(pPN512, PN512_REG_TRELOADLOW, countdown_value & 0xFF);
-    pn512_register_write(pPN512, PN512_REG_TRELOADHIGH, (countdown_value >> 8) & 0xFF);
-
-    pn512_register_write(pPN512, PN512_REG_TPRESCALERLOW, prescaler & 0xFF);
-    pn512_register_write(pPN512, PN512_REG_TMODE_TPRESCALERHIGH, (autostart ? 0x80 : 0x00) | ((prescaler >> 8) & 0x0F));
+    const uint8_t addresses[] = {
+        PN512_REG_TRELOADLOW,
+        PN512_REG_TRELOADHIGH,
+        PN512_REG_TPRESCALERLOW,
+        PN512_REG_TMODE_TPRESCALERHIGH
+    };
+    const uint8_t values[] = {
+        countdown_value & 0xFF,
+        (countdown_value >> 8) & 0xFF,
+        prescaler & 0xFF,
+        (autostart ? 0x80 : 0x00) | ((prescaler >> 8) & 0x0F)
+    };
+    pn512_register_write_multiple(pPN512, addresses, values, sizeof(addresses));
 }
 
 void pn512_timer_start(pn512_t *pPN512)
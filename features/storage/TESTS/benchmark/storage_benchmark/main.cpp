@@ -0,0 +1,614 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "BlockDevice.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "SlicingBlockDevice.h"
+#include "LittleFileSystem.h"
+#include "FATFileSystem.h"
+#include "TDBStore.h"
+#include "FileSystemStore.h"
+#include "SecureStore.h"
+#include "DeviceKey.h"
+#include <algorithm>
+#include <stdlib.h>
+#include <stdio.h>
+
+using namespace utest::v1;
+using namespace mbed;
+
+// Every result is sent to the host as {{bench;<fields>}}, see README.md
+
+// Latency samples kept per operation, further operations only count towards the throughput
+#ifndef BENCH_MAX_SAMPLES
+#define BENCH_MAX_SAMPLES 64
+#endif
+
+// Size of each read and program, and of each file read and write
+#ifndef BENCH_IO_SIZE
+#define BENCH_IO_SIZE 512
+#endif
+
+// Part of the default block device used for the block device and file system runs
+#ifndef BENCH_AREA_SIZE
+#define BENCH_AREA_SIZE (256 * 1024)
+#endif
+
+// Size of the heap backed devices
+#ifndef BENCH_HEAP_BD_SIZE
+#define BENCH_HEAP_BD_SIZE (64 * 1024)
+#endif
+
+#ifndef BENCH_FILE_SIZE
+#define BENCH_FILE_SIZE (16 * 1024)
+#endif
+
+#ifndef BENCH_KV_KEYS
+#define BENCH_KV_KEYS 32
+#endif
+
+#ifndef BENCH_KV_VALUE_SIZE
+#define BENCH_KV_VALUE_SIZE 64
+#endif
+
+// Timing of one kind of operation against one subject
+class Bench {
+public:
+    Bench(const char *suite, const char *subject, const char *op) :
+        _suite(suite), _subject(subject), _op(op), _count(0), _bytes(0), _total_us(0)
+    {
+    }
+
+    ~Bench()
+    {
+        report();
+    }
+
+    void start()
+    {
+        _timer.reset();
+        _timer.start();
+    }
+
+    void stop(uint64_t bytes = 0)
+    {
+        _timer.stop();
+        uint32_t us = _timer.elapsed_time().count();
+        if (_count < BENCH_MAX_SAMPLES) {
+            _samples[_count] = us;
+        }
+        _count++;
+        _bytes += bytes;
+        _total_us += us;
+    }
+
+private:
+    const char *_suite;
+    const char *_subject;
+    const char *_op;
+    Timer _timer;
+    uint32_t _samples[BENCH_MAX_SAMPLES];
+    uint32_t _count;
+    uint64_t _bytes;
+    uint64_t _total_us;
+
+    uint32_t percentile(uint32_t n, uint32_t pct)
+    {
+        return _samples[(n - 1) * pct / 100];
+    }
+
+    void report()
+    {
+        if (!_count) {
+            return;
+        }
+
+        uint32_t n = std::min<uint32_t>(_count, BENCH_MAX_SAMPLES);
+        std::sort(_samples, _samples + n);
+        uint32_t kib_s = _total_us ? (uint32_t)(_bytes * 1000000 / 1024 / _total_us) : 0;
+
+        char buf[160];
+        snprintf(buf, sizeof(buf), "%s,%s,%s,%lu,%llu,%llu,%lu,%lu,%lu,%lu,%lu",
+                 _suite, _subject, _op, (unsigned long)_count, (unsigned long long)_bytes,
+                 (unsigned long long)_total_us, (unsigned long)kib_s,
+                 (unsigned long)percentile(n, 50), (unsigned long)percentile(n, 90),
+                 (unsigned long)percentile(n, 99), (unsigned long)_samples[n - 1]);
+        greentea_send_kv("bench", buf);
+    }
+};
+
+static uint8_t *io_buf = NULL;
+
+static void fill_io_buf(size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        io_buf[i] = rand() & 0xff;
+    }
+}
+
+static bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+// ---------------------------------------------------------------------------------------------- Block devices
+
+static void bench_block_device(const char *subject, BlockDevice *bd)
+{
+    {
+        Bench bench("bd", subject, "init");
+        bench.start();
+        int err = bd->init();
+        bench.stop();
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    bd_size_t erase_size = bd->get_erase_size();
+    bd_size_t area = std::min<bd_size_t>(bd->size(), BENCH_AREA_SIZE) / erase_size * erase_size;
+    bd_size_t read_io = align_up(BENCH_IO_SIZE, bd->get_read_size());
+    bd_size_t program_io = align_up(BENCH_IO_SIZE, bd->get_program_size());
+    TEST_SKIP_UNLESS_MESSAGE(area >= erase_size && area >= std::max(read_io, program_io),
+                             "Erase unit too large for the benchmark area");
+
+    io_buf = new (std::nothrow) uint8_t[std::max(read_io, program_io)];
+    TEST_SKIP_UNLESS_MESSAGE(io_buf, "Not enough heap memory to run test. Test skipped.");
+
+    {
+        Bench bench("bd", subject, "erase");
+        for (bd_addr_t addr = 0; addr < area; addr += erase_size) {
+            bench.start();
+            int err = bd->erase(addr, erase_size);
+            bench.stop(erase_size);
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    {
+        Bench bench("bd", subject, "seq_program");
+        for (bd_addr_t addr = 0; addr + program_io <= area; addr += program_io) {
+            fill_io_buf(program_io);
+            bench.start();
+            int err = bd->program(io_buf, addr, program_io);
+            bench.stop(program_io);
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    {
+        Bench bench("bd", subject, "seq_read");
+        for (bd_addr_t addr = 0; addr + read_io <= area; addr += read_io) {
+            bench.start();
+            int err = bd->read(io_buf, addr, read_io);
+            bench.stop(read_io);
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    {
+        Bench bench("bd", subject, "rand_read");
+        for (int i = 0; i < BENCH_MAX_SAMPLES; i++) {
+            bd_addr_t addr = rand() % (area / read_io) * read_io;
+            bench.start();
+            int err = bd->read(io_buf, addr, read_io);
+            bench.stop(read_io);
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    {
+        // Rewrite the start of erase units in a random order, erasing each one just before
+        Bench erase_bench("bd", subject, "rand_erase");
+        Bench program_bench("bd", subject, "rand_program");
+        uint32_t units = area / erase_size;
+        for (int i = 0; i < BENCH_MAX_SAMPLES && i < (int)units; i++) {
+            bd_addr_t addr = rand() % units * erase_size;
+            erase_bench.start();
+            int err = bd->erase(addr, erase_size);
+            erase_bench.stop(erase_size);
+            TEST_ASSERT_EQUAL(0, err);
+
+            fill_io_buf(program_io);
+            program_bench.start();
+            err = bd->program(io_buf, addr, program_io);
+            program_bench.stop(program_io);
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    delete[] io_buf;
+    io_buf = NULL;
+
+    {
+        Bench bench("bd", subject, "deinit");
+        bench.start();
+        int err = bd->deinit();
+        bench.stop();
+        TEST_ASSERT_EQUAL(0, err);
+    }
+}
+
+static void test_bd_heap()
+{
+    HeapBlockDevice *bd = new (std::nothrow) HeapBlockDevice(BENCH_HEAP_BD_SIZE, 512);
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+    bench_block_device("heap", bd);
+    delete bd;
+}
+
+static void test_bd_flashsim()
+{
+    HeapBlockDevice *heap_bd = new (std::nothrow) HeapBlockDevice(BENCH_HEAP_BD_SIZE, 1, 1, 4096);
+    FlashSimBlockDevice *bd = new (std::nothrow) FlashSimBlockDevice(heap_bd);
+    TEST_SKIP_UNLESS_MESSAGE(heap_bd && bd, "Not enough heap memory to run test. Test skipped.");
+    bench_block_device("flashsim", bd);
+    delete bd;
+    delete heap_bd;
+}
+
+static void test_bd_default()
+{
+    BlockDevice *bd = BlockDevice::get_default_instance();
+    TEST_SKIP_UNLESS_MESSAGE(bd, "No default block device on this target");
+    bench_block_device(bd->get_type(), bd);
+}
+
+// ---------------------------------------------------------------------------------------------- File systems
+
+static void bench_filesystem(const char *subject, FileSystem *fs, BlockDevice *bd)
+{
+    int err;
+
+    {
+        Bench bench("fs", subject, "format");
+        bench.start();
+        err = fs->reformat(bd);
+        bench.stop();
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    {
+        Bench unmount_bench("fs", subject, "unmount");
+        Bench mount_bench("fs", subject, "mount");
+        for (int i = 0; i < 4; i++) {
+            unmount_bench.start();
+            err = fs->unmount();
+            unmount_bench.stop();
+            TEST_ASSERT_EQUAL(0, err);
+
+            mount_bench.start();
+            err = fs->mount(bd);
+            mount_bench.stop();
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    io_buf = new (std::nothrow) uint8_t[BENCH_IO_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(io_buf, "Not enough heap memory to run test. Test skipped.");
+
+    File file;
+    {
+        Bench write_bench("fs", subject, "file_write");
+        Bench close_bench("fs", subject, "file_close");
+        err = file.open(fs, "bench.dat", O_WRONLY | O_CREAT | O_TRUNC);
+        TEST_ASSERT_EQUAL(0, err);
+        for (int i = 0; i < BENCH_FILE_SIZE / BENCH_IO_SIZE; i++) {
+            fill_io_buf(BENCH_IO_SIZE);
+            write_bench.start();
+            ssize_t size = file.write(io_buf, BENCH_IO_SIZE);
+            write_bench.stop(BENCH_IO_SIZE);
+            TEST_ASSERT_EQUAL(BENCH_IO_SIZE, size);
+        }
+        close_bench.start();
+        err = file.close();
+        close_bench.stop();
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    {
+        Bench bench("fs", subject, "file_read");
+        err = file.open(fs, "bench.dat", O_RDONLY);
+        TEST_ASSERT_EQUAL(0, err);
+        for (int i = 0; i < BENCH_FILE_SIZE / BENCH_IO_SIZE; i++) {
+            bench.start();
+            ssize_t size = file.read(io_buf, BENCH_IO_SIZE);
+            bench.stop(BENCH_IO_SIZE);
+            TEST_ASSERT_EQUAL(BENCH_IO_SIZE, size);
+        }
+
+        Bench rand_bench("fs", subject, "file_rand_read");
+        for (int i = 0; i < BENCH_MAX_SAMPLES; i++) {
+            off_t off = rand() % (BENCH_FILE_SIZE - BENCH_IO_SIZE + 1);
+            rand_bench.start();
+            file.seek(off, SEEK_SET);
+            ssize_t size = file.read(io_buf, BENCH_IO_SIZE);
+            rand_bench.stop(BENCH_IO_SIZE);
+            TEST_ASSERT_EQUAL(BENCH_IO_SIZE, size);
+        }
+        err = file.close();
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    delete[] io_buf;
+    io_buf = NULL;
+
+    {
+        Bench create_bench("fs", subject, "create");
+        Bench stat_bench("fs", subject, "stat");
+        Bench remove_bench("fs", subject, "remove");
+        char path[16];
+        struct stat st;
+        for (int i = 0; i < 16; i++) {
+            snprintf(path, sizeof(path), "small%d", i);
+            create_bench.start();
+            err = file.open(fs, path, O_WRONLY | O_CREAT);
+            if (!err) {
+                err = file.close();
+            }
+            create_bench.stop();
+            TEST_ASSERT_EQUAL(0, err);
+        }
+        for (int i = 0; i < 16; i++) {
+            snprintf(path, sizeof(path), "small%d", i);
+            stat_bench.start();
+            err = fs->stat(path, &st);
+            stat_bench.stop();
+            TEST_ASSERT_EQUAL(0, err);
+        }
+        for (int i = 0; i < 16; i++) {
+            snprintf(path, sizeof(path), "small%d", i);
+            remove_bench.start();
+            err = fs->remove(path);
+            remove_bench.stop();
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+
+    err = fs->remove("bench.dat");
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs->unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+static const char *fs_name(LittleFileSystem *)
+{
+    return "littlefs";
+}
+
+static const char *fs_name(FATFileSystem *)
+{
+    return "fat";
+}
+
+template <typename FS>
+static void test_fs_heap()
+{
+    HeapBlockDevice *bd = new (std::nothrow) HeapBlockDevice(BENCH_HEAP_BD_SIZE, 512);
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+    FS fs("bench");
+    char subject[32];
+    snprintf(subject, sizeof(subject), "%s@heap", fs_name(&fs));
+    bench_filesystem(subject, &fs, bd);
+    delete bd;
+}
+
+template <typename FS>
+static void test_fs_default()
+{
+    BlockDevice *bd = BlockDevice::get_default_instance();
+    TEST_SKIP_UNLESS_MESSAGE(bd, "No default block device on this target");
+
+    int err = bd->init();
+    TEST_ASSERT_EQUAL(0, err);
+    bd_size_t erase_size = bd->get_erase_size();
+    bd_size_t area = std::min<bd_size_t>(bd->size(), BENCH_AREA_SIZE) / erase_size * erase_size;
+    err = bd->deinit();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_SKIP_UNLESS_MESSAGE(area >= 16 * erase_size, "Not enough erase units for a file system");
+
+    SlicingBlockDevice slice(bd, 0, area);
+    FS fs("bench");
+    char subject[32];
+    snprintf(subject, sizeof(subject), "%s@%s", fs_name(&fs), bd->get_type());
+    bench_filesystem(subject, &fs, &slice);
+}
+
+// ---------------------------------------------------------------------------------------------- KVStores
+
+static void bench_kvstore(const char *subject, KVStore *kv)
+{
+    int err;
+    char key[16];
+    uint8_t value[BENCH_KV_VALUE_SIZE];
+    size_t actual_size;
+
+    {
+        Bench bench("kv", subject, "init");
+        bench.start();
+        err = kv->init();
+        bench.stop();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+    }
+
+    {
+        Bench bench("kv", subject, "reset");
+        bench.start();
+        err = kv->reset();
+        bench.stop();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+    }
+
+    {
+        Bench bench("kv", subject, "set");
+        for (int i = 0; i < BENCH_KV_KEYS; i++) {
+            snprintf(key, sizeof(key), "bench_%d", i);
+            for (size_t j = 0; j < sizeof(value); j++) {
+                value[j] = rand() & 0xff;
+            }
+            bench.start();
+            err = kv->set(key, value, sizeof(value), 0);
+            bench.stop(sizeof(value));
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        }
+    }
+
+    {
+        Bench bench("kv", subject, "deinit");
+        bench.start();
+        err = kv->deinit();
+        bench.stop();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+    }
+
+    {
+        // Init again, this time with the keys to rebuild state from
+        Bench bench("kv", subject, "init_full");
+        bench.start();
+        err = kv->init();
+        bench.stop();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+    }
+
+    {
+        Bench bench("kv", subject, "get");
+        for (int i = 0; i < BENCH_KV_KEYS; i++) {
+            snprintf(key, sizeof(key), "bench_%d", rand() % BENCH_KV_KEYS);
+            bench.start();
+            err = kv->get(key, value, sizeof(value), &actual_size);
+            bench.stop(sizeof(value));
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+            TEST_ASSERT_EQUAL(sizeof(value), actual_size);
+        }
+    }
+
+    {
+        Bench bench("kv", subject, "iterate");
+        KVStore::iterator_t it;
+        int count = 0;
+        bench.start();
+        err = kv->iterator_open(&it, "bench_");
+        if (!err) {
+            while (kv->iterator_next(it, key, sizeof(key)) == MBED_SUCCESS) {
+                count++;
+            }
+            err = kv->iterator_close(it);
+        }
+        bench.stop();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        TEST_ASSERT_EQUAL(BENCH_KV_KEYS, count);
+    }
+
+    {
+        Bench bench("kv", subject, "remove");
+        for (int i = 0; i < BENCH_KV_KEYS; i++) {
+            snprintf(key, sizeof(key), "bench_%d", i);
+            bench.start();
+            err = kv->remove(key);
+            bench.stop();
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        }
+    }
+
+    err = kv->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+}
+
+static void test_kv_tdbstore()
+{
+    HeapBlockDevice *heap_bd = new (std::nothrow) HeapBlockDevice(8 * 4096, 1, 1, 4096);
+    FlashSimBlockDevice *bd = new (std::nothrow) FlashSimBlockDevice(heap_bd);
+    TEST_SKIP_UNLESS_MESSAGE(heap_bd && bd, "Not enough heap memory to run test. Test skipped.");
+
+    TDBStore kv(bd);
+    bench_kvstore("tdbstore", &kv);
+
+    delete bd;
+    delete heap_bd;
+}
+
+static void test_kv_filesystemstore()
+{
+    HeapBlockDevice *bd = new (std::nothrow) HeapBlockDevice(BENCH_HEAP_BD_SIZE, 512);
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    LittleFileSystem fs("bench");
+    int err = fs.reformat(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    FileSystemStore kv(&fs);
+    bench_kvstore("filesystemstore", &kv);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+    delete bd;
+}
+
+static void test_kv_securestore()
+{
+#if SECURESTORE_ENABLED
+    HeapBlockDevice *heap_bd = new (std::nothrow) HeapBlockDevice(12 * 4096, 1, 1, 4096);
+    FlashSimBlockDevice *bd = new (std::nothrow) FlashSimBlockDevice(heap_bd);
+    TEST_SKIP_UNLESS_MESSAGE(heap_bd && bd, "Not enough heap memory to run test. Test skipped.");
+
+    SlicingBlockDevice ul_bd(bd, 0, 8 * 4096);
+    SlicingBlockDevice rbp_bd(bd, 8 * 4096, 12 * 4096);
+    TDBStore ul_kv(&ul_bd);
+    TDBStore rbp_kv(&rbp_bd);
+    SecureStore kv(&ul_kv, &rbp_kv);
+
+#if DEVICEKEY_ENABLED
+    DeviceKey::get_instance().generate_root_of_trust();
+#endif
+    bench_kvstore("securestore", &kv);
+
+    delete bd;
+    delete heap_bd;
+#else
+    TEST_SKIP_MESSAGE("SecureStore is not enabled on this target");
+#endif
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(600, "default_auto");
+    srand(1);
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Benchmark HeapBlockDevice", test_bd_heap),
+    Case("Benchmark FlashSimBlockDevice", test_bd_flashsim),
+    Case("Benchmark default block device", test_bd_default),
+    Case("Benchmark LittleFileSystem on heap", test_fs_heap<LittleFileSystem>),
+    Case("Benchmark FATFileSystem on heap", test_fs_heap<FATFileSystem>),
+    Case("Benchmark LittleFileSystem on default block device", test_fs_default<LittleFileSystem>),
+    Case("Benchmark FATFileSystem on default block device", test_fs_default<FATFileSystem>),
+    Case("Benchmark TDBStore", test_kv_tdbstore),
+    Case("Benchmark FileSystemStore", test_kv_filesystemstore),
+    Case("Benchmark SecureStore", test_kv_securestore),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
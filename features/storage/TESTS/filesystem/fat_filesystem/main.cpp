@@ -106,6 +106,198 @@ void test_read_write()
 }
 
 
+// Test streaming writes to a preallocated file
+void test_stream_write()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    const int size = 16 * BLOCK_SIZE + BLOCK_SIZE / 2;
+    uint8_t *buffer = new (std::nothrow) uint8_t[size];
+    TEST_SKIP_UNLESS_MESSAGE(buffer, "Not enough heap memory to run test. Test skipped.");
+
+    srand(2);
+    for (int i = 0; i < size; i++) {
+        buffer[i] = 0xff & rand();
+    }
+
+    File file;
+    err = file.open(&fs, "test_stream.dat", O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Without fat_chan.ff_use_expand, the chain is just allocated as the file grows
+    bool preallocated = file.preallocate(32 * BLOCK_SIZE) == 0;
+
+    // Whole sectors first, then a partial one
+    ssize_t written = file.write(buffer, 16 * BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(16 * BLOCK_SIZE, written);
+    written = file.write(buffer + 16 * BLOCK_SIZE, BLOCK_SIZE / 2);
+    TEST_ASSERT_EQUAL(BLOCK_SIZE / 2, written);
+    if (preallocated) {
+        err = file.truncate(size);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    struct stat st;
+    err = fs.stat("test_stream.dat", &st);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(size, st.st_size);
+
+    memset(buffer, 0, size);
+    err = file.open(&fs, "test_stream.dat", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    ssize_t read = file.read(buffer, size);
+    TEST_ASSERT_EQUAL(size, read);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    srand(2);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL(0xff & rand(), buffer[i]);
+    }
+
+    err = fs.remove("test_stream.dat");
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+
+    delete[] buffer;
+}
+
+// Test counting free space in steps after mount
+void test_scan_free_space()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    struct statvfs empty;
+    err = fs.statvfs("", &empty);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Scanning after the count is known is a no-op
+    err = fs.scan_free_space();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(-EINVAL, fs.scan_free_space(0));
+
+    File file;
+    err = file.open(&fs, "test_scan.dat", O_WRONLY | O_CREAT | O_TRUNC);
+    TEST_ASSERT_EQUAL(0, err);
+    uint8_t buffer[BLOCK_SIZE] = {};
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(BLOCK_SIZE, file.write(buffer, BLOCK_SIZE));
+    }
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    struct statvfs used;
+    err = fs.statvfs("", &used);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT(used.f_bfree < empty.f_bfree);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // A small volume keeps no FSInfo, so the count has to be rebuilt after mount
+    err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.scan_free_space(1);
+    TEST_ASSERT_EQUAL(0, err);
+
+    struct statvfs scanned;
+    err = fs.statvfs("", &scanned);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(used.f_bfree, scanned.f_bfree);
+
+    err = fs.remove("test_scan.dat");
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.statvfs("", &scanned);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(empty.f_bfree, scanned.f_bfree);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+#if MBED_CONF_RTOS_PRESENT
+static ssize_t async_result;
+
+static void async_done(EventQueue *queue, ssize_t result)
+{
+    async_result = result;
+    queue->break_dispatch();
+}
+
+// Test reads and writes completed on the storage worker thread
+void test_async_read_write()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    const int size = 2 * BLOCK_SIZE;
+    uint8_t *buffer = new (std::nothrow) uint8_t[size];
+    TEST_SKIP_UNLESS_MESSAGE(buffer, "Not enough heap memory to run test. Test skipped.");
+
+    srand(3);
+    for (int i = 0; i < size; i++) {
+        buffer[i] = 0xff & rand();
+    }
+
+    // Completions are dispatched in this thread
+    EventQueue queue(8 * EVENTS_EVENT_SIZE);
+
+    File file;
+    err = file.open(&fs, "test_async.dat", O_RDWR | O_CREAT | O_TRUNC);
+    TEST_ASSERT_EQUAL(0, err);
+
+    async_result = 0;
+    int id = file.write_async(buffer, size, callback(async_done, &queue), &queue);
+    TEST_ASSERT(id > 0);
+    queue.dispatch(10000);
+    TEST_ASSERT_EQUAL(size, async_result);
+
+    err = file.seek(0, SEEK_SET);
+    TEST_ASSERT_EQUAL(0, err);
+
+    memset(buffer, 0, size);
+    async_result = 0;
+    id = file.read_async(buffer, size, callback(async_done, &queue), &queue);
+    TEST_ASSERT(id > 0);
+    queue.dispatch(10000);
+    TEST_ASSERT_EQUAL(size, async_result);
+
+    srand(3);
+    for (int i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL(0xff & rand(), buffer[i]);
+    }
+
+    // A completed request can no longer be cancelled
+    TEST_ASSERT_FALSE(file.cancel_async(id));
+
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.remove("test_async.dat");
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+
+    delete[] buffer;
+}
+#endif
+
 // Simple test for iterating dir entries
 void test_read_dir()
 {
@@ -184,6 +376,11 @@ Case cases[] = {
     Case("Testing formating", test_format),
     Case("Testing read write < block", test_read_write < BLOCK_SIZE / 2 >),
     Case("Testing read write > block", test_read_write<2 * BLOCK_SIZE>),
+    Case("Testing streaming write", test_stream_write),
+    Case("Testing free space scan", test_scan_free_space),
+#if MBED_CONF_RTOS_PRESENT
+    Case("Testing async read write", test_async_read_write),
+#endif
     Case("Testing dir iteration", test_read_dir),
 };
 
@@ -0,0 +1,182 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "ROMFileSystem.h"
+#include <string.h>
+#include "mbed_retarget.h"
+
+using namespace utest::v1;
+
+// Image built by tools/mkromfs.py --c-array from:
+//   certs.ver              "v1.0"
+//   certs/ca.pem           "root certificate\n"
+//   certs/client/cert.pem  "client certificate\n"
+//   certs/client/key.pem   "client key\n"
+//   index.html             "<html></html>\n"
+//   ui/logo.bmp            "logo"
+static const uint32_t romfs_image[] = {
+    0x314d4f52, 0x00000006, 0x000000fc, 0x00000054, 0x000000b0, 0x00000004, 0x0000005e, 0x000000b4,
+    0x00000011, 0x0000006b, 0x000000c8, 0x00000013, 0x00000081, 0x000000dc, 0x0000000b, 0x00000096,
+    0x000000e8, 0x0000000e, 0x000000a1, 0x000000f8, 0x00000004, 0x74726563, 0x65762e73, 0x65630072,
+    0x2f737472, 0x702e6163, 0x63006d65, 0x73747265, 0x696c632f, 0x2f746e65, 0x74726563, 0x6d65702e,
+    0x72656300, 0x632f7374, 0x6e65696c, 0x656b2f74, 0x65702e79, 0x6e69006d, 0x2e786564, 0x6c6d7468,
+    0x2f697500, 0x6f676f6c, 0x706d622e, 0x00000000, 0x302e3176, 0x746f6f72, 0x72656320, 0x69666974,
+    0x65746163, 0x0000000a, 0x65696c63, 0x6320746e, 0x69747265, 0x61636966, 0x000a6574, 0x65696c63,
+    0x6b20746e, 0x000a7965, 0x6d74683c, 0x2f3c3e6c, 0x6c6d7468, 0x00000a3e, 0x6f676f6c,
+};
+
+void test_mount()
+{
+    ROMFileSystem fs("rom");
+    static const uint32_t bad_image[4] = {};
+
+    TEST_ASSERT_EQUAL(-EINVAL, fs.mount((BlockDevice *)NULL));
+    TEST_ASSERT_EQUAL(-EINVAL, fs.mount(bad_image));
+    TEST_ASSERT_EQUAL(0, fs.mount(romfs_image));
+    TEST_ASSERT_EQUAL(0, fs.unmount());
+}
+
+void test_read()
+{
+    ROMFileSystem fs("rom", romfs_image);
+    char buffer[32];
+
+    File file;
+    TEST_ASSERT_EQUAL(0, file.open(&fs, "certs/client/cert.pem"));
+    TEST_ASSERT_EQUAL(19, file.size());
+    TEST_ASSERT_EQUAL(7, file.read(buffer, 7));
+    TEST_ASSERT_EQUAL_MEMORY("client ", buffer, 7);
+    TEST_ASSERT_EQUAL(12, file.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("certificate\n", buffer, 12);
+    TEST_ASSERT_EQUAL(0, file.read(buffer, sizeof(buffer)));
+
+    TEST_ASSERT_EQUAL(2, file.seek(-17, SEEK_END));
+    TEST_ASSERT_EQUAL(4, file.read(buffer, 4));
+    TEST_ASSERT_EQUAL_MEMORY("ient", buffer, 4);
+    TEST_ASSERT_EQUAL(0, file.close());
+
+    TEST_ASSERT_EQUAL(0, file.open(&fs, "/ui/logo.bmp"));
+    TEST_ASSERT_EQUAL(4, file.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("logo", buffer, 4);
+    TEST_ASSERT_EQUAL(0, file.close());
+}
+
+void test_map()
+{
+    ROMFileSystem fs("rom", romfs_image);
+    const void *data = NULL;
+
+    File file;
+    TEST_ASSERT_EQUAL(0, file.open(&fs, "certs/ca.pem"));
+    TEST_ASSERT_EQUAL(0, file.map(&data));
+    TEST_ASSERT_EQUAL_MEMORY("root certificate\n", data, file.size());
+
+    // The contents are used in place
+    const uint8_t *image = (const uint8_t *)romfs_image;
+    TEST_ASSERT_TRUE(data >= image && data < image + sizeof(romfs_image));
+    TEST_ASSERT_EQUAL(0, file.close());
+}
+
+void test_errors()
+{
+    ROMFileSystem fs("rom", romfs_image);
+    struct stat st;
+
+    File file;
+    TEST_ASSERT_EQUAL(-ENOENT, file.open(&fs, "certs/missing.pem"));
+    TEST_ASSERT_EQUAL(-ENOENT, file.open(&fs, "cert"));
+    TEST_ASSERT_EQUAL(-EISDIR, file.open(&fs, "certs"));
+    TEST_ASSERT_EQUAL(-EROFS, file.open(&fs, "index.html", O_RDWR));
+    TEST_ASSERT_EQUAL(-EROFS, file.open(&fs, "new.txt", O_WRONLY | O_CREAT));
+
+    TEST_ASSERT_EQUAL(-EROFS, fs.remove("index.html"));
+    TEST_ASSERT_EQUAL(-EROFS, fs.rename("index.html", "main.html"));
+    TEST_ASSERT_EQUAL(-EROFS, fs.mkdir("new", 0777));
+
+    TEST_ASSERT_EQUAL(0, fs.stat("index.html", &st));
+    TEST_ASSERT_EQUAL(S_IFREG, st.st_mode & S_IFMT);
+    TEST_ASSERT_EQUAL(14, st.st_size);
+    TEST_ASSERT_EQUAL(0, fs.stat("certs/client", &st));
+    TEST_ASSERT_EQUAL(S_IFDIR, st.st_mode & S_IFMT);
+    TEST_ASSERT_EQUAL(-ENOENT, fs.stat("certs/clien", &st));
+}
+
+static void check_dir(FileSystem *fs, const char *path, const char *const *names, int count)
+{
+    Dir dir;
+    struct dirent ent;
+
+    TEST_ASSERT_EQUAL(0, dir.open(fs, path));
+    for (int i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL(1, dir.read(&ent));
+        const char *name = names[i];
+        size_t len = strlen(name);
+        if (name[len - 1] == '/') {
+            TEST_ASSERT_EQUAL(DT_DIR, ent.d_type);
+            len--;
+        } else {
+            TEST_ASSERT_EQUAL(DT_REG, ent.d_type);
+        }
+        TEST_ASSERT_EQUAL(len, strlen(ent.d_name));
+        TEST_ASSERT_EQUAL_MEMORY(name, ent.d_name, len);
+    }
+    TEST_ASSERT_EQUAL(0, dir.read(&ent));
+    TEST_ASSERT_EQUAL(0, dir.close());
+}
+
+void test_read_dir()
+{
+    ROMFileSystem fs("rom", romfs_image);
+
+    static const char *const root[] = {"certs.ver", "certs/", "index.html", "ui/"};
+    check_dir(&fs, "/", root, 4);
+    static const char *const certs[] = {"ca.pem", "client/"};
+    check_dir(&fs, "certs", certs, 2);
+    static const char *const client[] = {"cert.pem", "key.pem"};
+    check_dir(&fs, "certs/client/", client, 2);
+
+    Dir dir;
+    TEST_ASSERT_EQUAL(-ENOENT, dir.open(&fs, "fonts"));
+    TEST_ASSERT_EQUAL(-ENOTDIR, dir.open(&fs, "index.html"));
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Testing mount", test_mount),
+    Case("Testing read", test_read),
+    Case("Testing map", test_map),
+    Case("Testing read only errors", test_errors),
+    Case("Testing dir iteration", test_read_dir),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,189 @@
+/*
+* Copyright (c) 2020 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "CompressedStore.h"
+#include "TDBStore.h"
+#include "mbed_error.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <algorithm>
+
+using namespace mbed;
+using namespace utest::v1;
+
+static const int heap_alloc_threshold_size = 4096;
+static const size_t value_size = 2000;
+
+static const char *const json_key = "config";
+static const char *const random_key = "random";
+static const char *const small_key = "small";
+
+// A JSON like value, repetitive enough to compress well
+static void fill_json(uint8_t *buf, size_t size)
+{
+    static const char *const fields[] = {"\"name\": \"sensor\", ", "\"rate\": 100, ", "\"enabled\": true, "};
+    size_t pos = 0;
+    for (int i = 0; pos < size; i++) {
+        const char *field = fields[i % 3];
+        size_t len = std::min(strlen(field), size - pos);
+        memcpy(buf + pos, field, len);
+        pos += len;
+    }
+}
+
+static void fill_random(uint8_t *buf, size_t size)
+{
+    srand(1);
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = rand();
+    }
+}
+
+static void check_value(CompressedStore *store, const char *key, const uint8_t *expected, size_t size,
+                        uint8_t *get_buf)
+{
+    size_t actual_size;
+    KVStore::info_t info;
+
+    int result = store->get_info(key, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(size, info.size);
+
+    memset(get_buf, 0, size);
+    result = store->get(key, get_buf, size, &actual_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(size, actual_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, get_buf, size);
+
+    // Parts from an offset decompress from the start of the value
+    result = store->get(key, get_buf, 100, &actual_size, size - 50);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(50, actual_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected + size - 50, get_buf, 50);
+}
+
+static void compressedstore_test()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    HeapBlockDevice heap_bd(4096 * 4, 1, 1, 4096);
+    FlashSimBlockDevice flash_bd(&heap_bd);
+    TDBStore tdbs(&flash_bd);
+    CompressedStore store(&tdbs);
+    KVStore::info_t info;
+    int result;
+
+    uint8_t *set_buf = new uint8_t[value_size];
+    uint8_t *get_buf = new uint8_t[value_size];
+
+    result = store.init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = store.reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Compressible values take less of the underlying store
+    fill_json(set_buf, value_size);
+    result = store.set(json_key, set_buf, value_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs.get_info(json_key, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    printf("%u bytes stored in %u\n", (unsigned)value_size, (unsigned)info.size);
+    TEST_ASSERT(info.size < value_size / 3);
+    check_value(&store, json_key, set_buf, value_size, get_buf);
+
+    // Random values are stored raw
+    fill_random(set_buf, value_size);
+    result = store.set(random_key, set_buf, value_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs.get_info(random_key, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT(info.size <= value_size + 8);
+    check_value(&store, random_key, set_buf, value_size, get_buf);
+
+    result = store.set(small_key, "tiny", 4, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_value(&store, small_key, (const uint8_t *)"tiny", 4, get_buf);
+
+    // Incremental set compressed as the data comes
+    KVStore::set_handle_t handle;
+    fill_json(set_buf, value_size);
+    result = store.set_start(&handle, json_key, value_size, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    for (size_t offset = 0; offset < value_size; offset += 300) {
+        result = store.set_add_data(handle, set_buf + offset, std::min<size_t>(300, value_size - offset));
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+    result = store.set_finalize(handle);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_value(&store, json_key, set_buf, value_size, get_buf);
+
+    // Values survive a reboot
+    result = store.deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = store.init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    check_value(&store, json_key, set_buf, value_size, get_buf);
+
+    // Records not written by CompressedStore are rejected
+    result = tdbs.set("plain", "plain value", 11, 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = store.get("plain", get_buf, value_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_DATA_DETECTED, result);
+
+    result = store.remove(json_key);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = store.get(json_key, get_buf, value_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+    result = store.deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete[] set_buf;
+    delete[] get_buf;
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("CompressedStore: Set and get test", compressedstore_test, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
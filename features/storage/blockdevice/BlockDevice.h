@@ -21,6 +21,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -122,6 +123,72 @@ public:
         return 0;
     }
 
+    /** Start reading blocks from a block device
+     *
+     *  The callback is called once the read has finished, with 0 on success
+     *  or a negative error code on failure. It may be called from another
+     *  thread, or before this function returns. The buffer must stay valid
+     *  until the callback is called.
+     *
+     *  The default implementation calls read() and then the callback, so
+     *  block devices which can not overlap their I/O with the caller are
+     *  used through the same API.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param callback Function to call when the read has finished
+     *  @return         0 if the read was started, or a negative error code,
+     *                  in which case the callback is not called
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+    {
+        callback(read(buffer, addr, size));
+        return 0;
+    }
+
+    /** Start programming blocks to a block device
+     *
+     *  The callback is called once the program has finished, with 0 on
+     *  success or a negative error code on failure. It may be called from
+     *  another thread, or before this function returns. The buffer must
+     *  stay valid until the callback is called.
+     *
+     *  The default implementation calls program() and then the callback.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param callback Function to call when the program has finished
+     *  @return         0 if the program was started, or a negative error code,
+     *                  in which case the callback is not called
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+    {
+        callback(program(buffer, addr, size));
+        return 0;
+    }
+
+    /** Start erasing blocks on a block device
+     *
+     *  The callback is called once the erase has finished, with 0 on
+     *  success or a negative error code on failure. It may be called from
+     *  another thread, or before this function returns.
+     *
+     *  The default implementation calls erase() and then the callback.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param callback Function to call when the erase has finished
+     *  @return         0 if the erase was started, or a negative error code,
+     *                  in which case the callback is not called
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+    {
+        callback(erase(addr, size));
+        return 0;
+    }
+
     /** Mark blocks as no longer in use
      *
      *  This function provides a hint to the underlying block device that a region of blocks
@@ -27,11 +27,14 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return val / size * size;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
-    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0), _write_cache_addr(0), _write_cache_valid(false),
-      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t cache_entries, uint32_t cache_ways)
+    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0), _cache_entries(cache_entries),
+      _cache_ways(cache_ways), _cache_sets(0), _cache_tick(0), _cache(0), _write_cache(0), _read_buf(0),
+      _init_ref_count(0), _is_initialized(false)
 {
     MBED_ASSERT(_bd);
+    MBED_ASSERT(_cache_entries && _cache_ways && !(_cache_entries % _cache_ways));
+    _cache_sets = _cache_entries / _cache_ways;
 }
 
 BufferedBlockDevice::~BufferedBlockDevice()
@@ -56,8 +59,12 @@ int BufferedBlockDevice::init()
     _bd_program_size = _bd->get_program_size();
     _bd_size = _bd->size();
 
+    if (!_cache) {
+        _cache = new cache_entry_t[_cache_entries];
+    }
+
     if (!_write_cache) {
-        _write_cache = new uint8_t[_bd_program_size];
+        _write_cache = new uint8_t[_bd_program_size * _cache_entries];
     }
 
     if (!_read_buf) {
@@ -88,6 +95,8 @@ int BufferedBlockDevice::deinit()
         return BD_ERROR_OK;
     }
 
+    delete[] _cache;
+    _cache = 0;
     delete[] _write_cache;
     _write_cache = 0;
     delete[] _read_buf;
@@ -96,6 +105,94 @@ int BufferedBlockDevice::deinit()
     return _bd->deinit();
 }
 
+uint8_t *BufferedBlockDevice::cache_data(int index) const
+{
+    // Data is laid out way by way, so that the same way of consecutive sets,
+    // which holds consecutive program units, is contiguous in memory
+    uint32_t set = index / _cache_ways;
+    uint32_t way = index % _cache_ways;
+    return _write_cache + (way * _cache_sets + set) * _bd_program_size;
+}
+
+int BufferedBlockDevice::find_cache_entry(bd_addr_t addr) const
+{
+    uint32_t first = (addr / _bd_program_size) % _cache_sets * _cache_ways;
+    for (uint32_t i = first; i < first + _cache_ways; i++) {
+        if (_cache[i].valid && (_cache[i].addr == addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int BufferedBlockDevice::get_cache_entry(bd_addr_t addr, int &index)
+{
+    int i = find_cache_entry(addr);
+    if (i < 0) {
+        // Use a free way of the set if there is one, otherwise the least recently used
+        uint32_t first = (addr / _bd_program_size) % _cache_sets * _cache_ways;
+        i = first;
+        for (uint32_t j = first; j < first + _cache_ways; j++) {
+            if (!_cache[j].valid) {
+                i = j;
+                break;
+            }
+            if (_cache[j].last_use < _cache[i].last_use) {
+                i = j;
+            }
+        }
+
+        if (_cache[i].valid && _cache[i].dirty) {
+            int ret = write_back(i);
+            if (ret) {
+                return ret;
+            }
+        }
+
+        _cache[i].valid = false;
+        int ret = _bd->read(cache_data(i), addr, _bd_program_size);
+        if (ret) {
+            return ret;
+        }
+        _cache[i].addr = addr;
+        _cache[i].valid = true;
+        _cache[i].dirty = false;
+    }
+
+    _cache[i].last_use = ++_cache_tick;
+    index = i;
+    return 0;
+}
+
+int BufferedBlockDevice::write_back(int index)
+{
+    bd_addr_t addr = _cache[index].addr;
+    bd_size_t size = _bd_program_size;
+    uint8_t *data = cache_data(index);
+
+    // Extend the program over following dirty units that sit right after this one in memory
+    int last = index;
+    while (addr + size < _bd_size) {
+        int next = find_cache_entry(addr + size);
+        if ((next < 0) || !_cache[next].dirty || (cache_data(next) != data + size)) {
+            break;
+        }
+        _cache[last].dirty = false;
+        last = next;
+        size += _bd_program_size;
+    }
+    _cache[last].dirty = false;
+
+    int ret = _bd->program(data, addr, size);
+    if (ret) {
+        // Keep the data around so a later sync can retry
+        for (bd_addr_t a = addr; a < addr + size; a += _bd_program_size) {
+            _cache[find_cache_entry(a)].dirty = true;
+        }
+    }
+    return ret;
+}
+
 int BufferedBlockDevice::flush()
 {
     MBED_ASSERT(_write_cache);
@@ -103,20 +200,43 @@ int BufferedBlockDevice::flush()
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if (_write_cache_valid) {
-        int ret = _bd->program(_write_cache, _write_cache_addr, _bd_program_size);
+    // Write back in address order, so adjacent entries are programmed together
+    while (true) {
+        int lowest = -1;
+        for (uint32_t i = 0; i < _cache_entries; i++) {
+            if (_cache[i].valid && _cache[i].dirty &&
+                    ((lowest < 0) || (_cache[i].addr < _cache[lowest].addr))) {
+                lowest = i;
+            }
+        }
+        if (lowest < 0) {
+            break;
+        }
+
+        int ret = write_back(lowest);
         if (ret) {
             return ret;
         }
-        invalidate_write_cache();
     }
     return 0;
 }
 
 void BufferedBlockDevice::invalidate_write_cache()
 {
-    _write_cache_addr = _bd_size;
-    _write_cache_valid = false;
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        _cache[i].valid = false;
+        _cache[i].dirty = false;
+    }
+}
+
+void BufferedBlockDevice::invalidate_write_cache(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        if (_cache[i].valid && (_cache[i].addr + _bd_program_size > addr) && (_cache[i].addr < addr + size)) {
+            _cache[i].valid = false;
+            _cache[i].dirty = false;
+        }
+    }
 }
 
 int BufferedBlockDevice::sync()
@@ -146,26 +266,39 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
     }
 
     // Common case - no need to involve write cache or read buffer
-    if (_bd->is_valid_read(addr, size) &&
-            ((addr + size <= _write_cache_addr) || (addr > _write_cache_addr + _bd_program_size))) {
-        return _bd->read(b, addr, size);
+    if (_bd->is_valid_read(addr, size)) {
+        bool cached = false;
+        for (uint32_t i = 0; i < _cache_entries; i++) {
+            if (_cache[i].valid && (_cache[i].addr + _bd_program_size > addr) && (_cache[i].addr < addr + size)) {
+                cached = true;
+                break;
+            }
+        }
+        if (!cached) {
+            return _bd->read(b, addr, size);
+        }
     }
 
     uint8_t *buf = static_cast<uint8_t *>(b);
 
-    // Read logic: Split read to chunks, according to whether we cross the write cache
+    // Read logic: Split read to chunks, according to whether we cross cached program units
     while (size) {
-        bd_size_t chunk;
+        bd_size_t chunk = size;
         bool read_from_bd = true;
-        if (_write_cache_valid && addr < _write_cache_addr) {
-            chunk = std::min(size, _write_cache_addr - addr);
-        } else if (_write_cache_valid && (addr >= _write_cache_addr) && (addr < _write_cache_addr + _bd_program_size)) {
+        bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
+        int index = find_cache_entry(aligned_addr);
+        if (index >= 0) {
             // One case we need to take our data from cache
-            chunk = std::min(size, _bd_program_size - addr % _bd_program_size);
-            memcpy(buf, _write_cache + addr % _bd_program_size, chunk);
+            chunk = std::min(size, _bd_program_size - (addr - aligned_addr));
+            memcpy(buf, cache_data(index) + (addr - aligned_addr), chunk);
             read_from_bd = false;
         } else {
-            chunk = size;
+            // Read from the BD up to the next cached unit
+            for (uint32_t i = 0; i < _cache_entries; i++) {
+                if (_cache[i].valid && (_cache[i].addr > addr)) {
+                    chunk = std::min(chunk, _cache[i].addr - addr);
+                }
+            }
         }
 
         // Now, in case we read from the BD, make sure we are aligned with its read size.
@@ -204,61 +337,51 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     int ret;
 
-    bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
-
     const uint8_t *buf = static_cast <const uint8_t *>(b);
 
-    // Need to flush if moved to another program unit
-    if (aligned_addr != _write_cache_addr) {
-        ret = flush();
-        if (ret) {
-            return ret;
-        }
-    }
-
-    // Write logic: Keep data in cache as long as we don't reach the end of the program unit.
-    // Otherwise, program to the underlying BD.
+    // Write logic: Program whole units straight to the underlying BD, and keep partial
+    // units in cache until they are evicted or synced.
     while (size) {
-        _write_cache_addr = align_down(addr, _bd_program_size);
-        bd_addr_t offs_in_buf = addr - _write_cache_addr;
+        bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
+        bd_addr_t offs_in_buf = addr - aligned_addr;
         bd_size_t chunk;
-        if (offs_in_buf) {
-            chunk = std::min(_bd_program_size - offs_in_buf, size);
-        } else if (size >= _bd_program_size) {
+        if (!offs_in_buf && (size >= _bd_program_size)) {
             chunk = align_down(size, _bd_program_size);
-        } else {
-            chunk = size;
-        }
-
-        const uint8_t *prog_buf;
-        if (chunk < _bd_program_size) {
-            // If cache not valid, and program doesn't cover an entire unit, it means we need to
-            // read it from the underlying BD
-            if (!_write_cache_valid) {
-                ret = _bd->read(_write_cache, _write_cache_addr, _bd_program_size);
-                if (ret) {
-                    return ret;
-                }
-            }
-            memcpy(_write_cache + offs_in_buf, buf, chunk);
-            prog_buf = _write_cache;
-        } else {
-            prog_buf = buf;
-        }
-
-        // Only program if we reached the end of a program unit
-        if (!((offs_in_buf + chunk) % _bd_program_size)) {
-            ret = _bd->program(prog_buf, _write_cache_addr, std::max(chunk, _bd_program_size));
+            // Cached copies of these units are now stale
+            invalidate_write_cache(addr, chunk);
+            ret = _bd->program(buf, addr, chunk);
             if (ret) {
                 return ret;
             }
-            invalidate_write_cache();
             ret = _bd->sync();
             if (ret) {
                 return ret;
             }
         } else {
-            _write_cache_valid = true;
+            chunk = std::min(_bd_program_size - offs_in_buf, size);
+
+            // If the unit is not cached, and program doesn't cover an entire unit, it means
+            // we need to read it from the underlying BD
+            int index;
+            ret = get_cache_entry(aligned_addr, index);
+            if (ret) {
+                return ret;
+            }
+            memcpy(cache_data(index) + offs_in_buf, buf, chunk);
+            _cache[index].dirty = true;
+
+            // With a single entry, program as soon as we reach the end of the program unit
+            if ((_cache_entries == 1) && (offs_in_buf + chunk == _bd_program_size)) {
+                ret = write_back(index);
+                if (ret) {
+                    return ret;
+                }
+                _cache[index].valid = false;
+                ret = _bd->sync();
+                if (ret) {
+                    return ret;
+                }
+            }
         }
 
         buf += chunk;
@@ -279,9 +402,7 @@ int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_write_cache(addr, size);
     return _bd->erase(addr, size);
 }
 
@@ -295,9 +416,7 @@ int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_write_cache(addr, size);
     return _bd->trim(addr, size);
 }
 
@@ -32,14 +32,27 @@ namespace mbed {
 
 /** Block device for allowing minimal read and program sizes (of 1) for the underlying BD,
  *  using a buffer on the heap.
+ *
+ *  Partial program units are held in a write-back cache of one or more
+ *  program-sized entries. The cache is set-associative: a program unit can
+ *  only live in the ways of the set its address maps to, and the least
+ *  recently used way of that set is evicted when a new unit is needed.
+ *  Dirty entries are written back on eviction and on sync(), lowest address
+ *  first, with adjacent entries combined into a single program call.
  */
 class BufferedBlockDevice : public BlockDevice {
 public:
     /** Lifetime of a memory-buffered block device wrapping an underlying block device
      *
-     *  @param bd        Block device to back the BufferedBlockDevice
+     *  @param bd            Block device to back the BufferedBlockDevice
+     *  @param cache_entries Number of program units held in the write cache
+     *  @param cache_ways    Number of entries per cache set, must divide cache_entries
+     *
+     *  @note With a single entry, a program unit is written to the underlying
+     *        block device as soon as it has been programmed up to its end.
+     *        With more entries, it stays in the cache until evicted or synced.
      */
-    BufferedBlockDevice(BlockDevice *bd);
+    BufferedBlockDevice(BlockDevice *bd, uint32_t cache_entries = 1, uint32_t cache_ways = 1);
 
     /** Lifetime of the memory-buffered block device
      */
@@ -164,8 +177,17 @@ protected:
     bd_size_t _bd_program_size;
     bd_size_t _bd_read_size;
     bd_size_t _bd_size;
-    bd_size_t _write_cache_addr;
-    bool _write_cache_valid;
+    uint32_t _cache_entries;
+    uint32_t _cache_ways;
+    uint32_t _cache_sets;
+    uint32_t _cache_tick;
+    struct cache_entry_t {
+        bd_addr_t addr;
+        uint32_t last_use;
+        bool valid;
+        bool dirty;
+    };
+    cache_entry_t *_cache;
     uint8_t *_write_cache;
     uint8_t *_read_buf;
     uint32_t _init_ref_count;
@@ -183,6 +205,42 @@ protected:
      *  @return         none
      */
     void invalidate_write_cache();
+
+    /** Drop cache entries overlapping a range, without writing them back
+     *
+     *  @param addr     Start of the range
+     *  @param size     Size of the range in bytes
+     */
+    void invalidate_write_cache(bd_addr_t addr, bd_size_t size);
+
+    /** Find the cache entry holding a program unit
+     *
+     *  @param addr     Program unit aligned address
+     *  @return         Cache entry index, or -1 if the unit is not cached
+     */
+    int find_cache_entry(bd_addr_t addr) const;
+
+    /** Get a cache entry for a program unit, evicting and filling it as needed
+     *
+     *  @param addr     Program unit aligned address
+     *  @param index    Set to the cache entry index on success
+     *  @return         0 on success or a negative error code on failure
+     */
+    int get_cache_entry(bd_addr_t addr, int &index);
+
+    /** Write back a run of adjacent dirty entries, starting at a given one
+     *
+     *  @param index    Cache entry index of the first entry of the run
+     *  @return         0 on success or a negative error code on failure
+     */
+    int write_back(int index);
+
+    /** Data buffer of a cache entry
+     *
+     *  @param index    Cache entry index
+     *  @return         Pointer to the entry's program unit data
+     */
+    uint8_t *cache_data(int index) const;
 #endif //#if !(DOXYGEN_ONLY)
 };
 } // namespace mbed
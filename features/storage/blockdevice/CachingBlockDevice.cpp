@@ -0,0 +1,346 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CachingBlockDevice.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include <algorithm>
+#include <string.h>
+
+namespace mbed {
+
+CachingBlockDevice::CachingBlockDevice(BlockDevice *bd, bd_size_t page_size, uint32_t page_count,
+                                       BlockDevice *cache_bd)
+    : _bd(bd), _cache_bd(cache_bd), _page_size(page_size), _page_count(page_count), _bd_size(0),
+      _pages(0), _cache(0), _tick(0), _hit_count(0), _miss_count(0), _init_ref_count(0), _is_initialized(false)
+{
+    MBED_ASSERT(_bd);
+    MBED_ASSERT(_page_size && _page_count);
+}
+
+CachingBlockDevice::~CachingBlockDevice()
+{
+    deinit();
+}
+
+int CachingBlockDevice::init()
+{
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (!err && _cache_bd) {
+        err = _cache_bd->init();
+        if (err) {
+            _bd->deinit();
+        }
+    }
+    if (err) {
+        core_util_atomic_decr_u32(&_init_ref_count, 1);
+        return err;
+    }
+
+    // Pages are always filled with whole read units
+    _page_size = (_page_size + _bd->get_read_size() - 1) / _bd->get_read_size() * _bd->get_read_size();
+    _bd_size = _bd->size();
+
+    if (_cache_bd) {
+        MBED_ASSERT(_cache_bd->size() >= _page_size * _page_count);
+        MBED_ASSERT(!(_page_size % _cache_bd->get_erase_size()));
+    }
+
+    if (!_pages) {
+        _pages = new page_t[_page_count];
+    }
+
+    if (!_cache) {
+        _cache = new uint8_t[_cache_bd ? _page_size : _page_size * _page_count];
+    }
+
+    invalidate();
+
+    _is_initialized = true;
+    return BD_ERROR_OK;
+}
+
+int CachingBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    delete[] _pages;
+    _pages = 0;
+    delete[] _cache;
+    _cache = 0;
+    _is_initialized = false;
+
+    if (_cache_bd) {
+        _cache_bd->deinit();
+    }
+    return _bd->deinit();
+}
+
+int CachingBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->sync();
+}
+
+void CachingBlockDevice::invalidate()
+{
+    if (!_pages) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < _page_count; i++) {
+        _pages[i].valid = false;
+    }
+}
+
+void CachingBlockDevice::invalidate(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _page_count; i++) {
+        if (_pages[i].valid && (_pages[i].addr + _page_size > addr) && (_pages[i].addr < addr + size)) {
+            _pages[i].valid = false;
+        }
+    }
+}
+
+int CachingBlockDevice::read_page(uint8_t *buffer, bd_addr_t addr, bd_size_t offset, bd_size_t size)
+{
+    int ret;
+    uint32_t i;
+    for (i = 0; i < _page_count; i++) {
+        if (_pages[i].valid && (_pages[i].addr == addr)) {
+            break;
+        }
+    }
+
+    if (i < _page_count) {
+        _hit_count++;
+        _pages[i].last_use = ++_tick;
+
+        if (!_cache_bd) {
+            memcpy(buffer, _cache + i * _page_size + offset, size);
+            return 0;
+        }
+
+        if (_cache_bd->is_valid_read(i * _page_size + offset, size)) {
+            return _cache_bd->read(buffer, i * _page_size + offset, size);
+        }
+
+        ret = _cache_bd->read(_cache, i * _page_size, _page_size);
+        if (!ret) {
+            memcpy(buffer, _cache + offset, size);
+        }
+        return ret;
+    }
+
+    _miss_count++;
+
+    // Replace a free page if there is one, otherwise the least recently read
+    uint32_t victim = 0;
+    for (i = 0; i < _page_count; i++) {
+        if (!_pages[i].valid) {
+            victim = i;
+            break;
+        }
+        if (_pages[i].last_use < _pages[victim].last_use) {
+            victim = i;
+        }
+    }
+
+    _pages[victim].valid = false;
+    bd_size_t fill = std::min(_page_size, _bd_size - addr);
+
+    if (!_cache_bd) {
+        uint8_t *page = _cache + victim * _page_size;
+        ret = _bd->read(page, addr, fill);
+        if (ret) {
+            return ret;
+        }
+        memcpy(buffer, page + offset, size);
+    } else {
+        // Read straight into the caller's buffer if it holds the whole page
+        uint8_t *page = (size == _page_size) ? buffer : _cache;
+        ret = _bd->read(page, addr, fill);
+        if (ret) {
+            return ret;
+        }
+        if (page != buffer) {
+            memcpy(buffer, page + offset, size);
+        }
+
+        // Failing to fill the cache does not fail the read, the page just stays uncached
+        if (_cache_bd->erase(victim * _page_size, _page_size) ||
+                _cache_bd->program(page, victim * _page_size, _page_size)) {
+            return 0;
+        }
+    }
+
+    _pages[victim].addr = addr;
+    _pages[victim].valid = true;
+    _pages[victim].last_use = ++_tick;
+    return 0;
+}
+
+int CachingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    // Reads bigger than the whole cache would only flush it out
+    if (size >= _page_size * _page_count) {
+        return _bd->read(b, addr, size);
+    }
+
+    uint8_t *buf = static_cast<uint8_t *>(b);
+
+    while (size) {
+        bd_addr_t page_addr = addr / _page_size * _page_size;
+        bd_size_t offset = addr - page_addr;
+        bd_size_t chunk = std::min(size, _page_size - offset);
+
+        int ret = read_page(buf, page_addr, offset, chunk);
+        if (ret) {
+            return ret;
+        }
+
+        buf += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return 0;
+}
+
+int CachingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    invalidate(addr, size);
+    return _bd->program(b, addr, size);
+}
+
+int CachingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    invalidate(addr, size);
+    return _bd->erase(addr, size);
+}
+
+int CachingBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    invalidate(addr, size);
+    return _bd->trim(addr, size);
+}
+
+bd_size_t CachingBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t CachingBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t CachingBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t CachingBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int CachingBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t CachingBlockDevice::size() const
+{
+    if (!_is_initialized) {
+        return 0;
+    }
+
+    return _bd_size;
+}
+
+void CachingBlockDevice::reset_counters()
+{
+    _hit_count = 0;
+    _miss_count = 0;
+}
+
+uint32_t CachingBlockDevice::get_hit_count() const
+{
+    return _hit_count;
+}
+
+uint32_t CachingBlockDevice::get_miss_count() const
+{
+    return _miss_count;
+}
+
+const char *CachingBlockDevice::get_type() const
+{
+    return _bd->get_type();
+}
+
+} // namespace mbed
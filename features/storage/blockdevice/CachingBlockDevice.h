@@ -0,0 +1,239 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_CACHING_BLOCK_DEVICE_H
+#define MBED_CACHING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+namespace mbed {
+
+/** Block device for caching reads of another block device
+ *
+ *  Data read from the underlying block device is kept in a number of pages,
+ *  either on the heap or in a second, faster block device. On a miss, the
+ *  least recently read page is replaced. Programs, erases and trims go straight to the
+ *  underlying block device and drop any page they overlap, so the cache never
+ *  holds data that has not been written.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "CachingBlockDevice.h"
+ *
+ *  SPIFBlockDevice spif;
+ *
+ *  // Keep eight 256 byte pages of flash in RAM
+ *  CachingBlockDevice cached(&spif, 256, 8);
+ *  @endcode
+ */
+class CachingBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of a caching block device
+     *
+     *  @param bd         Block device to back the CachingBlockDevice
+     *  @param page_size  Size of a cache page in bytes, rounded up to a multiple
+     *                    of the underlying read size
+     *  @param page_count Number of pages to cache
+     *  @param cache_bd   Optional block device to hold the pages, rather than the heap.
+     *                    It must be at least page_size * page_count bytes, and
+     *                    page_size must be a multiple of its erase size. A single
+     *                    page is still allocated on the heap to move data around
+     */
+    CachingBlockDevice(BlockDevice *bd, bd_size_t page_size, uint32_t page_count, BlockDevice *cache_bd = NULL);
+
+    /** Lifetime of the caching block device
+     */
+    virtual ~CachingBlockDevice();
+
+    /** Initialize the caching block device and its underlying block devices
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize the caching block device and its underlying block devices
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from the caching block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to the caching block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on the caching block device
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Mark blocks as no longer in use
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     *  @note Must be a multiple of the read size
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Drop all cached pages
+     */
+    void invalidate();
+
+    /** Reset the hit and miss counts to zero
+     */
+    void reset_counters();
+
+    /** Get number of page reads served from the cache
+     *
+     *  @return The number of cache hits
+     */
+    uint32_t get_hit_count() const;
+
+    /** Get number of page reads that had to go to the underlying block device
+     *
+     *  @return The number of cache misses
+     */
+    uint32_t get_miss_count() const;
+
+    /** Get the underlying BlockDevice class type
+     *
+     *  @return         A string representing the underlying BlockDevice class type
+     */
+    virtual const char *get_type() const;
+
+protected:
+    struct page_t {
+        bd_addr_t addr;
+        uint32_t last_use;
+        bool valid;
+    };
+
+    BlockDevice *_bd;
+    BlockDevice *_cache_bd;
+    bd_size_t _page_size;
+    uint32_t _page_count;
+    bd_size_t _bd_size;
+    page_t *_pages;
+    uint8_t *_cache;
+    uint32_t _tick;
+    uint32_t _hit_count;
+    uint32_t _miss_count;
+    uint32_t _init_ref_count;
+    bool _is_initialized;
+
+#if !(DOXYGEN_ONLY)
+    /** Drop cached pages overlapping a range
+     *
+     *  @param addr     Start of the range
+     *  @param size     Size of the range in bytes
+     */
+    void invalidate(bd_addr_t addr, bd_size_t size);
+
+    /** Copy part of a page out of the cache, loading it first on a miss
+     *
+     *  @param buffer   Buffer to copy into
+     *  @param addr     Page aligned address
+     *  @param offset   Offset of the data in the page
+     *  @param size     Size to copy in bytes
+     *  @return         0 on success or a negative error code on failure
+     */
+    int read_page(uint8_t *buffer, bd_addr_t addr, bd_size_t offset, bd_size_t size);
+#endif //#if !(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::CachingBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
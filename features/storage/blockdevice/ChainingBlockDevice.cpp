@@ -247,6 +247,82 @@ int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return 0;
 }
 
+BlockDevice *ChainingBlockDevice::find_single_bd(bd_addr_t &addr, bd_size_t size) const
+{
+    for (size_t i = 0; i < _bd_count; i++) {
+        bd_size_t bdsize = _bds[i]->size();
+
+        if (addr < bdsize) {
+            // Only return the block device if it holds the whole range
+            return (addr + size <= bdsize) ? _bds[i] : NULL;
+        }
+
+        addr -= bdsize;
+    }
+
+    return NULL;
+}
+
+int ChainingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    bd_addr_t bd_addr = addr;
+    BlockDevice *bd = find_single_bd(bd_addr, size);
+    if (!bd) {
+        // Spans several block devices, read them one after the other
+        return BlockDevice::read_async(b, addr, size, callback);
+    }
+
+    return bd->read_async(b, bd_addr, size, callback);
+}
+
+int ChainingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    bd_addr_t bd_addr = addr;
+    BlockDevice *bd = find_single_bd(bd_addr, size);
+    if (!bd) {
+        // Spans several block devices, program them one after the other
+        return BlockDevice::program_async(b, addr, size, callback);
+    }
+
+    return bd->program_async(b, bd_addr, size, callback);
+}
+
+int ChainingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    bd_addr_t bd_addr = addr;
+    BlockDevice *bd = find_single_bd(bd_addr, size);
+    if (!bd) {
+        // Spans several block devices, erase them one after the other
+        return BlockDevice::erase_async(addr, size, callback);
+    }
+
+    return bd->erase_async(bd_addr, size, callback);
+}
+
 bd_size_t ChainingBlockDevice::get_read_size() const
 {
     return _read_size;
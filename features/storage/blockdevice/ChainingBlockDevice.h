@@ -127,6 +127,38 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Start reading blocks from a block device
+     *
+     *  Only operations which fall within one of the chained block devices
+     *  are forwarded to it, others complete before returning
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function to call with the result when the read has finished
+     *  @return         0 if the read was started, or a negative error code
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start programming blocks to a block device
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function to call with the result when the program has finished
+     *  @return         0 if the program was started, or a negative error code
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start erasing blocks on a block device
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function to call with the result when the erase has finished
+     *  @return         0 if the erase was started, or a negative error code
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -179,6 +211,8 @@ public:
     virtual const char *get_type() const;
 
 protected:
+    BlockDevice *find_single_bd(bd_addr_t &addr, bd_size_t size) const;
+
     BlockDevice **_bds;
     size_t _bd_count;
     bd_size_t _read_size;
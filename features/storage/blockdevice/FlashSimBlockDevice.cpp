@@ -31,9 +31,39 @@ static inline uint32_t align_up(bd_size_t val, bd_size_t size)
     return (((val - 1) / size) + 1) * size;
 }
 
+const FlashSimBlockDevice::cost_model_t FlashSimBlockDevice::W25Q128JV_COSTS = {
+    800,        // read_op_ns: command and address
+    200,        // read_byte_ns
+    200,        // program_byte_ns
+    256,        // program_unit_size: page
+    400000,     // program_unit_ns: tPP
+    4096,       // erase_unit_size: sector
+    45000000,   // erase_unit_ns: tSE
+};
+
+const FlashSimBlockDevice::cost_model_t FlashSimBlockDevice::NRF52840_COSTS = {
+    0,          // read_op_ns: memory mapped
+    16,         // read_byte_ns
+    0,          // program_byte_ns
+    4,          // program_unit_size: word
+    41000,      // program_unit_ns: tWRITE
+    4096,       // erase_unit_size: page
+    85000000,   // erase_unit_ns: tERASEPAGE
+};
+
+// Number of units of the given size that the range touches
+static inline uint64_t units_touched(bd_addr_t addr, bd_size_t size, bd_size_t unit)
+{
+    if (!size || !unit) {
+        return 0;
+    }
+    return (addr + size - 1) / unit - addr / unit + 1;
+}
+
 FlashSimBlockDevice::FlashSimBlockDevice(BlockDevice *bd, uint8_t erase_value) :
     _erase_value(erase_value), _blank_buf_size(0),
-    _blank_buf(0), _bd(bd), _init_ref_count(0), _is_initialized(false)
+    _blank_buf(0), _bd(bd), _init_ref_count(0), _is_initialized(false),
+    _cost_model(0), _elapsed_ns(0), _erase_counts(0), _wear_unit_size(0), _wear_unit_count(0)
 {
     MBED_ASSERT(bd);
 }
@@ -42,6 +72,7 @@ FlashSimBlockDevice::~FlashSimBlockDevice()
 {
     deinit();
     delete[] _blank_buf;
+    delete[] _erase_counts;
 }
 
 int FlashSimBlockDevice::init()
@@ -149,7 +180,11 @@ int FlashSimBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    return _bd->read(b, addr, size);
+    int ret = _bd->read(b, addr, size);
+    if (!ret && _cost_model) {
+        _elapsed_ns += _cost_model->read_op_ns + (uint64_t)_cost_model->read_byte_ns * size;
+    }
+    return ret;
 }
 
 int FlashSimBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
@@ -184,7 +219,12 @@ int FlashSimBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
         curr_size -= read_size;
     }
 
-    return _bd->program(b, addr, size);
+    int ret = _bd->program(b, addr, size);
+    if (!ret && _cost_model) {
+        _elapsed_ns += (uint64_t)_cost_model->program_byte_ns * size +
+                       _cost_model->program_unit_ns * units_touched(addr, size, _cost_model->program_unit_size);
+    }
+    return ret;
 }
 
 int FlashSimBlockDevice::erase(bd_addr_t addr, bd_size_t size)
@@ -212,6 +252,16 @@ int FlashSimBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         curr_size -= prog_size;
     }
 
+    if (_cost_model) {
+        _elapsed_ns += _cost_model->erase_unit_ns * units_touched(addr, size, _cost_model->erase_unit_size);
+    }
+
+    if (_erase_counts) {
+        for (bd_size_t unit = addr / _wear_unit_size; unit < (addr + size) / _wear_unit_size; unit++) {
+            _erase_counts[unit]++;
+        }
+    }
+
     return BD_ERROR_OK;
 }
 
@@ -229,5 +279,68 @@ const char *FlashSimBlockDevice::get_type() const
     return NULL;
 }
 
+void FlashSimBlockDevice::set_cost_model(const cost_model_t *model)
+{
+    _cost_model = model;
+}
+
+uint64_t FlashSimBlockDevice::get_elapsed_ns() const
+{
+    return _elapsed_ns;
+}
+
+int FlashSimBlockDevice::enable_wear_tracking()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (_erase_counts) {
+        return BD_ERROR_OK;
+    }
+
+    // Count per smallest erase unit, so non-uniform erase sizes still map onto fixed slots
+    _wear_unit_size = _bd->get_erase_size();
+    _wear_unit_count = _bd->size() / _wear_unit_size;
+    _erase_counts = new uint32_t[_wear_unit_count];
+    memset(_erase_counts, 0, _wear_unit_count * sizeof(uint32_t));
+    return BD_ERROR_OK;
+}
+
+uint32_t FlashSimBlockDevice::get_erase_count(bd_addr_t addr) const
+{
+    if (!_erase_counts || addr / _wear_unit_size >= _wear_unit_count) {
+        return 0;
+    }
+
+    return _erase_counts[addr / _wear_unit_size];
+}
+
+uint32_t FlashSimBlockDevice::get_max_erase_count() const
+{
+    uint32_t max = 0;
+    for (bd_size_t i = 0; _erase_counts && i < _wear_unit_count; i++) {
+        max = std::max(max, _erase_counts[i]);
+    }
+    return max;
+}
+
+uint64_t FlashSimBlockDevice::get_total_erase_count() const
+{
+    uint64_t total = 0;
+    for (bd_size_t i = 0; _erase_counts && i < _wear_unit_count; i++) {
+        total += _erase_counts[i];
+    }
+    return total;
+}
+
+void FlashSimBlockDevice::reset_stats()
+{
+    _elapsed_ns = 0;
+    if (_erase_counts) {
+        memset(_erase_counts, 0, _wear_unit_count * sizeof(uint32_t));
+    }
+}
+
 } // namespace mbed
 
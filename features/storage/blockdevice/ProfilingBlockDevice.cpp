@@ -15,16 +15,53 @@
  */
 
 #include "ProfilingBlockDevice.h"
+#include "hal/us_ticker_api.h"
 #include "stddef.h"
+#include <string.h>
 
 namespace mbed {
 
+static uint64_t now_us()
+{
+#if DEVICE_USTICKER
+    return ticker_read_us(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+// 0 for 0, otherwise one more than the index of the highest set bit
+static int log2_bucket(uint64_t val)
+{
+    int bucket = 0;
+    while (val && bucket < ProfilingBlockDevice::HISTOGRAM_BUCKETS - 1) {
+        val >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
 ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
     : _bd(bd)
-    , _read_count(0)
-    , _program_count(0)
-    , _erase_count(0)
 {
+    reset();
+}
+
+void ProfilingBlockDevice::record(op_stats_t &stats, bd_size_t size, uint64_t start)
+{
+    uint64_t elapsed = now_us() - start;
+    uint32_t us = elapsed > UINT32_MAX ? UINT32_MAX : elapsed;
+
+    if (!stats.calls || us < stats.min_us) {
+        stats.min_us = us;
+    }
+    if (us > stats.max_us) {
+        stats.max_us = us;
+    }
+    stats.calls++;
+    stats.total_us += us;
+    stats.duration_histogram[log2_bucket(us)]++;
+    stats.size_histogram[log2_bucket(size)]++;
 }
 
 int ProfilingBlockDevice::init()
@@ -44,27 +81,33 @@ int ProfilingBlockDevice::sync()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint64_t start = now_us();
     int err = _bd->read(b, addr, size);
     if (!err) {
         _read_count += size;
+        record(_read_stats, size, start);
     }
     return err;
 }
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint64_t start = now_us();
     int err = _bd->program(b, addr, size);
     if (!err) {
         _program_count += size;
+        record(_program_stats, size, start);
     }
     return err;
 }
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    uint64_t start = now_us();
     int err = _bd->erase(addr, size);
     if (!err) {
         _erase_count += size;
+        record(_erase_stats, size, start);
     }
     return err;
 }
@@ -104,6 +147,9 @@ void ProfilingBlockDevice::reset()
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(&_read_stats, 0, sizeof(_read_stats));
+    memset(&_program_stats, 0, sizeof(_program_stats));
+    memset(&_erase_stats, 0, sizeof(_erase_stats));
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -121,6 +167,21 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
     return _erase_count;
 }
 
+const ProfilingBlockDevice::op_stats_t &ProfilingBlockDevice::get_read_stats() const
+{
+    return _read_stats;
+}
+
+const ProfilingBlockDevice::op_stats_t &ProfilingBlockDevice::get_program_stats() const
+{
+    return _program_stats;
+}
+
+const ProfilingBlockDevice::op_stats_t &ProfilingBlockDevice::get_erase_stats() const
+{
+    return _erase_stats;
+}
+
 const char *ProfilingBlockDevice::get_type() const
 {
     if (_bd != NULL) {
@@ -32,9 +32,32 @@ namespace mbed {
 
 
 /** Block device for measuring storage operations of another block device
+ *
+ *  Besides byte counts, calls are timed with the microsecond ticker, when the
+ *  target has one, and collected per operation type.
  */
 class ProfilingBlockDevice : public BlockDevice {
 public:
+    /** Number of buckets in the duration and size histograms
+     */
+    static const int HISTOGRAM_BUCKETS = 24;
+
+    /** Statistics of one type of operation
+     *
+     *  Histogram bucket 0 counts zero values, and bucket n counts values in
+     *  [2^(n-1), 2^n). The last bucket also holds anything larger.
+     *  The average duration is total_us / calls, and the throughput is
+     *  the matching byte count divided by total_us.
+     */
+    struct op_stats_t {
+        uint32_t calls;
+        uint32_t min_us;
+        uint32_t max_us;
+        uint64_t total_us;
+        uint32_t duration_histogram[HISTOGRAM_BUCKETS];
+        uint32_t size_histogram[HISTOGRAM_BUCKETS];
+    };
+
     /** Lifetime of the memory block device
      *
      *  @param bd       Block device to back the ProfilingBlockDevice
@@ -163,6 +186,24 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get statistics of the reads from the block device
+     *
+     *  @return Durations and sizes of successful reads
+     */
+    const op_stats_t &get_read_stats() const;
+
+    /** Get statistics of the programs to the block device
+     *
+     *  @return Durations and sizes of successful programs
+     */
+    const op_stats_t &get_program_stats() const;
+
+    /** Get statistics of the erases of the block device
+     *
+     *  @return Durations and sizes of successful erases
+     */
+    const op_stats_t &get_erase_stats() const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -174,6 +215,11 @@ private:
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    op_stats_t _read_stats;
+    op_stats_t _program_stats;
+    op_stats_t _erase_stats;
+
+    void record(op_stats_t &stats, bd_size_t size, uint64_t start);
 };
 
 } // namespace mbed
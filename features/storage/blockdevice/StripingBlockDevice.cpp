@@ -0,0 +1,450 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StripingBlockDevice.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+
+namespace mbed {
+
+StripingBlockDevice::StripingBlockDevice(BlockDevice **bds, size_t bd_count, bd_size_t stripe_size)
+    : _bds(bds), _bd_count(bd_count), _stripe_size(stripe_size)
+    , _read_size(0), _program_size(0), _erase_size(0), _erase_value(-1), _size(0)
+    , _members(NULL), _init_ref_count(0), _is_initialized(false)
+    , _async_op(ASYNC_READ), _async_buffer(NULL), _async_addr(0), _async_end(0), _async_pending(0)
+{
+    MBED_ASSERT(_bds && _bd_count);
+}
+
+StripingBlockDevice::~StripingBlockDevice()
+{
+    deinit();
+    delete[] _members;
+}
+
+int StripingBlockDevice::init()
+{
+    int err;
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    bd_size_t bd_size = 0;
+    for (size_t i = 0; i < _bd_count; i++) {
+        err = _bds[i]->init();
+        if (err) {
+            while (i--) {
+                _bds[i]->deinit();
+            }
+            _init_ref_count = 0;
+            return err;
+        }
+
+        // Every stripe must be usable the same way on every device
+        if (i == 0) {
+            _read_size = _bds[i]->get_read_size();
+            _program_size = _bds[i]->get_program_size();
+            _erase_size = _bds[i]->get_erase_size();
+            _erase_value = _bds[i]->get_erase_value();
+            bd_size = _bds[i]->size();
+        } else {
+            MBED_ASSERT(_bds[i]->get_read_size() == _read_size);
+            MBED_ASSERT(_bds[i]->get_program_size() == _program_size);
+            MBED_ASSERT(_bds[i]->get_erase_size() == _erase_size);
+            if (_bds[i]->get_erase_value() != _erase_value) {
+                _erase_value = -1;
+            }
+            if (_bds[i]->size() < bd_size) {
+                bd_size = _bds[i]->size();
+            }
+        }
+    }
+
+    if (!_stripe_size) {
+        _stripe_size = _erase_size;
+    }
+    _stripe_size = (_stripe_size + _erase_size - 1) / _erase_size * _erase_size;
+    _size = bd_size / _stripe_size * _stripe_size * _bd_count;
+
+    if (!_members) {
+        _members = new member_t[_bd_count];
+    }
+
+    _is_initialized = true;
+    return BD_ERROR_OK;
+}
+
+int StripingBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    _is_initialized = false;
+
+    int err = BD_ERROR_OK;
+    for (size_t i = 0; i < _bd_count; i++) {
+        int bd_err = _bds[i]->deinit();
+        if (bd_err && !err) {
+            err = bd_err;
+        }
+    }
+
+    return err;
+}
+
+int StripingBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    for (size_t i = 0; i < _bd_count; i++) {
+        int err = _bds[i]->sync();
+        if (err) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+size_t StripingBlockDevice::find_bd(bd_addr_t addr, bd_addr_t &bd_addr, bd_size_t &size) const
+{
+    bd_addr_t stripe = addr / _stripe_size;
+    bd_size_t offset = addr % _stripe_size;
+
+    bd_addr = (stripe / _bd_count) * _stripe_size + offset;
+    size = _stripe_size - offset;
+    return stripe % _bd_count;
+}
+
+int StripingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    uint8_t *buffer = static_cast<uint8_t *>(b);
+
+    while (size > 0) {
+        bd_addr_t bd_addr;
+        bd_size_t read;
+        size_t i = find_bd(addr, bd_addr, read);
+        if (read > size) {
+            read = size;
+        }
+
+        int err = _bds[i]->read(buffer, bd_addr, read);
+        if (err) {
+            return err;
+        }
+
+        buffer += read;
+        addr += read;
+        size -= read;
+    }
+
+    return 0;
+}
+
+int StripingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    const uint8_t *buffer = static_cast<const uint8_t *>(b);
+
+    while (size > 0) {
+        bd_addr_t bd_addr;
+        bd_size_t program;
+        size_t i = find_bd(addr, bd_addr, program);
+        if (program > size) {
+            program = size;
+        }
+
+        int err = _bds[i]->program(buffer, bd_addr, program);
+        if (err) {
+            return err;
+        }
+
+        buffer += program;
+        addr += program;
+        size -= program;
+    }
+
+    return 0;
+}
+
+int StripingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    while (size > 0) {
+        bd_addr_t bd_addr;
+        bd_size_t erase;
+        size_t i = find_bd(addr, bd_addr, erase);
+        if (erase > size) {
+            erase = size;
+        }
+
+        int err = _bds[i]->erase(bd_addr, erase);
+        if (err) {
+            return err;
+        }
+
+        addr += erase;
+        size -= erase;
+    }
+
+    return 0;
+}
+
+int StripingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return start_async(ASYNC_READ, static_cast<uint8_t *>(b), addr, size, callback);
+}
+
+int StripingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return start_async(ASYNC_PROGRAM, const_cast<uint8_t *>(static_cast<const uint8_t *>(b)), addr, size, callback);
+}
+
+int StripingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return start_async(ASYNC_ERASE, NULL, addr, size, callback);
+}
+
+int StripingBlockDevice::start_async(async_op_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size,
+                                     mbed::Callback<void(int)> callback)
+{
+    // Held by this function until every device has been started, so the
+    // operation can't finish while it is still being set up
+    core_util_critical_section_enter();
+    bool busy = (_async_pending != 0);
+    if (!busy) {
+        _async_pending = 1;
+    }
+    core_util_critical_section_exit();
+    if (busy) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _async_op = op;
+    _async_buffer = buffer;
+    _async_addr = addr;
+    _async_end = addr + size;
+    _async_callback = callback;
+
+    // Each device starts at its first stripe within the range
+    bd_addr_t first = addr / _stripe_size;
+    for (size_t i = 0; i < _bd_count; i++) {
+        bd_addr_t skip = (i + _bd_count - first % _bd_count) % _bd_count;
+        _members[i].next = skip ? (first + skip) * _stripe_size : addr;
+        _members[i].state = MEMBER_IDLE;
+        _members[i].err = 0;
+    }
+
+    for (size_t i = 0; i < _bd_count; i++) {
+        if (_members[i].next < _async_end) {
+            core_util_atomic_incr_u32(&_async_pending, 1);
+            run_member(i);
+        }
+    }
+
+    async_release();
+    return 0;
+}
+
+void StripingBlockDevice::run_member(size_t i)
+{
+    member_t &member = _members[i];
+
+    // Operations finishing before they are done starting are followed up
+    // here rather than from their callback, to keep the stack flat
+    while (!member.err && member.next < _async_end) {
+        bd_addr_t addr = member.next;
+        bd_addr_t bd_addr;
+        bd_size_t size;
+        find_bd(addr, bd_addr, size);
+        if (size > _async_end - addr) {
+            size = _async_end - addr;
+        }
+        member.next = addr - addr % _stripe_size + _stripe_size * _bd_count;
+        member.state = MEMBER_STARTING;
+
+        mbed::Callback<void(int)> done = [this, i](int err) {
+            member_done(i, err);
+        };
+        int err;
+        if (_async_op == ASYNC_READ) {
+            err = _bds[i]->read_async(_async_buffer + (addr - _async_addr), bd_addr, size, done);
+        } else if (_async_op == ASYNC_PROGRAM) {
+            err = _bds[i]->program_async(_async_buffer + (addr - _async_addr), bd_addr, size, done);
+        } else {
+            err = _bds[i]->erase_async(bd_addr, size, done);
+        }
+        if (err) {
+            member.err = err;
+            break;
+        }
+
+        core_util_critical_section_enter();
+        bool finished = (member.state == MEMBER_DONE_EARLY);
+        member.state = finished ? MEMBER_IDLE : MEMBER_BUSY;
+        core_util_critical_section_exit();
+        if (!finished) {
+            // The callback carries on
+            return;
+        }
+    }
+
+    member.state = MEMBER_IDLE;
+    async_release();
+}
+
+void StripingBlockDevice::member_done(size_t i, int err)
+{
+    member_t &member = _members[i];
+    if (err) {
+        member.err = err;
+    }
+
+    core_util_critical_section_enter();
+    bool starting = (member.state == MEMBER_STARTING);
+    if (starting) {
+        member.state = MEMBER_DONE_EARLY;
+    }
+    core_util_critical_section_exit();
+
+    if (!starting) {
+        run_member(i);
+    }
+}
+
+void StripingBlockDevice::async_release()
+{
+    if (core_util_atomic_decr_u32(&_async_pending, 1)) {
+        return;
+    }
+
+    int err = 0;
+    for (size_t i = 0; i < _bd_count && !err; i++) {
+        err = _members[i].err;
+    }
+
+    mbed::Callback<void(int)> callback = _async_callback;
+    _async_callback = nullptr;
+    callback(err);
+}
+
+bd_size_t StripingBlockDevice::get_read_size() const
+{
+    return _read_size;
+}
+
+bd_size_t StripingBlockDevice::get_program_size() const
+{
+    return _program_size;
+}
+
+bd_size_t StripingBlockDevice::get_erase_size() const
+{
+    return _erase_size;
+}
+
+bd_size_t StripingBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    if (!_is_initialized) {
+        return 0;
+    }
+
+    bd_addr_t bd_addr;
+    bd_size_t size;
+    size_t i = find_bd(addr, bd_addr, size);
+    return _bds[i]->get_erase_size(bd_addr);
+}
+
+int StripingBlockDevice::get_erase_value() const
+{
+    return _erase_value;
+}
+
+bd_size_t StripingBlockDevice::size() const
+{
+    return _size;
+}
+
+bd_size_t StripingBlockDevice::get_stripe_size() const
+{
+    return _stripe_size;
+}
+
+const char *StripingBlockDevice::get_type() const
+{
+    return "STRIPING";
+}
+
+} // namespace mbed
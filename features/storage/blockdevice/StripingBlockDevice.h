@@ -0,0 +1,285 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_STRIPING_BLOCK_DEVICE_H
+#define MBED_STRIPING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+namespace mbed {
+
+/** Block device interleaving stripes across several block devices
+ *
+ *  Consecutive stripes of the address space go to the block devices in turn,
+ *  so large sequential operations are shared between all of them. The
+ *  asynchronous operations keep every block device busy at once, which gets
+ *  close to the combined throughput of devices on separate buses.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "QSPIFBlockDevice.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "StripingBlockDevice.h"
+ *
+ *  QSPIFBlockDevice qspif;
+ *  SPIFBlockDevice spif(SPI_MOSI, SPI_MISO, SPI_SCK, SPI_CS);
+ *  BlockDevice *bds[] = {&qspif, &spif};
+ *
+ *  // 4 KiB from each flash in turn
+ *  StripingBlockDevice striped(bds, 4096);
+ *  @endcode
+ */
+class StripingBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the striping block device
+     *
+     *  @param bds          Array of block devices to stripe across
+     *  @param bd_count     Number of block devices to stripe across
+     *  @param stripe_size  Size of a stripe in bytes, rounded up to whole erase
+     *                      blocks, 0 for one erase block (Default: 0)
+     *  @note All block devices must have the same block sizes
+     */
+    StripingBlockDevice(BlockDevice **bds, size_t bd_count, bd_size_t stripe_size = 0);
+
+    /** Lifetime of the striping block device
+     *
+     *  @param bds          Array of block devices to stripe across
+     *  @param stripe_size  Size of a stripe in bytes, rounded up to whole erase
+     *                      blocks, 0 for one erase block (Default: 0)
+     *  @note All block devices must have the same block sizes
+     */
+    template <size_t Size>
+    StripingBlockDevice(BlockDevice * (&bds)[Size], bd_size_t stripe_size = 0)
+        : StripingBlockDevice(bds, Size, stripe_size)
+    {
+    }
+
+    /** Lifetime of the striping block device
+     */
+    virtual ~StripingBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Start reading blocks from a block device
+     *
+     *  Each striped block device reads its stripes in turn, all of them at
+     *  the same time. Only one asynchronous operation may be in progress.
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function to call with the result when the read has finished
+     *  @return         0 if the read was started, or a negative error code
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start programming blocks to a block device
+     *
+     *  Each striped block device programs its stripes in turn, all of them
+     *  at the same time. Only one asynchronous operation may be in progress.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function to call with the result when the program has finished
+     *  @return         0 if the program was started, or a negative error code
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Start erasing blocks on a block device
+     *
+     *  Each striped block device erases its stripes in turn, all of them at
+     *  the same time. Only one asynchronous operation may be in progress.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function to call with the result when the erase has finished
+     *  @return         0 if the erase was started, or a negative error code
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     *  @note Must be a multiple of the read size
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an eraseable block
+     *
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  If get_erase_value returns a non-negative byte value, the underlying
+     *  storage is set to that value when erased, and storage containing
+     *  that value can be programmed without another erase.
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  Every block device contributes as many whole stripes as the smallest
+     *  of them holds.
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the size of a stripe
+     *
+     *  @return         Size of a stripe in bytes, once initialized
+     */
+    bd_size_t get_stripe_size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+protected:
+    enum async_op_t {
+        ASYNC_READ,
+        ASYNC_PROGRAM,
+        ASYNC_ERASE
+    };
+
+    enum member_state_t {
+        MEMBER_IDLE,        // No operation started
+        MEMBER_STARTING,    // In the middle of starting an operation
+        MEMBER_BUSY,        // Operation started, the callback restarts the member
+        MEMBER_DONE_EARLY   // Operation finished before it was done starting
+    };
+
+    struct member_t {
+        bd_addr_t next;             // Next address of the member within the operation
+        volatile member_state_t state;
+        int err;
+    };
+
+    BlockDevice **_bds;
+    size_t _bd_count;
+    bd_size_t _stripe_size;
+    bd_size_t _read_size;
+    bd_size_t _program_size;
+    bd_size_t _erase_size;
+    int _erase_value;
+    bd_size_t _size;
+    member_t *_members;
+    uint32_t _init_ref_count;
+    bool _is_initialized;
+
+    async_op_t _async_op;
+    uint8_t *_async_buffer;
+    bd_addr_t _async_addr;
+    bd_addr_t _async_end;
+    volatile uint32_t _async_pending;
+    mbed::Callback<void(int)> _async_callback;
+
+#if !(DOXYGEN_ONLY)
+    // Translate an address to the device holding it, and the size until the end of its stripe
+    size_t find_bd(bd_addr_t addr, bd_addr_t &bd_addr, bd_size_t &size) const;
+
+    int start_async(async_op_t op, uint8_t *buffer, bd_addr_t addr, bd_size_t size,
+                    mbed::Callback<void(int)> callback);
+    void run_member(size_t i);
+    void member_done(size_t i, int err);
+    void async_release();
+#endif //#if !(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::StripingBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
@@ -17,8 +17,62 @@
 #include "File.h"
 #include <errno.h>
 
+#if MBED_CONF_RTOS_PRESENT
+#include "events/EventQueue.h"
+#include "events/mbed_shared_queues.h"
+#include "rtos/Thread.h"
+#include "rtos/ThisThread.h"
+
+using namespace std::chrono;
+#endif
+
 namespace mbed {
 
+#if MBED_CONF_RTOS_PRESENT
+namespace {
+
+/* Thread running the asynchronous requests of all files in turn, so they are
+ * ordered and only one of them waits on the storage at a time.
+ */
+class StorageWorker {
+public:
+    StorageWorker() :
+        queue(sizeof queue_buffer, (unsigned char *) queue_buffer),
+        thread(osPriorityNormal, sizeof stack, (unsigned char *) stack, "storage_worker")
+    {
+        osStatus status = thread.start(callback(&queue, &events::EventQueue::dispatch_forever));
+        MBED_ASSERT(status == osOK);
+        (void)status;
+    }
+
+    static StorageWorker &get()
+    {
+        static StorageWorker worker;
+        return worker;
+    }
+
+    events::EventQueue queue;
+
+private:
+    uint64_t queue_buffer[MBED_CONF_FILESYSTEM_ASYNC_EVENTSIZE / sizeof(uint64_t)];
+    uint64_t stack[MBED_CONF_FILESYSTEM_ASYNC_STACKSIZE / sizeof(uint64_t)];
+    rtos::Thread thread;
+};
+
+void post_completion(events::EventQueue *queue, Callback<void(ssize_t)> callback, ssize_t result)
+{
+    if (!callback) {
+        return;
+    }
+    // Wait for room in the caller's queue rather than dropping the result
+    while (!queue->call(callback, result)) {
+        rtos::ThisThread::sleep_for(1ms);
+    }
+}
+
+} // namespace
+#endif
+
 File::File()
     : _fs(0), _file(0)
 {
@@ -74,6 +128,53 @@ ssize_t File::write(const void *buffer, size_t len)
     return _fs->file_write(_file, buffer, len);
 }
 
+int File::read_async(void *buffer, size_t size, Callback<void(ssize_t)> callback, events::EventQueue *queue)
+{
+    MBED_ASSERT(_fs);
+#if MBED_CONF_RTOS_PRESENT
+    int id = StorageWorker::get().queue.call(mbed::callback(this, &File::async_read), buffer, size, callback,
+                                             queue ? queue : mbed_event_queue());
+    return id ? id : -ENOMEM;
+#else
+    return -ENOSYS;
+#endif
+}
+
+int File::write_async(const void *buffer, size_t size, Callback<void(ssize_t)> callback, events::EventQueue *queue)
+{
+    MBED_ASSERT(_fs);
+#if MBED_CONF_RTOS_PRESENT
+    int id = StorageWorker::get().queue.call(mbed::callback(this, &File::async_write), buffer, size, callback,
+                                             queue ? queue : mbed_event_queue());
+    return id ? id : -ENOMEM;
+#else
+    return -ENOSYS;
+#endif
+}
+
+bool File::cancel_async(int id)
+{
+#if MBED_CONF_RTOS_PRESENT
+    return StorageWorker::get().queue.cancel(id);
+#else
+    return false;
+#endif
+}
+
+void File::async_read(void *buffer, size_t size, Callback<void(ssize_t)> callback, events::EventQueue *queue)
+{
+#if MBED_CONF_RTOS_PRESENT
+    post_completion(queue, callback, _fs ? read(buffer, size) : -EBADF);
+#endif
+}
+
+void File::async_write(const void *buffer, size_t size, Callback<void(ssize_t)> callback, events::EventQueue *queue)
+{
+#if MBED_CONF_RTOS_PRESENT
+    post_completion(queue, callback, _fs ? write(buffer, size) : -EBADF);
+#endif
+}
+
 int File::sync()
 {
     MBED_ASSERT(_fs);
@@ -116,4 +217,28 @@ int File::truncate(off_t length)
     return _fs->file_truncate(_file, length);
 }
 
+int File::set_cache(size_t size)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_set_cache(_file, size);
+}
+
+int File::get_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_cache_stats(_file, hits, misses);
+}
+
+int File::preallocate(off_t size)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_preallocate(_file, size);
+}
+
+int File::map(const void **data)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_map(_file, data);
+}
+
 } // namespace mbed
@@ -20,6 +20,10 @@
 #include "features/storage/filesystem/FileSystem.h"
 #include "platform/FileHandle.h"
 
+namespace events {
+class EventQueue;
+}
+
 namespace mbed {
 /** \addtogroup filesystem */
 /** @{*/
@@ -85,6 +89,47 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size);
 
+    /** Read the contents of a file into a buffer without blocking
+     *
+     *  The read runs on the storage worker thread, shared by all files, after
+     *  the requests made before it. The callback is then posted to the queue
+     *  with the result of read(). The buffer and the file must stay valid
+     *  until the callback runs or the request is cancelled.
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @param callback Callback receiving the number of bytes read, 0 at end
+     *                  of file, negative error on failure
+     *  @param queue    Queue the callback is posted to, NULL for mbed_event_queue()
+     *  @return         Positive id of the request for cancel_async(), -ENOMEM
+     *                  if the worker queue is full, -ENOSYS without an RTOS
+     */
+    int read_async(void *buffer, size_t size, Callback<void(ssize_t)> callback,
+                   events::EventQueue *queue = NULL);
+
+    /** Write the contents of a buffer to a file without blocking
+     *
+     *  The write runs on the storage worker thread, as read_async().
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @param callback Callback receiving the number of bytes written,
+     *                  negative error on failure
+     *  @param queue    Queue the callback is posted to, NULL for mbed_event_queue()
+     *  @return         Positive id of the request for cancel_async(), -ENOMEM
+     *                  if the worker queue is full, -ENOSYS without an RTOS
+     */
+    int write_async(const void *buffer, size_t size, Callback<void(ssize_t)> callback,
+                    events::EventQueue *queue = NULL);
+
+    /** Cancel a request made with read_async() or write_async()
+     *
+     *  @param id       Id returned when making the request
+     *  @return         True if the request had not started, and its callback
+     *                  won't be called. False if it is running or done.
+     */
+    bool cancel_async(int id);
+
     /** Flush any buffers associated with the file
      *
      *  @return         0 on success, negative error code on failure
@@ -138,7 +183,59 @@ public:
      */
     virtual int truncate(off_t length);
 
+    /** Set the size of the file's own read cache
+     *
+     *  Reads served from the cache don't wait for other operations on the
+     *  file system, and a cache larger than the file system's read size
+     *  suits streaming through a large file.
+     *
+     *  @param size     Size of the cache in bytes, 0 to drop it
+     *
+     *  @return         Zero on success, -ENOSYS if the file system has no
+     *                  per file caches, negative error code on failure
+     */
+    int set_cache(size_t size);
+
+    /** Get the read cache statistics of the file
+     *
+     *  @param hits     Destination for the number of reads served from the cache
+     *  @param misses   Destination for the number of reads that went to the file system
+     *
+     *  @return         Zero on success, negative error code on failure
+     */
+    int get_cache_stats(uint32_t *hits, uint32_t *misses);
+
+    /** Allocate storage for an empty file ahead of writing it
+     *
+     *  On FATFileSystem, this allocates a contiguous cluster chain and the
+     *  file's size becomes the given size. The contents are undefined until
+     *  written, so truncate the file to the length written when done. Combined
+     *  with O_DIRECT, whole sector writes then span clusters.
+     *
+     *  @param size     Number of bytes to allocate
+     *
+     *  @return         Zero on success, -ENOSYS if the file system can't
+     *                  preallocate, negative error code on failure
+     */
+    int preallocate(off_t size);
+
+    /** Get a pointer to the contents of the file
+     *
+     *  On file systems in memory mapped storage, such as ROMFileSystem, the
+     *  contents can then be used in place without copying them out with
+     *  read. The pointer stays valid until the file system is unmounted.
+     *
+     *  @param data     Destination for the pointer to the first byte of the file
+     *
+     *  @return         Zero on success, -ENOSYS if the file system is not
+     *                  memory mapped, negative error code on failure
+     */
+    int map(const void **data);
+
 private:
+    void async_read(void *buffer, size_t size, Callback<void(ssize_t)> callback, events::EventQueue *queue);
+    void async_write(const void *buffer, size_t size, Callback<void(ssize_t)> callback, events::EventQueue *queue);
+
     FileSystem *_fs;
     fs_file_t _file;
 };
@@ -89,6 +89,26 @@ int FileSystem::file_truncate(fs_file_t file, off_t length)
     return -ENOSYS;
 }
 
+int FileSystem::file_set_cache(fs_file_t file, size_t size)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_cache_stats(fs_file_t file, uint32_t *hits, uint32_t *misses)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_preallocate(fs_file_t file, off_t size)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_map(fs_file_t file, const void **data)
+{
+    return -ENOSYS;
+}
+
 int FileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
     return -ENOSYS;
@@ -233,6 +233,39 @@ protected:
      */
     virtual int file_truncate(fs_file_t file, off_t length);
 
+    /** Set the size of the read cache of a file.
+     *
+     *  @param file     File handle.
+     *  @param size     Size of the cache in bytes, 0 to drop it.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_set_cache(fs_file_t file, size_t size);
+
+    /** Get the read cache statistics of a file.
+     *
+     *  @param file     File handle.
+     *  @param hits     Destination for the number of reads served from the cache.
+     *  @param misses   Destination for the number of reads that went to the file system.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_cache_stats(fs_file_t file, uint32_t *hits, uint32_t *misses);
+
+    /** Allocate storage for a file ahead of writing it.
+     *
+     *  @param file     File handle.
+     *  @param size     Number of bytes to allocate.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_preallocate(fs_file_t file, off_t size);
+
+    /** Get a pointer to the contents of a file in memory mapped storage.
+     *
+     *  @param file     File handle.
+     *  @param data     Destination for the pointer to the first byte of the file.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_map(fs_file_t file, const void **data);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
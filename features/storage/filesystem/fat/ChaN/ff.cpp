@@ -1407,6 +1407,92 @@ FRESULT fill_last_frag (
 
 
 #if !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Count free clusters in steps                           */
+/*-----------------------------------------------------------------------*/
+static
+void scan_adjust (
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst,		/* First cluster allocated or freed */
+	DWORD ncl,		/* Number of clusters */
+	int freed		/* 1:freed, 0:allocated */
+)
+{
+	/* Clusters behind the scan point have been counted already, so follow their changes */
+	if (fs->scan_clst > clst) {
+		if (ncl > fs->scan_clst - clst) ncl = fs->scan_clst - clst;
+		if (freed) {
+			fs->scan_free += ncl;
+		} else {
+			fs->scan_free -= ncl;
+		}
+	}
+}
+
+
+#if FF_FS_MINIMIZE == 0
+static
+FRESULT scan_free (	/* FR_OK(0):succeeded, !=0:error */
+	FATFS* fs,		/* Filesystem object */
+	DWORD ncl		/* Maximum number of clusters to check */
+)
+{
+	FRESULT res = FR_OK;
+	DWORD clst, stat;
+	UINT i, es;
+	FFOBJID obj;
+
+
+	if (fs->scan_clst < 2) {	/* Start a new scan */
+		fs->scan_clst = 2;
+		fs->scan_free = 0;
+	}
+	clst = fs->scan_clst;
+	obj.fs = fs;
+	while (ncl && clst < fs->n_fatent) {
+#if FF_FS_EXFAT
+		if (fs->fs_type == FS_EXFAT) {	/* exFAT: Check the allocation bitmap */
+			res = move_window(fs, fs->database + (clst - 2) / 8 / SS(fs));
+			if (res != FR_OK) break;
+			if (!(fs->win[(clst - 2) / 8 % SS(fs)] & (1 << ((clst - 2) % 8)))) fs->scan_free++;
+			clst++; ncl--;
+		} else
+#endif
+		if (fs->fs_type == FS_FAT12) {	/* FAT12: Entries straddle sectors, go through get_fat() */
+			stat = get_fat(&obj, clst);
+			if (stat == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+			if (stat == 1) { res = FR_INT_ERR; break; }
+			if (stat == 0) fs->scan_free++;
+			clst++; ncl--;
+		} else {	/* FAT16/32: Check the rest of the FAT sector in one go */
+			es = (fs->fs_type == FS_FAT16) ? 2 : 4;
+			res = move_window(fs, fs->fatbase + clst / (SS(fs) / es));
+			if (res != FR_OK) break;
+			i = clst % (SS(fs) / es) * es;
+			do {
+				if (es == 2) {
+					if (ld_word(fs->win + i) == 0) fs->scan_free++;
+				} else {
+					if ((ld_dword(fs->win + i) & 0x0FFFFFFF) == 0) fs->scan_free++;
+				}
+				clst++; ncl--; i += es;
+			} while (ncl && clst < fs->n_fatent && i < SS(fs));
+		}
+	}
+	fs->scan_clst = clst;
+
+	if (res == FR_OK && clst >= fs->n_fatent) {	/* Scan done? */
+		fs->free_clst = fs->scan_free;	/* Now free_clst is valid */
+		fs->fsi_flag |= 1;				/* FAT32: FSInfo is to be updated */
+		fs->scan_clst = 0;
+	}
+	return res;
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* FAT handling - Remove a cluster chain                                 */
 /*-----------------------------------------------------------------------*/
@@ -1449,6 +1535,7 @@ FRESULT remove_chain (	/* FR_OK(0):succeeded, !=0:error */
 			fs->free_clst++;
 			fs->fsi_flag |= 1;
 		}
+		scan_adjust(fs, clst, 1, 1);
 #if FF_FS_EXFAT || FF_USE_TRIM
 		if (ecl + 1 == nxt) {	/* Is next cluster contiguous? */
 			ecl = nxt;
@@ -1591,6 +1678,7 @@ DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk err
 	if (res == FR_OK) {			/* Update FSINFO if function succeeded. */
 		fs->last_clst = ncl;
 		if (fs->free_clst <= fs->n_fatent - 2) fs->free_clst--;
+		scan_adjust(fs, ncl, 1, 0);
 		fs->fsi_flag |= 1;
 	} else {
 		ncl = (res == FR_DISK_ERR) ? 0xFFFFFFFF : 1;	/* Failed. Generate error status */
@@ -3348,6 +3436,7 @@ FRESULT find_volume (	/* FR_OK(0): successful, !=0: any error occurred */
 		if (i == SS(fs)) return FR_NO_FILESYSTEM;
 #if !FF_FS_READONLY
 		fs->last_clst = fs->free_clst = 0xFFFFFFFF;		/* Initialize cluster allocation information */
+		fs->scan_clst = 0;
 #endif
 		fmt = FS_EXFAT;			/* FAT sub-type */
 	} else
@@ -3407,6 +3496,7 @@ FRESULT find_volume (	/* FR_OK(0): successful, !=0: any error occurred */
 #if !FF_FS_READONLY
 		/* Get FSInfo if available */
 		fs->last_clst = fs->free_clst = 0xFFFFFFFF;		/* Initialize cluster allocation information */
+		fs->scan_clst = 0;
 		fs->fsi_flag = 0x80;
 #if (FF_FS_NOFSINFO & 3) != 3
 		if (fmt == FS_FAT32				/* Allow to update FSInfo only if BPB_FSInfo32 == 1 */
@@ -3698,6 +3788,7 @@ FRESULT f_open (
 			fp->obj.id = fs->id;
 			fp->flag = mode;		/* Set file access mode */
 			fp->err = 0;			/* Clear error flag */
+			fp->stream = 0;			/* Not streaming */
 			fp->sect = 0;			/* Invalidate current data sector */
 			fp->fptr = 0;			/* Set file pointer top of the file */
 #if !FF_FS_READONLY
@@ -3899,7 +3990,7 @@ FRESULT f_write (
 				if (fp->obj.sclust == 0) fp->obj.sclust = clst;	/* Set start cluster if the first write */
 #if FLUSH_ON_NEW_CLUSTER
                 // We do not need to flush for the first cluster
-                if (fp->fptr != 0) {
+                if (fp->fptr != 0 && !fp->stream) {
                     need_sync = true;
                 }
 #endif
@@ -3918,7 +4009,14 @@ FRESULT f_write (
 			cc = btw / SS(fs);				/* When remaining bytes >= sector size, */
 			if (cc > 0) {					/* Write maximum contiguous sectors directly */
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
+					UINT ncc = cc;
 					cc = fs->csize - csect;
+					if (fp->stream) {			/* Streaming: go on over the following clusters while the chain is consecutive */
+						while (cc + fs->csize <= ncc && get_fat(&fp->obj, fp->clust) == fp->clust + 1) {
+							fp->clust++;
+							cc += fs->csize;
+						}
+					}
 				}
 				if (disk_write(fs->pdrv, wbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
 #if FF_FS_MINIMIZE <= 2
@@ -3936,7 +4034,9 @@ FRESULT f_write (
 #endif
 				wcnt = SS(fs) * cc;		/* Number of bytes transferred */
 #if FLUSH_ON_NEW_SECTOR
-                need_sync = true;
+                if (!fp->stream) {
+                    need_sync = true;
+                }
 #endif
 				continue;
 			}
@@ -4641,74 +4741,49 @@ FRESULT f_getfree (
 {
 	FRESULT res;
 	FATFS *fs;
-	DWORD nfree, clst, sect, stat;
-	UINT i;
-	FFOBJID obj;
 
 
 	/* Get logical drive */
 	res = find_volume(&path, &fs, 0);
 	if (res == FR_OK) {
 		*fatfs = fs;				/* Return ptr to the fs object */
-		/* If free_clst is valid, return it without full FAT scan */
-		if (fs->free_clst <= fs->n_fatent - 2) {
+		/* If free_clst is not valid, scan the rest of the FAT (continuing any scan in progress) */
+		if (fs->free_clst > fs->n_fatent - 2) {
+			res = scan_free(fs, fs->n_fatent);
+		}
+		if (res == FR_OK) {
 			*nclst = fs->free_clst;
-		} else {
-			/* Scan FAT to obtain number of free clusters */
-			nfree = 0;
-			if (fs->fs_type == FS_FAT12) {	/* FAT12: Scan bit field FAT entries */
-				clst = 2; obj.fs = fs;
-				do {
-					stat = get_fat(&obj, clst);
-					if (stat == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
-					if (stat == 1) { res = FR_INT_ERR; break; }
-					if (stat == 0) nfree++;
-				} while (++clst < fs->n_fatent);
-			} else {
-#if FF_FS_EXFAT
-				if (fs->fs_type == FS_EXFAT) {	/* exFAT: Scan allocation bitmap */
-					BYTE bm;
-					UINT b;
-
-					clst = fs->n_fatent - 2;	/* Number of clusters */
-					sect = fs->database;		/* Assuming bitmap starts at cluster 2 */
-					i = 0;						/* Offset in the sector */
-					do {	/* Counts numbuer of bits with zero in the bitmap */
-						if (i == 0) {
-							res = move_window(fs, sect++);
-							if (res != FR_OK) break;
-						}
-						for (b = 8, bm = fs->win[i]; b && clst; b--, clst--) {
-							if (!(bm & 1)) nfree++;
-							bm >>= 1;
-						}
-						i = (i + 1) % SS(fs);
-					} while (clst);
-				} else
-#endif
-				{	/* FAT16/32: Scan WORD/DWORD FAT entries */
-					clst = fs->n_fatent;	/* Number of entries */
-					sect = fs->fatbase;		/* Top of the FAT */
-					i = 0;					/* Offset in the sector */
-					do {	/* Counts numbuer of entries with zero in the FAT */
-						if (i == 0) {
-							res = move_window(fs, sect++);
-							if (res != FR_OK) break;
-						}
-						if (fs->fs_type == FS_FAT16) {
-							if (ld_word(fs->win + i) == 0) nfree++;
-							i += 2;
-						} else {
-							if ((ld_dword(fs->win + i) & 0x0FFFFFFF) == 0) nfree++;
-							i += 4;
-						}
-						i %= SS(fs);
-					} while (--clst);
-				}
-			}
-			*nclst = nfree;			/* Return the free clusters */
-			fs->free_clst = nfree;	/* Now free_clst is valid */
-			fs->fsi_flag |= 1;		/* FAT32: FSInfo is to be updated */
+		}
+	}
+
+	LEAVE_FF(fs, res);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Count Free Clusters in Steps                                          */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_scanfree (
+	const TCHAR* path,	/* Logical drive number */
+	UINT ncl,			/* Number of clusters to check in this step */
+	DWORD* remain		/* Pointer to return number of clusters left to check (0:free count is valid) */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+
+
+	/* Get logical drive */
+	res = find_volume(&path, &fs, 0);
+	if (res == FR_OK) {
+		if (fs->free_clst > fs->n_fatent - 2) {
+			res = scan_free(fs, ncl);
+		}
+		if (res == FR_OK) {
+			*remain = (fs->free_clst <= fs->n_fatent - 2) ? 0 : fs->n_fatent - fs->scan_clst;
 		}
 	}
 
@@ -5449,6 +5524,7 @@ FRESULT f_expand (
 				fs->free_clst -= tcl;
 				fs->fsi_flag |= 1;
 			}
+			scan_adjust(fs, scl, tcl, 0);
 		}
 	}
 
@@ -557,6 +557,25 @@ int FATFileSystem::statvfs(const char *path, struct statvfs *buf)
     return 0;
 }
 
+int FATFileSystem::scan_free_space(uint32_t step)
+{
+    if (!step) {
+        return -EINVAL;
+    }
+
+    DWORD remain;
+    do {
+        lock();
+        FRESULT res = f_scanfree(_fsid, step, &remain);
+        unlock();
+        if (res != FR_OK) {
+            return fat_error_remap(res);
+        }
+    } while (remain);
+
+    return 0;
+}
+
 void FATFileSystem::lock()
 {
     _ffs_mutex->lock();
@@ -610,6 +629,9 @@ int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 
     unlock();
 
+    // Streaming writes leave syncing to file_sync() and file_close()
+    fh->stream = (flags & O_DIRECT) ? 1 : 0;
+
     *file = fh;
     return 0;
 }
@@ -747,7 +769,27 @@ int FATFileSystem::file_truncate(fs_file_t file, off_t length)
         return fat_error_remap(res);
     }
 
+    unlock();
+    return 0;
+}
+
+int FATFileSystem::file_preallocate(fs_file_t file, off_t size)
+{
+#if FF_USE_EXPAND
+    FIL *fh = static_cast<FIL *>(file);
+
+    lock();
+    FRESULT res = f_expand(fh, size, 1);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+        return fat_error_remap(res);
+    }
     return 0;
+#else
+    return -ENOSYS;
+#endif
 }
 
 
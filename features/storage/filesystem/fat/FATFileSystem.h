@@ -153,6 +153,21 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Count the free space on the mounted file system in steps.
+     *
+     *  If the volume has no usable free cluster count in its FSInfo sector,
+     *  the first statvfs() walks the whole FAT while holding the file system,
+     *  which takes seconds on a large card. Calling this from a low priority
+     *  thread after mount() does the same walk, but releases the file system
+     *  between steps so other operations can run. Clusters allocated or freed
+     *  during the walk are accounted for, and once the count is known statvfs()
+     *  returns at once. On FAT32 the count is written back to FSInfo on the next sync.
+     *
+     *  @param step     Number of FAT entries to check each time the file system is held.
+     *  @return         0 on success, negative error code on failure.
+     */
+    int scan_free_space(uint32_t step = 4096);
+
 protected:
 #if !(DOXYGEN_ONLY)
     /** Open a file on the file system.
@@ -236,6 +251,17 @@ protected:
      */
     virtual int file_truncate(mbed::fs_file_t file, off_t length);
 
+    /** Allocate contiguous clusters for an empty file.
+     *
+     *  Needs fat_chan.ff_use_expand. The file size becomes the given size.
+     *
+     *  @param file     File handle.
+     *  @param size     Number of bytes to allocate.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_preallocate(mbed::fs_file_t file, off_t size);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
@@ -20,6 +20,18 @@
 #include "features/storage/filesystem/littlefs/littlefs/lfs_util.h"
 #include "MbedCRC.h"
 
+#if MBED_CONF_RTOS_API_PRESENT
+#include "rtos/Semaphore.h"
+#endif
+
+#ifndef MBED_LFS_FILE_CACHE_SIZE
+#define MBED_LFS_FILE_CACHE_SIZE 0
+#endif
+
+#ifndef MBED_LFS_READAHEAD_SIZE
+#define MBED_LFS_READAHEAD_SIZE 0
+#endif
+
 namespace mbed {
 
 extern "C" void lfs_crc(uint32_t *crc, const void *buffer, size_t size)
@@ -139,6 +151,133 @@ static int lfs_bd_sync(const struct lfs_config *c)
     return bd->sync();
 }
 
+// Readahead of the block device. A read following on from the previous one
+// starts reading the data after it in the background, so the caller can deal
+// with its data while the next piece comes in. The block device is only used
+// with the file system locked, so there is at most one readahead in flight.
+struct lfs_readahead_t {
+    BlockDevice *bd;
+    uint8_t *buffer;
+    lfs_size_t size;
+    bd_addr_t off;          // Address of the buffered data
+    lfs_size_t len;         // Size of the buffered data, or of the data being read
+    bd_addr_t last;         // End of the last read, to spot sequential reads
+    bool started;           // Readahead started and not waited for yet
+    volatile bool finished;
+    int err;
+#if MBED_CONF_RTOS_API_PRESENT
+    rtos::Semaphore done{0};
+#endif
+};
+
+static void lfs_ra_done(lfs_readahead_t *ra, int err)
+{
+    ra->err = err;
+    ra->finished = true;
+#if MBED_CONF_RTOS_API_PRESENT
+    ra->done.release();
+#endif
+}
+
+static void lfs_ra_wait(lfs_readahead_t *ra)
+{
+    if (!ra->started) {
+        return;
+    }
+#if MBED_CONF_RTOS_API_PRESENT
+    ra->done.acquire();
+#else
+    while (!ra->finished);
+#endif
+    ra->started = false;
+    if (ra->err) {
+        ra->len = 0;
+    }
+}
+
+static void lfs_ra_start(lfs_readahead_t *ra, bd_addr_t addr)
+{
+    bd_size_t bd_size = ra->bd->size();
+    ra->len = 0;
+    if (addr >= bd_size) {
+        return;
+    }
+
+    ra->off = addr;
+    ra->len = (bd_size - addr < ra->size) ? (lfs_size_t)(bd_size - addr) : ra->size;
+    ra->finished = false;
+    ra->started = true;
+    if (ra->bd->read_async(ra->buffer, ra->off, ra->len, callback(lfs_ra_done, ra))) {
+        ra->started = false;
+        ra->len = 0;
+    }
+}
+
+static int lfs_ra_read(const struct lfs_config *c, lfs_block_t block,
+                       lfs_off_t off, void *buffer, lfs_size_t size)
+{
+    lfs_readahead_t *ra = (lfs_readahead_t *)c->context;
+    bd_addr_t addr = (bd_addr_t)block * c->block_size + off;
+    bool sequential = (addr == ra->last);
+    ra->last = addr + size;
+
+    if (addr >= ra->off && addr + size <= ra->off + ra->len) {
+        lfs_ra_wait(ra);
+        // Still there unless the readahead failed
+        if (ra->len) {
+            memcpy(buffer, ra->buffer + (addr - ra->off), size);
+            if (addr + size == ra->off + ra->len) {
+                lfs_ra_start(ra, addr + size);
+            }
+            return 0;
+        }
+    }
+
+    lfs_ra_wait(ra);
+    int err = ra->bd->read(buffer, addr, size);
+    if (err) {
+        return err;
+    }
+    if (sequential) {
+        lfs_ra_start(ra, addr + size);
+    }
+    return 0;
+}
+
+static int lfs_ra_prog(const struct lfs_config *c, lfs_block_t block,
+                       lfs_off_t off, const void *buffer, lfs_size_t size)
+{
+    lfs_readahead_t *ra = (lfs_readahead_t *)c->context;
+    lfs_ra_wait(ra);
+    ra->len = 0;
+    return ra->bd->program(buffer, (bd_addr_t)block * c->block_size + off, size);
+}
+
+static int lfs_ra_erase(const struct lfs_config *c, lfs_block_t block)
+{
+    lfs_readahead_t *ra = (lfs_readahead_t *)c->context;
+    lfs_ra_wait(ra);
+    ra->len = 0;
+    return ra->bd->erase((bd_addr_t)block * c->block_size, c->block_size);
+}
+
+static int lfs_ra_sync(const struct lfs_config *c)
+{
+    lfs_readahead_t *ra = (lfs_readahead_t *)c->context;
+    lfs_ra_wait(ra);
+    return ra->bd->sync();
+}
+
+static void lfs_ra_free(lfs_readahead_t *&ra)
+{
+    if (ra) {
+        lfs_ra_wait(ra);
+        delete[] ra->buffer;
+        delete ra;
+        ra = NULL;
+    }
+}
+
 
 ////// Generic filesystem operations //////
 
@@ -150,6 +289,7 @@ LittleFileSystem::LittleFileSystem(const char *name, BlockDevice *bd,
     , _lfs()
     , _config()
     , _bd(NULL)
+    , _readahead(NULL)
     , _read_size(read_size)
     , _prog_size(prog_size)
     , _block_size(block_size)
@@ -203,8 +343,28 @@ int LittleFileSystem::mount(BlockDevice *bd)
         _config.lookahead = _lookahead;
     }
 
+    if (MBED_LFS_READAHEAD_SIZE) {
+        _readahead = new lfs_readahead_t;
+        _readahead->bd = bd;
+        _readahead->size = (MBED_LFS_READAHEAD_SIZE + _config.read_size - 1) / _config.read_size * _config.read_size;
+        _readahead->buffer = new uint8_t[_readahead->size];
+        _readahead->off = 0;
+        _readahead->len = 0;
+        _readahead->last = 0;
+        _readahead->started = false;
+        _readahead->finished = false;
+        _readahead->err = 0;
+
+        _config.context = _readahead;
+        _config.read  = lfs_ra_read;
+        _config.prog  = lfs_ra_prog;
+        _config.erase = lfs_ra_erase;
+        _config.sync  = lfs_ra_sync;
+    }
+
     err = lfs_mount(&_lfs, &_config);
     if (err) {
+        lfs_ra_free(_readahead);
         _bd = NULL;
         LFS_INFO("mount -> %d", lfs_toerror(err));
         _mutex.unlock();
@@ -227,6 +387,8 @@ int LittleFileSystem::unmount()
             res = lfs_toerror(err);
         }
 
+        lfs_ra_free(_readahead);
+
         err = _bd->deinit();
         if (err && !res) {
             res = err;
@@ -411,48 +573,141 @@ int LittleFileSystem::statvfs(const char *name, struct statvfs *st)
 }
 
 ////// File operations //////
+// Read cache of a file opened read only. The file position is kept here, and
+// the lfs file is only moved when the cache misses.
+struct lfs_file_cache_t {
+    PlatformMutex mutex;
+    uint8_t *buffer;
+    lfs_size_t size;
+    lfs_off_t off;
+    lfs_size_t len;
+    lfs_off_t pos;
+    uint32_t hits;
+    uint32_t misses;
+};
+
+struct lfs_handle_t {
+    lfs_file_t file;
+    lfs_file_cache_t *cache;
+};
+
 int LittleFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 {
-    lfs_file_t *f = new lfs_file_t;
+    lfs_handle_t *h = new lfs_handle_t;
+    h->cache = NULL;
     _mutex.lock();
     LFS_INFO("file_open(%p, \"%s\", 0x%x)", *file, path, flags);
-    int err = lfs_file_open(&_lfs, f, path, lfs_fromflags(flags));
+    int err = lfs_file_open(&_lfs, &h->file, path, lfs_fromflags(flags));
     LFS_INFO("file_open -> %d", lfs_toerror(err));
     _mutex.unlock();
     if (!err) {
-        *file = f;
+        *file = h;
+        if (MBED_LFS_FILE_CACHE_SIZE && (flags & O_ACCMODE) == O_RDONLY) {
+            file_set_cache(h, MBED_LFS_FILE_CACHE_SIZE);
+        }
     } else {
-        delete f;
+        delete h;
     }
     return lfs_toerror(err);
 }
 
 int LittleFileSystem::file_close(fs_file_t file)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_handle_t *h = (lfs_handle_t *)file;
     _mutex.lock();
     LFS_INFO("file_close(%p)", file);
-    int err = lfs_file_close(&_lfs, f);
+    int err = lfs_file_close(&_lfs, &h->file);
     LFS_INFO("file_close -> %d", lfs_toerror(err));
     _mutex.unlock();
-    delete f;
+    if (h->cache) {
+        delete[] h->cache->buffer;
+        delete h->cache;
+    }
+    delete h;
     return lfs_toerror(err);
 }
 
 ssize_t LittleFileSystem::file_read(fs_file_t file, void *buffer, size_t len)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_handle_t *h = (lfs_handle_t *)file;
+    if (h->cache) {
+        return file_read_cached(h, buffer, len);
+    }
     _mutex.lock();
     LFS_INFO("file_read(%p, %p, %d)", file, buffer, len);
-    lfs_ssize_t res = lfs_file_read(&_lfs, f, buffer, len);
+    lfs_ssize_t res = lfs_file_read(&_lfs, &h->file, buffer, len);
     LFS_INFO("file_read -> %d", lfs_toerror(res));
     _mutex.unlock();
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::file_read_cached(void *handle, void *buffer, size_t len)
+{
+    lfs_handle_t *h = (lfs_handle_t *)handle;
+    lfs_file_cache_t *c = h->cache;
+    uint8_t *buf = (uint8_t *)buffer;
+    lfs_ssize_t res = 0;
+    size_t done = 0;
+    bool missed = false;
+
+    c->mutex.lock();
+    while (done < len) {
+        if (c->pos >= c->off && c->pos < c->off + c->len) {
+            lfs_size_t chunk = lfs_min(len - done, c->off + c->len - c->pos);
+            memcpy(buf + done, c->buffer + (c->pos - c->off), chunk);
+            c->pos += chunk;
+            done += chunk;
+            continue;
+        }
+
+        // Only a miss locks the file system
+        missed = true;
+        _mutex.lock();
+        LFS_INFO("file_read(%p, %p, %d)", handle, buf + done, len - done);
+        if (lfs_file_tell(&_lfs, &h->file) != (lfs_soff_t)c->pos) {
+            res = lfs_file_seek(&_lfs, &h->file, c->pos, LFS_SEEK_SET);
+        }
+        if (res >= 0) {
+            if (len - done >= c->size) {
+                // Reads bigger than the cache go straight into the buffer
+                res = lfs_file_read(&_lfs, &h->file, buf + done, len - done);
+            } else {
+                res = lfs_file_read(&_lfs, &h->file, c->buffer, c->size);
+            }
+        }
+        LFS_INFO("file_read -> %d", lfs_toerror(res));
+        _mutex.unlock();
+
+        if (res <= 0) {
+            break;
+        }
+        if (len - done >= c->size) {
+            c->pos += res;
+            done += res;
+            break;
+        }
+        c->off = c->pos;
+        c->len = res;
+    }
+
+    if (len) {
+        if (missed) {
+            c->misses++;
+        } else {
+            c->hits++;
+        }
+    }
+    c->mutex.unlock();
+
+    if (res < 0) {
+        return lfs_toerror(res);
+    }
+    return done;
+}
+
 ssize_t LittleFileSystem::file_write(fs_file_t file, const void *buffer, size_t len)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_file_t *f = &((lfs_handle_t *)file)->file;
     _mutex.lock();
     LFS_INFO("file_write(%p, %p, %d)", file, buffer, len);
     lfs_ssize_t res = lfs_file_write(&_lfs, f, buffer, len);
@@ -463,7 +718,7 @@ ssize_t LittleFileSystem::file_write(fs_file_t file, const void *buffer, size_t
 
 int LittleFileSystem::file_sync(fs_file_t file)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_file_t *f = &((lfs_handle_t *)file)->file;
     _mutex.lock();
     LFS_INFO("file_sync(%p)", file);
     int err = lfs_file_sync(&_lfs, f);
@@ -474,10 +729,34 @@ int LittleFileSystem::file_sync(fs_file_t file)
 
 off_t LittleFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_handle_t *h = (lfs_handle_t *)file;
+    lfs_file_cache_t *c = h->cache;
+    off_t res;
+    if (c) {
+        // Only moves the cached position, the lfs file follows on the next miss
+        c->mutex.lock();
+        if (whence == SEEK_SET) {
+            res = offset;
+        } else if (whence == SEEK_CUR) {
+            res = c->pos + offset;
+        } else if (whence == SEEK_END) {
+            res = file_size(file) + offset;
+        } else {
+            res = -EINVAL;
+        }
+        if (res > LFS_FILE_MAX) {
+            res = -EFBIG;
+        } else if (res < 0) {
+            res = -EINVAL;
+        } else {
+            c->pos = res;
+        }
+        c->mutex.unlock();
+        return res;
+    }
     _mutex.lock();
     LFS_INFO("file_seek(%p, %ld, %d)", file, offset, whence);
-    off_t res = lfs_file_seek(&_lfs, f, offset, lfs_fromwhence(whence));
+    res = lfs_file_seek(&_lfs, &h->file, offset, lfs_fromwhence(whence));
     LFS_INFO("file_seek -> %d", lfs_toerror(res));
     _mutex.unlock();
     return lfs_toerror(res);
@@ -485,10 +764,16 @@ off_t LittleFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
 
 off_t LittleFileSystem::file_tell(fs_file_t file)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_handle_t *h = (lfs_handle_t *)file;
+    if (h->cache) {
+        h->cache->mutex.lock();
+        off_t pos = h->cache->pos;
+        h->cache->mutex.unlock();
+        return pos;
+    }
     _mutex.lock();
     LFS_INFO("file_tell(%p)", file);
-    off_t res = lfs_file_tell(&_lfs, f);
+    off_t res = lfs_file_tell(&_lfs, &h->file);
     LFS_INFO("file_tell -> %d", lfs_toerror(res));
     _mutex.unlock();
     return lfs_toerror(res);
@@ -496,7 +781,7 @@ off_t LittleFileSystem::file_tell(fs_file_t file)
 
 off_t LittleFileSystem::file_size(fs_file_t file)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_file_t *f = &((lfs_handle_t *)file)->file;
     _mutex.lock();
     LFS_INFO("file_size(%p)", file);
     off_t res = lfs_file_size(&_lfs, f);
@@ -507,7 +792,7 @@ off_t LittleFileSystem::file_size(fs_file_t file)
 
 int LittleFileSystem::file_truncate(fs_file_t file, off_t length)
 {
-    lfs_file_t *f = (lfs_file_t *)file;
+    lfs_file_t *f = &((lfs_handle_t *)file)->file;
     _mutex.lock();
     LFS_INFO("file_truncate(%p)", file);
     int err = lfs_file_truncate(&_lfs, f, length);
@@ -516,6 +801,66 @@ int LittleFileSystem::file_truncate(fs_file_t file, off_t length)
     return lfs_toerror(err);
 }
 
+int LittleFileSystem::file_set_cache(fs_file_t file, size_t size)
+{
+    lfs_handle_t *h = (lfs_handle_t *)file;
+
+    // Writes would have to keep the cache coherent, so only cache read only files
+    if ((h->file.flags & LFS_O_RDWR) != LFS_O_RDONLY) {
+        return -EINVAL;
+    }
+
+    if (!h->cache) {
+        if (!size) {
+            return 0;
+        }
+        _mutex.lock();
+        lfs_soff_t pos = lfs_file_tell(&_lfs, &h->file);
+        _mutex.unlock();
+        h->cache = new lfs_file_cache_t;
+        h->cache->buffer = NULL;
+        h->cache->size = 0;
+        h->cache->pos = pos;
+        h->cache->hits = 0;
+        h->cache->misses = 0;
+    }
+
+    lfs_file_cache_t *c = h->cache;
+    c->mutex.lock();
+    delete[] c->buffer;
+    c->buffer = NULL;
+    c->size = size;
+    c->off = 0;
+    c->len = 0;
+    if (size) {
+        c->buffer = new uint8_t[size];
+        c->mutex.unlock();
+        return 0;
+    }
+
+    // Dropping the cache puts the lfs file back at the cached position
+    _mutex.lock();
+    lfs_soff_t res = lfs_file_seek(&_lfs, &h->file, c->pos, LFS_SEEK_SET);
+    _mutex.unlock();
+    h->cache = NULL;
+    c->mutex.unlock();
+    delete c;
+    return res < 0 ? lfs_toerror(res) : 0;
+}
+
+int LittleFileSystem::file_cache_stats(fs_file_t file, uint32_t *hits, uint32_t *misses)
+{
+    lfs_handle_t *h = (lfs_handle_t *)file;
+    if (!h->cache) {
+        return -EINVAL;
+    }
+    h->cache->mutex.lock();
+    *hits = h->cache->hits;
+    *misses = h->cache->misses;
+    h->cache->mutex.unlock();
+    return 0;
+}
+
 
 ////// Dir operations //////
 int LittleFileSystem::dir_open(fs_dir_t *dir, const char *path)
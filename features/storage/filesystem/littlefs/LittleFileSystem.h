@@ -240,6 +240,25 @@ protected:
      */
     virtual int file_truncate(mbed::fs_file_t file, off_t length);
 
+    /** Set the size of the read cache of a file opened read only.
+     *
+     *  Reads served from the cache only lock the file, not the file system.
+     *
+     *  @param file     File handle.
+     *  @param size     Size of the cache in bytes, 0 to drop it
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_set_cache(mbed::fs_file_t file, size_t size);
+
+    /** Get the read cache statistics of a file.
+     *
+     *  @param file     File handle.
+     *  @param hits     Destination for the number of reads served from the cache
+     *  @param misses   Destination for the number of reads that went to the file system
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int file_cache_stats(mbed::fs_file_t file, uint32_t *hits, uint32_t *misses);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
@@ -289,6 +308,7 @@ private:
     lfs_t _lfs; // The actual file system
     struct lfs_config _config;
     mbed::BlockDevice *_bd; // The block device
+    struct lfs_readahead_t *_readahead; // Readahead of the block device, if enabled
 
     // default parameters
     const lfs_size_t _read_size;
@@ -298,6 +318,9 @@ private:
 
     // thread-safe locking
     PlatformMutex _mutex;
+
+    // file_read() for files with a read cache
+    ssize_t file_read_cached(void *handle, void *buffer, size_t len);
 };
 
 } // namespace mbed
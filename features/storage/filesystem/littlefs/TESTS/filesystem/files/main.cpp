@@ -236,6 +236,65 @@ void test_medium_file_test()
     TEST_ASSERT_EQUAL(0, res);
 }
 
+void test_cached_read_test()
+{
+    int res = bd.init();
+    TEST_ASSERT_EQUAL(0, res);
+
+    {
+        size_t size = 8192;
+        size_t chunk = 29;
+        uint32_t hits, misses;
+        res = fs.mount(&bd);
+        TEST_ASSERT_EQUAL(0, res);
+        res = file[0].open(&fs, "mediumavacado", O_RDONLY);
+        TEST_ASSERT_EQUAL(0, res);
+        res = file[0].set_cache(1024);
+        if (res == -ENOSYS) {
+            file[0].close();
+            fs.unmount();
+            bd.deinit();
+            TEST_IGNORE_MESSAGE("File system has no per file caches");
+        }
+        TEST_ASSERT_EQUAL(0, res);
+
+        for (int pass = 0; pass < 2; pass++) {
+            srand(0);
+            for (size_t i = 0; i < size; i += chunk) {
+                chunk = (chunk < size - i) ? chunk : size - i;
+                res = file[0].read(buffer, chunk);
+                TEST_ASSERT_EQUAL(chunk, res);
+                for (size_t b = 0; b < chunk; b++) {
+                    res = buffer[b];
+                    TEST_ASSERT_EQUAL(rand() & 0xff, res);
+                }
+            }
+            res = file[0].read(buffer, chunk);
+            TEST_ASSERT_EQUAL(0, res);
+            res = file[0].tell();
+            TEST_ASSERT_EQUAL(size, res);
+            file[0].rewind();
+            chunk = 29;
+        }
+
+        // About one miss per cache fill
+        res = file[0].get_cache_stats(&hits, &misses);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_TRUE(misses <= 2 * (size / 1024 + 2));
+        TEST_ASSERT_TRUE(hits > 2 * (size / 29) - misses - 4);
+
+        res = file[0].set_cache(0);
+        TEST_ASSERT_EQUAL(0, res);
+        res = file[0].close();
+        TEST_ASSERT_EQUAL(0, res);
+        res = fs.unmount();
+        TEST_ASSERT_EQUAL(0, res);
+    }
+
+    res = bd.deinit();
+    TEST_ASSERT_EQUAL(0, res);
+}
+
 void test_large_file_test()
 {
     int res = bd.init();
@@ -436,6 +495,7 @@ Case cases[] = {
     Case("Simple file test", test_simple_file_test),
     Case("Small file test", test_small_file_test),
     Case("Medium file test", test_medium_file_test),
+    Case("Cached read test", test_cached_read_test),
     Case("Large file test", test_large_file_test),
     Case("Non-overlap check", test_non_overlap_check),
     Case("Dir check", test_dir_check),
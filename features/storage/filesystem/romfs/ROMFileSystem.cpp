@@ -0,0 +1,380 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "features/storage/filesystem/romfs/ROMFileSystem.h"
+#include <errno.h>
+#include <string.h>
+
+namespace mbed {
+
+// Position in an open file
+struct romfs_file_t {
+    const romfs_entry_t *entry;
+    off_t pos;
+};
+
+// Position in an open directory, whose entries all start with the same prefix
+struct romfs_dir_t {
+    const romfs_entry_t *first;
+    const romfs_entry_t *end;
+    size_t prefix_len;
+    off_t pos;
+};
+
+// Paths are relative to the mount point, leading slashes are ignored
+static const char *skip_slashes(const char *path)
+{
+    while (*path == '/') {
+        path++;
+    }
+    return path;
+}
+
+// Compare a name with the first len characters of path followed by sep
+static int compare(const char *name, const char *path, size_t len, char sep)
+{
+    int res = strncmp(name, path, len);
+    if (res) {
+        return res;
+    }
+    return (unsigned char)name[len] - (unsigned char)sep;
+}
+
+ROMFileSystem::ROMFileSystem(const char *name, const void *image)
+    : FileSystem(name), _image(NULL), _entries(NULL), _count(0)
+{
+    if (image) {
+        mount(image);
+    }
+}
+
+ROMFileSystem::~ROMFileSystem()
+{
+    // nop if unmounted
+    unmount();
+}
+
+int ROMFileSystem::mount(BlockDevice *bd)
+{
+    if (bd) {
+        return -EINVAL;
+    }
+    return _image ? 0 : -EINVAL;
+}
+
+int ROMFileSystem::mount(const void *image)
+{
+    const romfs_header_t *header = static_cast<const romfs_header_t *>(image);
+    if (!header || ((uintptr_t)image & 3) || header->magic != ROMFS_MAGIC || header->size < sizeof(romfs_header_t)
+            || header->count > (header->size - sizeof(romfs_header_t)) / sizeof(romfs_entry_t)) {
+        return -EINVAL;
+    }
+
+    _image = static_cast<const uint8_t *>(image);
+    _entries = reinterpret_cast<const romfs_entry_t *>(header + 1);
+    _count = header->count;
+    return 0;
+}
+
+int ROMFileSystem::unmount()
+{
+    _image = NULL;
+    _entries = NULL;
+    _count = 0;
+    return 0;
+}
+
+int ROMFileSystem::reformat(BlockDevice *bd)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::remove(const char *path)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::rename(const char *path, const char *newpath)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::mkdir(const char *path, mode_t mode)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::stat(const char *path, struct stat *st)
+{
+    if (!_image) {
+        return -EINVAL;
+    }
+
+    memset(st, 0, sizeof(*st));
+    const romfs_entry_t *entry = find(path);
+    if (entry) {
+        st->st_size = entry->size;
+        st->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH;
+        return 0;
+    }
+
+    size_t prefix_len;
+    if (find_dir(path, &prefix_len)) {
+        st->st_mode = S_IFDIR | S_IRUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH;
+        return 0;
+    }
+
+    return -ENOENT;
+}
+
+int ROMFileSystem::statvfs(const char *path, struct statvfs *buf)
+{
+    if (!_image) {
+        return -EINVAL;
+    }
+
+    memset(buf, 0, sizeof(struct statvfs));
+    buf->f_bsize = 1;
+    buf->f_frsize = 1;
+    buf->f_blocks = reinterpret_cast<const romfs_header_t *>(_image)->size;
+    buf->f_namemax = NAME_MAX;
+    return 0;
+}
+
+const char *ROMFileSystem::entry_name(const romfs_entry_t *entry) const
+{
+    return reinterpret_cast<const char *>(_image + entry->name);
+}
+
+const romfs_entry_t *ROMFileSystem::lower_bound(const char *path, size_t len, char sep) const
+{
+    const romfs_entry_t *first = _entries;
+    uint32_t count = _count;
+    while (count > 0) {
+        uint32_t half = count / 2;
+        if (compare(entry_name(&first[half]), path, len, sep) < 0) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+const romfs_entry_t *ROMFileSystem::find(const char *path) const
+{
+    path = skip_slashes(path);
+    size_t len = strlen(path);
+    const romfs_entry_t *entry = lower_bound(path, len, '\0');
+    if (entry == _entries + _count || compare(entry_name(entry), path, len, '\0') != 0) {
+        return NULL;
+    }
+    return entry;
+}
+
+const romfs_entry_t *ROMFileSystem::find_dir(const char *path, size_t *prefix_len) const
+{
+    path = skip_slashes(path);
+    size_t len = strlen(path);
+    while (len > 0 && path[len - 1] == '/') {
+        len--;
+    }
+
+    if (len == 0) {
+        *prefix_len = 0;
+        return _entries;
+    }
+
+    // A directory exists if a file is in it, all such files are together in the index
+    const romfs_entry_t *entry = lower_bound(path, len, '/');
+    if (entry == _entries + _count || strncmp(entry_name(entry), path, len) != 0 || entry_name(entry)[len] != '/') {
+        return NULL;
+    }
+    *prefix_len = len + 1;
+    return entry;
+}
+
+int ROMFileSystem::file_open(fs_file_t *file, const char *path, int flags)
+{
+    if (!_image) {
+        return -EINVAL;
+    }
+
+    if ((flags & O_ACCMODE) != O_RDONLY || (flags & O_TRUNC)) {
+        return -EROFS;
+    }
+
+    const romfs_entry_t *entry = find(path);
+    if (!entry) {
+        size_t prefix_len;
+        if (find_dir(path, &prefix_len)) {
+            return -EISDIR;
+        }
+        return (flags & O_CREAT) ? -EROFS : -ENOENT;
+    }
+
+    romfs_file_t *f = new romfs_file_t;
+    f->entry = entry;
+    f->pos = 0;
+    *file = f;
+    return 0;
+}
+
+int ROMFileSystem::file_close(fs_file_t file)
+{
+    delete static_cast<romfs_file_t *>(file);
+    return 0;
+}
+
+ssize_t ROMFileSystem::file_read(fs_file_t file, void *buffer, size_t size)
+{
+    romfs_file_t *f = static_cast<romfs_file_t *>(file);
+    if (f->pos >= (off_t)f->entry->size) {
+        return 0;
+    }
+
+    if (size > (size_t)(f->entry->size - f->pos)) {
+        size = f->entry->size - f->pos;
+    }
+    memcpy(buffer, _image + f->entry->offset + f->pos, size);
+    f->pos += size;
+    return size;
+}
+
+ssize_t ROMFileSystem::file_write(fs_file_t file, const void *buffer, size_t size)
+{
+    return -EBADF;
+}
+
+off_t ROMFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
+{
+    romfs_file_t *f = static_cast<romfs_file_t *>(file);
+    if (whence == SEEK_CUR) {
+        offset += f->pos;
+    } else if (whence == SEEK_END) {
+        offset += f->entry->size;
+    } else if (whence != SEEK_SET) {
+        return -EINVAL;
+    }
+
+    if (offset < 0) {
+        return -EINVAL;
+    }
+    f->pos = offset;
+    return offset;
+}
+
+off_t ROMFileSystem::file_tell(fs_file_t file)
+{
+    return static_cast<romfs_file_t *>(file)->pos;
+}
+
+off_t ROMFileSystem::file_size(fs_file_t file)
+{
+    return static_cast<romfs_file_t *>(file)->entry->size;
+}
+
+int ROMFileSystem::file_map(fs_file_t file, const void **data)
+{
+    *data = _image + static_cast<romfs_file_t *>(file)->entry->offset;
+    return 0;
+}
+
+int ROMFileSystem::dir_open(fs_dir_t *dir, const char *path)
+{
+    if (!_image) {
+        return -EINVAL;
+    }
+
+    size_t prefix_len;
+    const romfs_entry_t *first = find_dir(path, &prefix_len);
+    if (!first) {
+        return find(path) ? -ENOTDIR : -ENOENT;
+    }
+
+    // The directory ends at the first file that does not share its prefix
+    const romfs_entry_t *end = _entries + _count;
+    if (prefix_len) {
+        end = lower_bound(entry_name(first), prefix_len - 1, '/' + 1);
+    }
+
+    romfs_dir_t *d = new romfs_dir_t;
+    d->first = first;
+    d->end = end;
+    d->prefix_len = prefix_len;
+    d->pos = 0;
+    *dir = d;
+    return 0;
+}
+
+int ROMFileSystem::dir_close(fs_dir_t dir)
+{
+    delete static_cast<romfs_dir_t *>(dir);
+    return 0;
+}
+
+ssize_t ROMFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
+{
+    romfs_dir_t *d = static_cast<romfs_dir_t *>(dir);
+    const romfs_entry_t *entry = d->first + d->pos;
+    if (entry >= d->end) {
+        return 0;
+    }
+
+    const char *name = entry_name(entry) + d->prefix_len;
+    const char *slash = strchr(name, '/');
+    if (!slash) {
+        ent->d_type = DT_REG;
+        strncpy(ent->d_name, name, NAME_MAX);
+        ent->d_name[NAME_MAX] = '\0';
+        d->pos++;
+        return 1;
+    }
+
+    // A subdirectory, listed once for all the files in it
+    size_t len = slash - name;
+    if (len > NAME_MAX) {
+        len = NAME_MAX;
+    }
+    ent->d_type = DT_DIR;
+    memcpy(ent->d_name, name, len);
+    ent->d_name[len] = '\0';
+
+    size_t sub_len = slash - entry_name(entry);
+    do {
+        d->pos++;
+        entry++;
+    } while (entry < d->end && strncmp(entry_name(entry), entry_name(entry - 1), sub_len + 1) == 0);
+    return 1;
+}
+
+void ROMFileSystem::dir_seek(fs_dir_t dir, off_t offset)
+{
+    static_cast<romfs_dir_t *>(dir)->pos = offset;
+}
+
+off_t ROMFileSystem::dir_tell(fs_dir_t dir)
+{
+    return static_cast<romfs_dir_t *>(dir)->pos;
+}
+
+void ROMFileSystem::dir_rewind(fs_dir_t dir)
+{
+    static_cast<romfs_dir_t *>(dir)->pos = 0;
+}
+
+} // namespace mbed
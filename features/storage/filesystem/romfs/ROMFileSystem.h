@@ -0,0 +1,187 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_ROMFILESYSTEM_H
+#define MBED_ROMFILESYSTEM_H
+
+#include <stdint.h>
+#include "features/storage/filesystem/FileSystem.h"
+
+namespace mbed {
+
+/** Magic number at the start of a ROMFileSystem image, "ROM1" */
+#define ROMFS_MAGIC 0x314d4f52
+
+/** Header of a ROMFileSystem image
+ *
+ * The header is followed by an index of @a count entries sorted by name,
+ * then by the names and contents of the files. Offsets are in bytes from the
+ * start of the image, and contents are 4-byte aligned. The image is built by
+ * tools/mkromfs.py.
+ */
+struct romfs_header_t {
+    uint32_t magic;     /**< ROMFS_MAGIC */
+    uint32_t count;     /**< Number of files */
+    uint32_t size;      /**< Size of the whole image */
+};
+
+/** Index entry of a file in a ROMFileSystem image */
+struct romfs_entry_t {
+    uint32_t name;      /**< Offset of the NUL terminated path, without a leading '/' */
+    uint32_t offset;    /**< Offset of the contents */
+    uint32_t size;      /**< Size of the contents */
+};
+
+/**
+ * ROMFileSystem, a read only file system in memory mapped storage
+ *
+ * The file system is an image in storage the CPU can read directly, such as
+ * a region of internal flash or memory mapped QSPI flash, so files are read
+ * straight from it and File::map gives the contents without any copy. Files
+ * are found by a binary search of the image's sorted index, and directories
+ * are implied by the paths of the files.
+ *
+ * @code
+ * // Image written to internal flash, at the start of the second half
+ * ROMFileSystem rom("rom", (const void *)(MBED_ROM_START + MBED_ROM_SIZE / 2));
+ *
+ * File cert;
+ * const void *data;
+ * cert.open(&rom, "certs/ca.pem");
+ * cert.map(&data);
+ * @endcode
+ *
+ * Synchronization level: Thread safe
+ */
+class ROMFileSystem : public mbed::FileSystem {
+public:
+    /** Lifetime of the ROMFileSystem
+     *
+     *  @param name     Name of the file system in the tree.
+     *  @param image    Address of the image. Mounted immediately if not NULL.
+     */
+    ROMFileSystem(const char *name = NULL, const void *image = NULL);
+
+    virtual ~ROMFileSystem();
+
+    /** Mount the file system
+     *
+     *  The image is in memory mapped storage rather than on a block device,
+     *  so this mounts the image given to the constructor.
+     *
+     *  @param bd       Must be NULL.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int mount(mbed::BlockDevice *bd);
+
+    /** Mount the file system from an image
+     *
+     *  @param image    Address of the image.
+     *  @return         0 on success, -EINVAL if there is no valid image at
+     *                  the address, negative error code on failure.
+     */
+    int mount(const void *image);
+
+    /** Unmount the file system
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int unmount();
+
+    /** Images are built offline, so the file system can't be reformatted
+     *
+     *  @return         -EROFS.
+     */
+    virtual int reformat(mbed::BlockDevice *bd);
+
+    /** Files can't be removed from the image
+     *
+     *  @return         -EROFS.
+     */
+    virtual int remove(const char *path);
+
+    /** Files can't be renamed in the image
+     *
+     *  @return         -EROFS.
+     */
+    virtual int rename(const char *path, const char *newpath);
+
+    /** Store information about the file in a stat structure
+     *
+     *  @param path     The name of the file to find information about.
+     *  @param st       The stat buffer to write to.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int stat(const char *path, struct stat *st);
+
+    /** Directories can't be created in the image
+     *
+     *  @return         -EROFS.
+     */
+    virtual int mkdir(const char *path, mode_t mode);
+
+    /** Store information about the mounted file system in a statvfs structure
+     *
+     *  @param path     The name of the file to find information about.
+     *  @param buf      The stat buffer to write to.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int statvfs(const char *path, struct statvfs *buf);
+
+protected:
+#if !(DOXYGEN_ONLY)
+    virtual int file_open(mbed::fs_file_t *file, const char *path, int flags);
+    virtual int file_close(mbed::fs_file_t file);
+    virtual ssize_t file_read(mbed::fs_file_t file, void *buffer, size_t size);
+    virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
+    virtual off_t file_seek(mbed::fs_file_t file, off_t offset, int whence);
+    virtual off_t file_tell(mbed::fs_file_t file);
+    virtual off_t file_size(mbed::fs_file_t file);
+    virtual int file_map(mbed::fs_file_t file, const void **data);
+    virtual int dir_open(mbed::fs_dir_t *dir, const char *path);
+    virtual int dir_close(mbed::fs_dir_t dir);
+    virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ent);
+    virtual void dir_seek(mbed::fs_dir_t dir, off_t offset);
+    virtual off_t dir_tell(mbed::fs_dir_t dir);
+    virtual void dir_rewind(mbed::fs_dir_t dir);
+#endif //!(DOXYGEN_ONLY)
+
+private:
+    const char *entry_name(const romfs_entry_t *entry) const;
+
+    /** Find the first entry whose name is not before the first @p len characters of @p path followed by @p sep */
+    const romfs_entry_t *lower_bound(const char *path, size_t len, char sep) const;
+
+    /** Find a file, NULL if there is none */
+    const romfs_entry_t *find(const char *path) const;
+
+    /** Find the first file in a directory, NULL if there is no such directory */
+    const romfs_entry_t *find_dir(const char *path, size_t *prefix_len) const;
+
+    const uint8_t *_image;
+    const romfs_entry_t *_entries;
+    uint32_t _count;
+};
+
+} // namespace mbed
+
+#endif
+
+/** @}*/
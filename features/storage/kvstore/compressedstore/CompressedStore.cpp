@@ -0,0 +1,682 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ----------------------------------------------------------- Includes -----------------------------------------------------------
+
+#include "CompressedStore.h"
+
+#include "mbed_error.h"
+#include <algorithm>
+#include <new>
+#include <string.h>
+
+using namespace mbed;
+
+// --------------------------------------------------------- Definitions ----------------------------------------------------------
+
+#ifndef MBED_CONF_COMPRESSEDSTORE_MIN_SIZE
+#define MBED_CONF_COMPRESSEDSTORE_MIN_SIZE 32
+#endif
+
+#ifndef MBED_CONF_COMPRESSEDSTORE_READ_CHUNK_SIZE
+#define MBED_CONF_COMPRESSEDSTORE_READ_CHUNK_SIZE 64
+#endif
+
+static const uint16_t record_magic      = 0x5a43; // "CZ"
+static const uint8_t  record_revision   = 1;
+static const uint8_t  compressed_flag   = 1 << 0;
+
+// Codec: a control byte below 0x80 is followed by that number plus one literal bytes, one
+// from 0x80 is a match of ((c >> 2) & 0x1f) + 3 bytes at distance ((c & 3) << 8 | next byte) + 1
+static const uint32_t window_size       = 1024;
+static const uint32_t min_match         = 3;
+static const uint32_t max_match         = 0x1f + min_match;
+static const uint32_t max_literals      = 0x80;
+static const uint32_t hash_bits         = 8;
+
+namespace {
+typedef struct {
+    uint16_t magic;
+    uint8_t  revision;
+    uint8_t  flags;
+    uint32_t data_size;
+} record_header_t;
+
+// iterator handle
+typedef struct {
+    KVStore::iterator_t underlying_it;
+} key_iterator_handle_t;
+
+// Largest output of the codec, one control byte per run of literals is all it can add
+size_t compress_bound(size_t size)
+{
+    return size + size / max_literals + 1;
+}
+
+class Compressor {
+public:
+    // Start compressing a value into the output buffer
+    void start(uint8_t *out, size_t out_size)
+    {
+        memset(_hash, 0, sizeof(_hash));
+        _out = out;
+        _out_size = out_size;
+        _out_len = 0;
+        _pos = 0;
+        _base = 0;
+        _chunk = NULL;
+        _lit_start = 0;
+        _lit_len = 0;
+    }
+
+    // Compress the next part of the input, false if the output doesn't fit
+    bool add(const uint8_t *data, size_t size)
+    {
+        _chunk = data;
+        _base = _pos;
+        size_t i = 0;
+        while (i < size) {
+            uint32_t len = 0;
+            uint32_t dist = 0;
+            if (size - i >= min_match) {
+                // Matches end with the data added, there's no lookahead across calls
+                uint32_t h = hash(&data[i]);
+                dist = (uint16_t)(_pos - _hash[h]);
+                _hash[h] = (uint16_t)_pos;
+                if (dist && dist <= window_size && dist <= _pos) {
+                    uint32_t limit = std::min<size_t>(max_match, size - i);
+                    while (len < limit && byte_at(_pos - dist + len) == data[i + len]) {
+                        len++;
+                    }
+                }
+            }
+
+            if (len >= min_match) {
+                if (!flush_literals() || !emit(0x80 | ((len - min_match) << 2) | ((dist - 1) >> 8))
+                        || !emit((dist - 1) & 0xff)) {
+                    return false;
+                }
+                _pos += len;
+                i += len;
+            } else {
+                if (!_lit_len) {
+                    _lit_start = _pos;
+                }
+                _pos++;
+                i++;
+                if (++_lit_len == max_literals && !flush_literals()) {
+                    return false;
+                }
+            }
+        }
+
+        // Keep the end of the data for the matches and literals of the next part
+        for (size_t j = size - std::min<size_t>(size, window_size); j < size; j++) {
+            _history[(_base + j) % window_size] = data[j];
+        }
+        _base = _pos;
+        return true;
+    }
+
+    // Write the pending literals, false if the output doesn't fit
+    bool finish()
+    {
+        return flush_literals();
+    }
+
+    size_t size() const
+    {
+        return _out_len;
+    }
+
+private:
+    static uint32_t hash(const uint8_t *p)
+    {
+        return ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >> (32 - hash_bits);
+    }
+
+    uint8_t byte_at(uint32_t pos) const
+    {
+        return pos >= _base ? _chunk[pos - _base] : _history[pos % window_size];
+    }
+
+    bool emit(uint8_t byte)
+    {
+        if (_out_len == _out_size) {
+            return false;
+        }
+        _out[_out_len++] = byte;
+        return true;
+    }
+
+    bool flush_literals()
+    {
+        if (!_lit_len) {
+            return true;
+        }
+        if (!emit(_lit_len - 1)) {
+            return false;
+        }
+        for (uint32_t j = 0; j < _lit_len; j++) {
+            if (!emit(byte_at(_lit_start + j))) {
+                return false;
+            }
+        }
+        _lit_len = 0;
+        return true;
+    }
+
+    uint8_t _history[window_size];
+    uint16_t _hash[1 << hash_bits];
+    uint8_t *_out;
+    size_t _out_size;
+    size_t _out_len;
+    uint32_t _pos;
+    uint32_t _base;
+    const uint8_t *_chunk;
+    uint32_t _lit_start;
+    uint32_t _lit_len;
+};
+
+// Decompresses into a window, copying the output from offset into the buffer
+class Decompressor {
+public:
+    Decompressor(uint8_t *window, uint8_t *buffer, size_t offset, size_t size) :
+        _window(window), _buffer(buffer), _offset(offset), _end(offset + size), _pos(0),
+        _literals(0), _match(0), _match_dist_high(0)
+    {
+    }
+
+    // Decompress the next part of the input, false if it's corrupt
+    bool add(const uint8_t *data, size_t size)
+    {
+        for (size_t i = 0; i < size && !done(); i++) {
+            uint8_t c = data[i];
+            if (_literals) {
+                _literals--;
+                output(c);
+            } else if (_match) {
+                uint32_t dist = (_match_dist_high | c) + 1;
+                if (dist > _pos || dist > window_size) {
+                    return false;
+                }
+                for (uint32_t j = 0; j < _match; j++) {
+                    output(_window[(_pos - dist) % window_size]);
+                }
+                _match = 0;
+            } else if (c < 0x80) {
+                _literals = c + 1;
+            } else {
+                _match = ((c >> 2) & 0x1f) + min_match;
+                _match_dist_high = (c & 3) << 8;
+            }
+        }
+        return true;
+    }
+
+    // All of the requested output has been produced
+    bool done() const
+    {
+        return _pos >= _end;
+    }
+
+private:
+    void output(uint8_t byte)
+    {
+        if (_pos >= _offset && _pos < _end) {
+            _buffer[_pos - _offset] = byte;
+        }
+        _window[_pos % window_size] = byte;
+        _pos++;
+    }
+
+    uint8_t *_window;
+    uint8_t *_buffer;
+    size_t _offset;
+    size_t _end;
+    size_t _pos;
+    uint32_t _literals;
+    uint32_t _match;
+    uint32_t _match_dist_high;
+};
+
+}
+
+// incremental set handle
+struct CompressedStore::inc_set_handle_t {
+    record_header_t header;
+    uint32_t create_flags = 0u;
+    uint32_t offset_in_data = 0u;
+    char *key = nullptr;
+    uint8_t *out = nullptr;
+    Compressor compressor;
+};
+
+// -------------------------------------------------- Functions Implementation ----------------------------------------------------
+
+CompressedStore::CompressedStore(KVStore *underlying_kv) :
+    _is_initialized(false), _underlying_kv(underlying_kv), _ih(nullptr), _window(nullptr)
+{
+}
+
+CompressedStore::~CompressedStore()
+{
+    deinit();
+}
+
+int CompressedStore::write_record(const char *key, uint32_t flags, uint32_t data_size,
+                                  const uint8_t *data, size_t stored_size, uint32_t create_flags)
+{
+    record_header_t header;
+    set_handle_t handle;
+    int ret;
+
+    header.magic = record_magic;
+    header.revision = record_revision;
+    header.flags = flags;
+    header.data_size = data_size;
+
+    ret = _underlying_kv->set_start(&handle, key, sizeof(header) + stored_size, create_flags);
+    if (ret) {
+        return ret;
+    }
+
+    ret = _underlying_kv->set_add_data(handle, &header, sizeof(header));
+    if (!ret && stored_size) {
+        ret = _underlying_kv->set_add_data(handle, data, stored_size);
+    }
+    if (ret) {
+        // The underlying KVStore releases the handle on a failed add
+        return ret;
+    }
+
+    return _underlying_kv->set_finalize(handle);
+}
+
+int CompressedStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key) || (!buffer && size)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    const uint8_t *data = static_cast<const uint8_t *>(buffer);
+
+    if (size >= MBED_CONF_COMPRESSEDSTORE_MIN_SIZE) {
+        // Only worth keeping if smaller than the raw value
+        Compressor *compressor = new (std::nothrow) Compressor;
+        uint8_t *out = new (std::nothrow) uint8_t[size - 1];
+        if (compressor && out) {
+            compressor->start(out, size - 1);
+            if (compressor->add(data, size) && compressor->finish()) {
+                ret = write_record(key, compressed_flag, size, out, compressor->size(), create_flags);
+                delete compressor;
+                delete[] out;
+                return ret;
+            }
+        }
+        delete compressor;
+        delete[] out;
+    }
+
+    return write_record(key, 0, size, data, size, create_flags);
+}
+
+int CompressedStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
+                         size_t offset)
+{
+    record_header_t header;
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key) || (!buffer && buffer_size)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    ret = _underlying_kv->get(key, &header, sizeof(header));
+    if (ret) {
+        return ret;
+    }
+
+    if (header.magic != record_magic || header.revision != record_revision) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    if (offset > header.data_size) {
+        return MBED_ERROR_INVALID_SIZE;
+    }
+
+    size_t size = std::min((size_t)header.data_size - offset, buffer_size);
+    if (actual_size) {
+        *actual_size = size;
+    }
+
+    if (!(header.flags & compressed_flag)) {
+        return _underlying_kv->get(key, buffer, size, NULL, sizeof(header) + offset);
+    }
+
+    // Decompress from the start of the value, in chunks, until the requested part is done
+    uint8_t chunk[MBED_CONF_COMPRESSEDSTORE_READ_CHUNK_SIZE];
+    size_t chunk_size;
+    size_t read_offset = sizeof(header);
+
+    _mutex.lock();
+    Decompressor decompressor(_window, static_cast<uint8_t *>(buffer), offset, size);
+    while (!decompressor.done()) {
+        ret = _underlying_kv->get(key, chunk, sizeof(chunk), &chunk_size, read_offset);
+        if (ret) {
+            break;
+        }
+        if (!chunk_size || !decompressor.add(chunk, chunk_size)) {
+            ret = MBED_ERROR_INVALID_DATA_DETECTED;
+            break;
+        }
+        read_offset += chunk_size;
+    }
+    _mutex.unlock();
+
+    return ret;
+}
+
+int CompressedStore::get_info(const char *key, info_t *info)
+{
+    record_header_t header;
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    ret = _underlying_kv->get_info(key, info);
+    if (ret || !info) {
+        return ret;
+    }
+
+    ret = _underlying_kv->get(key, &header, sizeof(header));
+    if (ret) {
+        return ret;
+    }
+
+    if (header.magic != record_magic || header.revision != record_revision) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    info->size = header.data_size;
+    return MBED_SUCCESS;
+}
+
+int CompressedStore::remove(const char *key)
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return _underlying_kv->remove(key);
+}
+
+int CompressedStore::begin_batch()
+{
+    return _underlying_kv->begin_batch();
+}
+
+int CompressedStore::commit_batch()
+{
+    return _underlying_kv->commit_batch();
+}
+
+int CompressedStore::abort_batch()
+{
+    return _underlying_kv->abort_batch();
+}
+
+int CompressedStore::set_start(set_handle_t *handle, const char *key, size_t final_data_size,
+                               uint32_t create_flags)
+{
+    info_t info;
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!is_valid_key(key) || !handle) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock();
+
+    // The underlying set only starts on set_finalize, report protected keys now
+    ret = _underlying_kv->get_info(key, &info);
+    if (ret == MBED_SUCCESS && (info.flags & WRITE_ONCE_FLAG)) {
+        ret = MBED_ERROR_WRITE_PROTECTED;
+        goto fail;
+    } else if (ret != MBED_SUCCESS && ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        goto fail;
+    }
+
+    _ih->out = new (std::nothrow) uint8_t[compress_bound(final_data_size)];
+    _ih->key = new (std::nothrow) char[strlen(key) + 1];
+    if (!_ih->out || !_ih->key) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto fail;
+    }
+    strcpy(_ih->key, key);
+
+    _ih->compressor.start(_ih->out, compress_bound(final_data_size));
+    _ih->header.magic = record_magic;
+    _ih->header.revision = record_revision;
+    _ih->header.flags = compressed_flag;
+    _ih->header.data_size = final_data_size;
+    _ih->create_flags = create_flags;
+    _ih->offset_in_data = 0;
+
+    *handle = reinterpret_cast<set_handle_t>(_ih);
+    return MBED_SUCCESS;
+
+fail:
+    delete[] _ih->out;
+    delete[] _ih->key;
+    _ih->out = nullptr;
+    _ih->key = nullptr;
+    _mutex.unlock();
+    return ret;
+}
+
+int CompressedStore::set_add_data(set_handle_t handle, const void *value_data, size_t data_size)
+{
+    int ret = MBED_SUCCESS;
+
+    if (reinterpret_cast<inc_set_handle_t *>(handle) != _ih) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!value_data && data_size) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!_ih->out) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (_ih->offset_in_data + data_size > _ih->header.data_size) {
+        ret = MBED_ERROR_INVALID_SIZE;
+        goto fail;
+    }
+
+    // Can't run out of room, the buffer is sized for the worst case
+    _ih->compressor.add(static_cast<const uint8_t *>(value_data), data_size);
+    _ih->offset_in_data += data_size;
+    return MBED_SUCCESS;
+
+fail:
+    delete[] _ih->out;
+    delete[] _ih->key;
+    _ih->out = nullptr;
+    _ih->key = nullptr;
+    _mutex.unlock();
+    return ret;
+}
+
+int CompressedStore::set_finalize(set_handle_t handle)
+{
+    int ret;
+
+    if (reinterpret_cast<inc_set_handle_t *>(handle) != _ih) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!_ih->out) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (_ih->offset_in_data != _ih->header.data_size) {
+        ret = MBED_ERROR_INVALID_SIZE;
+    } else {
+        _ih->compressor.finish();
+        ret = write_record(_ih->key, _ih->header.flags, _ih->header.data_size, _ih->out,
+                           _ih->compressor.size(), _ih->create_flags);
+    }
+
+    delete[] _ih->out;
+    delete[] _ih->key;
+    _ih->out = nullptr;
+    _ih->key = nullptr;
+    _mutex.unlock();
+    return ret;
+}
+
+int CompressedStore::init()
+{
+    int ret;
+
+    _mutex.lock();
+
+    if (_is_initialized) {
+        _mutex.unlock();
+        return MBED_SUCCESS;
+    }
+
+    _ih = new inc_set_handle_t;
+    _window = new uint8_t[window_size];
+
+    ret = _underlying_kv->init();
+    if (ret) {
+        delete _ih;
+        delete[] _window;
+        _ih = nullptr;
+        _window = nullptr;
+    } else {
+        _is_initialized = true;
+    }
+
+    _mutex.unlock();
+    return ret;
+}
+
+int CompressedStore::deinit()
+{
+    int ret = MBED_SUCCESS;
+
+    _mutex.lock();
+    if (_is_initialized) {
+        ret = _underlying_kv->deinit();
+        delete _ih;
+        delete[] _window;
+        _ih = nullptr;
+        _window = nullptr;
+        _is_initialized = false;
+    }
+    _mutex.unlock();
+
+    return ret;
+}
+
+int CompressedStore::reset()
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    return _underlying_kv->reset();
+}
+
+int CompressedStore::iterator_open(iterator_t *it, const char *prefix)
+{
+    key_iterator_handle_t *handle;
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!it) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    handle = new key_iterator_handle_t;
+    ret = _underlying_kv->iterator_open(&handle->underlying_it, prefix);
+    if (ret) {
+        delete handle;
+        return ret;
+    }
+
+    *it = reinterpret_cast<iterator_t>(handle);
+    return MBED_SUCCESS;
+}
+
+int CompressedStore::iterator_next(iterator_t it, char *key, size_t key_size)
+{
+    key_iterator_handle_t *handle;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    handle = reinterpret_cast<key_iterator_handle_t *>(it);
+
+    return _underlying_kv->iterator_next(handle->underlying_it, key, key_size);
+}
+
+int CompressedStore::iterator_close(iterator_t it)
+{
+    key_iterator_handle_t *handle;
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    handle = reinterpret_cast<key_iterator_handle_t *>(it);
+
+    ret = _underlying_kv->iterator_close(handle->underlying_it);
+
+    delete handle;
+
+    return ret;
+}
@@ -0,0 +1,270 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_COMPRESSEDSTORE_H
+#define MBED_COMPRESSEDSTORE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "KVStore.h"
+#include "PlatformMutex.h"
+
+namespace mbed {
+
+/** CompressedStore class
+ *
+ *  KVStore wrapper that compresses values on their way to another KVStore,
+ *  so values such as configurations, certificate chains and calibration
+ *  tables take fewer flash writes and garbage collections.
+ *
+ *  Values are compressed with a small LZ77 codec with a 1kB window. Each
+ *  record starts with a header marking whether it's compressed, and set()
+ *  stores values raw when they are small or don't shrink. Incremental sets
+ *  are compressed as the data is added, into a RAM buffer of about the final
+ *  size that is written to the underlying KVStore on set_finalize(). Reads
+ *  decompress from the start of the value up to the requested part, without
+ *  buffering the whole value.
+ */
+class CompressedStore : public KVStore {
+public:
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in]  underlying_kv        KVStore that will hold the data.
+     *
+     * @returns none
+     */
+    CompressedStore(KVStore *underlying_kv);
+
+    /**
+     * @brief Class destructor
+     *
+     * @returns none
+     */
+    virtual ~CompressedStore();
+
+    /**
+     * @brief Initialize CompressedStore class. It will also initialize
+     *        the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int init();
+
+    /**
+     * @brief Deinitialize CompressedStore class, free handles and memory allocations.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int deinit();
+
+    /**
+     * @brief Reset KVStore contents (clear all keys)
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int reset();
+
+    /**
+     * @brief Set one KVStore item, given key and value.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  size                 Value data size.
+     * @param[in]  create_flags         Flag mask, passed to the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags);
+
+    /**
+     * @brief Get one KVStore item, given key.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Offset is beyond the end of the value.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Record was not written by CompressedStore or is corrupt.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
+                    size_t offset = 0);
+
+    /**
+     * @brief Get information of a given key.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] info                 Returned information structure, with the uncompressed size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Record was not written by CompressedStore.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int get_info(const char *key, info_t *info);
+
+    /**
+     * @brief Remove a KVStore item, given key.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int remove(const char *key);
+
+    /**
+     * @brief Start a batch of set and remove operations in the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS on success, or any error from underlying KVStore instance.
+     */
+    virtual int begin_batch();
+
+    /**
+     * @brief Commit the open batch of the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS on success, or any error from underlying KVStore instance.
+     */
+    virtual int commit_batch();
+
+    /**
+     * @brief Discard the open batch of the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS on success, or any error from underlying KVStore instance.
+     */
+    virtual int abort_batch();
+
+    /**
+     * @brief Start an incremental KVStore set sequence. This operation is blocking other operations.
+     *        Any get/set/remove/iterator operation will be blocked until set_finalize is called.
+     *
+     * @param[out] handle               Returned incremental set handle.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  final_data_size      Final value data size.
+     * @param[in]  create_flags         Flag mask, passed to the underlying KVStore.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_WRITE_PROTECTED          Already stored with "write once" flag.
+     *          MBED_ERROR_FAILED_OPERATION         No memory for the compressed data.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags);
+
+    /**
+     * @brief Add data to incremental KVStore set sequence. This operation is blocking other operations.
+     *        Any get/set/remove operation will be blocked until set_finalize will be called.
+     *
+     * @param[in]  handle               Incremental set handle.
+     * @param[in]  value_data           Value data to add.
+     * @param[in]  data_size            Value data size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Data is beyond the final size given to set_start.
+     */
+    virtual int set_add_data(set_handle_t handle, const void *value_data, size_t data_size);
+
+    /**
+     * @brief Finalize an incremental KVStore set sequence, writing the compressed value.
+     *
+     * @param[in]  handle               Incremental set handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Less data was added than the final size given to set_start.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int set_finalize(set_handle_t handle);
+
+    /**
+     * @brief Start an iteration over KVStore keys.
+     *
+     * @param[out] it                   Returned iterator handle.
+     * @param[in]  prefix               Key prefix (null for all keys).
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int iterator_open(iterator_t *it, const char *prefix = NULL);
+
+    /**
+     * @brief Get next key in iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     * @param[in]  key                  Buffer for returned key.
+     * @param[in]  key_size             Key buffer size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No more keys found.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int iterator_next(iterator_t it, char *key, size_t key_size);
+
+    /**
+     * @brief Close iteration.
+     *
+     * @param[in]  it                   Iterator handle.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          or any other error from underlying KVStore instance.
+     */
+    virtual int iterator_close(iterator_t it);
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    // Forward declaration
+    struct inc_set_handle_t;
+
+    PlatformMutex _mutex;
+    bool _is_initialized;
+    KVStore *_underlying_kv;
+    inc_set_handle_t *_ih;
+    uint8_t *_window;
+
+    int write_record(const char *key, uint32_t flags, uint32_t data_size,
+                     const uint8_t *data, size_t stored_size, uint32_t create_flags);
+#endif
+};
+/** @}*/
+
+} // namespace mbed
+
+#endif
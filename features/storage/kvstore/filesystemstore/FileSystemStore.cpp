@@ -34,6 +34,13 @@
 
 #define FSST_DEFAULT_FOLDER_PATH "kvstore" //default FileSystemStore folder path on fs
 
+#define FSST_INDEX_MAGIC 0x46535349 // "FSSI" hex 'magic' signature
+#define FSST_INDEX_SUFFIX ".idx" // key index file, next to the FileSystemStore folder
+
+#ifndef MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+#define MBED_CONF_FILESYSTEMSTORE_KEY_INDEX 0
+#endif
+
 // Only write once flag is supported, other two are kept in storage but ignored
 static const uint32_t supported_flags = mbed::KVStore::WRITE_ONCE_FLAG | mbed::KVStore::REQUIRE_CONFIDENTIALITY_FLAG |
                                         mbed::KVStore::REQUIRE_REPLAY_PROTECTION_FLAG;
@@ -48,8 +55,15 @@ typedef struct {
     uint32_t create_flags;
     size_t data_size;
     File *file_handle;
+    bool new_key;
 } inc_set_handle_t;
 
+// key index file header, followed by the sorted key hashes
+typedef struct {
+    uint32_t magic;
+    uint32_t num_keys;
+} key_index_header_t;
+
 // iterator handle
 typedef struct {
     void *dir_handle;
@@ -60,12 +74,14 @@ typedef struct {
 
 // Local Functions
 static char *string_ndup(const char *src, size_t size);
+static uint32_t key_hash(const char *key);
 
 
 // Class Functions
 FileSystemStore::FileSystemStore(FileSystem *fs) : _fs(fs),
     _is_initialized(false), _cfg_fs_path(NULL), _cfg_fs_path_size(0),
-    _full_path_key(NULL), _cur_inc_data_size(0), _cur_inc_set_handle(NULL)
+    _full_path_key(NULL), _cur_inc_data_size(0), _cur_inc_set_handle(NULL),
+    _key_hashes(NULL), _num_key_hashes(0), _max_key_hashes(0), _key_index_path(NULL), _key_index_saved(false)
 {
 
 }
@@ -106,6 +122,14 @@ int FileSystemStore::init()
         }
     }
 
+#if MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+    delete[] _key_index_path;
+    _key_index_path = new char[_cfg_fs_path_size + sizeof(FSST_INDEX_SUFFIX)];
+    strcpy(_key_index_path, _cfg_fs_path);
+    strcat(_key_index_path, FSST_INDEX_SUFFIX);
+    _load_key_index();
+#endif
+
     _is_initialized = true;
 exit_point:
 
@@ -118,6 +142,17 @@ exit_point:
 int FileSystemStore::deinit()
 {
     _mutex.lock();
+#if MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+    if (_is_initialized) {
+        _save_key_index();
+    }
+#endif
+    delete[] _key_hashes;
+    _key_hashes = NULL;
+    _num_key_hashes = 0;
+    _max_key_hashes = 0;
+    delete[] _key_index_path;
+    _key_index_path = NULL;
     _is_initialized = false;
     delete[] _cfg_fs_path;
     delete[] _full_path_key;
@@ -151,6 +186,9 @@ int FileSystemStore::reset()
 
     kv_dir.close();
 
+    _key_index_changed();
+    _num_key_hashes = 0;
+
 exit_point:
     _mutex.unlock();
     return status;
@@ -313,8 +351,11 @@ int FileSystemStore::remove(const char *key)
     }
     kv_file.close();
 
+    _key_index_changed();
     if (0 != _fs->remove(_full_path_key)) {
         status =  MBED_ERROR_FAILED_OPERATION;
+    } else {
+        _remove_key_hash(key_hash(key));
     }
 
 exit_point:
@@ -330,6 +371,7 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     File *kv_file;
     key_metadata_t key_metadata;
     int key_len = 0;
+    bool new_key;
 
     if (create_flags & ~supported_flags) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -366,7 +408,9 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     if (status != MBED_ERROR_ITEM_NOT_FOUND) {
         kv_file->close();
     }
+    new_key = (status == MBED_ERROR_ITEM_NOT_FOUND);
 
+    _key_index_changed();
     if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
         tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
         status = MBED_ERROR_FAILED_OPERATION ;
@@ -378,6 +422,7 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     set_handle->create_flags = create_flags;
     set_handle->data_size = final_data_size;
     set_handle->file_handle = kv_file;
+    set_handle->new_key = new_key;
     key_len = strlen(key);
     set_handle->key = string_ndup(key, key_len);
     *handle = (set_handle_t)set_handle;
@@ -454,6 +499,11 @@ int FileSystemStore::set_finalize(set_handle_t handle)
                      set_handle->data_size, _full_path_key);
             status = MBED_ERROR_INVALID_SIZE;
             _fs->remove(_full_path_key);
+            if (!set_handle->new_key) {
+                _remove_key_hash(key_hash(set_handle->key));
+            }
+        } else if (set_handle->new_key) {
+            _add_key_hash(key_hash(set_handle->key));
         }
         delete[] set_handle->key;
     }
@@ -602,6 +652,14 @@ int FileSystemStore::_verify_key_file(const char *key, key_metadata_t *key_metad
 
     _build_full_path_key(key);
 
+#if MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+    // Keys missing from the index don't exist, no need to go to the file system
+    if (!_find_key_hash(key_hash(key))) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+        goto exit_point;
+    }
+#endif
+
     if (0 != kv_file->open(_fs, _full_path_key, O_RDONLY)) {
         status = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit_point;
@@ -627,7 +685,151 @@ int FileSystemStore::_build_full_path_key(const char *key_src)
     return 0;
 }
 
+size_t FileSystemStore::_key_hash_index(uint32_t hash)
+{
+    // Hashes are sorted, find the first one that isn't lower
+    size_t low = 0, high = _num_key_hashes;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (_key_hashes[mid] < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool FileSystemStore::_find_key_hash(uint32_t hash)
+{
+    size_t ind = _key_hash_index(hash);
+    return (ind < _num_key_hashes) && (_key_hashes[ind] == hash);
+}
+
+void FileSystemStore::_add_key_hash(uint32_t hash)
+{
+#if MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+    if (_num_key_hashes == _max_key_hashes) {
+        _max_key_hashes = _max_key_hashes ? _max_key_hashes * 2 : 16;
+        uint32_t *new_hashes = new uint32_t[_max_key_hashes];
+        if (_num_key_hashes) {
+            memcpy(new_hashes, _key_hashes, _num_key_hashes * sizeof(uint32_t));
+        }
+        delete[] _key_hashes;
+        _key_hashes = new_hashes;
+    }
+
+    // Colliding keys each keep their own copy of the hash
+    size_t ind = _key_hash_index(hash);
+    memmove(&_key_hashes[ind + 1], &_key_hashes[ind], (_num_key_hashes - ind) * sizeof(uint32_t));
+    _key_hashes[ind] = hash;
+    _num_key_hashes++;
+#endif
+}
+
+void FileSystemStore::_remove_key_hash(uint32_t hash)
+{
+#if MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+    size_t ind = _key_hash_index(hash);
+    if ((ind < _num_key_hashes) && (_key_hashes[ind] == hash)) {
+        _num_key_hashes--;
+        memmove(&_key_hashes[ind], &_key_hashes[ind + 1], (_num_key_hashes - ind) * sizeof(uint32_t));
+    }
+#endif
+}
+
+void FileSystemStore::_key_index_changed()
+{
+#if MBED_CONF_FILESYSTEMSTORE_KEY_INDEX
+    // The saved index no longer matches the folder once it changes, drop it until deinit
+    if (_key_index_saved) {
+        _fs->remove(_key_index_path);
+        _key_index_saved = false;
+    }
+#endif
+}
+
+void FileSystemStore::_load_key_index()
+{
+    File index_file;
+    key_index_header_t header;
+
+    delete[] _key_hashes;
+    _key_hashes = NULL;
+    _num_key_hashes = 0;
+    _max_key_hashes = 0;
+    _key_index_saved = false;
+
+    // The index is only saved by deinit and removed on the first change after init,
+    // so if there is a complete one, it matches the folder
+    if (index_file.open(_fs, _key_index_path, O_RDONLY) == 0) {
+        if ((index_file.read(&header, sizeof(header)) == sizeof(header)) &&
+                (header.magic == FSST_INDEX_MAGIC) &&
+                (index_file.size() == (off_t)(sizeof(header) + header.num_keys * sizeof(uint32_t)))) {
+            _max_key_hashes = header.num_keys ? header.num_keys : 16;
+            _key_hashes = new uint32_t[_max_key_hashes];
+            if (index_file.read(_key_hashes, header.num_keys * sizeof(uint32_t)) ==
+                    (ssize_t)(header.num_keys * sizeof(uint32_t))) {
+                _num_key_hashes = header.num_keys;
+                _key_index_saved = true;
+            }
+        }
+        index_file.close();
+    }
+
+    if (_key_index_saved) {
+        return;
+    }
+
+    // Otherwise rebuild it from the folder
+    tr_info("KV Dir: %s, rebuilding key index", _cfg_fs_path);
+    _num_key_hashes = 0;
+    Dir kv_dir;
+    struct dirent dir_ent;
+    if (kv_dir.open(_fs, _cfg_fs_path) != 0) {
+        return;
+    }
+    while (kv_dir.read(&dir_ent) > 0) {
+        if (dir_ent.d_type == DT_REG) {
+            _add_key_hash(key_hash(dir_ent.d_name));
+        }
+    }
+    kv_dir.close();
+}
+
+void FileSystemStore::_save_key_index()
+{
+    File index_file;
+    key_index_header_t header;
+
+    if (_key_index_saved) {
+        return;
+    }
+
+    // A partly written index fails the size check at init, and is rebuilt
+    if (index_file.open(_fs, _key_index_path, O_WRONLY | O_CREAT | O_TRUNC) == 0) {
+        header.magic = FSST_INDEX_MAGIC;
+        header.num_keys = _num_key_hashes;
+        index_file.write(&header, sizeof(header));
+        if (_num_key_hashes) {
+            index_file.write(_key_hashes, _num_key_hashes * sizeof(uint32_t));
+        }
+        index_file.close();
+        _key_index_saved = true;
+    }
+}
+
 // Local Functions
+static uint32_t key_hash(const char *key)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    while (*key) {
+        hash = (hash ^ (uint8_t) * key++) * 16777619UL;
+    }
+    return hash;
+}
+
 static char *string_ndup(const char *src, size_t size)
 {
     char *string_copy = new char[size + 1];
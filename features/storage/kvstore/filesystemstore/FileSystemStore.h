@@ -253,6 +253,53 @@ private:
      */
     int _verify_key_file(const char *key, key_metadata_t *key_metadata, File *kv_file);
 
+    /**
+     * @brief Find where a key hash is, or would be, in the sorted key index
+     *
+     * @param[in]  hash                 Key hash
+     *
+     * @returns Index of the first hash not lower than the given one
+     */
+    size_t _key_hash_index(uint32_t hash);
+
+    /**
+     * @brief Check whether a key may exist, according to the key index
+     *
+     * @param[in]  hash                 Key hash
+     *
+     * @returns true if some key with this hash exists
+     */
+    bool _find_key_hash(uint32_t hash);
+
+    /**
+     * @brief Add a created key to the key index
+     *
+     * @param[in]  hash                 Key hash
+     */
+    void _add_key_hash(uint32_t hash);
+
+    /**
+     * @brief Remove a deleted key from the key index
+     *
+     * @param[in]  hash                 Key hash
+     */
+    void _remove_key_hash(uint32_t hash);
+
+    /**
+     * @brief Load the key index from its file, or rebuild it from the folder if there is no valid one
+     */
+    void _load_key_index();
+
+    /**
+     * @brief Save the key index to its file, unless it is saved already
+     */
+    void _save_key_index();
+
+    /**
+     * @brief Drop the saved key index, before the folder changes
+     */
+    void _key_index_changed();
+
     FileSystem *_fs;
     PlatformMutex _mutex;
     PlatformMutex _inc_data_add_mutex;
@@ -263,6 +310,11 @@ private:
     char *_full_path_key; /* Full name of Key file currently working on */
     size_t _cur_inc_data_size; /* Amount of data added to Key file so far, during incremental add data */
     set_handle_t _cur_inc_set_handle; /* handle of currently key file under incremental set process */
+    uint32_t *_key_hashes; /* Sorted hashes of all existing keys, when the key index is enabled */
+    size_t _num_key_hashes; /* Number of hashes in the key index */
+    size_t _max_key_hashes; /* Number of hashes the key index has room for */
+    char *_key_index_path; /* Key index file name on FileSystem */
+    bool _key_index_saved; /* Whether the key index file matches the folder */
 #endif
 };
 
@@ -19,9 +19,21 @@
 #include "features/storage/kvstore/kv_map/KVMap.h"
 #include "features/storage/kvstore/include/KVStore.h"
 #include "mbed_error.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include <algorithm>
+#include <string.h>
 
 using namespace mbed;
 
+#ifndef MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+#define MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES 0
+#endif
+
+#ifndef MBED_CONF_KV_GLOBAL_API_CACHE_VALUE_SIZE
+#define MBED_CONF_KV_GLOBAL_API_CACHE_VALUE_SIZE 32
+#endif
+
 // iterator handle
 struct _opaque_kv_key_iterator {
     bool iterator_is_open;
@@ -30,6 +42,113 @@ struct _opaque_kv_key_iterator {
     char *path;
 };
 
+#if MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+// LRU cache of small values, so hot keys don't go through the KVStore (and its crypto, for
+// SecureStore) on every read. Keys stored with KV_REQUIRE_CONFIDENTIALITY_FLAG only get an
+// entry without the value, which saves looking up their flags again.
+struct kv_cache_entry {
+    char *key;
+    uint32_t last_use;
+    size_t size;
+    bool no_value;
+    uint8_t value[MBED_CONF_KV_GLOBAL_API_CACHE_VALUE_SIZE];
+};
+
+static kv_cache_entry cache[MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES];
+static uint32_t cache_tick;
+// Bumped on every invalidation, so a read racing with a write doesn't cache the old value
+static uint32_t cache_generation;
+static SingletonPtr<PlatformMutex> cache_mutex;
+
+static void cache_drop(kv_cache_entry *entry)
+{
+    delete[] entry->key;
+    entry->key = NULL;
+    memset(entry->value, 0, sizeof(entry->value));
+}
+
+static kv_cache_entry *cache_find(const char *full_name_key)
+{
+    for (int i = 0; i < MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES; i++) {
+        if (cache[i].key && !strcmp(cache[i].key, full_name_key)) {
+            return &cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void cache_invalidate(const char *full_name_key)
+{
+    cache_mutex->lock();
+    cache_generation++;
+    for (int i = 0; i < MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES; i++) {
+        // A NULL key drops everything
+        if (cache[i].key && (!full_name_key || !strcmp(cache[i].key, full_name_key))) {
+            cache_drop(&cache[i]);
+        }
+    }
+    cache_mutex->unlock();
+}
+
+// Returns true on a hit. Confidential keys hit without a value, and must be read from the store.
+static bool cache_get(const char *full_name_key, void *buffer, size_t buffer_size, size_t *actual_size,
+                      bool &no_value, uint32_t &generation)
+{
+    cache_mutex->lock();
+    generation = cache_generation;
+    kv_cache_entry *entry = cache_find(full_name_key);
+    if (!entry) {
+        cache_mutex->unlock();
+        return false;
+    }
+
+    entry->last_use = ++cache_tick;
+    no_value = entry->no_value;
+    if (!no_value) {
+        size_t size = std::min(buffer_size, entry->size);
+        memcpy(buffer, entry->value, size);
+        if (actual_size) {
+            *actual_size = size;
+        }
+    }
+    cache_mutex->unlock();
+    return true;
+}
+
+static void cache_put(const char *full_name_key, const void *value, size_t size, bool no_value,
+                      uint32_t generation)
+{
+    cache_mutex->lock();
+    if ((generation != cache_generation) || cache_find(full_name_key)) {
+        cache_mutex->unlock();
+        return;
+    }
+
+    // Take a free entry if there is one, otherwise the least recently used
+    kv_cache_entry *entry = &cache[0];
+    for (int i = 0; i < MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES; i++) {
+        if (!cache[i].key) {
+            entry = &cache[i];
+            break;
+        }
+        if (cache[i].last_use < entry->last_use) {
+            entry = &cache[i];
+        }
+    }
+    cache_drop(entry);
+
+    entry->key = new char[strlen(full_name_key) + 1];
+    strcpy(entry->key, full_name_key);
+    entry->last_use = ++cache_tick;
+    entry->no_value = no_value;
+    entry->size = no_value ? 0 : size;
+    if (!no_value) {
+        memcpy(entry->value, value, size);
+    }
+    cache_mutex->unlock();
+}
+#endif // MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+
 int kv_set(const char *full_name_key, const void *buffer, size_t size, uint32_t create_flags)
 {
     int ret = kv_init_storage_config();
@@ -47,6 +166,11 @@ int kv_set(const char *full_name_key, const void *buffer, size_t size, uint32_t
     }
 
     ret = kv_instance->set(full_name_key + key_index, buffer, size, create_flags & flags_mask);
+
+#if MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+    // After the write, so that a read which got the old value doesn't cache it
+    cache_invalidate(full_name_key);
+#endif
     return ret;
 }
 
@@ -65,7 +189,33 @@ int kv_get(const char *full_name_key, void *buffer, size_t buffer_size, size_t *
         return ret;
     }
 
+#if MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+    bool no_value = false;
+    uint32_t generation;
+    if (cache_get(full_name_key, buffer, buffer_size, actual_size, no_value, generation) && !no_value) {
+        return MBED_SUCCESS;
+    }
+
+    size_t read_size;
+    ret = kv_instance->get(full_name_key + key_index, buffer, buffer_size, &read_size);
+    if (actual_size) {
+        *actual_size = read_size;
+    }
+    if ((ret != MBED_SUCCESS) || no_value || (read_size > MBED_CONF_KV_GLOBAL_API_CACHE_VALUE_SIZE)) {
+        return ret;
+    }
+
+    // Only cache whole values that may stay in RAM
+    KVStore::info_t info;
+    if ((kv_instance->get_info(full_name_key + key_index, &info) == MBED_SUCCESS) &&
+            (info.size == read_size)) {
+        cache_put(full_name_key, buffer, read_size, info.flags & KVStore::REQUIRE_CONFIDENTIALITY_FLAG,
+                  generation);
+    }
+    return ret;
+#else
     return kv_instance->get(full_name_key + key_index, buffer, buffer_size, actual_size);
+#endif
 }
 
 int kv_get_info(const char *full_name_key, kv_info_t *info)
@@ -108,7 +258,12 @@ int kv_remove(const char *full_name_key)
         return ret;
     }
 
-    return kv_instance->remove(full_name_key + key_index);
+    ret = kv_instance->remove(full_name_key + key_index);
+
+#if MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+    cache_invalidate(full_name_key);
+#endif
+    return ret;
 }
 
 int kv_iterator_open(kv_iterator_t *it, const char *full_prefix)
@@ -198,6 +353,10 @@ int kv_reset(const char *kvstore_name)
 
     ret = kv_instance->reset();
 
+#if MBED_CONF_KV_GLOBAL_API_CACHE_ENTRIES
+    cache_invalidate(NULL);
+#endif
+
     return ret;
 
 }
@@ -64,6 +64,11 @@ int kv_set(const char *full_name_key, const void *buffer, size_t size, uint32_t
 /**
  * @brief Get one KVStore item by given key.
  *
+ * If kv-global-api.cache-entries is set, values up to kv-global-api.cache-value-size bytes
+ * are kept in a RAM cache and later reads of them skip the KVStore. kv_set, kv_remove and
+ * kv_reset invalidate the cache. Values stored with KV_REQUIRE_CONFIDENTIALITY_FLAG are
+ * never cached.
+ *
  * @param[in]  full_name_key        /Partition_path/Key. Must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
  * @param[in]  buffer               Value data buffer.
  * @param[in]  buffer_size          Value data buffer size.
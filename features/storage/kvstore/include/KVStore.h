@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "platform/mbed_error.h"
 
 namespace mbed {
 
@@ -127,6 +128,42 @@ public:
      */
     virtual int remove(const char *key) = 0;
 
+    /**
+     * @brief Start a batch of set and remove operations, to be committed atomically.
+     *
+     * Items set or removed by the calling thread until commit_batch() or abort_batch()
+     * take effect together, or not at all if power is lost before the commit completes.
+     * Until then, reads see the values from before the batch. Other threads
+     * accessing the KVStore wait until the batch is closed.
+     *
+     * @returns MBED_SUCCESS on success, MBED_ERROR_UNSUPPORTED if the KVStore doesn't
+     *          support batches, or an error code on failure
+     */
+    virtual int begin_batch()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    /**
+     * @brief Commit the open batch, making all of its operations take effect.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int commit_batch()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    /**
+     * @brief Close the open batch, discarding all of its operations.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int abort_batch()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
 
     /**
      * @brief Start an incremental KVStore set sequence.
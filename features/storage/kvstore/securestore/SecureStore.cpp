@@ -23,7 +23,11 @@
 #include "aes.h"
 #include "cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "entropy.h"
+#if MBED_CONF_MBEDTLS_SHARED_DRBG
+#include "mbed_shared_drbg.h"
+#endif
 #include "DeviceKey.h"
 #include "mbed_assert.h"
 #include "mbed_wait_api.h"
@@ -41,7 +45,15 @@ static const uint32_t securestore_revision = 1;
 static const uint32_t enc_block_size    = 16;
 static const uint32_t cmac_size         = 16;
 static const uint32_t iv_size           = 8;
-static const uint32_t scratch_buf_size  = 256;
+#ifndef MBED_CONF_SECURESTORE_SCRATCH_BUF_SIZE
+#define MBED_CONF_SECURESTORE_SCRATCH_BUF_SIZE 256
+#endif
+
+#ifndef MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_ENTRIES
+#define MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_ENTRIES 4
+#endif
+
+static const uint32_t scratch_buf_size  = MBED_CONF_SECURESTORE_SCRATCH_BUF_SIZE;
 static const uint32_t derived_key_size  = 16;
 
 static const char *const enc_prefix  = "ENC";
@@ -65,6 +77,13 @@ typedef struct {
 
 }
 
+// derived key cache entry, keyed by the derivation salt
+struct SecureStore::derived_key_t {
+    char *salt = nullptr;
+    uint32_t last_use = 0u;
+    uint8_t key[derived_key_size] = { 0u };
+};
+
 // incremental set handle
 struct SecureStore::inc_set_handle_t {
     record_metadata_t metadata;
@@ -80,21 +99,9 @@ struct SecureStore::inc_set_handle_t {
 
 // -------------------------------------------------- Functions Implementation ----------------------------------------------------
 
-int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const char *key,
-                          uint8_t *ctr_buf, uint8_t *salt_buf, int salt_buf_size)
+int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const uint8_t *encrypt_key,
+                          uint8_t *ctr_buf)
 {
-    DeviceKey &devkey = DeviceKey::get_instance();
-    char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t encrypt_key[derived_key_size];
-    strcpy(salt, enc_prefix);
-    int pos = strlen(enc_prefix);
-    strncpy(salt + pos, key, salt_buf_size - pos - 1);
-    salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), encrypt_key,  DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
-
     mbedtls_aes_init(&enc_aes_ctx);
     mbedtls_aes_setkey_enc(&enc_aes_ctx, encrypt_key, enc_block_size * 8);
 
@@ -113,20 +120,9 @@ int encrypt_decrypt_data(mbedtls_aes_context &enc_aes_ctx, const uint8_t *in_buf
                                  stream_block, in_buf, out_buf);
 }
 
-int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const char *key, uint8_t *salt_buf, int salt_buf_size)
+int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const uint8_t *auth_key)
 {
-    DeviceKey &devkey = DeviceKey::get_instance();
-    char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t auth_key[derived_key_size];
-    strcpy(salt, auth_prefix);
-    int pos = strlen(auth_prefix);
-    strncpy(salt + pos, key, salt_buf_size - pos - 1);
-    salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), auth_key, DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
-
+    int os_ret;
     const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
 
     mbedtls_cipher_init(&auth_ctx);
@@ -165,9 +161,59 @@ int cmac_calc_finish(mbedtls_cipher_context_t &auth_ctx, uint8_t *output)
 
 // Class member functions
 
+int SecureStore::derive_key(const char *prefix, const char *key, uint8_t *derived_key)
+{
+    DeviceKey &devkey = DeviceKey::get_instance();
+    char *salt = reinterpret_cast<char *>(_scratch_buf);
+    strcpy(salt, prefix);
+    int pos = strlen(prefix);
+    strncpy(salt + pos, key, scratch_buf_size - pos - 1);
+    _scratch_buf[scratch_buf_size - 1] = 0;
+
+    // Deriving goes through the device key, so keep the results of recent derivations.
+    // Take the matching entry, or else a free one, or else the least recently used.
+    derived_key_t *entry = 0;
+    for (uint32_t i = 0; i < MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_ENTRIES; i++) {
+        derived_key_t *candidate = &_derived_keys[i];
+        if (candidate->salt && !strcmp(candidate->salt, salt)) {
+            candidate->last_use = ++_derived_key_tick;
+            memcpy(derived_key, candidate->key, derived_key_size);
+            return 0;
+        }
+        if (!entry || (entry->salt && (!candidate->salt || (candidate->last_use < entry->last_use)))) {
+            entry = candidate;
+        }
+    }
+
+    int os_ret = devkey.generate_derived_key(_scratch_buf, strlen(salt), derived_key, DEVICE_KEY_16BYTE);
+    if (os_ret || !entry) {
+        return os_ret;
+    }
+
+    delete[] entry->salt;
+    entry->salt = new char[strlen(salt) + 1];
+    strcpy(entry->salt, salt);
+    entry->last_use = ++_derived_key_tick;
+    memcpy(entry->key, derived_key, derived_key_size);
+    return 0;
+}
+
+void SecureStore::clear_derived_keys()
+{
+    if (!_derived_keys) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_ENTRIES; i++) {
+        delete[] _derived_keys[i].salt;
+        _derived_keys[i].salt = nullptr;
+        mbedtls_platform_zeroize(_derived_keys[i].key, derived_key_size);
+    }
+}
+
 SecureStore::SecureStore(KVStore *underlying_kv, KVStore *rbp_kv) :
     _is_initialized(false), _underlying_kv(underlying_kv), _rbp_kv(rbp_kv), _entropy(0),
-    _ih(0), _scratch_buf(0)
+    _ih(0), _scratch_buf(0), _derived_keys(0), _derived_key_tick(0)
 {
 }
 
@@ -183,6 +229,7 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
     int ret, os_ret;
     info_t info;
     bool enc_started = false, auth_started = false;
+    uint8_t derived_key[derived_key_size];
 
     if (!_is_initialized) {
         return MBED_ERROR_NOT_READY;
@@ -239,23 +286,32 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
 
     if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
         // generate a new random iv
+#if MBED_CONF_MBEDTLS_SHARED_DRBG
+        os_ret = mbed_shared_drbg_random(NULL, _ih->metadata.iv, iv_size);
+#else
         os_ret = mbedtls_entropy_func(_entropy, _ih->metadata.iv, iv_size);
+#endif
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
         }
-        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, key, _ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
+        os_ret = derive_key(enc_prefix, key, derived_key);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
         }
+        encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, derived_key, _ih->ctr_buf);
         enc_started = true;
     } else {
         memset(_ih->metadata.iv, 0, iv_size);
     }
 
-    os_ret = cmac_calc_start(_ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = derive_key(auth_prefix, key, derived_key);
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto fail;
+    }
+    os_ret = cmac_calc_start(_ih->auth_ctx, derived_key);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto fail;
@@ -517,6 +573,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     int os_ret, ret;
     bool rbp_key_exists = false;
     uint8_t rbp_cmac[cmac_size];
+    uint8_t derived_key[derived_key_size];
     size_t aes_offs = 0;
     uint32_t data_size;
     uint32_t actual_data_size;
@@ -576,7 +633,12 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
         goto end;
     }
 
-    os_ret = cmac_calc_start(_ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = derive_key(auth_prefix, key, derived_key);
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto end;
+    }
+    os_ret = cmac_calc_start(_ih->auth_ctx, derived_key);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
@@ -596,12 +658,12 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     }
 
     if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
-        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, key, _ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
+        os_ret = derive_key(enc_prefix, key, derived_key);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto end;
         }
+        encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, derived_key, _ih->ctr_buf);
         enc_started = true;
     }
 
@@ -760,6 +822,9 @@ int SecureStore::init()
 
     _scratch_buf = new uint8_t[scratch_buf_size];
     _ih = new inc_set_handle_t;
+#if MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_ENTRIES
+    _derived_keys = new derived_key_t[MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_ENTRIES];
+#endif
 
     ret = _underlying_kv->init();
     if (ret) {
@@ -789,8 +854,11 @@ int SecureStore::deinit()
             mbedtls_entropy_free(_entropy);
             delete _entropy;
             delete _ih;
-            delete _scratch_buf;
+            delete[] _scratch_buf;
             _entropy = nullptr;
+            clear_derived_keys();
+            delete[] _derived_keys;
+            _derived_keys = nullptr;
         }
         ret = _underlying_kv->deinit();
         if (ret) {
@@ -274,6 +274,7 @@ public:
 private:
     // Forward declaration
     struct inc_set_handle_t;
+    struct derived_key_t;
 
     PlatformMutex _mutex;
     bool _is_initialized;
@@ -281,6 +282,26 @@ private:
     mbedtls_entropy_context *_entropy;
     inc_set_handle_t *_ih;
     uint8_t *_scratch_buf;
+    derived_key_t *_derived_keys;
+    uint32_t _derived_key_tick;
+
+    /**
+     * @brief Derive the encryption or authentication key of an item from the device key.
+     *
+     * Recent derivations are cached for the life of the store.
+     *
+     * @param[in]  prefix               Derivation salt prefix.
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] derived_key          Derived key buffer.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int derive_key(const char *prefix, const char *key, uint8_t *derived_key);
+
+    /**
+     * @brief Wipe the derived key cache.
+     */
+    void clear_derived_keys();
 
     /**
      * @brief Actual get function, serving get and get_info APIs.
@@ -31,6 +31,18 @@ using namespace mbed;
 
 // --------------------------------------------------------- Definitions ----------------------------------------------------------
 
+#ifndef MBED_CONF_TDBSTORE_GC_THRESHOLD
+#define MBED_CONF_TDBSTORE_GC_THRESHOLD 25
+#endif
+
+#ifndef MBED_CONF_TDBSTORE_STANDBY_ERASE_UNITS_PER_STEP
+#define MBED_CONF_TDBSTORE_STANDBY_ERASE_UNITS_PER_STEP 1
+#endif
+
+#ifndef MBED_CONF_TDBSTORE_PREFIX_INDEX
+#define MBED_CONF_TDBSTORE_PREFIX_INDEX 1
+#endif
+
 static const uint32_t delete_flag = (1UL << 31);
 static const uint32_t internal_flags = delete_flag;
 // Only write once flag is supported, other two are kept in storage but ignored
@@ -49,19 +61,34 @@ typedef struct {
     uint32_t crc;
 } record_header_t;
 
+// Kept small, as lookups touch one entry per binary search step. Area offsets fit in 32 bits.
 typedef struct {
-    uint32_t  hash;
-    bd_size_t bd_offset;
+    uint32_t hash;
+    uint32_t bd_offset;
 } ram_table_entry_t;
 
 static const char *master_rec_key = "TDBS";
 static const uint32_t tdbstore_magic = 0x54686683;
 static const uint32_t tdbstore_revision = 1;
 
+// RAM table snapshot record. The '/' keeps it apart from any user key, and it is written
+// with the delete flag, so a scan that doesn't know about snapshots just skips it.
+static const char *index_rec_key = "TDBS/IDX";
+
+// Batch marker records, also written with the delete flag. Records between a begin
+// marker and a commit marker only take effect once the commit marker is found.
+static const char *batch_begin_key = "TDBS/BEGIN";
+static const char *batch_commit_key = "TDBS/COMMIT";
+static const char *batch_abort_key = "TDBS/ABORT";
+
+// Pre-erased standby area record, also written with the delete flag. Its data is the
+// offset up to which the standby area has been erased ahead of garbage collection.
+static const char *erased_rec_key = "TDBS/ERASED";
+
 typedef struct {
     uint16_t version;
     uint16_t tdbstore_revision;
-    uint32_t reserved;
+    uint32_t index_offset;    // Offset of the RAM table snapshot, 0 if none
 } master_record_data_t;
 
 typedef enum {
@@ -95,7 +122,8 @@ typedef struct {
 // iterator handle
 typedef struct {
     int iterator_num;
-    uint32_t ram_table_ind;
+    uint32_t ram_table_ind; // Index in the key order table for ordered iterators
+    bool ordered;
     char *prefix;
 } key_iterator_handle_t;
 
@@ -130,7 +158,8 @@ static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data
 TDBStore::TDBStore(BlockDevice *bd) : _ram_table(0), _max_keys(0),
     _num_keys(0), _bd(bd), _buff_bd(0),  _free_space_offset(0), _master_record_offset(0),
     _master_record_size(0), _is_initialized(false), _active_area(0), _active_area_version(0), _size(0),
-    _area_params{}, _prog_size(0), _work_buf(0), _key_buf(0), _inc_set_handle(0)
+    _area_params{}, _erased_offset{}, _prog_size(0), _work_buf(0), _key_buf(0), _inc_set_handle(0), _gc_table(0),
+    _gc_free_space_offset(0), _batch_offset(0), _key_order(0), _order_key_buf(0)
 {
     for (int i = 0; i < _num_areas; i++) {
         _area_params[i] = { 0 };
@@ -361,7 +390,9 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
             // We're on key part. May need to calculate hash or check whether key is the expected one
             if (check_expected_key) {
                 if (memcmp(user_key_ptr, dest_buf, chunk_size)) {
+                    // Not our key, and later reads would overwrite the return code
                     ret = MBED_ERROR_ITEM_NOT_FOUND;
+                    goto end;
                 }
             }
 
@@ -395,6 +426,13 @@ end:
 
 int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
                           uint32_t &ram_table_ind, uint32_t &hash)
+{
+    hash = key_hash(key);
+    return find_hashed_record(area, key, hash, offset, ram_table_ind);
+}
+
+int TDBStore::find_hashed_record(uint8_t area, const char *key, uint32_t hash, uint32_t &offset,
+                                 uint32_t &ram_table_ind)
 {
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
     ram_table_entry_t *entry;
@@ -402,15 +440,20 @@ int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
     uint32_t actual_data_size;
     uint32_t flags, dummy_hash, next_offset;
 
+    // RAM table is sorted by descending hash. Find the first entry whose hash isn't greater than ours.
+    uint32_t low = 0, high = _num_keys;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (ram_table[mid].hash > hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
 
-    hash = calc_crc(initial_crc, strlen(key), key);
-
-    for (ram_table_ind = 0; ram_table_ind < _num_keys; ram_table_ind++) {
+    for (ram_table_ind = low; ram_table_ind < _num_keys; ram_table_ind++) {
         entry = &ram_table[ram_table_ind];
         offset = entry->bd_offset;
-        if (hash < entry->hash)  {
-            continue;
-        }
         if (hash > entry->hash)  {
             return MBED_ERROR_ITEM_NOT_FOUND;
         }
@@ -425,6 +468,11 @@ int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
     return ret;
 }
 
+uint32_t TDBStore::key_hash(const char *key)
+{
+    return calc_crc(initial_crc, strlen(key), key);
+}
+
 uint32_t TDBStore::record_size(const char *key, uint32_t data_size)
 {
     return align_up(sizeof(record_header_t), _prog_size) +
@@ -472,8 +520,12 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
             }
         }
 
-        // If we have no room for the record, perform garbage collection
+        // If we have no room for the record, perform garbage collection.
+        // Finish a running incremental one first, it may already have done most of the work.
         uint32_t rec_size = record_size(key, final_data_size);
+        if ((_free_space_offset + rec_size > _size) && _gc_table) {
+            do_garbage_collection_step(_num_keys);
+        }
         if (_free_space_offset + rec_size > _size) {
             ret = garbage_collection();
             if (ret) {
@@ -609,9 +661,8 @@ int TDBStore::set_finalize(set_handle_t handle)
 {
     int os_ret, ret = MBED_SUCCESS;
     inc_set_handle_t *ih;
-    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    ram_table_entry_t *entry;
     bool need_gc = false;
+    bool in_batch;
     uint32_t actual_data_size, hash, flags, next_offset;
 
     if (handle != _inc_set_handle) {
@@ -639,12 +690,17 @@ int TDBStore::set_finalize(set_handle_t handle)
         goto end;
     }
 
+    // Records of an open batch are synced and added to the RAM table on commit
+    in_batch = _batch_offset && (ih->bd_base_offset != _master_record_offset);
+
     // Need to flush buffered BD as our record is totally written now
-    os_ret = _buff_bd->sync();
-    if (os_ret) {
-        ret = MBED_ERROR_WRITE_FAILED;
-        need_gc = true;
-        goto end;
+    if (!in_batch) {
+        os_ret = _buff_bd->sync();
+        if (os_ret) {
+            ret = MBED_ERROR_WRITE_FAILED;
+            need_gc = true;
+            goto end;
+        }
     }
 
     // In master record case we don't update RAM table
@@ -662,26 +718,9 @@ int TDBStore::set_finalize(set_handle_t handle)
         goto end;
     }
 
-    // Update RAM table
-    if (ih->header.flags & delete_flag) {
-        _num_keys--;
-        if (ih->ram_table_ind < _num_keys) {
-            memmove(&ram_table[ih->ram_table_ind], &ram_table[ih->ram_table_ind + 1],
-                    sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
-        }
-        update_all_iterators(false, ih->ram_table_ind);
-    } else {
-        if (ih->new_key) {
-            if (ih->ram_table_ind < _num_keys) {
-                memmove(&ram_table[ih->ram_table_ind + 1], &ram_table[ih->ram_table_ind],
-                        sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
-            }
-            _num_keys++;
-            update_all_iterators(true, ih->ram_table_ind);
-        }
-        entry = &ram_table[ih->ram_table_ind];
-        entry->hash = ih->hash;
-        entry->bd_offset = ih->bd_base_offset;
+    if (!in_batch) {
+        update_ram_table(ih->ram_table_ind, ih->new_key, ih->header.flags & delete_flag,
+                         ih->hash, ih->bd_base_offset);
     }
 
     _free_space_offset = align_up(ih->bd_curr_offset, _prog_size);
@@ -739,12 +778,174 @@ int TDBStore::remove(const char *key)
     return set(key, 0, 0, delete_flag);
 }
 
+int TDBStore::begin_batch()
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (_batch_offset) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    ret = write_batch_marker(batch_begin_key);
+    if (ret) {
+        _mutex.unlock();
+        return ret;
+    }
+
+    // The marker is the last record, wherever compacting to make room for it left it.
+    // The lock is held until the batch is closed.
+    _batch_offset = _free_space_offset - record_size(batch_begin_key, 0);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::commit_batch()
+{
+    int ret;
+
+    _mutex.lock();
+
+    if (!_batch_offset) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    ret = write_batch_marker(batch_commit_key);
+    if (ret) {
+        _mutex.unlock();
+        return ret;
+    }
+
+    // The batch is on storage, now it can take effect
+    ret = replay_batch(_batch_offset, _free_space_offset - record_size(batch_commit_key, 0));
+    _batch_offset = 0;
+
+    _mutex.unlock();
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::abort_batch()
+{
+    int ret;
+
+    _mutex.lock();
+
+    if (!_batch_offset) {
+        _mutex.unlock();
+        return MBED_ERROR_INVALID_OPERATION;
+    }
+
+    uint32_t next_offset;
+    ret = write_internal_record(_active_area, _free_space_offset, batch_abort_key, 0, 0, next_offset);
+    if (!ret && _buff_bd->sync()) {
+        ret = MBED_ERROR_WRITE_FAILED;
+    }
+    _batch_offset = 0;
+
+    if (ret) {
+        // Compacting leaves the batch records behind, no need for a marker then
+        ret = garbage_collection();
+    } else {
+        _free_space_offset = next_offset;
+    }
+
+    _mutex.unlock();
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::write_batch_marker(const char *key)
+{
+    int ret;
+    uint32_t next_offset;
+
+    if (_free_space_offset + record_size(key, 0) > _size) {
+        ret = garbage_collection();
+        if (ret) {
+            return ret;
+        }
+    }
+
+    ret = write_internal_record(_active_area, _free_space_offset, key, 0, 0, next_offset);
+    if (!ret && _buff_bd->sync()) {
+        ret = MBED_ERROR_WRITE_FAILED;
+    }
+    if (ret) {
+        if (ret != MBED_ERROR_MEDIA_FULL) {
+            garbage_collection();
+        }
+        return ret;
+    }
+
+    _free_space_offset = next_offset;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::copy_batch(uint32_t to_offset, uint32_t &to_next_offset)
+{
+    int ret;
+    uint32_t from_offset = _batch_offset;
+    uint32_t batch_offset = to_offset;
+
+    to_next_offset = to_offset;
+    while (from_offset < _free_space_offset) {
+        ret = copy_record(_active_area, from_offset, to_offset, to_next_offset);
+        if (ret) {
+            return ret;
+        }
+        from_offset += to_next_offset - to_offset;
+        to_offset = to_next_offset;
+    }
+
+    _batch_offset = batch_offset;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::replay_batch(uint32_t from_offset, uint32_t to_offset)
+{
+    int ret;
+    uint32_t actual_data_size, hash, flags, next_offset;
+
+    while (from_offset < to_offset) {
+        ret = read_record(_active_area, from_offset, _key_buf, 0, 0, actual_data_size, 0,
+                          true, false, false, true, hash, flags, next_offset);
+        if (ret) {
+            return ret;
+        }
+
+        // The begin marker is skipped like any other delete of a missing key
+        ret = apply_record(_key_buf, hash, flags, from_offset);
+        if (ret) {
+            return ret;
+        }
+        from_offset = next_offset;
+    }
+    return MBED_SUCCESS;
+}
+
 int TDBStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size, size_t offset)
+{
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    return get_with_hash(key, key_hash(key), buffer, buffer_size, actual_size, offset);
+}
+
+int TDBStore::get_with_hash(const char *key, uint32_t hash, void *buffer, size_t buffer_size,
+                            size_t *actual_size, size_t offset)
 {
     int ret;
     uint32_t actual_data_size;
     uint32_t bd_offset, next_bd_offset;
-    uint32_t flags, hash, ram_table_ind;
+    uint32_t flags, ram_table_ind;
 
     if (!is_valid_key(key)) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -752,7 +953,7 @@ int TDBStore::get(const char *key, void *buffer, size_t buffer_size, size_t *act
 
     _mutex.lock();
 
-    ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
+    ret = find_hashed_record(_active_area, key, hash, bd_offset, ram_table_ind);
 
     if (ret != MBED_SUCCESS) {
         goto end;
@@ -809,13 +1010,14 @@ end:
     return ret;
 }
 
-int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset)
+int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset,
+                                  uint32_t index_offset)
 {
     master_record_data_t master_rec;
 
     master_rec.version = version;
     master_rec.tdbstore_revision = tdbstore_revision;
-    master_rec.reserved = 0;
+    master_rec.index_offset = index_offset;
     next_offset = _master_record_offset + _master_record_size;
     return set(master_rec_key, &master_rec, sizeof(master_rec), 0);
 }
@@ -877,6 +1079,96 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
     return MBED_SUCCESS;
 }
 
+int TDBStore::write_index(uint8_t area, uint32_t offset, uint32_t &next_offset)
+{
+    return write_internal_record(area, offset, index_rec_key, _ram_table,
+                                 _num_keys * sizeof(ram_table_entry_t), next_offset);
+}
+
+int TDBStore::write_internal_record(uint8_t area, uint32_t offset, const char *key,
+                                    const void *data, uint32_t data_size, uint32_t &next_offset)
+{
+    int ret;
+    record_header_t header;
+    uint32_t rec_size = record_size(key, data_size);
+
+    if (offset + rec_size > _size) {
+        return MBED_ERROR_MEDIA_FULL;
+    }
+
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = delete_flag;
+    header.key_size = strlen(key);
+    header.reserved = 0;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, header.key_size, key);
+    header.crc = calc_crc(header.crc, data_size, data);
+
+    ret = check_erase_before_write(area, offset, rec_size);
+    if (ret) {
+        return ret;
+    }
+
+    ret = write_area(area, offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
+
+    uint32_t key_offset = offset + align_up(sizeof(record_header_t), _prog_size);
+    ret = write_area(area, key_offset, header.key_size, key);
+    if (ret) {
+        return ret;
+    }
+
+    if (data_size) {
+        ret = write_area(area, key_offset + header.key_size, data_size, data);
+        if (ret) {
+            return ret;
+        }
+    }
+
+    next_offset = offset + rec_size;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::load_index(uint32_t index_offset, uint32_t &next_offset)
+{
+    int ret;
+    record_header_t header;
+    uint32_t actual_data_size, hash, flags;
+
+    ret = read_area(_active_area, index_offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
+
+    if ((header.magic != tdbstore_magic) || !(header.flags & delete_flag) ||
+            (header.data_size % sizeof(ram_table_entry_t))) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    uint32_t num_keys = header.data_size / sizeof(ram_table_entry_t);
+    if (num_keys > _max_keys) {
+        delete[] (ram_table_entry_t *) _ram_table;
+        _max_keys = num_keys;
+        _ram_table = new ram_table_entry_t[_max_keys];
+    }
+
+    // Reads straight into the RAM table, validating the record CRC
+    ret = read_record(_active_area, index_offset, const_cast<char *>(index_rec_key), _ram_table,
+                      header.data_size, actual_data_size, 0, false, true, true, false,
+                      hash, flags, next_offset);
+    if (ret) {
+        return ret;
+    }
+
+    _num_keys = num_keys;
+    return MBED_SUCCESS;
+}
+
 int TDBStore::garbage_collection()
 {
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
@@ -884,10 +1176,16 @@ int TDBStore::garbage_collection()
     int ret;
     size_t ind;
 
-    // Reset the standby area
-    ret = reset_area(1 - _active_area);
-    if (ret) {
-        return ret;
+    // Start over, as the standby area will be reset
+    abort_garbage_collection_step();
+
+    // Reset the standby area, unless it was erased ahead of time
+    check_standby_erased();
+    if (!_erased_offset[1 - _active_area]) {
+        ret = reset_area(1 - _active_area);
+        if (ret) {
+            return ret;
+        }
     }
 
     to_offset = _master_record_offset + _master_record_size;
@@ -907,15 +1205,33 @@ int TDBStore::garbage_collection()
         to_offset = to_next_offset;
     }
 
+    // Snapshot the RAM table after the records, so the next init doesn't need to scan them
+    uint32_t index_offset = to_next_offset;
+    ret = write_index(1 - _active_area, index_offset, to_next_offset);
+    if (ret == MBED_ERROR_MEDIA_FULL) {
+        index_offset = 0;
+    } else if (ret) {
+        return ret;
+    }
+
+    // Carry over the records of an open batch, they are not in the RAM table yet
+    if (_batch_offset) {
+        ret = copy_batch(to_next_offset, to_next_offset);
+        if (ret) {
+            return ret;
+        }
+    }
+
     to_offset = to_next_offset;
     _free_space_offset = to_next_offset;
 
     // Now we can switch to the new active area
+    _erased_offset[_active_area] = 0;
     _active_area = 1 - _active_area;
 
     // Now write master record, with version incremented by 1.
     _active_area_version++;
-    ret = write_master_record(_active_area, _active_area_version, to_offset);
+    ret = write_master_record(_active_area, _active_area_version, to_offset, index_offset);
     if (ret) {
         return ret;
     }
@@ -924,19 +1240,206 @@ int TDBStore::garbage_collection()
 }
 
 
-int TDBStore::build_ram_table()
+void TDBStore::abort_garbage_collection_step()
+{
+    delete[] _gc_table;
+    _gc_table = 0;
+}
+
+int TDBStore::do_garbage_collection_step(size_t max_records)
 {
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    uint32_t offset, next_offset = 0, dummy;
+    uint32_t to_next_offset;
+    int ret;
+    size_t ind;
+
+    if (!_gc_table) {
+        // Reset the standby area, unless it was erased ahead of time. It has no master
+        // record until the switch, so a power failure before that leaves the active area in use.
+        check_standby_erased();
+        if (!_erased_offset[1 - _active_area]) {
+            ret = reset_area(1 - _active_area);
+            if (ret) {
+                return ret;
+            }
+        }
+        _gc_table = new uint32_t[_max_keys];
+        memset(_gc_table, 0, sizeof(uint32_t) * _max_keys);
+        _gc_free_space_offset = _master_record_offset + _master_record_size;
+    }
+
+    // Copy records that have no up to date copy in the standby area yet
+    for (ind = 0; ind < _num_keys; ind++) {
+        if (_gc_table[ind]) {
+            continue;
+        }
+        if (!max_records) {
+            return MBED_SUCCESS;
+        }
+        ret = copy_record(_active_area, ram_table[ind].bd_offset, _gc_free_space_offset, to_next_offset);
+        if (ret) {
+            // Most likely the standby area filled up with stale copies. Start over next time.
+            abort_garbage_collection_step();
+            return ret;
+        }
+        _gc_table[ind] = _gc_free_space_offset;
+        _gc_free_space_offset = to_next_offset;
+        max_records--;
+    }
+
+    // All records are copied, switch to the standby area
+    for (ind = 0; ind < _num_keys; ind++) {
+        ram_table[ind].bd_offset = _gc_table[ind];
+    }
+    abort_garbage_collection_step();
+
+    uint32_t index_offset = _gc_free_space_offset;
+    ret = write_index(1 - _active_area, index_offset, _gc_free_space_offset);
+    if (ret == MBED_ERROR_MEDIA_FULL) {
+        index_offset = 0;
+    } else if (ret) {
+        return ret;
+    }
+
+    if (_batch_offset) {
+        ret = copy_batch(_gc_free_space_offset, _gc_free_space_offset);
+        if (ret) {
+            return ret;
+        }
+    }
+    _free_space_offset = _gc_free_space_offset;
+
+    _erased_offset[_active_area] = 0;
+    _active_area = 1 - _active_area;
+
+    // Now write master record, with version incremented by 1.
+    _active_area_version++;
+    return write_master_record(_active_area, _active_area_version, _gc_free_space_offset, index_offset);
+}
+
+bool TDBStore::garbage_collection_pending()
+{
+    return _gc_table ||
+           ((_size - _free_space_offset) < (uint64_t) _size * MBED_CONF_TDBSTORE_GC_THRESHOLD / 100);
+}
+
+int TDBStore::garbage_collection_step(size_t max_records)
+{
+    int ret = MBED_SUCCESS;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (garbage_collection_pending()) {
+        ret = do_garbage_collection_step(max_records);
+    } else if (!_batch_offset) {
+        ret = do_standby_erase_step(MBED_CONF_TDBSTORE_STANDBY_ERASE_UNITS_PER_STEP);
+    }
+
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::do_standby_erase_step(size_t max_units)
+{
+    uint8_t area = 1 - _active_area;
+    uint32_t offset = _erased_offset[area];
+    uint32_t offset_from_start, dist, next_offset;
+    int ret;
+
+    if (!max_units || (offset >= _size)) {
+        return MBED_SUCCESS;
+    }
+
+    if (!offset) {
+        // Start with the erase units holding the reserved area and master record,
+        // the same way garbage collection resets the area
+        ret = reset_area(area);
+        if (ret) {
+            return ret;
+        }
+        offset = _master_record_offset + _master_record_size + _prog_size - 1;
+        offset_in_erase_unit(area, offset, offset_from_start, dist);
+        offset += dist;
+        max_units--;
+    }
+
+    for (; max_units && (offset < _size); max_units--) {
+        offset_in_erase_unit(area, offset, offset_from_start, dist);
+        if (erase_erase_unit(area, offset) != MBED_SUCCESS) {
+            return MBED_ERROR_WRITE_FAILED;
+        }
+        offset += dist;
+    }
+    _erased_offset[area] = std::min(offset, (uint32_t) _size);
+
+    // Persist the watermark once the whole area is erased. One record per garbage
+    // collection keeps the cost in the active area low; a reboot before that only
+    // loses the progress, and the units are erased again.
+    if ((_erased_offset[area] < _size) ||
+            (_free_space_offset + record_size(erased_rec_key, sizeof(uint32_t)) > _size)) {
+        return MBED_SUCCESS;
+    }
+
+    ret = write_internal_record(_active_area, _free_space_offset, erased_rec_key, &_erased_offset[area],
+                                sizeof(uint32_t), next_offset);
+    if (!ret && _buff_bd->sync()) {
+        ret = MBED_ERROR_WRITE_FAILED;
+    }
+    if (ret) {
+        garbage_collection();
+        return ret;
+    }
+
+    _free_space_offset = next_offset;
+    return MBED_SUCCESS;
+}
+
+void TDBStore::check_standby_erased()
+{
+    uint8_t area = 1 - _active_area;
+    int erase_val = _buff_bd->get_erase_value();
+    uint8_t blank = (erase_val == -1) ? 0xFF : erase_val;
+
+    if (!_erased_offset[area]) {
+        return;
+    }
+
+    // Garbage collection always writes the first record right after the master record.
+    // Anything there means a collection was interrupted after the area was erased.
+    if (read_area(area, _master_record_offset + _master_record_size, sizeof(record_header_t), _work_buf)) {
+        _erased_offset[area] = 0;
+        return;
+    }
+    for (uint32_t i = 0; i < sizeof(record_header_t); i++) {
+        if (_work_buf[i] != blank) {
+            _erased_offset[area] = 0;
+            return;
+        }
+    }
+}
+
+int TDBStore::build_ram_table(uint32_t index_offset)
+{
+    uint32_t offset, next_offset = 0;
+    uint32_t batch_offset = 0;
     int ret = MBED_SUCCESS;
     uint32_t hash;
     uint32_t flags;
     uint32_t actual_data_size;
-    uint32_t ram_table_ind;
 
     _num_keys = 0;
     offset = _master_record_offset;
 
+    // Start from the snapshot if there is a valid one, otherwise scan everything
+    if (index_offset && (load_index(index_offset, offset) != MBED_SUCCESS)) {
+        _num_keys = 0;
+        offset = _master_record_offset;
+    }
+
     while (offset + sizeof(record_header_t) < _free_space_offset) {
         ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
                           true, false, false, true, hash, flags, next_offset);
@@ -945,47 +1448,232 @@ int TDBStore::build_ram_table()
             goto end;
         }
 
-        ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
-
-        if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
-            goto end;
+        if ((flags & delete_flag) && !strcmp(_key_buf, batch_begin_key)) {
+            batch_offset = offset;
+        } else if ((flags & delete_flag) && !strcmp(_key_buf, batch_commit_key) && batch_offset) {
+            ret = replay_batch(batch_offset, offset);
+            if (ret) {
+                goto end;
+            }
+            batch_offset = 0;
+        } else if ((flags & delete_flag) && !strcmp(_key_buf, batch_abort_key)) {
+            batch_offset = 0;
+        } else if ((flags & delete_flag) && !strcmp(_key_buf, erased_rec_key)) {
+            uint32_t erased;
+            if ((read_record(_active_area, offset, _key_buf, &erased, sizeof(erased), actual_data_size, 0,
+                             false, true, true, false, hash, flags, next_offset) == MBED_SUCCESS) &&
+                    (actual_data_size == sizeof(erased))) {
+                _erased_offset[1 - _active_area] = erased;
+            }
+        } else if (!batch_offset) {
+            ret = apply_record(_key_buf, hash, flags, offset);
+            if (ret) {
+                goto end;
+            }
         }
 
-        uint32_t save_offset = offset;
         offset = next_offset;
+    }
 
-        if (ret == MBED_ERROR_ITEM_NOT_FOUND) {
-            // Key doesn't exist, need to add it to RAM table
-            ret = MBED_SUCCESS;
+end:
+    _free_space_offset = next_offset;
 
-            if (flags & delete_flag) {
-                continue;
-            }
-            if (_num_keys >= _max_keys) {
-                // In order to avoid numerous reallocations of ram table,
-                // Add a chunk of entries now
-                increment_max_keys(reinterpret_cast<void **>(&ram_table));
+    if (batch_offset) {
+        // Power was lost before the batch was committed. Drop its records, and compact
+        // so that they are out of the way of the records written next.
+        _free_space_offset = batch_offset;
+        return garbage_collection();
+    }
+    return ret;
+}
+
+int TDBStore::apply_record(const char *key, uint32_t hash, uint32_t flags, uint32_t bd_offset)
+{
+    uint32_t dummy, ram_table_ind;
+
+    int ret = find_hashed_record(_active_area, key, hash, dummy, ram_table_ind);
+
+    if (ret == MBED_ERROR_ITEM_NOT_FOUND) {
+        // Key doesn't exist, need to add it to RAM table
+        if (flags & delete_flag) {
+            return MBED_SUCCESS;
+        }
+        if (_num_keys >= _max_keys) {
+            increment_max_keys();
+        }
+        update_ram_table(ram_table_ind, true, false, hash, bd_offset);
+        return MBED_SUCCESS;
+    }
+
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    update_ram_table(ram_table_ind, false, flags & delete_flag, hash, bd_offset);
+    return MBED_SUCCESS;
+}
+
+void TDBStore::update_ram_table(uint32_t ram_table_ind, bool new_key, bool deleted, uint32_t hash,
+                                uint32_t bd_offset)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    ram_table_entry_t *entry;
+
+    // Update RAM table, and the incremental GC table alongside it
+    if (deleted) {
+        _num_keys--;
+        if (ram_table_ind < _num_keys) {
+            memmove(&ram_table[ram_table_ind], &ram_table[ram_table_ind + 1],
+                    sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            if (_gc_table) {
+                memmove(&_gc_table[ram_table_ind], &_gc_table[ram_table_ind + 1],
+                        sizeof(uint32_t) * (_num_keys - ram_table_ind));
             }
+        }
+        update_all_iterators(false, ram_table_ind);
+        key_order_remove(ram_table_ind);
+        return;
+    }
+
+    if (new_key) {
+        if (ram_table_ind < _num_keys) {
             memmove(&ram_table[ram_table_ind + 1], &ram_table[ram_table_ind],
                     sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            if (_gc_table) {
+                memmove(&_gc_table[ram_table_ind + 1], &_gc_table[ram_table_ind],
+                        sizeof(uint32_t) * (_num_keys - ram_table_ind));
+            }
+        }
+        _num_keys++;
+        update_all_iterators(true, ram_table_ind);
+    }
+    entry = &ram_table[ram_table_ind];
+    entry->hash = hash;
+    entry->bd_offset = bd_offset;
+    // Any copy in the standby area is now stale
+    if (_gc_table) {
+        _gc_table[ram_table_ind] = 0;
+    }
+    if (new_key) {
+        key_order_insert(ram_table_ind);
+    }
+}
 
-            _num_keys++;
-        } else if (flags & delete_flag) {
-            _num_keys--;
-            memmove(&ram_table[ram_table_ind], &ram_table[ram_table_ind + 1],
-                    sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+int TDBStore::read_key(uint32_t ram_table_ind, char *key)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t actual_data_size, hash, flags, next_offset;
 
-            continue;
+    return read_record(_active_area, ram_table[ram_table_ind].bd_offset, key,
+                       0, 0, actual_data_size, 0, true, false, false, false, hash, flags, next_offset);
+}
+
+int TDBStore::key_order_find(const char *key, uint32_t num_keys, uint32_t &order_ind)
+{
+    uint32_t low = 0, high = num_keys;
+
+    // First key that isn't lower than the given one. Reads a key per step, into the key buffer.
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int ret = read_key(_key_order[mid], _key_buf);
+        if (ret) {
+            return ret;
         }
+        if (strcmp(_key_buf, key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    order_ind = low;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::key_order_add(uint32_t ram_table_ind, uint32_t num_keys)
+{
+    uint32_t order_ind;
 
-        // update record parameters
-        ram_table[ram_table_ind].hash = hash;
-        ram_table[ram_table_ind].bd_offset = save_offset;
+    int ret = read_key(ram_table_ind, _order_key_buf);
+    if (ret) {
+        return ret;
+    }
+    ret = key_order_find(_order_key_buf, num_keys, order_ind);
+    if (ret) {
+        return ret;
     }
 
-end:
-    _free_space_offset = next_offset;
-    return ret;
+    memmove(&_key_order[order_ind + 1], &_key_order[order_ind], sizeof(uint32_t) * (num_keys - order_ind));
+    _key_order[order_ind] = ram_table_ind;
+    update_all_iterators(true, order_ind, true);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::build_key_order()
+{
+    if (_key_order) {
+        return MBED_SUCCESS;
+    }
+
+    _key_order = new uint32_t[_max_keys];
+    _order_key_buf = new char[MAX_KEY_SIZE];
+
+    // Binary insertion, reading about log2(n) keys per key
+    for (uint32_t ind = 0; ind < _num_keys; ind++) {
+        int ret = key_order_add(ind, ind);
+        if (ret) {
+            drop_key_order();
+            return ret;
+        }
+    }
+    return MBED_SUCCESS;
+}
+
+void TDBStore::drop_key_order()
+{
+    delete[] _key_order;
+    _key_order = 0;
+    delete[] _order_key_buf;
+    _order_key_buf = 0;
+}
+
+void TDBStore::key_order_insert(uint32_t ram_table_ind)
+{
+    if (!_key_order) {
+        return;
+    }
+
+    // RAM table entries from the index on have moved up
+    for (uint32_t order_ind = 0; order_ind < _num_keys - 1; order_ind++) {
+        if (_key_order[order_ind] >= ram_table_ind) {
+            _key_order[order_ind]++;
+        }
+    }
+
+    // Failing to read the new key drops the table, it is rebuilt by the next ordered iterator
+    if (key_order_add(ram_table_ind, _num_keys - 1)) {
+        drop_key_order();
+    }
+}
+
+void TDBStore::key_order_remove(uint32_t ram_table_ind)
+{
+    uint32_t order_ind, found = _num_keys;
+
+    if (!_key_order) {
+        return;
+    }
+
+    // RAM table entries after the index have moved down
+    for (order_ind = 0; order_ind <= _num_keys; order_ind++) {
+        if (_key_order[order_ind] == ram_table_ind) {
+            found = order_ind;
+        } else if (_key_order[order_ind] > ram_table_ind) {
+            _key_order[order_ind]--;
+        }
+    }
+
+    memmove(&_key_order[found], &_key_order[found + 1], sizeof(uint32_t) * (_num_keys - found));
+    update_all_iterators(false, found, true);
 }
 
 int TDBStore::increment_max_keys(void **ram_table)
@@ -1002,6 +1690,21 @@ int TDBStore::increment_max_keys(void **ram_table)
     _ram_table = new_ram_table;
     delete[] old_ram_table;
 
+    if (_gc_table) {
+        uint32_t *new_gc_table = new uint32_t[_max_keys];
+        memcpy(new_gc_table, _gc_table, sizeof(uint32_t) * (_max_keys - 1));
+        new_gc_table[_max_keys - 1] = 0;
+        delete[] _gc_table;
+        _gc_table = new_gc_table;
+    }
+
+    if (_key_order) {
+        uint32_t *new_key_order = new uint32_t[_max_keys];
+        memcpy(new_key_order, _key_order, sizeof(uint32_t) * _num_keys);
+        delete[] _key_order;
+        _key_order = new_key_order;
+    }
+
     if (ram_table) {
         *ram_table = _ram_table;
     }
@@ -1018,6 +1721,7 @@ int TDBStore::init()
     uint32_t actual_data_size;
     int ret = MBED_SUCCESS;
     uint16_t versions[_num_areas];
+    uint32_t index_offsets[_num_areas];
 
     _mutex.lock();
 
@@ -1060,6 +1764,8 @@ int TDBStore::init()
     for (uint8_t area = 0; area < _num_areas; area++) {
         area_state[area] = TDBSTORE_AREA_STATE_NONE;
         versions[area] = 0;
+        index_offsets[area] = 0;
+        _erased_offset[area] = 0;
 
         _size = std::min(_size, _area_params[area].size);
 
@@ -1079,6 +1785,7 @@ int TDBStore::init()
         }
 
         versions[area] = master_rec.version;
+        index_offsets[area] = master_rec.index_offset;
 
         area_state[area] = TDBSTORE_AREA_STATE_VALID;
 
@@ -1116,7 +1823,7 @@ int TDBStore::init()
     // Currently set free space offset pointer to the end of free space.
     // Ram table build process needs it, but will update it.
     _free_space_offset = _size;
-    ret = build_ram_table();
+    ret = build_ram_table(index_offsets[_active_area]);
 
     // build_ram_table() scans all keys, until invalid data found.
     // Therefore INVALID_DATA is not considered error.
@@ -1124,12 +1831,17 @@ int TDBStore::init()
         goto fail;
     }
 
+    // Only the standby area watermark is recorded. The active area is erased on demand.
+    _erased_offset[_active_area] = 0;
+    check_standby_erased();
+
 end:
     _is_initialized = true;
     _mutex.unlock();
     return MBED_SUCCESS;
 fail:
-    delete[] ram_table;
+    // The RAM table may have been reallocated while building it
+    delete[] (ram_table_entry_t *) _ram_table;
     delete _buff_bd;
     delete[] _work_buf;
     delete[] _key_buf;
@@ -1154,6 +1866,15 @@ int TDBStore::deinit()
         delete[] ram_table;
         delete[] _work_buf;
         delete[] _key_buf;
+        abort_garbage_collection_step();
+        drop_key_order();
+
+        // An open batch is dropped, along with the lock it holds. Its records are
+        // cleaned up by the next init.
+        if (_batch_offset) {
+            _batch_offset = 0;
+            _mutex.unlock();
+        }
     }
 
     _is_initialized = false;
@@ -1190,8 +1911,16 @@ int TDBStore::reset()
 
     _mutex.lock();
 
+    abort_garbage_collection_step();
+
+    if (_batch_offset) {
+        _batch_offset = 0;
+        _mutex.unlock();
+    }
+
     // Reset both areas
     for (area = 0; area < _num_areas; area++) {
+        _erased_offset[area] = 0;
         ret = check_erase_before_write(area, 0, _master_record_offset + _master_record_size + _prog_size, true);
         if (ret) {
             goto end;
@@ -1203,6 +1932,7 @@ int TDBStore::reset()
     _free_space_offset = _master_record_offset;
     _active_area_version = 1;
     memset(_ram_table, 0, sizeof(ram_table_entry_t) * _max_keys);
+    drop_key_order();
     // Write an initial master record on active area
     ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
 
@@ -1248,6 +1978,19 @@ int TDBStore::iterator_open(iterator_t *it, const char *prefix)
         handle->prefix = 0;
     }
     handle->ram_table_ind = 0;
+    handle->ordered = false;
+
+#if MBED_CONF_TDBSTORE_PREFIX_INDEX
+    // Keys sharing the prefix are next to each other in key order, starting at the first
+    // key not lower than the prefix. Without the key order table, fall back to a full scan.
+    if (handle->prefix && (build_key_order() == MBED_SUCCESS) &&
+            (key_order_find(handle->prefix, _num_keys, handle->ram_table_ind) == MBED_SUCCESS)) {
+        handle->ordered = true;
+    } else {
+        handle->ram_table_ind = 0;
+    }
+#endif
+
     handle->iterator_num = it_num;
     _iterator_table[it_num] = handle;
 
@@ -1273,8 +2016,15 @@ int TDBStore::iterator_next(iterator_t it, char *key, size_t key_size)
 
     ret = MBED_ERROR_ITEM_NOT_FOUND;
 
+    // The key order table was dropped on a read failure, so the iterator lost its place
+    if (handle->ordered && !_key_order) {
+        ret = MBED_ERROR_READ_FAILED;
+        goto end;
+    }
+
     while (ret && (handle->ram_table_ind < _num_keys)) {
-        ret = read_record(_active_area, ram_table[handle->ram_table_ind].bd_offset, _key_buf,
+        ret = read_record(_active_area, ram_table[handle->ordered ? _key_order[handle->ram_table_ind] :
+                                                  handle->ram_table_ind].bd_offset, _key_buf,
                           0, 0, actual_data_size, 0, true, false, false, false, hash, flags, next_offset);
         if (ret) {
             goto end;
@@ -1285,6 +2035,11 @@ int TDBStore::iterator_next(iterator_t it, char *key, size_t key_size)
                 goto end;
             }
             strcpy(key, _key_buf);
+        } else if (handle->ordered) {
+            // Past the keys sharing the prefix
+            handle->ram_table_ind = _num_keys;
+            ret = MBED_ERROR_ITEM_NOT_FOUND;
+            goto end;
         } else {
             ret = MBED_ERROR_ITEM_NOT_FOUND;
         }
@@ -1316,11 +2071,11 @@ int TDBStore::iterator_close(iterator_t it)
     return MBED_SUCCESS;
 }
 
-void TDBStore::update_all_iterators(bool added, uint32_t ram_table_ind)
+void TDBStore::update_all_iterators(bool added, uint32_t ram_table_ind, bool key_order)
 {
     for (int it_num = 0; it_num < _max_open_iterators; it_num++) {
         key_iterator_handle_t *handle = static_cast <key_iterator_handle_t *>(_iterator_table[it_num]);
-        if (!handle) {
+        if (!handle || (handle->ordered != key_order)) {
             continue;
         }
 
@@ -1358,7 +2113,9 @@ int TDBStore::reserved_data_set(const void *reserved_data, size_t reserved_data_
     trailer.crc = calc_crc(initial_crc, reserved_data_buf_size, reserved_data);
 
     // Erase the header of non-active area, just to make sure that we can write to it
-    // In case garbage collection has not yet been run, the area can be un-erased
+    // In case garbage collection has not yet been run, the area can be un-erased.
+    // This also clobbers any records an incremental garbage collection has copied.
+    abort_garbage_collection_step();
     ret = reset_area(1 - _active_area);
     if (ret) {
         goto end;
@@ -1463,14 +2220,14 @@ void TDBStore::offset_in_erase_unit(uint8_t area, uint32_t offset,
 int TDBStore::check_erase_before_write(uint8_t area, uint32_t offset, uint32_t size, bool force_check)
 {
     // In order to save init time, we don't check that the entire area is erased.
-    // Instead, whenever reaching an erase unit start erase it.
+    // Instead, whenever reaching an erase unit start erase it, unless it was erased ahead of time.
     while (size) {
         uint32_t dist, offset_from_start;
         int ret;
         offset_in_erase_unit(area, offset, offset_from_start, dist);
         uint32_t chunk = std::min(size, dist);
 
-        if (offset_from_start == 0 || force_check) {
+        if (force_check || (offset_from_start == 0 && offset >= _erased_offset[area])) {
             ret = erase_erase_unit(area, offset - offset_from_start);
             if (ret != MBED_SUCCESS) {
                 return MBED_ERROR_WRITE_FAILED;
@@ -25,6 +25,10 @@
 #include "PlatformMutex.h"
 #include "mbed_error.h"
 
+#ifndef MBED_CONF_TDBSTORE_GC_RECORDS_PER_STEP
+#define MBED_CONF_TDBSTORE_GC_RECORDS_PER_STEP 4
+#endif
+
 namespace mbed {
 
 /** TDBStore class
@@ -123,6 +127,32 @@ public:
     virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
                     size_t offset = 0);
 
+    /**
+     * @brief Get one TDBStore item by given key, with its hash already calculated.
+     *
+     * Saves hashing the key on every lookup of frequently read keys.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  hash                 Key hash, as returned by key_hash().
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     *
+     * @returns Same as get(). A hash that doesn't match the key gives MBED_ERROR_ITEM_NOT_FOUND.
+     */
+    int get_with_hash(const char *key, uint32_t hash, void *buffer, size_t buffer_size,
+                      size_t *actual_size = NULL, size_t offset = 0);
+
+    /**
+     * @brief Calculate the hash TDBStore uses for a key.
+     *
+     * @param[in]  key                  Key.
+     *
+     * @returns key hash.
+     */
+    static uint32_t key_hash(const char *key);
+
     /**
      * @brief Get information of a given key. The returned info contains size and flags
      *
@@ -154,6 +184,42 @@ public:
      */
     virtual int remove(const char *key);
 
+    /**
+     * @brief Start a batch of set and remove operations, to be committed atomically.
+     *
+     * The batch is appended to the active area as one run of records between a begin and a
+     * commit marker record. On init, records of a batch without a commit marker are dropped.
+     * The calling thread holds TDBStore until the batch is closed, and reads see the values
+     * from before the batch until then. The whole batch must fit in one area.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_OPERATION        A batch is already open.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_MEDIA_FULL               Not enough room on media.
+     */
+    virtual int begin_batch();
+
+    /**
+     * @brief Commit the open batch.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_OPERATION        No batch is open.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media, the batch stays open.
+     *          MBED_ERROR_MEDIA_FULL               Not enough room on media, the batch stays open.
+     */
+    virtual int commit_batch();
+
+    /**
+     * @brief Discard the open batch.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_INVALID_OPERATION        No batch is open.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     */
+    virtual int abort_batch();
+
 
     /**
      * @brief Start an incremental TDBStore set sequence. This operation is blocking other operations.
@@ -280,6 +346,37 @@ public:
     virtual int reserved_data_get(void *reserved_data, size_t reserved_data_buf_size,
                                   size_t *actual_data_size = 0);
 
+    /**
+     * @brief Run a bounded step of incremental garbage collection.
+     *
+     * Once free space in the active area drops below the configured threshold, each call
+     * copies up to max_records live records to the standby area, and the last one switches
+     * areas. Keys set while a collection is running are copied again if needed. This spreads
+     * the cost of compaction, so set() rarely has to collect everything at once.
+     * Until then, each call erases up to MBED_CONF_TDBSTORE_STANDBY_ERASE_UNITS_PER_STEP erase
+     * units of the standby area, so the collection only copies records and doesn't wait on erases.
+     * Call it periodically, for example from an EventQueue:
+     *
+     * @code
+     * queue.call_every(100, &tdb, &TDBStore::garbage_collection_step, 4);
+     * @endcode
+     *
+     * @param[in]  max_records          Maximum number of records to copy.
+     *
+     * @returns MBED_SUCCESS                        Success, or nothing to do.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     */
+    int garbage_collection_step(size_t max_records = MBED_CONF_TDBSTORE_GC_RECORDS_PER_STEP);
+
+    /**
+     * @brief Check whether incremental garbage collection has work to do.
+     *
+     * @returns true if a collection is running or free space is below the threshold.
+     */
+    bool garbage_collection_pending();
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -306,11 +403,21 @@ private:
     uint16_t _active_area_version;
     size_t _size;
     tdbstore_area_data_t _area_params[_num_areas];
+    // Erase units starting below these offsets were erased ahead of time and not written since
+    uint32_t _erased_offset[_num_areas];
     uint32_t _prog_size;
     uint8_t *_work_buf;
     char *_key_buf;
     void *_inc_set_handle;
     void *_iterator_table[_max_open_iterators];
+    // Standby area offsets of copied records during incremental GC, indexed like the RAM table (0 if not copied yet)
+    uint32_t *_gc_table;
+    uint32_t _gc_free_space_offset;
+    // Offset of the begin marker of the open batch, 0 if none
+    uint32_t _batch_offset;
+    // RAM table indices sorted by key, built on the first prefixed iterator_open (0 if not built)
+    uint32_t *_key_order;
+    char *_order_key_buf;
 
     /**
      * @brief Read a block from an area.
@@ -394,10 +501,79 @@ private:
      * @param[in]  area                   Area.
      * @param[in]  version                Area version.
      * @param[out] next_offset            Offset of next record.
+     * @param[in]  index_offset           Offset of the RAM table snapshot, 0 if none.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset,
+                            uint32_t index_offset = 0);
+
+    /**
+     * @brief Write a snapshot of the RAM table as a record, to speed up the next init.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  offset                 Offset of the record in the area.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, MBED_ERROR_MEDIA_FULL if it doesn't fit, other nonzero for failure.
+     */
+    int write_index(uint8_t area, uint32_t offset, uint32_t &next_offset);
+
+    /**
+     * @brief Load the RAM table from a snapshot record.
+     *
+     * @param[in]  index_offset           Offset of the snapshot record in the active area.
+     * @param[out] next_offset            Offset of the record following the snapshot.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int load_index(uint32_t index_offset, uint32_t &next_offset);
+
+    /**
+     * @brief Write a record for TDBStore's own use, with a key no user key can clash with.
+     *
+     * The record has the delete flag set, so it never makes it to the RAM table.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  offset                 Offset of the record in the area.
+     * @param[in]  key                    Key.
+     * @param[in]  data                   Data.
+     * @param[in]  data_size              Data size.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, MBED_ERROR_MEDIA_FULL if it doesn't fit, other nonzero for failure.
+     */
+    int write_internal_record(uint8_t area, uint32_t offset, const char *key,
+                              const void *data, uint32_t data_size, uint32_t &next_offset);
+
+    /**
+     * @brief Append a batch marker record to the active area, garbage collecting first if needed.
+     *
+     * @param[in]  key                    Marker key.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_batch_marker(const char *key);
+
+    /**
+     * @brief Copy the records of the open batch to the standby area.
+     *
+     * @param[in]  to_offset              Offset in the standby area.
+     * @param[out] to_next_offset         Offset of the record following the batch.
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset);
+    int copy_batch(uint32_t to_offset, uint32_t &to_next_offset);
+
+    /**
+     * @brief Apply the records of the active area within a range to the RAM table.
+     *
+     * @param[in]  from_offset            Offset of the first record.
+     * @param[in]  to_offset              Offset past the last record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int replay_batch(uint32_t from_offset, uint32_t to_offset);
 
     /**
      * @brief Copy a record from one area to the opposite one.
@@ -419,6 +595,34 @@ private:
      */
     int garbage_collection();
 
+    /**
+     * @brief Copy records for an incremental garbage collection, switching areas once all are copied.
+     *
+     * @param[in]  max_records            Maximum number of records to copy.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int do_garbage_collection_step(size_t max_records);
+
+    /**
+     * @brief Drop the state of a running incremental garbage collection.
+     */
+    void abort_garbage_collection_step();
+
+    /**
+     * @brief Erase the next erase units of the standby area, ahead of garbage collection.
+     *
+     * @param[in]  max_units              Maximum number of erase units to erase.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int do_standby_erase_step(size_t max_units);
+
+    /**
+     * @brief Drop the standby area watermark if a garbage collection has written to the area since.
+     */
+    void check_standby_erased();
+
     /**
      * @brief Return record size given key and data size.
      *
@@ -442,6 +646,20 @@ private:
      */
     int find_record(uint8_t area, const char *key, uint32_t &offset,
                     uint32_t &ram_table_ind, uint32_t &hash);
+
+    /**
+     * @brief Find a record given key and its hash
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  key                    Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  hash                   Key hash.
+     * @param[out] offset                 Offset of record.
+     * @param[out] ram_table_ind          Index in RAM table (target one if not found).
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int find_hashed_record(uint8_t area, const char *key, uint32_t hash, uint32_t &offset,
+                           uint32_t &ram_table_ind);
     /**
      * @brief Actual logics of get API (also covers all other get APIs).
      *
@@ -473,9 +691,37 @@ private:
     /**
      * @brief Build RAM table and update _free_space_offset (scanning all the records in the area).
      *
+     * If the area has a valid RAM table snapshot, only records written after it are scanned.
+     *
+     * @param[in]  index_offset           Offset of the RAM table snapshot, 0 if none.
+     *
      * @returns 0 for success, nonzero for failure.
      */
-    int build_ram_table();
+    int build_ram_table(uint32_t index_offset);
+
+    /**
+     * @brief Apply a record to the RAM table, adding, updating or deleting its key.
+     *
+     * @param[in]  key                    Record key.
+     * @param[in]  hash                   Key hash.
+     * @param[in]  flags                  Record flags.
+     * @param[in]  bd_offset              Record offset in the active area.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int apply_record(const char *key, uint32_t hash, uint32_t flags, uint32_t bd_offset);
+
+    /**
+     * @brief Update a RAM table entry, along with the incremental GC table and iterators.
+     *
+     * @param[in]  ram_table_ind          RAM table index.
+     * @param[in]  new_key                Whether to insert a new entry at the index.
+     * @param[in]  deleted                Whether to delete the entry at the index.
+     * @param[in]  hash                   Key hash.
+     * @param[in]  bd_offset              Record offset in the active area.
+     */
+    void update_ram_table(uint32_t ram_table_ind, bool new_key, bool deleted, uint32_t hash,
+                          uint32_t bd_offset);
 
     /**
      * @brief Increment maximum number of keys and reallocate RAM table accordingly.
@@ -536,11 +782,70 @@ private:
      * @brief Update all iterators after adding or deleting of keys.
      *
      * @param[in]  added                True if added, false if deleted.
-     * @param[in]  ram_table_ind        RAM table index.
+     * @param[in]  ram_table_ind        RAM table index, or key order table index.
+     * @param[in]  key_order            Whether to update ordered iterators, which walk the key order table.
      *
      * @returns none
      */
-    void update_all_iterators(bool added, uint32_t ram_table_ind);
+    void update_all_iterators(bool added, uint32_t ram_table_ind, bool key_order = false);
+
+    /**
+     * @brief Read the key of a RAM table entry.
+     *
+     * @param[in]  ram_table_ind        RAM table index.
+     * @param[out] key                  Key buffer, of MAX_KEY_SIZE bytes.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int read_key(uint32_t ram_table_ind, char *key);
+
+    /**
+     * @brief Find the first key not lower than the given one in the key order table.
+     *        Uses the key buffer.
+     *
+     * @param[in]  key                  Key.
+     * @param[in]  num_keys             Number of keys in the key order table.
+     * @param[out] order_ind            Key order table index.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int key_order_find(const char *key, uint32_t num_keys, uint32_t &order_ind);
+
+    /**
+     * @brief Insert a RAM table entry in its place in the key order table.
+     *
+     * @param[in]  ram_table_ind        RAM table index.
+     * @param[in]  num_keys             Number of keys in the key order table.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int key_order_add(uint32_t ram_table_ind, uint32_t num_keys);
+
+    /**
+     * @brief Build the key order table, if not built yet.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int build_key_order();
+
+    /**
+     * @brief Free the key order table.
+     */
+    void drop_key_order();
+
+    /**
+     * @brief Update the key order table after a new key was inserted in the RAM table.
+     *
+     * @param[in]  ram_table_ind        RAM table index of the new key.
+     */
+    void key_order_insert(uint32_t ram_table_ind);
+
+    /**
+     * @brief Update the key order table after a key was deleted from the RAM table.
+     *
+     * @param[in]  ram_table_ind        RAM table index of the deleted key.
+     */
+    void key_order_remove(uint32_t ram_table_ind);
 
 #endif
 
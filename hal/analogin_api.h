@@ -33,6 +33,16 @@ extern "C" {
  */
 typedef struct analogin_s analogin_t;
 
+#if DEVICE_ANALOGIN_ASYNCH
+/** Handler called when one half of a stream buffer is full
+ *
+ * @param id      The id given to ::analogin_stream_start
+ * @param samples The half of the buffer that has just been filled
+ * @param count   The number of samples in that half
+ */
+typedef void (*analogin_stream_handler)(uint32_t id, const uint16_t *samples, size_t count);
+#endif
+
 /**
  * \defgroup hal_analogin Analogin hal functions
  *
@@ -43,11 +53,16 @@ typedef struct analogin_s analogin_t;
  * * The function ::analogin_read_u16 reads the value from analogin pin, represented as an unsigned 16bit value [0.0 (GND), MAX_UINT16 (VCC)]
  * * The accuracy of the ADC is +/- 10%
  * * The ADC operations ::analogin_read, ::analogin_read_u16 take less than 20us to complete
+ * * The function ::analogin_stream_start starts conversions triggered at a fixed rate, written to a double buffer without CPU involvement
+ * * The samples written by ::analogin_stream_start use the same representation as ::analogin_read_u16
+ * * The handler given to ::analogin_stream_start is called from interrupt context each time one half of the buffer is full
+ * * The function ::analogin_stream_stop stops the conversions, no handler is called after it returns
  *
  * # Undefined behaviour
  *
  * * ::analogin_init is called with invalid pin (which does not support analog input function)
  * * Calling ::analogin_read, ::analogin_read_u16 before ::analogin_init
+ * * Calling ::analogin_read, ::analogin_read_u16 while a stream started by ::analogin_stream_start is active
  * @{
  */
 
@@ -107,6 +122,31 @@ uint16_t analogin_read_u16(analogin_t *obj);
  */
 const PinMap *analogin_pinmap(void);
 
+#if DEVICE_ANALOGIN_ASYNCH
+/** Start continuous timer-triggered conversions into a double buffer
+ *
+ * Conversions run at sample_rate and fill the buffer from its start,
+ * wrapping back once it is full. The handler is called each time the
+ * first or the second half of the buffer is full, while the other half
+ * is being filled.
+ *
+ * @param obj         The analogin object
+ * @param buffer      The sample buffer, holding 2 * count samples
+ * @param count       The number of samples in each half of the buffer
+ * @param sample_rate The number of conversions per second
+ * @param handler     The handler called when one half of the buffer is full
+ * @param id          The id passed to the handler
+ * @return 0 on success, -1 if the sample rate is not supported
+ */
+int analogin_stream_start(analogin_t *obj, uint16_t *buffer, size_t count, uint32_t sample_rate, analogin_stream_handler handler, uint32_t id);
+
+/** Stop conversions started by ::analogin_stream_start
+ *
+ * @param obj The analogin object
+ */
+void analogin_stream_stop(analogin_t *obj);
+#endif
+
 /**@}*/
 
 #ifdef __cplusplus
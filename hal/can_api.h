@@ -28,6 +28,7 @@
 #include "PinNames.h"
 #include "PeripheralNames.h"
 #include "hal/can_helper.h"
+#include "hal/ticker_api.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -87,6 +88,48 @@ unsigned char can_rderror(can_t *obj);
 unsigned char can_tderror(can_t *obj);
 void          can_monitor(can_t *obj, int silent);
 
+/** Read a message and the time it was received
+ *
+ * Targets which timestamp frames in hardware convert the timestamp
+ * to the time base of the us ticker and store it in timestamp. Other
+ * targets leave timestamp untouched, so the caller should set it to
+ * the current time of the us ticker before the call.
+ *
+ * The default implementation calls can_read().
+ *
+ * @param obj       The CAN object
+ * @param msg       The message read
+ * @param handle    The message filter handle, as passed to can_read()
+ * @param timestamp The time the message was received, in microseconds
+ * @return 1 if a message was read, 0 otherwise
+ */
+int           can_read_timestamp(can_t *obj, CAN_Message *msg, int handle, us_timestamp_t *timestamp);
+
+/** Get the number of acceptance filter banks of the peripheral
+ *
+ * The default implementation returns 0, as only can_filter() is supported.
+ *
+ * @param obj The CAN object
+ * @return Number of filter banks available to can_filter_bank()
+ */
+int           can_filter_bank_count(can_t *obj);
+
+/** Configure or disable an acceptance filter bank
+ *
+ * A message is received if it matches any of the enabled banks. It
+ * matches a bank if its format matches and (message id & mask) equals
+ * (id & mask).
+ *
+ * @param obj    The CAN object
+ * @param bank   The bank to configure, from 0 to can_filter_bank_count() - 1
+ * @param id     The id to filter on
+ * @param mask   The mask applied to the id
+ * @param format The format to filter on, CANAny is not supported by all targets
+ * @param enable 1 to enable the bank, 0 to disable it
+ * @return 1 if the bank was configured, 0 otherwise
+ */
+int           can_filter_bank(can_t *obj, int bank, uint32_t id, uint32_t mask, CANFormat format, int enable);
+
 /** Get the pins that support CAN RD
  *
  * Return a PinMap array of pins that support CAN RD. The
@@ -86,6 +86,8 @@ extern "C" {
  *   data length is equal to 0 - verified by test ::crc_compute_partial_invalid_param_test.
  * * Function hal_crc_get_result() returns the checksum result from the CRC module
  *   - verified by tests ::crc_calc_single_test, ::crc_calc_multi_test, ::crc_reconfigure_test.
+ * * Function hal_crc_compute_partial_asynch() writes data to the CRC module without blocking, and calls
+ *   the handler from interrupt context once the data has been processed.
  *
  * # Undefined behaviour
  *
@@ -221,6 +223,24 @@ void hal_crc_compute_partial(const uint8_t *data, const size_t size);
  */
 uint32_t hal_crc_get_result(void);
 
+#if DEVICE_CRC_ASYNCH
+/** Writes data to the current CRC module without blocking.
+ *
+ * Behaves like hal_crc_compute_partial(), except that the data is fed to
+ * the CRC module by DMA and the function returns immediately. The handler
+ * is called from interrupt context once all the data has been processed,
+ * after which hal_crc_compute_partial() or hal_crc_get_result() can be
+ * called.
+ *
+ * The buffer must stay valid until the handler is called.
+ *
+ * \param data    Input data stream to be written into the CRC calculation
+ * \param size    Size of the data stream in bytes
+ * \param handler Function called when the data has been processed
+ */
+void hal_crc_compute_partial_asynch(const uint8_t *data, const size_t size, void (*handler)(void));
+#endif
+
 /**@}*/
 
 #ifdef __cplusplus
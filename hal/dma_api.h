@@ -21,6 +21,8 @@
 #define MBED_DMA_API_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "device.h"
 
 #define DMA_ERROR_OUT_OF_CHANNELS (-1)
 
@@ -46,6 +48,207 @@ int dma_channel_free(int channelid);
 }
 #endif
 
+#if DEVICE_DMA
+
+/**
+ * \defgroup hal_dma DMA HAL API
+ * Low-level interface to the DMA controller of a target.
+ *
+ * The DMA HAL lets drivers move data between memory and peripherals, or
+ * between two memory areas, without the CPU. A channel is initialized for a
+ * direction and a peripheral request line, then runs transfers described by
+ * chains of descriptors, and reports their progress to a handler called in
+ * interrupt context.
+ *
+ * # Defined behavior
+ * * ::hal_dma_channel_init returns ::DMA_STATUS_OUT_OF_CHANNELS when no
+ * channel able to serve the request is free, the channel must not be used then.
+ * * ::hal_dma_transfer_start returns ::DMA_STATUS_BUSY if a transfer is running
+ * on the channel, and ::DMA_STATUS_NOT_SUPPORTED if the descriptors use a
+ * feature missing from ::hal_dma_get_capabilities.
+ * * Descriptors are processed in order, following their `next` member, and
+ * must stay valid until the transfer completes or is aborted.
+ * * A chain whose last descriptor links back to an earlier one is circular,
+ * it runs until ::hal_dma_transfer_abort is called.
+ * * The handler is called with ::DMA_EVENT_DESCRIPTOR_COMPLETE after each
+ * descriptor if requested in the channel configuration, with
+ * ::DMA_EVENT_HALF_COMPLETE halfway through each descriptor if requested, and
+ * with ::DMA_EVENT_COMPLETE once after the last descriptor of a chain that
+ * is not circular.
+ * * The handler may start a new transfer on its channel.
+ * * ::hal_dma_transfer_abort stops the channel before it returns, no event is
+ * reported for the aborted transfer afterwards.
+ *
+ * # Undefined behavior
+ * * Using a channel that is not initialized, or that was freed.
+ * * Passing buffers that are not aligned to the width of their descriptor.
+ * * Modifying a descriptor or its buffers while the transfer uses them.
+ *
+ * # Notes
+ * * Buffers the DMA writes must not be accessed through the data cache until
+ * the transfer completes, targets with a data cache clean and invalidate
+ * the buffers of a transfer as needed.
+ *
+ * @{
+ */
+
+/**
+ * \defgroup hal_dma_tests DMA HAL tests
+ * Greentea tests for the DMA HAL.
+ *
+ * To run the DMA HAL tests use the command:
+ *
+ *     mbed test -t <toolchain> -m <target> -n tests-mbed_hal-dma
+ *
+ */
+
+/** DMA channel, defined by the target as `struct dma_channel_s` in objects.h */
+typedef struct dma_channel_s dma_channel_t;
+
+/** Status of a DMA operation
+ */
+typedef enum {
+    DMA_STATUS_OK,                  /**< Operation successful */
+    DMA_STATUS_BUSY,                /**< A transfer is running on the channel */
+    DMA_STATUS_NOT_SUPPORTED,       /**< Configuration or descriptor not supported by the target */
+    DMA_STATUS_INVALID_ARGUMENT,    /**< Invalid argument */
+    DMA_STATUS_OUT_OF_CHANNELS      /**< No channel available for the request */
+} dma_status_t;
+
+/** Direction of the transfers of a channel
+ */
+typedef enum {
+    DMA_MEMORY_TO_MEMORY,           /**< Both addresses are memory, transfers run as fast as the bus allows */
+    DMA_MEMORY_TO_PERIPHERAL,       /**< Items are written to a peripheral when it requests them */
+    DMA_PERIPHERAL_TO_MEMORY        /**< Items are read from a peripheral when it requests them */
+} dma_direction_t;
+
+/** Size of the items moved by a descriptor
+ */
+typedef enum {
+    DMA_WIDTH_8BIT = 1,
+    DMA_WIDTH_16BIT = 2,
+    DMA_WIDTH_32BIT = 4
+} dma_width_t;
+
+/** Events reported to the handler of a channel
+ */
+typedef enum {
+    DMA_EVENT_COMPLETE = (1 << 0),              /**< The last descriptor of the chain completed */
+    DMA_EVENT_DESCRIPTOR_COMPLETE = (1 << 1),   /**< A descriptor completed */
+    DMA_EVENT_HALF_COMPLETE = (1 << 2),         /**< Half of the items of a descriptor were moved */
+    DMA_EVENT_ERROR = (1 << 3)                  /**< Bus error, the transfer stopped */
+} dma_event_t;
+
+/** Transfer descriptor
+ *
+ * Moves `count` items of `width` bytes from `src` to `dst`. Peripheral
+ * addresses are usually not incremented.
+ */
+typedef struct dma_descriptor_s {
+    const volatile void *src;               /**< Source address */
+    volatile void *dst;                     /**< Destination address */
+    uint32_t count;                         /**< Number of items to move, from 1 to max_count */
+    dma_width_t width;                      /**< Size of each item */
+    bool src_increment;                     /**< Increment the source address after each item */
+    bool dst_increment;                     /**< Increment the destination address after each item */
+    const struct dma_descriptor_s *next;    /**< Next descriptor, NULL for the last one */
+} dma_descriptor_t;
+
+/** Channel configuration
+ */
+typedef struct {
+    dma_direction_t direction;  /**< Direction of the transfers */
+    uint32_t request;           /**< Target specific peripheral request, ignored for ::DMA_MEMORY_TO_MEMORY */
+    uint8_t priority;           /**< Priority among channels, 0 is the lowest, clamped to the highest supported */
+    uint32_t events;            /**< Mask of ::dma_event_t to report, ::DMA_EVENT_COMPLETE and ::DMA_EVENT_ERROR are always reported */
+} dma_config_t;
+
+/** DMA capabilities of a target
+ */
+typedef struct {
+    uint8_t channels;           /**< Number of channels */
+    uint32_t max_count;         /**< Largest count of a descriptor */
+    uint8_t widths;             /**< Mask of the supported ::dma_width_t values */
+    bool memory_to_memory;      /**< ::DMA_MEMORY_TO_MEMORY transfers are supported */
+    bool linked;                /**< Chains of more than one descriptor are supported */
+    bool circular;              /**< Circular chains are supported */
+} dma_capabilities_t;
+
+/** Handler of the events of a channel, called in interrupt context
+ *
+ * @param channel   Channel the events occurred on
+ * @param events    Mask of ::dma_event_t
+ * @param context   Context given to ::hal_dma_channel_init
+ */
+typedef void (*dma_handler_t)(dma_channel_t *channel, uint32_t events, void *context);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Get the DMA capabilities of the target
+ *
+ * @param[out] capabilities     Capabilities of the target
+ */
+void hal_dma_get_capabilities(dma_capabilities_t *capabilities);
+
+/** Allocate and configure a channel
+ *
+ * The target picks a channel, or a stream and channel, able to serve
+ * `config->request`, and routes the request to it.
+ *
+ * @param channel   Channel to initialize
+ * @param config    Configuration of the channel
+ * @param handler   Handler of the events of the channel, may be NULL
+ * @param context   Context passed to the handler
+ * @return ::DMA_STATUS_OK if the channel is ready, ::DMA_STATUS_OUT_OF_CHANNELS
+ *         if no channel is free, ::DMA_STATUS_NOT_SUPPORTED if the
+ *         direction or request is not supported
+ */
+dma_status_t hal_dma_channel_init(dma_channel_t *channel, const dma_config_t *config,
+                                  dma_handler_t handler, void *context);
+
+/** Abort any transfer and release a channel
+ *
+ * @param channel   Channel to release
+ */
+void hal_dma_channel_free(dma_channel_t *channel);
+
+/** Start a transfer
+ *
+ * @param channel       Initialized channel
+ * @param descriptor    First descriptor of the chain
+ * @return ::DMA_STATUS_OK if the transfer started, ::DMA_STATUS_BUSY if a
+ *         transfer is running, ::DMA_STATUS_NOT_SUPPORTED if the chain uses
+ *         a feature the target lacks, ::DMA_STATUS_INVALID_ARGUMENT if a
+ *         descriptor is invalid
+ */
+dma_status_t hal_dma_transfer_start(dma_channel_t *channel, const dma_descriptor_t *descriptor);
+
+/** Check if a transfer is running
+ *
+ * @param channel   Initialized channel
+ * @return true if a transfer is running
+ */
+bool hal_dma_transfer_busy(dma_channel_t *channel);
+
+/** Stop the running transfer
+ *
+ * @param channel   Initialized channel
+ * @return Number of items of the current descriptor that were not moved,
+ *         0 if no transfer was running
+ */
+uint32_t hal_dma_transfer_abort(dma_channel_t *channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif // DEVICE_DMA
+
 #endif
 
 /** @}*/
@@ -125,6 +125,43 @@ uint32_t flash_get_size(const flash_t *obj);
  */
 uint8_t flash_get_erase_value(const flash_t *obj);
 
+#if DEVICE_FLASH_ASYNCH
+
+/** Handler called when an asynchronous flash operation completes
+ * @param id     The id given when the operation was started
+ * @param status 0 for success, -1 for error
+ */
+typedef void (*flash_async_handler_t)(uint32_t id, int32_t status);
+
+/** Start erasing one sector starting at defined address
+ * The address should be at sector boundary. This function does not do any check for address alignments.
+ * It returns once the erase is started, and the flash controller interrupt calls the handler when it completes.
+ * The handler may start the next operation.
+ * @param obj The flash object
+ * @param address The sector starting address
+ * @param handler The function to call on completion, from interrupt context
+ * @param id The id to pass to the handler
+ * @return 0 if the erase was started, -1 for error, in which case the handler is not called
+ */
+int32_t flash_erase_sector_async(flash_t *obj, uint32_t address, flash_async_handler_t handler, uint32_t id);
+
+/** Start programming pages starting at defined address
+ * The pages should not cross multiple sectors.
+ * This function does not do any check for address alignments or if size is aligned to a page size.
+ * It returns once programming is started, and the flash controller interrupt calls the handler when it completes.
+ * The data buffer must stay valid until then. The handler may start the next operation.
+ * @param obj The flash object
+ * @param address The sector starting address
+ * @param data The data buffer to be programmed
+ * @param size The number of bytes to program
+ * @param handler The function to call on completion, from interrupt context
+ * @param id The id to pass to the handler
+ * @return 0 if programming was started, -1 for error, in which case the handler is not called
+ */
+int32_t flash_program_page_async(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size, flash_async_handler_t handler, uint32_t id);
+
+#endif
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,110 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_GPIO_FAST_API_H
+#define MBED_GPIO_FAST_API_H
+
+#include "device.h"
+#include "hal/gpio_api.h"
+#include "hal/port_api.h"
+
+/**
+ * \defgroup hal_gpio_fast Fast GPIO HAL functions
+ *
+ * Pin and port accessors the drivers call on their hot path. A target whose
+ * GPIO block has set, clear and input registers defines GPIO_FAST_API_PRESENT
+ * in its gpio_object.h and implements the functions below as static inline
+ * functions there, so a write compiles to a single store. Other targets get
+ * the versions below, which call the regular GPIO and port HAL.
+ *
+ * # Defined behavior
+ * * ::gpio_write_fast sets the output value like ::gpio_write
+ * * ::gpio_read_fast reads the input value like ::gpio_read
+ * * ::port_write_fast sets the pins in the port mask like ::port_write, without
+ *   changing the other pins of the port
+ * * ::port_read_fast reads the pins in the port mask like ::port_read
+ * * The functions are safe to call from interrupt context
+ *
+ * # Undefined behavior
+ * * Calling any of the functions on an object that was initialized with NC
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !defined(GPIO_FAST_API_PRESENT)
+
+/** Set the output value
+ *
+ * @param obj   The GPIO object (must be connected)
+ * @param value The value to be set
+ */
+static inline void gpio_write_fast(gpio_t *obj, int value)
+{
+    gpio_write(obj, value);
+}
+
+/** Read the input value
+ *
+ * @param obj The GPIO object (must be connected)
+ * @return An integer value 1 or 0
+ */
+static inline int gpio_read_fast(gpio_t *obj)
+{
+    return gpio_read(obj);
+}
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+/** Write value to the port
+ *
+ * @param obj   The port object
+ * @param value The value to be set
+ */
+static inline void port_write_fast(port_t *obj, int value)
+{
+    port_write(obj, value);
+}
+
+/** Read the current value on the port
+ *
+ * @param obj The port object
+ * @return An integer with each bit corresponding to an associated port pin setting
+ */
+static inline int port_read_fast(port_t *obj)
+{
+    return port_read(obj);
+}
+
+#endif
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/**@}*/
+
+#endif
+
+/** @}*/
@@ -16,10 +16,12 @@
  */
 
 #include "analogin_api.h"
+#include "can_api.h"
 #include "i2c_api.h"
 #include "spi_api.h"
 #include "gpio_api.h"
 #include "reset_reason_api.h"
+#include "port_api.h"
 #include "mbed_toolchain.h"
 
 // To be re-implemented in the target layer if required
@@ -28,6 +30,14 @@ MBED_WEAK void gpio_free(gpio_t *obj)
     // Do nothing
 }
 
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+// To be re-implemented in the target layer if required
+MBED_WEAK bool port_pin_info(PinName pin, PortName *port, int *pin_n)
+{
+    return false;
+}
+#endif
+
 #if DEVICE_I2C
 // To be re-implemented in the target layer if required
 MBED_WEAK void i2c_free(i2c_t *obj)
@@ -36,6 +46,25 @@ MBED_WEAK void i2c_free(i2c_t *obj)
 }
 #endif
 
+#if DEVICE_CAN
+// To be re-implemented in the target layer if the hardware timestamps frames
+MBED_WEAK int can_read_timestamp(can_t *obj, CAN_Message *msg, int handle, us_timestamp_t *timestamp)
+{
+    return can_read(obj, msg, handle);
+}
+
+// To be re-implemented in the target layer if required
+MBED_WEAK int can_filter_bank_count(can_t *obj)
+{
+    return 0;
+}
+
+MBED_WEAK int can_filter_bank(can_t *obj, int bank, uint32_t id, uint32_t mask, CANFormat format, int enable)
+{
+    return 0;
+}
+#endif
+
 #if DEVICE_ANALOGIN
 // To be re-implemented in the target layer if required
 MBED_WEAK void analogin_free(analogin_t *obj)
@@ -18,8 +18,10 @@
 #include <stddef.h>
 #include "hal/ticker_api.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_error.h"
+#include "platform/mbed_toolchain.h"
 
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
@@ -139,6 +141,69 @@ static us_timestamp_t convert_timestamp(us_timestamp_t ref, timestamp_t timestam
     return result;
 }
 
+#if MBED_CONF_PLATFORM_TICKER_LOCK_FREE_READ
+/*
+ * The present time is updated with interrupts disabled and read without.
+ * Updates make seq odd while tick_last_read, tick_remainder and present_time
+ * change, readers retry when seq was odd or changed while they read them.
+ */
+static void present_time_write_begin(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->seq, queue->seq + 1);
+}
+
+static void present_time_write_end(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->seq, queue->seq + 1);
+}
+
+/*
+ * Read the present time of a ticker without disabling interrupts.
+ *
+ * The queue state is not updated, the ticker interrupt that is always
+ * scheduled at most max_delta ticks ahead updates it before the hardware
+ * counter can wrap past tick_last_read.
+ */
+static us_timestamp_t read_present_time(const ticker_data_t *const ticker)
+{
+    ticker_event_queue_t *queue = ticker->queue;
+    uint32_t seq;
+    uint32_t tick_last_read;
+    uint64_t tick_remainder;
+    us_timestamp_t present_time;
+    uint32_t ticker_time;
+
+    do {
+        seq = core_util_atomic_load_u32(&queue->seq);
+        tick_last_read = queue->tick_last_read;
+        tick_remainder = queue->tick_remainder;
+        present_time = queue->present_time;
+        ticker_time = queue->suspended ? tick_last_read : ticker->interface->read();
+    } while ((seq & 1) || seq != core_util_atomic_load_u32(&queue->seq));
+
+    // Same conversion as update_present_time(), without storing the result
+    uint64_t elapsed_ticks = (ticker_time - tick_last_read) & queue->bitmask;
+    if (1000000 == queue->frequency) {
+        return present_time + elapsed_ticks;
+    }
+    uint64_t us_x_ticks = elapsed_ticks * 1000000 + tick_remainder;
+    if (0 != queue->frequency_shifts) {
+        return present_time + (us_x_ticks >> queue->frequency_shifts);
+    }
+    return present_time + us_x_ticks / queue->frequency;
+}
+#else
+static void present_time_write_begin(ticker_event_queue_t *queue)
+{
+    (void)queue;
+}
+
+static void present_time_write_end(ticker_event_queue_t *queue)
+{
+    (void)queue;
+}
+#endif
+
 /**
  * Update the present timestamp value of a ticker.
  */
@@ -155,6 +220,7 @@ static void update_present_time(const ticker_data_t *const ticker)
     }
 
     uint64_t elapsed_ticks = (ticker_time - queue->tick_last_read) & queue->bitmask;
+    present_time_write_begin(queue);
     queue->tick_last_read = ticker_time;
 
     uint64_t elapsed_us;
@@ -189,6 +255,7 @@ static void update_present_time(const ticker_data_t *const ticker)
 
     // Update current time
     queue->present_time += elapsed_us;
+    present_time_write_end(queue);
 }
 
 /**
@@ -304,7 +371,78 @@ void ticker_set_handler(const ticker_data_t *const ticker, ticker_event_handler
     core_util_critical_section_exit();
 }
 
-void ticker_irq_handler(const ticker_data_t *const ticker)
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+/* Pending events are kept in a pairing heap rooted at queue->head. Each
+ * event points to its first child and to its next sibling; prev points to
+ * the previous sibling, or to the parent for a first child, so any event
+ * can be unlinked without a search. The root has no prev and no sibling,
+ * which also tells queued events (head or prev set) from unqueued ones.
+ */
+static ticker_event_t *heap_meld(ticker_event_t *a, ticker_event_t *b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (b->timestamp < a->timestamp) {
+        ticker_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    // b becomes the first child of a
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+static ticker_event_t *heap_merge_pairs(ticker_event_t *first)
+{
+    // meld the siblings in pairs from left to right, stacking the results
+    ticker_event_t *pairs = NULL;
+    while (first != NULL) {
+        ticker_event_t *a = first;
+        ticker_event_t *b = a->next;
+        first = b != NULL ? b->next : NULL;
+
+        a->next = NULL;
+        a->prev = NULL;
+        if (b != NULL) {
+            b->next = NULL;
+            b->prev = NULL;
+        }
+        a = heap_meld(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    // then meld the pairs together from right to left
+    ticker_event_t *root = NULL;
+    while (pairs != NULL) {
+        ticker_event_t *p = pairs;
+        pairs = p->next;
+        p->next = NULL;
+        root = heap_meld(root, p);
+    }
+    return root;
+}
+
+static ticker_event_t *heap_parent(ticker_event_t *p)
+{
+    while (p->prev != NULL && p->prev->child != p) {
+        p = p->prev;
+    }
+    return p->prev;
+}
+#endif
+
+MBED_FAST_CODE void ticker_irq_handler(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
@@ -328,7 +466,11 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             // This event was in the past:
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
-            ticker->queue->head = ticker->queue->head->next;
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+            ticker->queue->head = heap_merge_pairs(p->child);
+#else
+            ticker->queue->head = p->next;
+#endif
             if (ticker->queue->event_handler != NULL) {
                 (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -376,6 +518,18 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     obj->timestamp = timestamp;
     obj->id = id;
 
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+    obj->next = NULL;
+    obj->prev = NULL;
+    obj->child = NULL;
+
+    // ties keep the current head, as in the sorted list
+    ticker->queue->head = heap_meld(ticker->queue->head, obj);
+
+    if (ticker->queue->head == obj || timestamp <= ticker->queue->present_time) {
+        schedule_interrupt(ticker);
+    }
+#else
     /* Go through the list until we either reach the end, or find
        an element this should come before (which is possibly the
        head). */
@@ -403,14 +557,87 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     if (prev == NULL || timestamp <= ticker->queue->present_time) {
         schedule_interrupt(ticker);
     }
+#endif
 
     core_util_critical_section_exit();
 }
 
+us_timestamp_t ticker_insert_event_us_coalesced(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, us_timestamp_t slack, uint32_t id)
+{
+    core_util_critical_section_enter();
+
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+    // find the earliest event due at or after timestamp. Children are never
+    // due before their parent, so only events due before timestamp need to
+    // have their children searched.
+    ticker_event_t *match = NULL;
+    ticker_event_t *p = ticker->queue->head;
+    while (p != NULL) {
+        if (p->timestamp < timestamp) {
+            if (p->child != NULL) {
+                p = p->child;
+                continue;
+            }
+        } else if (p->timestamp - timestamp <= slack &&
+                   (match == NULL || p->timestamp < match->timestamp)) {
+            match = p;
+        }
+
+        while (p != NULL && p->next == NULL) {
+            p = heap_parent(p);
+        }
+        if (p != NULL) {
+            p = p->next;
+        }
+    }
+
+    if (match != NULL) {
+        timestamp = match->timestamp;
+    }
+#else
+    // find the first event due at or after timestamp, the queue is sorted
+    ticker_event_t *p = ticker->queue->head;
+    while (p != NULL && p->timestamp < timestamp) {
+        p = p->next;
+    }
+
+    if (p != NULL && p->timestamp - timestamp <= slack) {
+        timestamp = p->timestamp;
+    }
+#endif
+
+    ticker_insert_event_us(ticker, obj, timestamp, id);
+
+    core_util_critical_section_exit();
+
+    return timestamp;
+}
+
 void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
 {
     core_util_critical_section_enter();
 
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+    if (ticker->queue->head == obj) {
+        // the root, so its children make the new heap
+        ticker->queue->head = heap_merge_pairs(obj->child);
+        schedule_interrupt(ticker);
+    } else if (obj->prev != NULL) {
+        // unlink from the parent or previous sibling, then put the children
+        // back; none of them is due before the head so it doesn't change
+        if (obj->prev->child == obj) {
+            obj->prev->child = obj->next;
+        } else {
+            obj->prev->next = obj->next;
+        }
+        if (obj->next != NULL) {
+            obj->next->prev = obj->prev;
+        }
+        obj->next = NULL;
+        obj->prev = NULL;
+        ticker->queue->head = heap_meld(ticker->queue->head, heap_merge_pairs(obj->child));
+    }
+#else
     // remove this object from the list
     if (ticker->queue->head == obj) {
         // first in the list, so just drop me
@@ -427,6 +654,7 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
             p = p->next;
         }
     }
+#endif
 
     core_util_critical_section_exit();
 }
@@ -442,10 +670,14 @@ us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
 
     initialize(ticker);
 
+#if MBED_CONF_PLATFORM_TICKER_LOCK_FREE_READ
+    ret = read_present_time(ticker);
+#else
     core_util_critical_section_enter();
     update_present_time(ticker);
     ret = ticker->queue->present_time;
     core_util_critical_section_exit();
+#endif
 
     return ret;
 }
@@ -495,7 +727,9 @@ void ticker_resume(const ticker_data_t *const ticker)
 
     ticker->queue->suspended = false;
     if (ticker->queue->initialized) {
+        present_time_write_begin(ticker->queue);
         ticker->queue->tick_last_read = ticker->interface->read();
+        present_time_write_end(ticker->queue);
 
         update_present_time(ticker);
         schedule_interrupt(ticker);
@@ -20,6 +20,7 @@
 #ifndef MBED_PORTMAP_H
 #define MBED_PORTMAP_H
 
+#include <stdbool.h>
 #include "device.h"
 
 #if DEVICE_PORTIN || DEVICE_PORTOUT
@@ -45,6 +46,21 @@ typedef struct port_s port_t;
  */
 PinName port_pin(PortName port, int pin_n);
 
+/** Get the port of a pin and the pin's number within that port
+ *
+ * This is the reverse of port_pin(). Drivers use it to group pins which
+ * share a port, so they can be accessed with one port operation.
+ *
+ * The default implementation returns false, in which case the pins are
+ * accessed one by one.
+ *
+ * @param pin   The pin name
+ * @param port  Where to store the port name
+ * @param pin_n Where to store the pin number within the port
+ * @return      true if the port and pin number were found
+ */
+bool port_pin_info(PinName pin, PortName *port, int *pin_n);
+
 /** Initilize the port
  *
  * @param obj  The port object to initialize
@@ -157,6 +157,72 @@ const PinMap *pwmout_pinmap(void);
 
 /**@}*/
 
+#if DEVICE_PWMOUT_STREAM
+
+/**
+ * \defgroup hal_pwmout_stream Pwmout streaming hal functions
+ *
+ * Targets whose PWM timers can trigger a DMA request on each timer update
+ * implement streaming: the DMA loads the compare register with the next
+ * value from a buffer at the start of every period, so a new pulsewidth is
+ * output each period without an interrupt per period.
+ *
+ * # Defined behavior
+ * * ::pwmout_stream_period_ticks returns the PWM period in timer ticks
+ * * ::pwmout_stream_start outputs the pulsewidths in the buffer one per period,
+ *   starting again from the beginning of the buffer after the last one
+ * * The handler passed to ::pwmout_stream_start is called once each half of the
+ *   buffer has been loaded, so the half can be refilled while the other half is output
+ * * ::pwmout_stream_stop stops the streaming and keeps the last pulsewidth output
+ * * Calling ::pwmout_write or the pulsewidth functions while streaming stops the streaming
+ *
+ * # Undefined behavior
+ * * Changing the period while streaming
+ * * Calling ::pwmout_stream_start with an odd count or a buffer value larger
+ *   than ::pwmout_stream_period_ticks
+ *
+ * @{
+ */
+
+/** Handler called when a half of the stream buffer has been loaded
+ *
+ * @param obj     The pwmout object
+ * @param half    0 for the first half of the buffer, 1 for the second half
+ * @param context The context passed to ::pwmout_stream_start
+ */
+typedef void (*pwmout_stream_handler_t)(pwmout_t *obj, uint32_t half, void *context);
+
+/** Get the PWM period in timer ticks, the unit of the stream buffer values
+ *
+ * @param obj The pwmout object
+ * @return The period in timer ticks
+ */
+uint32_t pwmout_stream_period_ticks(pwmout_t *obj);
+
+/** Start streaming pulsewidths from a circular buffer
+ *
+ * The buffer must stay valid until ::pwmout_stream_stop.
+ *
+ * @param obj     The pwmout object
+ * @param buffer  Pulsewidths in timer ticks, one per period
+ * @param count   Number of values in the buffer, must be even
+ * @param handler Handler called from interrupt context after each half of the buffer is loaded
+ * @param context Context passed to the handler
+ * @return 0 on success, -1 if no DMA channel is available for the timer
+ */
+int pwmout_stream_start(pwmout_t *obj, const uint16_t *buffer, uint32_t count,
+                        pwmout_stream_handler_t handler, void *context);
+
+/** Stop streaming
+ *
+ * @param obj The pwmout object
+ */
+void pwmout_stream_stop(pwmout_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,7 @@ typedef enum qspi_bus_width {
     QSPI_CFG_BUS_SINGLE,
     QSPI_CFG_BUS_DUAL,
     QSPI_CFG_BUS_QUAD,
+    QSPI_CFG_BUS_OCTAL, /**< Needs DEVICE_QSPI_OCTAL >*/
 } qspi_bus_width_t;
 
 /** Address size in bits
@@ -94,22 +95,26 @@ typedef struct qspi_command {
         qspi_bus_width_t bus_width; /**< Bus width for the instruction >*/
         uint8_t value;  /**< Instruction value >*/
         bool disabled; /**< Instruction phase skipped if disabled is set to true >*/
+        bool dtr; /**< Instruction sent on both clock edges, needs DEVICE_QSPI_DTR >*/
     } instruction;
     struct {
         qspi_bus_width_t bus_width; /**< Bus width for the address >*/
         qspi_address_size_t size; /**< Address size >*/
         uint32_t value; /**< Address value >*/
         bool disabled; /**< Address phase skipped if disabled is set to true >*/
+        bool dtr; /**< Address sent on both clock edges, needs DEVICE_QSPI_DTR >*/
     }  address;
     struct {
         qspi_bus_width_t bus_width; /**< Bus width for alternative  >*/
         qspi_alt_size_t size; /**< Alternative size >*/
         uint32_t value; /**< Alternative value >*/
         bool disabled; /**< Alternative phase skipped if disabled is set to true >*/
+        bool dtr; /**< Alternative sent on both clock edges, needs DEVICE_QSPI_DTR >*/
     } alt;
     uint8_t dummy_count; /**< Dummy cycles count >*/
     struct {
         qspi_bus_width_t bus_width; /**< Bus width for data >*/
+        bool dtr; /**< Data transferred on both clock edges, needs DEVICE_QSPI_DTR >*/
     } data;
 } qspi_command_t;
 
@@ -140,6 +145,36 @@ typedef enum qspi_status {
  */
 qspi_status_t qspi_init(qspi_t *obj, PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, PinName ssel, uint32_t hz, uint8_t mode);
 
+#if DEVICE_QSPI_OCTAL
+
+/** Initialize QSPI peripheral with an 8-line data bus
+ *
+ * Same as qspi_init(), with the pins io4-io7 of an octal memory. Commands can
+ * then use QSPI_CFG_BUS_OCTAL for any phase.
+ *
+ * @param obj QSPI object
+ * @param io0 Data pin 0
+ * @param io1 Data pin 1
+ * @param io2 Data pin 2
+ * @param io3 Data pin 3
+ * @param io4 Data pin 4
+ * @param io5 Data pin 5
+ * @param io6 Data pin 6
+ * @param io7 Data pin 7
+ * @param sclk The clock pin
+ * @param ssel The chip select pin
+ * @param hz The bus frequency
+ * @param mode Clock polarity and phase mode (0 - 3)
+ * @return QSPI_STATUS_OK if initialisation successfully executed
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_init_octal(qspi_t *obj, PinName io0, PinName io1, PinName io2, PinName io3,
+                              PinName io4, PinName io5, PinName io6, PinName io7,
+                              PinName sclk, PinName ssel, uint32_t hz, uint8_t mode);
+
+#endif
+
 /** Initialize QSPI peripheral.
  *
  * It should initialize QSPI pins (io0-io3, sclk and ssel), set frequency, clock polarity and phase mode. The clock for the peripheral should be enabled
@@ -215,6 +250,38 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+
+/** Enter memory-mapped mode
+ *
+ * The controller maps the external memory into the address space, and issues
+ * the given read command whenever the CPU reads from it. The address value of
+ * the command is ignored, the address comes from the access. The CPU may cache
+ * the mapped region.
+ *
+ * No other command can be sent until memory-mapped mode is left with
+ * qspi_memory_mapped_disable().
+ *
+ * @param obj QSPI object
+ * @param command QSPI read command
+ * @param[out] base Start of the mapped region, which maps address 0 of the memory
+ * @param[out] size Size of the mapped region in bytes
+ * @return QSPI_STATUS_OK if memory-mapped mode has been entered
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_memory_mapped_enable(qspi_t *obj, const qspi_command_t *command, const void **base, size_t *size);
+
+/** Leave memory-mapped mode
+ *
+ * @param obj QSPI object
+ * @return QSPI_STATUS_OK if memory-mapped mode has been left
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_memory_mapped_disable(qspi_t *obj);
+
+#endif
+
 /** Get the pins that support QSPI SCLK
  *
  * Return a PinMap array of pins that support QSPI SCLK in
@@ -187,6 +187,17 @@ extern "C" {
  * * Correct operation guaranteed when interrupt latency is shorter than one packet transfer time (packet_bits / baudrate)
  * if the flow control is not used.
  * * Correct operation guaranteed regardless of interrupt latency if the flow control is used.
+ * * ::serial_rx_dma_start starts continuous reception into a circular buffer, wrapping at its end.
+ * * While continuous reception is active and `RxIrq` is enabled by ::serial_irq_set, ::serial_irq_handler
+ * is invoked with `RxIrq` when the RX line goes idle after receiving data, and when the reception
+ * reaches the middle or the end of the buffer, instead of for every character.
+ * * ::serial_rx_dma_position returns the offset in the buffer of the next character to be received,
+ * or 0 while continuous reception is not active.
+ * * ::serial_rx_dma_stop stops continuous reception. ::serial_free also stops it.
+ * * ::serial_tx_dma_start starts transmission of a buffer without CPU involvement.
+ * * While a DMA transmission is active and `TxIrq` is enabled by ::serial_irq_set, ::serial_irq_handler
+ * is invoked with `TxIrq` when it completes, instead of when the Transmit Data Register is empty.
+ * * ::serial_tx_dma_active returns non-zero while a DMA transmission is ongoing, 0 otherwise.
  *
  * # Undefined behavior
  * * Calling ::serial_init multiple times on the same `serial_t` without ::serial_free.
@@ -196,6 +207,8 @@ extern "C" {
  * * Passing an invalid pointer as `handler` to ::serial_irq_handler, ::serial_tx_asynch, ::serial_rx_asynch.
  * * Calling ::serial_tx_abort while no async TX transfer is being processed.
  * * Calling ::serial_rx_abort while no async RX transfer is being processed.
+ * * Calling ::serial_getc while continuous reception is active.
+ * * Calling ::serial_putc or ::serial_tx_dma_start while a DMA transmission is active.
  * * Devices behavior is undefined when the interrupt latency is longer than one packet transfer time
  * (packet_bits / baudrate) if the flow control is not used.
  * @{
@@ -341,6 +354,51 @@ void serial_set_flow_control(serial_t *obj, FlowControl type, PinName rxflow, Pi
 void serial_set_flow_control_direct(serial_t *obj, FlowControl type, const serial_fc_pinmap_t *pinmap);
 #endif
 
+#if DEVICE_SERIAL_DMA
+/** Start continuous reception into a circular buffer
+ *
+ * The peripheral writes received characters into the buffer, wrapping back
+ * to its start, until ::serial_rx_dma_stop is called. The RX interrupt is
+ * raised on idle line and when half of the buffer has been filled.
+ *
+ * @param obj    The serial object
+ * @param buffer The circular receive buffer
+ * @param size   The size of the buffer in bytes
+ */
+void serial_rx_dma_start(serial_t *obj, void *buffer, size_t size);
+
+/** Get the current position of continuous reception
+ *
+ * @param obj The serial object
+ * @return Offset in the buffer where the next character will be written,
+ *         or 0 if continuous reception is not active
+ */
+size_t serial_rx_dma_position(serial_t *obj);
+
+/** Stop continuous reception
+ *
+ * @param obj The serial object
+ */
+void serial_rx_dma_stop(serial_t *obj);
+
+/** Start transmission of a buffer by DMA
+ *
+ * The TX interrupt is raised when the whole buffer has been sent.
+ *
+ * @param obj    The serial object
+ * @param buffer The data to send, must stay valid until the transmission completes
+ * @param size   The number of bytes to send
+ */
+void serial_tx_dma_start(serial_t *obj, const void *buffer, size_t size);
+
+/** Check if a DMA transmission is ongoing
+ *
+ * @param obj The serial object
+ * @return Non-zero if a DMA transmission is ongoing, 0 otherwise
+ */
+uint8_t serial_tx_dma_active(serial_t *obj);
+#endif
+
 /** Get the pins that support Serial TX
  *
  * Return a PinMap array of pins that support Serial TX. The
@@ -43,7 +43,11 @@ typedef uint64_t us_timestamp_t;
 typedef struct ticker_event_s {
     us_timestamp_t         timestamp; /**< Event's timestamp */
     uint32_t               id;        /**< TimerEvent object */
-    struct ticker_event_s *next;      /**< Next event in the queue */
+    struct ticker_event_s *next;      /**< Next event in the queue, or next sibling in the heap */
+#if MBED_CONF_PLATFORM_TICKER_EVENT_HEAP
+    struct ticker_event_s *child;     /**< First child in the heap */
+    struct ticker_event_s *prev;      /**< Previous sibling in the heap, or parent if first child */
+#endif
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
@@ -74,7 +78,7 @@ typedef struct {
  */
 typedef struct {
     ticker_event_handler event_handler; /**< Event handler */
-    ticker_event_t *head;               /**< A pointer to head */
+    ticker_event_t *head;               /**< Earliest pending event, the root of the heap if enabled */
     uint32_t frequency;                 /**< Frequency of the timer in Hz */
     uint32_t bitmask;                   /**< Mask to be applied to time values read */
     uint32_t max_delta;                 /**< Largest delta in ticks that can be used when scheduling */
@@ -86,6 +90,9 @@ typedef struct {
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
     uint8_t frequency_shifts;           /**< If frequency is a value of 2^n, this is n, otherwise 0 */
+#if MBED_CONF_PLATFORM_TICKER_LOCK_FREE_READ
+    volatile uint32_t seq;              /**< Odd while the present time is being updated, changes on each update */
+#endif
 } ticker_event_queue_t;
 
 /** Ticker's data structure
@@ -159,6 +166,22 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
  */
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id);
 
+/** Insert an event to the queue, allowing it to share an interrupt with a later event
+ *
+ * If an event already in the queue is due no more than slack us after
+ * timestamp, the new event is given that event's timestamp, so both are
+ * handled by a single interrupt. Otherwise this behaves like
+ * ticker_insert_event_us.
+ *
+ * @param ticker    The ticker object.
+ * @param obj       The event object to be inserted to the queue
+ * @param timestamp The event's timestamp
+ * @param slack     How late in us the event may be executed
+ * @param id        The event object
+ * @return The timestamp the event was inserted with
+ */
+us_timestamp_t ticker_insert_event_us_coalesced(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, us_timestamp_t slack, uint32_t id);
+
 /** Read the current (relative) ticker's timestamp
  *
  * @warning Return a relative timestamp because the counter wrap every 4294
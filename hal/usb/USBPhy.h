@@ -268,13 +268,34 @@ public:
      */
     virtual void endpoint_unstall(usb_ep_t endpoint) = 0;
 
+    /**
+     * Get the largest transfer endpoint_read and endpoint_write accept
+     *
+     * PHYs that move a transfer of several packets without help from the
+     * upper layer override this. A multi-packet read completes when the
+     * buffer is full or a short packet is received. A multi-packet write
+     * sends the data as max sized packets followed by a short one if the
+     * size isn't a multiple of the max packet size; no zero length packet
+     * is added.
+     *
+     * @param endpoint Endpoint to check
+     * @return The largest transfer in bytes, or 0 if transfers are limited
+     *     to one packet
+     */
+    virtual uint32_t endpoint_max_transfer_size(usb_ep_t endpoint)
+    {
+        (void)endpoint;
+        return 0;
+    }
+
     /**
      * Start a read on the given endpoint
      *
      * @param endpoint Endpoint to start the read on
      * @param data Buffer to fill with data
      * @param size Size of the read buffer. This must be at least
-     *     the max packet size for this endpoint.
+     *     the max packet size for this endpoint. Reads larger than the max
+     *     packet size are only started if endpoint_max_transfer_size allows it.
      * @return true if the read was successfully started, false otherwise
      */
     virtual bool endpoint_read(usb_ep_t endpoint, uint8_t *data, uint32_t size) = 0;
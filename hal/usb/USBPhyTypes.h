@@ -41,7 +41,11 @@ enum  {
     USB_EP_ATTR_DIR_OUT = 1 << 4,
     USB_EP_ATTR_DIR_IN_OR_OUT = 2 << 4,
     USB_EP_ATTR_DIR_IN_AND_OUT = 3 << 4,
-    USB_EP_ATTR_DIR_MASK = 3 << 4
+    USB_EP_ATTR_DIR_MASK = 3 << 4,
+
+    /* The hardware has two packet buffers for this endpoint, so the next
+     * packet is accepted or sent while the previous transfer is completed */
+    USB_EP_ATTR_DOUBLE_BUFFER = 1 << 6
 };
 typedef uint8_t usb_ep_attr_t;
 
@@ -60,6 +60,7 @@
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
 #include "drivers/AnalogIn.h"
+#include "drivers/AnalogInStream.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
 #include "drivers/SPI.h"
@@ -73,6 +74,7 @@
 #include "drivers/MbedCRC.h"
 #include "drivers/QSPI.h"
 #include "drivers/Watchdog.h"
+#include "drivers/DMAMemcpy.h"
 
 // mbed Internal components
 #include "drivers/ResetReason.h"
@@ -106,6 +108,7 @@
 
 // mbed Non-hardware components
 #include "platform/Callback.h"
+#include "platform/FunctionRef.h"
 #include "platform/ScopedLock.h"
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
@@ -26,6 +26,10 @@
 #include "platform/NonCopyable.h"
 #include "platform/FileHandle.h"
 
+#ifndef MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE 0
+#endif
+
 namespace mbed {
 /** \addtogroup platform-public-api Platform */
 /** @{*/
@@ -63,6 +67,12 @@ private:
     char *_buffer;
     int _timeout;
 
+    // Read-ahead buffer, bytes in [_rx_pos, _rx_len) are unread
+    int _rx_buf_size;
+    char *_rx_buf;
+    int _rx_pos;
+    int _rx_len;
+
     // Parsing information
     const char *_output_delimiter;
     int _output_delim_size;
@@ -97,6 +107,12 @@ private:
      */
     int vrecvscanf(const char *response, std::va_list args, bool multiline);
 
+    // Refill the read-ahead buffer, waiting up to the timeout
+    bool fill();
+
+    // Check for data in the read-ahead buffer or the file handle
+    bool readable();
+
 public:
 
     /**
@@ -107,12 +123,22 @@ public:
      * @param buffer_size Size of internal buffer for transaction
      * @param timeout Timeout of the connection
      * @param debug Turns on/off debug output for AT commands
+     *
+     * @note If platform.atcmdparser-rx-buffer-size is non-zero, the parser
+     * reads from the file handle in blocks of up to that size, rather than
+     * one byte at a time. Data that the parser has read ahead is only
+     * available through the parser, so the file handle should then not be
+     * read directly.
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
                 int buffer_size = 256, int timeout = 8000, bool debug = false)
-        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _aborted(false), _oobs(NULL)
+        : _fh(fh), _buffer_size(buffer_size), _rx_buf_size(MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE), _rx_buf(NULL),
+          _rx_pos(0), _rx_len(0), _oob_cb_count(0), _in_prev(0), _aborted(false), _oobs(NULL)
     {
         _buffer = new char[buffer_size];
+        if (_rx_buf_size > 0) {
+            _rx_buf = new char[_rx_buf_size];
+        }
         set_timeout(timeout);
         set_delimiter(output_delimiter);
         debug_on(debug);
@@ -129,6 +155,7 @@ public:
             delete oob;
         }
         delete[] _buffer;
+        delete[] _rx_buf;
     }
 
     /**
@@ -223,6 +250,9 @@ public:
     /**
      * Read an array of bytes from the underlying stream
      *
+     * Data already read ahead by the parser is copied out first, the rest is
+     * read from the underlying stream straight into @a data.
+     *
      * @param data The buffer for filling the read bytes
      * @param size Number of bytes to read
      * @return number of bytes read or -1 on failure
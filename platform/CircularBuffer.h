@@ -18,8 +18,12 @@
 #define MBED_CIRCULARBUFFER_H
 
 #include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <type_traits>
 #include "platform/mbed_critical.h"
 #include "platform/mbed_assert.h"
+#include "platform/Span.h"
 
 namespace mbed {
 
@@ -108,6 +112,38 @@ public:
         core_util_critical_section_exit();
     }
 
+    /** Push a number of transactions to the buffer. This overwrites the
+     *  oldest transactions if there is not enough space
+     *
+     * The transactions are copied in at most two contiguous blocks.
+     *
+     * @param src Transactions to be pushed to the buffer. If it holds more
+     *            than BufferSize transactions, only the last BufferSize are kept
+     */
+    void push(mbed::Span<const T> src)
+    {
+        MBED_STATIC_ASSERT(std::is_trivially_copyable<T>::value, "Span push requires a trivially copyable T");
+
+        const T *ptr = src.data();
+        size_t len = src.size();
+        if (len > BufferSize) {
+            ptr += len - BufferSize;
+            len = BufferSize;
+        }
+
+        core_util_critical_section_enter();
+        size_t elements = size();
+        size_t first = std::min<size_t>(len, BufferSize - _head);
+        memcpy(&_pool[_head], ptr, first * sizeof(T));
+        memcpy(&_pool[0], ptr + first, (len - first) * sizeof(T));
+        _head = increment(_head, len);
+        if (len != 0 && elements + len >= BufferSize) {
+            _tail = _head;
+            _full = true;
+        }
+        core_util_critical_section_exit();
+    }
+
     /** Pop the transaction from the buffer
      *
      * @param data Data to be popped from the buffer
@@ -129,6 +165,110 @@ public:
         return data_popped;
     }
 
+    /** Pop a number of transactions from the buffer
+     *
+     * The transactions are copied out in at most two contiguous blocks.
+     *
+     * @param dest Buffer the transactions are popped into
+     * @return Number of transactions popped, at most dest.size()
+     */
+    CounterType pop(mbed::Span<T> dest)
+    {
+        MBED_STATIC_ASSERT(std::is_trivially_copyable<T>::value, "Span pop requires a trivially copyable T");
+
+        core_util_critical_section_enter();
+        size_t len = std::min<size_t>(dest.size(), size());
+        size_t first = std::min<size_t>(len, BufferSize - _tail);
+        memcpy(dest.data(), &_pool[_tail], first * sizeof(T));
+        memcpy(dest.data() + first, &_pool[0], (len - first) * sizeof(T));
+        _tail = increment(_tail, len);
+        if (len != 0) {
+            _full = false;
+        }
+        core_util_critical_section_exit();
+        return len;
+    }
+
+    /** Get the contiguous free region at the head of the buffer
+     *
+     * Lets a producer, such as a DMA transfer, write transactions into the
+     * buffer directly. The region becomes part of the buffer once
+     * commit_write() is called; it may be shorter than the total free space
+     * if the free space wraps around the end of the buffer.
+     *
+     * @return Free region, empty if the buffer is full
+     */
+    mbed::Span<T> get_write_region()
+    {
+        core_util_critical_section_enter();
+        size_t len;
+        if (_full) {
+            len = 0;
+        } else if (_head < _tail) {
+            len = _tail - _head;
+        } else {
+            len = BufferSize - _head;
+        }
+        mbed::Span<T> region(&_pool[_head], len);
+        core_util_critical_section_exit();
+        return region;
+    }
+
+    /** Add transactions written into the region from get_write_region()
+     *
+     * @param count Number of transactions written, at most the size of the region
+     */
+    void commit_write(CounterType count)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(count <= BufferSize - size());
+        _head = increment(_head, count);
+        if (count != 0 && _head == _tail) {
+            _full = true;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** Get the contiguous region of transactions at the tail of the buffer
+     *
+     * Lets a consumer, such as a DMA transfer, read the oldest transactions
+     * directly from the buffer. The transactions stay in the buffer until
+     * commit_read() is called; the region may be shorter than size() if the
+     * transactions wrap around the end of the buffer.
+     *
+     * @return Region of the oldest transactions, empty if the buffer is empty
+     */
+    mbed::Span<const T> get_read_region() const
+    {
+        core_util_critical_section_enter();
+        size_t len;
+        if (_tail < _head) {
+            len = _head - _tail;
+        } else if (_tail == _head && !_full) {
+            len = 0;
+        } else {
+            len = BufferSize - _tail;
+        }
+        mbed::Span<const T> region(&_pool[_tail], len);
+        core_util_critical_section_exit();
+        return region;
+    }
+
+    /** Remove transactions read from the region from get_read_region()
+     *
+     * @param count Number of transactions read, at most the size of the region
+     */
+    void commit_read(CounterType count)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(count <= size());
+        _tail = increment(_tail, count);
+        if (count != 0) {
+            _full = false;
+        }
+        core_util_critical_section_exit();
+    }
+
     /** Check if the buffer is empty
      *
      * @return True if the buffer is empty, false if not
@@ -201,6 +341,15 @@ public:
     }
 
 private:
+    static CounterType increment(CounterType index, size_t count)
+    {
+        size_t next = index + count;
+        if (next >= BufferSize) {
+            next -= BufferSize;
+        }
+        return next;
+    }
+
     T _pool[BufferSize];
     CounterType _head;
     CounterType _tail;
@@ -45,10 +45,22 @@ namespace mbed {
 class DeepSleepLock {
 private:
     uint16_t _lock_count;
+    const char *_tag;
 
 public:
     DeepSleepLock();
 
+    /** Create a lock that is recorded against a named holder
+     *
+     *  If deep sleep lock statistics are enabled, the time this lock
+     *  prevents deep sleep is recorded against @a tag. See
+     *  mbed_stats_deep_sleep_lock_get_each().
+     *
+     *  @param tag Name of the lock holder, such as a driver class name. The
+     *             string must remain valid for the lifetime of the program.
+     */
+    explicit DeepSleepLock(const char *tag);
+
     ~DeepSleepLock();
 
     /** Mark the start of a locked deep sleep section
@@ -24,6 +24,7 @@ typedef int FILEHANDLE;
 #include "platform/mbed_poll.h"
 #include "platform/platform.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 namespace mbed {
 
@@ -75,6 +76,35 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file into several buffers
+     *
+     *  The buffers are filled in order, as if by one read() of their total
+     *  size. As with read(), the call returns once some data has been read,
+     *  so it may fill fewer bytes than the buffers can hold.
+     *
+     *  The default implementation calls read() for each buffer, stopping at
+     *  the first that is not filled. Override it to transfer the buffers in
+     *  one operation.
+     *
+     *  @param iov      The buffers to read in to
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(Span<const struct iovec> iov);
+
+    /** Write the contents of several buffers to a file
+     *
+     *  The buffers are written in order, as if by one write() of their
+     *  total size.
+     *
+     *  The default implementation calls write() for each buffer, stopping
+     *  at the first that is not written completely. Override it to
+     *  transfer the buffers in one operation.
+     *
+     *  @param iov      The buffers to write from
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(Span<const struct iovec> iov);
+
     /** Move the file position to a given offset from from a given location
      *
      *  @param offset   The offset from whence to move to
@@ -216,7 +246,8 @@ public:
      * You can use or ignore the input parameter. You can return all events
      * or check just the events listed in events.
      * Call is nonblocking - returns instantaneous state of events.
-     * Whenever an event occurs, the derived class should call the sigio() callback).
+     * Whenever an event occurs, the derived class should call the sigio() callback,
+     * and mbed::poll_wake() if wakes_poll() returns true.
      *
      * @param events        bitmask of poll events we're interested in - POLLIN/POLLOUT etc.
      *
@@ -228,6 +259,19 @@ public:
         return POLLIN | POLLOUT;
     }
 
+    /** Check whether the FileHandle wakes mbed::poll()
+     *
+     *  A FileHandle that calls mbed::poll_wake() whenever the result of poll()
+     *  may have changed should return true. mbed::poll() then blocks until
+     *  woken, rather than checking the FileHandle periodically.
+     *
+     * @returns             true if the FileHandle calls mbed::poll_wake() on state changes.
+     */
+    virtual bool wakes_poll() const
+    {
+        return false;
+    }
+
     /** Definition depends on the subclass implementing FileHandle.
      *  For example, if the FileHandle is of type Stream, writable() could return
      *  true when there is ample buffer space available for write() calls.
@@ -0,0 +1,137 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FUNCTIONREF_H
+#define MBED_FUNCTIONREF_H
+
+#include <memory>
+#include <mstd_type_traits>
+#include "platform/Callback.h"
+
+namespace mbed {
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_FunctionRef FunctionRef class
+ * @{
+ */
+
+/** FunctionRef class based on template specialization
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename Signature>
+class FunctionRef;
+
+namespace detail {
+
+/* Callables a FunctionRef refers to rather than stores */
+template <typename F, typename Self>
+struct is_function_ref_object : std::integral_constant < bool,
+        !std::is_same<mstd::remove_cvref_t<F>, Self>::value &&
+        !std::is_function<std::remove_reference_t<F>>::value &&
+        !std::is_member_pointer<mstd::remove_cvref_t<F>>::value &&
+        !(std::is_pointer<mstd::remove_cvref_t<F>>::value &&
+          std::is_function<std::remove_pointer_t<mstd::remove_cvref_t<F>>>::value) > { };
+
+} // namespace detail
+
+/** Non-owning reference to a callable, for calls made before the callee returns
+ *
+ * A FunctionRef is two words, trivially copyable, and calls its target
+ * through a single thunk. It does not copy the callable, so unlike Callback
+ * it has no storage limit and no ops table, but the callable must outlive
+ * every call. This suits parameters of functions that call back
+ * synchronously and never keep the callable:
+ *
+ * @code
+ * int sfdp_parse_headers(FunctionRef<int(bd_addr_t, void *, bd_size_t)> sfdp_reader, sfdp_hdr_info &sfdp_info);
+ *
+ * // The temporary Callback lives until sfdp_parse_headers returns
+ * sfdp_parse_headers(callback(this, &SPIFBlockDevice::_spi_send_read_sfdp_command), _sfdp_info);
+ * @endcode
+ *
+ * A FunctionRef is never empty. Use a Callback to keep a callable beyond a
+ * call, or to attach member functions without a function object.
+ */
+template <typename R, typename... ArgTs>
+class FunctionRef<R(ArgTs...)> {
+public:
+    // *INDENT-OFF*
+    /** Refer to a function object
+     *  @param f Function object, such as a lambda or a Callback, that must outlive the calls
+     */
+    template <typename F,
+            typename std::enable_if_t<
+                    detail::is_function_ref_object<F, FunctionRef>::value &&
+                    mstd::is_invocable_r<R, std::remove_reference_t<F> &, ArgTs...>::value, int> = 0>
+    FunctionRef(F &&f) noexcept :
+        _thunk(&object_thunk<std::remove_reference_t<F>>)
+    {
+        _target.obj = const_cast<void *>(static_cast<const volatile void *>(std::addressof(f)));
+    }
+
+    /** Refer to a function
+     *  @param f Function to call, must not be null
+     */
+    template <typename F,
+            typename std::enable_if_t<
+                    std::is_function<F>::value &&
+                    mstd::is_invocable_r<R, F *, ArgTs...>::value, int> = 0>
+    FunctionRef(F *f) noexcept :
+        _thunk(&function_thunk<F>)
+    {
+        MBED_ASSERT(f);
+        _target.func = reinterpret_cast<void (*)()>(f);
+    }
+    // *INDENT-ON*
+
+    /** Call the referenced callable
+     */
+    R operator()(ArgTs... args) const
+    {
+        return _thunk(_target, std::forward<ArgTs>(args)...);
+    }
+
+private:
+    union target_t {
+        void *obj;
+        void (*func)();
+    };
+
+    template <typename F>
+    static R object_thunk(target_t target, ArgTs... args)
+    {
+        return detail::invoke_r<R>(*static_cast<F *>(target.obj), std::forward<ArgTs>(args)...);
+    }
+
+    template <typename F>
+    static R function_thunk(target_t target, ArgTs... args)
+    {
+        return detail::invoke_r<R>(reinterpret_cast<F *>(target.func), std::forward<ArgTs>(args)...);
+    }
+
+    target_t _target;
+    R(*_thunk)(target_t, ArgTs...);
+};
+
+/**@}*/
+
+/**@}*/
+
+} // namespace mbed
+
+#endif
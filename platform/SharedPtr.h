@@ -22,11 +22,79 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include "platform/mbed_atomic.h"
 
 namespace mbed {
 
+template <class T>
+class SharedPtr;
+
+template <class T, class... Args>
+SharedPtr<T> make_shared(Args &&... args);
+
+namespace internal {
+/* Reference count shared by all SharedPtrs to one object, along with how
+ * to dispose of the object once the count reaches zero.
+ */
+struct SharedPtrControl {
+    uint32_t counter;
+    void (*dispose)(SharedPtrControl *control, void *ptr);
+};
+}
+
+/** Base class for objects that embed their own SharedPtr reference count.
+  *
+  * SharedPtrs to a class derived from RefCounted use the embedded count
+  * instead of allocating one, so the object is the only allocation. As the
+  * count lives in the object, a new SharedPtr can also be made from a raw
+  * pointer, such as this, while other SharedPtrs to the object exist.
+  *
+  * @code
+  * #include "platform/SharedPtr.h"
+  *
+  * struct MyStruct : mbed::RefCounted { int a; };
+  *
+  * void test() {
+  *     SharedPtr<MyStruct> ptr(new MyStruct);
+  *     MyStruct *raw = ptr.get();
+  *
+  *     // Shares the reference count with ptr
+  *     SharedPtr<MyStruct> ptr2(raw);
+  * }
+  * @endcode
+  *
+  * The object must be allocated with new and must not be deleted directly
+  * once it is managed by a SharedPtr.
+  */
+class RefCounted {
+protected:
+    RefCounted() : _shared_ptr_control{0, nullptr}
+    {
+    }
+
+    /* The reference count belongs to the object, not its value */
+    RefCounted(const RefCounted &) : RefCounted()
+    {
+    }
+
+    RefCounted &operator=(const RefCounted &)
+    {
+        return *this;
+    }
+
+    ~RefCounted() = default;
+
+private:
+    template <class T>
+    friend class SharedPtr;
+
+    internal::SharedPtrControl _shared_ptr_control;
+};
+
 /** Shared pointer class.
   *
   * A shared pointer is a "smart" pointer that retains ownership of an object using
@@ -52,10 +120,14 @@ namespace mbed {
   *
   *
   * It is similar to the std::shared_ptr class introduced in C++11;
-  * however, this is not a compatible implementation (no weak pointer, no make_shared, no custom deleters and so on.)
+  * however, this is not a compatible implementation (no weak pointer, no custom deleters and so on.)
   *
   * Usage: SharedPtr<Class> ptr(new Class())
   *
+  * Constructing from a raw pointer allocates the reference count separately
+  * from the object. Use make_shared to allocate both at once, or derive the
+  * class from RefCounted to embed the count in the object.
+  *
   * When ptr is passed around by value, the copy constructor and
   * destructor manages the reference count of the raw pointer.
   * If the counter reaches zero, delete is called on the raw pointer.
@@ -71,7 +143,7 @@ public:
      * @brief Create empty SharedPtr not pointing to anything.
      * @details Used for variable declaration.
      */
-    constexpr SharedPtr(): _ptr(), _counter()
+    constexpr SharedPtr(): _ptr(), _control()
     {
     }
 
@@ -86,11 +158,10 @@ public:
      * @brief Create new SharedPtr
      * @param ptr Pointer to take control over
      */
-    SharedPtr(T *ptr): _ptr(ptr), _counter()
+    SharedPtr(T *ptr): _ptr(ptr), _control()
     {
-        // Allocate counter on the heap, so it can be shared
         if (_ptr != nullptr) {
-            _counter = new uint32_t(1);
+            _control = acquire_control(ptr, std::is_base_of<RefCounted, T>());
         }
     }
 
@@ -109,11 +180,11 @@ public:
      *          copying pointer to original object and pointer to counter.
      * @param source Object being copied from.
      */
-    SharedPtr(const SharedPtr &source): _ptr(source._ptr), _counter(source._counter)
+    SharedPtr(const SharedPtr &source): _ptr(source._ptr), _control(source._control)
     {
         // Increment reference counter
         if (_ptr != nullptr) {
-            core_util_atomic_incr_u32(_counter, 1);
+            core_util_atomic_incr_u32(&_control->counter, 1);
         }
     }
 
@@ -123,10 +194,10 @@ public:
      *          moving pointer to original object and pointer to counter.
      * @param source Object being copied from.
      */
-    SharedPtr(SharedPtr &&source): _ptr(source._ptr), _counter(source._counter)
+    SharedPtr(SharedPtr &&source): _ptr(source._ptr), _control(source._control)
     {
         source._ptr = nullptr;
-        source._counter = nullptr;
+        source._control = nullptr;
     }
 
     /**
@@ -143,11 +214,11 @@ public:
 
             // Assign new values
             _ptr = source.get();
-            _counter = source.get_counter();
+            _control = source._control;
 
             // Increment new counter
             if (_ptr != nullptr) {
-                core_util_atomic_incr_u32(_counter, 1);
+                core_util_atomic_incr_u32(&_control->counter, 1);
             }
         }
 
@@ -168,10 +239,10 @@ public:
 
             // Assign new values
             _ptr = source._ptr;
-            _counter = source._counter;
+            _control = source._control;
 
             source._ptr = nullptr;
-            source._counter = nullptr;
+            source._control = nullptr;
         }
 
         return *this;
@@ -188,10 +259,9 @@ public:
 
         _ptr = ptr;
         if (ptr != nullptr) {
-            // Allocate counter on the heap, so it can be shared
-            _counter = new uint32_t(1);
+            _control = acquire_control(ptr, std::is_base_of<RefCounted, T>());
         } else {
-            _counter = nullptr;
+            _control = nullptr;
         }
     }
 
@@ -204,7 +274,7 @@ public:
         decrement_counter();
 
         _ptr = nullptr;
-        _counter = nullptr;
+        _control = nullptr;
     }
 
     /**
@@ -224,7 +294,7 @@ public:
     uint32_t use_count() const
     {
         if (_ptr != nullptr) {
-            return core_util_atomic_load_u32(_counter);
+            return core_util_atomic_load_u32(&_control->counter);
         } else {
             return 0;
         }
@@ -258,13 +328,77 @@ public:
     }
 
 private:
+    template <class U, class... Args>
+    friend SharedPtr<U> make_shared(Args &&... args);
+
+    // Object and reference count allocated together by make_shared
+    struct InplaceControl : internal::SharedPtrControl {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    /**
+     * @brief Take ownership of an object and its already counted control block.
+     */
+    SharedPtr(T *ptr, internal::SharedPtrControl *control): _ptr(ptr), _control(control)
+    {
+    }
+
+    /**
+     * @brief Allocate the object and its reference counter together.
+     */
+    template <class... Args>
+    static SharedPtr make(std::false_type, Args &&... args)
+    {
+        InplaceControl *control = new InplaceControl;
+        control->counter = 1;
+        control->dispose = &dispose_inplace;
+        T *ptr = new (&control->storage) T(std::forward<Args>(args)...);
+        return SharedPtr(ptr, control);
+    }
+
+    /**
+     * @brief Allocate an object that already contains its reference counter.
+     */
+    template <class... Args>
+    static SharedPtr make(std::true_type, Args &&... args)
+    {
+        return SharedPtr(new T(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Allocate a reference counter on the heap, so it can be shared.
+     */
+    static internal::SharedPtrControl *acquire_control(T *ptr, std::false_type)
+    {
+        return new internal::SharedPtrControl{1, &dispose_separate};
+    }
+
     /**
-     * @brief Get pointer to reference counter.
-     * @return Pointer to reference counter.
+     * @brief Use the reference counter embedded in the object.
      */
-    uint32_t *get_counter() const
+    static internal::SharedPtrControl *acquire_control(T *ptr, std::true_type)
+    {
+        internal::SharedPtrControl *control = &static_cast<RefCounted *>(ptr)->_shared_ptr_control;
+        control->dispose = &dispose_embedded;
+        core_util_atomic_incr_u32(&control->counter, 1);
+        return control;
+    }
+
+    static void dispose_separate(internal::SharedPtrControl *control, void *ptr)
     {
-        return _counter;
+        delete control;
+        delete static_cast<T *>(ptr);
+    }
+
+    static void dispose_embedded(internal::SharedPtrControl *control, void *ptr)
+    {
+        delete static_cast<T *>(ptr);
+    }
+
+    static void dispose_inplace(internal::SharedPtrControl *control, void *ptr)
+    {
+        static_cast<T *>(ptr)->~T();
+        delete static_cast<InplaceControl *>(control);
     }
 
     /**
@@ -276,9 +410,8 @@ private:
     void decrement_counter()
     {
         if (_ptr != nullptr) {
-            if (core_util_atomic_decr_u32(_counter, 1) == 0) {
-                delete _counter;
-                delete _ptr;
+            if (core_util_atomic_decr_u32(&_control->counter, 1) == 0) {
+                _control->dispose(_control, _ptr);
             }
         }
     }
@@ -288,9 +421,36 @@ private:
     T *_ptr;
 
     // Pointer to shared reference counter
-    uint32_t *_counter;
+    internal::SharedPtrControl *_control;
 };
 
+/** Create an object managed by a SharedPtr with a single allocation.
+  *
+  * The object and its reference count share one heap block, halving the
+  * number of allocations compared to SharedPtr<T>(new T(args...)).
+  *
+  * @code
+  * #include "platform/SharedPtr.h"
+  *
+  * struct MyStruct {
+  *     MyStruct(int a) : a(a) {}
+  *     int a;
+  * };
+  *
+  * void test() {
+  *     SharedPtr<MyStruct> ptr = mbed::make_shared<MyStruct>(42);
+  * }
+  * @endcode
+  *
+  * @param args Arguments forwarded to the constructor of T
+  * @return SharedPtr managing the new object
+  */
+template <class T, class... Args>
+SharedPtr<T> make_shared(Args &&... args)
+{
+    return SharedPtr<T>::make(std::is_base_of<RefCounted, T>(), std::forward<Args>(args)...);
+}
+
 /** Non-member relational operators.
   */
 template <class T, class U>
@@ -22,6 +22,7 @@
 #include <new>
 #include "platform/mbed_assert.h"
 #include "platform/mbed_atomic.h"
+#include "platform/mbed_toolchain.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #endif
@@ -124,19 +125,13 @@ struct SingletonPtr {
      */
     T *get() const
     {
-        T *p = core_util_atomic_load(&_ptr);
+        // Once initialized this is a plain load. The object is published by a
+        // release store, and every access through the pointer depends on the
+        // loaded value, which orders it after the load without a barrier.
+        T *p = core_util_atomic_load_explicit(&_ptr, mbed_memory_order_relaxed);
         if (p == NULL) {
-            singleton_lock();
-            p = _ptr;
-            if (p == NULL) {
-                p = new (_data) T();
-                core_util_atomic_store(&_ptr, p);
-            }
-            singleton_unlock();
+            p = _init();
         }
-        // _ptr was not zero initialized or was
-        // corrupted if this assert is hit
-        MBED_ASSERT(p == reinterpret_cast<T *>(&_data));
         return p;
     }
 
@@ -195,6 +190,22 @@ struct SingletonPtr {
         }
     }
 
+    // Construct the singleton on first use
+    MBED_NOINLINE T *_init() const
+    {
+        singleton_lock();
+        T *p = _ptr;
+        if (p == NULL) {
+            p = new (_data) T();
+            core_util_atomic_store_explicit(&_ptr, p, mbed_memory_order_release);
+        }
+        singleton_unlock();
+        // _ptr was not zero initialized or was
+        // corrupted if this assert is hit
+        MBED_ASSERT(p == reinterpret_cast<T *>(&_data));
+        return p;
+    }
+
     mutable T *_ptr;
 #if __cplusplus >= 201103L
     // Align data appropriately
@@ -205,6 +216,73 @@ struct SingletonPtr {
 #endif
 };
 
+
+/** Utility class for a singleton constructed at start-up
+ *
+ * Has the interface of SingletonPtr, but the object is constructed by the
+ * C++ static initializers, on the main thread before main() is called. get()
+ * is then only the address of the object, with no check at all, which suits
+ * singletons used on hot paths.
+ *
+ * @note Synchronization level: Thread safe
+ *
+ * @note: Unlike SingletonPtr, the object is always constructed and linked
+ * in. It must not be used by the constructors of other non-local objects,
+ * which may run before its own.
+ */
+template <class T>
+struct EagerSingletonPtr {
+
+    EagerSingletonPtr()
+    {
+        new (_data) T();
+    }
+
+    /** Get a pointer to the underlying singleton
+     *
+     * @returns
+     *   A pointer to the singleton
+     */
+    T *get() const
+    {
+        return reinterpret_cast<T *>(&_data);
+    }
+
+    /** Get a pointer to the underlying singleton
+     *
+     * @returns
+     *   A pointer to the singleton
+     */
+    T *operator->() const
+    {
+        return get();
+    }
+
+    /** Get a reference to the underlying singleton
+     *
+     * @returns
+     *   A reference to the singleton
+     */
+    T &operator*() const
+    {
+        return *get();
+    }
+
+    /** Get a pointer to the underlying singleton
+     *
+     * Same as get(), for compatibility with SingletonPtr
+     *
+     * @returns
+     *   A pointer to the singleton
+     */
+    T *get_no_init() const
+    {
+        return get();
+    }
+
+    alignas(T) mutable char _data[sizeof(T)];
+};
+
 #endif
 /**@}*/
 
@@ -1126,13 +1126,13 @@ inline void core_util_atomic_store(T **valuePtr, T *val) noexcept
 template<typename T>
 inline void core_util_atomic_store_explicit(T *volatile *valuePtr, T *val, mbed_memory_order order) noexcept
 {
-    core_util_atomic_store_ptr((void *volatile *) valuePtr, val, order);
+    core_util_atomic_store_explicit_ptr((void *volatile *) valuePtr, val, order);
 }
 
 template<typename T>
 inline void core_util_atomic_store_explicit(T **valuePtr, T *val, mbed_memory_order order) noexcept
 {
-    core_util_atomic_store_ptr((void **) valuePtr, val, order);
+    core_util_atomic_store_explicit_ptr((void **) valuePtr, val, order);
 }
 
 DO_MBED_ATOMIC_STORE_TEMPLATE(uint8_t,  u8)
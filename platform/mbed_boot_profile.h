@@ -0,0 +1,81 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOOT_PROFILE_H
+#define MBED_BOOT_PROFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_boot_profile Boot profile functions
+ * @{
+ */
+
+/** Boot phases, in the order they complete */
+typedef enum {
+    MBED_BOOT_PHASE_INIT,           /**< mbed_init() entered, the time reference */
+    MBED_BOOT_PHASE_SDK_INIT,       /**< Target SDK initialized by mbed_sdk_init() */
+    MBED_BOOT_PHASE_RTOS_START,     /**< RTOS kernel started, not reached without RTOS */
+    MBED_BOOT_PHASE_CONSTRUCTORS,   /**< C++ static constructors run */
+    MBED_BOOT_PHASE_MAIN,           /**< main() about to be called */
+    MBED_BOOT_PHASE_COUNT
+} mbed_boot_phase_t;
+
+/** Time each boot phase was reached */
+typedef struct {
+    uint32_t reached;                           /**< Mask of the phases reached, bit n for phase n */
+    uint32_t time_us[MBED_BOOT_PHASE_COUNT];    /**< Time since mbed_init() each phase was reached */
+} mbed_boot_profile_t;
+
+/** Get the boot profile
+ *
+ * The boot phases are timed with the DWT cycle counter at the core clock
+ * frequency of each phase, on cores without one no phase is recorded.
+ * Time spent before mbed_init(), in the reset handler and SystemInit(), is
+ * not included.
+ *
+ * @return Boot profile, all zero unless platform.boot-profile-enabled is set
+ */
+const mbed_boot_profile_t *mbed_boot_profile_get(void);
+
+/** Record the time a boot phase is reached
+ *
+ * Called by the boot code.
+ *
+ * @param phase Phase reached
+ */
+#if MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED
+void mbed_boot_profile_mark(mbed_boot_phase_t phase);
+#else
+#define mbed_boot_profile_mark(phase) (void)0
+#endif
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HEAP_H
+#define MBED_HEAP_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_heap heap functions
+ *
+ * When the configuration option platform.heap-tlsf-enabled is set, the
+ * newlib allocator behind malloc, realloc, calloc, memalign and free is
+ * replaced by a two-level segregated fit (TLSF) allocator. Allocation and
+ * free take a bounded time and the heap fragments less under long running
+ * mixed size workloads. The TLSF heap is only available with GCC_ARM.
+ *
+ * The TLSF heap starts with the default heap region of the target, and
+ * further regions, such as external SDRAM, can be added at run time.
+ * Heap statistics, if enabled, cover all regions.
+ *
+ * @{
+ */
+
+/**
+ * Add a region of memory to the heap
+ *
+ * The region does not need to be contiguous with other heap regions, and
+ * must stay reserved for the heap for the lifetime of the application.
+ *
+ * @param start     Start of the region
+ * @param size      Size of the region in bytes
+ * @return          0 on success, -1 if the region is too small or the
+ *                  TLSF heap is not enabled
+ */
+int mbed_heap_add_region(void *start, size_t size);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
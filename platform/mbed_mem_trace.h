@@ -162,6 +162,79 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/* Value of the 'sync' field of every binary trace record */
+#define MBED_MEM_TRACE_RECORD_SYNC      0x544D
+
+/**
+ * Fixed-size record stored by the binary tracer. All fields are little
+ * endian on the supported targets; pointers are stored as 32-bit values.
+ */
+typedef struct {
+    uint16_t sync;          /**< MBED_MEM_TRACE_RECORD_SYNC, to find record boundaries in a stream */
+    uint8_t op;             /**< Operation, MBED_MEM_TRACE_MALLOC to MBED_MEM_TRACE_FREE */
+    uint8_t seq;            /**< Sequence number, incremented for every operation including dropped ones */
+    uint32_t timestamp;     /**< Value of the microsecond ticker when the operation was traced */
+    uint32_t res;           /**< Result of the operation, 0 for free */
+    uint32_t ptr;           /**< 'ptr' argument of realloc and free, 0 otherwise */
+    uint32_t size;          /**< Requested size, nmemb * size for calloc, 0 for free */
+    uint32_t caller;        /**< Caller of the operation */
+} mbed_mem_trace_record_t;
+
+/**
+ * Set the RAM ring buffer used by the binary tracer.
+ * Must be called before 'mbed_mem_trace_binary_callback' is installed with
+ * 'mbed_mem_trace_set_callback'. Any records already buffered are discarded.
+ * @param records the buffer of records, or NULL to stop buffering.
+ * @param count the number of records in the buffer.
+ */
+void mbed_mem_trace_binary_set_buffer(mbed_mem_trace_record_t *records, size_t count);
+
+/**
+ * Binary memory trace callback. DO NOT CALL DIRECTLY. It is meant to be used
+ * as the argument of 'mbed_mem_trace_set_callback'.
+ * Instead of formatting text, the callback stores one 'mbed_mem_trace_record_t'
+ * per operation into the buffer given to 'mbed_mem_trace_binary_set_buffer',
+ * so it is cheap enough to leave enabled. If the buffer is full, the record is
+ * dropped and counted; the gap also shows in the sequence numbers.
+ * The records are drained with 'mbed_mem_trace_binary_read', typically from a
+ * low priority thread that writes them to a UART or SWO channel, for decoding
+ * on the host with tools/mem_trace_decode.py:
+ * @code
+ * static mbed_mem_trace_record_t trace_buffer[256];
+ *
+ * void trace_drain()
+ * {
+ *     mbed_mem_trace_record_t batch[8];
+ *     while (true) {
+ *         size_t count = mbed_mem_trace_binary_read(batch, 8);
+ *         if (count != 0) {
+ *             trace_port.write(batch, count * sizeof(batch[0]));
+ *         } else {
+ *             ThisThread::sleep_for(10ms);
+ *         }
+ *     }
+ * }
+ *
+ * mbed_mem_trace_binary_set_buffer(trace_buffer, 256);
+ * mbed_mem_trace_set_callback(mbed_mem_trace_binary_callback);
+ * @endcode
+ */
+void mbed_mem_trace_binary_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Take the oldest records out of the binary tracer buffer.
+ * @param records the buffer to copy the records to.
+ * @param count the maximum number of records to copy.
+ * @return the number of records copied.
+ */
+size_t mbed_mem_trace_binary_read(mbed_mem_trace_record_t *records, size_t count);
+
+/**
+ * Get the number of records dropped because the binary tracer buffer was full.
+ * @return the number of dropped records since the buffer was set.
+ */
+uint32_t mbed_mem_trace_binary_dropped(void);
+
 /** @}*/
 
 #ifdef __cplusplus
@@ -49,10 +49,24 @@ struct pollfh {
  * @param nfhs    number of file handles
  * @param timeout timer value to timeout or -1 for loop forever
  *
+ * @note If every file handle wakes poll() (see FileHandle::wakes_poll()), the
+ * calling thread sleeps until one of them changes state or the timeout expires.
+ * Otherwise the file handles are checked every millisecond.
+ *
  * @return number of file handles selected (for which revents is non-zero). 0 if timed out with nothing selected. -1 for error.
  */
 int poll(pollfh fhs[], unsigned nfhs, int timeout);
 
+/** Wake up threads blocked in poll()
+ *
+ * FileHandles that return true from FileHandle::wakes_poll() must call this
+ * whenever their poll events may have changed. Blocked poll() calls then
+ * check their file handles again.
+ *
+ * This function is IRQ and thread safe.
+ */
+void poll_wake();
+
 /**@}*/
 
 /**@}*/
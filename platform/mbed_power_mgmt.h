@@ -90,6 +90,24 @@ extern "C" {
  *
  */
 
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+
+#define SLEEP_MANAGER_LOCK_DEEP_SLEEP() \
+    sleep_manager_lock_deep_sleep_tagged(MBED_FILENAME)
+
+#define SLEEP_MANAGER_UNLOCK_DEEP_SLEEP() \
+    sleep_manager_unlock_deep_sleep_tagged(MBED_FILENAME)
+
+#else
+
+#define SLEEP_MANAGER_LOCK_DEEP_SLEEP() \
+    sleep_manager_lock_deep_sleep_internal()
+
+#define SLEEP_MANAGER_UNLOCK_DEEP_SLEEP() \
+    sleep_manager_unlock_deep_sleep_internal()
+
+#endif // MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+
 #ifdef MBED_SLEEP_TRACING_ENABLED
 
 void sleep_tracker_lock(const char *const filename, int line);
@@ -98,24 +116,24 @@ void sleep_tracker_unlock(const char *const filename, int line);
 #define sleep_manager_lock_deep_sleep()              \
     do                                               \
     {                                                \
-        sleep_manager_lock_deep_sleep_internal();    \
+        SLEEP_MANAGER_LOCK_DEEP_SLEEP();             \
         sleep_tracker_lock(MBED_FILENAME, __LINE__); \
     } while (0);
 
 #define sleep_manager_unlock_deep_sleep()              \
     do                                                 \
     {                                                  \
-        sleep_manager_unlock_deep_sleep_internal();    \
+        SLEEP_MANAGER_UNLOCK_DEEP_SLEEP();             \
         sleep_tracker_unlock(MBED_FILENAME, __LINE__); \
     } while (0);
 
 #else
 
 #define sleep_manager_lock_deep_sleep() \
-    sleep_manager_lock_deep_sleep_internal()
+    SLEEP_MANAGER_LOCK_DEEP_SLEEP()
 
 #define sleep_manager_unlock_deep_sleep() \
-    sleep_manager_unlock_deep_sleep_internal()
+    SLEEP_MANAGER_UNLOCK_DEEP_SLEEP()
 
 #endif // MBED_SLEEP_TRACING_ENABLED
 
@@ -142,6 +160,33 @@ void sleep_manager_lock_deep_sleep_internal(void);
  */
 void sleep_manager_unlock_deep_sleep_internal(void);
 
+/** Lock the deep sleep mode on behalf of a named holder
+ *
+ * Behaves like sleep_manager_lock_deep_sleep_internal(). If
+ * platform.deep-sleep-stats-slots is non-zero, the lock is also recorded
+ * against @a tag, see mbed_stats_deep_sleep_lock_get_each().
+ *
+ * When deep sleep statistics are enabled, sleep_manager_lock_deep_sleep()
+ * uses the name of the calling file as the tag.
+ *
+ * This function is IRQ and thread safe
+ *
+ * @param tag Name of the lock holder, such as a driver class name. The
+ *            string must remain valid for the lifetime of the program.
+ */
+void sleep_manager_lock_deep_sleep_tagged(const char *tag);
+
+/** Unlock the deep sleep mode on behalf of a named holder
+ *
+ * Use unlocking in pair with sleep_manager_lock_deep_sleep_tagged(), with
+ * the same tag.
+ *
+ * This function is IRQ and thread safe
+ *
+ * @param tag Name of the lock holder
+ */
+void sleep_manager_unlock_deep_sleep_tagged(const char *tag);
+
 /** Get the status of deep sleep allowance for a target
  *
  * @return true if a target can go to deepsleep, false otherwise
@@ -201,6 +246,21 @@ static inline void sleep(void)
 #endif /* DEVICE_SLEEP */
 }
 
+/** Set how late the OS may wake up from a timed sleep
+ *
+ * With tickless RTOS, or when sleeping without RTOS, the system timer wakes
+ * up for the earliest thread timeout or delay. If a driver timer, such as a
+ * Timeout, is already due no more than @a slack_us after that time, the
+ * wake-up is delayed to coincide with it, so the system wakes once rather
+ * than twice. Threads waiting with a timeout may then resume up to
+ * @a slack_us late.
+ *
+ * The initial value is set by the platform.os-timer-slack configuration option.
+ *
+ * @param slack_us how late in microseconds a wake-up may be, 0 to wake exactly on time
+ */
+void sleep_manager_set_os_timer_slack(uint32_t slack_us);
+
 /** Provides the time spent in sleep mode since boot.
  *
  *  @return  Time spent in sleep
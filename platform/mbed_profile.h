@@ -0,0 +1,192 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_PROFILE_H
+#define MBED_PROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_preprocessor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_profile Profiling functions
+ * @{
+ */
+
+/** Statistics of a profiled code region, kept by the probe itself */
+typedef struct mbed_profile_site {
+    const char *name;                   /**< Name given to the probe */
+    uint32_t count;                     /**< Number of times the region ran */
+    uint32_t min;                       /**< Shortest run, in timestamp ticks */
+    uint32_t max;                       /**< Longest run, in timestamp ticks */
+    uint64_t total;                     /**< Time of all runs together, in timestamp ticks */
+    struct mbed_profile_site *next;     /**< Next probe that has run, for the table */
+    uint8_t linked;                     /**< Set once the probe is in the table */
+} mbed_profile_site_t;
+
+#if MBED_CONF_PLATFORM_PROFILING_ENABLED || defined(DOXYGEN_ONLY)
+
+/** Read the profiling timestamp
+ *
+ * The DWT cycle counter, or the microsecond ticker on cores without one.
+ *
+ * @return Current timestamp in ticks of mbed_profile_frequency()
+ */
+uint32_t mbed_profile_now(void);
+
+/** Add a run of a profiled region to its probe
+ *
+ * The first probe to run also starts the cycle counter, so its first run is
+ * not counted.
+ *
+ * @param site  Probe of the region
+ * @param start Timestamp the region started at
+ */
+void mbed_profile_record(mbed_profile_site_t *site, uint32_t start);
+
+/** Start profiling a region of C code
+ *
+ * Declares the probe @p site and the start time of the region. Regions can
+ * nest and overlap, as long as each has its own probe.
+ *
+ * @code
+ * MBED_PROFILE_START(rx_probe, "emac rx");
+ * receive_frame();
+ * MBED_PROFILE_STOP(rx_probe);
+ * @endcode
+ *
+ * @param site Name of the probe variable
+ * @param name Name of the region in the table
+ */
+#define MBED_PROFILE_START(site, name) \
+    static mbed_profile_site_t site = { name }; \
+    uint32_t site##_start = mbed_profile_now()
+
+/** Stop profiling a region of C code started with MBED_PROFILE_START
+ *
+ * @param site Name of the probe variable
+ */
+#define MBED_PROFILE_STOP(site) mbed_profile_record(&site, site##_start)
+
+#else
+
+#define MBED_PROFILE_START(site, name) (void)0
+#define MBED_PROFILE_STOP(site) (void)0
+
+#endif
+
+/** Get the frequency of the profiling timestamp
+ *
+ * @return Core clock frequency with the cycle counter, 1000000 with the
+ *         microsecond ticker, or 0 unless platform.profiling-enabled is set
+ */
+uint32_t mbed_profile_frequency(void);
+
+/** Get the statistics of each probe that has run
+ *
+ * @param stats Array of statistics to fill, the next fields point into the table
+ * @param count Number of entries in the array
+ * @return Number of entries filled, 0 unless platform.profiling-enabled is set
+ */
+size_t mbed_profile_get_each(mbed_profile_site_t *stats, size_t count);
+
+/** Clear the statistics of every probe, keeping them in the table
+ */
+void mbed_profile_reset(void);
+
+/**@}*/
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/** Profile the enclosing scope into a probe, see MBED_PROFILE
+ *
+ * Does nothing unless platform.profiling-enabled is set.
+ */
+class ProfileScope {
+public:
+    /** Start profiling
+     *
+     * @param site Probe of the scope
+     */
+    ProfileScope(mbed_profile_site_t *site)
+#if MBED_CONF_PLATFORM_PROFILING_ENABLED
+        : _site(site), _start(mbed_profile_now())
+    {
+    }
+
+    /** Stop profiling and record the time of the scope
+     */
+    ~ProfileScope()
+    {
+        mbed_profile_record(_site, _start);
+    }
+
+private:
+    mbed_profile_site_t *_site;
+    uint32_t _start;
+#else
+    {
+        (void)site;
+    }
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+/** Profile the rest of the enclosing C++ scope
+ *
+ * Compiles to nothing unless platform.profiling-enabled is set, so probes can
+ * be left in hot paths. The statistics are read with mbed_profile_get_each().
+ *
+ * @code
+ * void EMACDriver::rx_isr()
+ * {
+ *     MBED_PROFILE("emac rx isr");
+ *     ...
+ * }
+ * @endcode
+ *
+ * @param name Name of the region in the table
+ */
+#if MBED_CONF_PLATFORM_PROFILING_ENABLED
+#define MBED_PROFILE(name) \
+    static mbed_profile_site_t MBED_CONCAT(_mbed_profile_site_, __LINE__) = { name }; \
+    mbed::ProfileScope MBED_CONCAT(_mbed_profile_scope_, __LINE__)(&MBED_CONCAT(_mbed_profile_site_, __LINE__))
+#else
+#define MBED_PROFILE(name) (void)0
+#endif
+
+#endif
+
+#endif
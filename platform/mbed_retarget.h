@@ -68,6 +68,7 @@ typedef unsigned int  gid_t;    ///< Group ID
 #define O_RDWR   2        ///< Open for reading and writing
 #define O_NONBLOCK 0x0004 ///< Non-blocking mode
 #define O_APPEND   0x0008 ///< Set file offset to end of file prior to each write
+#define O_DIRECT   0x0010 ///< Write whole sectors straight to storage, leaving syncs to fsync() and close()
 #define O_CREAT    0x0200 ///< Create file if it does not exist
 #define O_TRUNC    0x0400 ///< Truncate file to zero length
 #define O_EXCL     0x0800 ///< Fail if file exists
@@ -183,6 +184,15 @@ FileHandle *mbed_override_console(int fd);
  *           possible if it's not open with current implementation).
  */
 FileHandle *mbed_file_handle(int fd);
+
+/** Get the number of bytes of console output dropped
+ *
+ * With platform.stdio-async set, output that does not fit in the console
+ * buffer is dropped unless platform.stdio-async-block-on-overflow is set.
+ *
+ * @return Bytes dropped since startup, 0 without asynchronous console output
+ */
+uint32_t mbed_console_dropped_bytes();
 }
 
 typedef mbed::DirHandle DIR;
@@ -564,6 +574,12 @@ struct pollfd {
     short revents;
 };
 
+/* sys/uio.h defines */
+struct iovec {
+    void *iov_base;     ///< Start of the buffer
+    size_t iov_len;     ///< Size of the buffer in bytes
+};
+
 /* POSIX-compatible I/O functions */
 #if __cplusplus
 extern "C" {
@@ -585,6 +601,8 @@ extern "C" {
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
     off_t lseek(int fildes, off_t offset, int whence);
     int ftruncate(int fildes, off_t length);
+    ssize_t readv(int fildes, const struct iovec *iov, int iovcnt);
+    ssize_t writev(int fildes, const struct iovec *iov, int iovcnt);
     int fstat(int fildes, struct stat *st);
     int fcntl(int fildes, int cmd, ...);
     int poll(struct pollfd fds[], nfds_t nfds, int timeout);
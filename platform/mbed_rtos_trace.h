@@ -0,0 +1,145 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_RTOS_TRACE_H
+#define MBED_RTOS_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * enum Event types recorded by the RTOS tracer
+ */
+enum {
+    MBED_RTOS_TRACE_START,              /**< Tracing started, object is the timestamp frequency in Hz */
+    MBED_RTOS_TRACE_THREAD_SWITCH,      /**< Thread switched in */
+    MBED_RTOS_TRACE_ISR_ENTER,          /**< Interrupt handler entered, object is the exception number */
+    MBED_RTOS_TRACE_ISR_EXIT,           /**< Interrupt handler exited, object is the exception number */
+    MBED_RTOS_TRACE_MUTEX_ACQUIRED,     /**< Mutex locked */
+    MBED_RTOS_TRACE_MUTEX_RELEASED,     /**< Mutex unlocked */
+    MBED_RTOS_TRACE_MUTEX_BLOCKED,      /**< Running thread waits for a mutex */
+    MBED_RTOS_TRACE_SEMAPHORE_ACQUIRED, /**< Semaphore token taken */
+    MBED_RTOS_TRACE_SEMAPHORE_RELEASED, /**< Semaphore token given */
+    MBED_RTOS_TRACE_SEMAPHORE_BLOCKED,  /**< Running thread waits for a semaphore */
+    MBED_RTOS_TRACE_QUEUE_PUT,          /**< Message put in a queue */
+    MBED_RTOS_TRACE_QUEUE_GET,          /**< Message taken from a queue */
+    MBED_RTOS_TRACE_QUEUE_BLOCKED,      /**< Running thread waits for a queue */
+    MBED_RTOS_TRACE_EVENT_DISPATCH,     /**< EventQueue callback started, object is the callback */
+    MBED_RTOS_TRACE_EVENT_DONE,         /**< EventQueue callback returned, object is the callback */
+    MBED_RTOS_TRACE_USER = 0x80         /**< First event type free for the application */
+};
+
+/**
+ * \defgroup platform_rtos_trace rtos_trace functions
+ * @{
+ */
+
+/* Value of the 'sync' field of every RTOS trace record */
+#define MBED_RTOS_TRACE_RECORD_SYNC     0x5452
+
+/**
+ * Fixed-size record written by the RTOS tracer. All fields are little
+ * endian on the supported targets; pointers are stored as 32-bit values.
+ */
+typedef struct {
+    uint16_t sync;          /**< MBED_RTOS_TRACE_RECORD_SYNC, to find record boundaries in a stream */
+    uint8_t event;          /**< Event type, MBED_RTOS_TRACE_START to MBED_RTOS_TRACE_EVENT_DONE or a user type */
+    uint8_t seq;            /**< Sequence number, incremented for every event including dropped ones */
+    uint32_t timestamp;     /**< Cycle counter, or microsecond ticker on cores without one */
+    uint32_t object;        /**< Thread, mutex, semaphore or queue ID the event is about */
+} mbed_rtos_trace_record_t;
+
+#if defined(MBED_RTOS_TRACING_ENABLED) || defined(DOXYGEN_ONLY)
+
+/**
+ * Start the RTOS tracer.
+ *
+ * With a buffer, records are kept in a RAM ring to be drained with
+ * 'mbed_rtos_trace_read', like the binary memory tracer. Without one, each
+ * record is written straight to the ITM stimulus port set by
+ * platform.rtos-trace-itm-port, and the hardware exception trace of the DWT
+ * is enabled to show every interrupt handler without software hooks.
+ *
+ * Thread switches, mutex, semaphore and message queue operations and
+ * EventQueue dispatches are then traced, for decoding on the host with
+ * tools/rtos_trace_decode.py:
+ * @code
+ * int main()
+ * {
+ *     // SWO capture, decode with: rtos_trace_decode.py --itm 1 swo.bin
+ *     mbed_rtos_trace_start(NULL, 0);
+ * }
+ * @endcode
+ *
+ * @param records the buffer of records, or NULL to write to ITM.
+ * @param count the number of records in the buffer.
+ */
+void mbed_rtos_trace_start(mbed_rtos_trace_record_t *records, size_t count);
+
+/**
+ * Stop the RTOS tracer. Records still in the buffer can be read.
+ */
+void mbed_rtos_trace_stop(void);
+
+/**
+ * Record an event. Callable from any context, including the kernel and
+ * interrupt handlers, which the application can trace with
+ * MBED_RTOS_TRACE_ISR_ENTER and MBED_RTOS_TRACE_ISR_EXIT when writing to RAM.
+ * @param event the event type.
+ * @param object the object the event is about.
+ */
+void mbed_rtos_trace(uint8_t event, uint32_t object);
+
+/**
+ * Take the oldest records out of the RAM buffer.
+ * @param records the buffer to copy the records to.
+ * @param count the maximum number of records to copy.
+ * @return the number of records copied.
+ */
+size_t mbed_rtos_trace_read(mbed_rtos_trace_record_t *records, size_t count);
+
+/**
+ * Get the number of records dropped because the RAM buffer was full.
+ * @return the number of dropped records since tracing started.
+ */
+uint32_t mbed_rtos_trace_dropped(void);
+
+/** Record an event, compiled out unless tracing is enabled */
+#define MBED_RTOS_TRACE(event, object) mbed_rtos_trace((event), (uint32_t)(uintptr_t)(object))
+
+#else
+
+#define MBED_RTOS_TRACE(event, object) ((void)0)
+
+#endif // defined(MBED_RTOS_TRACING_ENABLED) || defined(DOXYGEN_ONLY)
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_RTOS_TRACE_H
@@ -0,0 +1,378 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_STATIC_PRINTF_H
+#define MBED_STATIC_PRINTF_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <limits.h>
+#include <type_traits>
+#include "platform/source/minimal-printf/mbed_printf_implementation.h"
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_static_printf Compile-time formatted printing
+ * @{
+ */
+
+/** Print to stdout with a format string that is parsed at compile time
+ *
+ *  Behaves like printf with the minimal-printf feature set, but the format
+ *  must be a string literal. The format is split into literal text and
+ *  conversions while compiling, so each call goes straight to the integer,
+ *  hexadecimal and string converters it needs, and the linker can drop the
+ *  converters a program never uses. Arguments are checked against their
+ *  conversions at compile time.
+ *
+ *  Flags and width are ignored, as in minimal-printf. Precision is honoured
+ *  for %s. Length modifiers are accepted but not needed, the size of each
+ *  argument comes from its type. A '*' width or precision is not supported.
+ *
+ *  @code
+ *  MBED_STATIC_PRINTF("sample %u: %d mV\n", index, millivolts);
+ *  @endcode
+ *
+ *  @param FORMAT   Format string literal
+ *  @param ...      Arguments for the conversions in FORMAT
+ *  @return         Number of characters written, or EOF on error
+ */
+#define MBED_STATIC_PRINTF(FORMAT, ...) \
+    ([&]() { \
+        struct mbed_static_printf_format { \
+            static constexpr const char *str() { return FORMAT; } \
+        }; \
+        return ::mbed::static_printf<mbed_static_printf_format>(__VA_ARGS__); \
+    }())
+
+/** Print to a buffer with a format string that is parsed at compile time
+ *
+ *  The snprintf counterpart of MBED_STATIC_PRINTF. The output is always null
+ *  terminated if size is not 0.
+ *
+ *  @param BUFFER   Buffer to print to
+ *  @param SIZE     Size of the buffer in bytes, including the terminator
+ *  @param FORMAT   Format string literal
+ *  @param ...      Arguments for the conversions in FORMAT
+ *  @return         Number of characters that would have been written if the
+ *                  buffer were large enough, not counting the terminator
+ */
+#define MBED_STATIC_SNPRINTF(BUFFER, SIZE, FORMAT, ...) \
+    ([&]() { \
+        struct mbed_static_printf_format { \
+            static constexpr const char *str() { return FORMAT; } \
+        }; \
+        return ::mbed::static_snprintf<mbed_static_printf_format>(BUFFER, SIZE, ##__VA_ARGS__); \
+    }())
+
+/** @}*/
+
+/** @}*/
+
+namespace mbed {
+
+namespace internal {
+
+/* Output state, matching the arguments of the minimal-printf converters */
+struct static_printf_output {
+    char *buffer;
+    size_t length;
+    int result;
+    FILE *stream;
+};
+
+/* Index of the next '%' or of the terminator */
+constexpr size_t static_printf_literal_end(const char *format, size_t index)
+{
+    while (format[index] != '\0' && format[index] != '%') {
+        index++;
+    }
+    return index;
+}
+
+/* Parsed conversion specification, starting at a '%' */
+struct static_printf_spec {
+    size_t end;         /* index following the specification */
+    char conversion;    /* conversion character, '%' to print a '%' */
+    int precision;      /* precision, INT_MAX if not given */
+};
+
+constexpr bool static_printf_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/* Same grammar as mbed_minimal_formatted_string */
+constexpr static_printf_spec static_printf_parse(const char *format, size_t index)
+{
+    size_t next = index + 1;
+
+    /* skip and ignore flags */
+    if (format[next] == '-' || format[next] == '+' || format[next] == ' ' ||
+            format[next] == '#' || format[next] == '0') {
+        next++;
+    }
+
+    /* skip and ignore width */
+    if (format[next] == '*') {
+        return static_printf_spec{next + 1, '*', INT_MAX};
+    }
+    while (static_printf_is_digit(format[next])) {
+        next++;
+    }
+
+    /* precision */
+    int precision = INT_MAX;
+    if (format[next] == '.') {
+        next++;
+        if (format[next] == '*') {
+            return static_printf_spec{next + 1, '*', INT_MAX};
+        }
+        precision = 0;
+        while (static_printf_is_digit(format[next])) {
+            precision = precision * 10 + (format[next] - '0');
+            next++;
+        }
+    }
+
+    /* skip length modifiers, the argument type gives the size */
+    if ((format[next] == 'h' && format[next + 1] == 'h') ||
+            (format[next] == 'l' && format[next + 1] == 'l')) {
+        next += 2;
+    } else if (format[next] == 'h' || format[next] == 'l' || format[next] == 'j' ||
+               format[next] == 'z' || format[next] == 't' || format[next] == 'L') {
+        next++;
+    }
+
+    switch (format[next]) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'c':
+        case 's':
+        case 'p':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            return static_printf_spec{next + 1, format[next], precision};
+        case '%':
+            return static_printf_spec{next + 1, '%', precision};
+        default:
+            /* unrecognised, print the '%' and carry on after it */
+            return static_printf_spec{index + 1, '%', precision};
+    }
+}
+
+template <char Conversion>
+using static_printf_conversion = std::integral_constant<char, Conversion>;
+
+/* Integer conversions. Unary + applies the usual promotions, so char, bool
+   and unscoped enums are accepted like they are by printf. */
+template <typename T>
+using static_printf_promoted = decltype(+std::declval<T>());
+
+template <typename T>
+void static_printf_check_integer()
+{
+    static_assert(std::is_integral<static_printf_promoted<T>>::value,
+                  "Integer conversion requires an integer argument");
+    static_assert(sizeof(static_printf_promoted<T>) <= sizeof(MBED_UNSIGNED_STORAGE),
+                  "64-bit integers require platform.minimal-printf-enable-64-bit");
+}
+
+template <typename T>
+MBED_SIGNED_STORAGE static_printf_signed(T value)
+{
+    static_printf_check_integer<T>();
+    using P = static_printf_promoted<T>;
+    return static_cast<typename std::make_signed<P>::type>(+value);
+}
+
+template <typename T>
+MBED_UNSIGNED_STORAGE static_printf_unsigned(T value)
+{
+    static_printf_check_integer<T>();
+    using P = static_printf_promoted<T>;
+    return static_cast<typename std::make_unsigned<P>::type>(+value);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'d'>, T value)
+{
+    mbed_minimal_formatted_string_signed(out.buffer, out.length, &out.result, static_printf_signed(value), out.stream);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'i'>, T value)
+{
+    mbed_minimal_formatted_string_signed(out.buffer, out.length, &out.result, static_printf_signed(value), out.stream);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'u'>, T value)
+{
+    mbed_minimal_formatted_string_unsigned(out.buffer, out.length, &out.result, static_printf_unsigned(value), out.stream);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'x'>, T value)
+{
+    mbed_minimal_formatted_string_hexadecimal(out.buffer, out.length, &out.result, static_printf_unsigned(value), out.stream, false);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'X'>, T value)
+{
+    mbed_minimal_formatted_string_hexadecimal(out.buffer, out.length, &out.result, static_printf_unsigned(value), out.stream, true);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'c'>, T value)
+{
+    static_printf_check_integer<T>();
+    mbed_minimal_putchar(out.buffer, out.length, &out.result, static_cast<char>(value), out.stream);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'s'>, T value)
+{
+    static_assert(std::is_convertible<T, const char *>::value, "%s requires a string argument");
+    mbed_minimal_formatted_string_string(out.buffer, out.length, &out.result, value, Precision, out.stream);
+}
+
+template <int Precision, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<'p'>, T value)
+{
+    static_assert(std::is_pointer<T>::value || std::is_null_pointer<T>::value, "%p requires a pointer argument");
+    mbed_minimal_formatted_string_void_pointer(out.buffer, out.length, &out.result, value, out.stream);
+}
+
+/* All floating point conversions are treated as %f, as in minimal-printf */
+template <int Precision, char Conversion, typename T>
+void static_printf_arg(static_printf_output &out, static_printf_conversion<Conversion>, T value)
+{
+    static_assert(Conversion == 'f' || Conversion == 'F' || Conversion == 'g' || Conversion == 'G',
+                  "Argument does not match its conversion");
+    static_assert(std::is_arithmetic<T>::value, "Floating point conversion requires a number");
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+    mbed_minimal_formatted_string_double(out.buffer, out.length, &out.result, value, out.stream);
+#else
+    (void)out;
+    (void)value;
+    static_assert(sizeof(T) == 0, "Floating point requires platform.minimal-printf-enable-floating-point");
+#endif
+}
+
+/* Prints Format from Index on, consuming one argument per conversion */
+template <typename Format, size_t Index>
+struct static_printf_step {
+    static constexpr size_t literal_end = static_printf_literal_end(Format::str(), Index);
+    static constexpr bool at_end = Format::str()[literal_end] == '\0';
+    static constexpr static_printf_spec spec = at_end
+                                               ? static_printf_spec{literal_end, '\0', INT_MAX}
+                                               : static_printf_parse(Format::str(), literal_end);
+    static constexpr size_t next = spec.end;
+    static constexpr char conversion = spec.conversion;
+    static constexpr int precision = spec.precision;
+
+    static_assert(conversion != '*', "'*' width and precision are not supported, use a constant");
+
+    enum action {
+        done,
+        percent,
+        argument
+    };
+    using action_tag = std::integral_constant<action, at_end ? done : conversion == '%' ? percent : argument>;
+
+    template <typename... Args>
+    static void print(static_printf_output &out, Args... args)
+    {
+        if (literal_end != Index) {
+            mbed_minimal_formatted_string_string(out.buffer, out.length, &out.result,
+                                                 Format::str() + Index, literal_end - Index, out.stream);
+        }
+        step(action_tag(), out, args...);
+    }
+
+    template <typename... Args>
+    static void step(std::integral_constant<action, done>, static_printf_output &, Args...)
+    {
+        static_assert(sizeof...(Args) == 0, "Too many arguments for format string");
+    }
+
+    template <typename... Args>
+    static void step(std::integral_constant<action, percent>, static_printf_output &out, Args... args)
+    {
+        mbed_minimal_putchar(out.buffer, out.length, &out.result, '%', out.stream);
+        static_printf_step<Format, next>::print(out, args...);
+    }
+
+    template <typename First, typename... Rest>
+    static void step(std::integral_constant<action, argument>, static_printf_output &out, First first, Rest... rest)
+    {
+        static_printf_arg<precision>(out, static_printf_conversion<conversion>(), first);
+        static_printf_step<Format, next>::print(out, rest...);
+    }
+
+    template <typename Dummy = void>
+    static void step(std::integral_constant<action, argument>, static_printf_output &)
+    {
+        static_assert(!std::is_void<Dummy>::value, "Too few arguments for format string");
+    }
+};
+
+} // namespace internal
+
+/** Print to stdout with a format parsed at compile time
+ *
+ *  Use through MBED_STATIC_PRINTF, which supplies the Format type.
+ *
+ *  @tparam Format  Type with a constexpr static str() returning the format
+ */
+template <typename Format, typename... Args>
+int static_printf(Args... args)
+{
+    internal::static_printf_output out = { nullptr, LONG_MAX, 0, stdout };
+    internal::static_printf_step<Format, 0>::print(out, args...);
+    return out.result;
+}
+
+/** Print to a buffer with a format parsed at compile time
+ *
+ *  Use through MBED_STATIC_SNPRINTF, which supplies the Format type.
+ *
+ *  @tparam Format  Type with a constexpr static str() returning the format
+ */
+template <typename Format, typename... Args>
+int static_snprintf(char *buffer, size_t size, Args... args)
+{
+    /* keep room for the terminator, as mbed_minimal_formatted_string does */
+    internal::static_printf_output out = { buffer, size > 0 ? size - 1 : 0, 0, nullptr };
+    internal::static_printf_step<Format, 0>::print(out, args...);
+    if (buffer && size > 0) {
+        buffer[(size_t)out.result <= out.length ? out.result : out.length] = '\0';
+    }
+    return out.result;
+}
+
+} // namespace mbed
+
+#endif
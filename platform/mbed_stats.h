@@ -75,6 +75,42 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/**
+ * Type of a per-thread or per-call-site heap statistics entry
+ */
+typedef enum {
+    MBED_STATS_HEAP_EACH_THREAD,    /**< Allocations made by one thread */
+    MBED_STATS_HEAP_EACH_CALLER,    /**< Allocations made from one call site */
+} mbed_stats_heap_each_type_t;
+
+/**
+ * struct mbed_stats_heap_each_t definition
+ */
+typedef struct {
+    mbed_stats_heap_each_type_t type;   /**< Whether the entry is for a thread or a call site */
+    uint32_t thread_id;         /**< Identifier of the thread for a thread entry, or 0 for allocations that could not be attributed to a tracked thread */
+    void *caller;               /**< Address of the call site for a call site entry, or NULL for allocations that could not be attributed to a tracked call site */
+    uint32_t current_size;      /**< Bytes currently allocated */
+    uint32_t max_size;          /**< Maximum bytes allocated at one time since tracking of the thread or call site started */
+    uint32_t alloc_cnt;         /**< Current number of allocations that have not been freed */
+} mbed_stats_heap_each_t;
+
+/**
+ *  Fill the passed array of structures with heap statistics for each thread and each call site.
+ *
+ *  Entries for threads come first, followed by entries for call sites. Up to
+ *  platform.heap-stats-thread-slots threads and platform.heap-stats-caller-slots
+ *  call sites are tracked, plus one entry of each type for the allocations that
+ *  did not fit. When the tables are full, a thread or call site with no
+ *  outstanding allocations gives up its entry to a new one, so entries with
+ *  memory still allocated are never lost.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_heap_each_t structures to fill
+ *  @param count    The number of mbed_stats_heap_each_t structures in the provided array
+ *  @return         The number of entries written, 0 if heap stats or per-thread and per-call-site tracking are disabled
+ */
+size_t mbed_stats_heap_get_each(mbed_stats_heap_each_t *stats, size_t count);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -112,6 +148,10 @@ typedef struct {
     us_timestamp_t idle_time;         /**< Time spent in the idle thread since the system has started */
     us_timestamp_t sleep_time;        /**< Time spent in sleep since the system has started */
     us_timestamp_t deep_sleep_time;   /**< Time spent in deep sleep since the system has started */
+    uint32_t deep_sleep_latency;      /**< Deep sleep wake-up latency measured by the tickless OS timer, in microseconds */
+    uint32_t timer_wakeups;           /**< Idle sleeps ended by the OS timer */
+    uint32_t early_wakeups;           /**< Idle sleeps ended early by another interrupt */
+    uint32_t deep_sleep_vetoes;       /**< Idle sleeps kept out of deep sleep because they were predicted too short to pay for it */
 } mbed_stats_cpu_t;
 
 /**
@@ -121,6 +161,35 @@ typedef struct {
  */
 void mbed_stats_cpu_get(mbed_stats_cpu_t *stats);
 
+/**
+ * struct mbed_stats_deep_sleep_lock_t definition
+ */
+typedef struct {
+    const char *tag;                /**< Name of the lock holder, or NULL for locks that could not be attributed to a tracked holder */
+    uint32_t lock_cnt;              /**< Number of times the holder has locked deep sleep */
+    uint32_t held_cnt;              /**< Number of locks the holder currently holds */
+    us_timestamp_t blocked_time;    /**< Time spent in sleep rather than deep sleep while the holder held a lock */
+} mbed_stats_deep_sleep_lock_t;
+
+/**
+ *  Fill the passed array of structures with the deep sleep lock statistics for each lock holder.
+ *
+ *  A holder is identified by the tag passed to sleep_manager_lock_deep_sleep_tagged(),
+ *  which for sleep_manager_lock_deep_sleep() is the name of the calling file.
+ *  Up to platform.deep-sleep-stats-slots holders are tracked, plus one entry
+ *  for the locks of holders that did not fit.
+ *
+ *  When several holders hold a lock at once, the sleep time is counted for
+ *  each of them, as any one of them would have prevented deep sleep.
+ *  blocked_time is only measured if CPU stats are enabled and the target has
+ *  a low power ticker.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_deep_sleep_lock_t structures to fill
+ *  @param count    The number of mbed_stats_deep_sleep_lock_t structures in the provided array
+ *  @return         The number of entries written, 0 if deep sleep lock statistics are disabled
+ */
+size_t mbed_stats_deep_sleep_lock_get_each(mbed_stats_deep_sleep_lock_t *stats, size_t count);
+
 /**
  * struct mbed_stats_thread_t definition
  */
@@ -131,6 +200,7 @@ typedef struct {
     uint32_t stack_size;        /**< Current number of bytes reserved for the stack */
     uint32_t stack_space;       /**< Current number of free bytes remaining on the stack */
     const char   *name;         /**< Name of the thread */
+    us_timestamp_t cpu_time;    /**< Time the thread has spent running since it was started, in microseconds */
 } mbed_stats_thread_t;
 
 /**
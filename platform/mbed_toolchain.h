@@ -446,6 +446,62 @@
 #endif
 #endif
 
+/** MBED_FAST_CODE
+ *  Place a function in fast memory, ITCM or SRAM, to run it without flash
+ *  wait states.
+ *
+ *  Only takes effect when platform.fast-code-enabled is set, and the linker
+ *  script of the target defines the fast regions:
+ *  - GCC: output sections .fast_code and .fast_data loaded from flash, with
+ *    the __fast_code_start__/__fast_code_end__/__fast_code_load__ and
+ *    __fast_data_start__/__fast_data_end__/__fast_data_load__ symbols.
+ *    mbed_init() copies them.
+ *  - ARM: execution regions holding *(.fast_code) and *(.fast_data), copied by
+ *    the scatter loading.
+ *  - IAR: functions are __ramfunc and copied with the other readwrite
+ *    sections, .fast_data must be placed in an "initialize by copy" block.
+ *  Without these, the sections stay in flash and RAM as usual.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_FAST_CODE void irq_handler() {
+ *
+ *  }
+ *  @endcode
+ */
+#ifndef MBED_FAST_CODE
+#if MBED_CONF_PLATFORM_FAST_CODE_ENABLED
+#if defined(__ICCARM__)
+#define MBED_FAST_CODE __ramfunc
+#elif defined(__GNUC__) || defined(__clang__)
+#define MBED_FAST_CODE __attribute__((section(".fast_code"), noinline))
+#else
+#define MBED_FAST_CODE
+#endif
+#else
+#define MBED_FAST_CODE
+#endif
+#endif
+
+/** MBED_FAST_DATA
+ *  Place initialized data in fast memory, DTCM or SRAM, next to the functions
+ *  placed with MBED_FAST_CODE.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_FAST_DATA uint32_t table[16] = { 1 };
+ *  @endcode
+ */
+#ifndef MBED_FAST_DATA
+#if MBED_CONF_PLATFORM_FAST_CODE_ENABLED
+#define MBED_FAST_DATA MBED_SECTION(".fast_data")
+#else
+#define MBED_FAST_DATA
+#endif
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 #ifdef LF
 #undef LF
@@ -42,6 +43,47 @@
 
 namespace mbed {
 
+// Character that the end of the input must match literally for the first
+// len characters of a scanf format to match all of it, or 0 if the format
+// ends with a conversion or whitespace, which can not be checked cheaply.
+static char format_last_literal(const char *format, int len)
+{
+    char last = 0;
+    int i = 0;
+    while (i < len) {
+        if (format[i] != '%') {
+            last = isspace((unsigned char)format[i]) ? 0 : format[i];
+            i++;
+            continue;
+        }
+        i++;
+        if (i < len && format[i] == '%') {
+            last = '%';
+            i++;
+            continue;
+        }
+        // Skip the conversion specification
+        while (i < len && (format[i] == '*' || isdigit((unsigned char)format[i]) || strchr("hlLqjzt", format[i]))) {
+            i++;
+        }
+        if (i < len && format[i] == '[') {
+            i++;
+            if (i < len && format[i] == '^') {
+                i++;
+            }
+            if (i < len && format[i] == ']') {
+                i++;
+            }
+            while (i < len && format[i] != ']') {
+                i++;
+            }
+        }
+        i++;
+        last = 0;
+    }
+    return last;
+}
+
 // getc/putc handling with timeouts
 int ATCmdParser::putc(char c)
 {
@@ -59,6 +101,13 @@ int ATCmdParser::putc(char c)
 
 int ATCmdParser::getc()
 {
+    if (_rx_buf) {
+        if (_rx_pos == _rx_len && !fill()) {
+            return -1;
+        }
+        return (unsigned char)_rx_buf[_rx_pos++];
+    }
+
     pollfh fhs;
     fhs.fh = _fh;
     fhs.events = POLLIN;
@@ -72,8 +121,33 @@ int ATCmdParser::getc()
     }
 }
 
+bool ATCmdParser::fill()
+{
+    pollfh fhs;
+    fhs.fh = _fh;
+    fhs.events = POLLIN;
+
+    int count = poll(&fhs, 1, _timeout);
+    if (count > 0 && (fhs.revents & POLLIN)) {
+        // Take whatever is available, up to the size of the buffer
+        ssize_t len = _fh->read(_rx_buf, _rx_buf_size);
+        if (len > 0) {
+            _rx_pos = 0;
+            _rx_len = len;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ATCmdParser::readable()
+{
+    return _rx_pos < _rx_len || _fh->readable();
+}
+
 void ATCmdParser::flush()
 {
+    _rx_pos = _rx_len = 0;
     while (_fh->readable()) {
         unsigned char ch;
         _fh->read(&ch, 1);
@@ -96,12 +170,32 @@ int ATCmdParser::write(const char *data, int size)
 int ATCmdParser::read(char *data, int size)
 {
     int i = 0;
-    for (; i < size; i++) {
-        int c = getc();
-        if (c < 0) {
+
+    // Use up what was read ahead first
+    if (_rx_pos < _rx_len) {
+        i = _rx_len - _rx_pos;
+        if (i > size) {
+            i = size;
+        }
+        memcpy(data, _rx_buf + _rx_pos, i);
+        _rx_pos += i;
+    }
+
+    while (i < size) {
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+
+        int count = poll(&fhs, 1, _timeout);
+        if (count <= 0 || !(fhs.revents & POLLIN)) {
             return -1;
         }
-        data[i] = c;
+
+        ssize_t len = _fh->read(data + i, size - i);
+        if (len <= 0) {
+            return -1;
+        }
+        i += len;
     }
     return i;
 }
@@ -195,6 +289,9 @@ restart:
         _buffer[offset++] = 'n';
         _buffer[offset++] = 0;
 
+        // A match can only end on this character, so don't scan on any other
+        char last_literal = response ? format_last_literal(response, i) : 0;
+
         debug_if(_dbg_on, "AT? %s\n", _buffer);
         // To workaround scanf's lack of error reporting, we actually
         // make two passes. One checks the validity with the modified
@@ -213,7 +310,7 @@ restart:
 
             // If just peeking for OOBs, and at start of line, check
             // readability
-            if (!response && j == 0 && !_fh->readable()) {
+            if (!response && j == 0 && !readable()) {
                 return -1;
             }
 
@@ -269,7 +366,7 @@ restart:
             if (whole_line_wanted && c != '\n') {
                 // Don't attempt scanning until we get delimiter if they included it in format
                 // This allows recv("Foo: %s\n") to work, and not match with just the first character of a string
-            } else if (response) {
+            } else if (response && (!last_literal || c == last_literal)) {
                 sscanf(_buffer + offset, _buffer, &count);
             }
 
@@ -0,0 +1,188 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+#include "platform/source/AsyncConsole.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_poll.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#define BUFFER_SIZE MBED_CONF_PLATFORM_STDIO_ASYNC_BUFFER_SIZE
+
+MBED_STATIC_ASSERT((BUFFER_SIZE & (BUFFER_SIZE - 1)) == 0, "platform.stdio-async-buffer-size must be a power of two");
+
+namespace mbed {
+namespace internal {
+
+AsyncConsole::AsyncConsole(FileHandle *console) :
+    _console(console),
+    _head(0),
+    _tail(0),
+    _dropped(0),
+    _data(0, 1),
+    _space(0, 1),
+    _thread(osPriorityLow, sizeof(_stack), _stack, "async_console")
+{
+    _thread.start(callback(this, &AsyncConsole::thread_main));
+}
+
+ssize_t AsyncConsole::write(const void *buffer, size_t size)
+{
+    const uint8_t *data = static_cast<const uint8_t *>(buffer);
+
+    if (core_util_is_isr_active() || core_util_in_critical_section()) {
+        // The thread can't run, send the buffered output and then this
+        flush(false);
+        return _console->write(buffer, size);
+    }
+
+    _write_mutex.lock();
+    size_t written = 0;
+    while (written < size) {
+        const uint32_t head = _head;
+        const uint32_t space = BUFFER_SIZE - (head - core_util_atomic_load_u32(&_tail));
+        if (space == 0) {
+#if MBED_CONF_PLATFORM_STDIO_ASYNC_BLOCK_ON_OVERFLOW
+            _space.acquire();
+            continue;
+#else
+            core_util_atomic_fetch_add_u32(&_dropped, size - written);
+            break;
+#endif
+        }
+
+        // Copy up to the end of the buffer, the rest wraps round on the next pass
+        const uint32_t offset = head % BUFFER_SIZE;
+        const size_t count = std::min<size_t>({size - written, space, BUFFER_SIZE - offset});
+        memcpy(&_buffer[offset], data + written, count);
+        core_util_atomic_store_u32(&_head, head + count);
+        written += count;
+        _data.release();
+    }
+    _write_mutex.unlock();
+
+    // Dropped output still counts as written, so stdio does not report errors for it
+    return size;
+}
+
+void AsyncConsole::flush(bool notify)
+{
+    if (notify) {
+        _flush_mutex.lock();
+    }
+
+    uint32_t tail = _tail;
+    uint32_t head;
+    while ((head = core_util_atomic_load_u32(&_head)) != tail) {
+        const uint32_t offset = tail % BUFFER_SIZE;
+        const size_t count = std::min<size_t>(head - tail, BUFFER_SIZE - offset);
+        ssize_t sent = _console->write(&_buffer[offset], count);
+        if (sent <= 0) {
+            break;
+        }
+        tail += sent;
+        core_util_atomic_store_u32(&_tail, tail);
+        if (notify) {
+            _space.release();
+        }
+    }
+
+    if (notify) {
+        _flush_mutex.unlock();
+    }
+}
+
+void AsyncConsole::thread_main()
+{
+    while (true) {
+        _data.acquire();
+        flush(true);
+    }
+}
+
+int AsyncConsole::sync()
+{
+    flush(!core_util_is_isr_active() && !core_util_in_critical_section());
+    return _console->sync();
+}
+
+uint32_t AsyncConsole::dropped() const
+{
+    return core_util_atomic_load_u32(&_dropped);
+}
+
+ssize_t AsyncConsole::read(void *buffer, size_t size)
+{
+    return _console->read(buffer, size);
+}
+
+off_t AsyncConsole::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+off_t AsyncConsole::size()
+{
+    return -EINVAL;
+}
+
+int AsyncConsole::close()
+{
+    return 0;
+}
+
+int AsyncConsole::isatty()
+{
+    return _console->isatty();
+}
+
+int AsyncConsole::set_blocking(bool blocking)
+{
+    return _console->set_blocking(blocking);
+}
+
+bool AsyncConsole::is_blocking() const
+{
+    return _console->is_blocking();
+}
+
+int AsyncConsole::enable_input(bool enabled)
+{
+    return _console->enable_input(enabled);
+}
+
+short AsyncConsole::poll(short events) const
+{
+    short revents = _console->poll(events & ~POLLOUT);
+    if ((events & POLLOUT) && _head - core_util_atomic_load_u32(&_tail) < BUFFER_SIZE) {
+        revents |= POLLOUT;
+    }
+    return revents;
+}
+
+void AsyncConsole::sigio(Callback<void()> func)
+{
+    _console->sigio(func);
+}
+
+} // namespace internal
+} // namespace mbed
+
+#endif // MBED_CONF_RTOS_PRESENT
@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ASYNC_CONSOLE_H
+#define MBED_ASYNC_CONSOLE_H
+
+#include <stdint.h>
+#include "platform/FileHandle.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/mbed_toolchain.h"
+#include "rtos/Semaphore.h"
+#include "rtos/Thread.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace mbed {
+namespace internal {
+
+/**
+ * \defgroup mbed_AsyncConsole AsyncConsole class
+ * \ingroup platform-internal-api
+ * @{
+ */
+
+/**
+ * Console FileHandle whose writes return once the data is buffered.
+ *
+ * Data is copied into a ring buffer and written to the underlying console by
+ * a low priority thread. Writes made in a critical section or an interrupt,
+ * where that thread cannot run, first flush the buffer and then go straight
+ * to the console, so fatal error reports are never lost or reordered.
+ *
+ * Writers are serialized by a mutex, the thread takes data out with atomic
+ * index updates only.
+ *
+ * @note AsyncConsole is not the part of Mbed API.
+ */
+class AsyncConsole : public FileHandle, private NonCopyable<AsyncConsole> {
+public:
+    /** Wrap a console and start the thread sending to it
+     *
+     * @param console Console to send the output to
+     */
+    explicit AsyncConsole(FileHandle *console);
+
+    ssize_t write(const void *buffer, size_t size) override;
+    ssize_t read(void *buffer, size_t size) override;
+    off_t seek(off_t offset, int whence = SEEK_SET) override;
+    off_t size() override;
+    int close() override;
+    int isatty() override;
+    int set_blocking(bool blocking) override;
+    bool is_blocking() const override;
+    int enable_input(bool enabled) override;
+    short poll(short events) const override;
+    void sigio(Callback<void()> func) override;
+
+    /** Send all the buffered output before returning */
+    int sync() override;
+
+    /** Get the number of bytes dropped because the buffer was full
+     *
+     * @return Count since the console was created
+     */
+    uint32_t dropped() const;
+
+private:
+    /** Write the buffered data to the console
+     *
+     * @param notify Wake writers waiting for space, not possible in a critical section
+     */
+    void flush(bool notify);
+
+    void thread_main();
+
+    FileHandle *_console;
+    uint32_t _head;
+    uint32_t _tail;
+    uint32_t _dropped;
+    PlatformMutex _write_mutex;
+    PlatformMutex _flush_mutex;
+    rtos::Semaphore _data;
+    rtos::Semaphore _space;
+    rtos::Thread _thread;
+    uint8_t _buffer[MBED_CONF_PLATFORM_STDIO_ASYNC_BUFFER_SIZE];
+    MBED_ALIGN(8) unsigned char _stack[MBED_CONF_PLATFORM_STDIO_ASYNC_THREAD_STACK_SIZE];
+};
+
+/** @}*/
+
+} // namespace internal
+} // namespace mbed
+
+#endif // MBED_CONF_RTOS_PRESENT
+
+#endif
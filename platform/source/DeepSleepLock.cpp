@@ -24,15 +24,19 @@
 
 namespace mbed {
 
-DeepSleepLock::DeepSleepLock(): _lock_count(1)
+DeepSleepLock::DeepSleepLock(): DeepSleepLock("DeepSleepLock")
 {
-    sleep_manager_lock_deep_sleep();
+}
+
+DeepSleepLock::DeepSleepLock(const char *tag): _lock_count(1), _tag(tag)
+{
+    sleep_manager_lock_deep_sleep_tagged(_tag);
 }
 
 DeepSleepLock::~DeepSleepLock()
 {
     if (_lock_count) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_tagged(_tag);
     }
 }
 
@@ -40,7 +44,7 @@ void DeepSleepLock::lock()
 {
     uint16_t count = core_util_atomic_incr_u16(&_lock_count, 1);
     if (1 == count) {
-        sleep_manager_lock_deep_sleep();
+        sleep_manager_lock_deep_sleep_tagged(_tag);
     }
     if (0 == count) {
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_PLATFORM, MBED_ERROR_CODE_OVERFLOW), "DeepSleepLock overflow (> USHRT_MAX)", count);
@@ -51,7 +55,7 @@ void DeepSleepLock::unlock()
 {
     uint16_t count = core_util_atomic_decr_u16(&_lock_count, 1);
     if (count == 0) {
-        sleep_manager_unlock_deep_sleep();
+        sleep_manager_unlock_deep_sleep_tagged(_tag);
     }
     if (count == USHRT_MAX) {
         core_util_critical_section_exit();
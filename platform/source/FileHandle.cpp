@@ -32,4 +32,44 @@ off_t FileHandle::size()
     return size;
 }
 
+ssize_t FileHandle::readv(Span<const struct iovec> iov)
+{
+    ssize_t total = 0;
+    for (ptrdiff_t i = 0; i < iov.size(); i++) {
+        const struct iovec &v = iov[i];
+        if (v.iov_len == 0) {
+            continue;
+        }
+        ssize_t n = read(v.iov_base, v.iov_len);
+        if (n < 0) {
+            return total ? total : n;
+        }
+        total += n;
+        if ((size_t)n < v.iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t FileHandle::writev(Span<const struct iovec> iov)
+{
+    ssize_t total = 0;
+    for (ptrdiff_t i = 0; i < iov.size(); i++) {
+        const struct iovec &v = iov[i];
+        if (v.iov_len == 0) {
+            continue;
+        }
+        ssize_t n = write(v.iov_base, v.iov_len);
+        if (n < 0) {
+            return total ? total : n;
+        }
+        total += n;
+        if ((size_t)n < v.iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
 } // namespace mbed
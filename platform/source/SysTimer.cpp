@@ -31,7 +31,7 @@ extern "C" {
 
 using namespace std::chrono;
 
-constexpr milliseconds deep_sleep_latency{MBED_CONF_TARGET_DEEP_SLEEP_LATENCY};
+constexpr milliseconds configured_deep_sleep_latency{MBED_CONF_TARGET_DEEP_SLEEP_LATENCY};
 
 #if (defined(NO_SYSTICK))
 /**
@@ -64,6 +64,9 @@ SysTimer<Period, IRQ>::SysTimer(const ticker_data_t *data) :
     TimerEvent(data),
     _epoch(_ticker_data.now()),
     _time(_epoch),
+    _wake_slack(0),
+    _deep_sleep_latency(configured_deep_sleep_latency),
+    _wake_event_time(_epoch),
     _tick(0),
     _unacknowledged_ticks(0),
     _wake_time_set(false),
@@ -112,6 +115,7 @@ void SysTimer<Period, IRQ>::set_wake_time(time_point at)
         sleep_manager_lock_deep_sleep();
     }
     /* Consider whether we will need early or precise wake-up */
+    highres_duration deep_sleep_latency = _deep_sleep_latency;
     if (deep_sleep_latency > deep_sleep_latency.zero() &&
             ticks_to_sleep > deep_sleep_latency &&
             !_deep_sleep_locked) {
@@ -121,7 +125,8 @@ void SysTimer<Period, IRQ>::set_wake_time(time_point at)
          * Actual sleep may or may not be deep, depending on other actors.
          */
         _wake_early = true;
-        insert_absolute(wake_time - deep_sleep_latency);
+        _wake_event_time = wake_time - deep_sleep_latency;
+        insert_absolute(_wake_event_time, _wake_slack);
     } else {
         /* Otherwise, set up to wake at the precise time.
          * If there is a deep sleep latency, ensure that we're holding the lock so the sleep
@@ -132,7 +137,8 @@ void SysTimer<Period, IRQ>::set_wake_time(time_point at)
             _deep_sleep_locked = true;
             sleep_manager_lock_deep_sleep();
         }
-        insert_absolute(wake_time);
+        _wake_event_time = wake_time;
+        insert_absolute(wake_time, _wake_slack);
     }
 }
 
@@ -309,11 +315,33 @@ void SysTimer<Period, IRQ>::_increment_tick()
     _time += duration(1);
 }
 
+template<class Period, bool IRQ>
+void SysTimer<Period, IRQ>::_measure_wake_latency()
+{
+    // Protected function synchronized externally
+#if DEVICE_SLEEP && !defined(MBED_DEBUG)
+    /* Only a sleep that could have been deep tells us its latency, and a
+     * wake-up coalesced with another event is late by design.
+     */
+    if (_deep_sleep_locked || !sleep_manager_can_deep_sleep() || _wake_slack != _wake_slack.zero()) {
+        return;
+    }
+    highres_duration latency = _ticker_data.now() - _wake_event_time;
+    if (latency > _deep_sleep_latency) {
+        // Waking late is costly, so follow longer latencies straight away
+        _deep_sleep_latency = latency;
+    } else {
+        _deep_sleep_latency -= (_deep_sleep_latency - latency) / 8;
+    }
+#endif
+}
+
 template<class Period, bool IRQ>
 void SysTimer<Period, IRQ>::handler()
 {
     /* To reduce IRQ latency problems, we do not re-arm in the interrupt handler */
     if (_wake_time_set) {
+        _measure_wake_latency();
         _wake_time_set = false;
         if (!_wake_early) {
             _wake_time_passed = true;
@@ -111,6 +111,34 @@ public:
      */
     void set_wake_time(time_point at);
 
+    /**
+     * Set how late the wake-up may be
+     *
+     * Subsequent calls to set_wake_time() will delay the wake-up interrupt
+     * by up to @a slack if another event on the same ticker is already
+     * due within that time, so that one interrupt serves both.
+     *
+     * @param slack How late the wake-up interrupt may be
+     */
+    void set_wake_slack(highres_duration slack)
+    {
+        _wake_slack = slack;
+    }
+
+    /**
+     * Get the deep sleep wake-up latency allowed for by set_wake_time()
+     *
+     * Starts at target.deep-sleep-latency and follows the latency measured
+     * when the wake-up interrupt runs after a sleep that could be deep: it
+     * rises to each longer measurement and decays slowly towards shorter ones.
+     *
+     * @return Deep sleep wake-up latency
+     */
+    highres_duration deep_sleep_latency() const
+    {
+        return _deep_sleep_latency;
+    }
+
     /**
      * Check whether the wake time has passed
      *
@@ -242,11 +270,15 @@ protected:
     void handler() override;
     void _increment_tick();
     void _schedule_tick();
+    void _measure_wake_latency();
     duration _elapsed_ticks() const;
     static void _set_irq_pending();
     static void _clear_irq_pending();
     const highres_time_point _epoch;
     highres_time_point _time;
+    highres_duration _wake_slack;
+    highres_duration _deep_sleep_latency;
+    highres_time_point _wake_event_time;
     uint64_t _tick;
     uint8_t _unacknowledged_ticks;
     bool _wake_time_set;
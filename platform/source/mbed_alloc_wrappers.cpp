@@ -15,16 +15,23 @@
  * limitations under the License.
  */
 
+#include "platform/mbed_assert.h"
+#include "platform/mbed_heap.h"
 #include "platform/mbed_mem_trace.h"
 #include "platform/mbed_stats.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
+#if MBED_CONF_RTOS_PRESENT
+#include "cmsis_os2.h"
+#endif
+
 /* There are two memory tracers in mbed OS:
 
 - the first can be used to detect the maximum heap usage at runtime. It is
@@ -41,13 +48,35 @@ are active, the second one (MBED_MEM_TRACING_ENABLED) will trace the first one's
 /* Implementation of the runtime max heap usage checker                       */
 /******************************************************************************/
 
+#if MBED_HEAP_STATS_ENABLED && \
+    (MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS > 0 || MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS > 0)
+#define HEAP_STATS_EACH 1
+#else
+#define HEAP_STATS_EACH 0
+#endif
+
+#if HEAP_STATS_EACH
+// The slot of the owning thread and call site are kept in the header so
+// free can update them. The header stays 8 bytes to keep allocations aligned.
+typedef struct {
+    uint32_t size;
+    uint16_t signature;
+    uint8_t thread_slot;
+    uint8_t caller_slot;
+} alloc_info_t;
+#else
 typedef struct {
     uint32_t size;
     uint32_t signature;
 } alloc_info_t;
+#endif
 
 #if MBED_HEAP_STATS_ENABLED
+#if HEAP_STATS_EACH
+#define MBED_HEAP_STATS_SIGNATURE       (0xbeef)
+#else
 #define MBED_HEAP_STATS_SIGNATURE       (0xdeadbeef)
+#endif
 
 static SingletonPtr<PlatformMutex> malloc_stats_mutex;
 static mbed_stats_heap_t heap_stats = {0, 0, 0, 0, 0, 0, 0};
@@ -61,11 +90,244 @@ typedef struct  {
 #define MALLOC_HEAP_TOTAL_SIZE(p)   (((p)->size) & (~0x1))
 #endif
 
-void mbed_stats_heap_get(mbed_stats_heap_t *stats)
+/******************************************************************************/
+/* Per-thread and per-call-site heap usage                                    */
+/******************************************************************************/
+
+#if HEAP_STATS_EACH
+#ifndef MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS
+#define MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS 0
+#endif
+
+#ifndef MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS
+#define MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS 0
+#endif
+
+#if MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS > 254 || MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS > 254
+#error At most 254 threads and call sites can be tracked by the heap statistics.
+#endif
+
+/* Each table has one extra slot at the end for allocations that could not
+   be given a slot of their own. Slots are protected by malloc_stats_mutex. */
+typedef struct {
+    uintptr_t key;
+    uint32_t current_size;
+    uint32_t max_size;
+    uint32_t alloc_cnt;
+    bool used;
+} heap_each_slot_t;
+
+static heap_each_slot_t heap_thread_slots[MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS + 1];
+static heap_each_slot_t heap_caller_slots[MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS + 1];
+
+// find the slot for key, or claim a slot that is unused or has nothing
+// allocated, preferring the one with the smallest peak
+static uint8_t heap_each_slot(heap_each_slot_t *slots, uint8_t count, uintptr_t key)
+{
+    uint8_t found = count;
+    for (uint8_t i = 0; i < count; i++) {
+        if (slots[i].used && slots[i].key == key) {
+            return i;
+        }
+
+        if (!slots[i].used) {
+            if (found == count || slots[found].used) {
+                found = i;
+            }
+        } else if (slots[i].current_size == 0) {
+            if (found == count || (slots[found].used && slots[i].max_size < slots[found].max_size)) {
+                found = i;
+            }
+        }
+    }
+
+    if (found != count) {
+        slots[found].key = key;
+        slots[found].current_size = 0;
+        slots[found].max_size = 0;
+        slots[found].alloc_cnt = 0;
+    }
+    return found;
+}
+
+static uint8_t heap_each_thread_slot()
+{
+#if MBED_CONF_RTOS_PRESENT
+    uintptr_t id = (uintptr_t)osThreadGetId();
+    if (id) {
+        return heap_each_slot(heap_thread_slots, MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS, id);
+    }
+#endif
+    return MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS;
+}
+
+static void heap_each_slot_alloc(heap_each_slot_t *slot, uint32_t size)
+{
+    slot->used = true;
+    slot->current_size += size;
+    slot->alloc_cnt += 1;
+    if (slot->current_size > slot->max_size) {
+        slot->max_size = slot->current_size;
+    }
+}
+
+static void heap_each_slot_free(heap_each_slot_t *slot, uint32_t size)
+{
+    slot->current_size -= size;
+    slot->alloc_cnt -= 1;
+}
+
+static void heap_each_alloc(alloc_info_t *alloc_info, void *caller)
+{
+    alloc_info->thread_slot = heap_each_thread_slot();
+    alloc_info->caller_slot = heap_each_slot(heap_caller_slots, MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS, (uintptr_t)caller);
+    heap_each_slot_alloc(&heap_thread_slots[alloc_info->thread_slot], alloc_info->size);
+    heap_each_slot_alloc(&heap_caller_slots[alloc_info->caller_slot], alloc_info->size);
+}
+
+static void heap_each_free(alloc_info_t *alloc_info)
+{
+    heap_each_slot_free(&heap_thread_slots[alloc_info->thread_slot], alloc_info->size);
+    heap_each_slot_free(&heap_caller_slots[alloc_info->caller_slot], alloc_info->size);
+}
+
+static size_t heap_each_fill(mbed_stats_heap_each_t *stats, size_t count,
+                             const heap_each_slot_t *slots, uint8_t slot_count,
+                             mbed_stats_heap_each_type_t type)
+{
+    size_t n = 0;
+    for (uint8_t i = 0; i <= slot_count && n < count; i++) {
+        if (!slots[i].used) {
+            continue;
+        }
+
+        stats[n].type = type;
+        if (i < slot_count) {
+            if (type == MBED_STATS_HEAP_EACH_THREAD) {
+                stats[n].thread_id = (uint32_t)slots[i].key;
+            } else {
+                stats[n].caller = (void *)slots[i].key;
+            }
+        }
+        stats[n].current_size = slots[i].current_size;
+        stats[n].max_size = slots[i].max_size;
+        stats[n].alloc_cnt = slots[i].alloc_cnt;
+        n++;
+    }
+    return n;
+}
+#endif // #if HEAP_STATS_EACH
+
+size_t mbed_stats_heap_get_each(mbed_stats_heap_each_t *stats, size_t count)
 {
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_heap_each_t));
+    size_t i = 0;
+
+#if HEAP_STATS_EACH
+    malloc_stats_mutex->lock();
+    i += heap_each_fill(stats, count, heap_thread_slots,
+                        MBED_CONF_PLATFORM_HEAP_STATS_THREAD_SLOTS, MBED_STATS_HEAP_EACH_THREAD);
+    i += heap_each_fill(stats + i, count - i, heap_caller_slots,
+                        MBED_CONF_PLATFORM_HEAP_STATS_CALLER_SLOTS, MBED_STATS_HEAP_EACH_CALLER);
+    malloc_stats_mutex->unlock();
+#endif
+    return i;
+}
+
+/******************************************************************************/
+/* TLSF heap                                                                  */
+/******************************************************************************/
+
+#if MBED_CONF_PLATFORM_HEAP_TLSF_ENABLED
+#if !defined(TOOLCHAIN_GCC)
+#error The TLSF heap is only supported with the GCC toolchain.
+#endif
+
+/* The TLSF allocator replaces the newlib allocator behind the GCC wrappers
+   below, so the rest of the file is unchanged apart from the heap_* calls.
+   It shares the newlib malloc lock, which is recursive and is backed by an
+   rtos mutex once the kernel is running. */
+
+#include <reent.h>
+#include "platform/source/mbed_tlsf.h"
+
+extern "C" {
+    void __malloc_lock(struct _reent *r);
+    void __malloc_unlock(struct _reent *r);
+}
+
+static mbed_tlsf_t heap_tlsf;
+static bool heap_tlsf_ready = false;
+
+// lock the heap, giving it the default heap region on first use
+static void heap_lock(struct _reent *r)
+{
+    __malloc_lock(r);
+    if (!heap_tlsf_ready) {
+        mbed_tlsf_init(&heap_tlsf);
+#if defined(MBED_SPLIT_HEAP)
+        extern uint32_t __mbed_sbrk_start_0;
+        extern uint32_t __mbed_krbs_start_0;
+        extern uint32_t __mbed_sbrk_start;
+        extern uint32_t __mbed_krbs_start;
+        mbed_tlsf_add_region(&heap_tlsf, &__mbed_sbrk_start_0,
+                             (char *)&__mbed_krbs_start_0 - (char *)&__mbed_sbrk_start_0);
+        mbed_tlsf_add_region(&heap_tlsf, &__mbed_sbrk_start,
+                             (char *)&__mbed_krbs_start - (char *)&__mbed_sbrk_start);
+#else
+        extern unsigned char *mbed_heap_start;
+        extern uint32_t mbed_heap_size;
+        mbed_tlsf_add_region(&heap_tlsf, mbed_heap_start, mbed_heap_size);
+#endif
+        heap_tlsf_ready = true;
+    }
+}
+
+static void heap_unlock(struct _reent *r)
+{
+    __malloc_unlock(r);
+}
+
+int mbed_heap_add_region(void *start, size_t size)
+{
+    heap_lock(_REENT);
+    int err = mbed_tlsf_add_region(&heap_tlsf, start, size);
+    heap_unlock(_REENT);
+    return err;
+}
+
+#if MBED_HEAP_STATS_ENABLED
+static size_t heap_reserved_size()
+{
+    heap_lock(_REENT);
+    size_t size = heap_tlsf.reserved_size;
+    heap_unlock(_REENT);
+    return size;
+}
+#endif
+
+#else // #if MBED_CONF_PLATFORM_HEAP_TLSF_ENABLED
+
+int mbed_heap_add_region(void *start, size_t size)
+{
+    return -1;
+}
+
 #if MBED_HEAP_STATS_ENABLED
+static size_t heap_reserved_size()
+{
     extern uint32_t mbed_heap_size;
-    heap_stats.reserved_size = mbed_heap_size;
+    return mbed_heap_size;
+}
+#endif
+
+#endif // #if MBED_CONF_PLATFORM_HEAP_TLSF_ENABLED
+
+void mbed_stats_heap_get(mbed_stats_heap_t *stats)
+{
+#if MBED_HEAP_STATS_ENABLED
+    heap_stats.reserved_size = heap_reserved_size();
 
     malloc_stats_mutex->lock();
     memcpy(stats, &heap_stats, sizeof(mbed_stats_heap_t));
@@ -91,6 +353,72 @@ extern "C" {
     void free_wrapper(struct _reent *r, void *ptr, void *caller);
 }
 
+#if MBED_CONF_PLATFORM_HEAP_TLSF_ENABLED
+static void *heap_malloc(struct _reent *r, size_t size)
+{
+    heap_lock(r);
+    void *ptr = mbed_tlsf_malloc(&heap_tlsf, size);
+    heap_unlock(r);
+    return ptr;
+}
+
+static void *heap_memalign(struct _reent *r, size_t alignment, size_t bytes)
+{
+    heap_lock(r);
+    void *ptr = mbed_tlsf_memalign(&heap_tlsf, alignment, bytes);
+    heap_unlock(r);
+    return ptr;
+}
+
+static void *heap_realloc(struct _reent *r, void *ptr, size_t size)
+{
+    heap_lock(r);
+    void *new_ptr = mbed_tlsf_realloc(&heap_tlsf, ptr, size);
+    heap_unlock(r);
+    return new_ptr;
+}
+
+static void heap_free(struct _reent *r, void *ptr)
+{
+    heap_lock(r);
+    mbed_tlsf_free(&heap_tlsf, ptr);
+    heap_unlock(r);
+}
+
+static void *heap_calloc(struct _reent *r, size_t nmemb, size_t size)
+{
+    if (size && nmemb > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void *ptr = heap_malloc(r, nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+#if MBED_HEAP_STATS_ENABLED
+static size_t heap_block_size(void *ptr)
+{
+    return mbed_tlsf_block_size(ptr);
+}
+#endif
+#else // #if MBED_CONF_PLATFORM_HEAP_TLSF_ENABLED
+#define heap_malloc     __real__malloc_r
+#define heap_memalign   __real__memalign_r
+#define heap_realloc    __real__realloc_r
+#define heap_free       __real__free_r
+#define heap_calloc     __real__calloc_r
+
+#if MBED_HEAP_STATS_ENABLED
+static size_t heap_block_size(void *ptr)
+{
+    return MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(ptr));
+}
+#endif
+#endif // #if MBED_CONF_PLATFORM_HEAP_TLSF_ENABLED
+
 
 extern "C" void *__wrap__malloc_r(struct _reent *r, size_t size)
 {
@@ -105,10 +433,13 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
 #endif
 #if MBED_HEAP_STATS_ENABLED
     malloc_stats_mutex->lock();
-    alloc_info_t *alloc_info = (alloc_info_t *)__real__malloc_r(r, size + sizeof(alloc_info_t));
+    alloc_info_t *alloc_info = (alloc_info_t *)heap_malloc(r, size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
         alloc_info->size = size;
         alloc_info->signature = MBED_HEAP_STATS_SIGNATURE;
+#if HEAP_STATS_EACH
+        heap_each_alloc(alloc_info, caller);
+#endif
         ptr = (void *)(alloc_info + 1);
         heap_stats.current_size += size;
         heap_stats.total_size += size;
@@ -116,13 +447,13 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
         if (heap_stats.current_size > heap_stats.max_size) {
             heap_stats.max_size = heap_stats.current_size;
         }
-        heap_stats.overhead_size += MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info)) - size;
+        heap_stats.overhead_size += heap_block_size(alloc_info) - size;
     } else {
         heap_stats.alloc_fail_cnt += 1;
     }
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    ptr = __real__malloc_r(r, size);
+    ptr = heap_malloc(r, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_malloc(ptr, size, caller);
@@ -154,7 +485,7 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
 
     // Allocate space
     if (size != 0) {
-        new_ptr = malloc(size);
+        new_ptr = malloc_wrapper(r, size, MBED_CALLER_ADDR());
     }
 
     // If the new buffer has been allocated copy the data to it
@@ -165,7 +496,7 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
         free(ptr);
     }
 #else // #if MBED_HEAP_STATS_ENABLED
-    new_ptr = __real__realloc_r(r, ptr, size);
+    new_ptr = heap_realloc(r, ptr, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_realloc(new_ptr, ptr, size, MBED_CALLER_ADDR());
@@ -191,20 +522,23 @@ extern "C" void free_wrapper(struct _reent *r, void *ptr, void *caller)
         alloc_info = ((alloc_info_t *)ptr) - 1;
         if (MBED_HEAP_STATS_SIGNATURE == alloc_info->signature) {
             size_t user_size = alloc_info->size;
-            size_t alloc_size = MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info));
+            size_t alloc_size = heap_block_size(alloc_info);
             alloc_info->signature = 0x0;
+#if HEAP_STATS_EACH
+            heap_each_free(alloc_info);
+#endif
             heap_stats.current_size -= user_size;
             heap_stats.alloc_cnt -= 1;
             heap_stats.overhead_size -= (alloc_size - user_size);
-            __real__free_r(r, (void *)alloc_info);
+            heap_free(r, (void *)alloc_info);
         } else {
-            __real__free_r(r, ptr);
+            heap_free(r, ptr);
         }
     }
 
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    __real__free_r(r, ptr);
+    heap_free(r, ptr);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_free(ptr, caller);
@@ -221,12 +555,12 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
 
-    ptr = malloc(nmemb * size);
+    ptr = malloc_wrapper(r, nmemb * size, MBED_CALLER_ADDR());
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
 #else // #if MBED_HEAP_STATS_ENABLED
-    ptr = __real__calloc_r(r, nmemb, size);
+    ptr = heap_calloc(r, nmemb, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_calloc(ptr, nmemb, size, MBED_CALLER_ADDR());
@@ -237,7 +571,7 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 
 extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t bytes)
 {
-    return __real__memalign_r(r, alignment, bytes);
+    return heap_memalign(r, alignment, bytes);
 }
 
 
@@ -296,6 +630,9 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
     if (alloc_info != NULL) {
         alloc_info->size = size;
         alloc_info->signature = MBED_HEAP_STATS_SIGNATURE;
+#if HEAP_STATS_EACH
+        heap_each_alloc(alloc_info, caller);
+#endif
         ptr = (void *)(alloc_info + 1);
         heap_stats.current_size += size;
         heap_stats.total_size += size;
@@ -337,7 +674,7 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
 
     // Allocate space
     if (size != 0) {
-        new_ptr = malloc(size);
+        new_ptr = malloc_wrapper(size, MBED_CALLER_ADDR());
     }
 
     // If the new buffer has been allocated copy the data to it
@@ -375,7 +712,7 @@ extern "C" void *SUB_CALLOC(size_t nmemb, size_t size)
 #endif
 #if MBED_HEAP_STATS_ENABLED
     // Note - no lock needed since malloc is thread safe
-    ptr = malloc(nmemb * size);
+    ptr = malloc_wrapper(nmemb * size, MBED_CALLER_ADDR());
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
@@ -418,6 +755,9 @@ extern "C" void free_wrapper(void *ptr, void *caller)
             size_t user_size = alloc_info->size;
             size_t alloc_size = MALLOC_HEAP_TOTAL_SIZE(MALLOC_HEADER_PTR(alloc_info));
             alloc_info->signature = 0x0;
+#if HEAP_STATS_EACH
+            heap_each_free(alloc_info);
+#endif
             heap_stats.current_size -= user_size;
             heap_stats.alloc_cnt -= 1;
             heap_stats.overhead_size -= (alloc_size - user_size);
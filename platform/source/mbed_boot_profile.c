@@ -0,0 +1,66 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_boot_profile.h"
+#include "cmsis.h"
+
+static mbed_boot_profile_t boot_profile;
+
+#if MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED && defined(DWT_CTRL_CYCCNTENA_Msk)
+
+static uint32_t last_cycles;
+static uint32_t last_us;
+
+void mbed_boot_profile_mark(mbed_boot_phase_t phase)
+{
+    if (phase == MBED_BOOT_PHASE_INIT) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        last_cycles = 0;
+        last_us = 0;
+        boot_profile.reached = 1 << phase;
+        boot_profile.time_us[phase] = 0;
+        return;
+    }
+
+    if (!boot_profile.reached) {
+        return;
+    }
+
+    // Convert each step at the clock it ran at, mbed_sdk_init() often changes it
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t cycles_per_us = SystemCoreClock / 1000000 ? SystemCoreClock / 1000000 : 1;
+    last_us += (cycles - last_cycles) / cycles_per_us;
+    last_cycles = cycles;
+    boot_profile.time_us[phase] = last_us;
+    boot_profile.reached |= 1 << phase;
+}
+
+#elif MBED_CONF_PLATFORM_BOOT_PROFILE_ENABLED
+
+void mbed_boot_profile_mark(mbed_boot_phase_t phase)
+{
+    (void)phase;
+}
+
+#endif
+
+const mbed_boot_profile_t *mbed_boot_profile_get(void)
+{
+    return &boot_profile;
+}
@@ -0,0 +1,65 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "cmsis.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/mbed_mpu_mgmt.h"
+
+#if MBED_CONF_PLATFORM_FAST_CODE_ENABLED
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+/* Defined by the linker scripts supporting MBED_FAST_CODE and MBED_FAST_DATA,
+ * the weak references resolve to 0 in the others so nothing is copied.
+ */
+extern uint32_t __fast_code_start__[] __attribute__((weak));
+extern uint32_t __fast_code_end__[] __attribute__((weak));
+extern uint32_t __fast_code_load__[] __attribute__((weak));
+extern uint32_t __fast_data_start__[] __attribute__((weak));
+extern uint32_t __fast_data_end__[] __attribute__((weak));
+extern uint32_t __fast_data_load__[] __attribute__((weak));
+
+static void copy_section(uint32_t *start, uint32_t *end, const uint32_t *load)
+{
+    if (start != load && end > start) {
+        memcpy(start, load, (uintptr_t)end - (uintptr_t)start);
+    }
+}
+#endif
+
+void mbed_fast_code_init(void)
+{
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+    // The ARM and IAR runtimes copy the fast regions with the data
+    copy_section(__fast_code_start__, __fast_code_end__, __fast_code_load__);
+    copy_section(__fast_data_start__, __fast_data_end__, __fast_data_load__);
+    __DSB();
+    __ISB();
+#endif
+
+    // Fast code may be in SRAM, which the MPU otherwise makes execute never
+    mbed_mpu_manager_lock_ram_execution();
+}
+
+#else
+
+void mbed_fast_code_init(void)
+{
+}
+
+#endif
@@ -21,6 +21,8 @@
 #include "platform/mbed_mem_trace.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
 
 /******************************************************************************
  * Internal variables, functions and helpers
@@ -37,6 +39,16 @@ static SingletonPtr<PlatformMutex> mem_trace_mutex;
 
 #define TRACE_FIRST_LOCK() (trace_lock_count < 2)
 
+/* Ring buffer of the binary tracer. Records are added with the trace lock
+ * held and drained from any thread, so the indices are only touched in
+ * critical sections. */
+static mbed_mem_trace_record_t *binary_records;
+static size_t binary_size;
+static size_t binary_tail;
+static size_t binary_used;
+static uint8_t binary_seq;
+static uint32_t binary_dropped;
+
 
 /******************************************************************************
  * Public interface
@@ -151,3 +163,100 @@ void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...)
     }
     va_end(va);
 }
+
+void mbed_mem_trace_binary_set_buffer(mbed_mem_trace_record_t *records, size_t count)
+{
+    core_util_critical_section_enter();
+    binary_records = records;
+    binary_size = records ? count : 0;
+    binary_tail = 0;
+    binary_used = 0;
+    binary_seq = 0;
+    binary_dropped = 0;
+    core_util_critical_section_exit();
+}
+
+void mbed_mem_trace_binary_callback(uint8_t op, void *res, void *caller, ...)
+{
+    va_list va;
+    mbed_mem_trace_record_t record;
+
+    record.sync = MBED_MEM_TRACE_RECORD_SYNC;
+    record.op = op;
+#if DEVICE_USTICKER
+    record.timestamp = (uint32_t)ticker_read_us(get_us_ticker_data());
+#else
+    record.timestamp = 0;
+#endif
+    record.res = (uint32_t)(uintptr_t)res;
+    record.ptr = 0;
+    record.size = 0;
+    record.caller = (uint32_t)(uintptr_t)caller;
+
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            record.size = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            record.ptr = (uint32_t)(uintptr_t)va_arg(va, void *);
+            record.size = va_arg(va, size_t);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC: {
+            size_t nmemb = va_arg(va, size_t);
+            record.size = nmemb * va_arg(va, size_t);
+            break;
+        }
+
+        case MBED_MEM_TRACE_FREE:
+            record.ptr = (uint32_t)(uintptr_t)va_arg(va, void *);
+            break;
+
+        default:
+            break;
+    }
+    va_end(va);
+
+    core_util_critical_section_enter();
+    record.seq = binary_seq++;
+    if (binary_used < binary_size) {
+        size_t index = binary_tail + binary_used;
+        if (index >= binary_size) {
+            index -= binary_size;
+        }
+        binary_records[index] = record;
+        binary_used++;
+    } else {
+        binary_dropped++;
+    }
+    core_util_critical_section_exit();
+}
+
+size_t mbed_mem_trace_binary_read(mbed_mem_trace_record_t *records, size_t count)
+{
+    size_t read = 0;
+
+    /* one record per critical section, to keep interrupt latency low */
+    while (read < count) {
+        core_util_critical_section_enter();
+        if (binary_used == 0) {
+            core_util_critical_section_exit();
+            break;
+        }
+        records[read++] = binary_records[binary_tail];
+        if (++binary_tail == binary_size) {
+            binary_tail = 0;
+        }
+        binary_used--;
+        core_util_critical_section_exit();
+    }
+
+    return read;
+}
+
+uint32_t mbed_mem_trace_binary_dropped(void)
+{
+    return binary_dropped;
+}
@@ -56,6 +56,7 @@ OsTimer *init_os_timer()
         return NULL;
 #endif
         //os_timer->setup_irq();
+        os_timer->set_wake_slack(std::chrono::microseconds(MBED_CONF_PLATFORM_OS_TIMER_SLACK));
     }
 
     return os_timer;
@@ -252,3 +253,9 @@ void do_timed_sleep_relative_or_forever(OsClock::duration_u32 wake_delay, bool (
 
 } // namespace internal
 } // namespace mbed
+
+void sleep_manager_set_os_timer_slack(uint32_t slack_us)
+{
+    mbed::CriticalSectionLock lock;
+    mbed::internal::init_os_timer()->set_wake_slack(std::chrono::microseconds(slack_us));
+}
@@ -17,34 +17,105 @@
 #include "mbed_poll.h"
 #include "FileHandle.h"
 #include "mbed_thread.h"
+#include "platform/mbed_atomic.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "platform/SingletonPtr.h"
+#include "rtos/EventFlags.h"
+#else
+#include "platform/source/mbed_os_timer.h"
+#endif
 
 namespace mbed {
 
+namespace {
+
+// Interval at which file handles that do not wake poll() are checked
+constexpr uint32_t poll_retry_ms = 1;
+
+constexpr uint32_t poll_forever = 0xFFFFFFFF;
+
+#if MBED_CONF_RTOS_PRESENT
+/* Each blocked poll() owns one of the event flags, and poll_wake() sets the
+ * flags of all of them. A flag stays set until its owner sees it, so a wake
+ * that arrives while the owner is scanning its file handles is not lost.
+ */
+SingletonPtr<rtos::EventFlags> poll_flags;
+uint32_t poll_flags_in_use;
+
+uint32_t poll_claim_flag()
+{
+    uint32_t in_use = core_util_atomic_load_u32(&poll_flags_in_use);
+    for (;;) {
+        uint32_t free = ~in_use & 0x7FFFFFFF;
+        if (!free) {
+            // Too many blocked threads, the rest fall back to checking periodically
+            return 0;
+        }
+        uint32_t flag = free & -free;
+        if (core_util_atomic_cas_u32(&poll_flags_in_use, &in_use, in_use | flag)) {
+            return flag;
+        }
+    }
+}
+#else
+uint32_t poll_wake_count;
+
+bool poll_woken(void *handle)
+{
+    return core_util_atomic_load_u32(&poll_wake_count) != *static_cast<uint32_t *>(handle);
+}
+#endif
+
+}
+
+void poll_wake()
+{
+#if MBED_CONF_RTOS_PRESENT
+    uint32_t in_use = core_util_atomic_load_u32(&poll_flags_in_use);
+    if (in_use) {
+        poll_flags->set(in_use);
+    }
+#else
+    core_util_atomic_incr_u32(&poll_wake_count, 1);
+#endif
+}
+
 // timeout -1 forever, or milliseconds
 int poll(pollfh fhs[], unsigned nfhs, int timeout)
 {
-    /*
-     * TODO Proper wake-up mechanism.
-     * In order to correctly detect availability of read/write a FileHandle, we needed
-     * a select or poll mechanisms. We opted for poll as POSIX defines in
-     * http://pubs.opengroup.org/onlinepubs/009695399/functions/poll.html Currently,
-     * mbed::poll() just spins and scans filehandles looking for any events we are
-     * interested in. In future, his spinning behaviour will be replaced with
-     * condition variables.
-     */
     uint64_t start_time = 0;
     if (timeout > 0) {
         start_time = get_ms_count();
     }
 
+#if MBED_CONF_RTOS_PRESENT
+    uint32_t flag = 0;
+    if (timeout != 0) {
+        // Construct the flags in thread context, before poll_wake() can see them in use
+        poll_flags.get();
+        flag = poll_claim_flag();
+        if (flag) {
+            poll_flags->clear(flag);
+        }
+    }
+#endif
+
     int count = 0;
     for (;;) {
+#if !MBED_CONF_RTOS_PRESENT
+        uint32_t wake_count = core_util_atomic_load_u32(&poll_wake_count);
+#endif
+        bool woken_by_all = true;
+
         /* Scan the file handles */
         for (unsigned n = 0; n < nfhs; n++) {
             FileHandle *fh = fhs[n].fh;
             short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
             if (fh) {
                 fhs[n].revents = fh->poll(mask) & mask;
+                if (!fh->wakes_poll()) {
+                    woken_by_all = false;
+                }
             } else {
                 fhs[n].revents = POLLNVAL;
             }
@@ -53,18 +124,45 @@ int poll(pollfh fhs[], unsigned nfhs, int timeout)
             }
         }
 
-        if (count) {
+        if (count || timeout == 0) {
             break;
         }
 
-        /* Nothing selected - this is where timeout handling would be needed */
-        if (timeout == 0 || (timeout > 0 && int64_t(get_ms_count() - start_time) > timeout)) {
-            break;
+        uint32_t wait_ms = poll_forever;
+        if (timeout > 0) {
+            int64_t elapsed = get_ms_count() - start_time;
+            if (elapsed >= timeout) {
+                break;
+            }
+            wait_ms = timeout - elapsed;
         }
-        // TODO - proper blocking
-        // wait for condition variable, wait queue whatever here
-        thread_sleep_for(1);
+
+#if MBED_CONF_RTOS_PRESENT
+        if (!flag) {
+            woken_by_all = false;
+        }
+#endif
+        if (!woken_by_all && wait_ms > poll_retry_ms) {
+            wait_ms = poll_retry_ms;
+        }
+
+#if MBED_CONF_RTOS_PRESENT
+        if (flag) {
+            poll_flags->wait_any_for(flag, rtos::Kernel::Clock::duration_u32(wait_ms));
+        } else {
+            thread_sleep_for(wait_ms);
+        }
+#else
+        internal::do_timed_sleep_relative_or_forever(internal::OsClock::duration_u32(wait_ms), poll_woken, &wake_count);
+#endif
+    }
+
+#if MBED_CONF_RTOS_PRESENT
+    if (flag) {
+        core_util_atomic_fetch_and_u32(&poll_flags_in_use, ~flag);
     }
+#endif
+
     return count;
 }
 
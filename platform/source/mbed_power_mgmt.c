@@ -28,6 +28,7 @@
 #include "platform/mbed_wait_api.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #if DEVICE_SLEEP
 
@@ -184,6 +185,90 @@ void sleep_tracker_unlock(const char *const filename, int line)
 
 #endif // MBED_SLEEP_TRACING_ENABLED
 
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+
+// Last entry collects the locks of holders that did not fit
+static mbed_stats_deep_sleep_lock_t deep_sleep_lock_stats[MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS + 1];
+
+#define DEEP_SLEEP_LOCK_STATS_OVERFLOW (&deep_sleep_lock_stats[MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS])
+
+// Must be called in a critical section
+static mbed_stats_deep_sleep_lock_t *deep_sleep_lock_stats_get(const char *tag, bool add)
+{
+    for (int i = 0; i < MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS; ++i) {
+        mbed_stats_deep_sleep_lock_t *stat = &deep_sleep_lock_stats[i];
+        if (stat->tag == NULL) {
+            if (!add) {
+                break;
+            }
+            stat->tag = tag;
+            return stat;
+        }
+        if (stat->tag == tag || strcmp(stat->tag, tag) == 0) {
+            return stat;
+        }
+    }
+
+    return DEEP_SLEEP_LOCK_STATS_OVERFLOW;
+}
+
+size_t mbed_stats_deep_sleep_lock_get_each(mbed_stats_deep_sleep_lock_t *stats, size_t count)
+{
+    size_t n = 0;
+
+    core_util_critical_section_enter();
+    for (int i = 0; i <= MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS && n < count; ++i) {
+        const mbed_stats_deep_sleep_lock_t *stat = &deep_sleep_lock_stats[i];
+        if (stat->lock_cnt == 0) {
+            continue;
+        }
+        stats[n++] = *stat;
+    }
+    core_util_critical_section_exit();
+
+    return n;
+}
+
+#else
+
+size_t mbed_stats_deep_sleep_lock_get_each(mbed_stats_deep_sleep_lock_t *stats, size_t count)
+{
+    (void)stats;
+    (void)count;
+    return 0;
+}
+
+#endif // MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+
+void sleep_manager_lock_deep_sleep_tagged(const char *tag)
+{
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+    core_util_critical_section_enter();
+    mbed_stats_deep_sleep_lock_t *stat = deep_sleep_lock_stats_get(tag, true);
+    stat->lock_cnt++;
+    stat->held_cnt++;
+    core_util_critical_section_exit();
+#else
+    (void)tag;
+#endif
+    sleep_manager_lock_deep_sleep_internal();
+}
+
+void sleep_manager_unlock_deep_sleep_tagged(const char *tag)
+{
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+    core_util_critical_section_enter();
+    mbed_stats_deep_sleep_lock_t *stat = deep_sleep_lock_stats_get(tag, false);
+    if (stat->held_cnt > 0) {
+        stat->held_cnt--;
+    }
+    core_util_critical_section_exit();
+#else
+    (void)tag;
+#endif
+    sleep_manager_unlock_deep_sleep_internal();
+}
+
 void sleep_manager_lock_deep_sleep_internal(void)
 {
     if (core_util_atomic_incr_u16(&deep_sleep_lock, 1) == 0) {
@@ -249,6 +334,13 @@ void sleep_manager_sleep_auto(void)
         deep_sleep_time += end - start;
     } else {
         sleep_time += end - start;
+#if MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS > 0
+        for (int i = 0; i <= MBED_CONF_PLATFORM_DEEP_SLEEP_STATS_SLOTS; ++i) {
+            if (deep_sleep_lock_stats[i].held_cnt > 0) {
+                deep_sleep_lock_stats[i].blocked_time += end - start;
+            }
+        }
+#endif
     }
 #endif
     core_util_critical_section_exit();
@@ -269,6 +361,23 @@ void sleep_manager_unlock_deep_sleep_internal(void)
 
 }
 
+void sleep_manager_lock_deep_sleep_tagged(const char *tag)
+{
+    (void)tag;
+}
+
+void sleep_manager_unlock_deep_sleep_tagged(const char *tag)
+{
+    (void)tag;
+}
+
+size_t mbed_stats_deep_sleep_lock_get_each(mbed_stats_deep_sleep_lock_t *stats, size_t count)
+{
+    (void)stats;
+    (void)count;
+    return 0;
+}
+
 bool sleep_manager_can_deep_sleep(void)
 {
     // no sleep implemented
@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_profile.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
+#include "cmsis.h"
+
+#if MBED_CONF_PLATFORM_PROFILING_ENABLED
+
+/* Probes that have run, newest first. Probes are updated from any context,
+ * so they and the list are only touched in critical sections. */
+static mbed_profile_site_t *profile_sites;
+
+uint32_t mbed_profile_now(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return DWT->CYCCNT;
+#elif DEVICE_USTICKER
+    return ticker_read(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+void mbed_profile_record(mbed_profile_site_t *site, uint32_t start)
+{
+    uint32_t time = mbed_profile_now() - start;
+
+    core_util_critical_section_enter();
+    if (!site->linked) {
+        site->linked = 1;
+        site->next = profile_sites;
+        profile_sites = site;
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+        if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+            CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+            core_util_critical_section_exit();
+            return;
+        }
+#endif
+    }
+
+    if (site->count == 0 || time < site->min) {
+        site->min = time;
+    }
+    if (time > site->max) {
+        site->max = time;
+    }
+    site->total += time;
+    site->count++;
+    core_util_critical_section_exit();
+}
+
+uint32_t mbed_profile_frequency(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return SystemCoreClock;
+#else
+    return 1000000;
+#endif
+}
+
+size_t mbed_profile_get_each(mbed_profile_site_t *stats, size_t count)
+{
+    size_t i = 0;
+
+    core_util_critical_section_enter();
+    for (mbed_profile_site_t *site = profile_sites; site && i < count; site = site->next) {
+        stats[i++] = *site;
+    }
+    core_util_critical_section_exit();
+
+    return i;
+}
+
+void mbed_profile_reset(void)
+{
+    core_util_critical_section_enter();
+    for (mbed_profile_site_t *site = profile_sites; site; site = site->next) {
+        site->count = 0;
+        site->min = 0;
+        site->max = 0;
+        site->total = 0;
+    }
+    core_util_critical_section_exit();
+}
+
+#else
+
+uint32_t mbed_profile_frequency(void)
+{
+    return 0;
+}
+
+size_t mbed_profile_get_each(mbed_profile_site_t *stats, size_t count)
+{
+    (void)stats;
+    (void)count;
+    return 0;
+}
+
+void mbed_profile_reset(void)
+{
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include "platform/mbed_critical.h"
 #include "platform/mbed_poll.h"
 #include "drivers/BufferedSerial.h"
+#include "platform/source/AsyncConsole.h"
 #include "hal/us_ticker_api.h"
 #include "hal/lp_ticker_api.h"
 #include "hal/static_pinmap.h"
@@ -344,6 +345,10 @@ static FileHandle *default_console()
     static const serial_pinmap_t console_pinmap = get_uart_pinmap(STDIO_UART_TX, STDIO_UART_RX);
     static DirectSerial console(console_pinmap, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
 #  endif
+#  if MBED_CONF_PLATFORM_STDIO_ASYNC && MBED_CONF_RTOS_PRESENT
+    static mbed::internal::AsyncConsole async_console(&console);
+    return &async_console;
+#  endif
 #else // MBED_CONF_TARGET_CONSOLE_UART && DEVICE_SERIAL
     static Sink console;
 #endif
@@ -366,6 +371,15 @@ static FileHandle *get_console(int fd)
 #endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 
 namespace mbed {
+uint32_t mbed_console_dropped_bytes()
+{
+#if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY && MBED_CONF_TARGET_CONSOLE_UART && DEVICE_SERIAL && MBED_CONF_PLATFORM_STDIO_ASYNC && MBED_CONF_RTOS_PRESENT
+    return static_cast<mbed::internal::AsyncConsole *>(default_console())->dropped();
+#else
+    return 0;
+#endif
+}
+
 /* Deal with the fact C library may not _open descriptors 0, 1, 2 - auto bind */
 FileHandle *mbed_file_handle(int fd)
 {
@@ -1020,6 +1034,48 @@ extern "C" int ftruncate(int fildes, off_t length)
     }
 }
 
+extern "C" ssize_t readv(int fildes, const struct iovec *iov, int iovcnt)
+{
+    FileHandle *fhc = mbed_file_handle(fildes);
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+    if (iovcnt < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ssize_t ret = fhc->readv(Span<const struct iovec>(iov, iovcnt));
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    } else {
+        return ret;
+    }
+}
+
+extern "C" ssize_t writev(int fildes, const struct iovec *iov, int iovcnt)
+{
+    FileHandle *fhc = mbed_file_handle(fildes);
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+    if (iovcnt < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ssize_t ret = fhc->writev(Span<const struct iovec>(iov, iovcnt));
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    } else {
+        return ret;
+    }
+}
+
 #ifdef __ARMCC_VERSION
 extern "C" int PREFIX(_ensure)(FILEHANDLE fh)
 {
@@ -0,0 +1,155 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_rtos_trace.h"
+
+#if defined(MBED_RTOS_TRACING_ENABLED)
+
+#include <stdbool.h>
+#include "platform/mbed_critical.h"
+#include "hal/itm_api.h"
+#include "hal/us_ticker_api.h"
+#include "cmsis.h"
+
+/* Records come from threads, interrupt handlers and the kernel, so they
+ * are numbered and stored or written out in critical sections. */
+static bool trace_running;
+static mbed_rtos_trace_record_t *trace_records;
+static size_t trace_size;
+static size_t trace_tail;
+static size_t trace_used;
+static uint8_t trace_seq;
+static uint32_t trace_dropped;
+
+static uint32_t trace_timestamp(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    return DWT->CYCCNT;
+#elif DEVICE_USTICKER
+    return (uint32_t)ticker_read_us(get_us_ticker_data());
+#else
+    return 0;
+#endif
+}
+
+void mbed_rtos_trace_start(mbed_rtos_trace_record_t *records, size_t count)
+{
+    uint32_t frequency;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    frequency = SystemCoreClock;
+#else
+    frequency = 1000000;
+#endif
+
+#if DEVICE_ITM
+    if (!records) {
+        mbed_itm_init();
+        ITM->TER |= 1UL << MBED_CONF_PLATFORM_RTOS_TRACE_ITM_PORT;
+#if defined(DWT_CTRL_EXCTRCENA_Msk)
+        DWT->CTRL |= DWT_CTRL_EXCTRCENA_Msk;
+#endif
+    }
+#endif
+
+    core_util_critical_section_enter();
+    trace_records = records;
+    trace_size = records ? count : 0;
+    trace_tail = 0;
+    trace_used = 0;
+    trace_seq = 0;
+    trace_dropped = 0;
+    trace_running = true;
+    core_util_critical_section_exit();
+
+    mbed_rtos_trace(MBED_RTOS_TRACE_START, frequency);
+}
+
+void mbed_rtos_trace_stop(void)
+{
+    trace_running = false;
+#if DEVICE_ITM && defined(DWT_CTRL_EXCTRCENA_Msk)
+    if (!trace_records) {
+        DWT->CTRL &= ~DWT_CTRL_EXCTRCENA_Msk;
+    }
+#endif
+}
+
+void mbed_rtos_trace(uint8_t event, uint32_t object)
+{
+    if (!trace_running) {
+        return;
+    }
+
+    mbed_rtos_trace_record_t record;
+    record.sync = MBED_RTOS_TRACE_RECORD_SYNC;
+    record.event = event;
+    record.object = object;
+
+    core_util_critical_section_enter();
+    record.seq = trace_seq++;
+    record.timestamp = trace_timestamp();
+    if (trace_records) {
+        if (trace_used < trace_size) {
+            size_t index = trace_tail + trace_used;
+            if (index >= trace_size) {
+                index -= trace_size;
+            }
+            trace_records[index] = record;
+            trace_used++;
+        } else {
+            trace_dropped++;
+        }
+    } else {
+#if DEVICE_ITM
+        /* Three word writes, which the ITM FIFO takes without stalling for long */
+        mbed_itm_send_block(MBED_CONF_PLATFORM_RTOS_TRACE_ITM_PORT, &record, sizeof(record));
+#endif
+    }
+    core_util_critical_section_exit();
+}
+
+size_t mbed_rtos_trace_read(mbed_rtos_trace_record_t *records, size_t count)
+{
+    size_t read = 0;
+
+    /* one record per critical section, to keep interrupt latency low */
+    while (read < count) {
+        core_util_critical_section_enter();
+        if (trace_used == 0) {
+            core_util_critical_section_exit();
+            break;
+        }
+        records[read++] = trace_records[trace_tail];
+        if (++trace_tail == trace_size) {
+            trace_tail = 0;
+        }
+        trace_used--;
+        core_util_critical_section_exit();
+    }
+
+    return read;
+}
+
+uint32_t mbed_rtos_trace_dropped(void)
+{
+    return trace_dropped;
+}
+
+#endif // defined(MBED_RTOS_TRACING_ENABLED)
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include "cmsis.h"
 #include "hal/us_ticker_api.h"
+#include "platform/mbed_boot_profile.h"
 
 /* This startup is for baremetal. There is no RTOS in baremetal,
  * therefore we protect this file with MBED_CONF_RTOS_PRESENT.
@@ -52,6 +53,8 @@ MBED_WEAK void mbed_sdk_init(void)
 
 }
 
+void mbed_fast_code_init(void);
+
 MBED_WEAK void software_init_hook_rtos()
 {
     // Nothing by default
@@ -77,6 +80,7 @@ void mbed_copy_nvic(void)
 
 void mbed_init(void)
 {
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_INIT);
 #ifdef MBED_DEBUG
     // Configs to make debugging easier
 #ifdef SCnSCB_ACTLR_DISDEFWBUF_Msk
@@ -87,8 +91,10 @@ void mbed_init(void)
     SCnSCB->ACTLR |= SCnSCB_ACTLR_DISDEFWBUF_Msk;
 #endif
 #endif
+    mbed_fast_code_init();
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_SDK_INIT);
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
@@ -137,8 +143,10 @@ int $Sub$$main(void)
     _platform_post_stackheap_init();
 #endif
     mbed_toolchain_init();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_CONSTRUCTORS);
     mbed_main();
     mbed_error_initialize();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_MAIN);
     return $Super$$main();
 }
 
@@ -172,8 +180,11 @@ void software_init_hook(void)
 
 int __wrap_main(void)
 {
+    // newlib ran the constructors after software_init_hook()
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_CONSTRUCTORS);
     mbed_main();
     mbed_error_initialize();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_MAIN);
     return __real_main();
 }
 
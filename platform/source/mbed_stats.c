@@ -24,6 +24,8 @@
 #include "device.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
+#include "rtos/source/rtos_handlers.h"
+#include "rtos/source/rtos_idle.h"
 #elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
@@ -42,6 +44,9 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
     stats->sleep_time = mbed_time_sleep();
     stats->deep_sleep_time = mbed_time_deepsleep();
 #endif
+#if defined(MBED_CPU_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    rtos_idle_stats_get(stats);
+#endif
 }
 
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
@@ -98,6 +103,11 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
     for (i = 0; i < count; i++) {
         uint32_t stack_size = osThreadGetStackSize(threads[i]);
         stats[i].max_size = stack_size - osThreadGetStackSpace(threads[i]);
+        // A pooled stack keeps the peak of the threads that used it before
+        uint32_t pool_max_size = rtos_stack_pool_max_usage(threads[i]);
+        if (pool_max_size > stats[i].max_size) {
+            stats[i].max_size = pool_max_size;
+        }
         stats[i].reserved_size = stack_size;
         stats[i].thread_id = (uint32_t)threads[i];
         stats[i].stack_cnt = 1;
@@ -132,6 +142,7 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
         stats[i].stack_size = osThreadGetStackSize(threads[i]);
         stats[i].stack_space = osThreadGetStackSpace(threads[i]);
         stats[i].name = osThreadGetName(threads[i]);
+        stats[i].cpu_time = rtos_thread_cpu_time(threads[i]);
     }
     osKernelUnlock();
     free(threads);
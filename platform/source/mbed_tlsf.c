@@ -0,0 +1,424 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/source/mbed_tlsf.h"
+#include <string.h>
+
+/* Block header
+ *
+ * prev_phys and size are always valid and precede the user data. The free
+ * list links are only valid while the block is free, and overlap the user
+ * data otherwise. The low bits of size hold the block flags, since block
+ * sizes are always a multiple of MBED_TLSF_ALIGN_SIZE.
+ *
+ * Each region ends with a zero sized sentinel block which is never free,
+ * so merging never walks past the end of a region.
+ */
+struct mbed_tlsf_block {
+    mbed_tlsf_block_t *prev_phys;
+    size_t size;
+    mbed_tlsf_block_t *next_free;
+    mbed_tlsf_block_t *prev_free;
+};
+
+#define BLOCK_FREE          ((size_t)0x1)
+#define BLOCK_PREV_FREE     ((size_t)0x2)
+#define BLOCK_FLAGS         (BLOCK_FREE | BLOCK_PREV_FREE)
+
+#define BLOCK_HEADER_SIZE   (offsetof(mbed_tlsf_block_t, next_free))
+#define BLOCK_SIZE_MIN      (sizeof(mbed_tlsf_block_t))
+#define BLOCK_SIZE_MAX      (((size_t)1 << MBED_TLSF_FL_INDEX_MAX) - MBED_TLSF_ALIGN_SIZE)
+
+#define ALIGN_UP(x, a)      (((x) + ((a) - 1)) & ~((a) - 1))
+#define ALIGN_DOWN(x, a)    ((x) & ~((a) - 1))
+
+
+// bit scan helpers, index of least and most significant set bit
+static inline int tlsf_ffs(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    int i = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        i += 1;
+    }
+    return i;
+#endif
+}
+
+static inline int tlsf_fls(size_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(size_t) > sizeof(unsigned)) {
+        return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll(x);
+    }
+    return 8 * sizeof(unsigned) - 1 - __builtin_clz(x);
+#else
+    int i = -1;
+    while (x) {
+        x >>= 1;
+        i += 1;
+    }
+    return i;
+#endif
+}
+
+
+// block accessors
+static inline size_t block_size(const mbed_tlsf_block_t *b)
+{
+    return b->size & ~BLOCK_FLAGS;
+}
+
+static inline void block_set_size(mbed_tlsf_block_t *b, size_t size)
+{
+    b->size = size | (b->size & BLOCK_FLAGS);
+}
+
+static inline int block_is_free(const mbed_tlsf_block_t *b)
+{
+    return b->size & BLOCK_FREE;
+}
+
+static inline int block_is_prev_free(const mbed_tlsf_block_t *b)
+{
+    return b->size & BLOCK_PREV_FREE;
+}
+
+static inline mbed_tlsf_block_t *block_next(const mbed_tlsf_block_t *b)
+{
+    return (mbed_tlsf_block_t *)((char *)b + block_size(b));
+}
+
+static inline void *block_to_ptr(const mbed_tlsf_block_t *b)
+{
+    return (char *)b + BLOCK_HEADER_SIZE;
+}
+
+static inline mbed_tlsf_block_t *block_from_ptr(const void *ptr)
+{
+    return (mbed_tlsf_block_t *)((char *)ptr - BLOCK_HEADER_SIZE);
+}
+
+static inline void block_mark_free(mbed_tlsf_block_t *b)
+{
+    mbed_tlsf_block_t *next = block_next(b);
+    next->prev_phys = b;
+    next->size |= BLOCK_PREV_FREE;
+    b->size |= BLOCK_FREE;
+}
+
+static inline void block_mark_used(mbed_tlsf_block_t *b)
+{
+    mbed_tlsf_block_t *next = block_next(b);
+    next->size &= ~BLOCK_PREV_FREE;
+    b->size &= ~BLOCK_FREE;
+}
+
+
+// size class mapping
+static inline void mapping_insert(size_t size, int *fl, int *sl)
+{
+    if (size < ((size_t)1 << MBED_TLSF_FL_INDEX_SHIFT)) {
+        *fl = 0;
+        *sl = (int)(size >> MBED_TLSF_ALIGN_SIZE_LOG2);
+    } else {
+        int f = tlsf_fls(size);
+        *sl = (int)(size >> (f - MBED_TLSF_SL_INDEX_COUNT_LOG2)) ^ MBED_TLSF_SL_INDEX_COUNT;
+        *fl = f - (MBED_TLSF_FL_INDEX_SHIFT - 1);
+    }
+}
+
+// rounds up to the next size class, so any block in the resulting
+// list is large enough
+static inline void mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= ((size_t)1 << MBED_TLSF_FL_INDEX_SHIFT)) {
+        size += ((size_t)1 << (tlsf_fls(size) - MBED_TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+
+// free lists
+static void free_insert(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *b)
+{
+    int fl, sl;
+    mapping_insert(block_size(b), &fl, &sl);
+
+    mbed_tlsf_block_t *head = tlsf->blocks[fl][sl];
+    b->next_free = head;
+    b->prev_free = NULL;
+    if (head) {
+        head->prev_free = b;
+    }
+    tlsf->blocks[fl][sl] = b;
+    tlsf->fl_bitmap |= 1U << fl;
+    tlsf->sl_bitmap[fl] |= 1U << sl;
+}
+
+static void free_remove(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *b)
+{
+    int fl, sl;
+    mapping_insert(block_size(b), &fl, &sl);
+
+    if (b->prev_free) {
+        b->prev_free->next_free = b->next_free;
+    } else {
+        tlsf->blocks[fl][sl] = b->next_free;
+    }
+    if (b->next_free) {
+        b->next_free->prev_free = b->prev_free;
+    }
+
+    if (!tlsf->blocks[fl][sl]) {
+        tlsf->sl_bitmap[fl] &= ~(1U << sl);
+        if (!tlsf->sl_bitmap[fl]) {
+            tlsf->fl_bitmap &= ~(1U << fl);
+        }
+    }
+}
+
+static mbed_tlsf_block_t *free_locate(mbed_tlsf_t *tlsf, size_t size)
+{
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= MBED_TLSF_FL_INDEX_COUNT) {
+        return NULL;
+    }
+
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+        uint32_t fl_map = tlsf->fl_bitmap & (~0U << (fl + 1));
+        if (!fl_map) {
+            return NULL;
+        }
+
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    mbed_tlsf_block_t *b = tlsf->blocks[fl][sl];
+    free_remove(tlsf, b);
+    return b;
+}
+
+
+// splitting and merging
+static mbed_tlsf_block_t *block_split(mbed_tlsf_block_t *b, size_t size)
+{
+    mbed_tlsf_block_t *rest = (mbed_tlsf_block_t *)((char *)b + size);
+    rest->size = block_size(b) - size;
+    rest->prev_phys = b;
+    block_next(rest)->prev_phys = rest;
+    block_set_size(b, size);
+    return rest;
+}
+
+static mbed_tlsf_block_t *block_merge_prev(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *b)
+{
+    if (block_is_prev_free(b)) {
+        mbed_tlsf_block_t *prev = b->prev_phys;
+        free_remove(tlsf, prev);
+        block_set_size(prev, block_size(prev) + block_size(b));
+        block_next(prev)->prev_phys = prev;
+        b = prev;
+    }
+    return b;
+}
+
+static mbed_tlsf_block_t *block_merge_next(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *b)
+{
+    mbed_tlsf_block_t *next = block_next(b);
+    if (block_is_free(next)) {
+        free_remove(tlsf, next);
+        block_set_size(b, block_size(b) + block_size(next));
+        block_next(b)->prev_phys = b;
+    }
+    return b;
+}
+
+// returns the tail of a used block beyond size to the free lists
+static void block_trim_used(mbed_tlsf_t *tlsf, mbed_tlsf_block_t *b, size_t size)
+{
+    if (block_size(b) >= size + BLOCK_SIZE_MIN) {
+        mbed_tlsf_block_t *rest = block_split(b, size);
+        block_mark_free(rest);
+        rest = block_merge_next(tlsf, rest);
+        free_insert(tlsf, rest);
+    }
+}
+
+static size_t adjust_size(size_t size)
+{
+    if (size > BLOCK_SIZE_MAX - BLOCK_HEADER_SIZE) {
+        return 0;
+    }
+
+    size = ALIGN_UP(size + BLOCK_HEADER_SIZE, MBED_TLSF_ALIGN_SIZE);
+    return size < BLOCK_SIZE_MIN ? BLOCK_SIZE_MIN : size;
+}
+
+
+// allocator functions
+void mbed_tlsf_init(mbed_tlsf_t *tlsf)
+{
+    memset(tlsf, 0, sizeof(mbed_tlsf_t));
+}
+
+int mbed_tlsf_add_region(mbed_tlsf_t *tlsf, void *start, size_t size)
+{
+    uintptr_t begin = ALIGN_UP((uintptr_t)start, MBED_TLSF_ALIGN_SIZE);
+    uintptr_t end = ALIGN_DOWN((uintptr_t)start + size, MBED_TLSF_ALIGN_SIZE);
+    int err = -1;
+
+    // each chunk is one free block followed by a sentinel
+    while (end > begin && end - begin >= BLOCK_SIZE_MIN + BLOCK_HEADER_SIZE) {
+        size_t chunk = end - begin - BLOCK_HEADER_SIZE;
+        if (chunk > BLOCK_SIZE_MAX) {
+            chunk = BLOCK_SIZE_MAX;
+        }
+
+        mbed_tlsf_block_t *b = (mbed_tlsf_block_t *)begin;
+        b->prev_phys = NULL;
+        b->size = chunk;
+
+        mbed_tlsf_block_t *sentinel = block_next(b);
+        sentinel->size = 0;
+        block_mark_free(b);
+        free_insert(tlsf, b);
+
+        tlsf->reserved_size += chunk + BLOCK_HEADER_SIZE;
+        begin += chunk + BLOCK_HEADER_SIZE;
+        err = 0;
+    }
+
+    return err;
+}
+
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size)
+{
+    size = adjust_size(size);
+    if (!size) {
+        return NULL;
+    }
+
+    mbed_tlsf_block_t *b = free_locate(tlsf, size);
+    if (!b) {
+        return NULL;
+    }
+
+    block_mark_used(b);
+    block_trim_used(tlsf, b, size);
+    return block_to_ptr(b);
+}
+
+void *mbed_tlsf_memalign(mbed_tlsf_t *tlsf, size_t align, size_t size)
+{
+    if (align <= MBED_TLSF_ALIGN_SIZE) {
+        return mbed_tlsf_malloc(tlsf, size);
+    }
+
+    size = adjust_size(size);
+    if (!size || size + BLOCK_SIZE_MIN > BLOCK_SIZE_MAX
+            || align > BLOCK_SIZE_MAX - BLOCK_SIZE_MIN - size) {
+        return NULL;
+    }
+
+    // leave room to split off a free block in front of the aligned block
+    mbed_tlsf_block_t *b = free_locate(tlsf, size + align + BLOCK_SIZE_MIN);
+    if (!b) {
+        return NULL;
+    }
+
+    uintptr_t ptr = (uintptr_t)block_to_ptr(b);
+    size_t gap = ALIGN_UP(ptr, align) - ptr;
+    if (gap && gap < BLOCK_SIZE_MIN) {
+        gap = ALIGN_UP(ptr + BLOCK_SIZE_MIN, align) - ptr;
+    }
+
+    if (gap) {
+        // blocks on either side of a free block are used, so the leading
+        // block does not need to be merged
+        mbed_tlsf_block_t *aligned = block_split(b, gap);
+        block_mark_free(b);
+        free_insert(tlsf, b);
+        b = aligned;
+    }
+
+    block_mark_used(b);
+    block_trim_used(tlsf, b, size);
+    return block_to_ptr(b);
+}
+
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size)
+{
+    if (!ptr) {
+        return mbed_tlsf_malloc(tlsf, size);
+    }
+
+    if (!size) {
+        mbed_tlsf_free(tlsf, ptr);
+        return NULL;
+    }
+
+    mbed_tlsf_block_t *b = block_from_ptr(ptr);
+    size_t current = block_size(b);
+    size_t adjusted = adjust_size(size);
+    if (!adjusted) {
+        return NULL;
+    }
+
+    if (adjusted > current) {
+        mbed_tlsf_block_t *next = block_next(b);
+        if (!block_is_free(next) || current + block_size(next) < adjusted) {
+            void *p = mbed_tlsf_malloc(tlsf, size);
+            if (p) {
+                memcpy(p, ptr, current - BLOCK_HEADER_SIZE);
+                mbed_tlsf_free(tlsf, ptr);
+            }
+            return p;
+        }
+
+        // grow in place into the following free block
+        block_merge_next(tlsf, b);
+        block_mark_used(b);
+    }
+
+    block_trim_used(tlsf, b, adjusted);
+    return ptr;
+}
+
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    mbed_tlsf_block_t *b = block_from_ptr(ptr);
+    block_mark_free(b);
+    b = block_merge_prev(tlsf, b);
+    b = block_merge_next(tlsf, b);
+    free_insert(tlsf, b);
+}
+
+size_t mbed_tlsf_block_size(const void *ptr)
+{
+    return block_size(block_from_ptr(ptr));
+}
@@ -0,0 +1,138 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TLSF_H
+#define MBED_TLSF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \ingroup mbed-os-internal */
+/** \addtogroup platform-internal-api */
+/** @{*/
+
+/*
+ * Two-level segregated fit allocator
+ *
+ * Free blocks are kept in size-segregated lists indexed by a first level
+ * (power of two) and a second level (linear subdivision of that power of
+ * two). Two bitmaps record which lists are non-empty, so finding a block,
+ * splitting it and merging it with its neighbours on free are all constant
+ * time operations, independent of the number of blocks in the heap.
+ *
+ * The allocator is not thread safe, callers must provide locking.
+ */
+
+/* Number of second level lists per first level, as a power of two */
+#define MBED_TLSF_SL_INDEX_COUNT_LOG2   4
+
+/* Largest block the allocator can hold, as a power of two */
+#define MBED_TLSF_FL_INDEX_MAX          24
+
+#define MBED_TLSF_ALIGN_SIZE_LOG2       (sizeof(void *) == 8 ? 4 : 3)
+#define MBED_TLSF_ALIGN_SIZE            (1 << MBED_TLSF_ALIGN_SIZE_LOG2)
+#define MBED_TLSF_SL_INDEX_COUNT        (1 << MBED_TLSF_SL_INDEX_COUNT_LOG2)
+#define MBED_TLSF_FL_INDEX_SHIFT        (MBED_TLSF_SL_INDEX_COUNT_LOG2 + MBED_TLSF_ALIGN_SIZE_LOG2)
+#define MBED_TLSF_FL_INDEX_COUNT        (MBED_TLSF_FL_INDEX_MAX - MBED_TLSF_FL_INDEX_SHIFT + 1)
+
+typedef struct mbed_tlsf_block mbed_tlsf_block_t;
+
+/* Allocator control structure */
+typedef struct {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[MBED_TLSF_FL_INDEX_COUNT];
+    mbed_tlsf_block_t *blocks[MBED_TLSF_FL_INDEX_COUNT][MBED_TLSF_SL_INDEX_COUNT];
+    size_t reserved_size;
+} mbed_tlsf_t;
+
+/*
+ * Initialize an allocator with no memory
+ *
+ * @param tlsf      Allocator to initialize
+ */
+void mbed_tlsf_init(mbed_tlsf_t *tlsf);
+
+/*
+ * Give a region of memory to the allocator
+ *
+ * Regions do not need to be contiguous. Regions larger than the largest
+ * block the allocator can hold are split.
+ *
+ * @param tlsf      Allocator
+ * @param start     Start of the region
+ * @param size      Size of the region in bytes
+ * @return          0 on success, -1 if the region is too small to be used
+ */
+int mbed_tlsf_add_region(mbed_tlsf_t *tlsf, void *start, size_t size);
+
+/*
+ * Allocate memory aligned to MBED_TLSF_ALIGN_SIZE
+ *
+ * @param tlsf      Allocator
+ * @param size      Size of the allocation in bytes
+ * @return          Pointer to the allocation, or NULL if out of memory
+ */
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size);
+
+/*
+ * Allocate memory with a specific alignment
+ *
+ * @param tlsf      Allocator
+ * @param align     Alignment in bytes, must be a power of two
+ * @param size      Size of the allocation in bytes
+ * @return          Pointer to the allocation, or NULL if out of memory
+ */
+void *mbed_tlsf_memalign(mbed_tlsf_t *tlsf, size_t align, size_t size);
+
+/*
+ * Resize an allocation, in place if possible
+ *
+ * @param tlsf      Allocator
+ * @param ptr       Allocation to resize, or NULL to allocate
+ * @param size      New size in bytes, or 0 to free
+ * @return          Pointer to the resized allocation, or NULL on failure,
+ *                  in which case the original allocation is untouched
+ */
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size);
+
+/*
+ * Free an allocation
+ *
+ * @param tlsf      Allocator
+ * @param ptr       Allocation to free, NULL is ignored
+ */
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr);
+
+/*
+ * Size of the block backing an allocation
+ *
+ * @param ptr       Allocation
+ * @return          Number of bytes taken from the heap by the allocation,
+ *                  including the block header
+ */
+size_t mbed_tlsf_block_size(const void *ptr);
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
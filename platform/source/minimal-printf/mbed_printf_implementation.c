@@ -22,50 +22,6 @@
 #include <stdint.h>
 #include <stddef.h>
 
-#if !TARGET_LIKE_MBED
-/* Linux implementation is for debug only */
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 1
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
-#endif
-
-#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 0
-#endif
-
-#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
-#endif
-
-#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
-#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
-#endif
-
-/**
- * Check architecture and choose storage data type.
- * On 32 bit machines, the default storage type is 32 bit wide
- * unless 64 bit integers are enabled in the configuration.
- */
-#if INTPTR_MAX == INT32_MAX
-#define MBED_SIGNED_NATIVE_TYPE int32_t
-#define MBED_UNSIGNED_NATIVE_TYPE uint32_t
-#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
-#define MBED_SIGNED_STORAGE int64_t
-#define MBED_UNSIGNED_STORAGE uint64_t
-#else
-#define MBED_SIGNED_STORAGE int32_t
-#define MBED_UNSIGNED_STORAGE uint32_t
-#endif
-
-#elif INTPTR_MAX == INT64_MAX
-#define MBED_SIGNED_NATIVE_TYPE int64_t
-#define MBED_UNSIGNED_NATIVE_TYPE uint64_t
-#define MBED_SIGNED_STORAGE int64_t
-#define MBED_UNSIGNED_STORAGE uint64_t
-#else
-#error unsupported architecture
-#endif
-
 /**
  * Precision defines
  */
@@ -86,16 +42,6 @@ typedef enum {
     LENGTH_LL           = 0x82
 } length_t;
 
-/**
- * Prototypes
- */
-static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, FILE *stream);
-static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream);
-static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream, bool upper);
-static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, FILE *stream);
-static void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, FILE *stream);
-
-
 /**
  * @brief      Print a single character, checking for buffer and size overflows.
  *
@@ -104,7 +50,7 @@ static void mbed_minimal_formatted_string_string(char *buffer, size_t length, in
  * @param      result  The current output location.
  * @param[in]  data    The char to be printed.
  */
-static void mbed_minimal_putchar(char *buffer, size_t length, int *result, char data, FILE *stream)
+void mbed_minimal_putchar(char *buffer, size_t length, int *result, char data, FILE *stream)
 {
     /* only continue if 'result' doesn't overflow */
     if ((*result >= 0) && (*result <= INT_MAX - 1)) {
@@ -137,7 +83,7 @@ static void mbed_minimal_putchar(char *buffer, size_t length, int *result, char
  * @param      result  The current output location.
  * @param[in]  value   The value to be printed.
  */
-static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, FILE *stream)
+void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, FILE *stream)
 {
     MBED_UNSIGNED_STORAGE new_value = 0;
 
@@ -164,7 +110,7 @@ static void mbed_minimal_formatted_string_signed(char *buffer, size_t length, in
  * @param      result  The current output location.
  * @param[in]  value   The value to be printed.
  */
-static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream)
+void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream)
 {
     /* treat 0 as a corner case */
     if (value == 0) {
@@ -200,7 +146,7 @@ static void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length,
  * @param[in]  value   The value to be printed.
  * @param      upper   Flag to print the hexadecimal in upper or lower case.
  */
-static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream, bool upper)
+void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream, bool upper)
 {
     bool print_leading_zero = false;
 
@@ -240,7 +186,7 @@ static void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t lengt
  * @param      result  The current output location.
  * @param[in]  value   The pointer to be printed.
  */
-static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, FILE *stream)
+void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, FILE *stream)
 {
     /* write leading 0x */
     mbed_minimal_putchar(buffer, length, result, '0', stream);
@@ -259,7 +205,7 @@ static void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t leng
  * @param      result  The current output location.
  * @param[in]  value   The value to be printed.
  */
-static void mbed_minimal_formatted_string_double(char *buffer, size_t length, int *result, double value, FILE *stream)
+void mbed_minimal_formatted_string_double(char *buffer, size_t length, int *result, double value, FILE *stream)
 {
     /* get integer part */
     MBED_SIGNED_STORAGE integer = value;
@@ -322,7 +268,7 @@ static void mbed_minimal_formatted_string_double(char *buffer, size_t length, in
  * @param[in]  value      The string to be printed.
  * @param[in]  precision  The maximum number of characters to be printed.
  */
-static void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, FILE *stream)
+void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, FILE *stream)
 {
     while ((*string != '\0') && (precision)) {
         mbed_minimal_putchar(buffer, length, result, *string, stream);
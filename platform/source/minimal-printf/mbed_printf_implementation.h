@@ -20,6 +20,75 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !TARGET_LIKE_MBED
+/* Linux implementation is for debug only */
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 1
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT 0
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_SET_FLOATING_POINT_MAX_DECIMALS 6
+#endif
+
+#ifndef MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+#define MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT 1
+#endif
+
+/**
+ * Check architecture and choose storage data type.
+ * On 32 bit machines, the default storage type is 32 bit wide
+ * unless 64 bit integers are enabled in the configuration.
+ */
+#if INTPTR_MAX == INT32_MAX
+#define MBED_SIGNED_NATIVE_TYPE int32_t
+#define MBED_UNSIGNED_NATIVE_TYPE uint32_t
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_64_BIT
+#define MBED_SIGNED_STORAGE int64_t
+#define MBED_UNSIGNED_STORAGE uint64_t
+#else
+#define MBED_SIGNED_STORAGE int32_t
+#define MBED_UNSIGNED_STORAGE uint32_t
+#endif
+
+#elif INTPTR_MAX == INT64_MAX
+#define MBED_SIGNED_NATIVE_TYPE int64_t
+#define MBED_UNSIGNED_NATIVE_TYPE uint64_t
+#define MBED_SIGNED_STORAGE int64_t
+#define MBED_UNSIGNED_STORAGE uint64_t
+#else
+#error unsupported architecture
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 int mbed_minimal_formatted_string(char *buffer, size_t length, const char *format, va_list arguments, FILE *stream);
+
+/**
+ * Converters behind mbed_minimal_formatted_string, also used directly by the
+ * compile-time formatter in platform/mbed_static_printf.h
+ */
+void mbed_minimal_putchar(char *buffer, size_t length, int *result, char data, FILE *stream);
+void mbed_minimal_formatted_string_signed(char *buffer, size_t length, int *result, MBED_SIGNED_STORAGE value, FILE *stream);
+void mbed_minimal_formatted_string_unsigned(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream);
+void mbed_minimal_formatted_string_hexadecimal(char *buffer, size_t length, int *result, MBED_UNSIGNED_STORAGE value, FILE *stream, bool upper);
+void mbed_minimal_formatted_string_void_pointer(char *buffer, size_t length, int *result, const void *value, FILE *stream);
+void mbed_minimal_formatted_string_string(char *buffer, size_t length, int *result, const char *string, size_t precision, FILE *stream);
+#if MBED_CONF_PLATFORM_MINIMAL_PRINTF_ENABLE_FLOATING_POINT
+void mbed_minimal_formatted_string_double(char *buffer, size_t length, int *result, double value, FILE *stream);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -29,6 +29,7 @@
 #include "rtos/mbed_rtos_types.h"
 #include "rtos/mbed_rtos1_types.h"
 #include "rtos/mbed_rtos_storage.h"
+#include "rtos/WaitSet.h"
 
 #include "platform/NonCopyable.h"
 
@@ -161,8 +162,11 @@ private:
     uint32_t wait_until(uint32_t flags, uint32_t opt, Kernel::Clock::time_point abs_time, bool clear);
 
 #if MBED_CONF_RTOS_PRESENT
+    friend class WaitSet;
+
     osEventFlagsId_t                _id;
     mbed_rtos_storage_event_flags_t _obj_mem;
+    internal::WaitSetLink           _wait_set_link;
 #else
     uint32_t _flags;
 #endif
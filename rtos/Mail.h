@@ -324,6 +324,8 @@ public:
     }
 
 private:
+    friend class WaitSet;
+
     Queue<T, queue_sz> _queue;
     MemoryPool<T, queue_sz> _pool;
 };
@@ -33,6 +33,21 @@
 #include "platform/ScopedLock.h"
 #include "platform/mbed_toolchain.h"
 
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED || defined(DOXYGEN_ONLY)
+/**
+ * struct mbed_stats_mutex_t definition
+ */
+typedef struct {
+    const char *name;               /**< Name of the mutex */
+    uint32_t lock_cnt;              /**< Number of times the mutex was acquired by a thread not already holding it */
+    uint32_t contended_cnt;         /**< Number of lock attempts that found the mutex held by another thread */
+    uint64_t total_wait_time;       /**< Total time threads spent waiting for the mutex, in microseconds */
+    uint32_t max_wait_time;         /**< Longest time a thread waited for the mutex, in microseconds */
+    uint32_t max_hold_time;         /**< Longest time the mutex was held, in microseconds */
+    osThreadId_t max_hold_owner;    /**< Thread that held the mutex for max_hold_time */
+} mbed_stats_mutex_t;
+#endif
+
 namespace rtos {
 /** \addtogroup rtos-public-api */
 /** @{*/
@@ -164,6 +179,18 @@ public:
      */
     osThreadId_t get_owner();
 
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED || defined(DOXYGEN_ONLY)
+    /** Get the contention statistics of this mutex
+
+      @param   stats  pointer to the structure to fill.
+      @param   reset  clear the statistics after reading them (default: false).
+
+      @note Requires the rtos-api.mutex-stats-enabled configuration option.
+      @note You cannot call this function from ISR context.
+     */
+    void get_stats(mbed_stats_mutex_t *stats, bool reset = false);
+#endif
+
     /** Mutex destructor
      *
      * @note You cannot call this function from ISR context.
@@ -173,11 +200,16 @@ public:
 private:
 #if MBED_CONF_RTOS_PRESENT
     void constructor(const char *name = nullptr);
+    osStatus acquire(uint32_t millisec);
     friend class ConditionVariable;
 
     osMutexId_t               _id;
     mbed_rtos_storage_mutex_t _obj_mem;
     uint32_t                  _count;
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+    mbed_stats_mutex_t        _stats;
+    uint64_t                  _lock_time;
+#endif
 #endif
 };
 
@@ -226,6 +258,13 @@ inline bool Mutex::trylock_until(Kernel::Clock::time_point)
 inline void Mutex::unlock()
 {
 }
+
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+inline void Mutex::get_stats(mbed_stats_mutex_t *stats, bool)
+{
+    *stats = mbed_stats_mutex_t();
+}
+#endif
 #endif
 
 /** @}*/
@@ -27,6 +27,7 @@
 #include "rtos/mbed_rtos1_types.h"
 #include "rtos/mbed_rtos_storage.h"
 #include "rtos/Kernel.h"
+#include "rtos/WaitSet.h"
 #include "platform/mbed_error.h"
 #include "platform/NonCopyable.h"
 
@@ -160,7 +161,11 @@ public:
      */
     osStatus put(T *data, Kernel::Clock::duration_u32 rel_time = Kernel::Clock::duration_u32::zero(), uint8_t prio = 0)
     {
-        return osMessageQueuePut(_id, &data, prio, rel_time.count());
+        osStatus status = osMessageQueuePut(_id, &data, prio, rel_time.count());
+        if (status == osOK) {
+            _wait_set_link.notify();
+        }
+        return status;
     }
 
     /** Inserts the given element to the end of the queue.
@@ -309,9 +314,12 @@ public:
         return get(std::chrono::duration<uint32_t, std::milli>(millisec));
     }
 private:
+    friend class WaitSet;
+
     osMessageQueueId_t            _id;
     char                          _queue_mem[queue_sz * (sizeof(T *) + sizeof(mbed_rtos_storage_message_t))];
     mbed_rtos_storage_msg_queue_t _obj_mem;
+    internal::WaitSetLink         _wait_set_link;
 };
 /** @}*/
 /** @}*/
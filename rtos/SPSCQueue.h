@@ -0,0 +1,295 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include "rtos/Kernel.h"
+#include "rtos/EventFlags.h"
+#include "platform/mbed_atomic.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_SPSCQueue SPSCQueue class
+ * @{
+ */
+
+/** The SPSCQueue class is a lock-free ring buffer of elements of type T
+ * with a single producer and a single consumer.
+ *
+ * Elements are copied into the ring, or constructed in place with
+ * try_reserve()/commit() and consumed in place with try_peek()/pop(), so
+ * no memory pool is needed. Putting an element never blocks and never
+ * takes a lock, which makes the queue suitable for high-rate streams fed
+ * from an interrupt, such as UART or ADC samples.
+ *
+ * The consumer only involves the RTOS when it has to block on an empty
+ * ring. The producer signals the consumer only if it is actually waiting,
+ * so a busy stream costs no kernel calls.
+ *
+ * @note
+ * Exactly one context may put elements and exactly one context may get
+ * elements. The producer and consumer may be different threads, or the
+ * producer may be an interrupt handler. Putting from several contexts, or
+ * getting from several contexts, is not safe.
+ *
+ * @tparam T   Type of the elements in the queue.
+ * @tparam N   Maximum number of elements in the queue.
+ *
+ * @note
+ * Memory considerations: The ring storage is part of the SPSCQueue object,
+ * so it is allocated wherever the object is.
+ */
+template<typename T, uint32_t N>
+class SPSCQueue : private mbed::NonCopyable<SPSCQueue<T, N> > {
+    static_assert(N > 0, "SPSCQueue must hold at least one element");
+
+public:
+    /** Create and initialize an empty SPSCQueue.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    SPSCQueue() : _head(0), _tail(0), _waiting(0)
+    {
+    }
+
+    /** Check if the queue is empty.
+     *
+     * @return True if the queue is empty, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool empty() const
+    {
+        return count() == 0;
+    }
+
+    /** Check if the queue is full.
+     *
+     * @return True if the queue is full, false if not
+     *
+     * @note You may call this function from ISR context.
+     */
+    bool full() const
+    {
+        return count() == N;
+    }
+
+    /** Get number of elements in the queue.
+     *
+     * The value is a snapshot; it may already be stale if the other side
+     * is active.
+     *
+     * @return Number of elements in the queue
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t count() const
+    {
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        return tail >= head ? tail - head : tail + N + 1 - head;
+    }
+
+    /** Reserve the next free slot for in-place construction.
+     *
+     * The slot is not visible to the consumer until commit() is called.
+     * Calling try_reserve() again before commit() returns the same slot.
+     *
+     * @return Pointer to the free slot, or nullptr if the queue is full
+     *
+     * @note Producer only.
+     * @note You may call this function from ISR context.
+     */
+    T *try_reserve()
+    {
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_relaxed);
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        if (incr(tail) == head) {
+            return nullptr;
+        }
+
+        return &_buffer[tail];
+    }
+
+    /** Publish the slot returned by the last try_reserve() to the consumer.
+     *
+     * Wakes the consumer if it is blocked in try_get_for().
+     *
+     * @note Producer only. Must follow a successful try_reserve().
+     * @note You may call this function from ISR context.
+     */
+    void commit()
+    {
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_relaxed);
+        // Sequentially consistent store, so it is ordered against the
+        // load of _waiting below and the consumer can not miss the wakeup
+        core_util_atomic_store_u32(&_tail, incr(tail));
+        if (core_util_atomic_load_u32(&_waiting)) {
+            _flags.set(FLAG_PUT);
+        }
+    }
+
+    /** Copy an element into the queue without blocking.
+     *
+     * @param  data  Element to put into the queue.
+     * @return True if the element was put, false if the queue is full
+     *
+     * @note Producer only.
+     * @note You may call this function from ISR context.
+     */
+    bool try_put(const T &data)
+    {
+        T *slot = try_reserve();
+        if (!slot) {
+            return false;
+        }
+
+        *slot = data;
+        commit();
+        return true;
+    }
+
+    /** Access the oldest element in the queue without removing it.
+     *
+     * @return Pointer to the oldest element, or nullptr if the queue is empty
+     *
+     * @note Consumer only.
+     * @note You may call this function from ISR context.
+     */
+    T *try_peek()
+    {
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_relaxed);
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        if (head == tail) {
+            return nullptr;
+        }
+
+        return &_buffer[head];
+    }
+
+    /** Remove the oldest element, returning its slot to the producer.
+     *
+     * @note Consumer only. Must follow a successful try_peek().
+     * @note You may call this function from ISR context.
+     */
+    void pop()
+    {
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_relaxed);
+        core_util_atomic_store_explicit_u32(&_head, incr(head), mbed_memory_order_release);
+    }
+
+    /** Copy the oldest element out of the queue without blocking.
+     *
+     * @param  data  Destination for the element.
+     * @return True if an element was retrieved, false if the queue is empty
+     *
+     * @note Consumer only.
+     * @note You may call this function from ISR context.
+     */
+    bool try_get(T *data)
+    {
+        T *slot = try_peek();
+        if (!slot) {
+            return false;
+        }
+
+        *data = *slot;
+        pop();
+        return true;
+    }
+
+    /** Copy the oldest element out of the queue, blocking while it is empty.
+     *
+     * @param  rel_time  Timeout value.
+     * @param  data      Destination for the element.
+     * @return True if an element was retrieved, false on timeout
+     *
+     * @note Consumer only.
+     * @note You may call this function from ISR context if the rel_time
+     *       parameter is set to 0.
+     */
+    bool try_get_for(Kernel::Clock::duration_u32 rel_time, T *data)
+    {
+        if (try_get(data)) {
+            return true;
+        }
+
+        bool forever = rel_time == Kernel::wait_for_u32_forever;
+        Kernel::Clock::time_point deadline = Kernel::Clock::now() + rel_time;
+        while (rel_time != rel_time.zero()) {
+            // Announce the wait before checking again, so a put that
+            // races with us either is seen here or sets the flag
+            core_util_atomic_store_u32(&_waiting, 1);
+            if (try_get(data)) {
+                core_util_atomic_store_u32(&_waiting, 0);
+                return true;
+            }
+
+            _flags.wait_any_for(FLAG_PUT, rel_time);
+            core_util_atomic_store_u32(&_waiting, 0);
+            if (try_get(data)) {
+                return true;
+            }
+
+            // A stale flag from an earlier put, keep waiting
+            if (!forever) {
+                Kernel::Clock::time_point now = Kernel::Clock::now();
+                rel_time = now < deadline
+                           ? std::chrono::duration_cast<Kernel::Clock::duration_u32>(deadline - now)
+                           : rel_time.zero();
+            }
+        }
+
+        return false;
+    }
+
+private:
+    static constexpr uint32_t FLAG_PUT = 0x1;
+
+    static constexpr uint32_t incr(uint32_t i)
+    {
+        return i == N ? 0 : i + 1;
+    }
+
+    // One slot is kept free to tell a full ring from an empty one
+    T _buffer[N + 1];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+    volatile uint32_t _waiting;
+    EventFlags _flags;
+};
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
+
+#endif // SPSC_QUEUE_H
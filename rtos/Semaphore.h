@@ -29,6 +29,7 @@
 #include "rtos/mbed_rtos1_types.h"
 #include "rtos/mbed_rtos_storage.h"
 #include "rtos/Kernel.h"
+#include "rtos/WaitSet.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/NonCopyable.h"
 
@@ -143,10 +144,13 @@ private:
     void constructor(int32_t count, uint16_t max_count);
 
 #if MBED_CONF_RTOS_PRESENT
+    friend class WaitSet;
+
     int32_t _wait(uint32_t millisec);
 
     osSemaphoreId_t               _id;
     mbed_rtos_storage_semaphore_t _obj_mem;
+    internal::WaitSetLink         _wait_set_link;
 #else
     static bool semaphore_available(void *);
     int32_t _count;
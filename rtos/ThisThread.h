@@ -246,6 +246,16 @@ void sleep_until(uint64_t millisec);
 */
 void sleep_until(Kernel::Clock::time_point abs_time);
 
+/** Sleep for a specified time period with microsecond resolution:
+  @param   rel_time  time delay value
+  @note You cannot call this function from ISR context.
+  @note The thread is woken by a one-shot microsecond ticker event of its own,
+        so the kernel tick rate is unchanged. Whole ticks of a longer sleep are
+        spent in an ordinary kernel sleep, and deep sleep is only locked for
+        the final part.
+*/
+void sleep_for_us(std::chrono::microseconds rel_time);
+
 /** Pass control to next equal-priority thread that is in state READY.
     (Higher-priority READY threads would prevent us from running; this
     will not enable lower-priority threads to run, as we remain READY).
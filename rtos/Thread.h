@@ -32,6 +32,7 @@
 #include "platform/NonCopyable.h"
 #include "rtos/Semaphore.h"
 #include "rtos/Mutex.h"
+#include "rtos/ThreadStackPool.h"
 
 #if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY) || defined(UNITTEST)
 
@@ -76,6 +77,7 @@ namespace rtos {
  * Memory considerations: The thread control structures will be created on current thread's stack, both for the mbed OS
  * and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
  * Additionally the stack memory for this thread will be allocated on the heap, if it wasn't supplied to the constructor.
+ * Threads created often can take their stack from a ThreadStackAllocator such as ThreadStackPool instead.
  *
  * @note
  * MBED_TZ_DEFAULT_ACCESS (default:0) flag can be used to change the default access of all user threads in non-secure mode.
@@ -128,6 +130,25 @@ public:
         constructor(tz_module, priority, stack_size, stack_mem, name);
     }
 
+    /** Allocate a new thread without starting execution, taking its stack from an allocator
+      @param   priority       initial priority of the thread function.
+      @param   stack_size     stack size (in bytes) requirements for the thread function.
+      @param   allocator      allocator the stack is taken from when the thread starts and given back to when it is destroyed,
+                              for example ThreadStackPool::get_default_instance(). It has to outlive the thread.
+      @param   name           name to be used for this thread. It has to stay allocated for the lifetime of the thread (default: nullptr)
+
+      @note Default value of tz_module will be MBED_TZ_DEFAULT_ACCESS
+      @note start() returns osErrorNoMemory if the allocator has no stack to give.
+      @note You cannot call this function from ISR context.
+    */
+
+    Thread(osPriority priority, uint32_t stack_size,
+           ThreadStackAllocator &allocator, const char *name = nullptr)
+    {
+        constructor(priority, stack_size, nullptr, name);
+        _allocator = &allocator;
+    }
+
 
     /** Starts a thread executing the specified function.
       @param   task           function to be executed by this thread.
@@ -265,12 +286,14 @@ private:
                      uint32_t stack_size = OS_STACK_SIZE,
                      unsigned char *stack_mem = nullptr,
                      const char *name = nullptr);
+    void free_stack_mem();
     static void _thunk(void *thread_ptr);
 
     mbed::Callback<void()>     _task;
     osThreadId_t               _tid;
     osThreadAttr_t             _attr;
     bool                       _dynamic_stack;
+    ThreadStackAllocator      *_allocator;
     bool                       _finished;
     Semaphore                  _join_sem;
     mutable Mutex              _mutex;
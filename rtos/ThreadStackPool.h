@@ -0,0 +1,137 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef THREAD_STACK_POOL_H
+#define THREAD_STACK_POOL_H
+
+#include <stdint.h>
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY) || defined(UNITTEST)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_ThreadStackPool ThreadStackPool class
+ * @{
+ */
+
+/** Interface of the allocators a Thread can take its stack from
+ *
+ * A Thread given an allocator gets its stack when it is started and gives it
+ * back when it is destroyed, instead of using the heap.
+ */
+class ThreadStackAllocator {
+public:
+    /** Allocate a stack
+     *
+     * @param size Size of the stack in bytes
+     * @return Stack of at least @p size bytes, aligned to 8 bytes, or nullptr if none is free
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    virtual void *allocate(uint32_t size) = 0;
+
+    /** Give back a stack from allocate()
+     *
+     * @param stack Stack to give back
+     * @param size  Size the stack was allocated with
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    virtual void deallocate(void *stack, uint32_t size) = 0;
+
+protected:
+    ~ThreadStackAllocator() = default;
+};
+
+/** Pool of thread stacks in a static region
+ *
+ * The pool has three size classes, small, medium and large, each with a
+ * number of stacks set by the rtos.thread-stack-pool-* configuration. A
+ * stack is taken from the smallest class it fits that has one free, so
+ * short-lived threads can be created and destroyed without fragmenting the
+ * heap.
+ *
+ *  Example:
+ *  @code
+ *  Thread worker(osPriorityNormal, 1024, ThreadStackPool::get_default_instance());
+ *
+ *  if (worker.start(do_work) == osErrorNoMemory) {
+ *      // All the stacks large enough are in use
+ *  }
+ *  @endcode
+ *
+ * The peak usage of each stack is kept when it is given back, and is
+ * reported by mbed_stats_stack_get_each() for the threads using it later.
+ * This shows whether the size classes fit the threads they serve.
+ *
+ * @note
+ * All the counts default to 0, so the pool has no stacks and takes no memory
+ * until it is configured.
+ */
+class ThreadStackPool : public ThreadStackAllocator, private mbed::NonCopyable<ThreadStackPool> {
+public:
+    /** Get the pool configured by the rtos.thread-stack-pool-* options
+     *
+     * @return Reference to the pool
+     */
+    static ThreadStackPool &get_default_instance();
+
+    /** Take a stack from the smallest class it fits that has one free
+     *
+     * @param size Size of the stack in bytes
+     * @return Stack of the class, or nullptr if all the stacks large enough
+     *         are in use
+     */
+    void *allocate(uint32_t size) override;
+
+    /** Give back a stack from allocate(), recording its peak usage when
+     * stack statistics are enabled
+     *
+     * @param stack Stack to give back
+     * @param size  Size the stack was allocated with
+     */
+    void deallocate(void *stack, uint32_t size) override;
+
+    /** Get the peak usage recorded for a stack of the pool
+     *
+     * @param stack Any address within a stack
+     * @return Peak usage in bytes of the threads that have given the stack
+     *         back, or 0 if @p stack is not in the pool
+     *
+     * @note You may call this function from ISR context.
+     */
+    uint32_t max_usage(const void *stack) const;
+
+private:
+    constexpr ThreadStackPool() = default;
+};
+
+/** @}*/
+/** @}*/
+}
+#endif
+
+#endif
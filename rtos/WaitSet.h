@@ -0,0 +1,229 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef WAIT_SET_H
+#define WAIT_SET_H
+
+#include <stdint.h>
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/Kernel.h"
+#include "platform/mbed_atomic.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+
+class Semaphore;
+class EventFlags;
+template<typename T, uint32_t queue_sz> class Queue;
+template<typename T, uint32_t queue_sz> class Mail;
+
+namespace internal {
+
+/** Link from an object to the thread waiting on it in a WaitSet
+ *
+ * Kept by each object a WaitSet can wait on, and notified whenever the
+ * object may have become ready.
+ */
+struct WaitSetLink {
+    osThreadId_t thread = nullptr;
+
+    void notify()
+    {
+        osThreadId_t waiter = core_util_atomic_load(&thread);
+        if (waiter) {
+            osThreadFlagsSet(waiter, MBED_CONF_RTOS_WAIT_SET_FLAG);
+        }
+    }
+};
+
+}
+
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_WaitSet WaitSet class
+ * @{
+ */
+
+/** The WaitSet class lets a thread wait on several objects at once.
+ *
+ * Semaphores, EventFlags, Queues and Mails are added to the set, then wait()
+ * blocks until any of them is ready and returns its index. A single thread
+ * can so serve several sources instead of one thread, and one stack, per
+ * source.
+ *
+ *  Example:
+ *  @code
+ *  Queue<message_t, 8> commands;
+ *  EventFlags events;
+ *  WaitSet set;
+ *
+ *  const int command_index = set.add(commands);
+ *  const int event_index = set.add(events, LINK_UP_FLAG | LINK_DOWN_FLAG);
+ *
+ *  while (true) {
+ *      int index = set.wait();
+ *      if (index == command_index) {
+ *          osEvent evt = commands.get(0s);
+ *          if (evt.status == osEventMessage) {
+ *              handle_command(static_cast<message_t *>(evt.value.p));
+ *          }
+ *      } else if (index == event_index) {
+ *          handle_link(events.clear(LINK_UP_FLAG | LINK_DOWN_FLAG));
+ *      }
+ *  }
+ *  @endcode
+ *
+ * wait() only reports that an object is ready, it does not take anything
+ * from it. The waiting thread then takes from the object without blocking,
+ * which can fail if another thread took from it first.
+ *
+ * The objects wake the waiting thread with the rtos.wait-set-flag thread
+ * flag, which the thread must not use for anything else. Ready objects are
+ * reported in turn, so a busy object does not starve the others.
+ *
+ * @note
+ * An object can be in one WaitSet at a time, and must be removed from it
+ * before it is destroyed.
+ *
+ * @note
+ * Bare metal profile: This class is not supported.
+ */
+class WaitSet : private mbed::NonCopyable<WaitSet> {
+public:
+    /** Create an empty WaitSet
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    WaitSet();
+
+    /** Add a Semaphore, ready while it has tokens
+     *
+     * @param semaphore Semaphore to wait on
+     * @return Index of the semaphore in the set, or -1 if the set is full
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    int add(Semaphore &semaphore);
+
+    /** Add an EventFlags, ready while any of the given flags is set
+     *
+     * @param event_flags EventFlags to wait on
+     * @param flags       Flags to wait for
+     * @return Index of the event flags in the set, or -1 if the set is full
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    int add(EventFlags &event_flags, uint32_t flags);
+
+    /** Add a Queue, ready while it has messages
+     *
+     * @param queue Queue to wait on
+     * @return Index of the queue in the set, or -1 if the set is full
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    template<typename T, uint32_t queue_sz>
+    int add(Queue<T, queue_sz> &queue)
+    {
+        return add(queue._wait_set_link, &queue, queue_ready<Queue<T, queue_sz>>, 0);
+    }
+
+    /** Add a Mail, ready while it has mail
+     *
+     * @param mail Mail to wait on
+     * @return Index of the mail in the set, or -1 if the set is full
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    template<typename T, uint32_t queue_sz>
+    int add(Mail<T, queue_sz> &mail)
+    {
+        return add(mail._queue);
+    }
+
+    /** Remove an object from the set
+     *
+     * @param index Index add() returned for the object
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void remove(int index);
+
+    /** Wait until an object of the set is ready
+     *
+     * @return Index of the ready object
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    int wait();
+
+    /** Wait until an object of the set is ready or a timeout occurs
+     *
+     * @param rel_time Timeout value
+     * @return Index of the ready object, or -1 if the timeout occurred
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    int wait_for(Kernel::Clock::duration_u32 rel_time);
+
+    /** WaitSet destructor, removes all the objects
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    ~WaitSet();
+
+private:
+    typedef bool (*ready_t)(const void *object, uint32_t flags);
+
+    struct entry_t {
+        internal::WaitSetLink *link;
+        const void *object;
+        ready_t ready;
+        uint32_t flags;
+    };
+
+    int add(internal::WaitSetLink &link, const void *object, ready_t ready, uint32_t flags);
+    int poll();
+
+    template<typename Q>
+    static bool queue_ready(const void *object, uint32_t)
+    {
+        return !static_cast<const Q *>(object)->empty();
+    }
+    static bool semaphore_ready(const void *object, uint32_t);
+    static bool event_flags_ready(const void *object, uint32_t flags);
+
+    entry_t _entries[MBED_CONF_RTOS_WAIT_SET_CAPACITY];
+    unsigned _next;
+};
+
+/** @}*/
+/** @}*/
+
+}
+#endif
+
+#endif
@@ -27,14 +27,17 @@
 #include "rtos/mbed_rtos_storage.h"
 #include "rtos/Kernel.h"
 #include "rtos/Thread.h"
+#include "rtos/ThreadStackPool.h"
 #include "rtos/ThisThread.h"
 #include "rtos/Mutex.h"
 #include "rtos/Semaphore.h"
 #include "rtos/Mail.h"
 #include "rtos/MemoryPool.h"
 #include "rtos/Queue.h"
+#include "rtos/SPSCQueue.h"
 #include "rtos/EventFlags.h"
 #include "rtos/ConditionVariable.h"
+#include "rtos/WaitSet.h"
 
 
 /** \defgroup rtos-public-api RTOS
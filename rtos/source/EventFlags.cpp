@@ -59,7 +59,11 @@ void EventFlags::constructor(const char *name)
 uint32_t EventFlags::set(uint32_t flags)
 {
 #if MBED_CONF_RTOS_PRESENT
-    return osEventFlagsSet(_id, flags);
+    uint32_t ret = osEventFlagsSet(_id, flags);
+    if (!(ret & osFlagsError)) {
+        _wait_set_link.notify();
+    }
+    return ret;
 #else
     return core_util_atomic_fetch_or_u32(&_flags, flags) | flags;
 #endif
@@ -26,6 +26,10 @@
 #include <string.h>
 #include "platform/mbed_error.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_rtos_trace.h"
+#include "hal/us_ticker_api.h"
+#include "cmsis.h"
 
 #if MBED_CONF_RTOS_PRESENT
 
@@ -45,9 +49,101 @@ Mutex::Mutex(const char *name)
     constructor(name);
 }
 
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+static uint64_t mutex_stats_now()
+{
+#if DEVICE_USTICKER
+    return ticker_read_us(get_us_ticker_data());
+#else
+    return Kernel::Clock::now().time_since_epoch().count() * 1000;
+#endif
+}
+#endif
+
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+// Uncontended locks and unlocks update the RTX control block the same way
+// the kernel would, with interrupts masked instead of through an SVC call.
+// Anything that could need the scheduler, such as waiting threads or a
+// raised priority, is left to the kernel so priority inheritance still works.
+static osRtxThread_t *mutex_fast_thread()
+{
+    if (__get_IPSR() != 0 || osRtxInfo.kernel.state != osRtxKernelRunning) {
+        return NULL;
+    }
+    return osRtxInfo.thread.run.curr;
+}
+
+static bool mutex_fast_acquire(mbed_rtos_storage_mutex_t *mutex)
+{
+    bool acquired = false;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    osRtxThread_t *thread = mutex_fast_thread();
+    if (thread && mutex->id == osRtxIdMutex) {
+        if (mutex->lock == 0) {
+            mutex->owner_thread = thread;
+            mutex->owner_next = thread->mutex_list;
+            mutex->owner_prev = NULL;
+            if (thread->mutex_list) {
+                thread->mutex_list->owner_prev = mutex;
+            }
+            thread->mutex_list = mutex;
+            mutex->lock = 1;
+            acquired = true;
+        } else if (mutex->owner_thread == thread && mutex->lock != osRtxMutexLockLimit) {
+            mutex->lock++;
+            acquired = true;
+        }
+    }
+
+    __set_PRIMASK(primask);
+    if (acquired) {
+        MBED_RTOS_TRACE(MBED_RTOS_TRACE_MUTEX_ACQUIRED, mutex);
+    }
+    return acquired;
+}
+
+static bool mutex_fast_release(mbed_rtos_storage_mutex_t *mutex)
+{
+    bool released = false;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    osRtxThread_t *thread = mutex_fast_thread();
+    if (thread && mutex->id == osRtxIdMutex && mutex->lock != 0 && mutex->owner_thread == thread) {
+        if (mutex->lock > 1) {
+            mutex->lock--;
+            released = true;
+        } else if (!mutex->thread_list && thread->priority == thread->priority_base) {
+            if (mutex->owner_next) {
+                mutex->owner_next->owner_prev = mutex->owner_prev;
+            }
+            if (mutex->owner_prev) {
+                mutex->owner_prev->owner_next = mutex->owner_next;
+            } else {
+                thread->mutex_list = mutex->owner_next;
+            }
+            mutex->lock = 0;
+            released = true;
+        }
+    }
+
+    __set_PRIMASK(primask);
+    if (released) {
+        MBED_RTOS_TRACE(MBED_RTOS_TRACE_MUTEX_RELEASED, mutex);
+    }
+    return released;
+}
+#endif
+
 void Mutex::constructor(const char *name)
 {
     _count = 0;
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+    memset(&_stats, 0, sizeof(_stats));
+    _lock_time = 0;
+#endif
     osMutexAttr_t attr =
     { 0 };
     attr.name = name ? name : "application_unnamed_mutex";
@@ -61,12 +157,56 @@ void Mutex::constructor(const char *name)
     MBED_ASSERT(_id || mbed_get_error_in_progress());
 }
 
-void Mutex::lock(void)
+osStatus Mutex::acquire(uint32_t millisec)
 {
-    osStatus status = osMutexAcquire(_id, osWaitForever);
-    if (osOK == status) {
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+    uint64_t start = mutex_stats_now();
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    osStatus status = mutex_fast_acquire(&_obj_mem) ? osOK : osMutexAcquire(_id, 0);
+#else
+    osStatus status = osMutexAcquire(_id, 0);
+#endif
+    bool contended = (status == osErrorResource);
+    if (contended) {
+        // Not holding the mutex yet, so count atomically
+        core_util_atomic_incr_u32(&_stats.contended_cnt, 1);
+        if (millisec != 0) {
+            status = osMutexAcquire(_id, millisec);
+        }
+    }
+
+    if (status == osOK) {
         _count++;
+        // The remaining statistics are only updated while holding the mutex
+        if (_count == 1) {
+            _lock_time = mutex_stats_now();
+            _stats.lock_cnt++;
+            if (contended) {
+                uint64_t wait = _lock_time - start;
+                _stats.total_wait_time += wait;
+                if (wait > _stats.max_wait_time) {
+                    _stats.max_wait_time = wait > UINT32_MAX ? UINT32_MAX : (uint32_t)wait;
+                }
+            }
+        }
     }
+#else
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    osStatus status = mutex_fast_acquire(&_obj_mem) ? osOK : osMutexAcquire(_id, millisec);
+#else
+    osStatus status = osMutexAcquire(_id, millisec);
+#endif
+    if (status == osOK) {
+        _count++;
+    }
+#endif
+
+    return status;
+}
+
+void Mutex::lock(void)
+{
+    osStatus status = acquire(osWaitForever);
 
     if (status != osOK && !mbed_get_error_in_progress()) {
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_MUTEX_LOCK_FAILED), "Mutex lock failed", status);
@@ -85,9 +225,8 @@ bool Mutex::trylock_for(uint32_t millisec)
 
 bool Mutex::trylock_for(Kernel::Clock::duration_u32 rel_time)
 {
-    osStatus status = osMutexAcquire(_id, rel_time.count());
+    osStatus status = acquire(rel_time.count());
     if (status == osOK) {
-        _count++;
         return true;
     }
 
@@ -123,7 +262,22 @@ bool Mutex::trylock_until(Kernel::Clock::time_point abs_time)
 
 void Mutex::unlock()
 {
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+    osThreadId_t owner = osMutexGetOwner(_id);
+    if (_count == 1 && owner == osThreadGetId()) {
+        uint64_t hold = mutex_stats_now() - _lock_time;
+        if (hold > _stats.max_hold_time) {
+            _stats.max_hold_time = hold > UINT32_MAX ? UINT32_MAX : (uint32_t)hold;
+            _stats.max_hold_owner = owner;
+        }
+    }
+#endif
+
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    osStatus status = mutex_fast_release(&_obj_mem) ? osOK : osMutexRelease(_id);
+#else
     osStatus status = osMutexRelease(_id);
+#endif
     if (osOK == status) {
         _count--;
     }
@@ -138,6 +292,26 @@ osThreadId Mutex::get_owner()
     return osMutexGetOwner(_id);
 }
 
+#if MBED_CONF_RTOS_API_MUTEX_STATS_ENABLED
+void Mutex::get_stats(mbed_stats_mutex_t *stats, bool reset)
+{
+    MBED_ASSERT(stats != NULL);
+
+    // Take the mutex directly, so reading the statistics does not change them
+    osMutexAcquire(_id, osWaitForever);
+    *stats = _stats;
+    stats->name = osMutexGetName(_id);
+    stats->contended_cnt = core_util_atomic_load_u32(&_stats.contended_cnt);
+    if (reset) {
+        memset(&_stats, 0, sizeof(_stats));
+        if (_count > 0) {
+            _lock_time = mutex_stats_now();
+        }
+    }
+    osMutexRelease(_id);
+}
+#endif
+
 Mutex::~Mutex()
 {
     osMutexDelete(_id);
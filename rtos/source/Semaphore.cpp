@@ -24,10 +24,13 @@
 #include "rtos/Kernel.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
 #include "platform/mbed_error.h"
+#include "platform/mbed_rtos_trace.h"
 #include "platform/source/mbed_os_timer.h"
 
 #include <string.h>
+#include "cmsis.h"
 
 using namespace std::chrono_literals;
 using std::chrono::duration;
@@ -59,6 +62,44 @@ void Semaphore::constructor(int32_t count, uint16_t max_count)
 #endif
 }
 
+#if MBED_CONF_RTOS_PRESENT && MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+// Tokens are taken with the same exclusive access the kernel uses, so a
+// free token never needs an SVC call. Waiting threads only exist while
+// there are no tokens, so taking one this way can't jump the queue.
+static bool semaphore_fast_acquire(mbed_rtos_storage_semaphore_t *semaphore)
+{
+    volatile uint16_t *tokens = &semaphore->tokens;
+    uint16_t old_tokens = core_util_atomic_load_u16(tokens);
+    while (old_tokens != 0) {
+        if (core_util_atomic_cas_u16(tokens, &old_tokens, old_tokens - 1)) {
+            MBED_RTOS_TRACE(MBED_RTOS_TRACE_SEMAPHORE_ACQUIRED, semaphore);
+            return true;
+        }
+    }
+    return false;
+}
+
+// A token can only be handed back directly while nobody is waiting for it,
+// which has to be checked with interrupts masked so no thread starts waiting
+static bool semaphore_fast_release(mbed_rtos_storage_semaphore_t *semaphore)
+{
+    bool released = false;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (!semaphore->thread_list && semaphore->tokens < semaphore->max_tokens) {
+        semaphore->tokens++;
+        released = true;
+    }
+
+    __set_PRIMASK(primask);
+    if (released) {
+        MBED_RTOS_TRACE(MBED_RTOS_TRACE_SEMAPHORE_RELEASED, semaphore);
+    }
+    return released;
+}
+#endif
+
 #if !MBED_CONF_RTOS_PRESENT
 struct sem_wait_capture {
     Semaphore *sem;
@@ -75,6 +116,11 @@ bool Semaphore::semaphore_available(void *handle)
 bool Semaphore::try_acquire()
 {
 #if MBED_CONF_RTOS_PRESENT
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    if (semaphore_fast_acquire(&_obj_mem)) {
+        return true;
+    }
+#endif
     osStatus_t status = osSemaphoreAcquire(_id, 0);
     if (status != osOK && status != osErrorResource) {
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_SEMAPHORE_LOCK_FAILED), "Semaphore acquire failed", status);
@@ -94,6 +140,11 @@ bool Semaphore::try_acquire()
 void Semaphore::acquire()
 {
 #if MBED_CONF_RTOS_PRESENT
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    if (semaphore_fast_acquire(&_obj_mem)) {
+        return;
+    }
+#endif
     osStatus_t status = osSemaphoreAcquire(_id, osWaitForever);
     if (status != osOK) {
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_SEMAPHORE_LOCK_FAILED), "Semaphore acquire failed", status);
@@ -115,6 +166,11 @@ bool Semaphore::try_acquire_for(uint32_t millisec)
 bool Semaphore::try_acquire_for(Kernel::Clock::duration_u32 rel_time)
 {
 #if MBED_CONF_RTOS_PRESENT
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    if (semaphore_fast_acquire(&_obj_mem)) {
+        return true;
+    }
+#endif
     osStatus_t status = osSemaphoreAcquire(_id, rel_time.count());
     if (status == osOK) {
         return true;
@@ -162,7 +218,15 @@ bool Semaphore::try_acquire_until(Kernel::Clock::time_point abs_time)
 osStatus Semaphore::release(void)
 {
 #if MBED_CONF_RTOS_PRESENT
-    return osSemaphoreRelease(_id);
+#if MBED_CONF_RTOS_API_FAST_PATH_ENABLED
+    osStatus status = semaphore_fast_release(&_obj_mem) ? osOK : osSemaphoreRelease(_id);
+#else
+    osStatus status = osSemaphoreRelease(_id);
+#endif
+    if (status == osOK) {
+        _wait_set_link.notify();
+    }
+    return status;
 #else
     int32_t old_count = core_util_atomic_load_s32(&_count);
     do {
@@ -63,6 +63,7 @@
 #include "mbed_boot.h"
 #include "mbed_error.h"
 #include "mbed_mpu_mgmt.h"
+#include "mbed_boot_profile.h"
 
 int main(void);
 static void mbed_cpy_nvic(void);
@@ -73,6 +74,7 @@ uint32_t mbed_stack_isr_size = 0;
 
 void mbed_init(void)
 {
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_INIT);
 #ifdef MBED_DEBUG
     // Configs to make debugging easier
 #ifdef SCnSCB_ACTLR_DISDEFWBUF_Msk
@@ -84,8 +86,10 @@ void mbed_init(void)
 #endif
 #endif
     mbed_mpu_manager_init();
+    mbed_fast_code_init();
     mbed_cpy_nvic();
     mbed_sdk_init();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_SDK_INIT);
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
@@ -94,10 +98,13 @@ void mbed_init(void)
 
 void mbed_start(void)
 {
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_RTOS_START);
     mbed_toolchain_init();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_CONSTRUCTORS);
     mbed_tfm_init();
     mbed_main();
     mbed_error_initialize();
+    mbed_boot_profile_mark(MBED_BOOT_PHASE_MAIN);
     main();
 }
 
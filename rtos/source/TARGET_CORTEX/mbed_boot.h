@@ -85,6 +85,16 @@ extern uint32_t mbed_stack_isr_size;
  */
 void mbed_init(void);
 
+/**
+ * Copy the functions and data placed with MBED_FAST_CODE and MBED_FAST_DATA
+ * to fast memory, if the toolchain runtime does not
+ *
+ * Preconditions:
+ * - Ram is initialized
+ * - The MPU has been initialized by mbed_mpu_manager_init
+ */
+void mbed_fast_code_init(void);
+
 /**
  * Start the main mbed application
  *
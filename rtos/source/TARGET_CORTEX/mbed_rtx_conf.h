@@ -209,7 +209,10 @@
 #define EVR_RTX_THREAD_BLOCKED_DISABLE
 #define EVR_RTX_THREAD_UNBLOCKED_DISABLE
 #define EVR_RTX_THREAD_PREEMPTED_DISABLE
+#if !defined(MBED_THREAD_STATS_ENABLED) && !defined(MBED_ALL_STATS_ENABLED) && !defined(MBED_RTOS_TRACING_ENABLED)
+// Used for per-thread CPU time when thread stats are enabled, and by the RTOS tracer
 #define EVR_RTX_THREAD_SWITCHED_DISABLE
+#endif
 #define EVR_RTX_THREAD_DESTROYED_DISABLE
 #define EVR_RTX_THREAD_GET_COUNT_DISABLE
 #define EVR_RTX_THREAD_ENUMERATE_DISABLE
@@ -254,16 +257,26 @@
 #define EVR_RTX_EVENT_FLAGS_WAIT_NOT_COMPLETED_DISABLE
 #define EVR_RTX_EVENT_FLAGS_DELETE_DISABLE
 #define EVR_RTX_EVENT_FLAGS_DESTROYED_DISABLE
+#if !defined(MBED_RTOS_TRACING_ENABLED)
+// Used by the RTOS tracer
+#define EVR_RTX_MUTEX_ACQUIRE_PENDING_DISABLE
+#define EVR_RTX_MUTEX_ACQUIRED_DISABLE
+#define EVR_RTX_MUTEX_RELEASED_DISABLE
+#define EVR_RTX_SEMAPHORE_ACQUIRE_PENDING_DISABLE
+#define EVR_RTX_SEMAPHORE_ACQUIRED_DISABLE
+#define EVR_RTX_SEMAPHORE_RELEASED_DISABLE
+#define EVR_RTX_MESSAGE_QUEUE_PUT_PENDING_DISABLE
+#define EVR_RTX_MESSAGE_QUEUE_INSERTED_DISABLE
+#define EVR_RTX_MESSAGE_QUEUE_GET_PENDING_DISABLE
+#define EVR_RTX_MESSAGE_QUEUE_RETRIEVED_DISABLE
+#endif
 #define EVR_RTX_MUTEX_NEW_DISABLE
 #define EVR_RTX_MUTEX_CREATED_DISABLE
 #define EVR_RTX_MUTEX_GET_NAME_DISABLE
 #define EVR_RTX_MUTEX_ACQUIRE_DISABLE
-#define EVR_RTX_MUTEX_ACQUIRE_PENDING_DISABLE
 #define EVR_RTX_MUTEX_ACQUIRE_TIMEOUT_DISABLE
-#define EVR_RTX_MUTEX_ACQUIRED_DISABLE
 #define EVR_RTX_MUTEX_NOT_ACQUIRED_DISABLE
 #define EVR_RTX_MUTEX_RELEASE_DISABLE
-#define EVR_RTX_MUTEX_RELEASED_DISABLE
 #define EVR_RTX_MUTEX_GET_OWNER_DISABLE
 #define EVR_RTX_MUTEX_DELETE_DISABLE
 #define EVR_RTX_MUTEX_DESTROYED_DISABLE
@@ -271,12 +284,9 @@
 #define EVR_RTX_SEMAPHORE_CREATED_DISABLE
 #define EVR_RTX_SEMAPHORE_GET_NAME_DISABLE
 #define EVR_RTX_SEMAPHORE_ACQUIRE_DISABLE
-#define EVR_RTX_SEMAPHORE_ACQUIRE_PENDING_DISABLE
 #define EVR_RTX_SEMAPHORE_ACQUIRE_TIMEOUT_DISABLE
-#define EVR_RTX_SEMAPHORE_ACQUIRED_DISABLE
 #define EVR_RTX_SEMAPHORE_NOT_ACQUIRED_DISABLE
 #define EVR_RTX_SEMAPHORE_RELEASE_DISABLE
-#define EVR_RTX_SEMAPHORE_RELEASED_DISABLE
 #define EVR_RTX_SEMAPHORE_GET_COUNT_DISABLE
 #define EVR_RTX_SEMAPHORE_DELETE_DISABLE
 #define EVR_RTX_SEMAPHORE_DESTROYED_DISABLE
@@ -301,15 +311,11 @@
 #define EVR_RTX_MESSAGE_QUEUE_CREATED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_NAME_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_PUT_DISABLE
-#define EVR_RTX_MESSAGE_QUEUE_PUT_PENDING_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_PUT_TIMEOUT_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_INSERT_PENDING_DISABLE
-#define EVR_RTX_MESSAGE_QUEUE_INSERTED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_NOT_INSERTED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_DISABLE
-#define EVR_RTX_MESSAGE_QUEUE_GET_PENDING_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_TIMEOUT_DISABLE
-#define EVR_RTX_MESSAGE_QUEUE_RETRIEVED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_NOT_RETRIEVED_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_CAPACITY_DISABLE
 #define EVR_RTX_MESSAGE_QUEUE_GET_MSG_SIZE_DISABLE
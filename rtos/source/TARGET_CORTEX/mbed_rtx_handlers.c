@@ -24,12 +24,22 @@
 #include "RTX_Config.h"
 #include "rtos/source/rtos_handlers.h"
 #include "rtos/source/rtos_idle.h"
+#include "platform/mbed_stats.h"
+#include "platform/mbed_rtos_trace.h"
+#include "hal/us_ticker_api.h"
+
+#if defined(MBED_THREAD_STATS_ENABLED) && DEVICE_USTICKER
+#define THREAD_CPU_STATS 1
+#else
+#define THREAD_CPU_STATS 0
+#endif
 
 #ifdef RTE_Compiler_EventRecorder
 #include "EventRecorder.h"              // Keil::Compiler:Event Recorder
 // Used from rtx_evr.c
 #define EvtRtxThreadExit               EventID(EventLevelAPI, 0xF2U, 0x19U)
 #define EvtRtxThreadTerminate          EventID(EventLevelAPI, 0xF2U, 0x1AU)
+#define EvtRtxThreadSwitched           EventID(EventLevelOp, 0xF2U, 0x19U)
 #endif
 
 static void (*terminate_hook)(osThreadId_t id);
@@ -46,6 +56,147 @@ void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id))
     terminate_hook = fptr;
 }
 
+#if THREAD_CPU_STATS
+typedef struct {
+    osThreadId_t id;
+    us_timestamp_t run_time;
+} thread_cpu_t;
+
+// Accessed from the thread switch and thread exit hooks, which the kernel
+// serializes, and from rtos_thread_cpu_time with the kernel locked
+static thread_cpu_t thread_cpu[MBED_CONF_RTOS_THREAD_STATS_CPU_SLOTS];
+static thread_cpu_t *thread_cpu_running;
+static us_timestamp_t thread_cpu_switched;
+
+static thread_cpu_t *thread_cpu_find(osThreadId_t id)
+{
+    for (int i = 0; i < MBED_CONF_RTOS_THREAD_STATS_CPU_SLOTS; i++) {
+        if (thread_cpu[i].id == id) {
+            return &thread_cpu[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void thread_cpu_release(osThreadId_t id)
+{
+    thread_cpu_t *slot = thread_cpu_find(id);
+    if (slot) {
+        slot->id = NULL;
+        if (slot == thread_cpu_running) {
+            thread_cpu_running = NULL;
+        }
+    }
+}
+#endif
+
+#if THREAD_CPU_STATS || defined(MBED_RTOS_TRACING_ENABLED)
+// RTX hook which gets called on every thread switch, from the kernel
+void EvrRtxThreadSwitched(osThreadId_t thread_id)
+{
+#if THREAD_CPU_STATS
+    us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+    if (thread_cpu_running) {
+        thread_cpu_running->run_time += now - thread_cpu_switched;
+    }
+    thread_cpu_switched = now;
+
+    // Threads beyond the number of slots are not tracked
+    thread_cpu_running = thread_cpu_find(thread_id);
+    if (!thread_cpu_running) {
+        thread_cpu_running = thread_cpu_find(NULL);
+        if (thread_cpu_running) {
+            thread_cpu_running->id = thread_id;
+            thread_cpu_running->run_time = 0;
+        }
+    }
+#endif
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_THREAD_SWITCH, thread_id);
+#if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && defined(RTE_Compiler_EventRecorder))
+    EventRecord2(EvtRtxThreadSwitched, (uint32_t)thread_id, 0U);
+#endif
+}
+#endif
+
+#if defined(MBED_RTOS_TRACING_ENABLED)
+#ifdef RTE_Compiler_EventRecorder
+#error "The RTOS tracer and the Keil Event Recorder both implement the RTX event hooks"
+#endif
+
+// RTX hooks for the RTOS object operations followed by the RTOS tracer
+void EvrRtxMutexAcquirePending(osMutexId_t mutex_id, uint32_t timeout)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_MUTEX_BLOCKED, mutex_id);
+}
+
+void EvrRtxMutexAcquired(osMutexId_t mutex_id, uint32_t lock)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_MUTEX_ACQUIRED, mutex_id);
+}
+
+void EvrRtxMutexReleased(osMutexId_t mutex_id, uint32_t lock)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_MUTEX_RELEASED, mutex_id);
+}
+
+void EvrRtxSemaphoreAcquirePending(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_SEMAPHORE_BLOCKED, semaphore_id);
+}
+
+void EvrRtxSemaphoreAcquired(osSemaphoreId_t semaphore_id, uint32_t tokens)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_SEMAPHORE_ACQUIRED, semaphore_id);
+}
+
+void EvrRtxSemaphoreReleased(osSemaphoreId_t semaphore_id, uint32_t tokens)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_SEMAPHORE_RELEASED, semaphore_id);
+}
+
+void EvrRtxMessageQueuePutPending(osMessageQueueId_t mq_id, const void *msg_ptr, uint32_t timeout)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_QUEUE_BLOCKED, mq_id);
+}
+
+void EvrRtxMessageQueueInserted(osMessageQueueId_t mq_id, const void *msg_ptr)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_QUEUE_PUT, mq_id);
+}
+
+void EvrRtxMessageQueueGetPending(osMessageQueueId_t mq_id, void *msg_ptr, uint32_t timeout)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_QUEUE_BLOCKED, mq_id);
+}
+
+void EvrRtxMessageQueueRetrieved(osMessageQueueId_t mq_id, void *msg_ptr)
+{
+    MBED_RTOS_TRACE(MBED_RTOS_TRACE_QUEUE_GET, mq_id);
+}
+#endif
+
+uint64_t rtos_thread_cpu_time(osThreadId_t id)
+{
+#if THREAD_CPU_STATS
+    uint64_t run_time = 0;
+    int32_t lock = osKernelLock();
+    thread_cpu_t *slot = thread_cpu_find(id);
+    if (slot) {
+        run_time = slot->run_time;
+        // Include the time slice the thread is currently running
+        if (slot == thread_cpu_running) {
+            run_time += ticker_read_us(get_us_ticker_data()) - thread_cpu_switched;
+        }
+    }
+    osKernelRestoreLock(lock);
+    return run_time;
+#else
+    (void)id;
+    return 0;
+#endif
+}
+
 __NO_RETURN void osRtxIdleThread(void *argument)
 {
     rtos_idle_loop();
@@ -167,6 +318,9 @@ void EvrRtxThreadExit(void)
 {
     osThreadId_t thread_id = osThreadGetId();
     thread_terminate_hook(thread_id);
+#if THREAD_CPU_STATS
+    thread_cpu_release(thread_id);
+#endif
 #if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_EXIT_DISABLE) && defined(RTE_Compiler_EventRecorder))
     EventRecord2(EvtRtxThreadExit, 0U, 0U);
 #endif
@@ -175,6 +329,9 @@ void EvrRtxThreadExit(void)
 void EvrRtxThreadTerminate(osThreadId_t thread_id)
 {
     thread_terminate_hook(thread_id);
+#if THREAD_CPU_STATS
+    thread_cpu_release(thread_id);
+#endif
 #if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_TERMINATE_DISABLE) && defined(RTE_Compiler_EventRecorder))
     EventRecord2(EvtRtxThreadTerminate, (uint32_t)thread_id, 0U);
 #endif
@@ -88,13 +88,13 @@ extern "C" {
     }
 
     // Acknowledge System Timer IRQ.
-    void OS_Tick_AcknowledgeIRQ(void)
+    MBED_FAST_CODE void OS_Tick_AcknowledgeIRQ(void)
     {
         os_timer->acknowledge_tick();
     }
 
     // Get System Timer count.
-    uint32_t OS_Tick_GetCount(void)
+    MBED_FAST_CODE uint32_t OS_Tick_GetCount(void)
     {
         return (uint32_t) os_timer->get_time_since_tick().count();
     }
@@ -134,16 +134,81 @@ extern "C" {
         return core_util_atomic_load_u8(&osRtxInfo.kernel.pendSV);
     }
 
+    /* Sleeps of the idle thread, to predict how long the next one will really last */
+    static struct {
+        // One bit per recent sleep, set if an interrupt other than the OS timer ended it
+        uint8_t early_wake_history;
+        // Running average of the length of the sleeps ended early
+        rtos::Kernel::Clock::duration_u32 early_wake_ticks;
+        uint32_t timer_wakeups;
+        uint32_t early_wakeups;
+        uint32_t deep_sleep_vetoes;
+    } idle_sleeps;
+
+    static rtos::Kernel::Clock::duration_u32 predict_sleep(rtos::Kernel::Clock::duration_u32 ticks_to_sleep)
+    {
+        // Trust the recent early wake-ups only if they ended most of the recent sleeps
+        int early_wakes = 0;
+        for (uint8_t history = idle_sleeps.early_wake_history; history; history &= history - 1) {
+            early_wakes++;
+        }
+        if (early_wakes >= 4 && idle_sleeps.early_wake_ticks < ticks_to_sleep) {
+            return idle_sleeps.early_wake_ticks;
+        }
+        return ticks_to_sleep;
+    }
+
+    static void record_sleep(rtos::Kernel::Clock::duration_u32 ticks_to_sleep, rtos::Kernel::Clock::duration_u32 ticks_slept)
+    {
+        bool early = ticks_slept < ticks_to_sleep;
+        idle_sleeps.early_wake_history = (uint8_t)((idle_sleeps.early_wake_history << 1) | early);
+        if (early) {
+            idle_sleeps.early_wakeups++;
+            if (ticks_slept > idle_sleeps.early_wake_ticks) {
+                idle_sleeps.early_wake_ticks += (ticks_slept - idle_sleeps.early_wake_ticks) / 4;
+            } else {
+                idle_sleeps.early_wake_ticks -= (idle_sleeps.early_wake_ticks - ticks_slept) / 4;
+            }
+        } else {
+            idle_sleeps.timer_wakeups++;
+        }
+    }
+
     static void default_idle_hook(void)
     {
         rtos::Kernel::Clock::duration_u32 ticks_to_sleep{osKernelSuspend()};
+        // Deep sleep only pays for its wake-up latency if the sleep is long enough
+        bool shallow = false;
+#if MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN > 0
+        if (predict_sleep(ticks_to_sleep) < MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN * os_timer->deep_sleep_latency()) {
+            shallow = true;
+            if (sleep_manager_can_deep_sleep()) {
+                idle_sleeps.deep_sleep_vetoes++;
+            }
+            sleep_manager_lock_deep_sleep();
+        }
+#endif
         // osKernelSuspend will call OS_Tick_Disable, cancelling the tick, which frees
         // up the os timer for the timed sleep
         rtos::Kernel::Clock::duration_u32 ticks_slept = mbed::internal::do_timed_sleep_relative(ticks_to_sleep, rtos_event_pending);
         MBED_ASSERT(ticks_slept < rtos::Kernel::wait_for_u32_max);
+        if (shallow) {
+            sleep_manager_unlock_deep_sleep();
+        }
+        record_sleep(ticks_to_sleep, ticks_slept);
         osKernelResume(ticks_slept.count());
     }
 
+    void rtos_idle_stats_get(mbed_stats_cpu_t *stats)
+    {
+        core_util_critical_section_enter();
+        stats->deep_sleep_latency = os_timer ? std::chrono::duration_cast<std::chrono::microseconds>(os_timer->deep_sleep_latency()).count() : 0;
+        stats->timer_wakeups = idle_sleeps.timer_wakeups;
+        stats->early_wakeups = idle_sleeps.early_wakeups;
+        stats->deep_sleep_vetoes = idle_sleeps.deep_sleep_vetoes;
+        core_util_critical_section_exit();
+    }
+
 
 #else // MBED_TICKLESS
 
@@ -157,6 +222,11 @@ extern "C" {
         core_util_critical_section_exit();
     }
 
+    void rtos_idle_stats_get(mbed_stats_cpu_t *stats)
+    {
+        (void)stats;
+    }
+
 #endif // MBED_TICKLESS
 
     static void (*idle_hook_fptr)(void) = &default_idle_hook;
@@ -30,6 +30,12 @@
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
 #include "platform/source/mbed_os_timer.h"
+#include "platform/mbed_power_mgmt.h"
+#include "drivers/TimerEvent.h"
+#include "hal/us_ticker_api.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#endif
 
 using std::milli;
 using std::chrono::duration;
@@ -254,6 +260,81 @@ void ThisThread::sleep_until(Clock::time_point abs_time)
 #endif
 }
 
+namespace {
+/* One-shot deadline on the microsecond ticker that wakes the thread waiting for it */
+class HighResWake : private mbed::TimerEvent {
+public:
+    HighResWake() : TimerEvent(get_us_ticker_data())
+#if MBED_CONF_RTOS_PRESENT
+        , _wake(0, 1)
+#else
+        , _fired(false)
+#endif
+    {
+    }
+
+    void sleep_until(mbed::TickerDataClock::time_point abs_time)
+    {
+        // The microsecond ticker may stop in deep sleep
+        sleep_manager_lock_deep_sleep();
+        insert_absolute(abs_time);
+#if MBED_CONF_RTOS_PRESENT
+        _wake.acquire();
+#else
+        mbed::internal::do_untimed_sleep(fired, this);
+#endif
+        sleep_manager_unlock_deep_sleep();
+    }
+
+    mbed::TickerDataClock::time_point now() const
+    {
+        return _ticker_data.now();
+    }
+
+private:
+    void handler() override
+    {
+#if MBED_CONF_RTOS_PRESENT
+        _wake.release();
+#else
+        core_util_atomic_store_bool(&_fired, true);
+#endif
+    }
+
+#if MBED_CONF_RTOS_PRESENT
+    rtos::Semaphore _wake;
+#else
+    static bool fired(void *handle)
+    {
+        return core_util_atomic_load_bool(&static_cast<HighResWake *>(handle)->_fired);
+    }
+
+    bool _fired;
+#endif
+};
+}
+
+void ThisThread::sleep_for_us(std::chrono::microseconds rel_time)
+{
+    using namespace std::chrono;
+
+    if (rel_time <= rel_time.zero()) {
+        return;
+    }
+
+    HighResWake wake;
+    mbed::TickerDataClock::time_point deadline = wake.now() + rel_time;
+
+    // A kernel sleep of n ticks can end up to a tick early, so it can cover
+    // all but the last tick of the sleep without overshooting the deadline
+    milliseconds coarse = duration_cast<milliseconds>(rel_time) - 1ms;
+    if (coarse > coarse.zero()) {
+        ThisThread::sleep_for(coarse);
+    }
+
+    wake.sleep_until(deadline);
+}
+
 void ThisThread::yield()
 {
 #if MBED_CONF_RTOS_PRESENT
@@ -56,6 +56,7 @@ void Thread::constructor(uint32_t tz_module, osPriority priority,
     memset(&_obj_mem, 0, sizeof(_obj_mem));
     _tid = nullptr;
     _dynamic_stack = (stack_mem == nullptr);
+    _allocator = nullptr;
     _finished = false;
     memset(&_attr, 0, sizeof(_attr));
     _attr.priority = priority;
@@ -81,8 +82,17 @@ osStatus Thread::start(mbed::Callback<void()> task)
     }
 
     if (_attr.stack_mem == nullptr) {
-        _attr.stack_mem = new uint32_t[_attr.stack_size / sizeof(uint32_t)];
-        MBED_ASSERT(_attr.stack_mem != nullptr);
+        if (_allocator) {
+            _attr.stack_mem = _allocator->allocate(_attr.stack_size);
+            if (_attr.stack_mem == nullptr) {
+                _mutex.unlock();
+                _join_sem.release();
+                return osErrorNoMemory;
+            }
+        } else {
+            _attr.stack_mem = new uint32_t[_attr.stack_size / sizeof(uint32_t)];
+            MBED_ASSERT(_attr.stack_mem != nullptr);
+        }
     }
 
     //Fill the stack with a magic word for maximum usage checking
@@ -96,9 +106,7 @@ osStatus Thread::start(mbed::Callback<void()> task)
     _tid = osThreadNew(Thread::_thunk, this, &_attr);
     if (_tid == nullptr) {
         if (_dynamic_stack) {
-            // Cast before deallocation as delete[] does not accept void*
-            delete[] static_cast<uint32_t *>(_attr.stack_mem);
-            _attr.stack_mem = nullptr;
+            free_stack_mem();
         }
         _mutex.unlock();
         _join_sem.release();
@@ -325,10 +333,22 @@ Thread::~Thread()
     // terminate is thread safe
     terminate();
     if (_dynamic_stack) {
+        free_stack_mem();
+    }
+}
+
+void Thread::free_stack_mem()
+{
+    if (_attr.stack_mem == nullptr) {
+        return;
+    }
+    if (_allocator) {
+        _allocator->deallocate(_attr.stack_mem, _attr.stack_size);
+    } else {
         // Cast before deallocation as delete[] does not accept void*
         delete[] static_cast<uint32_t *>(_attr.stack_mem);
-        _attr.stack_mem = nullptr;
     }
+    _attr.stack_mem = nullptr;
 }
 
 void Thread::_thunk(void *thread_ptr)
@@ -0,0 +1,182 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/ThreadStackPool.h"
+#include "rtos/mbed_rtos_storage.h"
+#include "rtos_handlers.h"
+#include "platform/CriticalSectionLock.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_toolchain.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+MBED_STATIC_ASSERT(MBED_CONF_RTOS_THREAD_STACK_POOL_SMALL_SIZE % 8 == 0 &&
+                   MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_SIZE % 8 == 0 &&
+                   MBED_CONF_RTOS_THREAD_STACK_POOL_LARGE_SIZE % 8 == 0,
+                   "Thread stack pool sizes must be multiples of 8 bytes");
+MBED_STATIC_ASSERT(MBED_CONF_RTOS_THREAD_STACK_POOL_SMALL_SIZE <= MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_SIZE &&
+                   MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_SIZE <= MBED_CONF_RTOS_THREAD_STACK_POOL_LARGE_SIZE,
+                   "Thread stack pool classes must be in increasing size");
+
+namespace rtos {
+
+namespace {
+
+/** Stacks of one size class, with their state */
+template <uint32_t Size, uint32_t Count>
+struct StackClass {
+    // Arrays cannot be empty, an unused class keeps a single word
+    static constexpr uint32_t words = Count ? Size / sizeof(uint32_t) : 1;
+    static constexpr uint32_t slots = Count ? Count : 1;
+
+    MBED_ALIGN(8) uint32_t stacks[slots][words];
+    uint32_t max_usage[slots];
+    bool in_use[slots];
+};
+
+StackClass<MBED_CONF_RTOS_THREAD_STACK_POOL_SMALL_SIZE, MBED_CONF_RTOS_THREAD_STACK_POOL_SMALL_COUNT> small_stacks;
+StackClass<MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_SIZE, MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_COUNT> medium_stacks;
+StackClass<MBED_CONF_RTOS_THREAD_STACK_POOL_LARGE_SIZE, MBED_CONF_RTOS_THREAD_STACK_POOL_LARGE_COUNT> large_stacks;
+
+/** View of a size class independent of its template parameters */
+struct class_t {
+    uint32_t *stacks;
+    uint32_t *max_usage;
+    bool *in_use;
+    uint32_t size;
+    uint32_t count;
+};
+
+const class_t classes[] = {
+    {
+        &small_stacks.stacks[0][0], small_stacks.max_usage, small_stacks.in_use,
+        MBED_CONF_RTOS_THREAD_STACK_POOL_SMALL_SIZE, MBED_CONF_RTOS_THREAD_STACK_POOL_SMALL_COUNT
+    },
+    {
+        &medium_stacks.stacks[0][0], medium_stacks.max_usage, medium_stacks.in_use,
+        MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_SIZE, MBED_CONF_RTOS_THREAD_STACK_POOL_MEDIUM_COUNT
+    },
+    {
+        &large_stacks.stacks[0][0], large_stacks.max_usage, large_stacks.in_use,
+        MBED_CONF_RTOS_THREAD_STACK_POOL_LARGE_SIZE, MBED_CONF_RTOS_THREAD_STACK_POOL_LARGE_COUNT
+    },
+};
+
+/** Find the class and slot of an address in the pool, false if it is not in the pool */
+bool find_slot(const void *stack, const class_t *&cls, uint32_t &slot)
+{
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(stack);
+
+    for (const class_t &c : classes) {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(c.stacks);
+        if (addr >= start && addr < start + c.size * c.count) {
+            cls = &c;
+            slot = (addr - start) / c.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+ThreadStackPool &ThreadStackPool::get_default_instance()
+{
+    // Constant initialized, so safe to use from any constructor
+    static ThreadStackPool pool;
+    return pool;
+}
+
+void *ThreadStackPool::allocate(uint32_t size)
+{
+    mbed::CriticalSectionLock lock;
+
+    for (const class_t &c : classes) {
+        if (size > c.size) {
+            continue;
+        }
+        for (uint32_t i = 0; i < c.count; i++) {
+            if (!c.in_use[i]) {
+                c.in_use[i] = true;
+                return c.stacks + i * (c.size / sizeof(uint32_t));
+            }
+        }
+    }
+    return nullptr;
+}
+
+void ThreadStackPool::deallocate(void *stack, uint32_t size)
+{
+    (void)size;
+    const class_t *cls;
+    uint32_t slot;
+
+    if (!find_slot(stack, cls, slot)) {
+        MBED_ASSERT(false);
+        return;
+    }
+    MBED_ASSERT(cls->in_use[slot]);
+
+#if defined(MBED_STACK_STATS_ENABLED)
+    // The stack is filled again when it is next used, record the peak of this thread first.
+    // Word 0 is the overflow guard, the stack grows down towards it.
+    const uint32_t *words = static_cast<const uint32_t *>(stack);
+    const uint32_t count = cls->size / sizeof(uint32_t);
+    uint32_t unused = 1;
+    while (unused < count && (words[unused] == osRtxStackMagicWord || words[unused] == osRtxStackFillPattern)) {
+        unused++;
+    }
+    const uint32_t usage = (count - unused) * sizeof(uint32_t);
+    if (usage > cls->max_usage[slot]) {
+        cls->max_usage[slot] = usage;
+    }
+#endif
+
+    mbed::CriticalSectionLock lock;
+    cls->in_use[slot] = false;
+}
+
+uint32_t ThreadStackPool::max_usage(const void *stack) const
+{
+    const class_t *cls;
+    uint32_t slot;
+
+    if (!find_slot(stack, cls, slot)) {
+        return 0;
+    }
+    return cls->max_usage[slot];
+}
+
+}
+
+extern "C" uint32_t rtos_stack_pool_max_usage(osThreadId_t id)
+{
+#if defined(MBED_OS_BACKEND_RTX5)
+    const mbed_rtos_storage_thread_t *thread = static_cast<const mbed_rtos_storage_thread_t *>(id);
+    return rtos::ThreadStackPool::get_default_instance().max_usage(thread->stack_mem);
+#else
+    (void)id;
+    return 0;
+#endif
+}
+
+#endif
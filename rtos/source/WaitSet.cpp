@@ -0,0 +1,144 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2020 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/WaitSet.h"
+#include "rtos/Semaphore.h"
+#include "rtos/EventFlags.h"
+#include "rtos/ThisThread.h"
+#include "platform/mbed_assert.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace rtos {
+
+WaitSet::WaitSet() : _entries(), _next(0)
+{
+}
+
+WaitSet::~WaitSet()
+{
+    for (int i = 0; i < MBED_CONF_RTOS_WAIT_SET_CAPACITY; i++) {
+        remove(i);
+    }
+}
+
+int WaitSet::add(Semaphore &semaphore)
+{
+    return add(semaphore._wait_set_link, &semaphore, semaphore_ready, 0);
+}
+
+int WaitSet::add(EventFlags &event_flags, uint32_t flags)
+{
+    return add(event_flags._wait_set_link, &event_flags, event_flags_ready, flags);
+}
+
+int WaitSet::add(internal::WaitSetLink &link, const void *object, ready_t ready, uint32_t flags)
+{
+    MBED_ASSERT(link.thread == nullptr);
+
+    for (int i = 0; i < MBED_CONF_RTOS_WAIT_SET_CAPACITY; i++) {
+        entry_t &entry = _entries[i];
+        if (entry.link == nullptr) {
+            entry.link = &link;
+            entry.object = object;
+            entry.ready = ready;
+            entry.flags = flags;
+            core_util_atomic_store(&link.thread, ThisThread::get_id());
+            return i;
+        }
+    }
+    return -1;
+}
+
+void WaitSet::remove(int index)
+{
+    MBED_ASSERT(index >= 0 && index < MBED_CONF_RTOS_WAIT_SET_CAPACITY);
+    entry_t &entry = _entries[index];
+    if (entry.link) {
+        core_util_atomic_store(&entry.link->thread, static_cast<osThreadId_t>(nullptr));
+        entry.link = nullptr;
+    }
+}
+
+int WaitSet::poll()
+{
+    for (int i = 0; i < MBED_CONF_RTOS_WAIT_SET_CAPACITY; i++) {
+        int index = (_next + i) % MBED_CONF_RTOS_WAIT_SET_CAPACITY;
+        const entry_t &entry = _entries[index];
+        if (entry.link && entry.ready(entry.object, entry.flags)) {
+            _next = index + 1;
+            return index;
+        }
+    }
+    return -1;
+}
+
+int WaitSet::wait()
+{
+    return wait_for(Kernel::wait_for_u32_forever);
+}
+
+int WaitSet::wait_for(Kernel::Clock::duration_u32 rel_time)
+{
+    // The set may be waited on by another thread than the one that filled it
+    osThreadId_t self = ThisThread::get_id();
+    for (entry_t &entry : _entries) {
+        if (entry.link && entry.link->thread != self) {
+            core_util_atomic_store(&entry.link->thread, self);
+        }
+    }
+
+    const Kernel::Clock::time_point start = Kernel::Clock::now();
+    while (true) {
+        // Clearing the flag before polling means an object becoming ready
+        // after it was polled always wakes the wait below
+        ThisThread::flags_clear(MBED_CONF_RTOS_WAIT_SET_FLAG);
+        int index = poll();
+        if (index >= 0) {
+            return index;
+        }
+
+        if (rel_time == Kernel::wait_for_u32_forever) {
+            ThisThread::flags_wait_any(MBED_CONF_RTOS_WAIT_SET_FLAG);
+        } else {
+            Kernel::Clock::duration_u32 elapsed = Kernel::Clock::now() - start;
+            if (elapsed >= rel_time ||
+                    !ThisThread::flags_wait_any_for(MBED_CONF_RTOS_WAIT_SET_FLAG, rel_time - elapsed)) {
+                return poll();
+            }
+        }
+    }
+}
+
+bool WaitSet::semaphore_ready(const void *object, uint32_t)
+{
+    return osSemaphoreGetCount(static_cast<const Semaphore *>(object)->_id) > 0;
+}
+
+bool WaitSet::event_flags_ready(const void *object, uint32_t flags)
+{
+    return (static_cast<const EventFlags *>(object)->get() & flags) != 0;
+}
+
+}
+
+#endif
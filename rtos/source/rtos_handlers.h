@@ -23,6 +23,7 @@
 #ifndef RTOS_HANDLERS_H
 #define RTOS_HANDLERS_H
 
+#include <stdint.h>
 #include "rtos/mbed_rtos_types.h"
 
 #ifdef __cplusplus
@@ -44,6 +45,22 @@ extern "C" {
  @param fptr Hook function pointer.
  */
 void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id));
+
+/**
+ @note
+ Gets the time a thread has spent running, tracked when thread stats are enabled
+ @param id Thread ID.
+ @return Run time in microseconds, or 0 if the thread is not tracked.
+ */
+uint64_t rtos_thread_cpu_time(osThreadId_t id);
+
+/**
+ @note
+ Gets the peak stack usage recorded for the pooled stack of a thread, kept when stack stats are enabled
+ @param id Thread ID.
+ @return Peak usage in bytes of earlier threads on the same stack, or 0 if the stack is not from rtos::ThreadStackPool.
+ */
+uint32_t rtos_stack_pool_max_usage(osThreadId_t id);
 /** @}*/
 
 #ifdef __cplusplus
@@ -24,6 +24,7 @@
 #define RTOS_IDLE_H
 
 #include "mbed_toolchain.h"
+#include "platform/mbed_stats.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,6 +47,13 @@ void rtos_attach_idle_hook(void (*fptr)(void));
 /** @private */
 MBED_NORETURN void rtos_idle_loop(void);
 
+/**
+ @note
+ Fills the idle sleep fields of the CPU statistics, which are only kept in tickless mode
+ @param stats CPU statistics to fill.
+ */
+void rtos_idle_stats_get(mbed_stats_cpu_t *stats);
+
 /** @}*/
 /** @}*/
 
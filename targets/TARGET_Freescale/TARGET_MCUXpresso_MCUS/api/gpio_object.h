@@ -16,6 +16,8 @@
 #ifndef MBED_GPIO_OBJECT_H
 #define MBED_GPIO_OBJECT_H
 
+#include "mbed_assert.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,6 +31,53 @@ static inline int gpio_is_connected(const gpio_t *obj)
     return obj->pin != (PinName)NC;
 }
 
+/* Fast GPIO, see hal/gpio_fast_api.h */
+#define GPIO_FAST_API_PRESENT 1
+
+static inline GPIO_Type *gpio_fast_base(uint32_t port)
+{
+    static GPIO_Type *const gpio_fast_addrs[] = GPIO_BASE_PTRS;
+    return gpio_fast_addrs[port];
+}
+
+static inline void gpio_write_fast(gpio_t *obj, int value)
+{
+    MBED_ASSERT(obj->pin != (PinName)NC);
+    GPIO_Type *base = gpio_fast_base(obj->pin >> GPIO_PORT_SHIFT);
+    uint32_t mask = 1U << (obj->pin & 0xFF);
+
+    if (value) {
+        base->PSOR = mask;
+    } else {
+        base->PCOR = mask;
+    }
+}
+
+static inline int gpio_read_fast(gpio_t *obj)
+{
+    MBED_ASSERT(obj->pin != (PinName)NC);
+    GPIO_Type *base = gpio_fast_base(obj->pin >> GPIO_PORT_SHIFT);
+
+    return (base->PDIR >> (obj->pin & 0xFF)) & 1;
+}
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+static inline void port_write_fast(struct port_s *obj, int value)
+{
+    GPIO_Type *base = gpio_fast_base(obj->port);
+
+    base->PSOR = (uint32_t)value & obj->mask;
+    base->PCOR = ~(uint32_t)value & obj->mask;
+}
+
+static inline int port_read_fast(struct port_s *obj)
+{
+    return (int)(gpio_fast_base(obj->port)->PDIR & obj->mask);
+}
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
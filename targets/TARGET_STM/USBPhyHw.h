@@ -85,6 +85,7 @@ public:
     virtual void endpoint_stall(usb_ep_t endpoint);
     virtual void endpoint_unstall(usb_ep_t endpoint);
 
+    virtual uint32_t endpoint_max_transfer_size(usb_ep_t endpoint);
     virtual bool endpoint_read(usb_ep_t endpoint, uint8_t *data, uint32_t size);
     virtual uint32_t endpoint_read_result(usb_ep_t endpoint);
     virtual bool endpoint_write(usb_ep_t endpoint, uint8_t *data, uint32_t size);
@@ -31,6 +31,13 @@
 #define NUM_ENDPOINTS           4
 #define MAX_PACKET_SIZE_NON_ISO      64
 #define MAX_PACKET_SIZE_ISO          (256 + 128)     // Spec can go up to 1023, only ram for this though
+// The OTG core splits larger transfers into packets itself, the PCD layer
+// of the USB_NO_OTG families restarts the count on every packet
+#if (MBED_CONF_TARGET_USB_SPEED == USE_USB_NO_OTG)
+#define MAX_TRANSFER_SIZE            0
+#else
+#define MAX_TRANSFER_SIZE            4096
+#endif
 
 static const uint32_t tx_ep_sizes[NUM_ENDPOINTS] = {
     MAX_PACKET_SIZE_NON_ISO,
@@ -440,6 +447,11 @@ void USBPhyHw::endpoint_unstall(usb_ep_t endpoint)
     MBED_ASSERT(ret != HAL_BUSY);
 }
 
+uint32_t USBPhyHw::endpoint_max_transfer_size(usb_ep_t endpoint)
+{
+    return EP_TO_LOG(endpoint) == 0 ? 0 : MAX_TRANSFER_SIZE;
+}
+
 bool USBPhyHw::endpoint_read(usb_ep_t endpoint, uint8_t *data, uint32_t size)
 {
     // clean reception end flag before requesting reception
@@ -1028,6 +1028,55 @@ int can_filter(can_t *obj, uint32_t id, uint32_t mask, CANFormat format, int32_t
     return 1;
 }
 
+/* Each CAN instance owns 14 filter banks. On parts with two CAN instances,
+   CAN1 uses banks 0 to 13 and CAN2 banks 14 to 27 of the shared filters. */
+#define CAN_FILTER_BANKS_PER_INSTANCE 14
+
+int can_filter_bank_count(can_t *obj)
+{
+    return CAN_FILTER_BANKS_PER_INSTANCE;
+}
+
+int can_filter_bank(can_t *obj, int bank, uint32_t id, uint32_t mask, CANFormat format, int enable)
+{
+    CAN_FilterConfTypeDef sFilterConfig = {0};
+
+    if (bank < 0 || bank >= CAN_FILTER_BANKS_PER_INSTANCE) {
+        return 0;
+    }
+
+    // filter for CANAny format cannot be configured for STM32
+    if (enable && (format != CANStandard) && (format != CANExtended)) {
+        return 0;
+    }
+
+    sFilterConfig.FilterNumber = (obj->index == 1) ? CAN_FILTER_BANKS_PER_INSTANCE + bank : bank;
+    sFilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
+    sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+
+    if (format == CANStandard) {
+        sFilterConfig.FilterIdHigh = id << 5;
+        sFilterConfig.FilterIdLow = 0x0;
+        sFilterConfig.FilterMaskIdHigh = mask << 5;
+        sFilterConfig.FilterMaskIdLow = (1 << 2); // IDE, only standard frames
+    } else if (format == CANExtended) {
+        sFilterConfig.FilterIdHigh = id >> 13; // EXTID[28:13]
+        sFilterConfig.FilterIdLow = (0xFFFF & (id << 3)) | (1 << 2); // EXTID[12:0] + IDE
+        sFilterConfig.FilterMaskIdHigh = mask >> 13;
+        sFilterConfig.FilterMaskIdLow = (0xFFFF & (mask << 3)) | (1 << 2);
+    }
+
+    sFilterConfig.FilterFIFOAssignment = 0;
+    sFilterConfig.FilterActivation = enable ? ENABLE : DISABLE;
+    sFilterConfig.BankNumber = CAN_FILTER_BANKS_PER_INSTANCE;
+
+    if (HAL_CAN_ConfigFilter(&obj->CanHandle, &sFilterConfig) != HAL_OK) {
+        return 0;
+    }
+
+    return 1;
+}
+
 static void can_irq(CANName name, int id)
 {
     uint32_t tmp1 = 0, tmp2 = 0, tmp3 = 0;
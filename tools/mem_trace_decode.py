@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2020 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decode the records written by mbed_mem_trace_binary_callback.
+
+The input is a raw capture of the records drained with
+mbed_mem_trace_binary_read, for example from a UART or SWO channel. Each
+record is printed in the text format of mbed_mem_trace_default_callback,
+prefixed with its timestamp, and missing sequence numbers are reported as
+dropped records. Bytes between records, such as other console output, are
+skipped.
+"""
+
+from __future__ import print_function
+
+import argparse
+import struct
+import sys
+
+RECORD = struct.Struct("<HBBIIIII")
+SYNC = 0x544D
+
+OPS = {0: "m", 1: "r", 2: "c", 3: "f"}
+
+
+def records(data):
+    """Yield (op, seq, timestamp, res, ptr, size, caller) from a capture"""
+    sync = struct.pack("<H", SYNC)
+    offset = 0
+    while True:
+        offset = data.find(sync, offset)
+        if offset < 0 or offset + RECORD.size > len(data):
+            return
+        fields = RECORD.unpack_from(data, offset)
+        if fields[1] not in OPS:
+            # Not a record, the sync bytes were part of something else
+            offset += 1
+            continue
+        offset += RECORD.size
+        yield fields[1:]
+
+
+def format_record(op, res, ptr, size, caller):
+    """Format a record in the text format of the default tracer"""
+    prefix = "#%s:0x%x;0x%x-" % (OPS[op], res, caller)
+    if op == 0 or op == 2:
+        return prefix + "%u" % size
+    elif op == 1:
+        return prefix + "0x%x;%u" % (ptr, size)
+    return prefix + "0x%x" % ptr
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[-2],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", nargs="?", default="-",
+                        help="binary capture file, '-' for stdin (default)")
+    args = parser.parse_args()
+
+    if args.capture == "-":
+        stream = getattr(sys.stdin, "buffer", sys.stdin)
+        data = stream.read()
+    else:
+        with open(args.capture, "rb") as capture:
+            data = capture.read()
+
+    expected = None
+    dropped = 0
+    for op, seq, timestamp, res, ptr, size, caller in records(data):
+        if expected is not None and seq != expected:
+            lost = (seq - expected) & 0xff
+            dropped += lost
+            print("# %u records dropped" % lost)
+        expected = (seq + 1) & 0xff
+        print("%10u %s" % (timestamp, format_record(op, res, ptr, size, caller)))
+
+    if dropped:
+        print("# %u records dropped in total" % dropped, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2020 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Build a ROMFileSystem image from the files under a directory.
+
+The image is written as a raw binary, to be programmed into flash at the
+address given to ROMFileSystem, or with --c-array as C source defining a
+const array of the given name, to be linked into the application.
+"""
+
+from __future__ import print_function
+
+import argparse
+import os
+import struct
+import sys
+
+HEADER = struct.Struct("<III")
+ENTRY = struct.Struct("<III")
+MAGIC = 0x314d4f52
+
+
+def align(size):
+    return (size + 3) & ~3
+
+
+def collect(root):
+    files = []
+    for dirpath, _, filenames in os.walk(root):
+        for filename in filenames:
+            path = os.path.join(dirpath, filename)
+            name = os.path.relpath(path, root).replace(os.sep, "/")
+            with open(path, "rb") as f:
+                files.append((name.encode("utf-8"), f.read()))
+    # ROMFileSystem finds files with a binary search by strcmp
+    files.sort(key=lambda entry: entry[0])
+    return files
+
+
+def build(files):
+    names_offset = HEADER.size + ENTRY.size * len(files)
+    names = b"".join(name + b"\0" for name, _ in files)
+    offset = align(names_offset + len(names))
+
+    index = b""
+    data = b""
+    name_offset = names_offset
+    for name, contents in files:
+        index += ENTRY.pack(name_offset, offset + len(data), len(contents))
+        name_offset += len(name) + 1
+        data += contents + b"\0" * (align(len(contents)) - len(contents))
+
+    padding = b"\0" * (align(names_offset + len(names)) - names_offset - len(names))
+    size = offset + len(data)
+    return HEADER.pack(MAGIC, len(files), size) + index + names + padding + data
+
+
+def c_array(image, name):
+    lines = ["/* Generated by mkromfs.py */",
+             "#include <stdint.h>",
+             "",
+             "const uint32_t %s[] = {" % name]
+    words = struct.unpack("<%dI" % (len(image) // 4), image)
+    for i in range(0, len(words), 8):
+        lines.append("    " + ", ".join("0x%08x" % w for w in words[i:i + 8]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[-1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("root", help="directory holding the files of the image")
+    parser.add_argument("output", help="file to write the image to")
+    parser.add_argument("--c-array", metavar="NAME",
+                        help="write C source defining the image as an array of this name")
+    args = parser.parse_args()
+
+    image = build(collect(args.root))
+    if args.c_array:
+        with open(args.output, "w") as f:
+            f.write(c_array(image, args.c_array))
+    else:
+        with open(args.output, "wb") as f:
+            f.write(image)
+
+    print("%d bytes" % len(image), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,211 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2020 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decode the records written by the RTOS tracer into a timeline.
+
+The input is either a raw capture of the records drained with
+mbed_rtos_trace_read, or with --itm a raw SWO capture of the ITM stream, in
+which the records are taken from the given stimulus port and the hardware
+exception trace packets are shown as interrupt entries and exits. Those
+packets carry no timestamp, so they get the time of the record before them,
+marked with '~'. Each event is printed with its time in microseconds and the
+thread running at the time, followed by the longest thread time slices,
+interrupt handlers and EventQueue callbacks.
+"""
+
+from __future__ import print_function
+
+import argparse
+import struct
+import sys
+
+RECORD = struct.Struct("<HBBII")
+SYNC = 0x5452
+
+START = 0
+THREAD_SWITCH = 1
+ISR_ENTER = 2
+ISR_EXIT = 3
+EVENT_DISPATCH = 13
+EVENT_DONE = 14
+
+EVENTS = {
+    START: "start",
+    THREAD_SWITCH: "switch",
+    ISR_ENTER: "isr-enter",
+    ISR_EXIT: "isr-exit",
+    4: "mutex-lock",
+    5: "mutex-unlock",
+    6: "mutex-wait",
+    7: "sem-acquire",
+    8: "sem-release",
+    9: "sem-wait",
+    10: "queue-put",
+    11: "queue-get",
+    12: "queue-wait",
+    EVENT_DISPATCH: "event",
+    EVENT_DONE: "event-done",
+}
+
+
+def itm_demux(data, port):
+    """Split a raw ITM stream into the bytes of a stimulus port and the
+    exception trace packets, as (bytes, [(offset, event, exception)])"""
+    records = bytearray()
+    exceptions = []
+    offset = 0
+    while offset < len(data):
+        header = data[offset]
+        offset += 1
+        if header & 0x03 == 0:
+            # Sync, overflow, timestamp or extension packet
+            if header & 0x80 and header != 0x80:
+                while offset < len(data) and data[offset] & 0x80:
+                    offset += 1
+                offset += 1
+            continue
+
+        size = {1: 1, 2: 2, 3: 4}[header & 0x03]
+        payload = data[offset:offset + size]
+        offset += size
+        if len(payload) < size:
+            break
+
+        if not header & 0x04:
+            if header >> 3 == port:
+                records += payload
+        elif header >> 3 == 1 and size == 2:
+            # Exception trace: 1 entered, 2 exited, 3 returned to
+            function = (payload[1] >> 4) & 0x03
+            exception = payload[0] | (payload[1] & 0x01) << 8
+            if function == 1:
+                exceptions.append((len(records), ISR_ENTER, exception))
+            elif function == 2:
+                exceptions.append((len(records), ISR_EXIT, exception))
+    return bytes(records), exceptions
+
+
+def records(data):
+    """Yield (end offset, event, seq, timestamp, object) from a capture"""
+    sync = struct.pack("<H", SYNC)
+    offset = 0
+    while True:
+        offset = data.find(sync, offset)
+        if offset < 0 or offset + RECORD.size > len(data):
+            return
+        fields = RECORD.unpack_from(data, offset)
+        if fields[1] not in EVENTS and fields[1] < 0x80:
+            # Not a record, the sync bytes were part of something else
+            offset += 1
+            continue
+        offset += RECORD.size
+        yield (offset,) + fields[1:]
+
+
+def timeline(data, exceptions):
+    """Yield (time, exact, event, seq, object), unwrapping the timestamps"""
+    frequency = 1000000
+    first = None
+    last = None
+    time = 0
+    pending = list(reversed(exceptions))
+    for end, event, seq, timestamp, obj in records(data):
+        while pending and pending[-1][0] < end:
+            _, exc_event, exception = pending.pop()
+            yield time, False, exc_event, None, exception
+        if event == START:
+            frequency = obj or frequency
+            first = timestamp
+            last = timestamp
+            time = 0
+        elif first is None:
+            first = timestamp
+            last = timestamp
+        time += ((timestamp - last) & 0xffffffff) * 1e6 / frequency
+        last = timestamp
+        yield time, True, event, seq, obj
+    for _, exc_event, exception in reversed(pending):
+        yield time, False, exc_event, None, exception
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[-1],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("capture", nargs="?", default="-",
+                        help="binary capture file, '-' for stdin (default)")
+    parser.add_argument("--itm", type=int, metavar="PORT",
+                        help="decode a raw ITM stream, taking the records from this stimulus port")
+    parser.add_argument("--top", type=int, default=10,
+                        help="number of longest slices, handlers and callbacks to list (default 10)")
+    args = parser.parse_args()
+
+    if args.capture == "-":
+        stream = getattr(sys.stdin, "buffer", sys.stdin)
+        data = stream.read()
+    else:
+        with open(args.capture, "rb") as capture:
+            data = capture.read()
+
+    exceptions = []
+    if args.itm is not None:
+        data, exceptions = itm_demux(bytearray(data), args.itm)
+
+    expected = None
+    dropped = 0
+    thread = None
+    started = {}
+    longest = []
+    for time, exact, event, seq, obj in timeline(data, exceptions):
+        if seq is not None:
+            if expected is not None and seq != expected:
+                lost = (seq - expected) & 0xff
+                dropped += lost
+                print("# %u records dropped" % lost)
+                started.clear()
+            expected = (seq + 1) & 0xff
+
+        name = EVENTS.get(event, "user-0x%02x" % event)
+        context = "0x%08x" % thread if thread is not None else "-"
+        print("%14.3f%s %-10s %-12s 0x%08x" % (time, " " if exact else "~", context, name, obj))
+
+        # Pair up the starts and ends of whatever we can time
+        if event == THREAD_SWITCH:
+            if ("thread", thread) in started:
+                longest.append((time - started.pop(("thread", thread)), "thread", thread))
+            thread = obj
+            started[("thread", thread)] = time
+        elif event == ISR_ENTER and exact:
+            started[("isr", obj)] = time
+        elif event == ISR_EXIT and ("isr", obj) in started:
+            longest.append((time - started.pop(("isr", obj)), "isr", obj))
+        elif event == EVENT_DISPATCH:
+            started[("event", obj)] = time
+        elif event == EVENT_DONE and ("event", obj) in started:
+            longest.append((time - started.pop(("event", obj)), "event", obj))
+
+    if longest:
+        print("\n# longest %u (us, kind, object)" % args.top)
+        for duration, kind, obj in sorted(longest, reverse=True)[:args.top]:
+            print("%14.3f  %-6s 0x%08x" % (duration, kind, obj))
+
+    if dropped:
+        print("# %u records dropped in total" % dropped, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()